@@ -5,6 +5,7 @@
 #include "flutter/assets/asset_manager.h"
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -96,6 +97,26 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+void AssetManager::ReadAheadAsMapping(
+    const std::string& asset_name,
+    const fml::RefPtr<fml::TaskRunner>& task_runner,
+    std::function<void(std::unique_ptr<fml::Mapping>)> callback) const {
+  FML_DCHECK(task_runner);
+  std::unique_ptr<fml::Mapping> mapping = GetAsMapping(asset_name);
+  task_runner->PostTask(fml::MakeCopyable(
+      [mapping = std::move(mapping), name = asset_name,
+       callback = std::move(callback)]() mutable {
+        if (mapping) {
+          TRACE_EVENT1("flutter", "AssetManager::ReadAhead", "name",
+                       name.c_str());
+          mapping->ReadAhead(0, mapping->GetSize());
+        }
+        if (callback) {
+          callback(std::move(mapping));
+        }
+      }));
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
   return !resolvers_.empty();
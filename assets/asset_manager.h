@@ -6,6 +6,7 @@
 #define FLUTTER_ASSETS_ASSET_MANAGER_H_
 
 #include <deque>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -13,6 +14,7 @@
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
@@ -88,6 +90,30 @@ class AssetManager final : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Maps an asset like GetAsMapping(), then reads the whole asset
+  ///             into memory on |task_runner|. This is meant for callers that
+  ///             know they will read an asset in full, such as shader bundles
+  ///             or scenes, so that its pages are not faulted in one at a time
+  ///             on the UI or raster thread.
+  ///
+  ///             The asset is looked up on the calling thread, which only
+  ///             opens it. The manager may be destroyed before the asset is
+  ///             read.
+  ///
+  /// @param[in]  asset_name   The name of the asset.
+  /// @param[in]  task_runner  The task runner to read the asset on, usually
+  ///                          the IO task runner.
+  /// @param[in]  callback     Called on |task_runner| with the mapping, or
+  ///                          nullptr if the asset was not found. May be null
+  ///                          to only warm the asset for later mappings of
+  ///                          the same file.
+  ///
+  void ReadAheadAsMapping(
+      const std::string& asset_name,
+      const fml::RefPtr<fml::TaskRunner>& task_runner,
+      std::function<void(std::unique_ptr<fml::Mapping>)> callback) const;
+
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
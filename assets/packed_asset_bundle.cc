@@ -0,0 +1,200 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <cstring>
+#include <regex>
+#include <utility>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint8_t kMagic[8] = {'F', 'L', 'T', 'P', 'A', 'C', 'K', '\0'};
+
+template <typename T>
+T ReadLittleEndian(const uint8_t* bytes) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return fml::LittleEndianToArch(value);
+}
+
+}  // namespace
+
+PackedAssetBundle::PackedAssetBundle(std::shared_ptr<fml::Mapping> archive,
+                                     bool is_valid_after_asset_manager_change)
+    : archive_(std::move(archive)) {
+  TRACE_EVENT0("flutter", "PackedAssetBundle::PackedAssetBundle");
+  if (!archive_ || !archive_->GetMapping() ||
+      archive_->GetSize() < kHeaderSize) {
+    return;
+  }
+  const uint8_t* bytes = archive_->GetMapping();
+  if (std::memcmp(bytes, kMagic, sizeof(kMagic)) != 0) {
+    FML_LOG(ERROR) << "Asset archive has an invalid header.";
+    return;
+  }
+  const auto version = ReadLittleEndian<uint32_t>(bytes + 8);
+  if (version != kVersion) {
+    FML_LOG(ERROR) << "Asset archive has unsupported version " << version;
+    return;
+  }
+  entry_count_ = ReadLittleEndian<uint32_t>(bytes + 12);
+  if (entry_count_ > (archive_->GetSize() - kHeaderSize) / kEntrySize ||
+      !ValidateIndex()) {
+    FML_LOG(ERROR) << "Asset archive has an invalid index.";
+    entry_count_ = 0u;
+    return;
+  }
+  is_valid_after_asset_manager_change_ = is_valid_after_asset_manager_change;
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+uint64_t PackedAssetBundle::HashName(std::string_view name) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  for (const char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+PackedAssetBundle::Entry PackedAssetBundle::GetEntry(size_t index) const {
+  const uint8_t* bytes =
+      archive_->GetMapping() + kHeaderSize + index * kEntrySize;
+  return {
+      .name_hash = ReadLittleEndian<uint64_t>(bytes),
+      .data_offset = ReadLittleEndian<uint64_t>(bytes + 8),
+      .data_length = ReadLittleEndian<uint64_t>(bytes + 16),
+      .name_offset = ReadLittleEndian<uint32_t>(bytes + 24),
+      .name_length = ReadLittleEndian<uint32_t>(bytes + 28),
+  };
+}
+
+std::string_view PackedAssetBundle::GetName(const Entry& entry) const {
+  return {reinterpret_cast<const char*>(archive_->GetMapping()) +
+              entry.name_offset,
+          entry.name_length};
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::MapEntry(
+    const Entry& entry) const {
+  return std::make_unique<fml::NonOwnedMapping>(
+      archive_->GetMapping() + entry.data_offset,                    // data
+      entry.data_length,                                             // size
+      [archive = archive_](auto, auto) mutable { archive.reset(); }  // proc
+  );
+}
+
+// Checks that every entry lies within the archive and that the entries are
+// sorted, once, so that lookups don't need to.
+bool PackedAssetBundle::ValidateIndex() const {
+  const uint64_t size = archive_->GetSize();
+  uint64_t previous_hash = 0u;
+  for (size_t i = 0; i < entry_count_; i++) {
+    const auto entry = GetEntry(i);
+    if (entry.data_offset > size ||
+        entry.data_length > size - entry.data_offset ||
+        entry.name_offset > size ||
+        entry.name_length > size - entry.name_offset) {
+      return false;
+    }
+    if (HashName(GetName(entry)) != entry.name_hash ||
+        (i > 0 && entry.name_hash < previous_hash)) {
+      return false;
+    }
+    previous_hash = entry.name_hash;
+  }
+  return true;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return nullptr;
+  }
+
+  // Find the first entry with the hash of the name. Names that collide are
+  // next to each other.
+  const uint64_t hash = HashName(asset_name);
+  size_t low = 0u;
+  size_t high = entry_count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (GetEntry(middle).name_hash < hash) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  for (size_t i = low; i < entry_count_; i++) {
+    const auto entry = GetEntry(i);
+    if (entry.name_hash != hash) {
+      break;
+    }
+    if (GetName(entry) == asset_name) {
+      return MapEntry(entry);
+    }
+  }
+  return nullptr;
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return mappings;
+  }
+
+  // Like the directory bundle, the pattern is matched against the file name
+  // of the assets, anywhere in the archive or directly in the subdirectory.
+  std::regex asset_regex(asset_pattern);
+  for (size_t i = 0; i < entry_count_; i++) {
+    const auto entry = GetEntry(i);
+    const auto name = GetName(entry);
+    const auto separator = name.rfind('/');
+    const auto directory = separator == std::string_view::npos
+                               ? std::string_view()
+                               : name.substr(0, separator);
+    const auto filename = separator == std::string_view::npos
+                              ? name
+                              : name.substr(separator + 1);
+    if (subdir && directory != subdir.value()) {
+      continue;
+    }
+    if (std::regex_match(filename.begin(), filename.end(), asset_regex)) {
+      mappings.push_back(MapEntry(entry));
+    }
+  }
+  return mappings;
+}
+
+}  // namespace flutter
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Resolves assets from a single archive that is mapped into
+///             memory once, rather than opening a file for every asset.
+///             Mappings of assets point into the archive, which stays mapped
+///             as long as any of them is alive.
+///
+///             All integers in the archive are little endian. The archive
+///             starts with a header:
+///
+///               uint8_t  magic[8];     // "FLTPACK\0"
+///               uint32_t version;      // kVersion
+///               uint32_t entry_count;
+///
+///             which is followed by `entry_count` index entries, sorted by
+///             their hash:
+///
+///               uint64_t name_hash;    // HashName(name)
+///               uint64_t data_offset;  // From the start of the archive.
+///               uint64_t data_length;
+///               uint32_t name_offset;  // From the start of the archive.
+///               uint32_t name_length;
+///
+///             The names and the data of the assets may be anywhere after the
+///             index. Names are relative to the asset directory and use '/'
+///             as their separator. Archives in APKs must be stored
+///             uncompressed for their mapping to be zero copy.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  /// The name of the archive in the asset directory of an application.
+  static constexpr char kArchiveName[] = "assets.fltpack";
+
+  static constexpr uint32_t kVersion = 1u;
+  static constexpr size_t kHeaderSize = 16u;
+  static constexpr size_t kEntrySize = 32u;
+
+  PackedAssetBundle(std::shared_ptr<fml::Mapping> archive,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The 64 bit FNV-1a hash of the name of an asset, by which the
+  ///             index of the archive is sorted.
+  ///
+  static uint64_t HashName(std::string_view name);
+
+ private:
+  struct Entry {
+    uint64_t name_hash = 0u;
+    uint64_t data_offset = 0u;
+    uint64_t data_length = 0u;
+    uint32_t name_offset = 0u;
+    uint32_t name_length = 0u;
+  };
+
+  const std::shared_ptr<fml::Mapping> archive_;
+  size_t entry_count_ = 0u;
+  bool is_valid_ = false;
+  bool is_valid_after_asset_manager_change_ = false;
+
+  Entry GetEntry(size_t index) const;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> MapEntry(const Entry& entry) const;
+
+  bool ValidateIndex() const;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct Asset {
+  std::string name;
+  std::string contents;
+};
+
+template <typename T>
+void Write(std::vector<uint8_t>& archive, size_t offset, T value) {
+  value = fml::LittleEndianToArch(value);
+  std::memcpy(archive.data() + offset, &value, sizeof(value));
+}
+
+std::shared_ptr<fml::Mapping> CreateArchive(std::vector<Asset> assets) {
+  std::sort(assets.begin(), assets.end(), [](const auto& a, const auto& b) {
+    return PackedAssetBundle::HashName(a.name) <
+           PackedAssetBundle::HashName(b.name);
+  });
+  std::vector<uint8_t> archive(
+      PackedAssetBundle::kHeaderSize +
+      assets.size() * PackedAssetBundle::kEntrySize);
+  std::memcpy(archive.data(), "FLTPACK", 8);
+  Write<uint32_t>(archive, 8, PackedAssetBundle::kVersion);
+  Write<uint32_t>(archive, 12, assets.size());
+  for (size_t i = 0; i < assets.size(); i++) {
+    const auto& asset = assets[i];
+    const size_t entry =
+        PackedAssetBundle::kHeaderSize + i * PackedAssetBundle::kEntrySize;
+    const size_t name_offset = archive.size();
+    archive.insert(archive.end(), asset.name.begin(), asset.name.end());
+    const size_t data_offset = archive.size();
+    archive.insert(archive.end(), asset.contents.begin(),
+                   asset.contents.end());
+    Write<uint64_t>(archive, entry, PackedAssetBundle::HashName(asset.name));
+    Write<uint64_t>(archive, entry + 8, data_offset);
+    Write<uint64_t>(archive, entry + 16, asset.contents.size());
+    Write<uint32_t>(archive, entry + 24, name_offset);
+    Write<uint32_t>(archive, entry + 28, asset.name.size());
+  }
+  return std::make_shared<fml::DataMapping>(std::move(archive));
+}
+
+std::string ToString(const std::unique_ptr<fml::Mapping>& mapping) {
+  return {reinterpret_cast<const char*>(mapping->GetMapping()),
+          mapping->GetSize()};
+}
+
+}  // namespace
+
+TEST(PackedAssetBundleTest, ResolvesAssetsWithoutCopies) {
+  auto archive = CreateArchive({{"AssetManifest.json", "{}"},
+                                {"fonts/Roboto.ttf", "font"},
+                                {"images/dash.png", "dash"}});
+  std::unique_ptr<AssetResolver> bundle =
+      std::make_unique<PackedAssetBundle>(archive, true);
+  ASSERT_TRUE(bundle->IsValid());
+  ASSERT_TRUE(bundle->IsValidAfterAssetManagerChange());
+  ASSERT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kPackedAssetBundle);
+
+  auto font = bundle->GetAsMapping("fonts/Roboto.ttf");
+  ASSERT_NE(font, nullptr);
+  ASSERT_EQ(ToString(font), "font");
+  ASSERT_GE(font->GetMapping(), archive->GetMapping());
+  ASSERT_LT(font->GetMapping(), archive->GetMapping() + archive->GetSize());
+
+  ASSERT_EQ(ToString(bundle->GetAsMapping("AssetManifest.json")), "{}");
+  ASSERT_EQ(bundle->GetAsMapping("Roboto.ttf"), nullptr);
+  ASSERT_EQ(bundle->GetAsMapping("images/missing.png"), nullptr);
+}
+
+TEST(PackedAssetBundleTest, MappingsOutliveTheBundle) {
+  std::unique_ptr<fml::Mapping> mapping;
+  {
+    std::unique_ptr<AssetResolver> bundle = std::make_unique<PackedAssetBundle>(
+        CreateArchive({{"images/dash.png", "dash"}}), false);
+    mapping = bundle->GetAsMapping("images/dash.png");
+  }
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(ToString(mapping), "dash");
+}
+
+TEST(PackedAssetBundleTest, MatchesFileNamesOfAssets) {
+  std::unique_ptr<AssetResolver> bundle = std::make_unique<PackedAssetBundle>(
+      CreateArchive({{"shaders/a.frag", "a"},
+                     {"shaders/nested/b.frag", "b"},
+                     {"images/c.png", "c"}}),
+      true);
+
+  ASSERT_EQ(bundle->GetAsMappings(".*\\.frag", std::nullopt).size(), 2u);
+  auto mappings = bundle->GetAsMappings(".*\\.frag", "shaders");
+  ASSERT_EQ(mappings.size(), 1u);
+  ASSERT_EQ(ToString(mappings[0]), "a");
+}
+
+TEST(PackedAssetBundleTest, RejectsInvalidArchives) {
+  auto is_valid = [](std::shared_ptr<fml::Mapping> archive) {
+    std::unique_ptr<AssetResolver> bundle =
+        std::make_unique<PackedAssetBundle>(std::move(archive), true);
+    return bundle->IsValid();
+  };
+  ASSERT_FALSE(is_valid(nullptr));
+  ASSERT_FALSE(is_valid(
+      std::make_shared<fml::DataMapping>(std::vector<uint8_t>(64, 0u))));
+
+  // An entry whose data extends past the end of the archive.
+  auto archive = CreateArchive({{"images/dash.png", "dash"}});
+  ASSERT_TRUE(is_valid(archive));
+  std::vector<uint8_t> bytes(archive->GetMapping(),
+                             archive->GetMapping() + archive->GetSize());
+  Write<uint64_t>(bytes, PackedAssetBundle::kHeaderSize + 16, 1024u);
+  ASSERT_FALSE(is_valid(std::make_shared<fml::DataMapping>(std::move(bytes))));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -2,6 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstdint>
+
 namespace flutter {
 constexpr double kMegaByteSizeInBytes = (1 << 20);
+
+// The ID of the view that every engine has, and that embedders that don't
+// support multiple views render into.
+constexpr int64_t kFlutterImplicitViewId = 0ll;
 }  // namespace flutter
@@ -85,8 +85,15 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  GetWorkerTaskRunner()->PostTask([&removed, file_io = file_io_,
+                                   cache_directory = cache_directory_,
+                                   cache_file = cache_file_,
+                                   sksl_cache_file = sksl_cache_file_]() {
+    // The files being written would be left behind otherwise.
+    file_io->WaitForPendingOperations();
+    // The files of both are removed below.
+    cache_file->Reset();
+    sksl_cache_file->Reset();
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -223,6 +230,11 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   std::vector<PersistentCache::SkSLCache> result;
   fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
                                        const std::string& filename) {
+    // The entries of the cache file are loaded through its index. The other
+    // files were written by engines that stored each entry in its own file.
+    if (filename.rfind(PersistentCacheFile::kFileName, 0) == 0) {
+      return true;
+    }
     SkSLCache cache = LoadFile(directory, filename, true);
     if (cache.key != nullptr && cache.value != nullptr) {
       result.push_back(cache);
@@ -236,6 +248,9 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
   if (IsValid()) {
+    for (auto& entry : sksl_cache_file_->GetEntries()) {
+      result.push_back({std::move(entry.key), std::move(entry.value)});
+    }
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
@@ -279,7 +294,13 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      cache_file_(
+          std::make_shared<PersistentCacheFile>(cache_directory_, read_only)),
+      sksl_cache_file_(
+          std::make_shared<PersistentCacheFile>(sksl_cache_directory_,
+                                                read_only)),
+      file_io_(std::make_shared<fml::AsyncFileIO>()) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -332,12 +353,15 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.empty()) {
-    return nullptr;
+  auto result = cache_file_->Find(key);
+  if (result == nullptr) {
+    auto file_name = SkKeyToFilePath(key);
+    if (file_name.empty()) {
+      return nullptr;
+    }
+    result =
+        PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   }
-  auto result =
-      PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
@@ -346,32 +370,35 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
 
 static void PersistentCacheStore(
     const fml::RefPtr<fml::TaskRunner>& worker,
+    const PersistentCache::IdleTaskPoster& idle_task_poster,
+    const std::shared_ptr<fml::AsyncFileIO>& file_io,
     const std::shared_ptr<fml::UniqueFD>& cache_directory,
     std::string key,
     std::unique_ptr<fml::Mapping> value) {
+  // The write itself happens on the file IO thread, so this task never blocks
+  // the thread it runs on.
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-  auto task = fml::MakeCopyable([cache_directory,             //
+  auto task = fml::MakeCopyable([file_io,                     //
+                                 cache_directory,             //
                                  file_name = std::move(key),  //
                                  mapping = std::move(value)   //
   ]() mutable {
     TRACE_EVENT0("flutter", "PersistentCacheStore");
-    if (!fml::WriteAtomically(*cache_directory,   //
-                              file_name.c_str(),  //
-                              *mapping)           //
-    ) {
-      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
-    }
+    file_io->WriteAtomically(
+        cache_directory, std::move(file_name), std::move(mapping), nullptr,
+        [](bool success) {
+          if (!success) {
+            FML_LOG(WARNING)
+                << "Could not write cache contents to persistent store.";
+          }
+        });
   });
 
-  if (!worker) {
-    FML_LOG(WARNING)
-        << "The persistent cache has no available workers. Performing the task "
-           "on the current thread. This slow operation is going to occur on a "
-           "frame workload.";
-    task();
+  if (worker && idle_task_poster) {
+    idle_task_poster(worker, std::move(task));
   } else {
-    worker->PostTask(std::move(task));
+    task();
   }
 }
 
@@ -395,6 +422,32 @@ std::unique_ptr<fml::MallocMapping> PersistentCache::BuildCacheObject(
   return mapping;
 }
 
+static void PersistentCacheAppend(
+    const fml::RefPtr<fml::TaskRunner>& worker,
+    const PersistentCache::IdleTaskPoster& idle_task_poster,
+    const std::shared_ptr<fml::AsyncFileIO>& file_io,
+    const std::shared_ptr<PersistentCacheFile>& cache_file,
+    sk_sp<SkData> key,
+    sk_sp<SkData> value) {
+  // Like |PersistentCacheStore|, but appends the entry to the cache file.
+  auto task = [file_io, cache_file, key = std::move(key),
+               value = std::move(value)]() {
+    file_io->RunOperation([cache_file, key, value]() {
+      TRACE_EVENT0("flutter", "PersistentCacheStore");
+      if (!cache_file->Store(*key, *value)) {
+        FML_LOG(WARNING)
+            << "Could not write cache contents to persistent store.";
+      }
+    });
+  };
+
+  if (worker && idle_task_poster) {
+    idle_task_poster(worker, std::move(task));
+  } else {
+    task();
+  }
+}
+
 // |GrContextOptions::PersistentCache|
 void PersistentCache::store(const SkData& key, const SkData& data) {
   stored_new_shaders_ = true;
@@ -407,20 +460,25 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.empty()) {
+  if (key.data() == nullptr || key.size() == 0) {
     return;
   }
 
-  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
-  if (!mapping) {
-    return;
-  }
+  PersistentCacheAppend(GetWorkerTaskRunner(), GetIdleTaskPoster(), file_io_,
+                        cache_sksl_ ? sksl_cache_file_ : cache_file_,
+                        SkData::MakeWithCopy(key.data(), key.size()),
+                        SkData::MakeWithCopy(data.data(), data.size()));
+}
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+void PersistentCache::WaitForPendingWrites() const {
+  file_io_->WaitForPendingOperations();
+}
+
+fml::UniqueFD PersistentCache::DuplicateCacheDirectory() const {
+  if (is_read_only_ || !IsValid()) {
+    return {};
+  }
+  return fml::Duplicate(cache_directory_->get());
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -437,8 +495,9 @@ void PersistentCache::DumpSkp(const SkData& data) {
   FML_LOG(INFO) << "Dumping " << file_name;
   auto mapping = std::make_unique<fml::DataMapping>(
       std::vector<uint8_t>{data.bytes(), data.bytes() + data.size()});
-  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
-                       std::move(file_name), std::move(mapping));
+  PersistentCacheStore(GetWorkerTaskRunner(), nullptr, file_io_,
+                       cache_directory_, std::move(file_name),
+                       std::move(mapping));
 }
 
 void PersistentCache::AddWorkerTaskRunner(
@@ -456,6 +515,16 @@ void PersistentCache::RemoveWorkerTaskRunner(
   }
 }
 
+void PersistentCache::SetIdleTaskPoster(IdleTaskPoster poster) {
+  std::scoped_lock lock(worker_task_runners_mutex_);
+  idle_task_poster_ = std::move(poster);
+}
+
+PersistentCache::IdleTaskPoster PersistentCache::GetIdleTaskPoster() const {
+  std::scoped_lock lock(worker_task_runners_mutex_);
+  return idle_task_poster_;
+}
+
 fml::RefPtr<fml::TaskRunner> PersistentCache::GetWorkerTaskRunner() const {
   fml::RefPtr<fml::TaskRunner> worker;
 
@@ -5,11 +5,15 @@
 #ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 #define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_H_
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_file.h"
+#include "flutter/fml/async_file_io.h"
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
@@ -48,7 +52,9 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   static std::string SkKeyToFilePath(const SkData& key);
 
   // Allocate a MallocMapping containing the given key and value in the file
-  // format used by the cache.
+  // format that the cache used to store each entry in a file of its own.
+  // Those files are still loaded, but new entries are appended to the
+  // |PersistentCacheFile| of the directory instead.
   static std::unique_ptr<fml::MallocMapping> BuildCacheObject(
       const SkData& key,
       const SkData& data);
@@ -72,6 +78,21 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   void RemoveWorkerTaskRunner(const fml::RefPtr<fml::TaskRunner>& task_runner);
 
+  // Posts a task to a worker when the engine is idle.
+  using IdleTaskPoster =
+      std::function<void(const fml::RefPtr<fml::TaskRunner>& /* worker */,
+                         fml::closure /* task */)>;
+
+  // The writes of the shaders stored by Skia are deferred through |poster|
+  // when it is set, so that they don't compete with the frames that compiled
+  // the shaders. Otherwise they are handed to the file IO thread right away.
+  // Either way, the writes never block the thread that compiled the shaders.
+  void SetIdleTaskPoster(IdleTaskPoster poster);
+
+  // Blocks until the files handed to the file IO thread so far are written.
+  // Writes still deferred to an idle period are not waited for.
+  void WaitForPendingWrites() const;
+
   // Whether Skia tries to store any shader into this persistent cache after
   // |ResetStoredNewShaders| is called. This flag is usually reset before each
   // frame so we can know if Skia tries to compile new shaders in that frame.
@@ -81,6 +102,12 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   bool IsDumpingSkp() const { return is_dumping_skp_; }
   void SetIsDumpingSkp(bool value) { is_dumping_skp_ = value; }
 
+  // Duplicate the descriptor of the versioned cache directory so that other
+  // caches (like the Impeller pipeline cache) may store their data alongside
+  // the Skia cache. Returns an invalid descriptor if the cache is read-only or
+  // invalid.
+  fml::UniqueFD DuplicateCacheDirectory() const;
+
   // Remove all files inside the persistent cache directory.
   // Return whether the purge is successful.
   bool Purge();
@@ -151,8 +178,12 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<PersistentCacheFile> cache_file_;
+  const std::shared_ptr<PersistentCacheFile> sksl_cache_file_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
+  IdleTaskPoster idle_task_poster_;
+  const std::shared_ptr<fml::AsyncFileIO> file_io_;
 
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
@@ -170,6 +201,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   fml::RefPtr<fml::TaskRunner> GetWorkerTaskRunner() const;
 
+  IdleTaskPoster GetIdleTaskPoster() const;
+
   friend class testing::ShellTest;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
@@ -0,0 +1,309 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_file.h"
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+struct FileHeader {
+  // A prefix used to identify the file format.
+  static const uint32_t kSignature = 0xA869594F;
+  static const uint32_t kVersion1 = 1;
+
+  uint32_t signature = kSignature;
+  uint32_t version = kVersion1;
+};
+
+// Followed by the key and the value.
+struct RecordHeader {
+  uint32_t key_size = 0u;
+  uint32_t value_size = 0u;
+  // Of the sizes, the key and the value.
+  uint32_t checksum = 0u;
+};
+
+// FNV-1a. A partly written record fails the check.
+uint32_t Checksum(uint32_t hash, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+uint32_t ComputeChecksum(uint32_t key_size,
+                         uint32_t value_size,
+                         const uint8_t* key,
+                         const uint8_t* value) {
+  uint32_t hash = 2166136261u;
+  hash = Checksum(hash, &key_size, sizeof(key_size));
+  hash = Checksum(hash, &value_size, sizeof(value_size));
+  hash = Checksum(hash, key, key_size);
+  return Checksum(hash, value, value_size);
+}
+
+size_t GetRecordSize(size_t key_size, size_t value_size) {
+  return sizeof(RecordHeader) + key_size + value_size;
+}
+
+}  // namespace
+
+PersistentCacheFile::PersistentCacheFile(
+    std::shared_ptr<const fml::UniqueFD> directory,
+    bool read_only)
+    : directory_(std::move(directory)), read_only_(read_only) {}
+
+PersistentCacheFile::~PersistentCacheFile() = default;
+
+void PersistentCacheFile::IndexLocked() {
+  if (indexed_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PersistentCacheFile::Index");
+  indexed_ = true;
+  index_.clear();
+  valid_size_ = 0u;
+  live_bytes_ = 0u;
+  dead_bytes_ = 0u;
+
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  mapping_ = fml::FileMapping::CreateReadOnly(*directory_, kFileName);
+  if (!mapping_ || mapping_->GetSize() < sizeof(FileHeader)) {
+    return;
+  }
+  const uint8_t* data = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+  FileHeader header;
+  memcpy(&header, data, sizeof(FileHeader));
+  if (header.signature != FileHeader::kSignature ||
+      header.version != FileHeader::kVersion1) {
+    FML_LOG(INFO) << "Persistent cache file header is corrupt.";
+    return;
+  }
+
+  size_t offset = sizeof(FileHeader);
+  while (size - offset >= sizeof(RecordHeader)) {
+    RecordHeader record;
+    memcpy(&record, data + offset, sizeof(RecordHeader));
+    const size_t available = size - offset - sizeof(RecordHeader);
+    if (record.key_size == 0u || record.key_size > available ||
+        record.value_size > available - record.key_size) {
+      break;
+    }
+    const uint8_t* key = data + offset + sizeof(RecordHeader);
+    const uint8_t* value = key + record.key_size;
+    if (ComputeChecksum(record.key_size, record.value_size, key, value) !=
+        record.checksum) {
+      break;
+    }
+    InsertLocked(std::string(reinterpret_cast<const char*>(key),
+                             record.key_size),
+                 {.offset = offset, .value_size = record.value_size});
+    offset += GetRecordSize(record.key_size, record.value_size);
+  }
+  valid_size_ = offset;
+  if (valid_size_ < size) {
+    FML_LOG(INFO) << "Dropped the persistent cache records after the first "
+                     "one that was not completely written.";
+  }
+}
+
+void PersistentCacheFile::InsertLocked(std::string key, Record record) {
+  const size_t record_size = GetRecordSize(key.size(), record.value_size);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    const size_t replaced_size =
+        GetRecordSize(found->first.size(), found->second.value_size);
+    live_bytes_ -= replaced_size;
+    dead_bytes_ += replaced_size;
+    found->second = record;
+  } else {
+    index_.emplace(std::move(key), record);
+  }
+  live_bytes_ += record_size;
+}
+
+const uint8_t* PersistentCacheFile::GetMappingLocked() {
+  if (!mapping_ || mapping_->GetSize() < valid_size_) {
+    mapping_ = fml::FileMapping::CreateReadOnly(*directory_, kFileName);
+  }
+  if (!mapping_ || mapping_->GetSize() < valid_size_) {
+    mapping_.reset();
+    return nullptr;
+  }
+  return mapping_->GetMapping();
+}
+
+sk_sp<SkData> PersistentCacheFile::Find(const SkData& key) {
+  std::scoped_lock lock(mutex_);
+  IndexLocked();
+  auto found = index_.find(
+      std::string(static_cast<const char*>(key.data()), key.size()));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  const uint8_t* data = GetMappingLocked();
+  if (data == nullptr) {
+    return nullptr;
+  }
+  const size_t value_offset =
+      found->second.offset + sizeof(RecordHeader) + found->first.size();
+  return SkData::MakeWithCopy(data + value_offset, found->second.value_size);
+}
+
+std::vector<PersistentCacheFile::Entry> PersistentCacheFile::GetEntries() {
+  std::scoped_lock lock(mutex_);
+  IndexLocked();
+  std::vector<Entry> entries;
+  const uint8_t* data = index_.empty() ? nullptr : GetMappingLocked();
+  if (data == nullptr) {
+    return entries;
+  }
+  entries.reserve(index_.size());
+  for (const auto& [key, record] : index_) {
+    const size_t value_offset =
+        record.offset + sizeof(RecordHeader) + key.size();
+    entries.push_back({
+        .key = SkData::MakeWithCopy(key.data(), key.size()),
+        .value = SkData::MakeWithCopy(data + value_offset, record.value_size),
+    });
+  }
+  return entries;
+}
+
+bool PersistentCacheFile::Store(const SkData& key, const SkData& value) {
+  if (read_only_ || key.size() == 0u ||
+      key.size() > std::numeric_limits<uint32_t>::max() ||
+      value.size() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PersistentCacheFile::Store");
+  std::scoped_lock lock(mutex_);
+  IndexLocked();
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+
+  // Some platforms can't resize a file that is mapped.
+  mapping_.reset();
+  auto file = fml::OpenFile(*directory_, kFileName, true,
+                            fml::FilePermission::kReadWrite);
+  if (!file.is_valid()) {
+    return false;
+  }
+  // A file without any valid record is written again from the start. This
+  // also overwrites whatever follows the last valid record.
+  const bool needs_header = valid_size_ == 0u;
+  const size_t offset = needs_header ? sizeof(FileHeader) : valid_size_;
+  const size_t record_size = GetRecordSize(key.size(), value.size());
+  if (!fml::TruncateFile(file, offset + record_size)) {
+    return false;
+  }
+  {
+    fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead,
+                                    fml::FileMapping::Protection::kWrite});
+    uint8_t* data = mapping.GetMutableMapping();
+    if (data == nullptr || mapping.GetSize() != offset + record_size) {
+      return false;
+    }
+    if (needs_header) {
+      FileHeader header;
+      memcpy(data, &header, sizeof(FileHeader));
+    }
+    RecordHeader record;
+    record.key_size = key.size();
+    record.value_size = value.size();
+    record.checksum = ComputeChecksum(record.key_size, record.value_size,
+                                      key.bytes(), value.bytes());
+    uint8_t* record_data = data + offset;
+    memcpy(record_data, &record, sizeof(RecordHeader));
+    record_data += sizeof(RecordHeader);
+    memcpy(record_data, key.data(), key.size());
+    record_data += key.size();
+    memcpy(record_data, value.data(), value.size());
+  }
+  InsertLocked(std::string(static_cast<const char*>(key.data()), key.size()),
+               {.offset = offset, .value_size = value.size()});
+  valid_size_ = offset + record_size;
+
+  if (dead_bytes_ >= kMinimumCompactionBytes && dead_bytes_ > live_bytes_) {
+    CompactLocked();
+  }
+  return true;
+}
+
+bool PersistentCacheFile::Compact() {
+  if (read_only_) {
+    return false;
+  }
+  std::scoped_lock lock(mutex_);
+  IndexLocked();
+  return CompactLocked();
+}
+
+bool PersistentCacheFile::CompactLocked() {
+  TRACE_EVENT0("flutter", "PersistentCacheFile::Compact");
+  const uint8_t* data = valid_size_ == 0u ? nullptr : GetMappingLocked();
+  if (data == nullptr) {
+    return false;
+  }
+  std::vector<uint8_t> compacted(sizeof(FileHeader) + live_bytes_);
+  FileHeader header;
+  memcpy(compacted.data(), &header, sizeof(FileHeader));
+  size_t offset = sizeof(FileHeader);
+  for (const auto& [key, record] : index_) {
+    const size_t record_size = GetRecordSize(key.size(), record.value_size);
+    memcpy(compacted.data() + offset, data + record.offset, record_size);
+    offset += record_size;
+  }
+
+  mapping_.reset();
+  if (!fml::WriteAtomically(*directory_, kFileName,
+                            fml::DataMapping(std::move(compacted)))) {
+    FML_LOG(WARNING) << "Could not compact the persistent cache file.";
+    // The file is unchanged unless the write got as far as replacing it.
+    indexed_ = false;
+    IndexLocked();
+    return false;
+  }
+  indexed_ = false;
+  IndexLocked();
+  return true;
+}
+
+void PersistentCacheFile::Reset() {
+  std::scoped_lock lock(mutex_);
+  indexed_ = false;
+  mapping_.reset();
+  index_.clear();
+  valid_size_ = 0u;
+  live_bytes_ = 0u;
+  dead_bytes_ = 0u;
+}
+
+size_t PersistentCacheFile::GetEntryCount() {
+  std::scoped_lock lock(mutex_);
+  IndexLocked();
+  return index_.size();
+}
+
+size_t PersistentCacheFile::GetDeadBytes() {
+  std::scoped_lock lock(mutex_);
+  IndexLocked();
+  return dead_bytes_;
+}
+
+}  // namespace flutter
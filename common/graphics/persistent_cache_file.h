@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_FILE_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_FILE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The entries of a |PersistentCache| directory, stored as records
+///             appended to a single file instead of a file per entry.
+///
+///             The file is memory-mapped and indexed the first time it is
+///             accessed. A record that is stored again for the same key
+///             replaces the previous one, which stays in the file until the
+///             file is compacted once the replaced records take up more
+///             space than the live ones.
+///
+///             Every record is checksummed, so a record that was only partly
+///             written when the process died ends the index, and is
+///             overwritten by the next record that is appended. Compaction
+///             replaces the file with |fml::WriteAtomically|.
+///
+///             All methods are thread-safe. The writes are expected to be
+///             made on a single thread, such as that of a |fml::AsyncFileIO|.
+///
+class PersistentCacheFile {
+ public:
+  /// The name of the file in the cache directory.
+  static constexpr char kFileName[] = "io.flutter.persistent_cache";
+
+  /// Replaced records are only compacted once there are at least this many
+  /// bytes of them.
+  static constexpr size_t kMinimumCompactionBytes = 256u * 1024u;
+
+  struct Entry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> value;
+  };
+
+  PersistentCacheFile(std::shared_ptr<const fml::UniqueFD> directory,
+                      bool read_only);
+
+  ~PersistentCacheFile();
+
+  //----------------------------------------------------------------------------
+  /// @brief      A copy of the value stored for |key|, or nullptr if there is
+  ///             none.
+  ///
+  sk_sp<SkData> Find(const SkData& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies of all the entries in the file, in no particular
+  ///             order.
+  ///
+  std::vector<Entry> GetEntries();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends a record to the file and compacts it if needed.
+  ///
+  /// @return     Whether the record was written.
+  ///
+  bool Store(const SkData& key, const SkData& value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rewrites the file with only the live records.
+  ///
+  /// @return     Whether the file was rewritten.
+  ///
+  bool Compact();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets the index so that the file is read again on the next
+  ///             access. Called after the file was removed by a purge.
+  ///
+  void Reset();
+
+  size_t GetEntryCount();
+
+  /// The bytes of the records that were replaced by later ones.
+  size_t GetDeadBytes();
+
+ private:
+  struct Record {
+    // The offset of the |RecordHeader| in the file.
+    size_t offset = 0u;
+    size_t value_size = 0u;
+  };
+
+  const std::shared_ptr<const fml::UniqueFD> directory_;
+  const bool read_only_;
+  std::mutex mutex_;
+  bool indexed_ = false;
+  // Dropped whenever the file is written to, and mapped again as needed.
+  std::unique_ptr<fml::FileMapping> mapping_;
+  // Keyed by the bytes of the keys.
+  std::unordered_map<std::string, Record> index_;
+  // The size of the file up to the end of its last valid record.
+  size_t valid_size_ = 0u;
+  size_t live_bytes_ = 0u;
+  size_t dead_bytes_ = 0u;
+
+  void IndexLocked();
+
+  void InsertLocked(std::string key, Record record);
+
+  const uint8_t* GetMappingLocked();
+
+  bool CompactLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCacheFile);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_FILE_H_
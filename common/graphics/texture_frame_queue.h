@@ -0,0 +1,174 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_TEXTURE_FRAME_QUEUE_H_
+#define FLUTTER_COMMON_GRAPHICS_TEXTURE_FRAME_QUEUE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Signals when the GPU work that wrote a texture frame is done.
+///
+class TextureFence {
+ public:
+  TextureFence() = default;
+
+  virtual ~TextureFence() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      If the work the fence was inserted after has completed. Must
+  ///             not block, this is polled on the raster thread.
+  ///
+  virtual bool IsSignaled() const = 0;
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureFence);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Hands the frames of an external texture from the thread that
+///             produces them to the raster thread without either of them
+///             waiting on the other.
+///
+///             The texture is triple-buffered: the consumer draws the frame
+///             it acquired last, one frame is ready to be acquired, and one
+///             frame has been submitted but its fence hasn't signaled yet.
+///             Submitting a frame while another is still in flight drops the
+///             older one, and acquiring skips to the latest frame that is
+///             ready, so a producer that runs faster than the display never
+///             backs up.
+///
+///             Frames are dropped and released by destroying them, which is
+///             always done outside of the lock of the queue. A frame type
+///             that wraps a producer buffer should hand it back from its
+///             destructor.
+///
+/// @tparam     Frame  A movable type describing a frame.
+///
+template <typename Frame>
+class TextureFrameQueue {
+ public:
+  TextureFrameQueue() = default;
+
+  ~TextureFrameQueue() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit a frame the producer has written, on any thread.
+  ///
+  /// @param[in]  frame        The frame.
+  /// @param[in]  ready_fence  Signals when the writes to the frame are done,
+  ///                          or nullptr if they already are.
+  ///
+  void Submit(Frame frame, std::shared_ptr<const TextureFence> ready_fence) {
+    std::optional<Entry> dropped;
+    {
+      std::scoped_lock lock(mutex_);
+      PromoteInFlightLocked(dropped);
+      if (in_flight_.has_value()) {
+        // The frame was superseded before it was ready to be drawn.
+        dropped = std::move(in_flight_);
+        dropped_frame_count_++;
+      }
+      in_flight_ = Entry{std::move(frame), std::move(ready_fence)};
+      submitted_frame_count_++;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Acquire the latest frame that is ready to be drawn. Called on
+  ///             the raster thread.
+  ///
+  /// @return     The frame, or std::nullopt if no frame became ready since
+  ///             the last call, in which case the consumer keeps drawing the
+  ///             frame it has.
+  ///
+  std::optional<Frame> AcquireLatest() {
+    std::optional<Entry> dropped;
+    std::optional<Entry> acquired;
+    {
+      std::scoped_lock lock(mutex_);
+      PromoteInFlightLocked(dropped);
+      acquired = std::move(ready_);
+      ready_.reset();
+    }
+    if (!acquired.has_value()) {
+      return std::nullopt;
+    }
+    return std::move(acquired->frame);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release the frames that haven't been acquired.
+  ///
+  void Clear() {
+    std::optional<Entry> ready;
+    std::optional<Entry> in_flight;
+    {
+      std::scoped_lock lock(mutex_);
+      ready = std::move(ready_);
+      in_flight = std::move(in_flight_);
+      ready_.reset();
+      in_flight_.reset();
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames that have been submitted.
+  ///
+  uint64_t GetSubmittedFrameCount() const {
+    std::scoped_lock lock(mutex_);
+    return submitted_frame_count_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames that were superseded by later ones
+  ///             before they could be acquired.
+  ///
+  uint64_t GetDroppedFrameCount() const {
+    std::scoped_lock lock(mutex_);
+    return dropped_frame_count_;
+  }
+
+ private:
+  struct Entry {
+    Frame frame;
+    std::shared_ptr<const TextureFence> ready_fence;
+  };
+
+  mutable std::mutex mutex_;
+  std::optional<Entry> ready_;
+  std::optional<Entry> in_flight_;
+  uint64_t submitted_frame_count_ = 0u;
+  uint64_t dropped_frame_count_ = 0u;
+
+  // Moves the frame in flight to the ready slot if its fence has signaled.
+  // The frame it replaces is moved to |dropped| to be released once the lock
+  // isn't held anymore.
+  void PromoteInFlightLocked(std::optional<Entry>& dropped) {
+    if (!in_flight_.has_value() || (in_flight_->ready_fence &&
+                                    !in_flight_->ready_fence->IsSignaled())) {
+      return;
+    }
+    if (ready_.has_value()) {
+      dropped = std::move(ready_);
+      dropped_frame_count_++;
+    }
+    ready_ = std::move(in_flight_);
+    in_flight_.reset();
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureFrameQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_TEXTURE_FRAME_QUEUE_H_
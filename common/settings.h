@@ -59,6 +59,30 @@ class FrameTiming {
     picture_cache_count_ = picture_cache_count;
     picture_cache_bytes_ = picture_cache_bytes;
   }
+  // The time from the earliest input handled in the frame until the end of
+  // its rasterization, or zero if it handled no input.
+  fml::TimeDelta GetInputLatency() const { return input_latency_; }
+  void SetInputLatency(fml::TimeDelta input_latency) {
+    input_latency_ = input_latency;
+  }
+  // The number of layer trees that were discarded since the previous frame
+  // because they were superseded by a newer tree while running late.
+  size_t GetDiscardedFrameCount() const { return discarded_frame_count_; }
+  void SetDiscardedFrameCount(size_t discarded_frame_count) {
+    discarded_frame_count_ = discarded_frame_count;
+  }
+  // The device memory held by the Impeller allocator when the frame was
+  // rasterized, or zero when rendering with Skia.
+  size_t GetDeviceMemoryBytes() const { return device_memory_bytes_; }
+  void SetDeviceMemoryBytes(size_t device_memory_bytes) {
+    device_memory_bytes_ = device_memory_bytes;
+  }
+  // The time from the start of the vsync the frame began at until its target
+  // time, which is the time the frame had to be built and rasterized in.
+  fml::TimeDelta GetVsyncInterval() const { return vsync_interval_; }
+  void SetVsyncInterval(fml::TimeDelta vsync_interval) {
+    vsync_interval_ = vsync_interval;
+  }
 
  private:
   fml::TimePoint data_[kCount];
@@ -67,6 +91,10 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  fml::TimeDelta input_latency_;
+  size_t discarded_frame_count_ = 0;
+  size_t device_memory_bytes_ = 0;
+  fml::TimeDelta vsync_interval_;
 };
 
 using TaskObserverAdd =
@@ -86,6 +114,9 @@ using Mappings = std::vector<std::unique_ptr<const fml::Mapping>>;
 using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
+using JankSnapshotCallback =
+    std::function<void(const FrameTiming& /* timing */,
+                       const std::string& /* snapshot */)>;
 
 class DartIsolate;
 
@@ -136,6 +167,12 @@ struct Settings {
   MappingsCallback application_kernels;
 
   std::string temp_directory_path;
+
+  // Whether to record the pages of the Dart snapshots that are touched until
+  // the first frame in the `temp_directory_path`, and to read those pages
+  // ahead on the next launches.
+  bool enable_snapshot_warmup_profile = false;
+
   std::vector<std::string> dart_flags;
   // Isolate settings
   bool enable_checked_mode = false;
@@ -145,6 +182,9 @@ struct Settings {
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Keep the last trace events of each thread in memory, even in release
+  // builds. See |fml::tracing::TraceRecorder|.
+  bool enable_trace_recorder = false;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -212,6 +252,119 @@ struct Settings {
   // not supported on the platform.
   bool enable_impeller = false;
 
+  // Whether Impeller on Vulkan presents frames as soon as possible instead
+  // of queuing every frame for a vsync, trading dropped frames for a lower
+  // input latency.
+  bool impeller_vulkan_low_latency = true;
+
+  // The number of frames Impeller on Vulkan may submit to the GPU before the
+  // first of them completes. More frames keep the GPU busier at the cost of
+  // latency.
+  size_t impeller_vulkan_frames_in_flight = 2u;
+
+  // Whether Impeller encodes the independent save layers of a frame
+  // concurrently on the worker threads of its context. Ignored by backends
+  // with threading restrictions.
+  bool impeller_parallel_subpass_encoding = false;
+
+  // Compose the overlays of platform views on Android through SurfaceControl
+  // transactions submitted from the raster thread, instead of merging the
+  // raster thread into the platform thread. Ignored below API 29 and when the
+  // renderer doesn't support it.
+  bool enable_surface_control = false;
+
+  // Delay the start of each frame past its vsync by as much as the timings of
+  // the recent frames allow. This reduces the latency from input to display
+  // without dropping more frames as long as the workload stays similar.
+  bool enable_predictive_frame_scheduling = false;
+
+  // Choose the number of frames in flight between the UI and raster threads
+  // from the timings of the recent frames instead of using a fixed number.
+  bool enable_adaptive_pipeline_depth = false;
+
+  // Ask the display to run at the rate the content is updated at, the full
+  // refresh rate while there is input, and the lowest rate while nothing is
+  // animating, on displays with a variable refresh rate.
+  bool enable_frame_rate_hints = false;
+
+  // For displays that mostly show static content. Frames begin as soon as
+  // they are requested instead of at the next vsync, frames whose layer trees
+  // don't differ from the last ones drawn are not drawn again, and the unused
+  // GPU resources are purged once no frame has been drawn for
+  // |render_on_demand_resource_trim_delay|.
+  bool render_on_demand = false;
+  fml::TimeDelta render_on_demand_resource_trim_delay =
+      fml::TimeDelta::FromSeconds(5);
+
+  // Keep the UI and raster threads on the fastest cores, and the IO thread
+  // off them, on devices with cores of different speeds. Only supported on
+  // Android.
+  bool enable_thread_placement = false;
+
+  // Report the work the UI and raster threads do on every frame to the
+  // system, so that it can give them more CPU time before frames miss their
+  // targets. Only supported on Android.
+  bool enable_performance_hints = false;
+
+  // Render the display lists that the raster cache decides to cache on the
+  // IO thread with the resource context, drawing them uncached until their
+  // images are ready, instead of in the frame that decided to cache them.
+  bool enable_async_raster_cache = false;
+
+  // Compile each layer tree into a flat list of paint commands after its
+  // preroll and paint the frame from that list.
+  bool enable_paint_list = false;
+
+  // Paint the children of a container in each layer tree on up to this
+  // many threads, including the raster thread, when the frame is painted
+  // into a display list. Values below 2 paint every layer on the raster
+  // thread.
+  size_t parallel_paint_tasks = 0;
+
+  // When the frame is painted into the canvas of a Skia GPU surface, record
+  // the children that are painted in parallel into deferred display lists,
+  // so that their GPU work is also prepared off the raster thread. Only
+  // applies if |parallel_paint_tasks| is set.
+  bool parallel_paint_deferred_display_lists = false;
+
+  // Rasterize the frames that are produced before the platform surface is
+  // created into an offscreen surface, and present the last of them as soon
+  // as the surface is created instead of waiting for the next frame.
+  bool prewarm_first_frame = false;
+
+  // The platform channels whose messages are coalesced on the platform
+  // thread for up to a frame interval, and then dispatched to the root
+  // isolate in one UI task and one call into Dart.
+  std::vector<std::string> batched_platform_message_channels;
+
+  // Hold the pointer events received during a frame until the next vsync, and
+  // coalesce the consecutive move and hover events of each pointer into one.
+  bool coalesce_pointer_events = false;
+
+  // When pointer events are coalesced, resample the coalesced moves at this
+  // many microseconds before the newest pointer event of the frame. Values
+  // that are not positive dispatch the newest sample instead.
+  int64_t pointer_resampling_offset_micros = 0;
+
+  // Dispatch the pointer events received while a frame is scheduled right
+  // before that frame begins, instead of as they are received. Ignored when
+  // pointer events are coalesced, which dispatches them at vsync.
+  bool frame_aligned_pointer_events = false;
+
+  // Move the transform layers that follow a dragging pointer by the distance
+  // the pointer has moved since their frame was built, right before the frame
+  // is rasterized.
+  bool late_latch_pointer_transforms = false;
+
+  // When a newer layer tree is already waiting and the current one has missed
+  // its vsync target, discard the current one instead of rasterizing it.
+  bool discard_superseded_frames = false;
+
+  // Keep a copy of the last frame that was presented, so that screenshots
+  // don't render the last layer tree again. Only frames rendered with Skia
+  // that contain no platform views are kept.
+  bool retain_last_frame_for_screenshots = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -292,6 +445,19 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // Callback to handle the snapshot of a janky frame, a frame that took
+  // longer than |jank_snapshot_frame_budget| from the start of its build to
+  // the end of its rasterization. The snapshot is a JSON object in the Chrome
+  // trace event format, with the trace events of the last
+  // |jank_snapshot_trace_duration|. See |JankSnapshotRecorder|.
+  //
+  // This is called on the raster thread. Setting it enables the
+  // |fml::tracing::TraceRecorder|.
+  JankSnapshotCallback jank_snapshot_callback;
+  fml::TimeDelta jank_snapshot_frame_budget =
+      fml::TimeDelta::FromMilliseconds(100);
+  fml::TimeDelta jank_snapshot_trace_duration = fml::TimeDelta::FromSeconds(5);
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
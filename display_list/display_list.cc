@@ -2,7 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_builder.h"
@@ -16,6 +21,161 @@ const SaveLayerOptions SaveLayerOptions::kNoAttributes = SaveLayerOptions();
 const SaveLayerOptions SaveLayerOptions::kWithAttributes =
     kNoAttributes.with_renders_with_attributes();
 
+namespace {
+
+// Caches released display list buffers by power of two size class. Buffers
+// above the largest class are rare and go straight back to the heap.
+class StoragePool {
+ public:
+  static constexpr size_t kMinBlockSize = 4096u;
+  static constexpr size_t kMaxBlockSize = 1u << 20;
+  static constexpr size_t kMaxPooledBytes = 4u << 20;
+  static constexpr size_t kMaxBlocksPerClass = 16u;
+
+  static StoragePool& GetInstance() {
+    static StoragePool* pool = new StoragePool();
+    return *pool;
+  }
+
+  static size_t GetBlockSize(size_t count) {
+    size_t size = kMinBlockSize;
+    while (size < count) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  uint8_t* Acquire(size_t block_size) {
+    if (block_size <= kMaxBlockSize) {
+      std::scoped_lock lock(mutex_);
+      auto& blocks = free_blocks_[GetSizeClass(block_size)];
+      if (!blocks.empty()) {
+        uint8_t* block = blocks.back();
+        blocks.pop_back();
+        pooled_bytes_ -= block_size;
+        return block;
+      }
+    }
+    return static_cast<uint8_t*>(std::malloc(block_size));
+  }
+
+  void Recycle(uint8_t* block, size_t block_size) {
+    if (block_size <= kMaxBlockSize) {
+      std::scoped_lock lock(mutex_);
+      auto& blocks = free_blocks_[GetSizeClass(block_size)];
+      if (blocks.size() < kMaxBlocksPerClass &&
+          pooled_bytes_ + block_size <= kMaxPooledBytes) {
+        blocks.push_back(block);
+        pooled_bytes_ += block_size;
+        return;
+      }
+    }
+    std::free(block);
+  }
+
+  size_t GetPooledBytes() {
+    std::scoped_lock lock(mutex_);
+    return pooled_bytes_;
+  }
+
+ private:
+  static constexpr size_t kSizeClassCount = 9u;
+  static_assert(kMinBlockSize << (kSizeClassCount - 1) == kMaxBlockSize);
+
+  std::mutex mutex_;
+  std::vector<uint8_t*> free_blocks_[kSizeClassCount];
+  size_t pooled_bytes_ = 0;
+
+  StoragePool() {
+    // The vectors must not allocate while recycling in the steady state.
+    for (auto& blocks : free_blocks_) {
+      blocks.reserve(kMaxBlocksPerClass);
+    }
+  }
+
+  static size_t GetSizeClass(size_t block_size) {
+    size_t size_class = 0;
+    while ((kMinBlockSize << size_class) < block_size) {
+      size_class++;
+    }
+    return size_class;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StoragePool);
+};
+
+}  // namespace
+
+DisplayListStorage::DisplayListStorage(DisplayListStorage&& other)
+    : ptr_(other.ptr_), capacity_(other.capacity_) {
+  other.ptr_ = nullptr;
+  other.capacity_ = 0;
+}
+
+DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& other) {
+  if (this != &other) {
+    Release();
+    ptr_ = other.ptr_;
+    capacity_ = other.capacity_;
+    other.ptr_ = nullptr;
+    other.capacity_ = 0;
+  }
+  return *this;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  Release();
+}
+
+void DisplayListStorage::realloc(size_t count) {
+  if (count <= capacity_) {
+    return;
+  }
+  auto& pool = StoragePool::GetInstance();
+  size_t block_size = StoragePool::GetBlockSize(count);
+  uint8_t* block = pool.Acquire(block_size);
+  FML_CHECK(block);
+  if (ptr_) {
+    memcpy(block, ptr_, capacity_);
+    pool.Recycle(ptr_, capacity_);
+  }
+  ptr_ = block;
+  capacity_ = block_size;
+}
+
+void DisplayListStorage::shrink(size_t count) {
+  FML_DCHECK(count <= capacity_);
+  if (!ptr_ || capacity_ - count <= capacity_ / 4) {
+    return;
+  }
+  // Buffers above the largest class aren't pooled, so they can be of any size.
+  size_t block_size = count > StoragePool::kMaxBlockSize
+                          ? count
+                          : StoragePool::GetBlockSize(count);
+  if (block_size >= capacity_) {
+    return;
+  }
+  auto& pool = StoragePool::GetInstance();
+  uint8_t* block = pool.Acquire(block_size);
+  FML_CHECK(block);
+  memcpy(block, ptr_, count);
+  pool.Recycle(ptr_, capacity_);
+  ptr_ = block;
+  capacity_ = block_size;
+}
+
+void DisplayListStorage::Release() {
+  if (ptr_) {
+    StoragePool::GetInstance().Recycle(ptr_, capacity_);
+    ptr_ = nullptr;
+    capacity_ = 0;
+  }
+}
+
+size_t DisplayListStorage::GetPooledBytesForTesting() {
+  return StoragePool::GetInstance().GetPooledBytes();
+}
+
 DisplayList::DisplayList()
     : byte_count_(0),
       op_count_(0),
@@ -23,6 +183,7 @@ DisplayList::DisplayList()
       nested_op_count_(0),
       unique_id_(0),
       bounds_({0, 0, 0, 0}),
+      opaque_rect_({0, 0, 0, 0}),
       can_apply_group_opacity_(true) {}
 
 DisplayList::DisplayList(DisplayListStorage&& storage,
@@ -31,8 +192,10 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
                          size_t nested_byte_count,
                          unsigned int nested_op_count,
                          const SkRect& bounds,
+                         const SkRect& opaque_rect,
                          bool can_apply_group_opacity,
-                         sk_sp<const DlRTree> rtree)
+                         sk_sp<const DlRTree> rtree,
+                         sk_sp<const DlOpIndex> op_index)
     : storage_(std::move(storage)),
       byte_count_(byte_count),
       op_count_(op_count),
@@ -40,8 +203,10 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       nested_op_count_(nested_op_count),
       unique_id_(next_unique_id()),
       bounds_(bounds),
+      opaque_rect_(opaque_rect),
       can_apply_group_opacity_(can_apply_group_opacity),
-      rtree_(std::move(rtree)) {}
+      rtree_(std::move(rtree)),
+      op_index_(std::move(op_index)) {}
 
 DisplayList::~DisplayList() {
   uint8_t* ptr = storage_.get();
@@ -81,59 +246,216 @@ class NopCuller final : public Culler {
   void update(DispatchContext& context) override {}
 };
 NopCuller NopCuller::instance = NopCuller();
-class VectorCuller final : public Culler {
- public:
-  VectorCuller(const DlRTree* rtree, const std::vector<int>& rect_indices)
-      : rtree_(rtree), cur_(rect_indices.begin()), end_(rect_indices.end()) {}
 
-  ~VectorCuller() = default;
+namespace {
 
-  bool init(DispatchContext& context) override {
-    if (cur_ < end_) {
-      context.next_render_index = rtree_->id(*cur_++);
+// Dispatches a single op, returning false for an unknown op type.
+bool DispatchOp(DispatchContext& context, const DLOp* op) {
+  switch (op->type) {
+#define DL_OP_DISPATCH(name)                             \
+  case DisplayListOpType::k##name:                       \
+    static_cast<const name##Op*>(op)->dispatch(context); \
+    return true;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_DISPATCH(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_DISPATCH
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+}
+
+bool IsSaveOp(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kSave:
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds:
       return true;
-    } else {
-      // Setting next_render_index to MAX_INT means that
-      // all rendering ops will be "before" that index and
-      // they will skip themselves and all clip and transform
-      // ops will see that the next render index is not
-      // before the next restore index (even if both are MAX_INT)
-      // and so they will also not execute.
-      // None of this really matters because returning false
-      // here should cause the Dispatch operation to abort,
-      // but this value is conceptually correct if that short
-      // circuit optimization isn't used.
-      context.next_render_index = std::numeric_limits<int>::max();
+    default:
       return false;
-    }
   }
-  void update(DispatchContext& context) override {
-    if (++context.cur_index > context.next_render_index) {
-      while (cur_ < end_) {
-        context.next_render_index = rtree_->id(*cur_++);
-        if (context.next_render_index >= context.cur_index) {
-          // It should be rare that we have duplicate indices
-          // but if we do, then having a while loop is a cheap
-          // insurance for those cases.
-          // The main cause of duplicate indices is when a
-          // DrawDisplayListOp was added to this DisplayList and
-          // both are computing an R-Tree, in which case the
-          // builder method will forward all of the child
-          // DisplayList's rects to this R-Tree with the same
-          // op_index.
-          return;
-        }
+}
+
+// Walks the ops of a DisplayList that intersect a cull rect with the help
+// of its DlOpIndex.
+//
+// The ops between two visible rendering ops are walked just like in an
+// unculled dispatch as long as there are only a few of them. Longer runs
+// are skipped by seeking to the next visible op, which restores the saves
+// that don't enclose it, replays the saves, transforms and clips that do,
+// and sets the most recent value of each attribute.
+class IndexedDispatch {
+ public:
+  // Runs of fewer ops than this are cheaper to walk than to seek over.
+  static constexpr int kMinSeekOps = 32;
+
+  IndexedDispatch(Dispatcher& dispatcher,
+                  const uint8_t* ops,
+                  const DlOpIndex& index,
+                  const SkRect& cull_rect)
+      : context_{
+            .dispatcher = dispatcher,
+            .cur_index = 0,
+            .next_render_index = 0,
+            .next_restore_index = std::numeric_limits<int>::max(),
+        },
+        ops_(ops),
+        index_(index),
+        cull_rect_(cull_rect) {}
+
+  void Run() {
+    int first = index_.FirstCandidate(cull_rect_);
+    int last = index_.LastCandidate(cull_rect_);
+    int next = index_.NextVisible(first, last, cull_rect_);
+    if (next > last) {
+      return;
+    }
+    SeekTo(next);
+    while (true) {
+      context_.next_render_index = index_.render_op_index(next);
+      if (!WalkThrough(index_.render_offset(next))) {
+        return;
+      }
+      next = index_.NextVisible(next + 1, last, cull_rect_);
+      if (next > last) {
+        break;
+      }
+      if (index_.render_op_index(next) - cur_index_ >= kMinSeekOps) {
+        SeekTo(next);
       }
-      context.next_render_index = std::numeric_limits<int>::max();
     }
+    // Nothing after the last visible op renders, only the open saves need
+    // to be balanced.
+    RestoreTo(0u);
   }
 
  private:
-  const DlRTree* rtree_;
-  std::vector<int>::const_iterator cur_;
-  std::vector<int>::const_iterator end_;
+  DispatchContext context_;
+  const uint8_t* ops_;
+  const DlOpIndex& index_;
+  const SkRect cull_rect_;
+
+  // The offset and index of the next op to walk.
+  uint32_t pos_ = 0u;
+  int cur_index_ = 0;
+  // The attributes are current up to this offset.
+  uint32_t attribute_pos_ = 0u;
+  // The saves enclosing |pos_|, outermost first.
+  std::vector<int> open_saves_;
+  int next_save_ = 0;
+
+  std::vector<int> target_saves_;
+  std::vector<uint32_t> attribute_offsets_;
+
+  const DLOp* OpAt(uint32_t offset) const {
+    return reinterpret_cast<const DLOp*>(ops_ + offset);
+  }
+
+  void DispatchAt(uint32_t offset, int op_index) {
+    context_.cur_index = op_index;
+    DispatchOp(context_, OpAt(offset));
+  }
+
+  bool WalkThrough(uint32_t offset) {
+    while (pos_ <= offset) {
+      const DLOp* op = OpAt(pos_);
+      context_.cur_index = cur_index_;
+      if (!DispatchOp(context_, op)) {
+        return false;
+      }
+      if (IsSaveOp(op->type)) {
+        open_saves_.push_back(next_save_++);
+      } else if (op->type == DisplayListOpType::kRestore) {
+        open_saves_.pop_back();
+      }
+      pos_ += op->size;
+      cur_index_++;
+    }
+    attribute_pos_ = pos_;
+    return true;
+  }
+
+  void SeekTo(int entry) {
+    uint32_t target = index_.render_offset(entry);
+    if (target <= pos_) {
+      return;
+    }
+    context_.next_render_index = index_.render_op_index(entry);
+
+    target_saves_.clear();
+    for (int save = index_.render_save(entry); save != DlOpIndex::kTopLevel;
+         save = index_.save_parent(save)) {
+      target_saves_.push_back(save);
+    }
+    std::reverse(target_saves_.begin(), target_saves_.end());
+
+    size_t common = 0u;
+    while (common < open_saves_.size() && common < target_saves_.size() &&
+           open_saves_[common] == target_saves_[common]) {
+      common++;
+    }
+    RestoreTo(common);
+
+    // Only the innermost of the saves that stay open can have transforms
+    // and clips between the current position and the target.
+    ReplayStateOps(common == 0u ? DlOpIndex::kTopLevel
+                                : target_saves_[common - 1],
+                   pos_, target);
+    for (size_t i = common; i < target_saves_.size(); i++) {
+      int save = target_saves_[i];
+      uint32_t save_offset = index_.save_offset(save);
+      // A saveLayer renders with the attributes that are current at it.
+      SyncAttributes(save_offset);
+      DispatchAt(save_offset, index_.save_op_index(save));
+      open_saves_.push_back(save);
+      ReplayStateOps(save, save_offset, target);
+    }
+    SyncAttributes(target);
+
+    pos_ = target;
+    cur_index_ = index_.render_op_index(entry);
+    next_save_ = index_.FirstSaveAtOrAfter(target);
+  }
+
+  void RestoreTo(size_t depth) {
+    while (open_saves_.size() > depth) {
+      int save = open_saves_.back();
+      DispatchAt(index_.restore_offset(save), index_.restore_op_index(save));
+      open_saves_.pop_back();
+    }
+  }
+
+  void ReplayStateOps(int save, uint32_t begin, uint32_t end) {
+    int first, last;
+    index_.FindStateOps(save, begin, end, &first, &last);
+    for (int i = first; i < last; i++) {
+      // The op index is only used by save ops.
+      DispatchAt(index_.state_offset(i), cur_index_);
+    }
+  }
+
+  void SyncAttributes(uint32_t offset) {
+    if (offset <= attribute_pos_) {
+      return;
+    }
+    attribute_offsets_.clear();
+    index_.FindAttributeOps(attribute_pos_, offset, &attribute_offsets_);
+    for (uint32_t attribute_offset : attribute_offsets_) {
+      DispatchOp(context_, OpAt(attribute_offset));
+    }
+    attribute_pos_ = offset;
+  }
 };
 
+}  // namespace
+
 void DisplayList::Dispatch(Dispatcher& ctx) const {
   uint8_t* ptr = storage_.get();
   Dispatch(ctx, ptr, ptr + byte_count_, NopCuller::instance);
@@ -146,18 +468,14 @@ void DisplayList::Dispatch(Dispatcher& ctx, const SkRect& cull_rect) const {
     Dispatch(ctx);
     return;
   }
-  const DlRTree* rtree = this->rtree().get();
-  FML_DCHECK(rtree != nullptr);
-  if (rtree == nullptr) {
+  const DlOpIndex* op_index = this->op_index().get();
+  FML_DCHECK(op_index != nullptr);
+  if (op_index == nullptr) {
     FML_LOG(ERROR) << "dispatched with culling rect on DL with no rtree";
     Dispatch(ctx);
     return;
   }
-  uint8_t* ptr = storage_.get();
-  std::vector<int> rect_indices;
-  rtree->search(cull_rect, &rect_indices);
-  VectorCuller culler(rtree, rect_indices);
-  Dispatch(ctx, ptr, ptr + byte_count_, culler);
+  IndexedDispatch(ctx, storage_.get(), *op_index, cull_rect).Run();
 }
 
 void DisplayList::Dispatch(Dispatcher& dispatcher,
@@ -177,22 +495,8 @@ void DisplayList::Dispatch(Dispatcher& dispatcher,
     auto op = reinterpret_cast<const DLOp*>(ptr);
     ptr += op->size;
     FML_DCHECK(ptr <= end);
-    switch (op->type) {
-#define DL_OP_DISPATCH(name)                             \
-  case DisplayListOpType::k##name:                       \
-    static_cast<const name##Op*>(op)->dispatch(context); \
-    break;
-
-      FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
-#ifdef IMPELLER_ENABLE_3D
-      DL_OP_DISPATCH(SetSceneColorSource)
-#endif  // IMPELLER_ENABLE_3D
-
-#undef DL_OP_DISPATCH
-
-      default:
-        FML_DCHECK(false);
-        return;
+    if (!DispatchOp(context, op)) {
+      return;
     }
     culler.update(context);
   }
@@ -314,6 +618,7 @@ void DisplayList::RenderTo(SkCanvas* canvas, SkScalar opacity) const {
   } else {
     Dispatch(dispatcher);
   }
+  dispatcher.Flush();
 }
 
 bool DisplayList::Equals(const DisplayList* other) const {
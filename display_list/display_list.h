@@ -8,10 +8,12 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/display_list/display_list_op_index.h"
 #include "flutter/display_list/display_list_rtree.h"
 #include "flutter/display_list/display_list_sampling_options.h"
 #include "flutter/display_list/types.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -220,24 +222,41 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
+// Manages a buffer for display list ops. Buffers are sized in power of two
+// classes and are returned to a process wide pool when released. So
+// repeatedly recording and releasing display lists of similar sizes reuses
+// the same buffers instead of going to the heap.
 class DisplayListStorage {
  public:
   DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
+  DisplayListStorage(DisplayListStorage&& other);
+  DisplayListStorage& operator=(DisplayListStorage&& other);
+  ~DisplayListStorage();
 
-  uint8_t* get() const { return ptr_.get(); }
+  uint8_t* get() const { return ptr_; }
 
-  void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
-  }
+  // The number of bytes that may be used. Can be larger than what was last
+  // asked for.
+  size_t capacity() const { return capacity_; }
+
+  // Ensures the buffer can hold at least |count| bytes. The bytes already in
+  // the buffer are kept. The buffer never shrinks.
+  void realloc(size_t count);
+
+  // Moves the first |count| bytes to a smaller buffer if more than a quarter
+  // of the buffer is unused and a smaller buffer can hold them.
+  void shrink(size_t count);
+
+  // The number of bytes of released buffers that are waiting to be reused.
+  static size_t GetPooledBytesForTesting();
 
  private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  void Release();
+
+  uint8_t* ptr_ = nullptr;
+  size_t capacity_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
 };
 
 class Culler;
@@ -267,6 +286,12 @@ class DisplayList : public SkRefCnt {
            (nested ? nested_byte_count_ : 0);
   }
 
+  // The memory held by this list, not including nested lists. This is more
+  // than |bytes(false)| by the unused capacity of the op storage.
+  size_t retained_bytes() const {
+    return sizeof(DisplayList) + storage_.capacity();
+  }
+
   unsigned int op_count(bool nested = false) const {
     return op_count_ + (nested ? nested_op_count_ : 0);
   }
@@ -275,9 +300,21 @@ class DisplayList : public SkRefCnt {
 
   const SkRect& bounds() const { return bounds_; }
 
+  // A rect, in the same coordinates as |bounds|, that the display list
+  // covers entirely with opaque pixels, or an empty rect if it is not known
+  // to cover any. The rect is conservative: content that is only partly
+  // opaque, blended or under a complex clip never contributes to it, so
+  // whatever the display list is drawn over is hidden inside the rect.
+  // The rect need not be pixel aligned, in which case its edge pixels are
+  // only partly covered, so users should round it in.
+  const SkRect& opaque_rect() const { return opaque_rect_; }
+
   bool has_rtree() const { return rtree_ != nullptr; }
   sk_sp<const DlRTree> rtree() const { return rtree_; }
 
+  bool has_op_index() const { return op_index_ != nullptr; }
+  sk_sp<const DlOpIndex> op_index() const { return op_index_; }
+
   bool Equals(const DisplayList* other) const;
   bool Equals(const DisplayList& other) const { return Equals(&other); }
   bool Equals(sk_sp<const DisplayList> other) const {
@@ -295,8 +332,10 @@ class DisplayList : public SkRefCnt {
               size_t nested_byte_count,
               unsigned int nested_op_count,
               const SkRect& bounds,
+              const SkRect& opaque_rect,
               bool can_apply_group_opacity,
-              sk_sp<const DlRTree> rtree);
+              sk_sp<const DlRTree> rtree,
+              sk_sp<const DlOpIndex> op_index);
 
   static uint32_t next_unique_id();
 
@@ -309,9 +348,11 @@ class DisplayList : public SkRefCnt {
 
   const uint32_t unique_id_;
   const SkRect bounds_;
+  const SkRect opaque_rect_;
 
   const bool can_apply_group_opacity_;
   const sk_sp<const DlRTree> rtree_;
+  const sk_sp<const DlOpIndex> op_index_;
 
   void Dispatch(Dispatcher& ctx,
                 uint8_t* ptr,
@@ -319,6 +360,7 @@ class DisplayList : public SkRefCnt {
                 Culler& culler) const;
 
   friend class DisplayListBuilder;
+  friend class DisplayListSerializer;
 };
 
 }  // namespace flutter
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_ATTRIBUTE_INTERNER_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_ATTRIBUTE_INTERNER_H_
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list_color_filter.h"
+#include "flutter/display_list/display_list_color_source.h"
+#include "flutter/display_list/display_list_comparable.h"
+#include "flutter/display_list/display_list_image_filter.h"
+#include "flutter/display_list/display_list_mask_filter.h"
+#include "flutter/display_list/display_list_path_effect.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A table of shared copies of the attributes of type |D| (i.e.
+// DlColorFilter, etc.) that a builder has seen, so that an attribute that
+// is set repeatedly with the same contents is only copied to the heap once
+// and all of its users hold the same object.
+//
+// Attributes are looked up by their type and size and then compared with
+// the content aware |Equals|, so the table works for every attribute class
+// without each of them having to implement a hash. Only the most recently
+// interned |kMaxCandidates| attributes of each type and size are kept for
+// comparison so that a stream of distinct attributes of the same type,
+// e.g. an animated blur, cannot make each lookup linear in its length.
+template <class D>
+class DlInternTable {
+ public:
+  static constexpr size_t kMaxCandidates = 16;
+
+  DlInternTable() = default;
+
+  // Returns a shared copy of |attribute| that is shared with any earlier
+  // call that was given an equal attribute, or nullptr if |attribute| is
+  // null.
+  std::shared_ptr<D> Intern(const D* attribute) {
+    if (attribute == nullptr) {
+      return nullptr;
+    }
+    auto& candidates = table_[Key(attribute)];
+    for (const std::shared_ptr<D>& candidate : candidates) {
+      if (Equals(static_cast<const D*>(candidate.get()), attribute)) {
+        hits_++;
+        return candidate;
+      }
+    }
+    if (candidates.size() >= kMaxCandidates) {
+      candidates.pop_back();
+    }
+    candidates.push_front(attribute->shared());
+    return candidates.front();
+  }
+
+  // The number of calls to |Intern| that returned an existing copy.
+  size_t hits() const { return hits_; }
+
+  void Clear() {
+    table_.clear();
+    hits_ = 0;
+  }
+
+ private:
+  static size_t Key(const D* attribute) {
+    return (static_cast<size_t>(attribute->type()) << 24) ^ attribute->size();
+  }
+
+  std::unordered_map<size_t, std::deque<std::shared_ptr<D>>> table_;
+  size_t hits_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlInternTable);
+};
+
+// The intern tables for all of the attributes that a |DisplayListBuilder|
+// holds shared copies of.
+//
+// Each builder has its own interner by default. An interner can also be
+// given to a series of builders, e.g. the builders recording each frame
+// of a picture, so that the attributes of the display lists they build
+// are the same objects from one frame to the next and the raster caches
+// find them equal with a pointer comparison. An interner is not thread
+// safe and must only be shared by builders used on the same thread.
+class DlAttributeInterner {
+ public:
+  DlAttributeInterner() = default;
+
+  DlInternTable<DlColorSource>& color_sources() { return color_sources_; }
+  DlInternTable<DlColorFilter>& color_filters() { return color_filters_; }
+  DlInternTable<DlImageFilter>& image_filters() { return image_filters_; }
+  DlInternTable<DlMaskFilter>& mask_filters() { return mask_filters_; }
+  DlInternTable<DlPathEffect>& path_effects() { return path_effects_; }
+
+  // The total number of attributes that were found in the tables rather
+  // than copied.
+  size_t hits() const {
+    return color_sources_.hits() + color_filters_.hits() +
+           image_filters_.hits() + mask_filters_.hits() +
+           path_effects_.hits();
+  }
+
+  // Releases all of the interned attributes, e.g. when the interner is
+  // shared across frames and the content it was interning has changed.
+  void Clear() {
+    color_sources_.Clear();
+    color_filters_.Clear();
+    image_filters_.Clear();
+    mask_filters_.Clear();
+    path_effects_.Clear();
+  }
+
+ private:
+  DlInternTable<DlColorSource> color_sources_;
+  DlInternTable<DlColorFilter> color_filters_;
+  DlInternTable<DlImageFilter> image_filters_;
+  DlInternTable<DlMaskFilter> mask_filters_;
+  DlInternTable<DlPathEffect> path_effects_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlAttributeInterner);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_ATTRIBUTE_INTERNER_H_
@@ -3,8 +3,14 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/display_list_benchmarks.h"
+
+#include <algorithm>
+#include <iterator>
+
 #include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_complexity_calibration.h"
 #include "flutter/display_list/display_list_flags.h"
+#include "flutter/fml/time/time_point.h"
 
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -1333,6 +1339,55 @@ void BM_SaveLayer(benchmark::State& state,
   surface_provider->Snapshot(filename);
 }
 
+// Measures the cost of each category of ops of the calibrated complexity
+// calculator on the backend and reports the fitted table as counters. See
+// display_list_complexity_calibration.h for how the table is measured.
+//
+// This is the same measurement that an embedder can run on the device to
+// install a table with DisplayListCalibratedComplexityCalculator's
+// SetCostTable.
+void BM_CalibrateComplexity(benchmark::State& state, BackendType backend_type) {
+  static constexpr const char* kCategoryNames[] = {
+      "Line",      "FillRect",    "StrokeRect", "FillOval", "StrokeOval",
+      "FillRRect", "StrokeRRect", "Path",       "Points",   "Vertices",
+      "Image",     "TextBlob",    "SaveLayer",  "Shadow",
+  };
+  static_assert(std::size(kCategoryNames) == kDlCostCategoryCount);
+
+  auto surface_provider = DlSurfaceProvider::Create(backend_type);
+  size_t length = DlComplexityCalibrator::kProbeCanvasSize;
+  surface_provider->InitializeSurface(length, length);
+  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
+  auto canvas = surface->getCanvas();
+
+  // Render each probe once to warm up caches of shaders and paths, then
+  // keep the fastest of a few runs.
+  auto timer = [&surface, canvas](const sk_sp<DisplayList>& display_list) {
+    display_list->RenderTo(canvas);
+    surface->flushAndSubmit(true);
+    fml::TimeDelta fastest = fml::TimeDelta::Max();
+    for (int i = 0; i < 3; i++) {
+      fml::TimePoint start = fml::TimePoint::Now();
+      display_list->RenderTo(canvas);
+      surface->flushAndSubmit(true);
+      fastest = std::min(fastest, fml::TimePoint::Now() - start);
+    }
+    return fastest;
+  };
+
+  DlComplexityCostTable table;
+  for ([[maybe_unused]] auto _ : state) {
+    table = DlComplexityCalibrator::Calibrate(timer);
+  }
+
+  for (size_t i = 0; i < kDlCostCategoryCount; i++) {
+    std::string name = kCategoryNames[i];
+    state.counters[name + "Fixed"] = table.costs[i].fixed;
+    state.counters[name + "PerUnit"] = table.costs[i].per_unit;
+  }
+  state.counters["AntiAliasPenalty"] = table.anti_alias_penalty;
+}
+
 #ifdef ENABLE_SOFTWARE_BENCHMARKS
 RUN_DISPLAYLIST_BENCHMARKS(Software)
 #endif
@@ -96,6 +96,7 @@ void BM_SaveLayer(benchmark::State& state,
                   BackendType backend_type,
                   unsigned attributes,
                   size_t save_depth);
+void BM_CalibrateComplexity(benchmark::State& state, BackendType backend_type);
 // clang-format off
 
 // DrawLine
@@ -533,6 +534,14 @@ void BM_SaveLayer(benchmark::State& state,
       ->UseRealTime()                                                   \
       ->Unit(benchmark::kMillisecond);
 
+// Calibration of the complexity calculators
+#define CALIBRATE_COMPLEXITY_BENCHMARKS(BACKEND)                        \
+  BENCHMARK_CAPTURE(BM_CalibrateComplexity, BACKEND,                    \
+                    BackendType::k##BACKEND##_Backend)                  \
+      ->Iterations(1)                                                   \
+      ->UseRealTime()                                                   \
+      ->Unit(benchmark::kMillisecond);
+
 // Applies stroke style and antialiasing
 #define STROKE_BENCHMARKS(BACKEND, ATTRIBUTES)                           \
   DRAW_LINE_BENCHMARKS(BACKEND, ATTRIBUTES)                              \
@@ -579,7 +588,8 @@ void BM_SaveLayer(benchmark::State& state,
   FILL_BENCHMARKS(BACKEND, kFilledStyle_Flag | kAntiAliasing_Flag)       \
   ANTI_ALIASING_BENCHMARKS(BACKEND, kEmpty_Flag)                         \
   ANTI_ALIASING_BENCHMARKS(BACKEND, kAntiAliasing_Flag)                  \
-  OTHER_BENCHMARKS(BACKEND, kEmpty_Flag)
+  OTHER_BENCHMARKS(BACKEND, kEmpty_Flag)                                 \
+  CALIBRATE_COMPLEXITY_BENCHMARKS(BACKEND)
 
 // clang-format on
 
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_bounds_kernels.h"
+
+#include <cstdint>
+
+namespace flutter {
+
+SkRect DlUnionRects(const SkRect* rects, size_t count, size_t stride) {
+  if (count == 0) {
+    return SkRect::MakeEmpty();
+  }
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(rects);
+  auto rect_at = [bytes, stride](size_t i) -> const SkRect& {
+    return *reinterpret_cast<const SkRect*>(bytes + i * stride);
+  };
+
+  // Two independent unions let consecutive minimums overlap in the
+  // pipeline instead of each waiting for the previous one.
+  DlBoundsVector even = DlBoundsVector::Empty();
+  DlBoundsVector odd = DlBoundsVector::Empty();
+  size_t i = 0;
+  for (; i + 1 < count; i += 2) {
+    even = even.Union(DlBoundsVector::FromRect(rect_at(i)));
+    odd = odd.Union(DlBoundsVector::FromRect(rect_at(i + 1)));
+  }
+  if (i < count) {
+    even = even.Union(DlBoundsVector::FromRect(rect_at(i)));
+  }
+  return even.Union(odd).ToRect();
+}
+
+}  // namespace flutter
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_BOUNDS_KERNELS_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_BOUNDS_KERNELS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#include "flutter/fml/build_config.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+#if defined(FML_ARCH_CPU_X86_FAMILY)
+#include <xmmintrin.h>
+#define DL_BOUNDS_KERNELS_SSE 1
+#elif defined(FML_ARCH_CPU_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DL_BOUNDS_KERNELS_NEON 1
+#endif
+
+namespace flutter {
+
+// A rect held in a single SSE or NEON register, for the unions and
+// intersections of bounds that are computed for every op recorded into a
+// DisplayList and for every node of its rtree.
+//
+// The rect is stored as {left, top, -right, -bottom}, so that the union of
+// two rects is a lane-wise minimum and their intersection is a lane-wise
+// maximum. Platforms without either instruction set use 4 floats.
+//
+// Unlike SkRect::join, |Union| does not skip empty rects, so callers only
+// pass it rects that they know to be non-empty.
+class DlBoundsVector {
+ public:
+  // The identity of |Union|, which converts back to an inverted rect.
+  static DlBoundsVector Empty() {
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    return DlBoundsVector(inf, inf, inf, inf);
+  }
+
+  static DlBoundsVector FromRect(const SkRect& rect) {
+#if defined(DL_BOUNDS_KERNELS_SSE)
+    return DlBoundsVector(_mm_xor_ps(_mm_loadu_ps(&rect.fLeft), SignMask()));
+#elif defined(DL_BOUNDS_KERNELS_NEON)
+    return DlBoundsVector(vmulq_f32(vld1q_f32(&rect.fLeft), Signs()));
+#else
+    return DlBoundsVector(rect.fLeft, rect.fTop, -rect.fRight,
+                          -rect.fBottom);
+#endif
+  }
+
+  static DlBoundsVector FromPoint(SkScalar x, SkScalar y) {
+    return DlBoundsVector(x, y, -x, -y);
+  }
+
+  DlBoundsVector Union(const DlBoundsVector& other) const {
+#if defined(DL_BOUNDS_KERNELS_SSE)
+    return DlBoundsVector(_mm_min_ps(lanes_, other.lanes_));
+#elif defined(DL_BOUNDS_KERNELS_NEON)
+    return DlBoundsVector(vminq_f32(lanes_, other.lanes_));
+#else
+    return DlBoundsVector(std::min(lanes_[0], other.lanes_[0]),
+                          std::min(lanes_[1], other.lanes_[1]),
+                          std::min(lanes_[2], other.lanes_[2]),
+                          std::min(lanes_[3], other.lanes_[3]));
+#endif
+  }
+
+  DlBoundsVector Intersect(const DlBoundsVector& other) const {
+#if defined(DL_BOUNDS_KERNELS_SSE)
+    return DlBoundsVector(_mm_max_ps(lanes_, other.lanes_));
+#elif defined(DL_BOUNDS_KERNELS_NEON)
+    return DlBoundsVector(vmaxq_f32(lanes_, other.lanes_));
+#else
+    return DlBoundsVector(std::max(lanes_[0], other.lanes_[0]),
+                          std::max(lanes_[1], other.lanes_[1]),
+                          std::max(lanes_[2], other.lanes_[2]),
+                          std::max(lanes_[3], other.lanes_[3]));
+#endif
+  }
+
+  SkRect ToRect() const {
+    SkRect rect;
+#if defined(DL_BOUNDS_KERNELS_SSE)
+    _mm_storeu_ps(&rect.fLeft, _mm_xor_ps(lanes_, SignMask()));
+#elif defined(DL_BOUNDS_KERNELS_NEON)
+    vst1q_f32(&rect.fLeft, vmulq_f32(lanes_, Signs()));
+#else
+    rect.setLTRB(lanes_[0], lanes_[1], -lanes_[2], -lanes_[3]);
+#endif
+    return rect;
+  }
+
+ private:
+#if defined(DL_BOUNDS_KERNELS_SSE)
+  explicit DlBoundsVector(__m128 lanes) : lanes_(lanes) {}
+  DlBoundsVector(float a, float b, float c, float d)
+      : lanes_(_mm_setr_ps(a, b, c, d)) {}
+
+  static __m128 SignMask() { return _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f); }
+
+  __m128 lanes_;
+#elif defined(DL_BOUNDS_KERNELS_NEON)
+  explicit DlBoundsVector(float32x4_t lanes) : lanes_(lanes) {}
+  DlBoundsVector(float a, float b, float c, float d) {
+    const float lanes[4] = {a, b, c, d};
+    lanes_ = vld1q_f32(lanes);
+  }
+
+  static float32x4_t Signs() {
+    static const float kSigns[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+    return vld1q_f32(kSigns);
+  }
+
+  float32x4_t lanes_;
+#else
+  DlBoundsVector(float a, float b, float c, float d) : lanes_{a, b, c, d} {}
+
+  float lanes_[4];
+#endif
+};
+
+// Returns the union of the |count| non-empty rects starting at |rects|,
+// which are |stride| bytes apart so that the rects can be members of a
+// larger struct. Returns an empty rect if |count| is 0.
+SkRect DlUnionRects(const SkRect* rects,
+                    size_t count,
+                    size_t stride = sizeof(SkRect));
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_BOUNDS_KERNELS_H_
@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_bounds_kernels.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<SkRect> GetTestRects() {
+  return {
+      SkRect::MakeLTRB(0, 0, 10, 10),        //
+      SkRect::MakeLTRB(-5, 3, 4, 20),        //
+      SkRect::MakeLTRB(2.5, -7, 30, 1),      //
+      SkRect::MakeLTRB(1, 1, 2, 2),          //
+      SkRect::MakeLTRB(100, 100, 101, 101),  //
+      SkRect::MakeLTRB(-1e6, 5, -1e5, 6),    //
+  };
+}
+
+TEST(DisplayListBoundsKernels, UnionMatchesJoin) {
+  auto rects = GetTestRects();
+  for (size_t count = 1; count <= rects.size(); count++) {
+    SkRect expected = SkRect::MakeEmpty();
+    DlBoundsVector bounds = DlBoundsVector::Empty();
+    for (size_t i = 0; i < count; i++) {
+      expected.join(rects[i]);
+      bounds = bounds.Union(DlBoundsVector::FromRect(rects[i]));
+    }
+    EXPECT_EQ(bounds.ToRect(), expected) << count << " rects";
+    EXPECT_EQ(DlUnionRects(rects.data(), count), expected) << count
+                                                           << " rects";
+  }
+  EXPECT_TRUE(DlUnionRects(rects.data(), 0).isEmpty());
+}
+
+TEST(DisplayListBoundsKernels, UnionWithStride) {
+  struct Entry {
+    SkRect bounds;
+    int id;
+  };
+  std::vector<Entry> entries;
+  SkRect expected = SkRect::MakeEmpty();
+  for (auto& rect : GetTestRects()) {
+    entries.push_back({rect, static_cast<int>(entries.size())});
+    expected.join(rect);
+  }
+  EXPECT_EQ(DlUnionRects(&entries[0].bounds, entries.size(), sizeof(Entry)),
+            expected);
+}
+
+TEST(DisplayListBoundsKernels, IntersectMatchesIntersect) {
+  auto rects = GetTestRects();
+  for (auto& a : rects) {
+    for (auto& b : rects) {
+      SkRect expected = a;
+      bool intersects = expected.intersect(b);
+      SkRect actual = DlBoundsVector::FromRect(a)
+                          .Intersect(DlBoundsVector::FromRect(b))
+                          .ToRect();
+      EXPECT_EQ(!actual.isEmpty(), intersects);
+      if (intersects) {
+        EXPECT_EQ(actual, expected);
+      }
+    }
+  }
+}
+
+TEST(DisplayListBoundsKernels, Points) {
+  DlBoundsVector bounds = DlBoundsVector::Empty();
+  EXPECT_GT(bounds.ToRect().fLeft, bounds.ToRect().fRight);
+  bounds = bounds.Union(DlBoundsVector::FromPoint(3, 4));
+  EXPECT_EQ(bounds.ToRect(), SkRect::MakeLTRB(3, 4, 3, 4));
+  bounds = bounds.Union(DlBoundsVector::FromPoint(-2, 8));
+  EXPECT_EQ(bounds.ToRect(), SkRect::MakeLTRB(-2, 4, 3, 8));
+}
+
+}  // namespace testing
+}  // namespace flutter
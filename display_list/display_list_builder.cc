@@ -4,8 +4,11 @@
 
 #include "flutter/display_list/display_list_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_blend_mode.h"
+#include "flutter/display_list/display_list_bounds_kernels.h"
 #include "flutter/display_list/display_list_canvas_dispatcher.h"
 #include "flutter/display_list/display_list_color_source.h"
 #include "flutter/display_list/display_list_ops.h"
@@ -13,8 +16,6 @@
 
 namespace flutter {
 
-#define DL_BUILDER_PAGE 4096
-
 // CopyV(dst, src,n, src,n, ...) copies any number of typed srcs into dst.
 static void CopyV(void* dst) {}
 
@@ -33,20 +34,15 @@ static void CopyV(void* dst, const S* src, int n, Rest&&... rest) {
   CopyV(dst, std::forward<Rest>(rest)...);
 }
 
-static constexpr inline bool is_power_of_two(int value) {
-  return (value & (value - 1)) == 0;
-}
-
 template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   size_t size = SkAlignPtr(sizeof(T) + pod);
   FML_DCHECK(size < (1 << 24));
   if (used_ + size > allocated_) {
-    static_assert(is_power_of_two(DL_BUILDER_PAGE),
-                  "This math needs updating for non-pow2.");
-    // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
+    // The storage grows in pooled power of two blocks. A builder that records
+    // again after Build() starts out at the size of the list it last built.
+    storage_.realloc(std::max(used_ + size, last_build_bytes_));
+    allocated_ = storage_.capacity();
     FML_DCHECK(storage_.get());
     memset(storage_.get() + used_, 0, allocated_ - used_);
   }
@@ -71,16 +67,23 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   int nested_count = nested_op_count_;
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
-  storage_.realloc(bytes);
+  last_build_bytes_ = bytes;
   bool compatible = layer_stack_.back().is_group_opacity_compatible();
-  return sk_sp<DisplayList>(new DisplayList(std::move(storage_), bytes, count,
-                                            nested_bytes, nested_count,
-                                            bounds(), compatible, rtree()));
+  SkRect opaque_rect = opaque_rect_;
+  opaque_rect_.setEmpty();
+  // The next recording grows back to |last_build_bytes_| without the list
+  // having to retain the spare capacity.
+  storage_.shrink(bytes);
+  sk_sp<DlOpIndex> op_index = accumulator()->op_index(storage_.get(), bytes);
+  return sk_sp<DisplayList>(new DisplayList(
+      std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
+      opaque_rect, compatible, rtree(), std::move(op_index)));
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
                                        bool prepare_rtree)
-    : tracker_(cull_rect, SkMatrix::I()) {
+    : tracker_(cull_rect, SkMatrix::I()),
+      interner_(std::make_shared<DlAttributeInterner>()) {
   if (prepare_rtree) {
     accumulator_ = std::make_unique<RTreeBoundsAccumulator>();
   } else {
@@ -164,7 +167,7 @@ void DisplayListBuilder::onSetColorSource(const DlColorSource* source) {
     current_.setColorSource(nullptr);
     Push<ClearColorSourceOp>(0, 0);
   } else {
-    current_.setColorSource(source->shared());
+    current_.setColorSource(interner_->color_sources().Intern(source));
     switch (source->type()) {
       case DlColorSourceType::kColor: {
         const DlColorColorSource* color_source = source->asColor();
@@ -232,7 +235,9 @@ void DisplayListBuilder::onSetImageFilter(const DlImageFilter* filter) {
     current_.setImageFilter(nullptr);
     Push<ClearImageFilterOp>(0, 0);
   } else {
-    current_.setImageFilter(filter->shared());
+    std::shared_ptr<DlImageFilter> shared_filter =
+        interner_->image_filters().Intern(filter);
+    current_.setImageFilter(shared_filter);
     switch (filter->type()) {
       case DlImageFilterType::kBlur: {
         const DlBlurImageFilter* blur_filter = filter->asBlur();
@@ -265,7 +270,7 @@ void DisplayListBuilder::onSetImageFilter(const DlImageFilter* filter) {
       case DlImageFilterType::kComposeFilter:
       case DlImageFilterType::kLocalMatrixFilter:
       case DlImageFilterType::kColorFilter: {
-        Push<SetSharedImageFilterOp>(0, 0, filter);
+        Push<SetSharedImageFilterOp>(0, 0, std::move(shared_filter));
         break;
       }
       case DlImageFilterType::kUnknown: {
@@ -280,7 +285,7 @@ void DisplayListBuilder::onSetColorFilter(const DlColorFilter* filter) {
     current_.setColorFilter(nullptr);
     Push<ClearColorFilterOp>(0, 0);
   } else {
-    current_.setColorFilter(filter->shared());
+    current_.setColorFilter(interner_->color_filters().Intern(filter));
     switch (filter->type()) {
       case DlColorFilterType::kBlend: {
         const DlBlendColorFilter* blend_filter = filter->asBlend();
@@ -319,7 +324,7 @@ void DisplayListBuilder::onSetPathEffect(const DlPathEffect* effect) {
     current_.setPathEffect(nullptr);
     Push<ClearPathEffectOp>(0, 0);
   } else {
-    current_.setPathEffect(effect->shared());
+    current_.setPathEffect(interner_->path_effects().Intern(effect));
     switch (effect->type()) {
       case DlPathEffectType::kDash: {
         const DlDashPathEffect* dash_effect = effect->asDash();
@@ -339,7 +344,7 @@ void DisplayListBuilder::onSetMaskFilter(const DlMaskFilter* filter) {
     current_.setMaskFilter(nullptr);
     Push<ClearMaskFilterOp>(0, 0);
   } else {
-    current_.setMaskFilter(filter->shared());
+    current_.setMaskFilter(interner_->mask_filters().Intern(filter));
     switch (filter->type()) {
       case DlMaskFilterType::kBlur: {
         const DlBlurMaskFilter* blur_filter = filter->asBlur();
@@ -461,9 +466,13 @@ void DisplayListBuilder::checkForDeferredSave() {
 }
 
 void DisplayListBuilder::save() {
+  bool renders_to_layer = current_layer_->renders_to_layer_;
+  bool has_complex_clip = current_layer_->has_complex_clip_;
   layer_stack_.emplace_back();
   current_layer_ = &layer_stack_.back();
   current_layer_->has_deferred_save_op_ = true;
+  current_layer_->renders_to_layer_ = renders_to_layer;
+  current_layer_->has_complex_clip_ = has_complex_clip;
   tracker_.save();
   accumulator()->save();
 }
@@ -552,9 +561,11 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
   SaveLayerOptions options = in_options.without_optimizations();
   size_t save_layer_offset = used_;
   if (backdrop) {
+    auto shared_backdrop = interner_->image_filters().Intern(backdrop);
     bounds  //
-        ? Push<SaveLayerBackdropBoundsOp>(0, 1, options, *bounds, backdrop)
-        : Push<SaveLayerBackdropOp>(0, 1, options, backdrop);
+        ? Push<SaveLayerBackdropBoundsOp>(0, 1, options, *bounds,
+                                          std::move(shared_backdrop))
+        : Push<SaveLayerBackdropOp>(0, 1, options, std::move(shared_backdrop));
   } else {
     bounds  //
         ? Push<SaveLayerBoundsOp>(0, 1, options, *bounds)
@@ -583,6 +594,7 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
   tracker_.save();
   accumulator()->save();
   current_layer_ = &layer_stack_.back();
+  current_layer_->renders_to_layer_ = true;
   if (options.renders_with_attributes()) {
     // |current_opacity_compatibility_| does not take an ImageFilter into
     // account because an individual primitive with an ImageFilter can apply
@@ -732,6 +744,7 @@ void DisplayListBuilder::clipRect(const SkRect& rect,
       Push<ClipDifferenceRectOp>(0, 1, rect, is_aa);
       break;
   }
+  UpdateClipComplexity(rect, clip_op, is_aa);
   tracker_.clipRect(rect, clip_op, is_aa);
 }
 void DisplayListBuilder::clipRRect(const SkRRect& rrect,
@@ -749,6 +762,7 @@ void DisplayListBuilder::clipRRect(const SkRRect& rrect,
         Push<ClipDifferenceRRectOp>(0, 1, rrect, is_aa);
         break;
     }
+    current_layer_->has_complex_clip_ = true;
     tracker_.clipRRect(rrect, clip_op, is_aa);
   }
 }
@@ -781,6 +795,7 @@ void DisplayListBuilder::clipPath(const SkPath& path,
       Push<ClipDifferencePathOp>(0, 1, path, is_aa);
       break;
   }
+  current_layer_->has_complex_clip_ = true;
   tracker_.clipPath(path, clip_op, is_aa);
 }
 
@@ -792,6 +807,9 @@ void DisplayListBuilder::drawPaint() {
   Push<DrawPaintOp>(0, 1);
   CheckLayerOpacityCompatibility();
   AccumulateUnbounded();
+  if (IsOpaqueFill()) {
+    AccumulateOpaqueRect(nullptr);
+  }
 }
 void DisplayListBuilder::drawPaint(const DlPaint& paint) {
   setAttributesFromDlPaint(paint, DisplayListOpFlags::kDrawPaintFlags);
@@ -801,6 +819,10 @@ void DisplayListBuilder::drawColor(DlColor color, DlBlendMode mode) {
   Push<DrawColorOp>(0, 1, color, mode);
   CheckLayerOpacityCompatibility(mode);
   AccumulateUnbounded();
+  if (color.isOpaque() &&
+      (mode == DlBlendMode::kSrcOver || mode == DlBlendMode::kSrc)) {
+    AccumulateOpaqueRect(nullptr);
+  }
 }
 void DisplayListBuilder::drawLine(const SkPoint& p0, const SkPoint& p1) {
   Push<DrawLineOp>(0, 1, p0, p1);
@@ -821,6 +843,9 @@ void DisplayListBuilder::drawRect(const SkRect& rect) {
   Push<DrawRectOp>(0, 1, rect);
   CheckLayerOpacityCompatibility();
   AccumulateOpBounds(rect, kDrawRectFlags);
+  if (IsOpaqueFill()) {
+    AccumulateOpaqueRect(&rect);
+  }
 }
 void DisplayListBuilder::drawRect(const SkRect& rect, const DlPaint& paint) {
   setAttributesFromDlPaint(paint, DisplayListOpFlags::kDrawRectFlags);
@@ -955,6 +980,7 @@ void DisplayListBuilder::drawPoints(SkCanvas::PointMode mode,
   // bounds of every sub-primitive.
   // See: https://fiddle.skia.org/c/228459001d2de8db117ce25ef5cedb0c
   UpdateLayerOpacityCompatibility(false);
+  CheckOpaqueRectBlend();
 }
 void DisplayListBuilder::drawPoints(SkCanvas::PointMode mode,
                                     uint32_t count,
@@ -986,6 +1012,7 @@ void DisplayListBuilder::drawSkVertices(const sk_sp<SkVertices> vertices,
   // Although, examination of the |mode| might find some predictable
   // cases.
   UpdateLayerOpacityCompatibility(false);
+  CheckOpaqueRectBlend();
   AccumulateOpBounds(vertices->bounds(), kDrawVerticesFlags);
 }
 void DisplayListBuilder::drawVertices(const DlVertices* vertices,
@@ -997,6 +1024,7 @@ void DisplayListBuilder::drawVertices(const DlVertices* vertices,
   // Although, examination of the |mode| might find some predictable
   // cases.
   UpdateLayerOpacityCompatibility(false);
+  CheckOpaqueRectBlend();
   AccumulateOpBounds(vertices->bounds(), kDrawVerticesFlags);
 }
 void DisplayListBuilder::drawVertices(const DlVertices* vertices,
@@ -1151,6 +1179,7 @@ void DisplayListBuilder::drawAtlas(const sk_sp<DlImage> atlas,
   // on it to distribute the opacity without overlap without checking all
   // of the transforms and texture rectangles.
   UpdateLayerOpacityCompatibility(false);
+  CheckOpaqueRectBlend();
 
   SkPoint quad[4];
   RectBoundsAccumulator atlasBounds;
@@ -1216,6 +1245,8 @@ void DisplayListBuilder::drawPicture(const sk_sp<SkPicture> picture,
   nested_op_count_ += picture->approximateOpCount(true) - 1;
   nested_bytes_ += picture->approximateBytesUsed();
   CheckLayerOpacityCompatibility(render_with_attributes);
+  // The ops of the picture may use blend modes that uncover the surface.
+  ClearOpaqueRect();
 }
 void DisplayListBuilder::drawDisplayList(
     const sk_sp<DisplayList> display_list) {
@@ -1249,6 +1280,9 @@ void DisplayListBuilder::drawDisplayList(
   nested_op_count_ += display_list->op_count(true) - 1;
   nested_bytes_ += display_list->bytes(true);
   UpdateLayerOpacityCompatibility(display_list->can_apply_group_opacity());
+  // The ops of the nested list may use blend modes that uncover the
+  // surface even if the list itself covers an opaque rect.
+  ClearOpaqueRect();
 }
 void DisplayListBuilder::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                       SkScalar x,
@@ -1362,11 +1396,89 @@ void DisplayListBuilder::AccumulateOpBounds(SkRect& bounds,
 }
 void DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
   tracker_.mapRect(&bounds);
-  if (bounds.intersect(tracker_.device_cull_rect())) {
+  SkRect clipped =
+      DlBoundsVector::FromRect(bounds)
+          .Intersect(DlBoundsVector::FromRect(tracker_.device_cull_rect()))
+          .ToRect();
+  if (clipped.fLeft < clipped.fRight && clipped.fTop < clipped.fBottom) {
+    bounds = clipped;
     accumulator()->accumulate(bounds, op_index_ - 1);
   }
 }
 
+bool DisplayListBuilder::PreservesOpaqueDestination(DlBlendMode mode) {
+  // Each of the following modes produces a result alpha of less than 1
+  // over an opaque destination for some source, or for every source.
+  switch (mode) {
+    case DlBlendMode::kClear:     // ra = 0
+    case DlBlendMode::kSrc:       // ra = sa
+    case DlBlendMode::kSrcIn:     // ra = sa * da
+    case DlBlendMode::kDstIn:     // ra = da * sa
+    case DlBlendMode::kSrcOut:    // ra = sa * (1-da)
+    case DlBlendMode::kDstOut:    // ra = da * (1-sa)
+    case DlBlendMode::kDstATop:   // ra = sa
+    case DlBlendMode::kXor:       // ra = sa + da - 2*sa*da
+    case DlBlendMode::kModulate:  // ra = sa * da
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool DisplayListBuilder::IsOpaqueFill() const {
+  if (current_blender_ || (current_.getBlendMode() != DlBlendMode::kSrcOver &&
+                           current_.getBlendMode() != DlBlendMode::kSrc)) {
+    return false;
+  }
+  if (current_.getDrawStyle() != DlDrawStyle::kFill ||
+      !current_.getColor().isOpaque() || current_.isInvertColors()) {
+    return false;
+  }
+  if (current_.getColorFilter() || current_.getImageFilter() ||
+      current_.getMaskFilter() || current_.getPathEffect()) {
+    return false;
+  }
+  auto source = current_.getColorSource();
+  return !source || source->is_opaque();
+}
+
+void DisplayListBuilder::AccumulateOpaqueRect(const SkRect* rect) {
+  if (!CanAccumulateOpaqueRect()) {
+    return;
+  }
+  SkRect opaque = tracker_.device_cull_rect();
+  if (rect) {
+    SkRect mapped = *rect;
+    if (!tracker_.mapRect(&mapped) || !opaque.intersect(mapped)) {
+      return;
+    }
+  }
+  if (opaque.isEmpty() || opaque_rect_.contains(opaque)) {
+    return;
+  }
+  if (opaque.contains(opaque_rect_) ||
+      opaque.width() * opaque.height() >
+          opaque_rect_.width() * opaque_rect_.height()) {
+    opaque_rect_ = opaque;
+  }
+}
+
+void DisplayListBuilder::UpdateClipComplexity(const SkRect& rect,
+                                              SkClipOp op,
+                                              bool is_aa) {
+  if (op == SkClipOp::kDifference) {
+    current_layer_->has_complex_clip_ = true;
+    return;
+  }
+  // The tracker rounds out the bounds of anti-aliased clips, which then
+  // only cover their edge pixels partially unless they are integral.
+  SkRect mapped = rect;
+  if (!tracker_.mapRect(&mapped) ||
+      (is_aa && mapped != SkRect::Make(mapped.roundOut()))) {
+    current_layer_->has_complex_clip_ = true;
+  }
+}
+
 bool DisplayListBuilder::paint_nops_on_transparency() {
   // SkImageFilter::canComputeFastBounds tests for transparency behavior
   // This test assumes that the blend mode checked down below will
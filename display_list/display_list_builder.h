@@ -6,6 +6,7 @@
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_BUILDER_H_
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_attribute_interner.h"
 #include "flutter/display_list/display_list_blend_mode.h"
 #include "flutter/display_list/display_list_comparable.h"
 #include "flutter/display_list/display_list_dispatcher.h"
@@ -41,6 +42,18 @@ class DisplayListBuilder final : public virtual Dispatcher,
 
   ~DisplayListBuilder();
 
+  // Replaces the table that the shared copies of the color sources,
+  // filters and effects set on this builder are interned in, so that they
+  // are shared with the other builders using |interner|. Attributes that
+  // were already set keep the copies they were given.
+  void SetAttributeInterner(std::shared_ptr<DlAttributeInterner> interner) {
+    FML_DCHECK(interner);
+    interner_ = std::move(interner);
+  }
+  const std::shared_ptr<DlAttributeInterner>& attribute_interner() const {
+    return interner_;
+  }
+
   void setAntiAlias(bool aa) override {
     if (current_.isAntiAlias() != aa) {
       onSetAntiAlias(aa);
@@ -366,6 +379,7 @@ class DisplayListBuilder final : public virtual Dispatcher,
   DisplayListStorage storage_;
   size_t used_ = 0;
   size_t allocated_ = 0;
+  size_t last_build_bytes_ = 0;
   int render_op_count_ = 0;
   int op_index_ = 0;
 
@@ -470,6 +484,17 @@ class DisplayListBuilder final : public virtual Dispatcher,
     bool is_unbounded_;
     bool has_deferred_save_op_ = false;
 
+    // Whether the ops of this layer render into a saveLayer, either this
+    // one or an enclosing one, rather than to the surface itself. Only the
+    // ops that render to the surface can change the opaque rect.
+    bool renders_to_layer_ = false;
+
+    // Whether the clip of this layer may not be the device rect that the
+    // tracker reports as its |device_cull_rect|, e.g. after a difference,
+    // rounded or path clip, so that an op which floods the clip does not
+    // necessarily cover that rect.
+    bool has_complex_clip_ = false;
+
     friend class DisplayListBuilder;
   };
 
@@ -516,9 +541,15 @@ class DisplayListBuilder final : public virtual Dispatcher,
   // If the flag is false then the rendering op will be able to substitute
   // a default Paint object with the opacity applied using the default SrcOver
   // blend mode which is always compatible with applying an inherited opacity.
+  //
+  // These checks also empty the opaque rect if the op could uncover some
+  // of it. The ops that don't come through them check that themselves.
   void CheckLayerOpacityCompatibility(bool uses_blend_attribute = true) {
     UpdateLayerOpacityCompatibility(!uses_blend_attribute ||
                                     current_opacity_compatibility_);
+    if (uses_blend_attribute) {
+      CheckOpaqueRectBlend();
+    }
   }
 
   void CheckLayerOpacityHairlineCompatibility() {
@@ -526,6 +557,7 @@ class DisplayListBuilder final : public virtual Dispatcher,
         current_opacity_compatibility_ &&
         (current_.getDrawStyle() == DlDrawStyle::kFill ||
          current_.getStrokeWidth() > 0));
+    CheckOpaqueRectBlend();
   }
 
   // Check for opacity compatibility for an op that ignores the current
@@ -533,8 +565,52 @@ class DisplayListBuilder final : public virtual Dispatcher,
   // This is only used by |drawColor| currently.
   void CheckLayerOpacityCompatibility(DlBlendMode mode) {
     UpdateLayerOpacityCompatibility(IsOpacityCompatible(mode));
+    if (!PreservesOpaqueDestination(mode)) {
+      ClearOpaqueRect();
+    }
+  }
+
+  // Returns true if rendering with |mode| onto an opaque pixel always
+  // leaves it opaque, whatever the source is.
+  static bool PreservesOpaqueDestination(DlBlendMode mode);
+
+  // Whether the current attributes fill the geometry of an op with
+  // opaque pixels, i.e. an opaque color or color source, no filters or
+  // effects that change its coverage and a SrcOver or Src blend.
+  bool IsOpaqueFill() const;
+
+  // Whether an op renders to the surface, under a clip that is exactly
+  // its |device_cull_rect|, so that its opaque coverage is known.
+  bool CanAccumulateOpaqueRect() const {
+    return !current_layer_->renders_to_layer_ &&
+           !current_layer_->has_complex_clip_;
+  }
+
+  // Empties the opaque rect if an op that renders to the surface with the
+  // current blend attributes could leave some of it less than opaque.
+  void CheckOpaqueRectBlend() {
+    if (current_blender_ ||
+        !PreservesOpaqueDestination(current_.getBlendMode())) {
+      ClearOpaqueRect();
+    }
+  }
+
+  // Empties the opaque rect for an op that renders to the surface.
+  void ClearOpaqueRect() {
+    if (!current_layer_->renders_to_layer_) {
+      opaque_rect_.setEmpty();
+    }
   }
 
+  // Records that an op covers |rect|, or the entire clip if |rect| is
+  // null, with opaque pixels. The opaque rect keeps the largest of the
+  // rects it is given since it was last cleared.
+  void AccumulateOpaqueRect(const SkRect* rect);
+
+  // Marks the clip of the current layer as complex unless intersecting it
+  // with |rect| under the current matrix leaves it a device rect.
+  void UpdateClipComplexity(const SkRect& rect, SkClipOp op, bool is_aa);
+
   void onSetAntiAlias(bool aa);
   void onSetDither(bool dither);
   void onSetInvertColors(bool invert);
@@ -615,7 +691,12 @@ class DisplayListBuilder final : public virtual Dispatcher,
   // and clipping against the current clip.
   void AccumulateBounds(SkRect& bounds);
 
+  // The largest rect, in device coordinates, that the ops rendered to the
+  // surface so far are known to cover with opaque pixels.
+  SkRect opaque_rect_ = SkRect::MakeEmpty();
+
   DlPaint current_;
+  std::shared_ptr<DlAttributeInterner> interner_;
   // If |current_blender_| is set then ignore |current_.getBlendMode()|
   sk_sp<SkBlender> current_blender_;
 };
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/display_list_rtree.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/allocation_counter.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 
 namespace flutter {
 namespace {
@@ -51,22 +54,36 @@ bool NeedPrepareRTree(DisplayListBuilderBenchmarkType type) {
          type == DisplayListBuilderBenchmarkType::kBoundsAndRtree;
 }
 
+// Reports the heap allocations per iteration the benchmark made since
+// |allocations| was created. The benchmarks link the allocation counter hooks.
+void ReportAllocations(benchmark::State& state,
+                       const fml::ScopedAllocationCount& allocations) {
+  auto count = allocations.Get();
+  state.counters["Allocations"] =
+      benchmark::Counter(count.allocations, benchmark::Counter::kAvgIterations);
+  state.counters["AllocatedBytes"] =
+      benchmark::Counter(count.bytes, benchmark::Counter::kAvgIterations);
+}
+
 }  // namespace
 
 static void BM_DisplayListBuilderDefault(benchmark::State& state,
                                          DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     InvokeAllRenderingOps(builder);
     Complete(builder, type);
   }
+  ReportAllocations(state, allocations);
 }
 
 static void BM_DisplayListBuilderWithScaleAndTranslate(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     builder.scale(3.5, 3.5);
@@ -74,12 +91,14 @@ static void BM_DisplayListBuilderWithScaleAndTranslate(
     InvokeAllRenderingOps(builder);
     Complete(builder, type);
   }
+  ReportAllocations(state, allocations);
 }
 
 static void BM_DisplayListBuilderWithPerspective(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     builder.transformFullPerspective(0, 1, 0, 12, 1, 0, 0, 33, 3, 2, 5, 29, 0,
@@ -87,6 +106,7 @@ static void BM_DisplayListBuilderWithPerspective(
     InvokeAllRenderingOps(builder);
     Complete(builder, type);
   }
+  ReportAllocations(state, allocations);
 }
 
 static void BM_DisplayListBuilderWithClipRect(
@@ -94,18 +114,21 @@ static void BM_DisplayListBuilderWithClipRect(
     DisplayListBuilderBenchmarkType type) {
   SkRect clip_bounds = SkRect::MakeLTRB(6.5, 7.3, 90.2, 85.7);
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     builder.clipRect(clip_bounds, SkClipOp::kIntersect, true);
     InvokeAllRenderingOps(builder);
     Complete(builder, type);
   }
+  ReportAllocations(state, allocations);
 }
 
 static void BM_DisplayListBuilderWithSaveLayer(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     for (auto& group : allRenderingOps) {
@@ -118,6 +141,7 @@ static void BM_DisplayListBuilderWithSaveLayer(
     }
     Complete(builder, type);
   }
+  ReportAllocations(state, allocations);
 }
 
 static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
@@ -127,6 +151,7 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   layer_paint.setImageFilter(&testing::kTestBlurImageFilter1);
   SkRect layer_bounds = SkRect::MakeLTRB(6.5, 7.3, 35.2, 42.7);
   bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     for (auto& group : allRenderingOps) {
@@ -139,6 +164,47 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
     }
     Complete(builder, type);
   }
+  ReportAllocations(state, allocations);
+}
+
+// Records |state.range(0)| glyph runs laid out in lines as in a long
+// paragraph, which is dominated by the cost of accumulating the bounds of
+// each op.
+static void BM_DisplayListBuilderWithTextBlobs(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  auto blob = SkTextBlob::MakeFromString("Glyphs", SkFont());
+  size_t run_count = state.range(0);
+  bool prepare_rtree = NeedPrepareRTree(type);
+  fml::ScopedAllocationCount allocations;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(prepare_rtree);
+    builder.scale(1.5, 1.5);
+    for (size_t i = 0; i < run_count; i++) {
+      builder.drawTextBlob(blob, (i % 40) * 30.0f, (i / 40) * 14.0f);
+    }
+    Complete(builder, type);
+  }
+  ReportAllocations(state, allocations);
+  state.counters["GlyphRuns"] = run_count;
+}
+
+// Builds an rtree over |state.range(0)| rects in the layout of the
+// text benchmark above.
+static void BM_DlRTreeBulkBuild(benchmark::State& state) {
+  size_t rect_count = state.range(0);
+  std::vector<SkRect> rects;
+  std::vector<int> ids;
+  for (size_t i = 0; i < rect_count; i++) {
+    rects.push_back(
+        SkRect::MakeXYWH((i % 40) * 30.0f, (i / 40) * 14.0f, 28.0f, 12.0f));
+    ids.push_back(i);
+  }
+  while (state.KeepRunning()) {
+    auto rtree = sk_make_sp<DlRTree>(rects.data(), rects.size(), ids.data());
+    benchmark::DoNotOptimize(rtree);
+  }
+  state.counters["Rects"] = rect_count;
 }
 
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
@@ -243,4 +309,34 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSaveLayerAndImageFilter,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithTextBlobs,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithTextBlobs,
+                  kBounds,
+                  DisplayListBuilderBenchmarkType::kBounds)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithTextBlobs,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithTextBlobs,
+                  kBoundsAndRtree,
+                  DisplayListBuilderBenchmarkType::kBoundsAndRtree)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_DlRTreeBulkBuild)
+    ->RangeMultiplier(4)
+    ->Range(1024, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
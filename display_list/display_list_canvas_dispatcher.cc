@@ -12,6 +12,10 @@ namespace flutter {
 const SkScalar kLightHeight = 600;
 const SkScalar kLightRadius = 800;
 
+DisplayListCanvasDispatcher::~DisplayListCanvasDispatcher() {
+  Flush();
+}
+
 const SkPaint* DisplayListCanvasDispatcher::safe_paint(bool use_attributes) {
   if (use_attributes) {
     // The accumulated SkPaint object will already have incorporated
@@ -26,6 +30,7 @@ const SkPaint* DisplayListCanvasDispatcher::safe_paint(bool use_attributes) {
 }
 
 void DisplayListCanvasDispatcher::save() {
+  Flush();
   canvas_->save();
   // save has no impact on attributes, but it needs to register a record
   // on the restore stack so that the eventual call to restore() will
@@ -36,12 +41,14 @@ void DisplayListCanvasDispatcher::save() {
   save_opacity(opacity());
 }
 void DisplayListCanvasDispatcher::restore() {
+  Flush();
   canvas_->restore();
   restore_opacity();
 }
 void DisplayListCanvasDispatcher::saveLayer(const SkRect* bounds,
                                             const SaveLayerOptions options,
                                             const DlImageFilter* backdrop) {
+  Flush();
   if (bounds == nullptr && options.can_distribute_opacity() &&
       backdrop == nullptr) {
     // We know that:
@@ -73,15 +80,19 @@ void DisplayListCanvasDispatcher::saveLayer(const SkRect* bounds,
 }
 
 void DisplayListCanvasDispatcher::translate(SkScalar tx, SkScalar ty) {
+  Flush();
   canvas_->translate(tx, ty);
 }
 void DisplayListCanvasDispatcher::scale(SkScalar sx, SkScalar sy) {
+  Flush();
   canvas_->scale(sx, sy);
 }
 void DisplayListCanvasDispatcher::rotate(SkScalar degrees) {
+  Flush();
   canvas_->rotate(degrees);
 }
 void DisplayListCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
+  Flush();
   canvas_->skew(sx, sy);
 }
 // clang-format off
@@ -89,6 +100,7 @@ void DisplayListCanvasDispatcher::skew(SkScalar sx, SkScalar sy) {
 void DisplayListCanvasDispatcher::transform2DAffine(
     SkScalar mxx, SkScalar mxy, SkScalar mxt,
     SkScalar myx, SkScalar myy, SkScalar myt) {
+  Flush();
   // Internally concat(SkMatrix) gets redirected to concat(SkM44)
   // so we just jump directly to the SkM44 version
   canvas_->concat(SkM44(mxx, mxy, 0, mxt,
@@ -102,6 +114,7 @@ void DisplayListCanvasDispatcher::transformFullPerspective(
     SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
     SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
     SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) {
+  Flush();
   canvas_->concat(SkM44(mxx, mxy, mxz, mxt,
                         myx, myy, myz, myt,
                         mzx, mzy, mzz, mzt,
@@ -109,26 +122,31 @@ void DisplayListCanvasDispatcher::transformFullPerspective(
 }
 // clang-format on
 void DisplayListCanvasDispatcher::transformReset() {
+  Flush();
   canvas_->resetMatrix();
 }
 
 void DisplayListCanvasDispatcher::clipRect(const SkRect& rect,
                                            SkClipOp clip_op,
                                            bool is_aa) {
+  Flush();
   canvas_->clipRect(rect, clip_op, is_aa);
 }
 void DisplayListCanvasDispatcher::clipRRect(const SkRRect& rrect,
                                             SkClipOp clip_op,
                                             bool is_aa) {
+  Flush();
   canvas_->clipRRect(rrect, clip_op, is_aa);
 }
 void DisplayListCanvasDispatcher::clipPath(const SkPath& path,
                                            SkClipOp clip_op,
                                            bool is_aa) {
+  Flush();
   canvas_->clipPath(path, clip_op, is_aa);
 }
 
 void DisplayListCanvasDispatcher::drawPaint() {
+  Flush();
   const SkPaint& sk_paint = paint();
   SkImageFilter* filter = sk_paint.getImageFilter();
   if (filter && !filter->asColorFilter(nullptr)) {
@@ -139,6 +157,7 @@ void DisplayListCanvasDispatcher::drawPaint() {
   canvas_->drawPaint(sk_paint);
 }
 void DisplayListCanvasDispatcher::drawColor(DlColor color, DlBlendMode mode) {
+  Flush();
   // SkCanvas::drawColor(SkColor) does the following conversion anyway
   // We do it here manually to increase precision on applying opacity
   SkColor4f color4f = SkColor4f::FromColor(color);
@@ -147,54 +166,85 @@ void DisplayListCanvasDispatcher::drawColor(DlColor color, DlBlendMode mode) {
 }
 void DisplayListCanvasDispatcher::drawLine(const SkPoint& p0,
                                            const SkPoint& p1) {
+  Flush();
   canvas_->drawLine(p0, p1, paint());
 }
 void DisplayListCanvasDispatcher::drawRect(const SkRect& rect) {
-  canvas_->drawRect(rect, paint());
+  const SkPaint& sk_paint = paint();
+  if (!CanBatchRect(sk_paint)) {
+    Flush();
+    canvas_->drawRect(rect, sk_paint);
+    return;
+  }
+  if (batch_type_ != BatchType::kRects || sk_paint != batch_paint_) {
+    Flush();
+    batch_type_ = BatchType::kRects;
+    batch_paint_ = sk_paint;
+  }
+  batched_rects_.push_back(rect.makeSorted());
 }
 void DisplayListCanvasDispatcher::drawOval(const SkRect& bounds) {
+  Flush();
   canvas_->drawOval(bounds, paint());
 }
 void DisplayListCanvasDispatcher::drawCircle(const SkPoint& center,
                                              SkScalar radius) {
+  Flush();
   canvas_->drawCircle(center, radius, paint());
 }
 void DisplayListCanvasDispatcher::drawRRect(const SkRRect& rrect) {
+  Flush();
   canvas_->drawRRect(rrect, paint());
 }
 void DisplayListCanvasDispatcher::drawDRRect(const SkRRect& outer,
                                              const SkRRect& inner) {
+  Flush();
   canvas_->drawDRRect(outer, inner, paint());
 }
 void DisplayListCanvasDispatcher::drawPath(const SkPath& path) {
+  Flush();
   canvas_->drawPath(path, paint());
 }
 void DisplayListCanvasDispatcher::drawArc(const SkRect& bounds,
                                           SkScalar start,
                                           SkScalar sweep,
                                           bool useCenter) {
+  Flush();
   canvas_->drawArc(bounds, start, sweep, useCenter, paint());
 }
 void DisplayListCanvasDispatcher::drawPoints(SkCanvas::PointMode mode,
                                              uint32_t count,
                                              const SkPoint pts[]) {
+  Flush();
   canvas_->drawPoints(mode, count, pts, paint());
 }
 void DisplayListCanvasDispatcher::drawSkVertices(
     const sk_sp<SkVertices> vertices,
     SkBlendMode mode) {
+  Flush();
   canvas_->drawVertices(vertices, mode, paint());
 }
 void DisplayListCanvasDispatcher::drawVertices(const DlVertices* vertices,
                                                DlBlendMode mode) {
+  Flush();
   canvas_->drawVertices(vertices->skia_object(), ToSk(mode), paint());
 }
 void DisplayListCanvasDispatcher::drawImage(const sk_sp<DlImage> image,
                                             const SkPoint point,
                                             DlImageSampling sampling,
                                             bool render_with_attributes) {
-  canvas_->drawImage(image ? image->skia_image() : nullptr, point.fX, point.fY,
-                     ToSk(sampling), safe_paint(render_with_attributes));
+  sk_sp<SkImage> skia_image = image ? image->skia_image() : nullptr;
+  const SkPaint* sk_paint = safe_paint(render_with_attributes);
+  if (skia_image && CanBatchImage(sk_paint)) {
+    // Drawing the whole image never samples outside of it.
+    const SkRect src = SkRect::Make(skia_image->bounds());
+    AddImageRect(std::move(skia_image), src, src.makeOffset(point.fX, point.fY),
+                 ToSk(sampling), sk_paint,
+                 SkCanvas::SrcRectConstraint::kFast_SrcRectConstraint);
+    return;
+  }
+  Flush();
+  canvas_->drawImage(skia_image, point.fX, point.fY, ToSk(sampling), sk_paint);
 }
 void DisplayListCanvasDispatcher::drawImageRect(
     const sk_sp<DlImage> image,
@@ -203,8 +253,15 @@ void DisplayListCanvasDispatcher::drawImageRect(
     DlImageSampling sampling,
     bool render_with_attributes,
     SkCanvas::SrcRectConstraint constraint) {
-  canvas_->drawImageRect(image ? image->skia_image() : nullptr, src, dst,
-                         ToSk(sampling), safe_paint(render_with_attributes),
+  sk_sp<SkImage> skia_image = image ? image->skia_image() : nullptr;
+  const SkPaint* sk_paint = safe_paint(render_with_attributes);
+  if (skia_image && CanBatchImage(sk_paint)) {
+    AddImageRect(std::move(skia_image), src, dst, ToSk(sampling), sk_paint,
+                 constraint);
+    return;
+  }
+  Flush();
+  canvas_->drawImageRect(skia_image, src, dst, ToSk(sampling), sk_paint,
                          constraint);
 }
 void DisplayListCanvasDispatcher::drawImageNine(const sk_sp<DlImage> image,
@@ -212,6 +269,7 @@ void DisplayListCanvasDispatcher::drawImageNine(const sk_sp<DlImage> image,
                                                 const SkRect& dst,
                                                 DlFilterMode filter,
                                                 bool render_with_attributes) {
+  Flush();
   if (!image) {
     return;
   }
@@ -228,6 +286,7 @@ void DisplayListCanvasDispatcher::drawImageLattice(
     const SkRect& dst,
     DlFilterMode filter,
     bool render_with_attributes) {
+  Flush();
   if (!image) {
     return;
   }
@@ -247,6 +306,7 @@ void DisplayListCanvasDispatcher::drawAtlas(const sk_sp<DlImage> atlas,
                                             DlImageSampling sampling,
                                             const SkRect* cullRect,
                                             bool render_with_attributes) {
+  Flush();
   if (!atlas) {
     return;
   }
@@ -262,6 +322,7 @@ void DisplayListCanvasDispatcher::drawAtlas(const sk_sp<DlImage> atlas,
 void DisplayListCanvasDispatcher::drawPicture(const sk_sp<SkPicture> picture,
                                               const SkMatrix* matrix,
                                               bool render_with_attributes) {
+  Flush();
   const SkPaint* paint = safe_paint(render_with_attributes);
   if (paint) {
     // drawPicture does an implicit saveLayer if an SkPaint is supplied.
@@ -273,6 +334,7 @@ void DisplayListCanvasDispatcher::drawPicture(const sk_sp<SkPicture> picture,
 }
 void DisplayListCanvasDispatcher::drawDisplayList(
     const sk_sp<DisplayList> display_list) {
+  Flush();
   int save_count = canvas_->save();
   display_list->RenderTo(canvas_, opacity());
   canvas_->restoreToCount(save_count);
@@ -280,9 +342,108 @@ void DisplayListCanvasDispatcher::drawDisplayList(
 void DisplayListCanvasDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                                SkScalar x,
                                                SkScalar y) {
+  Flush();
   canvas_->drawTextBlob(blob, x, y, paint());
 }
 
+bool DisplayListCanvasDispatcher::CanBatchRect(const SkPaint& paint) {
+  // The triangles of the vertices are not anti-aliased, and filters and
+  // effects would apply to the batch as a whole instead of to each rect.
+  // Overlapping rects are only blended in order with source-over.
+  return paint.getStyle() == SkPaint::kFill_Style && !paint.isAntiAlias() &&
+         !paint.getMaskFilter() && !paint.getImageFilter() &&
+         !paint.getPathEffect() &&
+         paint.asBlendMode() == SkBlendMode::kSrcOver;
+}
+
+bool DisplayListCanvasDispatcher::CanBatchImage(const SkPaint* paint) {
+  return !paint || (!paint->getMaskFilter() && !paint->getImageFilter() &&
+                    !paint->getShader() && !paint->getPathEffect());
+}
+
+void DisplayListCanvasDispatcher::AddImageRect(
+    sk_sp<SkImage> image,
+    const SkRect& src,
+    const SkRect& dst,
+    const SkSamplingOptions& sampling,
+    const SkPaint* paint,
+    SkCanvas::SrcRectConstraint constraint) {
+  const bool has_paint = paint != nullptr;
+  if (batch_type_ != BatchType::kImageRects ||
+      image.get() != batched_image_entries_.front().fImage.get() ||
+      sampling != batch_sampling_ || constraint != batch_constraint_ ||
+      has_paint != batch_has_paint_ || (has_paint && *paint != batch_paint_)) {
+    Flush();
+    batch_type_ = BatchType::kImageRects;
+    batch_sampling_ = sampling;
+    batch_constraint_ = constraint;
+    batch_has_paint_ = has_paint;
+    if (has_paint) {
+      batch_paint_ = *paint;
+    }
+  }
+  // The paint decides whether a single image rect is anti-aliased, the flags
+  // of the entry do so in a set.
+  const unsigned aa_flags = has_paint && paint->isAntiAlias()
+                                ? SkCanvas::kAll_QuadAAFlags
+                                : SkCanvas::kNone_QuadAAFlags;
+  batched_image_entries_.emplace_back(std::move(image), src, dst, 1.0f,
+                                      aa_flags);
+}
+
+void DisplayListCanvasDispatcher::Flush() {
+  switch (batch_type_) {
+    case BatchType::kNone:
+      return;
+    case BatchType::kRects:
+      if (batched_rects_.size() < kMinRectBatchCount) {
+        for (const SkRect& rect : batched_rects_) {
+          canvas_->drawRect(rect, batch_paint_);
+        }
+      } else {
+        batched_vertices_.clear();
+        batched_vertices_.reserve(batched_rects_.size() * 6);
+        for (const SkRect& rect : batched_rects_) {
+          const SkPoint corners[4] = {
+              {rect.fLeft, rect.fTop},
+              {rect.fRight, rect.fTop},
+              {rect.fRight, rect.fBottom},
+              {rect.fLeft, rect.fBottom},
+          };
+          batched_vertices_.insert(batched_vertices_.end(),
+                                   {corners[0], corners[1], corners[2],
+                                    corners[0], corners[2], corners[3]});
+        }
+        // Without colors or texture coordinates, the blend mode is unused.
+        canvas_->drawVertices(
+            SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode,
+                                 static_cast<int>(batched_vertices_.size()),
+                                 batched_vertices_.data(), nullptr, nullptr),
+            SkBlendMode::kModulate, batch_paint_);
+      }
+      batched_rects_.clear();
+      break;
+    case BatchType::kImageRects: {
+      const SkPaint* paint = batch_has_paint_ ? &batch_paint_ : nullptr;
+      if (batched_image_entries_.size() == 1u) {
+        const auto& entry = batched_image_entries_.front();
+        canvas_->drawImageRect(entry.fImage.get(), entry.fSrcRect,
+                               entry.fDstRect, batch_sampling_, paint,
+                               batch_constraint_);
+      } else {
+        canvas_->experimental_DrawEdgeAAImageSet(
+            batched_image_entries_.data(),
+            static_cast<int>(batched_image_entries_.size()),
+            /*dstClips=*/nullptr, /*preViewMatrices=*/nullptr,
+            batch_sampling_, paint, batch_constraint_);
+      }
+      batched_image_entries_.clear();
+      break;
+    }
+  }
+  batch_type_ = BatchType::kNone;
+}
+
 SkRect DisplayListCanvasDispatcher::ComputeShadowBounds(const SkPath& path,
                                                         float elevation,
                                                         SkScalar dpr,
@@ -324,6 +485,7 @@ void DisplayListCanvasDispatcher::drawShadow(const SkPath& path,
                                              const SkScalar elevation,
                                              bool transparent_occluder,
                                              SkScalar dpr) {
+  Flush();
   DrawShadow(canvas_, path, color, elevation, transparent_occluder, dpr);
 }
 
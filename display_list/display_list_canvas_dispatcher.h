@@ -5,6 +5,8 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_CANVAS_DISPATCHER_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_CANVAS_DISPATCHER_H_
 
+#include <vector>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_blend_mode.h"
 #include "flutter/display_list/display_list_dispatcher.h"
@@ -19,13 +21,27 @@ namespace flutter {
 ///
 /// Receives all methods on Dispatcher and sends them to an SkCanvas
 ///
+/// Runs of rects and of image rects of the same image that are drawn with the
+/// same attributes are sent as a single call, as vertices and as an image set
+/// respectively. The last run is sent by |Flush|, or when the dispatcher is
+/// destroyed.
+///
 class DisplayListCanvasDispatcher : public virtual Dispatcher,
                                     public SkPaintDispatchHelper {
  public:
+  // Shorter runs of rects are drawn one by one, as the vertices would cost
+  // more to make than the calls they save.
+  static constexpr size_t kMinRectBatchCount = 8u;
+
   explicit DisplayListCanvasDispatcher(SkCanvas* canvas,
                                        SkScalar opacity = SK_Scalar1)
       : SkPaintDispatchHelper(opacity), canvas_(canvas) {}
 
+  ~DisplayListCanvasDispatcher();
+
+  // Sends the ops of the current run to the canvas.
+  void Flush();
+
   const SkPaint* safe_paint(bool use_attributes);
 
   void save() override;
@@ -129,8 +145,34 @@ class DisplayListCanvasDispatcher : public virtual Dispatcher,
                          SkScalar dpr);
 
  private:
+  enum class BatchType {
+    kNone,
+    kRects,
+    kImageRects,
+  };
+
+  static bool CanBatchRect(const SkPaint& paint);
+  static bool CanBatchImage(const SkPaint* paint);
+
+  void AddImageRect(sk_sp<SkImage> image,
+                    const SkRect& src,
+                    const SkRect& dst,
+                    const SkSamplingOptions& sampling,
+                    const SkPaint* paint,
+                    SkCanvas::SrcRectConstraint constraint);
+
   SkCanvas* canvas_;
   SkPaint temp_paint_;
+
+  BatchType batch_type_ = BatchType::kNone;
+  SkPaint batch_paint_;
+  bool batch_has_paint_ = false;
+  SkSamplingOptions batch_sampling_;
+  SkCanvas::SrcRectConstraint batch_constraint_ =
+      SkCanvas::kStrict_SrcRectConstraint;
+  std::vector<SkRect> batched_rects_;
+  std::vector<SkPoint> batched_vertices_;
+  std::vector<SkCanvas::ImageSetEntry> batched_image_entries_;
 };
 
 }  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/display_list/display_list_complexity.h"
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_complexity_calibrated.h"
 #include "flutter/display_list/display_list_complexity_gl.h"
 #include "flutter/display_list/display_list_complexity_metal.h"
 
@@ -27,11 +28,18 @@ DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
       return DisplayListMetalComplexityCalculator::GetInstance();
     case GrBackendApi::kOpenGL:
       return DisplayListGLComplexityCalculator::GetInstance();
+    case GrBackendApi::kVulkan:
+      return DisplayListCalibratedComplexityCalculator::GetVulkanInstance();
     default:
       return DisplayListNaiveComplexityCalculator::GetInstance();
   }
 }
 
+DisplayListComplexityCalculator*
+DisplayListComplexityCalculator::GetForImpeller() {
+  return DisplayListCalibratedComplexityCalculator::GetImpellerInstance();
+}
+
 DisplayListComplexityCalculator*
 DisplayListComplexityCalculator::GetForSoftware() {
   return DisplayListNaiveComplexityCalculator::GetInstance();
@@ -0,0 +1,298 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_complexity_calibrated.h"
+
+#include <cmath>
+#include <limits>
+
+namespace flutter {
+
+DlComplexityCostTable DlComplexityCostTable::DefaultVulkanTable() {
+  // These are the trend lines of the Metal calculator where it has one,
+  // reduced to a single line per category. Skia on Vulkan goes through the
+  // same Ganesh ops, so they are a better start than counting ops.
+  DlComplexityCostTable table;
+  table[DlCostCategory::kLine] = {100.0f, 4.0f / 9.0f};
+  table[DlCostCategory::kFillRect] = {0.0f, 1.0f / 225.0f};
+  table[DlCostCategory::kStrokeRect] = {0.0f, 8.0f / 7.0f};
+  table[DlCostCategory::kFillOval] = {0.0f, 1.0f / 80.0f};
+  table[DlCostCategory::kStrokeOval] = {0.0f, 5.0f / 2.0f};
+  table[DlCostCategory::kFillRRect] = {60.0f, 1.0f / 175.0f};
+  table[DlCostCategory::kStrokeRRect] = {80.0f, 1.0f};
+  table[DlCostCategory::kPath] = {200000.0f, 75.0f};
+  table[DlCostCategory::kPoints] = {150000.0f, 25.0f / 2.0f};
+  table[DlCostCategory::kVertices] = {200000.0f, 50.0f};
+  table[DlCostCategory::kImage] = {1200.0f, 4.0f / 170.0f};
+  table[DlCostCategory::kTextBlob] = {2500.0f, 0.0f};
+  table[DlCostCategory::kSaveLayer] = {100000.0f, 0.0f};
+  table[DlCostCategory::kShadow] = {0.0f, 20000.0f};
+  table.anti_alias_penalty = 1.4f;
+  return table;
+}
+
+DlComplexityCostTable DlComplexityCostTable::DefaultImpellerTable() {
+  DlComplexityCostTable table = DefaultVulkanTable();
+  table[DlCostCategory::kPath] = {2000.0f, 100.0f};
+  table[DlCostCategory::kPoints] = {2000.0f, 25.0f / 2.0f};
+  table[DlCostCategory::kVertices] = {2000.0f, 50.0f};
+  table[DlCostCategory::kTextBlob] = {1000.0f, 0.0f};
+  table[DlCostCategory::kSaveLayer] = {150000.0f, 0.0f};
+  table[DlCostCategory::kShadow] = {1000.0f, 1000.0f};
+  table.anti_alias_penalty = 1.0f;
+  return table;
+}
+
+DisplayListCalibratedComplexityCalculator*
+DisplayListCalibratedComplexityCalculator::GetVulkanInstance() {
+  static DisplayListCalibratedComplexityCalculator* instance =
+      new DisplayListCalibratedComplexityCalculator(
+          DlComplexityCostTable::DefaultVulkanTable());
+  return instance;
+}
+
+DisplayListCalibratedComplexityCalculator*
+DisplayListCalibratedComplexityCalculator::GetImpellerInstance() {
+  static DisplayListCalibratedComplexityCalculator* instance =
+      new DisplayListCalibratedComplexityCalculator(
+          DlComplexityCostTable::DefaultImpellerTable());
+  return instance;
+}
+
+DisplayListCalibratedComplexityCalculator::
+    DisplayListCalibratedComplexityCalculator(
+        const DlComplexityCostTable& table)
+    : table_(table), ceiling_(std::numeric_limits<unsigned int>::max()) {}
+
+unsigned int DisplayListCalibratedComplexityCalculator::Compute(
+    DisplayList* display_list) {
+  CalibratedHelper helper(GetCostTable(), ceiling_);
+  display_list->Dispatch(helper);
+  return helper.ComplexityScore();
+}
+
+void DisplayListCalibratedComplexityCalculator::SetCostTable(
+    const DlComplexityCostTable& table) {
+  std::scoped_lock lock(table_mutex_);
+  table_ = table;
+}
+
+DlComplexityCostTable DisplayListCalibratedComplexityCalculator::GetCostTable()
+    const {
+  std::scoped_lock lock(table_mutex_);
+  return table_;
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::
+    AccumulateGeometry(DlCostCategory category, float units) {
+  unsigned int complexity = table_.Cost(category, units);
+  if (IsAntiAliased()) {
+    complexity *= table_.anti_alias_penalty;
+  }
+  AccumulateComplexity(complexity);
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::
+    AccumulateShape(DlCostCategory fill,
+                    DlCostCategory stroke,
+                    const SkRect& bounds) {
+  if (Style() == SkPaint::Style::kFill_Style) {
+    AccumulateGeometry(fill, bounds.width() * bounds.height());
+  } else {
+    AccumulateGeometry(stroke, (bounds.width() + bounds.height()) / 2);
+  }
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::saveLayer(
+    const SkRect* bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop) {
+  if (IsComplex()) {
+    return;
+  }
+  if (backdrop) {
+    // As with the Metal and GL calculators, backdrops only appear in frame
+    // wide builders, which are not evaluated for complexity.
+    AccumulateComplexity(Ceiling());
+  }
+  float area = bounds ? bounds->width() * bounds->height() : 0.0f;
+  AccumulateComplexity(table_.Cost(DlCostCategory::kSaveLayer, area));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawLine(
+    const SkPoint& p0,
+    const SkPoint& p1) {
+  if (IsComplex()) {
+    return;
+  }
+  SkScalar distance = std::abs(p0.x() - p1.x()) + std::abs(p0.y() - p1.y());
+  AccumulateGeometry(DlCostCategory::kLine, distance);
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawRect(
+    const SkRect& rect) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(DlCostCategory::kFillRect, DlCostCategory::kStrokeRect,
+                  rect);
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawOval(
+    const SkRect& bounds) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(DlCostCategory::kFillOval, DlCostCategory::kStrokeOval,
+                  bounds);
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawCircle(
+    const SkPoint& center,
+    SkScalar radius) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(DlCostCategory::kFillOval, DlCostCategory::kStrokeOval,
+                  SkRect::MakeLTRB(center.x() - radius, center.y() - radius,
+                                   center.x() + radius, center.y() + radius));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawRRect(
+    const SkRRect& rrect) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(DlCostCategory::kFillRRect, DlCostCategory::kStrokeRRect,
+                  rrect.rect());
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawDRRect(
+    const SkRRect& outer,
+    const SkRRect& inner) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(DlCostCategory::kFillRRect, DlCostCategory::kStrokeRRect,
+                  outer.rect());
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawPath(
+    const SkPath& path) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateGeometry(DlCostCategory::kPath, path.countVerbs());
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawArc(
+    const SkRect& oval_bounds,
+    SkScalar start_degrees,
+    SkScalar sweep_degrees,
+    bool use_center) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateShape(DlCostCategory::kFillOval, DlCostCategory::kStrokeOval,
+                  oval_bounds);
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawPoints(
+    SkCanvas::PointMode mode,
+    uint32_t count,
+    const SkPoint points[]) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateGeometry(DlCostCategory::kPoints, count);
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::
+    drawSkVertices(const sk_sp<SkVertices> vertices, SkBlendMode mode) {
+  // Same approximation of the vertex count as the Metal calculator.
+  unsigned int approximate_vertex_count = vertices->approximateSize() / 20;
+  AccumulateComplexity(
+      table_.Cost(DlCostCategory::kVertices, approximate_vertex_count));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawVertices(
+    const DlVertices* vertices,
+    DlBlendMode mode) {
+  AccumulateComplexity(
+      table_.Cost(DlCostCategory::kVertices, vertices->vertex_count()));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const SkPoint point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  SkISize dimensions = image->dimensions();
+  AccumulateComplexity(table_.Cost(
+      DlCostCategory::kImage, dimensions.width() * dimensions.height()));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::ImageRect(
+    const SkISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    SkCanvas::SrcRectConstraint constraint) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateComplexity(
+      table_.Cost(DlCostCategory::kImage, size.width() * size.height()));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::
+    drawImageNine(const sk_sp<DlImage> image,
+                  const SkIRect& center,
+                  const SkRect& dst,
+                  DlFilterMode filter,
+                  bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  SkISize dimensions = image->dimensions();
+  AccumulateComplexity(table_.Cost(
+      DlCostCategory::kImage, dimensions.width() * dimensions.height()));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::
+    drawDisplayList(const sk_sp<DisplayList> display_list) {
+  if (IsComplex()) {
+    return;
+  }
+  CalibratedHelper helper(table_, Ceiling() - CurrentComplexityScore());
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawTextBlob(
+    const sk_sp<SkTextBlob> blob,
+    SkScalar x,
+    SkScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateComplexity(table_.Cost(DlCostCategory::kTextBlob, 0.0f));
+}
+
+void DisplayListCalibratedComplexityCalculator::CalibratedHelper::drawShadow(
+    const SkPath& path,
+    const DlColor color,
+    const SkScalar elevation,
+    bool transparent_occluder,
+    SkScalar dpr) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateComplexity(
+      table_.Cost(DlCostCategory::kShadow, path.countVerbs()));
+}
+
+}  // namespace flutter
@@ -0,0 +1,184 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_COMPLEXITY_CALIBRATED_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_COMPLEXITY_CALIBRATED_H_
+
+#include <array>
+#include <mutex>
+
+#include "flutter/display_list/display_list_complexity_helper.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// The kinds of ops that the calibrated complexity model has a separate cost
+// for. Circles and arcs are costed as ovals and DRRects as RRects.
+enum class DlCostCategory {
+  kLine,         // per unit of (manhattan) length
+  kFillRect,     // per pixel of area
+  kStrokeRect,   // per pixel of the average of width and height
+  kFillOval,     // per pixel of area
+  kStrokeOval,   // per pixel of the average of width and height
+  kFillRRect,    // per pixel of area
+  kStrokeRRect,  // per pixel of the average of width and height
+  kPath,         // per verb
+  kPoints,       // per point
+  kVertices,     // per vertex
+  kImage,        // per pixel of the image
+  kTextBlob,     // per blob, the cost has no per unit part
+  kSaveLayer,    // per pixel of the layer bounds, if it has any
+  kShadow,       // per verb of the occluding path
+};
+
+static constexpr size_t kDlCostCategoryCount =
+    static_cast<size_t>(DlCostCategory::kShadow) + 1;
+
+// The cost of an op of a given category as a straight line, y = mx + c,
+// where x is the size of the op in the units listed above. Both values
+// use the scale of the other calculators, where 100 is about 0.0005ms.
+struct DlLinearCost {
+  float fixed = 0.0f;
+  float per_unit = 0.0f;
+};
+
+// The table of costs used by the calibrated calculator. Tables are either
+// the defaults below, which are rough starting points for each backend, or
+// measured on the running device with |DlComplexityCalibrator|.
+struct DlComplexityCostTable {
+  std::array<DlLinearCost, kDlCostCategoryCount> costs;
+
+  // The factor applied to the cost of geometry drawn with anti-aliasing.
+  float anti_alias_penalty = 1.0f;
+
+  DlLinearCost& operator[](DlCostCategory category) {
+    return costs[static_cast<size_t>(category)];
+  }
+  const DlLinearCost& operator[](DlCostCategory category) const {
+    return costs[static_cast<size_t>(category)];
+  }
+
+  unsigned int Cost(DlCostCategory category, float units) const {
+    const DlLinearCost& cost = (*this)[category];
+    return static_cast<unsigned int>(cost.fixed + cost.per_unit * units);
+  }
+
+  // A table derived from the Metal calculator, used for Skia on Vulkan
+  // until the device has been calibrated.
+  static DlComplexityCostTable DefaultVulkanTable();
+
+  // A table for Impeller, which tessellates paths on the CPU and renders
+  // with MSAA, so that paths are cheaper and anti-aliasing is free, but
+  // layers cost a render pass each.
+  static DlComplexityCostTable DefaultImpellerTable();
+};
+
+// A complexity calculator that scores each op with a table of linear costs
+// rather than with hand-fitted formulas. This allows the costs to be
+// measured on the device the engine is running on, see
+// display_list_complexity_calibration.h.
+class DisplayListCalibratedComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  // The shared calculators for Skia on Vulkan and for Impeller. They start
+  // with the default tables and can be given a measured one with
+  // |SetCostTable|.
+  static DisplayListCalibratedComplexityCalculator* GetVulkanInstance();
+  static DisplayListCalibratedComplexityCalculator* GetImpellerInstance();
+
+  explicit DisplayListCalibratedComplexityCalculator(
+      const DlComplexityCostTable& table);
+
+  unsigned int Compute(DisplayList* display_list) override;
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    // Set cache threshold at 1ms
+    return complexity_score > 200000u;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+  // Replaces the table of costs. This may be called from another thread
+  // than the one computing the scores, e.g. once a calibration has run.
+  void SetCostTable(const DlComplexityCostTable& table);
+
+  DlComplexityCostTable GetCostTable() const;
+
+ private:
+  class CalibratedHelper : public ComplexityCalculatorHelper {
+   public:
+    CalibratedHelper(const DlComplexityCostTable& table, unsigned int ceiling)
+        : ComplexityCalculatorHelper(ceiling), table_(table) {}
+
+    void saveLayer(const SkRect* bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop) override;
+
+    void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+    void drawRect(const SkRect& rect) override;
+    void drawOval(const SkRect& bounds) override;
+    void drawCircle(const SkPoint& center, SkScalar radius) override;
+    void drawRRect(const SkRRect& rrect) override;
+    void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+    void drawPath(const SkPath& path) override;
+    void drawArc(const SkRect& oval_bounds,
+                 SkScalar start_degrees,
+                 SkScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(SkCanvas::PointMode mode,
+                    uint32_t count,
+                    const SkPoint points[]) override;
+    void drawSkVertices(const sk_sp<SkVertices> vertices,
+                        SkBlendMode mode) override;
+    void drawVertices(const DlVertices* vertices, DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const SkPoint point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list) override;
+    void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                      SkScalar x,
+                      SkScalar y) override;
+    void drawShadow(const SkPath& path,
+                    const DlColor color,
+                    const SkScalar elevation,
+                    bool transparent_occluder,
+                    SkScalar dpr) override;
+
+   protected:
+    void ImageRect(const SkISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   SkCanvas::SrcRectConstraint constraint) override;
+
+    unsigned int BatchedComplexity() override { return 0; }
+
+   private:
+    // Accumulates the cost of geometry, which is the only kind of op that
+    // the anti-aliasing penalty applies to.
+    void AccumulateGeometry(DlCostCategory category, float units);
+    void AccumulateShape(DlCostCategory fill,
+                         DlCostCategory stroke,
+                         const SkRect& bounds);
+
+    const DlComplexityCostTable& table_;
+  };
+
+  mutable std::mutex table_mutex_;
+  DlComplexityCostTable table_;
+  unsigned int ceiling_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCalibratedComplexityCalculator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_COMPLEXITY_CALIBRATED_H_
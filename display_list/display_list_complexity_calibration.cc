@@ -0,0 +1,260 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_complexity_calibration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/display_list/display_list_vertices.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+namespace {
+
+// The sizes of the small and large probes, in pixels for shapes, images
+// and layers and as a count for verbs, points and vertices.
+constexpr int kSmallProbeSize = 8;
+constexpr int kLargeProbeSize = 128;
+
+SkPath MakePolygon(int sides, SkPoint center, SkScalar radius) {
+  SkPath path;
+  for (int i = 0; i < sides; i++) {
+    float angle = 2.0f * M_PI * i / sides;
+    SkPoint point = SkPoint::Make(center.x() + radius * std::cos(angle),
+                                  center.y() + radius * std::sin(angle));
+    if (i == 0) {
+      path.moveTo(point);
+    } else {
+      path.lineTo(point);
+    }
+  }
+  path.close();
+  return path;
+}
+
+sk_sp<DlImage> MakeProbeImage(int size) {
+  auto surface = SkSurface::MakeRasterN32Premul(size, size);
+  surface->getCanvas()->clear(SK_ColorRED);
+  return DlImage::Make(surface->makeImageSnapshot());
+}
+
+}  // namespace
+
+DlComplexityCalibrator::Probe DlComplexityCalibrator::MakeSmallProbe(
+    DlCostCategory category) {
+  return MakeProbe(category, kSmallProbeSize);
+}
+
+DlComplexityCalibrator::Probe DlComplexityCalibrator::MakeLargeProbe(
+    DlCostCategory category) {
+  return MakeProbe(category, kLargeProbeSize);
+}
+
+DlComplexityCalibrator::Probe DlComplexityCalibrator::MakeProbe(
+    DlCostCategory category,
+    int size,
+    bool anti_alias) {
+  DisplayListBuilder builder(
+      SkRect::MakeWH(kProbeCanvasSize, kProbeCanvasSize));
+  builder.setAntiAlias(anti_alias);
+  builder.setColor(SK_ColorBLUE);
+
+  // Spread the ops over the canvas so that consecutive ops do not cover
+  // the same pixels.
+  const int range = kProbeCanvasSize - size;
+  auto origin = [range](size_t i) {
+    return SkPoint::Make((i * 37) % range, (i * 53) % range);
+  };
+  auto bounds = [size, &origin](size_t i) {
+    SkPoint point = origin(i);
+    return SkRect::MakeXYWH(point.x(), point.y(), size, size);
+  };
+
+  Probe probe;
+  probe.op_count = kProbeOpCount;
+  switch (category) {
+    case DlCostCategory::kLine:
+      builder.setStyle(DlDrawStyle::kStroke);
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        SkPoint p0 = origin(i);
+        builder.drawLine(p0, SkPoint::Make(p0.x() + size, p0.y()));
+      }
+      probe.units_per_op = size;
+      break;
+    case DlCostCategory::kFillRect:
+    case DlCostCategory::kStrokeRect:
+      if (category == DlCostCategory::kStrokeRect) {
+        builder.setStyle(DlDrawStyle::kStroke);
+        builder.setStrokeWidth(1.0f);
+      }
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        builder.drawRect(bounds(i));
+      }
+      break;
+    case DlCostCategory::kFillOval:
+    case DlCostCategory::kStrokeOval:
+      if (category == DlCostCategory::kStrokeOval) {
+        builder.setStyle(DlDrawStyle::kStroke);
+        builder.setStrokeWidth(1.0f);
+      }
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        builder.drawOval(bounds(i));
+      }
+      break;
+    case DlCostCategory::kFillRRect:
+    case DlCostCategory::kStrokeRRect:
+      if (category == DlCostCategory::kStrokeRRect) {
+        builder.setStyle(DlDrawStyle::kStroke);
+        builder.setStrokeWidth(1.0f);
+      }
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        builder.drawRRect(
+            SkRRect::MakeRectXY(bounds(i), size / 4.0f, size / 4.0f));
+      }
+      break;
+    case DlCostCategory::kPath: {
+      SkPath path = MakePolygon(size, SkPoint::Make(0, 0), size / 2.0f);
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        SkPoint point = origin(i);
+        builder.drawPath(path.makeOffset(point.x() + size / 2.0f,
+                                         point.y() + size / 2.0f));
+      }
+      probe.units_per_op = path.countVerbs();
+      break;
+    }
+    case DlCostCategory::kPoints: {
+      std::vector<SkPoint> points;
+      for (int i = 0; i < size * 4; i++) {
+        points.push_back(SkPoint::Make((i * 13) % kProbeCanvasSize,
+                                       (i * 7) % kProbeCanvasSize));
+      }
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        builder.drawPoints(SkCanvas::kPoints_PointMode, points.size(),
+                           points.data());
+      }
+      probe.units_per_op = points.size();
+      break;
+    }
+    case DlCostCategory::kVertices: {
+      std::vector<SkPoint> vertices;
+      for (int i = 0; i < size; i++) {
+        SkPoint point = origin(i);
+        vertices.push_back(point);
+        vertices.push_back(SkPoint::Make(point.x() + size, point.y()));
+        vertices.push_back(SkPoint::Make(point.x(), point.y() + size));
+      }
+      auto dl_vertices =
+          DlVertices::Make(DlVertexMode::kTriangles, vertices.size(),
+                           vertices.data(), nullptr, nullptr);
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        builder.drawVertices(dl_vertices, DlBlendMode::kSrcOver);
+      }
+      probe.units_per_op = vertices.size();
+      break;
+    }
+    case DlCostCategory::kImage: {
+      auto image = MakeProbeImage(size);
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        builder.drawImage(image, origin(i), DlImageSampling::kNearestNeighbor,
+                          false);
+      }
+      break;
+    }
+    case DlCostCategory::kTextBlob: {
+      // The cost of text is per blob only, so both probes draw the same
+      // blobs and only the fixed cost is measured.
+      auto blob = SkTextBlob::MakeFromString("Calibrate", SkFont());
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        SkPoint point = origin(i);
+        builder.drawTextBlob(blob, point.x(), point.y());
+      }
+      break;
+    }
+    case DlCostCategory::kSaveLayer:
+      // Each layer draws a single rect, whose cost is measured along with
+      // the layer as there is no way to composite an empty layer.
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        SkRect layer_bounds = bounds(i);
+        builder.saveLayer(&layer_bounds, false);
+        builder.drawRect(layer_bounds);
+        builder.restore();
+      }
+      break;
+    case DlCostCategory::kShadow: {
+      SkPath path = MakePolygon(std::max(size / 4, 3), SkPoint::Make(0, 0),
+                                kSmallProbeSize);
+      for (size_t i = 0; i < kProbeOpCount; i++) {
+        SkPoint point = origin(i);
+        builder.drawShadow(path.makeOffset(point.x() + kSmallProbeSize,
+                                           point.y() + kSmallProbeSize),
+                           SK_ColorBLACK, 4.0f, false, 1.0f);
+      }
+      probe.units_per_op = path.countVerbs();
+      break;
+    }
+  }
+
+  switch (category) {
+    case DlCostCategory::kFillRect:
+    case DlCostCategory::kFillOval:
+    case DlCostCategory::kFillRRect:
+    case DlCostCategory::kImage:
+    case DlCostCategory::kSaveLayer:
+      probe.units_per_op = size * size;
+      break;
+    case DlCostCategory::kStrokeRect:
+    case DlCostCategory::kStrokeOval:
+    case DlCostCategory::kStrokeRRect:
+      probe.units_per_op = size;
+      break;
+    default:
+      break;
+  }
+  probe.display_list = builder.Build();
+  return probe;
+}
+
+DlComplexityCostTable DlComplexityCalibrator::Calibrate(const Timer& timer) {
+  auto per_op_cost = [&timer](const Probe& probe) {
+    return ToComplexity(timer(probe.display_list)) / probe.op_count;
+  };
+
+  DlComplexityCostTable table;
+  for (size_t i = 0; i < kDlCostCategoryCount; i++) {
+    auto category = static_cast<DlCostCategory>(i);
+    Probe small = MakeSmallProbe(category);
+    Probe large = MakeLargeProbe(category);
+    float small_cost = per_op_cost(small);
+    float large_cost = per_op_cost(large);
+
+    DlLinearCost& cost = table[category];
+    float unit_delta = large.units_per_op - small.units_per_op;
+    if (unit_delta > 0.0f) {
+      cost.per_unit = std::max(0.0f, (large_cost - small_cost) / unit_delta);
+      cost.fixed =
+          std::max(0.0f, small_cost - cost.per_unit * small.units_per_op);
+    } else {
+      cost.per_unit = 0.0f;
+      cost.fixed = std::max(0.0f, (small_cost + large_cost) / 2.0f);
+    }
+  }
+
+  float plain_cost = per_op_cost(
+      MakeProbe(DlCostCategory::kFillOval, kLargeProbeSize, false));
+  float anti_aliased_cost = per_op_cost(
+      MakeProbe(DlCostCategory::kFillOval, kLargeProbeSize, true));
+  if (plain_cost > 0.0f) {
+    table.anti_alias_penalty = std::max(1.0f, anti_aliased_cost / plain_cost);
+  }
+  return table;
+}
+
+}  // namespace flutter
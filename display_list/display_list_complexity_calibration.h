@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_COMPLEXITY_CALIBRATION_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_COMPLEXITY_CALIBRATION_H_
+
+#include <functional>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_complexity_calibrated.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+// Measures the table of costs used by the calibrated complexity calculator
+// on the running device.
+//
+// For every cost category, the calibrator records two probe display lists
+// that draw the same number of ops of that category at a small and at a
+// large size, and has them timed by the caller. The fixed and per unit
+// costs of the category are the straight line through the two timings.
+// The anti-aliasing penalty is the ratio between the timings of a probe
+// drawn with and without anti-aliasing.
+//
+// The calibrator does not render anything itself, as it does not know the
+// surface the engine draws to. The |Timer| it is given must render the
+// display list to that surface, wait for the GPU to finish and return the
+// time it took. See BM_CalibrateComplexity in display_list_benchmarks.cc.
+class DlComplexityCalibrator {
+ public:
+  using Timer = std::function<fml::TimeDelta(const sk_sp<DisplayList>&)>;
+
+  // The number of ops in each probe, so that a probe takes long enough to
+  // be timed reliably.
+  static constexpr size_t kProbeOpCount = 200;
+
+  // The size of the surface that the probes are drawn into.
+  static constexpr int kProbeCanvasSize = 512;
+
+  // A display list of |op_count| ops of the same category whose size is
+  // |units_per_op| each.
+  struct Probe {
+    sk_sp<DisplayList> display_list;
+    float units_per_op = 0.0f;
+    size_t op_count = 0;
+  };
+
+  // The small and large probes for the given category.
+  static Probe MakeSmallProbe(DlCostCategory category);
+  static Probe MakeLargeProbe(DlCostCategory category);
+
+  // Times all probes with |timer| and fits a table of costs to the timings.
+  static DlComplexityCostTable Calibrate(const Timer& timer);
+
+  // Converts the time taken by an op to the scale of the complexity
+  // calculators, where 100 is about 0.0005ms.
+  static float ToComplexity(fml::TimeDelta time) {
+    return time.ToNanoseconds() / 5.0f;
+  }
+
+ private:
+  static Probe MakeProbe(DlCostCategory category,
+                         int size,
+                         bool anti_alias = false);
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DlComplexityCalibrator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_COMPLEXITY_CALIBRATION_H_
@@ -5,6 +5,8 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_complexity.h"
+#include "flutter/display_list/display_list_complexity_calibrated.h"
+#include "flutter/display_list/display_list_complexity_calibration.h"
 #include "flutter/display_list/display_list_complexity_gl.h"
 #include "flutter/display_list/display_list_complexity_metal.h"
 #include "flutter/display_list/display_list_sampling_options.h"
@@ -39,6 +41,14 @@ std::vector<SkPoint> GetTestPoints() {
   return points;
 }
 
+DlComplexityCostTable GetUniformCostTable(float fixed, float per_unit) {
+  DlComplexityCostTable table;
+  for (auto& cost : table.costs) {
+    cost = {fixed, per_unit};
+  }
+  return table;
+}
+
 }  // namespace
 
 TEST(DisplayListComplexity, EmptyDisplayList) {
@@ -432,5 +442,97 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, CalibratedCalculatorUsesCostTable) {
+  DlComplexityCostTable table = GetUniformCostTable(0.0f, 0.0f);
+  table[DlCostCategory::kFillRect] = {100.0f, 2.0f};
+  table[DlCostCategory::kStrokeRect] = {10.0f, 3.0f};
+  table.anti_alias_penalty = 1.5f;
+  DisplayListCalibratedComplexityCalculator calculator(table);
+
+  DisplayListBuilder builder_filled;
+  builder_filled.drawRect(SkRect::MakeXYWH(10, 10, 10, 20));
+  auto display_list_filled = builder_filled.Build();
+  ASSERT_EQ(calculator.Compute(display_list_filled.get()), 100u + 2u * 200u);
+
+  DisplayListBuilder builder_stroked;
+  builder_stroked.setStyle(DlDrawStyle::kStroke);
+  builder_stroked.setAntiAlias(true);
+  builder_stroked.drawRect(SkRect::MakeXYWH(10, 10, 10, 20));
+  auto display_list_stroked = builder_stroked.Build();
+  ASSERT_EQ(calculator.Compute(display_list_stroked.get()),
+            (10u + 3u * 15u) * 3u / 2u);
+
+  table[DlCostCategory::kFillRect] = {50.0f, 0.0f};
+  calculator.SetCostTable(table);
+  ASSERT_EQ(calculator.Compute(display_list_filled.get()), 50u);
+}
+
+TEST(DisplayListComplexity, CalibratedCalculatorCeilingAndNesting) {
+  DisplayListCalibratedComplexityCalculator calculator(
+      GetUniformCostTable(100.0f, 1.0f));
+
+  auto nested_display_list = GetSampleNestedDisplayList();
+  ASSERT_GT(calculator.Compute(nested_display_list.get()), 1u);
+
+  auto display_list = GetSampleDisplayList();
+  calculator.SetComplexityCeiling(10u);
+  ASSERT_EQ(calculator.Compute(display_list.get()), 10u);
+}
+
+TEST(DisplayListComplexity, CalibratedBackends) {
+  auto vulkan = DisplayListComplexityCalculator::GetForBackend(
+      GrBackendApi::kVulkan);
+  auto impeller = DisplayListComplexityCalculator::GetForImpeller();
+  ASSERT_EQ(vulkan,
+            DisplayListCalibratedComplexityCalculator::GetVulkanInstance());
+  ASSERT_EQ(impeller,
+            DisplayListCalibratedComplexityCalculator::GetImpellerInstance());
+
+  // Paths are tessellated on the CPU by Impeller, which makes their fixed
+  // cost much lower than in Skia.
+  SkPath path;
+  path.addCircle(50, 50, 20);
+  DisplayListBuilder builder;
+  builder.drawPath(path);
+  auto display_list = builder.Build();
+  ASSERT_GT(vulkan->Compute(display_list.get()),
+            impeller->Compute(display_list.get()));
+  ASSERT_FALSE(impeller->ShouldBeCached(200000u));
+  ASSERT_TRUE(impeller->ShouldBeCached(200001u));
+}
+
+TEST(DisplayListComplexity, CalibrationFitsMeasuredCosts) {
+  // Time the probes as if the device cost exactly what a known table says,
+  // with one complexity unit taking 5ns.
+  DlComplexityCostTable device_table = GetUniformCostTable(100.0f, 2.0f);
+  device_table[DlCostCategory::kTextBlob] = {300.0f, 0.0f};
+  device_table.anti_alias_penalty = 1.5f;
+  DisplayListCalibratedComplexityCalculator device(device_table);
+  int probe_count = 0;
+  auto timer = [&device, &probe_count](const sk_sp<DisplayList>& probe) {
+    probe_count++;
+    return fml::TimeDelta::FromNanoseconds(5 * device.Compute(probe.get()));
+  };
+
+  DlComplexityCostTable table = DlComplexityCalibrator::Calibrate(timer);
+  ASSERT_EQ(probe_count, static_cast<int>(kDlCostCategoryCount * 2 + 2));
+
+  for (size_t i = 0; i < kDlCostCategoryCount; i++) {
+    auto category = static_cast<DlCostCategory>(i);
+    if (category == DlCostCategory::kSaveLayer) {
+      // The layer probes draw a rect in each layer.
+      EXPECT_NEAR(table[category].fixed, 200.0f, 1.0f);
+      EXPECT_NEAR(table[category].per_unit, 4.0f, 0.01f);
+      continue;
+    }
+    EXPECT_NEAR(table[category].fixed, device_table[category].fixed, 1.0f)
+        << "category " << i;
+    EXPECT_NEAR(table[category].per_unit, device_table[category].per_unit,
+                0.01f)
+        << "category " << i;
+  }
+  EXPECT_NEAR(table.anti_alias_penalty, 1.5f, 0.01f);
+}
+
 }  // namespace testing
 }  // namespace flutter
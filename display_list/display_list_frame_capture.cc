@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_frame_capture.h"
+
+#include <cstring>
+
+#include "flutter/display_list/display_list_serialization.h"
+
+namespace flutter {
+
+namespace {
+
+// "DLFC" in little endian.
+static constexpr uint32_t kMagic = 0x43464C44u;
+// The serialized display lists have to start on the alignment of their
+// sections to be read in place.
+static constexpr size_t kAlignment = 8u;
+
+// The buffer is laid out as the header followed by the frames. Each frame
+// is a |FrameHeader| followed by its serialized display list, and starts on
+// an 8 byte boundary.
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t frame_count;
+  uint32_t reserved;
+};
+
+struct FrameHeader {
+  int32_t width;
+  int32_t height;
+  float device_pixel_ratio;
+  uint32_t reserved;
+  int64_t build_time_micros;
+  int64_t raster_time_micros;
+  uint64_t display_list_size;
+};
+
+size_t Align(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+DisplayListFrameCapture::DisplayListFrameCapture() = default;
+
+DisplayListFrameCapture::~DisplayListFrameCapture() = default;
+
+bool DisplayListFrameCapture::AddFrame(const Frame& frame,
+                                       bool read_back_texture_images) {
+  sk_sp<SkData> data = DisplayListSerializer::Serialize(
+      frame.display_list, read_back_texture_images);
+  if (!data) {
+    return false;
+  }
+  frames_.push_back({
+      .frame = frame,
+      .display_list_data = std::move(data),
+  });
+  return true;
+}
+
+sk_sp<SkData> DisplayListFrameCapture::Serialize() const {
+  size_t size = Align(sizeof(Header));
+  for (const SerializedFrame& serialized : frames_) {
+    size += Align(sizeof(FrameHeader)) +
+            Align(serialized.display_list_data->size());
+  }
+  sk_sp<SkData> data = SkData::MakeZeroInitialized(size);
+  auto buffer = static_cast<uint8_t*>(data->writable_data());
+
+  Header header = {
+      .magic = kMagic,
+      .version = kVersion,
+      .frame_count = static_cast<uint32_t>(frames_.size()),
+      .reserved = 0u,
+  };
+  memcpy(buffer, &header, sizeof(header));
+  size_t offset = Align(sizeof(Header));
+  for (const SerializedFrame& serialized : frames_) {
+    const Frame& frame = serialized.frame;
+    FrameHeader frame_header = {
+        .width = frame.frame_size.width(),
+        .height = frame.frame_size.height(),
+        .device_pixel_ratio = frame.device_pixel_ratio,
+        .reserved = 0u,
+        .build_time_micros = frame.build_time.ToMicroseconds(),
+        .raster_time_micros = frame.raster_time.ToMicroseconds(),
+        .display_list_size = serialized.display_list_data->size(),
+    };
+    memcpy(buffer + offset, &frame_header, sizeof(frame_header));
+    offset += Align(sizeof(FrameHeader));
+    memcpy(buffer + offset, serialized.display_list_data->data(),
+           serialized.display_list_data->size());
+    offset += Align(serialized.display_list_data->size());
+  }
+  return data;
+}
+
+std::optional<std::vector<DisplayListFrameCapture::Frame>>
+DisplayListFrameCapture::Deserialize(const sk_sp<SkData>& data) {
+  if (!data || data->size() < sizeof(Header)) {
+    return std::nullopt;
+  }
+  auto buffer = static_cast<const uint8_t*>(data->data());
+  Header header;
+  memcpy(&header, buffer, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion) {
+    return std::nullopt;
+  }
+
+  std::vector<Frame> frames;
+  size_t offset = Align(sizeof(Header));
+  for (uint32_t i = 0; i < header.frame_count; i++) {
+    if (offset > data->size() ||
+        data->size() - offset < Align(sizeof(FrameHeader))) {
+      return std::nullopt;
+    }
+    FrameHeader frame_header;
+    memcpy(&frame_header, buffer + offset, sizeof(frame_header));
+    offset += Align(sizeof(FrameHeader));
+    if (frame_header.display_list_size > data->size() - offset) {
+      return std::nullopt;
+    }
+    // The display list uses the image pixels in place, so it refers to a
+    // subset of |data| instead of a copy.
+    sk_sp<DisplayList> display_list = DisplayListSerializer::Deserialize(
+        SkData::MakeSubset(data.get(), offset, frame_header.display_list_size));
+    if (!display_list) {
+      return std::nullopt;
+    }
+    frames.push_back({
+        .frame_size = SkISize::Make(frame_header.width, frame_header.height),
+        .device_pixel_ratio = frame_header.device_pixel_ratio,
+        .build_time =
+            fml::TimeDelta::FromMicroseconds(frame_header.build_time_micros),
+        .raster_time =
+            fml::TimeDelta::FromMicroseconds(frame_header.raster_time_micros),
+        .display_list = std::move(display_list),
+    });
+    offset += Align(frame_header.display_list_size);
+  }
+  return frames;
+}
+
+}  // namespace flutter
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_FRAME_CAPTURE_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_FRAME_CAPTURE_H_
+
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+// A capture of consecutive frames of an app, to replay them offline, e.g.
+// to reproduce a performance problem of the field in the lab.
+//
+// Each frame is the layer tree of the frame flattened into a display list,
+// with the images that it draws, as serialized by |DisplayListSerializer|,
+// and the time that building and rasterizing the frame took when it was
+// captured. The raster cache and platform views are not part of the
+// capture, so a replay measures drawing every frame from scratch.
+//
+// The format has the same constraints as the one of the serialized display
+// lists: captures are read by the engine build that wrote them.
+class DisplayListFrameCapture {
+ public:
+  static constexpr uint32_t kVersion = 1u;
+
+  // The extension of the files that captures are saved in.
+  static constexpr char kFileExtension[] = ".dlcapture";
+
+  struct Frame {
+    SkISize frame_size = SkISize::MakeEmpty();
+    float device_pixel_ratio = 1.0f;
+    fml::TimeDelta build_time;
+    fml::TimeDelta raster_time;
+    sk_sp<DisplayList> display_list;
+  };
+
+  DisplayListFrameCapture();
+
+  ~DisplayListFrameCapture();
+
+  // Serializes |frame| and appends it to the capture. Returns false, and
+  // does not append the frame, if its display list can't be serialized.
+  //
+  // See |DisplayListSerializer::Serialize| for |read_back_texture_images|.
+  bool AddFrame(const Frame& frame, bool read_back_texture_images = false);
+
+  size_t frame_count() const { return frames_.size(); }
+
+  // The frames added so far in one buffer.
+  sk_sp<SkData> Serialize() const;
+
+  // Returns std::nullopt if |data| isn't a capture of this version, or if
+  // one of its display lists can't be read. Like with the display lists,
+  // the image pixels stay in |data|, which may be a memory mapped file.
+  static std::optional<std::vector<Frame>> Deserialize(
+      const sk_sp<SkData>& data);
+
+ private:
+  struct SerializedFrame {
+    Frame frame;
+    sk_sp<SkData> display_list_data;
+  };
+
+  std::vector<SerializedFrame> frames_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListFrameCapture);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_FRAME_CAPTURE_H_
@@ -0,0 +1,199 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list_frame_capture.h"
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using BackendType = DlSurfaceProvider::BackendType;
+
+struct Capture {
+  std::string name;
+  std::vector<DisplayListFrameCapture::Frame> frames;
+};
+
+sk_sp<SkData> OpenFileAsSkData(const fml::UniqueFD& directory,
+                               const std::string& filename) {
+  auto mapping = fml::FileMapping::CreateReadOnly(directory, filename);
+  if (!mapping || mapping->GetSize() == 0u) {
+    return nullptr;
+  }
+  // The deserialized display lists use the image pixels in the mapping, so
+  // the mapping lives as long as the data.
+  auto data = SkData::MakeWithProc(
+      mapping->GetMapping(), mapping->GetSize(),
+      [](const void* ptr, void* context) {
+        delete reinterpret_cast<fml::Mapping*>(context);
+      },
+      mapping.get());
+  mapping.release();
+  return data;
+}
+
+// Loads the frame captures in a directory, sorted by name.
+std::vector<Capture> LoadCaptures(const std::string& capture_directory) {
+  std::vector<Capture> captures;
+  auto directory = fml::OpenDirectory(capture_directory.c_str(), false,
+                                      fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open the capture directory "
+                   << capture_directory;
+    return captures;
+  }
+  const std::string extension = DisplayListFrameCapture::kFileExtension;
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& directory,
+                                 const std::string& filename) {
+    if (filename.size() <= extension.size() ||
+        filename.compare(filename.size() - extension.size(), extension.size(),
+                         extension) != 0) {
+      return true;
+    }
+    auto data = OpenFileAsSkData(directory, filename);
+    auto frames =
+        data ? DisplayListFrameCapture::Deserialize(data) : std::nullopt;
+    if (!frames.has_value() || frames->empty()) {
+      FML_LOG(ERROR) << "Could not load the capture " << filename
+                     << ". It may have been written by another engine build.";
+      return true;
+    }
+    captures.push_back({
+        .name = filename.substr(0, filename.size() - extension.size()),
+        .frames = std::move(*frames),
+    });
+    return true;
+  });
+  std::sort(captures.begin(), captures.end(),
+            [](const Capture& a, const Capture& b) { return a.name < b.name; });
+  return captures;
+}
+
+}  // namespace
+
+// Replays the frames of a capture in turn on a Skia surface of the backend,
+// flushing and submitting each frame.
+//
+// The time of an iteration is the time to render all the frames once, and
+// the average raster time that the frames took when they were captured is
+// reported as "CapturedRasterMs" to compare the replay to.
+static void BM_SkiaFrameCapture(benchmark::State& state,
+                                BackendType backend_type,
+                                const Capture& capture) {
+  auto surface_provider = DlSurfaceProvider::Create(backend_type);
+  if (!surface_provider) {
+    state.SkipWithError("Backend is not supported on this platform.");
+    return;
+  }
+
+  SkISize frame_size = SkISize::Make(1, 1);
+  size_t draw_call_count = 0u;
+  fml::TimeDelta captured_raster_time;
+  for (const auto& frame : capture.frames) {
+    frame_size.set(std::max(frame_size.width(), frame.frame_size.width()),
+                   std::max(frame_size.height(), frame.frame_size.height()));
+    draw_call_count += frame.display_list->op_count(true);
+    captured_raster_time = captured_raster_time + frame.raster_time;
+  }
+  if (!surface_provider->InitializeSurface(frame_size.width(),
+                                           frame_size.height())) {
+    state.SkipWithError("Could not create a surface.");
+    return;
+  }
+  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
+  auto canvas = surface->getCanvas();
+
+  state.counters["FrameCount"] = capture.frames.size();
+  state.counters["DrawCallCount"] = draw_call_count / capture.frames.size();
+  state.counters["CapturedRasterMs"] =
+      captured_raster_time.ToMillisecondsF() / capture.frames.size();
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& frame : capture.frames) {
+      canvas->clear(SK_ColorTRANSPARENT);
+      frame.display_list->RenderTo(canvas);
+      surface->flushAndSubmit(true);
+    }
+  }
+
+#ifndef BENCHMARKS_NO_SNAPSHOT
+  auto filename = surface_provider->backend_name() + "-FrameCapture-" +
+                  capture.name + ".png";
+  surface_provider->Snapshot(filename);
+#endif  // BENCHMARKS_NO_SNAPSHOT
+}
+
+// Registers a benchmark per capture and backend, named
+// `BM_SkiaFrameCapture/<capture>/<backend>`.
+static void RegisterFrameCaptureBenchmarks(
+    const std::vector<Capture>& captures) {
+  std::vector<BackendType> backends;
+#ifdef ENABLE_SOFTWARE_BENCHMARKS
+  backends.push_back(DlSurfaceProvider::kSoftware_Backend);
+#endif
+#ifdef ENABLE_OPENGL_BENCHMARKS
+  backends.push_back(DlSurfaceProvider::kOpenGL_Backend);
+#endif
+#ifdef ENABLE_METAL_BENCHMARKS
+  backends.push_back(DlSurfaceProvider::kMetal_Backend);
+#endif
+
+  for (const auto& capture : captures) {
+    for (auto backend : backends) {
+      auto backend_name = DlSurfaceProvider::Create(backend)->backend_name();
+      auto name = "BM_SkiaFrameCapture/" + capture.name + "/" + backend_name;
+      benchmark::RegisterBenchmark(name.c_str(), BM_SkiaFrameCapture, backend,
+                                   capture)
+          ->UseRealTime()
+          ->Unit(benchmark::kMillisecond);
+    }
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
+
+// Runs the frame capture benchmarks.
+//
+// --capture-dir=<path>  The directory of the captures to replay, one capture
+//                       written by |flutter::DisplayListFrameCapture| per
+//                       file with the `.dlcapture` extension.
+//
+// All other flags are passed to Google Benchmark, e.g.
+// `--benchmark_format=json`. The same captures can be replayed with Impeller
+// by the scene benchmarks of impeller/display_list.
+int main(int argc, char** argv) {
+  auto command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  std::string capture_directory;
+  if (!command_line.GetOptionValue("capture-dir", &capture_directory)) {
+    FML_LOG(ERROR) << "Pass the directory of the captures with --capture-dir.";
+    return 1;
+  }
+
+  auto captures = flutter::testing::LoadCaptures(capture_directory);
+  if (captures.empty()) {
+    FML_LOG(ERROR) << "No captures were found in " << capture_directory;
+    return 1;
+  }
+  flutter::testing::RegisterFrameCaptureBenchmarks(captures);
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
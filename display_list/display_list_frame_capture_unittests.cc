@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_frame_capture.h"
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<DisplayList> MakeFrameList(int index) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor(0xFF000000 | (index * 0x102030)));
+  builder.drawRect(SkRect::MakeXYWH(index * 10, 5, 20, 20));
+  builder.save();
+  builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect, false);
+  builder.drawCircle({25, 25}, 10 + index);
+  builder.restore();
+  return builder.Build();
+}
+
+TEST(DisplayListFrameCapture, FramesRoundTrip) {
+  DisplayListFrameCapture capture;
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(capture.AddFrame({
+        .frame_size = SkISize::Make(100 + i, 200),
+        .device_pixel_ratio = 2.0f,
+        .build_time = fml::TimeDelta::FromMicroseconds(1000 + i),
+        .raster_time = fml::TimeDelta::FromMicroseconds(2000 + i),
+        .display_list = MakeFrameList(i),
+    }));
+  }
+  EXPECT_EQ(capture.frame_count(), 3u);
+
+  auto frames = DisplayListFrameCapture::Deserialize(capture.Serialize());
+  ASSERT_TRUE(frames.has_value());
+  ASSERT_EQ(frames->size(), 3u);
+  for (int i = 0; i < 3; i++) {
+    const auto& frame = (*frames)[i];
+    EXPECT_EQ(frame.frame_size, SkISize::Make(100 + i, 200));
+    EXPECT_EQ(frame.device_pixel_ratio, 2.0f);
+    EXPECT_EQ(frame.build_time.ToMicroseconds(), 1000 + i);
+    EXPECT_EQ(frame.raster_time.ToMicroseconds(), 2000 + i);
+    ASSERT_NE(frame.display_list, nullptr);
+    EXPECT_TRUE(frame.display_list->Equals(MakeFrameList(i)));
+  }
+}
+
+TEST(DisplayListFrameCapture, EmptyCaptureRoundTrips) {
+  DisplayListFrameCapture capture;
+  auto frames = DisplayListFrameCapture::Deserialize(capture.Serialize());
+  ASSERT_TRUE(frames.has_value());
+  EXPECT_TRUE(frames->empty());
+}
+
+TEST(DisplayListFrameCapture, FramesWithoutDisplayListAreNotAdded) {
+  DisplayListFrameCapture capture;
+  EXPECT_FALSE(capture.AddFrame({.frame_size = SkISize::Make(10, 10)}));
+  EXPECT_EQ(capture.frame_count(), 0u);
+}
+
+TEST(DisplayListFrameCapture, RejectsInvalidData) {
+  EXPECT_FALSE(DisplayListFrameCapture::Deserialize(nullptr).has_value());
+  EXPECT_FALSE(DisplayListFrameCapture::Deserialize(
+                   SkData::MakeWithCString("not a capture"))
+                   .has_value());
+
+  DisplayListFrameCapture capture;
+  ASSERT_TRUE(capture.AddFrame({
+      .frame_size = SkISize::Make(100, 100),
+      .display_list = MakeFrameList(0),
+  }));
+  sk_sp<SkData> data = capture.Serialize();
+  // A truncated capture is rejected instead of being read past its end.
+  EXPECT_FALSE(DisplayListFrameCapture::Deserialize(
+                   SkData::MakeSubset(data.get(), 0, data->size() / 2))
+                   .has_value());
+}
+
+}  // namespace testing
+}  // namespace flutter
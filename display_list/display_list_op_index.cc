@@ -0,0 +1,313 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_op_index.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_ops.h"
+
+namespace flutter {
+
+namespace {
+
+// Ops that set the same attribute of the rendering state share a slot so
+// that only the most recent of them needs to be replayed.
+enum class AttributeSlot {
+  kAntiAlias,
+  kDither,
+  kInvertColors,
+  kStrokeCap,
+  kStrokeJoin,
+  kStyle,
+  kStrokeWidth,
+  kStrokeMiter,
+  kColor,
+  kBlend,
+  kPathEffect,
+  kColorFilter,
+  kColorSource,
+  kImageFilter,
+  kMaskFilter,
+};
+static constexpr int kAttributeSlotCount =
+    static_cast<int>(AttributeSlot::kMaskFilter) + 1;
+
+enum class OpKind {
+  kAttribute,
+  kSave,
+  kRestore,
+  kTransformOrClip,
+  kRender,
+};
+
+OpKind KindOf(DisplayListOpType type, AttributeSlot* slot) {
+  switch (type) {
+#define DL_ATTRIBUTE_CASE(name, attribute) \
+  case DisplayListOpType::k##name:         \
+    *slot = AttributeSlot::k##attribute;   \
+    return OpKind::kAttribute;
+
+    DL_ATTRIBUTE_CASE(SetAntiAlias, AntiAlias)
+    DL_ATTRIBUTE_CASE(SetDither, Dither)
+    DL_ATTRIBUTE_CASE(SetInvertColors, InvertColors)
+    DL_ATTRIBUTE_CASE(SetStrokeCap, StrokeCap)
+    DL_ATTRIBUTE_CASE(SetStrokeJoin, StrokeJoin)
+    DL_ATTRIBUTE_CASE(SetStyle, Style)
+    DL_ATTRIBUTE_CASE(SetStrokeWidth, StrokeWidth)
+    DL_ATTRIBUTE_CASE(SetStrokeMiter, StrokeMiter)
+    DL_ATTRIBUTE_CASE(SetColor, Color)
+    DL_ATTRIBUTE_CASE(SetBlendMode, Blend)
+    DL_ATTRIBUTE_CASE(SetBlender, Blend)
+    DL_ATTRIBUTE_CASE(ClearBlender, Blend)
+    DL_ATTRIBUTE_CASE(SetSkPathEffect, PathEffect)
+    DL_ATTRIBUTE_CASE(SetPodPathEffect, PathEffect)
+    DL_ATTRIBUTE_CASE(ClearPathEffect, PathEffect)
+    DL_ATTRIBUTE_CASE(ClearColorFilter, ColorFilter)
+    DL_ATTRIBUTE_CASE(SetPodColorFilter, ColorFilter)
+    DL_ATTRIBUTE_CASE(SetSkColorFilter, ColorFilter)
+    DL_ATTRIBUTE_CASE(ClearColorSource, ColorSource)
+    DL_ATTRIBUTE_CASE(SetPodColorSource, ColorSource)
+    DL_ATTRIBUTE_CASE(SetSkColorSource, ColorSource)
+    DL_ATTRIBUTE_CASE(SetImageColorSource, ColorSource)
+    DL_ATTRIBUTE_CASE(SetRuntimeEffectColorSource, ColorSource)
+#ifdef IMPELLER_ENABLE_3D
+    DL_ATTRIBUTE_CASE(SetSceneColorSource, ColorSource)
+#endif  // IMPELLER_ENABLE_3D
+    DL_ATTRIBUTE_CASE(ClearImageFilter, ImageFilter)
+    DL_ATTRIBUTE_CASE(SetPodImageFilter, ImageFilter)
+    DL_ATTRIBUTE_CASE(SetSkImageFilter, ImageFilter)
+    DL_ATTRIBUTE_CASE(SetSharedImageFilter, ImageFilter)
+    DL_ATTRIBUTE_CASE(ClearMaskFilter, MaskFilter)
+    DL_ATTRIBUTE_CASE(SetPodMaskFilter, MaskFilter)
+    DL_ATTRIBUTE_CASE(SetSkMaskFilter, MaskFilter)
+
+#undef DL_ATTRIBUTE_CASE
+
+    case DisplayListOpType::kSave:
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds:
+      return OpKind::kSave;
+
+    case DisplayListOpType::kRestore:
+      return OpKind::kRestore;
+
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kRotate:
+    case DisplayListOpType::kSkew:
+    case DisplayListOpType::kTransform2DAffine:
+    case DisplayListOpType::kTransformFullPerspective:
+    case DisplayListOpType::kTransformReset:
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferenceRect:
+    case DisplayListOpType::kClipDifferenceRRect:
+    case DisplayListOpType::kClipDifferencePath:
+      return OpKind::kTransformOrClip;
+
+    default:
+      return OpKind::kRender;
+  }
+}
+
+// Stable sorts |offsets| by |keys| in [0, key_count) and returns the start
+// of the entries of each key, followed by the total count.
+std::vector<uint32_t> SortByKey(const std::vector<int>& keys,
+                                int key_count,
+                                std::vector<uint32_t>& offsets) {
+  std::vector<uint32_t> starts(key_count + 1, 0u);
+  for (int key : keys) {
+    starts[key + 1]++;
+  }
+  for (int i = 0; i < key_count; i++) {
+    starts[i + 1] += starts[i];
+  }
+  std::vector<uint32_t> sorted(offsets.size());
+  std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+  for (size_t i = 0; i < offsets.size(); i++) {
+    sorted[next[keys[i]]++] = offsets[i];
+  }
+  offsets.swap(sorted);
+  return starts;
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T>& vector) {
+  return sizeof(T) * vector.capacity();
+}
+
+}  // namespace
+
+DlOpIndex::DlOpIndex(const uint8_t* ops,
+                     size_t byte_count,
+                     const SkRect rects[],
+                     const int ids[],
+                     int count) {
+  // The offset of every op and the save that encloses it, by op index.
+  // A restore is considered to be within the save that it closes.
+  std::vector<uint32_t> op_offsets;
+  std::vector<int> op_saves;
+  std::vector<int> save_stack;
+
+  std::vector<int> state_saves;
+  std::vector<int> attribute_slots;
+
+  const uint8_t* ptr = ops;
+  const uint8_t* end = ops + byte_count;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    uint32_t offset = ptr - ops;
+    int op_index = op_offsets.size();
+    int save_index = save_stack.empty() ? kTopLevel : save_stack.back();
+    op_offsets.push_back(offset);
+    op_saves.push_back(save_index);
+    ptr += op->size;
+
+    AttributeSlot slot = AttributeSlot::kAntiAlias;
+    switch (KindOf(op->type, &slot)) {
+      case OpKind::kAttribute:
+        attribute_offsets_.push_back(offset);
+        attribute_slots.push_back(static_cast<int>(slot));
+        break;
+      case OpKind::kSave:
+        save_stack.push_back(save_offsets_.size());
+        save_offsets_.push_back(offset);
+        save_op_indices_.push_back(op_index);
+        restore_offsets_.push_back(byte_count);
+        restore_op_indices_.push_back(std::numeric_limits<int>::max());
+        save_parents_.push_back(save_index);
+        save_depths_.push_back(save_stack.size());
+        break;
+      case OpKind::kRestore:
+        FML_DCHECK(!save_stack.empty());
+        if (!save_stack.empty()) {
+          restore_offsets_[save_index] = offset;
+          restore_op_indices_[save_index] = op_index;
+          save_stack.pop_back();
+        }
+        break;
+      case OpKind::kTransformOrClip:
+        state_offsets_.push_back(offset);
+        // Shifted so that the top level sorts first.
+        state_saves.push_back(save_index + 1);
+        break;
+      case OpKind::kRender:
+        break;
+    }
+  }
+  FML_DCHECK(save_stack.empty());
+
+  int op_count = op_offsets.size();
+  for (int i = 0; i < count; i++) {
+    int id = ids[i];
+    if (id < 0 || id >= op_count) {
+      continue;
+    }
+    // A nested DisplayList contributes one rect per rect of its own rtree,
+    // all with the same op index.
+    if (!render_op_indices_.empty() && render_op_indices_.back() == id) {
+      render_bounds_.back().join(rects[i]);
+      continue;
+    }
+    FML_DCHECK(render_op_indices_.empty() || render_op_indices_.back() < id);
+    render_offsets_.push_back(op_offsets[id]);
+    render_op_indices_.push_back(id);
+    render_bounds_.push_back(rects[i]);
+    render_saves_.push_back(op_saves[id]);
+  }
+
+  int render_count = render_bounds_.size();
+  render_max_bottoms_.resize(render_count);
+  render_min_tops_.resize(render_count);
+  SkScalar max_bottom = std::numeric_limits<SkScalar>::lowest();
+  for (int i = 0; i < render_count; i++) {
+    max_bottom = std::max(max_bottom, render_bounds_[i].fBottom);
+    render_max_bottoms_[i] = max_bottom;
+  }
+  SkScalar min_top = std::numeric_limits<SkScalar>::max();
+  for (int i = render_count - 1; i >= 0; i--) {
+    min_top = std::min(min_top, render_bounds_[i].fTop);
+    render_min_tops_[i] = min_top;
+  }
+
+  state_starts_ = SortByKey(state_saves, save_count() + 1, state_offsets_);
+  attribute_starts_ =
+      SortByKey(attribute_slots, kAttributeSlotCount, attribute_offsets_);
+}
+
+int DlOpIndex::FirstCandidate(const SkRect& cull_rect) const {
+  // Entries that end at or above the top of the cull rect don't intersect.
+  auto it = std::upper_bound(render_max_bottoms_.begin(),
+                             render_max_bottoms_.end(), cull_rect.fTop);
+  return it - render_max_bottoms_.begin();
+}
+
+int DlOpIndex::LastCandidate(const SkRect& cull_rect) const {
+  // Entries that start at or below the bottom of the cull rect don't
+  // intersect.
+  auto it = std::lower_bound(render_min_tops_.begin(), render_min_tops_.end(),
+                             cull_rect.fBottom);
+  return (it - render_min_tops_.begin()) - 1;
+}
+
+int DlOpIndex::NextVisible(int begin, int end, const SkRect& cull_rect) const {
+  for (int i = begin; i <= end; i++) {
+    if (SkRect::Intersects(render_bounds_[i], cull_rect)) {
+      return i;
+    }
+  }
+  return end + 1;
+}
+
+int DlOpIndex::FirstSaveAtOrAfter(uint32_t offset) const {
+  auto it = std::lower_bound(save_offsets_.begin(), save_offsets_.end(),
+                             offset);
+  return it - save_offsets_.begin();
+}
+
+void DlOpIndex::FindStateOps(int save_index,
+                             uint32_t begin,
+                             uint32_t end,
+                             int* first,
+                             int* last) const {
+  auto start = state_offsets_.begin() + state_starts_[save_index + 1];
+  auto stop = state_offsets_.begin() + state_starts_[save_index + 2];
+  *first = std::lower_bound(start, stop, begin) - state_offsets_.begin();
+  *last = std::lower_bound(start, stop, end) - state_offsets_.begin();
+}
+
+void DlOpIndex::FindAttributeOps(uint32_t begin,
+                                 uint32_t end,
+                                 std::vector<uint32_t>* offsets) const {
+  size_t first_new = offsets->size();
+  for (int slot = 0; slot < kAttributeSlotCount; slot++) {
+    auto start = attribute_offsets_.begin() + attribute_starts_[slot];
+    auto stop = attribute_offsets_.begin() + attribute_starts_[slot + 1];
+    auto it = std::lower_bound(start, stop, end);
+    if (it != start && *(it - 1) >= begin) {
+      offsets->push_back(*(it - 1));
+    }
+  }
+  std::sort(offsets->begin() + first_new, offsets->end());
+}
+
+size_t DlOpIndex::bytes_used() const {
+  return sizeof(DlOpIndex) +  //
+         VectorBytes(render_offsets_) + VectorBytes(render_op_indices_) +
+         VectorBytes(render_bounds_) + VectorBytes(render_saves_) +
+         VectorBytes(render_max_bottoms_) + VectorBytes(render_min_tops_) +
+         VectorBytes(save_offsets_) + VectorBytes(save_op_indices_) +
+         VectorBytes(restore_offsets_) + VectorBytes(restore_op_indices_) +
+         VectorBytes(save_parents_) + VectorBytes(save_depths_) +
+         VectorBytes(state_offsets_) + VectorBytes(state_starts_) +
+         VectorBytes(attribute_offsets_) + VectorBytes(attribute_starts_);
+}
+
+}  // namespace flutter
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OP_INDEX_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OP_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+
+namespace flutter {
+
+/// A compact index over the ops of a DisplayList that allows a culled
+/// dispatch to seek directly to the ops that are visible instead of
+/// walking every op in the list.
+///
+/// The index is stored as a structure of arrays with entries for:
+/// - the rendering ops, with their byte offset, op index, bounds and the
+///   save that encloses them,
+/// - the save and saveLayer ops, with the offsets of the matching restore,
+///   the enclosing save and the save depth,
+/// - the transform and clip ops, grouped by the save that encloses them,
+/// - the attribute ops, grouped by the attribute they set.
+///
+/// Seeking to a rendering op only needs the state that is current at that
+/// op: the enclosing saves, the transform and clip ops at each of their
+/// levels and the most recent op of each attribute. All of these can be
+/// found with binary searches in the arrays above.
+class DlOpIndex : public SkRefCnt {
+ public:
+  /// The |save_index| of the top level of the list, outside of any save.
+  static constexpr int kTopLevel = -1;
+
+  /// Indexes the |byte_count| bytes of ops at |ops|. The rendering ops are
+  /// described by the |count| |rects| tagged with their op index in |ids|,
+  /// as accumulated for the DlRTree of the list. The ids must not decrease.
+  DlOpIndex(const uint8_t* ops,
+            size_t byte_count,
+            const SkRect rects[],
+            const int ids[],
+            int count);
+
+  /// The number of rendering op entries.
+  int render_count() const { return render_offsets_.size(); }
+
+  uint32_t render_offset(int i) const { return render_offsets_[i]; }
+  int render_op_index(int i) const { return render_op_indices_[i]; }
+  const SkRect& render_bounds(int i) const { return render_bounds_[i]; }
+  int render_save(int i) const { return render_saves_[i]; }
+
+  /// Returns the first rendering entry that is not entirely above the
+  /// |cull_rect|, or |render_count| if they all are.
+  int FirstCandidate(const SkRect& cull_rect) const;
+
+  /// Returns the last rendering entry that is not entirely below the
+  /// |cull_rect|, or -1 if they all are.
+  int LastCandidate(const SkRect& cull_rect) const;
+
+  /// Returns the first rendering entry in [begin, end] that intersects the
+  /// |cull_rect|, or |end + 1| if none of them do.
+  int NextVisible(int begin, int end, const SkRect& cull_rect) const;
+
+  /// The number of save and saveLayer ops.
+  int save_count() const { return save_offsets_.size(); }
+
+  uint32_t save_offset(int i) const { return save_offsets_[i]; }
+  int save_op_index(int i) const { return save_op_indices_[i]; }
+  uint32_t restore_offset(int i) const { return restore_offsets_[i]; }
+  int restore_op_index(int i) const { return restore_op_indices_[i]; }
+  int save_parent(int i) const { return save_parents_[i]; }
+  int save_depth(int i) const { return save_depths_[i]; }
+
+  /// Returns the first save whose op is at or after |offset|.
+  int FirstSaveAtOrAfter(uint32_t offset) const;
+
+  /// Finds the transform and clip ops that are directly within the save
+  /// |save_index| (or at the top level) and in [begin, end). Returns the
+  /// range of the matching entries in [|*first|, |*last|).
+  void FindStateOps(int save_index,
+                    uint32_t begin,
+                    uint32_t end,
+                    int* first,
+                    int* last) const;
+
+  uint32_t state_offset(int i) const { return state_offsets_[i]; }
+
+  /// Appends the offset of the most recent op of each attribute that was
+  /// set in [begin, end) to |offsets|, in the order of the ops.
+  void FindAttributeOps(uint32_t begin,
+                        uint32_t end,
+                        std::vector<uint32_t>* offsets) const;
+
+  /// Returns the bytes used by the object and all of its arrays.
+  size_t bytes_used() const;
+
+ private:
+  std::vector<uint32_t> render_offsets_;
+  std::vector<int> render_op_indices_;
+  std::vector<SkRect> render_bounds_;
+  std::vector<int> render_saves_;
+  // The running maximum of the bottoms and the running minimum of the tops
+  // from the end of the rendering entries, for the candidate searches.
+  std::vector<SkScalar> render_max_bottoms_;
+  std::vector<SkScalar> render_min_tops_;
+
+  std::vector<uint32_t> save_offsets_;
+  std::vector<int> save_op_indices_;
+  std::vector<uint32_t> restore_offsets_;
+  std::vector<int> restore_op_indices_;
+  std::vector<int> save_parents_;
+  std::vector<int> save_depths_;
+
+  // Sorted by the enclosing save (top level first) and then by offset.
+  // The entries of the save |i| start at |state_starts_[i + 1]|.
+  std::vector<uint32_t> state_offsets_;
+  std::vector<uint32_t> state_starts_;
+
+  // Sorted by the attribute and then by offset. The entries of the
+  // attribute |i| start at |attribute_starts_[i]|.
+  std::vector<uint32_t> attribute_offsets_;
+  std::vector<uint32_t> attribute_starts_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlOpIndex);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OP_INDEX_H_
@@ -0,0 +1,254 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_op_index.h"
+
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr int kRenderSize = 100;
+static constexpr int kItemCount = 1000;
+static constexpr SkScalar kItemHeight = 20;
+
+static DlColor ItemColor(int i) {
+  return DlColor(0xFF000000 | ((i * 0x3F1) & 0xFFFFFF));
+}
+
+// Records a tall list of items that each set their own transform, clip and
+// color within a save, grouped ten items to a group.
+static sk_sp<DisplayList> MakeNestedList(bool prepare_rtree) {
+  DisplayListBuilder builder(prepare_rtree);
+  for (int group = 0; group < kItemCount / 10; group++) {
+    builder.save();
+    builder.translate(0, group * 10 * kItemHeight);
+    for (int i = 0; i < 10; i++) {
+      int item = group * 10 + i;
+      builder.save();
+      builder.translate(0, i * kItemHeight);
+      builder.clipRect(SkRect::MakeWH(kRenderSize, kItemHeight),
+                       SkClipOp::kIntersect, false);
+      builder.setColor(ItemColor(item));
+      builder.drawRect(SkRect::MakeXYWH(5, 5, 50, kItemHeight));
+      builder.restore();
+    }
+    builder.restore();
+  }
+  return builder.Build();
+}
+
+// Records a tall list of items that are positioned by transforms at the
+// top level and only some of which change the color.
+static sk_sp<DisplayList> MakeFlatList(bool prepare_rtree) {
+  DisplayListBuilder builder(prepare_rtree);
+  builder.setStrokeWidth(3);
+  for (int i = 0; i < kItemCount; i++) {
+    if (i % 7 == 0) {
+      builder.setColor(ItemColor(i));
+    }
+    builder.setStyle(i % 3 == 0 ? DlDrawStyle::kStroke : DlDrawStyle::kFill);
+    builder.drawRect(SkRect::MakeXYWH(5, 5, 50, 10));
+    builder.translate(0, kItemHeight);
+  }
+  return builder.Build();
+}
+
+// Renders the |culled| list, which is dispatched with the clip of the
+// canvas as the cull rect, and the |expected| list, which is fully
+// dispatched, scrolled by |scroll| and expects the same pixels.
+static void ExpectSameRendering(const sk_sp<DisplayList>& expected,
+                                const sk_sp<DisplayList>& culled,
+                                SkScalar scroll) {
+  ASSERT_FALSE(expected->has_op_index());
+  ASSERT_TRUE(culled->has_op_index());
+  auto expected_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  auto culled_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  expected_surface->getCanvas()->translate(0, -scroll);
+  culled_surface->getCanvas()->translate(0, -scroll);
+  expected->RenderTo(expected_surface->getCanvas());
+  culled->RenderTo(culled_surface->getCanvas());
+  SkPixmap expected_pixels;
+  SkPixmap culled_pixels;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected_pixels));
+  ASSERT_TRUE(culled_surface->peekPixels(&culled_pixels));
+  for (int y = 0; y < kRenderSize; y++) {
+    for (int x = 0; x < kRenderSize; x++) {
+      ASSERT_EQ(*expected_pixels.addr32(x, y), *culled_pixels.addr32(x, y))
+          << "at " << x << ", " << y << " scrolled by " << scroll;
+    }
+  }
+}
+
+TEST(DlOpIndex, IsOnlyBuiltWithAnRTree) {
+  DisplayListBuilder builder(false);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  EXPECT_FALSE(builder.Build()->has_op_index());
+
+  DisplayListBuilder rtree_builder(true);
+  rtree_builder.drawRect(SkRect::MakeWH(10, 10));
+  EXPECT_TRUE(rtree_builder.Build()->has_op_index());
+}
+
+TEST(DlOpIndex, FindsCandidatesOfVerticalList) {
+  DisplayListBuilder builder(true);
+  for (int i = 0; i < 10; i++) {
+    builder.drawRect(SkRect::MakeXYWH(0, i * 10, 10, 10));
+  }
+  auto index = builder.Build()->op_index();
+
+  ASSERT_EQ(index->render_count(), 10);
+  SkRect cull_rect = SkRect::MakeLTRB(0, 35, 10, 55);
+  EXPECT_EQ(index->FirstCandidate(cull_rect), 3);
+  EXPECT_EQ(index->LastCandidate(cull_rect), 5);
+  EXPECT_EQ(index->NextVisible(3, 5, cull_rect), 3);
+  EXPECT_EQ(index->NextVisible(3, 5, SkRect::MakeLTRB(20, 35, 30, 55)), 6);
+
+  EXPECT_EQ(index->FirstCandidate(SkRect::MakeLTRB(0, 200, 10, 300)), 10);
+  EXPECT_EQ(index->LastCandidate(SkRect::MakeLTRB(0, -100, 10, 0)), -1);
+}
+
+TEST(DlOpIndex, TracksSavesAndTheirStateOps) {
+  DisplayListBuilder builder(true);
+  builder.translate(10, 10);
+  builder.save();
+  builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect, false);
+  builder.save();
+  builder.scale(2, 2);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  builder.restore();
+  builder.restore();
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  auto index = builder.Build()->op_index();
+
+  ASSERT_EQ(index->save_count(), 2);
+  EXPECT_EQ(index->save_parent(0), DlOpIndex::kTopLevel);
+  EXPECT_EQ(index->save_parent(1), 0);
+  EXPECT_EQ(index->save_depth(0), 1);
+  EXPECT_EQ(index->save_depth(1), 2);
+  EXPECT_EQ(index->save_op_index(0), 1);
+  EXPECT_EQ(index->save_op_index(1), 3);
+  EXPECT_EQ(index->restore_op_index(1), 6);
+  EXPECT_EQ(index->restore_op_index(0), 7);
+  EXPECT_LT(index->restore_offset(1), index->restore_offset(0));
+
+  ASSERT_EQ(index->render_count(), 2);
+  EXPECT_EQ(index->render_op_index(0), 5);
+  EXPECT_EQ(index->render_save(0), 1);
+  EXPECT_EQ(index->render_op_index(1), 8);
+  EXPECT_EQ(index->render_save(1), DlOpIndex::kTopLevel);
+  EXPECT_EQ(index->render_bounds(0), SkRect::MakeLTRB(10, 10, 30, 30));
+
+  uint32_t end = index->render_offset(1);
+  int first, last;
+  index->FindStateOps(DlOpIndex::kTopLevel, 0u, end, &first, &last);
+  ASSERT_EQ(last - first, 1);
+  EXPECT_EQ(index->state_offset(first), 0u);
+  index->FindStateOps(0, 0u, end, &first, &last);
+  ASSERT_EQ(last - first, 1);
+  EXPECT_GT(index->state_offset(first), index->save_offset(0));
+  EXPECT_LT(index->state_offset(first), index->save_offset(1));
+  index->FindStateOps(1, 0u, index->render_offset(0), &first, &last);
+  ASSERT_EQ(last - first, 1);
+  EXPECT_GT(index->state_offset(first), index->save_offset(1));
+  // Nothing between the first draw and the end of its save.
+  index->FindStateOps(1, index->render_offset(0), end, &first, &last);
+  EXPECT_EQ(last - first, 0);
+}
+
+TEST(DlOpIndex, FindsMostRecentAttributeOps) {
+  DisplayListBuilder builder(true);
+  builder.setColor(DlColor::kRed());
+  builder.setStrokeWidth(5);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  builder.setColor(DlColor::kBlue());
+  builder.setBlendMode(DlBlendMode::kSrc);
+  builder.setColor(DlColor::kGreen());
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  auto index = builder.Build()->op_index();
+
+  ASSERT_EQ(index->render_count(), 2);
+  uint32_t first_draw = index->render_offset(0);
+  uint32_t second_draw = index->render_offset(1);
+
+  std::vector<uint32_t> offsets;
+  index->FindAttributeOps(0u, first_draw, &offsets);
+  EXPECT_EQ(offsets.size(), 2u);
+
+  // The color is set three times, the width once and the blend mode once.
+  offsets.clear();
+  index->FindAttributeOps(0u, second_draw, &offsets);
+  ASSERT_EQ(offsets.size(), 3u);
+  EXPECT_LT(offsets[0], first_draw);
+  EXPECT_GT(offsets[1], first_draw);
+  EXPECT_GT(offsets[2], offsets[1]);
+
+  // Only the ops after the first draw.
+  offsets.clear();
+  index->FindAttributeOps(first_draw, second_draw, &offsets);
+  EXPECT_EQ(offsets.size(), 2u);
+}
+
+TEST(DlOpIndex, CulledDispatchOfTallListOnlyDispatchesVisibleItems) {
+  auto display_list = MakeNestedList(true);
+  ASSERT_GT(display_list->op_count(), 5000u);
+
+  SkRect cull_rect = SkRect::MakeXYWH(0, 10000, kRenderSize, kRenderSize);
+  DisplayListBuilder culling_builder(cull_rect);
+  display_list->RenderTo(&culling_builder);
+  auto culled = culling_builder.Build();
+
+  // Five items touch the cull rect and each of them dispatches its save,
+  // translate, clip, color, draw and restore. The enclosing groups add a
+  // few more ops.
+  EXPECT_GT(culled->op_count(), 30u);
+  EXPECT_LT(culled->op_count(), 50u);
+}
+
+TEST(DlOpIndex, CulledDispatchOfNestedListRendersVisibleItems) {
+  auto expected = MakeNestedList(false);
+  auto culled = MakeNestedList(true);
+  for (SkScalar scroll : {0.0f, 5.0f, 1990.0f, 7777.0f, 19900.0f}) {
+    ExpectSameRendering(expected, culled, scroll);
+  }
+}
+
+TEST(DlOpIndex, CulledDispatchOfFlatListRendersVisibleItems) {
+  auto expected = MakeFlatList(false);
+  auto culled = MakeFlatList(true);
+  for (SkScalar scroll : {0.0f, 5.0f, 1990.0f, 7777.0f, 19900.0f}) {
+    ExpectSameRendering(expected, culled, scroll);
+  }
+}
+
+TEST(DlOpIndex, CulledDispatchSeeksIntoSaveLayerWithAttributes) {
+  auto make_list = [](bool prepare_rtree) {
+    DisplayListBuilder builder(prepare_rtree);
+    for (int i = 0; i < kItemCount; i++) {
+      builder.setColor(ItemColor(i).withAlpha(0x80));
+      builder.saveLayer(nullptr, true);
+      builder.setColor(ItemColor(i + 1));
+      builder.drawRect(SkRect::MakeXYWH(5, i * kItemHeight, 50, 10));
+      builder.restore();
+    }
+    return builder.Build();
+  };
+  auto expected = make_list(false);
+  auto culled = make_list(true);
+  for (SkScalar scroll : {0.0f, 1990.0f, 7777.0f}) {
+    ExpectSameRendering(expected, culled, scroll);
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
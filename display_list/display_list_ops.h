@@ -338,6 +338,8 @@ struct SetSharedImageFilterOp : DLOp {
 
   SetSharedImageFilterOp(const DlImageFilter* filter)
       : filter(filter->shared()) {}
+  explicit SetSharedImageFilterOp(std::shared_ptr<DlImageFilter> filter)
+      : filter(std::move(filter)) {}
 
   const std::shared_ptr<DlImageFilter> filter;
 
@@ -418,6 +420,9 @@ struct SaveLayerBackdropOp final : SaveOpBase {
   explicit SaveLayerBackdropOp(const SaveLayerOptions options,
                                const DlImageFilter* backdrop)
       : SaveOpBase(options), backdrop(backdrop->shared()) {}
+  SaveLayerBackdropOp(const SaveLayerOptions options,
+                      std::shared_ptr<DlImageFilter> backdrop)
+      : SaveOpBase(options), backdrop(std::move(backdrop)) {}
 
   const std::shared_ptr<DlImageFilter> backdrop;
 
@@ -441,6 +446,10 @@ struct SaveLayerBackdropBoundsOp final : SaveOpBase {
                             const SkRect& rect,
                             const DlImageFilter* backdrop)
       : SaveOpBase(options), rect(rect), backdrop(backdrop->shared()) {}
+  SaveLayerBackdropBoundsOp(const SaveLayerOptions options,
+                            const SkRect& rect,
+                            std::shared_ptr<DlImageFilter> backdrop)
+      : SaveOpBase(options), rect(rect), backdrop(std::move(backdrop)) {}
 
   const SkRect rect;
   const std::shared_ptr<DlImageFilter> backdrop;
@@ -0,0 +1,650 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_optimizer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/display_list/display_list_dispatcher.h"
+#include "flutter/display_list/display_list_matrix_clip_tracker.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkM44.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkVertices.h"
+
+namespace flutter {
+
+namespace {
+
+// Replays a DisplayList into a DisplayListBuilder while removing ops that
+// have no effect on the rendering.
+//
+// The builder already skips attribute ops that don't change the current
+// value and saves that are never followed by a transform, clip or draw. So
+// attributes are forwarded as they are. Transforms are held back until
+// something depends on them, which lets consecutive transforms collapse into
+// one and lets transforms that are reset or restored disappear.
+//
+// Folding layers needs to know what a layer contains before the layer is
+// replayed. So the list is dispatched twice. The first, analyzing, pass
+// records which layers can be folded into their only child.
+class OptimizingDispatcher final : public virtual Dispatcher {
+ public:
+  OptimizingDispatcher(DisplayListBuilder& builder,
+                       const SkRect& cull_rect,
+                       std::vector<bool>& foldable_layers,
+                       bool analyzing)
+      : builder_(builder),
+        foldable_layers_(foldable_layers),
+        analyzing_(analyzing),
+        tracker_(cull_rect, SkMatrix::I()) {}
+
+  ~OptimizingDispatcher() = default;
+
+  // |Dispatcher|
+  void setAntiAlias(bool aa) override { builder_.setAntiAlias(aa); }
+  void setDither(bool dither) override { builder_.setDither(dither); }
+  void setStyle(DlDrawStyle style) override { builder_.setStyle(style); }
+  void setColor(DlColor color) override { builder_.setColor(color); }
+  void setStrokeWidth(float width) override { builder_.setStrokeWidth(width); }
+  void setStrokeMiter(float limit) override { builder_.setStrokeMiter(limit); }
+  void setStrokeCap(DlStrokeCap cap) override { builder_.setStrokeCap(cap); }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    builder_.setStrokeJoin(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    builder_.setColorSource(source);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    builder_.setColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    builder_.setInvertColors(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override { builder_.setBlendMode(mode); }
+  void setBlender(sk_sp<SkBlender> blender) override {
+    builder_.setBlender(std::move(blender));
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    builder_.setPathEffect(effect);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    builder_.setMaskFilter(filter);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    builder_.setImageFilter(filter);
+  }
+
+  // |Dispatcher|
+  void save() override {
+    if (analyzing_) {
+      MarkContent();
+      save_stack_.emplace_back();
+      return;
+    }
+    FlushTransform();
+    builder_.save();
+    tracker_.save();
+    save_stack_.emplace_back();
+  }
+
+  // |Dispatcher|
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    bool opacity_only = IsOpacityOnlyLayer(options, backdrop);
+    if (analyzing_) {
+      if (!save_stack_.empty()) {
+        auto& parent = save_stack_.back();
+        if (opacity_only) {
+          parent.child_layers++;
+        } else {
+          parent.has_content = true;
+        }
+      }
+      SaveInfo info;
+      info.is_layer = true;
+      info.can_fold = opacity_only && bounds == nullptr;
+      info.layer_index = foldable_layers_.size();
+      foldable_layers_.push_back(false);
+      save_stack_.push_back(info);
+      return;
+    }
+
+    FlushTransform();
+    SaveInfo info;
+    info.is_layer = true;
+    if (foldable_layers_[layer_count_++]) {
+      // The opacity of this layer is applied by its only child instead.
+      if (options.renders_with_attributes()) {
+        pending_layer_opacity_ *= builder_.getColor().getAlphaF();
+      }
+      info.folded = true;
+    } else {
+      info.filtered =
+          options.renders_with_attributes() && builder_.getImageFilter();
+      EmitSaveLayer(bounds, options, backdrop);
+    }
+    tracker_.save();
+    if (bounds) {
+      tracker_.clipRect(*bounds, SkClipOp::kIntersect, false);
+    }
+    if (info.filtered) {
+      filtered_layer_depth_++;
+    }
+    save_stack_.push_back(info);
+  }
+
+  // |Dispatcher|
+  void restore() override {
+    if (save_stack_.empty()) {
+      return;
+    }
+    SaveInfo info = save_stack_.back();
+    save_stack_.pop_back();
+    if (analyzing_) {
+      if (info.can_fold && !info.has_content && info.child_layers == 1) {
+        foldable_layers_[info.layer_index] = true;
+      }
+      return;
+    }
+
+    // Anything still pending was set after the last draw of this level.
+    has_pending_transform_ = false;
+    pending_transform_reset_ = false;
+    pending_transform_.setIdentity();
+    tracker_.restore();
+    if (info.filtered) {
+      filtered_layer_depth_--;
+    }
+    if (!info.folded) {
+      builder_.restore();
+    }
+  }
+
+  // |Dispatcher|
+  void translate(SkScalar tx, SkScalar ty) override {
+    if (PrepareTransform()) {
+      tracker_.translate(tx, ty);
+      pending_transform_.preTranslate(tx, ty);
+    }
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    if (PrepareTransform()) {
+      tracker_.scale(sx, sy);
+      pending_transform_.preScale(sx, sy);
+    }
+  }
+  void rotate(SkScalar degrees) override {
+    if (PrepareTransform()) {
+      tracker_.rotate(degrees);
+      pending_transform_.preConcat(SkMatrix::RotateDeg(degrees));
+    }
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    if (PrepareTransform()) {
+      tracker_.skew(sx, sy);
+      pending_transform_.preConcat(SkMatrix::Skew(sx, sy));
+    }
+  }
+
+  // clang-format off
+
+  // |Dispatcher|
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    if (PrepareTransform()) {
+      tracker_.transform2DAffine(mxx, mxy, mxt,
+                                 myx, myy, myt);
+      pending_transform_.preConcat(SkM44(mxx, mxy, 0, mxt,
+                                         myx, myy, 0, myt,
+                                         0,   0,   1, 0,
+                                         0,   0,   0, 1));
+    }
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    if (PrepareTransform()) {
+      tracker_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                        myx, myy, myz, myt,
+                                        mzx, mzy, mzz, mzt,
+                                        mwx, mwy, mwz, mwt);
+      pending_transform_.preConcat(SkM44(mxx, mxy, mxz, mxt,
+                                         myx, myy, myz, myt,
+                                         mzx, mzy, mzz, mzt,
+                                         mwx, mwy, mwz, mwt));
+    }
+  }
+
+  // clang-format on
+
+  // |Dispatcher|
+  void transformReset() override {
+    if (PrepareTransform()) {
+      tracker_.setIdentity();
+      pending_transform_.setIdentity();
+      pending_transform_reset_ = true;
+    }
+  }
+
+  // |Dispatcher|
+  void clipRect(const SkRect& rect, SkClipOp clip_op, bool is_aa) override {
+    if (PrepareClip()) {
+      tracker_.clipRect(rect, clip_op, is_aa);
+      builder_.clipRect(rect, clip_op, is_aa);
+    }
+  }
+  void clipRRect(const SkRRect& rrect, SkClipOp clip_op, bool is_aa) override {
+    if (PrepareClip()) {
+      tracker_.clipRRect(rrect, clip_op, is_aa);
+      builder_.clipRRect(rrect, clip_op, is_aa);
+    }
+  }
+  void clipPath(const SkPath& path, SkClipOp clip_op, bool is_aa) override {
+    if (PrepareClip()) {
+      tracker_.clipPath(path, clip_op, is_aa);
+      builder_.clipPath(path, clip_op, is_aa);
+    }
+  }
+
+  // |Dispatcher|
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    if (PrepareDraw(nullptr, false)) {
+      builder_.drawColor(color, mode);
+    }
+  }
+  void drawPaint() override {
+    if (PrepareDraw(nullptr, true)) {
+      builder_.drawPaint();
+    }
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    SkRect bounds = SkRect::MakeLTRB(p0.fX, p0.fY, p1.fX, p1.fY).makeSorted();
+    if (PrepareDraw(&bounds, true, true)) {
+      builder_.drawLine(p0, p1);
+    }
+  }
+  void drawRect(const SkRect& rect) override {
+    SkRect bounds = rect.makeSorted();
+    if (PrepareDraw(&bounds, true)) {
+      builder_.drawRect(rect);
+    }
+  }
+  void drawOval(const SkRect& bounds) override {
+    SkRect sorted = bounds.makeSorted();
+    if (PrepareDraw(&sorted, true)) {
+      builder_.drawOval(bounds);
+    }
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    SkRect bounds = SkRect::MakeLTRB(center.fX - radius, center.fY - radius,
+                                     center.fX + radius, center.fY + radius);
+    if (PrepareDraw(&bounds, true)) {
+      builder_.drawCircle(center, radius);
+    }
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    if (PrepareDraw(&rrect.getBounds(), true)) {
+      builder_.drawRRect(rrect);
+    }
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    if (PrepareDraw(&outer.getBounds(), true)) {
+      builder_.drawDRRect(outer, inner);
+    }
+  }
+  void drawPath(const SkPath& path) override {
+    // Inverse fills cover everything outside of the path.
+    if (PrepareDraw(path.isInverseFillType() ? nullptr : &path.getBounds(),
+                    true)) {
+      builder_.drawPath(path);
+    }
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    SkRect bounds = oval_bounds.makeSorted();
+    if (PrepareDraw(&bounds, true)) {
+      builder_.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+    }
+  }
+  void drawPoints(SkCanvas::PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    SkRect bounds;
+    bounds.setBounds(points, count);
+    if (PrepareDraw(&bounds, true, true)) {
+      builder_.drawPoints(mode, count, points);
+    }
+  }
+  void drawSkVertices(const sk_sp<SkVertices> vertices,
+                      SkBlendMode mode) override {
+    if (PrepareDraw(&vertices->bounds(), true)) {
+      builder_.drawSkVertices(vertices, mode);
+    }
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    SkRect bounds = vertices->bounds();
+    if (PrepareDraw(&bounds, true)) {
+      builder_.drawVertices(vertices, mode);
+    }
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    SkRect bounds = SkRect::MakeXYWH(point.fX, point.fY,  //
+                                     image->width(), image->height());
+    if (PrepareDraw(&bounds, render_with_attributes)) {
+      builder_.drawImage(image, point, sampling, render_with_attributes);
+    }
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    SkRect bounds = dst.makeSorted();
+    if (PrepareDraw(&bounds, render_with_attributes)) {
+      builder_.drawImageRect(image, src, dst, sampling, render_with_attributes,
+                             constraint);
+    }
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    SkRect bounds = dst.makeSorted();
+    if (PrepareDraw(&bounds, render_with_attributes)) {
+      builder_.drawImageNine(image, center, dst, filter,
+                             render_with_attributes);
+    }
+  }
+  void drawImageLattice(const sk_sp<DlImage> image,
+                        const SkCanvas::Lattice& lattice,
+                        const SkRect& dst,
+                        DlFilterMode filter,
+                        bool render_with_attributes) override {
+    SkRect bounds = dst.makeSorted();
+    if (PrepareDraw(&bounds, render_with_attributes)) {
+      builder_.drawImageLattice(image, lattice, dst, filter,
+                                render_with_attributes);
+    }
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    if (PrepareDraw(cull_rect, render_with_attributes)) {
+      builder_.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                         cull_rect, render_with_attributes);
+    }
+  }
+  void drawPicture(const sk_sp<SkPicture> picture,
+                   const SkMatrix* matrix,
+                   bool render_with_attributes) override {
+    if (PrepareDraw(nullptr, render_with_attributes)) {
+      builder_.drawPicture(picture, matrix, render_with_attributes);
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    if (PrepareDraw(&display_list->bounds(), false)) {
+      builder_.drawDisplayList(display_list);
+    }
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    SkRect bounds = blob->bounds().makeOffset(x, y);
+    if (PrepareDraw(&bounds, true)) {
+      builder_.drawTextBlob(blob, x, y);
+    }
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    if (PrepareDraw(nullptr, false)) {
+      builder_.drawShadow(path, color, elevation, transparent_occluder, dpr);
+    }
+  }
+
+ private:
+  struct SaveInfo {
+    bool is_layer = false;
+    // Replay. The layer was folded into its child and was not recorded.
+    bool folded = false;
+    // Replay. The layer has an image filter that can move its content.
+    bool filtered = false;
+    // Analysis. The layer only applies an opacity and has no bounds.
+    bool can_fold = false;
+    size_t layer_index = 0;
+    int child_layers = 0;
+    bool has_content = false;
+  };
+
+  DisplayListBuilder& builder_;
+  std::vector<bool>& foldable_layers_;
+  const bool analyzing_;
+  DisplayListMatrixClipTracker tracker_;
+  std::vector<SaveInfo> save_stack_;
+  size_t layer_count_ = 0;
+  // The opacity of folded layers that is still to be applied by a child.
+  SkScalar pending_layer_opacity_ = SK_Scalar1;
+  int filtered_layer_depth_ = 0;
+  SkM44 pending_transform_;
+  bool has_pending_transform_ = false;
+  bool pending_transform_reset_ = false;
+
+  void MarkContent() {
+    if (!save_stack_.empty()) {
+      save_stack_.back().has_content = true;
+    }
+  }
+
+  bool IsOpacityOnlyLayer(const SaveLayerOptions options,
+                          const DlImageFilter* backdrop) const {
+    if (backdrop) {
+      return false;
+    }
+    if (!options.renders_with_attributes()) {
+      return true;
+    }
+    auto mode = builder_.getBlendMode();
+    return !builder_.getColorFilter() && !builder_.getImageFilter() &&
+           !builder_.isInvertColors() && mode.has_value() &&
+           mode.value() == DlBlendMode::kSrcOver;
+  }
+
+  void EmitSaveLayer(const SkRect* bounds,
+                     const SaveLayerOptions options,
+                     const DlImageFilter* backdrop) {
+    if (pending_layer_opacity_ == SK_Scalar1) {
+      builder_.saveLayer(bounds, options, backdrop);
+      return;
+    }
+    SkScalar opacity = pending_layer_opacity_;
+    pending_layer_opacity_ = SK_Scalar1;
+
+    // Folded layers are only over layers that use at most an opacity. So
+    // their opacity combines with the opacity of this layer.
+    DlColor color = builder_.getColor();
+    if (options.renders_with_attributes()) {
+      builder_.setColor(color.withAlpha(
+          DlColor::toAlpha(color.getAlphaF() * opacity)));
+      builder_.saveLayer(bounds, options, backdrop);
+      builder_.setColor(color);
+      return;
+    }
+
+    // This layer ignored the attributes. So it must now be recorded with
+    // attributes that apply nothing but the opacity.
+    auto color_filter = builder_.getColorFilter();
+    auto image_filter = builder_.getImageFilter();
+    auto blender = builder_.getBlender();
+    bool invert_colors = builder_.isInvertColors();
+    builder_.setColor(color.withAlpha(DlColor::toAlpha(opacity)));
+    builder_.setColorFilter(nullptr);
+    builder_.setImageFilter(nullptr);
+    builder_.setBlendMode(DlBlendMode::kSrcOver);
+    builder_.setInvertColors(false);
+    builder_.saveLayer(bounds, SaveLayerOptions::kWithAttributes, backdrop);
+    builder_.setColor(color);
+    builder_.setColorFilter(color_filter.get());
+    builder_.setImageFilter(image_filter.get());
+    builder_.setBlender(blender);
+    builder_.setInvertColors(invert_colors);
+  }
+
+  // Returns true if the transform should be tracked.
+  bool PrepareTransform() {
+    if (analyzing_) {
+      MarkContent();
+      return false;
+    }
+    has_pending_transform_ = true;
+    return true;
+  }
+
+  // Returns true if the clip should be recorded.
+  bool PrepareClip() {
+    if (analyzing_) {
+      MarkContent();
+      return false;
+    }
+    FlushTransform();
+    return true;
+  }
+
+  // Returns true if the draw should be recorded. |bounds| are the local
+  // bounds of the geometry before any attributes are applied, or nullptr if
+  // the draw is unbounded or its bounds are unknown.
+  bool PrepareDraw(const SkRect* bounds,
+                   bool uses_attributes,
+                   bool always_stroked = false) {
+    if (analyzing_) {
+      MarkContent();
+      return false;
+    }
+    if (IsCulled(bounds, uses_attributes, always_stroked)) {
+      return false;
+    }
+    FlushTransform();
+    return true;
+  }
+
+  bool IsCulled(const SkRect* bounds,
+                bool uses_attributes,
+                bool always_stroked) const {
+    if (tracker_.device_cull_rect().isEmpty()) {
+      return true;
+    }
+    // A filter on an enclosing layer can move content into the clip.
+    if (bounds == nullptr || filtered_layer_depth_ > 0 ||
+        tracker_.using_4x4_matrix()) {
+      return false;
+    }
+    if (uses_attributes &&
+        (builder_.getMaskFilter() || builder_.getImageFilter() ||
+         builder_.getPathEffect())) {
+      return false;
+    }
+    SkRect device_bounds = *bounds;
+    if (uses_attributes &&
+        (always_stroked || builder_.getStyle() != DlDrawStyle::kFill)) {
+      // Covers miter joins up to the miter limit and square caps.
+      SkScalar outset =
+          builder_.getStrokeWidth() * 0.5f *
+          std::max(builder_.getStrokeMiter(), SK_ScalarSqrt2);
+      device_bounds.outset(outset, outset);
+    }
+    tracker_.mapRect(&device_bounds);
+    // Hairlines and anti-aliasing can touch one more pixel.
+    device_bounds.outset(1.0f, 1.0f);
+    return !device_bounds.intersects(tracker_.device_cull_rect());
+  }
+
+  void FlushTransform() {
+    if (pending_transform_reset_) {
+      builder_.transformReset();
+      pending_transform_reset_ = false;
+    }
+    if (!has_pending_transform_) {
+      return;
+    }
+    has_pending_transform_ = false;
+    const SkM44& m = pending_transform_;
+    if (m.rc(0, 2) == 0 && m.rc(1, 2) == 0 &&  //
+        m.rc(2, 0) == 0 && m.rc(2, 1) == 0 &&  //
+        m.rc(2, 2) == 1 && m.rc(2, 3) == 0 &&  //
+        m.rc(3, 0) == 0 && m.rc(3, 1) == 0 &&  //
+        m.rc(3, 2) == 0 && m.rc(3, 3) == 1) {
+      SkScalar mxx = m.rc(0, 0), mxy = m.rc(0, 1), mxt = m.rc(0, 3);
+      SkScalar myx = m.rc(1, 0), myy = m.rc(1, 1), myt = m.rc(1, 3);
+      if (mxy == 0 && myx == 0 && mxx == 1 && myy == 1) {
+        builder_.translate(mxt, myt);
+      } else if (mxy == 0 && myx == 0 && mxt == 0 && myt == 0) {
+        builder_.scale(mxx, myy);
+      } else {
+        builder_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+      }
+    } else {
+      // clang-format off
+      builder_.transformFullPerspective(
+          m.rc(0, 0), m.rc(0, 1), m.rc(0, 2), m.rc(0, 3),
+          m.rc(1, 0), m.rc(1, 1), m.rc(1, 2), m.rc(1, 3),
+          m.rc(2, 0), m.rc(2, 1), m.rc(2, 2), m.rc(2, 3),
+          m.rc(3, 0), m.rc(3, 1), m.rc(3, 2), m.rc(3, 3));
+      // clang-format on
+    }
+    pending_transform_.setIdentity();
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(OptimizingDispatcher);
+};
+
+}  // namespace
+
+sk_sp<DisplayList> DisplayListOptimizer::Optimize(
+    const sk_sp<DisplayList>& display_list,
+    const SkRect& cull_rect,
+    Stats* stats) {
+  TRACE_EVENT0("flutter", "DisplayListOptimizer::Optimize");
+  std::vector<bool> foldable_layers;
+  {
+    DisplayListBuilder scratch;
+    OptimizingDispatcher analyzer(scratch, cull_rect, foldable_layers,
+                                  /*analyzing=*/true);
+    display_list->Dispatch(analyzer);
+  }
+
+  DisplayListBuilder builder(cull_rect, display_list->has_rtree());
+  OptimizingDispatcher optimizer(builder, cull_rect, foldable_layers,
+                                 /*analyzing=*/false);
+  display_list->Dispatch(optimizer);
+  auto optimized = builder.Build();
+
+  if (stats) {
+    stats->op_count_before = display_list->op_count();
+    stats->op_count_after = optimized->op_count();
+    stats->bytes_before = display_list->bytes();
+    stats->bytes_after = optimized->bytes();
+  }
+  return optimized;
+}
+
+}  // namespace flutter
@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OPTIMIZER_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OPTIMIZER_H_
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+
+namespace flutter {
+
+// Rewrites a built DisplayList into an equivalent one with fewer ops.
+//
+// The optimized list renders the same pixels as the original. It:
+// - drops attribute ops that set the value that is already current,
+// - drops save/restore pairs that contain no rendering,
+// - folds runs of transform ops into a single op and drops transforms
+//   that are reset or restored before anything is drawn with them,
+// - drops draws that fall completely outside of the clip,
+// - folds a saveLayer that applies only an opacity and contains nothing
+//   but another such layer into that child layer.
+class DisplayListOptimizer {
+ public:
+  struct Stats {
+    unsigned int op_count_before = 0;
+    unsigned int op_count_after = 0;
+    size_t bytes_before = 0;
+    size_t bytes_after = 0;
+  };
+
+  // Draws are culled against |cull_rect|, which should be the cull rect the
+  // list was recorded with, and against the clips within the list.
+  static sk_sp<DisplayList> Optimize(
+      const sk_sp<DisplayList>& display_list,
+      const SkRect& cull_rect = DisplayListBuilder::kMaxCullRect,
+      Stats* stats = nullptr);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DisplayListOptimizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OPTIMIZER_H_
@@ -0,0 +1,259 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_optimizer.h"
+
+#include <cstdlib>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_color_filter.h"
+#include "flutter/display_list/display_list_image_filter.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr int kRenderSize = 100;
+
+// Renders both lists and expects every channel of every pixel to be within
+// one, which allows for the rounding of combined layer opacities.
+static void ExpectSameRendering(const sk_sp<DisplayList>& expected,
+                                const sk_sp<DisplayList>& actual) {
+  auto expected_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  auto actual_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  expected->RenderTo(expected_surface->getCanvas());
+  actual->RenderTo(actual_surface->getCanvas());
+  SkPixmap expected_pixels;
+  SkPixmap actual_pixels;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected_pixels));
+  ASSERT_TRUE(actual_surface->peekPixels(&actual_pixels));
+  for (int y = 0; y < kRenderSize; y++) {
+    for (int x = 0; x < kRenderSize; x++) {
+      uint32_t e = *expected_pixels.addr32(x, y);
+      uint32_t a = *actual_pixels.addr32(x, y);
+      for (int shift = 0; shift < 32; shift += 8) {
+        int ec = (e >> shift) & 0xFF;
+        int ac = (a >> shift) & 0xFF;
+        ASSERT_LE(std::abs(ec - ac), 1) << "at " << x << ", " << y;
+      }
+    }
+  }
+}
+
+TEST(DisplayListOptimizer, ConsecutiveTransformsAreMerged) {
+  DisplayListBuilder builder;
+  builder.translate(10, 10);
+  builder.translate(5, 5);
+  builder.scale(2, 2);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = DisplayListOptimizer::Optimize(
+      display_list, DisplayListBuilder::kMaxCullRect, &stats);
+
+  DisplayListBuilder expected_builder;
+  expected_builder.transform2DAffine(2, 0, 15,  //
+                                     0, 2, 15);
+  expected_builder.drawRect(SkRect::MakeWH(10, 10));
+  EXPECT_TRUE(optimized->Equals(expected_builder.Build()));
+  EXPECT_EQ(stats.op_count_before, 4u);
+  EXPECT_EQ(stats.op_count_after, 2u);
+  EXPECT_LT(stats.bytes_after, stats.bytes_before);
+  ExpectSameRendering(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, TransformsRestoredBeforeUseAreDropped) {
+  DisplayListBuilder builder;
+  builder.save();
+  builder.translate(10, 10);
+  builder.rotate(45);
+  builder.restore();
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  DisplayListBuilder expected_builder;
+  expected_builder.drawRect(SkRect::MakeWH(10, 10));
+  EXPECT_TRUE(optimized->Equals(expected_builder.Build()));
+}
+
+TEST(DisplayListOptimizer, TransformsAreKeptForDrawsInsideSave) {
+  DisplayListBuilder builder;
+  builder.translate(5, 5);
+  builder.save();
+  builder.translate(10, 10);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  builder.restore();
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  EXPECT_TRUE(optimized->Equals(display_list));
+  ExpectSameRendering(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, TransformsBeforeResetAreDropped) {
+  DisplayListBuilder builder;
+  builder.translate(10, 10);
+  builder.scale(3, 3);
+  builder.transformReset();
+  builder.translate(20, 20);
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  DisplayListBuilder expected_builder;
+  expected_builder.transformReset();
+  expected_builder.translate(20, 20);
+  expected_builder.drawRect(SkRect::MakeWH(10, 10));
+  EXPECT_TRUE(optimized->Equals(expected_builder.Build()));
+}
+
+TEST(DisplayListOptimizer, ClippedOutDrawsAreDropped) {
+  DisplayListBuilder builder;
+  builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect, false);
+  builder.drawRect(SkRect::MakeXYWH(60, 60, 10, 10));
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 10, 10));
+  builder.translate(100, 0);
+  builder.drawOval(SkRect::MakeXYWH(0, 0, 10, 10));
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  DisplayListBuilder expected_builder;
+  expected_builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect,
+                            false);
+  expected_builder.drawRect(SkRect::MakeXYWH(10, 10, 10, 10));
+  EXPECT_TRUE(optimized->Equals(expected_builder.Build()));
+  ExpectSameRendering(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, DrawsOutsideOfCullRectAreDropped) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeXYWH(200, 200, 10, 10));
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 10, 10));
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(
+      display_list, SkRect::MakeWH(kRenderSize, kRenderSize));
+
+  EXPECT_EQ(optimized->op_count(), 1u);
+  ExpectSameRendering(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, StrokesReachingIntoClipAreKept) {
+  DisplayListBuilder builder;
+  builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect, false);
+  builder.setStyle(DlDrawStyle::kStroke);
+  builder.setStrokeWidth(20);
+  builder.drawRect(SkRect::MakeXYWH(55, 10, 10, 10));
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  EXPECT_TRUE(optimized->Equals(display_list));
+}
+
+TEST(DisplayListOptimizer, DrawsInFilteredLayersAreKept) {
+  DisplayListBuilder builder;
+  builder.clipRect(SkRect::MakeWH(50, 50), SkClipOp::kIntersect, false);
+  DlBlurImageFilter blur(10, 10, DlTileMode::kDecal);
+  builder.setImageFilter(&blur);
+  builder.saveLayer(nullptr, true);
+  builder.setImageFilter(nullptr);
+  builder.drawRect(SkRect::MakeXYWH(55, 10, 10, 10));
+  builder.restore();
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  EXPECT_TRUE(optimized->Equals(display_list));
+}
+
+TEST(DisplayListOptimizer, NestedOpacityLayersAreFolded) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kBlack().withAlpha(0x80));
+  builder.saveLayer(nullptr, true);
+  builder.saveLayer(nullptr, true);
+  builder.setColor(DlColor::kRed());
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 30, 30));
+  builder.drawRect(SkRect::MakeXYWH(20, 20, 30, 30));
+  builder.restore();
+  builder.restore();
+  auto display_list = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  auto optimized = DisplayListOptimizer::Optimize(
+      display_list, DisplayListBuilder::kMaxCullRect, &stats);
+
+  EXPECT_EQ(stats.op_count_before, 6u);
+  EXPECT_EQ(stats.op_count_after, 4u);
+  ExpectSameRendering(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, OpacityLayerFoldsIntoChildLayerWithoutAttributes) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kBlack().withAlpha(0x80));
+  builder.saveLayer(nullptr, true);
+  builder.setColorFilter(DlSrgbToLinearGammaColorFilter::instance.get());
+  builder.saveLayer(nullptr, false);
+  builder.setColorFilter(nullptr);
+  builder.setColor(DlColor::kBlue());
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 30, 30));
+  builder.drawRect(SkRect::MakeXYWH(20, 20, 30, 30));
+  builder.restore();
+  builder.restore();
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  EXPECT_EQ(optimized->op_count(), 4u);
+  ExpectSameRendering(display_list, optimized);
+}
+
+TEST(DisplayListOptimizer, LayersWithOtherContentAreNotFolded) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kBlack().withAlpha(0x80));
+  builder.saveLayer(nullptr, true);
+  builder.saveLayer(nullptr, true);
+  builder.setColor(DlColor::kRed());
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 30, 30));
+  builder.restore();
+  builder.drawRect(SkRect::MakeXYWH(20, 20, 30, 30));
+  builder.restore();
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  EXPECT_TRUE(optimized->Equals(display_list));
+}
+
+TEST(DisplayListOptimizer, LayersWithFiltersAreNotFolded) {
+  DisplayListBuilder builder;
+  builder.setColorFilter(DlSrgbToLinearGammaColorFilter::instance.get());
+  builder.saveLayer(nullptr, true);
+  builder.setColorFilter(nullptr);
+  builder.saveLayer(nullptr, true);
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 30, 30));
+  builder.drawRect(SkRect::MakeXYWH(20, 20, 30, 30));
+  builder.restore();
+  builder.restore();
+  auto display_list = builder.Build();
+
+  auto optimized = DisplayListOptimizer::Optimize(display_list);
+
+  EXPECT_TRUE(optimized->Equals(display_list));
+}
+
+}  // namespace testing
+}  // namespace flutter
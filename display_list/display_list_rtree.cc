@@ -4,10 +4,22 @@
 
 #include "flutter/display_list/display_list_rtree.h"
 
+#include "flutter/display_list/display_list_bounds_kernels.h"
 #include "flutter/fml/logging.h"
 
 namespace flutter {
 
+uint32_t DlRTree::NodeCountForLeaves(uint32_t leaf_count) {
+  uint32_t total_node_count = leaf_count;
+  uint32_t gen_count = leaf_count;
+  while (gen_count > 1) {
+    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
+    total_node_count += family_count;
+    gen_count = family_count;
+  }
+  return total_node_count;
+}
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -20,45 +32,28 @@ DlRTree::DlRTree(const SkRect rects[],
   }
   FML_DCHECK(rects != nullptr);
 
-  // Count the number of rectangles we actually want to track,
-  // which includes only non-empty rectangles whose optional
-  // ID is not filtered by the predicate.
-  int leaf_count = 0;
-  for (int i = 0; i < N; i++) {
-    if (!rects[i].isEmpty()) {
-      if (ids == nullptr || p(ids[i])) {
-        leaf_count++;
-      }
-    }
-  }
-  leaf_count_ = leaf_count;
+  // Size the nodes for the case where every rectangle is tracked, so
+  // that the tracked rectangles, which include only non-empty rectangles
+  // whose optional ID is not filtered by the predicate, can be placed
+  // into the first leaf_count_ entries in a single pass. The vector then
+  // only shrinks to the actual number of nodes, without reallocating.
+  nodes_.resize(NodeCountForLeaves(N));
 
-  // Count the total number of nodes (leaf and internal) up front
-  // so we can resize the vector just once.
-  uint32_t total_node_count = leaf_count;
-  uint32_t gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    total_node_count += family_count;
-    gen_count = family_count;
-  }
-
-  nodes_.resize(total_node_count);
-
-  // Now place only the tracked rectangles into the nodes array
-  // in the first leaf_count_ entries.
-  int leaf_index = 0;
+  int leaf_count = 0;
   int id = invalid_id;
   for (int i = 0; i < N; i++) {
     if (!rects[i].isEmpty()) {
       if (ids == nullptr || p(id = ids[i])) {
-        Node& node = nodes_[leaf_index++];
+        Node& node = nodes_[leaf_count++];
         node.bounds = rects[i];
         node.id = id;
       }
     }
   }
-  FML_DCHECK(leaf_index == leaf_count);
+  leaf_count_ = leaf_count;
+
+  uint32_t total_node_count = NodeCountForLeaves(leaf_count);
+  nodes_.resize(total_node_count);
 
   // --- Implementation note ---
   // Many R-Tree algorithms attempt to consolidate nearby rectangles
@@ -86,7 +81,7 @@ DlRTree::DlRTree(const SkRect rects[],
   // until there is just one node left, which is the root node of
   // the R-Tree.
   uint32_t gen_start = 0;
-  gen_count = leaf_count;
+  uint32_t gen_count = leaf_count;
   while (gen_count > 1) {
     uint32_t gen_end = gen_start + gen_count;
 
@@ -121,17 +116,24 @@ DlRTree::DlRTree(const SkRect rects[],
         D -= gen_count;
         FML_DCHECK(parent_index < gen_end + family_count);
         parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
         parent->child.index = sibling_index;
         parent->child.count = 0;
       }
       FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
+      sibling_index++;
       parent->child.count++;
     }
     FML_DCHECK(D == 0);
     FML_DCHECK(sibling_index == gen_end);
     FML_DCHECK(parent_index == gen_end + family_count);
+
+    // The children of each parent are contiguous, so their bounds are
+    // joined in bulk.
+    for (uint32_t i = gen_end; i < parent_index; i++) {
+      Node& family = nodes_[i];
+      family.bounds = DlUnionRects(&nodes_[family.child.index].bounds,
+                                   family.child.count, sizeof(Node));
+    }
     gen_start = gen_end;
     gen_count = family_count;
   }
@@ -118,6 +118,10 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect empty_ = SkRect::MakeEmpty();
 
+  // The total number of nodes (leaf and internal) of a tree with the given
+  // number of leaves.
+  static uint32_t NodeCountForLeaves(uint32_t leaf_count);
+
   void search(const Node& parent,
               const SkRect& query,
               std::vector<int>* results) const;
@@ -0,0 +1,1139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_serialization.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/display_list/display_list_color_filter.h"
+#include "flutter/display_list/display_list_color_source.h"
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/display_list/display_list_image_filter.h"
+#include "flutter/display_list/display_list_mask_filter.h"
+#include "flutter/display_list/display_list_ops.h"
+#include "flutter/display_list/display_list_path_effect.h"
+#include "flutter/display_list/display_list_vertices.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace flutter {
+
+namespace {
+
+// "DLSR" in little endian.
+static constexpr uint32_t kMagic = 0x52534C44u;
+static constexpr size_t kAlignment = 8u;
+
+static constexpr uint32_t kCanApplyGroupOpacity = 1u << 0;
+static constexpr uint32_t kHasRTree = 1u << 1;
+
+// The buffer is laid out as the header followed by the op stream, the
+// rtree rects, the rtree ids, the fixups and the fixup data. Every section
+// starts on an 8 byte boundary.
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t layout_hash;
+  uint32_t flags;
+  SkRect bounds;
+  SkRect opaque_rect;
+  uint64_t byte_count;
+  uint64_t nested_byte_count;
+  uint32_t op_count;
+  uint32_t nested_op_count;
+  uint32_t rtree_count;
+  uint32_t fixup_count;
+  uint64_t data_size;
+};
+
+// Restores the references of the op at |op_offset| in the stream from the
+// |data_size| bytes at |data_offset| in the fixup data.
+struct Fixup {
+  uint32_t op_offset;
+  uint32_t data_offset;
+  uint32_t data_size;
+  uint32_t reserved;
+};
+
+size_t Align(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+// Changes to any op structure change this hash and invalidate buffers that
+// were written with the old layout.
+uint32_t LayoutHash() {
+  static const uint32_t hash = [] {
+    uint32_t value = 2166136261u;
+    auto mix = [&value](size_t size) {
+      value = (value ^ static_cast<uint32_t>(size)) * 16777619u;
+    };
+    mix(sizeof(void*));
+    mix(sizeof(DlVertices));
+#define DL_OP_SIZE(name) mix(sizeof(name##Op));
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_SIZE)
+#undef DL_OP_SIZE
+    return value;
+  }();
+  return hash;
+}
+
+enum class OpStorage {
+  // The op holds plain values only and is copied as it is.
+  kPlain,
+  // The op refers to another object that is stored in the fixup data.
+  kFixup,
+  // The op refers to an object that can't be serialized.
+  kUnsupported,
+};
+
+OpStorage StorageOf(DisplayListOpType type) {
+  switch (type) {
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferencePath:
+    case DisplayListOpType::kDrawPath:
+    case DisplayListOpType::kDrawShadow:
+    case DisplayListOpType::kDrawShadowTransparentOccluder:
+    case DisplayListOpType::kDrawImage:
+    case DisplayListOpType::kDrawImageWithAttr:
+    case DisplayListOpType::kDrawImageRect:
+    case DisplayListOpType::kDrawImageNine:
+    case DisplayListOpType::kDrawImageNineWithAttr:
+    case DisplayListOpType::kDrawImageLattice:
+    case DisplayListOpType::kDrawAtlas:
+    case DisplayListOpType::kDrawAtlasCulled:
+    case DisplayListOpType::kDrawTextBlob:
+    case DisplayListOpType::kDrawDisplayList:
+    case DisplayListOpType::kSetPodColorFilter:
+    case DisplayListOpType::kSetPodColorSource:
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetPodMaskFilter:
+    case DisplayListOpType::kSetPodPathEffect:
+      return OpStorage::kFixup;
+
+    case DisplayListOpType::kSetBlender:
+    case DisplayListOpType::kSetSkPathEffect:
+    case DisplayListOpType::kSetSkColorFilter:
+    case DisplayListOpType::kSetSkColorSource:
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+    case DisplayListOpType::kSetSkImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter:
+    case DisplayListOpType::kSetSkMaskFilter:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds:
+    case DisplayListOpType::kDrawSkVertices:
+    case DisplayListOpType::kDrawSkPicture:
+    case DisplayListOpType::kDrawSkPictureMatrix:
+      return OpStorage::kUnsupported;
+
+    default:
+      return OpStorage::kPlain;
+  }
+}
+
+// Returns the smallest size of a valid op of |type|, or 0 for an unknown
+// type.
+size_t MinimumOpSize(DisplayListOpType type) {
+  switch (type) {
+#define DL_OP_MINIMUM_SIZE(name)   \
+  case DisplayListOpType::k##name: \
+    return sizeof(name##Op);
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_MINIMUM_SIZE)
+
+#undef DL_OP_MINIMUM_SIZE
+
+    default:
+      return 0u;
+  }
+}
+
+template <typename Op, typename Field>
+size_t FieldOffset(const Op* op, const Field& field) {
+  return reinterpret_cast<const uint8_t*>(&field) -
+         reinterpret_cast<const uint8_t*>(op);
+}
+
+// Constructs the |value| over a field of an op that was cleared in the
+// stream. A cleared field holds no references and is safe to overwrite or
+// to destroy.
+template <typename Field>
+void RestoreField(const Field& field, Field value) {
+  new (const_cast<Field*>(&field)) Field(std::move(value));
+}
+
+class Writer {
+ public:
+  explicit Writer(bool read_back_texture_images)
+      : read_back_texture_images_(read_back_texture_images) {}
+
+  bool Write(const uint8_t* ops, size_t byte_count) {
+    stream_.assign(ops, ops + byte_count);
+    const uint8_t* ptr = ops;
+    const uint8_t* end = ops + byte_count;
+    while (ptr < end) {
+      auto op = reinterpret_cast<const DLOp*>(ptr);
+      uint32_t offset = ptr - ops;
+      ptr += op->size;
+      switch (StorageOf(op->type)) {
+        case OpStorage::kPlain:
+          break;
+        case OpStorage::kFixup:
+          data_.resize(Align(data_.size()));
+          fixups_.push_back({offset, static_cast<uint32_t>(data_.size())});
+          if (!WriteFixup(op, offset)) {
+            return false;
+          }
+          fixups_.back().data_size = data_.size() - fixups_.back().data_offset;
+          break;
+        case OpStorage::kUnsupported:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  sk_sp<SkData> Finish(const DisplayList& display_list) {
+    auto rtree = display_list.rtree();
+    uint32_t rtree_count = rtree ? rtree->leaf_count() : 0u;
+
+    size_t stream_offset = Align(sizeof(Header));
+    size_t rects_offset = stream_offset + Align(stream_.size());
+    size_t ids_offset = rects_offset + Align(sizeof(SkRect) * rtree_count);
+    size_t fixups_offset = ids_offset + Align(sizeof(int) * rtree_count);
+    size_t data_offset = fixups_offset + sizeof(Fixup) * fixups_.size();
+    size_t total_size = data_offset + data_.size();
+
+    sk_sp<SkData> data = SkData::MakeZeroInitialized(total_size);
+    uint8_t* buffer = static_cast<uint8_t*>(data->writable_data());
+
+    Header header = {};
+    header.magic = kMagic;
+    header.version = DisplayListSerializer::kVersion;
+    header.layout_hash = LayoutHash();
+    if (display_list.can_apply_group_opacity()) {
+      header.flags |= kCanApplyGroupOpacity;
+    }
+    if (rtree) {
+      header.flags |= kHasRTree;
+    }
+    header.bounds = display_list.bounds();
+    header.opaque_rect = display_list.opaque_rect();
+    header.byte_count = stream_.size();
+    header.nested_byte_count = display_list.bytes(true) - display_list.bytes();
+    header.op_count = display_list.op_count();
+    header.nested_op_count =
+        display_list.op_count(true) - display_list.op_count();
+    header.rtree_count = rtree_count;
+    header.fixup_count = fixups_.size();
+    header.data_size = data_.size();
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(buffer + stream_offset, stream_.data(), stream_.size());
+    auto rects = reinterpret_cast<SkRect*>(buffer + rects_offset);
+    auto ids = reinterpret_cast<int*>(buffer + ids_offset);
+    for (uint32_t i = 0; i < rtree_count; i++) {
+      rects[i] = rtree->bounds(i);
+      ids[i] = rtree->id(i);
+    }
+    memcpy(buffer + fixups_offset, fixups_.data(),
+           sizeof(Fixup) * fixups_.size());
+    memcpy(buffer + data_offset, data_.data(), data_.size());
+    return data;
+  }
+
+ private:
+  const bool read_back_texture_images_;
+  std::vector<uint8_t> stream_;
+  std::vector<Fixup> fixups_;
+  std::vector<uint8_t> data_;
+
+  template <typename T>
+  void WriteValue(const T& value) {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void WriteBytes(const void* bytes, size_t size) {
+    auto begin = static_cast<const uint8_t*>(bytes);
+    data_.insert(data_.end(), begin, begin + size);
+  }
+
+  template <typename Op, typename Field>
+  void ClearField(uint32_t offset, const Op* op, const Field& field) {
+    memset(stream_.data() + offset + FieldOffset(op, field), 0, sizeof(field));
+  }
+
+  template <typename Op>
+  void ClearPod(uint32_t offset, const Op* op) {
+    memset(stream_.data() + offset + sizeof(Op), 0, op->size - sizeof(Op));
+  }
+
+  bool WriteFixup(const DLOp* op, uint32_t offset) {
+    switch (op->type) {
+#define DL_PATH_FIXUP(name)                            \
+  case DisplayListOpType::k##name: {                   \
+    auto path_op = static_cast<const name##Op*>(op);   \
+    ClearField(offset, path_op, path_op->path);        \
+    return WritePath(path_op->path);                   \
+  }
+
+      DL_PATH_FIXUP(ClipIntersectPath)
+      DL_PATH_FIXUP(ClipDifferencePath)
+      DL_PATH_FIXUP(DrawPath)
+      DL_PATH_FIXUP(DrawShadow)
+      DL_PATH_FIXUP(DrawShadowTransparentOccluder)
+
+#undef DL_PATH_FIXUP
+
+#define DL_IMAGE_FIXUP(name, field)                    \
+  case DisplayListOpType::k##name: {                   \
+    auto image_op = static_cast<const name##Op*>(op);  \
+    ClearField(offset, image_op, image_op->field);     \
+    return WriteImage(image_op->field);                \
+  }
+
+      DL_IMAGE_FIXUP(DrawImage, image)
+      DL_IMAGE_FIXUP(DrawImageWithAttr, image)
+      DL_IMAGE_FIXUP(DrawImageRect, image)
+      DL_IMAGE_FIXUP(DrawImageNine, image)
+      DL_IMAGE_FIXUP(DrawImageNineWithAttr, image)
+      DL_IMAGE_FIXUP(DrawImageLattice, image)
+      DL_IMAGE_FIXUP(DrawAtlas, atlas)
+      DL_IMAGE_FIXUP(DrawAtlasCulled, atlas)
+
+#undef DL_IMAGE_FIXUP
+
+      case DisplayListOpType::kDrawTextBlob: {
+        auto blob_op = static_cast<const DrawTextBlobOp*>(op);
+        ClearField(offset, blob_op, blob_op->blob);
+        sk_sp<SkData> blob_data = blob_op->blob->serialize(SkSerialProcs{});
+        if (!blob_data) {
+          return false;
+        }
+        WriteBytes(blob_data->data(), blob_data->size());
+        return true;
+      }
+      case DisplayListOpType::kDrawDisplayList: {
+        auto display_list_op = static_cast<const DrawDisplayListOp*>(op);
+        ClearField(offset, display_list_op, display_list_op->display_list);
+        sk_sp<SkData> nested = DisplayListSerializer::Serialize(
+            display_list_op->display_list, read_back_texture_images_);
+        if (!nested) {
+          return false;
+        }
+        WriteBytes(nested->data(), nested->size());
+        return true;
+      }
+      case DisplayListOpType::kSetPodColorFilter: {
+        auto filter_op = static_cast<const SetPodColorFilterOp*>(op);
+        ClearPod(offset, filter_op);
+        return WriteColorFilter(
+            reinterpret_cast<const DlColorFilter*>(filter_op + 1));
+      }
+      case DisplayListOpType::kSetPodColorSource: {
+        auto source_op = static_cast<const SetPodColorSourceOp*>(op);
+        ClearPod(offset, source_op);
+        return WriteColorSource(
+            reinterpret_cast<const DlColorSource*>(source_op + 1));
+      }
+      case DisplayListOpType::kSetPodImageFilter: {
+        auto filter_op = static_cast<const SetPodImageFilterOp*>(op);
+        ClearPod(offset, filter_op);
+        return WriteImageFilter(
+            reinterpret_cast<const DlImageFilter*>(filter_op + 1));
+      }
+      case DisplayListOpType::kSetPodMaskFilter: {
+        auto filter_op = static_cast<const SetPodMaskFilterOp*>(op);
+        ClearPod(offset, filter_op);
+        const DlBlurMaskFilter* blur =
+            reinterpret_cast<const DlMaskFilter*>(filter_op + 1)->asBlur();
+        if (!blur) {
+          return false;
+        }
+        WriteValue(blur->style());
+        WriteValue(blur->sigma());
+        WriteValue(blur->respectCTM());
+        return true;
+      }
+      case DisplayListOpType::kSetPodPathEffect: {
+        auto effect_op = static_cast<const SetPodPathEffectOp*>(op);
+        ClearPod(offset, effect_op);
+        const DlDashPathEffect* dash =
+            reinterpret_cast<const DlPathEffect*>(effect_op + 1)->asDash();
+        if (!dash) {
+          return false;
+        }
+        WriteValue(dash->phase());
+        WriteValue(dash->count());
+        WriteBytes(dash->intervals(), sizeof(SkScalar) * dash->count());
+        return true;
+      }
+      default:
+        FML_DCHECK(false);
+        return false;
+    }
+  }
+
+  bool WritePath(const SkPath& path) {
+    size_t size = path.writeToMemory(nullptr);
+    size_t start = data_.size();
+    data_.resize(start + size);
+    path.writeToMemory(data_.data() + start);
+    return true;
+  }
+
+  bool WriteImage(const sk_sp<DlImage>& image) {
+    if (!image || (image->isTextureBacked() && !read_back_texture_images_)) {
+      return false;
+    }
+    sk_sp<SkImage> sk_image = image->skia_image();
+    SkPixmap pixmap;
+    if (!sk_image || !sk_image->peekPixels(&pixmap)) {
+      // Lazy images are decoded and texture images are read back.
+      sk_image = sk_image ? sk_image->makeRasterImage() : nullptr;
+      if (!sk_image || !sk_image->peekPixels(&pixmap)) {
+        return false;
+      }
+    }
+    sk_sp<SkData> color_space =
+        pixmap.colorSpace() ? pixmap.colorSpace()->serialize() : nullptr;
+    WriteValue(pixmap.width());
+    WriteValue(pixmap.height());
+    WriteValue(pixmap.colorType());
+    WriteValue(pixmap.alphaType());
+    WriteValue(static_cast<uint64_t>(pixmap.rowBytes()));
+    WriteValue(static_cast<uint64_t>(color_space ? color_space->size() : 0u));
+    if (color_space) {
+      WriteBytes(color_space->data(), color_space->size());
+    }
+    // The pixels are aligned so that they can be used in place.
+    data_.resize(Align(data_.size()));
+    WriteBytes(pixmap.addr(), pixmap.computeByteSize());
+    return true;
+  }
+
+  void WriteMatrix(const SkMatrix* matrix) {
+    WriteValue(matrix != nullptr);
+    if (matrix) {
+      SkScalar values[9];
+      matrix->get9(values);
+      WriteBytes(values, sizeof(values));
+    }
+  }
+
+  void WriteStops(const DlGradientColorSourceBase* gradient) {
+    WriteValue(gradient->tile_mode());
+    WriteMatrix(gradient->matrix_ptr());
+    WriteValue(gradient->stop_count());
+    WriteBytes(gradient->colors(), sizeof(DlColor) * gradient->stop_count());
+    WriteBytes(gradient->stops(), sizeof(float) * gradient->stop_count());
+  }
+
+  bool WriteColorFilter(const DlColorFilter* filter) {
+    WriteValue(filter->type());
+    switch (filter->type()) {
+      case DlColorFilterType::kBlend:
+        WriteValue(filter->asBlend()->color());
+        WriteValue(filter->asBlend()->mode());
+        return true;
+      case DlColorFilterType::kMatrix: {
+        float matrix[20];
+        filter->asMatrix()->get_matrix(matrix);
+        WriteBytes(matrix, sizeof(matrix));
+        return true;
+      }
+      case DlColorFilterType::kSrgbToLinearGamma:
+      case DlColorFilterType::kLinearToSrgbGamma:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool WriteColorSource(const DlColorSource* source) {
+    WriteValue(source->type());
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+        WriteValue(source->asColor()->color());
+        return true;
+      case DlColorSourceType::kLinearGradient: {
+        auto linear = source->asLinearGradient();
+        WriteValue(linear->start_point());
+        WriteValue(linear->end_point());
+        WriteStops(linear);
+        return true;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        auto radial = source->asRadialGradient();
+        WriteValue(radial->center());
+        WriteValue(radial->radius());
+        WriteStops(radial);
+        return true;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        auto conical = source->asConicalGradient();
+        WriteValue(conical->start_center());
+        WriteValue(conical->start_radius());
+        WriteValue(conical->end_center());
+        WriteValue(conical->end_radius());
+        WriteStops(conical);
+        return true;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        auto sweep = source->asSweepGradient();
+        WriteValue(sweep->center());
+        WriteValue(sweep->start());
+        WriteValue(sweep->end());
+        WriteStops(sweep);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  bool WriteImageFilter(const DlImageFilter* filter) {
+    WriteValue(filter->type());
+    switch (filter->type()) {
+      case DlImageFilterType::kBlur:
+        WriteValue(filter->asBlur()->sigma_x());
+        WriteValue(filter->asBlur()->sigma_y());
+        WriteValue(filter->asBlur()->tile_mode());
+        return true;
+      case DlImageFilterType::kDilate:
+        WriteValue(filter->asDilate()->radius_x());
+        WriteValue(filter->asDilate()->radius_y());
+        return true;
+      case DlImageFilterType::kErode:
+        WriteValue(filter->asErode()->radius_x());
+        WriteValue(filter->asErode()->radius_y());
+        return true;
+      case DlImageFilterType::kMatrix:
+        WriteMatrix(&filter->asMatrix()->matrix());
+        WriteValue(filter->asMatrix()->sampling());
+        return true;
+      default:
+        return false;
+    }
+  }
+};
+
+// Reads values from the data of a single fixup. Every read fails once the
+// data is exhausted.
+class FixupReader {
+ public:
+  FixupReader(const uint8_t* begin, const uint8_t* end)
+      : begin_(begin), ptr_(begin), end_(end) {}
+
+  template <typename T>
+  bool ReadValue(T* value) {
+    const void* bytes = ReadBytes(sizeof(T));
+    if (!bytes) {
+      return false;
+    }
+    memcpy(value, bytes, sizeof(T));
+    return true;
+  }
+
+  const void* ReadBytes(size_t size) {
+    if (static_cast<size_t>(end_ - ptr_) < size) {
+      return nullptr;
+    }
+    const void* bytes = ptr_;
+    ptr_ += size;
+    return bytes;
+  }
+
+  void AlignTo(size_t alignment) {
+    size_t offset = ptr_ - begin_;
+    size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+    ptr_ = begin_ + std::min(aligned, static_cast<size_t>(end_ - begin_));
+  }
+
+  const uint8_t* position() const { return ptr_; }
+  size_t remaining() const { return end_ - ptr_; }
+
+ private:
+  const uint8_t* begin_;
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+};
+
+class Reader {
+ public:
+  // |depth| is the number of display lists that the list being read is
+  // nested in.
+  Reader(sk_sp<SkData> data, uint32_t depth)
+      : data_(std::move(data)), depth_(depth) {}
+
+  sk_sp<DisplayList> Read() {
+    auto buffer = static_cast<const uint8_t*>(data_->data());
+    size_t size = data_->size();
+    if (size < sizeof(Header)) {
+      return nullptr;
+    }
+    Header header;
+    memcpy(&header, buffer, sizeof(header));
+    if (header.magic != kMagic ||
+        header.version != DisplayListSerializer::kVersion ||
+        header.layout_hash != LayoutHash()) {
+      return nullptr;
+    }
+
+    // The sizes are checked one at a time so that the offsets can't
+    // overflow.
+    size_t stream_offset = Align(sizeof(Header));
+    if (header.byte_count > size ||
+        header.rtree_count > size / sizeof(SkRect) ||
+        header.fixup_count > size / sizeof(Fixup) || header.data_size > size) {
+      return nullptr;
+    }
+    size_t byte_count = header.byte_count;
+    size_t rects_offset = stream_offset + Align(byte_count);
+    size_t ids_offset =
+        rects_offset + Align(sizeof(SkRect) * header.rtree_count);
+    size_t fixups_offset = ids_offset + Align(sizeof(int) * header.rtree_count);
+    size_t data_offset = fixups_offset + sizeof(Fixup) * header.fixup_count;
+    if (data_offset + header.data_size != size) {
+      return nullptr;
+    }
+    data_offset_ = data_offset;
+    data_size_ = header.data_size;
+
+    // The stream is validated once it is copied, where the ops are
+    // aligned.
+    DisplayListStorage storage;
+    storage.realloc(byte_count);
+    uint8_t* ops = storage.get();
+    memcpy(ops, buffer + stream_offset, byte_count);
+    auto fixups = reinterpret_cast<const Fixup*>(buffer + fixups_offset);
+    if (!ValidateStream(ops, byte_count, fixups, header.fixup_count)) {
+      return nullptr;
+    }
+    for (uint32_t i = 0; i < header.fixup_count; i++) {
+      const Fixup& fixup = fixups[i];
+      if (!ApplyFixup(reinterpret_cast<DLOp*>(ops + fixup.op_offset),
+                      fixup)) {
+        // The ops that weren't restored yet still hold cleared fields,
+        // which are safe to dispose.
+        DisplayList::DisposeOps(ops, ops + byte_count);
+        return nullptr;
+      }
+    }
+
+    sk_sp<DlRTree> rtree;
+    sk_sp<DlOpIndex> op_index;
+    if (header.flags & kHasRTree) {
+      auto rects = reinterpret_cast<const SkRect*>(buffer + rects_offset);
+      auto ids = reinterpret_cast<const int*>(buffer + ids_offset);
+      int count = header.rtree_count;
+      rtree = sk_make_sp<DlRTree>(rects, count, ids,
+                                  [](int id) { return id >= 0; });
+      op_index = sk_make_sp<DlOpIndex>(ops, byte_count, rects, ids, count);
+    }
+
+    return sk_sp<DisplayList>(new DisplayList(
+        std::move(storage), byte_count, header.op_count,
+        header.nested_byte_count, header.nested_op_count, header.bounds,
+        header.opaque_rect, (header.flags & kCanApplyGroupOpacity) != 0,
+        std::move(rtree), std::move(op_index)));
+  }
+
+ private:
+  sk_sp<SkData> data_;
+  const uint32_t depth_;
+  size_t data_offset_ = 0u;
+  size_t data_size_ = 0u;
+
+  // Checks that the arrays that follow a variable length op fit in the
+  // op, and that the enums that index tables are in range. Forged counts
+  // would otherwise make the op read past its end when it is dispatched.
+  static bool ValidatePayload(const DLOp* op) {
+    size_t payload = op->size - MinimumOpSize(op->type);
+    switch (op->type) {
+      case DisplayListOpType::kSetBlendMode:
+        return static_cast<const SetBlendModeOp*>(op)->mode <=
+               DlBlendMode::kLastMode;
+      case DisplayListOpType::kDrawColor:
+        return static_cast<const DrawColorOp*>(op)->mode <=
+               DlBlendMode::kLastMode;
+      case DisplayListOpType::kDrawPoints:
+      case DisplayListOpType::kDrawLines:
+      case DisplayListOpType::kDrawPolygon: {
+        // The three point ops share the same layout.
+        auto count = static_cast<const DrawPointsOp*>(op)->count;
+        return count <= payload / sizeof(SkPoint);
+      }
+      case DisplayListOpType::kDrawVertices: {
+        auto vertices_op = static_cast<const DrawVerticesOp*>(op);
+        auto vertices = reinterpret_cast<const DlVertices*>(vertices_op + 1);
+        return vertices_op->mode <= DlBlendMode::kLastMode &&
+               payload >= sizeof(DlVertices) &&
+               vertices->IsValidWithin(payload);
+      }
+      case DisplayListOpType::kDrawAtlas:
+      case DisplayListOpType::kDrawAtlasCulled: {
+        auto atlas_op = static_cast<const DrawAtlasBaseOp*>(op);
+        if (atlas_op->count < 0 ||
+            atlas_op->mode_index >
+                static_cast<uint16_t>(DlBlendMode::kLastMode)) {
+          return false;
+        }
+        size_t item_size = sizeof(SkRSXform) + sizeof(SkRect) +
+                           (atlas_op->has_colors ? sizeof(DlColor) : 0u);
+        return static_cast<size_t>(atlas_op->count) <= payload / item_size;
+      }
+      case DisplayListOpType::kDrawImageLattice: {
+        auto lattice_op = static_cast<const DrawImageLatticeOp*>(op);
+        if (lattice_op->x_count < 0 || lattice_op->y_count < 0 ||
+            lattice_op->cell_count < 0) {
+          return false;
+        }
+        // The counts are ints, so the sizes can't overflow 64 bits.
+        uint64_t divs_size =
+            (static_cast<uint64_t>(lattice_op->x_count) +
+             static_cast<uint64_t>(lattice_op->y_count)) *
+            sizeof(int);
+        uint64_t cells_size =
+            static_cast<uint64_t>(lattice_op->cell_count) *
+            (sizeof(SkColor) + sizeof(SkCanvas::Lattice::RectType));
+        return divs_size + cells_size <= payload;
+      }
+      default:
+        return true;
+    }
+  }
+
+  // Checks that the stream is a sequence of complete ops of known types
+  // and that exactly the ops that need a fixup have one, in order.
+  bool ValidateStream(const uint8_t* ops,
+                      size_t byte_count,
+                      const Fixup* fixups,
+                      uint32_t fixup_count) {
+    uint32_t next_fixup = 0u;
+    size_t offset = 0u;
+    while (offset < byte_count) {
+      DLOp op;
+      if (byte_count - offset < sizeof(op)) {
+        return false;
+      }
+      memcpy(&op, ops + offset, sizeof(op));
+      size_t minimum_size = MinimumOpSize(op.type);
+      if (minimum_size == 0u || op.size < minimum_size ||
+          op.size % kAlignment != 0u || op.size > byte_count - offset ||
+          !ValidatePayload(reinterpret_cast<const DLOp*>(ops + offset))) {
+        return false;
+      }
+      switch (StorageOf(op.type)) {
+        case OpStorage::kPlain:
+          break;
+        case OpStorage::kFixup: {
+          if (next_fixup >= fixup_count) {
+            return false;
+          }
+          const Fixup& fixup = fixups[next_fixup++];
+          if (fixup.op_offset != offset ||
+              fixup.data_offset > data_size_ ||
+              fixup.data_size > data_size_ - fixup.data_offset) {
+            return false;
+          }
+          break;
+        }
+        case OpStorage::kUnsupported:
+          return false;
+      }
+      offset += op.size;
+    }
+    return next_fixup == fixup_count;
+  }
+
+  bool ApplyFixup(DLOp* op, const Fixup& fixup) {
+    const uint8_t* begin =
+        static_cast<const uint8_t*>(data_->data()) + data_offset_ +
+        fixup.data_offset;
+    FixupReader reader(begin, begin + fixup.data_size);
+    switch (op->type) {
+#define DL_PATH_FIXUP(name)                               \
+  case DisplayListOpType::k##name: {                      \
+    SkPath path;                                          \
+    if (!ReadPath(reader, &path)) {                       \
+      return false;                                       \
+    }                                                     \
+    RestoreField(static_cast<name##Op*>(op)->path, path); \
+    return true;                                          \
+  }
+
+      DL_PATH_FIXUP(ClipIntersectPath)
+      DL_PATH_FIXUP(ClipDifferencePath)
+      DL_PATH_FIXUP(DrawPath)
+      DL_PATH_FIXUP(DrawShadow)
+      DL_PATH_FIXUP(DrawShadowTransparentOccluder)
+
+#undef DL_PATH_FIXUP
+
+#define DL_IMAGE_FIXUP(name, field)                         \
+  case DisplayListOpType::k##name: {                        \
+    sk_sp<DlImage> image = ReadImage(reader);               \
+    if (!image) {                                           \
+      return false;                                         \
+    }                                                       \
+    RestoreField(static_cast<name##Op*>(op)->field, image); \
+    return true;                                            \
+  }
+
+      DL_IMAGE_FIXUP(DrawImage, image)
+      DL_IMAGE_FIXUP(DrawImageWithAttr, image)
+      DL_IMAGE_FIXUP(DrawImageRect, image)
+      DL_IMAGE_FIXUP(DrawImageNine, image)
+      DL_IMAGE_FIXUP(DrawImageNineWithAttr, image)
+      DL_IMAGE_FIXUP(DrawImageLattice, image)
+      DL_IMAGE_FIXUP(DrawAtlas, atlas)
+      DL_IMAGE_FIXUP(DrawAtlasCulled, atlas)
+
+#undef DL_IMAGE_FIXUP
+
+      case DisplayListOpType::kDrawTextBlob: {
+        sk_sp<SkTextBlob> blob = SkTextBlob::Deserialize(
+            reader.position(), reader.remaining(), SkDeserialProcs{});
+        if (!blob) {
+          return false;
+        }
+        RestoreField(static_cast<DrawTextBlobOp*>(op)->blob, blob);
+        return true;
+      }
+      case DisplayListOpType::kDrawDisplayList: {
+        // Each level of nesting is read recursively, so a forged buffer
+        // could otherwise exhaust the stack.
+        if (depth_ >= DisplayListSerializer::kMaxNestingDepth) {
+          return false;
+        }
+        sk_sp<DisplayList> nested =
+            Reader(SkData::MakeSubset(data_.get(),
+                                      data_offset_ + fixup.data_offset,
+                                      fixup.data_size),
+                   depth_ + 1)
+                .Read();
+        if (!nested) {
+          return false;
+        }
+        RestoreField(static_cast<DrawDisplayListOp*>(op)->display_list,
+                     nested);
+        return true;
+      }
+      case DisplayListOpType::kSetPodColorFilter: {
+        auto filter = ReadColorFilter(reader);
+        return filter && CopyPod(static_cast<SetPodColorFilterOp*>(op),
+                                 filter.get(), filter->size());
+      }
+      case DisplayListOpType::kSetPodColorSource: {
+        auto source = ReadColorSource(reader);
+        return source && CopyPod(static_cast<SetPodColorSourceOp*>(op),
+                                 source.get(), source->size());
+      }
+      case DisplayListOpType::kSetPodImageFilter: {
+        auto filter = ReadImageFilter(reader);
+        return filter && CopyPod(static_cast<SetPodImageFilterOp*>(op),
+                                 filter.get(), filter->size());
+      }
+      case DisplayListOpType::kSetPodMaskFilter: {
+        SkBlurStyle style;
+        SkScalar sigma;
+        bool respect_ctm;
+        if (!reader.ReadValue(&style) || !reader.ReadValue(&sigma) ||
+            !reader.ReadValue(&respect_ctm)) {
+          return false;
+        }
+        DlBlurMaskFilter filter(style, sigma, respect_ctm);
+        return CopyPod(static_cast<SetPodMaskFilterOp*>(op), &filter,
+                       filter.size());
+      }
+      case DisplayListOpType::kSetPodPathEffect: {
+        SkScalar phase;
+        int count;
+        if (!reader.ReadValue(&phase) || !reader.ReadValue(&count) ||
+            count < 0) {
+          return false;
+        }
+        auto intervals = reader.ReadBytes(sizeof(SkScalar) * count);
+        if (!intervals) {
+          return false;
+        }
+        auto effect = DlDashPathEffect::Make(
+            static_cast<const SkScalar*>(intervals), count, phase);
+        return CopyPod(static_cast<SetPodPathEffectOp*>(op), effect.get(),
+                       effect->size());
+      }
+      default:
+        return false;
+    }
+  }
+
+  // Pod attributes are trivially relocatable, in the same way that they
+  // are moved when the storage of a DisplayListBuilder grows.
+  template <typename Op>
+  bool CopyPod(Op* op, const void* pod, size_t pod_size) {
+    if (pod_size > op->size - sizeof(Op)) {
+      return false;
+    }
+    memcpy(static_cast<void*>(op + 1), pod, pod_size);
+    return true;
+  }
+
+  bool ReadPath(FixupReader& reader, SkPath* path) {
+    size_t read = path->readFromMemory(reader.position(), reader.remaining());
+    return read != 0u && reader.ReadBytes(read) != nullptr;
+  }
+
+  sk_sp<DlImage> ReadImage(FixupReader& reader) {
+    int width, height;
+    SkColorType color_type;
+    SkAlphaType alpha_type;
+    uint64_t row_bytes, color_space_size;
+    if (!reader.ReadValue(&width) || !reader.ReadValue(&height) ||
+        !reader.ReadValue(&color_type) || !reader.ReadValue(&alpha_type) ||
+        !reader.ReadValue(&row_bytes) || !reader.ReadValue(&color_space_size)) {
+      return nullptr;
+    }
+    if (width <= 0 || height <= 0 || color_type <= kUnknown_SkColorType ||
+        color_type > kLastEnum_SkColorType ||
+        alpha_type <= kUnknown_SkAlphaType ||
+        alpha_type > kLastEnum_SkAlphaType) {
+      return nullptr;
+    }
+    sk_sp<SkColorSpace> color_space;
+    if (color_space_size > 0u) {
+      const void* bytes = reader.ReadBytes(color_space_size);
+      if (!bytes) {
+        return nullptr;
+      }
+      color_space = SkColorSpace::Deserialize(bytes, color_space_size);
+      if (!color_space) {
+        return nullptr;
+      }
+    }
+    SkImageInfo info = SkImageInfo::Make(width, height, color_type,
+                                         alpha_type, std::move(color_space));
+    if (!info.validRowBytes(row_bytes)) {
+      return nullptr;
+    }
+    size_t pixels_size = info.computeByteSize(row_bytes);
+    reader.AlignTo(kAlignment);
+    const uint8_t* pixels = reader.position();
+    if (SkImageInfo::ByteSizeOverflowed(pixels_size) ||
+        !reader.ReadBytes(pixels_size)) {
+      return nullptr;
+    }
+    // The pixels stay in the buffer, which the image keeps alive.
+    sk_sp<SkData> pixel_data = SkData::MakeSubset(
+        data_.get(), pixels - static_cast<const uint8_t*>(data_->data()),
+        pixels_size);
+    sk_sp<SkImage> image =
+        SkImage::MakeRasterData(info, std::move(pixel_data), row_bytes);
+    return image ? DlImage::Make(std::move(image)) : nullptr;
+  }
+
+  bool ReadMatrix(FixupReader& reader, SkMatrix* matrix, bool* has_matrix) {
+    if (!reader.ReadValue(has_matrix)) {
+      return false;
+    }
+    if (*has_matrix) {
+      SkScalar values[9];
+      if (!reader.ReadValue(&values)) {
+        return false;
+      }
+      matrix->set9(values);
+    }
+    return true;
+  }
+
+  struct Stops {
+    DlTileMode tile_mode;
+    SkMatrix matrix;
+    bool has_matrix;
+    uint32_t count;
+    const DlColor* colors;
+    const float* stops;
+
+    const SkMatrix* matrix_ptr() const {
+      return has_matrix ? &matrix : nullptr;
+    }
+  };
+
+  bool ReadStops(FixupReader& reader, Stops* stops) {
+    if (!reader.ReadValue(&stops->tile_mode) ||
+        !ReadMatrix(reader, &stops->matrix, &stops->has_matrix) ||
+        !reader.ReadValue(&stops->count) ||
+        stops->count > reader.remaining()) {
+      return false;
+    }
+    stops->colors = static_cast<const DlColor*>(
+        reader.ReadBytes(sizeof(DlColor) * stops->count));
+    stops->stops = static_cast<const float*>(
+        reader.ReadBytes(sizeof(float) * stops->count));
+    return stops->colors && stops->stops;
+  }
+
+  std::shared_ptr<DlColorFilter> ReadColorFilter(FixupReader& reader) {
+    DlColorFilterType type;
+    if (!reader.ReadValue(&type)) {
+      return nullptr;
+    }
+    switch (type) {
+      case DlColorFilterType::kBlend: {
+        DlColor color;
+        DlBlendMode mode;
+        if (!reader.ReadValue(&color) || !reader.ReadValue(&mode)) {
+          return nullptr;
+        }
+        return std::make_shared<DlBlendColorFilter>(color, mode);
+      }
+      case DlColorFilterType::kMatrix: {
+        float matrix[20];
+        if (!reader.ReadValue(&matrix)) {
+          return nullptr;
+        }
+        return std::make_shared<DlMatrixColorFilter>(matrix);
+      }
+      case DlColorFilterType::kSrgbToLinearGamma:
+        return DlSrgbToLinearGammaColorFilter::instance;
+      case DlColorFilterType::kLinearToSrgbGamma:
+        return DlLinearToSrgbGammaColorFilter::instance;
+      default:
+        return nullptr;
+    }
+  }
+
+  std::shared_ptr<DlColorSource> ReadColorSource(FixupReader& reader) {
+    DlColorSourceType type;
+    if (!reader.ReadValue(&type)) {
+      return nullptr;
+    }
+    Stops stops;
+    switch (type) {
+      case DlColorSourceType::kColor: {
+        DlColor color;
+        if (!reader.ReadValue(&color)) {
+          return nullptr;
+        }
+        return std::make_shared<DlColorColorSource>(color);
+      }
+      case DlColorSourceType::kLinearGradient: {
+        SkPoint start, end;
+        if (!reader.ReadValue(&start) || !reader.ReadValue(&end) ||
+            !ReadStops(reader, &stops)) {
+          return nullptr;
+        }
+        return DlColorSource::MakeLinear(start, end, stops.count, stops.colors,
+                                         stops.stops, stops.tile_mode,
+                                         stops.matrix_ptr());
+      }
+      case DlColorSourceType::kRadialGradient: {
+        SkPoint center;
+        SkScalar radius;
+        if (!reader.ReadValue(&center) || !reader.ReadValue(&radius) ||
+            !ReadStops(reader, &stops)) {
+          return nullptr;
+        }
+        return DlColorSource::MakeRadial(center, radius, stops.count,
+                                         stops.colors, stops.stops,
+                                         stops.tile_mode, stops.matrix_ptr());
+      }
+      case DlColorSourceType::kConicalGradient: {
+        SkPoint start_center, end_center;
+        SkScalar start_radius, end_radius;
+        if (!reader.ReadValue(&start_center) ||
+            !reader.ReadValue(&start_radius) ||
+            !reader.ReadValue(&end_center) ||
+            !reader.ReadValue(&end_radius) || !ReadStops(reader, &stops)) {
+          return nullptr;
+        }
+        return DlColorSource::MakeConical(
+            start_center, start_radius, end_center, end_radius, stops.count,
+            stops.colors, stops.stops, stops.tile_mode, stops.matrix_ptr());
+      }
+      case DlColorSourceType::kSweepGradient: {
+        SkPoint center;
+        SkScalar start, end;
+        if (!reader.ReadValue(&center) || !reader.ReadValue(&start) ||
+            !reader.ReadValue(&end) || !ReadStops(reader, &stops)) {
+          return nullptr;
+        }
+        return DlColorSource::MakeSweep(center, start, end, stops.count,
+                                        stops.colors, stops.stops,
+                                        stops.tile_mode, stops.matrix_ptr());
+      }
+      default:
+        return nullptr;
+    }
+  }
+
+  std::shared_ptr<DlImageFilter> ReadImageFilter(FixupReader& reader) {
+    DlImageFilterType type;
+    if (!reader.ReadValue(&type)) {
+      return nullptr;
+    }
+    switch (type) {
+      case DlImageFilterType::kBlur: {
+        SkScalar sigma_x, sigma_y;
+        DlTileMode tile_mode;
+        if (!reader.ReadValue(&sigma_x) || !reader.ReadValue(&sigma_y) ||
+            !reader.ReadValue(&tile_mode)) {
+          return nullptr;
+        }
+        return std::make_shared<DlBlurImageFilter>(sigma_x, sigma_y,
+                                                   tile_mode);
+      }
+      case DlImageFilterType::kDilate:
+      case DlImageFilterType::kErode: {
+        SkScalar radius_x, radius_y;
+        if (!reader.ReadValue(&radius_x) || !reader.ReadValue(&radius_y)) {
+          return nullptr;
+        }
+        if (type == DlImageFilterType::kDilate) {
+          return std::make_shared<DlDilateImageFilter>(radius_x, radius_y);
+        }
+        return std::make_shared<DlErodeImageFilter>(radius_x, radius_y);
+      }
+      case DlImageFilterType::kMatrix: {
+        SkMatrix matrix;
+        bool has_matrix;
+        DlImageSampling sampling;
+        if (!ReadMatrix(reader, &matrix, &has_matrix) || !has_matrix ||
+            !reader.ReadValue(&sampling)) {
+          return nullptr;
+        }
+        return std::make_shared<DlMatrixImageFilter>(matrix, sampling);
+      }
+      default:
+        return nullptr;
+    }
+  }
+};
+
+}  // namespace
+
+sk_sp<SkData> DisplayListSerializer::Serialize(
+    const sk_sp<DisplayList>& display_list,
+    bool read_back_texture_images) {
+  if (!display_list) {
+    return nullptr;
+  }
+  Writer writer(read_back_texture_images);
+  if (!writer.Write(display_list->storage_.get(), display_list->byte_count_)) {
+    return nullptr;
+  }
+  return writer.Finish(*display_list);
+}
+
+sk_sp<DisplayList> DisplayListSerializer::Deserialize(
+    const sk_sp<SkData>& data) {
+  if (!data) {
+    return nullptr;
+  }
+  return Reader(data, 0u).Read();
+}
+
+}  // namespace flutter
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_SERIALIZATION_H_
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+// Converts a DisplayList to and from a flat, relocatable buffer.
+//
+// The buffer holds the op stream in the same layout as the storage of a
+// DisplayList. Ops that only hold plain values are stored as they are and
+// are mapped back with a single copy, without being recorded again. Ops
+// that refer to other objects have those references cleared in the
+// stream and get them back from side tables for paths, images, text
+// blobs, filters, shaders and nested display lists. The rtree of the list,
+// if any, is stored as well.
+//
+// The format is versioned and also records a hash of the sizes of all op
+// types, so that a buffer written by an engine with a different op layout
+// is rejected instead of being misread. Buffers are meant to be written
+// and read by the same engine build, e.g. for pictures that are recorded
+// on a background isolate, shipped in assets or replayed for benchmarks.
+//
+// Lists that hold Skia objects without a DisplayList equivalent (such as
+// SkPicture, SkVertices, runtime effects or an image filter that isn't
+// one of the pod filters) can't be serialized. Neither can texture backed
+// images, unless they are read back.
+class DisplayListSerializer {
+ public:
+  static constexpr uint32_t kVersion = 2u;
+
+  // Buffers with display lists nested deeper than this are rejected.
+  static constexpr uint32_t kMaxNestingDepth = 64u;
+
+  // Returns nullptr if the list holds ops that can't be serialized.
+  //
+  // With |read_back_texture_images|, the pixels of texture backed Skia
+  // images are read back, which has to happen on the thread of their GPU
+  // context.
+  static sk_sp<SkData> Serialize(const sk_sp<DisplayList>& display_list,
+                                 bool read_back_texture_images = false);
+
+  // Returns nullptr if |data| isn't a valid buffer of this version and op
+  // layout. Image pixels in the buffer are used without being copied, so
+  // |data| may be a memory mapped file.
+  static sk_sp<DisplayList> Deserialize(const sk_sp<SkData>& data);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DisplayListSerializer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_SERIALIZATION_H_
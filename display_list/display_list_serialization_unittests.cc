@@ -0,0 +1,344 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_serialization.h"
+
+#include <cstring>
+#include <limits>
+#include <set>
+#include <string>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_ops.h"
+#include "flutter/display_list/display_list_vertices.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/logging.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+static constexpr int kRenderSize = 100;
+
+// The op stream follows the 88 bytes of the header, which holds the size
+// of the stream at offset 48.
+static constexpr size_t kStreamOffset = 88u;
+static constexpr size_t kByteCountOffset = 48u;
+
+// The groups that have variants which refer to Skia objects without a
+// DisplayList equivalent.
+static const std::set<std::string> kPartlySupportedGroups = {
+    "SetBlendModeOrBlender",
+    "SetColorSource",
+    "SetImageFilter",
+    "Save(Layer)+Restore",
+    "DrawPicture",
+};
+
+// The groups whose ops compare the objects they refer to by identity, so
+// a list read back from a buffer is never Equals to the original.
+static const std::set<std::string> kIdentityComparedGroups = {
+    "DrawImage",        "DrawImageRect", "DrawImageNine",
+    "DrawImageLattice", "DrawAtlas",     "DrawTextBlob",
+};
+
+static sk_sp<DisplayList> RoundTrip(const sk_sp<DisplayList>& display_list) {
+  sk_sp<SkData> data = DisplayListSerializer::Serialize(display_list);
+  return data ? DisplayListSerializer::Deserialize(data) : nullptr;
+}
+
+static void ExpectSameRendering(const sk_sp<DisplayList>& expected,
+                                const sk_sp<DisplayList>& actual) {
+  auto expected_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  auto actual_surface =
+      SkSurface::MakeRasterN32Premul(kRenderSize, kRenderSize);
+  expected->RenderTo(expected_surface->getCanvas());
+  actual->RenderTo(actual_surface->getCanvas());
+  SkPixmap expected_pixels;
+  SkPixmap actual_pixels;
+  ASSERT_TRUE(expected_surface->peekPixels(&expected_pixels));
+  ASSERT_TRUE(actual_surface->peekPixels(&actual_pixels));
+  for (int y = 0; y < kRenderSize; y++) {
+    for (int x = 0; x < kRenderSize; x++) {
+      ASSERT_EQ(*expected_pixels.addr32(x, y), *actual_pixels.addr32(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+static sk_sp<DisplayList> MakeTallList() {
+  DisplayListBuilder builder(true);
+  for (int i = 0; i < 100; i++) {
+    builder.setColor(DlColor(0xFF000000 | (i * 0x020408)));
+    builder.drawRect(SkRect::MakeXYWH(5, i * 20, 50, 10));
+  }
+  return builder.Build();
+}
+
+TEST(DisplayListSerialization, AllGroupsRoundTrip) {
+  for (auto& group : CreateAllGroups()) {
+    bool partly_supported = kPartlySupportedGroups.count(group.op_name) > 0;
+    bool identity_compared = kIdentityComparedGroups.count(group.op_name) > 0;
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      auto& invocation = group.variants[i];
+      sk_sp<DisplayList> display_list = invocation.Build();
+      sk_sp<SkData> data = DisplayListSerializer::Serialize(display_list);
+      if (!data) {
+        EXPECT_TRUE(partly_supported) << group.op_name << " variant " << i;
+        continue;
+      }
+      sk_sp<DisplayList> copy = DisplayListSerializer::Deserialize(data);
+      ASSERT_NE(copy, nullptr) << group.op_name << " variant " << i;
+      EXPECT_EQ(copy->op_count(true), display_list->op_count(true))
+          << group.op_name << " variant " << i;
+      EXPECT_EQ(copy->bytes(true), display_list->bytes(true))
+          << group.op_name << " variant " << i;
+      EXPECT_EQ(copy->bounds(), display_list->bounds())
+          << group.op_name << " variant " << i;
+      EXPECT_EQ(copy->opaque_rect(), display_list->opaque_rect())
+          << group.op_name << " variant " << i;
+      EXPECT_EQ(copy->can_apply_group_opacity(),
+                display_list->can_apply_group_opacity())
+          << group.op_name << " variant " << i;
+      if (!identity_compared) {
+        EXPECT_TRUE(copy->Equals(display_list))
+            << group.op_name << " variant " << i;
+      }
+      ExpectSameRendering(display_list, copy);
+    }
+  }
+}
+
+TEST(DisplayListSerialization, NestedDisplayListRoundTrips) {
+  DisplayListBuilder builder;
+  builder.translate(10, 10);
+  builder.drawDisplayList(TestDisplayList1);
+  builder.drawImage(TestImage1, SkPoint::Make(20, 20), kNearestSampling);
+  auto display_list = builder.Build();
+
+  auto copy = RoundTrip(display_list);
+  ASSERT_NE(copy, nullptr);
+  EXPECT_EQ(copy->op_count(true), display_list->op_count(true));
+  ExpectSameRendering(display_list, copy);
+}
+
+TEST(DisplayListSerialization, RTreeAndOpIndexAreRestored) {
+  auto display_list = MakeTallList();
+  auto copy = RoundTrip(display_list);
+  ASSERT_NE(copy, nullptr);
+  ASSERT_TRUE(copy->has_rtree());
+  EXPECT_TRUE(copy->has_op_index());
+  EXPECT_EQ(copy->rtree()->leaf_count(), display_list->rtree()->leaf_count());
+
+  SkRect query = SkRect::MakeLTRB(0, 500, 100, 560);
+  EXPECT_EQ(copy->rtree()->searchAndConsolidateRects(query),
+            display_list->rtree()->searchAndConsolidateRects(query));
+
+  // Culled dispatch goes through the restored op index.
+  DisplayListBuilder expected_builder(query);
+  DisplayListBuilder actual_builder(query);
+  display_list->RenderTo(&expected_builder);
+  copy->RenderTo(&actual_builder);
+  EXPECT_TRUE(actual_builder.Build()->Equals(expected_builder.Build()));
+}
+
+TEST(DisplayListSerialization, UnsupportedOpsAreRejected) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeWH(10, 10));
+  builder.drawPicture(TestPicture1, nullptr, false);
+  EXPECT_EQ(DisplayListSerializer::Serialize(builder.Build()), nullptr);
+}
+
+TEST(DisplayListSerialization, InvalidBuffersAreRejected) {
+  sk_sp<SkData> data = DisplayListSerializer::Serialize(MakeTallList());
+  ASSERT_NE(data, nullptr);
+  ASSERT_NE(DisplayListSerializer::Deserialize(data), nullptr);
+
+  EXPECT_EQ(DisplayListSerializer::Deserialize(nullptr), nullptr);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(SkData::MakeEmpty()), nullptr);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(
+                SkData::MakeSubset(data.get(), 0, data->size() - 8)),
+            nullptr);
+
+  // The version follows the magic number.
+  sk_sp<SkData> wrong_version =
+      SkData::MakeWithCopy(data->data(), data->size());
+  uint32_t version = DisplayListSerializer::kVersion + 1;
+  memcpy(static_cast<uint8_t*>(wrong_version->writable_data()) + 4, &version,
+         sizeof(version));
+  EXPECT_EQ(DisplayListSerializer::Deserialize(wrong_version), nullptr);
+
+  // Clearing the start of the op stream leaves ops of size 0.
+  sk_sp<SkData> cleared = SkData::MakeWithCopy(data->data(), data->size());
+  memset(static_cast<uint8_t*>(cleared->writable_data()) + kStreamOffset, 0,
+         64);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(cleared), nullptr);
+}
+
+// Returns a writable copy of the buffer of |display_list|, which must be
+// serializable.
+static sk_sp<SkData> SerializeToCopy(const sk_sp<DisplayList>& display_list) {
+  sk_sp<SkData> data = DisplayListSerializer::Serialize(display_list);
+  FML_CHECK(data);
+  return SkData::MakeWithCopy(data->data(), data->size());
+}
+
+// Returns the first op of type |Op| in the stream of a writable buffer.
+template <typename Op>
+static Op* FindOp(const sk_sp<SkData>& data) {
+  auto bytes = static_cast<uint8_t*>(data->writable_data());
+  uint64_t byte_count;
+  memcpy(&byte_count, bytes + kByteCountOffset, sizeof(byte_count));
+  uint8_t* ptr = bytes + kStreamOffset;
+  uint8_t* end = ptr + byte_count;
+  while (ptr < end) {
+    auto op = reinterpret_cast<DLOp*>(ptr);
+    if (op->type == Op::kType) {
+      return static_cast<Op*>(op);
+    }
+    if (op->size == 0u) {
+      break;
+    }
+    ptr += op->size;
+  }
+  return nullptr;
+}
+
+// Overwrites a field of an op in a buffer, as a forged buffer would.
+template <typename T>
+static void Forge(const T& field, T value) {
+  memcpy(const_cast<T*>(&field), &value, sizeof(T));
+}
+
+static sk_sp<DisplayList> MakeVariableLengthList() {
+  DisplayListBuilder builder;
+  SkPoint points[] = {{10, 10}, {20, 20}, {30, 10}};
+  builder.drawPoints(SkCanvas::kPolygon_PointMode, 3, points);
+  builder.drawVertices(
+      DlVertices::Make(DlVertexMode::kTriangles, 3, points, nullptr, nullptr),
+      DlBlendMode::kSrcOver);
+  SkRSXform xforms[] = {SkRSXform::Make(1, 0, 0, 0),
+                        SkRSXform::Make(1, 0, 20, 20)};
+  SkRect tex[] = {SkRect::MakeWH(10, 10), SkRect::MakeXYWH(10, 10, 10, 10)};
+  builder.drawAtlas(TestImage1, xforms, tex, nullptr, 2, DlBlendMode::kSrcOver,
+                    kNearestSampling, nullptr);
+  int divs[] = {10, 20};
+  SkCanvas::Lattice lattice = {divs, divs, nullptr, 2, 2, nullptr, nullptr};
+  builder.drawImageLattice(TestImage1, lattice, SkRect::MakeWH(50, 50),
+                           DlFilterMode::kNearest, false);
+  builder.drawDisplayList(TestDisplayList1);
+  return builder.Build();
+}
+
+TEST(DisplayListSerialization, TruncatedBuffersAreRejected) {
+  sk_sp<SkData> data =
+      DisplayListSerializer::Serialize(MakeVariableLengthList());
+  ASSERT_NE(data, nullptr);
+  ASSERT_NE(DisplayListSerializer::Deserialize(data), nullptr);
+  for (size_t size = 0u; size < data->size(); size++) {
+    EXPECT_EQ(DisplayListSerializer::Deserialize(
+                  SkData::MakeSubset(data.get(), 0u, size)),
+              nullptr)
+        << "truncated to " << size << " bytes";
+  }
+}
+
+TEST(DisplayListSerialization, ForgedPointCountsAreRejected) {
+  auto data = SerializeToCopy(MakeVariableLengthList());
+  auto op = FindOp<DrawPolygonOp>(data);
+  ASSERT_NE(op, nullptr);
+  ASSERT_NE(DisplayListSerializer::Deserialize(data), nullptr);
+
+  // The 3 points fill the op, so a single point more doesn't fit.
+  Forge(op->count, 4u);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->count, std::numeric_limits<uint32_t>::max());
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+}
+
+TEST(DisplayListSerialization, ForgedAtlasCountsAreRejected) {
+  auto data = SerializeToCopy(MakeVariableLengthList());
+  auto op = FindOp<DrawAtlasOp>(data);
+  ASSERT_NE(op, nullptr);
+  ASSERT_NE(DisplayListSerializer::Deserialize(data), nullptr);
+
+  Forge(op->count, 3);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->count, -1);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->count, 2);
+  Forge(op->has_colors, static_cast<uint8_t>(1u));
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->has_colors, static_cast<uint8_t>(0u));
+  Forge(op->mode_index, std::numeric_limits<uint16_t>::max());
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+}
+
+TEST(DisplayListSerialization, ForgedLatticeCountsAreRejected) {
+  auto data = SerializeToCopy(MakeVariableLengthList());
+  auto op = FindOp<DrawImageLatticeOp>(data);
+  ASSERT_NE(op, nullptr);
+  ASSERT_NE(DisplayListSerializer::Deserialize(data), nullptr);
+
+  Forge(op->x_count, 1000);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->x_count, -1);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->x_count, 2);
+  Forge(op->cell_count, std::numeric_limits<int>::max());
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+}
+
+TEST(DisplayListSerialization, ForgedVerticesAreRejected) {
+  auto data = SerializeToCopy(MakeVariableLengthList());
+  auto op = FindOp<DrawVerticesOp>(data);
+  ASSERT_NE(op, nullptr);
+  ASSERT_NE(DisplayListSerializer::Deserialize(data), nullptr);
+
+  Forge(op->mode, static_cast<DlBlendMode>(0xFF));
+  EXPECT_EQ(DisplayListSerializer::Deserialize(data), nullptr);
+  Forge(op->mode, DlBlendMode::kSrcOver);
+
+  // The vertices are checked by DlVertices::IsValidWithin. An index that
+  // doesn't refer to a vertex is rejected even though it is in bounds.
+  DisplayListBuilder builder;
+  SkPoint points[] = {{10, 10}, {20, 20}, {30, 10}};
+  uint16_t indices[] = {0, 1, 3};
+  builder.drawVertices(DlVertices::Make(DlVertexMode::kTriangles, 3, points,
+                                        nullptr, nullptr, 3, indices),
+                       DlBlendMode::kSrcOver);
+  auto bad_indices = DisplayListSerializer::Serialize(builder.Build());
+  ASSERT_NE(bad_indices, nullptr);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(bad_indices), nullptr);
+}
+
+static sk_sp<DisplayList> MakeNestedList(uint32_t depth) {
+  DisplayListBuilder leaf_builder;
+  leaf_builder.drawRect(SkRect::MakeWH(10, 10));
+  sk_sp<DisplayList> display_list = leaf_builder.Build();
+  for (uint32_t i = 0; i < depth; i++) {
+    DisplayListBuilder builder;
+    builder.drawDisplayList(display_list);
+    display_list = builder.Build();
+  }
+  return display_list;
+}
+
+TEST(DisplayListSerialization, NestingDepthIsCapped) {
+  constexpr uint32_t kMaxDepth = DisplayListSerializer::kMaxNestingDepth;
+  EXPECT_NE(RoundTrip(MakeNestedList(kMaxDepth)), nullptr);
+
+  sk_sp<SkData> too_deep =
+      DisplayListSerializer::Serialize(MakeNestedList(kMaxDepth + 1));
+  ASSERT_NE(too_deep, nullptr);
+  EXPECT_EQ(DisplayListSerializer::Deserialize(too_deep), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -21,6 +22,7 @@
 #include "flutter/testing/display_list_testing.h"
 #include "flutter/testing/testing.h"
 
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
@@ -2610,5 +2612,309 @@ TEST(DisplayList, RTreeRenderCulling) {
   }
 }
 
+TEST(DisplayList, StorageGrowsInPowerOfTwoBlocks) {
+  DisplayListStorage storage;
+  storage.realloc(100);
+  EXPECT_EQ(storage.capacity(), 4096u);
+  storage.get()[0] = 42;
+  storage.realloc(5000);
+  EXPECT_EQ(storage.capacity(), 8192u);
+  EXPECT_EQ(storage.get()[0], 42);
+  // Storage never shrinks.
+  storage.realloc(10);
+  EXPECT_EQ(storage.capacity(), 8192u);
+}
+
+TEST(DisplayList, StorageShrinksToTheSmallestBlock) {
+  DisplayListStorage storage;
+  storage.realloc(20000);
+  EXPECT_EQ(storage.capacity(), 32768u);
+  storage.get()[0] = 42;
+  // No smaller block can hold the bytes.
+  storage.shrink(20000);
+  EXPECT_EQ(storage.capacity(), 32768u);
+  storage.shrink(9000);
+  EXPECT_EQ(storage.capacity(), 16384u);
+  EXPECT_EQ(storage.get()[0], 42);
+  storage.shrink(100);
+  EXPECT_EQ(storage.capacity(), 4096u);
+  EXPECT_EQ(storage.get()[0], 42);
+  storage.shrink(0);
+  EXPECT_EQ(storage.capacity(), 4096u);
+}
+
+TEST(DisplayList, LargeStorageShrinksToTheBytesUsed) {
+  constexpr size_t kMegabyte = 1u << 20;
+  DisplayListStorage storage;
+  storage.realloc(2 * kMegabyte + 1);
+  EXPECT_EQ(storage.capacity(), 4 * kMegabyte);
+  // A quarter of the buffer is unused, which isn't worth a copy.
+  storage.shrink(3 * kMegabyte);
+  EXPECT_EQ(storage.capacity(), 4 * kMegabyte);
+  storage.shrink(2 * kMegabyte + 1);
+  EXPECT_EQ(storage.capacity(), 2 * kMegabyte + 1);
+}
+
+TEST(DisplayList, ReleasedStorageIsReused) {
+  uint8_t* released = nullptr;
+  size_t pooled_bytes = 0;
+  {
+    DisplayListStorage storage;
+    storage.realloc(20000);
+    released = storage.get();
+    pooled_bytes = DisplayListStorage::GetPooledBytesForTesting();
+  }
+  EXPECT_EQ(DisplayListStorage::GetPooledBytesForTesting(),
+            pooled_bytes + 32768u);
+
+  DisplayListStorage storage;
+  storage.realloc(30000);
+  EXPECT_EQ(storage.get(), released);
+  EXPECT_EQ(DisplayListStorage::GetPooledBytesForTesting(), pooled_bytes);
+}
+
+TEST(DisplayList, RebuiltDisplayListReusesStorage) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 1000; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i, i, 10, 10));
+  }
+  auto first = builder.Build();
+  ASSERT_GT(first->bytes(false), 4096u);
+  first.reset();
+
+  size_t pooled_bytes = DisplayListStorage::GetPooledBytesForTesting();
+  for (int i = 0; i < 1000; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i, i, 10, 10));
+  }
+  auto second = builder.Build();
+  // The builder went straight to the size of its previous list and took the
+  // buffer that the previous list released.
+  EXPECT_LT(DisplayListStorage::GetPooledBytesForTesting(), pooled_bytes);
+  EXPECT_EQ(second->op_count(), 1000u);
+}
+
+TEST(DisplayList, BuildDoesNotRetainTheSpareCapacity) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 1000; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i, i, 10, 10));
+  }
+  auto large = builder.Build();
+  EXPECT_GE(large->retained_bytes(), large->bytes(false));
+  EXPECT_LT(large->retained_bytes(), large->bytes(false) * 2);
+
+  // The builder records the next list in a buffer the size of the previous
+  // one, which the list doesn't keep.
+  for (int i = 0; i < 10; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i, i, 10, 10));
+  }
+  auto small = builder.Build();
+  EXPECT_EQ(small->op_count(), 10u);
+  EXPECT_GE(small->retained_bytes(), small->bytes(false));
+  EXPECT_LE(small->retained_bytes(), sizeof(DisplayList) + 4096u);
+  EXPECT_LT(small->retained_bytes(), large->retained_bytes());
+}
+
+TEST(DisplayList, RepeatedAttributesShareOneCopy) {
+  DlBlurImageFilter blur(5.0, 5.0, DlTileMode::kClamp);
+  DlBlurImageFilter other_blur(8.0, 8.0, DlTileMode::kClamp);
+  DlBlendColorFilter blend(DlColor::kRed(), DlBlendMode::kSrcIn);
+  DlBlendColorFilter other_blend(DlColor::kBlue(), DlBlendMode::kSrcIn);
+
+  DisplayListBuilder builder;
+  builder.setImageFilter(&blur);
+  builder.setColorFilter(&blend);
+  auto first_filter = builder.getImageFilter();
+  auto first_color_filter = builder.getColorFilter();
+  builder.setImageFilter(&other_blur);
+  builder.setColorFilter(&other_blend);
+  ASSERT_NE(builder.getImageFilter(), first_filter);
+  ASSERT_NE(builder.getColorFilter(), first_color_filter);
+
+  DlBlurImageFilter blur_copy(5.0, 5.0, DlTileMode::kClamp);
+  DlBlendColorFilter blend_copy(DlColor::kRed(), DlBlendMode::kSrcIn);
+  builder.setImageFilter(&blur_copy);
+  builder.setColorFilter(&blend_copy);
+  EXPECT_EQ(builder.getImageFilter(), first_filter);
+  EXPECT_EQ(builder.getColorFilter(), first_color_filter);
+  EXPECT_EQ(builder.attribute_interner()->hits(), 2u);
+}
+
+TEST(DisplayList, SharedInternerSharesAttributesAcrossBuilders) {
+  auto interner = std::make_shared<DlAttributeInterner>();
+  DlBlurMaskFilter mask(kNormal_SkBlurStyle, 3.0);
+
+  DisplayListBuilder first_builder;
+  first_builder.SetAttributeInterner(interner);
+  first_builder.setMaskFilter(&mask);
+  first_builder.drawRect(SkRect::MakeWH(10, 10));
+
+  DisplayListBuilder second_builder;
+  second_builder.SetAttributeInterner(interner);
+  second_builder.setMaskFilter(&mask);
+  second_builder.drawRect(SkRect::MakeWH(10, 10));
+
+  EXPECT_EQ(first_builder.getMaskFilter(), second_builder.getMaskFilter());
+
+  DisplayListBuilder unshared_builder;
+  unshared_builder.setMaskFilter(&mask);
+  EXPECT_NE(unshared_builder.getMaskFilter(), first_builder.getMaskFilter());
+  EXPECT_TRUE(Equals(unshared_builder.getMaskFilter(),
+                     first_builder.getMaskFilter()));
+}
+
+TEST(DisplayList, InternTableKeepsTheMostRecentCandidates) {
+  DlInternTable<DlImageFilter> table;
+  DlBlurImageFilter first(1.0, 1.0, DlTileMode::kClamp);
+  auto interned_first = table.Intern(&first);
+  for (size_t i = 0; i < DlInternTable<DlImageFilter>::kMaxCandidates; i++) {
+    DlBlurImageFilter blur(i + 2.0, i + 2.0, DlTileMode::kClamp);
+    table.Intern(&blur);
+  }
+  // The first blur was pushed out by the later ones, so an equal blur
+  // gets a new copy.
+  DlBlurImageFilter first_copy(1.0, 1.0, DlTileMode::kClamp);
+  auto interned_copy = table.Intern(&first_copy);
+  EXPECT_NE(interned_copy, interned_first);
+  EXPECT_TRUE(Equals(interned_copy, interned_first));
+  EXPECT_EQ(table.hits(), 0u);
+  EXPECT_EQ(table.Intern(&first), interned_copy);
+  EXPECT_EQ(table.hits(), 1u);
+  EXPECT_EQ(table.Intern(nullptr), nullptr);
+}
+
+TEST(DisplayList, OpaqueRectOfOpaqueFills) {
+  DlPaint red = DlPaint().setColor(DlColor::kRed());
+  {
+    DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+    builder.drawColor(SK_ColorWHITE, DlBlendMode::kSrc);
+    EXPECT_EQ(builder.Build()->opaque_rect(), SkRect::MakeWH(100, 100));
+  }
+  {
+    // The largest rect is kept and is in device coordinates.
+    DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+    builder.translate(10, 10);
+    builder.drawRect(SkRect::MakeWH(20, 20), red);
+    builder.drawRect(SkRect::MakeWH(50, 50), red);
+    builder.drawRect(SkRect::MakeWH(30, 30), red);
+    EXPECT_EQ(builder.Build()->opaque_rect(),
+              SkRect::MakeXYWH(10, 10, 50, 50));
+  }
+  {
+    DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+    builder.save();
+    builder.clipRect(SkRect::MakeWH(40, 40), SkClipOp::kIntersect, false);
+    builder.drawPaint(red);
+    builder.restore();
+    EXPECT_EQ(builder.Build()->opaque_rect(), SkRect::MakeWH(40, 40));
+  }
+}
+
+TEST(DisplayList, OpaqueRectIgnoresContentThatIsNotOpaque) {
+  SkRect rect = SkRect::MakeWH(50, 50);
+  DlBlurMaskFilter blur(kNormal_SkBlurStyle, 2.0);
+  std::vector<std::function<void(DisplayListBuilder&)>> setups = {
+      [](DisplayListBuilder& b) { b.setColor(DlColor(0x7FFF0000)); },
+      [](DisplayListBuilder& b) { b.setStyle(DlDrawStyle::kStroke); },
+      [&blur](DisplayListBuilder& b) { b.setMaskFilter(&blur); },
+      [](DisplayListBuilder& b) { b.setBlendMode(DlBlendMode::kMultiply); },
+      [](DisplayListBuilder& b) { b.rotate(45); },
+      [](DisplayListBuilder& b) {
+        b.clipRRect(SkRRect::MakeRectXY(SkRect::MakeWH(40, 40), 5, 5),
+                    SkClipOp::kIntersect, false);
+      },
+      [](DisplayListBuilder& b) {
+        b.clipRect(SkRect::MakeWH(10, 10), SkClipOp::kDifference, false);
+      },
+      [](DisplayListBuilder& b) {
+        b.clipRect(SkRect::MakeWH(10.5, 10.5), SkClipOp::kIntersect, true);
+      },
+      [](DisplayListBuilder& b) { b.saveLayer(nullptr, false); },
+  };
+  for (size_t i = 0; i < setups.size(); i++) {
+    DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+    setups[i](builder);
+    builder.drawRect(rect);
+    EXPECT_TRUE(builder.Build()->opaque_rect().isEmpty()) << "setup " << i;
+  }
+}
+
+TEST(DisplayList, OpaqueRectIsClearedByOpsThatUncoverIt) {
+  std::vector<std::function<void(DisplayListBuilder&)>> ops = {
+      [](DisplayListBuilder& b) {
+        b.drawColor(SK_ColorTRANSPARENT, DlBlendMode::kClear);
+      },
+      [](DisplayListBuilder& b) {
+        DlPaint paint;
+        paint.setColor(DlColor(0x7F000000)).setBlendMode(DlBlendMode::kSrc);
+        b.drawRect(SkRect::MakeWH(10, 10), paint);
+      },
+      [](DisplayListBuilder& b) {
+        DlPaint paint;
+        paint.setBlendMode(DlBlendMode::kDstOut);
+        b.saveLayer(nullptr, &paint);
+        b.drawRect(SkRect::MakeWH(10, 10));
+        b.restore();
+      },
+      [](DisplayListBuilder& b) {
+        DisplayListBuilder nested;
+        nested.drawRect(SkRect::MakeWH(10, 10));
+        b.drawDisplayList(nested.Build());
+      },
+  };
+  for (size_t i = 0; i < ops.size(); i++) {
+    DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+    builder.drawRect(SkRect::MakeWH(50, 50));
+    ops[i](builder);
+    EXPECT_TRUE(builder.Build()->opaque_rect().isEmpty()) << "op " << i;
+  }
+
+  // Ops that only blend onto the surface keep it.
+  DisplayListBuilder builder(SkRect::MakeWH(100, 100));
+  builder.drawRect(SkRect::MakeWH(50, 50));
+  builder.drawCircle(SkPoint::Make(20, 20), 10,
+                     DlPaint().setColor(DlColor(0x7F00FF00)));
+  DlPaint paint;
+  paint.setBlendMode(DlBlendMode::kClear);
+  builder.saveLayer(nullptr, false);
+  builder.drawRect(SkRect::MakeWH(10, 10), paint);
+  builder.restore();
+  EXPECT_EQ(builder.Build()->opaque_rect(), SkRect::MakeWH(50, 50));
+}
+
+TEST(DisplayList, BatchedRectsRenderLikeSeparateRects) {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorRED);
+  for (int i = 0; i < 10; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i * 5, 0, 4, 4));
+  }
+  // The transform only applies to the rects that follow it.
+  builder.translate(0, 10);
+  for (int i = 0; i < 10; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i * 5 + 4, 4, -4, -4));
+  }
+  sk_sp<SkSurface> list_surface = SkSurface::MakeRasterN32Premul(50, 20);
+  builder.Build()->RenderTo(list_surface->getCanvas());
+
+  sk_sp<SkSurface> expected_surface = SkSurface::MakeRasterN32Premul(50, 20);
+  SkCanvas* canvas = expected_surface->getCanvas();
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  for (int y = 0; y < 20; y += 10) {
+    for (int i = 0; i < 10; i++) {
+      canvas->drawRect(SkRect::MakeXYWH(i * 5, y, 4, 4), paint);
+    }
+  }
+
+  SkBitmap list_bitmap;
+  SkBitmap expected_bitmap;
+  list_bitmap.allocN32Pixels(50, 20);
+  expected_bitmap.allocN32Pixels(50, 20);
+  ASSERT_TRUE(list_surface->readPixels(list_bitmap, 0, 0));
+  ASSERT_TRUE(expected_surface->readPixels(expected_bitmap, 0, 0));
+  EXPECT_EQ(memcmp(list_bitmap.getPixels(), expected_bitmap.getPixels(),
+                   list_bitmap.computeByteSize()),
+            0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -109,8 +109,7 @@ sk_sp<SkColorFilter> SkPaintDispatchHelper::makeColorFilter() const {
 
 void RectBoundsAccumulator::accumulate(const SkRect& r, int index) {
   if (r.fLeft < r.fRight && r.fTop < r.fBottom) {
-    rect_.accumulate(r.fLeft, r.fTop);
-    rect_.accumulate(r.fRight, r.fBottom);
+    rect_.accumulate(r);
   }
 }
 
@@ -147,31 +146,10 @@ void RectBoundsAccumulator::pop_and_accumulate(SkRect& layer_bounds,
   }
 }
 
-RectBoundsAccumulator::AccumulationRect::AccumulationRect() {
-  min_x_ = std::numeric_limits<SkScalar>::infinity();
-  min_y_ = std::numeric_limits<SkScalar>::infinity();
-  max_x_ = -std::numeric_limits<SkScalar>::infinity();
-  max_y_ = -std::numeric_limits<SkScalar>::infinity();
-}
-void RectBoundsAccumulator::AccumulationRect::accumulate(SkScalar x,
-                                                         SkScalar y) {
-  if (min_x_ > x) {
-    min_x_ = x;
-  }
-  if (min_y_ > y) {
-    min_y_ = y;
-  }
-  if (max_x_ < x) {
-    max_x_ = x;
-  }
-  if (max_y_ < y) {
-    max_y_ = y;
-  }
-}
 SkRect RectBoundsAccumulator::AccumulationRect::bounds() const {
-  return (max_x_ >= min_x_ && max_y_ >= min_y_)
-             ? SkRect::MakeLTRB(min_x_, min_y_, max_x_, max_y_)
-             : SkRect::MakeEmpty();
+  SkRect r = bounds_.ToRect();
+  return (r.fRight >= r.fLeft && r.fBottom >= r.fTop) ? r
+                                                      : SkRect::MakeEmpty();
 }
 
 void RTreeBoundsAccumulator::accumulate(const SkRect& r, int index) {
@@ -232,4 +210,11 @@ sk_sp<DlRTree> RTreeBoundsAccumulator::rtree() const {
                              [](int id) { return id >= 0; });
 }
 
+sk_sp<DlOpIndex> RTreeBoundsAccumulator::op_index(const uint8_t* ops,
+                                                  size_t byte_count) const {
+  FML_DCHECK(saved_offsets_.empty());
+  return sk_make_sp<DlOpIndex>(ops, byte_count, rects_.data(),
+                               rect_indices_.data(), rects_.size());
+}
+
 }  // namespace flutter
@@ -9,6 +9,7 @@
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_blend_mode.h"
+#include "flutter/display_list/display_list_bounds_kernels.h"
 #include "flutter/display_list/display_list_dispatcher.h"
 #include "flutter/display_list/display_list_flags.h"
 #include "flutter/display_list/display_list_rtree.h"
@@ -289,6 +290,12 @@ class BoundsAccumulator {
 
   virtual sk_sp<DlRTree> rtree() const = 0;
 
+  /// Returns an index of the |byte_count| bytes of ops at |ops| with the
+  /// accumulated rects as the bounds of the rendering ops, or nullptr if
+  /// the accumulator doesn't track the rects of the individual ops.
+  virtual sk_sp<DlOpIndex> op_index(const uint8_t* ops,
+                                    size_t byte_count) const = 0;
+
   virtual BoundsAccumulatorType type() const = 0;
 };
 
@@ -317,23 +324,36 @@ class RectBoundsAccumulator final : public virtual BoundsAccumulator {
 
   sk_sp<DlRTree> rtree() const override { return nullptr; }
 
+  sk_sp<DlOpIndex> op_index(const uint8_t* ops,
+                            size_t byte_count) const override {
+    return nullptr;
+  }
+
  private:
   class AccumulationRect {
    public:
-    AccumulationRect();
+    AccumulationRect() : bounds_(DlBoundsVector::Empty()) {}
 
-    void accumulate(SkScalar x, SkScalar y);
+    void accumulate(SkScalar x, SkScalar y) {
+      bounds_ = bounds_.Union(DlBoundsVector::FromPoint(x, y));
+    }
+    void accumulate(const SkRect& r) {
+      bounds_ = bounds_.Union(DlBoundsVector::FromRect(r));
+    }
 
-    bool is_empty() const { return min_x_ >= max_x_ || min_y_ >= max_y_; }
-    bool is_not_empty() const { return min_x_ < max_x_ && min_y_ < max_y_; }
+    bool is_empty() const {
+      SkRect r = bounds_.ToRect();
+      return r.fLeft >= r.fRight || r.fTop >= r.fBottom;
+    }
+    bool is_not_empty() const {
+      SkRect r = bounds_.ToRect();
+      return r.fLeft < r.fRight && r.fTop < r.fBottom;
+    }
 
     SkRect bounds() const;
 
    private:
-    SkScalar min_x_;
-    SkScalar min_y_;
-    SkScalar max_x_;
-    SkScalar max_y_;
+    DlBoundsVector bounds_;
   };
 
   void pop_and_accumulate(SkRect& layer_bounds, const SkRect* clip);
@@ -356,6 +376,9 @@ class RTreeBoundsAccumulator final : public virtual BoundsAccumulator {
 
   sk_sp<DlRTree> rtree() const override;
 
+  sk_sp<DlOpIndex> op_index(const uint8_t* ops,
+                            size_t byte_count) const override;
+
   BoundsAccumulatorType type() const override {
     return BoundsAccumulatorType::kRTree;
   }
@@ -176,6 +176,52 @@ DlVertices::DlVertices(DlVertexMode mode,
   FML_DCHECK((index_count_ != 0) == (indices() != nullptr));
 }
 
+bool DlVertices::IsValidWithin(size_t available) const {
+  if (available < sizeof(DlVertices) || vertex_count_ < 0 ||
+      index_count_ < 0) {
+    return false;
+  }
+  switch (mode_) {
+    case DlVertexMode::kTriangles:
+    case DlVertexMode::kTriangleStrip:
+    case DlVertexMode::kTriangleFan:
+      break;
+    default:
+      return false;
+  }
+
+  // The arrays that are present follow the object in order, and only the
+  // arrays with elements are present. The counts are checked against the
+  // space left before they are multiplied, so the offsets can't overflow.
+  size_t offset = sizeof(DlVertices);
+  auto next_array = [available, &offset](size_t array_offset, size_t size,
+                                         size_t count, bool optional) {
+    if (count == 0u || (optional && array_offset == 0u)) {
+      return array_offset == 0u;
+    }
+    if (array_offset != offset || count > (available - offset) / size) {
+      return false;
+    }
+    offset += count * size;
+    return true;
+  };
+  if (!next_array(vertices_offset_, sizeof(SkPoint), vertex_count_, false) ||
+      !next_array(texture_coordinates_offset_, sizeof(SkPoint), vertex_count_,
+                  true) ||
+      !next_array(colors_offset_, sizeof(DlColor), vertex_count_, true) ||
+      !next_array(indices_offset_, sizeof(uint16_t), index_count_, false)) {
+    return false;
+  }
+
+  const uint16_t* vertex_indices = indices();
+  for (int i = 0; i < index_count_; i++) {
+    if (vertex_indices[i] >= vertex_count_) {
+      return false;
+    }
+  }
+  return true;
+}
+
 sk_sp<SkVertices> DlVertices::skia_object() const {
   const SkColor* sk_colors = reinterpret_cast<const SkColor*>(colors());
   return SkVertices::MakeCopy(ToSk(mode_), vertex_count_, vertices(),
@@ -284,6 +330,24 @@ void DlVertices::Builder::store_indices(const uint16_t indices[]) {
   needs_indices_ = false;
 }
 
+void DlVertices::update_vertices(const float coordinates[]) {
+  store_points(reinterpret_cast<char*>(this), vertices_offset_, coordinates,
+               vertex_count_);
+  bounds_ = compute_bounds(vertices(), vertex_count_);
+}
+
+void DlVertices::update_texture_coordinates(const float coordinates[]) {
+  FML_CHECK(texture_coordinates_offset_ > 0);
+  store_points(reinterpret_cast<char*>(this), texture_coordinates_offset_,
+               coordinates, vertex_count_);
+}
+
+void DlVertices::update_colors(const uint32_t colors[]) {
+  FML_CHECK(colors_offset_ > 0);
+  char* pod = reinterpret_cast<char*>(this);
+  memcpy(pod + colors_offset_, colors, vertex_count_ * sizeof(colors[0]));
+}
+
 std::shared_ptr<DlVertices> DlVertices::Builder::build() {
   FML_CHECK(is_valid());
   if (vertices_->vertex_count() <= 0) {
@@ -195,6 +195,15 @@ class DlVertices {
   /// Returns the size of the object including all of the inlined data.
   size_t size() const;
 
+  /// Returns true if the object and all of its inlined data fit in
+  /// |available| bytes and every index refers to one of the vertices.
+  ///
+  /// This is meant for objects that were not built by this class, such
+  /// as those copied from a deserialized display list, which may have been
+  /// truncated or forged. At least sizeof(DlVertices) bytes must be
+  /// readable at the object.
+  bool IsValidWithin(size_t available) const;
+
   /// Returns the bounds of the vertices.
   SkRect bounds() const { return bounds_; }
 
@@ -233,6 +242,25 @@ class DlVertices {
     return static_cast<const uint16_t*>(pod(indices_offset_));
   }
 
+  /// @brief Overwrites the vertices with the indicated list of float pairs
+  ///        and recomputes the bounds.
+  ///
+  /// Display lists copy the vertices that are drawn into them, so the
+  /// display lists that already hold this object are not affected.
+  void update_vertices(const float coordinates[]);
+
+  /// @brief Overwrites the texture coordinates with the indicated list of
+  ///        float pairs.
+  ///
+  /// fails if this object was built without texture coordinates.
+  void update_texture_coordinates(const float coordinates[]);
+
+  /// @brief Overwrites the vertex colors with the indicated list of unsigned
+  ///        ints in the 32-bit RGBA format.
+  ///
+  /// fails if this object was built without colors.
+  void update_colors(const uint32_t colors[]);
+
   // Returns an equivalent sk_sp<SkVertices> analog to this object.
   sk_sp<SkVertices> skia_object() const;
 
@@ -859,6 +859,44 @@ TEST(DisplayListVertices, BuildWithNegativeIndexCount) {
   ASSERT_EQ(vertices->index_count(), 0);
 }
 
+TEST(DisplayListVertices, UpdateInPlace) {
+  float coords[6] = {2, 3, 5, 6, 15, 20};
+  float texture_coords[6] = {0, 0, 1, 0, 0, 1};
+  uint32_t colors[3] = {0xffff0000, 0xff00ff00, 0xff0000ff};
+
+  Builder builder(DlVertexMode::kTriangles, 3,
+                  Builder::kHasTextureCoordinates | Builder::kHasColors, 0);
+  builder.store_vertices(coords);
+  builder.store_texture_coordinates(texture_coords);
+  builder.store_colors(colors);
+  std::shared_ptr<DlVertices> vertices = builder.build();
+  ASSERT_NE(vertices, nullptr);
+
+  DisplayListBuilder recorder;
+  recorder.drawVertices(vertices.get(), DlBlendMode::kSrcOver);
+  sk_sp<DisplayList> display_list = recorder.Build();
+
+  float new_coords[6] = {1, 1, 4, 4, 10, 12};
+  float new_texture_coords[6] = {1, 1, 0, 1, 1, 0};
+  uint32_t new_colors[3] = {0xff000000, 0xffffffff, 0xff808080};
+  vertices->update_vertices(new_coords);
+  vertices->update_texture_coordinates(new_texture_coords);
+  vertices->update_colors(new_colors);
+
+  ASSERT_EQ(vertices->bounds(), SkRect::MakeLTRB(1, 1, 10, 12));
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(vertices->vertices()[i],
+              SkPoint::Make(new_coords[i * 2], new_coords[i * 2 + 1]));
+    ASSERT_EQ(vertices->texture_coordinates()[i],
+              SkPoint::Make(new_texture_coords[i * 2],
+                            new_texture_coords[i * 2 + 1]));
+    ASSERT_EQ(vertices->colors()[i], new_colors[i]);
+  }
+
+  // The display list holds a copy of the vertices that were drawn.
+  ASSERT_EQ(display_list->bounds(), SkRect::MakeLTRB(2, 3, 15, 20));
+}
+
 TEST(DisplayListVertices, TestEquals) {
   SkPoint coords[3] = {
       SkPoint::Make(2, 3),
@@ -982,5 +1020,33 @@ TEST(DisplayListVertices, TestNotEquals) {
   }
 }
 
+TEST(DisplayListVertices, IsValidWithinChecksSizeAndIndices) {
+  SkPoint coords[3] = {
+      SkPoint::Make(2, 3),
+      SkPoint::Make(5, 6),
+      SkPoint::Make(15, 20),
+  };
+  DlColor colors[3] = {DlColor::kRed(), DlColor::kCyan(), DlColor::kGreen()};
+  uint16_t indices[3] = {2, 1, 0};
+  auto vertices = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                   coords, colors, 3, indices);
+  ASSERT_NE(vertices, nullptr);
+  EXPECT_TRUE(vertices->IsValidWithin(vertices->size()));
+  EXPECT_TRUE(vertices->IsValidWithin(vertices->size() + 8));
+  EXPECT_FALSE(vertices->IsValidWithin(vertices->size() - 1));
+  EXPECT_FALSE(vertices->IsValidWithin(sizeof(DlVertices) - 1));
+
+  auto no_vertices = DlVertices::Make(DlVertexMode::kTriangles, 0, nullptr,
+                                      nullptr, nullptr);
+  ASSERT_NE(no_vertices, nullptr);
+  EXPECT_TRUE(no_vertices->IsValidWithin(sizeof(DlVertices)));
+
+  uint16_t bad_indices[3] = {0, 1, 3};
+  auto out_of_range = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                       nullptr, nullptr, 3, bad_indices);
+  ASSERT_NE(out_of_range, nullptr);
+  EXPECT_FALSE(out_of_range->IsValidWithin(out_of_range->size()));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -14,6 +14,7 @@ DiffContext::DiffContext(SkISize frame_size,
                          bool has_raster_cache)
     : clip_tracker_(DisplayListMatrixClipTracker(kGiantRect, SkMatrix::I())),
       rects_(std::make_shared<std::vector<SkRect>>()),
+      occluders_(std::make_shared<std::vector<PaintRegion::Occluder>>()),
       frame_size_(frame_size),
       frame_device_pixel_ratio_(frame_device_pixel_ratio),
       this_frame_paint_region_map_(this_frame_paint_region_map),
@@ -53,7 +54,8 @@ DiffContext::State::State()
       integral_transform(false),
       clip_tracker_save_count(0),
       has_filter_bounds_adjustment(false),
-      has_texture(false) {}
+      has_texture(false),
+      translucent(false) {}
 
 void DiffContext::PushTransform(const SkMatrix& transform) {
   clip_tracker_.transform(transform);
@@ -114,9 +116,15 @@ void DiffContext::AlignRect(SkIRect& rect,
 Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
                                   int horizontal_clip_alignment,
                                   int vertical_clip_alignment) const {
+  SkRect damage = SkRect::MakeEmpty();
+  for (const auto& rect : damage_) {
+    if (!IsOccluded(rect)) {
+      damage.join(rect.rect);
+    }
+  }
   SkRect buffer_damage = SkRect::Make(accumulated_buffer_damage);
-  buffer_damage.join(damage_);
-  SkRect frame_damage(damage_);
+  buffer_damage.join(damage);
+  SkRect frame_damage(damage);
 
   for (const auto& r : readbacks_) {
     SkRect rect = SkRect::Make(r.rect);
@@ -145,6 +153,32 @@ Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
   return res;
 }
 
+bool DiffContext::IsOccluded(const DamageRect& damage) const {
+  SkRect pixels = SkRect::Make(damage.rect.roundOut());
+  for (const auto& occluder : unchanged_occluders_) {
+    if (occluder.position > damage.position &&
+        occluder.rect.contains(pixels) &&
+        !IsReadBetween(damage, occluder.position)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DiffContext::IsReadBetween(const DamageRect& damage,
+                                size_t position) const {
+  // A layer that reads back the damaged pixels before they are hidden
+  // spreads them beyond the occluder.
+  for (const auto& readback : readbacks_) {
+    if (readback.position >= damage.position &&
+        readback.position < position &&
+        SkRect::Make(readback.rect).intersects(damage.rect)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 SkRect DiffContext::MapRect(const SkRect& rect) {
   SkRect mapped_rect(rect);
   clip_tracker_.mapRect(&mapped_rect);
@@ -207,12 +241,50 @@ void DiffContext::MarkSubtreeHasTextureLayer() {
   state_.has_texture = true;
 }
 
+void DiffContext::AddOpaqueRect(const SkRect& rect) {
+  if (state_.translucent || !filter_bounds_adjustment_stack_.empty()) {
+    return;
+  }
+  // Map the rect with the same transform that |AddLayerBounds| uses.
+  clip_tracker_.save();
+  if (state_.integral_transform) {
+    MakeCurrentTransformIntegral();
+  }
+  SkRect mapped = rect;
+  bool stays_rect = clip_tracker_.mapRect(&mapped);
+  clip_tracker_.restore();
+  if (!stays_rect || !mapped.intersect(clip_tracker_.device_cull_rect())) {
+    return;
+  }
+  SkIRect pixels;
+  mapped.roundIn(&pixels);
+  if (pixels.isEmpty()) {
+    return;
+  }
+  // The rect is kept with the paint region in any case, so that it can
+  // hide damage in a later frame that retains the layer.
+  PaintRegion::Occluder occluder = {rects_->size(), SkRect::Make(pixels)};
+  occluders_->push_back(occluder);
+  if (!IsSubtreeDirty()) {
+    unchanged_occluders_.push_back(occluder);
+  }
+}
+
 void DiffContext::AddExistingPaintRegion(const PaintRegion& region) {
   // Adding paint region for retained layer implies that current subtree is not
   // dirty, so we know, for example, that the inherited transforms must match
   FML_DCHECK(!IsSubtreeDirty());
   if (region.is_valid()) {
+    size_t position = rects_->size();
     rects_->insert(rects_->end(), region.begin(), region.end());
+    if (!state_.translucent && filter_bounds_adjustment_stack_.empty()) {
+      for (const auto& occluder : region.GetOccluders()) {
+        PaintRegion::Occluder retained = {position + occluder.position,
+                                          occluder.rect};
+        occluders_->push_back(retained);
+        unchanged_occluders_.push_back(retained);
+      }
+    }
   }
 }
 
@@ -225,23 +297,34 @@ void DiffContext::AddReadbackRegion(const SkIRect& rect) {
   readbacks_.push_back(readback);
 }
 
+bool DiffContext::IsRegionDamaged(const SkIRect& rect) const {
+  SkRect pixels = SkRect::Make(rect);
+  return std::any_of(damage_.begin(), damage_.end(),
+                     [&](const DamageRect& damage) {
+                       return damage.rect.intersects(pixels) &&
+                              !IsOccluded(damage);
+                     });
+}
+
 PaintRegion DiffContext::CurrentSubtreeRegion() const {
   bool has_readback = std::any_of(
       readbacks_.begin(), readbacks_.end(),
       [&](const Readback& r) { return r.position >= state_.rect_index; });
   return PaintRegion(rects_, state_.rect_index, rects_->size(), has_readback,
-                     state_.has_texture);
+                     state_.has_texture, occluders_);
 }
 
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    AddDamage(r);
   }
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
-  damage_.join(rect);
+  if (!rect.isEmpty()) {
+    damage_.push_back({rects_->size(), rect});
+  }
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -109,6 +109,18 @@ class DiffContext {
   // ensure that we'll Diff the TextureLayer even if inside retained layer.
   void MarkSubtreeHasTextureLayer();
 
+  // Marks that the content of current subtree may be painted less opaque
+  // than it is, e.g. with an opacity or a filter, or under a clip that only
+  // covers some pixels partially, so that it can't hide what is painted
+  // before it.
+  void MarkSubtreeTranslucent() { state_.translucent = true; }
+
+  // Adds a rect, in "local" (layer) coordinates, that the layer covers with
+  // opaque pixels. If the layer and its ancestors are the same as in the
+  // previous frame, the damage of the layers painted before it that the
+  // rect hides is dropped, as those pixels show the layer in both frames.
+  void AddOpaqueRect(const SkRect& rect);
+
   // Add layer bounds to current paint region; rect is in "local" (layer)
   // coordinates.
   void AddLayerBounds(const SkRect& rect);
@@ -124,6 +136,12 @@ class DiffContext {
   // Readback rect is in screen coordinates.
   void AddReadbackRegion(const SkIRect& rect);
 
+  // Returns whether the layers diffed so far, which are the layers painted
+  // before the current one, damaged any of the pixels in the rect.
+  //
+  // Rect is in screen coordinates.
+  bool IsRegionDamaged(const SkIRect& rect) const;
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -226,12 +244,17 @@ class DiffContext {
 
     // Whether there is a texture layer in this subtree.
     bool has_texture;
+
+    // Whether the content of this subtree can't hide what is painted
+    // before it, see |MarkSubtreeTranslucent|.
+    bool translucent;
   };
 
   void MakeCurrentTransformIntegral();
 
   DisplayListMatrixClipTracker clip_tracker_;
   std::shared_ptr<std::vector<SkRect>> rects_;
+  std::shared_ptr<std::vector<PaintRegion::Occluder>> occluders_;
   State state_;
   SkISize frame_size_;
   double frame_device_pixel_ratio_;
@@ -242,7 +265,25 @@ class DiffContext {
   // Rect must be in device coordinates.
   SkRect ApplyFilterBoundsAdjustment(SkRect rect) const;
 
-  SkRect damage_ = SkRect::MakeEmpty();
+  // A damaged rect, in screen coordinates, and the index in |rects_| at
+  // which it was added, so that only the occluders painted after it can
+  // hide it.
+  struct DamageRect {
+    size_t position;
+    SkRect rect;
+  };
+  std::vector<DamageRect> damage_;
+
+  // The occluders of the layers that paint the same as in the previous
+  // frame, which are the only ones that can hide damage.
+  std::vector<PaintRegion::Occluder> unchanged_occluders_;
+
+  // Returns whether an occluder added after |damage| hides all of it.
+  bool IsOccluded(const DamageRect& damage) const;
+
+  // Returns whether a readback between |damage| and |position| samples any
+  // of the damaged pixels.
+  bool IsReadBetween(const DamageRect& damage, size_t position) const;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
@@ -93,5 +93,60 @@ TEST(EmbeddedViewParams,
   ASSERT_TRUE(SkScalarNearlyEqual(rect.height(), 3));
 }
 
+TEST(EmbeddedViewParamsCache, ReusesParamsOfUnchangedView) {
+  EmbeddedViewParamsCache cache;
+  MutatorsStack stack;
+  SkMatrix matrix = SkMatrix::Translate(5, 5);
+  stack.PushTransform(matrix);
+
+  cache.BeginFrame();
+  auto params = cache.GetParams(1, matrix, SkSize::Make(10, 10), stack, true);
+
+  // A stack with equal but separately made mutators.
+  MutatorsStack next_stack;
+  next_stack.PushTransform(matrix);
+  cache.BeginFrame();
+  auto next_params =
+      cache.GetParams(1, matrix, SkSize::Make(10, 10), next_stack, true);
+  ASSERT_EQ(cache.hits(), 1u);
+  ASSERT_TRUE(*next_params == *params);
+  ASSERT_TRUE(next_params->mutatorsStack().shares_mutators_with(
+      params->mutatorsStack()));
+  ASSERT_TRUE(next_params->display_list_enabled());
+}
+
+TEST(EmbeddedViewParamsCache, MakesNewParamsForChangedView) {
+  EmbeddedViewParamsCache cache;
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(5, 5));
+
+  cache.BeginFrame();
+  auto params = cache.GetParams(1, SkMatrix::Translate(5, 5),
+                                SkSize::Make(10, 10), stack, false);
+
+  MutatorsStack moved_stack;
+  moved_stack.PushTransform(SkMatrix::Translate(6, 5));
+  cache.BeginFrame();
+  auto moved_params = cache.GetParams(1, SkMatrix::Translate(6, 5),
+                                      SkSize::Make(10, 10), moved_stack, false);
+  auto other_params = cache.GetParams(2, SkMatrix::Translate(5, 5),
+                                      SkSize::Make(10, 10), stack, false);
+  ASSERT_EQ(cache.hits(), 0u);
+  ASSERT_TRUE(SkScalarNearlyEqual(moved_params->finalBoundingRect().x(), 6));
+  ASSERT_TRUE(*other_params == *params);
+}
+
+TEST(EmbeddedViewParamsCache, ForgetsViewsThatWereNotPrerolled) {
+  EmbeddedViewParamsCache cache;
+  MutatorsStack stack;
+
+  cache.BeginFrame();
+  cache.GetParams(1, SkMatrix::I(), SkSize::Make(10, 10), stack, false);
+  cache.BeginFrame();
+  cache.BeginFrame();
+  cache.GetParams(1, SkMatrix::I(), SkSize::Make(10, 10), stack, false);
+  ASSERT_EQ(cache.hits(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -77,68 +77,111 @@ void ExternalViewEmbedder::SubmitFrame(GrDirectContext* context,
 };
 
 void MutatorsStack::PushClipRect(const SkRect& rect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rect);
-  vector_.push_back(element);
+  Push(std::make_shared<Mutator>(rect));
 };
 
 void MutatorsStack::PushClipRRect(const SkRRect& rrect) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(rrect);
-  vector_.push_back(element);
+  Push(std::make_shared<Mutator>(rrect));
 };
 
 void MutatorsStack::PushClipPath(const SkPath& path) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(path);
-  vector_.push_back(element);
+  Push(std::make_shared<Mutator>(path));
 };
 
 void MutatorsStack::PushTransform(const SkMatrix& matrix) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(matrix);
-  vector_.push_back(element);
+  Push(std::make_shared<Mutator>(matrix));
 };
 
 void MutatorsStack::PushOpacity(const int& alpha) {
-  std::shared_ptr<Mutator> element = std::make_shared<Mutator>(alpha);
-  vector_.push_back(element);
+  Push(std::make_shared<Mutator>(alpha));
 };
 
 void MutatorsStack::PushBackdropFilter(
     const std::shared_ptr<const DlImageFilter>& filter,
     const SkRect& filter_rect) {
-  std::shared_ptr<Mutator> element =
-      std::make_shared<Mutator>(filter, filter_rect);
-  vector_.push_back(element);
+  Push(std::make_shared<Mutator>(filter, filter_rect));
 };
 
+void MutatorsStack::Push(std::shared_ptr<Mutator> mutator) {
+  FML_DCHECK(mutator);
+  mutable_vector().push_back(std::move(mutator));
+}
+
 void MutatorsStack::Pop() {
-  vector_.pop_back();
+  mutable_vector().pop_back();
 };
 
 void MutatorsStack::PopTo(size_t stack_count) {
-  while (vector_.size() > stack_count) {
-    Pop();
+  if (stack_count >= this->stack_count()) {
+    return;
+  }
+  MutatorVector& mutators = mutable_vector();
+  mutators.erase(mutators.begin() + stack_count, mutators.end());
+}
+
+const MutatorsStack::MutatorVector& MutatorsStack::vector() const {
+  static const MutatorVector kEmptyVector;
+  return vector_ ? *vector_ : kEmptyVector;
+}
+
+MutatorsStack::MutatorVector& MutatorsStack::mutable_vector() {
+  if (!vector_) {
+    vector_ = std::make_shared<MutatorVector>();
+  } else if (vector_.use_count() > 1) {
+    vector_ = std::make_shared<MutatorVector>(*vector_);
   }
+  return *vector_;
 }
 
 const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
 MutatorsStack::Top() const {
-  return vector_.rend();
+  return vector().rend();
 };
 
 const std::vector<std::shared_ptr<Mutator>>::const_reverse_iterator
 MutatorsStack::Bottom() const {
-  return vector_.rbegin();
+  return vector().rbegin();
 };
 
 const std::vector<std::shared_ptr<Mutator>>::const_iterator
 MutatorsStack::Begin() const {
-  return vector_.begin();
+  return vector().begin();
 };
 
 const std::vector<std::shared_ptr<Mutator>>::const_iterator MutatorsStack::End()
     const {
-  return vector_.end();
+  return vector().end();
 };
 
+std::unique_ptr<EmbeddedViewParams> EmbeddedViewParamsCache::GetParams(
+    int64_t view_id,
+    const SkMatrix& matrix,
+    const SkSize& size_points,
+    MutatorsStack mutators_stack,
+    bool display_list_enabled) {
+  auto previous = previous_params_.find(view_id);
+  if (previous != previous_params_.end()) {
+    const EmbeddedViewParams& params = previous->second;
+    if (params.transformMatrix() == matrix &&
+        params.sizePoints() == size_points &&
+        params.display_list_enabled() == display_list_enabled &&
+        params.mutatorsStack() == mutators_stack) {
+      hits_++;
+      current_params_.insert_or_assign(view_id, params);
+      return std::make_unique<EmbeddedViewParams>(params);
+    }
+  }
+  EmbeddedViewParams params(matrix, size_points, std::move(mutators_stack),
+                            display_list_enabled);
+  current_params_.insert_or_assign(view_id, params);
+  return std::make_unique<EmbeddedViewParams>(std::move(params));
+}
+
+void EmbeddedViewParamsCache::BeginFrame() {
+  previous_params_.swap(current_params_);
+  current_params_.clear();
+}
+
 bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
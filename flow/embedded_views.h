@@ -5,11 +5,14 @@
 #ifndef FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 #define FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/flow/rtree.h"
 #include "flutter/flow/surface_frame.h"
+#include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -176,6 +179,10 @@ class Mutator {
 // For example consider the following stack: [T1, T2, T3], where T1 is the top
 // of the stack and T3 is the bottom of the stack. Applying this mutators stack
 // to a platform view P1 will result in T1(T2(T3(P1))).
+//
+// Copies of a stack share their mutators until one of them is pushed to or
+// popped, so that the stack of an embedded view can be handed from the
+// layer tree to the embedder without copying each of its mutators.
 class MutatorsStack {
  public:
   MutatorsStack() = default;
@@ -188,6 +195,9 @@ class MutatorsStack {
   // `filter_rect` is in global coordinates.
   void PushBackdropFilter(const std::shared_ptr<const DlImageFilter>& filter,
                           const SkRect& filter_rect);
+  // Pushes a mutator that may be shared with other stacks. The mutator must
+  // not be modified once it was pushed.
+  void Push(std::shared_ptr<Mutator> mutator);
 
   // Removes the `Mutator` on the top of the stack
   // and destroys it.
@@ -212,15 +222,27 @@ class MutatorsStack {
   // mutator that is closest from the leaf node.
   const std::vector<std::shared_ptr<Mutator>>::const_iterator End() const;
 
-  bool is_empty() const { return vector_.empty(); }
-  size_t stack_count() const { return vector_.size(); }
+  bool is_empty() const { return vector().empty(); }
+  size_t stack_count() const { return vector().size(); }
+
+  // Whether this stack and |other| are copies of each other that share the
+  // same mutators.
+  bool shares_mutators_with(const MutatorsStack& other) const {
+    return vector_ == other.vector_;
+  }
 
   bool operator==(const MutatorsStack& other) const {
-    if (vector_.size() != other.vector_.size()) {
+    if (shares_mutators_with(other)) {
+      return true;
+    }
+    const MutatorVector& mutators = vector();
+    const MutatorVector& other_mutators = other.vector();
+    if (mutators.size() != other_mutators.size()) {
       return false;
     }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != *other.vector_[i]) {
+    for (size_t i = 0; i < mutators.size(); i++) {
+      if (mutators[i] != other_mutators[i] &&
+          *mutators[i] != *other_mutators[i]) {
         return false;
       }
     }
@@ -228,11 +250,12 @@ class MutatorsStack {
   }
 
   bool operator==(const std::vector<Mutator>& other) const {
-    if (vector_.size() != other.size()) {
+    const MutatorVector& mutators = vector();
+    if (mutators.size() != other.size()) {
       return false;
     }
-    for (size_t i = 0; i < vector_.size(); i++) {
-      if (*vector_[i] != other[i]) {
+    for (size_t i = 0; i < mutators.size(); i++) {
+      if (*mutators[i] != other[i]) {
         return false;
       }
     }
@@ -248,7 +271,16 @@ class MutatorsStack {
   }
 
  private:
-  std::vector<std::shared_ptr<Mutator>> vector_;
+  using MutatorVector = std::vector<std::shared_ptr<Mutator>>;
+
+  const MutatorVector& vector() const;
+
+  // Returns the mutators of this stack, copied first if they are shared with
+  // another stack.
+  MutatorVector& mutable_vector();
+
+  // Null until the first push.
+  std::shared_ptr<MutatorVector> vector_;
 };  // MutatorsStack
 
 class EmbeddedViewParams {
@@ -261,7 +293,7 @@ class EmbeddedViewParams {
                      bool display_list_enabled = false)
       : matrix_(matrix),
         size_points_(size_points),
-        mutators_stack_(mutators_stack),
+        mutators_stack_(std::move(mutators_stack)),
         display_list_enabled_(display_list_enabled) {
     SkPath path;
     SkRect starting_rect = SkRect::MakeSize(size_points);
@@ -311,6 +343,42 @@ class EmbeddedViewParams {
   bool display_list_enabled_;
 };
 
+// Remembers the params that each embedded view was given in the previous
+// frame so that the params of a view that did not move are reused rather
+// than built again.
+//
+// The reused params share their mutators with the params of the previous
+// frame, so an embedder comparing them with the params it kept from that
+// frame does so with a pointer comparison.
+class EmbeddedViewParamsCache {
+ public:
+  EmbeddedViewParamsCache() = default;
+
+  // Returns params for |view_id| with the given values, which are a copy of
+  // the params of the previous frame if those were made from equal values.
+  std::unique_ptr<EmbeddedViewParams> GetParams(
+      int64_t view_id,
+      const SkMatrix& matrix,
+      const SkSize& size_points,
+      MutatorsStack mutators_stack,
+      bool display_list_enabled);
+
+  // Starts a new frame. The params of the views that were not asked for
+  // since the previous call are dropped.
+  void BeginFrame();
+
+  // The number of calls to |GetParams| that reused the params of the
+  // previous frame.
+  size_t hits() const { return hits_; }
+
+ private:
+  std::unordered_map<int64_t, EmbeddedViewParams> previous_params_;
+  std::unordered_map<int64_t, EmbeddedViewParams> current_params_;
+  size_t hits_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbeddedViewParamsCache);
+};
+
 enum class PostPrerollResult {
   // Frame has successfully rasterized.
   kSuccess,
@@ -405,6 +473,11 @@ class ExternalViewEmbedder {
   // from the on-screen render target.
   virtual SkCanvas* GetRootCanvas() = 0;
 
+  // Like |GetRootCanvas|, but for frames that are recorded into display lists,
+  // such as the frames rendered by Impeller. The builder takes priority over
+  // the builder of the on-screen render target.
+  virtual DisplayListBuilder* GetRootBuilder() { return nullptr; }
+
   // Call this in-lieu of |SubmitFrame| to clear pre-roll state and
   // sets the stage for the next pre-roll.
   virtual void CancelFrame() = 0;
@@ -498,8 +571,13 @@ class ExternalViewEmbedder {
       std::shared_ptr<const DlImageFilter> filter,
       const SkRect& filter_rect) {}
 
+  // The params of the embedded views of the previous frame, which the
+  // platform view layers reuse for the views that have not changed.
+  EmbeddedViewParamsCache& params_cache() { return params_cache_; }
+
  private:
   bool used_this_frame_ = false;
+  EmbeddedViewParamsCache params_cache_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalViewEmbedder);
 
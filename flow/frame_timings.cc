@@ -67,6 +67,11 @@ fml::TimePoint FrameTimingsRecorder::GetRasterEndWallTime() const {
   return raster_end_wall_time_;
 }
 
+fml::TimePoint FrameTimingsRecorder::GetInputTime() const {
+  std::scoped_lock state_lock(state_mutex_);
+  return input_time_;
+}
+
 fml::TimeDelta FrameTimingsRecorder::GetBuildDuration() const {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ >= State::kBuildEnd);
@@ -101,6 +106,18 @@ size_t FrameTimingsRecorder::GetPictureCacheBytes() const {
   return picture_cache_bytes_;
 }
 
+size_t FrameTimingsRecorder::GetDeviceMemoryBytes() const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterEnd);
+  return device_memory_bytes_;
+}
+
+void FrameTimingsRecorder::RecordDeviceMemoryUsage(size_t bytes) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  device_memory_bytes_ = bytes;
+}
+
 void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
                                        fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -110,6 +127,14 @@ void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
   vsync_target_ = vsync_target;
 }
 
+void FrameTimingsRecorder::RecordInput(fml::TimePoint input_time) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ < State::kBuildEnd);
+  if (input_time_ == fml::TimePoint() || input_time < input_time_) {
+    input_time_ = input_time;
+  }
+}
+
 void FrameTimingsRecorder::RecordBuildStart(fml::TimePoint build_start) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kVsync);
@@ -157,6 +182,11 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetDeviceMemoryBytes(device_memory_bytes_);
+  timing_.SetVsyncInterval(vsync_target_ - vsync_start_);
+  if (input_time_ != fml::TimePoint()) {
+    timing_.SetInputLatency(raster_end_ - input_time_);
+  }
   return timing_;
 }
 
@@ -173,6 +203,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
       std::make_unique<FrameTimingsRecorder>(frame_number_);
   FML_DCHECK(state_ >= state);
   recorder->state_ = state;
+  recorder->input_time_ = input_time_;
 
   if (state >= State::kVsync) {
     recorder->vsync_start_ = vsync_start_;
@@ -198,6 +229,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
     recorder->layer_cache_bytes_ = layer_cache_bytes_;
     recorder->picture_cache_count_ = picture_cache_count_;
     recorder->picture_cache_bytes_ = picture_cache_bytes_;
+    recorder->device_memory_bytes_ = device_memory_bytes_;
   }
 
   return recorder;
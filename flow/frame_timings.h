@@ -68,6 +68,10 @@ class FrameTimingsRecorder {
   /// Timestamp of when the frame rasterization is complete in wall-time.
   fml::TimePoint GetRasterEndWallTime() const;
 
+  /// Timestamp of when the earliest input handled in the frame was received,
+  /// or a default time point if the frame handled no input.
+  fml::TimePoint GetInputTime() const;
+
   /// Duration of the frame build time.
   fml::TimeDelta GetBuildDuration() const;
 
@@ -83,9 +87,18 @@ class FrameTimingsRecorder {
   /// Total Bytes in all picture cache entries
   size_t GetPictureCacheBytes() const;
 
+  /// Bytes of device memory in use when the frame was rasterized.
+  size_t GetDeviceMemoryBytes() const;
+
   /// Records a vsync event.
   void RecordVsync(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
 
+  /// Records that the frame handles input that was received at `input_time`.
+  /// May be called any number of times before the build ends. The earliest
+  /// time is kept, and the time from it until the end of the rasterization is
+  /// reported as the input latency of the frame.
+  void RecordInput(fml::TimePoint input_time);
+
   /// Records a build start event.
   void RecordBuildStart(fml::TimePoint build_start);
 
@@ -95,6 +108,10 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records the bytes of device memory the renderer holds, for renderers that
+  /// track them. Must be called between the raster start and end events.
+  void RecordDeviceMemoryUsage(size_t bytes);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -124,6 +141,7 @@ class FrameTimingsRecorder {
 
   fml::TimePoint vsync_start_;
   fml::TimePoint vsync_target_;
+  fml::TimePoint input_time_;
   fml::TimePoint build_start_;
   fml::TimePoint build_end_;
   fml::TimePoint raster_start_;
@@ -134,6 +152,7 @@ class FrameTimingsRecorder {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  size_t device_memory_bytes_ = 0;
 
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
@@ -74,6 +74,7 @@ TEST(FrameTimingsRecorderTest, RecordRasterTimes) {
   ASSERT_EQ(recorder->GetLayerCacheBytes(), 0u);
   ASSERT_EQ(recorder->GetPictureCacheCount(), 0u);
   ASSERT_EQ(recorder->GetPictureCacheBytes(), 0u);
+  ASSERT_EQ(timing.GetVsyncInterval(), en - st);
 }
 
 TEST(FrameTimingsRecorderTest, RecordRasterTimesWithCache) {
@@ -286,6 +287,58 @@ TEST(FrameTimingsRecorderTest, ClonedHasSameRasterEndWithCache) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), cloned->GetPictureCacheBytes());
 }
 
+TEST(FrameTimingsRecorderTest, RecordInputLatency) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  const auto first_input = now - fml::TimeDelta::FromMilliseconds(8);
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordInput(now - fml::TimeDelta::FromMilliseconds(4));
+  recorder->RecordInput(first_input);
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordInput(now);
+  ASSERT_EQ(recorder->GetInputTime(), first_input);
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kBuildStart);
+  ASSERT_EQ(cloned->GetInputTime(), first_input);
+
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  const auto timing = recorder->RecordRasterEnd();
+  ASSERT_EQ(timing.GetInputLatency(),
+            recorder->GetRasterEndTime() - first_input);
+}
+
+TEST(FrameTimingsRecorderTest, NoInputLatencyWithoutInput) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  const auto timing = recorder->RecordRasterEnd();
+  ASSERT_EQ(recorder->GetInputTime(), fml::TimePoint());
+  ASSERT_EQ(timing.GetInputLatency(), fml::TimeDelta::Zero());
+}
+
+TEST(FrameTimingsRecorderTest, RecordDeviceMemoryUsage) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto now = fml::TimePoint::Now();
+  recorder->RecordVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->RecordDeviceMemoryUsage(4096u);
+  const auto timing = recorder->RecordRasterEnd();
+  ASSERT_EQ(recorder->GetDeviceMemoryBytes(), 4096u);
+  ASSERT_EQ(timing.GetDeviceMemoryBytes(), 4096u);
+
+  auto cloned = recorder->CloneUntil(FrameTimingsRecorder::State::kRasterEnd);
+  ASSERT_EQ(cloned->GetDeviceMemoryBytes(), 4096u);
+}
+
 TEST(FrameTimingsRecorderTest, FrameNumberTraceArgIsValid) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
@@ -10,11 +10,13 @@
 namespace flutter {
 
 LayerSnapshotData::LayerSnapshotData(int64_t layer_unique_id,
-                                     const fml::TimeDelta& duration,
+                                     const fml::TimeDelta& cpu_duration,
+                                     const fml::TimeDelta& gpu_duration,
                                      const sk_sp<SkData>& snapshot,
                                      const SkRect& bounds)
     : layer_unique_id_(layer_unique_id),
-      duration_(duration),
+      cpu_duration_(cpu_duration),
+      gpu_duration_(gpu_duration),
       snapshot_(snapshot),
       bounds_(bounds) {}
 
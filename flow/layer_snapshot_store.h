@@ -21,10 +21,15 @@ namespace flutter {
 
 /// Container for snapshot data pertaining to a given layer. A layer is
 /// identified by it's unique id.
+///
+/// The time taken to rasterize the layer is split into the time the raster
+/// thread spent issuing its commands and the time it then waited for the GPU
+/// to execute them.
 class LayerSnapshotData {
  public:
   LayerSnapshotData(int64_t layer_unique_id,
-                    const fml::TimeDelta& duration,
+                    const fml::TimeDelta& cpu_duration,
+                    const fml::TimeDelta& gpu_duration,
                     const sk_sp<SkData>& snapshot,
                     const SkRect& bounds);
 
@@ -32,7 +37,15 @@ class LayerSnapshotData {
 
   int64_t GetLayerUniqueId() const { return layer_unique_id_; }
 
-  fml::TimeDelta GetDuration() const { return duration_; }
+  /// The total time taken to rasterize the layer.
+  fml::TimeDelta GetDuration() const { return cpu_duration_ + gpu_duration_; }
+
+  /// The time the raster thread took to issue the commands of the layer.
+  fml::TimeDelta GetCpuDuration() const { return cpu_duration_; }
+
+  /// The time the GPU took to execute the commands of the layer once they
+  /// were issued. Zero when the layer is rasterized in software.
+  fml::TimeDelta GetGpuDuration() const { return gpu_duration_; }
 
   sk_sp<SkData> GetSnapshot() const { return snapshot_; }
 
@@ -40,7 +53,8 @@ class LayerSnapshotData {
 
  private:
   const int64_t layer_unique_id_;
-  const fml::TimeDelta duration_;
+  const fml::TimeDelta cpu_duration_;
+  const fml::TimeDelta gpu_duration_;
   const sk_sp<SkData> snapshot_;
   const SkRect bounds_;
 };
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(
@@ -13,6 +16,8 @@ BackdropFilterLayer::BackdropFilterLayer(
 
 void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  // The filter samples the content that the children are painted over.
+  context->MarkSubtreeTranslucent();
   auto* prev = static_cast<const BackdropFilterLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
@@ -32,6 +37,19 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
     filter_->get_input_device_bounds(
         filter_target_bounds, context->GetTransform3x3(), filter_input_bounds);
     context->AddReadbackRegion(filter_input_bounds);
+
+    // Only the layers painted before this one are diffed so far, so any
+    // damage in the input bounds changes what the filter samples.
+    backdrop_undamaged_ = prev != nullptr && !context->IsSubtreeDirty() &&
+                          !context->IsRegionDamaged(filter_input_bounds);
+    if (prev && prev->backdrop_cache_) {
+      backdrop_cache_ = prev->backdrop_cache_;
+    } else {
+      backdrop_cache_ = std::make_shared<BackdropCache>();
+    }
+    if (!backdrop_undamaged_) {
+      backdrop_cache_->image.reset();
+    }
   }
 
   DiffChildren(context, prev);
@@ -57,9 +75,84 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   auto mutator = context.state_stack.save();
-  mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  SkIRect backdrop_bounds;
+  sk_sp<SkImage> backdrop = GetFilteredBackdrop(context, &backdrop_bounds);
+  if (backdrop) {
+    // The layer starts with the filtered backdrop, as it does when the
+    // canvas applies the filter.
+    mutator.applyBackdropFilter(paint_bounds(), nullptr, blend_mode_);
+    SkAutoCanvasRestore save(context.canvas, true);
+    context.canvas->resetMatrix();
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    context.canvas->drawImage(backdrop, backdrop_bounds.fLeft,
+                              backdrop_bounds.fTop, SkSamplingOptions(),
+                              &paint);
+  } else {
+    mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  }
 
   PaintChildren(context);
 }
 
+sk_sp<SkImage> BackdropFilterLayer::GetFilteredBackdrop(
+    PaintContext& context,
+    SkIRect* bounds) const {
+  bool backdrop_undamaged = backdrop_undamaged_;
+  backdrop_undamaged_ = false;
+  if (!backdrop_cache_) {
+    return nullptr;
+  }
+  // The backdrop can only be read from the surface when the canvas paints
+  // straight into it.
+  SkSurface* surface = context.canvas ? context.canvas->getSurface() : nullptr;
+  if (!backdrop_undamaged || !filter_ || context.builder || !surface ||
+      context.state_stack.is_in_save_layer()) {
+    backdrop_cache_->image.reset();
+    return nullptr;
+  }
+  SkMatrix matrix = context.canvas->getTotalMatrix();
+  SkIRect layer_bounds = matrix.mapRect(paint_bounds()).roundOut();
+  if (backdrop_cache_->image && backdrop_cache_->matrix == matrix &&
+      backdrop_cache_->bounds == layer_bounds) {
+    *bounds = layer_bounds;
+    return backdrop_cache_->image;
+  }
+
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::FilterBackdrop");
+  backdrop_cache_->image.reset();
+  sk_sp<SkImageFilter> sk_filter = filter_->skia_object();
+  SkIRect input_bounds;
+  if (!sk_filter || layer_bounds.isEmpty() ||
+      !filter_->get_input_device_bounds(layer_bounds, matrix, input_bounds) ||
+      !input_bounds.intersect(SkIRect::MakeWH(surface->width(),
+                                              surface->height()))) {
+    return nullptr;
+  }
+  sk_sp<SkImage> input = surface->makeImageSnapshot(input_bounds);
+  sk_sp<SkSurface> output = surface->makeSurface(
+      surface->imageInfo().makeWH(layer_bounds.width(), layer_bounds.height()));
+  if (!input || !output) {
+    return nullptr;
+  }
+  // Filter the backdrop the way the canvas does, by saving a layer with the
+  // layer's bounds and transform over the backdrop, in the device space of
+  // the output.
+  SkCanvas* canvas = output->getCanvas();
+  canvas->translate(-layer_bounds.fLeft, -layer_bounds.fTop);
+  canvas->drawImage(input, input_bounds.fLeft, input_bounds.fTop);
+  canvas->concat(matrix);
+  SkPaint paint;
+  paint.setBlendMode(SkBlendMode::kSrc);
+  canvas->saveLayer(
+      SkCanvas::SaveLayerRec(&paint_bounds(), &paint, sk_filter.get(), 0));
+  canvas->restore();
+
+  backdrop_cache_->matrix = matrix;
+  backdrop_cache_->bounds = layer_bounds;
+  backdrop_cache_->image = output->makeImageSnapshot();
+  *bounds = layer_bounds;
+  return backdrop_cache_->image;
+}
+
 }  // namespace flutter
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_BACKDROP_FILTER_LAYER_H_
 
+#include <memory>
+
 #include "flutter/flow/layers/container_layer.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 
 namespace flutter {
@@ -21,9 +24,39 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // |ContainerLayer|
+  void CompilePaint(LayerPaintList* list) const override {
+    Layer::CompilePaint(list);
+  }
+
+  // Whether the last |Diff| found that no layer painted before this one
+  // changed the content that the filter samples.
+  bool backdrop_undamaged() const { return backdrop_undamaged_; }
+
  private:
+  // The filtered backdrop of the last frame, which is painted instead of
+  // filtering the backdrop again while the content behind the layer stays
+  // the same. It is handed from the layer of the previous frame to the one
+  // replacing it in |Diff|.
+  struct BackdropCache {
+    // The transform and the device bounds of the layer.
+    SkMatrix matrix;
+    SkIRect bounds;
+    sk_sp<SkImage> image;
+  };
+
   std::shared_ptr<const DlImageFilter> filter_;
   DlBlendMode blend_mode_;
+  std::shared_ptr<BackdropCache> backdrop_cache_;
+  // Set by |Diff| and reset by |Paint|, so that a frame that isn't diffed
+  // doesn't reuse the backdrop.
+  mutable bool backdrop_undamaged_ = false;
+
+  // Returns the filtered backdrop for the layer, from the cache if it is
+  // still valid, or nullptr if the backdrop can't be filtered outside of
+  // the canvas, in which case the cache is dropped.
+  sk_sp<SkImage> GetFilteredBackdrop(PaintContext& context,
+                                     SkIRect* bounds) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
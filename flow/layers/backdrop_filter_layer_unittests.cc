@@ -422,5 +422,43 @@ TEST_F(BackdropLayerDiffTest, BackdropLayerInvalidTransform) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeWH(100, 100));
 }
 
+TEST_F(BackdropLayerDiffTest, BackdropUndamagedWhileContentBehindIsSame) {
+  auto filter = DlBlurImageFilter(10, 10, DlTileMode::kClamp);
+  auto background = std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(0, 0, 100, 100)));
+
+  MockLayerTree l1(SkISize::Make(100, 100));
+  auto backdrop1 = std::make_shared<BackdropFilterLayer>(
+      filter.shared(), DlBlendMode::kSrcOver);
+  l1.root()->Add(background);
+  l1.root()->Add(backdrop1);
+  DiffLayerTree(l1, MockLayerTree(SkISize::Make(100, 100)));
+  EXPECT_FALSE(backdrop1->backdrop_undamaged());
+
+  // Same content behind, and a child that changes over the backdrop.
+  MockLayerTree l2(SkISize::Make(100, 100));
+  auto backdrop2 = std::make_shared<BackdropFilterLayer>(
+      filter.shared(), DlBlendMode::kSrcOver);
+  backdrop2->AssignOldLayer(backdrop1.get());
+  backdrop2->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(40, 40, 50, 50))));
+  l2.root()->Add(background);
+  l2.root()->Add(backdrop2);
+  DiffLayerTree(l2, l1);
+  EXPECT_TRUE(backdrop2->backdrop_undamaged());
+
+  // Different content behind.
+  MockLayerTree l3(SkISize::Make(100, 100));
+  auto backdrop3 = std::make_shared<BackdropFilterLayer>(
+      filter.shared(), DlBlendMode::kSrcOver);
+  backdrop3->AssignOldLayer(backdrop2.get());
+  l3.root()->Add(std::make_shared<MockLayer>(
+      SkPath().addRect(SkRect::MakeLTRB(10, 10, 20, 20))));
+  l3.root()->Add(background);
+  l3.root()->Add(backdrop3);
+  DiffLayerTree(l3, l2);
+  EXPECT_FALSE(backdrop3->backdrop_undamaged());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -41,6 +41,12 @@ class CacheableContainerLayer : public ContainerLayer {
     return layer_raster_cache_item_.get();
   }
 
+  // The layer may be painted from the raster cache, which is decided in
+  // its |Paint|.
+  void CompilePaint(LayerPaintList* list) const override {
+    Layer::CompilePaint(list);
+  }
+
  protected:
   std::unique_ptr<LayerRasterCacheItem> layer_raster_cache_item_;
 };
@@ -17,6 +17,8 @@ class ClipPathLayer : public ClipShapeLayer<SkPath> {
  protected:
   const SkRect& clip_shape_bounds() const override;
 
+  bool clip_shape_is_rect() const override;
+
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
  private:
@@ -13,6 +13,10 @@ const SkRect& ClipRectLayer::clip_shape_bounds() const {
   return clip_shape();
 }
 
+bool ClipRectLayer::clip_shape_is_rect() const {
+  return true;
+}
+
 void ClipRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRect(clip_shape(), clip_behavior() != Clip::hardEdge);
 }
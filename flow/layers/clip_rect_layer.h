@@ -16,6 +16,8 @@ class ClipRectLayer : public ClipShapeLayer<SkRect> {
  protected:
   const SkRect& clip_shape_bounds() const override;
 
+  bool clip_shape_is_rect() const override;
+
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
 
  private:
@@ -13,6 +13,10 @@ const SkRect& ClipRRectLayer::clip_shape_bounds() const {
   return clip_shape().getBounds();
 }
 
+bool ClipRRectLayer::clip_shape_is_rect() const {
+  return clip_shape().isRect();
+}
+
 void ClipRRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRRect(clip_shape(), clip_behavior() != Clip::hardEdge);
 }
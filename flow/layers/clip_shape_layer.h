@@ -35,6 +35,10 @@ class ClipShapeLayer : public CacheableContainerLayer {
     if (UsesSaveLayer() && context->has_raster_cache()) {
       context->WillPaintWithIntegralTransform();
     }
+    if (!IsExactClip(context->GetTransform3x3())) {
+      // Opaque content that the clip cuts into does not hide whole pixels.
+      context->MarkSubtreeTranslucent();
+    }
     if (context->PushCullRect(clip_shape_bounds())) {
       DiffChildren(context, prev);
     }
@@ -54,11 +58,21 @@ class ClipShapeLayer : public CacheableContainerLayer {
     Layer::AutoPrerollSaveLayerState save =
         Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
 
+    bool had_complex_clip = context->has_complex_clip;
+    context->has_complex_clip =
+        had_complex_clip || !IsExactClip(context->state_stack.transform_3x3());
+
     auto mutator = context->state_stack.save();
     ApplyClip(mutator);
 
     SkRect child_paint_bounds = SkRect::MakeEmpty();
     PrerollChildren(context, &child_paint_bounds);
+    context->has_complex_clip = had_complex_clip;
+    // A layer painted from the raster cache is drawn with an integral
+    // transform, which may shift it off the pixels its children cover.
+    if (!uses_save_layer || !context->raster_cache) {
+      set_opaque_bounds(children_opaque_bounds());
+    }
     if (child_paint_bounds.intersect(clip_shape_bounds())) {
       set_paint_bounds(child_paint_bounds);
     } else {
@@ -99,12 +113,28 @@ class ClipShapeLayer : public CacheableContainerLayer {
     PaintChildren(context);
   }
 
+  void CompilePaint(LayerPaintList* list) const override {
+    if (UsesSaveLayer()) {
+      // The children may be painted from the raster cache or into a
+      // saveLayer, which is decided in |Paint|.
+      Layer::CompilePaint(list);
+      return;
+    }
+    list->BeginLayer(this);
+    list->Clip(clip_shape_, clip_behavior_ != Clip::hardEdge);
+    CompilePaintChildren(list);
+    list->EndLayer();
+  }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
  protected:
   virtual const SkRect& clip_shape_bounds() const = 0;
+  // Whether the clip shape is a plain rect, so that the clip only cuts
+  // along the edges of |clip_shape_bounds|.
+  virtual bool clip_shape_is_rect() const = 0;
   virtual void ApplyClip(LayerStateStack::MutatorContext& mutator) const = 0;
   virtual ~ClipShapeLayer() = default;
 
@@ -112,6 +142,12 @@ class ClipShapeLayer : public CacheableContainerLayer {
   Clip clip_behavior() const { return clip_behavior_; }
 
  private:
+  bool IsExactClip(const SkMatrix& matrix) const {
+    return clip_shape_is_rect() &&
+           IsExactClipRect(matrix, clip_shape_bounds(),
+                           clip_behavior_ != Clip::hardEdge);
+  }
+
   const ClipShape clip_shape_;
   Clip clip_behavior_;
 
@@ -19,6 +19,8 @@ ColorFilterLayer::ColorFilterLayer(std::shared_ptr<const DlColorFilter> filter)
 
 void ColorFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  // The filter may make the opaque pixels of the children translucent.
+  context->MarkSubtreeTranslucent();
   auto* prev = static_cast<const ColorFilterLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
@@ -6,9 +6,13 @@
 
 #include <optional>
 
+#include "flutter/flow/layers/layer_parallel_painter.h"
+
 namespace flutter {
 
-ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
+ContainerLayer::ContainerLayer()
+    : child_paint_bounds_(SkRect::MakeEmpty()),
+      children_opaque_bounds_(SkRect::MakeEmpty()) {}
 
 void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
   auto old_container = static_cast<const ContainerLayer*>(old_layer);
@@ -64,13 +68,20 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     --old_children_bottom;
   }
 
-  // old layers that don't match
-  for (int i = old_children_top; i <= old_children_bottom; ++i) {
-    auto layer = prev_layers[i];
-    context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
-  }
+  // old layers that don't match; their damage is added where they were
+  // painted, after the matching layers before them, so that only the layers
+  // painted after them can occlude it.
+  auto add_old_layers_damage = [&]() {
+    for (int i = old_children_top; i <= old_children_bottom; ++i) {
+      auto layer = prev_layers[i];
+      context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
+    }
+  };
 
   for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
+    if (i == new_children_top) {
+      add_old_layers_damage();
+    }
     if (i < new_children_top || i > new_children_bottom) {
       int i_prev =
           i < new_children_top ? i : prev_layers.size() - (layers_.size() - i);
@@ -91,6 +102,11 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
+
+        // For the same reason the outcome of the previous frame's Preroll of
+        // the retained subtree can be reused, as long as it is prerolled
+        // under the same conditions.
+        layer->set_preroll_retained(true);
       } else {
         layer->Diff(context, prev_layer.get());
       }
@@ -101,6 +117,9 @@ void ContainerLayer::DiffChildren(DiffContext* context,
       layer->Diff(context, nullptr);
     }
   }
+  if (new_children_top >= static_cast<int>(layers_.size())) {
+    add_old_layers_damage();
+  }
 }
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
@@ -111,6 +130,7 @@ void ContainerLayer::Preroll(PrerollContext* context) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(children_opaque_bounds());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -148,7 +168,14 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    if (!layer->TryToReusePreroll(context)) {
+      size_t first_cached_entry = context->raster_cached_entries
+                                      ? context->raster_cached_entries->size()
+                                      : 0;
+      bool needed_readback = context->surface_needs_readback;
+      layer->Preroll(context);
+      layer->RecordPreroll(context, first_cached_entry, needed_readback);
+    }
 
     all_renderable_state_flags &= context->renderable_state_flags;
     if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
@@ -169,8 +196,43 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
   set_subtree_has_platform_view(child_has_platform_view);
+  set_subtree_has_texture_layer(child_has_texture_layer);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
+  OccludeChildren(context);
+}
+
+void ContainerLayer::OccludeChildren(const PrerollContext* context) {
+  SkRect occluder = SkRect::MakeEmpty();
+  // The embedders may paint the children before and after a platform view
+  // to different surfaces, so the children can't hide each other. Nor can
+  // they when a layer reads back the surface, as a layer painted after the
+  // read would hide the content that it sampled.
+  bool can_occlude =
+      !subtree_has_platform_view() && !context->surface_needs_readback;
+  const SkMatrix matrix = context->state_stack.transform_3x3();
+  const SkRect cull_rect = context->state_stack.device_cull_rect();
+  for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+    Layer* layer = it->get();
+    bool occluded = false;
+    if (can_occlude && !occluder.isEmpty()) {
+      // The bounds are outset by a pixel for the layers that are painted
+      // with their translation snapped to whole pixels.
+      SkRect bounds = matrix.mapRect(layer->paint_bounds()).makeOutset(1, 1);
+      occluded = bounds.intersect(cull_rect) &&
+                 occluder.contains(SkRect::Make(bounds.roundOut()));
+    }
+    layer->set_occluded(occluded);
+    if (occluded || !can_occlude) {
+      continue;
+    }
+    const SkRect& opaque_bounds = layer->opaque_bounds();
+    if (opaque_bounds.width() * opaque_bounds.height() >
+        occluder.width() * occluder.height()) {
+      occluder = opaque_bounds;
+    }
+  }
+  children_opaque_bounds_ = occluder;
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -185,13 +247,33 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   auto restore = context.state_stack.applyState(
       child_paint_bounds(), children_renderable_state_flags());
 
+  if (context.parallel_painter &&
+      context.parallel_painter->PaintChildren(this, context)) {
+    return;
+  }
+
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
-    if (layer->needs_painting(context)) {
+    if (!layer->is_occluded() && layer->needs_painting(context)) {
       layer->Paint(context);
     }
   }
 }
 
+void ContainerLayer::CompilePaint(LayerPaintList* list) const {
+  list->BeginLayer(this);
+  CompilePaintChildren(list);
+  list->EndLayer();
+}
+
+void ContainerLayer::CompilePaintChildren(LayerPaintList* list) const {
+  list->ApplyState(child_paint_bounds(), children_renderable_state_flags());
+  for (auto& layer : layers_) {
+    if (!layer->is_occluded()) {
+      layer->CompilePaint(list);
+    }
+  }
+}
+
 }  // namespace flutter
@@ -30,6 +30,14 @@ class ContainerLayer : public Layer {
 
   void PaintChildren(PaintContext& context) const override;
 
+  // Compiles the children into their own scope of commands, which paints
+  // them in the same way as |Paint|.
+  //
+  // Subclasses that do more in |Paint| than painting their children must
+  // override this, either to compile their own commands or to fall back to
+  // |Layer::CompilePaint|.
+  void CompilePaint(LayerPaintList* list) const override;
+
   const ContainerLayer* as_container_layer() const override { return this; }
 
   const SkRect& child_paint_bounds() const { return child_paint_bounds_; }
@@ -37,6 +45,13 @@ class ContainerLayer : public Layer {
     child_paint_bounds_ = bounds;
   }
 
+  // The largest of the opaque bounds of the children that aren't occluded,
+  // as determined by |PrerollChildren|. Containers that paint their
+  // children with full opacity pass these on as their own opaque bounds.
+  const SkRect& children_opaque_bounds() const {
+    return children_opaque_bounds_;
+  }
+
   int children_renderable_state_flags() const {
     return children_renderable_state_flags_;
   }
@@ -47,9 +62,18 @@ class ContainerLayer : public Layer {
  protected:
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
+  // Marks the children that are hidden by the opaque bounds of the ones
+  // painted after them as occluded, and computes the opaque bounds of the
+  // children. Called by |PrerollChildren|.
+  void OccludeChildren(const PrerollContext* context);
+
+  // Appends the commands of |PaintChildren| to |list|.
+  void CompilePaintChildren(LayerPaintList* list) const;
+
  private:
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
+  SkRect children_opaque_bounds_;
   int children_renderable_state_flags_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
@@ -542,6 +542,112 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+TEST_F(ContainerLayerTest, RetainedLayerReusesPreroll) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPaint child_paint(SkColors::kGreen);
+  SkMatrix initial_transform = SkMatrix::Translate(-0.5f, -0.5f);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  preroll_context()->state_stack.set_preroll_delegate(initial_transform);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+
+  // The child now reports that it can apply opacity, which the container
+  // only sees if the child is prerolled again.
+  mock_layer->set_fake_opacity_compatible(true);
+  mock_layer->set_preroll_retained(true);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+  EXPECT_EQ(layer->paint_bounds(), child_path.getBounds());
+
+  // The retained flag is consumed by the Preroll that reused the outcome.
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+
+  // A retained layer is prerolled again if its transform changed.
+  SkMatrix other_transform = SkMatrix::Translate(10.0f, 10.0f);
+  preroll_context()->state_stack.set_preroll_delegate(other_transform);
+  mock_layer->set_fake_opacity_compatible(false);
+  mock_layer->set_preroll_retained(true);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), other_transform);
+  EXPECT_EQ(layer->children_renderable_state_flags(), 0);
+}
+
+TEST_F(ContainerLayerTest, RetainedLayerWithPlatformViewIsPrerolled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPaint child_paint(SkColors::kGreen);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  mock_layer->set_fake_has_platform_view(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+
+  preroll_context()->has_platform_view = false;
+  mock_layer->set_fake_opacity_compatible(true);
+  mock_layer->set_preroll_retained(true);
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->has_platform_view);
+  EXPECT_EQ(layer->children_renderable_state_flags(),
+            LayerStateStack::kCallerCanApplyOpacity);
+}
+
+TEST_F(ContainerLayerTest, OpaqueChildHidesEarlierSiblings) {
+  SkPath child_path1;
+  child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 32.0f, 32.0f);
+  SkPaint child_paint1(SkColors::kGray);
+  SkPaint child_paint2(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint1);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2, child_paint2);
+  mock_layer2->set_opaque_bounds(child_path2.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(mock_layer1->is_occluded());
+  EXPECT_FALSE(mock_layer2->is_occluded());
+  EXPECT_EQ(layer->opaque_bounds(), child_path2.getBounds());
+
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path2, child_paint2}}}));
+}
+
+TEST_F(ContainerLayerTest, PlatformViewDisablesOcclusion) {
+  SkPath child_path1;
+  child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath child_path2;
+  child_path2.addRect(0.0f, 0.0f, 32.0f, 32.0f);
+  SkPaint child_paint1(SkColors::kGray);
+  SkPaint child_paint2(SkColors::kGreen);
+
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1, child_paint1);
+  mock_layer1->set_fake_has_platform_view(true);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2, child_paint2);
+  mock_layer2->set_opaque_bounds(child_path2.getBounds());
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(mock_layer1->is_occluded());
+  EXPECT_EQ(layer->opaque_bounds(), SkRect::MakeEmpty());
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -745,5 +851,35 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+TEST_F(ContainerLayerDiffTest, OpaqueLayerHidesDamageBelowIt) {
+  auto pic1 = CreateDisplayList(SkRect::MakeLTRB(0, 0, 50, 50), 1);
+  auto pic2 = CreateDisplayList(SkRect::MakeLTRB(10, 10, 40, 40), 2);
+  auto opaque = CreateDisplayList(SkRect::MakeLTRB(0, 0, 100, 100),
+                                  SK_ColorRED);
+
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(pic1));
+  t1.root()->Add(CreateDisplayListLayer(opaque));
+  DiffLayerTree(t1, MockLayerTree());
+
+  // The changed layer is painted below the unchanged opaque layer.
+  MockLayerTree t2;
+  t2.root()->Add(CreateDisplayListLayer(pic2));
+  t2.root()->Add(CreateDisplayListLayer(opaque));
+  auto damage = DiffLayerTree(t2, t1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeEmpty());
+
+  // The changed layer is painted above the opaque layer.
+  MockLayerTree t3;
+  t3.root()->Add(CreateDisplayListLayer(opaque));
+  t3.root()->Add(CreateDisplayListLayer(pic2));
+  MockLayerTree t4;
+  t4.root()->Add(CreateDisplayListLayer(opaque));
+  t4.root()->Add(CreateDisplayListLayer(pic1));
+  DiffLayerTree(t3, MockLayerTree());
+  damage = DiffLayerTree(t4, t3);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 50, 50));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/display_list_layer.h"
 
+#include <string>
 #include <utility>
 
 #include "flutter/display_list/display_list_builder.h"
@@ -56,6 +57,7 @@ void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
     context->WillPaintWithIntegralTransform();
   }
   context->AddLayerBounds(display_list()->bounds());
+  context->AddOpaqueRect(display_list()->opaque_rect());
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
@@ -103,6 +105,15 @@ void DisplayListLayer::Preroll(PrerollContext* context) {
     context->renderable_state_flags = LayerStateStack::kCallerCanApplyOpacity;
   }
   set_paint_bounds(bounds_);
+
+  // Map the opaque rect with the transform that |Paint| uses.
+  SkMatrix matrix = context->state_stack.transform_3x3();
+  matrix.preTranslate(offset_.x(), offset_.y());
+  if (context->raster_cache) {
+    matrix = RasterCacheUtil::GetIntegralTransCTM(matrix);
+  }
+  set_opaque_bounds(
+      ComputeOpaqueBounds(context, matrix, disp_list->opaque_rect()));
 }
 
 void DisplayListLayer::Paint(PaintContext& context) const {
@@ -136,8 +147,14 @@ void DisplayListLayer::Paint(PaintContext& context) const {
 
     const auto& ctm = context.canvas->getTotalMatrix();
 
+    // The timeline shows the time of each traced layer under its unique id,
+    // split into issuing its commands and waiting for the GPU to run them.
+    const std::string unique_id_arg = std::to_string(unique_id());
+    TRACE_EVENT1("flutter", "LeafLayerRaster", "layer_unique_id",
+                 unique_id_arg.c_str());
     const auto start_time = fml::TimePoint::Now();
     {
+      TRACE_EVENT0("flutter", "LeafLayerIssueCommands");
       // render display list to offscreen surface.
       auto* canvas = offscreen_surface->GetCanvas();
       SkAutoCanvasRestore save(canvas, true);
@@ -146,13 +163,20 @@ void DisplayListLayer::Paint(PaintContext& context) const {
       display_list()->RenderTo(canvas, opacity);
       canvas->flush();
     }
-    const fml::TimeDelta offscreen_render_time =
-        fml::TimePoint::Now() - start_time;
+    const auto issued_time = fml::TimePoint::Now();
+    if (context.gr_context) {
+      // The surface only holds the commands of this layer, so waiting for
+      // the GPU to finish them measures the GPU time of this layer alone.
+      TRACE_EVENT0("flutter", "LeafLayerWaitForGPU");
+      context.gr_context->submit(true);
+    }
+    const fml::TimeDelta cpu_duration = issued_time - start_time;
+    const fml::TimeDelta gpu_duration = fml::TimePoint::Now() - issued_time;
 
     const SkRect device_bounds =
         RasterCacheUtil::GetDeviceBounds(paint_bounds(), ctm);
     sk_sp<SkData> raster_data = offscreen_surface->GetRasterData(true);
-    LayerSnapshotData snapshot_data(unique_id(), offscreen_render_time,
+    LayerSnapshotData snapshot_data(unique_id(), cpu_duration, gpu_duration,
                                     raster_data, device_bounds);
     context.layer_snapshot_store->Add(snapshot_data);
   }
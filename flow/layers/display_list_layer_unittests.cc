@@ -402,6 +402,12 @@ TEST_F(DisplayListLayerTest, LayerTreeSnapshotsWhenEnabled) {
 
   auto& snapshot_store = layer_snapshot_store();
   EXPECT_EQ(1u, snapshot_store.Size());
+  const LayerSnapshotData& snapshot = *snapshot_store.begin();
+  EXPECT_EQ(snapshot.GetLayerUniqueId(), layer->unique_id());
+  EXPECT_GE(snapshot.GetCpuDuration(), fml::TimeDelta::Zero());
+  // There is no GPU to wait for when rasterizing in software.
+  EXPECT_EQ(snapshot.GetGpuDuration(), fml::TimeDelta::Zero());
+  EXPECT_EQ(snapshot.GetDuration(), snapshot.GetCpuDuration());
 }
 
 TEST_F(DisplayListLayerTest, NoLayerTreeSnapshotsWhenDisabledByDefault) {
@@ -21,7 +21,9 @@ static bool IsDisplayListWorthRasterizing(
     DisplayList* display_list,
     bool will_change,
     bool is_complex,
-    DisplayListComplexityCalculator* complexity_calculator) {
+    DisplayListComplexityCalculator* complexity_calculator,
+    unsigned int* complexity_score) {
+  *complexity_score = 0;
   if (will_change) {
     // If the display list is going to change in the future, there is no point
     // in doing to extra work to rasterize.
@@ -41,8 +43,8 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
-  unsigned int complexity_score = complexity_calculator->Compute(display_list);
-  return complexity_calculator->ShouldBeCached(complexity_score);
+  *complexity_score = complexity_calculator->Compute(display_list);
+  return complexity_calculator->ShouldBeCached(*complexity_score);
 }
 
 DisplayListRasterCacheItem::DisplayListRasterCacheItem(
@@ -70,13 +72,19 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
-  DisplayListComplexityCalculator* complexity_calculator =
-      context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
-                                context->gr_context->backend())
-                          : DisplayListComplexityCalculator::GetForSoftware();
+  DisplayListComplexityCalculator* complexity_calculator;
+  if (context->impeller_enabled) {
+    complexity_calculator = DisplayListComplexityCalculator::GetForImpeller();
+  } else if (context->gr_context) {
+    complexity_calculator = DisplayListComplexityCalculator::GetForBackend(
+        context->gr_context->backend());
+  } else {
+    complexity_calculator = DisplayListComplexityCalculator::GetForSoftware();
+  }
 
   if (!IsDisplayListWorthRasterizing(display_list_, will_change_, is_complex_,
-                                     complexity_calculator)) {
+                                     complexity_calculator,
+                                     &complexity_score_)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
@@ -106,6 +114,7 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   bool visible = !context->state_stack.content_culled(bounds);
   int accesses = raster_cache->MarkSeen(key_id_, matrix, visible);
+  preroll_matrix_ = matrix;
   if (!visible || accesses <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
   } else {
@@ -115,8 +124,28 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   return;
 }
 
+bool DisplayListRasterCacheItem::CanReusePreroll() const {
+  // Once the display list is cached, every further preroll with the same
+  // matrix and cull rect keeps it cached.
+  return cache_state_ == CacheState::kCurrent;
+}
+
+void DisplayListRasterCacheItem::ReusePreroll(PrerollContext* context) {
+  if (!context->raster_cache || !context->raster_cached_entries) {
+    return;
+  }
+  context->raster_cached_entries->push_back(this);
+  context->raster_cache->MarkSeen(key_id_, preroll_matrix_, true);
+}
+
 bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
                                       const SkPaint* paint) const {
+  if (context.builder) {
+    if (!context.raster_cache || cache_state_ != CacheState::kCurrent) {
+      return false;
+    }
+    return context.raster_cache->Draw(key_id_, *context.builder, paint);
+  }
   return Draw(context, context.canvas, paint);
 }
 
@@ -150,16 +179,19 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   RasterCache::Context r_context = {
       // clang-format off
-      .gr_context         = context.gr_context,
-      .dst_color_space    = context.dst_color_space,
-      .matrix             = transformation_matrix_,
-      .logical_rect       = bounds,
-      .flow_type          = flow_type,
+      .gr_context                = context.gr_context,
+      .dst_color_space           = context.dst_color_space,
+      .matrix                    = transformation_matrix_,
+      .logical_rect              = bounds,
+      .flow_type                 = flow_type,
+      .aiks_context              = context.aiks_context,
+      .complexity_score          = complexity_score_,
+      .allow_async_rasterization = true,
       // clang-format on
   };
   return context.raster_cache->UpdateCacheEntry(
       GetId().value(), r_context,
-      [display_list = display_list_](SkCanvas* canvas) {
+      [display_list = sk_ref_sp(display_list_)](SkCanvas* canvas) {
         display_list->RenderTo(canvas);
       });
 }
@@ -47,6 +47,10 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   bool TryToPrepareRasterCache(const PaintContext& context,
                                bool parent_cached = false) const override;
 
+  bool CanReusePreroll() const override;
+
+  void ReusePreroll(PrerollContext* context) override;
+
   void ModifyMatrix(SkPoint offset) const {
     matrix_ = matrix_.preTranslate(offset.x(), offset.y());
   }
@@ -55,10 +59,15 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
 
  private:
   SkMatrix transformation_matrix_;
+  // The matrix that the last |PrerollFinalize| marked the entry seen with.
+  SkMatrix preroll_matrix_;
   DisplayList* display_list_;
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // The complexity score computed in |PrerollSetup|, or 0 if the display
+  // list was not measured.
+  unsigned int complexity_score_ = 0;
 };
 
 }  // namespace flutter
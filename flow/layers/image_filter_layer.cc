@@ -19,6 +19,9 @@ ImageFilterLayer::ImageFilterLayer(std::shared_ptr<const DlImageFilter> filter,
 
 void ImageFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  // The filter may move the opaque pixels of the children or make them
+  // translucent.
+  context->MarkSubtreeTranslucent();
   auto* prev = static_cast<const ImageFilterLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
@@ -5,12 +5,14 @@
 #include "flutter/flow/layers/layer.h"
 
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/raster_cache_item.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 
 namespace flutter {
 
 Layer::Layer()
     : paint_bounds_(SkRect::MakeEmpty()),
+      opaque_bounds_(SkRect::MakeEmpty()),
       unique_id_(NextUniqueID()),
       original_layer_id_(unique_id_),
       subtree_has_platform_view_(false) {}
@@ -26,6 +28,88 @@ uint64_t Layer::NextUniqueID() {
   return id;
 }
 
+bool Layer::TryToReusePreroll(PrerollContext* context) {
+  bool retained = preroll_retained_;
+  preroll_retained_ = false;
+  if (!retained || !preroll_record_.has_value()) {
+    return false;
+  }
+  const PrerollRecord& record = preroll_record_.value();
+  if (record.raster_cache != context->raster_cache ||
+      record.has_raster_cached_entries !=
+          (context->raster_cached_entries != nullptr) ||
+      record.frame_device_pixel_ratio != context->frame_device_pixel_ratio ||
+      record.matrix != context->state_stack.transform_4x4() ||
+      record.cull_rect != context->state_stack.device_cull_rect() ||
+      record.has_complex_clip != context->has_complex_clip) {
+    return false;
+  }
+  for (RasterCacheItem* item : record.raster_cached_entries) {
+    if (!item->CanReusePreroll()) {
+      return false;
+    }
+  }
+
+  for (RasterCacheItem* item : record.raster_cached_entries) {
+    item->ReusePreroll(context);
+  }
+  context->renderable_state_flags = record.renderable_state_flags;
+  return true;
+}
+
+void Layer::RecordPreroll(const PrerollContext* context,
+                          size_t first_cached_entry,
+                          bool needed_readback) {
+  if (context->has_platform_view || context->has_texture_layer ||
+      needed_readback || context->surface_needs_readback) {
+    preroll_record_.reset();
+    return;
+  }
+  if (!preroll_record_.has_value()) {
+    preroll_record_.emplace();
+  }
+  PrerollRecord& record = preroll_record_.value();
+  record.matrix = context->state_stack.transform_4x4();
+  record.cull_rect = context->state_stack.device_cull_rect();
+  record.raster_cache = context->raster_cache;
+  record.has_raster_cached_entries = context->raster_cached_entries != nullptr;
+  record.frame_device_pixel_ratio = context->frame_device_pixel_ratio;
+  record.renderable_state_flags = context->renderable_state_flags;
+  record.has_complex_clip = context->has_complex_clip;
+  record.raster_cached_entries.clear();
+  if (context->raster_cached_entries) {
+    auto& entries = *context->raster_cached_entries;
+    record.raster_cached_entries.assign(entries.begin() + first_cached_entry,
+                                        entries.end());
+  }
+}
+
+SkRect Layer::ComputeOpaqueBounds(const PrerollContext* context,
+                                  const SkMatrix& matrix,
+                                  const SkRect& rect) {
+  SkRect bounds;
+  if (context->has_complex_clip || rect.isEmpty() ||
+      !matrix.mapRect(&bounds, rect) ||
+      !bounds.intersect(context->state_stack.device_cull_rect())) {
+    return SkRect::MakeEmpty();
+  }
+  // Anti-aliased edges only cover their pixels partially.
+  SkIRect pixels;
+  bounds.roundIn(&pixels);
+  return pixels.isEmpty() ? SkRect::MakeEmpty() : SkRect::Make(pixels);
+}
+
+bool Layer::IsExactClipRect(const SkMatrix& matrix,
+                            const SkRect& rect,
+                            bool is_aa) {
+  SkRect bounds;
+  if (!matrix.mapRect(&bounds, rect)) {
+    return false;
+  }
+  // The cull rect of an anti-aliased clip is rounded out to whole pixels.
+  return !is_aa || bounds == SkRect::Make(bounds.roundOut());
+}
+
 Layer::AutoPrerollSaveLayerState::AutoPrerollSaveLayerState(
     PrerollContext* preroll_context,
     bool save_layer_is_active,
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
 #include "flutter/flow/layer_snapshot_store.h"
+#include "flutter/flow/layers/layer_paint_list.h"
 #include "flutter/flow/layers/layer_state_stack.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/build_config.h"
@@ -26,6 +28,7 @@
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
+#include "third_party/skia/include/core/SkM44.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkRRect.h"
@@ -87,8 +90,26 @@ struct PrerollContext {
   // the embedders that must decide between creating SkPicture or
   // DisplayList objects for the inter-view slices of the layer tree.
   bool display_list_enabled = false;
+
+  // This flag will be set to true iff the frame is rendered with Impeller,
+  // so that the raster cache items can estimate the cost of their content
+  // with the complexity calculator for Impeller.
+  bool impeller_enabled = false;
+
+  // This flag is set by the layers that clip their children to a shape that
+  // the device cull rect of the state_stack doesn't match exactly, such as
+  // a rounded rect or an anti-aliased rect that isn't pixel aligned. Layers
+  // under such a clip can't know which pixels they cover entirely, so they
+  // don't report opaque bounds, see |Layer::opaque_bounds|.
+  bool has_complex_clip = false;
+
+  // How far the pointer driving a drag has moved since the frame was built,
+  // in logical pixels. See |TransformLayer::set_pointer_delta_scale|.
+  SkPoint late_latched_pointer_delta = SkPoint::Make(0, 0);
 };
 
+class LayerParallelPainter;
+
 struct PaintContext {
   // When splitting the scene into multiple canvases (e.g when embedding
   // a platform view on iOS) during the paint traversal we apply any state
@@ -120,6 +141,10 @@ struct PaintContext {
   LayerSnapshotStore* layer_snapshot_store = nullptr;
   bool enable_leaf_layer_tracing = false;
   impeller::AiksContext* aiks_context;
+
+  // Paints the children of containers on worker threads when non-null. See
+  // |LayerParallelPainter|.
+  const LayerParallelPainter* parallel_painter = nullptr;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -168,6 +193,38 @@ class Layer {
 
   virtual void Preroll(PrerollContext* context) = 0;
 
+  // Marks the layer as the same instance as in the tree of the previous
+  // frame, with nothing above it having changed since. This is set by
+  // |ContainerLayer::DiffChildren| for the retained layers whose paint
+  // region it preserves and is consumed by the next call to
+  // |TryToReusePreroll|.
+  void set_preroll_retained(bool retained) { preroll_retained_ = retained; }
+
+  // Replaces a call to |Preroll| for a retained layer with the outcome of
+  // its last |Preroll|, if that was recorded by |RecordPreroll| with the
+  // same transform, cull rect and raster cache as |context| has now and
+  // none of the raster cache items it registered would change their
+  // state in another |Preroll|. The paint bounds of the layer and of its
+  // subtree are still those of the last |Preroll|, so only the state that
+  // |Preroll| leaves in the |context| is restored and the raster cache
+  // items are registered and marked as seen for this frame again.
+  //
+  // Returns false, and leaves |context| untouched, if the layer has to be
+  // prerolled.
+  bool TryToReusePreroll(PrerollContext* context);
+
+  // Records the outcome of a call to |Preroll| that left the state in
+  // |context| for |TryToReusePreroll| to reuse in a later frame.
+  // |first_cached_entry| is the size that |raster_cached_entries| had
+  // before the call and |needed_readback| is the value that
+  // |surface_needs_readback| had.
+  //
+  // Nothing is recorded for a subtree with platform views, texture
+  // layers or readbacks, as those have to be prerolled every frame.
+  void RecordPreroll(const PrerollContext* context,
+                     size_t first_cached_entry,
+                     bool needed_readback);
+
   // Used during Preroll by layers that employ a saveLayer to manage the
   // PrerollContext settings with values affected by the saveLayer mechanism.
   // This object must be created before calling Preroll on the children to
@@ -198,11 +255,27 @@ class Layer {
 
   virtual void PaintChildren(PaintContext& context) const { FML_DCHECK(false); }
 
+  // Appends the commands that paint this layer to |list|, called on the
+  // layers of a tree after its |Preroll|. By default the layer is painted
+  // by a single command that calls its |Paint| method.
+  //
+  // Layers that only apply transforms or clips to their children compile
+  // those into |list| followed by the commands of their children instead,
+  // see |ContainerLayer::CompilePaint|.
+  virtual void CompilePaint(LayerPaintList* list) const {
+    list->PaintLayer(this);
+  }
+
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
   void set_subtree_has_platform_view(bool value) {
     subtree_has_platform_view_ = value;
   }
 
+  bool subtree_has_texture_layer() const { return subtree_has_texture_layer_; }
+  void set_subtree_has_texture_layer(bool value) {
+    subtree_has_texture_layer_ = value;
+  }
+
   // Returns the paint bounds in the layer's local coordinate system
   // as determined during Preroll().  The bounds should include any
   // transform, clip or distortions performed by the layer itself,
@@ -227,6 +300,40 @@ class Layer {
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.isEmpty(); }
 
+  // Returns the rect of whole device pixels that the layer covers with
+  // opaque content as determined during Preroll(), or an empty rect. Unlike
+  // the paint bounds, these are in device coordinates, as they are only
+  // compared with the bounds of other layers of the same frame.
+  //
+  // Layers only report opaque bounds if they paint them with full opacity
+  // whatever their ancestors are, so the layers that apply an opacity or a
+  // filter to their children don't pass their opaque bounds on.
+  const SkRect& opaque_bounds() const { return opaque_bounds_; }
+  void set_opaque_bounds(const SkRect& opaque_bounds) {
+    opaque_bounds_ = opaque_bounds;
+  }
+
+  // Whether the opaque bounds of the siblings painted after the layer hide
+  // all of it, so that its parent does not paint it. This is determined by
+  // |ContainerLayer::PrerollChildren|.
+  bool is_occluded() const { return is_occluded_; }
+  void set_occluded(bool occluded) { is_occluded_ = occluded; }
+
+  // Returns the opaque bounds covered by |rect|, in the local coordinates
+  // of a layer painted with |matrix| under the cull rect and clip of
+  // |context|, or an empty rect if the matrix doesn't keep it a rect or
+  // the clip is complex.
+  static SkRect ComputeOpaqueBounds(const PrerollContext* context,
+                                    const SkMatrix& matrix,
+                                    const SkRect& rect);
+
+  // Whether clipping to |rect| in local coordinates with |matrix| clips to
+  // exactly the device cull rect that the clip leaves, i.e. the matrix
+  // keeps the rect a rect and an anti-aliased clip is pixel aligned.
+  static bool IsExactClipRect(const SkMatrix& matrix,
+                              const SkRect& rect,
+                              bool is_aa);
+
   // Determines if the Paint() method is necessary based on the properties
   // of the indicated PaintContext object.
   bool needs_painting(PaintContext& context) const {
@@ -264,10 +371,28 @@ class Layer {
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
  private:
+  // The inputs and outcome of the last |Preroll| of a layer, see
+  // |RecordPreroll|.
+  struct PrerollRecord {
+    SkM44 matrix;
+    SkRect cull_rect;
+    const RasterCache* raster_cache;
+    bool has_raster_cached_entries;
+    float frame_device_pixel_ratio;
+    int renderable_state_flags;
+    bool has_complex_clip;
+    std::vector<RasterCacheItem*> raster_cached_entries;
+  };
+
   SkRect paint_bounds_;
+  SkRect opaque_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_;
+  bool subtree_has_texture_layer_ = false;
+  bool is_occluded_ = false;
+  bool preroll_retained_ = false;
+  std::optional<PrerollRecord> preroll_record_;
 
   static uint64_t NextUniqueID();
 
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_paint_list.h"
+
+#include <algorithm>
+
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_state_stack.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+void LayerPaintList::BeginLayer(const Layer* layer) {
+  open_layers_.push_back(commands_.size());
+  max_depth_ = std::max(max_depth_, open_layers_.size());
+  Command& command = commands_.emplace_back();
+  command.type = Type::kBeginLayer;
+  command.layer = layer;
+}
+
+void LayerPaintList::EndLayer() {
+  FML_DCHECK(!open_layers_.empty());
+  Command& command = commands_.emplace_back();
+  command.type = Type::kEndLayer;
+  commands_[open_layers_.back()].value = commands_.size();
+  open_layers_.pop_back();
+}
+
+void LayerPaintList::Transform(const SkMatrix& matrix) {
+  Command& command = commands_.emplace_back();
+  command.type = Type::kTransform;
+  command.matrix = &matrix;
+}
+
+void LayerPaintList::Clip(const SkRect& rect, bool is_aa) {
+  Command& command = commands_.emplace_back();
+  command.type = Type::kClipRect;
+  command.is_aa = is_aa;
+  command.rect = rect;
+}
+
+void LayerPaintList::Clip(const SkRRect& rrect, bool is_aa) {
+  Command& command = commands_.emplace_back();
+  command.type = Type::kClipRRect;
+  command.is_aa = is_aa;
+  command.rrect = &rrect;
+}
+
+void LayerPaintList::Clip(const SkPath& path, bool is_aa) {
+  Command& command = commands_.emplace_back();
+  command.type = Type::kClipPath;
+  command.is_aa = is_aa;
+  command.path = &path;
+}
+
+void LayerPaintList::ApplyState(const SkRect& bounds,
+                                int renderable_state_flags) {
+  Command& command = commands_.emplace_back();
+  command.type = Type::kApplyState;
+  command.value = renderable_state_flags;
+  command.rect = bounds;
+}
+
+void LayerPaintList::PaintLayer(const Layer* layer) {
+  Command& command = commands_.emplace_back();
+  command.type = Type::kPaintLayer;
+  command.layer = layer;
+}
+
+void LayerPaintList::Clear() {
+  commands_.clear();
+  open_layers_.clear();
+  max_depth_ = 0;
+}
+
+void LayerPaintList::Paint(PaintContext& context) const {
+  FML_DCHECK(open_layers_.empty());
+
+  LayerStateStack& state_stack = context.state_stack;
+  // The depths of the state stack to restore at the end of each open scope.
+  std::vector<size_t> restore_counts;
+  restore_counts.reserve(max_depth_);
+  // Whether the next transform or clip is the first one in its scope, which
+  // the state stack needs to know to decide on a protective saveLayer, as
+  // it does for the first call on a |MutatorContext|.
+  bool save_needed = true;
+
+  const size_t count = commands_.size();
+  size_t index = 0;
+  while (index < count) {
+    const Command& command = commands_[index];
+    switch (command.type) {
+      case Type::kBeginLayer:
+        if (!command.layer->needs_painting(context)) {
+          index = command.value;
+          continue;
+        }
+        restore_counts.push_back(state_stack.stack_count());
+        save_needed = true;
+        break;
+      case Type::kEndLayer:
+        state_stack.restore_to_count(restore_counts.back());
+        restore_counts.pop_back();
+        break;
+      case Type::kTransform: {
+        const SkMatrix& matrix = *command.matrix;
+        if (matrix.isTranslate()) {
+          SkScalar tx = matrix.getTranslateX();
+          SkScalar ty = matrix.getTranslateY();
+          if (!(tx == 0 && ty == 0)) {
+            state_stack.maybe_save_layer_for_transform(save_needed);
+            save_needed = false;
+            state_stack.push_translate(tx, ty);
+          }
+        } else if (!matrix.isIdentity()) {
+          state_stack.maybe_save_layer_for_transform(save_needed);
+          save_needed = false;
+          state_stack.push_transform(matrix);
+        }
+        break;
+      }
+      case Type::kClipRect:
+        state_stack.maybe_save_layer_for_clip(save_needed);
+        save_needed = false;
+        state_stack.push_clip_rect(command.rect, command.is_aa);
+        break;
+      case Type::kClipRRect:
+        state_stack.maybe_save_layer_for_clip(save_needed);
+        save_needed = false;
+        state_stack.push_clip_rrect(*command.rrect, command.is_aa);
+        break;
+      case Type::kClipPath:
+        state_stack.maybe_save_layer_for_clip(save_needed);
+        save_needed = false;
+        state_stack.push_clip_path(*command.path, command.is_aa);
+        break;
+      case Type::kApplyState:
+        if (state_stack.needs_save_layer(command.value)) {
+          state_stack.save_layer(command.rect);
+        }
+        break;
+      case Type::kPaintLayer:
+        if (command.layer->needs_painting(context)) {
+          command.layer->Paint(context);
+        }
+        break;
+    }
+    index++;
+  }
+  FML_DCHECK(restore_counts.empty());
+}
+
+}  // namespace flutter
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_PAINT_LIST_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_PAINT_LIST_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+class Layer;
+struct PaintContext;
+
+// A layer tree compiled after |Preroll| into a linear list of commands, so
+// that the tree can be painted by a single loop over contiguous memory
+// rather than by the recursive |Paint| calls of its layers.
+//
+// The layers that only transform or clip their children and pass the
+// outstanding state down to them (|ContainerLayer|, |TransformLayer| and the
+// clip layers that do not use a saveLayer) are compiled into a scope of
+// commands that apply those changes to the |LayerStateStack| followed by the
+// commands of their children. Every other layer, including all leaf layers,
+// is compiled into a single command that calls its |Paint| method. See
+// |Layer::CompilePaint|.
+//
+// The commands point to the layers and to the transforms and clips that the
+// layers hold, so the list must not outlive the layer tree it was compiled
+// from and must be compiled again after every |Preroll|.
+class LayerPaintList {
+ public:
+  LayerPaintList() = default;
+
+  // Starts the scope of the commands of |layer|, which are skipped while
+  // painting if |layer| does not need to be painted. Any state applied to
+  // the state stack within the scope is restored at its |EndLayer|.
+  void BeginLayer(const Layer* layer);
+
+  // Ends the scope started by the last unmatched |BeginLayer|.
+  void EndLayer();
+
+  void Transform(const SkMatrix& matrix);
+  void Clip(const SkRect& rect, bool is_aa);
+  void Clip(const SkRRect& rrect, bool is_aa);
+  void Clip(const SkPath& path, bool is_aa);
+
+  // Applies the outstanding state attributes that children with the given
+  // bounds and renderable state flags cannot apply themselves, as
+  // |ContainerLayer::PaintChildren| does before painting them.
+  void ApplyState(const SkRect& bounds, int renderable_state_flags);
+
+  // Paints |layer| with its own |Paint| method if it needs painting.
+  void PaintLayer(const Layer* layer);
+
+  // Paints the commands in order, which draws the same content as calling
+  // |Paint| on the layer tree the list was compiled from.
+  void Paint(PaintContext& context) const;
+
+  size_t command_count() const { return commands_.size(); }
+  bool is_empty() const { return commands_.empty(); }
+
+  void Clear();
+
+ private:
+  enum class Type : uint8_t {
+    kBeginLayer,
+    kEndLayer,
+    kTransform,
+    kClipRect,
+    kClipRRect,
+    kClipPath,
+    kApplyState,
+    kPaintLayer,
+  };
+
+  struct Command {
+    Type type;
+    bool is_aa = false;
+    // The index of the command after the matching |kEndLayer| for a
+    // |kBeginLayer| and the renderable state flags for a |kApplyState|.
+    uint32_t value = 0;
+    union {
+      const Layer* layer = nullptr;
+      const SkMatrix* matrix;
+      const SkRRect* rrect;
+      const SkPath* path;
+    };
+    // The clip of a |kClipRect| and the bounds of a |kApplyState|.
+    SkRect rect = SkRect::MakeEmpty();
+  };
+
+  std::vector<Command> commands_;
+  // The indices of the |kBeginLayer| commands of the open scopes while the
+  // list is compiled.
+  std::vector<uint32_t> open_layers_;
+  // The deepest nesting of scopes in the list.
+  size_t max_depth_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerPaintList);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_PAINT_LIST_H_
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_paint_list.h"
+#include "flutter/flow/layers/transform_layer.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr SkScalar kCanvasSize = 1024.0f;
+
+sk_sp<DisplayList> MakeLeafDisplayList() {
+  DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect(SkRect::MakeWH(16.0f, 16.0f));
+  return builder.Build();
+}
+
+// Builds a tree of |depth| levels below the returned layer, in which every
+// layer that is not a leaf has |fanout| children. The levels alternate
+// between transform and clip layers, which are the layers that the paint
+// list compiles into commands, and the leaves draw a small display list.
+std::shared_ptr<ContainerLayer> MakeTree(int depth,
+                                         int fanout,
+                                         const sk_sp<DisplayList>& leaf) {
+  std::shared_ptr<ContainerLayer> layer;
+  if (depth % 2 == 0) {
+    layer = std::make_shared<TransformLayer>(SkMatrix::Translate(2.0f, 3.0f));
+  } else {
+    layer = std::make_shared<ClipRectLayer>(
+        SkRect::MakeWH(kCanvasSize, kCanvasSize), Clip::hardEdge);
+  }
+  for (int i = 0; i < fanout; i++) {
+    if (depth <= 1) {
+      SkPoint offset = SkPoint::Make((i * 37) % 1000, (i * 53) % 1000);
+      layer->Add(std::make_shared<DisplayListLayer>(
+          offset, SkiaGPUObject<DisplayList>(leaf, nullptr), false, false));
+    } else {
+      layer->Add(MakeTree(depth - 1, fanout, leaf));
+    }
+  }
+  return layer;
+}
+
+}  // namespace
+
+// Paints a synthetic layer tree into a DisplayListBuilder, either with the
+// recursive |Paint| calls of its layers or from the |LayerPaintList| that
+// the tree is compiled into after its preroll. The compilation is not part
+// of the measured time, as it happens once per frame like the preroll.
+//
+// The first argument of the benchmark is the depth of the tree and the
+// second the number of children of each layer.
+static void BM_PaintLayerTree(benchmark::State& state, bool use_paint_list) {
+  int depth = state.range(0);
+  int fanout = state.range(1);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(MakeTree(depth, fanout, MakeLeafDisplayList()));
+
+  const FixedRefreshRateStopwatch unused_stopwatch;
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(
+      SkRect::MakeWH(kCanvasSize, kCanvasSize));
+  PrerollContext preroll_context{
+      // clang-format off
+      .raster_cache                  = nullptr,
+      .gr_context                    = nullptr,
+      .view_embedder                 = nullptr,
+      .state_stack                   = preroll_state_stack,
+      .dst_color_space               = nullptr,
+      .surface_needs_readback        = false,
+      .raster_time                   = unused_stopwatch,
+      .ui_time                       = unused_stopwatch,
+      .texture_registry              = nullptr,
+      // clang-format on
+  };
+  root->Preroll(&preroll_context);
+
+  LayerPaintList paint_list;
+  root->CompilePaint(&paint_list);
+  state.counters["Commands"] = paint_list.command_count();
+
+  for ([[maybe_unused]] auto _ : state) {
+    DisplayListBuilder builder(SkRect::MakeWH(kCanvasSize, kCanvasSize));
+    LayerStateStack state_stack;
+    state_stack.set_delegate(&builder);
+    PaintContext paint_context = {
+        // clang-format off
+        .state_stack                   = state_stack,
+        .canvas                        = nullptr,
+        .builder                       = &builder,
+        .gr_context                    = nullptr,
+        .dst_color_space               = nullptr,
+        .view_embedder                 = nullptr,
+        .raster_time                   = unused_stopwatch,
+        .ui_time                       = unused_stopwatch,
+        .texture_registry              = nullptr,
+        .raster_cache                  = nullptr,
+        // clang-format on
+    };
+    if (use_paint_list) {
+      paint_list.Paint(paint_context);
+    } else if (root->needs_painting(paint_context)) {
+      root->Paint(paint_context);
+    }
+    benchmark::DoNotOptimize(builder.Build());
+  }
+}
+
+BENCHMARK_CAPTURE(BM_PaintLayerTree, Recursive, false)
+    ->Args({4, 4})
+    ->Args({6, 4})
+    ->Args({8, 4})
+    ->Args({3, 16})
+    ->Args({4, 16})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_PaintLayerTree, PaintList, true)
+    ->Args({4, 4})
+    ->Args({6, 4})
+    ->Args({8, 4})
+    ->Args({3, 16})
+    ->Args({4, 16})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
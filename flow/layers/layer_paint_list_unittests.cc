@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_paint_list.h"
+
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/macros.h"
+#include "flutter/testing/mock_canvas.h"
+
+namespace flutter {
+namespace testing {
+
+using LayerPaintListTest = LayerTest;
+
+TEST_F(LayerPaintListTest, PaintsLikeTheLayerTree) {
+  SkPath path1 = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath path2 = SkPath().addRect(15.0f, 16.0f, 30.5f, 31.5f);
+  SkPath path3 = SkPath().addRect(2.0f, 2.0f, 10.0f, 10.0f);
+  auto mock_layer1 = std::make_shared<MockLayer>(path1, SkPaint());
+  auto mock_layer2 = std::make_shared<MockLayer>(path2, SkPaint());
+  auto mock_layer3 = std::make_shared<MockLayer>(path3, SkPaint());
+
+  // ContainerLayer
+  //   |- TransformLayer
+  //   |    |- ClipRectLayer
+  //   |         |- MockLayer
+  //   |         |- MockLayer
+  //   |- OpacityLayer
+  //        |- MockLayer
+  auto clip_layer = std::make_shared<ClipRectLayer>(
+      SkRect::MakeLTRB(0.0f, 0.0f, 25.0f, 25.0f), Clip::hardEdge);
+  clip_layer->Add(mock_layer1);
+  clip_layer->Add(mock_layer2);
+  auto transform_layer =
+      std::make_shared<TransformLayer>(SkMatrix::Scale(1.5f, 2.0f));
+  transform_layer->Add(clip_layer);
+  auto opacity_layer =
+      std::make_shared<OpacityLayer>(128, SkPoint::Make(3.0f, 4.0f));
+  opacity_layer->Add(mock_layer3);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(transform_layer);
+  root->Add(opacity_layer);
+
+  root->Preroll(preroll_context());
+  root->Paint(paint_context());
+  auto expected_draw_calls = mock_canvas().draw_calls();
+  ASSERT_FALSE(expected_draw_calls.empty());
+  mock_canvas().reset_draw_calls();
+
+  LayerPaintList list;
+  root->CompilePaint(&list);
+  // The root, transform and clip layers are compiled into scopes of
+  // commands and the opacity layer into a single command.
+  EXPECT_EQ(list.command_count(), 14u);
+
+  list.Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+  EXPECT_TRUE(paint_context().state_stack.is_empty());
+}
+
+TEST_F(LayerPaintListTest, SkipsLayersThatDoNotNeedPainting) {
+  SkPath path = SkPath().addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto visible_layer = std::make_shared<MockLayer>(path, SkPaint());
+  auto culled_layer = std::make_shared<MockLayer>(path, SkPaint());
+
+  auto transform_layer =
+      std::make_shared<TransformLayer>(SkMatrix::Translate(1e5f, 1e5f));
+  transform_layer->Add(culled_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(transform_layer);
+  root->Add(visible_layer);
+
+  root->Preroll(preroll_context());
+  LayerPaintList list;
+  root->CompilePaint(&list);
+  list.Paint(paint_context());
+
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{path, SkPaint()}}}));
+  EXPECT_TRUE(paint_context().state_stack.is_empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
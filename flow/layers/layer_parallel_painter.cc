@@ -0,0 +1,227 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_parallel_painter.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/display_list/display_list_canvas_recorder.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkDeferredDisplayList.h"
+#include "third_party/skia/include/core/SkDeferredDisplayListRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/core/SkSurfaceCharacterization.h"
+
+namespace flutter {
+
+namespace {
+
+// Paints |layers| to the delegate of |state_stack|, with the frame state
+// of |context|.
+void PaintLayersTo(const std::vector<const Layer*>& layers,
+                   const PaintContext& context,
+                   LayerStateStack& state_stack,
+                   SkCanvas* canvas,
+                   DisplayListBuilder* builder) {
+  state_stack.set_checkerboard_func(context.state_stack.checkerboard_func());
+  PaintContext layers_context = {
+      // clang-format off
+      .state_stack                   = state_stack,
+      .canvas                        = canvas,
+      .builder                       = builder,
+      .gr_context                    = nullptr,
+      .dst_color_space               = context.dst_color_space,
+      .view_embedder                 = nullptr,
+      .raster_time                   = context.raster_time,
+      .ui_time                       = context.ui_time,
+      .texture_registry              = nullptr,
+      .raster_cache                  = context.raster_cache,
+      .frame_device_pixel_ratio      = context.frame_device_pixel_ratio,
+      .layer_snapshot_store          = nullptr,
+      .enable_leaf_layer_tracing     = false,
+      .aiks_context                  = nullptr,
+      .parallel_painter              = nullptr,
+      // clang-format on
+  };
+  for (const Layer* layer : layers) {
+    if (layer->needs_painting(layers_context)) {
+      layer->Paint(layers_context);
+    }
+  }
+  state_stack.clear_delegate();
+}
+
+// Paints |layers| into a display list in the device space of |context|.
+sk_sp<DisplayList> PaintLayers(const std::vector<const Layer*>& layers,
+                               const PaintContext& context,
+                               const SkRect& device_cull_rect,
+                               const SkM44& matrix) {
+  TRACE_EVENT0("flutter", "LayerParallelPainter::PaintLayers");
+  DisplayListCanvasRecorder recorder(device_cull_rect);
+  recorder.setMatrix(matrix);
+  LayerStateStack state_stack;
+  state_stack.set_delegate(recorder);
+  PaintLayersTo(layers, context, state_stack, &recorder,
+                recorder.builder().get());
+  return recorder.Build();
+}
+
+// Records |layers| into a deferred display list for surfaces with
+// |characterization|, in the device space of |context|. Returns nullptr if
+// the display list could not be recorded.
+sk_sp<SkDeferredDisplayList> RecordLayers(
+    const std::vector<const Layer*>& layers,
+    const PaintContext& context,
+    const SkSurfaceCharacterization& characterization,
+    const SkRect& device_clip_rect,
+    const SkM44& matrix) {
+  TRACE_EVENT0("flutter", "LayerParallelPainter::RecordLayers");
+  SkDeferredDisplayListRecorder recorder(characterization);
+  SkCanvas* canvas = recorder.getCanvas();
+  if (!canvas) {
+    return nullptr;
+  }
+  canvas->clipRect(device_clip_rect);
+  canvas->setMatrix(matrix);
+  LayerStateStack state_stack;
+  state_stack.set_delegate(canvas);
+  PaintLayersTo(layers, context, state_stack, canvas, nullptr);
+  return recorder.detach();
+}
+
+}  // namespace
+
+LayerParallelPainter::LayerParallelPainter(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t max_tasks,
+    bool record_deferred_display_lists)
+    : task_runner_(std::move(task_runner)),
+      max_tasks_(max_tasks),
+      record_deferred_display_lists_(record_deferred_display_lists) {
+  FML_DCHECK(task_runner_);
+}
+
+SkSurface* LayerParallelPainter::GetDeferredDisplayListSurface(
+    PaintContext& context) const {
+  if (!record_deferred_display_lists_ || !context.canvas ||
+      context.state_stack.canvas_delegate() != context.canvas ||
+      context.state_stack.is_in_save_layer() ||
+      !context.canvas->isClipRect()) {
+    return nullptr;
+  }
+  // The canvases of the deferred display lists are clipped to the device
+  // cull rect, which is only the clip of the canvas if it has whole pixels.
+  SkRect device_cull_rect = context.state_stack.device_cull_rect();
+  if (SkRect::Make(device_cull_rect.roundOut()) != device_cull_rect) {
+    return nullptr;
+  }
+  return context.canvas->getSurface();
+}
+
+void LayerParallelPainter::PaintRunsToSurface(
+    const std::vector<std::vector<const Layer*>>& runs,
+    PaintContext& context,
+    SkSurface* surface) const {
+  const SkRect device_clip_rect = context.state_stack.device_cull_rect();
+  const SkM44 matrix = context.state_stack.transform_4x4();
+  std::vector<sk_sp<SkDeferredDisplayList>> display_lists(runs.size());
+  SkSurfaceCharacterization characterization;
+  if (surface->characterize(&characterization)) {
+    fml::CountDownLatch latch(runs.size() - 1);
+    for (size_t i = 1; i < runs.size(); i++) {
+      task_runner_->PostTask([&, i] {
+        display_lists[i] = RecordLayers(runs[i], context, characterization,
+                                        device_clip_rect, matrix);
+        latch.CountDown();
+      });
+    }
+    display_lists[0] = RecordLayers(runs[0], context, characterization,
+                                    device_clip_rect, matrix);
+    latch.Wait();
+  }
+
+  // The runs that could not be recorded are painted here, in order.
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (display_lists[i]) {
+      surface->draw(display_lists[i]);
+      continue;
+    }
+    for (const Layer* layer : runs[i]) {
+      if (layer->needs_painting(context)) {
+        layer->Paint(context);
+      }
+    }
+  }
+}
+
+bool LayerParallelPainter::PaintChildren(const ContainerLayer* container,
+                                         PaintContext& context) const {
+  DisplayListBuilder* builder = context.builder;
+  SkSurface* surface =
+      builder ? nullptr : GetDeferredDisplayListSurface(context);
+  if (max_tasks_ < 2 || (!builder && !surface) ||
+      (builder && context.state_stack.builder_delegate() != builder) ||
+      container->subtree_has_platform_view() ||
+      container->subtree_has_texture_layer() ||
+      context.state_stack.outstanding_opacity() != SK_Scalar1 ||
+      context.state_stack.outstanding_color_filter() ||
+      context.state_stack.outstanding_image_filter()) {
+    return false;
+  }
+
+  std::vector<const Layer*> layers;
+  for (auto& layer : container->layers()) {
+    if (!layer->is_occluded() && layer->needs_painting(context)) {
+      layers.push_back(layer.get());
+    }
+  }
+  if (layers.size() < 2) {
+    return false;
+  }
+
+  TRACE_EVENT0("flutter", "LayerParallelPainter::PaintChildren");
+
+  // Split the children into runs of consecutive children of about the same
+  // length.
+  size_t task_count = std::min(max_tasks_, layers.size());
+  std::vector<std::vector<const Layer*>> runs(task_count);
+  for (size_t i = 0; i < layers.size(); i++) {
+    runs[i * task_count / layers.size()].push_back(layers[i]);
+  }
+
+  if (surface) {
+    PaintRunsToSurface(runs, context, surface);
+    return true;
+  }
+
+  const SkRect device_cull_rect = context.state_stack.device_cull_rect();
+  const SkM44 matrix = context.state_stack.transform_4x4();
+  std::vector<sk_sp<DisplayList>> display_lists(task_count);
+  fml::CountDownLatch latch(task_count - 1);
+  for (size_t i = 1; i < task_count; i++) {
+    task_runner_->PostTask([&, i] {
+      display_lists[i] =
+          PaintLayers(runs[i], context, device_cull_rect, matrix);
+      latch.CountDown();
+    });
+  }
+  display_lists[0] = PaintLayers(runs[0], context, device_cull_rect, matrix);
+  latch.Wait();
+
+  // The display lists already contain the transform of |context|.
+  builder->save();
+  builder->transformReset();
+  for (auto& display_list : display_lists) {
+    if (display_list->op_count() > 0) {
+      builder->drawDisplayList(display_list);
+    }
+  }
+  builder->restore();
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_PARALLEL_PAINTER_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_PARALLEL_PAINTER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+class SkSurface;
+
+namespace flutter {
+
+class ContainerLayer;
+class Layer;
+struct PaintContext;
+
+// Paints the children of a container into separate display lists on worker
+// threads and draws those display lists into the frame's builder in order.
+//
+// Recording a display list does not depend on the content that is already
+// recorded, and a nested display list is replayed directly onto the canvas
+// of the display list that draws it, so the children paint and blend
+// exactly as if they had been painted one after the other.
+//
+// A container hands its children to the painter from |PaintChildren| when
+// the frame is painted into a |DisplayListBuilder|. The children are split
+// into at most |max_tasks| runs of consecutive children, one of which is
+// painted on the calling thread while the others are posted to the task
+// runner. The children of a container are painted serially, and may in turn
+// be painted in parallel, if:
+//
+//   - the subtree has a platform view or a texture layer, as those paint
+//     through the view embedder or with the GPU context of the raster thread,
+//   - the state stack has outstanding attributes that the children would
+//     have to render themselves,
+//   - fewer than two children need painting.
+//
+// Only one level of the tree is split. The children painted on a worker
+// never hand their own children to the painter.
+//
+// If |record_deferred_display_lists| is set, a frame that is painted into the
+// canvas of a Skia GPU surface is split too. The runs are then recorded into
+// deferred display lists, which the GPU work of the runs is prepared on the
+// workers for, and drawn to the surface in order. These canvases don't inherit
+// the state of the surface's canvas, so their children are only split when
+// the canvas is only clipped to a rect of whole pixels and isn't drawing into
+// a save layer. The runs of a deferred display list that can't be recorded are
+// painted onto the canvas instead.
+class LayerParallelPainter {
+ public:
+  LayerParallelPainter(std::shared_ptr<fml::BasicTaskRunner> task_runner,
+                       size_t max_tasks,
+                       bool record_deferred_display_lists = false);
+
+  size_t max_tasks() const { return max_tasks_; }
+
+  bool record_deferred_display_lists() const {
+    return record_deferred_display_lists_;
+  }
+
+  // Paints the children of |container| into |context|, in parallel if they
+  // can be. Returns false, without painting anything, if the children must
+  // be painted serially by the caller.
+  bool PaintChildren(const ContainerLayer* container,
+                     PaintContext& context) const;
+
+ private:
+  // The surface of the canvas of |context| if the children can be recorded
+  // into deferred display lists for it, or nullptr.
+  SkSurface* GetDeferredDisplayListSurface(PaintContext& context) const;
+
+  void PaintRunsToSurface(const std::vector<std::vector<const Layer*>>& runs,
+                          PaintContext& context,
+                          SkSurface* surface) const;
+
+  std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  const size_t max_tasks_;
+  const bool record_deferred_display_lists_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerParallelPainter);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_PARALLEL_PAINTER_H_
@@ -0,0 +1,213 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_parallel_painter.h"
+
+#include "flutter/display_list/display_list_canvas_recorder.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/testing/layer_test.h"
+#include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr SkISize kCanvasSize = SkISize::Make(64, 64);
+
+// Runs the tasks posted to it right away on the posting thread.
+class CountingTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(fml::UniqueClosure task) override {
+    posted_tasks_++;
+    task();
+  }
+
+  int posted_tasks() const { return posted_tasks_; }
+
+ private:
+  int posted_tasks_ = 0;
+};
+
+}  // namespace
+
+class LayerParallelPainterTest : public LayerTest {
+ public:
+  // Paints |layer| with |matrix| into a display list with |painter|, or
+  // serially if |painter| is null.
+  sk_sp<DisplayList> PaintToDisplayList(
+      const Layer* layer,
+      const LayerParallelPainter* painter,
+      const SkMatrix& matrix = SkMatrix::I()) {
+    DisplayListCanvasRecorder recorder(SkRect::Make(kCanvasSize));
+    recorder.setMatrix(matrix);
+    LayerStateStack state_stack;
+    state_stack.set_delegate(recorder);
+    PaintContext context{
+        // clang-format off
+        .state_stack                   = state_stack,
+        .canvas                        = &recorder,
+        .builder                       = recorder.builder().get(),
+        .gr_context                    = nullptr,
+        .view_embedder                 = nullptr,
+        .raster_time                   = paint_context().raster_time,
+        .ui_time                       = paint_context().ui_time,
+        .texture_registry              = nullptr,
+        .raster_cache                  = nullptr,
+        .frame_device_pixel_ratio      = 1.0f,
+        .parallel_painter              = painter,
+        // clang-format on
+    };
+    layer->Paint(context);
+    state_stack.clear_delegate();
+    return recorder.Build();
+  }
+
+  static std::vector<uint32_t> Rasterize(const sk_sp<DisplayList>& dl) {
+    auto surface = SkSurface::MakeRasterN32Premul(kCanvasSize.width(),
+                                                  kCanvasSize.height());
+    surface->getCanvas()->drawColor(SK_ColorWHITE);
+    dl->RenderTo(surface->getCanvas());
+    SkPixmap pixmap;
+    EXPECT_TRUE(surface->peekPixels(&pixmap));
+    std::vector<uint32_t> pixels;
+    for (int y = 0; y < kCanvasSize.height(); y++) {
+      const uint32_t* row = pixmap.addr32(0, y);
+      pixels.insert(pixels.end(), row, row + kCanvasSize.width());
+    }
+    return pixels;
+  }
+};
+
+static std::shared_ptr<ContainerLayer> MakeContainer(int child_count) {
+  auto container = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < child_count; i++) {
+    SkPath path;
+    path.addRect(SkRect::MakeXYWH(i * 6.0f, i * 4.0f, 20.0f, 20.0f));
+    SkPaint paint(SkColor4f::FromColor(
+        SkColorSetARGB(0x80, i * 40, 0xff - i * 40, 0x80)));
+    container->Add(std::make_shared<MockLayer>(path, paint));
+  }
+  return container;
+}
+
+TEST_F(LayerParallelPainterTest, PaintsRunsOfChildrenOnTheTaskRunner) {
+  auto container = MakeContainer(5);
+  container->Preroll(preroll_context());
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  LayerParallelPainter painter(task_runner, 3);
+  auto parallel = PaintToDisplayList(container.get(), &painter);
+  auto serial = PaintToDisplayList(container.get(), nullptr);
+
+  // One of the three runs is painted on the calling thread.
+  EXPECT_EQ(task_runner->posted_tasks(), 2);
+  EXPECT_EQ(parallel->bounds(), serial->bounds());
+  EXPECT_EQ(Rasterize(parallel), Rasterize(serial));
+}
+
+TEST_F(LayerParallelPainterTest, PaintsConcurrentlyLikeSerialPaint) {
+  auto container = MakeContainer(6);
+  auto transform = SkMatrix::Translate(3.5f, 2.0f);
+  transform.preScale(1.5f, 1.5f);
+  preroll_context()->state_stack.set_preroll_delegate(kGiantRect, transform);
+  container->Preroll(preroll_context());
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  LayerParallelPainter painter(loop->GetTaskRunner(), 3);
+  auto parallel = PaintToDisplayList(container.get(), &painter, transform);
+  auto serial = PaintToDisplayList(container.get(), nullptr, transform);
+
+  EXPECT_EQ(parallel->bounds(), serial->bounds());
+  EXPECT_EQ(Rasterize(parallel), Rasterize(serial));
+}
+
+TEST_F(LayerParallelPainterTest, PlatformViewsArePaintedSerially) {
+  auto container = MakeContainer(3);
+  auto* mock_layer = static_cast<MockLayer*>(container->layers()[1].get());
+  mock_layer->set_fake_has_platform_view(true);
+  container->Preroll(preroll_context());
+  EXPECT_TRUE(container->subtree_has_platform_view());
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  LayerParallelPainter painter(task_runner, 3);
+  auto parallel = PaintToDisplayList(container.get(), &painter);
+  auto serial = PaintToDisplayList(container.get(), nullptr);
+
+  EXPECT_EQ(task_runner->posted_tasks(), 0);
+  EXPECT_EQ(parallel->op_count(true), serial->op_count(true));
+}
+
+TEST_F(LayerParallelPainterTest, ChildrenAreNotSplitWhenPaintingToACanvas) {
+  auto container = MakeContainer(3);
+  container->Preroll(preroll_context());
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  LayerParallelPainter painter(task_runner, 3);
+  EXPECT_FALSE(painter.PaintChildren(container.get(), paint_context()));
+  EXPECT_EQ(task_runner->posted_tasks(), 0);
+  EXPECT_TRUE(mock_canvas().draw_calls().empty());
+}
+
+TEST_F(LayerParallelPainterTest,
+       DeferredDisplayListsAreOnlyRecordedForSurfaces) {
+  auto container = MakeContainer(3);
+  container->Preroll(preroll_context());
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  LayerParallelPainter painter(task_runner, 3, true);
+  EXPECT_TRUE(painter.record_deferred_display_lists());
+  EXPECT_FALSE(painter.PaintChildren(container.get(), paint_context()));
+  EXPECT_EQ(task_runner->posted_tasks(), 0);
+  EXPECT_TRUE(mock_canvas().draw_calls().empty());
+}
+
+TEST_F(LayerParallelPainterTest, RasterSurfacesArePaintedInOrder) {
+  auto container = MakeContainer(4);
+  container->Preroll(preroll_context());
+
+  auto task_runner = std::make_shared<CountingTaskRunner>();
+  LayerParallelPainter painter(task_runner, 2, true);
+  auto surface = SkSurface::MakeRasterN32Premul(kCanvasSize.width(),
+                                                kCanvasSize.height());
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->drawColor(SK_ColorWHITE);
+  LayerStateStack state_stack;
+  state_stack.set_delegate(canvas);
+  PaintContext context{
+      // clang-format off
+      .state_stack                   = state_stack,
+      .canvas                        = canvas,
+      .builder                       = nullptr,
+      .gr_context                    = nullptr,
+      .view_embedder                 = nullptr,
+      .raster_time                   = paint_context().raster_time,
+      .ui_time                       = paint_context().ui_time,
+      .texture_registry              = nullptr,
+      .raster_cache                  = nullptr,
+      .frame_device_pixel_ratio      = 1.0f,
+      // clang-format on
+  };
+
+  // Raster surfaces can't be characterized, so the runs are painted onto
+  // the canvas without any tasks.
+  EXPECT_TRUE(painter.PaintChildren(container.get(), context));
+  state_stack.clear_delegate();
+  EXPECT_EQ(task_runner->posted_tasks(), 0);
+
+  SkPixmap pixmap;
+  ASSERT_TRUE(surface->peekPixels(&pixmap));
+  std::vector<uint32_t> pixels;
+  for (int y = 0; y < kCanvasSize.height(); y++) {
+    const uint32_t* row = pixmap.addr32(0, y);
+    pixels.insert(pixels.end(), row, row + kCanvasSize.width());
+  }
+  EXPECT_EQ(pixels, Rasterize(PaintToDisplayList(container.get(), nullptr)));
+}
+
+}  // namespace testing
+}  // namespace flutter
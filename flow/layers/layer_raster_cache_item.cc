@@ -74,6 +74,21 @@ void LayerRasterCacheItem::PrerollFinalize(PrerollContext* context,
   }
 }
 
+bool LayerRasterCacheItem::CanReusePreroll() const {
+  // The layer is only cached after it has been prerolled for a number of
+  // frames, which a reused preroll would not count, so only the items where
+  // the layer itself is already cached can be reused.
+  return cache_state_ == CacheState::kCurrent;
+}
+
+void LayerRasterCacheItem::ReusePreroll(PrerollContext* context) {
+  if (!context->raster_cache || !context->raster_cached_entries) {
+    return;
+  }
+  context->raster_cached_entries->push_back(this);
+  context->raster_cache->MarkSeen(key_id_, matrix_, true);
+}
+
 std::optional<RasterCacheKeyID> LayerRasterCacheItem::GetId() const {
   switch (cache_state_) {
     case kCurrent:
@@ -153,6 +168,7 @@ bool LayerRasterCacheItem::TryToPrepareRasterCache(const PaintContext& context,
           .matrix             = matrix_,
           .logical_rect       = *paint_bounds,
           .flow_type          = flow_type,
+          .aiks_context       = context.aiks_context,
           // clang-format on
       };
       return context.raster_cache->UpdateCacheEntry(
@@ -168,6 +184,20 @@ bool LayerRasterCacheItem::TryToPrepareRasterCache(const PaintContext& context,
 
 bool LayerRasterCacheItem::Draw(const PaintContext& context,
                                 const SkPaint* paint) const {
+  if (context.builder) {
+    if (!context.raster_cache) {
+      return false;
+    }
+    switch (cache_state_) {
+      case RasterCacheItem::kNone:
+        return false;
+      case RasterCacheItem::kCurrent:
+        return context.raster_cache->Draw(key_id_, *context.builder, paint);
+      case RasterCacheItem::kChildren:
+        return context.raster_cache->Draw(layer_children_id_.value(),
+                                          *context.builder, paint);
+    }
+  }
   return Draw(context, context.canvas, paint);
 }
 
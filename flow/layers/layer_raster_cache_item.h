@@ -45,6 +45,10 @@ class LayerRasterCacheItem : public RasterCacheItem {
   bool TryToPrepareRasterCache(const PaintContext& context,
                                bool parent_cached = false) const override;
 
+  bool CanReusePreroll() const override;
+
+  void ReusePreroll(PrerollContext* context) override;
+
   void MarkCacheChildren() { can_cache_children_ = true; }
 
   void MarkNotCacheChildren() { can_cache_children_ = false; }
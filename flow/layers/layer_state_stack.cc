@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/layer_state_stack.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list_matrix_clip_tracker.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -293,6 +295,7 @@ class SaveLayerEntry : public LayerStateStack::StateEntry {
     stack->delegate_->restore();
     stack->outstanding_ = old_attributes_;
   }
+  bool is_save_layer() const override { return true; }
 
  protected:
   const SkRect bounds_;
@@ -320,8 +323,8 @@ class OpacityEntry : public LayerStateStack::StateEntry {
     stack->outstanding_.save_layer_bounds = old_bounds_;
     stack->outstanding_.opacity = old_opacity_;
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushOpacity(DlColor::toAlpha(opacity_));
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(DlColor::toAlpha(opacity_));
   }
 
  private:
@@ -354,7 +357,7 @@ class ImageFilterEntry : public LayerStateStack::StateEntry {
   }
 
   // There is no ImageFilter mutator currently
-  // void update_mutators(MutatorsStack* mutators_stack) const override;
+  // std::shared_ptr<Mutator> make_mutator() const override;
 
  private:
   const SkRect bounds_;
@@ -386,7 +389,7 @@ class ColorFilterEntry : public LayerStateStack::StateEntry {
   }
 
   // There is no ColorFilter mutator currently
-  // void update_mutators(MutatorsStack* mutators_stack) const override;
+  // std::shared_ptr<Mutator> make_mutator() const override;
 
  private:
   const SkRect bounds_;
@@ -436,8 +439,8 @@ class TranslateEntry : public LayerStateStack::StateEntry {
   void apply(LayerStateStack* stack) const override {
     stack->delegate_->translate(tx_, ty_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushTransform(SkMatrix::Translate(tx_, ty_));
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(SkMatrix::Translate(tx_, ty_));
   }
 
  private:
@@ -454,8 +457,8 @@ class TransformMatrixEntry : public LayerStateStack::StateEntry {
   void apply(LayerStateStack* stack) const override {
     stack->delegate_->transform(matrix_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushTransform(matrix_);
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(matrix_);
   }
 
  private:
@@ -471,8 +474,8 @@ class TransformM44Entry : public LayerStateStack::StateEntry {
   void apply(LayerStateStack* stack) const override {
     stack->delegate_->transform(m44_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushTransform(m44_.asM33());
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(m44_.asM33());
   }
 
  private:
@@ -501,8 +504,8 @@ class ClipRectEntry : public LayerStateStack::StateEntry {
   void apply(LayerStateStack* stack) const override {
     stack->delegate_->clipRect(clip_rect_, SkClipOp::kIntersect, is_aa_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushClipRect(clip_rect_);
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(clip_rect_);
   }
 
  private:
@@ -520,8 +523,8 @@ class ClipRRectEntry : public LayerStateStack::StateEntry {
   void apply(LayerStateStack* stack) const override {
     stack->delegate_->clipRRect(clip_rrect_, SkClipOp::kIntersect, is_aa_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushClipRRect(clip_rrect_);
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(clip_rrect_);
   }
 
  private:
@@ -540,8 +543,8 @@ class ClipPathEntry : public LayerStateStack::StateEntry {
   void apply(LayerStateStack* stack) const override {
     stack->delegate_->clipPath(clip_path_, SkClipOp::kIntersect, is_aa_);
   }
-  void update_mutators(MutatorsStack* mutators_stack) const override {
-    mutators_stack->PushClipPath(clip_path_);
+  std::shared_ptr<Mutator> make_mutator() const override {
+    return std::make_shared<Mutator>(clip_path_);
   }
 
  private:
@@ -757,12 +760,31 @@ void LayerStateStack::reapply_all() {
   FML_DCHECK(attributes == outstanding_);
 }
 
+void LayerStateStack::StateEntry::update_mutators(
+    MutatorsStack* mutators_stack) const {
+  if (!mutator_made_) {
+    mutator_ = make_mutator();
+    mutator_made_ = true;
+  }
+  if (mutator_) {
+    mutators_stack->Push(mutator_);
+  }
+}
+
 void LayerStateStack::fill(MutatorsStack* mutators) {
   for (auto& state : state_stack_) {
     state->update_mutators(mutators);
   }
 }
 
+bool LayerStateStack::is_in_save_layer() const {
+  return std::any_of(
+      state_stack_.begin(), state_stack_.end(),
+      [](const std::unique_ptr<StateEntry>& entry) {
+        return entry->is_save_layer();
+      });
+}
+
 void LayerStateStack::restore_to_count(size_t restore_count) {
   while (state_stack_.size() > restore_count) {
     state_stack_.back()->restore(this);
@@ -353,6 +353,11 @@ class LayerStateStack {
   // its initial state.
   bool is_empty() const { return state_stack_.empty(); }
 
+  // Returns true if a saveLayer was executed by the state stack and is
+  // not yet restored, so that the canvas or builder is rendering into a
+  // layer rather than directly into its surface.
+  bool is_in_save_layer() const;
+
  private:
   size_t stack_count() const { return state_stack_.size(); }
   void restore_to_count(size_t restore_count);
@@ -436,11 +441,25 @@ class LayerStateStack {
     virtual void apply(LayerStateStack* stack) const = 0;
     virtual void reapply(LayerStateStack* stack) const { apply(stack); }
     virtual void restore(LayerStateStack* stack) const {}
-    virtual void update_mutators(MutatorsStack* mutators_stack) const {}
+
+    virtual bool is_save_layer() const { return false; }
+
+    // Pushes the mutator of this entry, if it has one, onto
+    // |mutators_stack|. The mutator is made once and shared by the stacks
+    // of all of the embedded views that the entry applies to.
+    void update_mutators(MutatorsStack* mutators_stack) const;
 
    protected:
     StateEntry() = default;
 
+    // Returns the mutator that this entry applies to embedded views, or
+    // nullptr if it is not applied to them.
+    virtual std::shared_ptr<Mutator> make_mutator() const { return nullptr; }
+
+   private:
+    mutable bool mutator_made_ = false;
+    mutable std::shared_ptr<Mutator> mutator_;
+
     FML_DISALLOW_COPY_ASSIGN_AND_MOVE(StateEntry);
   };
   friend class SaveEntry;
@@ -503,6 +522,7 @@ class LayerStateStack {
 
   std::vector<std::unique_ptr<StateEntry>> state_stack_;
   friend class MutatorContext;
+  friend class LayerPaintList;
 
   std::shared_ptr<Delegate> delegate_;
   RenderingAttributes outstanding_;
@@ -516,5 +516,26 @@ TEST(LayerStateStack, ColorFilterAndImageFilterInteraction) {
   ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
 }
 
+TEST(LayerStateStack, FilledMutatorsAreShared) {
+  LayerStateStack state_stack;
+  state_stack.set_preroll_delegate(SkRect::MakeLTRB(0, 0, 100, 100));
+  auto mutator = state_stack.save();
+  mutator.translate(10, 10);
+  mutator.clipRect(SkRect::MakeLTRB(0, 0, 50, 50), false);
+
+  MutatorsStack first;
+  state_stack.fill(&first);
+  MutatorsStack second;
+  state_stack.fill(&second);
+
+  ASSERT_EQ(first.stack_count(), 2u);
+  ASSERT_TRUE(first == second);
+  auto first_iter = first.Begin();
+  auto second_iter = second.Begin();
+  ASSERT_EQ(first_iter->get(), second_iter->get());
+  ASSERT_EQ((++first_iter)->get(), (++second_iter)->get());
+  ASSERT_EQ(first_iter->get()->GetType(), MutatorType::kClipRect);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -11,6 +11,7 @@
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/fml/allocation_counter.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "include/core/SkMatrix.h"
@@ -36,6 +37,7 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
                         bool ignore_raster_cache,
                         SkRect cull_rect) {
   TRACE_EVENT0("flutter", "LayerTree::Preroll");
+  FML_TRACE_ALLOCATIONS("flutter", "LayerTree::PrerollAllocations");
 
   if (!root_layer_) {
     FML_LOG(ERROR) << "The scene did not specify any layers.";
@@ -51,6 +53,9 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
   RasterCache* cache =
       ignore_raster_cache ? nullptr : &frame.context().raster_cache();
   raster_cache_items_.clear();
+  if (frame.view_embedder()) {
+    frame.view_embedder()->params_cache().BeginFrame();
+  }
 
   PrerollContext context = {
       // clang-format off
@@ -66,11 +71,19 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .frame_device_pixel_ratio      = device_pixel_ratio_,
       .raster_cached_entries         = &raster_cache_items_,
       .display_list_enabled          = frame.display_list_builder() != nullptr,
+      .impeller_enabled              = frame.aiks_context() != nullptr,
+      .late_latched_pointer_delta    = late_latched_pointer_delta_,
       // clang-format on
   };
 
   root_layer_->Preroll(&context);
 
+  paint_list_.Clear();
+  if (enable_paint_list_) {
+    TRACE_EVENT0("flutter", "LayerTree::CompilePaint");
+    root_layer_->CompilePaint(&paint_list_);
+  }
+
   return context.surface_needs_readback;
 }
 
@@ -105,6 +118,7 @@ void LayerTree::TryToRasterCache(
 void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
                       bool ignore_raster_cache) const {
   TRACE_EVENT0("flutter", "LayerTree::Paint");
+  FML_TRACE_ALLOCATIONS("flutter", "LayerTree::PaintAllocations");
 
   if (!root_layer_) {
     FML_LOG(ERROR) << "The scene did not specify any layers to paint.";
@@ -149,6 +163,9 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .layer_snapshot_store          = snapshot_store,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
       .aiks_context                  = frame.aiks_context(),
+      .parallel_painter              = enable_leaf_layer_tracing_
+                                           ? nullptr
+                                           : parallel_painter_.get(),
       // clang-format on
   };
 
@@ -157,7 +174,9 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
   }
 
-  if (root_layer_->needs_painting(context)) {
+  if (enable_paint_list_ && !paint_list_.is_empty()) {
+    paint_list_.Paint(context);
+  } else if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
   }
 }
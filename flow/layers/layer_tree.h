@@ -7,10 +7,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_paint_list.h"
+#include "flutter/flow/layers/layer_parallel_painter.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_delta.h"
@@ -51,6 +54,7 @@ class LayerTree {
 
   void set_root_layer(std::shared_ptr<Layer> root_layer) {
     root_layer_ = std::move(root_layer);
+    paint_list_.Clear();
   }
 
   const SkISize& frame_size() const { return frame_size_; }
@@ -90,6 +94,38 @@ class LayerTree {
     return enable_leaf_layer_tracing_;
   }
 
+  /// When enabled, `Preroll` compiles the tree into a `LayerPaintList`
+  /// that `Paint` then paints in a single loop instead of recursing into
+  /// the layers. This can be changed from one frame to the next.
+  void enable_paint_list(bool enable) { enable_paint_list_ = enable; }
+
+  bool is_paint_list_enabled() const { return enable_paint_list_; }
+
+  /// When set, `Paint` hands the children of the containers that can be
+  /// painted concurrently to `painter` if the frame is painted into a
+  /// `DisplayListBuilder`. The painter is not used when painting from the
+  /// paint list or when leaf layer tracing is enabled.
+  void set_parallel_painter(std::shared_ptr<LayerParallelPainter> painter) {
+    parallel_painter_ = std::move(painter);
+  }
+
+  // The position, in physical pixels, of the pointer driving a drag as of
+  // the events the framework had seen when it built this tree.
+  void set_built_pointer_position(std::optional<SkPoint> position) {
+    built_pointer_position_ = position;
+  }
+
+  std::optional<SkPoint> built_pointer_position() const {
+    return built_pointer_position_;
+  }
+
+  // Set by the rasterizer to how far that pointer has moved since, in
+  // logical pixels, right before the tree is prerolled. The transform layers
+  // that follow the pointer are moved accordingly.
+  void set_late_latched_pointer_delta(SkPoint delta) {
+    late_latched_pointer_delta_ = delta;
+  }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   SkISize frame_size_ = SkISize::MakeEmpty();  // Physical pixels.
@@ -98,11 +134,18 @@ class LayerTree {
   bool checkerboard_raster_cache_images_;
   bool checkerboard_offscreen_layers_;
   bool enable_leaf_layer_tracing_ = false;
+  bool enable_paint_list_ = false;
+  std::shared_ptr<LayerParallelPainter> parallel_painter_;
+  std::optional<SkPoint> built_pointer_position_;
+  SkPoint late_latched_pointer_delta_ = SkPoint::Make(0, 0);
 
   PaintRegionMap paint_region_map_;
 
   std::vector<RasterCacheItem*> raster_cache_items_;
 
+  // The tree compiled by the last |Preroll| if the paint list is enabled.
+  LayerPaintList paint_list_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
 
@@ -30,11 +30,8 @@ static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
   return SkSurface::MakeRaster(image_info);
 }
 
-/// Returns a buffer containing a snapshot of the surface.
-///
-/// If compressed is true the data is encoded as PNG.
-static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
-                                   bool compressed) {
+static sk_sp<SkImage> MakeRasterImage(
+    const sk_sp<SkSurface>& offscreen_surface) {
   // Prepare an image from the surface, this image may potentially be on th GPU.
   auto potentially_gpu_snapshot = offscreen_surface->makeImageSnapshot();
   if (!potentially_gpu_snapshot) {
@@ -49,6 +46,18 @@ static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
     FML_LOG(ERROR) << "Screenshot: unable to make raster image";
     return nullptr;
   }
+  return cpu_snapshot;
+}
+
+/// Returns a buffer containing a snapshot of the surface.
+///
+/// If compressed is true the data is encoded as PNG.
+static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
+                                   bool compressed) {
+  auto cpu_snapshot = MakeRasterImage(offscreen_surface);
+  if (!cpu_snapshot) {
+    return nullptr;
+  }
 
   // If the caller want the pixels to be compressed, there is a Skia utility to
   // compress to PNG. Use that.
@@ -74,6 +83,10 @@ sk_sp<SkData> OffscreenSurface::GetRasterData(bool compressed) const {
   return flutter::GetRasterData(offscreen_surface_, compressed);
 }
 
+sk_sp<SkImage> OffscreenSurface::MakeRasterImage() const {
+  return flutter::MakeRasterImage(offscreen_surface_);
+}
+
 SkCanvas* OffscreenSurface::GetCanvas() const {
   return offscreen_surface_->getCanvas();
 }
@@ -21,6 +21,9 @@ class OffscreenSurface {
 
   sk_sp<SkData> GetRasterData(bool compressed) const;
 
+  /// Returns a copy of the contents of the surface in CPU memory.
+  sk_sp<SkImage> MakeRasterImage() const;
+
   SkCanvas* GetCanvas() const;
 
   bool IsValid() const;
@@ -20,6 +20,8 @@ OpacityLayer::OpacityLayer(SkAlpha alpha, const SkPoint& offset)
 
 void OpacityLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  // The children are blended with what is painted before them.
+  context->MarkSubtreeTranslucent();
   auto* prev = static_cast<const OpacityLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
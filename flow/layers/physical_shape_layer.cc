@@ -43,6 +43,19 @@ void PhysicalShapeLayer::Diff(DiffContext* context, const Layer* old_layer) {
 
   context->AddLayerBounds(bounds);
 
+  SkRect rect;
+  bool path_is_rect = path_.isRect(&rect);
+  if (path_is_rect && SkColorGetA(color_) == 0xff) {
+    context->AddOpaqueRect(rect);
+  }
+  if (clip_behavior_ != Clip::none &&
+      !(path_is_rect &&
+        IsExactClipRect(context->GetTransform3x3(), rect,
+                        clip_behavior_ != Clip::hardEdge))) {
+    // Opaque content that the clip cuts into does not hide whole pixels.
+    context->MarkSubtreeTranslucent();
+  }
+
   // Only push cull rect if there is clip.
   if (clip_behavior_ == Clip::none || context->PushCullRect(bounds)) {
     DiffChildren(context, prev);
@@ -54,11 +67,55 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context) {
   Layer::AutoPrerollSaveLayerState save =
       Layer::AutoPrerollSaveLayerState::Create(context, UsesSaveLayer());
 
+  SkMatrix matrix = context->state_stack.transform_3x3();
+  SkRect rect;
+  bool path_is_rect = path_.isRect(&rect);
+  bool had_complex_clip = context->has_complex_clip;
+  if (clip_behavior_ != Clip::none &&
+      !(path_is_rect &&
+        IsExactClipRect(matrix, rect, clip_behavior_ != Clip::hardEdge))) {
+    context->has_complex_clip = true;
+  }
+
+  if (elevation_ != 0 && ShadowRasterCacheItem::IsShadowWorthCaching(path_)) {
+    if (!shadow_raster_cache_item_ ||
+        shadow_raster_cache_item_->dpr() != context->frame_device_pixel_ratio) {
+      shadow_raster_cache_item_ = ShadowRasterCacheItem::Make(
+          path_, shadow_color_, elevation_, SkColorGetA(color_) != 0xff,
+          context->frame_device_pixel_ratio);
+    }
+    shadow_raster_cache_item_->PrerollSetup(context, matrix);
+    shadow_raster_cache_item_->PrerollFinalize(context, matrix);
+  }
+
   SkRect child_paint_bounds = SkRect::MakeEmpty();
   PrerollChildren(context, &child_paint_bounds);
+  context->has_complex_clip = had_complex_clip;
   context->renderable_state_flags =
       UsesSaveLayer() ? Layer::kSaveLayerRenderFlags : 0;
 
+  // The children are not clipped to the path in the state stack during
+  // preroll, so their opaque bounds are clipped to it here.
+  SkRect opaque_bounds = children_opaque_bounds();
+  if (clip_behavior_ != Clip::none && !opaque_bounds.isEmpty()) {
+    SkIRect pixels;
+    if (opaque_bounds.intersect(matrix.mapRect(rect))) {
+      opaque_bounds.roundIn(&pixels);
+    } else {
+      pixels.setEmpty();
+    }
+    opaque_bounds = SkRect::Make(pixels);
+  }
+  if (path_is_rect && SkColorGetA(color_) == 0xff) {
+    SkRect shape_bounds = ComputeOpaqueBounds(context, matrix, rect);
+    if (shape_bounds.width() * shape_bounds.height() >
+        opaque_bounds.width() * opaque_bounds.height()) {
+      opaque_bounds = shape_bounds;
+    }
+  }
+  set_opaque_bounds(opaque_bounds.isEmpty() ? SkRect::MakeEmpty()
+                                            : opaque_bounds);
+
   SkRect paint_bounds;
   if (elevation_ == 0) {
     paint_bounds = path_.getBounds();
@@ -80,7 +137,9 @@ void PhysicalShapeLayer::Preroll(PrerollContext* context) {
 void PhysicalShapeLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
-  if (elevation_ != 0) {
+  bool shadow_cached = shadow_raster_cache_item_ &&
+                       shadow_raster_cache_item_->Draw(context, nullptr);
+  if (elevation_ != 0 && !shadow_cached) {
     DisplayListCanvasDispatcher::DrawShadow(
         context.canvas, path_, shadow_color_, elevation_,
         SkColorGetA(color_) != 0xff, context.frame_device_pixel_ratio);
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_FLOW_LAYERS_PHYSICAL_SHAPE_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_PHYSICAL_SHAPE_LAYER_H_
 
+#include <memory>
+
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/shadow_raster_cache_item.h"
 
 namespace flutter {
 
@@ -23,18 +26,30 @@ class PhysicalShapeLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // |ContainerLayer|
+  void CompilePaint(LayerPaintList* list) const override {
+    Layer::CompilePaint(list);
+  }
+
   bool UsesSaveLayer() const {
     return clip_behavior_ == Clip::antiAliasWithSaveLayer;
   }
 
   float elevation() const { return elevation_; }
 
+  const ShadowRasterCacheItem* shadow_raster_cache_item() const {
+    return shadow_raster_cache_item_.get();
+  }
+
  private:
   SkColor color_;
   SkColor shadow_color_;
   float elevation_ = 0.0f;
   SkPath path_;
   Clip clip_behavior_;
+  // Caches the shadow if it is worth caching. Recreated when the device pixel
+  // ratio, which is part of the cache key, changes.
+  std::unique_ptr<ShadowRasterCacheItem> shadow_raster_cache_item_;
 };
 
 }  // namespace flutter
@@ -453,6 +453,81 @@ TEST_F(PhysicalShapeLayerTest, OpacityInheritance) {
   EXPECT_EQ(context->renderable_state_flags, 0);
 }
 
+TEST_F(PhysicalShapeLayerTest, ShadowIsRasterCachedAcrossLayers) {
+  SkPath layer_path;
+  layer_path.moveTo(10, 10).lineTo(60, 10).lineTo(35, 50).close();
+  auto make_layer = [&layer_path]() {
+    return std::make_shared<PhysicalShapeLayer>(SK_ColorGREEN, SK_ColorBLACK,
+                                                4.0f,  // elevation
+                                                layer_path, Clip::none);
+  };
+
+  use_mock_raster_cache();
+  preroll_context()->state_stack.set_preroll_delegate(
+      SkRect::MakeLTRB(0, 0, 200, 200));
+  int access_threshold = preroll_context()->raster_cache->access_threshold();
+  for (int i = 0; i <= access_threshold; i++) {
+    // Each frame has a new layer, which still finds the shadow of the layers
+    // of the previous frames.
+    auto layer = make_layer();
+    preroll_context()->raster_cached_entries->clear();
+    layer->Preroll(preroll_context());
+    auto* raster_cache_item = layer->shadow_raster_cache_item();
+    ASSERT_NE(raster_cache_item, nullptr);
+    ASSERT_EQ(preroll_context()->raster_cached_entries->size(), size_t(1));
+    ASSERT_EQ(preroll_context()->raster_cache->GetAccessCount(
+                  raster_cache_item->GetId().value(), SkMatrix::I()),
+              i + 1);
+    if (i < access_threshold) {
+      ASSERT_EQ(raster_cache_item->cache_state(), RasterCacheItem::kNone);
+      ASSERT_FALSE(raster_cache_item->TryToPrepareRasterCache(paint_context()));
+    } else {
+      ASSERT_EQ(raster_cache_item->cache_state(), RasterCacheItem::kCurrent);
+      ASSERT_TRUE(raster_cache_item->TryToPrepareRasterCache(paint_context()));
+      ASSERT_TRUE(raster_cache_item->Draw(paint_context(), nullptr));
+    }
+  }
+}
+
+TEST_F(PhysicalShapeLayerTest, AnalyticShadowIsNotRasterCached) {
+  SkPath layer_path;
+  layer_path.addRRect(SkRRect::MakeRectXY(SkRect::MakeWH(50, 20), 10, 10));
+  auto layer =
+      std::make_shared<PhysicalShapeLayer>(SK_ColorGREEN, SK_ColorBLACK,
+                                           4.0f,  // elevation
+                                           layer_path, Clip::none);
+
+  use_mock_raster_cache();
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(layer->shadow_raster_cache_item(), nullptr);
+  EXPECT_TRUE(preroll_context()->raster_cached_entries->empty());
+}
+
+TEST(ShadowRasterCacheItemTest, ShadowIdDependsOnShadow) {
+  SkPath path = SkPath().moveTo(0, 0).lineTo(10, 0).lineTo(5, 8).close();
+  SkPath other_path = SkPath().moveTo(0, 0).lineTo(10, 0).lineTo(5, 9).close();
+  uint64_t id = ShadowRasterCacheItem::ComputeShadowId(path, SK_ColorBLACK,
+                                                       4.0f, false, 2.0f);
+  EXPECT_EQ(ShadowRasterCacheItem::ComputeShadowId(SkPath(path), SK_ColorBLACK,
+                                                   4.0f, false, 2.0f),
+            id);
+  EXPECT_NE(ShadowRasterCacheItem::ComputeShadowId(other_path, SK_ColorBLACK,
+                                                   4.0f, false, 2.0f),
+            id);
+  EXPECT_NE(ShadowRasterCacheItem::ComputeShadowId(path, SK_ColorRED, 4.0f,
+                                                   false, 2.0f),
+            id);
+  EXPECT_NE(ShadowRasterCacheItem::ComputeShadowId(path, SK_ColorBLACK, 8.0f,
+                                                   false, 2.0f),
+            id);
+  EXPECT_NE(ShadowRasterCacheItem::ComputeShadowId(path, SK_ColorBLACK, 4.0f,
+                                                   true, 2.0f),
+            id);
+  EXPECT_NE(ShadowRasterCacheItem::ComputeShadowId(path, SK_ColorBLACK, 4.0f,
+                                                   false, 3.0f),
+            id);
+}
+
 using PhysicalShapeLayerDiffTest = DiffContextTest;
 
 TEST_F(PhysicalShapeLayerDiffTest, NoClipPaintRegion) {
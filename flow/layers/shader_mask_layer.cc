@@ -18,6 +18,8 @@ ShaderMaskLayer::ShaderMaskLayer(std::shared_ptr<DlColorSource> color_source,
 
 void ShaderMaskLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  // The mask may make the opaque pixels of the children translucent.
+  context->MarkSubtreeTranslucent();
   auto* prev = static_cast<const ShaderMaskLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
@@ -0,0 +1,157 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/shadow_raster_cache_item.h"
+
+#include <string_view>
+#include <vector>
+
+#include "flutter/display_list/display_list_canvas_dispatcher.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/raster_cache_key.h"
+#include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/hash_combine.h"
+
+namespace flutter {
+
+ShadowRasterCacheItem::ShadowRasterCacheItem(const SkPath& path,
+                                             SkColor color,
+                                             float elevation,
+                                             bool transparent_occluder,
+                                             SkScalar dpr)
+    : RasterCacheItem(
+          RasterCacheKeyID(ComputeShadowId(path, color, elevation,
+                                           transparent_occluder, dpr),
+                           RasterCacheKeyType::kShadow),
+          CacheState::kCurrent),
+      path_(path),
+      color_(color),
+      elevation_(elevation),
+      transparent_occluder_(transparent_occluder),
+      dpr_(dpr) {}
+
+std::unique_ptr<ShadowRasterCacheItem> ShadowRasterCacheItem::Make(
+    const SkPath& path,
+    SkColor color,
+    float elevation,
+    bool transparent_occluder,
+    SkScalar dpr) {
+  return std::make_unique<ShadowRasterCacheItem>(path, color, elevation,
+                                                 transparent_occluder, dpr);
+}
+
+bool ShadowRasterCacheItem::IsShadowWorthCaching(const SkPath& path) {
+  return !path.isRect(nullptr) && !path.isRRect(nullptr) &&
+         !path.isOval(nullptr) && !path.isEmpty();
+}
+
+uint64_t ShadowRasterCacheItem::ComputeShadowId(const SkPath& path,
+                                                SkColor color,
+                                                float elevation,
+                                                bool transparent_occluder,
+                                                SkScalar dpr) {
+  std::vector<char> path_data(path.writeToMemory(nullptr));
+  path.writeToMemory(path_data.data());
+  return fml::HashCombine(
+      std::string_view(path_data.data(), path_data.size()), color, elevation,
+      transparent_occluder, dpr);
+}
+
+void ShadowRasterCacheItem::PrerollSetup(PrerollContext* context,
+                                         const SkMatrix& matrix) {
+  cache_state_ = CacheState::kNone;
+  if (!context->raster_cache || !context->raster_cached_entries) {
+    return;
+  }
+  bounds_ = DisplayListCanvasDispatcher::ComputeShadowBounds(
+      path_, elevation_, dpr_, matrix);
+  if (!RasterCacheUtil::CanRasterizeRect(bounds_) || !matrix.invert(nullptr)) {
+    return;
+  }
+  transformation_matrix_ = matrix;
+  context->raster_cached_entries->push_back(this);
+  cache_state_ = CacheState::kCurrent;
+}
+
+void ShadowRasterCacheItem::PrerollFinalize(PrerollContext* context,
+                                            const SkMatrix& matrix) {
+  if (cache_state_ == CacheState::kNone || !context->raster_cache ||
+      !context->raster_cached_entries) {
+    return;
+  }
+  auto* raster_cache = context->raster_cache;
+  bool visible = !context->state_stack.content_culled(bounds_);
+  int accesses = raster_cache->MarkSeen(key_id_, matrix, visible);
+  preroll_matrix_ = matrix;
+  if (!visible || accesses <= raster_cache->access_threshold()) {
+    cache_state_ = kNone;
+  } else {
+    cache_state_ = kCurrent;
+  }
+}
+
+bool ShadowRasterCacheItem::CanReusePreroll() const {
+  return cache_state_ == CacheState::kCurrent;
+}
+
+void ShadowRasterCacheItem::ReusePreroll(PrerollContext* context) {
+  if (!context->raster_cache || !context->raster_cached_entries) {
+    return;
+  }
+  context->raster_cached_entries->push_back(this);
+  context->raster_cache->MarkSeen(key_id_, preroll_matrix_, true);
+}
+
+bool ShadowRasterCacheItem::Draw(const PaintContext& context,
+                                 const SkPaint* paint) const {
+  if (context.builder) {
+    if (!context.raster_cache || cache_state_ != CacheState::kCurrent) {
+      return false;
+    }
+    return context.raster_cache->Draw(key_id_, *context.builder, paint);
+  }
+  return Draw(context, context.canvas, paint);
+}
+
+bool ShadowRasterCacheItem::Draw(const PaintContext& context,
+                                 SkCanvas* canvas,
+                                 const SkPaint* paint) const {
+  if (!context.raster_cache || !canvas ||
+      cache_state_ != CacheState::kCurrent) {
+    return false;
+  }
+  return context.raster_cache->Draw(key_id_, *canvas, paint);
+}
+
+static const auto* flow_type = "RasterCacheFlow::Shadow";
+
+bool ShadowRasterCacheItem::TryToPrepareRasterCache(const PaintContext& context,
+                                                    bool parent_cached) const {
+  // A cached ancestor already contains the shadow.
+  if (cache_state_ == kNone || !context.raster_cache || parent_cached) {
+    return false;
+  }
+  RasterCache::Context r_context = {
+      // clang-format off
+      .gr_context                = context.gr_context,
+      .dst_color_space           = context.dst_color_space,
+      .matrix                    = transformation_matrix_,
+      .logical_rect              = bounds_,
+      .flow_type                 = flow_type,
+      .aiks_context              = context.aiks_context,
+      .allow_async_rasterization = true,
+      // clang-format on
+  };
+  return context.raster_cache->UpdateCacheEntry(
+      GetId().value(), r_context,
+      [path = path_, color = color_, elevation = elevation_,
+       transparent_occluder = transparent_occluder_,
+       dpr = dpr_](SkCanvas* canvas) {
+        DisplayListCanvasDispatcher::DrawShadow(canvas, path, color, elevation,
+                                                transparent_occluder, dpr);
+      });
+}
+
+}  // namespace flutter
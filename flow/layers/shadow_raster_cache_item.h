@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_SHADOW_RASTER_CACHE_ITEM_H_
+#define FLUTTER_FLOW_LAYERS_SHADOW_RASTER_CACHE_ITEM_H_
+
+#include <memory>
+
+#include "flutter/flow/raster_cache_item.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+
+namespace flutter {
+
+// Caches the elevation shadow of a |PhysicalShapeLayer|.
+//
+// The shadow is lit by a directional light, so it only depends on the path,
+// the shadow parameters and the transform without its translation. The key of
+// the cache entry is computed from them instead of from the layer, so layers
+// that draw the same shadow share the entry, also across frames.
+class ShadowRasterCacheItem : public RasterCacheItem {
+ public:
+  ShadowRasterCacheItem(const SkPath& path,
+                        SkColor color,
+                        float elevation,
+                        bool transparent_occluder,
+                        SkScalar dpr);
+
+  static std::unique_ptr<ShadowRasterCacheItem> Make(const SkPath& path,
+                                                     SkColor color,
+                                                     float elevation,
+                                                     bool transparent_occluder,
+                                                     SkScalar dpr);
+
+  // Whether the shadow of |path| is worth caching.
+  //
+  // The shadows of rects, rounded rects and ovals are drawn analytically,
+  // which costs less than drawing the cached image of the shadow and does not
+  // use any memory.
+  static bool IsShadowWorthCaching(const SkPath& path);
+
+  // The id of the shadow in the raster cache. Equal shadows have the same id.
+  static uint64_t ComputeShadowId(const SkPath& path,
+                                  SkColor color,
+                                  float elevation,
+                                  bool transparent_occluder,
+                                  SkScalar dpr);
+
+  void PrerollSetup(PrerollContext* context, const SkMatrix& matrix) override;
+
+  void PrerollFinalize(PrerollContext* context,
+                       const SkMatrix& matrix) override;
+
+  bool Draw(const PaintContext& context, const SkPaint* paint) const override;
+
+  bool Draw(const PaintContext& context,
+            SkCanvas* canvas,
+            const SkPaint* paint) const override;
+
+  bool TryToPrepareRasterCache(const PaintContext& context,
+                               bool parent_cached = false) const override;
+
+  bool CanReusePreroll() const override;
+
+  void ReusePreroll(PrerollContext* context) override;
+
+  SkScalar dpr() const { return dpr_; }
+
+ private:
+  const SkPath path_;
+  const SkColor color_;
+  const float elevation_;
+  const bool transparent_occluder_;
+  const SkScalar dpr_;
+  SkMatrix transformation_matrix_;
+  // The matrix that the last |PrerollFinalize| marked the entry seen with.
+  SkMatrix preroll_matrix_;
+  // The local bounds of the shadow, computed in |PrerollSetup|.
+  SkRect bounds_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_SHADOW_RASTER_CACHE_ITEM_H_
@@ -24,6 +24,7 @@ TransformLayer::TransformLayer(const SkMatrix& transform)
     FML_LOG(ERROR) << "TransformLayer is constructed with an invalid matrix.";
     transform_.setIdentity();
   }
+  built_transform_ = transform_;
 }
 
 void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
@@ -31,7 +32,7 @@ void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
   auto* prev = static_cast<const TransformLayer*>(old_layer);
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(prev);
-    if (transform_ != prev->transform_) {
+    if (transform_ != prev->transform_ || !pointer_delta_scale_.isZero()) {
       context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
     }
   }
@@ -41,6 +42,14 @@ void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
 }
 
 void TransformLayer::Preroll(PrerollContext* context) {
+  if (!pointer_delta_scale_.isZero()) {
+    const SkPoint& delta = context->late_latched_pointer_delta;
+    transform_ = SkMatrix::Concat(
+        SkMatrix::Translate(pointer_delta_scale_.x() * delta.x(),
+                            pointer_delta_scale_.y() * delta.y()),
+        built_transform_);
+  }
+
   auto mutator = context->state_stack.save();
   mutator.transform(transform_);
 
@@ -49,6 +58,7 @@ void TransformLayer::Preroll(PrerollContext* context) {
 
   transform_.mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(children_opaque_bounds());
 }
 
 void TransformLayer::Paint(PaintContext& context) const {
@@ -60,4 +70,11 @@ void TransformLayer::Paint(PaintContext& context) const {
   PaintChildren(context);
 }
 
+void TransformLayer::CompilePaint(LayerPaintList* list) const {
+  list->BeginLayer(this);
+  list->Transform(transform_);
+  CompilePaintChildren(list);
+  list->EndLayer();
+}
+
 }  // namespace flutter
@@ -21,8 +21,24 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  void CompilePaint(LayerPaintList* list) const override;
+
+  // Makes this layer follow the pointer that drives a drag when the frame is
+  // rasterized later than the pointer moved. The layer is translated in its
+  // parent's coordinates by |scale| times the distance the pointer has moved
+  // since the framework built the frame. A scrollable that follows the
+  // pointer along one axis would use a scale of (0, 1) or (1, 0).
+  void set_pointer_delta_scale(const SkPoint& scale) {
+    pointer_delta_scale_ = scale;
+  }
+
  private:
+  // The transform the layer was built with.
+  SkMatrix built_transform_;
+  // The transform the layer is painted with, which includes the pointer delta
+  // latched by the last |Preroll|.
   SkMatrix transform_;
+  SkPoint pointer_delta_scale_ = SkPoint::Make(0, 0);
 
   FML_DISALLOW_COPY_AND_ASSIGN(TransformLayer);
 };
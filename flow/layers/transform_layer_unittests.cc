@@ -106,6 +106,30 @@ TEST_F(TransformLayerTest, Simple) {
                    MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}}));
 }
 
+TEST_F(TransformLayerTest, LateLatchedPointerDelta) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkMatrix layer_transform = SkMatrix::Translate(2.5f, 2.5f);
+
+  auto mock_layer = std::make_shared<MockLayer>(child_path, SkPaint());
+  auto layer = std::make_shared<TransformLayer>(layer_transform);
+  layer->set_pointer_delta_scale(SkPoint::Make(0, -1));
+  layer->Add(mock_layer);
+
+  preroll_context()->state_stack.set_preroll_delegate(kGiantRect);
+  preroll_context()->late_latched_pointer_delta = SkPoint::Make(3, 4);
+  layer->Preroll(preroll_context());
+  SkMatrix latched_transform = SkMatrix::Translate(2.5f, -1.5f);
+  EXPECT_EQ(mock_layer->parent_matrix(), latched_transform);
+  EXPECT_EQ(layer->paint_bounds(),
+            latched_transform.mapRect(mock_layer->paint_bounds()));
+
+  // The delta doesn't accumulate from one frame to the next.
+  preroll_context()->late_latched_pointer_delta = SkPoint::Make(0, 0);
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(mock_layer->parent_matrix(), layer_transform);
+}
+
 TEST_F(TransformLayerTest, Nested) {
   SkPath child_path;
   child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
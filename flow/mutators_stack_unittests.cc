@@ -43,6 +43,48 @@ TEST(MutatorsStack, CopyAndUpdateTheCopy) {
   ASSERT_TRUE(iter->get()->GetRect() == rect);
 }
 
+TEST(MutatorsStack, CopiesShareMutatorsUntilUpdated) {
+  MutatorsStack stack;
+  stack.PushClipRect(SkRect::MakeWH(10, 10));
+  stack.PushTransform(SkMatrix::Translate(1, 1));
+  MutatorsStack copy = stack;
+  ASSERT_TRUE(copy.shares_mutators_with(stack));
+
+  copy.PushOpacity(128);
+  ASSERT_FALSE(copy.shares_mutators_with(stack));
+  ASSERT_EQ(stack.stack_count(), 2u);
+  ASSERT_EQ(copy.stack_count(), 3u);
+  // The copy holds the same mutators as the stack it was copied from.
+  ASSERT_EQ(copy.Begin()->get(), stack.Begin()->get());
+
+  copy.Pop();
+  ASSERT_TRUE(copy == stack);
+  ASSERT_FALSE(copy.shares_mutators_with(stack));
+}
+
+TEST(MutatorsStack, PushSharedMutator) {
+  auto mutator = std::make_shared<Mutator>(SkRect::MakeWH(10, 10));
+  MutatorsStack stack;
+  stack.Push(mutator);
+  MutatorsStack other;
+  other.Push(mutator);
+  ASSERT_TRUE(stack == other);
+  ASSERT_EQ(stack.Begin()->get(), mutator.get());
+  ASSERT_EQ(other.Begin()->get(), mutator.get());
+}
+
+TEST(MutatorsStack, PopToSharedStack) {
+  MutatorsStack stack;
+  stack.PushClipRect(SkRect::MakeWH(10, 10));
+  stack.PushTransform(SkMatrix::Translate(1, 1));
+  stack.PushOpacity(128);
+  MutatorsStack copy = stack;
+  copy.PopTo(1);
+  ASSERT_EQ(copy.stack_count(), 1u);
+  ASSERT_EQ(stack.stack_count(), 3u);
+  ASSERT_EQ(copy.Bottom()->get()->GetType(), MutatorType::kClipRect);
+}
+
 TEST(MutatorsStack, PushClipRect) {
   MutatorsStack stack;
   auto rect = SkRect::MakeEmpty();
@@ -14,4 +14,16 @@ SkRect PaintRegion::ComputeBounds() const {
   return res;
 }
 
+std::vector<PaintRegion::Occluder> PaintRegion::GetOccluders() const {
+  std::vector<Occluder> res;
+  if (occluders_) {
+    for (const auto& occluder : *occluders_) {
+      if (occluder.position > from_ && occluder.position <= to_) {
+        res.push_back({occluder.position - from_, occluder.rect});
+      }
+    }
+  }
+  return res;
+}
+
 }  // namespace flutter
@@ -21,17 +21,28 @@ namespace flutter {
 // All rects are in screen coordinates.
 class PaintRegion {
  public:
+  // A rect that a layer of the subtree covers with opaque pixels, which
+  // hides everything painted before the layer inside of it. |position| is
+  // the index, in the shared vector of rects, right after the rects of
+  // that layer.
+  struct Occluder {
+    size_t position;
+    SkRect rect;
+  };
+
   PaintRegion() = default;
   PaintRegion(std::shared_ptr<std::vector<SkRect>> rects,
               size_t from,
               size_t to,
               bool has_readback,
-              bool has_texture)
+              bool has_texture,
+              std::shared_ptr<std::vector<Occluder>> occluders = nullptr)
       : rects_(rects),
         from_(from),
         to_(to),
         has_readback_(has_readback),
-        has_texture_(has_texture) {}
+        has_texture_(has_texture),
+        occluders_(occluders) {}
 
   std::vector<SkRect>::const_iterator begin() const {
     FML_DCHECK(is_valid());
@@ -56,12 +67,17 @@ class PaintRegion {
   // region.
   bool has_texture() const { return has_texture_; }
 
+  // Returns the occluders of the layers in this region, with positions
+  // relative to the first rect of the region.
+  std::vector<Occluder> GetOccluders() const;
+
  private:
   std::shared_ptr<std::vector<SkRect>> rects_;
   size_t from_ = 0;
   size_t to_ = 0;
   bool has_readback_ = false;
   bool has_texture_ = false;
+  std::shared_ptr<std::vector<Occluder>> occluders_;
 };
 
 }  // namespace flutter
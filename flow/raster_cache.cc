@@ -4,10 +4,12 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/display_list_builder.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -21,6 +23,10 @@
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/flow/raster_cache_impeller.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 RasterCacheResult::RasterCacheResult(sk_sp<SkImage> image,
@@ -29,24 +35,101 @@ RasterCacheResult::RasterCacheResult(sk_sp<SkImage> image,
     : image_(std::move(image)), logical_rect_(logical_rect), flow_(type) {}
 
 void RasterCacheResult::draw(SkCanvas& canvas, const SkPaint* paint) const {
+  DrawImage(canvas, image_, paint);
+}
+
+void RasterCacheResult::DrawImage(SkCanvas& canvas,
+                                  const sk_sp<SkImage>& image,
+                                  const SkPaint* paint) const {
   SkAutoCanvasRestore auto_restore(&canvas, true);
 
   auto matrix = RasterCacheUtil::GetIntegralTransCTM(canvas.getTotalMatrix());
   SkRect bounds =
       RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect_, matrix);
-  FML_DCHECK(std::abs(bounds.width() - image_->dimensions().width()) <= 1 &&
-             std::abs(bounds.height() - image_->dimensions().height()) <= 1);
+  FML_DCHECK(std::abs(bounds.width() - image->dimensions().width()) <= 1 &&
+             std::abs(bounds.height() - image->dimensions().height()) <= 1);
   canvas.resetMatrix();
   flow_.Step();
-  canvas.drawImage(image_, bounds.fLeft, bounds.fTop, SkSamplingOptions(),
+  canvas.drawImage(image, bounds.fLeft, bounds.fTop, SkSamplingOptions(),
                    paint);
 }
 
+void RasterCacheResult::draw(DisplayListBuilder& builder,
+                             const SkPaint* paint) const {
+  DrawImage(builder, DlImage::Make(image_), paint);
+}
+
+void RasterCacheResult::DrawImage(DisplayListBuilder& builder,
+                                  const sk_sp<DlImage>& image,
+                                  const SkPaint* paint) const {
+  builder.save();
+
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(builder.getTransform());
+  SkRect bounds =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect_, matrix);
+  FML_DCHECK(std::abs(bounds.width() - image->dimensions().width()) <= 1 &&
+             std::abs(bounds.height() - image->dimensions().height()) <= 1);
+  builder.transformReset();
+  flow_.Step();
+  if (paint) {
+    builder.setAttributesFromPaint(
+        *paint, DisplayListOpFlags::kDrawImageWithPaintFlags);
+  }
+  builder.drawImage(image, SkPoint::Make(bounds.fLeft, bounds.fTop),
+                    DlImageSampling::kNearestNeighbor, paint != nullptr);
+
+  builder.restore();
+}
+
+namespace {
+
+// A raster cache entry rendered by a |RasterCacheAsyncRasterizer|, whose
+// image may belong to another GrDirectContext and is released on the
+// thread of that context.
+class AsyncRasterCacheResult final : public RasterCacheResult {
+ public:
+  AsyncRasterCacheResult(SkiaGPUObject<SkImage> image,
+                         const SkRect& logical_rect,
+                         const char* type)
+      : RasterCacheResult(nullptr, logical_rect, type),
+        image_(std::move(image)) {}
+
+  // |RasterCacheResult|
+  void draw(SkCanvas& canvas, const SkPaint* paint) const override {
+    DrawImage(canvas, image_.skia_object(), paint);
+  }
+
+  // |RasterCacheResult|
+  void draw(DisplayListBuilder& builder, const SkPaint* paint) const override {
+    DrawImage(builder, DlImage::Make(image_.skia_object()), paint);
+  }
+
+  // |RasterCacheResult|
+  SkISize image_dimensions() const override {
+    return image_.skia_object()->dimensions();
+  }
+
+  // |RasterCacheResult|
+  int64_t image_bytes() const override {
+    return image_.skia_object()->imageInfo().computeMinByteSize();
+  }
+
+ private:
+  SkiaGPUObject<SkImage> image_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncRasterCacheResult);
+};
+
+}  // namespace
+
 RasterCache::RasterCache(size_t access_threshold,
-                         size_t display_list_cache_limit_per_frame)
+                         size_t display_list_cache_limit_per_frame,
+                         size_t max_unused_frames)
     : access_threshold_(access_threshold),
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
-      checkerboard_images_(false) {}
+      max_unused_frames_(max_unused_frames),
+      checkerboard_images_(false),
+      generation_(std::make_shared<size_t>(0)) {}
 
 /// @note Procedure doesn't copy all closures.
 std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
@@ -58,6 +141,26 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (context.aiks_context) {
+    return ImpellerRasterCacheResult::Rasterize(
+        *context.aiks_context,
+        SkISize::Make(dest_rect.width(), dest_rect.height()),
+        context.logical_rect, context.flow_type, [&](SkCanvas* canvas) {
+          canvas->translate(-dest_rect.left(), -dest_rect.top());
+          canvas->concat(matrix);
+          draw_function(canvas);
+          if (checkerboard_images_) {
+            draw_checkerboard(canvas, context.logical_rect);
+          }
+        });
+  }
+#else   // IMPELLER_SUPPORTS_RENDERING
+  if (context.aiks_context) {
+    return nullptr;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   const SkImageInfo image_info =
       SkImageInfo::MakeN32Premul(dest_rect.width(), dest_rect.height(),
                                  sk_ref_sp(context.dst_color_space));
@@ -92,10 +195,38 @@ bool RasterCache::UpdateCacheEntry(
     const std::function<void(SkCanvas*)>& render_function) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
+  if (entry.rasterizing) {
+    // The image will be swapped in when it is ready. Until then, the entry
+    // is drawn uncached.
+    return false;
+  }
   if (!entry.image) {
+    entry.complexity_score = raster_cache_context.complexity_score;
+    if (max_bytes_ != std::numeric_limits<size_t>::max()) {
+      // Make room for the image before rasterizing it, so that none of the
+      // work is done for an image that would not be admitted.
+      SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+          raster_cache_context.logical_rect,
+          RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix));
+      size_t bytes = static_cast<size_t>(dest_rect.width()) *
+                     static_cast<size_t>(dest_rect.height()) * 4;
+      if (bytes > max_bytes_ ||
+          !EvictToFit(max_bytes_ - bytes, ComputePriority(entry, bytes))) {
+        return false;
+      }
+    }
+    if (async_rasterizer_ && raster_cache_context.allow_async_rasterization &&
+        !raster_cache_context.aiks_context) {
+      RasterizeAsync(key, entry, raster_cache_context, render_function);
+      if (id.type() == RasterCacheKeyType::kDisplayList) {
+        display_list_cached_this_frame_++;
+      }
+      return false;
+    }
     void (*func)(SkCanvas*, const SkRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, render_function, func);
     if (entry.image != nullptr) {
+      entry.priority = ComputePriority(entry, entry.image->image_bytes());
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -110,6 +241,72 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+void RasterCache::RasterizeAsync(
+    const RasterCacheKey& key,
+    Entry& entry,
+    const Context& context,
+    const std::function<void(SkCanvas*)>& draw_function) const {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  const SkImageInfo image_info =
+      SkImageInfo::MakeN32Premul(dest_rect.width(), dest_rect.height(),
+                                 sk_ref_sp(context.dst_color_space));
+
+  entry.rasterizing = true;
+  async_rasterizer_->Rasterize(
+      image_info,
+      [draw_function, matrix, dest_rect, logical_rect = context.logical_rect,
+       checkerboard = checkerboard_images_](SkCanvas* canvas) {
+        canvas->clear(SK_ColorTRANSPARENT);
+        canvas->translate(-dest_rect.left(), -dest_rect.top());
+        canvas->concat(matrix);
+        draw_function(canvas);
+        if (checkerboard) {
+          DrawCheckerboard(canvas, logical_rect);
+        }
+      },
+      [this, key, weak_generation = std::weak_ptr<size_t>(generation_),
+       generation = *generation_, logical_rect = context.logical_rect,
+       flow_type = context.flow_type](SkiaGPUObject<SkImage> image) {
+        auto current_generation = weak_generation.lock();
+        if (!current_generation || *current_generation != generation) {
+          return;
+        }
+        OnAsyncRasterizationComplete(key, std::move(image), logical_rect,
+                                     flow_type);
+      });
+}
+
+void RasterCache::OnAsyncRasterizationComplete(const RasterCacheKey& key,
+                                               SkiaGPUObject<SkImage> image,
+                                               const SkRect& logical_rect,
+                                               const char* flow_type) const {
+  auto it = cache_.find(key);
+  if (it == cache_.end() || !it->second.rasterizing) {
+    // The entry was evicted while its image was being rendered.
+    return;
+  }
+  Entry& entry = it->second;
+  entry.rasterizing = false;
+  if (!image.skia_object()) {
+    return;
+  }
+
+  auto result = std::make_unique<AsyncRasterCacheResult>(
+      std::move(image), logical_rect, flow_type);
+  size_t bytes = result->image_bytes();
+  if (max_bytes_ != std::numeric_limits<size_t>::max()) {
+    // Other images may have taken the room that was made for this one.
+    if (bytes > max_bytes_ ||
+        !EvictToFit(max_bytes_ - bytes, ComputePriority(entry, bytes))) {
+      return;
+    }
+  }
+  entry.image = std::move(result);
+  entry.priority = ComputePriority(entry, bytes);
+}
+
 int RasterCache::MarkSeen(const RasterCacheKeyID& id,
                           const SkMatrix& matrix,
                           bool visible) const {
@@ -120,6 +317,9 @@ int RasterCache::MarkSeen(const RasterCacheKeyID& id,
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
+  if (entry.image) {
+    entry.priority = ComputePriority(entry, entry.image->image_bytes());
+  }
   return entry.accesses_since_visible;
 }
 
@@ -152,7 +352,7 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   Entry& entry = it->second;
 
-  if (entry.image) {
+  if (entry.image && entry.image->can_draw_to_canvas()) {
     entry.image->draw(canvas, paint);
     return true;
   }
@@ -160,8 +360,27 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
   return false;
 }
 
-void RasterCache::BeginFrame() {
+bool RasterCache::Draw(const RasterCacheKeyID& id,
+                       DisplayListBuilder& builder,
+                       const SkPaint* paint) const {
+  auto it = cache_.find(RasterCacheKey(id, builder.getTransform()));
+  if (it == cache_.end()) {
+    return false;
+  }
+
+  Entry& entry = it->second;
+
+  if (entry.image) {
+    entry.image->draw(builder, paint);
+    return true;
+  }
+
+  return false;
+}
+
+void RasterCache::BeginFrame(size_t view_count) {
   display_list_cached_this_frame_ = 0;
+  views_left_to_evict_ = view_count;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -169,7 +388,6 @@ void RasterCache::BeginFrame() {
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.in_use_count++;
@@ -180,23 +398,102 @@ void RasterCache::UpdateMetrics() {
 }
 
 void RasterCache::EvictUnusedCacheEntries() {
+  if (views_left_to_evict_ > 1u) {
+    // The entries the views painted later in the frame encounter aren't
+    // marked yet.
+    views_left_to_evict_--;
+    return;
+  }
+  views_left_to_evict_ = 0u;
+
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (entry.encountered_this_frame) {
+      entry.unused_frames = 0;
+    } else if (entry.image && entry.unused_frames < max_unused_frames_) {
+      // Keep the image for a few frames in case the content comes back
+      // into view, e.g. while scrolling back and forth.
+      entry.unused_frames++;
+    } else {
       dead.push_back(it);
     }
   }
 
   for (auto it : dead) {
     if (it->second.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.eviction_count++;
-      metrics.eviction_bytes += it->second.image->image_bytes();
+      EvictImage(it);
     }
     cache_.erase(it);
   }
+
+  // The byte budget may have been lowered since the last frame.
+  EvictToFit(max_bytes_, std::numeric_limits<double>::infinity());
+}
+
+double RasterCache::ComputePriority(const Entry& entry, size_t bytes) const {
+  // Entries whose cost is not known, such as layers, are assumed to cost
+  // one unit of complexity, about 5ns, for each byte of their image.
+  double cost_per_byte =
+      entry.complexity_score > 0 && bytes > 0
+          ? static_cast<double>(entry.complexity_score) / bytes
+          : 1.0;
+  return priority_floor_ + entry.accesses_since_visible * cost_per_byte;
+}
+
+size_t RasterCache::GetCachedBytes() const {
+  size_t bytes = 0;
+  for (const auto& item : cache_) {
+    if (item.second.image) {
+      bytes += item.second.image->image_bytes();
+    }
+  }
+  return bytes;
+}
+
+bool RasterCache::EvictToFit(size_t max_bytes, double max_priority) const {
+  size_t bytes = GetCachedBytes();
+  if (bytes <= max_bytes) {
+    return true;
+  }
+
+  std::vector<RasterCacheKey::Map<Entry>::iterator> candidates;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (it->second.image && it->second.priority < max_priority) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) {
+              return a->second.priority < b->second.priority;
+            });
+
+  size_t victims = 0;
+  size_t remaining = bytes;
+  while (remaining > max_bytes && victims < candidates.size()) {
+    remaining -= candidates[victims]->second.image->image_bytes();
+    victims++;
+  }
+  if (remaining > max_bytes) {
+    return false;
+  }
+
+  for (size_t i = 0; i < victims; i++) {
+    priority_floor_ =
+        std::max(priority_floor_, candidates[i]->second.priority);
+    EvictImage(candidates[i]);
+  }
+  return true;
+}
+
+void RasterCache::EvictImage(RasterCacheKey::Map<Entry>::iterator it) const {
+  RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+  metrics.eviction_count++;
+  metrics.eviction_bytes += it->second.image->image_bytes();
+  // The entry itself is kept, along with its access count, until a frame
+  // does not encounter it.
+  it->second.image.reset();
 }
 
 void RasterCache::EndFrame() {
@@ -206,6 +503,8 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  priority_floor_ = 0.0;
+  (*generation_)++;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -281,7 +580,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
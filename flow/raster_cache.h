@@ -5,13 +5,17 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_complexity.h"
+#include "flutter/display_list/display_list_image.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/flow/skia_gpu_object.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/trace_event.h"
@@ -23,8 +27,14 @@
 
 class SkColorSpace;
 
+namespace impeller {
+class AiksContext;
+}  // namespace impeller
+
 namespace flutter {
 
+class DisplayListBuilder;
+
 enum class RasterCacheLayerStrategy { kLayer, kLayerChildren };
 
 class RasterCacheResult {
@@ -37,6 +47,14 @@ class RasterCacheResult {
 
   virtual void draw(SkCanvas& canvas, const SkPaint* paint) const;
 
+  // Draws the cached image into |builder| at the integral device position
+  // of its logical rect, as |draw| does for a canvas.
+  virtual void draw(DisplayListBuilder& builder, const SkPaint* paint) const;
+
+  // Whether the result can be drawn to an SkCanvas. Results rasterized by
+  // Impeller hold a texture that only a DisplayListBuilder can draw.
+  virtual bool can_draw_to_canvas() const { return true; }
+
   virtual SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -45,12 +63,41 @@ class RasterCacheResult {
     return image_ ? image_->imageInfo().computeMinByteSize() : 0;
   };
 
+ protected:
+  void DrawImage(SkCanvas& canvas,
+                 const sk_sp<SkImage>& image,
+                 const SkPaint* paint) const;
+
+  void DrawImage(DisplayListBuilder& builder,
+                 const sk_sp<DlImage>& image,
+                 const SkPaint* paint) const;
+
  private:
   sk_sp<SkImage> image_;
   SkRect logical_rect_;
   fml::tracing::TraceFlow flow_;
 };
 
+// Renders raster cache entries away from the raster thread, e.g. with the
+// resource context on the IO thread, so that the frame in which content
+// crosses the access threshold does not also pay for rendering it
+// offscreen.
+class RasterCacheAsyncRasterizer {
+ public:
+  using DrawFunction = std::function<void(SkCanvas*)>;
+  using Callback = std::function<void(SkiaGPUObject<SkImage> image)>;
+
+  virtual ~RasterCacheAsyncRasterizer() = default;
+
+  // Calls |draw_function| on another thread with the canvas of a surface
+  // of |image_info|, and then calls |callback| on the raster thread with a
+  // snapshot of the surface, or with an empty object if the surface could
+  // not be created.
+  virtual void Rasterize(const SkImageInfo& image_info,
+                         DrawFunction draw_function,
+                         Callback callback) = 0;
+};
+
 class Layer;
 class RasterCacheItem;
 struct PrerollContext;
@@ -103,7 +150,9 @@ struct RasterCacheMetrics {
  *         encountered by the current frame.
  * - Paint stage
  *   - RasterCache::EvictUnusedCacheEntries
- *       Evict cached images that are no longer used.
+ *       Evict cached images that have not been used for more than
+ *       `max_unused_frames` frames, and the least valuable images if the
+ *       cache is over its byte budget.
  *   - LayerTree::TryToPrepareRasterCache
  *       Create cache image for each cache entry if it does not exist.
  *   - LayerTree::Paint - for each layer in the tree:
@@ -111,6 +160,15 @@ struct RasterCacheMetrics {
  *       `RasterCache::Draw` will be used to draw those cache images.
  *   - RasterCache::EndFrame:
  *       Computes used counts and memory then reports cache metrics.
+ *
+ * When the images would exceed the byte budget set with |SetMaxBytes|,
+ * entries are evicted by the Greedy-Dual-Size-Frequency policy: each image
+ * has a priority of L + accesses * cost / bytes, where |cost| is the
+ * complexity score of its content and L is the priority of the last image
+ * that was evicted, so that the images that were used recently, are used
+ * often and are the most expensive to render again for their size are
+ * kept. A new image is only admitted if it can make room by evicting
+ * images of lower priority.
  */
 class RasterCache {
  public:
@@ -120,6 +178,18 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // If set, the entry is rasterized into an Impeller texture rather than
+    // into an SkSurface.
+    impeller::AiksContext* aiks_context = nullptr;
+    // The complexity score of the content to rasterize, which weights the
+    // entry against the others when the cache is over its byte budget, or
+    // 0 if it is not known.
+    unsigned int complexity_score = 0;
+    // Whether the render function only uses objects that it holds
+    // references to, so that it may be copied and called on another thread
+    // after the frame. The entry is then rasterized by the async rasterizer
+    // if the cache has one.
+    bool allow_async_rasterization = false;
   };
 
   std::unique_ptr<RasterCacheResult> Rasterize(
@@ -131,7 +201,9 @@ class RasterCache {
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_and_display_list_cache_limit_per_frame =
-          RasterCacheUtil::kDefaultPictureAndDispLayListCacheLimitPerFrame);
+          RasterCacheUtil::kDefaultPictureAndDispLayListCacheLimitPerFrame,
+      size_t max_unused_frames =
+          RasterCacheUtil::kDefaultMaxUnusedFramesBeforeEviction);
 
   virtual ~RasterCache() = default;
 
@@ -144,9 +216,18 @@ class RasterCache {
             SkCanvas& canvas,
             const SkPaint* paint) const;
 
+  // Draws this item into a DisplayListBuilder, which is the only way to
+  // draw the entries rasterized by Impeller.
+  bool Draw(const RasterCacheKeyID& id,
+            DisplayListBuilder& builder,
+            const SkPaint* paint) const;
+
   bool HasEntry(const RasterCacheKeyID& id, const SkMatrix&) const;
 
-  void BeginFrame();
+  // The frame paints the layer trees of |view_count| views, which share the
+  // cache. The entries are only evicted when the last of them is painted, so
+  // that the entries of the views painted later in the frame are kept.
+  void BeginFrame(size_t view_count = 1u);
 
   void EvictUnusedCacheEntries();
 
@@ -205,6 +286,35 @@ class RasterCache {
    */
   int access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Return the number of consecutive frames that a rasterized entry
+   * may go unused before it is evicted. If the number is 0, entries are
+   * evicted as soon as a frame does not use them.
+   */
+  size_t max_unused_frames() const { return max_unused_frames_; }
+
+  /**
+   * @brief Set the maximum number of bytes that the cached images may use.
+   * The budget is unlimited until this is called.
+   *
+   * Lowering the budget takes effect at the next call to
+   * |EvictUnusedCacheEntries|.
+   */
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Set the rasterizer that renders the entries that allow it away
+   * from the raster thread. Until the image of such an entry is ready, the
+   * entry is drawn uncached. Entries rasterized by Impeller are always
+   * rendered on the raster thread.
+   */
+  void SetAsyncRasterizer(
+      std::shared_ptr<RasterCacheAsyncRasterizer> async_rasterizer) {
+    async_rasterizer_ = std::move(async_rasterizer);
+  }
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 && display_list_cached_this_frame_ <
@@ -241,20 +351,61 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    size_t unused_frames = 0;
+    unsigned int complexity_score = 0;
+    double priority = 0.0;
+    // Whether the image is being rendered by the async rasterizer.
+    bool rasterizing = false;
     std::unique_ptr<RasterCacheResult> image;
   };
 
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  // The priority that |entry| would have if its image were |bytes| large.
+  double ComputePriority(const Entry& entry, size_t bytes) const;
+
+  size_t GetCachedBytes() const;
+
+  // Evicts the images of the lowest priority until the cached images use
+  // no more than |max_bytes| bytes, but only among images whose priority
+  // is below |max_priority|. Returns false if there was not enough to
+  // evict, in which case nothing was evicted.
+  bool EvictToFit(size_t max_bytes, double max_priority) const;
+
+  void EvictImage(RasterCacheKey::Map<Entry>::iterator it) const;
+
+  void RasterizeAsync(
+      const RasterCacheKey& key,
+      Entry& entry,
+      const Context& context,
+      const std::function<void(SkCanvas*)>& draw_function) const;
+
+  void OnAsyncRasterizationComplete(const RasterCacheKey& key,
+                                    SkiaGPUObject<SkImage> image,
+                                    const SkRect& logical_rect,
+                                    const char* flow_type) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  const size_t max_unused_frames_;
+  size_t max_bytes_ = std::numeric_limits<size_t>::max();
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  // The views of the frame that have yet to evict the unused entries.
+  size_t views_left_to_evict_ = 0;
+  // The L of the Greedy-Dual-Size-Frequency policy, which rises to the
+  // priority of every image that is evicted to make room for another.
+  mutable double priority_floor_ = 0.0;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_;
+  std::shared_ptr<RasterCacheAsyncRasterizer> async_rasterizer_;
+  // Incremented by |Clear|, so that the images of the async rasterizer
+  // that were requested before the cache was cleared or destroyed are
+  // dropped when they arrive.
+  std::shared_ptr<size_t> generation_;
 
   void TraceStatsToTimeline() const;
 
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_impeller.h"
+
+#include "flutter/display_list/display_list_canvas_recorder.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/aiks/picture.h"
+#include "impeller/display_list/display_list_dispatcher.h"
+#include "impeller/display_list/display_list_image_impeller.h"
+#include "impeller/renderer/render_target.h"
+
+namespace flutter {
+
+std::unique_ptr<RasterCacheResult> ImpellerRasterCacheResult::Rasterize(
+    impeller::AiksContext& aiks_context,
+    const SkISize& size,
+    const SkRect& logical_rect,
+    const char* type,
+    const std::function<void(SkCanvas*)>& draw_function) {
+  TRACE_EVENT0("flutter", "ImpellerRasterCacheResult::Rasterize");
+  if (size.isEmpty()) {
+    return nullptr;
+  }
+
+  DisplayListCanvasRecorder recorder(SkRect::Make(size));
+  draw_function(&recorder);
+  auto display_list = recorder.Build();
+
+  impeller::DisplayListDispatcher dispatcher;
+  display_list->Dispatch(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+
+  auto context = aiks_context.GetContext();
+  auto& allocator = *aiks_context.GetContentContext().GetRenderTargetCache();
+  impeller::ISize target_size(size.width(), size.height());
+  impeller::RenderTarget target;
+  if (context->SupportsOffscreenMSAA()) {
+    target = impeller::RenderTarget::CreateOffscreenMSAA(
+        *context, allocator, target_size, "Raster Cache MSAA");
+  } else {
+    target = impeller::RenderTarget::CreateOffscreen(
+        *context, allocator, target_size, "Raster Cache");
+  }
+  if (!target.IsValid()) {
+    FML_LOG(ERROR) << "Could not create a render target for the raster cache.";
+    return nullptr;
+  }
+  if (!aiks_context.Render(picture, target)) {
+    FML_LOG(ERROR) << "Could not render a raster cache entry.";
+    return nullptr;
+  }
+
+  auto texture = target.GetRenderTargetTexture();
+  if (!texture) {
+    return nullptr;
+  }
+  return std::make_unique<ImpellerRasterCacheResult>(std::move(texture),
+                                                     logical_rect, type);
+}
+
+ImpellerRasterCacheResult::ImpellerRasterCacheResult(
+    std::shared_ptr<impeller::Texture> texture,
+    const SkRect& logical_rect,
+    const char* type)
+    : RasterCacheResult(nullptr, logical_rect, type),
+      image_(impeller::DlImageImpeller::Make(
+          std::move(texture),
+          DlImage::OwningContext::kRaster)) {}
+
+void ImpellerRasterCacheResult::draw(SkCanvas& canvas,
+                                     const SkPaint* paint) const {
+  // The raster cache only draws this result into a DisplayListBuilder, see
+  // |can_draw_to_canvas|.
+  FML_DCHECK(false);
+}
+
+void ImpellerRasterCacheResult::draw(DisplayListBuilder& builder,
+                                     const SkPaint* paint) const {
+  DrawImage(builder, image_, paint);
+}
+
+SkISize ImpellerRasterCacheResult::image_dimensions() const {
+  return image_->dimensions();
+}
+
+int64_t ImpellerRasterCacheResult::image_bytes() const {
+  return image_->impeller_texture()
+      ->GetTextureDescriptor()
+      .GetByteSizeOfBaseMipLevel();
+}
+
+}  // namespace flutter
@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_IMPELLER_H_
+#define FLUTTER_FLOW_RASTER_CACHE_IMPELLER_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/macros.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/renderer/texture.h"
+
+namespace flutter {
+
+// A raster cache entry held in an Impeller texture.
+//
+// The texture is a render target allocated from the render target cache of
+// the |AiksContext|, so it returns to that pool to be reused by the frames
+// that follow once the entry is evicted.
+class ImpellerRasterCacheResult final : public RasterCacheResult {
+ public:
+  // Renders the output of |draw_function| into a texture of |size| pixels,
+  // or returns nullptr if the texture could not be rendered.
+  static std::unique_ptr<RasterCacheResult> Rasterize(
+      impeller::AiksContext& aiks_context,
+      const SkISize& size,
+      const SkRect& logical_rect,
+      const char* type,
+      const std::function<void(SkCanvas*)>& draw_function);
+
+  ImpellerRasterCacheResult(std::shared_ptr<impeller::Texture> texture,
+                            const SkRect& logical_rect,
+                            const char* type);
+
+  // |RasterCacheResult|
+  void draw(SkCanvas& canvas, const SkPaint* paint) const override;
+
+  // |RasterCacheResult|
+  void draw(DisplayListBuilder& builder, const SkPaint* paint) const override;
+
+  // |RasterCacheResult|
+  bool can_draw_to_canvas() const override { return false; }
+
+  // |RasterCacheResult|
+  SkISize image_dimensions() const override;
+
+  // |RasterCacheResult|
+  int64_t image_bytes() const override;
+
+ private:
+  sk_sp<DlImage> image_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImpellerRasterCacheResult);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_IMPELLER_H_
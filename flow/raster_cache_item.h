@@ -57,6 +57,15 @@ class RasterCacheItem {
   virtual bool TryToPrepareRasterCache(const PaintContext& context,
                                        bool parent_cached = false) const = 0;
 
+  // Whether another preroll of the item with the same matrix and cull rect
+  // would leave its state unchanged, so that |ReusePreroll| can be called in
+  // its place. See |Layer::TryToReusePreroll|.
+  virtual bool CanReusePreroll() const { return false; }
+
+  // Registers the item in the raster cache entries of |context| and marks
+  // its cache entry as seen in the same state as its last preroll did.
+  virtual void ReusePreroll(PrerollContext* context) {}
+
   unsigned child_items() const { return child_items_; }
 
   void set_matrix(const SkMatrix& matrix) { matrix_ = matrix; }
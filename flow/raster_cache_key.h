@@ -18,7 +18,7 @@ namespace flutter {
 
 class Layer;
 
-enum class RasterCacheKeyType { kLayer, kDisplayList, kLayerChildren };
+enum class RasterCacheKeyType { kLayer, kDisplayList, kLayerChildren, kShadow };
 
 class RasterCacheKeyID {
  public:
@@ -96,6 +96,7 @@ class RasterCacheKey {
         return RasterCacheKeyKind::kDisplayListMetrics;
       case RasterCacheKeyType::kLayer:
       case RasterCacheKeyType::kLayerChildren:
+      case RasterCacheKeyType::kShadow:
         return RasterCacheKeyKind::kLayerMetrics;
     }
   }
@@ -22,6 +22,7 @@
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -334,7 +335,9 @@ TEST(RasterCache, PictureCacheLimitPerFrameIsRespectedWhenZeroForDisplayList) {
 
 TEST(RasterCache, EvitUnusedCacheEntries) {
   size_t threshold = 1;
-  flutter::RasterCache cache(threshold);
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDispLayListCacheLimitPerFrame, 0);
 
   SkMatrix matrix = SkMatrix::I();
 
@@ -432,6 +435,211 @@ TEST(RasterCache, EvitUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, UnusedImagesAreRetainedForMaxUnusedFrames) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDispLayListCacheLimitPerFrame, 2);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+  SkPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list.get(), SkPoint(),
+                                               true, false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+
+  // A frame without the display list keeps its image.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+
+  // When it comes back, it is drawn from the image it already had.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  // After more than 2 frames without it, the image is evicted.
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame();
+    cache.EvictUnusedCacheEntries();
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.GetCachedEntriesCount(), 0u);
+}
+
+TEST(RasterCache, ViewsOfAFrameDoNotEvictTheEntriesOfEachOther) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDispLayListCacheLimitPerFrame, 0);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+  SkPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1.get(),
+                                                 SkPoint(), true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2.get(),
+                                                 SkPoint(), true, false);
+
+  // Each of the two views of the frame has one of the display lists, and its
+  // layer tree is prerolled and painted after the other one was painted.
+  for (int i = 0; i < 3; i++) {
+    cache.BeginFrame(/*view_count=*/2);
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_2, paint_context);
+    cache.EndFrame();
+    if (i > 0) {
+      ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51200u);
+    }
+  }
+  ASSERT_TRUE(
+      cache.Draw(display_list_item_1.GetId().value(), dummy_canvas, &paint));
+  ASSERT_TRUE(
+      cache.Draw(display_list_item_2.GetId().value(), dummy_canvas, &paint));
+
+  // Once a single view is left, the entries of the other one are evicted.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+}
+
+TEST(RasterCache, ByteBudgetKeepsImagesOfHigherPriority) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDispLayListCacheLimitPerFrame, 10);
+  // Room for only one of the 25600 byte images.
+  cache.SetMaxBytes(40000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+  SkPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1.get(),
+                                                 SkPoint(), true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2.get(),
+                                                 SkPoint(), true, false);
+
+  // The first display list is seen for 4 frames and the second one for the
+  // last 2 of them, so the first one has the higher priority.
+  for (int i = 0; i < 4; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    if (i >= 2) {
+      RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    }
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    if (i >= 2) {
+      ASSERT_FALSE(
+          RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+    }
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+
+  // Once the second display list has been seen more often than the first
+  // one, it replaces it.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    ASSERT_FALSE(
+        RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+    cache.EndFrame();
+  }
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(
+      cache.Draw(display_list_item_1.GetId().value(), dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+
+  // Lowering the budget evicts the remaining image.
+  cache.SetMaxBytes(0);
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -492,6 +700,54 @@ TEST(RasterCache, DeviceRectRoundOutForDisplayList) {
   ASSERT_TRUE(display_list_item.Draw(paint_context, &canvas, &paint));
 }
 
+TEST(RasterCache, CachedDisplayListCanBeDrawnToBuilder) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::Scale(1.5, 1.5);
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+  SkPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  cache.BeginFrame();
+  DisplayListRasterCacheItem display_list_item(display_list.get(), SkPoint(),
+                                               true, false);
+
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+
+  cache.EndFrame();
+  cache.BeginFrame();
+
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+
+  DisplayListBuilder builder;
+  ASSERT_FALSE(cache.Draw(display_list_item.GetId().value(), builder, &paint));
+
+  builder.transform(matrix);
+  ASSERT_TRUE(cache.Draw(display_list_item.GetId().value(), builder, &paint));
+  // The draw leaves the transform of the builder as it found it.
+  ASSERT_EQ(builder.getTransform(), matrix);
+  ASSERT_GT(builder.Build()->op_count(), 0u);
+}
+
 TEST(RasterCache, NestedOpCountMetricUsedForDisplayList) {
   size_t threshold = 1;
   flutter::RasterCache cache(threshold);
@@ -884,5 +1140,139 @@ TEST_F(RasterCacheTest, RasterCacheKeyIDLayerChildrenIds) {
   ASSERT_EQ(ids, expected_ids);
 }
 
+namespace {
+
+// Holds on to the requests until the test completes them, as a rasterizer
+// on another thread would.
+class PendingAsyncRasterizer final : public RasterCacheAsyncRasterizer {
+ public:
+  struct Request {
+    SkImageInfo image_info;
+    DrawFunction draw_function;
+    Callback callback;
+  };
+
+  void Rasterize(const SkImageInfo& image_info,
+                 DrawFunction draw_function,
+                 Callback callback) override {
+    requests.push_back({image_info, std::move(draw_function),
+                        std::move(callback)});
+  }
+
+  std::vector<Request> requests;
+};
+
+}  // namespace
+
+TEST_F(RasterCacheTest, AsyncRasterizedImageIsSwappedInWhenReady) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto async_rasterizer = std::make_shared<PendingAsyncRasterizer>();
+  cache.SetAsyncRasterizer(async_rasterizer);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+  SkPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list.get(), SkPoint(),
+                                               true, false);
+
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+
+  // The frame that decides to cache the display list only requests its
+  // image and draws it uncached.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(async_rasterizer->requests.size(), 1u);
+  cache.EndFrame();
+
+  // The image is not requested again while it is being rendered.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_EQ(async_rasterizer->requests.size(), 1u);
+
+  auto& request = async_rasterizer->requests.front();
+  auto surface = SkSurface::MakeRaster(request.image_info);
+  request.draw_function(surface->getCanvas());
+  request.callback(
+      SkiaGPUObject<SkImage>(surface->makeImageSnapshot(), unref_queue()));
+
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25600u);
+  cache.EndFrame();
+}
+
+TEST_F(RasterCacheTest, AsyncRasterizedImageIsDroppedAfterClear) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto async_rasterizer = std::make_shared<PendingAsyncRasterizer>();
+  cache.SetAsyncRasterizer(async_rasterizer);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  SkCanvas dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list.get(), SkPoint(),
+                                               true, false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPrerollAndTryToRasterCache(display_list_item,
+                                              preroll_context, paint_context,
+                                              matrix);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(async_rasterizer->requests.size(), 1u);
+
+  cache.Clear();
+
+  auto& request = async_rasterizer->requests.front();
+  auto surface = SkSurface::MakeRaster(request.image_info);
+  request.draw_function(surface->getCanvas());
+  request.callback(
+      SkiaGPUObject<SkImage>(surface->makeImageSnapshot(), unref_queue()));
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
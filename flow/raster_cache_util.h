@@ -19,6 +19,18 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDispLayListCacheLimitPerFrame = 3;
 
+  // The default number of consecutive frames that a rasterized entry may go
+  // unused before it is evicted. Keeping entries for a few frames means that
+  // content which scrolls or animates briefly out of view and back does not
+  // have to be rasterized again, and it is the same number of frames that it
+  // takes the default access threshold to cache new content.
+  static constexpr int kDefaultMaxUnusedFramesBeforeEviction = 3;
+
+  // The fraction of the GPU resource cache limit that the raster cache may
+  // use for its images. The rest is left to the textures, glyph atlases and
+  // other resources that are allocated while rendering a frame.
+  static constexpr float kResourceCacheFractionForRasterCache = 0.5f;
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
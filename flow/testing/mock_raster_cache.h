@@ -32,6 +32,8 @@ class MockRasterCacheResult : public RasterCacheResult {
   explicit MockRasterCacheResult(SkRect device_rect);
 
   void draw(SkCanvas& canvas, const SkPaint* paint = nullptr) const override{};
+  void draw(DisplayListBuilder& builder,
+            const SkPaint* paint = nullptr) const override{};
 
   SkISize image_dimensions() const override {
     return SkSize::Make(device_rect_.width(), device_rect_.height()).toCeil();
@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/texture_frame_queue.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class TestFence : public TextureFence {
+ public:
+  TestFence() = default;
+
+  bool IsSignaled() const override { return signaled_; }
+
+  void Signal() { signaled_ = true; }
+
+ private:
+  std::atomic_bool signaled_ = false;
+};
+
+// Counts how many of the frames it was moved into were released.
+class TestFrame {
+ public:
+  TestFrame(int id, std::shared_ptr<std::atomic_int> release_count)
+      : id_(id), release_count_(std::move(release_count)) {}
+
+  TestFrame(TestFrame&& other)
+      : id_(other.id_), release_count_(std::move(other.release_count_)) {}
+
+  TestFrame& operator=(TestFrame&& other) {
+    Release();
+    id_ = other.id_;
+    release_count_ = std::move(other.release_count_);
+    return *this;
+  }
+
+  ~TestFrame() { Release(); }
+
+  int id() const { return id_; }
+
+ private:
+  int id_;
+  std::shared_ptr<std::atomic_int> release_count_;
+
+  void Release() {
+    if (release_count_) {
+      (*release_count_)++;
+      release_count_.reset();
+    }
+  }
+};
+
+}  // namespace
+
+TEST(TextureFrameQueueTest, AcquiresTheLatestSubmittedFrame) {
+  auto release_count = std::make_shared<std::atomic_int>(0);
+  TextureFrameQueue<TestFrame> queue;
+  ASSERT_FALSE(queue.AcquireLatest().has_value());
+
+  queue.Submit(TestFrame(1, release_count), nullptr);
+  auto frame = queue.AcquireLatest();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->id(), 1);
+
+  // Nothing new was submitted, the consumer keeps the frame it has.
+  EXPECT_FALSE(queue.AcquireLatest().has_value());
+  EXPECT_EQ(*release_count, 0);
+  frame.reset();
+  EXPECT_EQ(*release_count, 1);
+}
+
+TEST(TextureFrameQueueTest, FramesThatAreSupersededAreDropped) {
+  auto release_count = std::make_shared<std::atomic_int>(0);
+  TextureFrameQueue<TestFrame> queue;
+
+  queue.Submit(TestFrame(1, release_count), nullptr);
+  queue.Submit(TestFrame(2, release_count), nullptr);
+  queue.Submit(TestFrame(3, release_count), nullptr);
+
+  auto frame = queue.AcquireLatest();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->id(), 3);
+  EXPECT_EQ(*release_count, 2);
+  EXPECT_EQ(queue.GetSubmittedFrameCount(), 3u);
+  EXPECT_EQ(queue.GetDroppedFrameCount(), 2u);
+}
+
+TEST(TextureFrameQueueTest, FramesAreAcquiredOnceTheirFenceSignals) {
+  auto release_count = std::make_shared<std::atomic_int>(0);
+  TextureFrameQueue<TestFrame> queue;
+
+  queue.Submit(TestFrame(1, release_count), nullptr);
+  auto fence = std::make_shared<TestFence>();
+  queue.Submit(TestFrame(2, release_count), fence);
+
+  // The frame that is still being written is skipped, not waited for.
+  auto frame = queue.AcquireLatest();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->id(), 1);
+  EXPECT_FALSE(queue.AcquireLatest().has_value());
+
+  fence->Signal();
+  frame = queue.AcquireLatest();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->id(), 2);
+  EXPECT_EQ(*release_count, 1);
+  EXPECT_EQ(queue.GetDroppedFrameCount(), 0u);
+}
+
+TEST(TextureFrameQueueTest, FramesInFlightAreDroppedWhenSuperseded) {
+  auto release_count = std::make_shared<std::atomic_int>(0);
+  TextureFrameQueue<TestFrame> queue;
+
+  auto fence = std::make_shared<TestFence>();
+  queue.Submit(TestFrame(1, release_count), fence);
+  queue.Submit(TestFrame(2, release_count), nullptr);
+  EXPECT_EQ(*release_count, 1);
+  EXPECT_EQ(queue.GetDroppedFrameCount(), 1u);
+
+  auto frame = queue.AcquireLatest();
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->id(), 2);
+}
+
+TEST(TextureFrameQueueTest, ClearReleasesTheFramesThatWereNotAcquired) {
+  auto release_count = std::make_shared<std::atomic_int>(0);
+  TextureFrameQueue<TestFrame> queue;
+
+  queue.Submit(TestFrame(1, release_count), nullptr);
+  queue.Submit(TestFrame(2, release_count), std::make_shared<TestFence>());
+  queue.Clear();
+  EXPECT_EQ(*release_count, 2);
+  EXPECT_FALSE(queue.AcquireLatest().has_value());
+}
+
+TEST(TextureFrameQueueTest, FramesCanBeSubmittedFromAnotherThread) {
+  auto release_count = std::make_shared<std::atomic_int>(0);
+  TextureFrameQueue<TestFrame> queue;
+  constexpr int kFrameCount = 1000;
+
+  std::thread producer([&queue, release_count]() {
+    for (int i = 1; i <= kFrameCount; i++) {
+      queue.Submit(TestFrame(i, release_count), nullptr);
+    }
+  });
+  int last_id = 0;
+  while (last_id < kFrameCount) {
+    if (auto frame = queue.AcquireLatest()) {
+      // Frames are never acquired out of order.
+      EXPECT_GT(frame->id(), last_id);
+      last_id = frame->id();
+    }
+  }
+  producer.join();
+  EXPECT_EQ(*release_count, kFrameCount);
+}
+
+}  // namespace testing
+}  // namespace flutter
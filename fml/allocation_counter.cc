@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/allocation_counter.h"
+
+#include <atomic>
+
+namespace fml {
+
+namespace {
+
+// Set by the first allocation the hooks record. Without the hooks nothing
+// ever sets it.
+std::atomic_bool gAllocationCounterEnabled = false;
+
+// Trivially constructible and destructible, so accessing it from the hooks
+// never allocates.
+thread_local AllocationCount tAllocationCount;
+
+}  // namespace
+
+bool AllocationCounter::IsEnabled() {
+  return gAllocationCounterEnabled.load(std::memory_order_relaxed);
+}
+
+AllocationCount AllocationCounter::GetCurrentThreadCount() {
+  return tAllocationCount;
+}
+
+void AllocationCounter::RecordAllocation(size_t size) {
+  tAllocationCount.allocations++;
+  tAllocationCount.bytes += size;
+  if (!gAllocationCounterEnabled.load(std::memory_order_relaxed)) {
+    gAllocationCounterEnabled.store(true, std::memory_order_relaxed);
+  }
+}
+
+ScopedAllocationCount::ScopedAllocationCount()
+    : start_(AllocationCounter::GetCurrentThreadCount()) {}
+
+ScopedAllocationCount::~ScopedAllocationCount() = default;
+
+AllocationCount ScopedAllocationCount::Get() const {
+  return AllocationCounter::GetCurrentThreadCount() - start_;
+}
+
+ScopedAllocationTrace::ScopedAllocationTrace(const char* category,
+                                             const char* name)
+    : category_(category), name_(name) {}
+
+ScopedAllocationTrace::~ScopedAllocationTrace() {
+  if (!AllocationCounter::IsEnabled()) {
+    return;
+  }
+  auto count = count_.Get();
+  FML_TRACE_COUNTER(category_, name_, 0,                 //
+                    "Allocations", count.allocations,  //
+                    "AllocatedBytes", count.bytes);
+}
+
+}  // namespace fml
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ALLOCATION_COUNTER_H_
+#define FLUTTER_FML_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      The number and size of the heap allocations made on a thread.
+///
+struct AllocationCount {
+  uint64_t allocations = 0u;
+  uint64_t bytes = 0u;
+
+  AllocationCount operator-(const AllocationCount& other) const {
+    return {allocations - other.allocations, bytes - other.bytes};
+  }
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the heap allocations of each thread.
+///
+///             Nothing is counted unless the replacements of the global
+///             `operator new` in `//flutter/fml:allocation_counter_hooks` are
+///             linked into the binary. Only benchmarks and tests should link
+///             them. Allocations made with `malloc` directly and those of
+///             over-aligned types are not counted.
+///
+class AllocationCounter {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      If the hooks are linked into the binary and allocations are
+  ///             being counted.
+  ///
+  static bool IsEnabled();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The allocations made on the calling thread since it started.
+  ///
+  static AllocationCount GetCurrentThreadCount();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the hooks for every allocation. Must not allocate.
+  ///
+  static void RecordAllocation(size_t size);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(AllocationCounter);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the allocations the calling thread makes while it is
+///             alive.
+///
+class ScopedAllocationCount {
+ public:
+  ScopedAllocationCount();
+
+  ~ScopedAllocationCount();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The allocations made since the scope was entered. Must be
+  ///             called on the thread that created the scope.
+  ///
+  AllocationCount Get() const;
+
+ private:
+  const AllocationCount start_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedAllocationCount);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Reports the allocations made in a scope as a trace counter
+///             named after the scope when allocations are being counted.
+///
+///             Use |FML_TRACE_ALLOCATIONS| next to the |TRACE_EVENT0| of the
+///             scope.
+///
+class ScopedAllocationTrace {
+ public:
+  ScopedAllocationTrace(const char* category, const char* name);
+
+  ~ScopedAllocationTrace();
+
+ private:
+  const char* category_;
+  const char* name_;
+  ScopedAllocationCount count_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedAllocationTrace);
+};
+
+}  // namespace fml
+
+#define FML_TRACE_ALLOCATIONS(category, name)     \
+  ::fml::ScopedAllocationTrace __FML__TOKEN_CAT__2( \
+      __allocation_trace_, __LINE__)((category), (name))
+
+#endif  // FLUTTER_FML_ALLOCATION_COUNTER_H_
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replaces the global allocation functions to count the allocations of each
+// thread with |fml::AllocationCounter|. Only linked into benchmarks and tests.
+
+#include <cstdlib>
+#include <new>
+
+#include "flutter/fml/allocation_counter.h"
+
+namespace {
+
+void* CountedAllocate(size_t size) {
+  fml::AllocationCounter::RecordAllocation(size);
+  // malloc(0) may return nullptr, which operator new must not.
+  return std::malloc(size == 0u ? 1u : size);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  void* ptr = CountedAllocate(size);
+  if (ptr == nullptr) {
+    // Exceptions are disabled, so this can't throw std::bad_alloc.
+    std::abort();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/allocation_counter.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+// fml_unittests links the hooks.
+TEST(AllocationCounterTest, IsEnabledWhenTheHooksAreLinked) {
+  auto allocation = std::make_unique<int>(1);
+  ASSERT_TRUE(AllocationCounter::IsEnabled());
+}
+
+TEST(AllocationCounterTest, CountsTheAllocationsOfAScope) {
+  ScopedAllocationCount count;
+  ASSERT_EQ(count.Get().allocations, 0u);
+
+  auto allocation = std::make_unique<int>(1);
+  std::vector<uint8_t> vector(100u);
+  EXPECT_EQ(count.Get().allocations, 2u);
+  EXPECT_GE(count.Get().bytes, sizeof(int) + 100u);
+
+  // Freeing memory is not an allocation.
+  allocation.reset();
+  vector = {};
+  EXPECT_EQ(count.Get().allocations, 2u);
+}
+
+TEST(AllocationCounterTest, ScopesNest) {
+  ScopedAllocationCount outer;
+  auto first = std::make_unique<int>(1);
+  {
+    ScopedAllocationCount inner;
+    auto second = std::make_unique<int>(2);
+    EXPECT_EQ(inner.Get().allocations, 1u);
+  }
+  EXPECT_EQ(outer.Get().allocations, 2u);
+}
+
+TEST(AllocationCounterTest, OnlyCountsTheAllocationsOfTheCurrentThread) {
+  ScopedAllocationCount count;
+  uint64_t thread_allocations = 0u;
+  std::thread thread([&thread_allocations]() {
+    ScopedAllocationCount thread_count;
+    for (int i = 0; i < 10; i++) {
+      auto allocation = std::make_unique<int>(i);
+    }
+    thread_allocations = thread_count.Get().allocations;
+  });
+  // Creating the thread allocates its state on this thread.
+  auto allocations_after_creation = count.Get().allocations;
+  thread.join();
+  EXPECT_EQ(thread_allocations, 10u);
+  EXPECT_EQ(count.Get().allocations, allocations_after_creation);
+}
+
+}  // namespace testing
+}  // namespace fml
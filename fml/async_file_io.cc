@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_io.h"
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+AsyncFileIO::AsyncFileIO() = default;
+
+AsyncFileIO::~AsyncFileIO() {
+  std::scoped_lock lock(thread_mutex_);
+  if (thread_) {
+    // The tasks posted before the join run first.
+    thread_->Join();
+  }
+}
+
+RefPtr<TaskRunner> AsyncFileIO::GetTaskRunner() {
+  std::scoped_lock lock(thread_mutex_);
+  if (!thread_) {
+    thread_ = std::make_unique<Thread>("io.flutter.file");
+  }
+  return thread_->GetTaskRunner();
+}
+
+void AsyncFileIO::ReadFile(std::shared_ptr<const UniqueFD> base_directory,
+                           std::string file_name,
+                           RefPtr<TaskRunner> completion_runner,
+                           ReadCallback callback) {
+  FML_DCHECK(base_directory);
+  FML_DCHECK(callback);
+  GetTaskRunner()->PostTask([base_directory = std::move(base_directory),
+                             file_name = std::move(file_name),
+                             completion_runner = std::move(completion_runner),
+                             callback = std::move(callback)]() {
+    TRACE_EVENT0("flutter", "AsyncFileIO::ReadFile");
+    std::unique_ptr<FileMapping> mapping =
+        FileMapping::CreateReadOnly(*base_directory, file_name);
+    if (mapping) {
+      mapping->ReadAhead(0, mapping->GetSize());
+    }
+    if (!completion_runner) {
+      callback(std::move(mapping));
+      return;
+    }
+    completion_runner->PostTask(fml::MakeCopyable(
+        [callback, mapping = std::move(mapping)]() mutable {
+          callback(std::move(mapping));
+        }));
+  });
+}
+
+void AsyncFileIO::WriteAtomically(
+    std::shared_ptr<const UniqueFD> base_directory,
+    std::string file_name,
+    std::unique_ptr<const Mapping> data,
+    RefPtr<TaskRunner> completion_runner,
+    WriteCallback callback) {
+  FML_DCHECK(base_directory);
+  FML_DCHECK(data);
+  // The static leak checker gets confused by the use of fml::MakeCopyable.
+  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+  GetTaskRunner()->PostTask(fml::MakeCopyable(
+      [base_directory = std::move(base_directory),
+       file_name = std::move(file_name), data = std::move(data),
+       completion_runner = std::move(completion_runner),
+       callback = std::move(callback)]() mutable {
+        TRACE_EVENT0("flutter", "AsyncFileIO::WriteAtomically");
+        const bool success =
+            fml::WriteAtomically(*base_directory, file_name.c_str(), *data);
+        if (!callback) {
+          return;
+        }
+        if (!completion_runner) {
+          callback(success);
+          return;
+        }
+        completion_runner->PostTask(
+            [callback, success]() { callback(success); });
+      }));
+}
+
+void AsyncFileIO::RunOperation(closure operation) {
+  FML_DCHECK(operation);
+  GetTaskRunner()->PostTask(std::move(operation));
+}
+
+void AsyncFileIO::WaitForPendingOperations() {
+  RefPtr<TaskRunner> task_runner = GetTaskRunner();
+  FML_DCHECK(!task_runner->RunsTasksOnCurrentThread());
+  AutoResetWaitableEvent latch;
+  task_runner->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
+
+}  // namespace fml
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ASYNC_FILE_IO_H_
+#define FLUTTER_FML_ASYNC_FILE_IO_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// Runs file reads and writes off the calling thread, and reports their
+/// completion on a task runner.
+///
+/// The operations run one at a time, in the order they were posted, on a
+/// thread owned by this object that is started with the first operation, so
+/// that they stall neither the threads that post them nor the IO thread.
+/// Destroying the object waits for the pending operations to complete, but
+/// their callbacks are dropped if their task runner is gone.
+///
+/// Operations may be posted from any thread.
+///
+class AsyncFileIO {
+ public:
+  using ReadCallback = std::function<void(std::unique_ptr<FileMapping>)>;
+  using WriteCallback = std::function<void(bool /* success */)>;
+
+  AsyncFileIO();
+
+  ~AsyncFileIO();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps a file for reading and reads it into memory.
+  ///
+  /// @param[in]  base_directory     The directory |file_name| is relative to.
+  /// @param[in]  file_name          The file to read.
+  /// @param[in]  completion_runner  The task runner |callback| is called on,
+  ///                                or nullptr to call it on the thread of
+  ///                                the operation.
+  /// @param[in]  callback           Called with the mapping, or nullptr if
+  ///                                the file could not be mapped.
+  ///
+  void ReadFile(std::shared_ptr<const UniqueFD> base_directory,
+                std::string file_name,
+                RefPtr<TaskRunner> completion_runner,
+                ReadCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes a file like |fml::WriteAtomically|.
+  ///
+  /// @param[in]  base_directory     The directory |file_name| is relative to.
+  /// @param[in]  file_name          The file to write.
+  /// @param[in]  data               The contents of the file.
+  /// @param[in]  completion_runner  The task runner |callback| is called on,
+  ///                                or nullptr to call it on the thread of
+  ///                                the operation.
+  /// @param[in]  callback           Called with whether the file was written.
+  ///                                May be null.
+  ///
+  void WriteAtomically(std::shared_ptr<const UniqueFD> base_directory,
+                       std::string file_name,
+                       std::unique_ptr<const Mapping> data,
+                       RefPtr<TaskRunner> completion_runner,
+                       WriteCallback callback = nullptr);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs an operation that does its own file IO, such as
+  ///             appending to a file, in order with the other operations.
+  ///
+  /// @param[in]  operation  The operation to run.
+  ///
+  void RunOperation(closure operation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks until the operations posted so far are complete. Their
+  ///             callbacks may still be pending on their task runners.
+  ///
+  void WaitForPendingOperations();
+
+ private:
+  std::mutex thread_mutex_;
+  std::unique_ptr<Thread> thread_;
+
+  // Starts the thread of the operations if needed.
+  RefPtr<TaskRunner> GetTaskRunner();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncFileIO);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ASYNC_FILE_IO_H_
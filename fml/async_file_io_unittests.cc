@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_io.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(AsyncFileIOTest, WritesAndReadsFiles) {
+  ScopedTemporaryDirectory dir;
+  auto base_directory = std::make_shared<const UniqueFD>(
+      OpenDirectory(dir.path().c_str(), false, FilePermission::kReadWrite));
+  ASSERT_TRUE(base_directory->is_valid());
+  Thread completion_thread("completion");
+  AsyncFileIO file_io;
+
+  AutoResetWaitableEvent write_latch;
+  bool written = false;
+  file_io.WriteAtomically(
+      base_directory, "file.txt",
+      std::make_unique<DataMapping>(std::string("contents")),
+      completion_thread.GetTaskRunner(), [&](bool success) {
+        EXPECT_TRUE(
+            completion_thread.GetTaskRunner()->RunsTasksOnCurrentThread());
+        written = success;
+        write_latch.Signal();
+      });
+  write_latch.Wait();
+  ASSERT_TRUE(written);
+
+  AutoResetWaitableEvent read_latch;
+  std::string contents;
+  file_io.ReadFile(base_directory, "file.txt",
+                   completion_thread.GetTaskRunner(),
+                   [&](std::unique_ptr<FileMapping> mapping) {
+                     if (mapping) {
+                       contents.assign(
+                           reinterpret_cast<const char*>(mapping->GetMapping()),
+                           mapping->GetSize());
+                     }
+                     read_latch.Signal();
+                   });
+  read_latch.Wait();
+  EXPECT_EQ(contents, "contents");
+}
+
+TEST(AsyncFileIOTest, ReportsMissingFiles) {
+  ScopedTemporaryDirectory dir;
+  auto base_directory = std::make_shared<const UniqueFD>(
+      OpenDirectory(dir.path().c_str(), false, FilePermission::kRead));
+  AsyncFileIO file_io;
+  AutoResetWaitableEvent latch;
+  bool found = true;
+  file_io.ReadFile(base_directory, "missing.txt", nullptr,
+                   [&](std::unique_ptr<FileMapping> mapping) {
+                     found = mapping != nullptr;
+                     latch.Signal();
+                   });
+  latch.Wait();
+  EXPECT_FALSE(found);
+}
+
+TEST(AsyncFileIOTest, WaitsForPendingWrites) {
+  ScopedTemporaryDirectory dir;
+  auto base_directory = std::make_shared<const UniqueFD>(
+      OpenDirectory(dir.path().c_str(), false, FilePermission::kReadWrite));
+  AsyncFileIO file_io;
+  for (int i = 0; i < 3; i++) {
+    file_io.WriteAtomically(
+        base_directory, "file" + std::to_string(i) + ".txt",
+        std::make_unique<DataMapping>(std::string("contents")), nullptr);
+  }
+  file_io.WaitForPendingOperations();
+  for (int i = 0; i < 3; i++) {
+    std::string file_name = "file" + std::to_string(i) + ".txt";
+    EXPECT_TRUE(FileExists(*base_directory, file_name.c_str()));
+  }
+}
+
+TEST(AsyncFileIOTest, RunsOperationsInOrderWithWrites) {
+  ScopedTemporaryDirectory dir;
+  auto base_directory = std::make_shared<const UniqueFD>(
+      OpenDirectory(dir.path().c_str(), false, FilePermission::kReadWrite));
+  AsyncFileIO file_io;
+  file_io.WriteAtomically(base_directory, "file.txt",
+                          std::make_unique<DataMapping>(std::string("a")),
+                          nullptr);
+  bool existed = false;
+  file_io.RunOperation([&existed, base_directory]() {
+    existed = FileExists(*base_directory, "file.txt");
+  });
+  file_io.WaitForPendingOperations();
+  EXPECT_TRUE(existed);
+}
+
+}  // namespace testing
+}  // namespace fml
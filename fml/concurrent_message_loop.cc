@@ -5,12 +5,43 @@
 #include "flutter/fml/concurrent_message_loop.h"
 
 #include <algorithm>
+#include <deque>
 
+#include "flutter/fml/synchronization/work_stealing_deque.h"
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
 
 namespace fml {
 
+struct ConcurrentMessageLoop::WorkerQueue {
+  // Only pushed to and popped from on the worker thread.
+  WorkStealingDeque<fml::UniqueClosure> deque;
+
+  std::mutex inbox_mutex;
+  std::deque<std::unique_ptr<fml::UniqueClosure>> inbox;
+  std::vector<fml::closure> thread_tasks;
+  std::atomic_bool has_thread_tasks = false;
+
+  ~WorkerQueue() {
+    // Tasks still pending when the loop is collected are dropped.
+    while (auto task = deque.Pop()) {
+      delete task;
+    }
+  }
+};
+
+namespace {
+
+// The loop and index of the worker running on the current thread, if any.
+struct CurrentWorker {
+  const ConcurrentMessageLoop* loop = nullptr;
+  size_t index = 0u;
+};
+
+thread_local CurrentWorker tCurrentWorker;
+
+}  // namespace
+
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
     size_t worker_count) {
   return std::shared_ptr<ConcurrentMessageLoop>{
@@ -19,17 +50,19 @@ std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
 
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  // Every queue must exist before any worker starts stealing.
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      tCurrentWorker = {this, i};
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -47,80 +80,150 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(fml::UniqueClosure task) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     task();
     return;
   }
 
-  tasks_.push(task);
+  if (tCurrentWorker.loop == this) {
+    // Tasks posted by a worker go onto its own deque without locking. Other
+    // workers steal them if this one stays busy.
+    worker_queues_[tCurrentWorker.index]->deque.Push(
+        new fml::UniqueClosure(std::move(task)));
+  } else {
+    // Spread tasks posted from other threads across all inboxes so that
+    // posters rarely contend with each other or with the workers.
+    auto& queue =
+        *worker_queues_[next_inbox_.fetch_add(1, std::memory_order_relaxed) %
+                        worker_count_];
+    std::scoped_lock lock(queue.inbox_mutex);
+    queue.inbox.emplace_back(
+        std::make_unique<fml::UniqueClosure>(std::move(task)));
+  }
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  pending_tasks_.fetch_add(1);
+  WakeWorker();
+}
 
-  tasks_condition_.notify_one();
+void ConcurrentMessageLoop::WakeWorker() {
+  // Sleeping workers check the pending task count after announcing that they
+  // sleep. So either they see the task or it is seen here that they sleep.
+  if (sleeping_workers_.load() == 0u) {
+    return;
+  }
+  {
+    // Workers check for tasks and go to sleep with this mutex held. Taking it
+    // here ensures the notification doesn't come in between.
+    std::scoped_lock lock(sleep_mutex_);
+  }
+  sleep_condition_.notify_one();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+std::unique_ptr<fml::UniqueClosure> ConcurrentMessageLoop::FindTask(
+    size_t worker_index) {
+  auto& own_queue = *worker_queues_[worker_index];
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+  if (auto task = own_queue.deque.Pop()) {
+    pending_tasks_.fetch_sub(1);
+    return std::unique_ptr<fml::UniqueClosure>(task);
+  }
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+  {
+    // Move the inbox onto the deque so that other workers can steal from it
+    // without locking.
+    std::scoped_lock lock(own_queue.inbox_mutex);
+    if (!own_queue.inbox.empty()) {
+      auto task = std::move(own_queue.inbox.front());
+      own_queue.inbox.pop_front();
+      for (auto& inbox_task : own_queue.inbox) {
+        own_queue.deque.Push(inbox_task.release());
+      }
+      own_queue.inbox.clear();
+      pending_tasks_.fetch_sub(1);
+      return task;
     }
+  }
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  for (size_t i = 1; i < worker_count_; ++i) {
+    auto& queue = *worker_queues_[(worker_index + i) % worker_count_];
+    if (auto task = queue.deque.Steal()) {
+      pending_tasks_.fetch_sub(1);
+      return std::unique_ptr<fml::UniqueClosure>(task);
     }
+  }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
-
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      task();
+  // The owners of these inboxes are busy. Otherwise they would have emptied
+  // them.
+  for (size_t i = 1; i < worker_count_; ++i) {
+    auto& queue = *worker_queues_[(worker_index + i) % worker_count_];
+    std::scoped_lock lock(queue.inbox_mutex);
+    if (!queue.inbox.empty()) {
+      auto task = std::move(queue.inbox.front());
+      queue.inbox.pop_front();
+      pending_tasks_.fetch_sub(1);
+      return task;
     }
+  }
+
+  return nullptr;
+}
+
+void ConcurrentMessageLoop::RunThreadTasks(WorkerQueue& queue) {
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(queue.inbox_mutex);
+    std::swap(thread_tasks, queue.thread_tasks);
+    queue.has_thread_tasks = false;
+  }
+  for (const auto& thread_task : thread_tasks) {
+    thread_task();
+  }
+}
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      thread_task();
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  auto& queue = *worker_queues_[worker_index];
+  while (!shutdown_) {
+    if (queue.has_thread_tasks) {
+      RunThreadTasks(queue);
     }
 
-    if (shutdown_now) {
-      break;
+    if (auto task = FindTask(worker_index)) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+      (*task)();
+      continue;
     }
+
+    // A steal may have lost a race without the task being found. The pending
+    // count accounts for that. So only sleep once it is zero.
+    std::unique_lock lock(sleep_mutex_);
+    sleeping_workers_.fetch_add(1);
+    sleep_condition_.wait(lock, [&]() {
+      return shutdown_ || queue.has_thread_tasks || pending_tasks_.load() > 0u;
+    });
+    sleeping_workers_.fetch_sub(1);
+  }
+
+  // Run the thread tasks that were posted before the shutdown.
+  if (queue.has_thread_tasks) {
+    RunThreadTasks(queue);
   }
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
-  shutdown_ = true;
-  tasks_condition_.notify_all();
+  {
+    std::scoped_lock lock(sleep_mutex_);
+    shutdown_ = true;
+  }
+  sleep_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -128,24 +231,15 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (auto& queue : worker_queues_) {
+    std::scoped_lock lock(queue->inbox_mutex);
+    queue->thread_tasks.emplace_back(task);
+    queue->has_thread_tasks = true;
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  {
+    std::scoped_lock lock(sleep_mutex_);
+  }
+  sleep_condition_.notify_all();
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -154,13 +248,13 @@ ConcurrentTaskRunner::ConcurrentTaskRunner(
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
-void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+void ConcurrentTaskRunner::PostTask(fml::UniqueClosure task) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(std::move(task));
     return;
   }
 
@@ -5,10 +5,12 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -37,24 +39,36 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  // The tasks of a single worker. Tasks posted from the worker itself go onto
+  // its lock-free deque. Tasks posted from other threads are spread across
+  // the inboxes of all workers. Idle workers steal from both.
+  struct WorkerQueue;
+
   size_t worker_count_ = 0;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_size_t next_inbox_ = 0u;
+  // The number of tasks in all deques and inboxes. Thread tasks posted via
+  // |PostTaskToAllWorkers| are not included.
+  std::atomic_size_t pending_tasks_ = 0u;
+  std::atomic_size_t sleeping_workers_ = 0u;
+  std::atomic_bool shutdown_ = false;
+  // Only used by workers to sleep while there are no tasks and by posters to
+  // wake them.
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
 
   explicit ConcurrentMessageLoop(size_t worker_count);
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
+
+  void PostTask(fml::UniqueClosure task);
 
-  void PostTask(const fml::closure& task);
+  void WakeWorker();
 
-  bool HasThreadTasksLocked() const;
+  std::unique_ptr<fml::UniqueClosure> FindTask(size_t worker_index);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  void RunThreadTasks(WorkerQueue& queue);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -65,7 +79,7 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   virtual ~ConcurrentTaskRunner();
 
-  void PostTask(const fml::closure& task) override;
+  void PostTask(fml::UniqueClosure task) override;
 
  private:
   friend ConcurrentMessageLoop;
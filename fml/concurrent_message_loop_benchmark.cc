@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+static constexpr size_t kTaskCount = 10000;
+
+// Many small tasks posted from threads that are not workers, like image
+// decodes and pipeline builds being kicked off from the UI and raster threads.
+static void BM_ConcurrentMessageLoopExternalTasks(
+    benchmark::State& state) {  // NOLINT
+  const auto poster_count = static_cast<size_t>(state.range(0));
+  auto loop = ConcurrentMessageLoop::Create();
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic_size_t sum = 0u;
+  while (state.KeepRunning()) {
+    CountDownLatch latch(kTaskCount);
+    std::vector<std::thread> posters;
+    for (size_t i = 0; i < poster_count; i++) {
+      posters.emplace_back([&]() {
+        for (size_t j = 0; j < kTaskCount / poster_count; j++) {
+          task_runner->PostTask([&sum, &latch, j]() {
+            sum.fetch_add(j, std::memory_order_relaxed);
+            latch.CountDown();
+          });
+        }
+      });
+    }
+    for (auto& poster : posters) {
+      poster.join();
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+// Many small tasks posted by the workers themselves, like a task fanning out
+// into subtasks.
+static void BM_ConcurrentMessageLoopNestedTasks(
+    benchmark::State& state) {  // NOLINT
+  const auto fan_out = static_cast<size_t>(state.range(0));
+  auto loop = ConcurrentMessageLoop::Create();
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic_size_t sum = 0u;
+  const size_t root_count = kTaskCount / fan_out;
+  while (state.KeepRunning()) {
+    CountDownLatch latch(root_count * fan_out);
+    for (size_t i = 0; i < root_count; i++) {
+      task_runner->PostTask([&, i]() {
+        for (size_t j = 0; j < fan_out; j++) {
+          task_runner->PostTask([&sum, &latch, i]() {
+            sum.fetch_add(i, std::memory_order_relaxed);
+            latch.CountDown();
+          });
+        }
+      });
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * root_count * fan_out);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopExternalTasks)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(BM_ConcurrentMessageLoopNestedTasks)
+    ->Arg(10)
+    ->Arg(100)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+#include <sched.h>
+#endif
+
+namespace fml {
+
+CpuSpeedTracker::CpuSpeedTracker(std::vector<CpuIndexAndSpeed> data)
+    : cpu_speeds_(std::move(data)) {
+  if (cpu_speeds_.empty()) {
+    return;
+  }
+  int64_t min_speed = cpu_speeds_.front().speed;
+  int64_t max_speed = cpu_speeds_.front().speed;
+  for (const auto& data : cpu_speeds_) {
+    min_speed = std::min(min_speed, data.speed);
+    max_speed = std::max(max_speed, data.speed);
+  }
+  if (min_speed == max_speed) {
+    return;
+  }
+  valid_ = true;
+  for (const auto& data : cpu_speeds_) {
+    if (data.speed == max_speed) {
+      performance_.push_back(data.index);
+    } else {
+      not_performance_.push_back(data.index);
+    }
+    if (data.speed == min_speed) {
+      efficiency_.push_back(data.index);
+    }
+  }
+}
+
+const std::vector<size_t>& CpuSpeedTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+  }
+  FML_UNREACHABLE();
+}
+
+#if defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+
+namespace {
+
+// The maximum frequency of the core, in kHz.
+std::optional<int64_t> ReadCpuSpeed(size_t index) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(index) +
+                     "/cpufreq/cpuinfo_max_freq");
+  int64_t speed = 0;
+  if (!(file >> speed)) {
+    return std::nullopt;
+  }
+  return speed;
+}
+
+// The cores are read once, as reading them takes several file reads and
+// they don't change while the process runs.
+const CpuSpeedTracker& GetCpuSpeedTracker() {
+  static const CpuSpeedTracker tracker([]() {
+    std::vector<CpuIndexAndSpeed> data;
+    const size_t count = std::thread::hardware_concurrency();
+    for (size_t index = 0; index < count; index++) {
+      auto speed = ReadCpuSpeed(index);
+      if (!speed.has_value()) {
+        // Without the speed of every core, a set could leave out the fastest
+        // ones.
+        return std::vector<CpuIndexAndSpeed>();
+      }
+      data.push_back({.index = index, .speed = speed.value()});
+    }
+    return data;
+  }());
+  return tracker;
+}
+
+}  // namespace
+
+std::optional<size_t> EfficiencyCoreCount() {
+  const CpuSpeedTracker& tracker = GetCpuSpeedTracker();
+  if (!tracker.IsValid()) {
+    return std::nullopt;
+  }
+  return tracker.GetIndices(CpuAffinity::kEfficiency).size();
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  const CpuSpeedTracker& tracker = GetCpuSpeedTracker();
+  if (!tracker.IsValid()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t index : tracker.GetIndices(affinity)) {
+    CPU_SET(index, &set);
+  }
+  return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+#else  // defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+
+std::optional<size_t> EfficiencyCoreCount() {
+  return std::nullopt;
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  return false;
+}
+
+#endif  // defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+
+}  // namespace fml
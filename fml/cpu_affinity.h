@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace fml {
+
+/// The set of cores a thread asks to run on.
+enum class CpuAffinity {
+  /// The fastest cores of the device.
+  kPerformance,
+
+  /// The slowest cores of the device.
+  kEfficiency,
+
+  /// Any core but the fastest ones.
+  kNotPerformance,
+};
+
+struct CpuIndexAndSpeed {
+  // The index of the core, as used by sched_setaffinity.
+  size_t index;
+  // The maximum frequency of the core. Only the order of the speeds matters.
+  int64_t speed;
+};
+
+/// Sorts the cores of a device by their speed.
+///
+/// The cores of a device whose cores all run at the same speed are not
+/// sorted, and no affinity is requested on such a device.
+class CpuSpeedTracker {
+ public:
+  explicit CpuSpeedTracker(std::vector<CpuIndexAndSpeed> data);
+
+  /// Whether the device has cores of more than one speed.
+  bool IsValid() const { return valid_; }
+
+  /// The indices of the cores in |affinity|, or an empty list if this tracker
+  /// is not valid.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  std::vector<CpuIndexAndSpeed> cpu_speeds_;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> performance_;
+  std::vector<size_t> not_performance_;
+};
+
+/// The number of efficiency cores of this device, or std::nullopt if this
+/// can't be told on this platform.
+std::optional<size_t> EfficiencyCoreCount();
+
+/// Asks for the current thread to run on the cores in |affinity|.
+///
+/// @return Whether the request was made. It is not on platforms that don't
+///         support it and on devices whose cores all run at the same speed.
+bool RequestAffinity(CpuAffinity affinity);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinity, CoresOfTheSameSpeedAreNotSorted) {
+  std::vector<CpuIndexAndSpeed> data = {
+      {.index = 0, .speed = 1},
+      {.index = 1, .speed = 1},
+  };
+  CpuSpeedTracker tracker(data);
+
+  ASSERT_FALSE(tracker.IsValid());
+  ASSERT_TRUE(tracker.GetIndices(CpuAffinity::kPerformance).empty());
+  ASSERT_TRUE(tracker.GetIndices(CpuAffinity::kEfficiency).empty());
+  ASSERT_TRUE(tracker.GetIndices(CpuAffinity::kNotPerformance).empty());
+}
+
+TEST(CpuAffinity, EmptyDataIsNotValid) {
+  CpuSpeedTracker tracker({});
+
+  ASSERT_FALSE(tracker.IsValid());
+}
+
+TEST(CpuAffinity, SortsCoresBySpeed) {
+  std::vector<CpuIndexAndSpeed> data = {
+      {.index = 0, .speed = 1},
+      {.index = 1, .speed = 1},
+      {.index = 2, .speed = 2},
+      {.index = 3, .speed = 2},
+      {.index = 4, .speed = 3},
+  };
+  CpuSpeedTracker tracker(data);
+
+  ASSERT_TRUE(tracker.IsValid());
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            std::vector<size_t>({4}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kEfficiency),
+            std::vector<size_t>({0, 1}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            std::vector<size_t>({0, 1, 2, 3}));
+}
+
+}  // namespace testing
+}  // namespace fml
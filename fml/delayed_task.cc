@@ -9,20 +9,22 @@
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
-                         const fml::closure& task,
+                         fml::UniqueClosure task,
                          fml::TimePoint target_time,
                          fml::TaskSourceGrade task_source_grade)
     : order_(order),
-      task_(task),
+      task_(std::move(task)),
       target_time_(target_time),
       task_source_grade_(task_source_grade) {}
 
 DelayedTask::~DelayedTask() = default;
 
-DelayedTask::DelayedTask(const DelayedTask& other) = default;
+DelayedTask::DelayedTask(DelayedTask&& other) = default;
 
-const fml::closure& DelayedTask::GetTask() const {
-  return task_;
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) = default;
+
+fml::UniqueClosure DelayedTask::TakeTask() const {
+  return std::move(task_);
 }
 
 fml::TimePoint DelayedTask::GetTargetTime() const {
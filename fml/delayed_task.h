@@ -7,24 +7,28 @@
 
 #include <queue>
 
-#include "flutter/fml/closure.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_closure.h"
 
 namespace fml {
 
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::UniqueClosure task,
               fml::TimePoint target_time,
               fml::TaskSourceGrade task_source_grade);
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  // Moves the task out. This is const because tasks are taken from the top of
+  // a |DelayedTaskQueue|, right before it is popped.
+  fml::UniqueClosure TakeTask() const;
 
   fml::TimePoint GetTargetTime() const;
 
@@ -34,7 +38,7 @@ class DelayedTask {
 
  private:
   size_t order_;
-  fml::closure task_;
+  mutable fml::UniqueClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
 };
@@ -11,6 +11,25 @@
 
 namespace fml {
 
+// Mapping
+
+void Mapping::ReadAhead(size_t offset, size_t length) const {
+  const uint8_t* mapping = GetMapping();
+  const size_t size = GetSize();
+  if (mapping == nullptr || offset >= size) {
+    return;
+  }
+  const size_t end = offset + std::min(length, size - offset);
+  // Touching one byte per page is enough to fault it in. Larger pages are
+  // just touched more than once.
+  constexpr size_t kPageSize = 4096;
+  volatile uint8_t sink = 0;
+  for (size_t i = offset; i < end; i += kPageSize) {
+    sink = sink + mapping[i];
+  }
+  sink = sink + mapping[end - 1];
+}
+
 // FileMapping
 
 uint8_t* FileMapping::GetMutableMapping() {
@@ -32,6 +32,12 @@ class Mapping {
   // Generally true for file-mapped memory and false for anonymous memory.
   virtual bool IsDontNeedSafe() const = 0;
 
+  // Reads the pages of the given range into memory, so that later accesses to
+  // the range don't fault on them. This blocks until the pages are read, so it
+  // is meant to be called on another thread than the ones that read the
+  // mapping, such as the IO thread. The range is clamped to the mapping.
+  virtual void ReadAhead(size_t offset, size_t length) const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -44,9 +50,20 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  // How the pages of the mapping are read from the file.
+  enum class Paging {
+    // Each page is read when it is first accessed.
+    kOnDemand,
+    // All the pages are read as the mapping is created, and large mappings
+    // are backed by huge pages where the kernel supports it for files. For
+    // files that are read in full, such as snapshots and fonts.
+    kPrefault,
+  };
+
   explicit FileMapping(const fml::UniqueFD& fd,
                        std::initializer_list<Protection> protection = {
-                           Protection::kRead});
+                           Protection::kRead},
+                       Paging paging = Paging::kOnDemand);
 
   ~FileMapping() override;
 
@@ -72,6 +89,9 @@ class FileMapping final : public Mapping {
   // |Mapping|
   bool IsDontNeedSafe() const override;
 
+  // |Mapping|
+  void ReadAhead(size_t offset, size_t length) const override;
+
   uint8_t* GetMutableMapping();
 
   bool IsValid() const;
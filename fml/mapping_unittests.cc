@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/fml/mapping.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
 #include "flutter/testing/testing.h"
 
 namespace fml {
@@ -67,4 +71,30 @@ TEST(MallocMapping, CopySizeZero) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(DataMapping, ReadAheadClampsTheRange) {
+  DataMapping mapping(std::string("hello"));
+  mapping.ReadAhead(0, 100);
+  mapping.ReadAhead(3, 100);
+  mapping.ReadAhead(5, 1);
+  ASSERT_EQ(5u, mapping.GetSize());
+}
+
+TEST(FileMapping, PrefaultedMappingHasTheFileContents) {
+  ScopedTemporaryDirectory dir;
+  // Larger than a huge page, so that the mapping may be backed by them.
+  std::string contents(3 * 1024 * 1024, 'x');
+  contents.back() = 'y';
+  DataMapping data(contents);
+  ASSERT_TRUE(WriteAtomically(dir.fd(), "large.bin", data));
+
+  auto fd = OpenFile(dir.fd(), "large.bin", false, FilePermission::kRead);
+  ASSERT_TRUE(fd.is_valid());
+  FileMapping mapping(fd, {FileMapping::Protection::kRead},
+                      FileMapping::Paging::kPrefault);
+  ASSERT_TRUE(mapping.IsValid());
+  ASSERT_EQ(contents.size(), mapping.GetSize());
+  mapping.ReadAhead(1, mapping.GetSize());
+  ASSERT_EQ(0, memcmp(mapping.GetMapping(), contents.data(), contents.size()));
+}
+
 }  // namespace fml
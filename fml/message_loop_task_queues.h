@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -18,6 +19,7 @@
 #include "flutter/fml/synchronization/shared_mutex.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source.h"
+#include "flutter/fml/unique_closure.h"
 #include "flutter/fml/wakeable.h"
 
 namespace fml {
@@ -46,6 +48,11 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards the wakeable, observers and tasks of this TaskQueue and of every
+  /// TaskQueue it owns. The mutex of a subsumed TaskQueue is not used while it
+  /// is merged.
+  std::mutex mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -78,14 +85,15 @@ class MessageLoopTaskQueues {
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::UniqueClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
                         fml::TaskSourceGrade::kUnspecified);
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::UniqueClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                      fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
@@ -144,15 +152,28 @@ class MessageLoopTaskQueues {
 
   ~MessageLoopTaskQueues();
 
+  /// The mutex that must be held to access the tasks, observers or wakeable of
+  /// the queue. This is the mutex of the owner if the queue is merged.
+  std::mutex& GetQueueGroupMutexUnlocked(TaskQueueId queue_id) const;
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
   TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
 
+  /// Like |PeekNextTaskUnlocked| but tasks critical to user interaction that
+  /// are due by |from_time| come first.
+  TaskSource::TopTask PeekNextTaskToRunUnlocked(TaskQueueId owner,
+                                                fml::TimePoint from_time) const;
+
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Guards the entries map and the merged state of every entry. It is only
+  // held exclusively when queues are created, disposed, merged or unmerged.
+  // Everything else holds it shared along with the mutex of the affected
+  // queue group. So loops on different threads don't contend with each other.
+  std::unique_ptr<fml::SharedMutex> queue_meta_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
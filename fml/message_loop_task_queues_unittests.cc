@@ -108,7 +108,7 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::UniqueClosure invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -148,7 +148,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -191,7 +192,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -210,7 +212,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -220,14 +223,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -413,6 +418,90 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that no tasks are lost when queues are merged and unmerged while
+/// tasks are being added to them.
+///
+TEST(MessageLoopTaskQueue, ConcurrentRegisterTaskWhileMerging) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+
+  constexpr size_t kThreadTaskCount = 1000;
+  constexpr size_t kMergeCount = 100;
+
+  const auto platform_queue = task_queues->CreateTaskQueue();
+  const auto raster_queue = task_queues->CreateTaskQueue();
+
+  auto thread_main = [&](TaskQueueId queue_id) {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(
+          queue_id, []() {}, ChronoTicksSinceEpoch());
+    }
+  };
+
+  std::thread platform_thread(thread_main, platform_queue);
+  std::thread raster_thread(thread_main, raster_queue);
+  for (size_t i = 0; i < kMergeCount; i++) {
+    ASSERT_TRUE(task_queues->Merge(platform_queue, raster_queue));
+    ASSERT_TRUE(task_queues->Unmerge(platform_queue, raster_queue));
+  }
+  platform_thread.join();
+  raster_thread.join();
+
+  ASSERT_EQ(task_queues->GetNumPendingTasks(platform_queue), kThreadTaskCount);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(raster_queue), kThreadTaskCount);
+}
+
+TEST(MessageLoopTaskQueue, DueUserInteractionTasksRunFirst) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto now = ChronoTicksSinceEpoch();
+  const auto past = now - fml::TimeDelta::FromMilliseconds(10);
+  const auto future = now + fml::TimeDelta::FromMilliseconds(10);
+
+  int value = 0;
+  task_queue->RegisterTask(
+      queue_id, [&value]() { value = 1; }, past);
+  task_queue->RegisterTask(
+      queue_id, [&value]() { value = 2; }, future,
+      fml::TaskSourceGrade::kUserInteraction);
+  task_queue->RegisterTask(
+      queue_id, [&value]() { value = 3; }, now,
+      fml::TaskSourceGrade::kUserInteraction);
+
+  std::vector<int> run_order;
+  while (auto task = task_queue->GetNextTaskToRun(queue_id, now)) {
+    task();
+    run_order.push_back(value);
+  }
+  ASSERT_EQ(run_order, (std::vector<int>{3, 1}));
+
+  auto task = task_queue->GetNextTaskToRun(queue_id, future);
+  ASSERT_TRUE(task);
+  task();
+  ASSERT_EQ(value, 2);
+}
+
+TEST(MessageLoopTaskQueue, DueUserInteractionTasksRunFirstOnMergedQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queue->CreateTaskQueue();
+  auto raster_queue = task_queue->CreateTaskQueue();
+  const auto now = ChronoTicksSinceEpoch();
+
+  int value = 0;
+  task_queue->RegisterTask(
+      platform_queue, [&value]() { value = 1; },
+      now - fml::TimeDelta::FromMilliseconds(10));
+  task_queue->RegisterTask(
+      raster_queue, [&value]() { value = 2; }, now,
+      fml::TaskSourceGrade::kUserInteraction);
+  ASSERT_TRUE(task_queue->Merge(platform_queue, raster_queue));
+
+  auto task = task_queue->GetNextTaskToRun(platform_queue, now);
+  ASSERT_TRUE(task);
+  task();
+  ASSERT_EQ(value, 2);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -6,6 +6,7 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <atomic>
 #include <iostream>
 #include <thread>
 
@@ -339,3 +340,40 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedFromWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kCount = 100;
+  // Also wait for the outer tasks so that the loop never outlives the test on
+  // a worker holding the last reference to it.
+  fml::CountDownLatch latch(kCount * kCount + kCount);
+  std::atomic_size_t run_count = 0u;
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      for (size_t j = 0; j < kCount; ++j) {
+        task_runner->PostTask([&]() {
+          run_count++;
+          latch.CountDown();
+        });
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  ASSERT_EQ(run_count.load(), kCount * kCount);
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopCanPostTaskToAllWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  fml::CountDownLatch latch(loop->GetWorkerCount());
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    std::scoped_lock lock(thread_ids_mutex);
+    thread_ids.insert(std::this_thread::get_id());
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), loop->GetWorkerCount());
+}
@@ -9,6 +9,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <type_traits>
 
 #include "flutter/fml/build_config.h"
@@ -50,8 +51,12 @@ Mapping::Mapping() = default;
 
 Mapping::~Mapping() = default;
 
+// Mappings this large may be backed by huge pages.
+static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
 FileMapping::FileMapping(const fml::UniqueFD& handle,
-                         std::initializer_list<Protection> protection) {
+                         std::initializer_list<Protection> protection,
+                         Paging paging) {
   if (!handle.is_valid()) {
     return;
   }
@@ -69,14 +74,33 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
 
   const auto is_writable = IsWritable(protection);
 
+  int flags = is_writable ? MAP_SHARED : MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  if (paging == Paging::kPrefault) {
+    flags |= MAP_POPULATE;
+  }
+#endif  // defined(MAP_POPULATE)
+
   auto* mapping =
       ::mmap(nullptr, stat_buffer.st_size, ToPosixProtectionFlags(protection),
-             is_writable ? MAP_SHARED : MAP_PRIVATE, handle.get(), 0);
+             flags, handle.get(), 0);
 
   if (mapping == MAP_FAILED) {
     return;
   }
 
+  if (paging == Paging::kPrefault) {
+    // The advice is only a hint, so failures are ignored.
+#if defined(MADV_HUGEPAGE)
+    if (static_cast<size_t>(stat_buffer.st_size) >= kHugePageSize) {
+      ::madvise(mapping, stat_buffer.st_size, MADV_HUGEPAGE);
+    }
+#endif  // defined(MADV_HUGEPAGE)
+#if !defined(MAP_POPULATE)
+    ::madvise(mapping, stat_buffer.st_size, MADV_WILLNEED);
+#endif  // !defined(MAP_POPULATE)
+  }
+
   mapping_ = static_cast<uint8_t*>(mapping);
   size_ = stat_buffer.st_size;
   valid_ = true;
@@ -107,4 +131,18 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+void FileMapping::ReadAhead(size_t offset, size_t length) const {
+  if (mapping_ == nullptr || offset >= size_) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+  // Asks the kernel to read the whole range at once instead of a page fault
+  // at a time, then waits for it by touching the pages.
+  const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  const size_t aligned_offset = offset - offset % page_size;
+  ::madvise(mapping_ + aligned_offset, offset + length - aligned_offset,
+            MADV_WILLNEED);
+  Mapping::ReadAhead(offset, length);
+}
+
 }  // namespace fml
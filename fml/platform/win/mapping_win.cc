@@ -41,7 +41,8 @@ static bool IsExecutable(
 }
 
 FileMapping::FileMapping(const fml::UniqueFD& fd,
-                         std::initializer_list<Protection> protections)
+                         std::initializer_list<Protection> protections,
+                         Paging paging)
     : size_(0), mapping_(nullptr) {
   if (!fd.is_valid()) {
     return;
@@ -99,6 +100,10 @@ FileMapping::FileMapping(const fml::UniqueFD& fd,
   if (IsWritable(protections)) {
     mutable_mapping_ = mapping_;
   }
+  if (paging == Paging::kPrefault) {
+    // There is no equivalent of MAP_POPULATE for views of files.
+    ReadAhead(0, size_);
+  }
 }
 
 FileMapping::~FileMapping() {
@@ -123,4 +128,8 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+void FileMapping::ReadAhead(size_t offset, size_t length) const {
+  Mapping::ReadAhead(offset, length);
+}
+
 }  // namespace fml
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_POST_TASK_AND_REPLY_H_
+#define FLUTTER_FML_POST_TASK_AND_REPLY_H_
+
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs |task| on |task_runner|, and then |reply| on
+///             |reply_runner| with the value that |task| returns.
+///
+///             This lets work that hops between threads, such as decoding an
+///             image on a worker and uploading it on the IO thread, be
+///             written as a sequence of steps instead of as tasks nested in
+///             tasks, and without blocking a thread on a latch until the
+///             previous step is done. The value may be move-only, and is
+///             moved from the thread of |task| to the thread of |reply|.
+///
+/// @param[in]  task_runner   The task runner to run |task| on.
+/// @param[in]  task          A callable taking no arguments. What it returns
+///                           is passed to |reply|.
+/// @param[in]  reply_runner  The task runner to run |reply| on.
+/// @param[in]  reply         A callable taking the value returned by |task|.
+///
+template <typename Task, typename Reply>
+void PostTaskAndReplyWithResult(BasicTaskRunner* task_runner,
+                                Task task,
+                                RefPtr<TaskRunner> reply_runner,
+                                Reply reply) {
+  using Result = std::invoke_result_t<Task&>;
+  static_assert(!std::is_void_v<Result>, "The task must return a value.");
+  static_assert(std::is_invocable_v<Reply&, Result>,
+                "The reply must take the value returned by the task.");
+  FML_DCHECK(task_runner);
+  FML_DCHECK(reply_runner);
+  task_runner->PostTask([task = std::move(task),
+                         reply_runner = std::move(reply_runner),
+                         reply = std::move(reply)]() mutable {
+    reply_runner->PostTask(
+        [reply = std::move(reply), result = task()]() mutable {
+          reply(std::move(result));
+        });
+  });
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_POST_TASK_AND_REPLY_H_
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/post_task_and_reply.h"
+
+#include <memory>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(PostTaskAndReplyTest, RepliesOnTheReplyRunnerWithTheResult) {
+  fml::Thread task_thread("task");
+  fml::Thread reply_thread("reply");
+  auto task_runner = task_thread.GetTaskRunner();
+  auto reply_runner = reply_thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent latch;
+  bool task_on_task_runner = false;
+  bool reply_on_reply_runner = false;
+  int result = 0;
+
+  PostTaskAndReplyWithResult(
+      task_runner.get(),
+      [&]() {
+        task_on_task_runner = task_runner->RunsTasksOnCurrentThread();
+        return 42;
+      },
+      reply_runner,
+      [&](int value) {
+        reply_on_reply_runner = reply_runner->RunsTasksOnCurrentThread();
+        result = value;
+        latch.Signal();
+      });
+  latch.Wait();
+
+  EXPECT_TRUE(task_on_task_runner);
+  EXPECT_TRUE(reply_on_reply_runner);
+  EXPECT_EQ(result, 42);
+}
+
+TEST(PostTaskAndReplyTest, MovesMoveOnlyResultsAndCallables) {
+  fml::Thread task_thread("task");
+  fml::Thread reply_thread("reply");
+  fml::AutoResetWaitableEvent latch;
+  auto value = std::make_unique<int>(7);
+  int result = 0;
+
+  PostTaskAndReplyWithResult(
+      task_thread.GetTaskRunner().get(),
+      [value = std::move(value)]() mutable { return std::move(value); },
+      reply_thread.GetTaskRunner(),
+      [&result, &latch](std::unique_ptr<int> moved) {
+        result = *moved;
+        latch.Signal();
+      });
+  latch.Wait();
+
+  EXPECT_EQ(result, 7);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -135,6 +135,10 @@ bool RasterThreadMerger::IsEnabled() {
   return IsEnabledUnSafe();
 }
 
+void RasterThreadMerger::SetLeaseHysteresisEnabled(bool enabled) {
+  shared_merger_->SetLeaseHysteresisEnabled(enabled);
+}
+
 bool RasterThreadMerger::IsEnabledUnSafe() const {
   return shared_merger_->IsEnabledUnSafe();
 }
@@ -160,6 +164,12 @@ RasterThreadStatus RasterThreadMerger::DecrementLease() {
   if (TaskQueuesAreSame()) {
     return RasterThreadStatus::kRemainsMerged;
   }
+  // Most frames are rasterized while the threads are unmerged, so check that
+  // without taking the lock first. A merge that races with the check only
+  // starts counting down on the next frame.
+  if (!shared_merger_->IsMergedUnSafe()) {
+    return RasterThreadStatus::kRemainsUnmerged;
+  }
   std::scoped_lock lock(mutex_);
   if (!IsMergedUnSafe()) {
     return RasterThreadStatus::kRemainsUnmerged;
@@ -106,6 +106,14 @@ class RasterThreadMerger
   // or |ExtendLeaseTo| or |DecrementLease| results in a noop.
   bool IsEnabled();
 
+  // Enables lease hysteresis, which is disabled by default. While enabled,
+  // merging the threads again soon after they were unmerged lengthens the
+  // lease terms, so that a platform view that keeps appearing and disappearing
+  // doesn't merge and unmerge the threads every few frames.
+  //
+  // See |SharedThreadMerger::kRemergeWindow|.
+  void SetLeaseHysteresisEnabled(bool enabled);
+
   // Registers a callback that can be used to clean up global state right after
   // the thread configuration has changed.
   //
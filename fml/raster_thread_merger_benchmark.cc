@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/fml/raster_thread_merger.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/message_loop_task_queues.h"
+
+namespace fml {
+namespace benchmarking {
+
+static void BM_MergeAndUnmerge(benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(
+          task_queues->CreateTaskQueue(), task_queues->CreateTaskQueue());
+  while (state.KeepRunning()) {
+    raster_thread_merger->MergeWithLease(1);
+    raster_thread_merger->DecrementLease();
+  }
+}
+
+static void BM_DecrementLeaseWhileUnmerged(benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(
+          task_queues->CreateTaskQueue(), task_queues->CreateTaskQueue());
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(raster_thread_merger->DecrementLease());
+  }
+}
+
+BENCHMARK(BM_MergeAndUnmerge);
+BENCHMARK(BM_DecrementLeaseWhileUnmerged);
+
+}  // namespace benchmarking
+}  // namespace fml
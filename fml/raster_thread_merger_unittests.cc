@@ -657,5 +657,79 @@ TEST(RasterThreadMerger,
   ASSERT_FALSE(merger_from_3_to_1->IsMerged());
 }
 
+TEST(RasterThreadMerger, QuickRemergeLengthensLeaseWithHysteresis) {
+  TaskQueueWrapper queue1;
+  TaskQueueWrapper queue2;
+  fml::TaskQueueId qid1 = queue1.GetTaskQueueId();
+  fml::TaskQueueId qid2 = queue2.GetTaskQueueId();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+  const auto& shared_merger =
+      raster_thread_merger->GetSharedRasterThreadMerger();
+  raster_thread_merger->SetLeaseHysteresisEnabled(true);
+  const size_t kNumFramesMerged = 2;
+
+  // The first merge isn't lengthened.
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  ASSERT_EQ(shared_merger->GetLeaseMultiplier(), 1u);
+  raster_thread_merger->UnMergeNowIfLastOne();
+
+  // Merging right after unmerging doubles the lease.
+  raster_thread_merger->MergeWithLease(kNumFramesMerged);
+  ASSERT_EQ(shared_merger->GetLeaseMultiplier(), 2u);
+  for (size_t i = 0; i < kNumFramesMerged * 2; i++) {
+    ASSERT_TRUE(raster_thread_merger->IsMerged());
+    raster_thread_merger->DecrementLease();
+  }
+  ASSERT_FALSE(raster_thread_merger->IsMerged());
+
+  // The lease stops growing at the maximum.
+  for (size_t i = 0; i < 4; i++) {
+    raster_thread_merger->MergeWithLease(kNumFramesMerged);
+    raster_thread_merger->UnMergeNowIfLastOne();
+  }
+  ASSERT_EQ(shared_merger->GetLeaseMultiplier(),
+            fml::SharedThreadMerger::kMaxLeaseMultiplier);
+}
+
+TEST(RasterThreadMerger, QuickRemergeKeepsLeaseWithoutHysteresis) {
+  TaskQueueWrapper queue1;
+  TaskQueueWrapper queue2;
+  fml::TaskQueueId qid1 = queue1.GetTaskQueueId();
+  fml::TaskQueueId qid2 = queue2.GetTaskQueueId();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+  const size_t kNumFramesMerged = 2;
+
+  for (size_t i = 0; i < 3; i++) {
+    raster_thread_merger->MergeWithLease(kNumFramesMerged);
+    for (size_t j = 0; j < kNumFramesMerged; j++) {
+      ASSERT_TRUE(raster_thread_merger->IsMerged());
+      raster_thread_merger->DecrementLease();
+    }
+    ASSERT_FALSE(raster_thread_merger->IsMerged());
+  }
+  ASSERT_EQ(
+      raster_thread_merger->GetSharedRasterThreadMerger()->GetLeaseMultiplier(),
+      1u);
+}
+
+TEST(RasterThreadMerger, DecrementLeaseWhileUnmergedRemainsUnmerged) {
+  TaskQueueWrapper queue1;
+  TaskQueueWrapper queue2;
+  fml::TaskQueueId qid1 = queue1.GetTaskQueueId();
+  fml::TaskQueueId qid2 = queue2.GetTaskQueueId();
+  const auto raster_thread_merger =
+      fml::MakeRefCounted<fml::RasterThreadMerger>(qid1, qid2);
+
+  ASSERT_EQ(raster_thread_merger->DecrementLease(),
+            fml::RasterThreadStatus::kRemainsUnmerged);
+  raster_thread_merger->MergeWithLease(1);
+  ASSERT_EQ(raster_thread_merger->DecrementLease(),
+            fml::RasterThreadStatus::kUnmergedNow);
+  ASSERT_EQ(raster_thread_merger->DecrementLease(),
+            fml::RasterThreadStatus::kRemainsUnmerged);
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -25,19 +25,34 @@ bool SharedThreadMerger::MergeWithLease(RasterThreadMergerId caller,
   if (IsMergedUnSafe()) {
     return true;
   }
+  // Merging only makes the platform task queue run the raster tasks. No task
+  // is moved between the queues.
   bool success = task_queues_->Merge(owner_, subsumed_);
   FML_CHECK(success) << "Unable to merge the raster and platform threads.";
+  UpdateLeaseMultiplierUnSafe();
   // Save the lease term
-  lease_term_by_caller_[caller] = lease_term;
+  lease_term_by_caller_[caller] = lease_term * lease_multiplier_;
+  merged_ = true;
   return success;
 }
 
+void SharedThreadMerger::UpdateLeaseMultiplierUnSafe() {
+  if (!lease_hysteresis_enabled_ || !last_unmerge_time_.has_value() ||
+      fml::TimePoint::Now() - last_unmerge_time_.value() > kRemergeWindow) {
+    lease_multiplier_ = 1u;
+    return;
+  }
+  lease_multiplier_ = std::min(lease_multiplier_ * 2u, kMaxLeaseMultiplier);
+}
+
 bool SharedThreadMerger::UnMergeNowUnSafe() {
   FML_CHECK(IsAllLeaseTermsZeroUnSafe())
       << "all lease term records must be zero before calling "
          "UnMergeNowUnSafe()";
   bool success = task_queues_->Unmerge(owner_, subsumed_);
   FML_CHECK(success) << "Unable to un-merge the raster and platform threads.";
+  merged_ = false;
+  last_unmerge_time_ = fml::TimePoint::Now();
   return success;
 }
 
@@ -80,11 +95,21 @@ void SharedThreadMerger::ExtendLeaseTo(RasterThreadMergerId caller,
   std::scoped_lock lock(mutex_);
   FML_DCHECK(IsMergedUnSafe())
       << "should be merged state when calling this method";
-  lease_term_by_caller_[caller] = lease_term;
+  lease_term_by_caller_[caller] = lease_term * lease_multiplier_;
 }
 
 bool SharedThreadMerger::IsMergedUnSafe() const {
-  return !IsAllLeaseTermsZeroUnSafe();
+  return merged_;
+}
+
+void SharedThreadMerger::SetLeaseHysteresisEnabled(bool enabled) {
+  std::scoped_lock lock(mutex_);
+  lease_hysteresis_enabled_ = enabled;
+}
+
+size_t SharedThreadMerger::GetLeaseMultiplier() {
+  std::scoped_lock lock(mutex_);
+  return lease_multiplier_;
 }
 
 bool SharedThreadMerger::IsEnabledUnSafe() const {
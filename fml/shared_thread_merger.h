@@ -5,12 +5,17 @@
 #ifndef FLUTTER_FML_SHARED_THREAD_MERGER_H_
 #define FLUTTER_FML_SHARED_THREAD_MERGER_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <map>
 #include <mutex>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
@@ -24,6 +29,14 @@ typedef void* RasterThreadMergerId;
 class SharedThreadMerger
     : public fml::RefCountedThreadSafe<SharedThreadMerger> {
  public:
+  /// Merges that start this soon after the threads were unmerged double the
+  /// lease terms of the callers, up to |kMaxLeaseMultiplier| times the terms
+  /// they ask for, while lease hysteresis is enabled.
+  static constexpr fml::TimeDelta kRemergeWindow =
+      fml::TimeDelta::FromMilliseconds(500);
+
+  static constexpr size_t kMaxLeaseMultiplier = 8u;
+
   SharedThreadMerger(TaskQueueId owner, TaskQueueId subsumed);
 
   // It's called by |RasterThreadMerger::MergeWithLease|.
@@ -40,6 +53,9 @@ class SharedThreadMerger
 
   // It's called by |RasterThreadMerger::IsMergedUnSafe|.
   // See the doc of |RasterThreadMerger::IsMergedUnSafe|.
+  //
+  // Doesn't take the lock, so it can be called on every frame without
+  // contending with the callers that merge or unmerge the threads.
   bool IsMergedUnSafe() const;
 
   // It's called by |RasterThreadMerger::IsEnabledUnSafe|.
@@ -54,12 +70,25 @@ class SharedThreadMerger
   // See the doc of |RasterThreadMerger::DecrementLease|.
   bool DecrementLease(RasterThreadMergerId caller);
 
+  // It's called by |RasterThreadMerger::SetLeaseHysteresisEnabled|.
+  // See the doc of |RasterThreadMerger::SetLeaseHysteresisEnabled|.
+  void SetLeaseHysteresisEnabled(bool enabled);
+
+  // The number of times the lease terms of the callers are multiplied by.
+  size_t GetLeaseMultiplier();
+
  private:
   fml::TaskQueueId owner_;
   fml::TaskQueueId subsumed_;
   fml::MessageLoopTaskQueues* task_queues_;
   std::mutex mutex_;
   bool enabled_;
+  // Whether the queues are merged, which is whether any lease term is not
+  // zero. Written with |mutex_| held.
+  std::atomic_bool merged_ = false;
+  bool lease_hysteresis_enabled_ = false;
+  size_t lease_multiplier_ = 1u;
+  std::optional<fml::TimePoint> last_unmerge_time_;
 
   /// The |MergeWithLease| or |ExtendLeaseTo| method will record the caller
   /// into this lease_term_by_caller_ map, |UnMergeNowIfLastOne|
@@ -70,6 +99,9 @@ class SharedThreadMerger
 
   bool UnMergeNowUnSafe();
 
+  // Called when the threads get merged.
+  void UpdateLeaseMultiplierUnSafe();
+
   FML_DISALLOW_COPY_AND_ASSIGN(SharedThreadMerger);
 };
 
@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_WORK_STEALING_DEQUE_H_
+#define FLUTTER_FML_SYNCHRONIZATION_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+// A lock-free deque of pointers with a single owner. The owning thread pushes
+// and pops at the bottom. Any thread may steal from the top.
+//
+// This is the Chase-Lev deque with the memory orderings described in "Correct
+// and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013). The
+// deque does not own the items it holds.
+template <typename T>
+class WorkStealingDeque {
+ public:
+  explicit WorkStealingDeque(size_t capacity = 64u)
+      : ring_(new Ring(RoundUpToPowerOfTwo(capacity))) {
+    retired_rings_.emplace_back(ring_.load(std::memory_order_relaxed));
+  }
+
+  ~WorkStealingDeque() = default;
+
+  // Must only be called on the owning thread.
+  void Push(T* item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (bottom - top > ring->capacity - 1) {
+      ring = Grow(ring, bottom, top);
+    }
+    ring->Put(bottom, item);
+    // The paper uses a release fence followed by a relaxed store. A release
+    // store is at least as strong and is understood by thread sanitizer.
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Must only be called on the owning thread. Returns nullptr if the deque is
+  // empty.
+  T* Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T* item = ring->Get(bottom);
+    if (top == bottom) {
+      // The last item. Race any thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // May be called on any thread. Returns nullptr if the deque is empty or if
+  // another thread took the item first.
+  T* Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    T* item = ring->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  // An estimate that may be stale by the time it is returned.
+  bool IsEmpty() const {
+    return bottom_.load(std::memory_order_relaxed) <=
+           top_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Ring {
+    explicit Ring(int64_t p_capacity)
+        : capacity(p_capacity),
+          mask(p_capacity - 1),
+          items(new std::atomic<T*>[p_capacity]) {}
+
+    T* Get(int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, T* item) {
+      items[index & mask].store(item, std::memory_order_relaxed);
+    }
+
+    const int64_t capacity;
+    const int64_t mask;
+    std::unique_ptr<std::atomic<T*>[]> items;
+  };
+
+  // Top and bottom are written by different threads. Keep them on separate
+  // cache lines.
+  alignas(64) std::atomic<int64_t> top_ = 0;
+  alignas(64) std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Ring*> ring_;
+  // Only accessed by the owner. Thieves may still be reading from rings that
+  // have been outgrown. So every ring is kept till the deque is destroyed.
+  std::vector<std::unique_ptr<Ring>> retired_rings_;
+
+  static int64_t RoundUpToPowerOfTwo(size_t value) {
+    int64_t result = 1;
+    while (result < static_cast<int64_t>(value)) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  Ring* Grow(Ring* ring, int64_t bottom, int64_t top) {
+    auto grown = new Ring(ring->capacity * 2);
+    for (int64_t i = top; i < bottom; i++) {
+      grown->Put(i, ring->Get(i));
+    }
+    retired_rings_.emplace_back(grown);
+    ring_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_WORK_STEALING_DEQUE_H_
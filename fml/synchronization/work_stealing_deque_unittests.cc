@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace fml {
+
+TEST(WorkStealingDequeTest, PopIsLastInFirstOut) {
+  WorkStealingDeque<int> deque;
+  int items[] = {1, 2, 3};
+  for (auto& item : items) {
+    deque.Push(&item);
+  }
+  ASSERT_EQ(deque.Pop(), &items[2]);
+  ASSERT_EQ(deque.Pop(), &items[1]);
+  ASSERT_EQ(deque.Pop(), &items[0]);
+  ASSERT_EQ(deque.Pop(), nullptr);
+  ASSERT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, StealIsFirstInFirstOut) {
+  WorkStealingDeque<int> deque;
+  int items[] = {1, 2, 3};
+  for (auto& item : items) {
+    deque.Push(&item);
+  }
+  ASSERT_EQ(deque.Steal(), &items[0]);
+  ASSERT_EQ(deque.Steal(), &items[1]);
+  ASSERT_EQ(deque.Pop(), &items[2]);
+  ASSERT_EQ(deque.Steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+  WorkStealingDeque<size_t> deque(4u);
+  std::vector<size_t> items(100u);
+  for (size_t i = 0; i < items.size(); i++) {
+    items[i] = i;
+    deque.Push(&items[i]);
+  }
+  for (size_t i = 0; i < items.size(); i++) {
+    auto item = deque.Steal();
+    ASSERT_NE(item, nullptr);
+    ASSERT_EQ(*item, i);
+  }
+  ASSERT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, EachItemIsTakenOnceUnderContention) {
+  const size_t kItemCount = 100000u;
+  const size_t kThiefCount = 4u;
+  WorkStealingDeque<std::atomic_size_t> deque(8u);
+  std::vector<std::atomic_size_t> items(kItemCount);
+  std::atomic_size_t taken = 0u;
+  std::atomic_bool done_pushing = false;
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefCount; i++) {
+    thieves.emplace_back([&]() {
+      while (!done_pushing || !deque.IsEmpty()) {
+        if (auto item = deque.Steal()) {
+          item->fetch_add(1u);
+          taken.fetch_add(1u);
+        }
+      }
+    });
+  }
+
+  for (size_t i = 0; i < kItemCount; i++) {
+    deque.Push(&items[i]);
+    // Race the thieves for some of the items.
+    if (i % 3u == 0u) {
+      if (auto item = deque.Pop()) {
+        item->fetch_add(1u);
+        taken.fetch_add(1u);
+      }
+    }
+  }
+  while (auto item = deque.Pop()) {
+    item->fetch_add(1u);
+    taken.fetch_add(1u);
+  }
+  done_pushing = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  ASSERT_EQ(taken.load(), kItemCount);
+  for (const auto& item : items) {
+    ASSERT_EQ(item.load(), 1u);
+  }
+}
+
+}  // namespace fml
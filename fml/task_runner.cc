@@ -21,18 +21,31 @@ TaskRunner::TaskRunner(fml::RefPtr<MessageLoopImpl> loop)
 
 TaskRunner::~TaskRunner() = default;
 
-void TaskRunner::PostTask(const fml::closure& task) {
-  loop_->PostTask(task, fml::TimePoint::Now());
+void TaskRunner::PostTask(fml::UniqueClosure task) {
+  loop_->PostTask(std::move(task), fml::TimePoint::Now());
 }
 
-void TaskRunner::PostTaskForTime(const fml::closure& task,
+void TaskRunner::PostTaskForTime(fml::UniqueClosure task,
                                  fml::TimePoint target_time) {
-  loop_->PostTask(task, target_time);
+  loop_->PostTask(std::move(task), target_time);
 }
 
-void TaskRunner::PostDelayedTask(const fml::closure& task,
+void TaskRunner::PostDelayedTask(fml::UniqueClosure task,
                                  fml::TimeDelta delay) {
-  loop_->PostTask(task, fml::TimePoint::Now() + delay);
+  loop_->PostTask(std::move(task), fml::TimePoint::Now() + delay);
+}
+
+void TaskRunner::PostTaskWithGrade(fml::UniqueClosure task,
+                                   fml::TaskSourceGrade task_source_grade) {
+  PostTaskForTimeWithGrade(std::move(task), fml::TimePoint::Now(),
+                           task_source_grade);
+}
+
+void TaskRunner::PostTaskForTimeWithGrade(
+    fml::UniqueClosure task,
+    fml::TimePoint target_time,
+    fml::TaskSourceGrade task_source_grade) {
+  loop_->PostTask(std::move(task), target_time, task_source_grade);
 }
 
 TaskQueueId TaskRunner::GetTaskQueueId() {
@@ -53,12 +66,12 @@ bool TaskRunner::RunsTasksOnCurrentThread() {
 }
 
 void TaskRunner::RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
-                                  const fml::closure& task) {
+                                  fml::UniqueClosure task) {
   FML_DCHECK(runner);
   if (runner->RunsTasksOnCurrentThread()) {
     task();
   } else {
-    runner->PostTask(task);
+    runner->PostTask(std::move(task));
   }
 }
 
@@ -11,6 +11,7 @@
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_closure.h"
 
 namespace fml {
 
@@ -20,8 +21,9 @@ class MessageLoopImpl;
 class BasicTaskRunner {
  public:
   /// Schedules \p task to be executed on the TaskRunner's associated event
-  /// loop.
-  virtual void PostTask(const fml::closure& task) = 0;
+  /// loop. Tasks are move-only, so lambdas with move-only captures can be
+  /// posted as is, and small ones are queued without a heap allocation.
+  virtual void PostTask(fml::UniqueClosure task) = 0;
 };
 
 /// The object for scheduling tasks on a \p fml::MessageLoop.
@@ -36,9 +38,9 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
  public:
   virtual ~TaskRunner();
 
-  virtual void PostTask(const fml::closure& task) override;
+  virtual void PostTask(fml::UniqueClosure task) override;
 
-  virtual void PostTaskForTime(const fml::closure& task,
+  virtual void PostTaskForTime(fml::UniqueClosure task,
                                fml::TimePoint target_time);
 
   /// Schedules a task to be run on the MessageLoop after the time \p delay has
@@ -47,7 +49,19 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// executed so that the actual execution time is: now + delay +
   /// message_loop_latency, where message_loop_latency is undefined and could be
   /// tens of milliseconds.
-  virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
+  virtual void PostDelayedTask(fml::UniqueClosure task, fml::TimeDelta delay);
+
+  /// Schedules \p task to be run on the MessageLoop as soon as possible. Tasks
+  /// posted with \p TaskSourceGrade::kUserInteraction run ahead of the other
+  /// tasks that are already due, such as a backlog of platform messages.
+  virtual void PostTaskWithGrade(fml::UniqueClosure task,
+                                 fml::TaskSourceGrade task_source_grade);
+
+  /// Like \p PostTaskWithGrade but the task doesn't run before \p
+  /// target_time.
+  virtual void PostTaskForTimeWithGrade(fml::UniqueClosure task,
+                                        fml::TimePoint target_time,
+                                        fml::TaskSourceGrade task_source_grade);
 
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
@@ -60,7 +74,7 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// Executes the \p task directly if the TaskRunner \p runner is the
   /// TaskRunner associated with the current executing thread.
   static void RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
-                               const fml::closure& task);
+                               fml::UniqueClosure task);
 
  protected:
   explicit TaskRunner(fml::RefPtr<MessageLoopImpl> loop);
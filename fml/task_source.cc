@@ -16,20 +16,21 @@ TaskSource::~TaskSource() {
 }
 
 void TaskSource::ShutDown() {
+  user_interaction_task_queue_ = {};
   primary_task_queue_ = {};
   secondary_task_queue_ = {};
 }
 
-void TaskSource::RegisterTask(const DelayedTask& task) {
+void TaskSource::RegisterTask(DelayedTask task) {
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      user_interaction_task_queue_.push(std::move(task));
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
+      primary_task_queue_.push(std::move(task));
       break;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.push(task);
+      secondary_task_queue_.push(std::move(task));
       break;
   }
 }
@@ -37,7 +38,7 @@ void TaskSource::RegisterTask(const DelayedTask& task) {
 void TaskSource::PopTask(TaskSourceGrade grade) {
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
+      user_interaction_task_queue_.pop();
       break;
     case TaskSourceGrade::kUnspecified:
       primary_task_queue_.pop();
@@ -49,7 +50,8 @@ void TaskSource::PopTask(TaskSourceGrade grade) {
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size =
+      user_interaction_task_queue_.size() + primary_task_queue_.size();
   if (secondary_pause_requests_ == 0) {
     size += secondary_task_queue_.size();
   }
@@ -62,33 +64,31 @@ bool TaskSource::IsEmpty() const {
 
 TaskSource::TopTask TaskSource::Top() const {
   FML_CHECK(!IsEmpty());
-  if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = primary_top,
-    };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = secondary_top,
-    };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
+  const DelayedTask* top = nullptr;
+  auto update_top = [&top](const DelayedTaskQueue& queue) {
+    if (!queue.empty() && (top == nullptr || *top > queue.top())) {
+      top = &queue.top();
     }
+  };
+  update_top(user_interaction_task_queue_);
+  update_top(primary_task_queue_);
+  if (secondary_pause_requests_ == 0) {
+    update_top(secondary_task_queue_);
+  }
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *top,
+  };
+}
+
+std::optional<TaskSource::TopTask> TaskSource::TopUserInteractionTask() const {
+  if (user_interaction_task_queue_.empty()) {
+    return std::nullopt;
   }
+  return TopTask{
+      .task_queue_id = task_queue_id_,
+      .task = user_interaction_task_queue_.top(),
+  };
 }
 
 void TaskSource::PauseSecondary() {
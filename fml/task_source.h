@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FML_TASK_SOURCE_H_
 #define FLUTTER_FML_TASK_SOURCE_H_
 
+#include <optional>
+
 #include "flutter/fml/delayed_task.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
@@ -18,7 +20,8 @@ class MessageLoopTaskQueues;
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. Tasks critical to user interaction are kept in a third heap so that the
+ * dispatcher can run them ahead of other due tasks.
  *
  * Registering Tasks
  * -----------------
@@ -49,7 +52,7 @@ class TaskSource {
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
   /// Pops the task heap corresponding to the `TaskSourceGrade`.
   void PopTask(TaskSourceGrade grade);
@@ -65,6 +68,9 @@ class TaskSource {
   /// the secondary heap has been paused or not.
   TopTask Top() const;
 
+  /// Returns the top task critical to user interaction, if any.
+  std::optional<TopTask> TopUserInteractionTask() const;
+
   /// Pause providing tasks from secondary task heap.
   void PauseSecondary();
 
@@ -73,6 +79,7 @@ class TaskSource {
 
  private:
   const fml::TaskQueueId task_queue_id_;
+  fml::DelayedTaskQueue user_interaction_task_queue_;
   fml::DelayedTaskQueue primary_task_queue_;
   fml::DelayedTaskQueue secondary_task_queue_;
   int secondary_pause_requests_ = 0;
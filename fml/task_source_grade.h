@@ -14,7 +14,8 @@ namespace fml {
  */
 enum class TaskSourceGrade {
   /// This `TaskSourceGrade` indicates that a task is critical to user
-  /// interaction.
+  /// interaction. Once due, these tasks run ahead of the tasks of other grades
+  /// that are due, even if those were due earlier.
   kUserInteraction,
   /// This `TaskSourceGrade` indicates that a task corresponds to servicing a
   /// dart micro task. These aren't critical to user interaction.
@@ -42,10 +42,10 @@ TEST(TaskSourceTests, SimpleOrdering) {
   task_source.RegisterTask({2, [&] { value = 7; },
                             time_stamp + fml::TimeDelta::FromMilliseconds(1),
                             TaskSourceGrade::kUnspecified});
-  task_source.Top().task.GetTask()();
+  task_source.Top().task.TakeTask()();
   task_source.PopTask(TaskSourceGrade::kUnspecified);
   ASSERT_EQ(value, 1);
-  task_source.Top().task.GetTask()();
+  task_source.Top().task.TakeTask()();
   task_source.PopTask(TaskSourceGrade::kUnspecified);
   ASSERT_EQ(value, 7);
 }
@@ -60,12 +60,12 @@ TEST(TaskSourceTests, SimpleOrderingMultiTaskHeaps) {
                             time_stamp + fml::TimeDelta::FromMilliseconds(1),
                             TaskSourceGrade::kUserInteraction});
   auto top_task = task_source.Top();
-  top_task.task.GetTask()();
+  top_task.task.TakeTask()();
   task_source.PopTask(top_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 1);
 
   auto second_task = task_source.Top();
-  second_task.task.GetTask()();
+  second_task.task.TakeTask()();
   task_source.PopTask(second_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 7);
 }
@@ -83,7 +83,7 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   task_source.PauseSecondary();
 
   auto top_task = task_source.Top();
-  top_task.task.GetTask()();
+  top_task.task.TakeTask()();
   task_source.PopTask(top_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 7);
 
@@ -92,10 +92,30 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   task_source.ResumeSecondary();
 
   auto second_task = task_source.Top();
-  second_task.task.GetTask()();
+  second_task.task.TakeTask()();
   task_source.PopTask(second_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, TopUserInteractionTask) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  int value = 0;
+  task_source.RegisterTask(
+      {1, [&] { value = 1; }, time_stamp, TaskSourceGrade::kUnspecified});
+  ASSERT_FALSE(task_source.TopUserInteractionTask().has_value());
+
+  task_source.RegisterTask({2, [&] { value = 7; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUserInteraction});
+  auto top_task = task_source.TopUserInteractionTask();
+  ASSERT_TRUE(top_task.has_value());
+  top_task->task.TakeTask()();
+  task_source.PopTask(top_task->task.GetTaskSourceGrade());
+  ASSERT_EQ(value, 7);
+  ASSERT_FALSE(task_source.TopUserInteractionTask().has_value());
+  ASSERT_EQ(task_source.GetNumPendingTasks(), 1u);
+}
+
 }  // namespace testing
 }  // namespace fml
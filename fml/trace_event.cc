@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_recorder.h"
 
 namespace fml {
 namespace tracing {
@@ -113,6 +114,7 @@ void TraceTimelineEvent(TraceArg category_group,
 }
 
 void TraceEvent0(TraceArg category_group, TraceArg name) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                          // timestamp1_or_async_id
@@ -127,6 +129,7 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, name);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -145,6 +148,7 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
                  TraceArg arg2_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, name);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   FlutterTimelineEvent(name,                            // label
@@ -158,6 +162,7 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kEnd, name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                        // timestamp1_or_async_id
@@ -229,6 +234,7 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 }
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, name);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                            // timestamp1_or_async_id
@@ -243,6 +249,7 @@ void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, name);
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
   FlutterTimelineEvent(name,                            // label
@@ -261,6 +268,7 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
                         TraceArg arg2_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, name);
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
   FlutterTimelineEvent(name,                            // label
@@ -345,21 +353,29 @@ void TraceTimelineEvent(TraceArg category_group,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {}
 
-void TraceEvent0(TraceArg category_group, TraceArg name) {}
+void TraceEvent0(TraceArg category_group, TraceArg name) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, name);
+}
 
 void TraceEvent1(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
-                 TraceArg arg1_val) {}
+                 TraceArg arg1_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, name);
+}
 
 void TraceEvent2(TraceArg category_group,
                  TraceArg name,
                  TraceArg arg1_name,
                  TraceArg arg1_val,
                  TraceArg arg2_name,
-                 TraceArg arg2_val) {}
+                 TraceArg arg2_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, name);
+}
 
-void TraceEventEnd(TraceArg name) {}
+void TraceEventEnd(TraceArg name) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kEnd, name);
+}
 
 void TraceEventAsyncComplete(TraceArg category_group,
                              TraceArg name,
@@ -386,19 +402,25 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg arg1_name,
                          TraceArg arg1_val) {}
 
-void TraceEventInstant0(TraceArg category_group, TraceArg name) {}
+void TraceEventInstant0(TraceArg category_group, TraceArg name) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, name);
+}
 
 void TraceEventInstant1(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
-                        TraceArg arg1_val) {}
+                        TraceArg arg1_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, name);
+}
 
 void TraceEventInstant2(TraceArg category_group,
                         TraceArg name,
                         TraceArg arg1_name,
                         TraceArg arg1_val,
                         TraceArg arg2_name,
-                        TraceArg arg2_val) {}
+                        TraceArg arg2_val) {
+  TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, name);
+}
 
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+std::atomic_bool TraceRecorder::enabled_ = false;
+
+namespace {
+
+// The ring buffer of a thread. Only that thread writes to it, and any thread
+// may read it.
+//
+// The writer publishes the number of events it recorded after writing each
+// one. A reader that copies the events may see some of them being
+// overwritten, which it detects by reading the count again afterwards, in
+// the way of a sequence lock.
+class ThreadBuffer {
+ public:
+  explicit ThreadBuffer(int64_t thread_index) : thread_index_(thread_index) {}
+
+  void Record(RecordedTraceEvent::Type type, const char* name) {
+    const int64_t timestamp = TimePoint::Now().ToEpochDelta().ToNanoseconds();
+    const uint64_t count = count_.load(std::memory_order_relaxed);
+    // Makes readers that see the writes below also see the count above.
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot& slot = slots_[count % TraceRecorder::kEventsPerThread];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.timestamp_nanos.store(timestamp, std::memory_order_relaxed);
+    slot.type.store(type, std::memory_order_relaxed);
+    count_.store(count + 1, std::memory_order_release);
+  }
+
+  TraceRecorder::ThreadRecording Read() const {
+    constexpr uint64_t kCapacity = TraceRecorder::kEventsPerThread;
+    TraceRecorder::ThreadRecording recording;
+    recording.thread_index = thread_index_;
+
+    const uint64_t end = count_.load(std::memory_order_acquire);
+    const uint64_t begin = end > kCapacity ? end - kCapacity : 0;
+    recording.events.resize(end - begin);
+    for (uint64_t i = begin; i < end; i++) {
+      const Slot& slot = slots_[i % kCapacity];
+      RecordedTraceEvent& event = recording.events[i - begin];
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.timestamp_nanos =
+          slot.timestamp_nanos.load(std::memory_order_relaxed);
+      event.type = slot.type.load(std::memory_order_relaxed);
+    }
+
+    // Drop the events that may have been overwritten while they were copied,
+    // including the one that may be being written.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t new_end = count_.load(std::memory_order_relaxed);
+    if (new_end + 1 > kCapacity) {
+      const uint64_t first_valid = new_end + 1 - kCapacity;
+      if (first_valid > begin) {
+        const uint64_t overwritten = std::min(first_valid, end) - begin;
+        recording.events.erase(recording.events.begin(),
+                               recording.events.begin() + overwritten);
+      }
+    }
+    return recording;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<const char*> name = nullptr;
+    std::atomic<int64_t> timestamp_nanos = 0;
+    std::atomic<RecordedTraceEvent::Type> type =
+        RecordedTraceEvent::Type::kBegin;
+  };
+
+  const int64_t thread_index_;
+  std::atomic<uint64_t> count_ = 0;
+  std::array<Slot, TraceRecorder::kEventsPerThread> slots_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+// The buffers of the running threads.
+class ThreadBufferRegistry {
+ public:
+  static ThreadBufferRegistry& GetInstance() {
+    static ThreadBufferRegistry* registry = new ThreadBufferRegistry();
+    return *registry;
+  }
+
+  std::shared_ptr<ThreadBuffer> Add() {
+    std::scoped_lock lock(mutex_);
+    auto buffer = std::make_shared<ThreadBuffer>(next_thread_index_++);
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  void Remove(const ThreadBuffer* buffer) {
+    std::scoped_lock lock(mutex_);
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                  [buffer](const auto& other) {
+                                    return other.get() == buffer;
+                                  }),
+                   buffers_.end());
+  }
+
+  std::vector<std::shared_ptr<ThreadBuffer>> GetBuffers() {
+    std::scoped_lock lock(mutex_);
+    return buffers_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+  int64_t next_thread_index_ = 0;
+
+  ThreadBufferRegistry() = default;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBufferRegistry);
+};
+
+// Registers the buffer of a thread for as long as the thread runs.
+class ThreadBufferHandle {
+ public:
+  ThreadBufferHandle() : buffer_(ThreadBufferRegistry::GetInstance().Add()) {}
+
+  ~ThreadBufferHandle() {
+    ThreadBufferRegistry::GetInstance().Remove(buffer_.get());
+  }
+
+  ThreadBuffer& buffer() { return *buffer_; }
+
+ private:
+  const std::shared_ptr<ThreadBuffer> buffer_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBufferHandle);
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<ThreadBufferHandle> tls_trace_buffer;
+
+}  // namespace
+
+void TraceRecorder::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::RecordOnCurrentThread(RecordedTraceEvent::Type type,
+                                          const char* name) {
+  ThreadBufferHandle* handle = tls_trace_buffer.get();
+  if (handle == nullptr) {
+    handle = new ThreadBufferHandle();
+    tls_trace_buffer.reset(handle);
+  }
+  handle->buffer().Record(type, name);
+}
+
+std::vector<TraceRecorder::ThreadRecording> TraceRecorder::GetRecording() {
+  std::vector<ThreadRecording> recordings;
+  for (const auto& buffer : ThreadBufferRegistry::GetInstance().GetBuffers()) {
+    recordings.push_back(buffer->Read());
+  }
+  return recordings;
+}
+
+}  // namespace tracing
+}  // namespace fml
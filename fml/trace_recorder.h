@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      An event kept by the |TraceRecorder|.
+///
+///             The name is not copied. The trace macros are given string
+///             literals, so their addresses identify the names.
+///
+struct RecordedTraceEvent {
+  enum class Type : uint8_t {
+    kBegin,
+    kEnd,
+    kInstant,
+  };
+
+  const char* name = nullptr;
+  /// The |fml::TimePoint| of the event, in nanoseconds.
+  int64_t timestamp_nanos = 0;
+  Type type = Type::kBegin;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A flight recorder of the duration and instant events of the
+///             trace macros, cheap enough to stay enabled in release builds.
+///
+///             Each thread records into its own ring buffer of the last
+///             |kEventsPerThread| events, without locks, formatting or
+///             copies of the arguments, which are not recorded. The buffers
+///             are read on demand, for instance after a janky frame, by
+///             |GetRecording|.
+///
+///             Recording is independent of the timeline and is disabled by
+///             default.
+///
+class TraceRecorder {
+ public:
+  static constexpr size_t kEventsPerThread = 4096;
+
+  /// The events recorded by a thread, oldest first.
+  struct ThreadRecording {
+    /// A small number that identifies the thread, in the order in which
+    /// threads first recorded an event.
+    int64_t thread_index = 0;
+    std::vector<RecordedTraceEvent> events;
+  };
+
+  static void SetEnabled(bool enabled);
+
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Records an event on the current thread, if recording is enabled.
+  static void Record(RecordedTraceEvent::Type type, const char* name) {
+    if (IsEnabled()) {
+      RecordOnCurrentThread(type, name);
+    }
+  }
+
+  /// Copies the events of the threads that are still running. This can be
+  /// called on any thread while the others record.
+  static std::vector<ThreadRecording> GetRecording();
+
+ private:
+  static std::atomic_bool enabled_;
+
+  static void RecordOnCurrentThread(RecordedTraceEvent::Type type,
+                                    const char* name);
+
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(TraceRecorder);
+};
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <thread>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+// Returns the recording of the thread that recorded events with |name|,
+// which only one thread of each test records.
+TraceRecorder::ThreadRecording GetRecordingWithEvent(const char* name) {
+  for (auto& recording : TraceRecorder::GetRecording()) {
+    for (const auto& event : recording.events) {
+      if (event.name == name) {
+        return recording;
+      }
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+TEST(TraceRecorderTest, RecordsNothingWhenDisabled) {
+  std::thread thread([] {
+    static const char kName[] = "TraceRecorderTest::Disabled";
+    TraceRecorder::SetEnabled(false);
+    TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, kName);
+    EXPECT_TRUE(GetRecordingWithEvent(kName).events.empty());
+  });
+  thread.join();
+}
+
+TEST(TraceRecorderTest, RecordsEventsInOrder) {
+  std::thread thread([] {
+    static const char kName[] = "TraceRecorderTest::InOrder";
+    TraceRecorder::SetEnabled(true);
+    TraceRecorder::Record(RecordedTraceEvent::Type::kBegin, kName);
+    TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, kName);
+    TraceRecorder::Record(RecordedTraceEvent::Type::kEnd, kName);
+    TraceRecorder::SetEnabled(false);
+
+    auto events = GetRecordingWithEvent(kName).events;
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].type, RecordedTraceEvent::Type::kBegin);
+    EXPECT_EQ(events[1].type, RecordedTraceEvent::Type::kInstant);
+    EXPECT_EQ(events[2].type, RecordedTraceEvent::Type::kEnd);
+    EXPECT_LE(events[0].timestamp_nanos, events[2].timestamp_nanos);
+  });
+  thread.join();
+}
+
+TEST(TraceRecorderTest, KeepsTheLastEventsOfAThread) {
+  std::thread thread([] {
+    static const char kOldName[] = "TraceRecorderTest::Old";
+    static const char kNewName[] = "TraceRecorderTest::New";
+    TraceRecorder::SetEnabled(true);
+    TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, kOldName);
+    for (size_t i = 0; i < TraceRecorder::kEventsPerThread; i++) {
+      TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, kNewName);
+    }
+    TraceRecorder::SetEnabled(false);
+
+    auto events = GetRecordingWithEvent(kNewName).events;
+    EXPECT_EQ(events.size(), TraceRecorder::kEventsPerThread);
+    for (const auto& event : events) {
+      EXPECT_EQ(event.name, kNewName);
+    }
+  });
+  thread.join();
+}
+
+TEST(TraceRecorderTest, ForgetsThreadsThatExited) {
+  static const char kName[] = "TraceRecorderTest::Exited";
+  std::thread thread([] {
+    TraceRecorder::SetEnabled(true);
+    TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, kName);
+    TraceRecorder::SetEnabled(false);
+    EXPECT_FALSE(GetRecordingWithEvent(kName).events.empty());
+  });
+  thread.join();
+  EXPECT_TRUE(GetRecordingWithEvent(kName).events.empty());
+}
+
+TEST(TraceRecorderTest, CanBeReadWhileRecording) {
+  static const char kName[] = "TraceRecorderTest::Concurrent";
+  fml::AutoResetWaitableEvent started;
+  std::atomic_bool done = false;
+  TraceRecorder::SetEnabled(true);
+  std::thread thread([&] {
+    TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, kName);
+    started.Signal();
+    while (!done) {
+      TraceRecorder::Record(RecordedTraceEvent::Type::kInstant, kName);
+    }
+  });
+  started.Wait();
+  for (int i = 0; i < 100; i++) {
+    auto events = GetRecordingWithEvent(kName).events;
+    EXPECT_LE(events.size(), TraceRecorder::kEventsPerThread);
+    for (const auto& event : events) {
+      EXPECT_EQ(event.name, kName);
+    }
+  }
+  done = true;
+  thread.join();
+  TraceRecorder::SetEnabled(false);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
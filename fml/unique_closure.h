@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_UNIQUE_CLOSURE_H_
+#define FLUTTER_FML_UNIQUE_CLOSURE_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only closure that stores small callables inline.
+///
+///             This is what task runners queue tasks as. Unlike
+///             |fml::closure|, which is a |std::function|, the callable does
+///             not need to be copyable, so move-only captures don't need
+///             |fml::MakeCopyable|, and callables of up to |kInlineSize|
+///             bytes are not allocated on the heap. Most tasks posted in the
+///             engine are lambdas this small.
+///
+///             An |fml::closure| converts to a |UniqueClosure| that calls
+///             it, and an empty one to an empty |UniqueClosure|.
+///
+class UniqueClosure {
+ public:
+  /// The size of the largest callable stored without a heap allocation.
+  static constexpr size_t kInlineSize = 64;
+
+  UniqueClosure() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(std::nullptr_t) {}
+
+  template <typename Callable,
+            typename Decayed = std::decay_t<Callable>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Decayed, UniqueClosure> &&
+                !std::is_same_v<Decayed, std::nullptr_t> &&
+                std::is_invocable_r_v<void, Decayed&>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(Callable&& callable) {
+    if constexpr (std::is_constructible_v<bool, const Decayed&>) {
+      // Empty |std::function|s and null function pointers.
+      if (!static_cast<bool>(callable)) {
+        return;
+      }
+    }
+    if constexpr (IsStoredInline<Decayed>()) {
+      new (&storage_) Decayed(std::forward<Callable>(callable));
+      ops_ = &kInlineOps<Decayed>;
+    } else {
+      new (&storage_) Decayed*(new Decayed(std::forward<Callable>(callable)));
+      ops_ = &kHeapOps<Decayed>;
+    }
+  }
+
+  UniqueClosure(UniqueClosure&& other) noexcept { MoveFrom(other); }
+
+  UniqueClosure& operator=(UniqueClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~UniqueClosure() { Reset(); }
+
+  void operator()() const {
+    FML_DCHECK(ops_);
+    ops_->invoke(&storage_);
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  bool operator==(std::nullptr_t) const { return ops_ == nullptr; }
+
+  bool operator!=(std::nullptr_t) const { return ops_ != nullptr; }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    // Move constructs into |destination| and destroys |source|.
+    void (*relocate)(void* destination, void* source);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Callable>
+  static constexpr bool IsStoredInline() {
+    return sizeof(Callable) <= kInlineSize &&
+           alignof(Callable) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Callable>;
+  }
+
+  template <typename Callable>
+  static constexpr Ops kInlineOps = {
+      .invoke =
+          [](void* storage) { (*static_cast<Callable*>(storage))(); },
+      .relocate =
+          [](void* destination, void* source) {
+            auto* callable = static_cast<Callable*>(source);
+            new (destination) Callable(std::move(*callable));
+            callable->~Callable();
+          },
+      .destroy =
+          [](void* storage) { static_cast<Callable*>(storage)->~Callable(); },
+  };
+
+  template <typename Callable>
+  static constexpr Ops kHeapOps = {
+      .invoke =
+          [](void* storage) { (**static_cast<Callable**>(storage))(); },
+      .relocate =
+          [](void* destination, void* source) {
+            new (destination) Callable*(*static_cast<Callable**>(source));
+          },
+      .destroy =
+          [](void* storage) { delete *static_cast<Callable**>(storage); },
+  };
+
+  alignas(std::max_align_t) mutable std::byte storage_[kInlineSize];
+  const Ops* ops_ = nullptr;
+
+  void MoveFrom(UniqueClosure& other) {
+    if (other.ops_) {
+      other.ops_->relocate(&storage_, &other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      // Cleared first in case the callable destroys this closure again.
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(&storage_);
+    }
+  }
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_UNIQUE_CLOSURE_H_
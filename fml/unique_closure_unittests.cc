@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/unique_closure.h"
+
+#include <array>
+#include <memory>
+
+#include "flutter/fml/closure.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(UniqueClosureTest, IsEmptyByDefault) {
+  UniqueClosure closure;
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(closure == nullptr);
+}
+
+TEST(UniqueClosureTest, CallsMoveOnlyCallables) {
+  auto value = std::make_unique<int>(42);
+  int result = 0;
+  UniqueClosure closure = [value = std::move(value), &result]() {
+    result = *value;
+  };
+  ASSERT_TRUE(closure);
+  closure();
+  EXPECT_EQ(result, 42);
+}
+
+TEST(UniqueClosureTest, CallsCallablesLargerThanTheInlineStorage) {
+  std::array<int, 64> values = {};
+  values.back() = 7;
+  static_assert(sizeof(values) > UniqueClosure::kInlineSize);
+  int result = 0;
+  UniqueClosure closure = [values, &result]() { result = values.back(); };
+  UniqueClosure moved = std::move(closure);
+  EXPECT_FALSE(closure);  // NOLINT(bugprone-use-after-move)
+  moved();
+  EXPECT_EQ(result, 7);
+}
+
+TEST(UniqueClosureTest, DestroysTheCallableOnce) {
+  auto value = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_value = value;
+  {
+    UniqueClosure closure = [value = std::move(value)]() {};
+    UniqueClosure moved = std::move(closure);
+    EXPECT_FALSE(weak_value.expired());
+    moved = nullptr;
+    EXPECT_TRUE(weak_value.expired());
+  }
+  EXPECT_TRUE(weak_value.expired());
+}
+
+TEST(UniqueClosureTest, ConvertsStdFunctions) {
+  int count = 0;
+  fml::closure function = [&count]() { count++; };
+  UniqueClosure closure = function;
+  closure();
+  function();
+  EXPECT_EQ(count, 2);
+
+  fml::closure empty_function;
+  UniqueClosure empty_closure = empty_function;
+  EXPECT_FALSE(empty_closure);
+}
+
+}  // namespace testing
+}  // namespace fml
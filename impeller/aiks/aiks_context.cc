@@ -4,10 +4,57 @@
 
 #include "impeller/aiks/aiks_context.h"
 
+#include <utility>
+#include <vector>
+
 #include "impeller/aiks/picture.h"
+#include "impeller/base/validation.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/host_buffer.h"
 
 namespace impeller {
 
+/// Retires the transient data written for a render, and lets the host
+/// buffers reuse it once the GPU is done with it.
+///
+/// An empty command buffer is submitted after the ones of the render. The
+/// queue completes command buffers in order, so once it completes, the
+/// commands that read the data have completed too.
+static void RetireTransients(
+    const Context& context,
+    const std::vector<std::shared_ptr<HostBuffer>>& buffers) {
+  std::vector<std::pair<std::weak_ptr<HostBuffer>, uint64_t>> frames;
+  for (const auto& buffer : buffers) {
+    if (auto frame_id = buffer->Reset(); frame_id != 0u) {
+      frames.emplace_back(buffer, frame_id);
+    }
+  }
+  if (frames.empty()) {
+    return;
+  }
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    VALIDATION_LOG << "Could not create a command buffer to track the "
+                      "completion of the transient data.";
+    return;
+  }
+  command_buffer->SetLabel("Transients Fence");
+  // The callback also runs, with an error, if the submission fails, so the
+  // blocks are released either way.
+  if (!command_buffer->SubmitCommands(
+          [frames = std::move(frames)](CommandBuffer::Status) {
+            for (const auto& [weak_buffer, frame_id] : frames) {
+              if (auto buffer = weak_buffer.lock()) {
+                buffer->MarkFrameCompleted(frame_id);
+              }
+            }
+          })) {
+    VALIDATION_LOG << "Could not submit the transient data fence.";
+  }
+}
+
 AiksContext::AiksContext(std::shared_ptr<Context> context)
     : context_(std::move(context)) {
   if (!context_ || !context_->IsValid()) {
@@ -36,13 +83,34 @@ const ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
-bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
+void AiksContext::SetParallelSubpassEncodingEnabled(bool enabled) {
+  if (!IsValid()) {
+    return;
+  }
+  content_context_->SetParallelSubpassEncodingEnabled(enabled);
+}
+
+bool AiksContext::Render(const Picture& picture,
+                         RenderTarget& render_target,
+                         std::optional<IRect> damage) {
   if (!IsValid()) {
     return false;
   }
 
   if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+    auto render_target_cache = content_context_->GetRenderTargetCache();
+    auto tessellation_cache = content_context_->GetTessellationCache();
+    auto gradient_cache = content_context_->GetGradientCache();
+    render_target_cache->Start();
+    tessellation_cache->Start();
+    gradient_cache->Start();
+    auto result =
+        picture.pass->Render(*content_context_, render_target, damage);
+    gradient_cache->End();
+    tessellation_cache->End();
+    render_target_cache->End();
+    RetireTransients(*context_, content_context_->GetAllTransientsBuffers());
+    return result;
   }
 
   return true;
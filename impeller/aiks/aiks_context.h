@@ -5,9 +5,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_target.h"
 
@@ -16,7 +18,7 @@ namespace impeller {
 struct Picture;
 class RenderPass;
 
-class AiksContext {
+class AiksContext : public std::enable_shared_from_this<AiksContext> {
  public:
   AiksContext(std::shared_ptr<Context> context);
 
@@ -28,7 +30,21 @@ class AiksContext {
 
   const ContentContext& GetContentContext() const;
 
-  bool Render(const Picture& picture, RenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      Encode the independent subpasses of the rendered pictures
+  ///             concurrently. See
+  ///             |ContentContext::SetParallelSubpassEncodingEnabled|.
+  ///
+  void SetParallelSubpassEncodingEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render the picture to the given target. If damage is set,
+  ///             only that region of the target is updated and the rest keeps
+  ///             its previous contents.
+  ///
+  bool Render(const Picture& picture,
+              RenderTarget& render_target,
+              std::optional<IRect> damage = std::nullopt);
 
  private:
   std::shared_ptr<Context> context_;
@@ -8,6 +8,7 @@
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "flutter/testing/testing.h"
 #include "impeller/aiks/aiks_playground.h"
@@ -62,6 +63,38 @@ TEST_P(AiksTest, CanvasCanPushPopCTM) {
                      Matrix::MakeTranslation({100.0, 100.0, 0.0}));
 }
 
+TEST_P(AiksTest, CanvasPictureSlotsKeepRecordingOrder) {
+  auto make_picture = [](Scalar x) {
+    Canvas canvas;
+    canvas.DrawRect(Rect::MakeXYWH(x, 0, 10, 10), Paint{});
+    return canvas.EndRecordingAsPicture();
+  };
+
+  Canvas canvas;
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 10, 10), Paint{});
+  auto first_slot = canvas.ReservePictureSlot();
+  canvas.DrawRect(Rect::MakeXYWH(20, 0, 10, 10), Paint{});
+  canvas.Translate(Vector3(0, 100));
+  auto second_slot = canvas.ReservePictureSlot();
+  canvas.DrawRect(Rect::MakeXYWH(40, 0, 10, 10), Paint{});
+
+  canvas.DrawPictureInSlot(second_slot, make_picture(30));
+  canvas.DrawPictureInSlot(first_slot, make_picture(10));
+  auto picture = canvas.EndRecordingAsPicture();
+
+  std::vector<Rect> coverages;
+  picture.pass->IterateAllEntities([&coverages](Entity& entity) {
+    coverages.push_back(entity.GetCoverage().value_or(Rect{}));
+    return true;
+  });
+  ASSERT_EQ(coverages.size(), 5u);
+  ASSERT_RECT_NEAR(coverages[0], Rect::MakeXYWH(0, 0, 10, 10));
+  ASSERT_RECT_NEAR(coverages[1], Rect::MakeXYWH(10, 0, 10, 10));
+  ASSERT_RECT_NEAR(coverages[2], Rect::MakeXYWH(20, 0, 10, 10));
+  ASSERT_RECT_NEAR(coverages[3], Rect::MakeXYWH(30, 100, 10, 10));
+  ASSERT_RECT_NEAR(coverages[4], Rect::MakeXYWH(40, 100, 10, 10));
+}
+
 TEST_P(AiksTest, CanRenderColoredRect) {
   Canvas canvas;
   Paint paint;
@@ -211,6 +244,41 @@ TEST_P(AiksTest, CanRenderCurvedStrokes) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, CanRenderAntialiasedPrimitives) {
+  Canvas canvas;
+  canvas.Translate({100, 100});
+  canvas.Rotate(Degrees(10));
+
+  Paint fill;
+  fill.color = Color::Red();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 200, 100), fill);
+  fill.color = Color::Green();
+  canvas.DrawRRect(Rect::MakeXYWH(250, 0, 200, 100), 30, fill);
+  fill.color = Color::Blue();
+  canvas.DrawOval(Rect::MakeXYWH(500, 0, 200, 100), fill);
+  fill.color = Color::Yellow().WithAlpha(0.5);
+  canvas.DrawCircle({800, 50}, 50, fill);
+
+  Paint stroke;
+  stroke.style = Paint::Style::kStroke;
+  stroke.stroke_width = 10;
+  stroke.color = Color::Red();
+  canvas.DrawRect(Rect::MakeXYWH(0, 200, 200, 100), stroke);
+  stroke.color = Color::Green();
+  canvas.DrawRRect(Rect::MakeXYWH(250, 200, 200, 100), 30, stroke);
+  stroke.color = Color::Yellow();
+  canvas.DrawCircle({800, 250}, 50, stroke);
+
+  Cap caps[] = {Cap::kButt, Cap::kSquare, Cap::kRound};
+  for (size_t i = 0; i < 3; i++) {
+    stroke.stroke_cap = caps[i];
+    stroke.color = Color::Blue();
+    canvas.DrawLine({50, 400.0f + i * 50}, {500, 450.0f + i * 50}, stroke);
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 TEST_P(AiksTest, CanRenderClips) {
   Canvas canvas;
   Paint paint;
@@ -1887,5 +1955,35 @@ TEST_P(AiksTest, PaintWithFilters) {
   ASSERT_FALSE(paint.HasColorFilter());
 }
 
+TEST_P(AiksTest, CanRenderSaveLayersWithParallelSubpassEncoding) {
+  AiksContext renderer(GetContext());
+  ASSERT_TRUE(renderer.IsValid());
+  ASSERT_FALSE(renderer.GetContentContext().IsParallelSubpassEncodingEnabled());
+  renderer.SetParallelSubpassEncodingEnabled(true);
+  if (!renderer.GetContentContext().IsParallelSubpassEncodingEnabled()) {
+    GTEST_SKIP() << "The backend can't encode subpasses concurrently.";
+  }
+
+  Canvas canvas;
+  for (size_t i = 0; i < 16u; i++) {
+    Paint layer_paint;
+    layer_paint.color = Color::White().WithAlpha(0.5);
+    canvas.SaveLayer(layer_paint);
+    Paint paint;
+    paint.color = i % 2u == 0u ? Color::Red() : Color::Blue();
+    auto offset = static_cast<Scalar>(i * 20u);
+    canvas.DrawRect(Rect::MakeXYWH(offset, offset, 100, 100), paint);
+    canvas.Restore();
+  }
+  auto picture = canvas.EndRecordingAsPicture();
+
+  auto render_target =
+      RenderTarget::CreateOffscreen(*GetContext(), ISize{400, 400});
+  ASSERT_TRUE(render_target.IsValid());
+  ASSERT_TRUE(renderer.Render(picture, render_target));
+  // The save layers were encoded with the transients of the workers.
+  ASSERT_GT(renderer.GetContentContext().GetAllTransientsBuffers().size(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -5,6 +5,7 @@
 #include "impeller/aiks/canvas.h"
 
 #include <algorithm>
+#include <cmath>
 #include <optional>
 #include <utility>
 
@@ -13,6 +14,8 @@
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/rrect_shadow_contents.h"
+#include "impeller/entity/contents/solid_points_contents.h"
+#include "impeller/entity/contents/solid_rrect_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
@@ -157,7 +160,7 @@ void Canvas::DrawPaint(const Paint& paint) {
 }
 
 bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
-                                     Scalar corner_radius,
+                                     Size corner_radii,
                                      const Paint& paint) {
   if (paint.color_source == nullptr ||
       paint.color_source_type != Paint::ColorSourceType::kColor ||
@@ -178,7 +181,7 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   auto contents = std::make_shared<RRectShadowContents>();
   contents->SetColor(new_paint.color);
   contents->SetSigma(new_paint.mask_blur_descriptor->sigma);
-  contents->SetRRect(rect, corner_radius);
+  contents->SetRRect(rect, corner_radii);
 
   new_paint.mask_blur_descriptor = std::nullopt;
 
@@ -193,13 +196,97 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   return true;
 }
 
+bool Canvas::AttemptDrawAntialiasedRRect(const Rect& rect,
+                                         Size corner_radii,
+                                         const Paint& paint,
+                                         const Matrix& local_transformation) {
+  if (paint.color_source.has_value() ||
+      paint.color_source_type != Paint::ColorSourceType::kColor ||
+      paint.mask_blur_descriptor.has_value()) {
+    return false;
+  }
+
+  // Scaling the color by the coverage only blends the edges correctly for
+  // source over.
+  if (paint.blend_mode != BlendMode::kSourceOver) {
+    return false;
+  }
+
+  // Hairlines are a pixel wide at every scale, which the stroke width in
+  // local coordinates cannot express.
+  if (paint.style == Paint::Style::kStroke && paint.stroke_width <= 0) {
+    return false;
+  }
+
+  auto transformation = GetCurrentTransformation() * local_transformation;
+  if (!SolidRRectContents::CanRenderWithTransformation(transformation)) {
+    return false;
+  }
+
+  auto contents = std::make_shared<SolidRRectContents>();
+  contents->SetRRect(rect, corner_radii);
+  contents->SetColor(paint.color);
+  if (paint.style == Paint::Style::kStroke) {
+    contents->SetStrokeWidth(paint.stroke_width);
+  }
+
+  Entity entity;
+  entity.SetTransformation(transformation);
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetBlendMode(paint.blend_mode);
+  entity.SetContents(paint.WithFilters(std::move(contents)));
+
+  GetCurrentPass().AddEntity(entity);
+
+  return true;
+}
+
+void Canvas::DrawLine(Point p0, Point p1, const Paint& paint) {
+  Paint stroke_paint = paint;
+  stroke_paint.style = Paint::Style::kStroke;
+
+  // A line is a rect along its direction that the caps extend, and round
+  // caps are its corners.
+  auto delta = p1 - p0;
+  auto length = delta.GetLength();
+  if (length > 0 && stroke_paint.stroke_width > 0) {
+    auto half_width = stroke_paint.stroke_width / 2;
+    auto extent = stroke_paint.stroke_cap == Cap::kButt ? 0 : half_width;
+    auto corner_radius =
+        stroke_paint.stroke_cap == Cap::kRound ? half_width : 0;
+    Paint fill_paint = stroke_paint;
+    fill_paint.style = Paint::Style::kFill;
+    auto local_transformation =
+        Matrix::MakeTranslation(p0) *
+        Matrix::MakeRotationZ(Radians(std::atan2(delta.y, delta.x)));
+    if (AttemptDrawAntialiasedRRect(
+            Rect::MakeLTRB(-extent, -half_width, length + extent, half_width),
+            Size(corner_radius, corner_radius), fill_paint,
+            local_transformation)) {
+      return;
+    }
+  }
+
+  DrawPath(PathBuilder{}.AddLine(p0, p1).TakePath(), stroke_paint);
+}
+
 void Canvas::DrawRect(Rect rect, const Paint& paint) {
   if (paint.style == Paint::Style::kStroke) {
+    // The corners of the distance field are sharp, which only mitered joins
+    // are.
+    if (paint.stroke_join == Join::kMiter && paint.stroke_miter >= kSqrt2 &&
+        AttemptDrawAntialiasedRRect(rect, {}, paint)) {
+      return;
+    }
     DrawPath(PathBuilder{}.AddRect(rect).TakePath(), paint);
     return;
   }
 
-  if (AttemptDrawBlurredRRect(rect, 0, paint)) {
+  if (AttemptDrawBlurredRRect(rect, {}, paint)) {
+    return;
+  }
+
+  if (AttemptDrawAntialiasedRRect(rect, {}, paint)) {
     return;
   }
 
@@ -214,24 +301,96 @@ void Canvas::DrawRect(Rect rect, const Paint& paint) {
 }
 
 void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
-  if (AttemptDrawBlurredRRect(rect, corner_radius, paint)) {
+  if (AttemptDrawBlurredRRect(rect, Size(corner_radius, corner_radius),
+                              paint)) {
+    return;
+  }
+  // The inner corners of strokes that are wider than the corners are sharp,
+  // which the distance field does not approximate.
+  if ((paint.style == Paint::Style::kFill ||
+       paint.stroke_width <= corner_radius * 2) &&
+      AttemptDrawAntialiasedRRect(rect, Size(corner_radius, corner_radius),
+                                  paint)) {
     return;
   }
   DrawPath(PathBuilder{}.AddRoundedRect(rect, corner_radius).TakePath(), paint);
 }
 
+void Canvas::DrawOval(Rect rect, const Paint& paint) {
+  auto positive_rect = rect.GetPositive();
+  if (AttemptDrawBlurredRRect(positive_rect, positive_rect.size / 2, paint)) {
+    return;
+  }
+  if (paint.style == Paint::Style::kFill &&
+      AttemptDrawAntialiasedRRect(positive_rect, positive_rect.size / 2,
+                                  paint)) {
+    return;
+  }
+  DrawPath(PathBuilder{}.AddOval(rect).TakePath(), paint);
+}
+
 void Canvas::DrawCircle(Point center, Scalar radius, const Paint& paint) {
   Size half_size(radius, radius);
-  if (AttemptDrawBlurredRRect(Rect(center - half_size, half_size * 2), radius,
-                              paint)) {
+  if (AttemptDrawBlurredRRect(Rect(center - half_size, half_size * 2),
+                              half_size, paint)) {
+    return;
+  }
+  if (AttemptDrawAntialiasedRRect(Rect(center - half_size, half_size * 2),
+                                  half_size, paint)) {
     return;
   }
   DrawPath(PathBuilder{}.AddCircle(center, radius).TakePath(), paint);
 }
 
+void Canvas::DrawPoints(std::vector<Point> points,
+                        Scalar radius,
+                        const Paint& paint,
+                        PointStyle point_style) {
+  // Advanced blends are applied to the entity as a whole, which would blend
+  // overlapping points with each other differently than separate draws do.
+  if (radius <= 0 || paint.color_source.has_value() ||
+      paint.color_source_type != Paint::ColorSourceType::kColor ||
+      paint.mask_blur_descriptor.has_value() ||
+      paint.blend_mode > Entity::kLastPipelineBlendMode) {
+    Paint stroke_paint = paint;
+    stroke_paint.style = Paint::Style::kStroke;
+    stroke_paint.stroke_width = std::max(radius, 0.0f) * 2;
+    stroke_paint.stroke_cap =
+        point_style == PointStyle::kRound ? Cap::kRound : Cap::kSquare;
+    for (const auto& point : points) {
+      DrawPath(PathBuilder{}.AddLine(point, point).TakePath(), stroke_paint);
+    }
+    return;
+  }
+
+  auto contents = std::make_shared<SolidPointsContents>();
+  contents->SetPoints(std::move(points));
+  contents->SetRadius(radius);
+  contents->SetPointStyle(point_style);
+  contents->SetColor(paint.color);
+
+  Entity entity;
+  entity.SetTransformation(GetCurrentTransformation());
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetBlendMode(paint.blend_mode);
+  entity.SetContents(paint.WithFilters(std::move(contents)));
+
+  GetCurrentPass().AddEntity(entity);
+}
+
 void Canvas::ClipPath(const Path& path, Entity::ClipOperation clip_op) {
+  ClipGeometry(Geometry::MakeFillPath(path), clip_op);
+}
+
+void Canvas::ClipRect(const Rect& rect, Entity::ClipOperation clip_op) {
+  // Rect clips are kept as rects so that they can be applied with a scissor.
+  ClipGeometry(Geometry::MakeRect(rect), clip_op);
+}
+
+void Canvas::ClipGeometry(std::unique_ptr<Geometry> geometry,
+                          Entity::ClipOperation clip_op) {
   auto contents = std::make_shared<ClipContents>();
-  contents->SetGeometry(Geometry::MakeFillPath(path));
+  contents->SetGeometry(std::move(geometry));
   contents->SetClipOperation(clip_op);
 
   Entity entity;
@@ -261,14 +420,26 @@ void Canvas::DrawPicture(Picture picture) {
     return;
   }
   // Clone the base pass and account for the CTM updates.
-  auto pass = picture.pass->Clone();
-  pass->IterateAllEntities([&](auto& entity) -> bool {
-    entity.IncrementStencilDepth(GetStencilDepth());
-    entity.SetTransformation(GetCurrentTransformation() *
-                             entity.GetTransformation());
-    return true;
-  });
-  return;
+  Picture clone;
+  clone.pass = picture.pass->Clone();
+  DrawPictureInSlot(ReservePictureSlot(), std::move(clone));
+}
+
+Canvas::PictureSlot Canvas::ReservePictureSlot() {
+  PictureSlot slot;
+  slot.pass = &GetCurrentPass();
+  slot.index = slot.pass->GetElementCount();
+  slot.xformation = GetCurrentTransformation();
+  slot.stencil_depth = GetStencilDepth();
+  return slot;
+}
+
+void Canvas::DrawPictureInSlot(const PictureSlot& slot, Picture picture) {
+  if (!slot.pass || !picture.pass) {
+    return;
+  }
+  slot.pass->InsertElements(slot.index, std::move(picture.pass),
+                            slot.xformation, slot.stencil_depth);
 }
 
 void Canvas::DrawImage(const std::shared_ptr<Image>& image,
@@ -303,6 +474,9 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
 
   auto contents = TextureContents::MakeRect(dest);
   contents->SetTexture(image->GetTexture());
+  if (image->GetUVTexture()) {
+    contents->SetUVTexture(image->GetUVTexture(), image->GetYUVColorSpace());
+  }
   contents->SetSourceRect(source);
   contents->SetSamplerDescriptor(std::move(sampler));
   contents->SetOpacity(paint.color.alpha);
@@ -361,11 +535,12 @@ void Canvas::DrawTextFrame(const TextFrame& text_frame,
                            const Paint& paint) {
   auto lazy_glyph_atlas = GetCurrentPass().GetLazyGlyphAtlas();
 
-  lazy_glyph_atlas->AddTextFrame(text_frame);
+  const bool uses_sdf = lazy_glyph_atlas->AddTextFrame(text_frame);
 
   auto text_contents = std::make_shared<TextContents>();
   text_contents->SetTextFrame(text_frame);
   text_contents->SetGlyphAtlas(std::move(lazy_glyph_atlas));
+  text_contents->SetUsesSignedDistanceField(uses_sdf);
   text_contents->SetColor(paint.color);
 
   Entity entity;
@@ -29,6 +29,16 @@ class Entity;
 
 class Canvas {
  public:
+  /// A position in the recording at which a picture that is recorded
+  /// separately can be drawn later, along with the transformation and clip
+  /// that were current at that position.
+  struct PictureSlot {
+    EntityPass* pass = nullptr;
+    size_t index = 0u;
+    Matrix xformation;
+    size_t stencil_depth = 0u;
+  };
+
   Canvas();
 
   ~Canvas();
@@ -70,12 +80,26 @@ class Canvas {
 
   void DrawPaint(const Paint& paint);
 
+  void DrawLine(Point p0, Point p1, const Paint& paint);
+
   void DrawRect(Rect rect, const Paint& paint);
 
   void DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint);
 
+  void DrawOval(Rect rect, const Paint& paint);
+
   void DrawCircle(Point center, Scalar radius, const Paint& paint);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draw a circle or a square of the given radius around every
+  ///             point. Points of solid colors are drawn with a single
+  ///             command.
+  ///
+  void DrawPoints(std::vector<Point> points,
+                  Scalar radius,
+                  const Paint& paint,
+                  PointStyle point_style);
+
   void DrawImage(const std::shared_ptr<Image>& image,
                  Point offset,
                  const Paint& paint,
@@ -91,8 +115,22 @@ class Canvas {
       const Path& path,
       Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
 
+  void ClipRect(
+      const Rect& rect,
+      Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
+
   void DrawPicture(Picture picture);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reserve the current position of the recording for a picture
+  ///             that is drawn with |DrawPictureInSlot|. Slots must be filled
+  ///             in the reverse order of their reservation and before the
+  ///             recording ends.
+  ///
+  PictureSlot ReservePictureSlot();
+
+  void DrawPictureInSlot(const PictureSlot& slot, Picture picture);
+
   void DrawTextFrame(const TextFrame& text_frame,
                      Point position,
                      const Paint& paint);
@@ -130,12 +168,20 @@ class Canvas {
             std::optional<EntityPass::BackdropFilterProc> backdrop_filter =
                 std::nullopt);
 
+  void ClipGeometry(std::unique_ptr<Geometry> geometry,
+                    Entity::ClipOperation clip_op);
+
   void RestoreClip();
 
   bool AttemptDrawBlurredRRect(const Rect& rect,
-                               Scalar corner_radius,
+                               Size corner_radii,
                                const Paint& paint);
 
+  bool AttemptDrawAntialiasedRRect(const Rect& rect,
+                                   Size corner_radii,
+                                   const Paint& paint,
+                                   const Matrix& local_transformation = {});
+
   FML_DISALLOW_COPY_AND_ASSIGN(Canvas);
 };
 
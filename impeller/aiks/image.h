@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "impeller/geometry/color.h"
 #include "impeller/renderer/texture.h"
 
 namespace impeller {
@@ -15,14 +16,26 @@ class Image {
  public:
   Image(std::shared_ptr<Texture> texture);
 
+  /// @brief  An image whose Y and UV planes are converted to RGB when they are
+  ///         sampled. |GetTexture| returns the Y plane.
+  Image(std::shared_ptr<Texture> y_texture,
+        std::shared_ptr<Texture> uv_texture,
+        YUVColorSpace yuv_color_space);
+
   ~Image();
 
   ISize GetSize() const;
 
   std::shared_ptr<Texture> GetTexture() const;
 
+  std::shared_ptr<Texture> GetUVTexture() const;
+
+  YUVColorSpace GetYUVColorSpace() const;
+
  private:
   const std::shared_ptr<Texture> texture_;
+  const std::shared_ptr<Texture> uv_texture_;
+  const YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Image);
 };
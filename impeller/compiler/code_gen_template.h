@@ -43,6 +43,35 @@ struct {{camel_case(shader_name)}}{{camel_case(shader_stage)}}Shader {
   // The generator used to prepare these bindings. Metal generators may be used
   // by GLES backends but GLES generators are unsuitable for the metal backend.
   static constexpr std::string_view kGeneratorName = "{{get_generator_name()}}";
+{% if length(specialization_constants) > 0 %}
+
+  // ===========================================================================
+  // Specialization Constants ==================================================
+  // ===========================================================================
+{% for constant in specialization_constants %}
+
+  static constexpr auto kSpecializationConstant{{camel_case(constant.name)}} = ShaderSpecializationConstantSlot { // {{constant.name}}
+    "{{constant.name}}",        // name
+    {{constant.constant_id}}u,  // constant id
+    {{constant.type}},          // type
+  };
+{% endfor %}
+
+  struct SpecializationConstants {
+{% for constant in specialization_constants %}
+    {{constant.cpp_type}} {{constant.name}} = {{constant.default_value}}; // (constant id {{constant.constant_id}})
+{% endfor %}
+  }; // struct SpecializationConstants
+
+  /// Create the values to specialize the constants of a pipeline with.
+  static std::vector<ShaderSpecializationConstant> CreateSpecializationConstants(const SpecializationConstants& constants) {
+    return {
+{% for constant in specialization_constants %}
+      ShaderSpecializationConstant(kSpecializationConstant{{camel_case(constant.name)}}, constants.{{constant.name}}),
+{% endfor %}
+    };
+  }
+{% endif %}
 {% if length(struct_definitions) > 0 %}
   // ===========================================================================
   // Struct Definitions ========================================================
@@ -7,6 +7,7 @@
 #include <array>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <utility>
 
@@ -17,6 +18,7 @@
 #include "impeller/compiler/logger.h"
 #include "impeller/compiler/types.h"
 #include "impeller/compiler/uniform_sorter.h"
+#include "spirv-tools/optimizer.hpp"
 
 namespace impeller {
 namespace compiler {
@@ -35,6 +37,12 @@ static CompilerBackend CreateMSLCompiler(const spirv_cross::ParsedIR& ir,
   // Metal to AIR must be updated as well.
   sl_options.msl_version =
       spirv_cross::CompilerMSL::Options::make_msl_version(1, 2);
+  // Apple GPUs can read the color attachment in the fragment shader. Subpass
+  // inputs are read from `[[color(n)]]` there instead of from a texture.
+  // Only the shaders of backends that support framebuffer fetch create
+  // pipelines that use subpass inputs.
+  sl_options.use_framebuffer_fetch_subpasses =
+      source_options.target_platform == TargetPlatform::kMetalIOS;
   sl_compiler->set_msl_options(sl_options);
 
   // Sort the float and sampler uniforms according to their declared/decorated
@@ -103,6 +111,14 @@ static CompilerBackend CreateGLSLCompiler(const spirv_cross::ParsedIR& ir,
     sl_options.es = false;
   }
   gl_compiler->set_common_options(sl_options);
+  // Subpass inputs read the color attachment with the same index using
+  // `GL_EXT_shader_framebuffer_fetch`. The pipelines using them are only
+  // created when the extension is available.
+  for (const auto& input : gl_compiler->get_shader_resources().subpass_inputs) {
+    auto index = gl_compiler->get_decoration(
+        input.id, spv::DecorationInputAttachmentIndex);
+    gl_compiler->remap_ext_framebuffer_fetch(index, index, true);
+  }
   return CompilerBackend(gl_compiler);
 }
 
@@ -130,6 +146,24 @@ static bool EntryPointMustBeNamedMain(TargetPlatform platform) {
   FML_UNREACHABLE();
 }
 
+static bool SupportsSpecializationConstants(TargetPlatform platform) {
+  switch (platform) {
+    case TargetPlatform::kUnknown:
+      FML_UNREACHABLE();
+    case TargetPlatform::kMetalDesktop:
+    case TargetPlatform::kMetalIOS:
+    case TargetPlatform::kVulkan:
+    case TargetPlatform::kOpenGLES:
+    case TargetPlatform::kOpenGLDesktop:
+      return true;
+    case TargetPlatform::kSkSL:
+    case TargetPlatform::kRuntimeStageMetal:
+    case TargetPlatform::kRuntimeStageGLES:
+      return false;
+  }
+  FML_UNREACHABLE();
+}
+
 static CompilerBackend CreateCompiler(const spirv_cross::ParsedIR& ir,
                                       const SourceOptions& source_options) {
   CompilerBackend compiler;
@@ -279,6 +313,33 @@ static void SetLimitations(shaderc::CompileOptions& compiler_opts) {
   }
 }
 
+// shaderc runs the performance passes of spirv-opt, which don't unroll loops.
+// Loops with trip counts known at compile time, like the ones over fixed size
+// kernels, are unrolled fully here. The performance passes then run again to
+// fold the indices of the unrolled iterations and remove the code that is
+// left dead.
+static bool UnrollLoops(std::vector<uint32_t>& spirv,
+                        spv_target_env target_env,
+                        std::stringstream& error_stream) {
+  spvtools::Optimizer optimizer(target_env);
+  optimizer.SetMessageConsumer(
+      [&error_stream](spv_message_level_t level, const char*,
+                      const spv_position_t&, const char* message) {
+        if (level <= SPV_MSG_ERROR) {
+          error_stream << message << std::endl;
+        }
+      });
+  optimizer.RegisterPass(spvtools::CreateLoopUnrollPass(true));
+  optimizer.RegisterPerformancePasses();
+
+  std::vector<uint32_t> optimized;
+  if (!optimizer.Run(spirv.data(), spirv.size(), &optimized)) {
+    return false;
+  }
+  spirv = std::move(optimized);
+  return true;
+}
+
 void Compiler::SetBindingBase(shaderc::CompileOptions& compiler_opts) const {
   for (size_t uniform_kind = 0; uniform_kind < kNumUniformKinds;
        uniform_kind++) {
@@ -337,6 +398,8 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
 
   SetLimitations(spirv_options);
 
+  // The environment to further optimize the SPIR-V for, if any.
+  std::optional<spv_target_env> optimization_env;
   switch (source_options.target_platform) {
     case TargetPlatform::kMetalDesktop:
     case TargetPlatform::kMetalIOS:
@@ -349,6 +412,7 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
           shaderc_env_version::shaderc_env_version_vulkan_1_1);
       spirv_options.SetTargetSpirv(
           shaderc_spirv_version::shaderc_spirv_version_1_3);
+      optimization_env = SPV_ENV_VULKAN_1_1;
       break;
     case TargetPlatform::kVulkan:
       spirv_options.SetOptimizationLevel(
@@ -358,6 +422,7 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
           shaderc_env_version::shaderc_env_version_vulkan_1_0);
       spirv_options.SetTargetSpirv(
           shaderc_spirv_version::shaderc_spirv_version_1_0);
+      optimization_env = SPV_ENV_VULKAN_1_0;
       break;
     case TargetPlatform::kRuntimeStageMetal:
     case TargetPlatform::kRuntimeStageGLES:
@@ -369,6 +434,7 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
       spirv_options.SetTargetSpirv(
           shaderc_spirv_version::shaderc_spirv_version_1_0);
       spirv_options.AddMacroDefinition("IMPELLER_GRAPHICS_BACKEND");
+      optimization_env = SPV_ENV_OPENGL_4_5;
       break;
     case TargetPlatform::kSkSL:
       // When any optimization level above 'zero' is enabled, the phi merges at
@@ -418,7 +484,7 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
   }
 
   // SPIRV Generation.
-  spv_result_ = std::make_shared<shaderc::SpvCompilationResult>(
+  auto spv_result = std::make_shared<shaderc::SpvCompilationResult>(
       spv_compiler.CompileGlslToSpv(
           reinterpret_cast<const char*>(
               source_mapping.GetMapping()),         // source_text
@@ -428,29 +494,38 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
           source_options.entry_point_name.c_str(),  // entry_point_name
           spirv_options                             // options
           ));
-  if (spv_result_->GetCompilationStatus() !=
+  if (spv_result->GetCompilationStatus() !=
       shaderc_compilation_status::shaderc_compilation_status_success) {
     COMPILER_ERROR << SourceLanguageToString(options_.source_language)
                    << " to SPIRV failed; "
-                   << ShaderCErrorToString(spv_result_->GetCompilationStatus())
-                   << ". " << spv_result_->GetNumErrors() << " error(s) and "
-                   << spv_result_->GetNumWarnings() << " warning(s).";
-    if (spv_result_->GetNumErrors() > 0 || spv_result_->GetNumWarnings() > 0) {
-      COMPILER_ERROR_NO_PREFIX << spv_result_->GetErrorMessage();
+                   << ShaderCErrorToString(spv_result->GetCompilationStatus())
+                   << ". " << spv_result->GetNumErrors() << " error(s) and "
+                   << spv_result->GetNumWarnings() << " warning(s).";
+    if (spv_result->GetNumErrors() > 0 || spv_result->GetNumWarnings() > 0) {
+      COMPILER_ERROR_NO_PREFIX << spv_result->GetErrorMessage();
     }
     return;
   } else {
     included_file_names_ = std::move(included_file_names);
   }
 
+  std::vector<uint32_t> spirv(spv_result->cbegin(), spv_result->cend());
+  if (std::stringstream optimizer_errors;
+      optimization_env.has_value() &&
+      !UnrollLoops(spirv, optimization_env.value(), optimizer_errors)) {
+    COMPILER_ERROR << "Could not optimize the SPIRV.";
+    COMPILER_ERROR_NO_PREFIX << optimizer_errors.str();
+    return;
+  }
+  spirv_ = std::make_shared<const std::vector<uint32_t>>(std::move(spirv));
+
   if (!TargetPlatformNeedsSL(source_options.target_platform)) {
     is_valid_ = true;
     return;
   }
 
   // SL Generation.
-  spirv_cross::Parser parser(spv_result_->cbegin(),
-                             spv_result_->cend() - spv_result_->cbegin());
+  spirv_cross::Parser parser(spirv_->data(), spirv_->size());
   // The parser and compiler must be run separately because the parser contains
   // meta information (like type member names) that are useful for reflection.
   parser.parse();
@@ -465,6 +540,15 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
     return;
   }
 
+  // Nothing specializes the constants of runtime effects, and SkSL has no
+  // equivalent of them.
+  if (!SupportsSpecializationConstants(source_options.target_platform) &&
+      !sl_compiler.GetCompiler()->get_specialization_constants().empty()) {
+    COMPILER_ERROR << "Specialization constants are not supported by the "
+                      "target platform.";
+    return;
+  }
+
   // We need to invoke the compiler even if we don't use the SL mapping later
   // for Vulkan. The reflector needs information that is only valid after a
   // successful compilation call.
@@ -500,16 +584,14 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
 Compiler::~Compiler() = default;
 
 std::unique_ptr<fml::Mapping> Compiler::GetSPIRVAssembly() const {
-  if (!spv_result_) {
+  if (!spirv_) {
     return nullptr;
   }
-  const auto data_length =
-      (spv_result_->cend() - spv_result_->cbegin()) *
-      sizeof(decltype(spv_result_)::element_type::element_type);
+  const auto data_length = spirv_->size() * sizeof(uint32_t);
 
   return std::make_unique<fml::NonOwnedMapping>(
-      reinterpret_cast<const uint8_t*>(spv_result_->cbegin()), data_length,
-      [result = spv_result_](auto, auto) mutable { result.reset(); });
+      reinterpret_cast<const uint8_t*>(spirv_->data()), data_length,
+      [spirv = spirv_](auto, auto) mutable { spirv.reset(); });
 }
 
 std::shared_ptr<fml::Mapping> Compiler::GetSLShaderSource() const {
@@ -7,6 +7,7 @@
 #include <initializer_list>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
@@ -46,7 +47,7 @@ class Compiler {
 
  private:
   SourceOptions options_;
-  std::shared_ptr<shaderc::SpvCompilationResult> spv_result_;
+  std::shared_ptr<const std::vector<uint32_t>> spirv_;
   std::shared_ptr<fml::Mapping> sl_mapping_;
   std::stringstream error_stream_;
   std::unique_ptr<Reflector> reflector_;
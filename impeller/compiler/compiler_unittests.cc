@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <map>
+#include <string>
+#include <string_view>
+
 #include "flutter/testing/testing.h"
 #include "impeller/base/validation.h"
 #include "impeller/compiler/compiler.h"
@@ -123,6 +127,47 @@ TEST_P(CompilerTest, UniformsHaveBindingAndSet) {
   ASSERT_EQ(vert_uniform_binding.binding, 17u);
 }
 
+TEST_P(CompilerTest, SpecializationConstantsAreReflected) {
+  ASSERT_TRUE(CanCompileAndReflect("specialization_constants.frag",
+                                   SourceType::kFragmentShader));
+
+  auto json_fd = GetReflectionJson("specialization_constants.frag");
+  nlohmann::json shader_json = nlohmann::json::parse(json_fd->GetMapping());
+  auto constants = shader_json["specialization_constants"];
+  ASSERT_EQ(constants.size(), 3u);
+
+  std::map<std::string, nlohmann::json> constants_by_name;
+  for (const auto& constant : constants) {
+    constants_by_name[constant["name"].get<std::string>()] = constant;
+  }
+
+  auto use_color = constants_by_name["kUseColor"];
+  EXPECT_EQ(use_color["constant_id"].get<uint32_t>(), 0u);
+  EXPECT_EQ(use_color["cpp_type"].get<std::string>(), "bool");
+  EXPECT_EQ(use_color["default_value"].get<std::string>(), "true");
+
+  auto scale = constants_by_name["kScale"];
+  EXPECT_EQ(scale["constant_id"].get<uint32_t>(), 3u);
+  EXPECT_EQ(scale["cpp_type"].get<std::string>(), "Scalar");
+  EXPECT_EQ(scale["default_value"].get<std::string>(), "0.500000000f");
+
+  auto count = constants_by_name["kCount"];
+  EXPECT_EQ(count["constant_id"].get<uint32_t>(), 5u);
+  EXPECT_EQ(count["cpp_type"].get<std::string>(), "int32_t");
+  EXPECT_EQ(count["default_value"].get<std::string>(), "2");
+}
+
+TEST_P(CompilerTest, FixedSizeLoopsAreUnrolled) {
+  ASSERT_TRUE(CanCompileAndReflect("fixed_size_loop.frag",
+                                   SourceType::kFragmentShader));
+
+  auto shader = GetShaderFile("fixed_size_loop.frag", GetParam());
+  ASSERT_NE(shader, nullptr);
+  std::string_view source(reinterpret_cast<const char*>(shader->GetMapping()),
+                          shader->GetSize());
+  EXPECT_EQ(source.find("for ("), std::string_view::npos);
+}
+
 #define INSTANTIATE_TARGET_PLATFORM_TEST_SUITE_P(suite_name)              \
   INSTANTIATE_TEST_SUITE_P(                                               \
       suite_name, CompilerTest,                                           \
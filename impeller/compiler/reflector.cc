@@ -7,6 +7,7 @@
 #include "impeller/compiler/reflector.h"
 
 #include <atomic>
+#include <iomanip>
 #include <optional>
 #include <set>
 #include <sstream>
@@ -235,6 +236,14 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
 
   const auto shader_resources = compiler_->get_shader_resources();
 
+  if (auto specialization_constants = ReflectSpecializationConstants();
+      specialization_constants.has_value()) {
+    root["specialization_constants"] =
+        std::move(specialization_constants.value());
+  } else {
+    return std::nullopt;
+  }
+
   // Uniform and storage buffers.
   {
     auto& buffers = root["buffers"] = nlohmann::json::array_t{};
@@ -550,6 +559,50 @@ static std::optional<KnownType> ReadKnownScalarType(
   return std::nullopt;
 }
 
+static std::string FloatToCPPLiteral(float value) {
+  std::stringstream stream;
+  stream << std::setprecision(9) << std::showpoint << value << "f";
+  return stream.str();
+}
+
+std::optional<nlohmann::json::array_t>
+Reflector::ReflectSpecializationConstants() const {
+  nlohmann::json::array_t result;
+  for (const auto& constant : compiler_->get_specialization_constants()) {
+    const auto& value = compiler_->get_constant(constant.id);
+    const auto& type = compiler_->get_type(value.constant_type);
+    const auto name = compiler_->get_name(constant.id);
+    auto known_type = ReadKnownScalarType(type.basetype);
+    if (!known_type.has_value() || type.vecsize != 1u || type.columns != 1u) {
+      VALIDATION_LOG << "Specialization constant " << name
+                     << " must be a boolean, integer or float scalar.";
+      return std::nullopt;
+    }
+
+    nlohmann::json::object_t reflected;
+    reflected["name"] = name;
+    reflected["constant_id"] = constant.constant_id;
+    reflected["type"] = BaseTypeToString(type.basetype);
+    reflected["cpp_type"] = known_type->name;
+    switch (type.basetype) {
+      case spirv_cross::SPIRType::BaseType::Boolean:
+        reflected["default_value"] = value.scalar() != 0u ? "true" : "false";
+        break;
+      case spirv_cross::SPIRType::BaseType::Int:
+        reflected["default_value"] = std::to_string(value.scalar_i32());
+        break;
+      case spirv_cross::SPIRType::BaseType::UInt:
+        reflected["default_value"] = std::to_string(value.scalar()) + "u";
+        break;
+      default:
+        reflected["default_value"] = FloatToCPPLiteral(value.scalar_f32());
+        break;
+    }
+    result.emplace_back(std::move(reflected));
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Get the reflected struct size. In the vast majority of the
 ///             cases, this is the same as the declared struct size as given by
@@ -121,6 +121,9 @@ class Reflector {
   std::optional<nlohmann::json::object_t> ReflectType(
       const spirv_cross::TypeID& type_id) const;
 
+  std::optional<nlohmann::json::array_t> ReflectSpecializationConstants()
+      const;
+
   nlohmann::json::object_t EmitStructDefinition(
       std::optional<Reflector::StructDefinition> struc) const;
 
@@ -26,4 +26,20 @@ vec4 IPPremultiply(vec4 color) {
   return vec4(color.rgb * color.a, color.a);
 }
 
+// These values must correspond to the order of the items in the
+// 'YUVColorSpace' enum class.
+const float kYUVColorSpaceBT601LimitedRange = 0;
+const float kYUVColorSpaceBT601FullRange = 1;
+
+/// Convert a color sampled from the Y and UV planes of a YUV image to RGB.
+///
+/// `matrix` is the conversion matrix of `yuv_color_space`.
+vec4 IPYUVToRGB(vec3 yuv, mat4 matrix, float yuv_color_space) {
+  vec3 yuv_offset = vec3(0.0, 0.5, 0.5);
+  if (yuv_color_space == kYUVColorSpaceBT601LimitedRange) {
+    yuv_offset.x = 16.0 / 255.0;
+  }
+  return matrix * vec4(yuv - yuv_offset, 1);
+}
+
 #endif
@@ -21,4 +21,16 @@ vec3 IPComputeFixedGradientValues(float t, float colors_length) {
   return vec3(lower_index, upper_index, scale);
 }
 
+/// Add noise of up to half an 8 bit step to a premultiplied gradient color,
+/// so that gradients drawn into 8 bit render targets don't band.
+///
+/// The noise is interleaved gradient noise, which doesn't need a texture and
+/// has no visible pattern at the scale of a step.
+vec4 IPGradientDither(vec4 color, vec2 frag_coord) {
+  float noise = fract(52.9829189 *
+                      fract(dot(frag_coord, vec2(0.06711056, 0.00583715))));
+  vec3 dithered = color.rgb + (noise - 0.5) / 255.0;
+  return vec4(clamp(dithered, vec3(0), vec3(color.a)), color.a);
+}
+
 #endif
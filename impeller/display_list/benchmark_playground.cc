@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/benchmark_playground.h"
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+
+BenchmarkPlayground::BenchmarkPlayground(PlaygroundBackend backend) {
+  SetupContext(backend);
+}
+
+BenchmarkPlayground::~BenchmarkPlayground() {
+  TeardownWindow();
+}
+
+// |Playground|
+std::unique_ptr<fml::Mapping> BenchmarkPlayground::OpenAssetAsMapping(
+    std::string asset_name) const {
+  return flutter::testing::OpenFixtureAsMapping(asset_name);
+}
+
+// |Playground|
+std::string BenchmarkPlayground::GetWindowTitle() const {
+  return "Impeller Benchmarks";
+}
+
+bool WaitForGPU(const Context& context) {
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  fml::AutoResetWaitableEvent latch;
+  bool completed = false;
+  if (!command_buffer->SubmitCommands(
+          [&latch, &completed](CommandBuffer::Status status) {
+            completed = status == CommandBuffer::Status::kCompleted;
+            latch.Signal();
+          })) {
+    return false;
+  }
+  latch.Wait();
+  return completed;
+}
+
+}  // namespace impeller
@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "impeller/playground/playground.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A playground without a visible window that only provides the
+///             context for the requested backend.
+///
+class BenchmarkPlayground final : public Playground {
+ public:
+  explicit BenchmarkPlayground(PlaygroundBackend backend);
+
+  ~BenchmarkPlayground() override;
+
+  // |Playground|
+  std::unique_ptr<fml::Mapping> OpenAssetAsMapping(
+      std::string asset_name) const override;
+
+  // |Playground|
+  std::string GetWindowTitle() const override;
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(BenchmarkPlayground);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Submits an empty command buffer and waits for it to complete.
+///             As the queue executes command buffers in order, this returns
+///             once all of the work submitted before it is done.
+///
+///             On OpenGLES, command buffers complete as soon as their
+///             commands have been issued to the driver, so the wait only
+///             covers that part of the work.
+///
+bool WaitForGPU(const Context& context);
+
+}  // namespace impeller
@@ -0,0 +1,238 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/testing/testing.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/display_list/benchmark_playground.h"
+#include "impeller/display_list/display_list_dispatcher.h"
+#include "impeller/display_list/display_list_image_impeller.h"
+#include "impeller/playground/playground.h"
+#include "impeller/renderer/render_target.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace impeller {
+
+namespace {
+
+/// The same kinds of content as the Skia benchmarks in
+/// //flutter/display_list/display_list_benchmarks.cc, each drawn a number of
+/// times given by the benchmark range.
+enum class BenchmarkScene {
+  kLines,
+  kRects,
+  kPaths,
+  kText,
+  kImages,
+  kSaveLayers,
+};
+
+constexpr ISize kCanvasSize = ISize(1024, 1024);
+
+sk_sp<SkData> OpenFixtureAsSkData(const char* fixture_name) {
+  auto mapping = flutter::testing::OpenFixtureAsMapping(fixture_name);
+  if (!mapping) {
+    return nullptr;
+  }
+  auto data = SkData::MakeWithProc(
+      mapping->GetMapping(), mapping->GetSize(),
+      [](const void* ptr, void* context) {
+        delete reinterpret_cast<fml::Mapping*>(context);
+      },
+      mapping.get());
+  mapping.release();
+  return data;
+}
+
+SkPath MakeCubicPath(SkScalar x, SkScalar y) {
+  SkPath path;
+  path.moveTo(x, y);
+  path.cubicTo(x + 10, y - 20, x + 30, y + 20, x + 40, y);
+  path.cubicTo(x + 30, y + 30, x + 10, y + 10, x, y + 40);
+  path.close();
+  return path;
+}
+
+sk_sp<flutter::DisplayList> MakeScene(BenchmarkScene scene,
+                                      size_t count,
+                                      const Playground& playground) {
+  flutter::DisplayListBuilder builder;
+  builder.setColor(SK_ColorBLUE);
+  builder.setAntiAlias(true);
+
+  // Spreads the ops over the canvas so that they do not all cover the same
+  // pixels.
+  auto origin = [](size_t i) {
+    return SkPoint::Make((i * 37) % (kCanvasSize.width - 64),
+                         (i * 53) % (kCanvasSize.height - 64));
+  };
+
+  switch (scene) {
+    case BenchmarkScene::kLines:
+      builder.setStyle(flutter::DlDrawStyle::kStroke);
+      builder.setStrokeWidth(2.0f);
+      for (size_t i = 0; i < count; i++) {
+        auto p0 = origin(i);
+        builder.drawLine(p0, SkPoint::Make(p0.x() + 64, p0.y() + 32));
+      }
+      break;
+    case BenchmarkScene::kRects:
+      for (size_t i = 0; i < count; i++) {
+        auto point = origin(i);
+        builder.drawRect(SkRect::MakeXYWH(point.x(), point.y(), 48, 48));
+      }
+      break;
+    case BenchmarkScene::kPaths:
+      for (size_t i = 0; i < count; i++) {
+        auto point = origin(i);
+        builder.drawPath(MakeCubicPath(point.x(), point.y()));
+      }
+      break;
+    case BenchmarkScene::kText: {
+      auto mapping = OpenFixtureAsSkData("Roboto-Regular.ttf");
+      FML_CHECK(mapping);
+      SkFont font(SkTypeface::MakeFromData(mapping), 24);
+      auto blob = SkTextBlob::MakeFromString("Benchmark", font);
+      for (size_t i = 0; i < count; i++) {
+        auto point = origin(i);
+        builder.drawTextBlob(blob, point.x(), point.y() + 24);
+      }
+      break;
+    }
+    case BenchmarkScene::kImages: {
+      auto texture = playground.CreateTextureForFixture("embarcadero.jpg");
+      FML_CHECK(texture);
+      auto image = DlImageImpeller::Make(texture);
+      auto size = texture->GetSize();
+      auto src = SkRect::MakeWH(size.width, size.height);
+      for (size_t i = 0; i < count; i++) {
+        auto point = origin(i);
+        builder.drawImageRect(image, src,
+                              SkRect::MakeXYWH(point.x(), point.y(), 64, 64),
+                              flutter::DlImageSampling::kLinear);
+      }
+      break;
+    }
+    case BenchmarkScene::kSaveLayers:
+      for (size_t i = 0; i < count; i++) {
+        auto point = origin(i);
+        auto bounds = SkRect::MakeXYWH(point.x(), point.y(), 64, 64);
+        builder.saveLayer(&bounds, false);
+        builder.drawRect(bounds.makeInset(8, 8));
+        builder.restore();
+      }
+      break;
+  }
+  return builder.Build();
+}
+
+}  // namespace
+
+/// Renders a display list of the requested scene through the
+/// |DisplayListDispatcher| and an |AiksContext|.
+///
+/// Each iteration converts the display list to a picture and encodes and
+/// submits its command buffers, which is reported as "EncodeMs", and then
+/// waits for the GPU to finish them, which is reported as "GPUMs". The time
+/// of the iteration is the sum of both.
+static void BM_DisplayList(benchmark::State& state,
+                           PlaygroundBackend backend,
+                           BenchmarkScene scene) {
+  if (!Playground::SupportsBackend(backend)) {
+    state.SkipWithError("Backend is not supported on this platform.");
+    return;
+  }
+  BenchmarkPlayground playground(backend);
+  auto context = playground.GetContext();
+  if (!context || !context->IsValid()) {
+    state.SkipWithError("Could not create a context.");
+    return;
+  }
+  AiksContext aiks_context(context);
+  if (!aiks_context.IsValid()) {
+    state.SkipWithError("Could not create an AiksContext.");
+    return;
+  }
+
+  RenderTarget render_target;
+  if (context->SupportsOffscreenMSAA()) {
+    render_target = RenderTarget::CreateOffscreenMSAA(*context, kCanvasSize);
+  } else {
+    render_target = RenderTarget::CreateOffscreen(*context, kCanvasSize);
+  }
+  if (!render_target.IsValid()) {
+    state.SkipWithError("Could not create a render target.");
+    return;
+  }
+
+  size_t count = state.range(0);
+  auto display_list = MakeScene(scene, count, playground);
+  state.counters["DrawCallCount"] = count;
+
+  fml::TimeDelta encode_time;
+  fml::TimeDelta gpu_time;
+  for ([[maybe_unused]] auto _ : state) {
+    auto start = fml::TimePoint::Now();
+    DisplayListDispatcher dispatcher;
+    display_list->Dispatch(dispatcher);
+    auto picture = dispatcher.EndRecordingAsPicture();
+    if (!aiks_context.Render(picture, render_target)) {
+      state.SkipWithError("Could not render the picture.");
+      break;
+    }
+    auto encoded = fml::TimePoint::Now();
+    if (!WaitForGPU(*context)) {
+      state.SkipWithError("Could not wait for the GPU.");
+      break;
+    }
+    auto finished = fml::TimePoint::Now();
+
+    encode_time = encode_time + (encoded - start);
+    gpu_time = gpu_time + (finished - encoded);
+    state.SetIterationTime((finished - start).ToSecondsF());
+  }
+
+  state.counters["EncodeMs"] = benchmark::Counter(
+      encode_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+  state.counters["GPUMs"] = benchmark::Counter(
+      gpu_time.ToMillisecondsF(), benchmark::Counter::kAvgIterations);
+}
+
+#define DISPLAY_LIST_BENCHMARK(BACKEND, SCENE)               \
+  BENCHMARK_CAPTURE(BM_DisplayList, SCENE/BACKEND,           \
+                    PlaygroundBackend::k##BACKEND,           \
+                    BenchmarkScene::k##SCENE)                \
+      ->RangeMultiplier(4)                                   \
+      ->Range(16, 4096)                                      \
+      ->UseManualTime()                                      \
+      ->Unit(benchmark::kMillisecond);
+
+#define DISPLAY_LIST_BENCHMARKS(BACKEND)     \
+  DISPLAY_LIST_BENCHMARK(BACKEND, Lines)     \
+  DISPLAY_LIST_BENCHMARK(BACKEND, Rects)     \
+  DISPLAY_LIST_BENCHMARK(BACKEND, Paths)     \
+  DISPLAY_LIST_BENCHMARK(BACKEND, Text)      \
+  DISPLAY_LIST_BENCHMARK(BACKEND, Images)    \
+  DISPLAY_LIST_BENCHMARK(BACKEND, SaveLayers)
+
+#if IMPELLER_ENABLE_METAL
+DISPLAY_LIST_BENCHMARKS(Metal)
+#endif  // IMPELLER_ENABLE_METAL
+
+#if IMPELLER_ENABLE_OPENGLES
+DISPLAY_LIST_BENCHMARKS(OpenGLES)
+#endif  // IMPELLER_ENABLE_OPENGLES
+
+#if IMPELLER_ENABLE_VULKAN
+DISPLAY_LIST_BENCHMARKS(Vulkan)
+#endif  // IMPELLER_ENABLE_VULKAN
+
+}  // namespace impeller
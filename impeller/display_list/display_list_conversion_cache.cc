@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/display_list_conversion_cache.h"
+
+#include <utility>
+
+namespace impeller {
+
+DisplayListConversionCache::DisplayListConversionCache() = default;
+
+DisplayListConversionCache::~DisplayListConversionCache() = default;
+
+std::optional<Picture> DisplayListConversionCache::Get(uint32_t unique_id,
+                                                       const Matrix& basis) {
+  auto range = entries_.equal_range(unique_id);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto& entry = it->second;
+    if (entry.basis == basis && entry.picture.pass) {
+      entry.used = true;
+      Picture picture;
+      picture.pass = entry.picture.pass->Clone();
+      return picture;
+    }
+  }
+  return std::nullopt;
+}
+
+void DisplayListConversionCache::Put(uint32_t unique_id,
+                                     const Matrix& basis,
+                                     const Picture& picture) {
+  // Cloning a pass doesn't keep the delegate, blend mode or backdrop filter
+  // of its subpasses.
+  if (!picture.pass || picture.pass->GetSubpassesDepth() > 1u) {
+    return;
+  }
+  Entry entry;
+  entry.basis = basis;
+  entry.picture.pass = picture.pass->Clone();
+  auto range = entries_.equal_range(unique_id);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.basis == basis) {
+      it->second = std::move(entry);
+      return;
+    }
+  }
+  entries_.emplace(unique_id, std::move(entry));
+}
+
+uint64_t DisplayListConversionCache::GetPathKey(uint32_t generation_id,
+                                                FillType fill_type) {
+  return (static_cast<uint64_t>(generation_id) << 8) |
+         static_cast<uint64_t>(fill_type);
+}
+
+const Path* DisplayListConversionCache::GetPath(uint32_t generation_id,
+                                                FillType fill_type) {
+  auto found = paths_.find(GetPathKey(generation_id, fill_type));
+  if (found == paths_.end()) {
+    return nullptr;
+  }
+  found->second.used = true;
+  return &found->second.path;
+}
+
+void DisplayListConversionCache::PutPath(uint32_t generation_id,
+                                         FillType fill_type,
+                                         Path path) {
+  paths_[GetPathKey(generation_id, fill_type)] = {.path = std::move(path)};
+}
+
+void DisplayListConversionCache::EndFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (!it->second.used) {
+      it = entries_.erase(it);
+      continue;
+    }
+    it->second.used = false;
+    ++it;
+  }
+  for (auto it = paths_.begin(); it != paths_.end();) {
+    if (!it->second.used) {
+      it = paths_.erase(it);
+      continue;
+    }
+    it->second.used = false;
+    ++it;
+  }
+}
+
+size_t DisplayListConversionCache::GetPictureCount() const {
+  return entries_.size();
+}
+
+size_t DisplayListConversionCache::GetPathCount() const {
+  return paths_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/aiks/picture.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the pictures that nested display lists were converted to
+///             across frames, so that a display list that is drawn again is
+///             not converted again. Paths are kept in the same way.
+///
+///             Pictures are keyed by the unique id of the display list and
+///             the transform they were recorded with, less its translation.
+///             A cached picture is reused wherever the display list is drawn
+///             with the same transform up to a translation. A display list
+///             that changes has a new unique id, so its old pictures are
+///             no longer used and are dropped at the end of the first frame
+///             that doesn't use them.
+///
+///             The cache is not thread safe. It is meant to be used by the
+///             dispatchers of a surface on the raster thread.
+///
+class DisplayListConversionCache {
+ public:
+  DisplayListConversionCache();
+
+  ~DisplayListConversionCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a copy of the picture that the display list with the
+  ///             given unique id was converted to with the given basis.
+  ///
+  std::optional<Picture> Get(uint32_t unique_id, const Matrix& basis);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Store a copy of the picture that the display list with the
+  ///             given unique id was converted to with the given basis.
+  ///             Pictures with subpasses, i.e. with save layers, are not
+  ///             stored.
+  ///
+  void Put(uint32_t unique_id, const Matrix& basis, const Picture& picture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the path that the SkPath with the given generation id and
+  ///             fill type was converted to, or null if it isn't cached.
+  ///
+  ///             Skia changes the generation id of a path with each edit of
+  ///             its points or verbs, but not of its fill type.
+  ///
+  const Path* GetPath(uint32_t generation_id, FillType fill_type);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Store the path that the SkPath with the given generation id
+  ///             and fill type was converted to.
+  ///
+  void PutPath(uint32_t generation_id, FillType fill_type, Path path);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drop the pictures and paths that were neither used nor
+  ///             stored since the last call.
+  ///
+  void EndFrame();
+
+  size_t GetPictureCount() const;
+
+  size_t GetPathCount() const;
+
+ private:
+  struct Entry {
+    Matrix basis;
+    Picture picture;
+    bool used = true;
+  };
+
+  struct PathEntry {
+    Path path;
+    bool used = true;
+  };
+
+  std::unordered_multimap<uint32_t, Entry> entries_;
+  std::unordered_map<uint64_t, PathEntry> paths_;
+
+  static uint64_t GetPathKey(uint32_t generation_id, FillType fill_type);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListConversionCache);
+};
+
+}  // namespace impeller
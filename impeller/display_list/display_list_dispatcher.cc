@@ -18,6 +18,7 @@
 #include "display_list/display_list_path_effect.h"
 #include "display_list/display_list_tile_mode.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/display_list/display_list_image_impeller.h"
 #include "impeller/display_list/display_list_vertices_geometry.h"
@@ -46,8 +47,29 @@ namespace impeller {
 #define UNIMPLEMENTED \
   FML_DLOG(ERROR) << "Unimplemented detail in " << __FUNCTION__;
 
+// A nested display list that is converted on its own, on the work queue
+// or from the conversion cache, and drawn in its slot later.
+struct DisplayListDispatcher::Fragment {
+  Canvas::PictureSlot slot;
+  // The transform the fragment is recorded with. The transform of the slot
+  // is what remains of the transform at the slot.
+  Matrix basis;
+  Picture picture;
+  fml::ManualResetWaitableEvent converted;
+  // The unique id of the display list if the picture should be cached.
+  std::optional<uint32_t> cache_id;
+};
+
 DisplayListDispatcher::DisplayListDispatcher() = default;
 
+DisplayListDispatcher::DisplayListDispatcher(
+    std::shared_ptr<WorkQueue> work_queue,
+    std::shared_ptr<DisplayListConversionCache> conversion_cache)
+    : work_queue_(std::move(work_queue)),
+      conversion_cache_(std::move(conversion_cache)) {}
+
+// Fragments that are still being converted own their state and are
+// dropped when their task completes.
 DisplayListDispatcher::~DisplayListDispatcher() = default;
 
 static BlendMode ToBlendMode(flutter::DlBlendMode mode) {
@@ -770,8 +792,18 @@ void DisplayListDispatcher::setImageFilter(
   paint_.image_filter = ToImageFilterProc(filter);
 }
 
+const Paint& DisplayListDispatcher::ApplyGroupOpacity(const Paint& paint) {
+  if (group_opacity_ == 1.0f) {
+    return paint;
+  }
+  group_opacity_paint_ = paint;
+  group_opacity_paint_.color.alpha *= group_opacity_;
+  return group_opacity_paint_;
+}
+
 // |flutter::Dispatcher|
 void DisplayListDispatcher::save() {
+  group_opacity_stack_.push_back(group_opacity_);
   canvas_.Save();
 }
 
@@ -794,12 +826,31 @@ static std::vector<Rect> ToRects(const SkRect tex[], int count) {
 void DisplayListDispatcher::saveLayer(const SkRect* bounds,
                                       const flutter::SaveLayerOptions options,
                                       const flutter::DlImageFilter* backdrop) {
+  group_opacity_stack_.push_back(group_opacity_);
+  // The recorder only lets a layer distribute its opacity when none of its
+  // children overlap and they can all apply it to themselves, so the layer
+  // doesn't need a pass of its own. Like the Skia dispatcher, layers with
+  // bounds or a backdrop filter still get one.
+  if (bounds == nullptr && options.can_distribute_opacity() &&
+      backdrop == nullptr) {
+    if (options.renders_with_attributes()) {
+      group_opacity_ *= paint_.color.alpha;
+    }
+    canvas_.Save();
+    return;
+  }
   auto paint = options.renders_with_attributes() ? paint_ : Paint{};
-  canvas_.SaveLayer(paint, ToRect(bounds), ToImageFilterProc(backdrop));
+  canvas_.SaveLayer(ApplyGroupOpacity(paint), ToRect(bounds),
+                    ToImageFilterProc(backdrop));
+  group_opacity_ = 1.0f;
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::restore() {
+  if (!group_opacity_stack_.empty()) {
+    group_opacity_ = group_opacity_stack_.back();
+    group_opacity_stack_.pop_back();
+  }
   canvas_.Restore();
 }
 
@@ -892,8 +943,7 @@ static Entity::ClipOperation ToClipOperation(SkClipOp clip_op) {
 void DisplayListDispatcher::clipRect(const SkRect& rect,
                                      SkClipOp clip_op,
                                      bool is_aa) {
-  auto path = PathBuilder{}.AddRect(ToRect(rect)).TakePath();
-  canvas_.ClipPath(path, ToClipOperation(clip_op));
+  canvas_.ClipRect(ToRect(rect), ToClipOperation(clip_op));
 }
 
 static PathBuilder::RoundingRadii ToRoundingRadii(const SkRRect& rrect) {
@@ -906,6 +956,21 @@ static PathBuilder::RoundingRadii ToRoundingRadii(const SkRRect& rrect) {
   return radii;
 }
 
+static FillType ToFillType(SkPathFillType fill_type) {
+  switch (fill_type) {
+    case SkPathFillType::kWinding:
+      return FillType::kNonZero;
+    case SkPathFillType::kEvenOdd:
+      return FillType::kOdd;
+    case SkPathFillType::kInverseWinding:
+    case SkPathFillType::kInverseEvenOdd:
+      // Flutter doesn't expose these path fill types. These are only visible
+      // via the dispatcher interface. We should never get here.
+      return FillType::kNonZero;
+  }
+  return FillType::kNonZero;
+}
+
 static Path ToPath(const SkPath& path) {
   auto iterator = SkPath::Iter(path, false);
 
@@ -964,22 +1029,27 @@ static Path ToPath(const SkPath& path) {
     }
   } while (verb != SkPath::Verb::kDone_Verb);
 
-  FillType fill_type;
-  switch (path.getFillType()) {
-    case SkPathFillType::kWinding:
-      fill_type = FillType::kNonZero;
-      break;
-    case SkPathFillType::kEvenOdd:
-      fill_type = FillType::kOdd;
-      break;
-    case SkPathFillType::kInverseWinding:
-    case SkPathFillType::kInverseEvenOdd:
-      // Flutter doesn't expose these path fill types. These are only visible
-      // via the dispatcher interface. We should never get here.
-      fill_type = FillType::kNonZero;
-      break;
+  auto result = builder.TakePath(ToFillType(path.getFillType()));
+  if (path.isConvex()) {
+    result.SetConvexity(Convexity::kConvex);
   }
-  return builder.TakePath(fill_type);
+  return result;
+}
+
+Path DisplayListDispatcher::ToCachedPath(const SkPath& path) {
+  // lib/ui marks the paths that were not changed for a few frames as not
+  // volatile. They are likely to be drawn again as they are.
+  if (!conversion_cache_ || path.isVolatile()) {
+    return ToPath(path);
+  }
+  auto fill_type = ToFillType(path.getFillType());
+  if (auto cached = conversion_cache_->GetPath(path.getGenerationID(),
+                                               fill_type)) {
+    return *cached;
+  }
+  auto result = ToPath(path);
+  conversion_cache_->PutPath(path.getGenerationID(), fill_type, result);
+  return result;
 }
 
 static Path ToPath(const SkRRect& rrect) {
@@ -999,7 +1069,7 @@ void DisplayListDispatcher::clipRRect(const SkRRect& rrect,
 void DisplayListDispatcher::clipPath(const SkPath& path,
                                      SkClipOp clip_op,
                                      bool is_aa) {
-  canvas_.ClipPath(ToPath(path), ToClipOperation(clip_op));
+  canvas_.ClipPath(ToCachedPath(path), ToClipOperation(clip_op));
 }
 
 // |flutter::Dispatcher|
@@ -1007,49 +1077,48 @@ void DisplayListDispatcher::drawColor(flutter::DlColor color,
                                       flutter::DlBlendMode dl_mode) {
   Paint paint;
   paint.color = ToColor(color);
+  paint.color.alpha *= group_opacity_;
   paint.blend_mode = ToBlendMode(dl_mode);
   canvas_.DrawPaint(paint);
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawPaint() {
-  canvas_.DrawPaint(paint_);
+  canvas_.DrawPaint(ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawLine(const SkPoint& p0, const SkPoint& p1) {
-  auto path = PathBuilder{}.AddLine(ToPoint(p0), ToPoint(p1)).TakePath();
-  Paint paint = paint_;
-  paint.style = Paint::Style::kStroke;
-  canvas_.DrawPath(path, paint);
+  canvas_.DrawLine(ToPoint(p0), ToPoint(p1), ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawRect(const SkRect& rect) {
-  canvas_.DrawRect(ToRect(rect), paint_);
+  canvas_.DrawRect(ToRect(rect), ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawOval(const SkRect& bounds) {
   if (bounds.width() == bounds.height()) {
-    canvas_.DrawCircle(ToPoint(bounds.center()), bounds.width() * 0.5, paint_);
+    canvas_.DrawCircle(ToPoint(bounds.center()), bounds.width() * 0.5,
+                       ApplyGroupOpacity(paint_));
   } else {
-    auto path = PathBuilder{}.AddOval(ToRect(bounds)).TakePath();
-    canvas_.DrawPath(path, paint_);
+    canvas_.DrawOval(ToRect(bounds), ApplyGroupOpacity(paint_));
   }
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawCircle(const SkPoint& center, SkScalar radius) {
-  canvas_.DrawCircle(ToPoint(center), radius, paint_);
+  canvas_.DrawCircle(ToPoint(center), radius, ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawRRect(const SkRRect& rrect) {
   if (rrect.isSimple()) {
-    canvas_.DrawRRect(ToRect(rrect.rect()), rrect.getSimpleRadii().fX, paint_);
+    canvas_.DrawRRect(ToRect(rrect.rect()), rrect.getSimpleRadii().fX,
+                      ApplyGroupOpacity(paint_));
   } else {
-    canvas_.DrawPath(ToPath(rrect), paint_);
+    canvas_.DrawPath(ToPath(rrect), ApplyGroupOpacity(paint_));
   }
 }
 
@@ -1059,12 +1128,12 @@ void DisplayListDispatcher::drawDRRect(const SkRRect& outer,
   PathBuilder builder;
   builder.AddPath(ToPath(outer));
   builder.AddPath(ToPath(inner));
-  canvas_.DrawPath(builder.TakePath(FillType::kOdd), paint_);
+  canvas_.DrawPath(builder.TakePath(FillType::kOdd), ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawPath(const SkPath& path) {
-  canvas_.DrawPath(ToPath(path), paint_);
+  canvas_.DrawPath(ToCachedPath(path), ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
@@ -1075,43 +1144,34 @@ void DisplayListDispatcher::drawArc(const SkRect& oval_bounds,
   PathBuilder builder;
   builder.AddArc(ToRect(oval_bounds), Degrees(start_degrees),
                  Degrees(sweep_degrees), use_center);
-  canvas_.DrawPath(builder.TakePath(), paint_);
+  canvas_.DrawPath(builder.TakePath(), ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawPoints(SkCanvas::PointMode mode,
                                        uint32_t count,
                                        const SkPoint points[]) {
-  Paint paint = paint_;
+  Paint paint = ApplyGroupOpacity(paint_);
   paint.style = Paint::Style::kStroke;
   switch (mode) {
-    case SkCanvas::kPoints_PointMode:
-      if (paint.stroke_cap == Cap::kButt) {
-        paint.stroke_cap = Cap::kSquare;
-      }
+    case SkCanvas::kPoints_PointMode: {
+      std::vector<Point> centers(count);
       for (uint32_t i = 0; i < count; i++) {
-        Point p0 = ToPoint(points[i]);
-        auto path = PathBuilder{}.AddLine(p0, p0).TakePath();
-        canvas_.DrawPath(path, paint);
+        centers[i] = ToPoint(points[i]);
       }
+      canvas_.DrawPoints(std::move(centers), paint.stroke_width / 2, paint,
+                         paint.stroke_cap == Cap::kRound ? PointStyle::kRound
+                                                         : PointStyle::kSquare);
       break;
+    }
     case SkCanvas::kLines_PointMode:
       for (uint32_t i = 1; i < count; i += 2) {
-        Point p0 = ToPoint(points[i - 1]);
-        Point p1 = ToPoint(points[i]);
-        auto path = PathBuilder{}.AddLine(p0, p1).TakePath();
-        canvas_.DrawPath(path, paint);
+        canvas_.DrawLine(ToPoint(points[i - 1]), ToPoint(points[i]), paint);
       }
       break;
     case SkCanvas::kPolygon_PointMode:
-      if (count > 1) {
-        Point p0 = ToPoint(points[0]);
-        for (uint32_t i = 1; i < count; i++) {
-          Point p1 = ToPoint(points[i]);
-          auto path = PathBuilder{}.AddLine(p0, p1).TakePath();
-          canvas_.DrawPath(path, paint);
-          p0 = p1;
-        }
+      for (uint32_t i = 1; i < count; i++) {
+        canvas_.DrawLine(ToPoint(points[i - 1]), ToPoint(points[i]), paint);
       }
       break;
   }
@@ -1128,7 +1188,20 @@ void DisplayListDispatcher::drawSkVertices(const sk_sp<SkVertices> vertices,
 void DisplayListDispatcher::drawVertices(const flutter::DlVertices* vertices,
                                          flutter::DlBlendMode dl_mode) {
   canvas_.DrawVertices(DLVerticesGeometry::MakeVertices(vertices),
-                       ToBlendMode(dl_mode), paint_);
+                       ToBlendMode(dl_mode), ApplyGroupOpacity(paint_));
+}
+
+// The planes of YUV images are drawn as they are, without converting the
+// whole image first.
+static std::shared_ptr<Image> ToDrawnImage(
+    const sk_sp<flutter::DlImage>& image) {
+  auto impeller_image = dynamic_cast<const DlImageImpeller*>(image.get());
+  if (impeller_image && impeller_image->GetUVTexture()) {
+    return std::make_shared<Image>(impeller_image->GetTexture(),
+                                   impeller_image->GetUVTexture(),
+                                   impeller_image->GetYUVColorSpace());
+  }
+  return std::make_shared<Image>(image->impeller_texture());
 }
 
 // |flutter::Dispatcher|
@@ -1140,15 +1213,14 @@ void DisplayListDispatcher::drawImage(const sk_sp<flutter::DlImage> image,
     return;
   }
 
-  auto texture = image->impeller_texture();
-  if (!texture) {
+  const auto size = image->dimensions();
+  if (size.isEmpty()) {
     return;
   }
 
-  const auto size = texture->GetSize();
-  const auto src = SkRect::MakeWH(size.width, size.height);
+  const auto src = SkRect::MakeWH(size.width(), size.height());
   const auto dest =
-      SkRect::MakeXYWH(point.fX, point.fY, size.width, size.height);
+      SkRect::MakeXYWH(point.fX, point.fY, size.width(), size.height());
 
   drawImageRect(
       image,                   // image
@@ -1169,11 +1241,11 @@ void DisplayListDispatcher::drawImageRect(
     bool render_with_attributes,
     SkCanvas::SrcRectConstraint constraint) {
   canvas_.DrawImageRect(
-      std::make_shared<Image>(image->impeller_texture()),  // image
-      ToRect(src),                                         // source rect
-      ToRect(dst),                                         // destination rect
-      render_with_attributes ? paint_ : Paint(),           // paint
-      ToSamplerDescriptor(sampling)                        // sampling
+      ToDrawnImage(image),                                           // image
+      ToRect(src),                                                   // source
+      ToRect(dst),                                                   // dest
+      ApplyGroupOpacity(render_with_attributes ? paint_ : Paint()),  // paint
+      ToSamplerDescriptor(sampling)                                  // sampling
   );
 }
 
@@ -1183,11 +1255,12 @@ void DisplayListDispatcher::drawImageNine(const sk_sp<flutter::DlImage> image,
                                           const SkRect& dst,
                                           flutter::DlFilterMode filter,
                                           bool render_with_attributes) {
+  Paint paint = ApplyGroupOpacity(paint_);
   NinePatchConverter converter = {};
   converter.DrawNinePatch(
       std::make_shared<Image>(image->impeller_texture()),
       Rect::MakeLTRB(center.fLeft, center.fTop, center.fRight, center.fBottom),
-      ToRect(dst), ToSamplerDescriptor(filter), &canvas_, &paint_);
+      ToRect(dst), ToSamplerDescriptor(filter), &canvas_, &paint);
 }
 
 // |flutter::Dispatcher|
@@ -1215,7 +1288,8 @@ void DisplayListDispatcher::drawAtlas(const sk_sp<flutter::DlImage> atlas,
   canvas_.DrawAtlas(std::make_shared<Image>(atlas->impeller_texture()),
                     ToRSXForms(xform, count), ToRects(tex, count),
                     ToColors(colors, count), ToBlendMode(mode),
-                    ToSamplerDescriptor(sampling), ToRect(cull_rect), paint_);
+                    ToSamplerDescriptor(sampling), ToRect(cull_rect),
+                    ApplyGroupOpacity(paint_));
 }
 
 // |flutter::Dispatcher|
@@ -1229,12 +1303,24 @@ void DisplayListDispatcher::drawPicture(const sk_sp<SkPicture> picture,
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawDisplayList(
     const sk_sp<flutter::DisplayList> display_list) {
+  auto op_count = display_list->op_count(true);
+  bool concurrent = work_queue_ && op_count >= kMinConcurrentOpCount;
+  bool cached = conversion_cache_ && op_count >= kMinCachedOpCount;
+  // Fragments are recorded without the opacity a parent layer distributes.
+  if ((concurrent || cached) && group_opacity_ == 1.0f) {
+    DrawDisplayListFragment(display_list, concurrent, cached);
+    return;
+  }
   int saveCount = canvas_.GetSaveCount();
+  size_t group_opacity_depth = group_opacity_stack_.size();
+  Scalar group_opacity = group_opacity_;
   Paint savePaint = paint_;
   paint_ = Paint();
   display_list->Dispatch(*this);
   paint_ = savePaint;
   canvas_.RestoreToCount(saveCount);
+  group_opacity_stack_.resize(group_opacity_depth);
+  group_opacity_ = group_opacity;
 }
 
 // |flutter::Dispatcher|
@@ -1244,7 +1330,7 @@ void DisplayListDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
   Scalar scale = canvas_.GetCurrentTransformation().GetMaxBasisLength();
   canvas_.DrawTextFrame(TextFrameFromTextBlob(blob, scale),  //
                         impeller::Point{x, y},               //
-                        paint_                               //
+                        ApplyGroupOpacity(paint_)            //
   );
 }
 
@@ -1292,6 +1378,7 @@ void DisplayListDispatcher::drawShadow(const SkPath& path,
   Paint paint;
   paint.style = Paint::Style::kFill;
   paint.color = spot_color;
+  paint.color.alpha *= group_opacity_;
   paint.mask_blur_descriptor = Paint::MaskBlurDescriptor{
       .style = FilterContents::BlurStyle::kNormal,
       .sigma = Radius{kLightRadius * occluder_z /
@@ -1309,8 +1396,8 @@ void DisplayListDispatcher::drawShadow(const SkPath& path,
     canvas_.DrawRect(ToRect(rect), paint);
   } else if (path.isRRect(&rrect) && rrect.isSimple()) {
     canvas_.DrawRRect(ToRect(rrect.rect()), rrect.getSimpleRadii().fX, paint);
-  } else if (path.isOval(&oval) && oval.width() == oval.height()) {
-    canvas_.DrawCircle(ToPoint(oval.center()), oval.width() * 0.5, paint);
+  } else if (path.isOval(&oval)) {
+    canvas_.DrawOval(ToRect(oval), paint);
   } else {
     canvas_.DrawPath(ToPath(path), paint);
   }
@@ -1318,8 +1405,84 @@ void DisplayListDispatcher::drawShadow(const SkPath& path,
   canvas_.Restore();
 }
 
+// Splits the |xformation| into a |basis| that the fragment is recorded
+// with and what is left of it, which is applied to the recording. Affine
+// transforms only leave their translation so that the recording can be
+// reused wherever the basis is the same.
+static void SplitFragmentTransformation(Matrix* xformation, Matrix* basis) {
+  if (!xformation->IsAffine()) {
+    *basis = *xformation;
+    *xformation = Matrix();
+    return;
+  }
+  *basis = *xformation;
+  basis->m[12] = 0;
+  basis->m[13] = 0;
+  *xformation = Matrix::MakeTranslation({xformation->m[12], xformation->m[13]});
+}
+
+void DisplayListDispatcher::DrawDisplayListFragment(
+    const sk_sp<flutter::DisplayList>& display_list,
+    bool concurrent,
+    bool cached) {
+  // A nested display list starts with a default paint and leaves the
+  // state of the canvas as it was, so it can be converted on its own and
+  // drawn at the current position with the current transform and clip.
+  auto fragment = std::make_shared<Fragment>();
+  fragment->slot = canvas_.ReservePictureSlot();
+  SplitFragmentTransformation(&fragment->slot.xformation, &fragment->basis);
+  fragments_.push_back(fragment);
+
+  if (cached) {
+    auto picture =
+        conversion_cache_->Get(display_list->unique_id(), fragment->basis);
+    if (picture.has_value()) {
+      fragment->picture = std::move(picture.value());
+      fragment->converted.Signal();
+      return;
+    }
+    fragment->cache_id = display_list->unique_id();
+  }
+
+  auto convert = [fragment, display_list]() {
+    TRACE_EVENT0("impeller", "DisplayListDispatcher::ConvertFragment");
+    // Nested fragments are converted inline so that workers never wait on
+    // other workers.
+    DisplayListDispatcher dispatcher;
+    dispatcher.canvas_.Transform(fragment->basis);
+    display_list->Dispatch(dispatcher);
+    fragment->picture = dispatcher.EndRecordingAsPicture();
+    fragment->converted.Signal();
+  };
+  if (concurrent) {
+    work_queue_->PostTask(std::move(convert));
+  } else {
+    convert();
+  }
+}
+
+void DisplayListDispatcher::StitchFragments() {
+  if (fragments_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "DisplayListDispatcher::StitchFragments");
+  // Inserting the last fragment first keeps the positions of the earlier
+  // ones valid.
+  for (auto it = fragments_.rbegin(); it != fragments_.rend(); ++it) {
+    auto& fragment = *it;
+    fragment->converted.Wait();
+    if (fragment->cache_id.has_value()) {
+      conversion_cache_->Put(fragment->cache_id.value(), fragment->basis,
+                             fragment->picture);
+    }
+    canvas_.DrawPictureInSlot(fragment->slot, std::move(fragment->picture));
+  }
+  fragments_.clear();
+}
+
 Picture DisplayListDispatcher::EndRecordingAsPicture() {
   TRACE_EVENT0("impeller", "DisplayListDispatcher::EndRecordingAsPicture");
+  StitchFragments();
   return canvas_.EndRecordingAsPicture();
 }
 
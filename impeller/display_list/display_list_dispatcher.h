@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "display_list/display_list_path_effect.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_blend_mode.h"
@@ -11,6 +14,8 @@
 #include "flutter/fml/macros.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/paint.h"
+#include "impeller/base/work_queue.h"
+#include "impeller/display_list/display_list_conversion_cache.h"
 
 namespace impeller {
 
@@ -18,8 +23,30 @@ class DisplayListDispatcher final : public flutter::Dispatcher {
  public:
   DisplayListDispatcher();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a dispatcher that converts large nested display lists
+  ///             concurrently on the given work queue. The converted lists are
+  ///             stitched back into the picture in |EndRecordingAsPicture|.
+  ///
+  /// @param[in]  work_queue        The queue to convert nested display lists
+  ///                               on, or nullptr to convert them inline.
+  /// @param[in]  conversion_cache  If set, nested display lists are reused
+  ///                               from and stored in this cache.
+  ///
+  explicit DisplayListDispatcher(
+      std::shared_ptr<WorkQueue> work_queue,
+      std::shared_ptr<DisplayListConversionCache> conversion_cache = nullptr);
+
   ~DisplayListDispatcher();
 
+  /// Nested display lists with at least this many ops, including the ops of
+  /// their own nested lists, are converted concurrently.
+  static constexpr unsigned int kMinConcurrentOpCount = 256u;
+
+  /// Nested display lists with at least this many ops are stored in the
+  /// conversion cache, if there is one.
+  static constexpr unsigned int kMinCachedOpCount = 16u;
+
   Picture EndRecordingAsPicture();
 
   // |flutter::Dispatcher|
@@ -237,8 +264,33 @@ class DisplayListDispatcher final : public flutter::Dispatcher {
                   SkScalar dpr) override;
 
  private:
+  struct Fragment;
+
   Paint paint_;
   Canvas canvas_;
+  std::shared_ptr<WorkQueue> work_queue_;
+  std::shared_ptr<DisplayListConversionCache> conversion_cache_;
+  std::vector<std::shared_ptr<Fragment>> fragments_;
+  // The opacity that the layers which were elided because they distribute
+  // their opacity to their children leave to the draws, and its value at
+  // each save.
+  Scalar group_opacity_ = 1.0f;
+  std::vector<Scalar> group_opacity_stack_;
+  Paint group_opacity_paint_;
+
+  void DrawDisplayListFragment(const sk_sp<flutter::DisplayList>& display_list,
+                               bool concurrent,
+                               bool cached);
+
+  // Converts the path, reusing the conversion cached for a path that is not
+  // volatile if there is a conversion cache.
+  Path ToCachedPath(const SkPath& path);
+
+  // Returns |paint| with the group opacity applied. The result is only valid
+  // until the next call.
+  const Paint& ApplyGroupOpacity(const Paint& paint);
+
+  void StitchFragments();
 
   FML_DISALLOW_COPY_AND_ASSIGN(DisplayListDispatcher);
 };
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/display_list_glyph_prerasterizer.h"
+
+#include <vector>
+
+#include "flutter/display_list/display_list_utils.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/backends/skia/text_render_context_skia.h"
+
+namespace impeller {
+
+namespace {
+
+/// Tracks the transform the same way the DisplayListDispatcher does so that
+/// text frames are created at the scale they will be rendered at.
+class GlyphPrerasterizer final
+    : public virtual flutter::Dispatcher,
+      public flutter::IgnoreAttributeDispatchHelper,
+      public flutter::IgnoreClipDispatchHelper,
+      public flutter::IgnoreDrawDispatchHelper {
+ public:
+  explicit GlyphPrerasterizer(Scalar scale)
+      : xformation_stack_({Matrix::MakeScale({scale, scale, 1.0})}) {}
+
+  // |flutter::Dispatcher|
+  void save() override {
+    xformation_stack_.push_back(xformation_stack_.back());
+  }
+
+  // |flutter::Dispatcher|
+  void saveLayer(const SkRect* bounds,
+                 const flutter::SaveLayerOptions options,
+                 const flutter::DlImageFilter* backdrop) override {
+    save();
+  }
+
+  // |flutter::Dispatcher|
+  void restore() override {
+    if (xformation_stack_.size() > 1) {
+      xformation_stack_.pop_back();
+    }
+  }
+
+  // |flutter::Dispatcher|
+  void translate(SkScalar tx, SkScalar ty) override {
+    Concat(Matrix::MakeTranslation({tx, ty, 0.0}));
+  }
+
+  // |flutter::Dispatcher|
+  void scale(SkScalar sx, SkScalar sy) override {
+    Concat(Matrix::MakeScale({sx, sy, 1.0}));
+  }
+
+  // |flutter::Dispatcher|
+  void rotate(SkScalar degrees) override {
+    Concat(Matrix::MakeRotationZ(Degrees{degrees}));
+  }
+
+  // |flutter::Dispatcher|
+  void skew(SkScalar sx, SkScalar sy) override {
+    Concat(Matrix::MakeSkew(sx, sy));
+  }
+
+  // |flutter::Dispatcher|
+  void transform2DAffine(SkScalar mxx,
+                         SkScalar mxy,
+                         SkScalar mxt,
+                         SkScalar myx,
+                         SkScalar myy,
+                         SkScalar myt) override {
+    // clang-format off
+    transformFullPerspective(
+      mxx, mxy,  0, mxt,
+      myx, myy,  0, myt,
+      0  ,   0,  1,   0,
+      0  ,   0,  0,   1
+    );
+    // clang-format on
+  }
+
+  // |flutter::Dispatcher|
+  void transformFullPerspective(SkScalar mxx,
+                                SkScalar mxy,
+                                SkScalar mxz,
+                                SkScalar mxt,
+                                SkScalar myx,
+                                SkScalar myy,
+                                SkScalar myz,
+                                SkScalar myt,
+                                SkScalar mzx,
+                                SkScalar mzy,
+                                SkScalar mzz,
+                                SkScalar mzt,
+                                SkScalar mwx,
+                                SkScalar mwy,
+                                SkScalar mwz,
+                                SkScalar mwt) override {
+    // The order of arguments is row-major but Impeller matrices are
+    // column-major.
+    // clang-format off
+    Concat(Matrix{
+      mxx, myx, mzx, mwx,
+      mxy, myy, mzy, mwy,
+      mxz, myz, mzz, mwz,
+      mxt, myt, mzt, mwt
+    });
+    // clang-format on
+  }
+
+  // |flutter::Dispatcher|
+  void transformReset() override { xformation_stack_.back() = Matrix{}; }
+
+  // |flutter::Dispatcher|
+  void drawDisplayList(
+      const sk_sp<flutter::DisplayList> display_list) override {
+    auto save_count = xformation_stack_.size();
+    display_list->Dispatch(*this);
+    xformation_stack_.resize(save_count);
+  }
+
+  // |flutter::Dispatcher|
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Scalar scale = xformation_stack_.back().GetMaxBasisLength();
+    TextRenderContextSkia::PrerasterizeGlyphs(
+        TextFrameFromTextBlob(blob, scale));
+  }
+
+ private:
+  std::vector<Matrix> xformation_stack_;
+
+  void Concat(const Matrix& xformation) {
+    xformation_stack_.back() = xformation_stack_.back() * xformation;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphPrerasterizer);
+};
+
+}  // namespace
+
+void PrerasterizeDisplayListGlyphs(const flutter::DisplayList& display_list,
+                                   Scalar scale) {
+  TRACE_EVENT0("impeller", "PrerasterizeDisplayListGlyphs");
+  GlyphPrerasterizer prerasterizer(scale);
+  display_list.Dispatch(prerasterizer);
+}
+
+}  // namespace impeller
@@ -0,0 +1,29 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include "flutter/display_list/display_list.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Rasterize the glyphs of every text blob in the display list,
+///             including nested display lists, ahead of time so that the
+///             raster thread only needs to copy them into the glyph atlas.
+///
+///             This may be called on any thread. It is meant to be called on
+///             a worker once the display list has been recorded.
+///
+/// @param[in]  display_list  The display list whose glyphs to rasterize.
+/// @param[in]  scale         The scale the display list is expected to be
+///                           drawn at, usually the device pixel ratio. Glyphs
+///                           drawn at a different scale are rasterized on
+///                           the raster thread as before.
+///
+void PrerasterizeDisplayListGlyphs(const flutter::DisplayList& display_list,
+                                   Scalar scale);
+
+}  // namespace impeller
@@ -26,13 +26,12 @@ sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
   if (!aiks_context || !y_texture || !uv_texture) {
     return nullptr;
   }
-  auto yuv_to_rgb_filter_contents = FilterContents::MakeYUVToRGBFilter(
-      std::move(y_texture), std::move(uv_texture), yuv_color_space);
-  impeller::Entity entity;
-  entity.SetBlendMode(impeller::BlendMode::kSource);
-  auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
-      aiks_context->GetContentContext(), entity);
-  return impeller::DlImageImpeller::Make(snapshot->texture);
+  auto image = sk_sp<DlImageImpeller>(
+      new DlImageImpeller(std::move(y_texture)));
+  image->uv_texture_ = std::move(uv_texture);
+  image->yuv_color_space_ = yuv_color_space;
+  image->aiks_context_ = aiks_context->weak_from_this();
+  return image;
 }
 
 DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> texture,
@@ -49,7 +48,27 @@ sk_sp<SkImage> DlImageImpeller::skia_image() const {
 
 // |DlImage|
 std::shared_ptr<impeller::Texture> DlImageImpeller::impeller_texture() const {
-  return texture_;
+  if (!uv_texture_) {
+    return texture_;
+  }
+  Lock lock(converted_texture_mutex_);
+  if (converted_texture_) {
+    return converted_texture_;
+  }
+  auto aiks_context = aiks_context_.lock();
+  if (!aiks_context) {
+    return nullptr;
+  }
+  auto yuv_to_rgb_filter_contents = FilterContents::MakeYUVToRGBFilter(
+      texture_, uv_texture_, yuv_color_space_);
+  impeller::Entity entity;
+  entity.SetBlendMode(impeller::BlendMode::kSource);
+  auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
+      aiks_context->GetContentContext(), entity);
+  if (snapshot.has_value()) {
+    converted_texture_ = snapshot->texture;
+  }
+  return converted_texture_;
 }
 
 // |DlImage|
@@ -76,6 +95,14 @@ size_t DlImageImpeller::GetApproximateByteSize() const {
   if (texture_) {
     size += texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
   }
+  if (uv_texture_) {
+    size += uv_texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  }
+  Lock lock(converted_texture_mutex_);
+  if (converted_texture_) {
+    size +=
+        converted_texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  }
   return size;
 }
 
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "flutter/display_list/display_list_image.h"
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/geometry/color.h"
 #include "impeller/renderer/texture.h"
 
 namespace impeller {
@@ -18,6 +22,14 @@ class DlImageImpeller final : public flutter::DlImage {
       std::shared_ptr<Texture> texture,
       OwningContext owning_context = OwningContext::kIO);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Make an image from the planes of a YUV image. The planes are
+  ///             sampled directly when the image is drawn. They are only
+  ///             converted into an RGBA texture when |impeller_texture| is
+  ///             used, with the given context. The image only keeps a weak
+  ///             reference to the context, so the conversion fails once the
+  ///             context is gone, or if it isn't owned by a shared pointer.
+  ///
   static sk_sp<DlImageImpeller> MakeFromYUVTextures(
       AiksContext* aiks_context,
       std::shared_ptr<Texture> y_texture,
@@ -48,9 +60,26 @@ class DlImageImpeller final : public flutter::DlImage {
   // |DlImage|
   OwningContext owning_context() const override { return owning_context_; }
 
+  /// @brief  The texture of the Y plane for YUV images, and the texture of
+  ///         the image otherwise.
+  const std::shared_ptr<Texture>& GetTexture() const { return texture_; }
+
+  /// @brief  The texture of the UV plane for YUV images, nullptr otherwise.
+  const std::shared_ptr<Texture>& GetUVTexture() const { return uv_texture_; }
+
+  YUVColorSpace GetYUVColorSpace() const { return yuv_color_space_; }
+
  private:
   std::shared_ptr<Texture> texture_;
   OwningContext owning_context_;
+  std::shared_ptr<Texture> uv_texture_;
+  YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
+  std::weak_ptr<AiksContext> aiks_context_;
+  // The RGBA conversion of a YUV image, made the first time it is needed.
+  // Images may be used on several threads.
+  mutable Mutex converted_texture_mutex_;
+  mutable std::shared_ptr<Texture> converted_texture_
+      IPLR_GUARDED_BY(converted_texture_mutex_);
 
   explicit DlImageImpeller(std::shared_ptr<Texture> texture,
                            OwningContext owning_context = OwningContext::kIO);
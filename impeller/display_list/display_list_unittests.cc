@@ -5,6 +5,7 @@
 #include <array>
 #include <cmath>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "display_list/display_list_blend_mode.h"
@@ -18,9 +19,14 @@
 #include "flutter/display_list/display_list_mask_filter.h"
 #include "flutter/display_list/types.h"
 #include "flutter/testing/testing.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/display_list/display_list_conversion_cache.h"
+#include "impeller/display_list/display_list_dispatcher.h"
 #include "impeller/display_list/display_list_image_impeller.h"
 #include "impeller/display_list/display_list_playground.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/geometry/constants.h"
+#include "impeller/geometry/geometry_unittests.h"
 #include "impeller/geometry/point.h"
 #include "impeller/playground/widgets.h"
 #include "impeller/scene/node.h"
@@ -714,11 +720,14 @@ TEST_P(DisplayListTest, CanDrawShadow) {
         50 - std::cos(rotation + half_spike_rotation) * inner_radius);
   }
 
-  std::array<SkPath, 4> paths = {
+  std::array<SkPath, 6> paths = {
       SkPath{}.addRect(SkRect::MakeXYWH(0, 0, 200, 100)),
       SkPath{}.addRRect(
           SkRRect::MakeRectXY(SkRect::MakeXYWH(20, 0, 200, 100), 30, 30)),
+      SkPath{}.addRRect(
+          SkRRect::MakeRectXY(SkRect::MakeXYWH(20, 0, 200, 100), 50, 50)),
       SkPath{}.addCircle(100, 50, 50),
+      SkPath{}.addOval(SkRect::MakeXYWH(0, 0, 200, 100)),
       SkPath{}.addPoly(star.data(), star.size(), true),
   };
   builder.setColor(flutter::DlColor::kWhite());
@@ -1285,6 +1294,138 @@ TEST_P(DisplayListTest, DrawVerticesBlendModes) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+static sk_sp<flutter::DisplayList> MakeNestedTestList(int count) {
+  flutter::DisplayListBuilder builder;
+  for (int i = 0; i < count; i++) {
+    builder.drawRect(SkRect::MakeXYWH(i * 10, 0, 5, 5));
+  }
+  return builder.Build();
+}
+
+static std::vector<Rect> GetEntityCoverages(Picture& picture) {
+  std::vector<Rect> coverages;
+  picture.pass->IterateAllEntities([&coverages](Entity& entity) {
+    coverages.push_back(entity.GetCoverage().value_or(Rect{}));
+    return true;
+  });
+  return coverages;
+}
+
+TEST_P(DisplayListTest, ConcurrentConversionKeepsNestedListOrder) {
+  auto nested =
+      MakeNestedTestList(DisplayListDispatcher::kMinConcurrentOpCount);
+  flutter::DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeXYWH(0, 0, 5, 5));
+  builder.translate(0, 100);
+  builder.drawDisplayList(nested);
+  builder.drawRect(SkRect::MakeXYWH(0, 200, 5, 5));
+  auto display_list = builder.Build();
+
+  DisplayListDispatcher dispatcher(GetContext()->GetWorkQueue());
+  display_list->Dispatch(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+
+  auto coverages = GetEntityCoverages(picture);
+  ASSERT_EQ(coverages.size(), nested->op_count() + 2u);
+  ASSERT_RECT_NEAR(coverages.front(), Rect::MakeXYWH(0, 0, 5, 5));
+  ASSERT_RECT_NEAR(coverages[1], Rect::MakeXYWH(0, 100, 5, 5));
+  ASSERT_RECT_NEAR(coverages.back(), Rect::MakeXYWH(0, 300, 5, 5));
+}
+
+TEST_P(DisplayListTest, ConversionCacheReusesTranslatedNestedLists) {
+  auto cache = std::make_shared<DisplayListConversionCache>();
+  auto nested = MakeNestedTestList(DisplayListDispatcher::kMinCachedOpCount);
+  auto convert = [&cache, &nested](SkScalar dx, SkScalar scale) {
+    flutter::DisplayListBuilder builder;
+    builder.translate(dx, 0);
+    builder.scale(scale, scale);
+    builder.drawDisplayList(nested);
+    DisplayListDispatcher dispatcher(nullptr, cache);
+    builder.Build()->Dispatch(dispatcher);
+    auto picture = dispatcher.EndRecordingAsPicture();
+    cache->EndFrame();
+    return GetEntityCoverages(picture);
+  };
+
+  auto first = convert(0, 1);
+  ASSERT_EQ(cache->GetPictureCount(), 1u);
+  ASSERT_EQ(first.size(), nested->op_count());
+
+  // A translation reuses the picture.
+  auto translated = convert(30, 1);
+  ASSERT_EQ(cache->GetPictureCount(), 1u);
+  ASSERT_RECT_NEAR(translated[0], Rect::MakeXYWH(30, 0, 5, 5));
+  ASSERT_RECT_NEAR(first[0], Rect::MakeXYWH(0, 0, 5, 5));
+
+  // A scale converts the list again. The picture at the old scale isn't
+  // used in that frame and is dropped.
+  auto scaled = convert(0, 2);
+  ASSERT_EQ(cache->GetPictureCount(), 1u);
+  ASSERT_RECT_NEAR(scaled[0], Rect::MakeXYWH(0, 0, 10, 10));
+}
+
+TEST_P(DisplayListTest, ConversionCacheReusesNonVolatilePaths) {
+  auto cache = std::make_shared<DisplayListConversionCache>();
+  SkPath path = SkPath().moveTo(0, 0).lineTo(10, 0).lineTo(5, 10).close();
+  auto convert = [&cache](const SkPath& path) {
+    flutter::DisplayListBuilder builder;
+    builder.drawPath(path, flutter::DlPaint());
+    DisplayListDispatcher dispatcher(nullptr, cache);
+    builder.Build()->Dispatch(dispatcher);
+    dispatcher.EndRecordingAsPicture();
+    cache->EndFrame();
+  };
+
+  path.setIsVolatile(true);
+  convert(path);
+  ASSERT_EQ(cache->GetPathCount(), 0u);
+
+  path.setIsVolatile(false);
+  convert(path);
+  ASSERT_EQ(cache->GetPathCount(), 1u);
+  convert(path);
+  ASSERT_EQ(cache->GetPathCount(), 1u);
+
+  // An edit of the path converts it again, and the old conversion isn't used
+  // in that frame and is dropped.
+  path.lineTo(20, 20);
+  convert(path);
+  ASSERT_EQ(cache->GetPathCount(), 1u);
+  ASSERT_NE(cache->GetPath(path.getGenerationID(), FillType::kNonZero),
+            nullptr);
+  ASSERT_EQ(cache->GetPath(path.getGenerationID(), FillType::kOdd), nullptr);
+}
+
+TEST_P(DisplayListTest, SaveLayerDistributesOpacityToChildren) {
+  auto convert = [](SkScalar offset) {
+    flutter::DisplayListBuilder builder;
+    flutter::DlPaint layer_paint;
+    layer_paint.setOpacity(0.5);
+    builder.saveLayer(nullptr, &layer_paint);
+    builder.drawRect(SkRect::MakeXYWH(0, 0, 10, 10));
+    builder.drawRect(SkRect::MakeXYWH(offset, 0, 10, 10));
+    builder.restore();
+    DisplayListDispatcher dispatcher;
+    builder.Build()->Dispatch(dispatcher);
+    return dispatcher.EndRecordingAsPicture();
+  };
+
+  // The rects don't overlap, so they are drawn with the opacity of the layer
+  // instead of in a pass of their own.
+  auto picture = convert(20);
+  ASSERT_EQ(picture.pass->GetElementCount(), 2u);
+  picture.pass->IterateAllEntities([](Entity& entity) {
+    auto contents =
+        std::static_pointer_cast<SolidColorContents>(entity.GetContents());
+    EXPECT_NEAR(contents->GetColor().alpha, 128.0 / 255.0, kEhCloseEnough);
+    return true;
+  });
+
+  // Overlapping rects still need the layer.
+  picture = convert(5);
+  ASSERT_EQ(picture.pass->GetElementCount(), 1u);
+}
+
 #ifdef IMPELLER_ENABLE_3D
 TEST_P(DisplayListTest, SceneColorSource) {
   // Load up the scene.
@@ -1312,5 +1453,44 @@ TEST_P(DisplayListTest, SceneColorSource) {
 }
 #endif
 
+TEST_P(DisplayListTest, YUVImagesAreOnlyConvertedWhileTheirContextIsAlive) {
+  if (GetParam() == PlaygroundBackend::kOpenGLES) {
+    GTEST_SKIP_("YUV textures are not supported on OpenGLES backend yet.");
+  }
+  auto aiks_context = std::make_shared<AiksContext>(GetContext());
+  ASSERT_TRUE(aiks_context->IsValid());
+  auto make_plane = [&](PixelFormat format, ISize size) {
+    TextureDescriptor desc;
+    desc.storage_mode = StorageMode::kHostVisible;
+    desc.format = format;
+    desc.size = size;
+    return GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  };
+  auto make_image = [&]() {
+    return DlImageImpeller::MakeFromYUVTextures(
+        aiks_context.get(), make_plane(PixelFormat::kR8UNormInt, {64, 64}),
+        make_plane(PixelFormat::kR8G8UNormInt, {32, 32}),
+        YUVColorSpace::kBT601FullRange);
+  };
+  auto image = make_image();
+  auto other_image = make_image();
+  ASSERT_TRUE(image && other_image);
+
+  // Conversions requested on several threads at once are only made once.
+  std::shared_ptr<Texture> converted_textures[2];
+  std::thread thread(
+      [&]() { converted_textures[1] = image->impeller_texture(); });
+  converted_textures[0] = image->impeller_texture();
+  thread.join();
+  ASSERT_TRUE(converted_textures[0]);
+  ASSERT_NE(converted_textures[0], image->GetTexture());
+  ASSERT_EQ(converted_textures[0], converted_textures[1]);
+
+  aiks_context.reset();
+  ASSERT_EQ(other_image->impeller_texture(), nullptr);
+  // Conversions made earlier are kept.
+  ASSERT_EQ(image->impeller_texture(), converted_textures[0]);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,333 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_frame_capture.h"
+#include "flutter/display_list/display_list_serialization.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/display_list/benchmark_playground.h"
+#include "impeller/display_list/display_list_dispatcher.h"
+#include "impeller/renderer/gpu_tracer.h"
+#include "impeller/renderer/render_target.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace impeller {
+
+namespace {
+
+/// The extension of the files written by |flutter::DisplayListSerializer|
+/// that are loaded from the scene directory.
+constexpr char kSceneExtension[] = ".dlist";
+
+constexpr size_t kDefaultFrameCount = 60u;
+
+/// A single display list, or the frames of a
+/// |flutter::DisplayListFrameCapture| that are rendered in turn.
+struct RecordedScene {
+  std::string name;
+  std::vector<flutter::DisplayListFrameCapture::Frame> frames;
+};
+
+bool HasExtension(const std::string& filename, const std::string& extension) {
+  return filename.size() > extension.size() &&
+         filename.compare(filename.size() - extension.size(),
+                          extension.size(), extension) == 0;
+}
+
+std::optional<std::vector<flutter::DisplayListFrameCapture::Frame>>
+LoadSceneFrames(const sk_sp<SkData>& data, bool is_capture) {
+  if (is_capture) {
+    return flutter::DisplayListFrameCapture::Deserialize(data);
+  }
+  auto display_list = flutter::DisplayListSerializer::Deserialize(data);
+  if (!display_list) {
+    return std::nullopt;
+  }
+  auto bounds = display_list->bounds().roundOut();
+  flutter::DisplayListFrameCapture::Frame frame;
+  frame.frame_size = SkISize::Make(bounds.right(), bounds.bottom());
+  frame.display_list = std::move(display_list);
+  return std::vector<flutter::DisplayListFrameCapture::Frame>{
+      std::move(frame)};
+}
+
+sk_sp<SkData> OpenFileAsSkData(const fml::UniqueFD& directory,
+                               const std::string& filename) {
+  auto mapping = fml::FileMapping::CreateReadOnly(directory, filename);
+  if (!mapping || mapping->GetSize() == 0u) {
+    return nullptr;
+  }
+  // The deserialized display list uses the image pixels in the mapping, so
+  // the mapping lives as long as the data.
+  auto data = SkData::MakeWithProc(
+      mapping->GetMapping(), mapping->GetSize(),
+      [](const void* ptr, void* context) {
+        delete reinterpret_cast<fml::Mapping*>(context);
+      },
+      mapping.get());
+  mapping.release();
+  return data;
+}
+
+/// Loads the serialized display lists and frame captures in a directory,
+/// sorted by name.
+std::vector<RecordedScene> LoadScenes(const std::string& scene_directory) {
+  std::vector<RecordedScene> scenes;
+  auto directory = fml::OpenDirectory(scene_directory.c_str(), false,
+                                      fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open the scene directory "
+                   << scene_directory;
+    return scenes;
+  }
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& directory,
+                                 const std::string& filename) {
+    const bool is_capture = HasExtension(
+        filename, flutter::DisplayListFrameCapture::kFileExtension);
+    if (!is_capture && !HasExtension(filename, kSceneExtension)) {
+      return true;
+    }
+    auto data = OpenFileAsSkData(directory, filename);
+    auto frames = data ? LoadSceneFrames(data, is_capture) : std::nullopt;
+    if (!frames.has_value() || frames->empty()) {
+      FML_LOG(ERROR) << "Could not load the scene " << filename
+                     << ". It may have been written by another engine build.";
+      return true;
+    }
+    scenes.push_back({
+        .name = filename.substr(0, filename.rfind('.')),
+        .frames = std::move(*frames),
+    });
+    return true;
+  });
+  std::sort(scenes.begin(), scenes.end(),
+            [](const RecordedScene& a, const RecordedScene& b) {
+              return a.name < b.name;
+            });
+  return scenes;
+}
+
+/// The peak resident set size of the process.
+size_t GetPeakResidentBytes() {
+  struct rusage usage = {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0u;
+  }
+#if FML_OS_MACOSX
+  return usage.ru_maxrss;
+#else
+  // Linux reports kilobytes.
+  return usage.ru_maxrss * 1024u;
+#endif  // FML_OS_MACOSX
+}
+
+}  // namespace
+
+/// Renders a recorded scene offscreen through the |DisplayListDispatcher|
+/// and an |AiksContext| for the number of frames given by the benchmark
+/// argument. The frames of a capture are rendered in turn, and the average
+/// raster time that they took when they were captured is reported as
+/// "CapturedRasterMs" to compare the replay to.
+///
+/// The time of an iteration is the wall time of all of its frames. Each
+/// frame converts the display list to a picture and encodes and submits its
+/// command buffers, which is reported as "EncodeMs", and then waits for the
+/// GPU to finish them, which is reported as "GPUMs". Both are averaged over
+/// the frames. The buffers and textures allocated per frame, the peak device
+/// memory reported by the |GPUTracer| if the backend tracks it, and the peak
+/// resident memory of the process are reported too.
+static void BM_ImpellerScene(benchmark::State& state,
+                             PlaygroundBackend backend,
+                             const RecordedScene& scene) {
+  if (!Playground::SupportsBackend(backend)) {
+    state.SkipWithError("Backend is not supported on this platform.");
+    return;
+  }
+  BenchmarkPlayground playground(backend);
+  auto context = playground.GetContext();
+  if (!context || !context->IsValid()) {
+    state.SkipWithError("Could not create a context.");
+    return;
+  }
+  AiksContext aiks_context(context);
+  if (!aiks_context.IsValid()) {
+    state.SkipWithError("Could not create an AiksContext.");
+    return;
+  }
+
+  SkISize frame_size = SkISize::MakeEmpty();
+  size_t draw_call_count = 0u;
+  fml::TimeDelta captured_raster_time;
+  for (const auto& frame : scene.frames) {
+    frame_size.set(std::max(frame_size.width(), frame.frame_size.width()),
+                   std::max(frame_size.height(), frame.frame_size.height()));
+    draw_call_count += frame.display_list->op_count(true);
+    captured_raster_time = captured_raster_time + frame.raster_time;
+  }
+  auto size = ISize(std::max(frame_size.width(), 1),
+                    std::max(frame_size.height(), 1));
+  RenderTarget render_target;
+  if (context->SupportsOffscreenMSAA()) {
+    render_target = RenderTarget::CreateOffscreenMSAA(*context, size);
+  } else {
+    render_target = RenderTarget::CreateOffscreen(*context, size);
+  }
+  if (!render_target.IsValid()) {
+    state.SkipWithError("Could not create a render target.");
+    return;
+  }
+
+  const size_t frame_count = state.range(0);
+  state.counters["DrawCallCount"] = draw_call_count / scene.frames.size();
+  if (captured_raster_time > fml::TimeDelta::Zero()) {
+    state.counters["CapturedRasterMs"] =
+        captured_raster_time.ToMillisecondsF() / scene.frames.size();
+  }
+
+  auto allocator = context->GetResourceAllocator();
+  auto gpu_tracer = context->GetGPUTracer();
+  const auto allocations_before = allocator->GetAllocationStatistics();
+  fml::TimeDelta encode_time;
+  fml::TimeDelta gpu_time;
+  size_t frames = 0u;
+  size_t peak_device_memory_bytes = 0u;
+  auto render_frame = [&]() {
+    auto start = fml::TimePoint::Now();
+    const auto& frame = scene.frames[frames % scene.frames.size()];
+    DisplayListDispatcher dispatcher;
+    frame.display_list->Dispatch(dispatcher);
+    auto picture = dispatcher.EndRecordingAsPicture();
+    if (!aiks_context.Render(picture, render_target)) {
+      state.SkipWithError("Could not render the picture.");
+      return false;
+    }
+    auto encoded = fml::TimePoint::Now();
+    if (!WaitForGPU(*context)) {
+      state.SkipWithError("Could not wait for the GPU.");
+      return false;
+    }
+    auto finished = fml::TimePoint::Now();
+
+    encode_time = encode_time + (encoded - start);
+    gpu_time = gpu_time + (finished - encoded);
+    frames++;
+    if (auto statistics =
+            gpu_tracer ? gpu_tracer->GetMemoryStatistics() : std::nullopt) {
+      peak_device_memory_bytes = std::max(
+          peak_device_memory_bytes, statistics->device_memory_usage_bytes);
+    }
+    return true;
+  };
+  bool failed = false;
+  for ([[maybe_unused]] auto _ : state) {
+    for (size_t i = 0; i < frame_count && !failed; i++) {
+      failed = !render_frame();
+    }
+    if (failed) {
+      break;
+    }
+  }
+  if (failed || frames == 0u) {
+    return;
+  }
+  const auto allocations = allocator->GetAllocationStatistics();
+
+  auto per_frame = [frames](double value) { return value / frames; };
+  state.counters["EncodeMs"] = per_frame(encode_time.ToMillisecondsF());
+  state.counters["GPUMs"] = per_frame(gpu_time.ToMillisecondsF());
+  state.counters["BufferAllocations"] = per_frame(
+      allocations.buffer_count - allocations_before.buffer_count);
+  state.counters["BufferAllocationBytes"] = per_frame(
+      allocations.buffer_bytes - allocations_before.buffer_bytes);
+  state.counters["TextureAllocations"] = per_frame(
+      allocations.texture_count - allocations_before.texture_count);
+  state.counters["TextureAllocationBytes"] = per_frame(
+      allocations.texture_bytes - allocations_before.texture_bytes);
+  if (peak_device_memory_bytes > 0u) {
+    state.counters["PeakDeviceMemoryBytes"] = peak_device_memory_bytes;
+  }
+  state.counters["PeakResidentBytes"] = GetPeakResidentBytes();
+}
+
+/// Registers a benchmark per scene and backend. The names are
+/// `BM_ImpellerScene/<scene>/<backend>/<frames>/real_time`, which is the
+/// layout testing/benchmark/displaylist_benchmark_parser.py expects.
+static void RegisterSceneBenchmarks(const std::vector<RecordedScene>& scenes,
+                                    size_t frame_count) {
+  std::vector<PlaygroundBackend> backends;
+#if IMPELLER_ENABLE_METAL
+  backends.push_back(PlaygroundBackend::kMetal);
+#endif  // IMPELLER_ENABLE_METAL
+#if IMPELLER_ENABLE_OPENGLES
+  backends.push_back(PlaygroundBackend::kOpenGLES);
+#endif  // IMPELLER_ENABLE_OPENGLES
+#if IMPELLER_ENABLE_VULKAN
+  backends.push_back(PlaygroundBackend::kVulkan);
+#endif  // IMPELLER_ENABLE_VULKAN
+
+  for (const auto& scene : scenes) {
+    for (auto backend : backends) {
+      auto name = "BM_ImpellerScene/" + scene.name + "/" +
+                  PlaygroundBackendToString(backend);
+      benchmark::RegisterBenchmark(name.c_str(), BM_ImpellerScene, backend,
+                                   scene)
+          ->Arg(frame_count)
+          ->UseRealTime()
+          ->Unit(benchmark::kMillisecond);
+    }
+  }
+}
+
+}  // namespace impeller
+
+/// Runs the scene benchmarks.
+///
+/// --scene-dir=<path>  The directory of the scenes to render, one display
+///                     list serialized by |flutter::DisplayListSerializer| per
+///                     file with the `.dlist` extension, or one capture
+///                     written by |flutter::DisplayListFrameCapture| per file
+///                     with the `.dlcapture` extension.
+/// --frames=<count>    The number of frames each iteration renders. Defaults
+///                     to 60.
+///
+/// All other flags are passed to Google Benchmark, e.g.
+/// `--benchmark_format=json`.
+int main(int argc, char** argv) {
+  auto command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  std::string scene_directory;
+  if (!command_line.GetOptionValue("scene-dir", &scene_directory)) {
+    FML_LOG(ERROR) << "Pass the directory of the scenes with --scene-dir.";
+    return 1;
+  }
+  size_t frame_count = impeller::kDefaultFrameCount;
+  std::string frames;
+  if (command_line.GetOptionValue("frames", &frames)) {
+    frame_count = std::max<size_t>(std::stoul(frames), 1u);
+  }
+
+  auto scenes = impeller::LoadScenes(scene_directory);
+  if (scenes.empty()) {
+    FML_LOG(ERROR) << "No scenes were found in " << scene_directory;
+    return 1;
+  }
+  impeller::RegisterSceneBenchmarks(scenes, frame_count);
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -21,6 +21,60 @@
 
 namespace impeller {
 
+namespace {
+
+// This must match the AtlasInstance of atlas_instanced_texture.vert and
+// atlas_instanced_color.vert.
+struct AtlasInstance {
+  Matrix transform;
+  Vector4 texture_rect;
+  Color color;
+};
+
+static_assert(sizeof(AtlasInstance) == 96);
+
+}  // namespace
+
+// Uploads the transform, the rectangle of the atlas and the premultiplied
+// color of every sprite, which the instanced pipelines draw an instance of
+// the unit square for.
+static BufferView CreateInstanceBuffer(const AtlasContents& contents,
+                                       HostBuffer& host_buffer) {
+  const auto& transforms = contents.GetTransforms();
+  const auto& texture_coords = contents.GetTextureCoordinates();
+  const auto& colors = contents.GetColors();
+
+  std::vector<AtlasInstance> instances(texture_coords.size());
+  for (size_t i = 0; i < texture_coords.size(); i++) {
+    const auto& sample_rect = texture_coords[i];
+    instances[i].transform = transforms[i];
+    instances[i].texture_rect =
+        Vector4(sample_rect.origin.x, sample_rect.origin.y,
+                sample_rect.size.width, sample_rect.size.height);
+    if (i < colors.size()) {
+      instances[i].color = colors[i].Premultiply();
+    }
+  }
+  return host_buffer.Emplace(instances.data(),
+                             instances.size() * sizeof(AtlasInstance),
+                             alignof(AtlasInstance));
+}
+
+template <class VertexShader>
+static VertexBuffer CreateUnitSquareVertices(HostBuffer& host_buffer) {
+  VertexBufferBuilder<typename VertexShader::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {Point(0, 0)},
+      {Point(1, 0)},
+      {Point(0, 1)},
+      {Point(1, 1)},
+  });
+  for (auto index : {0, 1, 2, 1, 2, 3}) {
+    vertex_builder.AppendIndex(index);
+  }
+  return vertex_builder.CreateVertexBuffer(host_buffer);
+}
+
 AtlasContents::AtlasContents() = default;
 
 AtlasContents::~AtlasContents() = default;
@@ -160,6 +214,13 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   using VS = TextureFillVertexShader;
   using FS = TextureFillFragmentShader;
 
+  if (parent_.GetTextureCoordinates().empty()) {
+    return true;
+  }
+  if (renderer.GetBackendFeatures().ssbo_support) {
+    return RenderInstanced(renderer, entity, pass);
+  }
+
   auto texture = parent_.GetTexture();
   auto texture_coords = parent_.GetTextureCoordinates();
   auto transforms = parent_.GetTransforms();
@@ -216,6 +277,41 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   return pass.AddCommand(std::move(cmd));
 }
 
+bool AtlasTextureContents::RenderInstanced(const ContentContext& renderer,
+                                           const Entity& entity,
+                                           RenderPass& pass) const {
+  using VS = AtlasInstancedTexturePipeline::VertexShader;
+  using FS = AtlasInstancedTexturePipeline::FragmentShader;
+
+  auto texture = parent_.GetTexture();
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = "AtlasTexture Instanced";
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  frame_info.texture_size = Point(texture->GetSize());
+
+  FS::FragInfo frag_info;
+  frag_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+  frag_info.alpha = alpha_;
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  cmd.pipeline = renderer.GetAtlasInstancedTexturePipeline(options);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(CreateUnitSquareVertices<VS>(host_buffer));
+  cmd.instance_count = parent_.GetTextureCoordinates().size();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  VS::BindInstanceData(cmd, CreateInstanceBuffer(parent_, host_buffer));
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  FS::BindTextureSampler(cmd, texture,
+                         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                             parent_.GetSamplerDescriptor()));
+  return pass.AddCommand(std::move(cmd));
+}
+
 // AtlasColorContents
 // ---------------------------------------------------------
 
@@ -243,6 +339,13 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   using VS = GeometryColorPipeline::VertexShader;
   using FS = GeometryColorPipeline::FragmentShader;
 
+  if (parent_.GetTextureCoordinates().empty()) {
+    return true;
+  }
+  if (renderer.GetBackendFeatures().ssbo_support) {
+    return RenderInstanced(renderer, entity, pass);
+  }
+
   auto texture_coords = parent_.GetTextureCoordinates();
   auto transforms = parent_.GetTransforms();
   auto colors = parent_.GetColors();
@@ -290,4 +393,34 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   return pass.AddCommand(std::move(cmd));
 }
 
+bool AtlasColorContents::RenderInstanced(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) const {
+  using VS = AtlasInstancedColorPipeline::VertexShader;
+  using FS = AtlasInstancedColorPipeline::FragmentShader;
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = "AtlasColors Instanced";
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = alpha_;
+
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.blend_mode = BlendMode::kSourceOver;
+  cmd.pipeline = renderer.GetAtlasInstancedColorPipeline(opts);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(CreateUnitSquareVertices<VS>(host_buffer));
+  cmd.instance_count = parent_.GetTextureCoordinates().size();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  VS::BindInstanceData(cmd, CreateInstanceBuffer(parent_, host_buffer));
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  return pass.AddCommand(std::move(cmd));
+}
+
 }  // namespace impeller
@@ -89,6 +89,12 @@ class AtlasTextureContents final : public Contents {
   void SetCoverage(Rect coverage);
 
  private:
+  // Draws every sprite with a single instanced command, on backends that
+  // support storage buffers.
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass) const;
+
   const AtlasContents& parent_;
   Scalar alpha_ = 1.0;
   Rect coverage_;
@@ -115,6 +121,12 @@ class AtlasColorContents final : public Contents {
   void SetCoverage(Rect coverage);
 
  private:
+  // Draws the colors of every sprite with a single instanced command, on
+  // backends that support storage buffers.
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass) const;
+
   const AtlasContents& parent_;
   Scalar alpha_ = 1.0;
   Rect coverage_;
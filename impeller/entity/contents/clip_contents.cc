@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
 #include <optional>
 
 #include "fml/logging.h"
@@ -30,6 +31,29 @@ void ClipContents::SetClipOperation(Entity::ClipOperation clip_op) {
   clip_op_ = clip_op;
 }
 
+std::optional<Rect> ClipContents::GetScissorRect(const Entity& entity) const {
+  if (clip_op_ != Entity::ClipOperation::kIntersect) {
+    return std::nullopt;
+  }
+  auto rect_geometry = dynamic_cast<const RectGeometry*>(geometry_.get());
+  if (!rect_geometry ||
+      !entity.GetTransformation().IsTranslationScaleOnly()) {
+    return std::nullopt;
+  }
+  auto ltrb = rect_geometry->GetRect()
+                  .TransformBounds(entity.GetTransformation())
+                  .GetLTRB();
+  for (auto& edge : ltrb) {
+    // Scissors can't cover parts of pixels, which the stencil does when it is
+    // multisampled.
+    if (std::abs(edge - std::round(edge)) > kEhCloseEnough) {
+      return std::nullopt;
+    }
+    edge = std::round(edge);
+  }
+  return Rect::MakeLTRB(ltrb[0], ltrb[1], ltrb[2], ltrb[3]);
+}
+
 std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
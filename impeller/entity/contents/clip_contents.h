@@ -25,6 +25,12 @@ class ClipContents final : public Contents {
 
   void SetClipOperation(Entity::ClipOperation clip_op);
 
+  /// @brief  The rect in render target coordinates that this clip can be
+  ///         applied with as a scissor instead of through the stencil. That is
+  ///         only the case for intersections with rects that stay axis
+  ///         aligned and whose edges land on pixel boundaries.
+  std::optional<Rect> GetScissorRect(const Entity& entity) const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
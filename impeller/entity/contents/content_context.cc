@@ -7,7 +7,13 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/trace_event.h"
+
+#include "impeller/entity/deferred_submission_scope.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/render_pass.h"
@@ -137,107 +143,236 @@ void ContentContextOptions::ApplyToPipelineDescriptor(
   desc.SetPrimitiveType(primitive_type);
 }
 
+static constexpr std::string_view kPipelineVariantsHeader =
+    "impeller-pipeline-variants-v1";
+
+std::string PipelineVariantKey::Serialize(
+    const std::vector<PipelineVariantKey>& keys) {
+  std::stringstream stream;
+  stream << kPipelineVariantsHeader << "\n";
+  for (const auto& key : keys) {
+    const auto& opts = key.options;
+    stream << key.pipeline << " " << static_cast<int>(opts.sample_count) << " "
+           << static_cast<int>(opts.blend_mode) << " "
+           << static_cast<int>(opts.stencil_compare) << " "
+           << static_cast<int>(opts.stencil_operation) << " "
+           << static_cast<int>(opts.primitive_type) << " "
+           << static_cast<int>(opts.color_attachment_pixel_format) << " "
+           << static_cast<int>(opts.has_stencil_attachment) << "\n";
+  }
+  return stream.str();
+}
+
+std::vector<PipelineVariantKey> PipelineVariantKey::Deserialize(
+    std::string_view data) {
+  std::vector<PipelineVariantKey> keys;
+  std::istringstream stream{std::string{data}};
+  std::string line;
+  if (!std::getline(stream, line) || line != kPipelineVariantsHeader) {
+    // Recorded by an incompatible version.
+    return keys;
+  }
+  while (std::getline(stream, line)) {
+    std::istringstream line_stream(line);
+    PipelineVariantKey key;
+    int sample_count, blend_mode, stencil_compare, stencil_operation,
+        primitive_type, pixel_format, has_stencil_attachment;
+    if (!(line_stream >> key.pipeline >> sample_count >> blend_mode >>
+          stencil_compare >> stencil_operation >> primitive_type >>
+          pixel_format >> has_stencil_attachment)) {
+      continue;
+    }
+    if ((sample_count != static_cast<int>(SampleCount::kCount1) &&
+         sample_count != static_cast<int>(SampleCount::kCount4)) ||
+        blend_mode < 0 ||
+        blend_mode > static_cast<int>(Entity::kLastPipelineBlendMode) ||
+        stencil_compare < 0 ||
+        stencil_compare > static_cast<int>(CompareFunction::kGreaterEqual) ||
+        stencil_operation < 0 ||
+        stencil_operation >
+            static_cast<int>(StencilOperation::kDecrementWrap) ||
+        primitive_type < 0 ||
+        primitive_type > static_cast<int>(PrimitiveType::kPoint) ||
+        pixel_format <= static_cast<int>(PixelFormat::kUnknown) ||
+        pixel_format > static_cast<int>(PixelFormat::kD32FloatS8UInt) ||
+        (has_stencil_attachment != 0 && has_stencil_attachment != 1)) {
+      continue;
+    }
+    key.options.sample_count = static_cast<SampleCount>(sample_count);
+    key.options.blend_mode = static_cast<BlendMode>(blend_mode);
+    key.options.stencil_compare = static_cast<CompareFunction>(stencil_compare);
+    key.options.stencil_operation =
+        static_cast<StencilOperation>(stencil_operation);
+    key.options.primitive_type = static_cast<PrimitiveType>(primitive_type);
+    key.options.color_attachment_pixel_format =
+        static_cast<PixelFormat>(pixel_format);
+    key.options.has_stencil_attachment = has_stencil_attachment == 1;
+    keys.emplace_back(std::move(key));
+  }
+  return keys;
+}
+
 template <typename PipelineT>
-static std::unique_ptr<PipelineT> CreateDefaultPipeline(
+static std::optional<PipelineDescriptor> CreateDefaultPipelineDescriptor(
     const Context& context) {
   auto desc = PipelineT::Builder::MakeDefaultPipelineDescriptor(context);
   if (!desc.has_value()) {
-    return nullptr;
+    return std::nullopt;
   }
   // Apply default ContentContextOptions to the descriptor.
   ContentContextOptions{}.ApplyToPipelineDescriptor(*desc);
-  return std::make_unique<PipelineT>(context, desc);
+  return desc;
+}
+
+template <class TypedPipeline>
+void ContentContext::InitializeVariants(
+    Variants<TypedPipeline>& container,
+    std::string name,
+    std::optional<PipelineDescriptor> prototype) {
+  container.name = name;
+  container.prototype = std::move(prototype);
+  if (!container.prototype.has_value()) {
+    return;
+  }
+  container.pipelines[{}] =
+      std::make_unique<TypedPipeline>(*context_, container.prototype);
+  variant_creators_[std::move(name)] =
+      [this, &container](const ContentContextOptions& opts) {
+        Lock lock(pipelines_mutex_);
+        auto count = container.pipelines.size();
+        FindOrCreateVariant(container, opts);
+        return container.pipelines.size() > count;
+      };
+}
+
+template <class TypedPipeline>
+void ContentContext::InitializeDefaultVariants(
+    Variants<TypedPipeline>& container,
+    std::string name) {
+  InitializeVariants(container, std::move(name),
+                     CreateDefaultPipelineDescriptor<TypedPipeline>(*context_));
 }
 
 ContentContext::ContentContext(std::shared_ptr<Context> context)
     : context_(std::move(context)),
       tessellator_(std::make_shared<Tessellator>()),
       glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
+      sdf_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
       scene_context_(std::make_shared<scene::SceneContext>(context_)) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
-
-  solid_fill_pipelines_[{}] =
-      CreateDefaultPipeline<SolidFillPipeline>(*context_);
-  linear_gradient_fill_pipelines_[{}] =
-      CreateDefaultPipeline<LinearGradientFillPipeline>(*context_);
-  radial_gradient_fill_pipelines_[{}] =
-      CreateDefaultPipeline<RadialGradientFillPipeline>(*context_);
+  render_target_cache_ =
+      std::make_shared<RenderTargetCache>(context_->GetResourceAllocator());
+  transients_buffer_ = HostBuffer::Create(context_->GetResourceAllocator());
+  transients_buffer_->SetLabel("ContentContext Transients");
+  tessellation_cache_ =
+      std::make_shared<TessellationCache>(context_->GetResourceAllocator());
+  gradient_cache_ = std::make_shared<GradientCache>();
+
+  InitializeDefaultVariants(solid_fill_pipelines_, "SolidFill");
+  InitializeDefaultVariants(linear_gradient_fill_pipelines_,
+                            "LinearGradientFill");
+  InitializeDefaultVariants(radial_gradient_fill_pipelines_,
+                            "RadialGradientFill");
   if (context_->GetBackendFeatures().ssbo_support) {
-    linear_gradient_ssbo_fill_pipelines_[{}] =
-        CreateDefaultPipeline<LinearGradientSSBOFillPipeline>(*context_);
-    radial_gradient_ssbo_fill_pipelines_[{}] =
-        CreateDefaultPipeline<RadialGradientSSBOFillPipeline>(*context_);
-    sweep_gradient_ssbo_fill_pipelines_[{}] =
-        CreateDefaultPipeline<SweepGradientSSBOFillPipeline>(*context_);
+    InitializeDefaultVariants(linear_gradient_ssbo_fill_pipelines_,
+                              "LinearGradientSSBOFill");
+    InitializeDefaultVariants(radial_gradient_ssbo_fill_pipelines_,
+                              "RadialGradientSSBOFill");
+    InitializeDefaultVariants(sweep_gradient_ssbo_fill_pipelines_,
+                              "SweepGradientSSBOFill");
+    InitializeDefaultVariants(atlas_instanced_texture_pipelines_,
+                              "AtlasInstancedTexture");
+    InitializeDefaultVariants(atlas_instanced_color_pipelines_,
+                              "AtlasInstancedColor");
+    InitializeDefaultVariants(points_instanced_pipelines_, "PointsInstanced");
+  }
+  InitializeDefaultVariants(sweep_gradient_fill_pipelines_,
+                            "SweepGradientFill");
+  InitializeDefaultVariants(rrect_blur_pipelines_, "RRectBlur");
+  InitializeDefaultVariants(solid_rrect_pipelines_, "SolidRRect");
+  InitializeDefaultVariants(texture_blend_pipelines_, "Blend");
+  InitializeDefaultVariants(blend_color_pipelines_, "BlendColor");
+  InitializeDefaultVariants(blend_colorburn_pipelines_, "BlendColorBurn");
+  InitializeDefaultVariants(blend_colordodge_pipelines_, "BlendColorDodge");
+  InitializeDefaultVariants(blend_darken_pipelines_, "BlendDarken");
+  InitializeDefaultVariants(blend_difference_pipelines_, "BlendDifference");
+  InitializeDefaultVariants(blend_exclusion_pipelines_, "BlendExclusion");
+  InitializeDefaultVariants(blend_hardlight_pipelines_, "BlendHardLight");
+  InitializeDefaultVariants(blend_hue_pipelines_, "BlendHue");
+  InitializeDefaultVariants(blend_lighten_pipelines_, "BlendLighten");
+  InitializeDefaultVariants(blend_luminosity_pipelines_, "BlendLuminosity");
+  InitializeDefaultVariants(blend_multiply_pipelines_, "BlendMultiply");
+  InitializeDefaultVariants(blend_overlay_pipelines_, "BlendOverlay");
+  InitializeDefaultVariants(blend_saturation_pipelines_, "BlendSaturation");
+  InitializeDefaultVariants(blend_screen_pipelines_, "BlendScreen");
+  InitializeDefaultVariants(blend_softlight_pipelines_, "BlendSoftLight");
+  if (context_->GetBackendFeatures().framebuffer_fetch_support) {
+    InitializeDefaultVariants(framebuffer_blend_pipelines_,
+                              "FramebufferBlend");
   }
-  sweep_gradient_fill_pipelines_[{}] =
-      CreateDefaultPipeline<SweepGradientFillPipeline>(*context_);
-  rrect_blur_pipelines_[{}] =
-      CreateDefaultPipeline<RRectBlurPipeline>(*context_);
-  texture_blend_pipelines_[{}] =
-      CreateDefaultPipeline<BlendPipeline>(*context_);
-  blend_color_pipelines_[{}] =
-      CreateDefaultPipeline<BlendColorPipeline>(*context_);
-  blend_colorburn_pipelines_[{}] =
-      CreateDefaultPipeline<BlendColorBurnPipeline>(*context_);
-  blend_colordodge_pipelines_[{}] =
-      CreateDefaultPipeline<BlendColorDodgePipeline>(*context_);
-  blend_darken_pipelines_[{}] =
-      CreateDefaultPipeline<BlendDarkenPipeline>(*context_);
-  blend_difference_pipelines_[{}] =
-      CreateDefaultPipeline<BlendDifferencePipeline>(*context_);
-  blend_exclusion_pipelines_[{}] =
-      CreateDefaultPipeline<BlendExclusionPipeline>(*context_);
-  blend_hardlight_pipelines_[{}] =
-      CreateDefaultPipeline<BlendHardLightPipeline>(*context_);
-  blend_hue_pipelines_[{}] = CreateDefaultPipeline<BlendHuePipeline>(*context_);
-  blend_lighten_pipelines_[{}] =
-      CreateDefaultPipeline<BlendLightenPipeline>(*context_);
-  blend_luminosity_pipelines_[{}] =
-      CreateDefaultPipeline<BlendLuminosityPipeline>(*context_);
-  blend_multiply_pipelines_[{}] =
-      CreateDefaultPipeline<BlendMultiplyPipeline>(*context_);
-  blend_overlay_pipelines_[{}] =
-      CreateDefaultPipeline<BlendOverlayPipeline>(*context_);
-  blend_saturation_pipelines_[{}] =
-      CreateDefaultPipeline<BlendSaturationPipeline>(*context_);
-  blend_screen_pipelines_[{}] =
-      CreateDefaultPipeline<BlendScreenPipeline>(*context_);
-  blend_softlight_pipelines_[{}] =
-      CreateDefaultPipeline<BlendSoftLightPipeline>(*context_);
-  texture_pipelines_[{}] = CreateDefaultPipeline<TexturePipeline>(*context_);
-  tiled_texture_pipelines_[{}] =
-      CreateDefaultPipeline<TiledTexturePipeline>(*context_);
-  gaussian_blur_pipelines_[{}] =
-      CreateDefaultPipeline<GaussianBlurPipeline>(*context_);
-  gaussian_blur_decal_pipelines_[{}] =
-      CreateDefaultPipeline<GaussianBlurDecalPipeline>(*context_);
-  border_mask_blur_pipelines_[{}] =
-      CreateDefaultPipeline<BorderMaskBlurPipeline>(*context_);
-  morphology_filter_pipelines_[{}] =
-      CreateDefaultPipeline<MorphologyFilterPipeline>(*context_);
-  color_matrix_color_filter_pipelines_[{}] =
-      CreateDefaultPipeline<ColorMatrixColorFilterPipeline>(*context_);
-  linear_to_srgb_filter_pipelines_[{}] =
-      CreateDefaultPipeline<LinearToSrgbFilterPipeline>(*context_);
-  srgb_to_linear_filter_pipelines_[{}] =
-      CreateDefaultPipeline<SrgbToLinearFilterPipeline>(*context_);
-  glyph_atlas_pipelines_[{}] =
-      CreateDefaultPipeline<GlyphAtlasPipeline>(*context_);
-  glyph_atlas_sdf_pipelines_[{}] =
-      CreateDefaultPipeline<GlyphAtlasSdfPipeline>(*context_);
-  geometry_color_pipelines_[{}] =
-      CreateDefaultPipeline<GeometryColorPipeline>(*context_);
-  geometry_position_pipelines_[{}] =
-      CreateDefaultPipeline<GeometryPositionPipeline>(*context_);
-  yuv_to_rgb_filter_pipelines_[{}] =
-      CreateDefaultPipeline<YUVToRGBFilterPipeline>(*context_);
-
-  if (solid_fill_pipelines_[{}]->GetDescriptor().has_value()) {
-    auto clip_pipeline_descriptor =
-        solid_fill_pipelines_[{}]->GetDescriptor().value();
+  InitializeDefaultVariants(texture_pipelines_, "Texture");
+  InitializeDefaultVariants(texture_yuv_pipelines_, "TextureYUV");
+  InitializeDefaultVariants(tiled_texture_pipelines_, "TiledTexture");
+  {
+    auto sampler_tile_mode_descriptor =
+        CreateDefaultPipelineDescriptor<TiledTexturePipeline>(*context_);
+    if (sampler_tile_mode_descriptor.has_value()) {
+      sampler_tile_mode_descriptor->SetSpecializationConstants(
+          TiledTextureFillFragmentShader::CreateSpecializationConstants(
+              {.kSamplerTileModes = true}));
+      sampler_tile_mode_descriptor->SetLabel(
+          sampler_tile_mode_descriptor->GetLabel() + " SamplerTileMode");
+    }
+    InitializeVariants(tiled_texture_sampler_tile_mode_pipelines_,
+                       "TiledTextureSamplerTileMode",
+                       std::move(sampler_tile_mode_descriptor));
+  }
+  InitializeDefaultVariants(gaussian_blur_pipelines_, "GaussianBlur");
+  {
+    auto decal_descriptor =
+        CreateDefaultPipelineDescriptor<GaussianBlurPipeline>(*context_);
+    if (decal_descriptor.has_value()) {
+      decal_descriptor->SetSpecializationConstants(
+          GaussianBlurFragmentShader::CreateSpecializationConstants(
+              {.kDecal = true}));
+      decal_descriptor->SetLabel(decal_descriptor->GetLabel() + " Decal");
+    }
+    InitializeVariants(gaussian_blur_decal_pipelines_, "GaussianBlurDecal",
+                       std::move(decal_descriptor));
+  }
+  InitializeDefaultVariants(border_mask_blur_pipelines_, "BorderMaskBlur");
+  InitializeDefaultVariants(morphology_filter_pipelines_, "MorphologyFilter");
+  InitializeDefaultVariants(color_matrix_color_filter_pipelines_,
+                            "ColorMatrixColorFilter");
+  InitializeDefaultVariants(linear_to_srgb_filter_pipelines_,
+                            "LinearToSrgbFilter");
+  InitializeDefaultVariants(srgb_to_linear_filter_pipelines_,
+                            "SrgbToLinearFilter");
+  InitializeDefaultVariants(glyph_atlas_pipelines_, "GlyphAtlas");
+  InitializeDefaultVariants(glyph_atlas_sdf_pipelines_, "GlyphAtlasSdf");
+  InitializeDefaultVariants(geometry_color_pipelines_, "GeometryColor");
+  InitializeDefaultVariants(geometry_position_pipelines_, "GeometryPosition");
+  InitializeDefaultVariants(yuv_to_rgb_filter_pipelines_, "YUVToRGBFilter");
+  if (context_->GetBackendFeatures().compute_shader_support) {
+    auto blur_compute_descriptor =
+        GaussianBlurComputePipeline::MakeDefaultPipelineDescriptor(*context_);
+    if (blur_compute_descriptor.has_value()) {
+      gaussian_blur_compute_pipeline_ =
+          context_->GetPipelineLibrary()->GetPipeline(
+              std::move(blur_compute_descriptor.value()));
+    }
+    auto stroke_compute_descriptor =
+        StrokeComputePipeline::MakeDefaultPipelineDescriptor(*context_);
+    if (stroke_compute_descriptor.has_value()) {
+      stroke_compute_pipeline_ = context_->GetPipelineLibrary()->GetPipeline(
+          std::move(stroke_compute_descriptor.value()));
+    }
+  }
+
+  if (solid_fill_pipelines_.prototype.has_value()) {
+    auto clip_pipeline_descriptor = solid_fill_pipelines_.prototype.value();
     clip_pipeline_descriptor.SetLabel("Clip Pipeline");
     // Disable write to all color attachments.
     auto color_attachments =
@@ -248,8 +383,8 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
     }
     clip_pipeline_descriptor.SetColorAttachmentDescriptors(
         std::move(color_attachments));
-    clip_pipelines_[{}] =
-        std::make_unique<ClipPipeline>(*context_, clip_pipeline_descriptor);
+    InitializeVariants(clip_pipelines_, "Clip",
+                       std::move(clip_pipeline_descriptor));
   } else {
     return;
   }
@@ -271,9 +406,11 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
 
   RenderTarget subpass_target;
   if (context->SupportsOffscreenMSAA() && msaa_enabled) {
-    subpass_target = RenderTarget::CreateOffscreenMSAA(*context, texture_size);
+    subpass_target = RenderTarget::CreateOffscreenMSAA(
+        *context, *GetRenderTargetCache(), texture_size);
   } else {
-    subpass_target = RenderTarget::CreateOffscreen(*context, texture_size);
+    subpass_target = RenderTarget::CreateOffscreen(
+        *context, *GetRenderTargetCache(), texture_size);
   }
   auto subpass_texture = subpass_target.GetRenderTargetTexture();
   if (!subpass_texture) {
@@ -290,6 +427,7 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   if (!sub_renderpass) {
     return nullptr;
   }
+  sub_renderpass->SetTransientsBuffer(GetTransientsBuffer());
   sub_renderpass->SetLabel("OffscreenContentsPass");
 
   if (!subpass_callback(*this, *sub_renderpass)) {
@@ -300,13 +438,42 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
     return nullptr;
   }
 
-  if (!sub_command_buffer->SubmitCommands()) {
+  if (!DeferredSubmissionScope::SubmitOrDefer(
+          std::move(sub_command_buffer))) {
     return nullptr;
   }
 
   return subpass_texture;
 }
 
+bool ContentContext::MakeComputeSubpass(
+    const std::string& label,
+    const ComputeSubpassCallback& subpass_callback) const {
+  auto context = GetContext();
+
+  auto sub_command_buffer = context->CreateCommandBuffer();
+  if (!sub_command_buffer) {
+    return false;
+  }
+  sub_command_buffer->SetLabel(label + " Command Buffer");
+
+  auto sub_compute_pass = sub_command_buffer->CreateComputePass();
+  if (!sub_compute_pass || !sub_compute_pass->IsValid()) {
+    return false;
+  }
+  sub_compute_pass->SetLabel(label);
+
+  if (!subpass_callback(*this, *sub_compute_pass)) {
+    return false;
+  }
+
+  if (!sub_compute_pass->EncodeCommands()) {
+    return false;
+  }
+
+  return DeferredSubmissionScope::SubmitOrDefer(std::move(sub_command_buffer));
+}
+
 std::shared_ptr<scene::SceneContext> ContentContext::GetSceneContext() const {
   return scene_context_;
 }
@@ -315,9 +482,11 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
-std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext()
-    const {
-  return glyph_atlas_context_;
+std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext(
+    GlyphAtlas::Type type) const {
+  return type == GlyphAtlas::Type::kSignedDistanceField
+             ? sdf_glyph_atlas_context_
+             : glyph_atlas_context_;
 }
 
 std::shared_ptr<Context> ContentContext::GetContext() const {
@@ -328,4 +497,98 @@ const BackendFeatures& ContentContext::GetBackendFeatures() const {
   return context_->GetBackendFeatures();
 }
 
+std::shared_ptr<RenderTargetAllocator> ContentContext::GetRenderTargetCache()
+    const {
+  return render_target_cache_;
+}
+
+static thread_local const ContentContext::WorkerTransientsScope*
+    tWorkerTransientsScope = nullptr;
+
+std::shared_ptr<HostBuffer> ContentContext::GetTransientsBuffer() const {
+  if (tWorkerTransientsScope && &tWorkerTransientsScope->renderer_ == this) {
+    return tWorkerTransientsScope->buffer_;
+  }
+  return transients_buffer_;
+}
+
+std::vector<std::shared_ptr<HostBuffer>>
+ContentContext::GetAllTransientsBuffers() const {
+  Lock lock(worker_transients_mutex_);
+  std::vector<std::shared_ptr<HostBuffer>> buffers;
+  buffers.reserve(worker_transients_buffers_.size() + 1u);
+  buffers.push_back(transients_buffer_);
+  buffers.insert(buffers.end(), worker_transients_buffers_.begin(),
+                 worker_transients_buffers_.end());
+  return buffers;
+}
+
+ContentContext::WorkerTransientsScope::WorkerTransientsScope(
+    const ContentContext& renderer)
+    : renderer_(renderer), previous_(tWorkerTransientsScope) {
+  {
+    Lock lock(renderer_.worker_transients_mutex_);
+    auto& free_buffers = renderer_.free_worker_transients_buffers_;
+    if (!free_buffers.empty()) {
+      buffer_ = std::move(free_buffers.back());
+      free_buffers.pop_back();
+    } else {
+      buffer_ = HostBuffer::Create(renderer_.context_->GetResourceAllocator());
+      buffer_->SetLabel("ContentContext Worker Transients");
+      renderer_.worker_transients_buffers_.push_back(buffer_);
+    }
+  }
+  tWorkerTransientsScope = this;
+}
+
+ContentContext::WorkerTransientsScope::~WorkerTransientsScope() {
+  FML_DCHECK(tWorkerTransientsScope == this);
+  tWorkerTransientsScope = previous_;
+  Lock lock(renderer_.worker_transients_mutex_);
+  renderer_.free_worker_transients_buffers_.push_back(std::move(buffer_));
+}
+
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+std::shared_ptr<GradientCache> ContentContext::GetGradientCache() const {
+  return gradient_cache_;
+}
+
+size_t ContentContext::PrewarmPipelineVariants(
+    const std::vector<PipelineVariantKey>& keys) const {
+  if (!IsValid()) {
+    return 0u;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::PrewarmPipelineVariants");
+  size_t created = 0u;
+  for (const auto& key : keys) {
+    auto creator = variant_creators_.find(key.pipeline);
+    if (creator == variant_creators_.end()) {
+      continue;
+    }
+    if (creator->second(key.options)) {
+      created++;
+    }
+  }
+  return created;
+}
+
+std::vector<PipelineVariantKey> ContentContext::GetUsedPipelineVariants()
+    const {
+  Lock lock(pipelines_mutex_);
+  return used_variants_;
+}
+
+void ContentContext::SetParallelSubpassEncodingEnabled(bool enabled) {
+  parallel_subpass_encoding_enabled_ = enabled;
+}
+
+bool ContentContext::IsParallelSubpassEncodingEnabled() const {
+  return parallel_subpass_encoding_enabled_ && context_ &&
+         !context_->HasThreadingRestrictions() && context_->GetWorkQueue();
+}
+
 }  // namespace impeller
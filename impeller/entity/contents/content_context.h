@@ -5,11 +5,17 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/base/validation.h"
 #include "impeller/entity/advanced_blend.vert.h"
 #include "impeller/entity/advanced_blend_color.frag.h"
@@ -34,9 +40,10 @@
 #include "impeller/entity/color_matrix_color_filter.frag.h"
 #include "impeller/entity/color_matrix_color_filter.vert.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/framebuffer_blend.frag.h"
+#include "impeller/entity/framebuffer_blend.vert.h"
 #include "impeller/entity/gaussian_blur.frag.h"
 #include "impeller/entity/gaussian_blur.vert.h"
-#include "impeller/entity/gaussian_blur_decal.frag.h"
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_sdf.frag.h"
@@ -52,18 +59,24 @@
 #include "impeller/entity/rrect_blur.vert.h"
 #include "impeller/entity/solid_fill.frag.h"
 #include "impeller/entity/solid_fill.vert.h"
+#include "impeller/entity/solid_rrect.frag.h"
 #include "impeller/entity/srgb_to_linear_filter.frag.h"
 #include "impeller/entity/srgb_to_linear_filter.vert.h"
 #include "impeller/entity/sweep_gradient_fill.frag.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
+#include "impeller/entity/texture_yuv_fill.frag.h"
 #include "impeller/entity/tiled_texture_fill.frag.h"
 #include "impeller/entity/tiled_texture_fill.vert.h"
 #include "impeller/entity/vertices.frag.h"
 #include "impeller/entity/yuv_to_rgb_filter.frag.h"
 #include "impeller/entity/yuv_to_rgb_filter.vert.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
 #include "impeller/renderer/formats.h"
+#include "impeller/renderer/host_buffer.h"
 #include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
 
 #include "impeller/entity/position.vert.h"
@@ -73,8 +86,13 @@
 #include "impeller/scene/scene_context.h"
 #include "impeller/typographer/glyph_atlas.h"
 
+#include "impeller/entity/atlas_instanced_color.vert.h"
+#include "impeller/entity/atlas_instanced_texture.vert.h"
+#include "impeller/entity/gaussian_blur.comp.h"
 #include "impeller/entity/linear_gradient_ssbo_fill.frag.h"
+#include "impeller/entity/points_instanced.vert.h"
 #include "impeller/entity/radial_gradient_ssbo_fill.frag.h"
+#include "impeller/entity/stroke.comp.h"
 #include "impeller/entity/sweep_gradient_ssbo_fill.frag.h"
 
 namespace impeller {
@@ -96,9 +114,21 @@ using RadialGradientSSBOFillPipeline =
 using SweepGradientSSBOFillPipeline =
     RenderPipelineT<GradientFillVertexShader,
                     SweepGradientSsboFillFragmentShader>;
+using AtlasInstancedTexturePipeline =
+    RenderPipelineT<AtlasInstancedTextureVertexShader,
+                    TextureFillFragmentShader>;
+using AtlasInstancedColorPipeline =
+    RenderPipelineT<AtlasInstancedColorVertexShader, VerticesFragmentShader>;
+using PointsInstancedPipeline =
+    RenderPipelineT<PointsInstancedVertexShader, SolidFillFragmentShader>;
 using BlendPipeline = RenderPipelineT<BlendVertexShader, BlendFragmentShader>;
+using GaussianBlurComputePipeline =
+    ComputePipelineBuilder<GaussianBlurComputeShader>;
+using StrokeComputePipeline = ComputePipelineBuilder<StrokeComputeShader>;
 using RRectBlurPipeline =
     RenderPipelineT<RrectBlurVertexShader, RrectBlurFragmentShader>;
+using SolidRRectPipeline =
+    RenderPipelineT<RrectBlurVertexShader, SolidRrectFragmentShader>;
 using BlendPipeline = RenderPipelineT<BlendVertexShader, BlendFragmentShader>;
 using BlendColorPipeline = RenderPipelineT<AdvancedBlendVertexShader,
                                            AdvancedBlendColorFragmentShader>;
@@ -141,14 +171,19 @@ using BlendScreenPipeline = RenderPipelineT<AdvancedBlendVertexShader,
 using BlendSoftLightPipeline =
     RenderPipelineT<AdvancedBlendVertexShader,
                     AdvancedBlendSoftlightFragmentShader>;
+// Blends all advanced blend modes with the color attachment using framebuffer
+// fetch.
+using FramebufferBlendPipeline =
+    RenderPipelineT<FramebufferBlendVertexShader,
+                    FramebufferBlendFragmentShader>;
 using TexturePipeline =
     RenderPipelineT<TextureFillVertexShader, TextureFillFragmentShader>;
+using TextureYUVPipeline =
+    RenderPipelineT<TextureFillVertexShader, TextureYuvFillFragmentShader>;
 using TiledTexturePipeline = RenderPipelineT<TiledTextureFillVertexShader,
                                              TiledTextureFillFragmentShader>;
 using GaussianBlurPipeline =
     RenderPipelineT<GaussianBlurVertexShader, GaussianBlurFragmentShader>;
-using GaussianBlurDecalPipeline =
-    RenderPipelineT<GaussianBlurVertexShader, GaussianBlurDecalFragmentShader>;
 using BorderMaskBlurPipeline =
     RenderPipelineT<BorderMaskBlurVertexShader, BorderMaskBlurFragmentShader>;
 using MorphologyFilterPipeline =
@@ -224,7 +259,33 @@ struct ContentContextOptions {
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Identifies a pipeline variant created by the content context.
+///             Used to record the variants used by a run of the application so
+///             that they may be prewarmed on subsequent runs.
+///
+struct PipelineVariantKey {
+  /// The name of the pipeline the variant is derived from. For example,
+  /// "SolidFill".
+  std::string pipeline;
+  ContentContextOptions options;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serialize the keys into a line based text format suitable for
+  ///             storing on disk.
+  ///
+  static std::string Serialize(const std::vector<PipelineVariantKey>& keys);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parse keys serialized by `Serialize`. Malformed lines are
+  ///             skipped.
+  ///
+  static std::vector<PipelineVariantKey> Deserialize(std::string_view data);
+};
+
+class GradientCache;
 class Tessellator;
+class TessellationCache;
 
 class ContentContext {
  public:
@@ -261,6 +322,24 @@ class ContentContext {
     return GetPipeline(sweep_gradient_ssbo_fill_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetAtlasInstancedTexturePipeline(ContentContextOptions opts) const {
+    FML_DCHECK(GetBackendFeatures().ssbo_support);
+    return GetPipeline(atlas_instanced_texture_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetAtlasInstancedColorPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetBackendFeatures().ssbo_support);
+    return GetPipeline(atlas_instanced_color_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetPointsInstancedPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetBackendFeatures().ssbo_support);
+    return GetPipeline(points_instanced_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetRadialGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(radial_gradient_fill_pipelines_, opts);
@@ -271,6 +350,11 @@ class ContentContext {
     return GetPipeline(rrect_blur_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetSolidRRectPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(solid_rrect_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetSweepGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(sweep_gradient_fill_pipelines_, opts);
@@ -291,11 +375,21 @@ class ContentContext {
     return GetPipeline(texture_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetTextureYUVPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(texture_yuv_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetTiledTexturePipeline(
       ContentContextOptions opts) const {
     return GetPipeline(tiled_texture_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetTiledTextureSamplerTileModePipeline(ContentContextOptions opts) const {
+    return GetPipeline(tiled_texture_sampler_tile_mode_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGaussianBlurPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(gaussian_blur_pipelines_, opts);
@@ -306,6 +400,21 @@ class ContentContext {
     return GetPipeline(gaussian_blur_decal_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+  GetGaussianBlurComputePipeline() const {
+    FML_DCHECK(GetBackendFeatures().compute_shader_support);
+    return gaussian_blur_compute_pipeline_.IsValid()
+               ? gaussian_blur_compute_pipeline_.Get()
+               : nullptr;
+  }
+
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+  GetStrokeComputePipeline() const {
+    FML_DCHECK(GetBackendFeatures().compute_shader_support);
+    return stroke_compute_pipeline_.IsValid() ? stroke_compute_pipeline_.Get()
+                                              : nullptr;
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBorderMaskBlurPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(border_mask_blur_pipelines_, opts);
@@ -438,12 +547,117 @@ class ContentContext {
     return GetPipeline(blend_softlight_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetFramebufferBlendPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetBackendFeatures().framebuffer_fetch_support);
+    return GetPipeline(framebuffer_blend_pipelines_, opts);
+  }
+
   std::shared_ptr<Context> GetContext() const;
 
-  std::shared_ptr<GlyphAtlasContext> GetGlyphAtlasContext() const;
+  //----------------------------------------------------------------------------
+  /// @brief      The context that caches the glyph atlases of the given type
+  ///             across frames. The bitmap atlases share one context, and the
+  ///             signed-distance field atlas has its own.
+  ///
+  std::shared_ptr<GlyphAtlasContext> GetGlyphAtlasContext(
+      GlyphAtlas::Type type) const;
 
   const BackendFeatures& GetBackendFeatures() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The allocator used for all offscreen render targets created
+  ///             through this content context. Textures handed out by it are
+  ///             recycled across frames bracketed by `Start`/`End`.
+  ///
+  std::shared_ptr<RenderTargetAllocator> GetRenderTargetCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The device backed transients buffer of the render passes
+  ///             created through this content context on the calling thread.
+  ///             This is the buffer of the thread's `WorkerTransientsScope`
+  ///             if one is active, and the main buffer otherwise.
+  ///
+  std::shared_ptr<HostBuffer> GetTransientsBuffer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      All the transients buffers of this content context, the main
+  ///             one first. Each of them must be reset once per frame.
+  ///
+  std::vector<std::shared_ptr<HostBuffer>> GetAllTransientsBuffers() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gives the calling thread a transients buffer of its own while
+  ///             the scope is alive. Entity passes encoded concurrently on
+  ///             worker threads install one so that they don't write into
+  ///             the same buffer.
+  ///
+  ///             The buffers are pooled by the content context. Each one is
+  ///             used by a single scope at a time, and keeps its data until
+  ///             it is reset with the other transients buffers.
+  ///
+  class WorkerTransientsScope {
+   public:
+    explicit WorkerTransientsScope(const ContentContext& renderer);
+
+    ~WorkerTransientsScope();
+
+   private:
+    friend class ContentContext;
+
+    const ContentContext& renderer_;
+    std::shared_ptr<HostBuffer> buffer_;
+    const WorkerTransientsScope* previous_ = nullptr;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(WorkerTransientsScope);
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of the vertices created from paths by geometries.
+  ///             It must be bracketed by `Start`/`End` once per frame. This is
+  ///             null if the content context is not valid.
+  ///
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of the color ramps of gradients. It must be
+  ///             bracketed by `Start`/`End` once per frame. This is null if
+  ///             the content context is not valid.
+  ///
+  std::shared_ptr<GradientCache> GetGradientCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allow entity passes to encode sibling subpasses that don't
+  ///             depend on each other concurrently on the context's work
+  ///             queue. This is ignored for contexts with threading
+  ///             restrictions.
+  ///
+  void SetParallelSubpassEncodingEnabled(bool enabled);
+
+  bool IsParallelSubpassEncodingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start creating the given pipeline variants. This does not
+  ///             wait for the variants to be ready. Backends that compile
+  ///             pipelines asynchronously do so on their worker threads in
+  ///             the order of the keys. So the keys must be sorted by
+  ///             priority, like the ones returned by `GetUsedPipelineVariants`.
+  ///
+  ///             Keys that name unknown pipelines are ignored.
+  ///
+  /// @param[in]  keys  The variants to create.
+  ///
+  /// @return     The number of variants that were not created yet.
+  ///
+  size_t PrewarmPipelineVariants(
+      const std::vector<PipelineVariantKey>& keys) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pipeline variants requested during rendering so far, in
+  ///             the order they were first requested.
+  ///
+  std::vector<PipelineVariantKey> GetUsedPipelineVariants() const;
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -453,14 +667,36 @@ class ContentContext {
                                        const SubpassCallback& subpass_callback,
                                        bool msaa_enabled = true) const;
 
+  using ComputeSubpassCallback =
+      std::function<bool(const ContentContext&, ComputePass&)>;
+
+  /// @brief  Calls `subpass_callback` with a `ComputePass` and submits it. The
+  ///         results are visible to work submitted afterwards.
+  ///
+  /// @warning Must only be called if the backend supports compute shaders.
+  bool MakeComputeSubpass(const std::string& label,
+                          const ComputeSubpassCallback& subpass_callback) const;
+
  private:
   std::shared_ptr<Context> context_;
 
   template <class T>
-  using Variants = std::unordered_map<ContentContextOptions,
-                                      std::unique_ptr<T>,
-                                      ContentContextOptions::Hash,
-                                      ContentContextOptions::Equal>;
+  struct Variants {
+    /// The name used to identify the pipeline in variant keys.
+    std::string name;
+    /// The descriptor all variants are derived from. Computed in the
+    /// constructor.
+    std::optional<PipelineDescriptor> prototype;
+    std::unordered_map<ContentContextOptions,
+                       std::unique_ptr<T>,
+                       ContentContextOptions::Hash,
+                       ContentContextOptions::Equal>
+        pipelines;
+    std::unordered_set<ContentContextOptions,
+                       ContentContextOptions::Hash,
+                       ContentContextOptions::Equal>
+        used;
+  };
 
   // These are mutable because while the prototypes are created eagerly, any
   // variants requested from that are lazily created and cached in the variants
@@ -475,12 +711,24 @@ class ContentContext {
       radial_gradient_ssbo_fill_pipelines_;
   mutable Variants<SweepGradientSSBOFillPipeline>
       sweep_gradient_ssbo_fill_pipelines_;
+  mutable Variants<AtlasInstancedTexturePipeline>
+      atlas_instanced_texture_pipelines_;
+  mutable Variants<AtlasInstancedColorPipeline>
+      atlas_instanced_color_pipelines_;
+  mutable Variants<PointsInstancedPipeline> points_instanced_pipelines_;
   mutable Variants<RRectBlurPipeline> rrect_blur_pipelines_;
+  mutable Variants<SolidRRectPipeline> solid_rrect_pipelines_;
   mutable Variants<BlendPipeline> texture_blend_pipelines_;
   mutable Variants<TexturePipeline> texture_pipelines_;
+  mutable Variants<TextureYUVPipeline> texture_yuv_pipelines_;
   mutable Variants<TiledTexturePipeline> tiled_texture_pipelines_;
+  // The tiled texture pipelines that sample with the tile modes of the
+  // sampler.
+  mutable Variants<TiledTexturePipeline>
+      tiled_texture_sampler_tile_mode_pipelines_;
   mutable Variants<GaussianBlurPipeline> gaussian_blur_pipelines_;
-  mutable Variants<GaussianBlurDecalPipeline> gaussian_blur_decal_pipelines_;
+  // The blur pipelines with the decal specialization constant set.
+  mutable Variants<GaussianBlurPipeline> gaussian_blur_decal_pipelines_;
   mutable Variants<BorderMaskBlurPipeline> border_mask_blur_pipelines_;
   mutable Variants<MorphologyFilterPipeline> morphology_filter_pipelines_;
   mutable Variants<ColorMatrixColorFilterPipeline>
@@ -509,6 +757,40 @@ class ContentContext {
   mutable Variants<BlendSaturationPipeline> blend_saturation_pipelines_;
   mutable Variants<BlendScreenPipeline> blend_screen_pipelines_;
   mutable Variants<BlendSoftLightPipeline> blend_softlight_pipelines_;
+  mutable Variants<FramebufferBlendPipeline> framebuffer_blend_pipelines_;
+  PipelineFuture<ComputePipelineDescriptor> gaussian_blur_compute_pipeline_;
+  PipelineFuture<ComputePipelineDescriptor> stroke_compute_pipeline_;
+
+  template <class TypedPipeline>
+  void InitializeVariants(Variants<TypedPipeline>& container,
+                          std::string name,
+                          std::optional<PipelineDescriptor> prototype);
+
+  template <class TypedPipeline>
+  void InitializeDefaultVariants(Variants<TypedPipeline>& container,
+                                 std::string name);
+
+  template <class TypedPipeline>
+  TypedPipeline* FindOrCreateVariant(Variants<TypedPipeline>& container,
+                                     const ContentContextOptions& opts) const
+      IPLR_REQUIRES(pipelines_mutex_) {
+    if (auto found = container.pipelines.find(opts);
+        found != container.pipelines.end()) {
+      return found->second.get();
+    }
+
+    // The prototype must always be initialized in the constructor.
+    FML_CHECK(container.prototype.has_value());
+
+    auto desc = container.prototype.value();
+    opts.ApplyToPipelineDescriptor(desc);
+    desc.SetLabel(SPrintF("%s V#%zu", desc.GetLabel().c_str(),
+                          container.pipelines.size()));
+    auto variant = std::make_unique<TypedPipeline>(*context_, desc);
+    auto variant_ptr = variant.get();
+    container.pipelines[opts] = std::move(variant);
+    return variant_ptr;
+  }
 
   template <class TypedPipeline>
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetPipeline(
@@ -518,31 +800,45 @@ class ContentContext {
       return nullptr;
     }
 
-    if (auto found = container.find(opts); found != container.end()) {
-      return found->second->WaitAndGet();
+    // Variants may be requested by entity passes encoded on worker threads.
+    // The lock is released before waiting for the pipeline, so that a slow
+    // compile doesn't hold up the lookups of other pipelines.
+    PipelineFuture<PipelineDescriptor> future;
+    {
+      Lock lock(pipelines_mutex_);
+      if (container.used.insert(opts).second) {
+        used_variants_.push_back({container.name, opts});
+      }
+      future = FindOrCreateVariant(container, opts)->GetPipelineFuture();
     }
-
-    auto prototype = container.find({});
-
-    // The prototype must always be initialized in the constructor.
-    FML_CHECK(prototype != container.end());
-
-    auto variant_future = prototype->second->WaitAndGet()->CreateVariant(
-        [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
-          opts.ApplyToPipelineDescriptor(desc);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
-        });
-    auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
-    container[opts] = std::move(variant);
-    return variant_pipeline;
+    if (!future.IsValid()) {
+      return nullptr;
+    }
+    return future.Get();
   }
 
+  mutable Mutex pipelines_mutex_;
+  mutable std::vector<PipelineVariantKey> used_variants_
+      IPLR_GUARDED_BY(pipelines_mutex_);
+  // Create the named variant if it doesn't exist. Return if it was created.
+  std::unordered_map<std::string,
+                     std::function<bool(const ContentContextOptions&)>>
+      variant_creators_;
   bool is_valid_ = false;
+  bool parallel_subpass_encoding_enabled_ = false;
   std::shared_ptr<Tessellator> tessellator_;
   std::shared_ptr<GlyphAtlasContext> glyph_atlas_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_glyph_atlas_context_;
   std::shared_ptr<scene::SceneContext> scene_context_;
+  std::shared_ptr<RenderTargetAllocator> render_target_cache_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
+  mutable Mutex worker_transients_mutex_;
+  mutable std::vector<std::shared_ptr<HostBuffer>> worker_transients_buffers_
+      IPLR_GUARDED_BY(worker_transients_mutex_);
+  mutable std::vector<std::shared_ptr<HostBuffer>>
+      free_worker_transients_buffers_ IPLR_GUARDED_BY(worker_transients_mutex_);
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  std::shared_ptr<GradientCache> gradient_cache_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
@@ -128,4 +128,19 @@ bool Contents::ShouldRender(const Entity& entity,
   return stencil_coverage->IntersectsWithRect(coverage.value());
 }
 
+bool Contents::CanBatchWith(const Contents& other) const {
+  return false;
+}
+
+bool Contents::RenderBatch(const ContentContext& renderer,
+                           const std::vector<Entity>& entities,
+                           RenderPass& pass) const {
+  for (const auto& entity : entities) {
+    if (!entity.Render(renderer, pass)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace impeller
@@ -75,6 +75,21 @@ class Contents {
   virtual bool ShouldRender(const Entity& entity,
                             const std::optional<Rect>& stencil_coverage) const;
 
+  /// @brief Whether an entity with this contents may be drawn in the same
+  ///        batch as a preceding entity with the `other` contents. The
+  ///        entities are guaranteed to have the same blend mode and stencil
+  ///        depth, and affine transformations.
+  virtual bool CanBatchWith(const Contents& other) const;
+
+  /// @brief Render consecutive entities whose contents can be batched with
+  ///        this one in as few commands as possible. Primitives must be
+  ///        submitted in entity order so that overlapping entities blend as
+  ///        if they had been rendered one at a time. By default, every entity
+  ///        is rendered as usual.
+  virtual bool RenderBatch(const ContentContext& renderer,
+                           const std::vector<Entity>& entities,
+                           RenderPass& pass) const;
+
  protected:
 
  private:
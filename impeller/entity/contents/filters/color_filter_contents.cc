@@ -4,7 +4,9 @@
 
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 
+#include <algorithm>
 #include <utility>
+#include <variant>
 
 #include "impeller/base/validation.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
@@ -55,9 +57,86 @@ std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeBlend(
   return new_blend;
 }
 
+//------------------------------------------------------------------------------
+/// Per-pixel color filters applied to the output of another one are fused
+/// with it where the result is the same, so that the chain renders a single
+/// pass instead of one per filter.
+///
+
+/// Returns the filter of `input` if it is a `T` whose output can be computed
+/// by the filter consuming it instead.
+template <typename T>
+static std::shared_ptr<T> GetFusableFilter(const FilterInput::Ref& input) {
+  if (!input) {
+    return nullptr;
+  }
+  auto variant = input->GetInput();
+  auto contents = std::get_if<std::shared_ptr<FilterContents>>(&variant);
+  if (!contents) {
+    return nullptr;
+  }
+  auto filter = std::dynamic_pointer_cast<T>(*contents);
+  if (!filter || filter->GetInputs().size() != 1u ||
+      filter->GetAbsorbOpacity() || filter->GetAlpha().has_value()) {
+    return nullptr;
+  }
+  return filter;
+}
+
+/// Whether the color matrix maps all colors of the unit cube into it. The
+/// shader clamps the results of a matrix, so they can only be composed with
+/// another matrix if the clamp doesn't change them.
+static bool PreservesUnitRange(const FilterContents::ColorMatrix& matrix) {
+  for (size_t row = 0; row < 4; row++) {
+    const float* coefficients = &matrix.array[row * 5];
+    float min = coefficients[4];
+    float max = coefficients[4];
+    for (size_t column = 0; column < 4; column++) {
+      min += std::min(coefficients[column], 0.0f);
+      max += std::max(coefficients[column], 0.0f);
+    }
+    if (min < 0.0f || max > 1.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Returns the color matrix applying `inner` then `outer`.
+static FilterContents::ColorMatrix ComposeColorMatrices(
+    const FilterContents::ColorMatrix& outer,
+    const FilterContents::ColorMatrix& inner) {
+  FilterContents::ColorMatrix result;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 5; column++) {
+      float value = column == 4 ? outer.array[row * 5 + 4] : 0.0f;
+      for (size_t k = 0; k < 4; k++) {
+        value += outer.array[row * 5 + k] * inner.array[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
+static constexpr FilterContents::ColorMatrix kIdentityColorMatrix = {{
+    1, 0, 0, 0, 0,  //
+    0, 1, 0, 0, 0,  //
+    0, 0, 1, 0, 0,  //
+    0, 0, 0, 1, 0,  //
+}};
+
 std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeColorMatrix(
     FilterInput::Ref input,
     const ColorMatrix& color_matrix) {
+  // The intermediate texture of the inner filter is premultiplied, so only
+  // colors with an alpha of zero can differ, and those are transparent.
+  if (auto inner = GetFusableFilter<ColorMatrixFilterContents>(input);
+      inner && PreservesUnitRange(inner->GetMatrix())) {
+    return MakeColorMatrix(
+        inner->GetInputs()[0],
+        ComposeColorMatrices(color_matrix, inner->GetMatrix()));
+  }
   auto filter = std::make_shared<ColorMatrixFilterContents>();
   filter->SetInputs({std::move(input)});
   filter->SetMatrix(color_matrix);
@@ -66,6 +145,10 @@ std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeColorMatrix(
 
 std::shared_ptr<ColorFilterContents>
 ColorFilterContents::MakeLinearToSrgbFilter(FilterInput::Ref input) {
+  // The conversions cancel out. The identity matrix doesn't render a pass.
+  if (auto inner = GetFusableFilter<SrgbToLinearFilterContents>(input)) {
+    return MakeColorMatrix(inner->GetInputs()[0], kIdentityColorMatrix);
+  }
   auto filter = std::make_shared<LinearToSrgbFilterContents>();
   filter->SetInputs({std::move(input)});
   return filter;
@@ -73,6 +156,9 @@ ColorFilterContents::MakeLinearToSrgbFilter(FilterInput::Ref input) {
 
 std::shared_ptr<ColorFilterContents>
 ColorFilterContents::MakeSrgbToLinearFilter(FilterInput::Ref input) {
+  if (auto inner = GetFusableFilter<LinearToSrgbFilterContents>(input)) {
+    return MakeColorMatrix(inner->GetInputs()[0], kIdentityColorMatrix);
+  }
   auto filter = std::make_shared<SrgbToLinearFilterContents>();
   filter->SetInputs({std::move(input)});
   return filter;
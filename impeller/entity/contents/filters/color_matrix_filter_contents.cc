@@ -23,6 +23,22 @@ void ColorMatrixFilterContents::SetMatrix(const ColorMatrix& matrix) {
   matrix_ = matrix;
 }
 
+const FilterContents::ColorMatrix& ColorMatrixFilterContents::GetMatrix()
+    const {
+  return matrix_;
+}
+
+static bool IsIdentity(const FilterContents::ColorMatrix& matrix) {
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 5; column++) {
+      if (matrix.array[row * 5 + column] != (row == column ? 1.0f : 0.0f)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -45,6 +61,13 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     return std::nullopt;
   }
 
+  // Fused filters that cancel out, like an sRGB round trip, don't need a
+  // pass. Whether the opacity is absorbed or not, it's applied the same way.
+  if (IsIdentity(matrix_)) {
+    return Contents::EntityFromSnapshot(input_snapshot, entity.GetBlendMode(),
+                                        entity.GetStencilDepth());
+  }
+
   //----------------------------------------------------------------------------
   /// Render to texture.
   ///
@@ -22,6 +22,8 @@ class ColorMatrixFilterContents final : public ColorFilterContents {
 
   void SetMatrix(const ColorMatrix& matrix);
 
+  const ColorMatrix& GetMatrix() const;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
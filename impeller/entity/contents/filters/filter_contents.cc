@@ -149,6 +149,10 @@ void FilterContents::SetInputs(FilterInput::Vector inputs) {
   inputs_ = std::move(inputs);
 }
 
+const FilterInput::Vector& FilterContents::GetInputs() const {
+  return inputs_;
+}
+
 void FilterContents::SetCoverageCrop(std::optional<Rect> coverage_crop) {
   coverage_crop_ = coverage_crop;
 }
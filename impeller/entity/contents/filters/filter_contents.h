@@ -100,6 +100,8 @@ class FilterContents : public Contents {
   ///         particular filter's implementation.
   void SetInputs(FilterInput::Vector inputs);
 
+  const FilterInput::Vector& GetInputs() const;
+
   /// @brief  Screen space bounds to use for cropping the filter output.
   void SetCoverageCrop(std::optional<Rect> coverage_crop);
 
@@ -5,6 +5,7 @@
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 
 #include <cmath>
+#include <limits>
 #include <utility>
 #include <valarray>
 
@@ -15,6 +16,8 @@
 #include "impeller/geometry/rect.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_command.h"
+#include "impeller/renderer/compute_pass.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -23,6 +26,33 @@
 
 namespace impeller {
 
+// These must match kMaxRadius and the local size of gaussian_blur.comp.
+static constexpr Scalar kComputeBlurMaxRadius = 64;
+static constexpr int64_t kComputeBlurWorkgroupSize = 128;
+// Metal requires the rows of textures backed by buffers to be aligned.
+static constexpr int64_t kComputeBlurRowAlignment = 256;
+
+static SamplerDescriptor ApplyTileMode(SamplerDescriptor descriptor,
+                                       Entity::TileMode tile_mode) {
+  switch (tile_mode) {
+    case Entity::TileMode::kDecal:
+      break;
+    case Entity::TileMode::kClamp:
+      descriptor.width_address_mode = SamplerAddressMode::kClampToEdge;
+      descriptor.height_address_mode = SamplerAddressMode::kClampToEdge;
+      break;
+    case Entity::TileMode::kMirror:
+      descriptor.width_address_mode = SamplerAddressMode::kMirror;
+      descriptor.height_address_mode = SamplerAddressMode::kMirror;
+      break;
+    case Entity::TileMode::kRepeat:
+      descriptor.width_address_mode = SamplerAddressMode::kRepeat;
+      descriptor.height_address_mode = SamplerAddressMode::kRepeat;
+      break;
+  }
+  return descriptor;
+}
+
 DirectionalGaussianBlurFilterContents::DirectionalGaussianBlurFilterContents() =
     default;
 
@@ -213,35 +243,13 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
 
     auto options = OptionsFromPass(pass);
     options.blend_mode = BlendMode::kSource;
-    auto input_descriptor = input_snapshot->sampler_descriptor;
-    auto source_descriptor = source_snapshot->sampler_descriptor;
-    switch (tile_mode_) {
-      case Entity::TileMode::kDecal:
-        cmd.pipeline = renderer.GetGaussianBlurDecalPipeline(options);
-        break;
-      case Entity::TileMode::kClamp:
-        cmd.pipeline = renderer.GetGaussianBlurPipeline(options);
-        input_descriptor.width_address_mode = SamplerAddressMode::kClampToEdge;
-        input_descriptor.height_address_mode = SamplerAddressMode::kClampToEdge;
-        source_descriptor.width_address_mode = SamplerAddressMode::kClampToEdge;
-        source_descriptor.height_address_mode =
-            SamplerAddressMode::kClampToEdge;
-        break;
-      case Entity::TileMode::kMirror:
-        cmd.pipeline = renderer.GetGaussianBlurPipeline(options);
-        input_descriptor.width_address_mode = SamplerAddressMode::kMirror;
-        input_descriptor.height_address_mode = SamplerAddressMode::kMirror;
-        source_descriptor.width_address_mode = SamplerAddressMode::kMirror;
-        source_descriptor.height_address_mode = SamplerAddressMode::kMirror;
-        break;
-      case Entity::TileMode::kRepeat:
-        cmd.pipeline = renderer.GetGaussianBlurPipeline(options);
-        input_descriptor.width_address_mode = SamplerAddressMode::kRepeat;
-        input_descriptor.height_address_mode = SamplerAddressMode::kRepeat;
-        source_descriptor.width_address_mode = SamplerAddressMode::kRepeat;
-        source_descriptor.height_address_mode = SamplerAddressMode::kRepeat;
-        break;
-    }
+    cmd.pipeline = tile_mode_ == Entity::TileMode::kDecal
+                       ? renderer.GetGaussianBlurDecalPipeline(options)
+                       : renderer.GetGaussianBlurPipeline(options);
+    auto input_descriptor =
+        ApplyTileMode(input_snapshot->sampler_descriptor, tile_mode_);
+    auto source_descriptor =
+        ApplyTileMode(source_snapshot->sampler_descriptor, tile_mode_);
 
     FS::BindTextureSampler(
         cmd, input_snapshot->texture,
@@ -273,10 +281,28 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     scale.y = scale_curve(y_radius);
   }
 
+  const bool use_compute = CanRenderWithCompute(renderer);
+  if (use_compute) {
+    // Downsample large blurs until the kernel fits in the compute shader's
+    // shared memory tile.
+    scale.x = std::min(scale.x,
+                       kComputeBlurMaxRadius / transformed_blur_radius_length);
+  }
+
   Vector2 scaled_size = pass_texture_rect.size * scale;
   ISize floored_size = ISize(scaled_size.x, scaled_size.y);
 
-  auto out_texture = renderer.MakeSubpass(floored_size, callback);
+  std::shared_ptr<Texture> out_texture;
+  if (use_compute) {
+    // The radius in output pixels.
+    auto output_radius = transformed_blur_radius_length * floored_size.width /
+                         pass_texture_rect.size.width;
+    out_texture = RenderWithCompute(renderer, input_snapshot.value(),
+                                    input_uvs, floored_size, output_radius);
+  }
+  if (!out_texture) {
+    out_texture = renderer.MakeSubpass(floored_size, callback);
+  }
 
   if (!out_texture) {
     return std::nullopt;
@@ -298,6 +324,95 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
       entity.GetBlendMode(), entity.GetStencilDepth());
 }
 
+bool DirectionalGaussianBlurFilterContents::CanRenderWithCompute(
+    const ContentContext& renderer) const {
+  // The compute shader only implements a plain blur. Blur styles and the
+  // secondary sigma need the alpha mask input of the fragment shader.
+  return renderer.GetBackendFeatures().compute_shader_support &&
+         !source_override_ && !src_color_factor_ && inner_blur_factor_ &&
+         outer_blur_factor_ && renderer.GetGaussianBlurComputePipeline();
+}
+
+std::shared_ptr<Texture>
+DirectionalGaussianBlurFilterContents::RenderWithCompute(
+    const ContentContext& renderer,
+    const Snapshot& input_snapshot,
+    const std::array<Point, 4>& input_uvs,
+    ISize output_size,
+    Scalar output_radius) const {
+  using CS = GaussianBlurComputePipeline::ComputeShader;
+
+  if (output_size.IsEmpty()) {
+    return nullptr;
+  }
+  const auto row_pixels =
+      (output_size.width * 4 + kComputeBlurRowAlignment - 1) /
+      kComputeBlurRowAlignment * kComputeBlurRowAlignment / 4;
+  const auto row_bytes = row_pixels * 4;
+  if (row_bytes > std::numeric_limits<uint16_t>::max()) {
+    return nullptr;
+  }
+
+  auto context = renderer.GetContext();
+  auto allocator = context->GetResourceAllocator();
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+  buffer_desc.size = row_bytes * output_size.height;
+  auto output_buffer = allocator->CreateBuffer(buffer_desc);
+  if (!output_buffer) {
+    return nullptr;
+  }
+  output_buffer->SetLabel("DirectionalGaussianBlurFilter Compute Buffer");
+
+  auto r = Radius{output_radius};
+  CS::BlurInfo blur_info;
+  blur_info.uv_origin = input_uvs[0];
+  blur_info.uv_step_x = (input_uvs[1] - input_uvs[0]) / output_size.width;
+  blur_info.uv_step_y = (input_uvs[2] - input_uvs[0]) / output_size.height;
+  blur_info.output_width = output_size.width;
+  blur_info.output_height = output_size.height;
+  blur_info.output_row_pixels = row_pixels;
+  blur_info.blur_sigma = Sigma{r}.sigma;
+  blur_info.blur_radius = std::min(r.radius, kComputeBlurMaxRadius);
+  blur_info.texture_sampler_y_coord_scale =
+      input_snapshot.texture->GetYCoordScale();
+  blur_info.decal = tile_mode_ == Entity::TileMode::kDecal;
+
+  auto sampler_descriptor =
+      ApplyTileMode(input_snapshot.sampler_descriptor, tile_mode_);
+
+  ContentContext::ComputeSubpassCallback callback =
+      [&](const ContentContext& renderer, ComputePass& pass) {
+        pass.SetGridSize(output_size);
+        pass.SetThreadGroupSize(ISize(kComputeBlurWorkgroupSize, 1));
+
+        ComputeCommand cmd;
+        cmd.label = SPrintF("Gaussian Blur Compute (Radius=%.2f)",
+                            output_radius);
+        cmd.pipeline = renderer.GetGaussianBlurComputePipeline();
+
+        CS::BindBlurInfo(cmd,
+                         pass.GetTransientsBuffer().EmplaceUniform(blur_info));
+        CS::BindTextureSampler(
+            cmd, input_snapshot.texture,
+            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                sampler_descriptor));
+        CS::BindOutput(cmd, output_buffer->AsBufferView());
+
+        return pass.AddCommand(std::move(cmd));
+      };
+  if (!renderer.MakeComputeSubpass("Gaussian Blur Compute", callback)) {
+    return nullptr;
+  }
+
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kDevicePrivate;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = output_size;
+  return output_buffer->AsTexture(*allocator, texture_desc, row_bytes);
+}
+
 std::optional<Rect> DirectionalGaussianBlurFilterContents::GetFilterCoverage(
     const FilterInput::Vector& inputs,
     const Entity& entity,
@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <optional>
+
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 
@@ -42,6 +44,24 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
                                      const Entity& entity,
                                      const Matrix& effect_transform,
                                      const Rect& coverage) const override;
+
+  bool CanRenderWithCompute(const ContentContext& renderer) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blur the input along the X axis of the output using the
+  ///             compute pipeline. Each workgroup shares the samples needed
+  ///             by a run of output pixels instead of fetching them per tap.
+  ///
+  /// @return     The blurred texture or null if the blur must be rendered
+  ///             with the fragment pipeline instead.
+  ///
+  std::shared_ptr<Texture> RenderWithCompute(
+      const ContentContext& renderer,
+      const Snapshot& input_snapshot,
+      const std::array<Point, 4>& input_uvs,
+      ISize output_size,
+      Scalar output_radius) const;
+
   Sigma blur_sigma_;
   Sigma secondary_blur_sigma_;
   Vector2 blur_direction_;
@@ -36,6 +36,17 @@ void YUVToRGBFilterContents::SetYUVColorSpace(YUVColorSpace yuv_color_space) {
   yuv_color_space_ = yuv_color_space;
 }
 
+Matrix YUVToRGBFilterContents::GetConversionMatrix(
+    YUVColorSpace yuv_color_space) {
+  switch (yuv_color_space) {
+    case YUVColorSpace::kBT601LimitedRange:
+      return kMatrixBT601LimitedRange;
+    case YUVColorSpace::kBT601FullRange:
+      return kMatrixBT601FullRange;
+  }
+  return kMatrixBT601LimitedRange;
+}
+
 std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -92,14 +103,7 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
     frag_info.texture_sampler_y_coord_scale =
         y_input_snapshot->texture->GetYCoordScale();
     frag_info.yuv_color_space = static_cast<Scalar>(yuv_color_space_);
-    switch (yuv_color_space_) {
-      case YUVColorSpace::kBT601LimitedRange:
-        frag_info.matrix = kMatrixBT601LimitedRange;
-        break;
-      case YUVColorSpace::kBT601FullRange:
-        frag_info.matrix = kMatrixBT601FullRange;
-        break;
-    }
+    frag_info.matrix = GetConversionMatrix(yuv_color_space_);
 
     auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
     FS::BindYTexture(cmd, y_input_snapshot->texture, sampler);
@@ -16,6 +16,10 @@ class YUVToRGBFilterContents final : public FilterContents {
 
   void SetYUVColorSpace(YUVColorSpace yuv_color_space);
 
+  /// @brief  The matrix that converts the colors sampled from the Y and UV
+  ///         planes of an image in `yuv_color_space` to RGB.
+  static Matrix GetConversionMatrix(YUVColorSpace yuv_color_space);
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/framebuffer_blend_contents.h"
+
+#include "impeller/base/validation.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+FramebufferBlendContents::FramebufferBlendContents() = default;
+
+FramebufferBlendContents::~FramebufferBlendContents() = default;
+
+void FramebufferBlendContents::SetBlendMode(BlendMode blend_mode) {
+  if (blend_mode <= Entity::kLastPipelineBlendMode ||
+      blend_mode > Entity::kLastAdvancedBlendMode) {
+    VALIDATION_LOG << "Invalid blend mode " << static_cast<int>(blend_mode)
+                   << " assigned to FramebufferBlendContents.";
+  }
+  blend_mode_ = blend_mode;
+}
+
+void FramebufferBlendContents::SetChildContents(
+    std::shared_ptr<Contents> child_contents) {
+  child_contents_ = std::move(child_contents);
+}
+
+// |Contents|
+std::optional<Rect> FramebufferBlendContents::GetCoverage(
+    const Entity& entity) const {
+  if (!child_contents_) {
+    return std::nullopt;
+  }
+  return child_contents_->GetCoverage(entity);
+}
+
+// |Contents|
+bool FramebufferBlendContents::Render(const ContentContext& renderer,
+                                      const Entity& entity,
+                                      RenderPass& pass) const {
+  if (!renderer.GetBackendFeatures().framebuffer_fetch_support) {
+    VALIDATION_LOG << "FramebufferBlendContents requires framebuffer fetch.";
+    return false;
+  }
+  if (!child_contents_) {
+    return true;
+  }
+
+  using VS = FramebufferBlendPipeline::VertexShader;
+  using FS = FramebufferBlendPipeline::FragmentShader;
+
+  auto src_snapshot = child_contents_->RenderToSnapshot(renderer, entity);
+  if (!src_snapshot.has_value()) {
+    // Nothing to blend.
+    return true;
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  auto size = src_snapshot->texture->GetSize();
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.AddVertices({
+      {Point(0, 0), Point(0, 0)},
+      {Point(size.width, 0), Point(1, 0)},
+      {Point(size.width, size.height), Point(1, 1)},
+      {Point(0, 0), Point(0, 0)},
+      {Point(size.width, size.height), Point(1, 1)},
+      {Point(0, size.height), Point(0, 1)},
+  });
+
+  // The shader writes the blended color, so the pipeline doesn't blend.
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.blend_mode = BlendMode::kSource;
+
+  Command cmd;
+  cmd.label = "Framebuffer Advanced Blend";
+  cmd.pipeline = renderer.GetFramebufferBlendPipeline(options);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   src_snapshot->transform;
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::BlendInfo blend_info;
+  blend_info.blend_mode = static_cast<Scalar>(blend_mode_);
+  blend_info.src_input_alpha = src_snapshot->opacity;
+  blend_info.src_y_coord_scale = src_snapshot->texture->GetYCoordScale();
+  FS::BindBlendInfo(cmd, host_buffer.EmplaceUniform(blend_info));
+
+  auto src_sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+      src_snapshot->sampler_descriptor);
+  FS::BindTextureSamplerSrc(cmd, src_snapshot->texture, src_sampler);
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Draws the child contents with an advanced blend mode directly
+///             into the render pass, reading the destination with
+///             framebuffer fetch.
+///
+///             `BlendFilterContents` needs the pass texture as an input, so
+///             the pass has to end before the blend, and the result is drawn
+///             back from another texture. This is only valid if the backend
+///             supports framebuffer fetch.
+///
+class FramebufferBlendContents final : public Contents {
+ public:
+  FramebufferBlendContents();
+
+  ~FramebufferBlendContents() override;
+
+  void SetBlendMode(BlendMode blend_mode);
+
+  void SetChildContents(std::shared_ptr<Contents> child_contents);
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  BlendMode blend_mode_ = BlendMode::kScreen;
+  std::shared_ptr<Contents> child_contents_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramebufferBlendContents);
+};
+
+}  // namespace impeller
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/geometry/gradient.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/texture.h"
@@ -53,4 +54,15 @@ std::vector<StopData> CreateGradientColors(const std::vector<Color>& colors,
   return result;
 }
 
+bool ShouldUseSSBOGradient(const BackendFeatures& features,
+                           const std::vector<Scalar>& stops) {
+  if (!features.ssbo_support) {
+    return false;
+  }
+  if (ComputeGradientTextureSize(stops) > kMaxGradientTextureSize) {
+    return true;
+  }
+  return stops.size() <= kMaxSSBOGradientStops;
+}
+
 }  // namespace impeller
@@ -14,12 +14,18 @@
 #include "impeller/geometry/gradient.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/point.h"
+#include "impeller/renderer/backend_features.h"
 #include "impeller/renderer/shader_types.h"
 
 namespace impeller {
 
 class Context;
 
+// Gradients with more stops than this sample a color ramp texture even when
+// the backend supports SSBOs, since the SSBO variants of the shaders search
+// the stops for every fragment.
+static constexpr size_t kMaxSSBOGradientStops = 16u;
+
 /**
  * @brief Create a host visible texture that contains the gradient defined
  * by the provided gradient data.
@@ -44,4 +50,19 @@ struct StopData {
 std::vector<StopData> CreateGradientColors(const std::vector<Color>& colors,
                                            const std::vector<Scalar>& stops);
 
+/**
+ * @brief Whether a gradient is drawn with the SSBO variant of its shader
+ * rather than by sampling a color ramp texture.
+ *
+ * The SSBO variants are used for gradients with few stops, and for gradients
+ * with stops that are too close together for the ramp to resolve them. They
+ * are never used if the backend doesn't support SSBOs.
+ *
+ * @param features
+ * @param stops
+ * @return bool
+ */
+bool ShouldUseSSBOGradient(const BackendFeatures& features,
+                           const std::vector<Scalar>& stops);
+
 }  // namespace impeller
@@ -9,6 +9,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_cache.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
@@ -47,7 +48,7 @@ void LinearGradientContents::SetTileMode(Entity::TileMode tile_mode) {
 bool LinearGradientContents::Render(const ContentContext& renderer,
                                     const Entity& entity,
                                     RenderPass& pass) const {
-  if (renderer.GetBackendFeatures().ssbo_support) {
+  if (ShouldUseSSBOGradient(renderer.GetBackendFeatures(), stops_)) {
     return RenderSSBO(renderer, entity, pass);
   }
   return RenderTexture(renderer, entity, pass);
@@ -59,9 +60,9 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = LinearGradientFillPipeline::VertexShader;
   using FS = LinearGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      renderer.GetGradientCache()->GetOrCreateGradientTexture(
+          colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -77,7 +78,7 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
                                      0.5 / gradient_texture->GetSize().height);
 
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetFillPositionBuffer(renderer, entity, pass);
 
   VS::FrameInfo frame_info;
   frame_info.mvp = geometry_result.transform;
@@ -91,6 +92,9 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
   options.primitive_type = geometry_result.type;
   cmd.pipeline = renderer.GetLinearGradientFillPipeline(options);
@@ -147,11 +151,14 @@ bool LinearGradientContents::RenderSSBO(const ContentContext& renderer,
   cmd.stencil_reference = entity.GetStencilDepth();
 
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetFillPositionBuffer(renderer, entity, pass);
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
   options.primitive_type = geometry_result.type;
   cmd.pipeline = renderer.GetLinearGradientSSBOFillPipeline(options);
@@ -9,6 +9,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_cache.h"
 #include "impeller/entity/geometry.h"
 #include "impeller/geometry/gradient.h"
 #include "impeller/renderer/render_pass.h"
@@ -48,7 +49,7 @@ const std::vector<Scalar>& RadialGradientContents::GetStops() const {
 bool RadialGradientContents::Render(const ContentContext& renderer,
                                     const Entity& entity,
                                     RenderPass& pass) const {
-  if (renderer.GetBackendFeatures().ssbo_support) {
+  if (ShouldUseSSBOGradient(renderer.GetBackendFeatures(), stops_)) {
     return RenderSSBO(renderer, entity, pass);
   }
   return RenderTexture(renderer, entity, pass);
@@ -83,11 +84,14 @@ bool RadialGradientContents::RenderSSBO(const ContentContext& renderer,
   cmd.stencil_reference = entity.GetStencilDepth();
 
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetFillPositionBuffer(renderer, entity, pass);
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
   options.primitive_type = geometry_result.type;
   cmd.pipeline = renderer.GetRadialGradientSSBOFillPipeline(options);
@@ -116,9 +120,9 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = RadialGradientFillPipeline::VertexShader;
   using FS = RadialGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
   auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+      renderer.GetGradientCache()->GetOrCreateGradientTexture(
+          colors_, stops_, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -134,7 +138,7 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
                                      0.5 / gradient_texture->GetSize().height);
 
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetFillPositionBuffer(renderer, entity, pass);
 
   VS::FrameInfo frame_info;
   frame_info.mvp = geometry_result.transform;
@@ -148,6 +152,9 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
   options.primitive_type = geometry_result.type;
   cmd.pipeline = renderer.GetRadialGradientFillPipeline(options);
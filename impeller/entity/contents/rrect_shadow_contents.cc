@@ -21,8 +21,13 @@ RRectShadowContents::~RRectShadowContents() = default;
 
 void RRectShadowContents::SetRRect(std::optional<Rect> rect,
                                    Scalar corner_radius) {
+  SetRRect(rect, Size(corner_radius, corner_radius));
+}
+
+void RRectShadowContents::SetRRect(std::optional<Rect> rect,
+                                   Size corner_radii) {
   rect_ = rect;
-  corner_radius_ = corner_radius;
+  corner_radii_ = corner_radii;
 }
 
 void RRectShadowContents::SetSigma(Sigma sigma) {
@@ -96,9 +101,19 @@ bool RRectShadowContents::Render(const ContentContext& renderer,
   frag_info.color = color_;
   frag_info.blur_sigma = sigma_.sigma;
   frag_info.rect_size = Point(positive_rect.size);
-  frag_info.corner_radius =
-      std::min(corner_radius_, std::min(positive_rect.size.width / 2.0f,
-                                        positive_rect.size.height / 2.0f));
+  // The shader computes the shadow in a space that is scaled vertically by the
+  // aspect ratio of the corners, which makes them circular.
+  auto corner_radii = Size(std::min(corner_radii_.width,
+                                    positive_rect.size.width / 2.0f),
+                           std::min(corner_radii_.height,
+                                    positive_rect.size.height / 2.0f));
+  if (corner_radii.width > 0 && corner_radii.height > 0) {
+    frag_info.corner_radius = corner_radii.width;
+    frag_info.corner_aspect = corner_radii.width / corner_radii.height;
+  } else {
+    frag_info.corner_radius = 0;
+    frag_info.corner_aspect = 1;
+  }
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
 
   if (!pass.AddCommand(std::move(cmd))) {
@@ -26,6 +26,10 @@ class RRectShadowContents final : public Contents {
 
   void SetRRect(std::optional<Rect> rect, Scalar corner_radius = 0);
 
+  /// @brief  Sets a rounded rect with elliptical corners, such as an oval
+  ///         when the radii are half the size of the rect.
+  void SetRRect(std::optional<Rect> rect, Size corner_radii);
+
   void SetSigma(Sigma sigma);
 
   void SetColor(Color color);
@@ -40,7 +44,7 @@ class RRectShadowContents final : public Contents {
 
  private:
   std::optional<Rect> rect_;
-  Scalar corner_radius_;
+  Size corner_radii_;
   Sigma sigma_;
 
   Color color_;
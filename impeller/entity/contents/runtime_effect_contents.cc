@@ -6,6 +6,7 @@
 
 #include <future>
 #include <memory>
+#include <mutex>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
@@ -37,24 +38,22 @@ void RuntimeEffectContents::SetTextureInputs(
   texture_inputs_ = std::move(texture_inputs);
 }
 
-bool RuntimeEffectContents::Render(const ContentContext& renderer,
-                                   const Entity& entity,
-                                   RenderPass& pass) const {
-  auto context = renderer.GetContext();
-  auto library = context->GetShaderLibrary();
-
-  //--------------------------------------------------------------------------
-  /// Get or register shader.
-  ///
-
-  // TODO(113719): Register the shader function earlier.
+std::shared_ptr<const ShaderFunction>
+RuntimeEffectContents::RegisterShaderFunction(const Context& context,
+                                              RuntimeStage& runtime_stage) {
+  // Serializes the checks of the dirty flag of the stage with the
+  // registration, since stages may be registered ahead of their first use on
+  // another thread than the raster thread.
+  static std::mutex mutex;
+  std::scoped_lock lock(mutex);
 
+  auto library = context.GetShaderLibrary();
   std::shared_ptr<const ShaderFunction> function = library->GetFunction(
-      runtime_stage_->GetEntrypoint(), ShaderStage::kFragment);
+      runtime_stage.GetEntrypoint(), ShaderStage::kFragment);
 
-  if (function && runtime_stage_->IsDirty()) {
-    context->GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
-    library->UnregisterFunction(runtime_stage_->GetEntrypoint(),
+  if (function && runtime_stage.IsDirty()) {
+    context.GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
+    library->UnregisterFunction(runtime_stage.GetEntrypoint(),
                                 ShaderStage::kFragment);
 
     function = nullptr;
@@ -65,49 +64,46 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
     auto future = promise.get_future();
 
     library->RegisterFunction(
-        runtime_stage_->GetEntrypoint(),
-        ToShaderStage(runtime_stage_->GetShaderStage()),
-        runtime_stage_->GetCodeMapping(),
+        runtime_stage.GetEntrypoint(),
+        ToShaderStage(runtime_stage.GetShaderStage()),
+        runtime_stage.GetCodeMapping(),
         fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
           promise.set_value(result);
         }));
 
     if (!future.get()) {
       VALIDATION_LOG << "Failed to build runtime effect (entry point: "
-                     << runtime_stage_->GetEntrypoint() << ")";
-      return false;
+                     << runtime_stage.GetEntrypoint() << ")";
+      return nullptr;
     }
 
-    function = library->GetFunction(runtime_stage_->GetEntrypoint(),
+    function = library->GetFunction(runtime_stage.GetEntrypoint(),
                                     ShaderStage::kFragment);
     if (!function) {
       VALIDATION_LOG
           << "Failed to fetch runtime effect function immediately after "
              "registering it (entry point: "
-          << runtime_stage_->GetEntrypoint() << ")";
-      return false;
+          << runtime_stage.GetEntrypoint() << ")";
+      return nullptr;
     }
 
-    runtime_stage_->SetClean();
+    runtime_stage.SetClean();
   }
+  return function;
+}
 
-  //--------------------------------------------------------------------------
-  /// Resolve geometry.
-  ///
-
-  auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
-
-  //--------------------------------------------------------------------------
-  /// Get or create runtime stage pipeline.
-  ///
-
+PipelineDescriptor RuntimeEffectContents::MakePipelineDescriptor(
+    const Context& context,
+    const RuntimeStage& runtime_stage,
+    const ContentContextOptions& options) {
   using VS = RuntimeEffectVertexShader;
+
+  auto library = context.GetShaderLibrary();
   PipelineDescriptor desc;
   desc.SetLabel("Runtime Stage");
   desc.AddStageEntrypoint(
       library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-  desc.AddStageEntrypoint(library->GetFunction(runtime_stage_->GetEntrypoint(),
+  desc.AddStageEntrypoint(library->GetFunction(runtime_stage.GetEntrypoint(),
                                                ShaderStage::kFragment));
   auto vertex_descriptor = std::make_shared<VertexDescriptor>();
   if (!vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs)) {
@@ -118,16 +114,76 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
       0u, {.format = PixelFormat::kDefaultColor, .blending_enabled = true});
   desc.SetStencilAttachmentDescriptors({});
   desc.SetStencilPixelFormat(PixelFormat::kDefaultStencil);
+  options.ApplyToPipelineDescriptor(desc);
+  return desc;
+}
+
+bool RuntimeEffectContents::CreatePipelines(const Context& context,
+                                            RuntimeStage& runtime_stage) {
+  if (!RegisterShaderFunction(context, runtime_stage)) {
+    return false;
+  }
+
+  // Most runtime effects fill rectangles or paths with the default blend mode
+  // in passes with the color format and sample count of the context.
+  ContentContextOptions options;
+  options.sample_count = context.SupportsOffscreenMSAA()
+                             ? SampleCount::kCount4
+                             : SampleCount::kCount1;
+  options.color_attachment_pixel_format =
+      context.GetColorAttachmentPixelFormat();
+  auto pipeline_library = context.GetPipelineLibrary();
+  for (auto primitive_type :
+       {PrimitiveType::kTriangle, PrimitiveType::kTriangleStrip}) {
+    options.primitive_type = primitive_type;
+    // The pipelines are cached by the library once they are created. There
+    // is no need to wait for them here.
+    pipeline_library->GetPipeline(
+        MakePipelineDescriptor(context, runtime_stage, options));
+  }
+  return true;
+}
+
+bool RuntimeEffectContents::Render(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const {
+  auto context = renderer.GetContext();
+
+  //--------------------------------------------------------------------------
+  /// Get or register shader.
+  ///
+
+  if (!RegisterShaderFunction(*context, *runtime_stage_)) {
+    return false;
+  }
+
+  //--------------------------------------------------------------------------
+  /// Resolve geometry.
+  ///
+
+  auto geometry_result =
+      GetGeometry()->GetFillPositionBuffer(renderer, entity, pass);
+
+  //--------------------------------------------------------------------------
+  /// Get or create runtime stage pipeline.
+  ///
+
+  using VS = RuntimeEffectVertexShader;
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
   options.primitive_type = geometry_result.type;
-  options.ApplyToPipelineDescriptor(desc);
 
-  auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+  auto pipeline = context->GetPipelineLibrary()
+                      ->GetPipeline(MakePipelineDescriptor(
+                          *context, *runtime_stage_, options))
+                      .Get();
   if (!pipeline) {
     VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
     return false;
@@ -7,7 +7,10 @@
 #include <vector>
 
 #include "impeller/entity/contents/color_source_contents.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/renderer/context.h"
 #include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/shader_function.h"
 #include "impeller/runtime_stage/runtime_stage.h"
 
 namespace impeller {
@@ -19,6 +22,31 @@ class RuntimeEffectContents final : public ColorSourceContents {
     std::shared_ptr<Texture> texture;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Compiles the fragment function of |runtime_stage| and
+  ///             registers it with the shader library of |context|, unless it
+  ///             is already registered. Blocks until the function is compiled.
+  ///
+  ///             This is done the first time the stage is rendered. Calling
+  ///             it ahead of that, on any thread, keeps the compilation off
+  ///             the raster thread.
+  ///
+  /// @return     The registered function, or nullptr if it failed to compile.
+  ///
+  static std::shared_ptr<const ShaderFunction> RegisterShaderFunction(
+      const Context& context,
+      RuntimeStage& runtime_stage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the fragment function of |runtime_stage| and starts
+  ///             creating the pipelines most draws with it use, on any
+  ///             thread. Only blocks on the compilation of the function.
+  ///
+  /// @return     If the function was registered.
+  ///
+  static bool CreatePipelines(const Context& context,
+                              RuntimeStage& runtime_stage);
+
   void SetRuntimeStage(std::shared_ptr<RuntimeStage> runtime_stage);
 
   void SetUniformData(std::shared_ptr<std::vector<uint8_t>> uniform_data);
@@ -34,6 +62,11 @@ class RuntimeEffectContents final : public ColorSourceContents {
   std::shared_ptr<RuntimeStage> runtime_stage_;
   std::shared_ptr<std::vector<uint8_t>> uniform_data_;
   std::vector<TextureInput> texture_inputs_;
+
+  static PipelineDescriptor MakePipelineDescriptor(
+      const Context& context,
+      const RuntimeStage& runtime_stage,
+      const ContentContextOptions& options);
 };
 
 }  // namespace impeller
@@ -4,11 +4,13 @@
 
 #include "solid_color_contents.h"
 
+#include "impeller/base/strings.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -58,12 +60,16 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   cmd.label = "Solid Fill";
   cmd.stencil_reference = entity.GetStencilDepth();
 
-  auto geometry_result = geometry_->GetPositionBuffer(renderer, entity, pass);
+  auto geometry_result =
+      geometry_->GetFillPositionBuffer(renderer, entity, pass);
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
 
   options.primitive_type = geometry_result.type;
@@ -90,6 +96,71 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidColorContents::CanBatchWith(const Contents& other) const {
+  // Only rectangles are batched. Other geometries may need to prevent overdraw
+  // using the stencil and are more expensive to transform on the CPU.
+  auto other_contents = dynamic_cast<const SolidColorContents*>(&other);
+  return other_contents &&
+         dynamic_cast<const RectGeometry*>(geometry_.get()) &&
+         dynamic_cast<const RectGeometry*>(other_contents->geometry_.get());
+}
+
+bool SolidColorContents::RenderBatch(const ContentContext& renderer,
+                                     const std::vector<Entity>& entities,
+                                     RenderPass& pass) const {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  if (entities.empty()) {
+    return true;
+  }
+
+  // The per-entity transforms and colors are baked into the vertices so that
+  // all of the rectangles can be drawn with a single command.
+  VertexBufferBuilder<VS::PerVertexData, uint32_t> vertex_builder;
+  vertex_builder.Reserve(entities.size() * 6);
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+  for (const auto& entity : entities) {
+    auto contents =
+        static_cast<const SolidColorContents*>(entity.GetContents().get());
+    auto rect =
+        static_cast<const RectGeometry*>(contents->geometry_.get())->GetRect();
+    auto transformed_points =
+        rect.GetTransformedPoints(entity.GetTransformation());
+    auto color = contents->color_.Premultiply();
+
+    for (size_t j = 0; j < 6; j++) {
+      VS::PerVertexData data;
+      data.position = transformed_points[indices[j]];
+      data.color = color;
+      vertex_builder.AppendVertex(data);
+    }
+  }
+
+  const auto& entity = entities.front();
+
+  Command cmd;
+  cmd.label = SPrintF("Solid Fill Batch (%zu)", entities.size());
+  cmd.stencil_reference = entity.GetStencilDepth();
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetGeometryColorPipeline(options);
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::VertInfo vert_info;
+  vert_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  VS::BindVertInfo(cmd, host_buffer.EmplaceUniform(vert_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(const Path& path,
                                                              Color color) {
   auto contents = std::make_unique<SolidColorContents>();
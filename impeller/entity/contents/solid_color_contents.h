@@ -47,6 +47,14 @@ class SolidColorContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CanBatchWith(const Contents& other) const override;
+
+  // |Contents|
+  bool RenderBatch(const ContentContext& renderer,
+                   const std::vector<Entity>& entities,
+                   RenderPass& pass) const override;
+
  private:
   std::shared_ptr<Geometry> geometry_;
 
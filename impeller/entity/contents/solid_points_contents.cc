@@ -0,0 +1,190 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/solid_points_contents.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/constants.h"
+#include "impeller/geometry/path_component.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+namespace {
+
+// The triangles of a point of radius 1 around the origin.
+struct PointShape {
+  std::vector<Point> vertices;
+  std::vector<uint16_t> indices;
+};
+
+PointShape CreateUnitShape(PointStyle point_style, Scalar pixel_radius) {
+  static constexpr size_t kMinDivisions = 8u;
+  static constexpr size_t kMaxDivisions = 256u;
+
+  PointShape shape;
+  if (point_style == PointStyle::kSquare) {
+    shape.vertices = {{-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+    shape.indices = {0, 1, 2, 1, 2, 3};
+    return shape;
+  }
+
+  // The circle is split so that its edges stay within the curve tolerance
+  // of the radius it is drawn at.
+  Scalar arc_step = 2.0f * std::acos(std::clamp(
+                               1.0f - kDefaultCurveTolerance / pixel_radius,
+                               -1.0f, 1.0f));
+  size_t division_count = kMaxDivisions;
+  if (arc_step > 2.0f * kPi / kMaxDivisions) {
+    division_count = std::max(
+        static_cast<size_t>(std::ceil(2.0f * kPi / arc_step)), kMinDivisions);
+  }
+
+  shape.vertices.reserve(division_count + 1);
+  shape.vertices.push_back({0, 0});
+  for (size_t i = 0; i < division_count; i++) {
+    Scalar angle = 2.0f * kPi * i / division_count;
+    shape.vertices.push_back({std::cos(angle), std::sin(angle)});
+  }
+  shape.indices.reserve(division_count * 3);
+  for (size_t i = 0; i < division_count; i++) {
+    shape.indices.push_back(0);
+    shape.indices.push_back(1 + i);
+    shape.indices.push_back(1 + (i + 1) % division_count);
+  }
+  return shape;
+}
+
+// Copies the shape of a point around every center, for the backends that
+// cannot draw them as instances.
+template <class VertexShader, class IndexType>
+VertexBuffer CreateExpandedVertices(const std::vector<Point>& points,
+                                    Scalar radius,
+                                    const PointShape& shape,
+                                    HostBuffer& host_buffer) {
+  VertexBufferBuilder<typename VertexShader::PerVertexData, IndexType>
+      vertex_builder;
+  vertex_builder.Reserve(points.size() * shape.vertices.size());
+  vertex_builder.ReserveIndices(points.size() * shape.indices.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    for (const auto& vertex : shape.vertices) {
+      vertex_builder.AppendVertex({points[i] + vertex * radius});
+    }
+    const IndexType base = i * shape.vertices.size();
+    for (auto index : shape.indices) {
+      vertex_builder.AppendIndex(base + index);
+    }
+  }
+  return vertex_builder.CreateVertexBuffer(host_buffer);
+}
+
+}  // namespace
+
+SolidPointsContents::SolidPointsContents() = default;
+
+SolidPointsContents::~SolidPointsContents() = default;
+
+void SolidPointsContents::SetPoints(std::vector<Point> points) {
+  points_ = std::move(points);
+}
+
+void SolidPointsContents::SetRadius(Scalar radius) {
+  radius_ = radius;
+}
+
+void SolidPointsContents::SetPointStyle(PointStyle point_style) {
+  point_style_ = point_style;
+}
+
+void SolidPointsContents::SetColor(Color color) {
+  color_ = color.Premultiply();
+}
+
+std::optional<Rect> SolidPointsContents::GetCoverage(
+    const Entity& entity) const {
+  auto bounds = Rect::MakePointBounds(points_);
+  if (!bounds.has_value() || radius_ <= 0.0f) {
+    return std::nullopt;
+  }
+  return Rect::MakeLTRB(bounds->GetLeft() - radius_, bounds->GetTop() - radius_,
+                        bounds->GetRight() + radius_,
+                        bounds->GetBottom() + radius_)
+      .TransformBounds(entity.GetTransformation());
+}
+
+bool SolidPointsContents::Render(const ContentContext& renderer,
+                                 const Entity& entity,
+                                 RenderPass& pass) const {
+  if (points_.empty() || radius_ <= 0.0f) {
+    return true;
+  }
+
+  using FS = SolidFillFragmentShader;
+
+  auto shape = CreateUnitShape(
+      point_style_, radius_ * entity.GetTransformation().GetMaxBasisLength());
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+             entity.GetTransformation();
+
+  Command cmd;
+  cmd.label = "Solid Points";
+  cmd.stencil_reference = entity.GetStencilDepth();
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+
+  if (renderer.GetBackendFeatures().ssbo_support) {
+    using VS = PointsInstancedPipeline::VertexShader;
+
+    VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+    for (const auto& vertex : shape.vertices) {
+      vertex_builder.AppendVertex({vertex});
+    }
+    for (auto index : shape.indices) {
+      vertex_builder.AppendIndex(index);
+    }
+
+    cmd.pipeline = renderer.GetPointsInstancedPipeline(opts);
+    cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+    cmd.instance_count = points_.size();
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = mvp;
+    frame_info.radius = radius_;
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    VS::BindPointData(
+        cmd, host_buffer.Emplace(points_.data(), points_.size() * sizeof(Point),
+                                 alignof(Point)));
+  } else {
+    using VS = SolidFillPipeline::VertexShader;
+
+    cmd.pipeline = renderer.GetSolidFillPipeline(opts);
+    if (points_.size() * shape.vertices.size() <=
+        std::numeric_limits<uint16_t>::max()) {
+      cmd.BindVertices(CreateExpandedVertices<VS, uint16_t>(
+          points_, radius_, shape, host_buffer));
+    } else {
+      cmd.BindVertices(CreateExpandedVertices<VS, uint32_t>(
+          points_, radius_, shape, host_buffer));
+    }
+
+    VS::VertInfo vert_info;
+    vert_info.mvp = mvp;
+    VS::BindVertInfo(cmd, host_buffer.EmplaceUniform(vert_info));
+  }
+
+  FS::FragInfo frag_info;
+  frag_info.color = color_;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
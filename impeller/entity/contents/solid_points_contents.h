@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/geometry.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Fills a circle or a square of the same radius around each of
+///             many points with a solid color, in a single command.
+///
+///             On backends that support storage buffers the shape of one
+///             point is uploaded once and drawn as an instance per point.
+///             Other backends expand the shape for every point on the CPU.
+///
+class SolidPointsContents final : public Contents {
+ public:
+  SolidPointsContents();
+
+  ~SolidPointsContents() override;
+
+  void SetPoints(std::vector<Point> points);
+
+  void SetRadius(Scalar radius);
+
+  void SetPointStyle(PointStyle point_style);
+
+  void SetColor(Color color);
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  std::vector<Point> points_;
+  Scalar radius_ = 0.0f;
+  PointStyle point_style_ = PointStyle::kRound;
+  Color color_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SolidPointsContents);
+};
+
+}  // namespace impeller
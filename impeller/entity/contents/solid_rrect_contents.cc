@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/solid_rrect_contents.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+namespace {
+
+// The largest length in local coordinates of a vector that is one pixel
+// long on the render target, which is the inverse of the smallest singular
+// value of the 2D part of the transformation.
+Scalar GetLocalPixelSize(const Matrix& transformation) {
+  const Scalar a = transformation.m[0];
+  const Scalar b = transformation.m[1];
+  const Scalar c = transformation.m[4];
+  const Scalar d = transformation.m[5];
+  const Scalar sum = a * a + b * b + c * c + d * d;
+  const Scalar determinant = a * d - b * c;
+  const Scalar discriminant =
+      std::sqrt(std::max(sum * sum - 4.0f * determinant * determinant, 0.0f));
+  const Scalar min_singular_value =
+      std::sqrt(std::max((sum - discriminant) / 2.0f, 0.0f));
+  return 1.0f / min_singular_value;
+}
+
+}  // namespace
+
+SolidRRectContents::SolidRRectContents() = default;
+
+SolidRRectContents::~SolidRRectContents() = default;
+
+// static
+bool SolidRRectContents::CanRenderWithTransformation(
+    const Matrix& transformation) {
+  // The vertices have no z, so only the projection has to be affine.
+  if (transformation.m[3] != 0.0f || transformation.m[7] != 0.0f ||
+      transformation.m[15] != 1.0f) {
+    return false;
+  }
+  return std::isfinite(GetLocalPixelSize(transformation));
+}
+
+void SolidRRectContents::SetRRect(std::optional<Rect> rect,
+                                  Size corner_radii) {
+  rect_ = rect;
+  corner_radii_ = corner_radii;
+}
+
+void SolidRRectContents::SetStrokeWidth(Scalar stroke_width) {
+  stroke_width_ = stroke_width;
+}
+
+void SolidRRectContents::SetColor(Color color) {
+  color_ = color.Premultiply();
+}
+
+std::optional<Rect> SolidRRectContents::GetPaddedRect(
+    const Matrix& transformation) const {
+  if (!rect_.has_value() || !CanRenderWithTransformation(transformation)) {
+    return std::nullopt;
+  }
+  auto padding =
+      std::max(stroke_width_, 0.0f) / 2.0f + GetLocalPixelSize(transformation);
+  auto rect = rect_->GetPositive();
+  return Rect::MakeLTRB(rect.GetLeft() - padding, rect.GetTop() - padding,
+                        rect.GetRight() + padding, rect.GetBottom() + padding);
+}
+
+std::optional<Rect> SolidRRectContents::GetCoverage(
+    const Entity& entity) const {
+  auto padded_rect = GetPaddedRect(entity.GetTransformation());
+  if (!padded_rect.has_value()) {
+    return std::nullopt;
+  }
+  return padded_rect->TransformBounds(entity.GetTransformation());
+}
+
+bool SolidRRectContents::Render(const ContentContext& renderer,
+                                const Entity& entity,
+                                RenderPass& pass) const {
+  auto padded_rect = GetPaddedRect(entity.GetTransformation());
+  if (!padded_rect.has_value()) {
+    return true;
+  }
+
+  using VS = SolidRRectPipeline::VertexShader;
+  using FS = SolidRRectPipeline::FragmentShader;
+
+  // The vertices are relative to the origin of the rect, so that the
+  // fragment shader sees the same local positions as the blurred rrect.
+  auto positive_rect = rect_->GetPositive();
+  auto left = padded_rect->GetLeft() - positive_rect.GetLeft();
+  auto top = padded_rect->GetTop() - positive_rect.GetTop();
+  auto right = padded_rect->GetRight() - positive_rect.GetLeft();
+  auto bottom = padded_rect->GetBottom() - positive_rect.GetTop();
+
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.AddVertices({
+      {Point(left, top)},
+      {Point(right, top)},
+      {Point(left, bottom)},
+      {Point(left, bottom)},
+      {Point(right, top)},
+      {Point(right, bottom)},
+  });
+
+  Command cmd;
+  cmd.label = "Solid RRect";
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetSolidRRectPipeline(opts);
+  cmd.stencil_reference = entity.GetStencilDepth();
+
+  cmd.BindVertices(vtx_builder.CreateVertexBuffer(pass.GetTransientsBuffer()));
+
+  VS::VertInfo vert_info;
+  vert_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                  entity.GetTransformation() *
+                  Matrix::MakeTranslation({positive_rect.origin});
+  VS::BindVertInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(vert_info));
+
+  FS::FragInfo frag_info;
+  frag_info.color = color_;
+  frag_info.rect_size = Point(positive_rect.size);
+  frag_info.corner_radii =
+      Point(std::clamp(corner_radii_.width, 0.0f, positive_rect.size.width / 2),
+            std::clamp(corner_radii_.height, 0.0f,
+                       positive_rect.size.height / 2));
+  frag_info.stroke_width = std::max(stroke_width_, 0.0f);
+  FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
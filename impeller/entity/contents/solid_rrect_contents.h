@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Fills or strokes a rounded rect with a solid color. The edges
+///             are anti-aliased with the coverage that the distance to them
+///             gives in the fragment shader, so that the result is smooth
+///             without a multisampled render target.
+///
+///             Ovals are rounded rects whose corner radii are half of their
+///             size, and butt capped lines are rotated rects.
+///
+class SolidRRectContents final : public Contents {
+ public:
+  SolidRRectContents();
+
+  ~SolidRRectContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the distance to the edges can be computed in the
+  ///             local coordinates of an entity with this transformation,
+  ///             which holds for all the affine transformations that are not
+  ///             degenerate.
+  ///
+  static bool CanRenderWithTransformation(const Matrix& transformation);
+
+  void SetRRect(std::optional<Rect> rect, Size corner_radii = {});
+
+  /// @brief  Stroke the rounded rect instead of filling it, if the width is
+  ///         positive.
+  void SetStrokeWidth(Scalar stroke_width);
+
+  void SetColor(Color color);
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  /// The rect drawn in local coordinates, padded by half of the stroke and by
+  /// the pixel that the edges are blended over.
+  std::optional<Rect> GetPaddedRect(const Matrix& transformation) const;
+
+  std::optional<Rect> rect_;
+  Size corner_radii_;
+  Scalar stroke_width_ = 0.0f;
+  Color color_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SolidRRectContents);
+};
+
+}  // namespace impeller
@@ -46,6 +46,10 @@ std::shared_ptr<GlyphAtlas> TextContents::ResolveAtlas(
   return nullptr;
 }
 
+void TextContents::SetUsesSignedDistanceField(bool uses_sdf) {
+  uses_sdf_ = uses_sdf;
+}
+
 void TextContents::SetColor(Color color) {
   color_ = color;
 }
@@ -77,8 +81,11 @@ static bool CommonRender(
                    entity.GetTransformation();
   VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
+  const bool is_sdf =
+      atlas->GetType() == GlyphAtlas::Type::kSignedDistanceField;
+
   SamplerDescriptor sampler_desc;
-  if (entity.GetTransformation().IsTranslationScaleOnly()) {
+  if (entity.GetTransformation().IsTranslationScaleOnly() && !is_sdf) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -87,6 +94,8 @@ static bool CommonRender(
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Signed-distance fields are always interpolated, since their glyphs are
+    // scaled from a single size.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
@@ -138,10 +147,16 @@ static bool CommonRender(
 
   for (const auto& run : frame.GetRuns()) {
     auto font = run.GetFont();
+    // The glyphs of signed-distance field atlases include the margin over
+    // which the distance falls off, scaled here to the size of the run.
+    const auto sdf_spread = GlyphAtlas::kSignedDistanceFieldSpread *
+                            font.GetMetrics().point_size /
+                            GlyphAtlas::kSignedDistanceFieldPointSize;
 
     for (const auto& glyph_position : run.GetGlyphPositions()) {
       FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
-      auto atlas_glyph_pos = atlas->FindFontGlyphPosition(font_glyph_pair);
+      auto atlas_glyph_pos = atlas->FindFontGlyphPosition(
+          GlyphAtlas::GetAtlasPair(atlas->GetType(), font_glyph_pair));
       if (!atlas_glyph_pos.has_value()) {
         VALIDATION_LOG << "Could not find glyph position in the atlas.";
         return false;
@@ -150,14 +165,21 @@ static bool CommonRender(
       auto atlas_position = atlas_glyph_pos->origin;
       auto atlas_glyph_size =
           Point{atlas_glyph_pos->size.width, atlas_glyph_pos->size.height};
+      auto glyph_bounds = glyph_position.glyph.bounds;
+      if (is_sdf && !atlas_glyph_pos->size.IsEmpty()) {
+        glyph_bounds = Rect::MakeLTRB(glyph_bounds.GetLeft() - sdf_spread,
+                                      glyph_bounds.GetTop() - sdf_spread,
+                                      glyph_bounds.GetRight() + sdf_spread,
+                                      glyph_bounds.GetBottom() + sdf_spread);
+      }
       auto offset_glyph_position =
-          glyph_position.position + glyph_position.glyph.bounds.origin;
+          glyph_position.position + glyph_bounds.origin;
 
       for (const auto& point : unit_points) {
         typename VS::PerVertexData vtx;
         vtx.unit_position = point;
         vtx.destination_position = offset_glyph_position;
-        vtx.destination_size = Point(glyph_position.glyph.bounds.size);
+        vtx.destination_size = Point(glyph_bounds.size);
         vtx.source_position = atlas_position;
         vtx.source_glyph_size = atlas_glyph_size;
         if constexpr (std::is_same_v<TPipeline, GlyphAtlasPipeline>) {
@@ -182,9 +204,10 @@ static bool CommonRender(
 bool TextContents::RenderSdf(const ContentContext& renderer,
                              const Entity& entity,
                              RenderPass& pass) const {
-  auto atlas =
-      ResolveAtlas(GlyphAtlas::Type::kSignedDistanceField,
-                   renderer.GetGlyphAtlasContext(), renderer.GetContext());
+  auto atlas = ResolveAtlas(
+      GlyphAtlas::Type::kSignedDistanceField,
+      renderer.GetGlyphAtlasContext(GlyphAtlas::Type::kSignedDistanceField),
+      renderer.GetContext());
 
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Cannot render glyphs without prepared atlas.";
@@ -210,16 +233,20 @@ bool TextContents::Render(const ContentContext& renderer,
     return true;
   }
 
+  if (uses_sdf_) {
+    return RenderSdf(renderer, entity, pass);
+  }
+
   // This TextContents may be for a frame that doesn't have color, but the
   // lazy atlas for this scene already does have color.
   // Benchmarks currently show that creating two atlases per pass regresses
   // render time. This should get re-evaluated if we start caching atlases
   // between frames or get significantly faster at creating atlases, because
   // we're potentially trading memory for time here.
-  auto atlas =
-      ResolveAtlas(lazy_atlas_->HasColor() ? GlyphAtlas::Type::kColorBitmap
-                                           : GlyphAtlas::Type::kAlphaBitmap,
-                   renderer.GetGlyphAtlasContext(), renderer.GetContext());
+  auto type = lazy_atlas_->HasColor() ? GlyphAtlas::Type::kColorBitmap
+                                      : GlyphAtlas::Type::kAlphaBitmap;
+  auto atlas = ResolveAtlas(type, renderer.GetGlyphAtlasContext(type),
+                            renderer.GetContext());
 
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Cannot render glyphs without prepared atlas.";
@@ -30,6 +30,12 @@ class TextContents final : public Contents {
 
   void SetGlyphAtlas(std::shared_ptr<LazyGlyphAtlas> atlas);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the frame is rendered from the signed-distance field
+  ///             atlas, as decided by `LazyGlyphAtlas::AddTextFrame`.
+  ///
+  void SetUsesSignedDistanceField(bool uses_sdf);
+
   void SetColor(Color color);
 
   // |Contents|
@@ -40,7 +46,10 @@ class TextContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
-  // TODO(dnfield): remove this https://github.com/flutter/flutter/issues/111640
+  //----------------------------------------------------------------------------
+  /// @brief      Render the frame from the signed-distance field atlas, whose
+  ///             glyphs scale without being rendered again.
+  ///
   bool RenderSdf(const ContentContext& renderer,
                  const Entity& entity,
                  RenderPass& pass) const;
@@ -48,6 +57,7 @@ class TextContents final : public Contents {
  private:
   TextFrame frame_;
   Color color_;
+  bool uses_sdf_ = false;
   mutable std::shared_ptr<LazyGlyphAtlas> lazy_atlas_;
 
   std::shared_ptr<GlyphAtlas> ResolveAtlas(
@@ -8,10 +8,13 @@
 #include <optional>
 #include <utility>
 
+#include "impeller/base/strings.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/yuv_to_rgb_filter_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
+#include "impeller/entity/texture_yuv_fill.frag.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/formats.h"
@@ -49,6 +52,16 @@ std::shared_ptr<Texture> TextureContents::GetTexture() const {
   return texture_;
 }
 
+void TextureContents::SetUVTexture(std::shared_ptr<Texture> uv_texture,
+                                   YUVColorSpace yuv_color_space) {
+  uv_texture_ = std::move(uv_texture);
+  yuv_color_space_ = yuv_color_space;
+}
+
+std::shared_ptr<Texture> TextureContents::GetUVTexture() const {
+  return uv_texture_;
+}
+
 void TextureContents::SetOpacity(Scalar opacity) {
   opacity_ = opacity;
 }
@@ -75,8 +88,9 @@ std::optional<Snapshot> TextureContents::RenderToSnapshot(
   }
 
   // Passthrough textures that have simple rectangle paths and complete source
-  // rects.
-  if (is_rect_ && source_rect_ == Rect::MakeSize(texture_->GetSize()) &&
+  // rects. The planes of YUV images have to be converted first.
+  if (is_rect_ && !uv_texture_ &&
+      source_rect_ == Rect::MakeSize(texture_->GetSize()) &&
       (opacity_ >= 1 - kEhCloseEnough || defer_applying_opacity_)) {
     auto scale = Vector2(bounds->size / Size(texture_->GetSize()));
     return Snapshot{
@@ -123,7 +137,9 @@ bool TextureContents::Render(const ContentContext& renderer,
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
   {
     const auto tess_result = renderer.GetTessellator()->Tessellate(
-        path_.GetFillType(), path_.CreatePolyline(),
+        path_.GetFillType(),
+        path_.CreatePolyline(kDefaultCurveTolerance /
+                             entity.GetTransformation().GetMaxBasisLength()),
         [this, &vertex_builder, &coverage_rect, &texture_size](
             const float* vertices, size_t vertices_size,
             const uint16_t* indices, size_t indices_size) {
@@ -163,16 +179,122 @@ bool TextureContents::Render(const ContentContext& renderer,
   vert_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                   entity.GetTransformation();
 
+  Command cmd;
+  cmd.label = uv_texture_ ? "Texture YUV Fill" : "Texture Fill";
+  if (!label_.empty()) {
+    cmd.label += ": " + label_;
+  }
+
+  auto pipeline_options = OptionsFromPassAndEntity(pass, entity);
+  if (!stencil_enabled_) {
+    pipeline_options.stencil_compare = CompareFunction::kAlways;
+  }
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  VS::BindVertInfo(cmd, host_buffer.EmplaceUniform(vert_info));
+  auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+      sampler_descriptor_);
+
+  if (uv_texture_) {
+    using YUVFS = TextureYuvFillFragmentShader;
+
+    YUVFS::FragInfo frag_info;
+    frag_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+    frag_info.alpha = opacity_;
+    frag_info.matrix =
+        YUVToRGBFilterContents::GetConversionMatrix(yuv_color_space_);
+    frag_info.yuv_color_space = static_cast<Scalar>(yuv_color_space_);
+
+    cmd.pipeline = renderer.GetTextureYUVPipeline(pipeline_options);
+    YUVFS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    YUVFS::BindYTexture(cmd, texture_, sampler);
+    YUVFS::BindUvTexture(cmd, uv_texture_, sampler);
+    pass.AddCommand(std::move(cmd));
+    return true;
+  }
+
   FS::FragInfo frag_info;
   frag_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
   frag_info.alpha = opacity_;
 
-  Command cmd;
-  cmd.label = "Texture Fill";
-  if (!label_.empty()) {
-    cmd.label += ": " + label_;
+  cmd.pipeline = renderer.GetTexturePipeline(pipeline_options);
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  FS::BindTextureSampler(cmd, texture_, sampler);
+  pass.AddCommand(std::move(cmd));
+
+  return true;
+}
+
+bool TextureContents::CanBatchWith(const Contents& other) const {
+  // Only rectangles sampling the same texture with the same sampler and
+  // opacity are batched. The texture and sampler are bound once per command.
+  auto other_contents = dynamic_cast<const TextureContents*>(&other);
+  // YUV images are not batched.
+  return other_contents && is_rect_ && other_contents->is_rect_ &&
+         texture_ && texture_ == other_contents->texture_ && !uv_texture_ &&
+         !other_contents->uv_texture_ &&
+         sampler_descriptor_.IsEqual(other_contents->sampler_descriptor_) &&
+         opacity_ == other_contents->opacity_ &&
+         stencil_enabled_ == other_contents->stencil_enabled_;
+}
+
+bool TextureContents::RenderBatch(const ContentContext& renderer,
+                                  const std::vector<Entity>& entities,
+                                  RenderPass& pass) const {
+  using VS = TextureFillVertexShader;
+  using FS = TextureFillFragmentShader;
+
+  if (texture_ == nullptr || entities.empty()) {
+    return true;
+  }
+
+  const auto texture_size = texture_->GetSize();
+  if (texture_size.IsEmpty()) {
+    return true;
+  }
+
+  // The per-entity transforms and source rects are baked into the vertices so
+  // that all of the rectangles can be drawn with a single command.
+  VertexBufferBuilder<VS::PerVertexData, uint32_t> vertex_builder;
+  vertex_builder.Reserve(entities.size() * 6);
+  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+  for (const auto& entity : entities) {
+    auto contents =
+        static_cast<const TextureContents*>(entity.GetContents().get());
+    const auto coverage_rect = contents->path_.GetBoundingBox();
+    if (!coverage_rect.has_value() || coverage_rect->size.IsEmpty() ||
+        contents->source_rect_.IsEmpty()) {
+      continue;
+    }
+
+    auto positions =
+        coverage_rect->GetTransformedPoints(entity.GetTransformation());
+    auto source_points = contents->source_rect_.GetPoints();
+    for (size_t j = 0; j < 6; j++) {
+      VS::PerVertexData data;
+      data.position = positions[indices[j]];
+      data.texture_coords = source_points[indices[j]] / texture_size;
+      vertex_builder.AppendVertex(data);
+    }
   }
 
+  if (!vertex_builder.HasVertices()) {
+    return true;
+  }
+
+  const auto& entity = entities.front();
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  VS::VertInfo vert_info;
+  vert_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+
+  FS::FragInfo frag_info;
+  frag_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  frag_info.alpha = opacity_;
+
+  Command cmd;
+  cmd.label = SPrintF("Texture Fill Batch (%zu)", entities.size());
+
   auto pipeline_options = OptionsFromPassAndEntity(pass, entity);
   if (!stencil_enabled_) {
     pipeline_options.stencil_compare = CompareFunction::kAlways;
@@ -185,9 +307,7 @@ bool TextureContents::Render(const ContentContext& renderer,
   FS::BindTextureSampler(cmd, texture_,
                          renderer.GetContext()->GetSamplerLibrary()->GetSampler(
                              sampler_descriptor_));
-  pass.AddCommand(std::move(cmd));
-
-  return true;
+  return pass.AddCommand(std::move(cmd));
 }
 
 void TextureContents::SetSourceRect(const Rect& source_rect) {
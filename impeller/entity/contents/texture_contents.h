@@ -10,6 +10,7 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/sampler_descriptor.h"
 
@@ -36,6 +37,14 @@ class TextureContents final : public Contents {
 
   std::shared_ptr<Texture> GetTexture() const;
 
+  /// @brief  Draw a YUV image. The texture becomes the Y plane of the image,
+  ///         and the colors are converted to RGB as they are sampled, instead
+  ///         of converting the image into an offscreen texture first.
+  void SetUVTexture(std::shared_ptr<Texture> uv_texture,
+                    YUVColorSpace yuv_color_space);
+
+  std::shared_ptr<Texture> GetUVTexture() const;
+
   void SetSamplerDescriptor(SamplerDescriptor desc);
 
   const SamplerDescriptor& GetSamplerDescriptor() const;
@@ -63,6 +72,14 @@ class TextureContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CanBatchWith(const Contents& other) const override;
+
+  // |Contents|
+  bool RenderBatch(const ContentContext& renderer,
+                   const std::vector<Entity>& entities,
+                   RenderPass& pass) const override;
+
   void SetDeferApplyingOpacity(bool defer_applying_opacity);
 
  private:
@@ -73,6 +90,8 @@ class TextureContents final : public Contents {
   bool stencil_enabled_ = true;
 
   std::shared_ptr<Texture> texture_;
+  std::shared_ptr<Texture> uv_texture_;
+  YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
   SamplerDescriptor sampler_descriptor_ = {};
   Rect source_rect_;
   Scalar opacity_ = 1.0f;
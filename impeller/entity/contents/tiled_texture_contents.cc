@@ -33,6 +33,46 @@ void TiledTextureContents::SetSamplerDescriptor(SamplerDescriptor desc) {
   sampler_descriptor_ = std::move(desc);
 }
 
+static std::optional<SamplerAddressMode> TileModeToAddressMode(
+    Entity::TileMode tile_mode) {
+  switch (tile_mode) {
+    case Entity::TileMode::kClamp:
+      return SamplerAddressMode::kClampToEdge;
+    case Entity::TileMode::kRepeat:
+      return SamplerAddressMode::kRepeat;
+    case Entity::TileMode::kMirror:
+      return SamplerAddressMode::kMirror;
+    case Entity::TileMode::kDecal:
+      // Samplers can't clamp to a transparent border on every backend.
+      return std::nullopt;
+  }
+}
+
+static constexpr bool IsPowerOfTwo(int64_t size) {
+  return (size & (size - 1)) == 0;
+}
+
+std::optional<SamplerDescriptor>
+TiledTextureContents::CreateSamplerTileModeDescriptor(
+    const BackendFeatures& features) const {
+  auto width_address_mode = TileModeToAddressMode(x_tile_mode_);
+  auto height_address_mode = TileModeToAddressMode(y_tile_mode_);
+  if (!width_address_mode.has_value() || !height_address_mode.has_value()) {
+    return std::nullopt;
+  }
+  const auto size = texture_->GetSize();
+  if (!features.npot_address_mode_support &&
+      (!IsPowerOfTwo(size.width) || !IsPowerOfTwo(size.height)) &&
+      (x_tile_mode_ != Entity::TileMode::kClamp ||
+       y_tile_mode_ != Entity::TileMode::kClamp)) {
+    return std::nullopt;
+  }
+  SamplerDescriptor descriptor = sampler_descriptor_;
+  descriptor.width_address_mode = width_address_mode.value();
+  descriptor.height_address_mode = height_address_mode.value();
+  return descriptor;
+}
+
 bool TiledTextureContents::Render(const ContentContext& renderer,
                                   const Entity& entity,
                                   RenderPass& pass) const {
@@ -52,7 +92,7 @@ bool TiledTextureContents::Render(const ContentContext& renderer,
 
   auto geometry = GetGeometry();
   auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+      GetGeometry()->GetFillPositionBuffer(renderer, entity, pass);
 
   // TODO(bdero): The geometry should be fetched from GetPositionUVBuffer and
   //              contain coverage-mapped UVs, and this should use
@@ -80,16 +120,27 @@ bool TiledTextureContents::Render(const ContentContext& renderer,
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
+  } else if (geometry_result.stencil_cover) {
+    options.stencil_compare = CompareFunction::kNotEqual;
+    options.stencil_operation = StencilOperation::kSetToReferenceValue;
   }
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetTiledTexturePipeline(options);
+  // The whole texture is always tiled, so the sampler can apply the tile
+  // modes instead of the shader when it supports them.
+  auto sampler_tile_mode_descriptor =
+      CreateSamplerTileModeDescriptor(renderer.GetBackendFeatures());
+  cmd.pipeline =
+      sampler_tile_mode_descriptor.has_value()
+          ? renderer.GetTiledTextureSamplerTileModePipeline(options)
+          : renderer.GetTiledTexturePipeline(options);
 
   cmd.BindVertices(geometry_result.vertex_buffer);
   VS::BindVertInfo(cmd, host_buffer.EmplaceUniform(vert_info));
   FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
   FS::BindTextureSampler(cmd, texture_,
                          renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-                             sampler_descriptor_));
+                             sampler_tile_mode_descriptor.value_or(
+                                 sampler_descriptor_)));
 
   if (!pass.AddCommand(std::move(cmd))) {
     return false;
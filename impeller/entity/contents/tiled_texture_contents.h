@@ -6,12 +6,14 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/entity/contents/color_source_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/path.h"
+#include "impeller/renderer/backend_features.h"
 #include "impeller/renderer/sampler_descriptor.h"
 
 namespace impeller {
@@ -39,6 +41,11 @@ class TiledTextureContents final : public ColorSourceContents {
   Entity::TileMode x_tile_mode_ = Entity::TileMode::kClamp;
   Entity::TileMode y_tile_mode_ = Entity::TileMode::kClamp;
 
+  // The descriptor of a sampler that applies the tile modes, or std::nullopt
+  // if they must be emulated in the shader.
+  std::optional<SamplerDescriptor> CreateSamplerTileModeDescriptor(
+      const BackendFeatures& features) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TiledTextureContents);
 };
 
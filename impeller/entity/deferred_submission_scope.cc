@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/deferred_submission_scope.h"
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+static thread_local DeferredSubmissionScope* tCurrentScope = nullptr;
+
+DeferredSubmissionScope::DeferredSubmissionScope() : previous_(tCurrentScope) {
+  tCurrentScope = this;
+}
+
+DeferredSubmissionScope::~DeferredSubmissionScope() {
+  FML_DCHECK(tCurrentScope == this);
+  tCurrentScope = previous_;
+}
+
+bool DeferredSubmissionScope::IsActive() {
+  return tCurrentScope != nullptr;
+}
+
+bool DeferredSubmissionScope::SubmitOrDefer(
+    std::shared_ptr<CommandBuffer> command_buffer) {
+  if (!command_buffer) {
+    return false;
+  }
+  if (tCurrentScope == nullptr) {
+    return command_buffer->SubmitCommands();
+  }
+  tCurrentScope->command_buffers_.emplace_back(std::move(command_buffer));
+  return true;
+}
+
+std::vector<std::shared_ptr<CommandBuffer>>
+DeferredSubmissionScope::TakeCommandBuffers() {
+  return std::move(command_buffers_);
+}
+
+}  // namespace impeller
@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/command_buffer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the command buffers that would otherwise be submitted
+///             by the entity framework on the current thread.
+///
+///             Entity passes encoded concurrently on worker threads install a
+///             scope so that their command buffers are not submitted from the
+///             workers. The owner of the scope then submits the collected
+///             buffers, in the order they were recorded, from the thread that
+///             owns the frame. Scopes are per-thread and nest.
+///
+class DeferredSubmissionScope {
+ public:
+  DeferredSubmissionScope();
+
+  ~DeferredSubmissionScope();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a deferred submission scope is active on the calling
+  ///             thread.
+  ///
+  static bool IsActive();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit the command buffer right away or, if a scope is active
+  ///             on the calling thread, defer it to the owner of that scope.
+  ///
+  /// @param[in]  command_buffer  The command buffer with encoded commands.
+  ///
+  /// @return     If the command buffer was submitted or deferred.
+  ///
+  [[nodiscard]] static bool SubmitOrDefer(
+      std::shared_ptr<CommandBuffer> command_buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Take all command buffers recorded so far in this scope.
+  ///
+  std::vector<std::shared_ptr<CommandBuffer>> TakeCommandBuffers();
+
+ private:
+  DeferredSubmissionScope* previous_ = nullptr;
+  std::vector<std::shared_ptr<CommandBuffer>> command_buffers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DeferredSubmissionScope);
+};
+
+}  // namespace impeller
@@ -4,19 +4,25 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <variant>
 
+#include "flutter/fml/allocation_counter.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/deferred_submission_scope.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
 #include "impeller/geometry/path_builder.h"
@@ -52,6 +58,50 @@ void EntityPass::SetElements(std::vector<Element> elements) {
   elements_ = std::move(elements);
 }
 
+size_t EntityPass::GetElementCount() const {
+  return elements_.size();
+}
+
+void EntityPass::InsertElements(size_t index,
+                                std::unique_ptr<EntityPass> pass,
+                                const Matrix& xformation,
+                                size_t stencil_depth) {
+  if (!pass) {
+    return;
+  }
+  FML_DCHECK(index <= elements_.size());
+  pass->PrependTransformation(xformation, stencil_depth);
+  for (auto& element : pass->elements_) {
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->superpass_ = this;
+    }
+  }
+  reads_from_pass_texture_ += pass->reads_from_pass_texture_;
+  elements_.insert(elements_.begin() + index,
+                   std::make_move_iterator(pass->elements_.begin()),
+                   std::make_move_iterator(pass->elements_.end()));
+  pass->elements_.clear();
+}
+
+void EntityPass::PrependTransformation(const Matrix& xformation,
+                                       size_t stencil_depth) {
+  for (auto& element : elements_) {
+    if (auto entity = std::get_if<Entity>(&element)) {
+      entity->SetTransformation(xformation * entity->GetTransformation());
+      entity->IncrementStencilDepth(stencil_depth);
+      continue;
+    }
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      auto& pass = *subpass->get();
+      pass.xformation_ = xformation * pass.xformation_;
+      pass.stencil_depth_ += stencil_depth;
+      pass.PrependTransformation(xformation, stencil_depth);
+      continue;
+    }
+    FML_UNREACHABLE();
+  }
+}
+
 size_t EntityPass::GetSubpassesDepth() const {
   size_t max_subpass_depth = 0u;
   for (const auto& element : elements_) {
@@ -144,6 +194,20 @@ EntityPass* EntityPass::AddSubpass(std::unique_ptr<EntityPass> pass) {
   return subpass_pointer;
 }
 
+static bool IsBatchable(const Entity& entity) {
+  const auto& contents = entity.GetContents();
+  return contents &&
+         entity.GetBlendMode() <= Entity::kLastPipelineBlendMode &&
+         entity.GetTransformation().IsAffine() &&
+         contents->CanBatchWith(*contents);
+}
+
+static bool CanJoinBatch(const Entity& last, const Entity& entity) {
+  return last.GetBlendMode() == entity.GetBlendMode() &&
+         last.GetStencilDepth() == entity.GetStencilDepth() &&
+         entity.GetContents()->CanBatchWith(*last.GetContents());
+}
+
 static RenderTarget CreateRenderTarget(ContentContext& renderer,
                                        ISize size,
                                        bool readable) {
@@ -156,9 +220,10 @@ static RenderTarget CreateRenderTarget(ContentContext& renderer,
 
   if (context->SupportsOffscreenMSAA()) {
     return RenderTarget::CreateOffscreenMSAA(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfigMSAA{
             .storage_mode = StorageMode::kDeviceTransient,
             .resolve_storage_mode = StorageMode::kDevicePrivate,
@@ -175,9 +240,10 @@ static RenderTarget CreateRenderTarget(ContentContext& renderer,
   }
 
   return RenderTarget::CreateOffscreen(
-      *context,      // context
-      size,          // size
-      "EntityPass",  // label
+      *context,                          // context
+      *renderer.GetRenderTargetCache(),  // allocator
+      size,                              // size
+      "EntityPass",                      // label
       RenderTarget::AttachmentConfig{
           .storage_mode = StorageMode::kDevicePrivate,
           .load_action = LoadAction::kDontCare,
@@ -192,9 +258,39 @@ static RenderTarget CreateRenderTarget(ContentContext& renderer,
   );
 }
 
+/// Returns a copy of the given onscreen target that preserves the contents
+/// of its color attachment. Only the single sampled texture that is presented
+/// keeps previous frames. So multisampled targets are replaced by their
+/// resolve texture and the stencil attachment is dropped.
+static RenderTarget CreateDamageTarget(const RenderTarget& render_target) {
+  auto color0 = render_target.GetColorAttachments().find(0u)->second;
+  if (color0.resolve_texture) {
+    color0.texture = color0.resolve_texture;
+    color0.resolve_texture = nullptr;
+  }
+  color0.load_action = LoadAction::kLoad;
+  color0.store_action = StoreAction::kStore;
+
+  RenderTarget damage_target = render_target;
+  damage_target.SetColorAttachment(color0, 0u);
+  damage_target.SetStencilAttachment(std::nullopt);
+  return damage_target;
+}
+
 bool EntityPass::Render(ContentContext& renderer,
-                        const RenderTarget& render_target) const {
-  if (reads_from_pass_texture_ > 0) {
+                        const RenderTarget& render_target,
+                        std::optional<IRect> damage) const {
+  FML_TRACE_ALLOCATIONS("impeller", "EntityPass::RenderAllocations");
+  if (damage.has_value()) {
+    damage = damage->Intersection(
+        IRect::MakeSize(render_target.GetRenderTargetSize()));
+    if (!damage.has_value()) {
+      // Nothing on screen changed.
+      return true;
+    }
+  }
+
+  if (reads_from_pass_texture_ > 0 || damage.has_value()) {
     auto offscreen_target =
         CreateRenderTarget(renderer, render_target.GetRenderTargetSize(), true);
     if (!OnRender(renderer, offscreen_target.GetRenderTargetSize(),
@@ -202,16 +298,24 @@ bool EntityPass::Render(ContentContext& renderer,
       return false;
     }
 
+    // With damage, only the damaged region of the onscreen target is
+    // replaced. The rest of it still holds the previous frame.
     auto command_buffer = renderer.GetContext()->CreateCommandBuffer();
     command_buffer->SetLabel("EntityPass Root Command Buffer");
-    auto render_pass = command_buffer->CreateRenderPass(render_target);
+    auto render_pass = command_buffer->CreateRenderPass(
+        damage.has_value() ? CreateDamageTarget(render_target)
+                           : render_target);
     render_pass->SetLabel("EntityPass Root Render Pass");
 
     {
-      auto size_rect = Rect::MakeSize(offscreen_target.GetRenderTargetSize());
-      auto contents = TextureContents::MakeRect(size_rect);
+      auto blit_rect =
+          damage.has_value()
+              ? Rect::MakeXYWH(damage->origin.x, damage->origin.y,
+                               damage->size.width, damage->size.height)
+              : Rect::MakeSize(offscreen_target.GetRenderTargetSize());
+      auto contents = TextureContents::MakeRect(blit_rect);
       contents->SetTexture(offscreen_target.GetRenderTargetTexture());
-      contents->SetSourceRect(size_rect);
+      contents->SetSourceRect(blit_rect);
 
       Entity entity;
       entity.SetContents(contents);
@@ -297,92 +401,214 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       pass_context.EndPass();
     }
 
-    auto subpass_coverage =
-        GetSubpassCoverage(*subpass, Rect::MakeSize(root_pass_size));
-    if (subpass->cover_whole_screen_) {
-      subpass_coverage = Rect(
-          position, Size(pass_context.GetRenderTarget().GetRenderTargetSize()));
+    auto subpass_coverage = GetSubpassTargetCoverage(
+        *subpass, root_pass_size, position,
+        pass_context.GetRenderTarget().GetRenderTargetSize(),
+        backdrop_filter_contents);
+    if (!subpass_coverage.has_value()) {
+      return EntityPass::EntityResult::Skip();
     }
-    if (backdrop_filter_contents) {
-      auto backdrop_coverage = backdrop_filter_contents->GetCoverage(Entity{});
-      if (backdrop_coverage.has_value()) {
-        backdrop_coverage->origin += position;
 
-        if (subpass_coverage.has_value()) {
-          subpass_coverage = subpass_coverage->Union(backdrop_coverage.value());
-        } else {
-          subpass_coverage = backdrop_coverage;
-        }
+    return RenderSubpass(*subpass, renderer, root_pass_size,
+                         subpass_coverage.value(), position, pass_depth + 1,
+                         std::move(backdrop_filter_contents));
+  } else {
+    FML_UNREACHABLE();
+  }
+
+  return EntityPass::EntityResult::Success(element_entity);
+}
+
+std::optional<Rect> EntityPass::GetSubpassTargetCoverage(
+    const EntityPass& subpass,
+    ISize root_pass_size,
+    Point position,
+    ISize target_size,
+    const std::shared_ptr<Contents>& backdrop_filter_contents) const {
+  auto subpass_coverage =
+      GetSubpassCoverage(subpass, Rect::MakeSize(root_pass_size));
+  if (subpass.cover_whole_screen_) {
+    subpass_coverage = Rect(position, Size(target_size));
+  }
+  if (backdrop_filter_contents) {
+    auto backdrop_coverage = backdrop_filter_contents->GetCoverage(Entity{});
+    if (backdrop_coverage.has_value()) {
+      backdrop_coverage->origin += position;
+
+      if (subpass_coverage.has_value()) {
+        subpass_coverage = subpass_coverage->Union(backdrop_coverage.value());
+      } else {
+        subpass_coverage = backdrop_coverage;
       }
     }
+  }
 
-    if (subpass_coverage.has_value()) {
-      subpass_coverage =
-          subpass_coverage->Intersection(Rect::MakeSize(root_pass_size));
-    }
+  if (subpass_coverage.has_value()) {
+    subpass_coverage =
+        subpass_coverage->Intersection(Rect::MakeSize(root_pass_size));
+  }
 
-    if (!subpass_coverage.has_value()) {
-      return EntityPass::EntityResult::Skip();
-    }
+  if (!subpass_coverage.has_value()) {
+    return std::nullopt;
+  }
 
-    if (subpass_coverage->size.IsEmpty()) {
-      // It is not an error to have an empty subpass. But subpasses that can't
-      // create their intermediates must trip errors.
-      return EntityPass::EntityResult::Skip();
-    }
+  if (subpass_coverage->size.IsEmpty()) {
+    // It is not an error to have an empty subpass. But subpasses that can't
+    // create their intermediates must trip errors.
+    return std::nullopt;
+  }
 
-    auto subpass_target =
-        CreateRenderTarget(renderer,                       //
-                           ISize(subpass_coverage->size),  //
-                           subpass->reads_from_pass_texture_ > 0);
+  return subpass_coverage;
+}
 
-    auto subpass_texture = subpass_target.GetRenderTargetTexture();
+EntityPass::EntityResult EntityPass::RenderSubpass(
+    const EntityPass& subpass,
+    ContentContext& renderer,
+    ISize root_pass_size,
+    Rect subpass_coverage,
+    Point position,
+    uint32_t pass_depth,
+    std::shared_ptr<Contents> backdrop_filter_contents) const {
+  auto subpass_target =
+      CreateRenderTarget(renderer,                      //
+                         ISize(subpass_coverage.size),  //
+                         subpass.reads_from_pass_texture_ > 0);
 
-    if (!subpass_texture) {
-      return EntityPass::EntityResult::Failure();
-    }
+  auto subpass_texture = subpass_target.GetRenderTargetTexture();
 
-    auto offscreen_texture_contents =
-        subpass->delegate_->CreateContentsForSubpassTarget(
-            subpass_texture, subpass->xformation_);
+  if (!subpass_texture) {
+    return EntityPass::EntityResult::Failure();
+  }
 
-    if (!offscreen_texture_contents) {
-      // This is an error because the subpass delegate said the pass couldn't
-      // be collapsed into its parent. Yet, when asked how it want's to
-      // postprocess the offscreen texture, it couldn't give us an answer.
-      //
-      // Theoretically, we could collapse the pass now. But that would be
-      // wasteful as we already have the offscreen texture and we don't want
-      // to discard it without ever using it. Just make the delegate do the
-      // right thing.
-      return EntityPass::EntityResult::Failure();
-    }
+  auto offscreen_texture_contents =
+      subpass.delegate_->CreateContentsForSubpassTarget(subpass_texture,
+                                                        subpass.xformation_);
+
+  if (!offscreen_texture_contents) {
+    // This is an error because the subpass delegate said the pass couldn't
+    // be collapsed into its parent. Yet, when asked how it want's to
+    // postprocess the offscreen texture, it couldn't give us an answer.
+    //
+    // Theoretically, we could collapse the pass now. But that would be
+    // wasteful as we already have the offscreen texture and we don't want
+    // to discard it without ever using it. Just make the delegate do the
+    // right thing.
+    return EntityPass::EntityResult::Failure();
+  }
+
+  // Stencil textures aren't shared between EntityPasses (as much of the
+  // time they are transient).
+  if (!subpass.OnRender(renderer, root_pass_size, subpass_target,
+                        subpass_coverage.origin, position, pass_depth,
+                        subpass.stencil_depth_, backdrop_filter_contents)) {
+    return EntityPass::EntityResult::Failure();
+  }
+
+  Entity element_entity;
+  element_entity.SetContents(std::move(offscreen_texture_contents));
+  element_entity.SetStencilDepth(subpass.stencil_depth_);
+  element_entity.SetBlendMode(subpass.blend_mode_);
+  element_entity.SetTransformation(
+      Matrix::MakeTranslation(Vector3(subpass_coverage.origin - position)));
+  return EntityPass::EntityResult::Success(element_entity);
+}
+
+EntityPass::SubpassResults EntityPass::RenderSubpassesConcurrently(
+    ContentContext& renderer,
+    ISize root_pass_size,
+    ISize target_size,
+    Point position,
+    uint32_t pass_depth) const {
+  TRACE_EVENT0("impeller", "EntityPass::RenderSubpassesConcurrently");
+
+  struct SubpassJob {
+    const EntityPass* subpass = nullptr;
+    Rect coverage;
+    EntityResult result;
+    std::vector<std::shared_ptr<CommandBuffer>> command_buffers;
+  };
 
-    // Stencil textures aren't shared between EntityPasses (as much of the
-    // time they are transient).
-    if (!subpass->OnRender(renderer, root_pass_size, subpass_target,
-                           subpass_coverage->origin, position, ++pass_depth,
-                           subpass->stencil_depth_, backdrop_filter_contents)) {
-      return EntityPass::EntityResult::Failure();
+  // Subpasses that render into their own targets and that don't read from
+  // this pass only depend on their own contents. Those are encoded on the
+  // work queue.
+  std::vector<SubpassJob> jobs;
+  for (const auto& element : elements_) {
+    auto subpass_ptr = std::get_if<std::unique_ptr<EntityPass>>(&element);
+    if (!subpass_ptr) {
+      continue;
+    }
+    const auto& subpass = *subpass_ptr->get();
+    if (subpass.delegate_->CanElide() ||
+        subpass.backdrop_filter_proc_.has_value() ||
+        subpass.delegate_->CanCollapseIntoParentPass()) {
+      continue;
+    }
+    auto coverage = GetSubpassTargetCoverage(subpass, root_pass_size, position,
+                                             target_size, nullptr);
+    if (!coverage.has_value()) {
+      continue;
     }
+    jobs.push_back(SubpassJob{.subpass = &subpass, .coverage = *coverage});
+  }
 
-    element_entity.SetContents(std::move(offscreen_texture_contents));
-    element_entity.SetStencilDepth(subpass->stencil_depth_);
-    element_entity.SetBlendMode(subpass->blend_mode_);
-    element_entity.SetTransformation(
-        Matrix::MakeTranslation(Vector3(subpass_coverage->origin - position)));
-  } else {
-    FML_UNREACHABLE();
+  SubpassResults results;
+  if (jobs.size() < 2u) {
+    // Not worth the dispatch, render these inline.
+    return results;
   }
 
-  return EntityPass::EntityResult::Success(element_entity);
+  auto work_queue = renderer.GetContext()->GetWorkQueue();
+  fml::CountDownLatch latch(jobs.size());
+  for (auto& job : jobs) {
+    work_queue->PostTask([this, job = &job, &renderer, &latch, root_pass_size,
+                          position, pass_depth]() {
+      {
+        // The jobs run at the same time, so each one writes its transient
+        // data into a buffer of its own.
+        ContentContext::WorkerTransientsScope transients_scope(renderer);
+        DeferredSubmissionScope scope;
+        job->result = RenderSubpass(*job->subpass, renderer, root_pass_size,
+                                    job->coverage, position, pass_depth + 1,
+                                    nullptr);
+        job->command_buffers = scope.TakeCommandBuffers();
+      }
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+
+  // Submit in element order from this thread. Each job recorded its command
+  // buffers in dependency order already.
+  for (auto& job : jobs) {
+    for (auto& command_buffer : job.command_buffers) {
+      if (!DeferredSubmissionScope::SubmitOrDefer(std::move(command_buffer))) {
+        job.result = EntityResult::Failure();
+      }
+    }
+    results[job.subpass] = job.result;
+  }
+  return results;
 }
 
 struct StencilLayer {
   std::optional<Rect> coverage;
   size_t stencil_depth;
+  // The intersection of the clips up to this layer that are applied with a
+  // scissor rather than the stencil, and how many of them there are.
+  std::optional<Rect> scissor;
+  size_t scissor_depth = 0;
 };
 
+static std::optional<IRect> ToScissor(const std::optional<Rect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  auto ltrb = rect->GetLTRB();
+  return IRect::MakeLTRB(
+      static_cast<IRect::Type>(ltrb[0]), static_cast<IRect::Type>(ltrb[1]),
+      static_cast<IRect::Type>(ltrb[2]), static_cast<IRect::Type>(ltrb[3]));
+}
+
 bool EntityPass::OnRender(
     ContentContext& renderer,
     ISize root_pass_size,
@@ -396,7 +622,8 @@ bool EntityPass::OnRender(
 
   auto context = renderer.GetContext();
   InlinePassContext pass_context(context, render_target,
-                                 reads_from_pass_texture_);
+                                 reads_from_pass_texture_,
+                                 renderer.GetTransientsBuffer());
   if (!pass_context.IsValid()) {
     return false;
   }
@@ -405,8 +632,40 @@ bool EntityPass::OnRender(
       .coverage = Rect::MakeSize(render_target.GetRenderTargetSize()),
       .stencil_depth = stencil_depth_floor}};
 
+  // Consecutive entities whose contents can be drawn together are collected
+  // here and rendered with a single command once a non-batchable element is
+  // encountered. Primitives within a draw are rasterized in order. So
+  // overlapping entities in a batch blend the same way they would separately.
+  std::vector<Entity> batch;
+  RenderPass* batch_pass = nullptr;
+  auto flush_batch = [&batch, &batch_pass, &renderer]() {
+    if (batch.empty()) {
+      return true;
+    }
+    bool success =
+        batch.size() == 1
+            ? batch.front().Render(renderer, *batch_pass)
+            : batch.front().GetContents()->RenderBatch(renderer, batch,
+                                                       *batch_pass);
+    batch.clear();
+    batch_pass = nullptr;
+    return success;
+  };
+
+  // Collapsed subpasses render into the same target with a stack of their
+  // own, which wouldn't account for the stencil depths that clips applied as
+  // scissors leave out. So their parents clip through the stencil only.
+  bool use_scissor_clips =
+      std::none_of(elements_.begin(), elements_.end(), [](const auto& element) {
+        auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element);
+        return subpass && (*subpass)->delegate_->CanCollapseIntoParentPass() &&
+               !(*subpass)->backdrop_filter_proc_.has_value();
+      });
+
   auto render_element = [&stencil_depth_floor, &pass_context, &pass_depth,
-                         &renderer, &stencil_stack](Entity& element_entity) {
+                         &renderer, &stencil_stack, &batch, &batch_pass,
+                         &flush_batch,
+                         use_scissor_clips](Entity& element_entity) {
     auto result = pass_context.GetRenderPass(pass_depth);
 
     if (!result.pass) {
@@ -438,21 +697,44 @@ bool EntityPass::OnRender(
 
     auto stencil_coverage =
         element_entity.GetStencilCoverage(stencil_stack.back().coverage);
+    // The recorded stencil depths count the clips that are applied with a
+    // scissor, which never touch the stencil.
+    auto scissor_depth = stencil_stack.back().scissor_depth;
 
     switch (stencil_coverage.type) {
       case Contents::StencilCoverage::Type::kNone:
         break;
       case Contents::StencilCoverage::Type::kAppend: {
         auto op = stencil_stack.back().coverage;
+        auto layer_scissor = stencil_stack.back().scissor;
+        std::optional<Rect> clip_scissor;
+        if (use_scissor_clips) {
+          clip_scissor = static_cast<const ClipContents*>(
+                             element_entity.GetContents().get())
+                             ->GetScissorRect(element_entity);
+        }
+        if (clip_scissor.has_value()) {
+          layer_scissor = layer_scissor.has_value()
+                              ? layer_scissor->Intersection(*clip_scissor)
+                                    .value_or(Rect{})
+                              : clip_scissor;
+        }
         stencil_stack.push_back(StencilLayer{
             .coverage = stencil_coverage.coverage,
-            .stencil_depth = element_entity.GetStencilDepth() + 1});
+            .stencil_depth = element_entity.GetStencilDepth() + 1,
+            .scissor = layer_scissor,
+            .scissor_depth = scissor_depth + (clip_scissor.has_value() ? 1 : 0),
+        });
 
         if (!op.has_value()) {
           // Running this append op won't impact the stencil because the whole
           // screen is already being clipped, so skip it.
           return true;
         }
+        if (clip_scissor.has_value()) {
+          // The scissor applies the clip to the elements that follow.
+          return true;
+        }
       } break;
       case Contents::StencilCoverage::Type::kRestore: {
         if (stencil_stack.back().stencil_depth <=
@@ -472,13 +754,23 @@ bool EntityPass::OnRender(
                 ? stencil_stack[restoration_depth + 1].coverage
                 : std::nullopt;
 
+        auto restored_layers = stencil_stack.size() - (restoration_depth + 1);
+        auto restored_scissors =
+            stencil_stack.back().scissor_depth -
+            stencil_stack[restoration_depth].scissor_depth;
         stencil_stack.resize(restoration_depth + 1);
+        scissor_depth = stencil_stack.back().scissor_depth;
 
         if (!stencil_stack.back().coverage.has_value()) {
           // Running this restore op won't make anything renderable, so skip it.
           return true;
         }
 
+        if (restored_layers == restored_scissors) {
+          // Only scissors are restored, which leaves the stencil as it is.
+          return true;
+        }
+
         auto restore_contents = static_cast<ClipRestoreContents*>(
             element_entity.GetContents().get());
         restore_contents->SetRestoreCoverage(restore_coverage);
@@ -487,7 +779,33 @@ bool EntityPass::OnRender(
     }
 
     element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
-                                   stencil_depth_floor);
+                                   stencil_depth_floor - scissor_depth);
+
+    auto scissor = ToScissor(stencil_stack.back().scissor);
+    if (!(result.pass->GetScissor() == scissor)) {
+      // Batched entities are drawn with the scissor they were collected with.
+      if (!flush_batch()) {
+        return false;
+      }
+      result.pass->SetScissor(scissor);
+    }
+
+    if (stencil_coverage.type == Contents::StencilCoverage::Type::kNone &&
+        IsBatchable(element_entity)) {
+      if (!batch.empty() &&
+          (batch_pass != result.pass.get() ||
+           !CanJoinBatch(batch.back(), element_entity)) &&
+          !flush_batch()) {
+        return false;
+      }
+      batch.push_back(element_entity);
+      batch_pass = result.pass.get();
+      return true;
+    }
+
+    if (!flush_batch()) {
+      return false;
+    }
     if (!element_entity.Render(renderer, *result.pass)) {
       return false;
     }
@@ -508,10 +826,33 @@ bool EntityPass::OnRender(
     render_element(backdrop_entity);
   }
 
+  // Independent subpasses are rendered up front, on worker threads when
+  // enabled. Encoding is never fanned out again from a worker.
+  SubpassResults prerendered_subpasses;
+  if (renderer.IsParallelSubpassEncodingEnabled() &&
+      !DeferredSubmissionScope::IsActive()) {
+    prerendered_subpasses = RenderSubpassesConcurrently(
+        renderer, root_pass_size, render_target.GetRenderTargetSize(),
+        position, pass_depth);
+  }
+
   for (const auto& element : elements_) {
-    EntityResult result =
-        GetEntityForElement(element, renderer, pass_context, root_pass_size,
-                            position, pass_depth, stencil_depth_floor);
+    EntityResult result;
+    auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element);
+    if (auto found = subpass ? prerendered_subpasses.find(subpass->get())
+                             : prerendered_subpasses.end();
+        found != prerendered_subpasses.end()) {
+      result = found->second;
+    } else {
+      // Collapsed subpasses render directly into the current pass, and
+      // backdrop filters end it. So pending batches must land first.
+      if (subpass && !flush_batch()) {
+        return false;
+      }
+      result =
+          GetEntityForElement(element, renderer, pass_context, root_pass_size,
+                              position, pass_depth, stencil_depth_floor);
+    }
 
     switch (result.status) {
       case EntityResult::kSuccess:
@@ -526,7 +867,17 @@ bool EntityPass::OnRender(
     /// Setup advanced blends.
     ///
 
-    if (result.entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
+    if (result.entity.GetBlendMode() > Entity::kLastPipelineBlendMode &&
+        renderer.GetBackendFeatures().framebuffer_fetch_support) {
+      // The blend reads the destination from the color attachment. So the
+      // entity is drawn into the active pass, in order with the commands
+      // before it.
+      auto contents = std::make_shared<FramebufferBlendContents>();
+      contents->SetBlendMode(result.entity.GetBlendMode());
+      contents->SetChildContents(result.entity.GetContents());
+      result.entity.SetContents(std::move(contents));
+      result.entity.SetBlendMode(BlendMode::kSource);
+    } else if (result.entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
       // End the active pass and flush the buffer before rendering "advanced"
       // blends. Advanced blends work by binding the current render target
       // texture as an input ("destination"), blending with a second texture
@@ -536,7 +887,7 @@ bool EntityPass::OnRender(
       // to the render target texture so far need to execute before it's bound
       // for blending (otherwise the blend pass will end up executing before
       // all the previous commands in the active pass).
-      if (!pass_context.EndPass()) {
+      if (!flush_batch() || !pass_context.EndPass()) {
         return false;
       }
 
@@ -567,7 +918,7 @@ bool EntityPass::OnRender(
     }
   }
 
-  return true;
+  return flush_batch();
 }
 
 void EntityPass::IterateAllEntities(
@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -43,14 +44,41 @@ class EntityPass {
 
   void SetElements(std::vector<Element> elements);
 
+  size_t GetElementCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Move the elements of a pass that was recorded separately into
+  ///             this pass, before the element at the given index.
+  ///
+  /// @param[in]  index          The position of the elements in this pass.
+  /// @param[in]  pass           The pass whose elements are moved.
+  /// @param[in]  xformation     The transformation that is prepended to the
+  ///                            elements of the pass.
+  /// @param[in]  stencil_depth  The stencil depth that is added to the
+  ///                            elements of the pass.
+  ///
+  void InsertElements(size_t index,
+                      std::unique_ptr<EntityPass> pass,
+                      const Matrix& xformation,
+                      size_t stencil_depth);
+
   const std::shared_ptr<LazyGlyphAtlas>& GetLazyGlyphAtlas() const;
 
   EntityPass* AddSubpass(std::unique_ptr<EntityPass> pass);
 
   EntityPass* GetSuperpass() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Render the pass to the given target.
+  ///
+  /// @param[in]  damage  If set, only this region of the target is updated.
+  ///                     The rest of the target is left as it was. This is
+  ///                     used for partial repaint of onscreen surfaces that
+  ///                     keep their previous contents.
+  ///
   bool Render(ContentContext& renderer,
-              const RenderTarget& render_target) const;
+              const RenderTarget& render_target,
+              std::optional<IRect> damage = std::nullopt) const;
 
   void IterateAllEntities(const std::function<bool(Entity&)>& iterator);
 
@@ -93,6 +121,39 @@ class EntityPass {
     static EntityResult Skip() { return {{}, kSkip}; }
   };
 
+  using SubpassResults = std::unordered_map<const EntityPass*, EntityResult>;
+
+  std::optional<Rect> GetSubpassTargetCoverage(
+      const EntityPass& subpass,
+      ISize root_pass_size,
+      Point position,
+      ISize target_size,
+      const std::shared_ptr<Contents>& backdrop_filter_contents) const;
+
+  EntityResult RenderSubpass(
+      const EntityPass& subpass,
+      ContentContext& renderer,
+      ISize root_pass_size,
+      Rect subpass_coverage,
+      Point position,
+      uint32_t pass_depth,
+      std::shared_ptr<Contents> backdrop_filter_contents) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render the subpasses of this pass that don't depend on this
+  ///             pass' render target concurrently on the context's work queue.
+  ///             Their command buffers are submitted in element order from the
+  ///             calling thread.
+  ///
+  /// @return     The resolved entities of all subpasses that were rendered.
+  ///             Subpasses missing from the results must be rendered inline.
+  ///
+  SubpassResults RenderSubpassesConcurrently(ContentContext& renderer,
+                                             ISize root_pass_size,
+                                             ISize target_size,
+                                             Point position,
+                                             uint32_t pass_depth) const;
+
   EntityResult GetEntityForElement(const EntityPass::Element& element,
                                    ContentContext& renderer,
                                    InlinePassContext& pass_context,
@@ -111,6 +172,8 @@ class EntityPass {
       size_t stencil_depth_floor = 0,
       std::shared_ptr<Contents> backdrop_filter_contents = nullptr) const;
 
+  void PrependTransformation(const Matrix& xformation, size_t stencil_depth);
+
   std::vector<Element> elements_;
 
   EntityPass* superpass_ = nullptr;
@@ -3,14 +3,17 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "flutter/testing/testing.h"
 #include "fml/logging.h"
+#include "fml/synchronization/waitable_event.h"
 #include "fml/time/time_point.h"
 #include "gtest/gtest.h"
 #include "impeller/entity/contents/atlas_contents.h"
@@ -18,15 +21,21 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/rrect_shadow_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/solid_points_contents.h"
+#include "impeller/entity/contents/solid_rrect_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
+#include "impeller/entity/deferred_submission_scope.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/entity_pass_delegate.h"
@@ -38,7 +47,12 @@
 #include "impeller/geometry/sigma.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/widgets.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/host_buffer.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 #include "impeller/runtime_stage/runtime_stage.h"
 #include "impeller/tessellator/tessellator.h"
@@ -87,11 +101,13 @@ class TestPassDelegate final : public EntityPassDelegate {
   const std::optional<Rect> coverage_;
 };
 
-auto CreatePassWithRectPath(Rect rect, std::optional<Rect> bounds_hint) {
+auto CreatePassWithRectPath(Rect rect,
+                            std::optional<Rect> bounds_hint,
+                            Color color = Color::Red()) {
   auto subpass = std::make_unique<EntityPass>();
   Entity entity;
-  entity.SetContents(SolidColorContents::Make(
-      PathBuilder{}.AddRect(rect).TakePath(), Color::Red()));
+  entity.SetContents(
+      SolidColorContents::Make(PathBuilder{}.AddRect(rect).TakePath(), color));
   subpass->AddEntity(entity);
   subpass->SetDelegate(std::make_unique<TestPassDelegate>(bounds_hint));
   return subpass;
@@ -154,6 +170,293 @@ TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   }
 }
 
+TEST_P(EntityTest, DeferredSubmissionScopeCollectsCommandBuffers) {
+  auto context = GetContext();
+  ASSERT_FALSE(DeferredSubmissionScope::IsActive());
+  {
+    DeferredSubmissionScope outer;
+    ASSERT_TRUE(DeferredSubmissionScope::IsActive());
+    ASSERT_TRUE(
+        DeferredSubmissionScope::SubmitOrDefer(context->CreateCommandBuffer()));
+    {
+      DeferredSubmissionScope inner;
+      ASSERT_TRUE(DeferredSubmissionScope::SubmitOrDefer(
+          context->CreateCommandBuffer()));
+      ASSERT_EQ(inner.TakeCommandBuffers().size(), 1u);
+    }
+    ASSERT_TRUE(DeferredSubmissionScope::IsActive());
+    ASSERT_EQ(outer.TakeCommandBuffers().size(), 1u);
+    ASSERT_TRUE(outer.TakeCommandBuffers().empty());
+  }
+  ASSERT_FALSE(DeferredSubmissionScope::IsActive());
+  ASSERT_FALSE(DeferredSubmissionScope::SubmitOrDefer(nullptr));
+}
+
+// Reads back the pixels of a texture with four bytes per pixel.
+static std::optional<std::vector<uint8_t>> ReadBackTexture(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Texture>& texture) {
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size = texture->GetSize().Area() * 4u;
+  auto buffer = context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!buffer || !command_buffer) {
+    return std::nullopt;
+  }
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass || !blit_pass->AddCopy(texture, buffer) ||
+      !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return std::nullopt;
+  }
+
+  fml::AutoResetWaitableEvent latch;
+  bool completed = false;
+  if (!command_buffer->SubmitCommands(
+          [&latch, &completed](CommandBuffer::Status status) {
+            completed = status == CommandBuffer::Status::kCompleted;
+            latch.Signal();
+          })) {
+    return std::nullopt;
+  }
+  latch.Wait();
+  if (!completed) {
+    return std::nullopt;
+  }
+  auto contents = buffer->AsBufferView().contents;
+  return std::vector<uint8_t>(contents, contents + buffer_desc.size);
+}
+
+// Renders overlapping subpasses of distinct colors into a new target and
+// reads the pixels back.
+static std::optional<std::vector<uint8_t>> RenderSubpassesAndReadBack(
+    const std::shared_ptr<Context>& context,
+    bool parallel_subpass_encoding) {
+  ContentContext renderer(context);
+  if (!renderer.IsValid()) {
+    return std::nullopt;
+  }
+  renderer.SetParallelSubpassEncodingEnabled(parallel_subpass_encoding);
+
+  // Enough subpasses for the jobs to run at the same time on the work queue.
+  constexpr size_t kSubpassCount = 32u;
+  EntityPass pass;
+  for (size_t i = 0; i < kSubpassCount; i++) {
+    auto offset = static_cast<Scalar>(i * 10u);
+    auto color = Color(static_cast<Scalar>(i % 4u) / 3.0f,
+                       static_cast<Scalar>(i % 8u) / 7.0f,
+                       static_cast<Scalar>(i) / kSubpassCount, 1.0f);
+    pass.AddSubpass(CreatePassWithRectPath(
+        Rect::MakeXYWH(offset, offset, 64, 64), std::nullopt, color));
+  }
+
+  constexpr ISize kSize = {400, 400};
+  auto render_target = RenderTarget::CreateOffscreen(*context, kSize);
+  if (!render_target.IsValid() || !pass.Render(renderer, render_target)) {
+    return std::nullopt;
+  }
+  if (parallel_subpass_encoding &&
+      renderer.GetAllTransientsBuffers().size() < 2u) {
+    // The subpasses were not encoded on the workers.
+    return std::nullopt;
+  }
+  return ReadBackTexture(context, render_target.GetRenderTargetTexture());
+}
+
+// Run under TSan to check that the subpass jobs don't race on the content
+// context.
+TEST_P(EntityTest, ConcurrentlyRenderedSubpassesMatchSerialRendering) {
+  auto serial = RenderSubpassesAndReadBack(GetContext(), false);
+  ASSERT_TRUE(serial.has_value());
+  auto concurrent = RenderSubpassesAndReadBack(GetContext(), true);
+  ASSERT_TRUE(concurrent.has_value());
+  ASSERT_FALSE(DeferredSubmissionScope::IsActive());
+
+  ASSERT_EQ(serial->size(), concurrent->size());
+  ASSERT_TRUE(std::any_of(serial->begin(), serial->end(),
+                          [](uint8_t value) { return value != 0u; }));
+  ASSERT_TRUE(*serial == *concurrent);
+}
+
+TEST_P(EntityTest, WorkerTransientsScopesUseTheirOwnBuffers) {
+  ContentContext renderer(GetContext());
+  ASSERT_TRUE(renderer.IsValid());
+  auto main_buffer = renderer.GetTransientsBuffer();
+  ASSERT_EQ(renderer.GetAllTransientsBuffers().size(), 1u);
+
+  std::shared_ptr<HostBuffer> worker_buffer;
+  std::shared_ptr<HostBuffer> other_worker_buffer;
+  {
+    ContentContext::WorkerTransientsScope scope(renderer);
+    worker_buffer = renderer.GetTransientsBuffer();
+    ASSERT_NE(worker_buffer, main_buffer);
+
+    // A scope on another thread doesn't share the buffer in use.
+    std::thread thread([&renderer, &other_worker_buffer, &main_buffer]() {
+      ASSERT_EQ(renderer.GetTransientsBuffer(), main_buffer);
+      ContentContext::WorkerTransientsScope scope(renderer);
+      other_worker_buffer = renderer.GetTransientsBuffer();
+    });
+    thread.join();
+    ASSERT_NE(other_worker_buffer, worker_buffer);
+    ASSERT_NE(other_worker_buffer, main_buffer);
+  }
+  ASSERT_EQ(renderer.GetTransientsBuffer(), main_buffer);
+  ASSERT_EQ(renderer.GetAllTransientsBuffers().size(), 3u);
+
+  // Released buffers are reused instead of growing the pool.
+  {
+    ContentContext::WorkerTransientsScope scope(renderer);
+    auto buffer = renderer.GetTransientsBuffer();
+    ASSERT_TRUE(buffer == worker_buffer || buffer == other_worker_buffer);
+  }
+  ASSERT_EQ(renderer.GetAllTransientsBuffers().size(), 3u);
+}
+
+TEST(PipelineVariantKeyTest, SerializationRoundTrips) {
+  ContentContextOptions opts;
+  opts.sample_count = SampleCount::kCount4;
+  opts.blend_mode = BlendMode::kPlus;
+  opts.stencil_operation = StencilOperation::kIncrementClamp;
+  opts.primitive_type = PrimitiveType::kTriangleStrip;
+  opts.has_stencil_attachment = false;
+  std::vector<PipelineVariantKey> keys = {{"SolidFill", {}},
+                                          {"Texture", opts}};
+
+  auto result = PipelineVariantKey::Deserialize(
+      PipelineVariantKey::Serialize(keys) + "Malformed 1 2\n");
+  ASSERT_EQ(result.size(), 2u);
+  ASSERT_EQ(result[0].pipeline, "SolidFill");
+  ASSERT_TRUE(ContentContextOptions::Equal{}(result[0].options, {}));
+  ASSERT_EQ(result[1].pipeline, "Texture");
+  ASSERT_TRUE(ContentContextOptions::Equal{}(result[1].options, opts));
+
+  // Recordings without a header are from an incompatible version.
+  ASSERT_TRUE(PipelineVariantKey::Deserialize("SolidFill 1 3 3 0 0 6 1\n")
+                  .empty());
+}
+
+TEST_P(EntityTest, ContentContextRecordsAndPrewarmsVariants) {
+  ContentContext renderer(GetContext());
+  ASSERT_TRUE(renderer.IsValid());
+  ASSERT_TRUE(renderer.GetUsedPipelineVariants().empty());
+
+  ContentContextOptions opts;
+  opts.blend_mode = BlendMode::kSource;
+  ASSERT_NE(renderer.GetSolidFillPipeline(opts), nullptr);
+  ASSERT_NE(renderer.GetSolidFillPipeline(opts), nullptr);
+
+  auto used = renderer.GetUsedPipelineVariants();
+  ASSERT_EQ(used.size(), 1u);
+  ASSERT_EQ(used[0].pipeline, "SolidFill");
+  ASSERT_TRUE(ContentContextOptions::Equal{}(used[0].options, opts));
+
+  // The default variants are created with the content context.
+  std::vector<PipelineVariantKey> prewarm = {used[0],
+                                             {"Texture", {}},
+                                             {"Texture", opts},
+                                             {"UnknownPipeline", opts}};
+  ASSERT_EQ(renderer.PrewarmPipelineVariants(prewarm), 1u);
+  ASSERT_EQ(renderer.PrewarmPipelineVariants(prewarm), 0u);
+  ASSERT_NE(renderer.GetTexturePipeline(opts), nullptr);
+}
+
+TEST_P(EntityTest, ConsecutiveRectsAndTexturesCanBeBatched) {
+  auto red = std::make_shared<SolidColorContents>();
+  red->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)));
+  red->SetColor(Color::Red());
+  auto blue = std::make_shared<SolidColorContents>();
+  blue->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(50, 50, 100, 100)));
+  blue->SetColor(Color::Blue());
+  auto circle = std::make_shared<SolidColorContents>();
+  circle->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({200, 200}, 50).TakePath()));
+  circle->SetColor(Color::Green());
+  ASSERT_TRUE(red->CanBatchWith(*blue));
+  ASSERT_FALSE(red->CanBatchWith(*circle));
+
+  auto image = CreateTextureForFixture("boston.jpg");
+  auto make_texture = [&image](Rect destination) {
+    auto contents = TextureContents::MakeRect(destination);
+    contents->SetTexture(image);
+    contents->SetSourceRect(Rect::MakeSize(image->GetSize()));
+    return contents;
+  };
+  auto texture_a = make_texture(Rect::MakeXYWH(0, 200, 100, 100));
+  auto texture_b = make_texture(Rect::MakeXYWH(100, 200, 100, 100));
+  ASSERT_TRUE(texture_a->CanBatchWith(*texture_b));
+  texture_b->SetOpacity(0.5);
+  ASSERT_FALSE(texture_a->CanBatchWith(*texture_b));
+  texture_b->SetOpacity(1.0);
+
+  std::vector<Entity> entities;
+  for (auto contents : std::vector<std::shared_ptr<Contents>>{
+           red, blue, circle, red, texture_a, texture_b}) {
+    Entity entity;
+    entity.SetContents(contents);
+    entities.push_back(entity);
+  }
+  Entity rotated;
+  rotated.SetContents(texture_a);
+  rotated.SetTransformation(Matrix::MakeRotationZ(Radians{kPiOver4}));
+  entities.push_back(rotated);
+
+  ContentContext renderer(GetContext());
+  ASSERT_TRUE(renderer.IsValid());
+  constexpr ISize kSize = {400, 400};
+  auto create_render_pass = [&](const RenderTarget& render_target) {
+    auto command_buffer = GetContext()->CreateCommandBuffer();
+    return std::make_pair(command_buffer,
+                          command_buffer->CreateRenderPass(render_target));
+  };
+
+  // Each batch is drawn with a single command.
+  {
+    auto render_target = RenderTarget::CreateOffscreen(*GetContext(), kSize);
+    auto [command_buffer, render_pass] = create_render_pass(render_target);
+    ASSERT_TRUE(render_pass);
+    ASSERT_TRUE(
+        red->RenderBatch(renderer, {entities[0], entities[1]}, *render_pass));
+    ASSERT_EQ(render_pass->GetCommands().size(), 1u);
+    ASSERT_TRUE(texture_a->RenderBatch(
+        renderer, {entities[4], entities[5], entities[6]}, *render_pass));
+    ASSERT_EQ(render_pass->GetCommands().size(), 2u);
+  }
+
+  // The entities drawn one command at a time.
+  auto unbatched_target = RenderTarget::CreateOffscreen(*GetContext(), kSize);
+  ASSERT_TRUE(unbatched_target.IsValid());
+  {
+    auto [command_buffer, render_pass] = create_render_pass(unbatched_target);
+    ASSERT_TRUE(render_pass);
+    for (const auto& entity : entities) {
+      ASSERT_TRUE(entity.Render(renderer, *render_pass));
+    }
+    ASSERT_EQ(render_pass->GetCommands().size(), entities.size());
+    ASSERT_TRUE(render_pass->EncodeCommands());
+    ASSERT_TRUE(command_buffer->SubmitCommands());
+  }
+  auto unbatched =
+      ReadBackTexture(GetContext(), unbatched_target.GetRenderTargetTexture());
+  ASSERT_TRUE(unbatched.has_value());
+
+  // The entity pass batches the rects, then the textures, and draws the
+  // same pixels.
+  EntityPass pass;
+  for (const auto& entity : entities) {
+    pass.AddEntity(entity);
+  }
+  auto batched_target = RenderTarget::CreateOffscreen(*GetContext(), kSize);
+  ASSERT_TRUE(batched_target.IsValid());
+  ASSERT_TRUE(pass.Render(renderer, batched_target));
+  auto batched =
+      ReadBackTexture(GetContext(), batched_target.GetRenderTargetTexture());
+  ASSERT_TRUE(batched.has_value());
+  ASSERT_TRUE(std::any_of(batched->begin(), batched->end(),
+                          [](uint8_t value) { return value != 0u; }));
+  ASSERT_TRUE(*batched == *unbatched);
+}
+
 TEST_P(EntityTest, FilterCoverageRespectsCropRect) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(BlendMode::kSoftLight,
@@ -1018,6 +1321,32 @@ TEST_P(EntityTest, GaussianBlurFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, DirectionalGaussianBlurCanRenderLargeSigmas) {
+  ContentContext renderer(GetContext());
+  ASSERT_TRUE(renderer.IsValid());
+  auto boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(boston);
+
+  // Large sigmas are downsampled further when blurring with compute so that
+  // the kernel fits in the shared memory tile.
+  for (auto sigma : {2.0f, 20.0f, 200.0f}) {
+    for (auto tile_mode :
+         {Entity::TileMode::kDecal, Entity::TileMode::kClamp}) {
+      auto blur = FilterContents::MakeDirectionalGaussianBlur(
+          FilterInput::Make(boston), Sigma{sigma}, Vector2(1, 0),
+          FilterContents::BlurStyle::kNormal, tile_mode);
+      Entity entity;
+      entity.SetContents(blur);
+      auto snapshot = blur->RenderToSnapshot(renderer, entity);
+      ASSERT_TRUE(snapshot.has_value());
+      ASSERT_TRUE(snapshot->texture);
+      auto coverage = snapshot->GetCoverage();
+      ASSERT_TRUE(coverage.has_value());
+      ASSERT_GT(coverage->size.width, boston->GetSize().width);
+    }
+  }
+}
+
 TEST_P(EntityTest, MorphologyFilter) {
   auto boston = CreateTextureForFixture("boston.jpg");
   ASSERT_TRUE(boston);
@@ -1409,6 +1738,92 @@ TEST_P(EntityTest, DrawAtlasNoColorFullSize) {
   ASSERT_TRUE(OpenPlaygroundHere(e));
 }
 
+TEST_P(EntityTest, DrawAtlasWithManySprites) {
+  // Scatters ten thousand rotated tiles of the image, which backends with
+  // storage buffers draw as instances of a single square.
+  auto atlas = CreateTextureForFixture("bay_bridge.jpg");
+  auto size = atlas->GetSize();
+  Scalar tile_width = size.width / 16;
+  Scalar tile_height = size.height / 16;
+
+  std::vector<Rect> texture_coordinates;
+  std::vector<Matrix> transforms;
+  std::vector<Color> colors;
+  for (size_t i = 0; i < 10000; i++) {
+    texture_coordinates.push_back(Rect::MakeXYWH((i % 16) * tile_width,
+                                                 (i / 16 % 16) * tile_height,
+                                                 tile_width, tile_height));
+    transforms.push_back(
+        Matrix::MakeTranslation({(i % 100) * 10.0f, (i / 100) * 10.0f, 0}) *
+        Matrix::MakeRotationZ(Degrees(i % 360)) *
+        Matrix::MakeScale({0.1, 0.1, 1}));
+    colors.push_back(Color(i % 3 == 0, i % 3 == 1, i % 3 == 2, 1));
+  }
+
+  std::shared_ptr<AtlasContents> contents = std::make_shared<AtlasContents>();
+  contents->SetTransforms(std::move(transforms));
+  contents->SetTextureCoordinates(std::move(texture_coordinates));
+  contents->SetColors(std::move(colors));
+  contents->SetTexture(atlas);
+  contents->SetBlendMode(BlendMode::kModulate);
+
+  Entity e;
+  e.SetTransformation(Matrix::MakeScale(GetContentScale()));
+  e.SetContents(contents);
+
+  ASSERT_TRUE(OpenPlaygroundHere(e));
+}
+
+TEST_P(EntityTest, SolidPointsContentsDrawsManyPoints) {
+  std::vector<Point> points;
+  for (size_t i = 0; i < 20000; i++) {
+    points.push_back({static_cast<Scalar>(i % 200) * 5.0f + 10,
+                      static_cast<Scalar>(i / 200) * 5.0f + 10});
+  }
+
+  auto round = std::make_shared<SolidPointsContents>();
+  round->SetPoints(points);
+  round->SetRadius(2);
+  round->SetPointStyle(PointStyle::kRound);
+  round->SetColor(Color::Blue().WithAlpha(0.5));
+
+  auto square = std::make_shared<SolidPointsContents>();
+  square->SetPoints(points);
+  square->SetRadius(1);
+  square->SetPointStyle(PointStyle::kSquare);
+  square->SetColor(Color::Red());
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) {
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+    entity.SetContents(round);
+    if (!entity.Render(context, pass)) {
+      return false;
+    }
+    entity.SetContents(square);
+    return entity.Render(context, pass);
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, SolidPointsContentsCoverageIncludesTheRadius) {
+  auto contents = std::make_shared<SolidPointsContents>();
+  contents->SetRadius(5);
+
+  Entity entity;
+  entity.SetContents(contents);
+  ASSERT_FALSE(entity.GetCoverage().has_value());
+
+  contents->SetPoints({{10, 20}, {100, 50}, {40, 80}});
+  entity.SetTransformation(Matrix::MakeScale({2, 1, 1}));
+  auto coverage = entity.GetCoverage();
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(10, 15, 210, 85));
+
+  contents->SetRadius(0);
+  ASSERT_FALSE(entity.GetCoverage().has_value());
+}
+
 TEST_P(EntityTest, SolidFillCoverageIsCorrect) {
   // No transform
   {
@@ -1568,6 +1983,48 @@ TEST_P(EntityTest, ClipContentsGetStencilCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, ClipContentsUseScissorsForPixelAlignedRects) {
+  auto make_clip = [](std::unique_ptr<Geometry> geometry,
+                      Entity::ClipOperation clip_op) {
+    auto clip = std::make_shared<ClipContents>();
+    clip->SetClipOperation(clip_op);
+    clip->SetGeometry(std::move(geometry));
+    return clip;
+  };
+  auto rect = Rect::MakeLTRB(10, 10, 50, 50);
+
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeTranslation({5, 10}) *
+                           Matrix::MakeScale({2, 2, 1}));
+  auto scissor =
+      make_clip(Geometry::MakeRect(rect), Entity::ClipOperation::kIntersect)
+          ->GetScissorRect(entity);
+  ASSERT_TRUE(scissor.has_value());
+  ASSERT_RECT_NEAR(scissor.value(), Rect::MakeLTRB(25, 30, 105, 110));
+
+  // Differences, paths and rects that don't land on pixel boundaries or stay
+  // axis aligned need the stencil.
+  ASSERT_FALSE(
+      make_clip(Geometry::MakeRect(rect), Entity::ClipOperation::kDifference)
+          ->GetScissorRect(entity)
+          .has_value());
+  ASSERT_FALSE(make_clip(Geometry::MakeFillPath(
+                             PathBuilder{}.AddRect(rect).TakePath()),
+                         Entity::ClipOperation::kIntersect)
+                   ->GetScissorRect(entity)
+                   .has_value());
+  entity.SetTransformation(Matrix::MakeTranslation({0.5, 0}));
+  ASSERT_FALSE(
+      make_clip(Geometry::MakeRect(rect), Entity::ClipOperation::kIntersect)
+          ->GetScissorRect(entity)
+          .has_value());
+  entity.SetTransformation(Matrix::MakeRotationZ(Degrees(45)));
+  ASSERT_FALSE(
+      make_clip(Geometry::MakeRect(rect), Entity::ClipOperation::kIntersect)
+          ->GetScissorRect(entity)
+          .has_value());
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -1618,6 +2075,73 @@ TEST_P(EntityTest, RRectShadowTest) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, SolidRRectContentsTest) {
+  auto callback = [&](ContentContext& context, RenderPass& pass) {
+    static Color color = Color::Red();
+    static float corner_radius = 40;
+    static float stroke_width = 0;
+    static float rotation = 10;
+
+    ImGui::Begin("Controls", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::SliderFloat("Corner radius", &corner_radius, 0, 300);
+    ImGui::SliderFloat("Stroke width", &stroke_width, 0, 100);
+    ImGui::SliderFloat("Rotation", &rotation, 0, 360);
+    ImGui::ColorEdit4("Color", reinterpret_cast<Scalar*>(&color));
+    ImGui::End();
+
+    auto [top_left, bottom_right] = IMPELLER_PLAYGROUND_LINE(
+        Point(200, 200), Point(600, 400), 30, Color::White(), Color::White());
+    auto rect =
+        Rect::MakeLTRB(top_left.x, top_left.y, bottom_right.x, bottom_right.y);
+
+    auto contents = std::make_unique<SolidRRectContents>();
+    contents->SetRRect(rect, Size(corner_radius, corner_radius));
+    contents->SetStrokeWidth(stroke_width);
+    contents->SetColor(color);
+
+    auto center = rect.origin + Point(rect.size.width, rect.size.height) / 2;
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeScale(GetContentScale()) *
+                             Matrix::MakeTranslation(center) *
+                             Matrix::MakeRotationZ(Degrees(rotation)) *
+                             Matrix::MakeTranslation(-center));
+    entity.SetContents(std::move(contents));
+    entity.Render(context, pass);
+
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, SolidRRectContentsCoverageIncludesTheAntialiasedEdge) {
+  auto contents = std::make_shared<SolidRRectContents>();
+  contents->SetRRect(Rect::MakeXYWH(10, 10, 100, 50), Size(5, 5));
+
+  Entity entity;
+  entity.SetContents(contents);
+  entity.SetTransformation(Matrix::MakeScale({2, 4, 1}));
+  // The edges are padded by a pixel in the direction that is scaled least.
+  auto coverage = entity.GetCoverage();
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(19, 38, 221, 242));
+
+  contents->SetStrokeWidth(10);
+  coverage = entity.GetCoverage();
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(9, 18, 231, 262));
+
+  // Perspective and degenerate transformations are not supported.
+  auto perspective =
+      Matrix::MakePerspective(Degrees(60), Size(400, 400), 1, 10);
+  ASSERT_FALSE(SolidRRectContents::CanRenderWithTransformation(perspective));
+  entity.SetTransformation(perspective);
+  ASSERT_FALSE(entity.GetCoverage().has_value());
+  ASSERT_FALSE(SolidRRectContents::CanRenderWithTransformation(
+      Matrix::MakeScale({0, 1, 1})));
+  ASSERT_TRUE(SolidRRectContents::CanRenderWithTransformation(
+      Matrix::MakeRotationZ(Degrees(30)) * Matrix::MakeSkew(0.5, 0)));
+}
+
 TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   // Set up a simple color background.
   auto fill = std::make_shared<SolidColorContents>();
@@ -1647,6 +2171,68 @@ TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   ASSERT_RECT_NEAR(actual.value(), expected);
 }
 
+TEST_P(EntityTest, ColorMatrixFiltersAreFused) {
+  auto input = FilterInput::Make(SolidColorContents::Make(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 300, 400)).TakePath(),
+      Color::Coral()));
+
+  // Swaps red and green.
+  FilterContents::ColorMatrix swap = {
+      0, 1, 0, 0, 0,  //
+      1, 0, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 1, 0,  //
+  };
+  // Halves the red channel and adds to the blue one.
+  FilterContents::ColorMatrix scale = {
+      0.5, 0, 0, 0, 0,    //
+      0,   1, 0, 0, 0,    //
+      0,   0, 1, 0, 0.5,  //
+      0,   0, 0, 1, 0,    //
+  };
+
+  auto inner = ColorFilterContents::MakeColorMatrix(input, swap);
+  auto outer =
+      ColorFilterContents::MakeColorMatrix(FilterInput::Make(inner), scale);
+  auto fused = std::static_pointer_cast<ColorMatrixFilterContents>(outer);
+  ASSERT_EQ(fused->GetInputs().size(), 1u);
+  ASSERT_EQ(fused->GetInputs()[0], input);
+  FilterContents::ColorMatrix expected = {
+      0, 0.5, 0, 0, 0,    //
+      1, 0,   0, 0, 0,    //
+      0, 0,   1, 0, 0.5,  //
+      0, 0,   0, 1, 0,    //
+  };
+  for (size_t i = 0; i < 20; i++) {
+    ASSERT_FLOAT_EQ(fused->GetMatrix().array[i], expected.array[i]) << i;
+  }
+
+  // The results of this matrix are clamped, so it can't be composed.
+  auto clamped = ColorFilterContents::MakeColorMatrix(
+      FilterInput::Make(outer),
+      {
+          2, 0, 0, 0, 0,  //
+          0, 2, 0, 0, 0,  //
+          0, 0, 2, 0, 0,  //
+          0, 0, 0, 1, 0,  //
+      });
+  auto clamped_input = FilterInput::Make(clamped);
+  auto not_fused = ColorFilterContents::MakeColorMatrix(clamped_input, swap);
+  ASSERT_EQ(not_fused->GetInputs()[0], clamped_input);
+
+  // An sRGB round trip cancels out.
+  auto round_trip = ColorFilterContents::MakeSrgbToLinearFilter(
+      FilterInput::Make(ColorFilterContents::MakeLinearToSrgbFilter(input)));
+  ASSERT_TRUE(std::dynamic_pointer_cast<ColorMatrixFilterContents>(round_trip));
+  ASSERT_EQ(round_trip->GetInputs()[0], input);
+
+  // Filters that absorb the opacity are kept separate.
+  inner->SetAbsorbOpacity(true);
+  auto absorbing_input = FilterInput::Make(inner);
+  auto absorbing = ColorFilterContents::MakeColorMatrix(absorbing_input, scale);
+  ASSERT_EQ(absorbing->GetInputs()[0], absorbing_input);
+}
+
 TEST_P(EntityTest, ColorMatrixFilterEditable) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   ASSERT_TRUE(bay_bridge);
@@ -2044,12 +2630,13 @@ TEST_P(EntityTest, TTTBlendColor) {
 TEST_P(EntityTest, SdfText) {
   auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
     SkFont font;
-    font.setSize(30);
+    font.setSize(64);
     auto blob = SkTextBlob::MakeFromString(
         "the quick brown fox jumped over the lazy dog (but with sdf).", font);
     auto frame = TextFrameFromTextBlob(blob);
     auto lazy_glyph_atlas = std::make_shared<LazyGlyphAtlas>();
-    lazy_glyph_atlas->AddTextFrame(frame);
+    // Text this large is rendered from a signed-distance field.
+    EXPECT_TRUE(lazy_glyph_atlas->AddTextFrame(frame));
 
     EXPECT_FALSE(lazy_glyph_atlas->HasColor());
 
@@ -2170,6 +2757,82 @@ TEST_P(EntityTest, YUVToRGBFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, TextureContentsSamplesYUVPlanes) {
+  if (GetParam() == PlaygroundBackend::kOpenGLES) {
+    // TODO(114588) : Support YUV to RGB filter on OpenGLES backend.
+    GTEST_SKIP_("YUV textures are not supported on OpenGLES backend yet.");
+  }
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    YUVColorSpace yuv_color_space_array[2]{YUVColorSpace::kBT601FullRange,
+                                           YUVColorSpace::kBT601LimitedRange};
+    for (int i = 0; i < 2; i++) {
+      auto yuv_color_space = yuv_color_space_array[i];
+      auto textures =
+          CreateTestYUVTextures(GetContext().get(), yuv_color_space);
+
+      Entity entity;
+      auto contents = TextureContents::MakeRect(Rect::MakeLTRB(0, 0, 256, 256));
+      contents->SetTexture(textures[0]);
+      contents->SetUVTexture(textures[1], yuv_color_space);
+      contents->SetSourceRect(Rect::MakeSize(textures[0]->GetSize()));
+      entity.SetContents(contents);
+      entity.SetTransformation(
+          Matrix::MakeTranslation({static_cast<Scalar>(100 + 400 * i), 300}));
+
+      // The planes can't be passed through as a snapshot.
+      auto snapshot = contents->RenderToSnapshot(context, entity);
+      if (!snapshot.has_value() || snapshot->texture == textures[0]) {
+        return false;
+      }
+      entity.Render(context, pass);
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, TiledTextureContentsUsesSamplerTileModesUnlessDecal) {
+  auto image = CreateTextureForFixture("table_mountain_nx.png");
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    auto render_tiled = [&](Entity::TileMode tile_mode, Scalar x) {
+      auto contents = std::make_shared<TiledTextureContents>();
+      contents->SetTexture(image);
+      contents->SetTileModes(tile_mode, tile_mode);
+      contents->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(x, 0, 200, 200)));
+      Entity entity;
+      entity.SetContents(contents);
+      return entity.Render(context, pass);
+    };
+    auto used_pipelines = [&context]() {
+      std::vector<std::string> pipelines;
+      for (const auto& key : context.GetUsedPipelineVariants()) {
+        pipelines.push_back(key.pipeline);
+      }
+      return pipelines;
+    };
+
+    if (!render_tiled(Entity::TileMode::kClamp, 0)) {
+      return false;
+    }
+    auto pipelines = used_pipelines();
+    EXPECT_NE(std::find(pipelines.begin(), pipelines.end(),
+                        "TiledTextureSamplerTileMode"),
+              pipelines.end());
+
+    // Decal has no sampler address mode on every backend.
+    if (!render_tiled(Entity::TileMode::kDecal, 200)) {
+      return false;
+    }
+    pipelines = used_pipelines();
+    EXPECT_NE(std::find(pipelines.begin(), pipelines.end(), "TiledTexture"),
+              pipelines.end());
+    return render_tiled(Entity::TileMode::kRepeat, 400) &&
+           render_tiled(Entity::TileMode::kMirror, 600);
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
 TEST_P(EntityTest, RuntimeEffect) {
   if (GetParam() != PlaygroundBackend::kMetal) {
     GTEST_SKIP_("This test only has a Metal fixture at the moment.");
@@ -2211,5 +2874,178 @@ TEST_P(EntityTest, RuntimeEffect) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+// A star with many points whose edges cross each other, so that its center
+// is wound around twice.
+static Path MakeLargeStarPath(Point center, Scalar radius, FillType fill) {
+  constexpr int kPointCount = 601;
+  PathBuilder builder;
+  for (int i = 0; i < kPointCount; i++) {
+    Scalar angle = i * 2 * k2Pi / kPointCount;
+    Scalar point_radius = radius * (i % 2 == 0 ? 1.0f : 0.8f);
+    Point point =
+        center + Point(std::cos(angle), std::sin(angle)) * point_radius;
+    if (i == 0) {
+      builder.MoveTo(point);
+    } else {
+      builder.LineTo(point);
+    }
+  }
+  return builder.Close().TakePath(fill);
+}
+
+TEST_P(EntityTest, FillPathGeometryChoosesStencilThenCoverForLargePaths) {
+  using FillStrategy = FillPathGeometry::FillStrategy;
+  ASSERT_EQ(FillPathGeometry(PathBuilder{}.AddCircle({0, 0}, 10).TakePath())
+                .GetFillStrategy(),
+            FillStrategy::kTessellate);
+  ASSERT_EQ(FillPathGeometry(
+                MakeLargeStarPath({100, 100}, 100, FillType::kNonZero))
+                .GetFillStrategy(),
+            FillStrategy::kStencilThenCover);
+  ASSERT_EQ(
+      FillPathGeometry(MakeLargeStarPath({100, 100}, 100, FillType::kOdd))
+          .GetFillStrategy(),
+      FillStrategy::kStencilThenCover);
+  // The stencil values wrap, so they can't tell positive windings apart from
+  // negative ones.
+  ASSERT_EQ(FillPathGeometry(
+                MakeLargeStarPath({100, 100}, 100, FillType::kPositive))
+                .GetFillStrategy(),
+            FillStrategy::kTessellate);
+}
+
+TEST_P(EntityTest, StencilThenCoverFillsLargePaths) {
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    // The center of the non-zero star is filled, the center of the even-odd
+    // star is not.
+    for (auto fill : {FillType::kNonZero, FillType::kOdd}) {
+      Point center = fill == FillType::kNonZero ? Point(250, 300)
+                                                : Point(650, 300);
+      auto contents = std::make_shared<SolidColorContents>();
+      contents->SetGeometry(
+          Geometry::MakeFillPath(MakeLargeStarPath(center, 200, fill)));
+      contents->SetColor(Color::Red());
+
+      Entity entity;
+      entity.SetContents(contents);
+      if (!entity.Render(context, pass)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, ComputeStrokeSegmentsFollowTheContours) {
+  using Segment = StrokePathGeometry::ComputeStrokeSegment;
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 10})
+                  .MoveTo({20, 20})
+                  .LineTo({30, 20})
+                  .LineTo({30, 30})
+                  .Close()
+                  .MoveTo({40, 40})
+                  .LineTo({40, 40})
+                  .TakePath();
+  auto segments =
+      StrokePathGeometry::CreateComputeStrokeSegments(path.CreatePolyline());
+  ASSERT_EQ(segments.size(), 6u);
+
+  // The open contour is capped at both ends and joined in between.
+  ASSERT_EQ(segments[0].p0, Point(0, 0));
+  ASSERT_EQ(segments[0].p1, Point(10, 0));
+  ASSERT_EQ(segments[0].next, Point(10, 10));
+  ASSERT_EQ(segments[0].flags, Segment::kStartsContour | Segment::kHasJoin);
+  ASSERT_EQ(segments[1].flags, Segment::kEndsContour);
+
+  // The closed contour is joined everywhere, including where it closes.
+  ASSERT_EQ(segments[2].flags, Segment::kHasJoin);
+  ASSERT_EQ(segments[3].flags, Segment::kHasJoin);
+  ASSERT_EQ(segments[4].p0, Point(30, 30));
+  ASSERT_EQ(segments[4].p1, Point(20, 20));
+  ASSERT_EQ(segments[4].next, Point(30, 20));
+  ASSERT_EQ(segments[4].flags, Segment::kHasJoin);
+
+  // A single point is capped on both ends.
+  ASSERT_EQ(segments[5].p0, Point(40, 40));
+  ASSERT_EQ(segments[5].p1, Point(40, 40));
+  ASSERT_EQ(segments[5].flags,
+            Segment::kStartsContour | Segment::kEndsContour);
+}
+
+TEST_P(EntityTest, CanStrokeLargePathsWithCompute) {
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    // Enough points to be stroked by the compute shader where it's
+    // supported. Each row uses a different join and cap.
+    const std::pair<Join, Cap> styles[] = {
+        {Join::kMiter, Cap::kButt},
+        {Join::kRound, Cap::kRound},
+        {Join::kBevel, Cap::kSquare},
+    };
+    for (size_t row = 0; row < 3; row++) {
+      PathBuilder builder;
+      builder.MoveTo({50, 100.0f + row * 200});
+      for (size_t i = 1;
+           i < StrokePathGeometry::kComputeStrokeMinComponentCount; i++) {
+        builder.LineTo({50.0f + i * 1.5f,
+                        100.0f + row * 200 + (i % 2 == 0 ? -40 : 40)});
+      }
+      auto [join, cap] = styles[row];
+      auto contents = std::make_shared<SolidColorContents>();
+      contents->SetGeometry(
+          Geometry::MakeStrokePath(builder.TakePath(), 6, 4, cap, join));
+      contents->SetColor(Color::Red().WithAlpha(0.5));
+
+      Entity entity;
+      entity.SetContents(contents);
+      if (!entity.Render(context, pass)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, FramebufferBlendContentsBlendsInPlace) {
+  if (!GetContext()->GetBackendFeatures().framebuffer_fetch_support) {
+    GTEST_SKIP_("This backend doesn't support framebuffer fetch.");
+  }
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    Entity dst_entity;
+    dst_entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(Rect::MakeXYWH(100, 100, 300, 300)).TakePath(),
+        Color::Red()));
+    if (!dst_entity.Render(context, pass)) {
+      return false;
+    }
+
+    // Each row blends with a different advanced blend mode.
+    auto row = 0;
+    for (auto blend_mode : {BlendMode::kScreen, BlendMode::kMultiply,
+                            BlendMode::kDifference, BlendMode::kLuminosity}) {
+      auto contents = std::make_shared<FramebufferBlendContents>();
+      contents->SetBlendMode(blend_mode);
+      contents->SetChildContents(SolidColorContents::Make(
+          PathBuilder{}.AddCircle({250, 130.0f + row * 80}, 60).TakePath(),
+          Color::Blue().WithAlpha(0.75)));
+
+      Entity src_entity;
+      src_entity.SetContents(contents);
+      src_entity.SetBlendMode(BlendMode::kSource);
+      if (!src_entity.Render(context, pass)) {
+        return false;
+      }
+      row++;
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
 }  // namespace testing
 }  // namespace impeller
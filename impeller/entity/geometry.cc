@@ -3,11 +3,23 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/position_color.vert.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/compute_command.h"
+#include "impeller/renderer/compute_pass.h"
 #include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/platform.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/tessellator/tessellator.h"
 
@@ -35,6 +47,12 @@ std::unique_ptr<Geometry> Geometry::MakeStrokePath(const Path& path,
                                               stroke_cap, stroke_join);
 }
 
+GeometryResult Geometry::GetFillPositionBuffer(const ContentContext& renderer,
+                                               const Entity& entity,
+                                               RenderPass& pass) {
+  return GetPositionBuffer(renderer, entity, pass);
+}
+
 std::unique_ptr<Geometry> Geometry::MakeCover() {
   return std::make_unique<CoverGeometry>();
 }
@@ -49,20 +67,67 @@ FillPathGeometry::FillPathGeometry(const Path& path) : path_(path) {}
 
 FillPathGeometry::~FillPathGeometry() = default;
 
-GeometryResult FillPathGeometry::GetPositionBuffer(
-    const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) {
-  auto tolerance =
-      kDefaultCurveTolerance / entity.GetTransformation().GetMaxBasisLength();
+// Fills a convex contour with a fan of triangles around its first point,
+// which covers every pixel inside the contour exactly once. The points of the
+// contour are used as vertices as they are.
+static std::optional<VertexBuffer> CreateConvexFillVertices(
+    const Path& path,
+    const Path::Polyline& polyline,
+    HostBuffer& host_buffer) {
+  // A single contour winds around its interior once, in either direction, so
+  // only the fill types that fill the area with a winding of one or minus one
+  // are the same for every contour.
+  if (path.GetFillType() != FillType::kNonZero &&
+      path.GetFillType() != FillType::kOdd) {
+    return std::nullopt;
+  }
+  auto bounds = polyline.GetSingleConvexContourBounds(
+      path.GetConvexity() == Convexity::kConvex);
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+  auto [start, end] = bounds.value();
+  const size_t count = end - start;
+  if (count > std::numeric_limits<uint16_t>::max()) {
+    return std::nullopt;
+  }
+
+  std::vector<uint16_t> indices;
+  indices.reserve((count - 2) * 3);
+  for (size_t i = 1; i + 1 < count; i++) {
+    indices.push_back(0);
+    indices.push_back(i);
+    indices.push_back(i + 1);
+  }
 
   VertexBuffer vertex_buffer;
-  auto& host_buffer = pass.GetTransientsBuffer();
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(), path_.CreatePolyline(tolerance),
+  vertex_buffer.vertex_buffer = host_buffer.Emplace(
+      polyline.points.data() + start, count * sizeof(Point), alignof(Point));
+  vertex_buffer.index_buffer =
+      host_buffer.Emplace(indices.data(), indices.size() * sizeof(uint16_t),
+                          alignof(uint16_t));
+  vertex_buffer.index_count = indices.size();
+  vertex_buffer.index_type = IndexType::k16bit;
+  return vertex_buffer;
+}
+
+// static
+VertexBuffer FillPathGeometry::CreateFillVertices(const Path& path,
+                                                  Scalar tolerance,
+                                                  Tessellator& tessellator,
+                                                  HostBuffer& host_buffer) {
+  auto polyline = path.CreatePolyline(tolerance);
+  if (auto convex_vertex_buffer =
+          CreateConvexFillVertices(path, polyline, host_buffer)) {
+    return convex_vertex_buffer.value();
+  }
+
+  VertexBuffer vertex_buffer;
+  auto tesselation_result = tessellator.Tessellate(
+      path.GetFillType(), polyline,
       [&vertex_buffer, &host_buffer](
-          const float* vertices, size_t vertices_count, const uint16_t* indices,
-          size_t indices_count) {
+          const float* vertices, size_t vertices_count,
+          const uint16_t* indices, size_t indices_count) {
         vertex_buffer.vertex_buffer = host_buffer.Emplace(
             vertices, vertices_count * sizeof(float), alignof(float));
         vertex_buffer.index_buffer = host_buffer.Emplace(
@@ -74,6 +139,43 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   if (tesselation_result != Tessellator::Result::kSuccess) {
     return {};
   }
+  return vertex_buffer;
+}
+
+GeometryResult FillPathGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  // Curves are flattened for the largest scale of the bucket of the current
+  // scale, so that the vertices can be cached for all scales in the bucket.
+  auto scale_bucket = TessellationCache::GetScaleBucket(
+      entity.GetTransformation().GetMaxBasisLength());
+  auto tolerance =
+      kDefaultCurveTolerance / TessellationCache::GetBucketScale(scale_bucket);
+
+  auto create_vertices = [this, &renderer,
+                          tolerance](HostBuffer& host_buffer) {
+    return CreateFillVertices(path_, tolerance, *renderer.GetTessellator(),
+                              host_buffer);
+  };
+
+  // Paths that are known to be convex are cheap enough to fill that caching
+  // them is not worth a device buffer of their own.
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto tessellation_cache = renderer.GetTessellationCache();
+  VertexBuffer vertex_buffer;
+  if (tessellation_cache && path_.GetConvexity() != Convexity::kConvex) {
+    vertex_buffer = tessellation_cache->GetOrCreateVertices(
+        path_,
+        {.type = TessellationCache::Key::Type::kFill,
+         .scale_bucket = scale_bucket},
+        host_buffer, create_vertices);
+  } else {
+    vertex_buffer = create_vertices(host_buffer);
+  }
+  if (!vertex_buffer) {
+    return {};
+  }
   return GeometryResult{
       .type = PrimitiveType::kTriangle,
       .vertex_buffer = vertex_buffer,
@@ -83,6 +185,153 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
   };
 }
 
+FillPathGeometry::FillStrategy FillPathGeometry::GetFillStrategy() const {
+  // The other fill types need the sign of the winding, which the wrapping
+  // stencil values don't keep.
+  if (path_.GetFillType() != FillType::kNonZero &&
+      path_.GetFillType() != FillType::kOdd) {
+    return FillStrategy::kTessellate;
+  }
+  if (path_.GetConvexity() == Convexity::kConvex ||
+      path_.GetComponentCount() < kStencilThenCoverMinComponentCount) {
+    return FillStrategy::kTessellate;
+  }
+  return FillStrategy::kStencilThenCover;
+}
+
+// Marks the interior of the polyline in the stencil buffer, which must hold
+// zero everywhere. Each contour is drawn as a fan of triangles around its
+// first point. A pixel is covered by the triangles of a contour as many times
+// more counterclockwise than clockwise as the contour winds around it, so
+// counterclockwise triangles increment the stencil value and clockwise ones
+// decrement it. For the even-odd fill type only the parity of the count
+// matters, which inverting the stencil value for every triangle keeps.
+static bool RenderStencilFans(const ContentContext& renderer,
+                              const Entity& entity,
+                              RenderPass& pass,
+                              const Path::Polyline& polyline,
+                              FillType fill_type) {
+  using VS = ClipPipeline::VertexShader;
+  using FS = ClipPipeline::FragmentShader;
+
+  std::vector<uint16_t> counterclockwise_indices;
+  std::vector<uint16_t> clockwise_indices;
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    auto [start, end] = polyline.GetContourPointBounds(contour_i);
+    const Point& origin = polyline.points[start];
+    for (size_t i = start + 1; i + 1 < end; i++) {
+      const Scalar cross = (polyline.points[i] - origin)
+                               .Cross(polyline.points[i + 1] - origin);
+      if (cross == 0) {
+        continue;
+      }
+      auto& indices = fill_type == FillType::kOdd || cross > 0
+                          ? counterclockwise_indices
+                          : clockwise_indices;
+      indices.push_back(start);
+      indices.push_back(i);
+      indices.push_back(i + 1);
+    }
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto vertices = host_buffer.Emplace(polyline.points.data(),
+                                      polyline.points.size() * sizeof(Point),
+                                      alignof(Point));
+
+  VS::VertInfo info;
+  info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+             entity.GetTransformation();
+  FS::FragInfo frag_info;
+  // The color really doesn't matter.
+  frag_info.color = Color::SkyBlue();
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.stencil_compare = CompareFunction::kAlways;
+  options.primitive_type = PrimitiveType::kTriangle;
+
+  auto add_fan = [&](const std::vector<uint16_t>& indices,
+                     StencilOperation operation, const char* label) {
+    if (indices.empty()) {
+      return true;
+    }
+    Command cmd;
+    cmd.label = label;
+    cmd.stencil_reference = 0u;
+    options.stencil_operation = operation;
+    cmd.pipeline = renderer.GetClipPipeline(options);
+    cmd.BindVertices(VertexBuffer{
+        .vertex_buffer = vertices,
+        .index_buffer = host_buffer.Emplace(indices.data(),
+                                            indices.size() * sizeof(uint16_t),
+                                            alignof(uint16_t)),
+        .index_count = indices.size(),
+        .index_type = IndexType::k16bit,
+    });
+    VS::BindVertInfo(cmd, host_buffer.EmplaceUniform(info));
+    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    return pass.AddCommand(std::move(cmd));
+  };
+
+  if (fill_type == FillType::kOdd) {
+    return add_fan(counterclockwise_indices, StencilOperation::kInvert,
+                   "Stencil Fill (Invert)");
+  }
+  return add_fan(counterclockwise_indices, StencilOperation::kIncrementWrap,
+                 "Stencil Fill (Increment)") &&
+         add_fan(clockwise_indices, StencilOperation::kDecrementWrap,
+                 "Stencil Fill (Decrement)");
+}
+
+GeometryResult FillPathGeometry::GetFillPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  // The fans need a stencil buffer that holds zero everywhere, which is the
+  // case until the first clip is drawn.
+  if (entity.GetStencilDepth() != 0u ||
+      !pass.GetRenderTarget().GetStencilAttachment().has_value() ||
+      GetFillStrategy() != FillStrategy::kStencilThenCover) {
+    return GetPositionBuffer(renderer, entity, pass);
+  }
+
+  auto coverage = path_.GetTransformedBoundingBox(entity.GetTransformation());
+  if (!coverage.has_value()) {
+    return {};
+  }
+
+  auto tolerance =
+      kDefaultCurveTolerance / entity.GetTransformation().GetMaxBasisLength();
+  auto polyline = path_.CreatePolyline(tolerance);
+  if (polyline.points.size() > std::numeric_limits<uint16_t>::max()) {
+    return GetPositionBuffer(renderer, entity, pass);
+  }
+  if (!RenderStencilFans(renderer, entity, pass, polyline,
+                         path_.GetFillType())) {
+    return {};
+  }
+
+  constexpr uint16_t kRectIndices[4] = {0, 1, 2, 3};
+  auto& host_buffer = pass.GetTransientsBuffer();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          {
+              .vertex_buffer = host_buffer.Emplace(
+                  coverage->GetPoints().data(), 8 * sizeof(float),
+                  alignof(float)),
+              .index_buffer = host_buffer.Emplace(
+                  kRectIndices, 4 * sizeof(uint16_t), alignof(uint16_t)),
+              .index_count = 4,
+              .index_type = IndexType::k16bit,
+          },
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()),
+      .prevent_overdraw = false,
+      .stencil_cover = true,
+  };
+}
+
 GeometryVertexType FillPathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
@@ -296,6 +545,20 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
   return cap_proc;
 }
 
+// static
+VertexBuffer StrokePathGeometry::CreateStrokeVertices(const Path& path,
+                                                      Scalar stroke_width,
+                                                      Scalar scaled_miter_limit,
+                                                      Cap stroke_cap,
+                                                      Join stroke_join,
+                                                      Scalar tolerance,
+                                                      HostBuffer& host_buffer) {
+  return CreateSolidStrokeVertices(path, host_buffer, stroke_width,
+                                   scaled_miter_limit, stroke_cap,
+                                   GetJoinProc(stroke_join),
+                                   GetCapProc(stroke_cap), tolerance);
+}
+
 // static
 VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
     const Path& path,
@@ -307,7 +570,7 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
     const StrokePathGeometry::CapProc& cap_proc,
     Scalar tolerance) {
   VertexBufferBuilder<VS::PerVertexData> vtx_builder;
-  auto polyline = path.CreatePolyline();
+  auto polyline = path.CreatePolyline(tolerance);
 
   VS::PerVertexData vtx;
 
@@ -424,6 +687,168 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
   return vtx_builder.CreateVertexBuffer(buffer);
 }
 
+// This must match the std430 layout of Segment in stroke.comp.
+static_assert(sizeof(StrokePathGeometry::ComputeStrokeSegment) == 32);
+
+// static
+std::vector<StrokePathGeometry::ComputeStrokeSegment>
+StrokePathGeometry::CreateComputeStrokeSegments(
+    const Path::Polyline& polyline) {
+  std::vector<ComputeStrokeSegment> segments;
+  segments.reserve(polyline.points.size());
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    auto [start, end] = polyline.GetContourPointBounds(contour_i);
+    if (end == start) {
+      continue;
+    }
+    const auto& points = polyline.points;
+    if (end - start == 1) {
+      segments.push_back({.p0 = points[start],
+                          .p1 = points[start],
+                          .next = points[start],
+                          .flags = ComputeStrokeSegment::kStartsContour |
+                                   ComputeStrokeSegment::kEndsContour});
+      continue;
+    }
+
+    const bool is_closed = polyline.contours[contour_i].is_closed;
+    for (size_t point_i = start; point_i < end - 1; point_i++) {
+      ComputeStrokeSegment segment{.p0 = points[point_i],
+                                   .p1 = points[point_i + 1]};
+      if (point_i + 2 < end) {
+        segment.next = points[point_i + 2];
+        segment.flags |= ComputeStrokeSegment::kHasJoin;
+      } else if (is_closed) {
+        // Closed contours are joined where they end to where they start.
+        segment.next = points[start + 1];
+        segment.flags |= ComputeStrokeSegment::kHasJoin;
+      }
+      if (!is_closed && point_i == start) {
+        segment.flags |= ComputeStrokeSegment::kStartsContour;
+      }
+      if (!is_closed && point_i + 2 == end) {
+        segment.flags |= ComputeStrokeSegment::kEndsContour;
+      }
+      segments.push_back(segment);
+    }
+  }
+  return segments;
+}
+
+std::optional<VertexBuffer> StrokePathGeometry::CreateComputeStrokeVertices(
+    const ContentContext& renderer,
+    Scalar stroke_width,
+    Scalar scaled_miter_limit,
+    Scalar tolerance) const {
+  using CS = StrokeComputePipeline::ComputeShader;
+  // These must match the local size and the vertex budget of stroke.comp.
+  static constexpr int64_t kWorkgroupSize = 128;
+  static constexpr uint32_t kMaxRoundDivisions = 16u;
+  static constexpr size_t kMaxVertexCount = 1u << 21;
+
+  TRACE_EVENT0("impeller", "StrokePathGeometry::CreateComputeStrokeVertices");
+  auto segments = CreateComputeStrokeSegments(path_.CreatePolyline(tolerance));
+  if (segments.empty()) {
+    return std::nullopt;
+  }
+
+  // Round joins and caps are split so that their arcs stay within the
+  // tolerance of a circle of the stroke's radius.
+  Scalar half_width = stroke_width * 0.5f;
+  Scalar arc_step = 2 * std::acos(std::max(1 - tolerance / half_width, -1.0f));
+  uint32_t round_divisions = std::clamp(
+      static_cast<uint32_t>(std::ceil(kPi / arc_step)), 1u, kMaxRoundDivisions);
+
+  uint32_t join_vertex_count = 0;
+  switch (stroke_join_) {
+    case Join::kMiter:
+      join_vertex_count = 6;
+      break;
+    case Join::kRound:
+      join_vertex_count = 3 * round_divisions;
+      break;
+    case Join::kBevel:
+      join_vertex_count = 3;
+      break;
+  }
+  uint32_t cap_vertex_count = 0;
+  switch (stroke_cap_) {
+    case Cap::kButt:
+      break;
+    case Cap::kRound:
+      cap_vertex_count = 3 * round_divisions;
+      break;
+    case Cap::kSquare:
+      cap_vertex_count = 6;
+      break;
+  }
+  // The rectangle of the segment, its join and the caps at both of its ends.
+  const uint32_t vertices_per_segment =
+      6 + join_vertex_count + 2 * cap_vertex_count;
+  const size_t vertex_count = segments.size() * vertices_per_segment;
+  if (vertex_count > kMaxVertexCount) {
+    return std::nullopt;
+  }
+
+  auto allocator = renderer.GetContext()->GetResourceAllocator();
+  DeviceBufferDescriptor vertex_desc;
+  vertex_desc.storage_mode = StorageMode::kDevicePrivate;
+  vertex_desc.size = vertex_count * sizeof(Point);
+  auto vertex_buffer = allocator->CreateBuffer(vertex_desc);
+  DeviceBufferDescriptor index_desc;
+  index_desc.storage_mode = StorageMode::kDevicePrivate;
+  index_desc.size = vertex_count * sizeof(uint32_t);
+  auto index_buffer = allocator->CreateBuffer(index_desc);
+  if (!vertex_buffer || !index_buffer) {
+    return std::nullopt;
+  }
+  vertex_buffer->SetLabel("StrokePathGeometry Compute Vertices");
+  index_buffer->SetLabel("StrokePathGeometry Compute Indices");
+
+  CS::StrokeInfo stroke_info;
+  stroke_info.segment_count = segments.size();
+  stroke_info.vertices_per_segment = vertices_per_segment;
+  stroke_info.join = static_cast<uint32_t>(stroke_join_);
+  stroke_info.cap = static_cast<uint32_t>(stroke_cap_);
+  stroke_info.round_divisions = round_divisions;
+  stroke_info.half_stroke_width = half_width;
+  stroke_info.miter_limit = scaled_miter_limit;
+
+  ContentContext::ComputeSubpassCallback callback =
+      [&](const ContentContext& renderer, ComputePass& pass) {
+        pass.SetGridSize(ISize(segments.size(), 1));
+        pass.SetThreadGroupSize(ISize(kWorkgroupSize, 1));
+
+        ComputeCommand cmd;
+        cmd.label = "Stroke Compute";
+        cmd.pipeline = renderer.GetStrokeComputePipeline();
+
+        auto& host_buffer = pass.GetTransientsBuffer();
+        CS::BindStrokeInfo(cmd, host_buffer.EmplaceUniform(stroke_info));
+        CS::BindSegments(
+            cmd, host_buffer.Emplace(
+                     segments.data(),
+                     segments.size() * sizeof(ComputeStrokeSegment),
+                     std::max(alignof(ComputeStrokeSegment),
+                              DefaultUniformAlignment())));
+        CS::BindVertices(cmd, vertex_buffer->AsBufferView());
+        CS::BindIndices(cmd, index_buffer->AsBufferView());
+
+        return pass.AddCommand(std::move(cmd));
+      };
+  if (!renderer.MakeComputeSubpass("Stroke Compute", callback)) {
+    return std::nullopt;
+  }
+
+  return VertexBuffer{
+      .vertex_buffer = vertex_buffer->AsBufferView(),
+      .index_buffer = index_buffer->AsBufferView(),
+      .index_count = vertex_count,
+      .index_type = IndexType::k32bit,
+  };
+}
+
 GeometryResult StrokePathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
@@ -439,15 +864,55 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
   Scalar stroke_width = std::max(stroke_width_, min_size);
 
+  auto scale_bucket = TessellationCache::GetScaleBucket(
+      entity.GetTransformation().GetMaxBasisLength());
+  // The path, the joins and the caps are all flattened in the coordinates of
+  // the path, so they share the tolerance of the scale they are drawn at.
   auto tolerance =
-      kDefaultCurveTolerance /
-      (stroke_width_ * entity.GetTransformation().GetMaxBasisLength());
+      kDefaultCurveTolerance / TessellationCache::GetBucketScale(scale_bucket);
+  Scalar scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5;
+
+  if (path_.GetComponentCount() >= kComputeStrokeMinComponentCount &&
+      renderer.GetBackendFeatures().compute_shader_support &&
+      renderer.GetStrokeComputePipeline()) {
+    // Large paths are usually ones that change every frame, such as charts,
+    // so they are stroked on the GPU again instead of being cached.
+    auto vertex_buffer = CreateComputeStrokeVertices(
+        renderer, stroke_width, scaled_miter_limit, tolerance);
+    if (vertex_buffer.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = vertex_buffer.value(),
+          .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransformation(),
+          .prevent_overdraw = true,
+      };
+    }
+  }
+
+  auto create_vertices = [this, stroke_width, scaled_miter_limit,
+                          tolerance](HostBuffer& host_buffer) {
+    return CreateStrokeVertices(path_, stroke_width, scaled_miter_limit,
+                                stroke_cap_, stroke_join_, tolerance,
+                                host_buffer);
+  };
 
   auto& host_buffer = pass.GetTransientsBuffer();
-  auto vertex_buffer = CreateSolidStrokeVertices(
-      path_, host_buffer, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      stroke_cap_, GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      tolerance);
+  auto tessellation_cache = renderer.GetTessellationCache();
+  VertexBuffer vertex_buffer;
+  if (tessellation_cache) {
+    vertex_buffer = tessellation_cache->GetOrCreateVertices(
+        path_,
+        {.type = TessellationCache::Key::Type::kStroke,
+         .scale_bucket = scale_bucket,
+         .stroke_width = stroke_width,
+         .miter_limit = scaled_miter_limit,
+         .cap = stroke_cap_,
+         .join = stroke_join_},
+        host_buffer, create_vertices);
+  } else {
+    vertex_buffer = create_vertices(host_buffer);
+  }
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
@@ -532,6 +997,10 @@ RectGeometry::RectGeometry(Rect rect) : rect_(rect) {}
 
 RectGeometry::~RectGeometry() = default;
 
+const Rect& RectGeometry::GetRect() const {
+  return rect_;
+}
+
 GeometryResult RectGeometry::GetPositionBuffer(const ContentContext& renderer,
                                                const Entity& entity,
                                                RenderPass& pass) {
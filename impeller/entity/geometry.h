@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/solid_fill.vert.h"
@@ -11,6 +14,7 @@
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/shader_types.h"
 #include "impeller/renderer/vertex_buffer.h"
 
 namespace impeller {
@@ -22,6 +26,11 @@ struct GeometryResult {
   VertexBuffer vertex_buffer;
   Matrix transform;
   bool prevent_overdraw;
+  /// The interior of the geometry was marked by non-zero values in the stencil
+  /// buffer, and the vertices only cover it. The contents must draw the pixels
+  /// whose stencil value differs from the reference value and reset them to
+  /// the reference value.
+  bool stencil_cover = false;
 };
 
 enum GeometryVertexType {
@@ -42,6 +51,12 @@ enum class Join {
   kBevel,
 };
 
+/// The shape of the points that are drawn around each of their centers.
+enum class PointStyle {
+  kRound,
+  kSquare,
+};
+
 class Geometry {
  public:
   Geometry();
@@ -65,6 +80,18 @@ class Geometry {
                                            const Entity& entity,
                                            RenderPass& pass) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the vertices of the geometry for contents that shade it.
+  ///             Unlike `GetPositionBuffer`, the geometry may choose to fill
+  ///             itself with the stencil buffer and return vertices that
+  ///             cover it, see `GeometryResult::stencil_cover`. Clips, which
+  ///             write the vertices into the stencil buffer themselves, must
+  ///             use `GetPositionBuffer`.
+  ///
+  virtual GeometryResult GetFillPositionBuffer(const ContentContext& renderer,
+                                               const Entity& entity,
+                                               RenderPass& pass);
+
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
@@ -87,16 +114,47 @@ class VerticesGeometry : public Geometry {
 /// @brief A geometry that is created from a filled path object.
 class FillPathGeometry : public Geometry {
  public:
+  /// How the interior of a path is computed.
+  enum class FillStrategy {
+    /// Tessellate the path into triangles on the CPU.
+    kTessellate,
+    /// Mark the interior in the stencil buffer with a fan of triangles for
+    /// each contour, then draw a rectangle that covers the path and only
+    /// touches the marked pixels.
+    kStencilThenCover,
+  };
+
+  /// Paths with fewer components than this are tessellated. Larger paths
+  /// take libtess2 long enough that filling them on the GPU is faster.
+  static constexpr size_t kStencilThenCoverMinComponentCount = 512u;
+
   explicit FillPathGeometry(const Path& path);
 
   ~FillPathGeometry();
 
+  /// Chooses how to fill the path when the stencil buffer is available and
+  /// holds no clip.
+  FillStrategy GetFillStrategy() const;
+
+  /// Creates the vertices that fill a path on the CPU, which are drawn as
+  /// triangles. Convex paths are filled with a fan instead of being
+  /// tessellated. Returns an invalid buffer if tessellation fails.
+  static VertexBuffer CreateFillVertices(const Path& path,
+                                         Scalar tolerance,
+                                         Tessellator& tessellator,
+                                         HostBuffer& host_buffer);
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
                                    RenderPass& pass) override;
 
+  // |Geometry|
+  GeometryResult GetFillPositionBuffer(const ContentContext& renderer,
+                                       const Entity& entity,
+                                       RenderPass& pass) override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
@@ -111,6 +169,34 @@ class FillPathGeometry : public Geometry {
 /// @brief A geometry that is created from a stroked path object.
 class StrokePathGeometry : public Geometry {
  public:
+  /// Paths with fewer components than this are stroked on the CPU. Larger
+  /// paths are stroked by a compute shader if the backend supports it.
+  static constexpr size_t kComputeStrokeMinComponentCount = 512u;
+
+  /// A segment of a polyline, as it is read by the stroke compute shader.
+  struct ComputeStrokeSegment {
+    enum Flags : uint32_t {
+      /// The segment is joined at |p1| to the segment that ends at |next|.
+      kHasJoin = 1 << 0,
+      /// The segment starts an open contour and is capped at |p0|.
+      kStartsContour = 1 << 1,
+      /// The segment ends an open contour and is capped at |p1|.
+      kEndsContour = 1 << 2,
+    };
+
+    Point p0;
+    Point p1;
+    Point next;
+    uint32_t flags = 0;
+    Padding<4> _padding_;
+  };
+
+  /// Splits a polyline into the segments the stroke compute shader reads.
+  /// Contours of a single point become a segment of zero length that is
+  /// capped on both ends.
+  static std::vector<ComputeStrokeSegment> CreateComputeStrokeSegments(
+      const Path::Polyline& polyline);
+
   StrokePathGeometry(const Path& path,
                      Scalar stroke_width,
                      Scalar miter_limit,
@@ -127,6 +213,17 @@ class StrokePathGeometry : public Geometry {
 
   Join GetStrokeJoin() const;
 
+  /// Creates the vertices that stroke a path on the CPU, which are drawn as
+  /// a triangle strip. The miter limit is scaled by half of the stroke
+  /// width.
+  static VertexBuffer CreateStrokeVertices(const Path& path,
+                                           Scalar stroke_width,
+                                           Scalar scaled_miter_limit,
+                                           Cap stroke_cap,
+                                           Join stroke_join,
+                                           Scalar tolerance,
+                                           HostBuffer& host_buffer);
+
  private:
   using VS = SolidFillVertexShader;
 
@@ -171,6 +268,12 @@ class StrokePathGeometry : public Geometry {
 
   static StrokePathGeometry::JoinProc GetJoinProc(Join stroke_join);
 
+  std::optional<VertexBuffer> CreateComputeStrokeVertices(
+      const ContentContext& renderer,
+      Scalar stroke_width,
+      Scalar scaled_miter_limit,
+      Scalar tolerance) const;
+
   static StrokePathGeometry::CapProc GetCapProc(Cap stroke_cap);
 
   Path path_;
@@ -211,6 +314,8 @@ class RectGeometry : public Geometry {
 
   ~RectGeometry();
 
+  const Rect& GetRect() const;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/gradient_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+GradientCache::GradientCache(size_t max_unused_frames, size_t max_entries)
+    : max_unused_frames_(max_unused_frames), max_entries_(max_entries) {}
+
+GradientCache::~GradientCache() = default;
+
+static size_t HashGradient(const std::vector<Color>& colors,
+                           const std::vector<Scalar>& stops) {
+  size_t hash = fml::HashCombine(colors.size());
+  for (const auto& color : colors) {
+    fml::HashCombineSeed(hash, color.red, color.green, color.blue,
+                         color.alpha);
+  }
+  for (auto stop : stops) {
+    fml::HashCombineSeed(hash, stop);
+  }
+  return hash;
+}
+
+std::shared_ptr<Texture> GradientCache::GetOrCreateGradientTexture(
+    const std::vector<Color>& colors,
+    const std::vector<Scalar>& stops,
+    const std::shared_ptr<Context>& context) {
+  const size_t hash = HashGradient(colors, stops);
+
+  bool should_cache = false;
+  {
+    Lock lock(mutex_);
+    if (auto found = entries_.find(hash); found != entries_.end()) {
+      auto& entry = found->second;
+      if (entry.colors == colors && entry.stops == stops) {
+        entry.used_this_frame = true;
+        frame_hits_++;
+        return entry.texture;
+      }
+      // A different gradient with the same hash is already cached.
+    } else {
+      should_cache = entries_.size() < max_entries_;
+    }
+    frame_misses_++;
+  }
+
+  // The ramp is created without holding the lock, so that other gradients
+  // may be created concurrently.
+  TRACE_EVENT0("impeller", "GradientCache::CreateGradientTexture");
+  auto texture =
+      CreateGradientTexture(CreateGradientBuffer(colors, stops), context);
+  if (!texture || !should_cache) {
+    return texture;
+  }
+
+  Lock lock(mutex_);
+  if (entries_.size() < max_entries_ &&
+      entries_.find(hash) == entries_.end()) {
+    entries_.emplace(hash, Entry{
+                               .colors = colors,
+                               .stops = stops,
+                               .texture = texture,
+                               .unused_frames = 0u,
+                               .used_this_frame = true,
+                           });
+  }
+  return texture;
+}
+
+void GradientCache::Start() {
+  Lock lock(mutex_);
+  for (auto& [hash, entry] : entries_) {
+    entry.used_this_frame = false;
+  }
+  frame_hits_ = 0u;
+  frame_misses_ = 0u;
+}
+
+void GradientCache::End() {
+  Lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto& entry = it->second;
+    entry.unused_frames = entry.used_this_frame ? 0u : entry.unused_frames + 1;
+    if (entry.unused_frames > max_unused_frames_) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  last_frame_hits_ = frame_hits_;
+  last_frame_misses_ = frame_misses_;
+
+  FML_TRACE_COUNTER("impeller",                                       //
+                    "GradientCache", reinterpret_cast<int64_t>(this),  //
+                    "CachedEntries", entries_.size(),                 //
+                    "Hits", last_frame_hits_,                         //
+                    "Misses", last_frame_misses_);
+}
+
+size_t GradientCache::CachedEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t GradientCache::GetHitCount() const {
+  Lock lock(mutex_);
+  return last_frame_hits_;
+}
+
+size_t GradientCache::GetMissCount() const {
+  Lock lock(mutex_);
+  return last_frame_misses_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the color ramp textures of gradients, so that
+///             gradients that are drawn every frame with the same colors and
+///             stops don't create and upload a new texture for every draw.
+///
+///             Ramps are keyed by the colors and stops of the gradient, which
+///             are all that the texture depends on. Ramps are released in
+///             `End` once they go unused for `max_unused_frames` consecutive
+///             frames. At most `max_entries` ramps are cached. Ramps that
+///             don't fit are created for the draw only.
+///
+///             Ramps may be requested concurrently from multiple threads.
+///
+class GradientCache {
+ public:
+  static constexpr size_t kDefaultMaxUnusedFrames = 2u;
+  static constexpr size_t kDefaultMaxEntries = 64u;
+
+  explicit GradientCache(size_t max_unused_frames = kDefaultMaxUnusedFrames,
+                         size_t max_entries = kDefaultMaxEntries);
+
+  ~GradientCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the ramp texture of a gradient, either from the cache or
+  ///             by creating it with `context`.
+  ///
+  /// @return     The texture, or nullptr if the gradient is invalid or the
+  ///             texture could not be created.
+  ///
+  std::shared_ptr<Texture> GetOrCreateGradientTexture(
+      const std::vector<Color>& colors,
+      const std::vector<Scalar>& stops,
+      const std::shared_ptr<Context>& context);
+
+  void Start();
+
+  void End();
+
+  /// @brief  The number of gradients whose ramps are currently cached.
+  size_t CachedEntryCount() const;
+
+  /// @brief  The number of requests served from the cache during the last
+  ///         completed frame.
+  size_t GetHitCount() const;
+
+  /// @brief  The number of requests that created a ramp during the last
+  ///         completed frame.
+  size_t GetMissCount() const;
+
+ private:
+  struct Entry {
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+    std::shared_ptr<Texture> texture;
+    size_t unused_frames = 0u;
+    bool used_this_frame = false;
+  };
+
+  const size_t max_unused_frames_;
+  const size_t max_entries_;
+  mutable Mutex mutex_;
+  std::unordered_map<size_t, Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  size_t frame_hits_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t frame_misses_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t last_frame_hits_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t last_frame_misses_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientCache);
+};
+
+}  // namespace impeller
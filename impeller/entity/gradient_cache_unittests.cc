@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "impeller/entity/contents/gradient_generator.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/entity/gradient_cache.h"
+
+namespace impeller {
+namespace testing {
+
+using GradientCacheTest = EntityPlayground;
+INSTANTIATE_PLAYGROUND_SUITE(GradientCacheTest);
+
+TEST_P(GradientCacheTest, ReusesTheRampsOfIdenticalGradients) {
+  GradientCache cache;
+  std::vector<Color> colors = {Color::Red(), Color::Blue()};
+  std::vector<Scalar> stops = {0.0, 1.0};
+
+  cache.Start();
+  auto first = cache.GetOrCreateGradientTexture(colors, stops, GetContext());
+  auto second = cache.GetOrCreateGradientTexture(colors, stops, GetContext());
+  cache.End();
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+  ASSERT_EQ(cache.GetHitCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+
+  // Gradients with other colors or stops get ramps of their own.
+  cache.Start();
+  auto other_colors = cache.GetOrCreateGradientTexture(
+      {Color::Red(), Color::Green()}, stops, GetContext());
+  auto other_stops = cache.GetOrCreateGradientTexture(
+      {Color::Red(), Color::Blue(), Color::Green()}, {0.0, 0.25, 1.0},
+      GetContext());
+  cache.End();
+  ASSERT_NE(other_colors, first);
+  ASSERT_NE(other_stops, first);
+  ASSERT_EQ(cache.CachedEntryCount(), 3u);
+  ASSERT_EQ(cache.GetHitCount(), 0u);
+  ASSERT_EQ(cache.GetMissCount(), 2u);
+}
+
+TEST_P(GradientCacheTest, ReleasesRampsThatGoUnused) {
+  GradientCache cache(/*max_unused_frames=*/1u);
+  std::vector<Color> colors = {Color::Red(), Color::Blue()};
+  std::vector<Scalar> stops = {0.0, 1.0};
+
+  cache.Start();
+  auto texture = cache.GetOrCreateGradientTexture(colors, stops, GetContext());
+  cache.End();
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedEntryCount(), 0u);
+}
+
+TEST_P(GradientCacheTest, DoesNotCacheMoreThanTheMaximumEntries) {
+  GradientCache cache(GradientCache::kDefaultMaxUnusedFrames,
+                      /*max_entries=*/1u);
+  std::vector<Scalar> stops = {0.0, 1.0};
+
+  cache.Start();
+  auto first = cache.GetOrCreateGradientTexture({Color::Red(), Color::Blue()},
+                                                stops, GetContext());
+  auto second = cache.GetOrCreateGradientTexture(
+      {Color::Red(), Color::Green()}, stops, GetContext());
+  auto third = cache.GetOrCreateGradientTexture({Color::Red(), Color::Green()},
+                                                stops, GetContext());
+  cache.End();
+  // Ramps that don't fit are still created for the draw.
+  ASSERT_NE(second, nullptr);
+  ASSERT_NE(second, third);
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 3u);
+}
+
+TEST(GradientGeneratorTest, SSBOGradientsAreOnlyUsedWhenTheyAreCheaper) {
+  const auto& no_ssbo = kLegacyBackendFeatures;
+  const auto& ssbo = kModernBackendFeatures;
+
+  std::vector<Scalar> two_stops = {0.0, 1.0};
+  ASSERT_FALSE(ShouldUseSSBOGradient(no_ssbo, two_stops));
+  ASSERT_TRUE(ShouldUseSSBOGradient(ssbo, two_stops));
+
+  // Many evenly spaced stops are cheaper to sample from a ramp.
+  std::vector<Scalar> many_stops;
+  for (auto i = 0u; i <= kMaxSSBOGradientStops; i++) {
+    many_stops.push_back(i / static_cast<Scalar>(kMaxSSBOGradientStops));
+  }
+  ASSERT_FALSE(ShouldUseSSBOGradient(ssbo, many_stops));
+
+  // Unless the ramp can't resolve them.
+  many_stops[1] = 0.0005;
+  ASSERT_TRUE(ShouldUseSSBOGradient(ssbo, many_stops));
+  ASSERT_FALSE(ShouldUseSSBOGradient(no_ssbo, many_stops));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -7,17 +7,21 @@
 #include <utility>
 
 #include "impeller/base/validation.h"
+#include "impeller/entity/deferred_submission_scope.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/texture_descriptor.h"
 
 namespace impeller {
 
-InlinePassContext::InlinePassContext(std::shared_ptr<Context> context,
-                                     const RenderTarget& render_target,
-                                     uint32_t pass_texture_reads)
+InlinePassContext::InlinePassContext(
+    std::shared_ptr<Context> context,
+    const RenderTarget& render_target,
+    uint32_t pass_texture_reads,
+    std::shared_ptr<HostBuffer> transients_buffer)
     : context_(std::move(context)),
       render_target_(render_target),
+      transients_buffer_(std::move(transients_buffer)),
       total_pass_reads_(pass_texture_reads) {}
 
 InlinePassContext::~InlinePassContext() {
@@ -48,7 +52,7 @@ bool InlinePassContext::EndPass() {
     return false;
   }
 
-  if (!command_buffer_->SubmitCommands()) {
+  if (!DeferredSubmissionScope::SubmitOrDefer(command_buffer_)) {
     return false;
   }
 
@@ -135,6 +139,7 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
     VALIDATION_LOG << "Could not create render pass.";
     return {};
   }
+  pass_->SetTransientsBuffer(transients_buffer_);
 
   pass_->SetLabel(
       "EntityPass Render Pass: Depth=" + std::to_string(pass_depth) +
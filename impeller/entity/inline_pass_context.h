@@ -5,6 +5,7 @@
 #pragma once
 
 #include "impeller/renderer/context.h"
+#include "impeller/renderer/host_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
 
@@ -19,7 +20,8 @@ class InlinePassContext {
 
   InlinePassContext(std::shared_ptr<Context> context,
                     const RenderTarget& render_target,
-                    uint32_t pass_texture_reads);
+                    uint32_t pass_texture_reads,
+                    std::shared_ptr<HostBuffer> transients_buffer = nullptr);
   ~InlinePassContext();
 
   bool IsValid() const;
@@ -36,6 +38,7 @@ class InlinePassContext {
   RenderTarget render_target_;
   std::shared_ptr<CommandBuffer> command_buffer_;
   std::shared_ptr<RenderPass> pass_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
   uint32_t pass_count_ = 0;
   uint32_t total_pass_reads_ = 0;
 
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_target_cache.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+static bool DescriptorsAreCompatible(const TextureDescriptor& lhs,
+                                     const TextureDescriptor& rhs) {
+  return lhs.storage_mode == rhs.storage_mode &&  //
+         lhs.type == rhs.type &&                  //
+         lhs.format == rhs.format &&              //
+         lhs.size == rhs.size &&                  //
+         lhs.mip_count == rhs.mip_count &&        //
+         lhs.usage == rhs.usage &&                //
+         lhs.sample_count == rhs.sample_count;
+}
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_unused_frames)
+    : RenderTargetAllocator(std::move(allocator)),
+      max_unused_frames_(max_unused_frames) {}
+
+RenderTargetCache::~RenderTargetCache() = default;
+
+void RenderTargetCache::Start() {
+  Lock lock(mutex_);
+  for (auto& td : texture_data_) {
+    td.used_this_frame = false;
+  }
+  frame_hits_ = 0u;
+  frame_misses_ = 0u;
+}
+
+void RenderTargetCache::End() {
+  Lock lock(mutex_);
+  std::vector<TextureData> retain;
+  retain.reserve(texture_data_.size());
+  for (auto& td : texture_data_) {
+    if (td.used_this_frame) {
+      td.unused_frames = 0u;
+    } else {
+      td.unused_frames++;
+    }
+    // Textures still referenced outside the cache must be kept regardless of
+    // age, they are only eligible for eviction once they are free again.
+    if (td.unused_frames <= max_unused_frames_ || td.texture.use_count() > 1) {
+      retain.push_back(std::move(td));
+    }
+  }
+  texture_data_ = std::move(retain);
+
+  last_frame_hits_ = frame_hits_;
+  last_frame_misses_ = frame_misses_;
+
+  FML_TRACE_COUNTER("impeller",                                           //
+                    "RenderTargetCache", reinterpret_cast<int64_t>(this),  //
+                    "CachedTextures", texture_data_.size(),               //
+                    "Hits", last_frame_hits_,                             //
+                    "Misses", last_frame_misses_);
+}
+
+std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
+    const TextureDescriptor& desc) {
+  FML_DCHECK(desc.storage_mode != StorageMode::kHostVisible);
+  Lock lock(mutex_);
+  for (auto& td : texture_data_) {
+    if (td.used_this_frame || td.texture.use_count() > 1) {
+      continue;
+    }
+    if (DescriptorsAreCompatible(td.descriptor, desc)) {
+      td.used_this_frame = true;
+      frame_hits_++;
+      return td.texture;
+    }
+  }
+
+  auto result = RenderTargetAllocator::CreateTexture(desc);
+  if (!result) {
+    return nullptr;
+  }
+  frame_misses_++;
+  texture_data_.push_back(TextureData{
+      .descriptor = desc,
+      .texture = result,
+      .unused_frames = 0u,
+      .used_this_frame = true,
+  });
+  return result;
+}
+
+size_t RenderTargetCache::CachedTextureCount() const {
+  Lock lock(mutex_);
+  return texture_data_.size();
+}
+
+size_t RenderTargetCache::GetHitCount() const {
+  Lock lock(mutex_);
+  return last_frame_hits_;
+}
+
+size_t RenderTargetCache::GetMissCount() const {
+  Lock lock(mutex_);
+  return last_frame_misses_;
+}
+
+}  // namespace impeller
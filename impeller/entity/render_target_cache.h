@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render target allocator that recycles textures across frames.
+///
+///             Textures are keyed by their full descriptor (size, format,
+///             sample count, storage mode, usage...). A texture is considered
+///             free once the cache holds the only reference to it. Textures
+///             that go unused for `max_unused_frames` consecutive frames are
+///             released back to the underlying allocator in `End`.
+///
+///             Textures may be requested concurrently from multiple threads.
+///
+class RenderTargetCache : public RenderTargetAllocator {
+ public:
+  static constexpr size_t kDefaultMaxUnusedFrames = 2u;
+
+  explicit RenderTargetCache(
+      std::shared_ptr<Allocator> allocator,
+      size_t max_unused_frames = kDefaultMaxUnusedFrames);
+
+  ~RenderTargetCache() override;
+
+  // |RenderTargetAllocator|
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc) override;
+
+  // |RenderTargetAllocator|
+  void Start() override;
+
+  // |RenderTargetAllocator|
+  void End() override;
+
+  /// @brief  The number of textures currently owned by the cache, whether or
+  ///         not they are in use.
+  size_t CachedTextureCount() const;
+
+  /// @brief  The number of texture requests served from the cache during the
+  ///         last completed frame.
+  size_t GetHitCount() const;
+
+  /// @brief  The number of texture requests that required a new allocation
+  ///         during the last completed frame.
+  size_t GetMissCount() const;
+
+ private:
+  struct TextureData {
+    TextureDescriptor descriptor;
+    std::shared_ptr<Texture> texture;
+    size_t unused_frames = 0u;
+    bool used_this_frame = false;
+  };
+
+  const size_t max_unused_frames_;
+  mutable Mutex mutex_;
+  std::vector<TextureData> texture_data_ IPLR_GUARDED_BY(mutex_);
+  size_t frame_hits_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t frame_misses_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t last_frame_hits_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t last_frame_misses_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
+};
+
+}  // namespace impeller
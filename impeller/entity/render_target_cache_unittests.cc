@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+namespace testing {
+
+using RenderTargetCacheTest = EntityPlayground;
+INSTANTIATE_PLAYGROUND_SUITE(RenderTargetCacheTest);
+
+static TextureDescriptor MakeRenderTargetDescriptor(ISize size) {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = size;
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  return desc;
+}
+
+TEST_P(RenderTargetCacheTest, CachesTexturesAcrossFrames) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+  auto desc = MakeRenderTargetDescriptor({100, 100});
+
+  cache.Start();
+  auto texture = cache.CreateTexture(desc);
+  ASSERT_NE(texture, nullptr);
+  auto* texture_pointer = texture.get();
+  texture = nullptr;
+  cache.End();
+
+  ASSERT_EQ(cache.CachedTextureCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+
+  cache.Start();
+  texture = cache.CreateTexture(desc);
+  ASSERT_EQ(texture.get(), texture_pointer);
+  texture = nullptr;
+  cache.End();
+
+  ASSERT_EQ(cache.CachedTextureCount(), 1u);
+  ASSERT_EQ(cache.GetHitCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 0u);
+}
+
+TEST_P(RenderTargetCacheTest, DoesNotReuseTexturesInUse) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+  auto desc = MakeRenderTargetDescriptor({100, 100});
+
+  cache.Start();
+  auto texture_a = cache.CreateTexture(desc);
+  auto texture_b = cache.CreateTexture(desc);
+  cache.End();
+
+  ASSERT_NE(texture_a, texture_b);
+  ASSERT_EQ(cache.CachedTextureCount(), 2u);
+
+  // A texture held outside of the cache is never handed out again.
+  cache.Start();
+  texture_b = nullptr;
+  auto texture_c = cache.CreateTexture(desc);
+  ASSERT_NE(texture_c, texture_a);
+  cache.End();
+}
+
+TEST_P(RenderTargetCacheTest, DoesNotMatchDifferentDescriptors) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+
+  cache.Start();
+  cache.CreateTexture(MakeRenderTargetDescriptor({100, 100}));
+  cache.End();
+
+  cache.Start();
+  cache.CreateTexture(MakeRenderTargetDescriptor({200, 100}));
+  cache.End();
+
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+  ASSERT_EQ(cache.CachedTextureCount(), 2u);
+}
+
+TEST_P(RenderTargetCacheTest, EvictsTexturesAfterUnusedFrames) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator(),
+                          /*max_unused_frames=*/1u);
+
+  cache.Start();
+  cache.CreateTexture(MakeRenderTargetDescriptor({100, 100}));
+  cache.End();
+  ASSERT_EQ(cache.CachedTextureCount(), 1u);
+
+  // First unused frame, texture is retained.
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedTextureCount(), 1u);
+
+  // Second unused frame, texture is evicted.
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedTextureCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,37 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+// Draws the color of one sprite of an atlas per instance, like
+// atlas_instanced_texture.vert does with its texture.
+
+// This must match AtlasInstance in atlas_contents.cc.
+struct AtlasInstance {
+  mat4 transform;
+  vec4 texture_rect;
+  vec4 color;
+};
+
+layout(std430) readonly buffer InstanceData {
+  AtlasInstance instances[];
+}
+instance_data;
+
+uniform FrameInfo {
+  mat4 mvp;
+}
+frame_info;
+
+in vec2 unit_position;
+
+out vec4 v_color;
+
+void main() {
+  AtlasInstance instance = instance_data.instances[gl_InstanceIndex];
+  vec2 local_position = unit_position * instance.texture_rect.zw;
+  gl_Position =
+      frame_info.mvp * instance.transform * vec4(local_position, 0.0, 1.0);
+  v_color = instance.color;
+}
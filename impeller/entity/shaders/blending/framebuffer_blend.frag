@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Blends the source texture with the color attachment it is drawn to, which
+// is read with framebuffer fetch. Unlike the "advanced_blend_*" shaders, this
+// doesn't need the destination to be resolved to a texture first. The
+// pipelines are only created on backends that support framebuffer fetch.
+
+#include <impeller/blending.glsl>
+#include <impeller/color.glsl>
+#include <impeller/texture.glsl>
+#include <impeller/types.glsl>
+
+// The values of the advanced blend modes of `impeller::BlendMode`.
+const float kBlendModeScreen = 14;
+const float kBlendModeOverlay = 15;
+const float kBlendModeDarken = 16;
+const float kBlendModeLighten = 17;
+const float kBlendModeColorDodge = 18;
+const float kBlendModeColorBurn = 19;
+const float kBlendModeHardLight = 20;
+const float kBlendModeSoftLight = 21;
+const float kBlendModeDifference = 22;
+const float kBlendModeExclusion = 23;
+const float kBlendModeMultiply = 24;
+const float kBlendModeHue = 25;
+const float kBlendModeSaturation = 26;
+const float kBlendModeColor = 27;
+
+uniform BlendInfo {
+  float blend_mode;
+  float src_input_alpha;
+  float src_y_coord_scale;
+}
+blend_info;
+
+uniform sampler2D texture_sampler_src;
+
+layout(input_attachment_index = 0) uniform subpassInput framebuffer_dst;
+
+in vec2 v_src_texture_coords;
+
+out vec4 frag_color;
+
+vec3 Blend(vec3 dst, vec3 src) {
+  // The mode is the same for all fragments of a draw, so this doesn't
+  // diverge.
+  float mode = blend_info.blend_mode;
+  if (mode == kBlendModeScreen) {
+    return IPBlendScreen(dst, src);
+  }
+  if (mode == kBlendModeOverlay) {
+    return IPBlendOverlay(dst, src);
+  }
+  if (mode == kBlendModeDarken) {
+    return IPBlendDarken(dst, src);
+  }
+  if (mode == kBlendModeLighten) {
+    return IPBlendLighten(dst, src);
+  }
+  if (mode == kBlendModeColorDodge) {
+    return IPBlendColorDodge(dst, src);
+  }
+  if (mode == kBlendModeColorBurn) {
+    return IPBlendColorBurn(dst, src);
+  }
+  if (mode == kBlendModeHardLight) {
+    return IPBlendHardLight(dst, src);
+  }
+  if (mode == kBlendModeSoftLight) {
+    return IPBlendSoftLight(dst, src);
+  }
+  if (mode == kBlendModeDifference) {
+    return IPBlendDifference(dst, src);
+  }
+  if (mode == kBlendModeExclusion) {
+    return IPBlendExclusion(dst, src);
+  }
+  if (mode == kBlendModeMultiply) {
+    return IPBlendMultiply(dst, src);
+  }
+  if (mode == kBlendModeHue) {
+    return IPBlendHue(dst, src);
+  }
+  if (mode == kBlendModeSaturation) {
+    return IPBlendSaturation(dst, src);
+  }
+  if (mode == kBlendModeColor) {
+    return IPBlendColor(dst, src);
+  }
+  return IPBlendLuminosity(dst, src);
+}
+
+void main() {
+  vec4 dst_sample = subpassLoad(framebuffer_dst);
+  vec4 dst = IPUnpremultiply(dst_sample);
+  vec4 src = IPUnpremultiply(
+      IPSampleWithTileMode(texture_sampler_src,           // sampler
+                           v_src_texture_coords,          // texture coordinates
+                           blend_info.src_y_coord_scale,  // y coordinate scale
+                           kTileModeDecal                 // tile mode
+                           ) *
+      blend_info.src_input_alpha);
+
+  vec4 blended = vec4(Blend(dst.rgb, src.rgb), 1) * dst.a;
+
+  frag_color = mix(dst_sample, blended, src.a);
+}
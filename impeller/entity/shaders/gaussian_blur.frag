@@ -4,7 +4,13 @@
 
 #include <impeller/texture.glsl>
 
+// Specialized by the pipelines of blurs with a decal tile mode.
+layout(constant_id = 0) const bool kDecal = false;
+
 vec4 Sample(sampler2D tex, vec2 coords) {
+  if (kDecal) {
+    return IPSampleDecal(tex, coords);
+  }
   return texture(tex, coords);
 }
 
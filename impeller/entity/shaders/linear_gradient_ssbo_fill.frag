@@ -58,4 +58,5 @@ void main() {
   }
   frag_color = vec4(result_color.xyz * result_color.a, result_color.a) *
                gradient_info.alpha;
+  frag_color = IPGradientDither(frag_color, gl_FragCoord.xy);
 }
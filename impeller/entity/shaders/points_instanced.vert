@@ -0,0 +1,28 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+// Draws one point per instance. The vertices are the shape of a point of
+// radius 1 around the origin, which each instance scales and moves to its
+// center.
+
+layout(std430) readonly buffer PointData {
+  vec2 centers[];
+}
+point_data;
+
+uniform FrameInfo {
+  mat4 mvp;
+  float radius;
+}
+frame_info;
+
+in vec2 unit_position;
+
+void main() {
+  vec2 position =
+      point_data.centers[gl_InstanceIndex] + unit_position * frame_info.radius;
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+}
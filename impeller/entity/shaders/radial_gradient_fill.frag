@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <impeller/gradient.glsl>
 #include <impeller/texture.glsl>
 #include <impeller/types.glsl>
 
@@ -30,4 +31,5 @@ void main() {
       gradient_info.tile_mode);
   frag_color =
       vec4(frag_color.xyz * frag_color.a, frag_color.a) * gradient_info.alpha;
+  frag_color = IPGradientDither(frag_color, gl_FragCoord.xy);
 }
@@ -10,6 +10,10 @@ uniform FragInfo {
   float blur_sigma;
   vec2 rect_size;
   float corner_radius;
+  // The ratio of the horizontal to the vertical corner radius. The shadow is
+  // computed in a space that is scaled vertically by it, in which the corners
+  // are circular with the horizontal radius.
+  float corner_aspect;
 }
 frag_info;
 
@@ -45,9 +49,13 @@ float RRectShadowX(vec2 sample_position, vec2 half_size) {
 }
 
 float RRectShadow(vec2 sample_position, vec2 half_size) {
+  // The scaled space stretches the blur in the Y direction along with the
+  // shape.
+  float blur_sigma_y = frag_info.blur_sigma * frag_info.corner_aspect;
+
   // Limit the sampling range to 3 standard deviations in the Y direction from
   // the kernel center to incorporate 99.7% of the color contribution.
-  float half_sampling_range = frag_info.blur_sigma * 3;
+  float half_sampling_range = blur_sigma_y * 3;
 
   float begin_y = max(-half_sampling_range, sample_position.y - half_size.y);
   float end_y = min(half_sampling_range, sample_position.y + half_size.y);
@@ -59,7 +67,7 @@ float RRectShadow(vec2 sample_position, vec2 half_size) {
     float y = begin_y + interval * (sample_i + 0.5);
     result += RRectShadowX(vec2(sample_position.x, sample_position.y - y),
                            half_size) *
-              IPGaussian(y, frag_info.blur_sigma) * interval;
+              IPGaussian(y, blur_sigma_y) * interval;
   }
 
   return result;
@@ -68,8 +76,9 @@ float RRectShadow(vec2 sample_position, vec2 half_size) {
 void main() {
   frag_color = frag_info.color;
 
-  vec2 half_size = frag_info.rect_size * 0.5;
-  vec2 sample_position = v_position - half_size;
+  vec2 scale = vec2(1.0, frag_info.corner_aspect);
+  vec2 half_size = frag_info.rect_size * 0.5 * scale;
+  vec2 sample_position = v_position * scale - half_size;
 
   if (frag_info.blur_sigma > 0) {
     frag_color *= RRectShadow(sample_position, half_size);
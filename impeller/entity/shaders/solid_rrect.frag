@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Fills or strokes a rounded rect with elliptical corners, anti-aliased by
+// the coverage of each pixel that the distance to its edge gives. This does
+// not need a multisampled render target.
+
+#include <impeller/types.glsl>
+
+uniform FragInfo {
+  vec4 color;
+  vec2 rect_size;
+  vec2 corner_radii;
+  // Zero for fills.
+  float stroke_width;
+}
+frag_info;
+
+in vec2 v_position;
+
+out vec4 frag_color;
+
+/// Approximate signed distance from the edge of the rounded rect, in local
+/// units, along with the direction in which it grows fastest.
+float RRectDistance(vec2 sample_position, vec2 half_size, out vec2 direction) {
+  vec2 radii = frag_info.corner_radii;
+  vec2 quadrant = vec2(sample_position.x < 0.0 ? -1.0 : 1.0,
+                       sample_position.y < 0.0 ? -1.0 : 1.0);
+  vec2 position = abs(sample_position);
+  vec2 corner = position - half_size + radii;
+
+  float edge_distance;
+  if (corner.x > 0.0 && corner.y > 0.0 && radii.x > 0.0 && radii.y > 0.0) {
+    // The implicit function of the ellipse divided by the length of its
+    // gradient, which is exact for circles.
+    vec2 scaled = corner / radii;
+    float scaled_length = length(scaled);
+    vec2 gradient = scaled / radii;
+    float gradient_length = length(gradient);
+    edge_distance = (scaled_length - 1.0) * scaled_length / gradient_length;
+    direction = gradient / gradient_length;
+  } else {
+    vec2 edge = position - half_size;
+    if (edge.x > edge.y) {
+      edge_distance = edge.x;
+      direction = vec2(1.0, 0.0);
+    } else {
+      edge_distance = edge.y;
+      direction = vec2(0.0, 1.0);
+    }
+  }
+  direction *= quadrant;
+
+  if (frag_info.stroke_width > 0.0) {
+    direction *= edge_distance < 0.0 ? -1.0 : 1.0;
+    edge_distance = abs(edge_distance) - frag_info.stroke_width * 0.5;
+  }
+  return edge_distance;
+}
+
+void main() {
+  vec2 half_size = frag_info.rect_size * 0.5;
+  vec2 direction;
+  float edge_distance =
+      RRectDistance(v_position - half_size, half_size, direction);
+
+  // How fast the distance changes from one pixel to the next, which converts
+  // it to pixels.
+  float pixel_rate = length(vec2(dot(direction, dFdx(v_position)),
+                                 dot(direction, dFdy(v_position))));
+  float coverage =
+      clamp(0.5 - edge_distance / max(pixel_rate, 1e-6), 0.0, 1.0);
+
+  frag_color = frag_info.color * coverage;
+}
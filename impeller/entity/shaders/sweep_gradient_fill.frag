@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <impeller/constants.glsl>
+#include <impeller/gradient.glsl>
 #include <impeller/texture.glsl>
 #include <impeller/types.glsl>
 
@@ -35,4 +36,5 @@ void main() {
       gradient_info.tile_mode);
   frag_color =
       vec4(frag_color.xyz * frag_color.a, frag_color.a) * gradient_info.alpha;
+  frag_color = IPGradientDither(frag_color, gl_FragCoord.xy);
 }
@@ -0,0 +1,34 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/color.glsl>
+#include <impeller/texture.glsl>
+#include <impeller/types.glsl>
+
+uniform sampler2D y_texture;
+uniform sampler2D uv_texture;
+
+uniform FragInfo {
+  float texture_sampler_y_coord_scale;
+  float alpha;
+  mat4 matrix;
+  float yuv_color_space;
+}
+frag_info;
+
+in vec2 v_texture_coords;
+
+out vec4 frag_color;
+
+void main() {
+  vec3 yuv;
+  yuv.x = IPSample(y_texture, v_texture_coords,
+                   frag_info.texture_sampler_y_coord_scale)
+              .r;
+  yuv.yz = IPSample(uv_texture, v_texture_coords,
+                    frag_info.texture_sampler_y_coord_scale)
+               .rg;
+  frag_color = IPYUVToRGB(yuv, frag_info.matrix, frag_info.yuv_color_space) *
+               frag_info.alpha;
+}
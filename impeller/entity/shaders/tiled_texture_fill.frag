@@ -5,6 +5,10 @@
 #include <impeller/texture.glsl>
 #include <impeller/types.glsl>
 
+// Specialized by the pipelines of textures whose tile modes are applied by
+// the address modes of the sampler rather than emulated here.
+layout(constant_id = 0) const bool kSamplerTileModes = false;
+
 uniform sampler2D texture_sampler;
 
 uniform FragInfo {
@@ -20,6 +24,12 @@ in vec2 v_texture_coords;
 out vec4 frag_color;
 
 void main() {
+  if (kSamplerTileModes) {
+    frag_color = IPSample(texture_sampler, v_texture_coords,
+                          frag_info.texture_sampler_y_coord_scale) *
+                 frag_info.alpha;
+    return;
+  }
   frag_color =
       IPSampleWithTileMode(
           texture_sampler,                          // sampler
@@ -9,11 +9,6 @@
 uniform sampler2D y_texture;
 uniform sampler2D uv_texture;
 
-// These values must correspond to the order of the items in the
-// 'YUVColorSpace' enum class.
-const float kBT601LimitedRange = 0;
-const float kBT601FullRange = 1;
-
 uniform FragInfo {
   float texture_sampler_y_coord_scale;
   mat4 matrix;
@@ -26,16 +21,11 @@ out vec4 frag_color;
 
 void main() {
   vec3 yuv;
-  vec3 yuv_offset = vec3(0.0, 0.5, 0.5);
-  if (frag_info.yuv_color_space == kBT601LimitedRange) {
-    yuv_offset.x = 16.0 / 255.0;
-  }
-
   yuv.x =
       IPSample(y_texture, v_position, frag_info.texture_sampler_y_coord_scale)
           .r;
   yuv.yz =
       IPSample(uv_texture, v_position, frag_info.texture_sampler_y_coord_scale)
           .rg;
-  frag_color = frag_info.matrix * vec4(yuv - yuv_offset, 1);
+  frag_color = IPYUVToRGB(yuv, frag_info.matrix, frag_info.yuv_color_space);
 }
@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_cache.h"
+
+#include <cmath>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/device_buffer.h"
+
+namespace impeller {
+
+bool TessellationCache::Key::operator==(const Key& other) const {
+  return type == other.type &&                  //
+         scale_bucket == other.scale_bucket &&  //
+         stroke_width == other.stroke_width &&  //
+         miter_limit == other.miter_limit &&    //
+         cap == other.cap &&                    //
+         join == other.join;
+}
+
+TessellationCache::TessellationCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_unused_frames,
+                                     size_t max_bytes)
+    : allocator_(std::move(allocator)),
+      max_unused_frames_(max_unused_frames),
+      max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+// static
+int32_t TessellationCache::GetScaleBucket(Scalar scale) {
+  if (!(scale > 0.0f)) {
+    return 0;
+  }
+  return static_cast<int32_t>(std::ceil(std::log2(scale) * 4.0f));
+}
+
+// static
+Scalar TessellationCache::GetBucketScale(int32_t scale_bucket) {
+  return std::exp2(scale_bucket / 4.0f);
+}
+
+std::optional<TessellationCache::Entry> TessellationCache::CreateEntry(
+    const Path& path,
+    const Key& key,
+    const VertexGenerator& generator) const {
+  TRACE_EVENT0("impeller", "TessellationCache::CreateEntry");
+  auto host_buffer = HostBuffer::Create();
+  auto vertex_buffer = generator(*host_buffer);
+  if (!vertex_buffer || host_buffer->GetLength() == 0u ||
+      vertex_buffer.vertex_buffer.buffer != host_buffer ||
+      vertex_buffer.index_buffer.buffer != host_buffer) {
+    return std::nullopt;
+  }
+
+  auto device_buffer = allocator_->CreateBufferWithCopy(
+      host_buffer->GetBuffer(), host_buffer->GetLength());
+  if (!device_buffer) {
+    return std::nullopt;
+  }
+  device_buffer->SetLabel("TessellationCache Vertices");
+
+  // The views keep their ranges, which are the same in the device buffer.
+  auto device_view = device_buffer->AsBufferView();
+  vertex_buffer.vertex_buffer.buffer = device_view.buffer;
+  vertex_buffer.vertex_buffer.contents = device_view.contents;
+  vertex_buffer.index_buffer.buffer = device_view.buffer;
+  vertex_buffer.index_buffer.contents = device_view.contents;
+  return Entry{
+      .path = path,
+      .key = key,
+      .vertex_buffer = vertex_buffer,
+      .bytes = host_buffer->GetLength(),
+      .unused_frames = 0u,
+      .used_this_frame = true,
+  };
+}
+
+VertexBuffer TessellationCache::GetOrCreateVertices(
+    const Path& path,
+    const Key& key,
+    HostBuffer& transients_buffer,
+    const VertexGenerator& generator) {
+  const size_t hash =
+      fml::HashCombine(path.GetHash(), key.type, key.scale_bucket,
+                       key.stroke_width, key.miter_limit, key.cap, key.join);
+
+  bool should_cache = false;
+  {
+    Lock lock(mutex_);
+    if (auto found = entries_.find(hash); found != entries_.end()) {
+      auto& entry = found->second;
+      if (entry.key == key && entry.path == path) {
+        entry.used_this_frame = true;
+        frame_hits_++;
+        return entry.vertex_buffer;
+      }
+      // A different path with the same hash is already cached.
+    } else {
+      auto [candidate, inserted] = candidates_.try_emplace(hash);
+      candidate->second.used_this_frame = true;
+      should_cache = !inserted && cached_bytes_ < max_bytes_;
+    }
+    frame_misses_++;
+  }
+
+  if (should_cache) {
+    // The vertices are created without holding the lock, so that other paths
+    // may be tessellated concurrently.
+    if (auto entry = CreateEntry(path, key, generator)) {
+      auto vertex_buffer = entry->vertex_buffer;
+      Lock lock(mutex_);
+      if (cached_bytes_ + entry->bytes <= max_bytes_ &&
+          entries_.find(hash) == entries_.end()) {
+        candidates_.erase(hash);
+        cached_bytes_ += entry->bytes;
+        entries_.emplace(hash, std::move(entry.value()));
+      }
+      return vertex_buffer;
+    }
+  }
+
+  return generator(transients_buffer);
+}
+
+void TessellationCache::Start() {
+  Lock lock(mutex_);
+  for (auto& [hash, entry] : entries_) {
+    entry.used_this_frame = false;
+  }
+  for (auto& [hash, candidate] : candidates_) {
+    candidate.used_this_frame = false;
+  }
+  frame_hits_ = 0u;
+  frame_misses_ = 0u;
+}
+
+void TessellationCache::End() {
+  Lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto& entry = it->second;
+    entry.unused_frames = entry.used_this_frame ? 0u : entry.unused_frames + 1;
+    if (entry.unused_frames > max_unused_frames_) {
+      cached_bytes_ -= entry.bytes;
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = candidates_.begin(); it != candidates_.end();) {
+    auto& candidate = it->second;
+    candidate.unused_frames =
+        candidate.used_this_frame ? 0u : candidate.unused_frames + 1;
+    if (candidate.unused_frames > max_unused_frames_) {
+      it = candidates_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  last_frame_hits_ = frame_hits_;
+  last_frame_misses_ = frame_misses_;
+
+  FML_TRACE_COUNTER("impeller",                                           //
+                    "TessellationCache", reinterpret_cast<int64_t>(this),  //
+                    "CachedEntries", entries_.size(),                     //
+                    "CachedBytes", cached_bytes_,                         //
+                    "Hits", last_frame_hits_,                             //
+                    "Misses", last_frame_misses_);
+}
+
+size_t TessellationCache::CachedEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t TessellationCache::GetCachedBytes() const {
+  Lock lock(mutex_);
+  return cached_bytes_;
+}
+
+size_t TessellationCache::GetHitCount() const {
+  Lock lock(mutex_);
+  return last_frame_hits_;
+}
+
+size_t TessellationCache::GetMissCount() const {
+  Lock lock(mutex_);
+  return last_frame_misses_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,147 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/entity/geometry.h"
+#include "impeller/geometry/path.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/vertex_buffer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the vertices that geometries create from paths, so
+///             that static paths drawn with animated transforms are not
+///             tessellated again every frame.
+///
+///             Vertices are keyed by the content of the path and by the
+///             parameters of the geometry, which include a bucket of the scale
+///             the path is drawn at. A path is only cached the second time it
+///             is drawn within `max_unused_frames` frames of its first draw,
+///             since paths that change every frame would never be hit. Cached
+///             vertices are copied into a device buffer of their own and are
+///             released in `End` once they go unused for `max_unused_frames`
+///             consecutive frames.
+///
+///             Vertices may be requested concurrently from multiple threads.
+///
+class TessellationCache {
+ public:
+  static constexpr size_t kDefaultMaxUnusedFrames = 2u;
+  static constexpr size_t kDefaultMaxBytes = 8u * 1024u * 1024u;
+
+  /// The parameters other than the path that the vertices depend on.
+  struct Key {
+    enum class Type {
+      kFill,
+      kStroke,
+    };
+
+    Type type = Type::kFill;
+    int32_t scale_bucket = 0;
+    Scalar stroke_width = 0.0f;
+    Scalar miter_limit = 0.0f;
+    Cap cap = Cap::kButt;
+    Join join = Join::kMiter;
+
+    bool operator==(const Key& other) const;
+  };
+
+  /// Creates the vertices of a path into the given buffer. The result is only
+  /// cached if it is valid.
+  using VertexGenerator = std::function<VertexBuffer(HostBuffer& buffer)>;
+
+  explicit TessellationCache(std::shared_ptr<Allocator> allocator,
+                             size_t max_unused_frames = kDefaultMaxUnusedFrames,
+                             size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the bucket of the scale a path is drawn at. Each bucket
+  ///             covers a quarter of a power of two.
+  ///
+  static int32_t GetScaleBucket(Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the largest scale in a bucket. Curves are flattened for
+  ///             this scale so that the vertices are precise enough for every
+  ///             scale in the bucket.
+  ///
+  static Scalar GetBucketScale(int32_t scale_bucket);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the vertices of a path, either from the cache or from
+  ///             `generator`. Vertices that are not cached are created into
+  ///             `transients_buffer`.
+  ///
+  VertexBuffer GetOrCreateVertices(const Path& path,
+                                   const Key& key,
+                                   HostBuffer& transients_buffer,
+                                   const VertexGenerator& generator);
+
+  void Start();
+
+  void End();
+
+  /// @brief  The number of paths whose vertices are currently cached.
+  size_t CachedEntryCount() const;
+
+  /// @brief  The size of the device buffers of the cached vertices.
+  size_t GetCachedBytes() const;
+
+  /// @brief  The number of requests served from the cache during the last
+  ///         completed frame.
+  size_t GetHitCount() const;
+
+  /// @brief  The number of requests that created vertices during the last
+  ///         completed frame.
+  size_t GetMissCount() const;
+
+ private:
+  struct Entry {
+    Path path;
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t bytes = 0u;
+    size_t unused_frames = 0u;
+    bool used_this_frame = false;
+  };
+
+  struct Candidate {
+    size_t unused_frames = 0u;
+    bool used_this_frame = false;
+  };
+
+  std::optional<Entry> CreateEntry(const Path& path,
+                                   const Key& key,
+                                   const VertexGenerator& generator) const;
+
+  const std::shared_ptr<Allocator> allocator_;
+  const size_t max_unused_frames_;
+  const size_t max_bytes_;
+  mutable Mutex mutex_;
+  std::unordered_map<size_t, Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  // The hashes of the paths that were drawn once and may be cached if they
+  // are drawn again.
+  std::unordered_map<size_t, Candidate> candidates_ IPLR_GUARDED_BY(mutex_);
+  size_t cached_bytes_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t frame_hits_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t frame_misses_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t last_frame_hits_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t last_frame_misses_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
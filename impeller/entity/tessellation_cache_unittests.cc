@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "impeller/entity/entity_playground.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/geometry/path_builder.h"
+
+namespace impeller {
+namespace testing {
+
+using TessellationCacheTest = EntityPlayground;
+INSTANTIATE_PLAYGROUND_SUITE(TessellationCacheTest);
+
+static Path MakeTrianglePath(Scalar size) {
+  return PathBuilder{}
+      .MoveTo({0, 0})
+      .LineTo({size, 0})
+      .LineTo({0, size})
+      .Close()
+      .TakePath();
+}
+
+// Creates the vertices of a triangle and counts the calls.
+static TessellationCache::VertexGenerator MakeGenerator(int& calls) {
+  return [&calls](HostBuffer& buffer) {
+    calls++;
+    const float vertices[] = {0, 0, 1, 0, 0, 1};
+    const uint16_t indices[] = {0, 1, 2};
+    VertexBuffer vertex_buffer;
+    vertex_buffer.vertex_buffer =
+        buffer.Emplace(vertices, sizeof(vertices), alignof(float));
+    vertex_buffer.index_buffer =
+        buffer.Emplace(indices, sizeof(indices), alignof(uint16_t));
+    vertex_buffer.index_count = 3u;
+    vertex_buffer.index_type = IndexType::k16bit;
+    return vertex_buffer;
+  };
+}
+
+TEST_P(TessellationCacheTest, CachesPathsDrawnAgainInALaterFrame) {
+  TessellationCache cache(GetContext()->GetResourceAllocator());
+  auto transients = HostBuffer::Create();
+  auto path = MakeTrianglePath(100);
+  int calls = 0;
+  auto generator = MakeGenerator(calls);
+
+  // The first draw of a path is not cached.
+  cache.Start();
+  auto first = cache.GetOrCreateVertices(path, {}, *transients, generator);
+  cache.End();
+  ASSERT_EQ(calls, 1);
+  ASSERT_EQ(first.vertex_buffer.buffer, transients);
+  ASSERT_EQ(cache.CachedEntryCount(), 0u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+
+  cache.Start();
+  auto second = cache.GetOrCreateVertices(path, {}, *transients, generator);
+  cache.End();
+  ASSERT_EQ(calls, 2);
+  ASSERT_NE(second.vertex_buffer.buffer, transients);
+  ASSERT_EQ(second.vertex_buffer.buffer, second.index_buffer.buffer);
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+  ASSERT_GT(cache.GetCachedBytes(), 0u);
+
+  // An equal path hits the cache.
+  cache.Start();
+  auto third = cache.GetOrCreateVertices(MakeTrianglePath(100), {},
+                                         *transients, generator);
+  cache.End();
+  ASSERT_EQ(calls, 2);
+  ASSERT_EQ(third.vertex_buffer.buffer, second.vertex_buffer.buffer);
+  ASSERT_EQ(third.index_buffer.range.offset, second.index_buffer.range.offset);
+  ASSERT_EQ(third.index_count, 3u);
+  ASSERT_EQ(cache.GetHitCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 0u);
+}
+
+TEST_P(TessellationCacheTest, DoesNotMatchDifferentPathsOrKeys) {
+  TessellationCache cache(GetContext()->GetResourceAllocator());
+  auto transients = HostBuffer::Create();
+  int calls = 0;
+  auto generator = MakeGenerator(calls);
+  TessellationCache::Key scaled_key = {.scale_bucket = 4};
+
+  for (int frame = 0; frame < 3; frame++) {
+    cache.Start();
+    cache.GetOrCreateVertices(MakeTrianglePath(100), {}, *transients,
+                              generator);
+    cache.GetOrCreateVertices(MakeTrianglePath(200), {}, *transients,
+                              generator);
+    cache.GetOrCreateVertices(MakeTrianglePath(100), scaled_key, *transients,
+                              generator);
+    cache.End();
+  }
+
+  // Each of the three was created in the first two frames only.
+  ASSERT_EQ(calls, 6);
+  ASSERT_EQ(cache.CachedEntryCount(), 3u);
+  ASSERT_EQ(cache.GetHitCount(), 3u);
+}
+
+TEST_P(TessellationCacheTest, EvictsVerticesAfterUnusedFrames) {
+  TessellationCache cache(GetContext()->GetResourceAllocator(),
+                          /*max_unused_frames=*/1u);
+  auto transients = HostBuffer::Create();
+  auto path = MakeTrianglePath(100);
+  int calls = 0;
+  auto generator = MakeGenerator(calls);
+
+  for (int frame = 0; frame < 2; frame++) {
+    cache.Start();
+    cache.GetOrCreateVertices(path, {}, *transients, generator);
+    cache.End();
+  }
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+
+  // First unused frame, the vertices are retained.
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedEntryCount(), 1u);
+
+  // Second unused frame, the vertices are evicted.
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedEntryCount(), 0u);
+  ASSERT_EQ(cache.GetCachedBytes(), 0u);
+}
+
+TEST_P(TessellationCacheTest, DoesNotCacheBeyondItsBudget) {
+  TessellationCache cache(GetContext()->GetResourceAllocator(),
+                          TessellationCache::kDefaultMaxUnusedFrames,
+                          /*max_bytes=*/1u);
+  auto transients = HostBuffer::Create();
+  auto path = MakeTrianglePath(100);
+  int calls = 0;
+  auto generator = MakeGenerator(calls);
+
+  for (int frame = 0; frame < 3; frame++) {
+    cache.Start();
+    auto vertex_buffer =
+        cache.GetOrCreateVertices(path, {}, *transients, generator);
+    ASSERT_TRUE(vertex_buffer);
+    cache.End();
+  }
+  ASSERT_EQ(calls, 3);
+  ASSERT_EQ(cache.CachedEntryCount(), 0u);
+}
+
+TEST(TessellationCacheScaleTest, BucketScalesCoverTheirScales) {
+  for (Scalar scale : {0.1f, 0.5f, 1.0f, 1.1f, 2.0f, 3.0f, 17.5f}) {
+    auto bucket = TessellationCache::GetBucketScale(
+        TessellationCache::GetScaleBucket(scale));
+    ASSERT_GE(bucket * 1.0001f, scale);
+    ASSERT_LT(bucket, scale * 1.19f);
+  }
+  ASSERT_EQ(TessellationCache::GetScaleBucket(1.0f), 0);
+  ASSERT_EQ(TessellationCache::GetScaleBucket(2.0f), 4);
+  ASSERT_EQ(TessellationCache::GetScaleBucket(0.0f), 0);
+}
+
+}  // namespace testing
+}  // namespace impeller
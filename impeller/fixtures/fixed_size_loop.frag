@@ -0,0 +1,20 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+uniform sampler2D texture_sampler;
+
+in vec2 v_texture_coords;
+
+out vec4 frag_color;
+
+const float kWeights[4] = float[](0.4, 0.3, 0.2, 0.1);
+
+void main() {
+  vec4 color = vec4(0.0);
+  for (int i = 0; i < 4; i++) {
+    color += kWeights[i] *
+             texture(texture_sampler, v_texture_coords + vec2(float(i), 0.0));
+  }
+  frag_color = color;
+}
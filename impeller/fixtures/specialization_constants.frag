@@ -0,0 +1,19 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+layout(constant_id = 0) const bool kUseColor = true;
+layout(constant_id = 3) const float kScale = 0.5;
+layout(constant_id = 5) const int kCount = 2;
+
+uniform FragInfo {
+  vec4 color;
+}
+frag_info;
+
+out vec4 frag_color;
+
+void main() {
+  vec4 color = kUseColor ? frag_info.color : vec4(1.0);
+  frag_color = color * kScale * float(kCount);
+}
@@ -4,8 +4,15 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include <cstdint>
+#include <vector>
+
+#include "impeller/entity/geometry.h"
+#include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/host_buffer.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -16,6 +23,15 @@ namespace {
 Path CreateCubic();
 /// Similar to the path above, but with all cubics replaced by quadratics.
 Path CreateQuadratic();
+/// A grid of circles, like the dots of a chart.
+Path CreateCircles(size_t count);
+/// A line of glyph outlines made of quadratics, like the ones of TrueType
+/// fonts, with the holes of the letters as separate contours.
+Path CreateTextOutline(size_t glyph_count);
+/// The heart of the Material "favorite" icon, as it is written in SVG.
+Path CreateIcon();
+/// A single self-intersecting contour through random points.
+Path CreateRandomPolygon(size_t point_count);
 }  // namespace
 
 static Tessellator tess;
@@ -48,6 +64,207 @@ BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
 
+static void BM_PolylineAtTolerance(benchmark::State& state,
+                                   Path path,
+                                   Scalar tolerance) {
+  size_t point_count = 0u;
+  while (state.KeepRunning()) {
+    auto polyline = path.CreatePolyline(tolerance);
+    point_count = polyline.points.size();
+    benchmark::DoNotOptimize(polyline);
+  }
+  state.counters["PointCount"] = point_count;
+}
+
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance, cubic_1, CreateCubic(), 1.0f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance, cubic_0_1, CreateCubic(), 0.1f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance, cubic_0_01, CreateCubic(), 0.01f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance, quad_1, CreateQuadratic(), 1.0f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance, quad_0_1, CreateQuadratic(), 0.1f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance,
+                  quad_0_01,
+                  CreateQuadratic(),
+                  0.01f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance, circles_1, CreateCircles(64), 1.0f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance,
+                  circles_0_1,
+                  CreateCircles(64),
+                  0.1f);
+BENCHMARK_CAPTURE(BM_PolylineAtTolerance,
+                  circles_0_01,
+                  CreateCircles(64),
+                  0.01f);
+
+// Creates the vertices of a filled path into a host buffer like
+// |FillPathGeometry::GetPositionBuffer| does when its vertices are not
+// cached, without the render pass that it would upload them to.
+static void BM_FillVertices(benchmark::State& state, Path path) {
+  auto host_buffer = HostBuffer::Create();
+  size_t index_count = 0u;
+  while (state.KeepRunning()) {
+    auto vertex_buffer = FillPathGeometry::CreateFillVertices(
+        path, kDefaultCurveTolerance, tess, *host_buffer);
+    index_count = vertex_buffer.index_count;
+    host_buffer->Reset();
+  }
+  state.counters["IndexCount"] = index_count;
+}
+
+BENCHMARK_CAPTURE(BM_FillVertices, circle, CreateCircles(1));
+BENCHMARK_CAPTURE(BM_FillVertices, circles, CreateCircles(64));
+BENCHMARK_CAPTURE(BM_FillVertices, text, CreateTextOutline(32));
+BENCHMARK_CAPTURE(BM_FillVertices, icon, CreateIcon());
+BENCHMARK_CAPTURE(BM_FillVertices, cubic, CreateCubic());
+BENCHMARK_CAPTURE(BM_FillVertices, quad, CreateQuadratic());
+BENCHMARK_CAPTURE(BM_FillVertices, random_16, CreateRandomPolygon(16));
+BENCHMARK_CAPTURE(BM_FillVertices, random_256, CreateRandomPolygon(256));
+BENCHMARK_CAPTURE(BM_FillVertices, random_2048, CreateRandomPolygon(2048));
+
+// Creates the vertices of a stroked path into a host buffer like
+// |StrokePathGeometry::GetPositionBuffer| does on the CPU when its vertices
+// are not cached.
+static void BM_StrokeVertices(benchmark::State& state,
+                              Path path,
+                              Scalar stroke_width,
+                              Cap cap,
+                              Join join) {
+  auto host_buffer = HostBuffer::Create();
+  size_t index_count = 0u;
+  const Scalar scaled_miter_limit = 4.0f * stroke_width * 0.5f;
+  while (state.KeepRunning()) {
+    auto vertex_buffer = StrokePathGeometry::CreateStrokeVertices(
+        path, stroke_width, scaled_miter_limit, cap, join,
+        kDefaultCurveTolerance, *host_buffer);
+    index_count = vertex_buffer.index_count;
+    host_buffer->Reset();
+  }
+  state.counters["IndexCount"] = index_count;
+}
+
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  circles_butt_miter,
+                  CreateCircles(64),
+                  2.0f,
+                  Cap::kButt,
+                  Join::kMiter);
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  text_butt_miter,
+                  CreateTextOutline(32),
+                  1.0f,
+                  Cap::kButt,
+                  Join::kMiter);
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  icon_round_round,
+                  CreateIcon(),
+                  10.0f,
+                  Cap::kRound,
+                  Join::kRound);
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  cubic_butt_bevel,
+                  CreateCubic(),
+                  5.0f,
+                  Cap::kButt,
+                  Join::kBevel);
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  cubic_round_round,
+                  CreateCubic(),
+                  5.0f,
+                  Cap::kRound,
+                  Join::kRound);
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  random_2048_square_miter,
+                  CreateRandomPolygon(2048),
+                  3.0f,
+                  Cap::kSquare,
+                  Join::kMiter);
+BENCHMARK_CAPTURE(BM_StrokeVertices,
+                  random_2048_round_round,
+                  CreateRandomPolygon(2048),
+                  3.0f,
+                  Cap::kRound,
+                  Join::kRound);
+
+namespace {
+// A transform with rotation, scale and translation, like the ones that
+// entities are drawn with.
+Matrix CreateTransform() {
+  return Matrix::MakeTranslation({100, 200}) *
+         Matrix::MakeRotationZ(Radians(0.3)) * Matrix::MakeScale({2, 3, 1});
+}
+}  // namespace
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  auto a = CreateTransform();
+  auto b = CreateTransform().Invert();
+  while (state.KeepRunning()) {
+    a = a * b;
+    benchmark::DoNotOptimize(a);
+  }
+}
+
+static void BM_MatrixMultiplyScalar(benchmark::State& state) {
+  auto a = CreateTransform();
+  auto b = CreateTransform().Invert();
+  while (state.KeepRunning()) {
+    a = a.Multiply(b);
+    benchmark::DoNotOptimize(a);
+  }
+}
+
+static void BM_MatrixInvert(benchmark::State& state) {
+  auto matrix = CreateTransform();
+  while (state.KeepRunning()) {
+    matrix = matrix.Invert();
+    benchmark::DoNotOptimize(matrix);
+  }
+}
+
+static void BM_RectTransformBounds(benchmark::State& state) {
+  auto transform = CreateTransform();
+  auto rect = Rect::MakeXYWH(10, 20, 300, 400);
+  while (state.KeepRunning()) {
+    auto bounds = rect.TransformBounds(transform);
+    benchmark::DoNotOptimize(bounds);
+  }
+}
+
+static void BM_MatrixTransformPoints(benchmark::State& state) {
+  auto transform = CreateTransform();
+  std::vector<Point> points(state.range(0));
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = Point(i, i * 2);
+  }
+  std::vector<Point> result(points.size());
+  while (state.KeepRunning()) {
+    transform.TransformPoints(points.data(), result.data(), points.size());
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_MatrixTransformPointsScalar(benchmark::State& state) {
+  auto transform = CreateTransform();
+  std::vector<Point> points(state.range(0));
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = Point(i, i * 2);
+  }
+  std::vector<Point> result(points.size());
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < points.size(); i++) {
+      result[i] = transform * points[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK(BM_MatrixMultiply);
+BENCHMARK(BM_MatrixMultiplyScalar);
+BENCHMARK(BM_MatrixInvert);
+BENCHMARK(BM_RectTransformBounds);
+BENCHMARK(BM_MatrixTransformPoints)->Arg(4)->Arg(64)->Arg(1024);
+BENCHMARK(BM_MatrixTransformPointsScalar)->Arg(4)->Arg(64)->Arg(1024);
+
 namespace {
 Path CreateCubic() {
   return PathBuilder{}
@@ -312,5 +529,87 @@ Path CreateQuadratic() {
       .TakePath();
 }
 
+Path CreateCircles(size_t count) {
+  PathBuilder builder;
+  for (size_t i = 0; i < count; i++) {
+    builder.AddCircle({20.0f + (i % 8) * 40.0f, 20.0f + (i / 8) * 40.0f},
+                      15.0f);
+  }
+  return builder.TakePath();
+}
+
+Path CreateTextOutline(size_t glyph_count) {
+  PathBuilder builder;
+  for (size_t i = 0; i < glyph_count; i++) {
+    const Scalar x = i * 12.0f;
+    if (i % 2 == 0) {
+      // An "o", whose counter winds the other way.
+      builder.MoveTo({x + 5, 0})
+          .QuadraticCurveTo({x + 10, 0}, {x + 10, 6})
+          .QuadraticCurveTo({x + 10, 12}, {x + 5, 12})
+          .QuadraticCurveTo({x, 12}, {x, 6})
+          .QuadraticCurveTo({x, 0}, {x + 5, 0})
+          .Close()
+          .MoveTo({x + 5, 2})
+          .QuadraticCurveTo({x + 2, 2}, {x + 2, 6})
+          .QuadraticCurveTo({x + 2, 10}, {x + 5, 10})
+          .QuadraticCurveTo({x + 8, 10}, {x + 8, 6})
+          .QuadraticCurveTo({x + 8, 2}, {x + 5, 2})
+          .Close();
+    } else {
+      // An "n", with a shoulder and straight stems.
+      builder.MoveTo({x, 12})
+          .LineTo({x, 0})
+          .LineTo({x + 2, 0})
+          .LineTo({x + 2, 2})
+          .QuadraticCurveTo({x + 4, 0}, {x + 6, 0})
+          .QuadraticCurveTo({x + 10, 0}, {x + 10, 5})
+          .LineTo({x + 10, 12})
+          .LineTo({x + 8, 12})
+          .LineTo({x + 8, 5})
+          .QuadraticCurveTo({x + 8, 2}, {x + 6, 2})
+          .QuadraticCurveTo({x + 2, 2}, {x + 2, 6})
+          .LineTo({x + 2, 12})
+          .Close();
+    }
+  }
+  return builder.TakePath();
+}
+
+Path CreateIcon() {
+  // M12 21.35l-1.45-1.32C5.4 15.36 2 12.28 2 8.5 2 5.42 4.42 3 7.5 3
+  // c1.74 0 3.41.81 4.5 2.09C13.09 3.81 14.76 3 16.5 3 19.58 3 22 5.42 22 8.5
+  // c0 3.78-3.4 6.86-8.55 11.54L12 21.35z, in absolute coordinates and
+  // scaled by 10.
+  return PathBuilder{}
+      .MoveTo({120, 213.5})
+      .LineTo({105.5, 200.3})
+      .CubicCurveTo({54, 153.6}, {20, 122.8}, {20, 85})
+      .CubicCurveTo({20, 54.2}, {44.2, 30}, {75, 30})
+      .CubicCurveTo({92.4, 30}, {109.1, 38.1}, {120, 50.9})
+      .CubicCurveTo({130.9, 38.1}, {147.6, 30}, {165, 30})
+      .CubicCurveTo({195.8, 30}, {220, 54.2}, {220, 85})
+      .CubicCurveTo({220, 122.8}, {186, 153.6}, {134.5, 200.4})
+      .LineTo({120, 213.5})
+      .Close()
+      .TakePath();
+}
+
+Path CreateRandomPolygon(size_t point_count) {
+  // A linear congruential generator, so that every run measures the same
+  // polygon.
+  uint32_t state = 1u;
+  auto next = [&state]() {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8) / static_cast<Scalar>(1u << 24) * 1000.0f;
+  };
+  PathBuilder builder;
+  builder.MoveTo({next(), next()});
+  for (size_t i = 1; i < point_count; i++) {
+    builder.LineTo({next(), next()});
+  }
+  return builder.Close().TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
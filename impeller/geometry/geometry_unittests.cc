@@ -4,6 +4,8 @@
 
 #include "impeller/geometry/geometry_unittests.h"
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <sstream>
 
@@ -129,6 +131,38 @@ TEST(GeometryTest, InvertMatrix) {
   ASSERT_MATRIX_NEAR(inverted, result);
 }
 
+TEST(GeometryTest, VectorizedMatrixMultiplicationMatchesMultiply) {
+  Matrix matrices[] = {
+      Matrix::MakeTranslation({100, -50, 10}) *
+          Matrix::MakeRotationZ(Radians{kPiOver4}),
+      Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100),
+      Matrix{3, 4, 14, 155, 2, 1, 3, 4, 2, 3, 2, 1, 1, 2, 4, 2},
+      Matrix::MakeScale({2, -3, 4}) * Matrix::MakeSkew(0.5, 0.25),
+  };
+  for (const auto& a : matrices) {
+    for (const auto& b : matrices) {
+      ASSERT_MATRIX_NEAR(a * b, a.Multiply(b));
+    }
+  }
+}
+
+TEST(GeometryTest, InvertedMatricesMultiplyToIdentity) {
+  Matrix matrices[] = {
+      Matrix::MakeTranslation({100, -50, 10}) *
+          Matrix::MakeRotationZ(Radians{kPiOver4}),
+      Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100),
+      Matrix{3, 4, 14, 155, 2, 1, 3, 4, 2, 3, 2, 1, 1, 2, 4, 2},
+      Matrix::MakeScale({2, -3, 4}) * Matrix::MakeSkew(0.5, 0.25),
+  };
+  for (const auto& matrix : matrices) {
+    ASSERT_MATRIX_NEAR(matrix * matrix.Invert(), Matrix{});
+    ASSERT_MATRIX_NEAR(matrix.Invert() * matrix, Matrix{});
+  }
+
+  // Singular matrices have no inverse.
+  ASSERT_MATRIX_NEAR(Matrix::MakeScale({0, 1, 1}).Invert(), Matrix{});
+}
+
 TEST(GeometryTest, TestDecomposition) {
   auto rotated = Matrix::MakeRotationZ(Radians{kPiOver4});
 
@@ -265,6 +299,37 @@ TEST(GeometryTest, MatrixVectorMultiplication) {
   }
 }
 
+TEST(GeometryTest, MatrixTransformPointsMatchesPointMultiplication) {
+  // More points than fit in a vector, so that the remainder is transformed
+  // one at a time.
+  Point points[] = {{0, 0},  {3, 3},    {-10, 20}, {1.5, -2.5},
+                    {7, 11}, {100, 50}, {-3, -3}};
+  constexpr size_t kCount = sizeof(points) / sizeof(points[0]);
+  Matrix matrices[] = {
+      Matrix::MakeTranslation({100, -50}) *
+          Matrix::MakeRotationZ(Radians{kPiOver4}) *
+          Matrix::MakeScale({2, 3, 1}),
+      // Maps (3, 3) to the singularity of the perspective.
+      Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100),
+      Matrix::MakePerspective(Radians(kPiOver2), 1, 1, 100) *
+          Matrix::MakeTranslation(Vector3(0, 0, -3)),
+  };
+  for (const auto& matrix : matrices) {
+    Point result[kCount];
+    matrix.TransformPoints(points, result, kCount);
+    for (size_t i = 0; i < kCount; i++) {
+      ASSERT_POINT_NEAR(result[i], matrix * points[i]);
+    }
+
+    Point in_place[kCount];
+    std::copy(std::begin(points), std::end(points), in_place);
+    matrix.TransformPoints(in_place, in_place, kCount);
+    for (size_t i = 0; i < kCount; i++) {
+      ASSERT_POINT_NEAR(in_place[i], result[i]);
+    }
+  }
+}
+
 TEST(GeometryTest, MatrixMakeRotationFromQuaternion) {
   {
     auto matrix = Matrix::MakeRotation(Quaternion({1, 0, 0}, kPiOver2));
@@ -1551,6 +1616,16 @@ TEST(GeometryTest, RectGetTransformedPoints) {
   ASSERT_POINT_NEAR(points[3], Point(410, 620));
 }
 
+TEST(GeometryTest, RectTransformBounds) {
+  Rect r(100, 200, 300, 400);
+  ASSERT_RECT_NEAR(r.TransformBounds(Matrix::MakeTranslation({10, 20})),
+                   Rect(110, 220, 300, 400));
+  // The bounds of a rotated rect contain all of its corners.
+  auto bounds = Rect(0, 0, 100, 100).TransformBounds(
+      Matrix::MakeRotationZ(Radians{kPiOver4}));
+  ASSERT_RECT_NEAR(bounds, Rect::MakeLTRB(-70.7107, 0, 70.7107, 141.421));
+}
+
 TEST(GeometryTest, RectMakePointBounds) {
   {
     Rect r =
@@ -1587,6 +1662,75 @@ TEST(GeometryTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+TEST(GeometryTest, CubicPathComponentPolylineFollowsTolerance) {
+  CubicPathComponent component({0, 0}, {0, 55.23}, {44.77, 100}, {100, 100});
+  auto coarse = component.CreatePolyline(1.0f);
+  auto fine = component.CreatePolyline(0.01f);
+  ASSERT_LT(coarse.size(), fine.size());
+
+  // Every point of the curve is within the tolerance of the polyline, up to
+  // the error of approximating the cubic with quadratics.
+  for (auto tolerance : {1.0f, 0.01f}) {
+    auto polyline = component.CreatePolyline(tolerance);
+    ASSERT_EQ(polyline.back(), component.p2);
+    polyline.insert(polyline.begin(), component.p1);
+    for (int i = 0; i <= 100; i++) {
+      Point curve_point = component.Solve(i / 100.0f);
+      Scalar distance = std::numeric_limits<Scalar>::max();
+      for (size_t j = 1; j < polyline.size(); j++) {
+        Point segment = polyline[j] - polyline[j - 1];
+        Scalar t = std::clamp(
+            (curve_point - polyline[j - 1]).Dot(segment) / segment.Dot(segment),
+            0.0f, 1.0f);
+        distance = std::min(
+            distance, curve_point.GetDistance(polyline[j - 1] + segment * t));
+      }
+      ASSERT_LE(distance, tolerance * 2);
+    }
+  }
+}
+
+TEST(GeometryTest, PathComponentsCanBeUpdatedInPlace) {
+  Path path;
+  path.AddLinearComponent({0, 0}, {10, 0});
+  path.AddQuadraticComponent({10, 0}, {20, 0}, {20, 10});
+  path.AddCubicComponent({20, 10}, {20, 20}, {10, 20}, {0, 20});
+  path.SetContourClosed(true);
+
+  ASSERT_TRUE(path.UpdateQuadraticComponentAtIndex(
+      2, QuadraticPathComponent({10, 0}, {30, 0}, {20, 10})));
+  ASSERT_FALSE(path.UpdateLinearComponentAtIndex(
+      2, LinearPathComponent({0, 0}, {1, 1})));
+
+  LinearPathComponent linear;
+  ASSERT_TRUE(path.GetLinearComponentAtIndex(1, linear));
+  ASSERT_EQ(linear.p2, Point(10, 0));
+  QuadraticPathComponent quad;
+  ASSERT_TRUE(path.GetQuadraticComponentAtIndex(2, quad));
+  ASSERT_EQ(quad.cp, Point(30, 0));
+  CubicPathComponent cubic;
+  ASSERT_TRUE(path.GetCubicComponentAtIndex(3, cubic));
+  ASSERT_EQ(cubic.p1, Point(20, 10));
+  ASSERT_EQ(cubic.p2, Point(0, 20));
+  ContourComponent contour;
+  ASSERT_TRUE(path.GetContourComponentAtIndex(0, contour));
+  ASSERT_TRUE(contour.is_closed);
+}
+
+TEST(GeometryTest, PathBuilderTakePathResetsTheBuilder) {
+  PathBuilder builder;
+  builder.AddRect(Rect::MakeXYWH(0, 0, 10, 10));
+  auto path = builder.TakePath(FillType::kOdd);
+  ASSERT_EQ(path.GetFillType(), FillType::kOdd);
+  ASSERT_EQ(path.GetConvexity(), Convexity::kConvex);
+  ASSERT_EQ(path.GetBoundingBox(), Rect::MakeXYWH(0, 0, 10, 10));
+
+  auto empty = builder.TakePath();
+  ASSERT_EQ(empty.GetComponentCount(), 1u);
+  ASSERT_FALSE(empty.GetBoundingBox().has_value());
+  ASSERT_EQ(empty, Path());
+}
+
 TEST(GeometryTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   Path path;
   path.AddContourComponent({10, 10});
@@ -1753,6 +1897,122 @@ TEST(GeometryTest, PathPolylineDuplicatesAreRemovedForSameContour) {
   ASSERT_EQ(polyline.points[6], Point(0, 100));
 }
 
+TEST(GeometryTest, PathBuilderMarksSingleConvexShapesAsConvex) {
+  auto rect = Rect::MakeLTRB(10, 20, 110, 220);
+  ASSERT_EQ(PathBuilder{}.AddRect(rect).TakePath().GetConvexity(),
+            Convexity::kConvex);
+  ASSERT_EQ(PathBuilder{}.AddOval(rect).TakePath().GetConvexity(),
+            Convexity::kConvex);
+  ASSERT_EQ(PathBuilder{}.AddCircle({50, 50}, 10).TakePath().GetConvexity(),
+            Convexity::kConvex);
+  ASSERT_EQ(PathBuilder{}.AddRoundedRect(rect, 10).CopyPath().GetConvexity(),
+            Convexity::kConvex);
+
+  // The corners overlap along the sides that are shorter than their radii.
+  ASSERT_EQ(PathBuilder{}.AddRoundedRect(rect, 60).TakePath().GetConvexity(),
+            Convexity::kUnknown);
+  ASSERT_EQ(
+      PathBuilder{}.AddRect(rect).AddRect(rect).TakePath().GetConvexity(),
+      Convexity::kUnknown);
+  ASSERT_EQ(
+      PathBuilder{}.AddRect(rect).LineTo({0, 0}).TakePath().GetConvexity(),
+      Convexity::kUnknown);
+  ASSERT_EQ(PathBuilder{}
+                .MoveTo({0, 0})
+                .LineTo({10, 0})
+                .LineTo({10, 10})
+                .Close()
+                .TakePath()
+                .GetConvexity(),
+            Convexity::kUnknown);
+
+  auto path = PathBuilder{}.AddRect(rect).TakePath();
+  path.AddLinearComponent({0, 0}, {10, 10});
+  ASSERT_EQ(path.GetConvexity(), Convexity::kUnknown);
+}
+
+TEST(GeometryTest, PathHashAndEqualityFollowTheComponents) {
+  auto make_path = [](Point end, FillType fill) {
+    return PathBuilder{}
+        .MoveTo({0, 0})
+        .QuadraticCurveTo({50, 0}, end)
+        .Close()
+        .TakePath(fill);
+  };
+  auto path = make_path({50, 50}, FillType::kNonZero);
+  auto same_path = make_path({50, 50}, FillType::kNonZero);
+  auto convex_path = make_path({50, 50}, FillType::kNonZero);
+  convex_path.SetConvexity(Convexity::kConvex);
+  auto other_end_path = make_path({50, 60}, FillType::kNonZero);
+  auto other_fill_path = make_path({50, 50}, FillType::kOdd);
+
+  ASSERT_TRUE(path == same_path);
+  ASSERT_EQ(path.GetHash(), same_path.GetHash());
+  ASSERT_TRUE(path == convex_path);
+  ASSERT_EQ(path.GetHash(), convex_path.GetHash());
+  ASSERT_FALSE(path == other_end_path);
+  ASSERT_NE(path.GetHash(), other_end_path.GetHash());
+  ASSERT_FALSE(path == other_fill_path);
+  ASSERT_NE(path.GetHash(), other_fill_path.GetHash());
+}
+
+TEST(GeometryTest, PolylineGetSingleConvexContourBounds) {
+  auto rect_polyline = PathBuilder{}
+                           .AddLine({0, 0}, {10, 10})
+                           .AddRect(Rect::MakeLTRB(50, 60, 70, 80))
+                           .TakePath()
+                           .CreatePolyline();
+  auto rect_bounds = rect_polyline.GetSingleConvexContourBounds();
+  ASSERT_TRUE(rect_bounds.has_value());
+  // The line encloses no area, and the closing point of the rectangle is
+  // left out.
+  ASSERT_EQ(std::get<0>(rect_bounds.value()), 2u);
+  ASSERT_EQ(std::get<1>(rect_bounds.value()), 6u);
+
+  auto oval_polyline = PathBuilder{}
+                           .AddOval(Rect::MakeLTRB(0, 0, 300, 100))
+                           .TakePath()
+                           .CreatePolyline();
+  ASSERT_TRUE(oval_polyline.GetSingleConvexContourBounds().has_value());
+
+  auto concave_polyline = PathBuilder{}
+                              .MoveTo({0, 0})
+                              .LineTo({100, 0})
+                              .LineTo({50, 50})
+                              .LineTo({100, 100})
+                              .LineTo({0, 100})
+                              .Close()
+                              .TakePath()
+                              .CreatePolyline();
+  ASSERT_FALSE(concave_polyline.GetSingleConvexContourBounds().has_value());
+
+  // The corners of a star all turn the same way, but it winds around its
+  // center twice.
+  PathBuilder star;
+  for (int i = 0; i < 5; i++) {
+    Scalar angle = kPiOver2 + i * 4 * kPi / 5;
+    Point point =
+        Point(100, 100) + Point(std::cos(angle), std::sin(angle)) * 50;
+    if (i == 0) {
+      star.MoveTo(point);
+    } else {
+      star.LineTo(point);
+    }
+  }
+  auto star_polyline = star.Close().TakePath().CreatePolyline();
+  ASSERT_FALSE(star_polyline.GetSingleConvexContourBounds().has_value());
+
+  auto two_rects_polyline = PathBuilder{}
+                                .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+                                .AddRect(Rect::MakeLTRB(20, 0, 30, 10))
+                                .TakePath()
+                                .CreatePolyline();
+  ASSERT_FALSE(two_rects_polyline.GetSingleConvexContourBounds().has_value());
+  ASSERT_FALSE(
+      two_rects_polyline.GetSingleConvexContourBounds(/*known_convex=*/true)
+          .has_value());
+}
+
 TEST(GeometryTest, MatrixPrinting) {
   {
     std::stringstream stream;
@@ -1911,6 +2171,7 @@ TEST(GeometryTest, Gradient) {
 
     ASSERT_EQ(gradient.texture_size, 1024u);
     ASSERT_EQ(gradient.color_bytes.size(), 1024u * 4);
+    ASSERT_GT(ComputeGradientTextureSize(stops), kMaxGradientTextureSize);
   }
 }
 
@@ -17,39 +17,42 @@ static void AppendColor(const Color& color, GradientData* data) {
   data->color_bytes.push_back(converted[3]);
 }
 
+uint32_t ComputeGradientTextureSize(const std::vector<Scalar>& stops) {
+  if (stops.size() == 2) {
+    return 2u;
+  }
+  auto minimum_delta = 1.0;
+  for (size_t i = 1; i < stops.size(); i++) {
+    auto value = stops[i] - stops[i - 1];
+    // Smaller than kEhCloseEnough
+    if (value < 0.0001) {
+      continue;
+    }
+    if (value < minimum_delta) {
+      minimum_delta = value;
+    }
+  }
+  return static_cast<uint32_t>(std::round(1.0 / minimum_delta)) + 1;
+}
+
 GradientData CreateGradientBuffer(const std::vector<Color>& colors,
                                   const std::vector<Scalar>& stops) {
   FML_DCHECK(stops.size() == colors.size());
 
-  uint32_t texture_size;
-  if (stops.size() == 2) {
-    texture_size = colors.size();
-  } else {
-    auto minimum_delta = 1.0;
-    for (size_t i = 1; i < stops.size(); i++) {
-      auto value = stops[i] - stops[i - 1];
-      // Smaller than kEhCloseEnough
-      if (value < 0.0001) {
-        continue;
-      }
-      if (value < minimum_delta) {
-        minimum_delta = value;
-      }
-    }
-    // Avoid creating textures that are absurdly large due to stops that are
-    // very close together.
-    // TODO(jonahwilliams): this should use a platform specific max texture
-    // size.
-    texture_size = std::min(
-        static_cast<uint32_t>(std::round(1.0 / minimum_delta)) + 1, 1024u);
-  }
+  // Avoid creating textures that are absurdly large due to stops that are
+  // very close together.
+  // TODO(jonahwilliams): this should use a platform specific max texture
+  // size.
+  uint32_t texture_size =
+      std::min(ComputeGradientTextureSize(stops), kMaxGradientTextureSize);
   GradientData data = {
       .color_bytes = {},
       .texture_size = texture_size,
   };
   data.color_bytes.reserve(texture_size * 4);
 
-  if (texture_size == colors.size() && colors.size() <= 1024) {
+  if (texture_size == colors.size() &&
+      colors.size() <= kMaxGradientTextureSize) {
     for (auto i = 0u; i < colors.size(); i++) {
       AppendColor(colors[i], &data);
     }
@@ -13,12 +13,26 @@
 
 namespace impeller {
 
+// The largest gradient texture that is created. Gradients with stops that are
+// closer together than a texel of it are approximated.
+static constexpr uint32_t kMaxGradientTextureSize = 1024u;
+
 // If texture_size is 0 then the gradient is invalid.
 struct GradientData {
   std::vector<uint8_t> color_bytes;
   uint32_t texture_size;
 };
 
+/**
+ * @brief Compute the number of texels needed to represent the gradient with
+ * the given stops without losing any of them. This is not limited to
+ * kMaxGradientTextureSize.
+ *
+ * @param stops
+ * @return uint32_t
+ */
+uint32_t ComputeGradientTextureSize(const std::vector<Scalar>& stops);
+
 /**
  * @brief Populate a vector with the interpolated color bytes for the linear
  * gradient described by colors and stops.
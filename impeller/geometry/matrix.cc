@@ -9,6 +9,9 @@
 
 namespace impeller {
 
+static_assert(sizeof(Point) == sizeof(Scalar) * 2,
+              "Points must be packed to be loaded into vectors.");
+
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
   /*
    *  Apply perspective.
@@ -94,58 +97,92 @@ Matrix Matrix::operator+(const Matrix& o) const {
   );
 }
 
-Matrix Matrix::Invert() const {
-  Matrix tmp{
-      m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
-          m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
-
-      -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] -
-          m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10],
-
-      m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] +
-          m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6],
-
-      -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] -
-          m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6],
-
-      -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] -
-          m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10],
-
-      m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] +
-          m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10],
-
-      -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] -
-          m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6],
-
-      m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] +
-          m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6],
-
-      m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] +
-          m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9],
-
-      -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] -
-          m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9],
-
-      m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] +
-          m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5],
-
-      -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] -
-          m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5],
-
-      -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] -
-          m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9],
-
-      m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] +
-          m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9],
-
-      -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] -
-          m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5],
-
-      m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] +
-          m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5]};
+void Matrix::TransformPoints(const Point* points,
+                             Point* result,
+                             size_t count) const {
+  size_t i = 0;
+  // Without perspective, w is always 1 and the division is skipped.
+  const bool has_perspective = m[3] != 0 || m[7] != 0 || m[15] != 1;
+#if defined(IMPELLER_MATRIX_SSE)
+  const __m128 m0 = _mm_set1_ps(m[0]);
+  const __m128 m1 = _mm_set1_ps(m[1]);
+  const __m128 m3 = _mm_set1_ps(m[3]);
+  const __m128 m4 = _mm_set1_ps(m[4]);
+  const __m128 m5 = _mm_set1_ps(m[5]);
+  const __m128 m7 = _mm_set1_ps(m[7]);
+  const __m128 m12 = _mm_set1_ps(m[12]);
+  const __m128 m13 = _mm_set1_ps(m[13]);
+  const __m128 m15 = _mm_set1_ps(m[15]);
+  for (; i + 4 <= count; i += 4) {
+    const __m128 p01 = _mm_loadu_ps(&points[i].x);
+    const __m128 p23 = _mm_loadu_ps(&points[i + 2].x);
+    const __m128 xs = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 ys = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, m0), _mm_mul_ps(ys, m4)),
+                           m12);
+    __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, m1), _mm_mul_ps(ys, m5)),
+                           m13);
+    if (has_perspective) {
+      const __m128 w = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(xs, m3), _mm_mul_ps(ys, m7)), m15);
+      // Points at the singularity resolve to 0 like in the scalar version.
+      const __m128 inverse_w =
+          _mm_and_ps(_mm_div_ps(_mm_set1_ps(1), w),
+                     _mm_cmpneq_ps(w, _mm_setzero_ps()));
+      tx = _mm_mul_ps(tx, inverse_w);
+      ty = _mm_mul_ps(ty, inverse_w);
+    }
+    _mm_storeu_ps(&result[i].x, _mm_unpacklo_ps(tx, ty));
+    _mm_storeu_ps(&result[i + 2].x, _mm_unpackhi_ps(tx, ty));
+  }
+#elif defined(IMPELLER_MATRIX_NEON)
+  const float32x4_t m12 = vdupq_n_f32(m[12]);
+  const float32x4_t m13 = vdupq_n_f32(m[13]);
+  const float32x4_t m15 = vdupq_n_f32(m[15]);
+  for (; i + 4 <= count; i += 4) {
+    const float32x4x2_t p = vld2q_f32(&points[i].x);
+    float32x4x2_t t;
+    t.val[0] = vfmaq_n_f32(vfmaq_n_f32(m12, p.val[0], m[0]), p.val[1], m[4]);
+    t.val[1] = vfmaq_n_f32(vfmaq_n_f32(m13, p.val[0], m[1]), p.val[1], m[5]);
+    if (has_perspective) {
+      const float32x4_t w =
+          vfmaq_n_f32(vfmaq_n_f32(m15, p.val[0], m[3]), p.val[1], m[7]);
+      // Points at the singularity resolve to 0 like in the scalar version.
+      const uint32x4_t nonzero = vmvnq_u32(vceqzq_f32(w));
+      const float32x4_t inverse_w = vreinterpretq_f32_u32(vandq_u32(
+          vreinterpretq_u32_f32(vdivq_f32(vdupq_n_f32(1), w)), nonzero));
+      t.val[0] = vmulq_f32(t.val[0], inverse_w);
+      t.val[1] = vmulq_f32(t.val[1], inverse_w);
+    }
+    vst2q_f32(&result[i].x, t);
+  }
+#endif
+  for (; i < count; i++) {
+    result[i] = *this * points[i];
+  }
+}
 
-  Scalar det =
-      m[0] * tmp.m[0] + m[1] * tmp.m[4] + m[2] * tmp.m[8] + m[3] * tmp.m[12];
+Matrix Matrix::Invert() const {
+  // The cofactors are expanded along pairs of rows, so that the determinants
+  // of the 2x2 minors are shared instead of being recomputed for each of the
+  // 16 cofactors. The storage is read as a row-major matrix, whose inverse
+  // is the transpose of the inverse of this matrix, which is the matrix in
+  // column-major storage again.
+  const Scalar s0 = m[0] * m[5] - m[4] * m[1];
+  const Scalar s1 = m[0] * m[6] - m[4] * m[2];
+  const Scalar s2 = m[0] * m[7] - m[4] * m[3];
+  const Scalar s3 = m[1] * m[6] - m[5] * m[2];
+  const Scalar s4 = m[1] * m[7] - m[5] * m[3];
+  const Scalar s5 = m[2] * m[7] - m[6] * m[3];
+
+  const Scalar c5 = m[10] * m[15] - m[14] * m[11];
+  const Scalar c4 = m[9] * m[15] - m[13] * m[11];
+  const Scalar c3 = m[9] * m[14] - m[13] * m[10];
+  const Scalar c2 = m[8] * m[15] - m[12] * m[11];
+  const Scalar c1 = m[8] * m[14] - m[12] * m[10];
+  const Scalar c0 = m[8] * m[13] - m[12] * m[9];
+
+  Scalar det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 
   if (det == 0) {
     return {};
@@ -153,10 +190,42 @@ Matrix Matrix::Invert() const {
 
   det = 1.0 / det;
 
-  return {tmp.m[0] * det,  tmp.m[1] * det,  tmp.m[2] * det,  tmp.m[3] * det,
-          tmp.m[4] * det,  tmp.m[5] * det,  tmp.m[6] * det,  tmp.m[7] * det,
-          tmp.m[8] * det,  tmp.m[9] * det,  tmp.m[10] * det, tmp.m[11] * det,
-          tmp.m[12] * det, tmp.m[13] * det, tmp.m[14] * det, tmp.m[15] * det};
+  Matrix result{
+      m[5] * c5 - m[6] * c4 + m[7] * c3,
+      -m[1] * c5 + m[2] * c4 - m[3] * c3,
+      m[13] * s5 - m[14] * s4 + m[15] * s3,
+      -m[9] * s5 + m[10] * s4 - m[11] * s3,
+
+      -m[4] * c5 + m[6] * c2 - m[7] * c1,
+      m[0] * c5 - m[2] * c2 + m[3] * c1,
+      -m[12] * s5 + m[14] * s2 - m[15] * s1,
+      m[8] * s5 - m[10] * s2 + m[11] * s1,
+
+      m[4] * c4 - m[5] * c2 + m[7] * c0,
+      -m[0] * c4 + m[1] * c2 - m[3] * c0,
+      m[12] * s4 - m[13] * s2 + m[15] * s0,
+      -m[8] * s4 + m[9] * s2 - m[11] * s0,
+
+      -m[4] * c3 + m[5] * c1 - m[6] * c0,
+      m[0] * c3 - m[1] * c1 + m[2] * c0,
+      -m[12] * s3 + m[13] * s1 - m[14] * s0,
+      m[8] * s3 - m[9] * s1 + m[10] * s0};
+
+#if defined(IMPELLER_MATRIX_SSE)
+  const __m128 scale = _mm_set1_ps(det);
+  for (int i = 0; i < 16; i += 4) {
+    _mm_storeu_ps(&result.m[i], _mm_mul_ps(_mm_loadu_ps(&result.m[i]), scale));
+  }
+#elif defined(IMPELLER_MATRIX_NEON)
+  for (int i = 0; i < 16; i += 4) {
+    vst1q_f32(&result.m[i], vmulq_n_f32(vld1q_f32(&result.m[i]), det));
+  }
+#else
+  for (int i = 0; i < 16; i++) {
+    result.m[i] *= det;
+  }
+#endif
+  return result;
 }
 
 Scalar Matrix::GetDeterminant() const {
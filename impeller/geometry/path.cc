@@ -4,8 +4,10 @@
 
 #include "impeller/geometry/path.h"
 
+#include <cmath>
 #include <optional>
 
+#include "flutter/fml/hash_combine.h"
 #include "impeller/geometry/path_component.h"
 
 namespace impeller {
@@ -16,6 +18,14 @@ Path::Path() {
 
 Path::~Path() = default;
 
+Path::Path(const Path& other) = default;
+
+Path::Path(Path&& other) = default;
+
+Path& Path::operator=(const Path& other) = default;
+
+Path& Path::operator=(Path&& other) = default;
+
 std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
     size_t contour_index) const {
   if (contour_index >= contours.size()) {
@@ -28,6 +38,92 @@ std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
   return std::make_tuple(start_index, end_index);
 }
 
+std::optional<std::tuple<size_t, size_t>>
+Path::Polyline::GetSingleConvexContourBounds(bool known_convex) const {
+  std::optional<std::tuple<size_t, size_t>> bounds;
+  for (size_t i = 0; i < contours.size(); i++) {
+    auto [start, end] = GetContourPointBounds(i);
+    if (end - start < 3) {
+      continue;
+    }
+    if (bounds.has_value()) {
+      return std::nullopt;
+    }
+    bounds = {start, end};
+  }
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+
+  auto [start, end] = bounds.value();
+  if (points[end - 1] == points[start]) {
+    end--;
+  }
+  const size_t count = end - start;
+  if (count < 3) {
+    return std::nullopt;
+  }
+  if (known_convex) {
+    return std::make_tuple(start, end);
+  }
+
+  // A contour is convex if all of its corners turn the same way, and it winds
+  // around its interior once if the direction of its edges along each axis
+  // changes sign no more than twice, counting the change from the last edge
+  // back to the first one.
+  struct AxisDirection {
+    Scalar first_sign = 0;
+    Scalar sign = 0;
+    size_t flips = 0;
+
+    void Add(Scalar delta) {
+      if (delta == 0) {
+        return;
+      }
+      Scalar new_sign = delta > 0 ? 1 : -1;
+      if (sign == 0) {
+        first_sign = new_sign;
+      } else if (new_sign != sign) {
+        flips++;
+      }
+      sign = new_sign;
+    }
+
+    size_t GetCyclicFlips() const {
+      return flips + (sign != first_sign ? 1 : 0);
+    }
+  };
+  AxisDirection x_direction;
+  AxisDirection y_direction;
+  Scalar turn_sign = 0;
+
+  Point previous_edge = points[start] - points[end - 1];
+  for (size_t i = 0; i < count; i++) {
+    const Point edge = points[start + (i + 1) % count] - points[start + i];
+    if (edge.IsZero()) {
+      continue;
+    }
+    // Nearly collinear edges may turn either way once curves are flattened.
+    const Scalar cross = previous_edge.Cross(edge);
+    if (std::abs(cross) >
+        kEhCloseEnough * previous_edge.GetLength() * edge.GetLength()) {
+      Scalar sign = cross > 0 ? 1 : -1;
+      if (turn_sign != 0 && sign != turn_sign) {
+        return std::nullopt;
+      }
+      turn_sign = sign;
+    }
+    x_direction.Add(edge.x);
+    y_direction.Add(edge.y);
+    previous_edge = edge;
+  }
+  if (turn_sign == 0 || x_direction.GetCyclicFlips() > 2 ||
+      y_direction.GetCyclicFlips() > 2) {
+    return std::nullopt;
+  }
+  return std::make_tuple(start, end);
+}
+
 size_t Path::GetComponentCount() const {
   return components_.size();
 }
@@ -40,21 +136,38 @@ FillType Path::GetFillType() const {
   return fill_;
 }
 
+void Path::SetConvexity(Convexity convexity) {
+  convexity_ = convexity;
+}
+
+Convexity Path::GetConvexity() const {
+  return convexity_;
+}
+
 Path& Path::AddLinearComponent(Point p1, Point p2) {
-  linears_.emplace_back(p1, p2);
-  components_.emplace_back(ComponentType::kLinear, linears_.size() - 1);
+  components_.emplace_back(ComponentType::kLinear, points_.size());
+  points_.push_back(p1);
+  points_.push_back(p2);
+  convexity_ = Convexity::kUnknown;
   return *this;
 }
 
 Path& Path::AddQuadraticComponent(Point p1, Point cp, Point p2) {
-  quads_.emplace_back(p1, cp, p2);
-  components_.emplace_back(ComponentType::kQuadratic, quads_.size() - 1);
+  components_.emplace_back(ComponentType::kQuadratic, points_.size());
+  points_.push_back(p1);
+  points_.push_back(cp);
+  points_.push_back(p2);
+  convexity_ = Convexity::kUnknown;
   return *this;
 }
 
 Path& Path::AddCubicComponent(Point p1, Point cp1, Point cp2, Point p2) {
-  cubics_.emplace_back(p1, cp1, cp2, p2);
-  components_.emplace_back(ComponentType::kCubic, cubics_.size() - 1);
+  components_.emplace_back(ComponentType::kCubic, points_.size());
+  points_.push_back(p1);
+  points_.push_back(cp1);
+  points_.push_back(cp2);
+  points_.push_back(p2);
+  convexity_ = Convexity::kUnknown;
   return *this;
 }
 
@@ -62,16 +175,47 @@ Path& Path::AddContourComponent(Point destination, bool is_closed) {
   if (components_.size() > 0 &&
       components_.back().type == ComponentType::kContour) {
     // Never insert contiguous contours.
-    contours_.back() = ContourComponent(destination, is_closed);
+    points_[components_.back().index] = destination;
   } else {
-    contours_.emplace_back(ContourComponent(destination, is_closed));
-    components_.emplace_back(ComponentType::kContour, contours_.size() - 1);
+    components_.emplace_back(ComponentType::kContour, points_.size());
+    points_.push_back(destination);
   }
+  components_.back().is_closed = is_closed;
+  convexity_ = Convexity::kUnknown;
   return *this;
 }
 
 void Path::SetContourClosed(bool is_closed) {
-  contours_.back().is_closed = is_closed;
+  for (auto it = components_.rbegin(); it != components_.rend(); ++it) {
+    if (it->type == ComponentType::kContour) {
+      it->is_closed = is_closed;
+      break;
+    }
+  }
+  convexity_ = Convexity::kUnknown;
+}
+
+LinearPathComponent Path::GetLinear(
+    const ComponentIndexPair& component) const {
+  return LinearPathComponent(points_[component.index],
+                             points_[component.index + 1]);
+}
+
+QuadraticPathComponent Path::GetQuadratic(
+    const ComponentIndexPair& component) const {
+  return QuadraticPathComponent(points_[component.index],
+                                points_[component.index + 1],
+                                points_[component.index + 2]);
+}
+
+CubicPathComponent Path::GetCubic(const ComponentIndexPair& component) const {
+  return CubicPathComponent(
+      points_[component.index], points_[component.index + 1],
+      points_[component.index + 2], points_[component.index + 3]);
+}
+
+ContourComponent Path::GetContour(const ComponentIndexPair& component) const {
+  return ContourComponent(points_[component.index], component.is_closed);
 }
 
 void Path::EnumerateComponents(
@@ -84,22 +228,22 @@ void Path::EnumerateComponents(
     switch (component.type) {
       case ComponentType::kLinear:
         if (linear_applier) {
-          linear_applier(currentIndex, linears_[component.index]);
+          linear_applier(currentIndex, GetLinear(component));
         }
         break;
       case ComponentType::kQuadratic:
         if (quad_applier) {
-          quad_applier(currentIndex, quads_[component.index]);
+          quad_applier(currentIndex, GetQuadratic(component));
         }
         break;
       case ComponentType::kCubic:
         if (cubic_applier) {
-          cubic_applier(currentIndex, cubics_[component.index]);
+          cubic_applier(currentIndex, GetCubic(component));
         }
         break;
       case ComponentType::kContour:
         if (contour_applier) {
-          contour_applier(currentIndex, contours_[component.index]);
+          contour_applier(currentIndex, GetContour(component));
         }
         break;
     }
@@ -117,7 +261,7 @@ bool Path::GetLinearComponentAtIndex(size_t index,
     return false;
   }
 
-  linear = linears_[components_[index].index];
+  linear = GetLinear(components_[index]);
   return true;
 }
 
@@ -132,7 +276,7 @@ bool Path::GetQuadraticComponentAtIndex(
     return false;
   }
 
-  quadratic = quads_[components_[index].index];
+  quadratic = GetQuadratic(components_[index]);
   return true;
 }
 
@@ -146,7 +290,7 @@ bool Path::GetCubicComponentAtIndex(size_t index,
     return false;
   }
 
-  cubic = cubics_[components_[index].index];
+  cubic = GetCubic(components_[index]);
   return true;
 }
 
@@ -160,7 +304,7 @@ bool Path::GetContourComponentAtIndex(size_t index,
     return false;
   }
 
-  move = contours_[components_[index].index];
+  move = GetContour(components_[index]);
   return true;
 }
 
@@ -174,7 +318,10 @@ bool Path::UpdateLinearComponentAtIndex(size_t index,
     return false;
   }
 
-  linears_[components_[index].index] = linear;
+  auto point_index = components_[index].index;
+  points_[point_index] = linear.p1;
+  points_[point_index + 1] = linear.p2;
+  convexity_ = Convexity::kUnknown;
   return true;
 }
 
@@ -189,7 +336,11 @@ bool Path::UpdateQuadraticComponentAtIndex(
     return false;
   }
 
-  quads_[components_[index].index] = quadratic;
+  auto point_index = components_[index].index;
+  points_[point_index] = quadratic.p1;
+  points_[point_index + 1] = quadratic.cp;
+  points_[point_index + 2] = quadratic.p2;
+  convexity_ = Convexity::kUnknown;
   return true;
 }
 
@@ -203,7 +354,12 @@ bool Path::UpdateCubicComponentAtIndex(size_t index,
     return false;
   }
 
-  cubics_[components_[index].index] = cubic;
+  auto point_index = components_[index].index;
+  points_[point_index] = cubic.p1;
+  points_[point_index + 1] = cubic.cp1;
+  points_[point_index + 2] = cubic.cp2;
+  points_[point_index + 3] = cubic.p2;
+  convexity_ = Convexity::kUnknown;
   return true;
 }
 
@@ -217,51 +373,71 @@ bool Path::UpdateContourComponentAtIndex(size_t index,
     return false;
   }
 
-  contours_[components_[index].index] = move;
+  points_[components_[index].index] = move.destination;
+  components_[index].is_closed = move.is_closed;
+  convexity_ = Convexity::kUnknown;
   return true;
 }
 
+std::optional<Vector2> Path::GetStartDirection(size_t component_index) const {
+  if (component_index >= components_.size()) {
+    return std::nullopt;
+  }
+  const auto& component = components_[component_index];
+  switch (component.type) {
+    case ComponentType::kLinear:
+      return GetLinear(component).GetStartDirection();
+    case ComponentType::kQuadratic:
+      return GetQuadratic(component).GetStartDirection();
+    case ComponentType::kCubic:
+      return GetCubic(component).GetStartDirection();
+    case ComponentType::kContour:
+      return std::nullopt;
+  }
+}
+
+std::optional<Vector2> Path::GetEndDirection(size_t component_index) const {
+  if (component_index >= components_.size()) {
+    return std::nullopt;
+  }
+  const auto& component = components_[component_index];
+  switch (component.type) {
+    case ComponentType::kLinear:
+      return GetLinear(component).GetEndDirection();
+    case ComponentType::kQuadratic:
+      return GetQuadratic(component).GetEndDirection();
+    case ComponentType::kCubic:
+      return GetCubic(component).GetEndDirection();
+    case ComponentType::kContour:
+      return std::nullopt;
+  }
+}
+
 Path::Polyline Path::CreatePolyline(Scalar tolerance) const {
   Polyline polyline;
 
   std::optional<Point> previous_contour_point;
-  auto collect_points = [&polyline, &previous_contour_point](
-                            const std::vector<Point>& collection) {
-    if (collection.empty()) {
+  auto collect_point = [&polyline, &previous_contour_point](Point point) {
+    if (previous_contour_point.has_value() &&
+        previous_contour_point.value() == point) {
+      // Skip over duplicate points in the same contour.
       return;
     }
-
-    for (const auto& point : collection) {
-      if (previous_contour_point.has_value() &&
-          previous_contour_point.value() == point) {
-        // Skip over duplicate points in the same contour.
-        continue;
-      }
-      previous_contour_point = point;
-      polyline.points.push_back(point);
-    }
+    previous_contour_point = point;
+    polyline.points.push_back(point);
   };
-
-  auto get_path_component =
-      [this](size_t component_i) -> std::optional<const PathComponent*> {
-    if (component_i >= components_.size()) {
-      return std::nullopt;
-    }
-    const auto& component = components_[component_i];
-    switch (component.type) {
-      case ComponentType::kLinear:
-        return &linears_[component.index];
-      case ComponentType::kQuadratic:
-        return &quads_[component.index];
-      case ComponentType::kCubic:
-        return &cubics_[component.index];
-      case ComponentType::kContour:
-        return std::nullopt;
+  // Reused by every curve, so that flattening a path doesn't allocate once
+  // per component.
+  std::vector<Point> curve_points;
+  auto collect_curve_points = [&collect_point, &curve_points]() {
+    for (const auto& point : curve_points) {
+      collect_point(point);
     }
+    curve_points.clear();
   };
 
-  std::optional<const PathComponent*> previous_path_component;
-  auto end_contour = [&polyline, &previous_path_component]() {
+  std::optional<size_t> previous_path_component;
+  auto end_contour = [this, &polyline, &previous_path_component]() {
     // Whenever a contour has ended, extract the exact end direction from the
     // last component.
     if (polyline.contours.empty()) {
@@ -272,7 +448,7 @@ Path::Polyline Path::CreatePolyline(Scalar tolerance) const {
     }
     auto& contour = polyline.contours.back();
     contour.end_direction =
-        previous_path_component.value()->GetEndDirection().value_or(
+        GetEndDirection(previous_path_component.value()).value_or(
             Vector2(0, 1));
   };
 
@@ -281,16 +457,18 @@ Path::Polyline Path::CreatePolyline(Scalar tolerance) const {
     const auto& component = components_[component_i];
     switch (component.type) {
       case ComponentType::kLinear:
-        collect_points(linears_[component.index].CreatePolyline());
-        previous_path_component = &linears_[component.index];
+        collect_point(points_[component.index + 1]);
+        previous_path_component = component_i;
         break;
       case ComponentType::kQuadratic:
-        collect_points(quads_[component.index].CreatePolyline(tolerance));
-        previous_path_component = &quads_[component.index];
+        GetQuadratic(component).FillPointsForPolyline(curve_points, tolerance);
+        collect_curve_points();
+        previous_path_component = component_i;
         break;
       case ComponentType::kCubic:
-        collect_points(cubics_[component.index].CreatePolyline(tolerance));
-        previous_path_component = &cubics_[component.index];
+        GetCubic(component).FillPointsForPolyline(curve_points, tolerance);
+        collect_curve_points();
+        previous_path_component = component_i;
         break;
       case ComponentType::kContour:
         if (component_i == components_.size() - 1) {
@@ -300,20 +478,13 @@ Path::Polyline Path::CreatePolyline(Scalar tolerance) const {
         }
         end_contour();
 
-        Vector2 start_direction(0, -1);
-        auto first_component = get_path_component(component_i + 1);
-        if (first_component.has_value()) {
-          start_direction =
-              first_component.value()->GetStartDirection().value_or(
-                  Vector2(0, -1));
-        }
-
-        const auto& contour = contours_[component.index];
+        Vector2 start_direction =
+            GetStartDirection(component_i + 1).value_or(Vector2(0, -1));
         polyline.contours.push_back({.start_index = polyline.points.size(),
-                                     .is_closed = contour.is_closed,
+                                     .is_closed = component.is_closed,
                                      .start_direction = start_direction});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        collect_point(points_[component.index]);
         break;
     }
     end_contour();
@@ -342,10 +513,6 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
 }
 
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
-  if (linears_.empty() && quads_.empty() && cubics_.empty()) {
-    return std::nullopt;
-  }
-
   std::optional<Point> min, max;
 
   auto clamp = [&min, &max](const Point& point) {
@@ -364,20 +531,24 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
     }
   };
 
-  for (const auto& linear : linears_) {
-    clamp(linear.p1);
-    clamp(linear.p2);
-  }
-
-  for (const auto& quad : quads_) {
-    for (const Point& point : quad.Extrema()) {
-      clamp(point);
-    }
-  }
-
-  for (const auto& cubic : cubics_) {
-    for (const Point& point : cubic.Extrema()) {
-      clamp(point);
+  for (const auto& component : components_) {
+    switch (component.type) {
+      case ComponentType::kLinear:
+        clamp(points_[component.index]);
+        clamp(points_[component.index + 1]);
+        break;
+      case ComponentType::kQuadratic:
+        for (const Point& point : GetQuadratic(component).Extrema()) {
+          clamp(point);
+        }
+        break;
+      case ComponentType::kCubic:
+        for (const Point& point : GetCubic(component).Extrema()) {
+          clamp(point);
+        }
+        break;
+      case ComponentType::kContour:
+        break;
     }
   }
 
@@ -388,4 +559,21 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
   return std::make_pair(min.value(), max.value());
 }
 
+size_t Path::GetHash() const {
+  size_t hash = fml::HashCombine(fill_, components_.size());
+  for (const auto& component : components_) {
+    fml::HashCombineSeed(hash, component.type, component.is_closed);
+  }
+  for (const auto& point : points_) {
+    fml::HashCombineSeed(hash, point.x, point.y);
+  }
+  return hash;
+}
+
+bool Path::operator==(const Path& other) const {
+  return fill_ == other.fill_ &&              //
+         components_ == other.components_ &&  //
+         points_ == other.points_;
+}
+
 }  // namespace impeller
@@ -22,6 +22,11 @@ enum class FillType {
   kAbsGeqTwo,
 };
 
+enum class Convexity {
+  kUnknown,
+  kConvex,
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Paths are lightweight objects that describe a collection of
 ///             linear, quadratic, or cubic segments. These segments may be
@@ -34,6 +39,11 @@ enum class FillType {
 ///             Creating paths that describe complex shapes is usually done by a
 ///             path builder.
 ///
+///             The points of all components are packed into a single vector in
+///             the order of the components, so a path takes two allocations
+///             regardless of the kinds of components it has, and walking its
+///             components reads memory in order.
+///
 class Path {
  public:
   enum class ComponentType {
@@ -70,18 +80,44 @@ class Path {
     /// The contour_index parameter is clamped to contours.size().
     std::tuple<size_t, size_t> GetContourPointBounds(
         size_t contour_index) const;
+
+    /// Returns the bounds of the only contour of the polyline that encloses
+    /// an area if that contour is convex and does not wind around its
+    /// interior more than once. Contours of less than three points enclose
+    /// no area and are ignored. The closing point of the contour is excluded
+    /// from the bounds if it repeats the first point.
+    ///
+    /// Returns |std::nullopt| if there is no such contour, or if more than one
+    /// contour encloses an area. The shape of the contour is not checked if
+    /// |known_convex| is true.
+    std::optional<std::tuple<size_t, size_t>> GetSingleConvexContourBounds(
+        bool known_convex = false) const;
   };
 
   Path();
 
   ~Path();
 
+  Path(const Path& other);
+
+  Path(Path&& other);
+
+  Path& operator=(const Path& other);
+
+  Path& operator=(Path&& other);
+
   size_t GetComponentCount() const;
 
   void SetFillType(FillType fill);
 
   FillType GetFillType() const;
 
+  /// Marks the path as known to be a single convex contour. Adding or
+  /// updating a component resets the convexity to |Convexity::kUnknown|.
+  void SetConvexity(Convexity convexity);
+
+  Convexity GetConvexity() const;
+
   Path& AddLinearComponent(Point p1, Point p2);
 
   Path& AddQuadraticComponent(Point p1, Point cp, Point p2);
@@ -130,23 +166,50 @@ class Path {
 
   std::optional<std::pair<Point, Point>> GetMinMaxCoveragePoints() const;
 
+  /// A hash of the components and fill type of the path, which is the same
+  /// for paths that compare equal.
+  size_t GetHash() const;
+
+  /// Paths are equal if they have the same components and fill type. The
+  /// convexity hint is not compared.
+  bool operator==(const Path& other) const;
+
  private:
   struct ComponentIndexPair {
     ComponentType type = ComponentType::kLinear;
+    /// The index of the first point of the component in |points_|.
     size_t index = 0;
+    /// Whether the contour is closed. Only used by contour components.
+    bool is_closed = false;
 
     ComponentIndexPair() {}
 
     ComponentIndexPair(ComponentType a_type, size_t a_index)
         : type(a_type), index(a_index) {}
+
+    bool operator==(const ComponentIndexPair& other) const {
+      return type == other.type && index == other.index &&
+             is_closed == other.is_closed;
+    }
   };
 
+  LinearPathComponent GetLinear(const ComponentIndexPair& component) const;
+
+  QuadraticPathComponent GetQuadratic(
+      const ComponentIndexPair& component) const;
+
+  CubicPathComponent GetCubic(const ComponentIndexPair& component) const;
+
+  ContourComponent GetContour(const ComponentIndexPair& component) const;
+
+  std::optional<Vector2> GetStartDirection(size_t component_index) const;
+
+  std::optional<Vector2> GetEndDirection(size_t component_index) const;
+
   FillType fill_ = FillType::kNonZero;
+  Convexity convexity_ = Convexity::kUnknown;
   std::vector<ComponentIndexPair> components_;
-  std::vector<LinearPathComponent> linears_;
-  std::vector<QuadraticPathComponent> quads_;
-  std::vector<CubicPathComponent> cubics_;
-  std::vector<ContourComponent> contours_;
+  std::vector<Point> points_;
 };
 
 }  // namespace impeller
@@ -15,15 +15,39 @@ PathBuilder::~PathBuilder() = default;
 Path PathBuilder::CopyPath(FillType fill) const {
   auto path = prototype_;
   path.SetFillType(fill);
+  path.SetConvexity(GetConvexity());
   return path;
 }
 
 Path PathBuilder::TakePath(FillType fill) {
-  auto path = prototype_;
+  auto convexity = GetConvexity();
+  auto path = std::move(prototype_);
   path.SetFillType(fill);
+  path.SetConvexity(convexity);
+  prototype_ = Path();
+  subpath_start_ = {};
+  current_ = {};
+  convex_component_count_ = 0;
   return path;
 }
 
+bool PathBuilder::IsEmpty() const {
+  // A path starts out with a single contour component, which moves to the
+  // origin.
+  return prototype_.GetComponentCount() <= 1;
+}
+
+void PathBuilder::UpdateConvexity(bool is_convex) {
+  convex_component_count_ = is_convex ? prototype_.GetComponentCount() : 0;
+}
+
+Convexity PathBuilder::GetConvexity() const {
+  // Any component added after the convex shape may break its convexity.
+  return convex_component_count_ == prototype_.GetComponentCount()
+             ? Convexity::kConvex
+             : Convexity::kUnknown;
+}
+
 PathBuilder& PathBuilder::MoveTo(Point point, bool relative) {
   current_ = relative ? current_ + point : point;
   subpath_start_ = current_;
@@ -169,6 +193,7 @@ PathBuilder& PathBuilder::AddCubicCurve(Point p1,
 }
 
 PathBuilder& PathBuilder::AddRect(Rect rect) {
+  const bool was_empty = IsEmpty();
   current_ = rect.origin;
 
   auto tl = rect.origin;
@@ -182,6 +207,7 @@ PathBuilder& PathBuilder::AddRect(Rect rect) {
       .AddLinearComponent(br, bl);
   Close();
 
+  UpdateConvexity(was_empty);
   return *this;
 }
 
@@ -198,6 +224,14 @@ PathBuilder& PathBuilder::AddRoundedRect(Rect rect, RoundingRadii radii) {
   if (radii.AreAllZero()) {
     return AddRect(rect);
   }
+  // The corners of a rounded rectangle overlap, and the outline is no longer
+  // convex, if the radii along a side add up to more than its length.
+  const bool is_convex =
+      IsEmpty() &&
+      radii.top_left.x + radii.top_right.x <= rect.size.width &&
+      radii.bottom_left.x + radii.bottom_right.x <= rect.size.width &&
+      radii.top_left.y + radii.bottom_left.y <= rect.size.height &&
+      radii.top_right.y + radii.bottom_right.y <= rect.size.height;
 
   current_ = rect.origin + Point{radii.top_left.x, 0.0};
 
@@ -286,6 +320,7 @@ PathBuilder& PathBuilder::AddRoundedRect(Rect rect, RoundingRadii radii) {
 
   Close();
 
+  UpdateConvexity(is_convex);
   return *this;
 }
 
@@ -350,6 +385,7 @@ PathBuilder& PathBuilder::AddArc(const Rect& oval_bounds,
 }
 
 PathBuilder& PathBuilder::AddOval(const Rect& container) {
+  const bool was_empty = IsEmpty();
   const Point r = {container.size.width * 0.5f, container.size.height * 0.5f};
   const Point c = {container.origin.x + r.x, container.origin.y + r.y};
   const Point m = {kArcApproximationMagic * r.x, kArcApproximationMagic * r.y};
@@ -394,6 +430,7 @@ PathBuilder& PathBuilder::AddOval(const Rect& container) {
 
   Close();
 
+  UpdateConvexity(was_empty);
   return *this;
 }
 
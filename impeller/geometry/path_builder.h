@@ -27,6 +27,8 @@ class PathBuilder {
 
   Path CopyPath(FillType fill = FillType::kNonZero) const;
 
+  /// Moves the path out of the builder without copying it, and resets the
+  /// builder to an empty path.
   Path TakePath(FillType fill = FillType::kNonZero);
 
   const Path& GetCurrentPath() const;
@@ -108,6 +110,15 @@ class PathBuilder {
   Point subpath_start_;
   Point current_;
   Path prototype_;
+  // The component count of the prototype after a convex shape was added to
+  // an empty builder, or zero if the path is not known to be convex.
+  size_t convex_component_count_ = 0;
+
+  bool IsEmpty() const;
+
+  void UpdateConvexity(bool is_convex);
+
+  Convexity GetConvexity() const;
 
   Point ReflectedQuadraticControlPoint1() const;
 
@@ -96,6 +96,11 @@ static Scalar ApproximateParabolaIntegral(Scalar x) {
   return x / (1.0 - d + sqrt(sqrt(pow(d, 4) + 0.25 * x * x)));
 }
 
+static Scalar ApproximateParabolaInverseIntegral(Scalar x) {
+  constexpr Scalar b = 0.39;
+  return x * (1.0 - b + sqrt(b * b + 0.25 * x * x));
+}
+
 std::vector<Point> QuadraticPathComponent::CreatePolyline(
     Scalar tolerance) const {
   std::vector<Point> points;
@@ -113,13 +118,13 @@ void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
   auto cross = (p2 - p1).Cross(dd);
   auto x0 = d01.Dot(dd) * 1 / cross;
   auto x2 = d12.Dot(dd) * 1 / cross;
-  auto scale = abs(cross / (hypot(dd.x, dd.y) * (x2 - x0)));
+  auto scale = std::abs(cross / (hypot(dd.x, dd.y) * (x2 - x0)));
 
   auto a0 = ApproximateParabolaIntegral(x0);
   auto a2 = ApproximateParabolaIntegral(x2);
   Scalar val = 0.f;
   if (std::isfinite(scale)) {
-    auto da = abs(a2 - a0);
+    auto da = std::abs(a2 - a0);
     auto sqrt_scale = sqrt(scale);
     if ((x0 < 0 && x2 < 0) || (x0 >= 0 && x2 >= 0)) {
       val = da * sqrt_scale;
@@ -129,8 +134,8 @@ void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
       val = sqrt_tolerance * da / ApproximateParabolaIntegral(xmin);
     }
   }
-  auto u0 = ApproximateParabolaIntegral(a0);
-  auto u2 = ApproximateParabolaIntegral(a2);
+  auto u0 = ApproximateParabolaInverseIntegral(a0);
+  auto u2 = ApproximateParabolaInverseIntegral(a2);
   auto uscale = 1 / (u2 - u0);
 
   auto line_count = std::max(1., ceil(0.5 * val / sqrt_tolerance));
@@ -138,7 +143,7 @@ void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
   for (size_t i = 1; i < line_count; i += 1) {
     auto u = i * step;
     auto a = a0 + (a2 - a0) * u;
-    auto t = (ApproximateParabolaIntegral(a) - u0) * uscale;
+    auto t = (ApproximateParabolaInverseIntegral(a) - u0) * uscale;
     points.emplace_back(Solve(t));
   }
   points.emplace_back(p2);
@@ -172,12 +177,17 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 }
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar tolerance) const {
-  auto quads = ToQuadraticPathComponents(.1);
   std::vector<Point> points;
+  FillPointsForPolyline(points, tolerance);
+  return points;
+}
+
+void CubicPathComponent::FillPointsForPolyline(std::vector<Point>& points,
+                                               Scalar tolerance) const {
+  auto quads = ToQuadraticPathComponents(tolerance);
   for (const auto& quad : quads) {
     quad.FillPointsForPolyline(points, tolerance);
   }
-  return points;
 }
 
 inline QuadraticPathComponent CubicPathComponent::Lower() const {
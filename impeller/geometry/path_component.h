@@ -118,9 +118,16 @@ struct CubicPathComponent : public PathComponent {
   // generates a polyline from those quadratics.
   //
   // See the note on QuadraticPathComponent::CreatePolyline for references.
+  //
+  // The quadratics approximate the cubic within `tolerance` as well, so that
+  // curves drawn at large scales are not faceted and curves drawn at small
+  // scales are not split into more quadratics than necessary.
   std::vector<Point> CreatePolyline(
       Scalar tolerance = kDefaultCurveTolerance) const;
 
+  void FillPointsForPolyline(std::vector<Point>& points,
+                             Scalar tolerance = kDefaultCurveTolerance) const;
+
   std::vector<Point> Extrema() const;
 
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
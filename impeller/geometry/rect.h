@@ -7,6 +7,7 @@
 #include <array>
 #include <optional>
 #include <ostream>
+#include <type_traits>
 #include <vector>
 
 #include "impeller/geometry/matrix.h"
@@ -162,20 +163,28 @@ struct TRect {
             TPoint(right, bottom)};
   }
 
-  constexpr std::array<TPoint<T>, 4> GetTransformedPoints(
+  std::array<TPoint<T>, 4> GetTransformedPoints(
       const Matrix& transform) const {
     auto points = GetPoints();
-    for (size_t i = 0; i < points.size(); i++) {
-      points[i] = transform * points[i];
+    if constexpr (std::is_same_v<T, Scalar>) {
+      transform.TransformPoints(points.data(), points.data(), points.size());
+    } else {
+      for (size_t i = 0; i < points.size(); i++) {
+        points[i] = transform * points[i];
+      }
     }
     return points;
   }
 
   /// @brief  Creates a new bounding box that contains this transformed
   ///         rectangle.
-  constexpr TRect TransformBounds(const Matrix& transform) const {
-    auto points = GetTransformedPoints(transform);
-    return TRect::MakePointBounds({points.begin(), points.end()}).value();
+  TRect TransformBounds(const Matrix& transform) const {
+    auto p = GetTransformedPoints(transform);
+    return TRect::MakeLTRB(
+        std::min(std::min(p[0].x, p[1].x), std::min(p[2].x, p[3].x)),
+        std::min(std::min(p[0].y, p[1].y), std::min(p[2].y, p[3].y)),
+        std::max(std::max(p[0].x, p[1].x), std::max(p[2].x, p[3].x)),
+        std::max(std::max(p[0].y, p[1].y), std::max(p[2].y, p[3].y)));
   }
 
   constexpr TRect Union(const TRect& o) const {
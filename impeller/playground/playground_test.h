@@ -48,4 +48,13 @@ class PlaygroundTest : public Playground,
         return PlaygroundBackendToString(info.param);                       \
       });
 
+// For tests of the internals of the Vulkan backend, which can't run with the
+// other backends.
+#define INSTANTIATE_VULKAN_PLAYGROUND_SUITE(playground)                     \
+  INSTANTIATE_TEST_SUITE_P(                                                 \
+      Vulkan, playground, ::testing::Values(PlaygroundBackend::kVulkan),    \
+      [](const ::testing::TestParamInfo<PlaygroundTest::ParamType>& info) { \
+        return PlaygroundBackendToString(info.param);                       \
+      });
+
 }  // namespace impeller
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/allocator.h"
 
+#include <algorithm>
+
 #include "impeller/base/validation.h"
 #include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/range.h"
@@ -42,7 +44,13 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
     const DeviceBufferDescriptor& desc) {
-  return OnCreateBuffer(desc);
+  auto buffer = OnCreateBuffer(desc);
+  if (buffer) {
+    buffer_count_++;
+    buffer_bytes_ += desc.size;
+    buffer->TrackDeviceMemory(memory_tracker_);
+  }
+  return buffer;
 }
 
 std::shared_ptr<Texture> Allocator::CreateTexture(
@@ -55,11 +63,63 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
-  return OnCreateTexture(desc);
+  auto texture = OnCreateTexture(desc);
+  if (texture) {
+    texture_count_++;
+    texture_bytes_ += desc.GetByteSizeOfBaseMipLevel();
+    texture->TrackDeviceMemory(memory_tracker_, GetAllocationCategory(desc),
+                               EstimateTextureByteSize(desc));
+  }
+  return texture;
+}
+
+AllocationCategory Allocator::GetAllocationCategory(
+    const TextureDescriptor& desc) {
+  const auto render_target_usage =
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  if (desc.category == AllocationCategory::kOther &&
+      (desc.usage & render_target_usage)) {
+    return AllocationCategory::kRenderTarget;
+  }
+  return desc.category;
+}
+
+size_t Allocator::EstimateTextureByteSize(const TextureDescriptor& desc) {
+  size_t bytes = 0u;
+  auto level = desc;
+  for (size_t mip = 0u; mip < desc.mip_count; mip++) {
+    bytes += level.GetByteSizeOfBaseMipLevel();
+    level.size = ISize(std::max<int64_t>(level.size.width / 2, 1),
+                       std::max<int64_t>(level.size.height / 2, 1));
+  }
+  const auto sample_count = static_cast<size_t>(desc.sample_count);
+  const auto slice_count = desc.type == TextureType::kTextureCube ? 6u : 1u;
+  return bytes * sample_count * slice_count;
+}
+
+DeviceMemoryStatistics Allocator::GetDeviceMemoryStatistics() const {
+  return memory_tracker_->GetStatistics();
+}
+
+AllocationStatistics Allocator::GetAllocationStatistics() const {
+  return {
+      .buffer_count = buffer_count_,
+      .buffer_bytes = buffer_bytes_,
+      .texture_count = texture_count_,
+      .texture_bytes = texture_bytes_,
+  };
 }
 
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
   return BytesPerPixelForPixelFormat(format);
 }
 
+bool Allocator::HasUnifiedMemory() const {
+  return false;
+}
+
+bool Allocator::SupportsCompressedPixelFormat(PixelFormat format) const {
+  return false;
+}
+
 }  // namespace impeller
@@ -4,11 +4,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
+#include "impeller/renderer/device_memory_tracker.h"
 #include "impeller/renderer/texture_descriptor.h"
 
 namespace impeller {
@@ -17,6 +19,17 @@ class Context;
 class DeviceBuffer;
 class Texture;
 
+//------------------------------------------------------------------------------
+/// @brief      The number and size of the buffers and textures an allocator
+///             has created.
+///
+struct AllocationStatistics {
+  size_t buffer_count = 0u;
+  size_t buffer_bytes = 0u;
+  size_t texture_count = 0u;
+  size_t texture_bytes = 0u;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      An object that allocates device memory.
 ///
@@ -37,6 +50,20 @@ class Allocator {
   ///
   virtual uint16_t MinimumBytesPerRow(PixelFormat format) const;
 
+  //------------------------------------------------------------------------------
+  /// @brief      Whether the host and the device share the same memory. If so,
+  ///             host visible device buffers may be used as the storage of
+  ///             textures through `DeviceBuffer::AsTexture` without copying
+  ///             their contents.
+  ///
+  virtual bool HasUnifiedMemory() const;
+
+  //------------------------------------------------------------------------------
+  /// @brief      Whether textures of a compressed pixel format can be created
+  ///             and sampled on this device.
+  ///
+  virtual bool SupportsCompressedPixelFormat(PixelFormat format) const;
+
   std::shared_ptr<DeviceBuffer> CreateBufferWithCopy(const uint8_t* buffer,
                                                      size_t length);
 
@@ -45,6 +72,19 @@ class Allocator {
 
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
+  //------------------------------------------------------------------------------
+  /// @brief      The buffers and textures created so far. The bytes of
+  ///             textures are those of their base mip level.
+  ///
+  AllocationStatistics GetAllocationStatistics() const;
+
+  //------------------------------------------------------------------------------
+  /// @brief      The buffers and textures created by this allocator that are
+  ///             still alive, by category. Textures without a category that
+  ///             are rendered to are accounted as render targets.
+  ///
+  DeviceMemoryStatistics GetDeviceMemoryStatistics() const;
+
  protected:
   Allocator();
 
@@ -55,6 +95,19 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  std::atomic_size_t buffer_count_ = 0u;
+  std::atomic_size_t buffer_bytes_ = 0u;
+  std::atomic_size_t texture_count_ = 0u;
+  std::atomic_size_t texture_bytes_ = 0u;
+  // Shared with the buffers and textures, which may outlive the allocator.
+  const std::shared_ptr<DeviceMemoryTracker> memory_tracker_ =
+      std::make_shared<DeviceMemoryTracker>();
+
+  static AllocationCategory GetAllocationCategory(
+      const TextureDescriptor& desc);
+
+  static size_t EstimateTextureByteSize(const TextureDescriptor& desc);
+
   FML_DISALLOW_COPY_AND_ASSIGN(Allocator);
 };
 
@@ -30,10 +30,10 @@ static std::optional<GLuint> ConfigureFBO(
   }
 
   if (TextureGLES::Cast(*texture).IsWrapped()) {
-    // The texture is attached to the default FBO, so there's no need to
-    // create/configure one.
-    gl.BindFramebuffer(fbo_type, 0);
-    return 0;
+    // The texture is attached to a wrapped FBO, so there's no need to
+    // create/configure one. The FBO isn't owned here and must not be deleted.
+    gl.BindFramebuffer(fbo_type, TextureGLES::Cast(*texture).GetWrappedFBO());
+    return GL_NONE;
   }
 
   GLuint fbo;
@@ -155,6 +155,59 @@ bool BlitCopyTextureToBufferCommandGLES::Encode(
   return true;
 };
 
+BlitCopyBufferToTextureCommandGLES::~BlitCopyBufferToTextureCommandGLES() =
+    default;
+
+std::string BlitCopyBufferToTextureCommandGLES::GetLabel() const {
+  return label;
+}
+
+bool BlitCopyBufferToTextureCommandGLES::Encode(
+    const ReactorGLES& reactor) const {
+  GLenum format;
+  switch (destination->GetTextureDescriptor().format) {
+    case PixelFormat::kA8UNormInt:
+      format = GL_ALPHA;
+      break;
+    case PixelFormat::kR8G8B8A8UNormInt:
+      format = GL_RGBA;
+      break;
+    default:
+      VALIDATION_LOG << "Only textures with pixel format A8 or RGBA are "
+                        "supported yet.";
+      return false;
+  }
+
+  if (destination->GetTextureDescriptor().type != TextureType::kTexture2D) {
+    VALIDATION_LOG << "Only 2D textures are supported yet.";
+    return false;
+  }
+
+  // Binding the texture allocates its storage if it hasn't been yet.
+  if (!TextureGLES::Cast(*destination).Bind()) {
+    return false;
+  }
+
+  const auto& gl = reactor.GetProcTable();
+  // Rows are tightly packed. Single channel rows may not be 4-byte aligned.
+  gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  const auto* data =
+      DeviceBufferGLES::Cast(*source).GetBufferData() + source_offset;
+  gl.TexSubImage2D(GL_TEXTURE_2D,                   // target
+                   0u,                              // LOD level
+                   destination_region.origin.x,     // x offset
+                   destination_region.origin.y,     // y offset
+                   destination_region.size.width,   // width
+                   destination_region.size.height,  // height
+                   format,                          // external format
+                   GL_UNSIGNED_BYTE,                // type
+                   data                             // data
+  );
+  gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  return true;
+};
+
 BlitGenerateMipmapCommandGLES::~BlitGenerateMipmapCommandGLES() = default;
 
 std::string BlitGenerateMipmapCommandGLES::GetLabel() const {
@@ -128,6 +128,49 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
+const std::vector<GLint>& BufferBindingsGLES::GetMemberLocations(
+    const ShaderMetadata& metadata) const {
+  auto& locations = member_locations_[metadata.name];
+  if (locations.size() == metadata.members.size()) {
+    return locations;
+  }
+  locations.clear();
+  locations.reserve(metadata.members.size());
+  for (const auto& member : metadata.members) {
+    if (member.type == ShaderType::kVoid) {
+      // Void types are used for padding. We are obviously not going to find
+      // mappings for these.
+      locations.push_back(-1);
+      continue;
+    }
+    const auto member_key = CreateUnifiormMemberKey(
+        metadata.name, member.name, member.array_elements.value_or(1) > 1);
+    const auto location = uniform_locations_.find(member_key);
+    // The list of uniform locations only contains "active" uniforms that are
+    // not optimized out. So this situation is expected to happen when unused
+    // uniforms are present in the shader.
+    locations.push_back(
+        location == uniform_locations_.end() ? -1 : location->second);
+  }
+  return locations;
+}
+
+std::optional<GLint> BufferBindingsGLES::GetTextureLocation(
+    const ShaderMetadata& metadata) const {
+  auto found = texture_locations_.find(metadata.name);
+  if (found != texture_locations_.end()) {
+    return found->second;
+  }
+  const auto uniform_key = CreateUnifiormMemberKey(metadata.name);
+  auto uniform = uniform_locations_.find(uniform_key);
+  if (uniform == uniform_locations_.end()) {
+    VALIDATION_LOG << "Could not find uniform for key: " << uniform_key;
+    return std::nullopt;
+  }
+  texture_locations_[metadata.name] = uniform->second;
+  return uniform->second;
+}
+
 bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
                                               size_t vertex_offset) const {
   for (const auto& array : vertex_attrib_arrays_) {
@@ -206,78 +249,68 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
     return false;
   }
 
-  for (const auto& member : metadata->members) {
-    if (member.type == ShaderType::kVoid) {
-      // Void types are used for padding. We are obviously not going to find
-      // mappings for these. Keep going.
+  const auto& locations = GetMemberLocations(*metadata);
+  for (size_t i = 0; i < metadata->members.size(); i++) {
+    const auto& member = metadata->members[i];
+    const auto location = locations[i];
+    if (location == -1) {
+      // Padding, or a uniform that is not active. Keep going.
       continue;
     }
 
     size_t element_count = member.array_elements.value_or(1);
-
-    const auto member_key =
-        CreateUnifiormMemberKey(metadata->name, member.name, element_count > 1);
-    const auto location = uniform_locations_.find(member_key);
-    if (location == uniform_locations_.end()) {
-      // The list of uniform locations only contains "active" uniforms that are
-      // not optimized out. So this situation is expected to happen when unused
-      // uniforms are present in the shader.
-      continue;
-    }
-
     size_t element_stride = member.byte_length / element_count;
 
     auto* buffer_data =
         reinterpret_cast<const GLfloat*>(buffer_ptr + member.offset);
 
-    std::vector<uint8_t> array_element_buffer;
     if (element_count > 1) {
       // When binding uniform arrays, the elements must be contiguous. Copy the
       // uniforms to a temp buffer to eliminate any padding needed by the other
       // backends.
-      array_element_buffer.resize(member.size * element_count);
+      array_element_buffer_.resize(member.size * element_count);
       for (size_t element_i = 0; element_i < element_count; element_i++) {
-        std::memcpy(array_element_buffer.data() + element_i * member.size,
+        std::memcpy(array_element_buffer_.data() + element_i * member.size,
                     reinterpret_cast<const char*>(buffer_data) +
                         element_i * element_stride,
                     member.size);
       }
       buffer_data =
-          reinterpret_cast<const GLfloat*>(array_element_buffer.data());
+          reinterpret_cast<const GLfloat*>(array_element_buffer_.data());
     }
 
     switch (member.type) {
       case ShaderType::kFloat:
         switch (member.size) {
           case sizeof(Matrix):
-            gl.UniformMatrix4fv(location->second,  // location
-                                element_count,     // count
-                                GL_FALSE,          // normalize
-                                buffer_data        // data
+            gl.UniformMatrix4fv(location,       // location
+                                element_count,  // count
+                                GL_FALSE,       // normalize
+                                buffer_data     // data
             );
             continue;
           case sizeof(Vector4):
-            gl.Uniform4fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform4fv(location,       // location
+                          element_count,  // count
+                          buffer_data     // data
             );
             continue;
           case sizeof(Vector3):
-            gl.Uniform3fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform3fv(location,       // location
+                          element_count,  // count
+                          buffer_data     // data
             );
             continue;
           case sizeof(Vector2):
-            gl.Uniform2fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform2fv(location,       // location
+                          element_count,  // count
+                          buffer_data     // data
             );
             continue;
           case sizeof(Scalar):
-            gl.Uniform1fv(location->second,  // location
-                          element_count,     // count
-                          buffer_data        // data
+            gl.Uniform1fv(location,       // location
+                          element_count,  // count
+                          buffer_data     // data
             );
             continue;
         }
@@ -300,7 +333,8 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
       case ShaderType::kSampledImage:
       case ShaderType::kSampler:
         VALIDATION_LOG << "Could not bind uniform buffer data for key: "
-                       << member_key;
+                       << CreateUnifiormMemberKey(metadata->name, member.name,
+                                                  element_count > 1);
         return false;
     }
   }
@@ -318,10 +352,8 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
       return false;
     }
 
-    const auto uniform_key = CreateUnifiormMemberKey(texture.second.isa->name);
-    auto uniform = uniform_locations_.find(uniform_key);
-    if (uniform == uniform_locations_.end()) {
-      VALIDATION_LOG << "Could not find uniform for key: " << uniform_key;
+    auto uniform = GetTextureLocation(*texture.second.isa);
+    if (!uniform.has_value()) {
       return false;
     }
 
@@ -357,7 +389,7 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
     //--------------------------------------------------------------------------
     /// Set the texture uniform location.
     ///
-    gl.Uniform1i(uniform->second, active_index);
+    gl.Uniform1i(uniform.value(), active_index);
 
     //--------------------------------------------------------------------------
     /// Bump up the active index at binding.
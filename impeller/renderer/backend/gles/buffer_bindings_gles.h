@@ -5,6 +5,9 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -54,6 +57,20 @@ class BufferBindingsGLES {
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
   std::map<std::string, GLint> uniform_locations_;
+  // The locations of the members of each uniform struct, in the order of its
+  // metadata, and of each texture, looked up the first time they are bound.
+  // Members without a location, like padding or uniforms the driver
+  // optimized out, are -1.
+  mutable std::unordered_map<std::string, std::vector<GLint>>
+      member_locations_;
+  mutable std::unordered_map<std::string, GLint> texture_locations_;
+  // Reused to pack the elements of uniform arrays.
+  mutable std::vector<uint8_t> array_element_buffer_;
+
+  const std::vector<GLint>& GetMemberLocations(
+      const ShaderMetadata& metadata) const;
+
+  std::optional<GLint> GetTextureLocation(const ShaderMetadata& metadata) const;
 
   bool BindUniformBuffer(const ProcTableGLES& gl,
                          Allocator& transients_allocator,
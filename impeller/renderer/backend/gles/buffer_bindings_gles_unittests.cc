@@ -0,0 +1,307 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/base/allocation.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/backend/gles/buffer_bindings_gles.h"
+#include "impeller/renderer/backend/gles/device_buffer_gles.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// A call to one of the glUniform*fv functions.
+struct UniformCall {
+  std::string function;
+  GLint location = -1;
+  GLsizei count = 0;
+  std::vector<GLfloat> values;
+};
+
+// The state of a driver with a single linked program.
+struct MockDriver {
+  // The names of the active uniforms. Their locations are their indices.
+  std::vector<std::string> active_uniforms;
+  size_t location_queries = 0u;
+  std::vector<UniformCall> uniform_calls;
+};
+
+MockDriver g_driver;
+
+GLboolean mockIsProgram(GLuint program) {
+  return GL_TRUE;
+}
+
+void mockGetProgramiv(GLuint program, GLenum name, GLint* value) {
+  switch (name) {
+    case GL_ACTIVE_UNIFORMS:
+      *value = static_cast<GLint>(g_driver.active_uniforms.size());
+      break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+      *value = 64;
+      break;
+    default:
+      *value = 0;
+      break;
+  }
+}
+
+void mockGetActiveUniform(GLuint program,
+                          GLuint index,
+                          GLsizei buffer_size,
+                          GLsizei* length,
+                          GLint* size,
+                          GLenum* type,
+                          GLchar* name) {
+  const auto& uniform = g_driver.active_uniforms[index];
+  std::strncpy(name, uniform.c_str(), buffer_size);
+  *length = static_cast<GLsizei>(uniform.size());
+  *size = 1;
+  *type = GL_FLOAT;
+}
+
+GLint mockGetUniformLocation(GLuint program, const GLchar* name) {
+  g_driver.location_queries++;
+  for (size_t i = 0; i < g_driver.active_uniforms.size(); i++) {
+    if (g_driver.active_uniforms[i] == name) {
+      return static_cast<GLint>(i);
+    }
+  }
+  return -1;
+}
+
+void RecordUniformCall(std::string function,
+                       GLint location,
+                       GLsizei count,
+                       const GLfloat* values,
+                       size_t components) {
+  g_driver.uniform_calls.push_back({
+      .function = std::move(function),
+      .location = location,
+      .count = count,
+      .values = std::vector<GLfloat>(values, values + count * components),
+  });
+}
+
+void mockUniform1fv(GLint location, GLsizei count, const GLfloat* values) {
+  RecordUniformCall("glUniform1fv", location, count, values, 1u);
+}
+
+void mockUniform4fv(GLint location, GLsizei count, const GLfloat* values) {
+  RecordUniformCall("glUniform4fv", location, count, values, 4u);
+}
+
+void mockUniformMatrix4fv(GLint location,
+                          GLsizei count,
+                          GLboolean transpose,
+                          const GLfloat* values) {
+  RecordUniformCall("glUniformMatrix4fv", location, count, values, 16u);
+}
+
+// Uniform buffers that are already device buffers are never allocated.
+class UnusedAllocator final : public Allocator {
+ public:
+  // |Allocator|
+  ISize GetMaxTextureSizeSupported() const override { return {}; }
+
+ private:
+  // |Allocator|
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  }
+
+  // |Allocator|
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+
+// The uniform struct of a shader, laid out the way impellerc lays it out for
+// the other backends.
+//
+//   uniform FrameInfo {
+//     mat4 mvp;
+//     vec4 color;
+//     float unused;
+//     float weights[3];
+//   } frame_info;
+ShaderMetadata MakeFrameInfoMetadata() {
+  return ShaderMetadata{
+      .name = "FrameInfo",
+      .members =
+          {
+              {ShaderType::kFloat, "mvp", 0u, 64u, 64u, std::nullopt},
+              {ShaderType::kFloat, "color", 64u, 16u, 16u, std::nullopt},
+              {ShaderType::kFloat, "unused", 80u, 4u, 4u, std::nullopt},
+              {ShaderType::kVoid, "_PADDING_", 84u, 12u, 12u, std::nullopt},
+              // Array elements are padded to 16 bytes.
+              {ShaderType::kFloat, "weights", 96u, 4u, 48u, 3u},
+          },
+  };
+}
+
+constexpr size_t kFrameInfoSize = 144u;
+
+// The contents of a FrameInfo in which each float is its offset in floats,
+// except for the weights which are 1, 2 and 3.
+std::shared_ptr<DeviceBufferGLES> MakeFrameInfoBuffer(
+    const ReactorGLES::Ref& reactor) {
+  std::vector<GLfloat> contents(kFrameInfoSize / sizeof(GLfloat));
+  for (size_t i = 0; i < contents.size(); i++) {
+    contents[i] = i;
+  }
+  contents[24] = 1.0;
+  contents[28] = 2.0;
+  contents[32] = 3.0;
+
+  auto backing_store = std::make_shared<Allocation>();
+  if (!backing_store->Truncate(kFrameInfoSize)) {
+    return nullptr;
+  }
+  std::memcpy(backing_store->GetBuffer(), contents.data(), kFrameInfoSize);
+  DeviceBufferDescriptor desc;
+  desc.size = kFrameInfoSize;
+  return std::make_shared<DeviceBufferGLES>(desc, reactor,
+                                            std::move(backing_store));
+}
+
+std::vector<GLfloat> MakeRange(GLfloat first, size_t count) {
+  std::vector<GLfloat> values;
+  for (size_t i = 0; i < count; i++) {
+    values.push_back(first + i);
+  }
+  return values;
+}
+
+class BufferBindingsGLESTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    g_driver = {};
+    g_driver.active_uniforms = {
+        "frame_info.mvp",
+        "frame_info.color",
+        "frame_info.weights[0]",
+    };
+    reactor_ = std::make_shared<ReactorGLES>(CreateMockProcTableGLES(
+        {
+            {"glIsProgram", reinterpret_cast<void*>(&mockIsProgram)},
+            {"glGetProgramiv", reinterpret_cast<void*>(&mockGetProgramiv)},
+            {"glGetActiveUniform",
+             reinterpret_cast<void*>(&mockGetActiveUniform)},
+            {"glGetUniformLocation",
+             reinterpret_cast<void*>(&mockGetUniformLocation)},
+            {"glUniform1fv", reinterpret_cast<void*>(&mockUniform1fv)},
+            {"glUniform4fv", reinterpret_cast<void*>(&mockUniform4fv)},
+            {"glUniformMatrix4fv",
+             reinterpret_cast<void*>(&mockUniformMatrix4fv)},
+        },
+        "OpenGL ES 2.0", "OpenGL ES GLSL ES 1.00"));
+    ASSERT_TRUE(reactor_->IsValid());
+  }
+
+  const ProcTableGLES& GetProcTable() const {
+    return reactor_->GetProcTable();
+  }
+
+  ReactorGLES::Ref reactor_;
+  UnusedAllocator allocator_;
+};
+
+}  // namespace
+
+TEST_F(BufferBindingsGLESTest, UniformStructMembersAreBoundToTheirLocations) {
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(GetProcTable(), 1u));
+
+  const auto metadata = MakeFrameInfoMetadata();
+  auto buffer = MakeFrameInfoBuffer(reactor_);
+  ASSERT_TRUE(buffer);
+  Bindings vertex_bindings;
+  vertex_bindings.buffers[0] = BufferResource(
+      &metadata, BufferView{buffer, nullptr, Range(0u, kFrameInfoSize)});
+  ASSERT_TRUE(bindings.BindUniformData(GetProcTable(), allocator_,
+                                       vertex_bindings, {}));
+
+  // The inactive member and the padding are skipped.
+  const auto& calls = g_driver.uniform_calls;
+  ASSERT_EQ(calls.size(), 3u);
+  ASSERT_EQ(calls[0].function, "glUniformMatrix4fv");
+  ASSERT_EQ(calls[0].location, 0);
+  ASSERT_EQ(calls[0].count, 1);
+  ASSERT_EQ(calls[0].values, MakeRange(0.0, 16u));
+  ASSERT_EQ(calls[1].function, "glUniform4fv");
+  ASSERT_EQ(calls[1].location, 1);
+  ASSERT_EQ(calls[1].count, 1);
+  ASSERT_EQ(calls[1].values, MakeRange(16.0, 4u));
+  // The elements of arrays are packed.
+  ASSERT_EQ(calls[2].function, "glUniform1fv");
+  ASSERT_EQ(calls[2].location, 2);
+  ASSERT_EQ(calls[2].count, 3);
+  ASSERT_EQ(calls[2].values, MakeRange(1.0, 3u));
+}
+
+TEST_F(BufferBindingsGLESTest, LocationsAreOnlyQueriedWhenReadingTheProgram) {
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(GetProcTable(), 1u));
+  ASSERT_EQ(g_driver.location_queries, 3u);
+
+  auto buffer = MakeFrameInfoBuffer(reactor_);
+  ASSERT_TRUE(buffer);
+  for (size_t i = 0; i < 3u; i++) {
+    // Runtime effects build their metadata for every draw.
+    const auto metadata = MakeFrameInfoMetadata();
+    Bindings fragment_bindings;
+    fragment_bindings.buffers[0] = BufferResource(
+        &metadata, BufferView{buffer, nullptr, Range(0u, kFrameInfoSize)});
+    ASSERT_TRUE(bindings.BindUniformData(GetProcTable(), allocator_, {},
+                                         fragment_bindings));
+  }
+  ASSERT_EQ(g_driver.location_queries, 3u);
+  ASSERT_EQ(g_driver.uniform_calls.size(), 9u);
+  ASSERT_EQ(g_driver.uniform_calls[8].function, "glUniform1fv");
+  ASSERT_EQ(g_driver.uniform_calls[8].values, MakeRange(1.0, 3u));
+}
+
+TEST_F(BufferBindingsGLESTest, StructsWithOtherMembersAreMappedAgain) {
+  BufferBindingsGLES bindings;
+  ASSERT_TRUE(bindings.ReadUniformsBindings(GetProcTable(), 1u));
+  auto buffer = MakeFrameInfoBuffer(reactor_);
+  ASSERT_TRUE(buffer);
+
+  const auto metadata = MakeFrameInfoMetadata();
+  Bindings vertex_bindings;
+  vertex_bindings.buffers[0] = BufferResource(
+      &metadata, BufferView{buffer, nullptr, Range(0u, kFrameInfoSize)});
+  ASSERT_TRUE(bindings.BindUniformData(GetProcTable(), allocator_,
+                                       vertex_bindings, {}));
+  ASSERT_EQ(g_driver.uniform_calls.size(), 3u);
+
+  // A struct of the same name with only the color.
+  const ShaderMetadata color_metadata{
+      .name = "FrameInfo",
+      .members = {{ShaderType::kFloat, "color", 0u, 16u, 16u, std::nullopt}},
+  };
+  vertex_bindings.buffers[0] = BufferResource(
+      &color_metadata, BufferView{buffer, nullptr, Range(64u, 16u)});
+  ASSERT_TRUE(bindings.BindUniformData(GetProcTable(), allocator_,
+                                       vertex_bindings, {}));
+  ASSERT_EQ(g_driver.uniform_calls.size(), 4u);
+  ASSERT_EQ(g_driver.uniform_calls[3].function, "glUniform4fv");
+  ASSERT_EQ(g_driver.uniform_calls[3].location, 1);
+  ASSERT_EQ(g_driver.uniform_calls[3].values, MakeRange(16.0, 4u));
+}
+
+}  // namespace testing
+}  // namespace impeller
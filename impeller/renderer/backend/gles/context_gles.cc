@@ -12,20 +12,30 @@ namespace impeller {
 
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
-    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries));
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+    fml::UniqueFD cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, std::move(cache_directory)));
 }
 
 ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
                          const std::vector<std::shared_ptr<fml::Mapping>>&
-                             shader_libraries_mappings) {
+                             shader_libraries_mappings,
+                         fml::UniqueFD cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
     return;
   }
 
+  const auto& description = *reactor_->GetProcTable().GetDescription();
+  backend_features_.framebuffer_fetch_support =
+      description.HasExtension("GL_EXT_shader_framebuffer_fetch");
+  backend_features_.npot_address_mode_support =
+      !description.IsES() ||
+      description.GetGlVersion().IsAtLeast(Version(3, 0, 0)) ||
+      description.HasExtension("GL_OES_texture_npot");
+
   // Create the shader library.
   {
     auto library = std::shared_ptr<ShaderLibraryGLES>(
@@ -39,8 +49,8 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(cache_directory)));
   }
 
   // Create allocators.
@@ -92,6 +102,10 @@ bool ContextGLES::RemoveReactorWorker(ReactorGLES::WorkerID id) {
   return reactor_->RemoveWorker(id);
 }
 
+Context::BackendType ContextGLES::GetBackendType() const {
+  return Context::BackendType::kOpenGLES;
+}
+
 bool ContextGLES::IsValid() const {
   return is_valid_;
 }
@@ -139,7 +153,7 @@ bool ContextGLES::SupportsOffscreenMSAA() const {
 
 // |Context|
 const BackendFeatures& ContextGLES::GetBackendFeatures() const {
-  return kLegacyBackendFeatures;
+  return backend_features_;
 }
 
 // |Context|
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
 #include "impeller/renderer/backend/gles/command_buffer_gles.h"
@@ -19,9 +20,19 @@ namespace impeller {
 class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Create a context.
+  ///
+  /// @param[in]  gl                The proc table of the context.
+  /// @param[in]  shader_libraries  The shader libraries to load.
+  /// @param[in]  cache_directory   The directory to cache linked program
+  ///                               binaries in. Programs are compiled on
+  ///                               every launch if it is not valid.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory = {});
 
   // |Context|
   ~ContextGLES() override;
@@ -40,11 +51,16 @@ class ContextGLES final : public Context,
   std::shared_ptr<SamplerLibraryGLES> sampler_library_;
   std::shared_ptr<WorkQueue> work_queue_;
   std::shared_ptr<AllocatorGLES> resource_allocator_;
+  BackendFeatures backend_features_ = kLegacyBackendFeatures;
   bool is_valid_ = false;
 
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory);
+
+  // |Context|
+  BackendType GetBackendType() const override;
 
   // |Context|
   bool IsValid() const override;
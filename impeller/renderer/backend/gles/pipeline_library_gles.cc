@@ -4,19 +4,29 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <iomanip>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "flutter/fml/container.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/promise.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/shader_function_gles.h"
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                                         fml::UniqueFD cache_directory)
+    : reactor_(std::move(reactor)) {
+  if (reactor_ && cache_directory.is_valid()) {
+    binary_cache_ = std::make_unique<ProgramBinaryCacheGLES>(
+        std::move(cache_directory),
+        reactor_->GetProcTable().GetDescription()->GetString());
+  }
+}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -69,22 +79,91 @@ static void LogShaderCompilationFailure(const ProcTableGLES& gl,
   VALIDATION_LOG << stream.str();
 }
 
+static std::string SpecializationConstantToGLSL(
+    const ShaderSpecializationConstant& constant) {
+  switch (constant.type) {
+    case ShaderType::kBoolean:
+      return constant.GetBool() ? "true" : "false";
+    case ShaderType::kSignedInt:
+      return std::to_string(constant.GetSignedInt());
+    case ShaderType::kUnsignedInt:
+      return std::to_string(constant.value) + "u";
+    case ShaderType::kFloat: {
+      // GLSL ES 1.00 doesn't convert integer literals to floats.
+      std::stringstream stream;
+      stream << std::setprecision(9) << std::showpoint << constant.GetFloat();
+      return stream.str();
+    }
+    default:
+      VALIDATION_LOG << "Unsupported type of specialization constant "
+                     << constant.constant_id << ".";
+      return "0";
+  }
+}
+
+// The GLSL generated by impellerc reads each specialization constant from a
+// macro named after its constant ID, which it only defines with the default
+// value of the constant if it isn't defined already. The macros for the
+// constants of the pipeline are defined right after the version directive.
+static std::shared_ptr<const fml::Mapping> SpecializeShaderSource(
+    const std::shared_ptr<const fml::Mapping>& source,
+    const std::vector<ShaderSpecializationConstant>& constants) {
+  if (!source || constants.empty()) {
+    return source;
+  }
+  std::string_view text(reinterpret_cast<const char*>(source->GetMapping()),
+                        source->GetSize());
+  size_t prologue_length = 0u;
+  if (text.rfind("#version", 0u) == 0u) {
+    auto newline = text.find('\n');
+    if (newline == std::string_view::npos) {
+      return source;
+    }
+    prologue_length = newline + 1u;
+  }
+  std::stringstream stream;
+  stream << text.substr(0u, prologue_length);
+  for (const auto& constant : constants) {
+    stream << "#define SPIRV_CROSS_CONSTANT_ID_" << constant.constant_id << " "
+           << SpecializationConstantToGLSL(constant) << "\n";
+  }
+  stream << text.substr(prologue_length);
+  auto specialized = std::make_shared<std::string>(stream.str());
+  return std::make_shared<fml::NonOwnedMapping>(
+      reinterpret_cast<const uint8_t*>(specialized->data()),
+      specialized->size(), [specialized](auto, auto) {});
+}
+
 static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    const ProgramBinaryCacheGLES* binary_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
 
-  auto vert_mapping =
-      ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping();
-  auto frag_mapping =
-      ShaderFunctionGLES::Cast(*frag_function).GetSourceMapping();
+  auto vert_mapping = SpecializeShaderSource(
+      ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping(),
+      descriptor.GetSpecializationConstants());
+  auto frag_mapping = SpecializeShaderSource(
+      ShaderFunctionGLES::Cast(*frag_function).GetSourceMapping(),
+      descriptor.GetSpecializationConstants());
 
   const auto& gl = reactor.GetProcTable();
 
+  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return false;
+  }
+
+  if (binary_cache &&
+      binary_cache->LoadProgram(gl, *program, *vert_mapping, *frag_mapping)) {
+    return true;
+  }
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
@@ -128,12 +207,6 @@ static bool LinkProgram(
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
-    return false;
-  }
-
   gl.AttachShader(*program, vert_shader);
   gl.AttachShader(*program, frag_shader);
 
@@ -154,6 +227,10 @@ static bool LinkProgram(
     );
   }
 
+  if (binary_cache) {
+    binary_cache->PrepareProgram(gl, *program);
+  }
+
   gl.LinkProgram(*program);
 
   GLint link_status = GL_FALSE;
@@ -164,6 +241,10 @@ static bool LinkProgram(
                    << gl.GetProgramInfoLogString(*program);
     return false;
   }
+
+  if (binary_cache) {
+    binary_cache->StoreProgram(gl, *program, *vert_mapping, *frag_mapping);
+  }
   return true;
 }
 
@@ -175,6 +256,7 @@ bool PipelineLibraryGLES::IsValid() const {
 // |PipelineLibrary|
 PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
     PipelineDescriptor descriptor) {
+  Lock lock(pipelines_mutex_);
   if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
     return found->second;
   }
@@ -221,11 +303,13 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
-        );
+        const auto link_result =
+            LinkProgram(reactor,                          //
+                        pipeline,                         //
+                        vert_function,                    //
+                        frag_function,                    //
+                        strong_this->binary_cache_.get()  //
+            );
         if (!link_result) {
           promise->set_value(nullptr);
           VALIDATION_LOG << "Could not link pipeline program.";
@@ -262,6 +346,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryGLES::GetPipeline(
 // |PipelineLibrary|
 void PipelineLibraryGLES::RemovePipelinesWithEntryPoint(
     std::shared_ptr<const ShaderFunction> function) {
+  Lock lock(pipelines_mutex_);
   fml::erase_if(pipelines_, [&](auto item) {
     return item->first.GetEntrypointForStage(function->GetStage())
         ->IsEqual(*function);
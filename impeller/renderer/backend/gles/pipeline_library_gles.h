@@ -4,7 +4,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
@@ -21,9 +26,14 @@ class PipelineLibraryGLES final : public PipelineLibrary {
   friend ContextGLES;
 
   ReactorGLES::Ref reactor_;
-  PipelineMap pipelines_;
-
-  PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  // Pipelines may be requested ahead of their first use on other threads
+  // than the raster thread.
+  Mutex pipelines_mutex_;
+  PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
+  // Null if there is no directory to cache program binaries in.
+  std::unique_ptr<ProgramBinaryCacheGLES> binary_cache_;
+
+  PipelineLibraryGLES(ReactorGLES::Ref reactor, fml::UniqueFD cache_directory);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -111,6 +111,15 @@ ProcTableGLES::ProcTableGLES(Resolver resolver) {
     DiscardFramebufferEXT.Reset();
   }
 
+  // Program binaries are core in GLES 3. Drivers may resolve the entry points
+  // on older contexts too.
+  if (!description_->IsES() ||
+      !description_->GetGlVersion().IsAtLeast(Version(3, 0, 0))) {
+    GetProgramBinary.Reset();
+    ProgramBinary.Reset();
+    ProgramParameteri.Reset();
+  }
+
   capabilities_ = std::make_unique<CapabilitiesGLES>(*this);
 
   is_valid_ = true;
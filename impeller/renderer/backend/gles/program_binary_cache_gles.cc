@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/strings.h"
+
+namespace impeller {
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(fml::UniqueFD cache_directory,
+                                               std::string driver_key)
+    : cache_directory_(
+          std::make_shared<fml::UniqueFD>(std::move(cache_directory))),
+      driver_key_(std::move(driver_key)) {}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsSupported(const ProcTableGLES& gl) const {
+  std::call_once(supported_once_, [this, &gl]() {
+    if (!cache_directory_->is_valid() || !gl.GetProgramBinary.IsAvailable() ||
+        !gl.ProgramBinary.IsAvailable()) {
+      return;
+    }
+    // Drivers that can't store binaries report no formats.
+    GLint format_count = 0;
+    gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    is_supported_ = format_count > 0;
+  });
+  return is_supported_;
+}
+
+// FNV-1a. The names of the files need to be the same from one launch to the
+// next, which |std::hash| doesn't guarantee.
+static uint64_t HashBytes(uint64_t hash, const uint8_t* bytes, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+std::string ProgramBinaryCacheGLES::GetFileName(
+    const fml::Mapping& vert_source,
+    const fml::Mapping& frag_source) const {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  hash = HashBytes(hash, reinterpret_cast<const uint8_t*>(driver_key_.data()),
+                   driver_key_.size());
+  hash = HashBytes(hash, vert_source.GetMapping(), vert_source.GetSize());
+  hash = HashBytes(hash, frag_source.GetMapping(), frag_source.GetSize());
+  return SPrintF("flutter.impeller.glprogram.%016" PRIx64, hash);
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(
+    const ProcTableGLES& gl,
+    GLuint program,
+    const fml::Mapping& vert_source,
+    const fml::Mapping& frag_source) const {
+  if (!IsSupported(gl)) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::LoadProgram");
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      *cache_directory_, GetFileName(vert_source, frag_source));
+  if (!mapping || mapping->GetMapping() == nullptr ||
+      mapping->GetSize() < sizeof(ProgramBinaryHeaderGLES)) {
+    return false;
+  }
+  ProgramBinaryHeaderGLES header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (header.magic != ProgramBinaryHeaderGLES::kMagic ||
+      header.version != ProgramBinaryHeaderGLES::kVersion ||
+      header.data_length != mapping->GetSize() - sizeof(header)) {
+    FML_LOG(INFO) << "Program binary is invalid or truncated. Ignoring.";
+    return false;
+  }
+  gl.ProgramBinary(program, header.binary_format,
+                   mapping->GetMapping() + sizeof(header),
+                   static_cast<GLsizei>(header.data_length));
+  // Drivers reject binaries that were written by other versions of them.
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  return link_status == GL_TRUE;
+}
+
+void ProgramBinaryCacheGLES::PrepareProgram(const ProcTableGLES& gl,
+                                            GLuint program) const {
+  if (!IsSupported(gl) || !gl.ProgramParameteri.IsAvailable()) {
+    return;
+  }
+  gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void ProgramBinaryCacheGLES::StoreProgram(
+    const ProcTableGLES& gl,
+    GLuint program,
+    const fml::Mapping& vert_source,
+    const fml::Mapping& frag_source) const {
+  if (!IsSupported(gl)) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::StoreProgram");
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return;
+  }
+  ProgramBinaryHeaderGLES header;
+  std::vector<uint8_t> contents(sizeof(header) + binary_length);
+  GLsizei written_length = 0;
+  GLenum binary_format = 0;
+  gl.GetProgramBinary(program, binary_length, &written_length, &binary_format,
+                      contents.data() + sizeof(header));
+  if (written_length <= 0) {
+    return;
+  }
+  header.binary_format = binary_format;
+  header.data_length = written_length;
+  contents.resize(sizeof(header) + written_length);
+  std::memcpy(contents.data(), &header, sizeof(header));
+
+  file_io_.WriteAtomically(
+      cache_directory_, GetFileName(vert_source, frag_source),
+      std::make_unique<fml::DataMapping>(std::move(contents)), nullptr,
+      [](bool success) {
+        if (!success) {
+          FML_LOG(WARNING) << "Could not write program binary to disk.";
+        }
+      });
+}
+
+}  // namespace impeller
@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/async_file_io.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The header prepended to the program binaries written to disk.
+///
+struct ProgramBinaryHeaderGLES {
+  static constexpr uint32_t kMagic = 0xC0DEB1A5;
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t binary_format = 0u;
+  // Keeps the header free of padding so that it can be written as is.
+  uint32_t reserved = 0u;
+  uint64_t data_length = 0u;
+};
+
+static_assert(sizeof(ProgramBinaryHeaderGLES) ==
+                  4 * sizeof(uint32_t) + sizeof(uint64_t),
+              "The program binary header must not contain padding.");
+
+//------------------------------------------------------------------------------
+/// @brief      Persists the binaries of linked programs to a cache directory,
+///             so that later launches can load them instead of compiling and
+///             linking the shaders again.
+///
+///             Binaries are keyed by the sources of both shaders of the
+///             program and by the description of the driver that linked
+///             them. Drivers reject binaries they can't load, in which case
+///             the program is compiled as usual.
+///
+///             All calls taking a proc table must be made on a thread with
+///             the context current, usually from a reactor operation.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Create a cache of the programs linked by a driver.
+  ///
+  /// @param[in]  cache_directory  The directory to store binaries in. The
+  ///                              cache does nothing if it is not valid.
+  /// @param[in]  driver_key       A description of the driver that programs
+  ///                              are linked by.
+  ///
+  ProgramBinaryCacheGLES(fml::UniqueFD cache_directory, std::string driver_key);
+
+  ~ProgramBinaryCacheGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      If binaries can be stored and loaded with the driver.
+  ///
+  bool IsSupported(const ProcTableGLES& gl) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Load the binary stored for the shaders into the program.
+  ///
+  /// @return     If the program was linked from the stored binary.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl,
+                   GLuint program,
+                   const fml::Mapping& vert_source,
+                   const fml::Mapping& frag_source) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Ask the driver to keep the binary of the program around.
+  ///             Must be called before the program is linked.
+  ///
+  void PrepareProgram(const ProcTableGLES& gl, GLuint program) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Store the binary of a linked program. The binary is written
+  ///             to disk off the calling thread.
+  ///
+  void StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    const fml::Mapping& vert_source,
+                    const fml::Mapping& frag_source) const;
+
+ private:
+  const std::shared_ptr<const fml::UniqueFD> cache_directory_;
+  const std::string driver_key_;
+  mutable fml::AsyncFileIO file_io_;
+  mutable std::once_flag supported_once_;
+  mutable bool is_supported_ = false;
+
+  std::string GetFileName(const fml::Mapping& vert_source,
+                          const fml::Mapping& frag_source) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgramBinaryCacheGLES);
+};
+
+}  // namespace impeller
@@ -0,0 +1,227 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+constexpr GLenum kBinaryFormat = 0x1234;
+
+// The state of a driver that links every program to the same binary.
+struct MockDriver {
+  GLint binary_format_count = 1;
+  std::string binary = "linked program";
+  GLint link_status = GL_FALSE;
+  size_t loaded_binaries = 0u;
+  GLint retrievable_hint = GL_FALSE;
+};
+
+MockDriver g_driver;
+
+void mockGetIntegerv(GLenum name, GLint* value) {
+  *value = name == GL_NUM_PROGRAM_BINARY_FORMATS ? g_driver.binary_format_count
+                                                 : 16;
+}
+
+void mockGetProgramiv(GLuint program, GLenum name, GLint* value) {
+  switch (name) {
+    case GL_PROGRAM_BINARY_LENGTH:
+      *value = static_cast<GLint>(g_driver.binary.size());
+      break;
+    case GL_LINK_STATUS:
+      *value = g_driver.link_status;
+      break;
+    default:
+      *value = 0;
+      break;
+  }
+}
+
+void mockGetProgramBinary(GLuint program,
+                          GLsizei buffer_size,
+                          GLsizei* length,
+                          GLenum* binary_format,
+                          void* binary) {
+  const auto size = std::min<GLsizei>(buffer_size, g_driver.binary.size());
+  std::memcpy(binary, g_driver.binary.data(), size);
+  *length = size;
+  *binary_format = kBinaryFormat;
+}
+
+void mockProgramBinary(GLuint program,
+                       GLenum binary_format,
+                       const void* binary,
+                       GLsizei length) {
+  g_driver.loaded_binaries++;
+  // Binaries written by other versions of the driver don't link.
+  const bool matches =
+      binary_format == kBinaryFormat &&
+      std::string(static_cast<const char*>(binary), length) == g_driver.binary;
+  g_driver.link_status = matches ? GL_TRUE : GL_FALSE;
+}
+
+void mockProgramParameteri(GLuint program, GLenum name, GLint value) {
+  if (name == GL_PROGRAM_BINARY_RETRIEVABLE_HINT) {
+    g_driver.retrievable_hint = value;
+  }
+}
+
+std::unique_ptr<ProcTableGLES> CreateProcTable() {
+  g_driver = {};
+  return CreateMockProcTableGLES({
+      {"glGetIntegerv", reinterpret_cast<void*>(&mockGetIntegerv)},
+      {"glGetProgramiv", reinterpret_cast<void*>(&mockGetProgramiv)},
+      {"glGetProgramBinary", reinterpret_cast<void*>(&mockGetProgramBinary)},
+      {"glProgramBinary", reinterpret_cast<void*>(&mockProgramBinary)},
+      {"glProgramParameteri", reinterpret_cast<void*>(&mockProgramParameteri)},
+  });
+}
+
+std::unique_ptr<ProgramBinaryCacheGLES> CreateCache(
+    const fml::ScopedTemporaryDirectory& directory,
+    std::string driver_key = "Mock GLES") {
+  return std::make_unique<ProgramBinaryCacheGLES>(
+      fml::OpenDirectory(directory.path().c_str(), false,
+                         fml::FilePermission::kReadWrite),
+      std::move(driver_key));
+}
+
+// Stores the binary of a program the way the pipeline library does, and
+// waits for it to be written.
+void StoreProgram(const ProcTableGLES& gl,
+                  const fml::ScopedTemporaryDirectory& directory,
+                  const fml::Mapping& vert_source,
+                  const fml::Mapping& frag_source) {
+  auto cache = CreateCache(directory);
+  cache->PrepareProgram(gl, 1u);
+  cache->StoreProgram(gl, 1u, vert_source, frag_source);
+  // Pending writes are completed when the cache is destroyed.
+  cache.reset();
+}
+
+}  // namespace
+
+TEST(ProgramBinaryCacheGLESTest, StoredBinariesAreLoadedOnTheNextLaunch) {
+  auto gl = CreateProcTable();
+  ASSERT_TRUE(gl);
+  fml::ScopedTemporaryDirectory directory;
+  fml::NonOwnedMapping vert_source(
+      reinterpret_cast<const uint8_t*>("vertex"), 6u);
+  fml::NonOwnedMapping frag_source(
+      reinterpret_cast<const uint8_t*>("fragment"), 8u);
+
+  // Nothing has been stored yet.
+  ASSERT_FALSE(
+      CreateCache(directory)->LoadProgram(*gl, 1u, vert_source, frag_source));
+  ASSERT_EQ(g_driver.loaded_binaries, 0u);
+
+  StoreProgram(*gl, directory, vert_source, frag_source);
+  ASSERT_EQ(g_driver.retrievable_hint, GL_TRUE);
+
+  ASSERT_TRUE(
+      CreateCache(directory)->LoadProgram(*gl, 2u, vert_source, frag_source));
+  ASSERT_EQ(g_driver.loaded_binaries, 1u);
+}
+
+TEST(ProgramBinaryCacheGLESTest, BinariesAreKeyedByShadersAndDriver) {
+  auto gl = CreateProcTable();
+  ASSERT_TRUE(gl);
+  fml::ScopedTemporaryDirectory directory;
+  fml::NonOwnedMapping vert_source(
+      reinterpret_cast<const uint8_t*>("vertex"), 6u);
+  fml::NonOwnedMapping frag_source(
+      reinterpret_cast<const uint8_t*>("fragment"), 8u);
+  fml::NonOwnedMapping other_frag_source(
+      reinterpret_cast<const uint8_t*>("other fragment"), 14u);
+  StoreProgram(*gl, directory, vert_source, frag_source);
+
+  ASSERT_FALSE(CreateCache(directory)->LoadProgram(*gl, 2u, vert_source,
+                                                   other_frag_source));
+  ASSERT_FALSE(CreateCache(directory, "Other GLES")
+                   ->LoadProgram(*gl, 2u, vert_source, frag_source));
+  ASSERT_EQ(g_driver.loaded_binaries, 0u);
+}
+
+TEST(ProgramBinaryCacheGLESTest, BinariesRejectedByTheDriverAreNotUsed) {
+  auto gl = CreateProcTable();
+  ASSERT_TRUE(gl);
+  fml::ScopedTemporaryDirectory directory;
+  fml::NonOwnedMapping vert_source(
+      reinterpret_cast<const uint8_t*>("vertex"), 6u);
+  fml::NonOwnedMapping frag_source(
+      reinterpret_cast<const uint8_t*>("fragment"), 8u);
+  StoreProgram(*gl, directory, vert_source, frag_source);
+
+  // An update of the driver changes the binaries it links programs to.
+  g_driver.binary = "updated linked program";
+  ASSERT_FALSE(
+      CreateCache(directory)->LoadProgram(*gl, 2u, vert_source, frag_source));
+  ASSERT_EQ(g_driver.loaded_binaries, 1u);
+}
+
+TEST(ProgramBinaryCacheGLESTest, TruncatedBinariesAreIgnored) {
+  auto gl = CreateProcTable();
+  ASSERT_TRUE(gl);
+  fml::ScopedTemporaryDirectory directory;
+  fml::NonOwnedMapping vert_source(
+      reinterpret_cast<const uint8_t*>("vertex"), 6u);
+  fml::NonOwnedMapping frag_source(
+      reinterpret_cast<const uint8_t*>("fragment"), 8u);
+  StoreProgram(*gl, directory, vert_source, frag_source);
+
+  size_t truncated_files = 0u;
+  fml::VisitFiles(directory.fd(), [&](const fml::UniqueFD& base_directory,
+                                      const std::string& file_name) {
+    auto mapping = fml::FileMapping::CreateReadOnly(base_directory, file_name);
+    if (!mapping || mapping->GetSize() == 0u) {
+      return true;
+    }
+    std::vector<uint8_t> contents(
+        mapping->GetMapping(), mapping->GetMapping() + mapping->GetSize() - 1);
+    mapping.reset();
+    fml::DataMapping truncated(std::move(contents));
+    if (fml::WriteAtomically(base_directory, file_name.c_str(), truncated)) {
+      truncated_files++;
+    }
+    return true;
+  });
+  ASSERT_EQ(truncated_files, 1u);
+
+  ASSERT_FALSE(
+      CreateCache(directory)->LoadProgram(*gl, 2u, vert_source, frag_source));
+  ASSERT_EQ(g_driver.loaded_binaries, 0u);
+}
+
+TEST(ProgramBinaryCacheGLESTest, UnsupportedWithoutBinaryFormats) {
+  auto gl = CreateProcTable();
+  ASSERT_TRUE(gl);
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_TRUE(CreateCache(directory)->IsSupported(*gl));
+
+  g_driver.binary_format_count = 0;
+  auto cache = CreateCache(directory);
+  ASSERT_FALSE(cache->IsSupported(*gl));
+  cache->PrepareProgram(*gl, 1u);
+  ASSERT_EQ(g_driver.retrievable_hint, GL_FALSE);
+
+  g_driver.binary_format_count = 1;
+  ProgramBinaryCacheGLES no_directory_cache(fml::UniqueFD{}, "Mock GLES");
+  ASSERT_FALSE(no_directory_cache.IsSupported(*gl));
+}
+
+}  // namespace testing
+}  // namespace impeller
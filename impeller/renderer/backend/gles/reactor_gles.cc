@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
@@ -39,9 +40,35 @@ bool ReactorGLES::RemoveWorker(WorkerID worker) {
   return workers_.erase(worker) == 1;
 }
 
+std::shared_ptr<ReactorGLES::OperationQueue>
+ReactorGLES::GetOperationQueueForCurrentThread() {
+  const auto thread_id = std::this_thread::get_id();
+  {
+    ReaderLock queues_lock(ops_queues_mutex_);
+    if (auto found = ops_queues_.find(thread_id); found != ops_queues_.end()) {
+      return found->second;
+    }
+  }
+  WriterLock queues_lock(ops_queues_mutex_);
+  auto& queue = ops_queues_[thread_id];
+  if (!queue) {
+    queue = std::make_shared<OperationQueue>();
+  }
+  return queue;
+}
+
+bool ReactorGLES::HasPendingOperations(const OperationQueue& queue) const {
+  Lock ops_lock(queue.mutex);
+  return !queue.ops.empty();
+}
+
 bool ReactorGLES::HasPendingOperations() const {
-  Lock ops_lock(ops_mutex_);
-  return !ops_.empty();
+  if (HasPendingOperations(unaffiliated_ops_)) {
+    return true;
+  }
+  ReaderLock queues_lock(ops_queues_mutex_);
+  auto found = ops_queues_.find(std::this_thread::get_id());
+  return found != ops_queues_.end() && HasPendingOperations(*found->second);
 }
 
 const ProcTableGLES& ReactorGLES::GetProcTable() const {
@@ -71,59 +98,80 @@ bool ReactorGLES::AddOperation(Operation operation) {
   if (!operation) {
     return false;
   }
-  {
-    Lock ops_lock(ops_mutex_);
-    ops_.emplace_back(std::move(operation));
+  if (CanReactOnCurrentThread()) {
+    auto queue = GetOperationQueueForCurrentThread();
+    Lock ops_lock(queue->mutex);
+    queue->ops.emplace_back(std::move(operation));
+  } else {
+    Lock ops_lock(unaffiliated_ops_.mutex);
+    unaffiliated_ops_.ops.emplace_back(std::move(operation));
   }
   // Attempt a reaction if able but it is not an error if this isn't possible.
   [[maybe_unused]] auto result = React();
   return true;
 }
 
-static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
-                                            HandleType type) {
-  GLuint handle = GL_NONE;
+static std::vector<GLuint> CreateGLHandles(const ProcTableGLES& gl,
+                                           HandleType type,
+                                           size_t count) {
+  std::vector<GLuint> handles(count, GL_NONE);
+  const auto gl_count = static_cast<GLsizei>(count);
   switch (type) {
     case HandleType::kUnknown:
-      return std::nullopt;
+      return {};
     case HandleType::kTexture:
-      gl.GenTextures(1u, &handle);
-      return handle;
+      gl.GenTextures(gl_count, handles.data());
+      return handles;
     case HandleType::kBuffer:
-      gl.GenBuffers(1u, &handle);
-      return handle;
+      gl.GenBuffers(gl_count, handles.data());
+      return handles;
     case HandleType::kProgram:
-      return gl.CreateProgram();
+      for (auto& handle : handles) {
+        handle = gl.CreateProgram();
+      }
+      return handles;
     case HandleType::kRenderBuffer:
-      gl.GenRenderbuffers(1u, &handle);
-      return handle;
+      gl.GenRenderbuffers(gl_count, handles.data());
+      return handles;
     case HandleType::kFrameBuffer:
-      gl.GenFramebuffers(1u, &handle);
-      return handle;
+      gl.GenFramebuffers(gl_count, handles.data());
+      return handles;
   }
-  return std::nullopt;
+  return {};
+}
+
+static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
+                                            HandleType type) {
+  auto handles = CreateGLHandles(gl, type, 1u);
+  if (handles.empty()) {
+    return std::nullopt;
+  }
+  return handles.front();
 }
 
-static bool CollectGLHandle(const ProcTableGLES& gl,
-                            HandleType type,
-                            GLuint handle) {
+static bool CollectGLHandles(const ProcTableGLES& gl,
+                             HandleType type,
+                             const std::vector<GLuint>& handles) {
+  const auto count = static_cast<GLsizei>(handles.size());
   switch (type) {
     case HandleType::kUnknown:
       return false;
     case HandleType::kTexture:
-      gl.DeleteTextures(1u, &handle);
+      gl.DeleteTextures(count, handles.data());
       return true;
     case HandleType::kBuffer:
-      gl.DeleteBuffers(1u, &handle);
+      gl.DeleteBuffers(count, handles.data());
       return true;
     case HandleType::kProgram:
-      gl.DeleteProgram(handle);
+      for (auto handle : handles) {
+        gl.DeleteProgram(handle);
+      }
       return true;
     case HandleType::kRenderBuffer:
-      gl.DeleteRenderbuffers(1u, &handle);
+      gl.DeleteRenderbuffers(count, handles.data());
       return true;
     case HandleType::kFrameBuffer:
-      gl.DeleteFramebuffers(1u, &handle);
+      gl.DeleteFramebuffers(count, handles.data());
       return true;
   }
   return false;
@@ -142,6 +190,7 @@ HandleGLES ReactorGLES::CreateHandle(HandleType type) {
                        ? CreateGLHandle(GetProcTable(), type)
                        : std::nullopt;
   handles_[new_handle] = LiveHandle{gl_handle};
+  handles_need_consolidation_ |= !gl_handle.has_value();
   return new_handle;
 }
 
@@ -149,6 +198,7 @@ void ReactorGLES::CollectHandle(HandleGLES handle) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
     found->second.pending_collection = true;
+    handles_need_consolidation_ = true;
   }
 }
 
@@ -195,39 +245,65 @@ bool ReactorGLES::ConsolidateHandles() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
+  if (!handles_need_consolidation_) {
+    return true;
+  }
   std::vector<HandleGLES> handles_to_delete;
+  // Handles are created and collected in bulk per type.
+  std::map<HandleType, std::vector<GLuint>> names_to_collect;
+  std::map<HandleType, std::vector<LiveHandle*>> handles_to_create;
+  bool has_pending_debug_labels = false;
   for (auto& handle : handles_) {
     // Collect dead handles.
     if (handle.second.pending_collection) {
       // This could be false if the handle was created and collected without
       // use. We still need to get rid of map entry.
       if (handle.second.name.has_value()) {
-        CollectGLHandle(gl, handle.first.type, handle.second.name.value());
+        names_to_collect[handle.first.type].push_back(
+            handle.second.name.value());
       }
       handles_to_delete.push_back(handle.first);
       continue;
     }
-    // Create live handles.
     if (!handle.second.name.has_value()) {
-      auto gl_handle = CreateGLHandle(gl, handle.first.type);
-      if (!gl_handle) {
-        VALIDATION_LOG << "Could not create GL handle.";
-        return false;
-      }
-      handle.second.name = gl_handle;
+      handles_to_create[handle.first.type].push_back(&handle.second);
+    }
+    has_pending_debug_labels |= handle.second.pending_debug_label.has_value();
+  }
+  for (const auto& names : names_to_collect) {
+    CollectGLHandles(gl, names.first, names.second);
+  }
+  // Create live handles.
+  for (const auto& handles : handles_to_create) {
+    auto names = CreateGLHandles(gl, handles.first, handles.second.size());
+    if (names.size() != handles.second.size()) {
+      VALIDATION_LOG << "Could not create GL handle.";
+      return false;
+    }
+    for (size_t i = 0; i < names.size(); i++) {
+      handles.second[i]->name = names[i];
     }
-    // Set pending debug labels.
-    if (handle.second.pending_debug_label.has_value()) {
+  }
+  for (const auto& handle_to_delete : handles_to_delete) {
+    handles_.erase(handle_to_delete);
+  }
+  // Set pending debug labels.
+  bool debug_labels_remain = false;
+  if (has_pending_debug_labels) {
+    for (auto& handle : handles_) {
+      if (!handle.second.pending_debug_label.has_value()) {
+        continue;
+      }
       if (gl.SetDebugLabel(ToDebugResourceType(handle.first.type),
                            handle.second.name.value(),
                            handle.second.pending_debug_label.value())) {
         handle.second.pending_debug_label = std::nullopt;
+      } else {
+        debug_labels_remain = true;
       }
     }
   }
-  for (const auto& handle_to_delete : handles_to_delete) {
-    handles_.erase(handle_to_delete);
-  }
+  handles_need_consolidation_ = debug_labels_remain;
   return true;
 }
 
@@ -235,15 +311,33 @@ bool ReactorGLES::FlushOps() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   // Do NOT hold the ops or handles locks while performing operations in case
   // the ops enqueue more ops.
-  decltype(ops_) ops;
+  std::vector<Operation> ops;
   {
-    Lock ops_lock(ops_mutex_);
-    std::swap(ops_, ops);
+    Lock ops_lock(unaffiliated_ops_.mutex);
+    std::swap(unaffiliated_ops_.ops, ops);
+  }
+  {
+    auto queue = GetOperationQueueForCurrentThread();
+    Lock ops_lock(queue->mutex);
+    ops.insert(ops.end(), std::make_move_iterator(queue->ops.begin()),
+               std::make_move_iterator(queue->ops.end()));
+    queue->ops.clear();
   }
   for (const auto& op : ops) {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
     op(*this);
   }
+  // When more than one thread reacts, each does so on its own context in a
+  // share group. Flush so that the objects these operations touched are
+  // visible to the other contexts.
+  bool has_shared_contexts = false;
+  {
+    ReaderLock queues_lock(ops_queues_mutex_);
+    has_shared_contexts = ops_queues_.size() > 1u;
+  }
+  if (!ops.empty() && has_shared_contexts) {
+    GetProcTable().Flush();
+  }
   return true;
 }
 
@@ -257,6 +351,7 @@ void ReactorGLES::SetDebugLabel(const HandleGLES& handle, std::string label) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
     found->second.pending_debug_label = std::move(label);
+    handles_need_consolidation_ = true;
   }
 }
 
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -51,6 +53,21 @@ class ReactorGLES {
   void SetDebugLabel(const HandleGLES& handle, std::string label);
 
   using Operation = std::function<void(const ReactorGLES& reactor)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueue an operation and attempt a reaction.
+  ///
+  ///             Operations enqueued on a thread that can react are only
+  ///             performed on that thread. So work enqueued on a thread with
+  ///             a resource context current (texture uploads on the IO
+  ///             thread for instance) never runs on, and stalls, the thread
+  ///             rendering frames. Operations enqueued on threads that cannot
+  ///             react are performed by the next thread that can.
+  ///
+  /// @param[in]  operation  The operation.
+  ///
+  /// @return     If the operation was enqueued.
+  ///
   [[nodiscard]] bool AddOperation(Operation operation);
 
   [[nodiscard]] bool React();
@@ -69,10 +86,21 @@ class ReactorGLES {
     constexpr bool IsLive() const { return name.has_value(); }
   };
 
+  struct OperationQueue {
+    mutable Mutex mutex;
+    std::vector<Operation> ops IPLR_GUARDED_BY(mutex);
+  };
+
   std::unique_ptr<ProcTableGLES> proc_table_;
 
-  mutable Mutex ops_mutex_;
-  std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  // Each thread that can react gets its own queue so that threads enqueueing
+  // work concurrently only contend on the lock of the queue map while the
+  // queue is first created.
+  mutable RWMutex ops_queues_mutex_;
+  std::map<std::thread::id, std::shared_ptr<OperationQueue>> ops_queues_
+      IPLR_GUARDED_BY(ops_queues_mutex_);
+  // Operations enqueued on threads that cannot react.
+  OperationQueue unaffiliated_ops_;
 
   // Make sure the container is one where erasing items during iteration doesn't
   // invalidate other iterators.
@@ -82,6 +110,9 @@ class ReactorGLES {
                                          HandleGLES::Equal>;
   mutable RWMutex handles_mutex_;
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // If any handle needs to be created, collected or labelled on the next
+  // reaction. This avoids walking all live handles on every reaction.
+  bool handles_need_consolidation_ IPLR_GUARDED_BY(handles_mutex_) = false;
 
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
@@ -92,6 +123,10 @@ class ReactorGLES {
 
   bool ReactOnce();
 
+  std::shared_ptr<OperationQueue> GetOperationQueueForCurrentThread();
+
+  bool HasPendingOperations(const OperationQueue& queue) const;
+
   bool HasPendingOperations() const;
 
   bool CanReactOnCurrentThread() const;
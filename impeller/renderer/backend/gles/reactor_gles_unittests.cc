@@ -0,0 +1,247 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/testing/testing.h"
+#include "impeller/base/thread.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// Counts the calls the reactor makes into the driver.
+struct GLCalls {
+  std::atomic<size_t> gen_textures = 0u;
+  std::atomic<size_t> gen_textures_names = 0u;
+  std::atomic<size_t> delete_textures = 0u;
+  std::atomic<size_t> delete_textures_names = 0u;
+  std::atomic<size_t> flushes = 0u;
+  std::atomic<GLuint> last_name = 0u;
+};
+
+GLCalls g_calls;
+
+void mockGenTextures(GLsizei n, GLuint* textures) {
+  g_calls.gen_textures++;
+  g_calls.gen_textures_names += n;
+  for (GLsizei i = 0; i < n; i++) {
+    textures[i] = ++g_calls.last_name;
+  }
+}
+
+void mockDeleteTextures(GLsizei n, const GLuint* textures) {
+  g_calls.delete_textures++;
+  g_calls.delete_textures_names += n;
+}
+
+void mockFlush() {
+  g_calls.flushes++;
+}
+
+// Allows reactions on the threads it is told about.
+class TestWorker final : public ReactorGLES::Worker {
+ public:
+  void AllowReactionsOnCurrentThread() {
+    Lock lock(mutex_);
+    threads_.insert(std::this_thread::get_id());
+  }
+
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    Lock lock(mutex_);
+    return threads_.count(std::this_thread::get_id()) > 0u;
+  }
+
+ private:
+  mutable Mutex mutex_;
+  std::set<std::thread::id> threads_ IPLR_GUARDED_BY(mutex_);
+};
+
+std::shared_ptr<ReactorGLES> CreateReactor(
+    const std::shared_ptr<TestWorker>& worker) {
+  g_calls.gen_textures = 0u;
+  g_calls.gen_textures_names = 0u;
+  g_calls.delete_textures = 0u;
+  g_calls.delete_textures_names = 0u;
+  g_calls.flushes = 0u;
+  auto reactor = std::make_shared<ReactorGLES>(CreateMockProcTableGLES({
+      {"glGenTextures", reinterpret_cast<void*>(&mockGenTextures)},
+      {"glDeleteTextures", reinterpret_cast<void*>(&mockDeleteTextures)},
+      {"glFlush", reinterpret_cast<void*>(&mockFlush)},
+  }));
+  if (!reactor->IsValid()) {
+    return nullptr;
+  }
+  reactor->AddWorker(worker);
+  return reactor;
+}
+
+void RunOnThread(fml::Thread& thread, const std::function<void()>& task) {
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&task, &latch]() {
+    task();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+}  // namespace
+
+TEST(ReactorGLESTest, OperationsRunOnTheThreadThatEnqueuedThem) {
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = CreateReactor(worker);
+  ASSERT_TRUE(reactor);
+  fml::Thread io_thread("io");
+  worker->AllowReactionsOnCurrentThread();
+  RunOnThread(io_thread, [&]() { worker->AllowReactionsOnCurrentThread(); });
+
+  std::vector<std::thread::id> op_threads;
+  std::thread::id io_thread_id;
+  RunOnThread(io_thread, [&]() {
+    io_thread_id = std::this_thread::get_id();
+    ASSERT_TRUE(reactor->AddOperation([&](const ReactorGLES&) {
+      op_threads.push_back(std::this_thread::get_id());
+    }));
+  });
+  ASSERT_TRUE(reactor->AddOperation([&](const ReactorGLES&) {
+    op_threads.push_back(std::this_thread::get_id());
+  }));
+  ASSERT_TRUE(reactor->React());
+
+  ASSERT_EQ(op_threads.size(), 2u);
+  ASSERT_EQ(op_threads[0], io_thread_id);
+  ASSERT_EQ(op_threads[1], std::this_thread::get_id());
+}
+
+TEST(ReactorGLESTest, OperationsFromThreadsThatCannotReactRunOnTheNextThatCan) {
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = CreateReactor(worker);
+  ASSERT_TRUE(reactor);
+  fml::Thread io_thread("io");
+
+  size_t op_count = 0u;
+  std::thread::id op_thread;
+  RunOnThread(io_thread, [&]() {
+    ASSERT_TRUE(reactor->AddOperation([&](const ReactorGLES&) {
+      op_count++;
+      op_thread = std::this_thread::get_id();
+    }));
+    ASSERT_FALSE(reactor->React());
+  });
+  ASSERT_EQ(op_count, 0u);
+
+  worker->AllowReactionsOnCurrentThread();
+  ASSERT_TRUE(reactor->React());
+  ASSERT_EQ(op_count, 1u);
+  ASSERT_EQ(op_thread, std::this_thread::get_id());
+
+  // The operation is not performed again.
+  ASSERT_TRUE(reactor->React());
+  ASSERT_EQ(op_count, 1u);
+}
+
+TEST(ReactorGLESTest, PendingHandlesAreCreatedInBulk) {
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = CreateReactor(worker);
+  ASSERT_TRUE(reactor);
+
+  constexpr size_t kHandleCount = 8u;
+  std::vector<HandleGLES> handles;
+  for (size_t i = 0u; i < kHandleCount; i++) {
+    handles.push_back(reactor->CreateHandle(HandleType::kTexture));
+    ASSERT_FALSE(handles.back().IsDead());
+  }
+  {
+    // Handles have no name until the next reaction.
+    ScopedValidationDisable disable_validation;
+    ASSERT_FALSE(reactor->GetGLHandle(handles.front()).has_value());
+  }
+  ASSERT_EQ(g_calls.gen_textures.load(), 0u);
+
+  worker->AllowReactionsOnCurrentThread();
+  ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  ASSERT_EQ(g_calls.gen_textures.load(), 1u);
+  ASSERT_EQ(g_calls.gen_textures_names.load(), kHandleCount);
+
+  std::set<GLuint> names;
+  for (const auto& handle : handles) {
+    auto name = reactor->GetGLHandle(handle);
+    ASSERT_TRUE(name.has_value());
+    names.insert(name.value());
+  }
+  ASSERT_EQ(names.size(), kHandleCount);
+}
+
+TEST(ReactorGLESTest, CollectedHandlesAreDeletedInBulk) {
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = CreateReactor(worker);
+  ASSERT_TRUE(reactor);
+  worker->AllowReactionsOnCurrentThread();
+
+  // Handles created on a thread that can react are named right away.
+  constexpr size_t kHandleCount = 4u;
+  std::vector<HandleGLES> handles;
+  for (size_t i = 0u; i < kHandleCount; i++) {
+    handles.push_back(reactor->CreateHandle(HandleType::kTexture));
+    ASSERT_TRUE(reactor->GetGLHandle(handles.back()).has_value());
+  }
+  ASSERT_EQ(g_calls.gen_textures.load(), kHandleCount);
+
+  // With nothing to consolidate, reactions make no calls for handles.
+  ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  ASSERT_EQ(g_calls.gen_textures.load(), kHandleCount);
+  ASSERT_EQ(g_calls.delete_textures.load(), 0u);
+
+  for (const auto& handle : handles) {
+    reactor->CollectHandle(handle);
+  }
+  ASSERT_EQ(g_calls.delete_textures.load(), 0u);
+  ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  ASSERT_EQ(g_calls.delete_textures.load(), 1u);
+  ASSERT_EQ(g_calls.delete_textures_names.load(), kHandleCount);
+  ScopedValidationDisable disable_validation;
+  for (const auto& handle : handles) {
+    ASSERT_FALSE(reactor->GetGLHandle(handle).has_value());
+  }
+}
+
+TEST(ReactorGLESTest, OperationsAreOnlyFlushedWithSharedContexts) {
+  auto worker = std::make_shared<TestWorker>();
+  auto reactor = CreateReactor(worker);
+  ASSERT_TRUE(reactor);
+  fml::Thread io_thread("io");
+  worker->AllowReactionsOnCurrentThread();
+
+  ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  ASSERT_EQ(g_calls.flushes.load(), 0u);
+
+  RunOnThread(io_thread, [&]() {
+    worker->AllowReactionsOnCurrentThread();
+    ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  });
+  ASSERT_EQ(g_calls.flushes.load(), 1u);
+
+  ASSERT_TRUE(reactor->AddOperation([](const ReactorGLES&) {}));
+  ASSERT_EQ(g_calls.flushes.load(), 2u);
+
+  // Reactions that perform no operations have nothing to flush.
+  ASSERT_TRUE(reactor->React());
+  ASSERT_EQ(g_calls.flushes.load(), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -166,10 +166,14 @@ struct RenderPassData {
     }
   });
 
+  const auto& color_gles = TextureGLES::Cast(*pass_data.color_attachment);
+  const auto is_wrapped_fbo = color_gles.IsWrapped();
   const auto is_default_fbo =
-      TextureGLES::Cast(*pass_data.color_attachment).IsWrapped();
+      is_wrapped_fbo && color_gles.GetWrappedFBO() == GL_NONE;
 
-  if (!is_default_fbo) {
+  if (is_wrapped_fbo) {
+    gl.BindFramebuffer(GL_FRAMEBUFFER, color_gles.GetWrappedFBO());
+  } else {
     // Create and bind an offscreen FBO.
     gl.GenFramebuffers(1u, &fbo);
     gl.BindFramebuffer(GL_FRAMEBUFFER, fbo);
@@ -17,6 +17,7 @@ SamplerLibraryGLES::~SamplerLibraryGLES() = default;
 // |SamplerLibrary|
 std::shared_ptr<const Sampler> SamplerLibraryGLES::GetSampler(
     SamplerDescriptor descriptor) {
+  Lock lock(samplers_mutex_);
   auto found = samplers_.find(descriptor);
   if (found != samplers_.end()) {
     return found->second;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/sampler_descriptor.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -18,7 +19,9 @@ class SamplerLibraryGLES final : public SamplerLibrary {
  private:
   friend class ContextGLES;
 
-  SamplerMap samplers_;
+  // Samplers are requested by passes that may be encoded concurrently.
+  Mutex samplers_mutex_;
+  SamplerMap samplers_ IPLR_GUARDED_BY(samplers_mutex_);
 
   SamplerLibraryGLES();
 
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+#include <cstring>
+#include <utility>
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// The strings glGetString returns must outlive the call.
+std::string g_gl_version;
+std::string g_shading_language_version;
+
+void doNothing() {}
+
+GLenum mockGetError() {
+  return GL_NO_ERROR;
+}
+
+const GLubyte* mockGetString(GLenum name) {
+  const char* string = "";
+  switch (name) {
+    case GL_VENDOR:
+      string = "Flutter";
+      break;
+    case GL_RENDERER:
+      string = "Mock GLES";
+      break;
+    case GL_VERSION:
+      string = g_gl_version.c_str();
+      break;
+    case GL_SHADING_LANGUAGE_VERSION:
+      string = g_shading_language_version.c_str();
+      break;
+  }
+  return reinterpret_cast<const GLubyte*>(string);
+}
+
+void mockGetIntegerv(GLenum name, GLint* value) {
+  *value = 16;
+}
+
+}  // namespace
+
+std::unique_ptr<ProcTableGLES> CreateMockProcTableGLES(
+    const MockGLESFunctions& functions,
+    std::string gl_version,
+    std::string shading_language_version) {
+  g_gl_version = std::move(gl_version);
+  g_shading_language_version = std::move(shading_language_version);
+  auto gl = std::make_unique<ProcTableGLES>([&functions](const char* name) {
+    if (auto found = functions.find(name); found != functions.end()) {
+      return found->second;
+    }
+    if (strcmp(name, "glGetError") == 0) {
+      return reinterpret_cast<void*>(&mockGetError);
+    }
+    if (strcmp(name, "glGetString") == 0) {
+      return reinterpret_cast<void*>(&mockGetString);
+    }
+    if (strcmp(name, "glGetIntegerv") == 0) {
+      return reinterpret_cast<void*>(&mockGetIntegerv);
+    }
+    return reinterpret_cast<void*>(&doNothing);
+  });
+  if (!gl->IsValid()) {
+    return nullptr;
+  }
+  return gl;
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+namespace testing {
+
+/// The stubs of the GLES functions a test cares about, by function name.
+using MockGLESFunctions = std::unordered_map<std::string, void*>;
+
+//------------------------------------------------------------------------------
+/// @brief      Create a proc table for a driver that doesn't render.
+///
+///             The driver reports the given versions, no errors and 16 for
+///             every integer it is queried for. The given functions resolve
+///             to their stubs, and every other function to a stub that does
+///             nothing.
+///
+/// @return     The proc table, or nullptr if it isn't valid.
+///
+std::unique_ptr<ProcTableGLES> CreateMockProcTableGLES(
+    const MockGLESFunctions& functions = {},
+    std::string gl_version = "OpenGL ES 3.0",
+    std::string shading_language_version = "OpenGL ES GLSL ES 3.00");
+
+}  // namespace testing
+}  // namespace impeller
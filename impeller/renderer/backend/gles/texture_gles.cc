@@ -39,21 +39,24 @@ HandleType ToHandleType(TextureGLES::Type type) {
 }
 
 TextureGLES::TextureGLES(ReactorGLES::Ref reactor, TextureDescriptor desc)
-    : TextureGLES(std::move(reactor), desc, false) {}
+    : TextureGLES(std::move(reactor), desc, false, GL_NONE) {}
 
 TextureGLES::TextureGLES(ReactorGLES::Ref reactor,
                          TextureDescriptor desc,
-                         enum IsWrapped wrapped)
-    : TextureGLES(std::move(reactor), desc, true) {}
+                         enum IsWrapped wrapped,
+                         GLuint fbo)
+    : TextureGLES(std::move(reactor), desc, true, fbo) {}
 
 TextureGLES::TextureGLES(std::shared_ptr<ReactorGLES> reactor,
                          TextureDescriptor desc,
-                         bool is_wrapped)
+                         bool is_wrapped,
+                         GLuint wrapped_fbo)
     : Texture(desc),
       reactor_(std::move(reactor)),
       type_(GetTextureTypeFromDescriptor(GetTextureDescriptor())),
       handle_(reactor_->CreateHandle(ToHandleType(type_))),
-      is_wrapped_(is_wrapped) {
+      is_wrapped_(is_wrapped),
+      wrapped_fbo_(wrapped_fbo) {
   // Ensure the texture descriptor itself is valid.
   if (!GetTextureDescriptor().IsValid()) {
     VALIDATION_LOG << "Invalid texture descriptor.";
@@ -124,6 +127,8 @@ struct TexImage2DData {
       case PixelFormat::kR8G8UNormInt:
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
+      case PixelFormat::kASTC4x4UNorm:
+      case PixelFormat::kETC2R8G8B8A8UNorm:
         return;
     }
     is_valid_ = true;
@@ -171,6 +176,8 @@ struct TexImage2DData {
       case PixelFormat::kR8G8UNormInt:
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
+      case PixelFormat::kASTC4x4UNorm:
+      case PixelFormat::kETC2R8G8B8A8UNorm:
         return;
     }
     is_valid_ = true;
@@ -318,6 +325,8 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB8G8R8A8UNormIntSRGB:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
+    case PixelFormat::kASTC4x4UNorm:
+    case PixelFormat::kETC2R8G8B8A8UNorm:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -26,9 +26,15 @@ class TextureGLES final : public Texture,
 
   TextureGLES(ReactorGLES::Ref reactor, TextureDescriptor desc);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps an attachment of a framebuffer that is owned outside of
+  ///             Impeller. Render passes into the texture render into the
+  ///             framebuffer, which is the default framebuffer unless given.
+  ///
   TextureGLES(ReactorGLES::Ref reactor,
               TextureDescriptor desc,
-              IsWrapped wrapped);
+              IsWrapped wrapped,
+              GLuint fbo = GL_NONE);
 
   // |Texture|
   ~TextureGLES() override;
@@ -52,6 +58,8 @@ class TextureGLES final : public Texture,
 
   bool IsWrapped() const { return is_wrapped_; }
 
+  GLuint GetWrappedFBO() const { return wrapped_fbo_; }
+
  private:
   friend class AllocatorMTL;
 
@@ -60,11 +68,13 @@ class TextureGLES final : public Texture,
   HandleGLES handle_;
   mutable bool contents_initialized_ = false;
   const bool is_wrapped_;
+  const GLuint wrapped_fbo_;
   bool is_valid_ = false;
 
   TextureGLES(std::shared_ptr<ReactorGLES> reactor,
               TextureDescriptor desc,
-              bool is_wrapped);
+              bool is_wrapped,
+              GLuint wrapped_fbo);
 
   // |Texture|
   void SetLabel(std::string_view label) override;
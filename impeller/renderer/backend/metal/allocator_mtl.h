@@ -25,6 +25,8 @@ class AllocatorMTL final : public Allocator {
   std::string allocator_label_;
   bool supports_memoryless_targets_ = false;
   bool supports_uma_ = false;
+  bool supports_astc_ = false;
+  bool supports_etc2_ = false;
   bool is_valid_ = false;
   ISize max_texture_supported_;
 
@@ -44,6 +46,12 @@ class AllocatorMTL final : public Allocator {
   // |Allocator|
   uint16_t MinimumBytesPerRow(PixelFormat format) const override;
 
+  // |Allocator|
+  bool HasUnifiedMemory() const override;
+
+  // |Allocator|
+  bool SupportsCompressedPixelFormat(PixelFormat format) const override;
+
   // |Allocator|
   ISize GetMaxTextureSizeSupported() const override;
 
@@ -50,6 +50,30 @@ static bool DeviceHasUnifiedMemoryArchitecture(id<MTLDevice> device) {
   FML_UNREACHABLE();
 }
 
+// ASTC and ETC2 textures are supported by all Apple GPUs that Impeller runs on,
+// and by no Mac GPU of another vendor.
+static bool DeviceSupportsASTC(id<MTLDevice> device) {
+  if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple2];
+  }
+#if FML_OS_IOS
+  return [device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily2_v1];
+#else
+  return false;
+#endif
+}
+
+static bool DeviceSupportsETC2(id<MTLDevice> device) {
+  if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple1];
+  }
+#if FML_OS_IOS
+  return true;
+#else
+  return false;
+#endif
+}
+
 static ISize DeviceMaxTextureSizeSupported(id<MTLDevice> device) {
   // Since Apple didn't expose API for us to get the max texture size, we have
   // to use hardcoded data from
@@ -86,6 +110,8 @@ AllocatorMTL::AllocatorMTL(id<MTLDevice> device, std::string label)
 
   supports_memoryless_targets_ = DeviceSupportsMemorylessTargets(device_);
   supports_uma_ = DeviceHasUnifiedMemoryArchitecture(device_);
+  supports_astc_ = DeviceSupportsASTC(device_);
+  supports_etc2_ = DeviceSupportsETC2(device_);
   max_texture_supported_ = DeviceMaxTextureSizeSupported(device_);
 
   is_valid_ = true;
@@ -206,6 +232,21 @@ uint16_t AllocatorMTL::MinimumBytesPerRow(PixelFormat format) const {
       minimumLinearTextureAlignmentForPixelFormat:ToMTLPixelFormat(format)]);
 }
 
+bool AllocatorMTL::HasUnifiedMemory() const {
+  return supports_uma_;
+}
+
+bool AllocatorMTL::SupportsCompressedPixelFormat(PixelFormat format) const {
+  switch (format) {
+    case PixelFormat::kASTC4x4UNorm:
+      return supports_astc_;
+    case PixelFormat::kETC2R8G8B8A8UNorm:
+      return supports_etc2_;
+    default:
+      return false;
+  }
+}
+
 ISize AllocatorMTL::GetMaxTextureSizeSupported() const {
   return max_texture_supported_;
 }
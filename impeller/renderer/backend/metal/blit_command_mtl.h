@@ -41,6 +41,16 @@ struct BlitCopyTextureToBufferCommandMTL
   [[nodiscard]] bool Encode(id<MTLBlitCommandEncoder> encoder) const override;
 };
 
+struct BlitCopyBufferToTextureCommandMTL
+    : public BlitCopyBufferToTextureCommand,
+      public BlitEncodeMTL {
+  ~BlitCopyBufferToTextureCommandMTL() override;
+
+  std::string GetLabel() const override;
+
+  [[nodiscard]] bool Encode(id<MTLBlitCommandEncoder> encoder) const override;
+};
+
 struct BlitGenerateMipmapCommandMTL : public BlitGenerateMipmapCommand,
                                       public BlitEncodeMTL {
   ~BlitGenerateMipmapCommandMTL() override;
@@ -7,15 +7,21 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
 #include "impeller/renderer/command_buffer.h"
 
 namespace impeller {
 
-class CommandBufferMTL final : public CommandBuffer {
+class CommandBufferMTL final
+    : public CommandBuffer,
+      public BackendCast<CommandBufferMTL, CommandBuffer> {
  public:
   // |CommandBuffer|
   ~CommandBufferMTL() override;
 
+  // The underlying command buffer, or nil once the commands were submitted.
+  id<MTLCommandBuffer> GetMTLCommandBuffer() const;
+
  private:
   friend class ContextMTL;
 
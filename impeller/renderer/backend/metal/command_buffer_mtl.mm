@@ -151,6 +151,10 @@ static CommandBuffer::Status ToCommitResult(MTLCommandBufferStatus status) {
   return CommandBufferMTL::Status::kError;
 }
 
+id<MTLCommandBuffer> CommandBufferMTL::GetMTLCommandBuffer() const {
+  return buffer_;
+}
+
 bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
   if (callback) {
     [buffer_
@@ -241,12 +241,24 @@ bool ComputePassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
         return false;
       }
     }
+    if (grid_size != thread_group_size) {
+      // The grid is covered by whole threadgroups. Shaders must discard
+      // invocations that fall outside of the grid.
+      auto threads = MTLSizeMake(thread_group_size.width,
+                                 thread_group_size.height, 1);
+      auto groups = MTLSizeMake(
+          (grid_size.width + thread_group_size.width - 1) /
+              thread_group_size.width,
+          (grid_size.height + thread_group_size.height - 1) /
+              thread_group_size.height,
+          1);
+      [encoder dispatchThreadgroups:groups threadsPerThreadgroup:threads];
+      continue;
+    }
+
     // TODO(dnfield): use feature detection to support non-uniform threadgroup
     // sizes.
     // https://github.com/flutter/flutter/issues/110619
-
-    // For now, check that the sizes are uniform.
-    FML_DCHECK(grid_size == thread_group_size);
     auto width = grid_size.width;
     auto height = grid_size.height;
     while (width * height >
@@ -45,10 +45,14 @@ class ContextMTL final : public Context,
   std::shared_ptr<AllocatorMTL> resource_allocator_;
   std::shared_ptr<WorkQueue> work_queue_;
   std::shared_ptr<GPUTracerMTL> gpu_tracer_;
+  BackendFeatures backend_features_ = kModernBackendFeatures;
   bool is_valid_ = false;
 
   ContextMTL(id<MTLDevice> device, NSArray<id<MTLLibrary>>* shader_libraries);
 
+  // |Context|
+  BackendType GetBackendType() const override;
+
   // |Context|
   bool IsValid() const override;
 
@@ -6,6 +6,7 @@
 
 #include <Foundation/Foundation.h>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/paths.h"
@@ -15,6 +16,21 @@
 
 namespace impeller {
 
+static bool DeviceSupportsFramebufferFetch(id<MTLDevice> device) {
+  // The shaders only read the color attachment with `[[color(0)]]` when
+  // targeting iOS. Refer to the "Programmable blending" feature in the table
+  // below:
+  // https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
+#if FML_OS_IOS && !TARGET_OS_SIMULATOR
+  if (@available(ios 13.0, tvos 13.0, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple2];
+  }
+  return [device supportsFeatureSet:MTLFeatureSet_iOS_GPUFamily2_v1];
+#else
+  return false;
+#endif
+}
+
 ContextMTL::ContextMTL(id<MTLDevice> device,
                        NSArray<id<MTLLibrary>>* shader_libraries)
     : device_(device) {
@@ -24,6 +40,9 @@ ContextMTL::ContextMTL(id<MTLDevice> device,
     return;
   }
 
+  backend_features_.framebuffer_fetch_support =
+      DeviceSupportsFramebufferFetch(device_);
+
   // Setup the shader library.
   {
     if (shader_libraries == nil) {
@@ -190,6 +209,10 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
 ContextMTL::~ContextMTL() = default;
 
 // |Context|
+Context::BackendType ContextMTL::GetBackendType() const {
+  return Context::BackendType::kMetal;
+}
+
 bool ContextMTL::IsValid() const {
   return is_valid_;
 }
@@ -252,7 +275,7 @@ bool ContextMTL::SupportsOffscreenMSAA() const {
 
 // |Context|
 const BackendFeatures& ContextMTL::GetBackendFeatures() const {
-  return kModernBackendFeatures;
+  return backend_features_;
 }
 
 }  // namespace impeller
@@ -56,6 +56,15 @@ MTLPixelFormat SafeMTLPixelFormatBGR10_XR_sRGB();
 /// Returns PixelFormat::kUnknown if MTLPixelFormatBGR10_XR isn't supported.
 MTLPixelFormat SafeMTLPixelFormatBGR10_XR();
 
+/// Safe accessor for MTLPixelFormatASTC_4x4_LDR.
+/// Returns MTLPixelFormatInvalid if MTLPixelFormatASTC_4x4_LDR isn't
+/// supported.
+MTLPixelFormat SafeMTLPixelFormatASTC_4x4_LDR();
+
+/// Safe accessor for MTLPixelFormatEAC_RGBA8.
+/// Returns MTLPixelFormatInvalid if MTLPixelFormatEAC_RGBA8 isn't supported.
+MTLPixelFormat SafeMTLPixelFormatEAC_RGBA8();
+
 constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -86,6 +95,10 @@ constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
       return SafeMTLPixelFormatBGR10_XR_sRGB();
     case PixelFormat::kB10G10R10XR:
       return SafeMTLPixelFormatBGR10_XR();
+    case PixelFormat::kASTC4x4UNorm:
+      return SafeMTLPixelFormatASTC_4x4_LDR();
+    case PixelFormat::kETC2R8G8B8A8UNorm:
+      return SafeMTLPixelFormatEAC_RGBA8();
   }
   return MTLPixelFormatInvalid;
 };
@@ -120,4 +120,20 @@ MTLPixelFormat SafeMTLPixelFormatBGR10_XR() {
   }
 }
 
+MTLPixelFormat SafeMTLPixelFormatASTC_4x4_LDR() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatASTC_4x4_LDR;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
+MTLPixelFormat SafeMTLPixelFormatEAC_RGBA8() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatEAC_RGBA8;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
 }  // namespace impeller
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <Metal/Metal.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Limits the number of frames the GPU has not finished yet.
+///
+///             The end of each frame is marked by signaling a shared event
+///             with the number of the frame, so that waiting for the GPU to
+///             catch up does not need a completion handler per frame.
+///
+///             Must only be used on one thread at a time.
+///
+class FramePacerMTL {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a pacer for the frames rendered by |device|, or
+  ///             nullptr if shared events are not supported.
+  ///
+  static std::shared_ptr<FramePacerMTL> Create(id<MTLDevice> device,
+                                               size_t max_frames_in_flight);
+
+  ~FramePacerMTL();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks until fewer than the maximum number of frames are in
+  ///             flight, so that another frame can be started.
+  ///
+  /// @return     False if the GPU did not catch up in time.
+  ///
+  bool WaitForFrameSlot() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the end of the current frame once the commands encoded
+  ///             so far in |command_buffer| completed. Must be called while no
+  ///             encoder of |command_buffer| is active, and
+  ///             |command_buffer| must be committed afterwards.
+  ///
+  void EncodeFrameEnd(id<MTLCommandBuffer> command_buffer);
+
+ private:
+  id<MTLSharedEvent> event_ = nil;
+  MTLSharedEventListener* listener_ = nil;
+  const uint64_t max_frames_in_flight_;
+  // The number of frames whose end was encoded.
+  uint64_t frame_count_ = 0u;
+
+  FramePacerMTL(id<MTLSharedEvent> event, size_t max_frames_in_flight);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramePacerMTL);
+};
+
+}  // namespace impeller
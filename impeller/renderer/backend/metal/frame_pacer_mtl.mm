@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/metal/frame_pacer_mtl.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+// How long to wait for the GPU before frames are started regardless.
+static constexpr int64_t kFrameSlotTimeoutNanos = 1'000'000'000;
+
+std::shared_ptr<FramePacerMTL> FramePacerMTL::Create(
+    id<MTLDevice> device,
+    size_t max_frames_in_flight) {
+  if (device == nil) {
+    return nullptr;
+  }
+  id<MTLSharedEvent> event = [device newSharedEvent];
+  if (event == nil) {
+    return nullptr;
+  }
+  event.label = @"ImpellerFramesInFlight";
+  // The constructor is private. So make_shared may not be used.
+  return std::shared_ptr<FramePacerMTL>(
+      new FramePacerMTL(event, max_frames_in_flight));
+}
+
+FramePacerMTL::FramePacerMTL(id<MTLSharedEvent> event,
+                             size_t max_frames_in_flight)
+    : event_(event),
+      listener_([[MTLSharedEventListener alloc]
+          initWithDispatchQueue:dispatch_queue_create(
+                                    "io.flutter.impeller.frame_pacer",
+                                    DISPATCH_QUEUE_SERIAL)]),
+      max_frames_in_flight_(std::max<size_t>(1u, max_frames_in_flight)) {}
+
+FramePacerMTL::~FramePacerMTL() = default;
+
+bool FramePacerMTL::WaitForFrameSlot() const {
+  if (frame_count_ < max_frames_in_flight_) {
+    return true;
+  }
+  // The frame that has to complete for one fewer frame to be in flight.
+  const uint64_t frame = frame_count_ - max_frames_in_flight_ + 1u;
+  if (event_.signaledValue >= frame) {
+    return true;
+  }
+
+  TRACE_EVENT0("impeller", "FramePacerMTL::WaitForFrameSlot");
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  [event_ notifyListener:listener_
+                 atValue:frame
+                   block:^(id<MTLSharedEvent> event, uint64_t value) {
+                     dispatch_semaphore_signal(semaphore);
+                   }];
+  return dispatch_semaphore_wait(
+             semaphore, dispatch_time(DISPATCH_TIME_NOW,
+                                      kFrameSlotTimeoutNanos)) == 0;
+}
+
+void FramePacerMTL::EncodeFrameEnd(id<MTLCommandBuffer> command_buffer) {
+  frame_count_++;
+  [command_buffer encodeSignalEvent:event_ value:frame_count_];
+}
+
+}  // namespace impeller
@@ -7,6 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/pipeline_library.h"
 
 namespace impeller {
@@ -24,7 +25,10 @@ class PipelineLibraryMTL final : public PipelineLibrary {
   friend ContextMTL;
 
   id<MTLDevice> device_ = nullptr;
-  PipelineMap pipelines_;
+  // Pipelines may be requested ahead of their first use on other threads
+  // than the raster thread.
+  Mutex pipelines_mutex_;
+  PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   ComputePipelineMap compute_pipelines_;
 
   PipelineLibraryMTL(id<MTLDevice> device);
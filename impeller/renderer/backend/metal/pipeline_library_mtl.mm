@@ -31,11 +31,13 @@ static MTLRenderPipelineDescriptor* GetMTLRenderPipelineDescriptor(
   for (const auto& entry : desc.GetStageEntrypoints()) {
     if (entry.first == ShaderStage::kVertex) {
       descriptor.vertexFunction =
-          ShaderFunctionMTL::Cast(*entry.second).GetMTLFunction();
+          ShaderFunctionMTL::Cast(*entry.second)
+              .GetMTLFunctionSpecialized(desc.GetSpecializationConstants());
     }
     if (entry.first == ShaderStage::kFragment) {
       descriptor.fragmentFunction =
-          ShaderFunctionMTL::Cast(*entry.second).GetMTLFunction();
+          ShaderFunctionMTL::Cast(*entry.second)
+              .GetMTLFunctionSpecialized(desc.GetSpecializationConstants());
     }
   }
 
@@ -90,6 +92,7 @@ bool PipelineLibraryMTL::IsValid() const {
 // |PipelineLibrary|
 PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
     PipelineDescriptor descriptor) {
+  Lock lock(pipelines_mutex_);
   if (auto found = pipelines_.find(descriptor); found != pipelines_.end()) {
     return found->second;
   }
@@ -205,6 +208,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
 // |PipelineLibrary|
 void PipelineLibraryMTL::RemovePipelinesWithEntryPoint(
     std::shared_ptr<const ShaderFunction> function) {
+  Lock lock(pipelines_mutex_);
   fml::erase_if(pipelines_, [&](auto item) {
     return item->first.GetEntrypointForStage(function->GetStage())
         ->IsEqual(*function);
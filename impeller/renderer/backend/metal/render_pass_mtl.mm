@@ -4,6 +4,9 @@
 
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
 
+#include <array>
+#include <optional>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
@@ -216,90 +219,106 @@ struct PassBindingsCache {
                  uint64_t index,
                  uint64_t offset,
                  id<MTLBuffer> buffer) {
-    auto& buffers_map = buffers_[stage];
-    auto found = buffers_map.find(index);
-    if (found != buffers_map.end() && found->second.buffer == buffer) {
-      // The right buffer is bound. Check if its offset needs to be updated.
-      if (found->second.offset == offset) {
-        // Buffer and its offset is identical. Nothing to do.
-        return true;
-      }
-
-      // Only the offset needs to be updated.
-      found->second.offset = offset;
+    auto bindings = GetStageBindings(stage);
+    if (!bindings) {
+      VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
+      return false;
+    }
+    if (index < kMaxBufferBindings) {
+      auto& bound = bindings->buffers[index];
+      if (bound.buffer == buffer) {
+        // The right buffer is bound. Check if its offset needs to be updated.
+        if (bound.offset == offset) {
+          // Buffer and its offset is identical. Nothing to do.
+          return true;
+        }
 
-      switch (stage) {
-        case ShaderStage::kVertex:
+        // Only the offset needs to be updated.
+        bound.offset = offset;
+        if (stage == ShaderStage::kVertex) {
           [encoder_ setVertexBufferOffset:offset atIndex:index];
-          return true;
-        case ShaderStage::kFragment:
+        } else {
           [encoder_ setFragmentBufferOffset:offset atIndex:index];
-          return true;
-        default:
-          VALIDATION_LOG << "Cannot update buffer offset of an unknown stage.";
-          return false;
+        }
+        return true;
       }
-      return true;
+      bound = {buffer, static_cast<size_t>(offset)};
     }
-    buffers_map[index] = {buffer, static_cast<size_t>(offset)};
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexBuffer:buffer offset:offset atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentBuffer:buffer offset:offset atIndex:index];
-        return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
+    if (stage == ShaderStage::kVertex) {
+      [encoder_ setVertexBuffer:buffer offset:offset atIndex:index];
+    } else {
+      [encoder_ setFragmentBuffer:buffer offset:offset atIndex:index];
     }
-    return false;
+    return true;
   }
 
   bool SetTexture(ShaderStage stage, uint64_t index, id<MTLTexture> texture) {
-    auto& texture_map = textures_[stage];
-    auto found = texture_map.find(index);
-    if (found != texture_map.end() && found->second == texture) {
-      // Already bound.
-      return true;
+    auto bindings = GetStageBindings(stage);
+    if (!bindings) {
+      VALIDATION_LOG << "Cannot bind texture to unknown shader stage.";
+      return false;
     }
-    texture_map[index] = texture;
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexTexture:texture atIndex:index];
-        return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentTexture:texture atIndex:index];
+    if (index < kMaxTextureBindings) {
+      if (bindings->textures[index] == texture) {
+        // Already bound.
         return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
+      }
+      bindings->textures[index] = texture;
     }
-    return false;
+    if (stage == ShaderStage::kVertex) {
+      [encoder_ setVertexTexture:texture atIndex:index];
+    } else {
+      [encoder_ setFragmentTexture:texture atIndex:index];
+    }
+    return true;
   }
 
   bool SetSampler(ShaderStage stage,
                   uint64_t index,
                   id<MTLSamplerState> sampler) {
-    auto& sampler_map = samplers_[stage];
-    auto found = sampler_map.find(index);
-    if (found != sampler_map.end() && found->second == sampler) {
-      // Already bound.
-      return true;
+    auto bindings = GetStageBindings(stage);
+    if (!bindings) {
+      VALIDATION_LOG << "Cannot bind sampler to unknown shader stage.";
+      return false;
     }
-    sampler_map[index] = sampler;
-    switch (stage) {
-      case ShaderStage::kVertex:
-        [encoder_ setVertexSamplerState:sampler atIndex:index];
+    if (index < kMaxSamplerBindings) {
+      if (bindings->samplers[index] == sampler) {
+        // Already bound.
         return true;
-      case ShaderStage::kFragment:
-        [encoder_ setFragmentSamplerState:sampler atIndex:index];
-        return true;
-      default:
-        VALIDATION_LOG << "Cannot bind buffer to unknown shader stage.";
-        return false;
+      }
+      bindings->samplers[index] = sampler;
     }
-    return false;
+    if (stage == ShaderStage::kVertex) {
+      [encoder_ setVertexSamplerState:sampler atIndex:index];
+    } else {
+      [encoder_ setFragmentSamplerState:sampler atIndex:index];
+    }
+    return true;
+  }
+
+  void SetFrontFacingWinding(MTLWinding winding) {
+    if (winding_.has_value() && winding_.value() == winding) {
+      return;
+    }
+    [encoder_ setFrontFacingWinding:winding];
+    winding_ = winding;
+  }
+
+  void SetCullMode(MTLCullMode cull_mode) {
+    if (cull_mode_.has_value() && cull_mode_.value() == cull_mode) {
+      return;
+    }
+    [encoder_ setCullMode:cull_mode];
+    cull_mode_ = cull_mode;
+  }
+
+  void SetStencilReferenceValue(uint32_t reference) {
+    if (stencil_reference_.has_value() &&
+        stencil_reference_.value() == reference) {
+      return;
+    }
+    [encoder_ setStencilReferenceValue:reference];
+    stencil_reference_ = reference;
   }
 
   void SetViewport(const Viewport& viewport) {
@@ -333,22 +352,46 @@ struct PassBindingsCache {
   }
 
  private:
+  // The bind slots that are tracked. These are the argument table sizes that
+  // all Metal devices support. Bindings past them are always set.
+  static constexpr size_t kMaxBufferBindings = 31u;
+  static constexpr size_t kMaxTextureBindings = 31u;
+  static constexpr size_t kMaxSamplerBindings = 16u;
+
   struct BufferOffsetPair {
     id<MTLBuffer> buffer = nullptr;
     size_t offset = 0u;
   };
-  using BufferMap = std::map<uint64_t, BufferOffsetPair>;
-  using TextureMap = std::map<uint64_t, id<MTLTexture>>;
-  using SamplerMap = std::map<uint64_t, id<MTLSamplerState>>;
+
+  // Bindings are looked up for every resource of every command. So they are
+  // kept in flat arrays indexed by slot rather than maps.
+  struct StageBindings {
+    std::array<BufferOffsetPair, kMaxBufferBindings> buffers = {};
+    std::array<id<MTLTexture>, kMaxTextureBindings> textures = {};
+    std::array<id<MTLSamplerState>, kMaxSamplerBindings> samplers = {};
+  };
 
   const id<MTLRenderCommandEncoder> encoder_;
   id<MTLRenderPipelineState> pipeline_ = nullptr;
   id<MTLDepthStencilState> depth_stencil_ = nullptr;
-  std::map<ShaderStage, BufferMap> buffers_;
-  std::map<ShaderStage, TextureMap> textures_;
-  std::map<ShaderStage, SamplerMap> samplers_;
+  StageBindings vertex_bindings_;
+  StageBindings fragment_bindings_;
   std::optional<Viewport> viewport_;
   std::optional<IRect> scissor_;
+  std::optional<MTLWinding> winding_;
+  std::optional<MTLCullMode> cull_mode_;
+  std::optional<uint32_t> stencil_reference_;
+
+  StageBindings* GetStageBindings(ShaderStage stage) {
+    switch (stage) {
+      case ShaderStage::kVertex:
+        return &vertex_bindings_;
+      case ShaderStage::kFragment:
+        return &fragment_bindings_;
+      default:
+        return nullptr;
+    }
+  }
 };
 
 static bool Bind(PassBindingsCache& pass,
@@ -463,12 +506,12 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     pass_bindings.SetScissor(
         command.scissor.value_or(IRect::MakeSize(GetRenderTargetSize())));
 
-    [encoder setFrontFacingWinding:pipeline_desc.GetWindingOrder() ==
-                                           WindingOrder::kClockwise
-                                       ? MTLWindingClockwise
-                                       : MTLWindingCounterClockwise];
-    [encoder setCullMode:ToMTLCullMode(pipeline_desc.GetCullMode())];
-    [encoder setStencilReferenceValue:command.stencil_reference];
+    pass_bindings.SetFrontFacingWinding(
+        pipeline_desc.GetWindingOrder() == WindingOrder::kClockwise
+            ? MTLWindingClockwise
+            : MTLWindingCounterClockwise);
+    pass_bindings.SetCullMode(ToMTLCullMode(pipeline_desc.GetCullMode()));
+    pass_bindings.SetStencilReferenceValue(command.stencil_reference);
 
     if (!bind_stage_resources(command.vertex_bindings, ShaderStage::kVertex)) {
       return false;
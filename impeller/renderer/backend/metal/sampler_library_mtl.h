@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/comparable.h"
 #include "impeller/renderer/sampler_descriptor.h"
@@ -27,7 +28,9 @@ class SamplerLibraryMTL final
   friend class ContextMTL;
 
   id<MTLDevice> device_ = nullptr;
-  SamplerMap samplers_;
+  // Samplers are requested by passes that may be encoded concurrently.
+  Mutex samplers_mutex_;
+  SamplerMap samplers_ IPLR_GUARDED_BY(samplers_mutex_);
 
   SamplerLibraryMTL(id<MTLDevice> device);
 
@@ -15,6 +15,7 @@ SamplerLibraryMTL::~SamplerLibraryMTL() = default;
 
 std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
     SamplerDescriptor descriptor) {
+  Lock lock(samplers_mutex_);
   auto found = samplers_.find(descriptor);
   if (found != samplers_.end()) {
     return found->second;
@@ -6,9 +6,12 @@
 
 #include <Metal/Metal.h>
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/shader_function.h"
+#include "impeller/renderer/shader_types.h"
 
 namespace impeller {
 
@@ -21,13 +24,26 @@ class ShaderFunctionMTL final
 
   id<MTLFunction> GetMTLFunction() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the function specialized with the function constants of a
+  ///             pipeline. Constants that aren't specified take the default
+  ///             values they are declared with.
+  ///
+  /// @return     The function itself if it has no function constants, or nil
+  ///             if it could not be specialized.
+  ///
+  id<MTLFunction> GetMTLFunctionSpecialized(
+      const std::vector<ShaderSpecializationConstant>& constants) const;
+
  private:
   friend class ShaderLibraryMTL;
 
   id<MTLFunction> function_ = nullptr;
+  id<MTLLibrary> library_ = nullptr;
 
   ShaderFunctionMTL(UniqueID parent_library_id,
                     id<MTLFunction> function,
+                    id<MTLLibrary> library,
                     std::string name,
                     ShaderStage stage);
 
@@ -4,14 +4,18 @@
 
 #include "impeller/renderer/backend/metal/shader_function_mtl.h"
 
+#include "impeller/base/validation.h"
+
 namespace impeller {
 
 ShaderFunctionMTL::ShaderFunctionMTL(UniqueID parent_library_id,
                                      id<MTLFunction> function,
+                                     id<MTLLibrary> library,
                                      std::string name,
                                      ShaderStage stage)
     : ShaderFunction(parent_library_id, std::move(name), stage),
-      function_(function) {}
+      function_(function),
+      library_(library) {}
 
 ShaderFunctionMTL::~ShaderFunctionMTL() = default;
 
@@ -19,4 +23,55 @@ id<MTLFunction> ShaderFunctionMTL::GetMTLFunction() const {
   return function_;
 }
 
+id<MTLFunction> ShaderFunctionMTL::GetMTLFunctionSpecialized(
+    const std::vector<ShaderSpecializationConstant>& constants) const {
+  // Functions with function constants must be specialized before they are
+  // used in a pipeline, even if all of their constants have defaults.
+  if (function_.functionConstantsDictionary.count == 0u) {
+    return function_;
+  }
+
+  auto values = [[MTLFunctionConstantValues alloc] init];
+  for (const auto& constant : constants) {
+    const auto index = static_cast<NSUInteger>(constant.constant_id);
+    switch (constant.type) {
+      case ShaderType::kBoolean: {
+        bool value = constant.GetBool();
+        [values setConstantValue:&value type:MTLDataTypeBool atIndex:index];
+        break;
+      }
+      case ShaderType::kSignedInt:
+        [values setConstantValue:&constant.value
+                            type:MTLDataTypeInt
+                         atIndex:index];
+        break;
+      case ShaderType::kUnsignedInt:
+        [values setConstantValue:&constant.value
+                            type:MTLDataTypeUInt
+                         atIndex:index];
+        break;
+      case ShaderType::kFloat:
+        [values setConstantValue:&constant.value
+                            type:MTLDataTypeFloat
+                         atIndex:index];
+        break;
+      default:
+        VALIDATION_LOG << "Unsupported type of specialization constant "
+                       << constant.constant_id << ".";
+        return nil;
+    }
+  }
+
+  NSError* error = nil;
+  id<MTLFunction> function = [library_ newFunctionWithName:function_.name
+                                            constantValues:values
+                                                     error:&error];
+  if (function == nil) {
+    VALIDATION_LOG << "Could not specialize function "
+                   << function_.name.UTF8String << ": "
+                   << error.localizedDescription.UTF8String;
+  }
+  return function;
+}
+
 }  // namespace impeller
@@ -55,6 +55,7 @@ std::shared_ptr<const ShaderFunction> ShaderLibraryMTL::GetFunction(
   ShaderKey key(name, stage);
 
   id<MTLFunction> function = nil;
+  id<MTLLibrary> library = nil;
 
   {
     ReaderLock lock(libraries_mutex_);
@@ -66,6 +67,7 @@ std::shared_ptr<const ShaderFunction> ShaderLibraryMTL::GetFunction(
     for (size_t i = 0, count = [libraries_ count]; i < count; i++) {
       function = [libraries_[i] newFunctionWithName:@(name.data())];
       if (function) {
+        library = libraries_[i];
         break;
       }
     }
@@ -81,7 +83,7 @@ std::shared_ptr<const ShaderFunction> ShaderLibraryMTL::GetFunction(
     }
 
     auto func = std::shared_ptr<ShaderFunctionMTL>(new ShaderFunctionMTL(
-        library_id_, function, {name.data(), name.size()}, stage));
+        library_id_, function, library, {name.data(), name.size()}, stage));
     functions_[key] = func;
 
     return func;
@@ -6,9 +6,13 @@
 
 #include <QuartzCore/CAMetalLayer.h>
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/metal/frame_pacer_mtl.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/surface.h"
+#include "impeller/renderer/texture.h"
 
 namespace impeller {
 
@@ -35,18 +39,65 @@ class SurfaceMTL final : public Surface {
   static std::unique_ptr<SurfaceMTL> WrapCurrentMetalLayerDrawable(
       const std::shared_ptr<Context>& context,
       CAMetalLayer* layer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that renders into |texture| and copies it
+  ///             into the next drawable of the given Metal layer when
+  ///             presented.
+  ///
+  ///             Unlike |WrapCurrentMetalLayerDrawable|, the drawable is only
+  ///             acquired once the frame was encoded, so that the frame is
+  ///             rendered by the GPU while waiting for a drawable. The layer
+  ///             must not be framebuffer only.
+  ///
+  /// @param[in]  context      The context
+  /// @param[in]  texture      The texture to render into. It must have the
+  ///                          size and pixel format of the drawables of the
+  ///                          layer.
+  /// @param[in]  layer        The layer whose next drawable to present the
+  ///                          texture in.
+  /// @param[in]  frame_pacer  If not null, the end of the frame is marked by
+  ///                          the pacer once presented.
+  ///
+  /// @return     A pointer to the surface or null.
+  ///
+  static std::unique_ptr<SurfaceMTL> WrapTextureForMetalLayer(
+      const std::shared_ptr<Context>& context,
+      const std::shared_ptr<Texture>& texture,
+      CAMetalLayer* layer,
+      std::shared_ptr<FramePacerMTL> frame_pacer);
 #pragma GCC diagnostic pop
 
   // |Surface|
   ~SurfaceMTL() override;
 
+  // The drawable rendered into, or nil if the drawable is acquired when the
+  // surface is presented.
   id<MTLDrawable> drawable() const { return drawable_; }
 
  private:
   id<MTLDrawable> drawable_ = nil;
+  std::shared_ptr<Context> context_;
+  std::shared_ptr<Texture> texture_;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunguarded-availability-new"
+  CAMetalLayer* layer_ = nil;
+#pragma GCC diagnostic pop
+  std::shared_ptr<FramePacerMTL> frame_pacer_;
 
   SurfaceMTL(const RenderTarget& target, id<MTLDrawable> drawable);
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunguarded-availability-new"
+  SurfaceMTL(const RenderTarget& target,
+             std::shared_ptr<Context> context,
+             std::shared_ptr<Texture> texture,
+             CAMetalLayer* layer,
+             std::shared_ptr<FramePacerMTL> frame_pacer);
+#pragma GCC diagnostic pop
+
+  bool PresentTextureInNextDrawable() const;
+
   // |Surface|
   bool Present() const override;
 
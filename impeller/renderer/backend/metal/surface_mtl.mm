@@ -4,10 +4,14 @@
 
 #include "impeller/renderer/backend/metal/surface_mtl.h"
 
+#include <optional>
+
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/metal/command_buffer_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
 #include "impeller/renderer/backend/metal/texture_mtl.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
@@ -15,67 +19,33 @@ namespace impeller {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunguarded-availability-new"
 
-std::unique_ptr<SurfaceMTL> SurfaceMTL::WrapCurrentMetalLayerDrawable(
+// Creates a multisampled render target that resolves into |resolve_texture|.
+static std::optional<RenderTarget> CreateRenderTarget(
     const std::shared_ptr<Context>& context,
-    CAMetalLayer* layer) {
-  TRACE_EVENT0("impeller", "SurfaceMTL::WrapCurrentMetalLayerDrawable");
-
-  if (context == nullptr || !context->IsValid() || layer == nil) {
-    return nullptr;
-  }
-
-  id<CAMetalDrawable> current_drawable = nil;
-  {
-    TRACE_EVENT0("impeller", "WaitForNextDrawable");
-    current_drawable = [layer nextDrawable];
-  }
-
-  if (!current_drawable) {
-    VALIDATION_LOG << "Could not acquire current drawable.";
-    return nullptr;
-  }
-
-  const auto color_format =
-      FromMTLPixelFormat(current_drawable.texture.pixelFormat);
-
-  if (color_format == PixelFormat::kUnknown) {
-    VALIDATION_LOG << "Unknown drawable color format.";
-    return nullptr;
-  }
-
+    const std::shared_ptr<Texture>& resolve_texture) {
   TextureDescriptor color0_tex_desc;
   color0_tex_desc.storage_mode = StorageMode::kDeviceTransient;
   color0_tex_desc.type = TextureType::kTexture2DMultisample;
   color0_tex_desc.sample_count = SampleCount::kCount4;
-  color0_tex_desc.format = color_format;
-  color0_tex_desc.size = {
-      static_cast<ISize::Type>(current_drawable.texture.width),
-      static_cast<ISize::Type>(current_drawable.texture.height)};
+  color0_tex_desc.format = resolve_texture->GetTextureDescriptor().format;
+  color0_tex_desc.size = resolve_texture->GetSize();
   color0_tex_desc.usage = static_cast<uint64_t>(TextureUsage::kRenderTarget);
 
   auto msaa_tex =
       context->GetResourceAllocator()->CreateTexture(color0_tex_desc);
   if (!msaa_tex) {
     VALIDATION_LOG << "Could not allocate MSAA resolve texture.";
-    return nullptr;
+    return std::nullopt;
   }
 
   msaa_tex->SetLabel("ImpellerOnscreenColorMSAA");
 
-  TextureDescriptor color0_resolve_tex_desc;
-  color0_resolve_tex_desc.format = color_format;
-  color0_resolve_tex_desc.size = color0_tex_desc.size;
-  color0_resolve_tex_desc.usage =
-      static_cast<uint64_t>(TextureUsage::kRenderTarget);
-  color0_resolve_tex_desc.storage_mode = StorageMode::kDevicePrivate;
-
   ColorAttachment color0;
   color0.texture = msaa_tex;
   color0.clear_color = Color::DarkSlateGray();
   color0.load_action = LoadAction::kClear;
   color0.store_action = StoreAction::kMultisampleResolve;
-  color0.resolve_texture = std::make_shared<TextureMTL>(
-      color0_resolve_tex_desc, current_drawable.texture);
+  color0.resolve_texture = resolve_texture;
 
   TextureDescriptor stencil0_tex;
   stencil0_tex.storage_mode = StorageMode::kDeviceTransient;
@@ -90,7 +60,7 @@ std::unique_ptr<SurfaceMTL> SurfaceMTL::WrapCurrentMetalLayerDrawable(
 
   if (!stencil_texture) {
     VALIDATION_LOG << "Could not create stencil texture.";
-    return nullptr;
+    return std::nullopt;
   }
   stencil_texture->SetLabel("ImpellerOnscreenStencil");
 
@@ -104,19 +74,108 @@ std::unique_ptr<SurfaceMTL> SurfaceMTL::WrapCurrentMetalLayerDrawable(
   render_target_desc.SetColorAttachment(color0, 0u);
   render_target_desc.SetStencilAttachment(stencil0);
 
+  return render_target_desc;
+}
+
+std::unique_ptr<SurfaceMTL> SurfaceMTL::WrapCurrentMetalLayerDrawable(
+    const std::shared_ptr<Context>& context,
+    CAMetalLayer* layer) {
+  TRACE_EVENT0("impeller", "SurfaceMTL::WrapCurrentMetalLayerDrawable");
+
+  if (context == nullptr || !context->IsValid() || layer == nil) {
+    return nullptr;
+  }
+
+  id<CAMetalDrawable> current_drawable = nil;
+  {
+    TRACE_EVENT0("impeller", "WaitForNextDrawable");
+    current_drawable = [layer nextDrawable];
+  }
+
+  if (!current_drawable) {
+    VALIDATION_LOG << "Could not acquire current drawable.";
+    return nullptr;
+  }
+
+  const auto color_format =
+      FromMTLPixelFormat(current_drawable.texture.pixelFormat);
+
+  if (color_format == PixelFormat::kUnknown) {
+    VALIDATION_LOG << "Unknown drawable color format.";
+    return nullptr;
+  }
+
+  TextureDescriptor resolve_tex_desc;
+  resolve_tex_desc.format = color_format;
+  resolve_tex_desc.size = {
+      static_cast<ISize::Type>(current_drawable.texture.width),
+      static_cast<ISize::Type>(current_drawable.texture.height)};
+  resolve_tex_desc.usage = static_cast<uint64_t>(TextureUsage::kRenderTarget);
+  resolve_tex_desc.storage_mode = StorageMode::kDevicePrivate;
+
+  auto render_target_desc = CreateRenderTarget(
+      context,
+      std::make_shared<TextureMTL>(resolve_tex_desc, current_drawable.texture));
+  if (!render_target_desc.has_value()) {
+    return nullptr;
+  }
+
   // The constructor is private. So make_unique may not be used.
   return std::unique_ptr<SurfaceMTL>(
-      new SurfaceMTL(render_target_desc, current_drawable));
+      new SurfaceMTL(render_target_desc.value(), current_drawable));
+}
+
+std::unique_ptr<SurfaceMTL> SurfaceMTL::WrapTextureForMetalLayer(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Texture>& texture,
+    CAMetalLayer* layer,
+    std::shared_ptr<FramePacerMTL> frame_pacer) {
+  TRACE_EVENT0("impeller", "SurfaceMTL::WrapTextureForMetalLayer");
+
+  if (context == nullptr || !context->IsValid() || texture == nullptr ||
+      layer == nil) {
+    return nullptr;
+  }
+
+  if (layer.framebufferOnly) {
+    VALIDATION_LOG << "The drawables of the layer cannot be copied into.";
+    return nullptr;
+  }
+
+  auto render_target_desc = CreateRenderTarget(context, texture);
+  if (!render_target_desc.has_value()) {
+    return nullptr;
+  }
+
+  // The constructor is private. So make_unique may not be used.
+  return std::unique_ptr<SurfaceMTL>(new SurfaceMTL(render_target_desc.value(),
+                                                    context, texture, layer,
+                                                    std::move(frame_pacer)));
 }
 
 SurfaceMTL::SurfaceMTL(const RenderTarget& target, id<MTLDrawable> drawable)
     : Surface(target), drawable_(drawable) {}
 
+SurfaceMTL::SurfaceMTL(const RenderTarget& target,
+                       std::shared_ptr<Context> context,
+                       std::shared_ptr<Texture> texture,
+                       CAMetalLayer* layer,
+                       std::shared_ptr<FramePacerMTL> frame_pacer)
+    : Surface(target),
+      context_(std::move(context)),
+      texture_(std::move(texture)),
+      layer_(layer),
+      frame_pacer_(std::move(frame_pacer)) {}
+
 // |Surface|
 SurfaceMTL::~SurfaceMTL() = default;
 
 // |Surface|
 bool SurfaceMTL::Present() const {
+  if (layer_ != nil) {
+    return PresentTextureInNextDrawable();
+  }
+
   if (drawable_ == nil) {
     return false;
   }
@@ -124,6 +183,67 @@ bool SurfaceMTL::Present() const {
   [drawable_ present];
   return true;
 }
+
+bool SurfaceMTL::PresentTextureInNextDrawable() const {
+  id<CAMetalDrawable> drawable = nil;
+  {
+    TRACE_EVENT0("impeller", "WaitForNextDrawable");
+    drawable = [layer_ nextDrawable];
+  }
+
+  if (!drawable) {
+    VALIDATION_LOG << "Could not acquire next drawable.";
+    return false;
+  }
+
+  const auto& texture_desc = texture_->GetTextureDescriptor();
+  const ISize drawable_size = {
+      static_cast<ISize::Type>(drawable.texture.width),
+      static_cast<ISize::Type>(drawable.texture.height)};
+  if (FromMTLPixelFormat(drawable.texture.pixelFormat) != texture_desc.format ||
+      drawable_size != texture_desc.size) {
+    VALIDATION_LOG << "The drawable does not match the rendered texture.";
+    return false;
+  }
+
+  TextureDescriptor drawable_tex_desc;
+  drawable_tex_desc.format = texture_desc.format;
+  drawable_tex_desc.size = texture_desc.size;
+  drawable_tex_desc.usage = static_cast<uint64_t>(TextureUsage::kRenderTarget);
+  drawable_tex_desc.storage_mode = StorageMode::kDevicePrivate;
+  auto drawable_texture =
+      TextureMTL::Wrapper(drawable_tex_desc, drawable.texture);
+
+  auto command_buffer = context_->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("ImpellerPresentCommandBuffer");
+
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("ImpellerPresentBlitPass");
+  if (!blit_pass->AddCopy(texture_, drawable_texture) ||
+      !blit_pass->EncodeCommands(context_->GetResourceAllocator())) {
+    return false;
+  }
+
+  // Commands of the same queue complete in order, so this buffer completes
+  // last of the frame.
+  if (frame_pacer_) {
+    frame_pacer_->EncodeFrameEnd(
+        CommandBufferMTL::Cast(*command_buffer).GetMTLCommandBuffer());
+  }
+
+  if (!command_buffer->SubmitCommands()) {
+    return false;
+  }
+
+  [drawable present];
+  return true;
+}
 #pragma GCC diagnostic pop
 
 }  // namespace impeller
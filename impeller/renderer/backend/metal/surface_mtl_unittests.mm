@@ -0,0 +1,187 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <Metal/Metal.h>
+#include <QuartzCore/CAMetalLayer.h>
+
+#include <memory>
+
+#include "flutter/fml/time/time_point.h"
+#include "flutter/testing/testing.h"
+#include "impeller/base/validation.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/backend/metal/context_mtl.h"
+#include "impeller/renderer/backend/metal/frame_pacer_mtl.h"
+#include "impeller/renderer/backend/metal/surface_mtl.h"
+
+namespace impeller {
+namespace testing {
+
+using SurfaceMTLTest = PlaygroundTest;
+INSTANTIATE_PLAYGROUND_SUITE(SurfaceMTLTest);
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunguarded-availability-new"
+
+namespace {
+
+constexpr ISize kDrawableSize = {16, 16};
+
+CAMetalLayer* CreateLayer(id<MTLDevice> device) {
+  CAMetalLayer* layer = [CAMetalLayer layer];
+  layer.device = device;
+  layer.pixelFormat = MTLPixelFormatBGRA8Unorm;
+  layer.drawableSize = CGSizeMake(kDrawableSize.width, kDrawableSize.height);
+  layer.framebufferOnly = NO;
+  return layer;
+}
+
+std::shared_ptr<Texture> CreateOffscreenTexture(const Context& context,
+                                                ISize size) {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kB8G8R8A8UNormInt;
+  desc.size = size;
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget) |
+               static_cast<TextureUsageMask>(TextureUsage::kShaderRead);
+  return context.GetResourceAllocator()->CreateTexture(desc);
+}
+
+}  // namespace
+
+TEST_P(SurfaceMTLTest, DeferredSurfacesAcquireTheDrawableWhenPresented) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend presents to a CAMetalLayer.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  auto texture = CreateOffscreenTexture(*GetContext(), kDrawableSize);
+  ASSERT_TRUE(texture);
+
+  auto surface = SurfaceMTL::WrapTextureForMetalLayer(
+      GetContext(), texture, CreateLayer(device), nullptr);
+  ASSERT_TRUE(surface);
+  ASSERT_TRUE(surface->drawable() == nil);
+  ASSERT_EQ(surface->GetTargetRenderPassDescriptor()
+                .GetColorAttachments()
+                .at(0u)
+                .resolve_texture,
+            texture);
+  ASSERT_TRUE(surface->Present());
+}
+
+TEST_P(SurfaceMTLTest, FramebufferOnlyLayersCannotBeDeferred) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend presents to a CAMetalLayer.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  auto texture = CreateOffscreenTexture(*GetContext(), kDrawableSize);
+  ASSERT_TRUE(texture);
+  auto layer = CreateLayer(device);
+  layer.framebufferOnly = YES;
+
+  ScopedValidationDisable disable_validation;
+  ASSERT_FALSE(
+      SurfaceMTL::WrapTextureForMetalLayer(GetContext(), texture, layer, {}));
+  ASSERT_FALSE(SurfaceMTL::WrapTextureForMetalLayer(GetContext(), nullptr,
+                                                    CreateLayer(device), {}));
+}
+
+TEST_P(SurfaceMTLTest, DeferredSurfacesDoNotPresentMismatchedTextures) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend presents to a CAMetalLayer.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  auto texture = CreateOffscreenTexture(
+      *GetContext(), {kDrawableSize.width * 2, kDrawableSize.height});
+  ASSERT_TRUE(texture);
+
+  auto surface = SurfaceMTL::WrapTextureForMetalLayer(
+      GetContext(), texture, CreateLayer(device), nullptr);
+  ASSERT_TRUE(surface);
+  ScopedValidationDisable disable_validation;
+  ASSERT_FALSE(surface->Present());
+}
+
+TEST_P(SurfaceMTLTest, FramePacerCannotBeCreatedWithoutADevice) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend paces frames with shared events.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  ASSERT_FALSE(FramePacerMTL::Create(nil, 3u));
+  ASSERT_TRUE(FramePacerMTL::Create(device, 3u));
+}
+
+TEST_P(SurfaceMTLTest, FramePacerLimitsTheFramesInFlight) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend paces frames with shared events.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  id<MTLCommandQueue> queue = [device newCommandQueue];
+  auto pacer = FramePacerMTL::Create(device, 2u);
+  ASSERT_TRUE(pacer);
+
+  // Frames whose end was encoded but never committed stay in flight.
+  id<MTLCommandBuffer> first_frame = [queue commandBuffer];
+  pacer->EncodeFrameEnd(first_frame);
+  ASSERT_TRUE(pacer->WaitForFrameSlot());
+  id<MTLCommandBuffer> second_frame = [queue commandBuffer];
+  pacer->EncodeFrameEnd(second_frame);
+  ASSERT_FALSE(pacer->WaitForFrameSlot());
+
+  // Completing the oldest frame frees up a slot.
+  [first_frame commit];
+  [first_frame waitUntilCompleted];
+  ASSERT_TRUE(pacer->WaitForFrameSlot());
+
+  [second_frame commit];
+  [second_frame waitUntilCompleted];
+}
+
+TEST_P(SurfaceMTLTest, FramePacerWaitsForTheGPUToCatchUp) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend paces frames with shared events.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  id<MTLCommandQueue> queue = [device newCommandQueue];
+  auto pacer = FramePacerMTL::Create(device, 1u);
+  ASSERT_TRUE(pacer);
+
+  id<MTLCommandBuffer> frame = [queue commandBuffer];
+  pacer->EncodeFrameEnd(frame);
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_MSEC),
+                 dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+                   [frame commit];
+                 });
+  const auto start = fml::TimePoint::Now();
+  ASSERT_TRUE(pacer->WaitForFrameSlot());
+  ASSERT_LT((fml::TimePoint::Now() - start).ToMilliseconds(), 1000);
+  [frame waitUntilCompleted];
+}
+
+TEST_P(SurfaceMTLTest, PresentingAPacedSurfaceEndsTheFrame) {
+  if (GetParam() != PlaygroundBackend::kMetal) {
+    GTEST_SKIP_("Only the Metal backend paces frames with shared events.");
+  }
+  auto device = ContextMTL::Cast(*GetContext()).GetMTLDevice();
+  auto texture = CreateOffscreenTexture(*GetContext(), kDrawableSize);
+  ASSERT_TRUE(texture);
+  auto layer = CreateLayer(device);
+  auto pacer = FramePacerMTL::Create(device, 1u);
+  ASSERT_TRUE(pacer);
+
+  // Each frame waits for the present of the previous one to complete.
+  for (size_t i = 0u; i < 3u; i++) {
+    ASSERT_TRUE(pacer->WaitForFrameSlot());
+    auto surface = SurfaceMTL::WrapTextureForMetalLayer(GetContext(), texture,
+                                                        layer, pacer);
+    ASSERT_TRUE(surface);
+    ASSERT_TRUE(surface->Present());
+  }
+  ASSERT_TRUE(pacer->WaitForFrameSlot());
+}
+
+#pragma GCC diagnostic pop
+
+}  // namespace testing
+}  // namespace impeller
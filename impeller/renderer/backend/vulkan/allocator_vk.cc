@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/vulkan/procs/vulkan_handle.h"
@@ -16,6 +17,32 @@
 
 namespace impeller {
 
+// Buffers up to this size are sub-allocated from the small buffer pool. Most
+// per-frame uniform and vertex data is much smaller.
+static constexpr size_t kSmallBufferMaxSize = 64u * 1024u;
+
+// The size of each block of device memory in the small buffer pool.
+static constexpr size_t kSmallBufferPoolBlockSize = 4u * 1024u * 1024u;
+
+static vk::BufferCreateInfo GetHostVisibleBufferCreateInfo(size_t size) {
+  return vk::BufferCreateInfo()
+      .setUsage(vk::BufferUsageFlagBits::eVertexBuffer |
+                vk::BufferUsageFlagBits::eIndexBuffer |
+                vk::BufferUsageFlagBits::eUniformBuffer |
+                vk::BufferUsageFlagBits::eTransferSrc |
+                vk::BufferUsageFlagBits::eTransferDst)
+      .setSize(size)
+      .setSharingMode(vk::SharingMode::eExclusive);
+}
+
+static VmaAllocationCreateInfo GetHostVisibleAllocationCreateInfo() {
+  VmaAllocationCreateInfo alloc_create_info = {};
+  alloc_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+  alloc_create_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT |
+                            VMA_ALLOCATION_CREATE_MAPPED_BIT;
+  return alloc_create_info;
+}
+
 AllocatorVK::AllocatorVK(ContextVK& context,
                          uint32_t vulkan_api_version,
                          const vk::PhysicalDevice& physical_device,
@@ -24,6 +51,10 @@ AllocatorVK::AllocatorVK(ContextVK& context,
                          PFN_vkGetInstanceProcAddr get_instance_proc_address,
                          PFN_vkGetDeviceProcAddr get_device_proc_address)
     : context_(context), device_(logical_device) {
+  const auto features = physical_device.getFeatures();
+  supports_astc_ = features.textureCompressionASTC_LDR;
+  supports_etc2_ = features.textureCompressionETC2;
+
   vk_ = fml::MakeRefCounted<vulkan::VulkanProcTable>(get_instance_proc_address);
 
   auto instance_handle = vulkan::VulkanHandle<VkInstance>(instance);
@@ -83,15 +114,82 @@ AllocatorVK::AllocatorVK(ContextVK& context,
     return;
   }
   allocator_ = allocator;
+  if (!CreateSmallBufferPool()) {
+    // Small buffers get allocations of their own instead.
+    FML_LOG(ERROR) << "Could not create the small buffer pool.";
+  }
   is_valid_ = true;
 }
 
 AllocatorVK::~AllocatorVK() {
+  if (small_buffer_pool_) {
+    ::vmaDestroyPool(allocator_, small_buffer_pool_);
+  }
   if (allocator_) {
     ::vmaDestroyAllocator(allocator_);
   }
 }
 
+bool AllocatorVK::CreateSmallBufferPool() {
+  // The sample buffer is only used to pick the memory type. Every buffer in
+  // the pool has the same usage.
+  auto buffer_create_info = static_cast<vk::BufferCreateInfo::NativeType>(
+      GetHostVisibleBufferCreateInfo(kSmallBufferMaxSize));
+  auto alloc_create_info = GetHostVisibleAllocationCreateInfo();
+
+  uint32_t memory_type_index = 0u;
+  auto result = vk::Result{::vmaFindMemoryTypeIndexForBufferInfo(
+      allocator_, &buffer_create_info, &alloc_create_info,
+      &memory_type_index)};
+  if (result != vk::Result::eSuccess) {
+    return false;
+  }
+
+  VmaPoolCreateInfo pool_create_info = {};
+  pool_create_info.memoryTypeIndex = memory_type_index;
+  pool_create_info.blockSize = kSmallBufferPoolBlockSize;
+
+  VmaPool pool = {};
+  result = vk::Result{::vmaCreatePool(allocator_, &pool_create_info, &pool)};
+  if (result != vk::Result::eSuccess) {
+    return false;
+  }
+  small_buffer_pool_ = pool;
+  return true;
+}
+
+void AllocatorVK::DidAcquireSurfaceFrame() {
+  if (!allocator_) {
+    return;
+  }
+  ::vmaSetCurrentFrameIndex(allocator_, ++frame_index_);
+}
+
+GPUMemoryStatistics AllocatorVK::GetMemoryStatistics() const {
+  GPUMemoryStatistics stats;
+  if (!allocator_) {
+    return stats;
+  }
+
+  if (small_buffer_pool_) {
+    VmaStatistics pool_stats = {};
+    ::vmaGetPoolStatistics(allocator_, small_buffer_pool_, &pool_stats);
+    stats.pooled_allocation_count = pool_stats.allocationCount;
+    stats.pooled_allocation_bytes = pool_stats.allocationBytes;
+    stats.pooled_block_bytes = pool_stats.blockBytes;
+  }
+
+  const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+  ::vmaGetMemoryProperties(allocator_, &memory_properties);
+  std::vector<VmaBudget> budgets(memory_properties->memoryHeapCount);
+  ::vmaGetHeapBudgets(allocator_, budgets.data());
+  for (const auto& budget : budgets) {
+    stats.device_memory_usage_bytes += budget.usage;
+    stats.device_memory_budget_bytes += budget.budget;
+  }
+  return stats;
+}
+
 // |Allocator|
 bool AllocatorVK::IsValid() const {
   return is_valid_;
@@ -115,8 +213,11 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   image_create_info.tiling = vk::ImageTiling::eOptimal;
   image_create_info.initialLayout = vk::ImageLayout::eUndefined;
   image_create_info.usage = vk::ImageUsageFlagBits::eSampled |
-                            vk::ImageUsageFlagBits::eColorAttachment |
                             vk::ImageUsageFlagBits::eTransferDst;
+  // Compressed images can only be sampled.
+  if (!IsCompressedPixelFormat(desc.format)) {
+    image_create_info.usage |= vk::ImageUsageFlagBits::eColorAttachment;
+  }
 
   VmaAllocationCreateInfo alloc_create_info = {};
   alloc_create_info.usage = VMA_MEMORY_USAGE_AUTO;
@@ -191,28 +292,23 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     const DeviceBufferDescriptor& desc) {
   // TODO (kaushikiska): consider optimizing  the usage flags based on
   // StorageMode.
+  VmaPool pool =
+      desc.size <= kSmallBufferMaxSize ? small_buffer_pool_ : VmaPool{};
   auto device_allocation = std::make_unique<DeviceBufferAllocationVK>(
-      CreateHostVisibleDeviceAllocation(desc.size));
+      CreateHostVisibleDeviceAllocation(desc.size, pool));
   return std::make_shared<DeviceBufferVK>(desc, context_,
                                           std::move(device_allocation));
 }
 
 DeviceBufferAllocationVK AllocatorVK::CreateHostVisibleDeviceAllocation(
-    size_t size) {
+    size_t size,
+    VmaPool pool) {
   auto buffer_create_info = static_cast<vk::BufferCreateInfo::NativeType>(
-      vk::BufferCreateInfo()
-          .setUsage(vk::BufferUsageFlagBits::eVertexBuffer |
-                    vk::BufferUsageFlagBits::eIndexBuffer |
-                    vk::BufferUsageFlagBits::eUniformBuffer |
-                    vk::BufferUsageFlagBits::eTransferSrc |
-                    vk::BufferUsageFlagBits::eTransferDst)
-          .setSize(size)
-          .setSharingMode(vk::SharingMode::eExclusive));
-
-  VmaAllocationCreateInfo allocCreateInfo = {};
-  allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-  allocCreateInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT |
-                          VMA_ALLOCATION_CREATE_MAPPED_BIT;
+      GetHostVisibleBufferCreateInfo(size));
+
+  VmaAllocationCreateInfo allocCreateInfo =
+      GetHostVisibleAllocationCreateInfo();
+  allocCreateInfo.pool = pool;
 
   VkBuffer buffer;
   VmaAllocation buffer_allocation;
@@ -245,6 +341,18 @@ DeviceBufferAllocationVK AllocatorVK::CreateHostVisibleDeviceAllocation(
   };
 }
 
+// |Allocator|
+bool AllocatorVK::SupportsCompressedPixelFormat(PixelFormat format) const {
+  switch (format) {
+    case PixelFormat::kASTC4x4UNorm:
+      return supports_astc_;
+    case PixelFormat::kETC2R8G8B8A8UNorm:
+      return supports_etc2_;
+    default:
+      return false;
+  }
+}
+
 // |Allocator|
 ISize AllocatorVK::GetMaxTextureSizeSupported() const {
   // TODO(magicianA): Get correct max texture size for Vulkan.
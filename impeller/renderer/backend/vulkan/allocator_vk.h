@@ -11,7 +11,9 @@
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/gpu_tracer.h"
 
+#include <atomic>
 #include <memory>
 
 namespace impeller {
@@ -21,13 +23,31 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   ~AllocatorVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notify the allocator that a new frame is being rendered. The
+  ///             memory budget is refreshed once per frame.
+  ///
+  void DidAcquireSurfaceFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the statistics of the pool backing small buffers and the
+  ///             memory budget of the device.
+  ///
+  GPUMemoryStatistics GetMemoryStatistics() const;
+
  private:
   friend class ContextVK;
 
   fml::RefPtr<vulkan::VulkanProcTable> vk_;
   VmaAllocator allocator_ = {};
+  // Small buffers are sub-allocated from shared blocks in this pool instead of
+  // each getting an allocation of their own.
+  VmaPool small_buffer_pool_ = {};
+  std::atomic<uint32_t> frame_index_ = 0u;
   ContextVK& context_;
   vk::Device device_;
+  bool supports_astc_ = false;
+  bool supports_etc2_ = false;
   bool is_valid_ = false;
 
   AllocatorVK(ContextVK& context,
@@ -49,10 +69,17 @@ class AllocatorVK final : public Allocator {
   std::shared_ptr<Texture> OnCreateTexture(
       const TextureDescriptor& desc) override;
 
+  // |Allocator|
+  bool SupportsCompressedPixelFormat(PixelFormat format) const override;
+
   // |Allocator|
   ISize GetMaxTextureSizeSupported() const override;
 
-  DeviceBufferAllocationVK CreateHostVisibleDeviceAllocation(size_t size);
+  bool CreateSmallBufferPool();
+
+  DeviceBufferAllocationVK CreateHostVisibleDeviceAllocation(
+      size_t size,
+      VmaPool pool = nullptr);
 
   FML_DISALLOW_COPY_AND_ASSIGN(AllocatorVK);
 };
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/testing/testing.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+namespace testing {
+
+using AllocatorVKTest = PlaygroundTest;
+INSTANTIATE_VULKAN_PLAYGROUND_SUITE(AllocatorVKTest);
+
+namespace {
+
+GPUMemoryStatistics GetMemoryStatistics(const Context& context) {
+  auto statistics = context.GetGPUTracer()->GetMemoryStatistics();
+  FML_CHECK(statistics.has_value());
+  return statistics.value();
+}
+
+std::shared_ptr<DeviceBuffer> CreateBuffer(const Context& context,
+                                           size_t size) {
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = size;
+  return context.GetResourceAllocator()->CreateBuffer(desc);
+}
+
+}  // namespace
+
+TEST_P(AllocatorVKTest, ReportsMemoryStatistics) {
+  auto tracer = GetContext()->GetGPUTracer();
+  ASSERT_TRUE(tracer);
+  auto statistics = tracer->GetMemoryStatistics();
+  ASSERT_TRUE(statistics.has_value());
+  ASSERT_GT(statistics->device_memory_budget_bytes, 0u);
+  ASSERT_GE(statistics->device_memory_usage_bytes,
+            statistics->pooled_block_bytes);
+  ASSERT_GE(statistics->pooled_block_bytes,
+            statistics->pooled_allocation_bytes);
+}
+
+TEST_P(AllocatorVKTest, SmallBuffersAreSubAllocatedFromThePool) {
+  auto& context = *GetContext();
+  const auto before = GetMemoryStatistics(context);
+
+  constexpr size_t kBufferCount = 64u;
+  constexpr size_t kBufferSize = 1024u;
+  std::vector<std::shared_ptr<DeviceBuffer>> buffers;
+  for (size_t i = 0u; i < kBufferCount; i++) {
+    buffers.push_back(CreateBuffer(context, kBufferSize));
+    ASSERT_TRUE(buffers.back());
+  }
+
+  const auto during = GetMemoryStatistics(context);
+  ASSERT_EQ(during.pooled_allocation_count,
+            before.pooled_allocation_count + kBufferCount);
+  ASSERT_GE(during.pooled_allocation_bytes,
+            before.pooled_allocation_bytes + kBufferCount * kBufferSize);
+  // The buffers share blocks rather than each getting memory of their own.
+  ASSERT_LE(during.pooled_block_bytes,
+            before.pooled_block_bytes + 4u * 1024u * 1024u);
+
+  // Their ranges go back to the pool once they are destroyed.
+  buffers.clear();
+  const auto after = GetMemoryStatistics(context);
+  ASSERT_EQ(after.pooled_allocation_count, before.pooled_allocation_count);
+  ASSERT_EQ(after.pooled_allocation_bytes, before.pooled_allocation_bytes);
+}
+
+TEST_P(AllocatorVKTest, LargeBuffersAreNotPooled) {
+  auto& context = *GetContext();
+  const auto before = GetMemoryStatistics(context);
+
+  auto small_buffer = CreateBuffer(context, 64u * 1024u);
+  ASSERT_TRUE(small_buffer);
+  ASSERT_EQ(GetMemoryStatistics(context).pooled_allocation_count,
+            before.pooled_allocation_count + 1u);
+
+  auto large_buffer = CreateBuffer(context, 64u * 1024u + 1u);
+  ASSERT_TRUE(large_buffer);
+  ASSERT_EQ(GetMemoryStatistics(context).pooled_allocation_count,
+            before.pooled_allocation_count + 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/vulkan/blit_command_vk.h"
 
 #include "impeller/renderer/backend/vulkan/commands_vk.h"
+#include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 
 namespace impeller {
@@ -159,6 +160,72 @@ std::string BlitCopyTextureToBufferCommandVK::GetLabel() const {
   return true;
 }
 
+//------------------------------------------------------------------------------
+/// BlitCopyBufferToTextureCommandVK
+///
+
+BlitCopyBufferToTextureCommandVK::~BlitCopyBufferToTextureCommandVK() =
+    default;
+
+std::string BlitCopyBufferToTextureCommandVK::GetLabel() const {
+  return label;
+}
+
+[[nodiscard]] bool BlitCopyBufferToTextureCommandVK::Encode(
+    FencedCommandBufferVK* fenced_command_buffer) const {
+  const auto& source_buf_vk = DeviceBufferVK::Cast(*source);
+  const auto& dest_tex_vk = TextureVK::Cast(*destination);
+
+  // Textures are uploaded from their staging buffer whenever they are bound.
+  // So the rows of the region are copied into the staging buffer rather than
+  // the image. Otherwise the next bind would overwrite them.
+  if (dest_tex_vk.IsWrapped()) {
+    VALIDATION_LOG << "Buffer blits into wrapped textures are not supported.";
+    return false;
+  }
+  const auto dest_buffer = dest_tex_vk.GetStagingBuffer();
+
+  const auto bytes_per_pixel =
+      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  const auto source_bytes_per_row =
+      destination_region.size.width * bytes_per_pixel;
+  const auto dest_bytes_per_row =
+      destination->GetTextureDescriptor().GetBytesPerRow();
+
+  std::vector<vk::BufferCopy> row_copies;
+  row_copies.reserve(destination_region.size.height);
+  for (auto row = 0; row < destination_region.size.height; row++) {
+    vk::BufferCopy row_copy;
+    row_copy.setSrcOffset(source_offset + row * source_bytes_per_row);
+    row_copy.setDstOffset((destination_region.origin.y + row) *
+                              dest_bytes_per_row +
+                          destination_region.origin.x * bytes_per_pixel);
+    row_copy.setSize(source_bytes_per_row);
+    row_copies.push_back(row_copy);
+  }
+
+  auto copy_cmd = fenced_command_buffer->GetSingleUseChild();
+
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+  auto res = copy_cmd.begin(begin_info);
+
+  if (res != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to begin command buffer: " << vk::to_string(res);
+    return false;
+  }
+
+  copy_cmd.copyBuffer(source_buf_vk.GetVKBufferHandle(), dest_buffer,
+                      row_copies);
+  res = copy_cmd.end();
+  if (res != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to end command buffer: " << vk::to_string(res);
+    return false;
+  }
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// BlitGenerateMipmapCommandVK
 ///
@@ -44,6 +44,16 @@ struct BlitCopyTextureToBufferCommandVK : public BlitCopyTextureToBufferCommand,
       FencedCommandBufferVK* fenced_command_buffer) const override;
 };
 
+struct BlitCopyBufferToTextureCommandVK : public BlitCopyBufferToTextureCommand,
+                                          public BlitEncodeVK {
+  ~BlitCopyBufferToTextureCommandVK() override;
+
+  std::string GetLabel() const override;
+
+  [[nodiscard]] bool Encode(
+      FencedCommandBufferVK* fenced_command_buffer) const override;
+};
+
 struct BlitGenerateMipmapCommandVK : public BlitGenerateMipmapCommand,
                                      public BlitEncodeVK {
   ~BlitGenerateMipmapCommandVK() override;
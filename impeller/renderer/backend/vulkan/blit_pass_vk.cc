@@ -52,6 +52,8 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
     IRect source_region,
     IPoint destination_origin,
     std::string label) {
+  command_buffer_->Track(source);
+  command_buffer_->Track(destination);
   auto command = std::make_unique<BlitCopyTextureToTextureCommandVK>();
   command->source = std::move(source);
   command->destination = std::move(destination);
@@ -70,6 +72,8 @@ bool BlitPassVK::OnCopyTextureToBufferCommand(
     IRect source_region,
     size_t destination_offset,
     std::string label) {
+  command_buffer_->Track(source);
+  command_buffer_->Track(destination);
   auto command = std::make_unique<BlitCopyTextureToBufferCommandVK>();
   command->source = std::move(source);
   command->destination = std::move(destination);
@@ -81,9 +85,30 @@ bool BlitPassVK::OnCopyTextureToBufferCommand(
   return true;
 }
 
+// |BlitPass|
+bool BlitPassVK::OnCopyBufferToTextureCommand(
+    std::shared_ptr<DeviceBuffer> source,
+    std::shared_ptr<Texture> destination,
+    IRect destination_region,
+    size_t source_offset,
+    std::string label) {
+  command_buffer_->Track(source);
+  command_buffer_->Track(destination);
+  auto command = std::make_unique<BlitCopyBufferToTextureCommandVK>();
+  command->source = std::move(source);
+  command->destination = std::move(destination);
+  command->destination_region = destination_region;
+  command->source_offset = source_offset;
+  command->label = std::move(label);
+
+  commands_.push_back(std::move(command));
+  return true;
+}
+
 // |BlitPass|
 bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
                                          std::string label) {
+  command_buffer_->Track(texture);
   auto command = std::make_unique<BlitGenerateMipmapCommandVK>();
   command->texture = std::move(texture);
   command->label = std::move(label);
@@ -25,11 +25,15 @@ std::shared_ptr<CommandBufferVK> CommandBufferVK::Create(
   if (auto context = context_arg.lock()) {
     auto context_vk = reinterpret_cast<const ContextVK*>(context.get());
     auto queue = context_vk->GetGraphicsQueue();
-    auto command_pool = context_vk->CreateGraphicsCommandPool();
+    std::shared_ptr<CommandPoolVK> command_pool =
+        context_vk->CreateGraphicsCommandPool();
+    if (!command_pool) {
+      return nullptr;
+    }
     auto fenced_command_buffer = std::make_shared<FencedCommandBufferVK>(
-        device, queue, command_pool->Get());
-    return std::make_shared<CommandBufferVK>(
-        context, device, std::move(command_pool), fenced_command_buffer);
+        device, queue, std::move(command_pool), context_vk->GetFenceWaiter());
+    return std::make_shared<CommandBufferVK>(context, device,
+                                             fenced_command_buffer);
   } else {
     return nullptr;
   }
@@ -38,11 +42,9 @@ std::shared_ptr<CommandBufferVK> CommandBufferVK::Create(
 CommandBufferVK::CommandBufferVK(
     std::weak_ptr<const Context> context,
     vk::Device device,
-    std::unique_ptr<CommandPoolVK> command_pool,
     std::shared_ptr<FencedCommandBufferVK> command_buffer)
     : CommandBuffer(std::move(context)),
       device_(device),
-      command_pool_(std::move(command_pool)),
       fenced_command_buffer_(std::move(command_buffer)) {
   is_valid_ = true;
 }
@@ -61,10 +63,16 @@ bool CommandBufferVK::IsValid() const {
 }
 
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
-  bool submit = fenced_command_buffer_->Submit();
-  if (callback) {
-    callback(submit ? CommandBuffer::Status::kCompleted
-                    : CommandBuffer::Status::kError);
+  // The callback is invoked on the fence waiter thread once the GPU is done
+  // with the commands.
+  bool submit = fenced_command_buffer_->Submit([callback](bool completed) {
+    if (callback) {
+      callback(completed ? CommandBuffer::Status::kCompleted
+                         : CommandBuffer::Status::kError);
+    }
+  });
+  if (!submit && callback) {
+    callback(CommandBuffer::Status::kError);
   }
   return submit;
 }
@@ -5,7 +5,6 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
-#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/fenced_command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_producer_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -21,7 +20,6 @@ class CommandBufferVK final : public CommandBuffer {
 
   CommandBufferVK(std::weak_ptr<const Context> context,
                   vk::Device device,
-                  std::unique_ptr<CommandPoolVK> command_pool,
                   std::shared_ptr<FencedCommandBufferVK> command_buffer);
 
   // |CommandBuffer|
@@ -31,7 +29,6 @@ class CommandBufferVK final : public CommandBuffer {
   friend class ContextVK;
 
   vk::Device device_;
-  std::unique_ptr<CommandPoolVK> command_pool_;
   vk::UniqueRenderPass render_pass_;
   std::shared_ptr<FencedCommandBufferVK> fenced_command_buffer_;
   bool is_valid_ = false;
@@ -4,10 +4,15 @@
 
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 
+#include "impeller/base/validation.h"
+
 namespace impeller {
 
-std::unique_ptr<CommandPoolVK> CommandPoolVK::Create(vk::Device device,
-                                                     uint32_t queue_index) {
+// Pools beyond this count are destroyed instead of being kept for reuse.
+static constexpr size_t kMaxRecycledPools = 16u;
+
+static vk::UniqueCommandPool CreateCommandPool(vk::Device device,
+                                               uint32_t queue_index) {
   vk::CommandPoolCreateInfo create_info;
   create_info.setQueueFamilyIndex(queue_index);
 
@@ -15,19 +20,71 @@ std::unique_ptr<CommandPoolVK> CommandPoolVK::Create(vk::Device device,
   if (res.result != vk::Result::eSuccess) {
     FML_CHECK(false) << "Failed to create command pool: "
                      << vk::to_string(res.result);
-    return nullptr;
+    return {};
   }
+  return std::move(res.value);
+}
 
-  return std::make_unique<CommandPoolVK>(std::move(res.value));
+std::unique_ptr<CommandPoolVK> CommandPoolVK::Create(vk::Device device,
+                                                     uint32_t queue_index) {
+  auto pool = CreateCommandPool(device, queue_index);
+  if (!pool) {
+    return nullptr;
+  }
+  return std::make_unique<CommandPoolVK>(std::move(pool));
 }
 
 vk::CommandPool CommandPoolVK::Get() const {
   return *command_pool_;
 }
 
-CommandPoolVK::CommandPoolVK(vk::UniqueCommandPool command_pool)
-    : command_pool_(std::move(command_pool)) {}
+CommandPoolVK::CommandPoolVK(vk::UniqueCommandPool command_pool,
+                             std::weak_ptr<CommandPoolRecyclerVK> recycler)
+    : command_pool_(std::move(command_pool)), recycler_(std::move(recycler)) {}
+
+CommandPoolVK::~CommandPoolVK() {
+  if (auto recycler = recycler_.lock()) {
+    recycler->Reclaim(std::move(command_pool_));
+  }
+}
 
-CommandPoolVK::~CommandPoolVK() = default;
+CommandPoolRecyclerVK::CommandPoolRecyclerVK(vk::Device device,
+                                             uint32_t queue_index)
+    : device_(device), queue_index_(queue_index) {}
+
+CommandPoolRecyclerVK::~CommandPoolRecyclerVK() = default;
+
+std::unique_ptr<CommandPoolVK> CommandPoolRecyclerVK::Get() {
+  vk::UniqueCommandPool pool;
+  {
+    Lock lock(pools_mutex_);
+    if (!pools_.empty()) {
+      pool = std::move(pools_.back());
+      pools_.pop_back();
+    }
+  }
+  if (!pool) {
+    pool = CreateCommandPool(device_, queue_index_);
+  }
+  if (!pool) {
+    return nullptr;
+  }
+  return std::make_unique<CommandPoolVK>(std::move(pool), weak_from_this());
+}
+
+void CommandPoolRecyclerVK::Reclaim(vk::UniqueCommandPool pool) {
+  if (!pool) {
+    return;
+  }
+  auto res = device_.resetCommandPool(pool.get(), {});
+  if (res != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not reset command pool: " << vk::to_string(res);
+    return;
+  }
+  Lock lock(pools_mutex_);
+  if (pools_.size() < kMaxRecycledPools) {
+    pools_.emplace_back(std::move(pool));
+  }
+}
 
 }  // namespace impeller
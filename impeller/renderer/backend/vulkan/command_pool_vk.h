@@ -4,26 +4,69 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
+class CommandPoolRecyclerVK;
+
 class CommandPoolVK {
  public:
   static std::unique_ptr<CommandPoolVK> Create(vk::Device device,
                                                uint32_t queue_index);
 
-  explicit CommandPoolVK(vk::UniqueCommandPool command_pool);
+  explicit CommandPoolVK(vk::UniqueCommandPool command_pool,
+                         std::weak_ptr<CommandPoolRecyclerVK> recycler = {});
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the pool to the recycler it came from, if any. All
+  ///             command buffers allocated from the pool must have been freed
+  ///             and be done executing.
+  ///
   ~CommandPoolVK();
 
   vk::CommandPool Get() const;
 
  private:
   vk::UniqueCommandPool command_pool_;
+  std::weak_ptr<CommandPoolRecyclerVK> recycler_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(CommandPoolVK);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Keeps command pools that are no longer in use around so that
+///             new command buffers do not need a new pool each time.
+///
+class CommandPoolRecyclerVK
+    : public std::enable_shared_from_this<CommandPoolRecyclerVK> {
+ public:
+  CommandPoolRecyclerVK(vk::Device device, uint32_t queue_index);
+
+  ~CommandPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a reset pool, creating one if none is available.
+  ///
+  std::unique_ptr<CommandPoolVK> Get();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reset the pool and make it available again.
+  ///
+  void Reclaim(vk::UniqueCommandPool pool);
+
+ private:
+  const vk::Device device_;
+  const uint32_t queue_index_;
+  Mutex pools_mutex_;
+  std::vector<vk::UniqueCommandPool> pools_ IPLR_GUARDED_BY(pools_mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CommandPoolRecyclerVK);
+};
+
 }  // namespace impeller
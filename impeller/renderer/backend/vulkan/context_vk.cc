@@ -76,6 +76,21 @@ static std::set<std::string> kRequiredDeviceExtensions = {
 #endif
 };
 
+#ifdef FML_OS_ANDROID
+// Extensions needed to import AHardwareBuffers as images. They are only
+// enabled when all of them are available.
+static std::vector<std::string> kAndroidHardwareBufferDeviceExtensions = {
+    VK_ANDROID_EXTERNAL_MEMORY_ANDROID_HARDWARE_BUFFER_EXTENSION_NAME,
+    VK_KHR_SAMPLER_YCBCR_CONVERSION_EXTENSION_NAME,
+    VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
+    VK_EXT_QUEUE_FAMILY_FOREIGN_EXTENSION_NAME,
+    VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
+    VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+    VK_KHR_MAINTENANCE1_EXTENSION_NAME,
+    VK_KHR_BIND_MEMORY_2_EXTENSION_NAME,
+};
+#endif  // FML_OS_ANDROID
+
 std::vector<std::string> kRequiredWSIInstanceExtensions = {
 #if FML_OS_WIN
     "VK_KHR_win32_surface",
@@ -123,9 +138,15 @@ static std::vector<std::string> HasRequiredExtensions(
   return missing;
 }
 
-static vk::PhysicalDeviceFeatures GetRequiredPhysicalDeviceFeatures() {
+static vk::PhysicalDeviceFeatures GetEnabledPhysicalDeviceFeatures(
+    const vk::PhysicalDevice& device) {
   vk::PhysicalDeviceFeatures features;
   features.setRobustBufferAccess(true);
+  // Compressed textures are used if the device supports them.
+  // @see `AllocatorVK::SupportsCompressedPixelFormat`.
+  const auto supported = device.getFeatures();
+  features.setTextureCompressionASTC_LDR(supported.textureCompressionASTC_LDR);
+  features.setTextureCompressionETC2(supported.textureCompressionETC2);
   return features;
 };
 
@@ -223,13 +244,13 @@ static std::optional<QueueVK> PickPresentQueue(const vk::PhysicalDevice& device,
 std::shared_ptr<ContextVK> ContextVK::Create(
     PFN_vkGetInstanceProcAddr proc_address_callback,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-    const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+    fml::UniqueFD cache_directory,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
     const std::string& label) {
   auto context = std::shared_ptr<ContextVK>(new ContextVK(
       proc_address_callback,          //
       shader_libraries_data,          //
-      pipeline_cache_data,            //
+      std::move(cache_directory),     //
       std::move(worker_task_runner),  //
       label                           //
       ));
@@ -242,7 +263,7 @@ std::shared_ptr<ContextVK> ContextVK::Create(
 ContextVK::ContextVK(
     PFN_vkGetInstanceProcAddr proc_address_callback,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-    const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+    fml::UniqueFD cache_directory,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
     const std::string& label)
     : worker_task_runner_(std::move(worker_task_runner)) {
@@ -423,15 +444,38 @@ ContextVK::ContextVK(
     required_extensions.push_back(ext.data());
   }
 
+#ifdef FML_OS_ANDROID
+  {
+    std::set<std::string> available_extensions;
+    for (const auto& ext :
+         physical_device->enumerateDeviceExtensionProperties().value) {
+      available_extensions.insert(ext.extensionName);
+    }
+    supports_android_hardware_buffers_ = true;
+    for (const auto& ext : kAndroidHardwareBufferDeviceExtensions) {
+      if (available_extensions.count(ext) != 1u) {
+        supports_android_hardware_buffers_ = false;
+        break;
+      }
+    }
+    if (supports_android_hardware_buffers_) {
+      for (const auto& ext : kAndroidHardwareBufferDeviceExtensions) {
+        required_extensions.push_back(ext.data());
+      }
+    }
+  }
+#endif  // FML_OS_ANDROID
+
   const auto queue_create_infos = GetQueueCreateInfos(
       {graphics_queue.value(), compute_queue.value(), transfer_queue.value()});
 
-  const auto required_features = GetRequiredPhysicalDeviceFeatures();
+  const auto enabled_features =
+      GetEnabledPhysicalDeviceFeatures(physical_device.value());
 
   vk::DeviceCreateInfo device_info;
   device_info.setQueueCreateInfos(queue_create_infos);
   device_info.setPEnabledExtensionNames(required_extensions);
-  device_info.setPEnabledFeatures(&required_features);
+  device_info.setPEnabledFeatures(&enabled_features);
   // Device layers are deprecated and ignored.
 
   auto device = physical_device->createDeviceUnique(device_info);
@@ -456,9 +500,10 @@ ContextVK::ContextVK(
   }
 
   auto pipeline_library = std::shared_ptr<PipelineLibraryVK>(
-      new PipelineLibraryVK(device.value.get(),   //
-                            pipeline_cache_data,  //
-                            worker_task_runner_   //
+      new PipelineLibraryVK(physical_device.value(),     //
+                            device.value.get(),          //
+                            std::move(cache_directory),  //
+                            worker_task_runner_          //
                             ));
 
   if (!pipeline_library->IsValid()) {
@@ -487,10 +532,16 @@ ContextVK::ContextVK(
   instance_ = std::move(instance.value);
   debug_messenger_ = std::move(debug_messenger);
   device_ = std::move(device.value);
+  gpu_tracer_ = std::shared_ptr<GPUTracerVK>(new GPUTracerVK(allocator));
   allocator_ = std::move(allocator);
   shader_library_ = std::move(shader_library);
   sampler_library_ = std::move(sampler_library);
   pipeline_library_ = std::move(pipeline_library);
+  descriptor_pool_recycler_ =
+      std::make_shared<DescriptorPoolRecyclerVK>(device_.get());
+  command_pool_recycler_ = std::make_shared<CommandPoolRecyclerVK>(
+      device_.get(), graphics_queue_idx_);
+  fence_waiter_ = std::make_shared<FenceWaiterVK>(device_.get());
   work_queue_ = std::move(work_queue);
   graphics_queue_ =
       device_->getQueue(graphics_queue->family, graphics_queue->index);
@@ -504,6 +555,10 @@ ContextVK::ContextVK(
 
 ContextVK::~ContextVK() = default;
 
+Context::BackendType ContextVK::GetBackendType() const {
+  return Context::BackendType::kVulkan;
+}
+
 bool ContextVK::IsValid() const {
   return is_valid_;
 }
@@ -537,7 +592,16 @@ vk::Instance ContextVK::GetInstance() const {
   return *instance_;
 }
 
+vk::Device ContextVK::GetDevice() const {
+  return *device_;
+}
+
+bool ContextVK::SupportsAndroidHardwareBuffers() const {
+  return supports_android_hardware_buffers_;
+}
+
 std::unique_ptr<Surface> ContextVK::AcquireSurface(size_t current_frame) {
+  static_cast<AllocatorVK&>(*allocator_).DidAcquireSurfaceFrame();
   return surface_producer_->AcquireSurface(current_frame);
 }
 
@@ -563,7 +627,8 @@ vk::UniqueSurfaceKHR ContextVK::CreateAndroidSurface(
 
 #endif  // FML_OS_ANDROID
 
-void ContextVK::SetupSwapchain(vk::UniqueSurfaceKHR surface) {
+void ContextVK::SetupSwapchain(vk::UniqueSurfaceKHR surface,
+                               const SwapchainSettingsVK& settings) {
   surface_ = std::move(surface);
   auto present_queue_out = PickPresentQueue(physical_device_, *surface_);
   if (!present_queue_out.has_value()) {
@@ -578,15 +643,21 @@ void ContextVK::SetupSwapchain(vk::UniqueSurfaceKHR surface) {
     return;
   }
   surface_format_ = swapchain_details->PickSurfaceFormat().format;
-  swapchain_ = SwapchainVK::Create(*device_, *surface_, *swapchain_details);
+  const vk::PresentModeKHR present_mode =
+      swapchain_details->PickPresentationMode(settings.latency);
+  swapchain_ = SwapchainVK::Create(*device_, *surface_, *swapchain_details,
+                                   present_mode);
   auto weak_this = weak_from_this();
   surface_producer_ = SurfaceProducerVK::Create(
-      weak_this, {
-                     .device = *device_,
-                     .graphics_queue = graphics_queue_,
-                     .present_queue = present_queue_,
-                     .swapchain = swapchain_.get(),
-                 });
+      weak_this,
+      {
+          .device = *device_,
+          .graphics_queue = graphics_queue_,
+          .present_queue = present_queue_,
+          .swapchain = swapchain_.get(),
+          .frames_in_flight = SwapchainDetailsVK::GetFramesInFlight(
+              settings, present_mode),
+      });
 }
 
 bool ContextVK::SupportsOffscreenMSAA() const {
@@ -594,7 +665,8 @@ bool ContextVK::SupportsOffscreenMSAA() const {
 }
 
 std::unique_ptr<DescriptorPoolVK> ContextVK::CreateDescriptorPool() const {
-  return std::make_unique<DescriptorPoolVK>(*device_);
+  return std::make_unique<DescriptorPoolVK>(*device_,
+                                            descriptor_pool_recycler_);
 }
 
 PixelFormat ContextVK::GetColorAttachmentPixelFormat() const {
@@ -602,7 +674,19 @@ PixelFormat ContextVK::GetColorAttachmentPixelFormat() const {
 }
 
 const BackendFeatures& ContextVK::GetBackendFeatures() const {
-  return kLegacyBackendFeatures;
+  // Vulkan addresses textures of any size with every sampler address mode.
+  static constexpr BackendFeatures kBackendFeaturesVK = {
+      .ssbo_support = kLegacyBackendFeatures.ssbo_support,
+      .compute_shader_support = kLegacyBackendFeatures.compute_shader_support,
+      .framebuffer_fetch_support =
+          kLegacyBackendFeatures.framebuffer_fetch_support,
+      .npot_address_mode_support = true,
+  };
+  return kBackendFeaturesVK;
+}
+
+std::shared_ptr<GPUTracer> ContextVK::GetGPUTracer() const {
+  return gpu_tracer_;
 }
 
 vk::Queue ContextVK::GetGraphicsQueue() const {
@@ -610,7 +694,16 @@ vk::Queue ContextVK::GetGraphicsQueue() const {
 }
 
 std::unique_ptr<CommandPoolVK> ContextVK::CreateGraphicsCommandPool() const {
-  return CommandPoolVK::Create(*device_, graphics_queue_idx_);
+  return command_pool_recycler_->Get();
+}
+
+const std::shared_ptr<fml::ConcurrentTaskRunner>&
+ContextVK::GetConcurrentWorkerTaskRunner() const {
+  return worker_task_runner_;
+}
+
+const std::shared_ptr<FenceWaiterVK>& ContextVK::GetFenceWaiter() const {
+  return fence_waiter_;
 }
 
 }  // namespace impeller
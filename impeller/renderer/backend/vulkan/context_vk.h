@@ -9,10 +9,13 @@
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/deletion_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_library_vk.h"
@@ -38,13 +41,16 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   static std::shared_ptr<ContextVK> Create(
       PFN_vkGetInstanceProcAddr proc_address_callback,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-      const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+      fml::UniqueFD cache_directory,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
       const std::string& label);
 
   // |Context|
   ~ContextVK() override;
 
+  // |Context|
+  BackendType GetBackendType() const override;
+
   // |Context|
   bool IsValid() const override;
 
@@ -82,10 +88,24 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
 
   vk::Instance GetInstance() const;
 
-  void SetupSwapchain(vk::UniqueSurfaceKHR surface);
+  vk::Device GetDevice() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the device can import AHardwareBuffers as images.
+  ///             Always false on platforms other than Android.
+  ///
+  bool SupportsAndroidHardwareBuffers() const;
+
+  void SetupSwapchain(vk::UniqueSurfaceKHR surface,
+                      const SwapchainSettingsVK& settings = {});
 
   std::unique_ptr<Surface> AcquireSurface(size_t current_frame);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Create a descriptor pool for the sets used by a single
+  ///             command buffer. The pools backing it are recycled when it is
+  ///             destroyed.
+  ///
   std::unique_ptr<DescriptorPoolVK> CreateDescriptorPool() const;
 
 #ifdef FML_OS_ANDROID
@@ -94,8 +114,21 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
 
   vk::Queue GetGraphicsQueue() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a command pool for the graphics queue. The pool is
+  ///             recycled when it is destroyed.
+  ///
   std::unique_ptr<CommandPoolVK> CreateGraphicsCommandPool() const;
 
+  const std::shared_ptr<fml::ConcurrentTaskRunner>&
+  GetConcurrentWorkerTaskRunner() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The waiter that reclaims the resources used by submitted
+  ///             command buffers once the GPU is done with them.
+  ///
+  const std::shared_ptr<FenceWaiterVK>& GetFenceWaiter() const;
+
  private:
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   vk::UniqueInstance instance_;
@@ -103,9 +136,15 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   vk::PhysicalDevice physical_device_;
   vk::UniqueDevice device_;
   std::shared_ptr<Allocator> allocator_;
+  std::shared_ptr<GPUTracerVK> gpu_tracer_;
   std::shared_ptr<ShaderLibraryVK> shader_library_;
   std::shared_ptr<SamplerLibraryVK> sampler_library_;
   std::shared_ptr<PipelineLibraryVK> pipeline_library_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<CommandPoolRecyclerVK> command_pool_recycler_;
+  // Declared after everything pending submissions may reference so that it is
+  // destroyed, and waits for those submissions, first.
+  std::shared_ptr<FenceWaiterVK> fence_waiter_;
   uint32_t graphics_queue_idx_;
   vk::Queue graphics_queue_;
   vk::Queue compute_queue_;
@@ -116,12 +155,13 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   std::unique_ptr<SwapchainVK> swapchain_;
   std::unique_ptr<SurfaceProducerVK> surface_producer_;
   std::shared_ptr<WorkQueue> work_queue_;
+  bool supports_android_hardware_buffers_ = false;
   bool is_valid_ = false;
 
   ContextVK(
       PFN_vkGetInstanceProcAddr proc_address_callback,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-      const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+      fml::UniqueFD cache_directory,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
       const std::string& label);
 
@@ -152,6 +192,9 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   // |Context|
   const BackendFeatures& GetBackendFeatures() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ContextVK);
 };
 
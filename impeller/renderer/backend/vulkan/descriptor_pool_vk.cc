@@ -4,50 +4,142 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
 #include "impeller/base/validation.h"
 #include "vulkan/vulkan_enums.hpp"
 
 namespace impeller {
 
-DescriptorPoolVK::DescriptorPoolVK(vk::Device device) {
-  constexpr size_t kPoolSize = 1024;
+// Pools handed out by the recycler are sized for the descriptor sets used by
+// a typical render pass. Passes that need more allocate additional pools.
+static constexpr uint32_t kMaxSetsPerPool = 256u;
+static constexpr uint32_t kDescriptorsPerType = 512u;
 
+// Pools beyond this count are destroyed instead of being kept for reuse.
+static constexpr size_t kMaxRecycledPools = 32u;
+
+static vk::UniqueDescriptorPool CreateDescriptorPool(vk::Device device) {
+  TRACE_EVENT0("impeller", "CreateDescriptorPool");
   std::vector<vk::DescriptorPoolSize> pool_sizes = {
-      {vk::DescriptorType::eSampler, kPoolSize},
-      {vk::DescriptorType::eCombinedImageSampler, kPoolSize},
-      {vk::DescriptorType::eSampledImage, kPoolSize},
-      {vk::DescriptorType::eStorageImage, kPoolSize},
-      {vk::DescriptorType::eUniformTexelBuffer, kPoolSize},
-      {vk::DescriptorType::eStorageTexelBuffer, kPoolSize},
-      {vk::DescriptorType::eUniformBuffer, kPoolSize},
-      {vk::DescriptorType::eStorageBuffer, kPoolSize},
-      {vk::DescriptorType::eUniformBufferDynamic, kPoolSize},
-      {vk::DescriptorType::eStorageBufferDynamic, kPoolSize},
-      {vk::DescriptorType::eInputAttachment, kPoolSize},
+      {vk::DescriptorType::eSampler, kDescriptorsPerType},
+      {vk::DescriptorType::eCombinedImageSampler, kDescriptorsPerType},
+      {vk::DescriptorType::eSampledImage, kDescriptorsPerType},
+      {vk::DescriptorType::eStorageImage, kDescriptorsPerType},
+      {vk::DescriptorType::eUniformTexelBuffer, kDescriptorsPerType},
+      {vk::DescriptorType::eStorageTexelBuffer, kDescriptorsPerType},
+      {vk::DescriptorType::eUniformBuffer, kDescriptorsPerType},
+      {vk::DescriptorType::eStorageBuffer, kDescriptorsPerType},
+      {vk::DescriptorType::eUniformBufferDynamic, kDescriptorsPerType},
+      {vk::DescriptorType::eStorageBufferDynamic, kDescriptorsPerType},
+      {vk::DescriptorType::eInputAttachment, kDescriptorsPerType},
   };
 
+  // Sets are never freed individually. The whole pool is reset once the
+  // command buffer using it has completed.
   vk::DescriptorPoolCreateInfo pool_info = {
-      vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,  // flags
-      static_cast<uint32_t>(pool_sizes.size() * kPoolSize),  // max sets
-      static_cast<uint32_t>(pool_sizes.size()),              // pool sizes count
-      pool_sizes.data()                                      // pool sizes
+      {},                                        // flags
+      kMaxSetsPerPool,                           // max sets
+      static_cast<uint32_t>(pool_sizes.size()),  // pool sizes count
+      pool_sizes.data()                          // pool sizes
   };
 
-  auto res = device.createDescriptorPool(pool_info);
+  auto res = device.createDescriptorPoolUnique(pool_info);
   if (res.result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Unable to create a descriptor pool";
+    VALIDATION_LOG << "Unable to create a descriptor pool: "
+                   << vk::to_string(res.result);
+    return {};
+  }
+  return std::move(res.value);
+}
+
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(vk::Device device)
+    : device_(device) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() = default;
+
+vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Get() {
+  {
+    Lock lock(pools_mutex_);
+    if (!pools_.empty()) {
+      auto pool = std::move(pools_.back());
+      pools_.pop_back();
+      return pool;
+    }
+  }
+  return CreateDescriptorPool(device_);
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool pool) {
+  if (!pool) {
     return;
   }
+  // vkResetDescriptorPool cannot fail. Depending on the version of the headers
+  // this may or may not return a result.
+  static_cast<void>(device_.resetDescriptorPool(pool.get()));
+  Lock lock(pools_mutex_);
+  if (pools_.size() < kMaxRecycledPools) {
+    pools_.emplace_back(std::move(pool));
+  }
+}
+
+DescriptorPoolVK::DescriptorPoolVK(
+    vk::Device device,
+    std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_(device), recycler_(std::move(recycler)) {}
 
-  pool_ = res.value;
-  is_valid_ = true;
+DescriptorPoolVK::~DescriptorPoolVK() {
+  auto recycler = recycler_.lock();
+  if (!recycler) {
+    return;
+  }
+  for (auto& pool : pools_) {
+    recycler->Reclaim(std::move(pool));
+  }
 }
 
-vk::DescriptorPool DescriptorPoolVK::GetPool() {
-  return pool_;
+std::optional<vk::DescriptorSet> DescriptorPoolVK::FindDescriptorSet(
+    const SetKey& key) const {
+  if (auto found = sets_.find(key); found != sets_.end()) {
+    return found->second;
+  }
+  return std::nullopt;
 }
 
-DescriptorPoolVK::~DescriptorPoolVK() = default;
+std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
+    vk::DescriptorSetLayout layout,
+    SetKey key) {
+  vk::DescriptorSetAllocateInfo alloc_info;
+  alloc_info.setDescriptorSetCount(1u);
+  alloc_info.setPSetLayouts(&layout);
+
+  // Try the most recent pool first. If it is exhausted, move on to a fresh
+  // one.
+  for (auto attempt = 0; attempt < 2; attempt++) {
+    if (pools_.empty() || attempt > 0) {
+      auto recycler = recycler_.lock();
+      auto pool = recycler ? recycler->Get() : CreateDescriptorPool(device_);
+      if (!pool) {
+        return std::nullopt;
+      }
+      pools_.emplace_back(std::move(pool));
+    }
+    alloc_info.setDescriptorPool(pools_.back().get());
+    auto res = device_.allocateDescriptorSets(alloc_info);
+    if (res.result == vk::Result::eSuccess) {
+      auto set = res.value.front();
+      sets_[std::move(key)] = set;
+      return set;
+    }
+    if (res.result != vk::Result::eErrorOutOfPoolMemory &&
+        res.result != vk::Result::eErrorFragmentedPool) {
+      VALIDATION_LOG << "Failed to allocate descriptor sets: "
+                     << vk::to_string(res.result);
+      return std::nullopt;
+    }
+  }
+  VALIDATION_LOG << "Could not allocate a descriptor set from a new pool.";
+  return std::nullopt;
+}
 
 }  // namespace impeller
@@ -4,26 +4,85 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "vulkan/vulkan_enums.hpp"
 #include "vulkan/vulkan_handles.hpp"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Owns descriptor pools that are no longer referenced by any
+///             command buffer in flight. These are reset in bulk and handed
+///             out again instead of creating new pools every frame.
+///
+class DescriptorPoolRecyclerVK {
+ public:
+  explicit DescriptorPoolRecyclerVK(vk::Device device);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a reset pool, creating one if none is available.
+  ///
+  vk::UniqueDescriptorPool Get();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reset a pool whose descriptor sets are no longer in use by
+  ///             the GPU and make it available again.
+  ///
+  void Reclaim(vk::UniqueDescriptorPool pool);
+
+ private:
+  vk::Device device_;
+  Mutex pools_mutex_;
+  std::vector<vk::UniqueDescriptorPool> pools_ IPLR_GUARDED_BY(pools_mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Allocates the descriptor sets for a single command buffer.
+///
+///             Sets with identical layouts and resource bindings are only
+///             allocated and written once. The pools backing the sets are
+///             returned to the recycler when this object is destroyed, which
+///             must only happen once the command buffer has completed.
+///
 class DescriptorPoolVK {
  public:
-  explicit DescriptorPoolVK(vk::Device device);
+  /// Uniquely identifies the layout and resources bound to a descriptor set.
+  using SetKey = std::vector<uint64_t>;
+
+  DescriptorPoolVK(vk::Device device,
+                   std::weak_ptr<DescriptorPoolRecyclerVK> recycler);
 
   ~DescriptorPoolVK();
 
-  vk::DescriptorPool GetPool();
+  //----------------------------------------------------------------------------
+  /// @brief      Find a set previously allocated with the same key.
+  ///
+  std::optional<vk::DescriptorSet> FindDescriptorSet(const SetKey& key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocate a new descriptor set and remember it by key. The
+  ///             caller is responsible for writing the set.
+  ///
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      vk::DescriptorSetLayout layout,
+      SetKey key);
 
  private:
-  vk::DescriptorPool pool_;
-  bool is_valid_ = false;
+  vk::Device device_;
+  std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
+  std::vector<vk::UniqueDescriptorPool> pools_;
+  std::map<SetKey, vk::DescriptorSet> sets_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolVK);
 };
@@ -25,7 +25,15 @@ DeviceBufferVK::DeviceBufferVK(
       context_(context),
       device_allocation_(std::move(device_allocation)) {}
 
-DeviceBufferVK::~DeviceBufferVK() = default;
+DeviceBufferVK::~DeviceBufferVK() {
+  // Submissions keep the buffers they reference alive. So the GPU is done with
+  // the buffer by now. Freeing it returns its range to the small buffer pool.
+  const auto& backing = device_allocation_->backing_allocation;
+  if (backing.allocator && backing.allocation) {
+    ::vmaDestroyBuffer(*backing.allocator, device_allocation_->buffer,
+                       backing.allocation);
+  }
+}
 
 uint8_t* DeviceBufferVK::OnGetContents() const {
   return reinterpret_cast<uint8_t*>(device_allocation_->GetMapping());
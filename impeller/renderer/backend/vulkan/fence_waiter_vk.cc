@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+// Fences are waited upon in batches. Fences added while a batch is being
+// waited upon are picked up once any fence in the batch signals or after this
+// timeout.
+static constexpr uint64_t kWaitTimeoutNanos =
+    std::chrono::nanoseconds(std::chrono::milliseconds(100)).count();
+
+FenceWaiterVK::FenceWaiterVK(vk::Device device) : device_(device) {
+  waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
+  is_valid_ = true;
+}
+
+FenceWaiterVK::~FenceWaiterVK() {
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    terminate_ = true;
+  }
+  wait_set_cv_.notify_one();
+  waiter_thread_->join();
+}
+
+bool FenceWaiterVK::IsValid() const {
+  return is_valid_;
+}
+
+bool FenceWaiterVK::AddFence(vk::UniqueFence fence, FenceCallback callback) {
+  if (!IsValid() || !fence || !callback) {
+    return false;
+  }
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    if (!terminate_) {
+      wait_set_.push_back(WaitEntry{std::move(fence), std::move(callback)});
+      wait_set_cv_.notify_one();
+      return true;
+    }
+  }
+  // The waiter thread is going away. The fence may not be destroyed before it
+  // signals. So wait for it here.
+  auto result = device_.waitForFences(fence.get(), true, UINT64_MAX);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to wait for fence: " << vk::to_string(result);
+  }
+  callback(result == vk::Result::eSuccess);
+  return true;
+}
+
+void FenceWaiterVK::Main() {
+  fml::Thread::SetCurrentThreadName(
+      fml::Thread::ThreadConfig{"io.flutter.impeller.fence_waiter"});
+
+  while (true) {
+    std::vector<vk::Fence> fences;
+    bool terminate = false;
+    {
+      std::unique_lock lock(wait_set_mutex_);
+      wait_set_cv_.wait(lock,
+                        [&]() { return terminate_ || !wait_set_.empty(); });
+      terminate = terminate_;
+      if (terminate && wait_set_.empty()) {
+        return;
+      }
+      for (const auto& entry : wait_set_) {
+        fences.push_back(entry.fence.get());
+      }
+    }
+
+    // While terminating, everything pending must be waited upon till
+    // completion before the device can go away.
+    auto result =
+        device_.waitForFences(fences, /*waitAll=*/terminate,
+                              terminate ? UINT64_MAX : kWaitTimeoutNanos);
+    if (result == vk::Result::eTimeout) {
+      continue;
+    }
+    const bool wait_failed = result != vk::Result::eSuccess;
+    if (wait_failed) {
+      // The device is lost. The callbacks of the fences that were waited upon
+      // are invoked anyway so that the objects they keep alive are released.
+      VALIDATION_LOG << "Failed to wait for fences: " << vk::to_string(result);
+    }
+
+    std::vector<std::pair<FenceCallback, bool>> callbacks;
+    {
+      std::scoped_lock lock(wait_set_mutex_);
+      for (auto it = wait_set_.begin(); it != wait_set_.end();) {
+        // Fences added during the wait are picked up by the next one.
+        if (std::find(fences.begin(), fences.end(), it->fence.get()) ==
+            fences.end()) {
+          ++it;
+          continue;
+        }
+        const bool signaled =
+            device_.getFenceStatus(it->fence.get()) == vk::Result::eSuccess;
+        if (!signaled && !wait_failed) {
+          ++it;
+          continue;
+        }
+        callbacks.emplace_back(std::move(it->callback), signaled);
+        it = wait_set_.erase(it);
+      }
+    }
+
+    TRACE_EVENT0("impeller", "FenceWaiterVK::Callbacks");
+    for (const auto& [callback, signaled] : callbacks) {
+      callback(signaled);
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Waits on submission fences on a dedicated thread and invokes a
+///             callback once each fence signals.
+///
+///             This lets submitting threads move on immediately while the
+///             resources referenced by a submission are reclaimed exactly
+///             when the GPU is done with them.
+///
+class FenceWaiterVK {
+ public:
+  explicit FenceWaiterVK(vk::Device device);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits for all pending fences and invokes their callbacks
+  ///             before returning. So the device must still be alive.
+  ///
+  ~FenceWaiterVK();
+
+  bool IsValid() const;
+
+  using FenceCallback = std::function<void(bool signaled)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invoke the callback on the waiter thread once the fence
+  ///             signals. The fence is destroyed afterwards. If the waiter is
+  ///             shutting down, this waits for the fence and invokes the
+  ///             callback on the calling thread instead.
+  ///
+  ///             If waiting for the fence fails, for instance because the
+  ///             device was lost, the callback is still invoked so that the
+  ///             objects it keeps alive are released, but with false.
+  ///
+  bool AddFence(vk::UniqueFence fence, FenceCallback callback);
+
+ private:
+  struct WaitEntry {
+    vk::UniqueFence fence;
+    FenceCallback callback;
+  };
+
+  const vk::Device device_;
+  // Guards the wait set and the termination flag.
+  std::mutex wait_set_mutex_;
+  std::condition_variable wait_set_cv_;
+  std::vector<WaitEntry> wait_set_;
+  bool terminate_ = false;
+  std::unique_ptr<std::thread> waiter_thread_;
+  bool is_valid_ = false;
+
+  void Main();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
+};
+
+}  // namespace impeller
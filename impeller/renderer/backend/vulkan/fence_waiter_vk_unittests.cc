@@ -0,0 +1,225 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/base/validation.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/fenced_command_buffer_vk.h"
+
+namespace impeller {
+namespace testing {
+
+class FenceWaiterVKTest : public PlaygroundTest {
+ public:
+  const ContextVK& GetContextVK() const {
+    return ContextVK::Cast(*GetContext());
+  }
+};
+INSTANTIATE_VULKAN_PLAYGROUND_SUITE(FenceWaiterVKTest);
+
+namespace {
+
+// Submits no work but a fence that signals once the queue gets to it.
+vk::UniqueFence SubmitFence(const ContextVK& context) {
+  auto fence = context.GetDevice().createFenceUnique(vk::FenceCreateInfo());
+  if (fence.result != vk::Result::eSuccess) {
+    return {};
+  }
+  if (context.GetGraphicsQueue().submit({}, *fence.value) !=
+      vk::Result::eSuccess) {
+    return {};
+  }
+  return std::move(fence.value);
+}
+
+// Records an empty command buffer so that it can be submitted.
+std::unique_ptr<FencedCommandBufferVK> CreateRecordedCommandBuffer(
+    const ContextVK& context,
+    std::shared_ptr<CommandPoolVK> command_pool,
+    std::weak_ptr<FenceWaiterVK> fence_waiter) {
+  auto command_buffer = std::make_unique<FencedCommandBufferVK>(
+      context.GetDevice(), context.GetGraphicsQueue(), std::move(command_pool),
+      std::move(fence_waiter));
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+  if (command_buffer->Get().begin(begin_info) != vk::Result::eSuccess ||
+      command_buffer->Get().end() != vk::Result::eSuccess) {
+    return nullptr;
+  }
+  return command_buffer;
+}
+
+}  // namespace
+
+TEST_P(FenceWaiterVKTest, CallbackIsInvokedOnTheWaiterThread) {
+  const auto& context = GetContextVK();
+  FenceWaiterVK waiter(context.GetDevice());
+  ASSERT_TRUE(waiter.IsValid());
+
+  auto fence = SubmitFence(context);
+  ASSERT_TRUE(fence);
+  fml::AutoResetWaitableEvent latch;
+  std::thread::id callback_thread;
+  bool signaled = false;
+  ASSERT_TRUE(waiter.AddFence(std::move(fence), [&](bool did_signal) {
+    signaled = did_signal;
+    callback_thread = std::this_thread::get_id();
+    latch.Signal();
+  }));
+  latch.Wait();
+  ASSERT_TRUE(signaled);
+  ASSERT_NE(callback_thread, std::this_thread::get_id());
+}
+
+TEST_P(FenceWaiterVKTest, SignaledFencesInvokeTheirCallback) {
+  const auto& context = GetContextVK();
+  FenceWaiterVK waiter(context.GetDevice());
+
+  vk::FenceCreateInfo fence_info;
+  fence_info.flags = vk::FenceCreateFlagBits::eSignaled;
+  auto fence = context.GetDevice().createFenceUnique(fence_info);
+  ASSERT_EQ(fence.result, vk::Result::eSuccess);
+  fml::AutoResetWaitableEvent latch;
+  ASSERT_TRUE(waiter.AddFence(std::move(fence.value),
+                              [&latch](bool) { latch.Signal(); }));
+  latch.Wait();
+}
+
+TEST_P(FenceWaiterVKTest, FencesWithoutACallbackAreRejected) {
+  const auto& context = GetContextVK();
+  FenceWaiterVK waiter(context.GetDevice());
+
+  ScopedValidationDisable disable_validation;
+  ASSERT_FALSE(waiter.AddFence({}, [](bool) {}));
+  auto fence = SubmitFence(context);
+  ASSERT_TRUE(fence);
+  ASSERT_FALSE(waiter.AddFence(std::move(fence), nullptr));
+}
+
+TEST_P(FenceWaiterVKTest, ShutdownWaitsForPendingFences) {
+  const auto& context = GetContextVK();
+  auto waiter = std::make_unique<FenceWaiterVK>(context.GetDevice());
+
+  constexpr size_t kFenceCount = 16u;
+  std::atomic<size_t> callback_count = 0u;
+  for (size_t i = 0u; i < kFenceCount; i++) {
+    auto fence = SubmitFence(context);
+    ASSERT_TRUE(fence);
+    ASSERT_TRUE(waiter->AddFence(std::move(fence), [&callback_count](bool) {
+      callback_count++;
+    }));
+  }
+  waiter.reset();
+  ASSERT_EQ(callback_count.load(), kFenceCount);
+}
+
+TEST_P(FenceWaiterVKTest, CommandPoolsAreRecycled) {
+  const auto& context = GetContextVK();
+  auto recycler = std::make_shared<CommandPoolRecyclerVK>(
+      context.GetDevice(), /*queue_index=*/0u);
+
+  auto pool = recycler->Get();
+  ASSERT_TRUE(pool);
+  auto handle = pool->Get();
+  ASSERT_TRUE(handle);
+  pool.reset();
+
+  auto recycled_pool = recycler->Get();
+  ASSERT_TRUE(recycled_pool);
+  ASSERT_EQ(recycled_pool->Get(), handle);
+
+  // Pools in use are never handed out twice.
+  auto other_pool = recycler->Get();
+  ASSERT_TRUE(other_pool);
+  ASSERT_NE(other_pool->Get(), handle);
+}
+
+TEST_P(FenceWaiterVKTest, CommandPoolsOutliveTheirRecycler) {
+  const auto& context = GetContextVK();
+  auto recycler = std::make_shared<CommandPoolRecyclerVK>(
+      context.GetDevice(), /*queue_index=*/0u);
+
+  auto pool = recycler->Get();
+  ASSERT_TRUE(pool);
+  recycler.reset();
+  ASSERT_TRUE(pool->Get());
+  // Destroys the pool instead of reclaiming it.
+  pool.reset();
+}
+
+TEST_P(FenceWaiterVKTest, CommandPoolIsRecycledOnceTheFenceSignals) {
+  const auto& context = GetContextVK();
+  auto fence_waiter = std::make_shared<FenceWaiterVK>(context.GetDevice());
+
+  std::shared_ptr<CommandPoolVK> pool = context.CreateGraphicsCommandPool();
+  ASSERT_TRUE(pool);
+  auto handle = pool->Get();
+  auto command_buffer =
+      CreateRecordedCommandBuffer(context, std::move(pool), fence_waiter);
+  ASSERT_TRUE(command_buffer);
+
+  bool deleted = false;
+  command_buffer->GetDeletionQueue()->Push([&deleted]() { deleted = true; });
+  fml::AutoResetWaitableEvent latch;
+  bool completed = false;
+  ASSERT_TRUE(command_buffer->Submit([&](bool did_complete) {
+    completed = did_complete;
+    latch.Signal();
+  }));
+  command_buffer.reset();
+  latch.Wait();
+  ASSERT_TRUE(completed);
+  ASSERT_TRUE(deleted);
+
+  // The pool was reclaimed before the callback was invoked.
+  auto recycled_pool = context.CreateGraphicsCommandPool();
+  ASSERT_TRUE(recycled_pool);
+  ASSERT_EQ(recycled_pool->Get(), handle);
+}
+
+TEST_P(FenceWaiterVKTest, ShutdownCompletesPendingSubmissions) {
+  const auto& context = GetContextVK();
+  auto fence_waiter = std::make_shared<FenceWaiterVK>(context.GetDevice());
+
+  constexpr size_t kSubmissionCount = 8u;
+  std::atomic<size_t> completed_count = 0u;
+  for (size_t i = 0u; i < kSubmissionCount; i++) {
+    auto command_buffer = CreateRecordedCommandBuffer(
+        context, context.CreateGraphicsCommandPool(), fence_waiter);
+    ASSERT_TRUE(command_buffer);
+    ASSERT_TRUE(command_buffer->Submit([&completed_count](bool completed) {
+      if (completed) {
+        completed_count++;
+      }
+    }));
+  }
+  fence_waiter.reset();
+  ASSERT_EQ(completed_count.load(), kSubmissionCount);
+}
+
+TEST_P(FenceWaiterVKTest, SubmitWaitsForTheFenceWithoutAWaiter) {
+  const auto& context = GetContextVK();
+  auto command_buffer = CreateRecordedCommandBuffer(
+      context, context.CreateGraphicsCommandPool(), {});
+  ASSERT_TRUE(command_buffer);
+
+  bool completed = false;
+  ASSERT_TRUE(command_buffer->Submit(
+      [&completed](bool did_complete) { completed = did_complete; }));
+  ASSERT_TRUE(completed);
+
+  ScopedValidationDisable disable_validation;
+  ASSERT_FALSE(command_buffer->Submit());
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -28,14 +28,17 @@ static vk::CommandBuffer CreateCommandBuffer(vk::Device device,
   return res.value[0];
 }
 
-FencedCommandBufferVK::FencedCommandBufferVK(vk::Device device,
-                                             vk::Queue queue,
-                                             vk::CommandPool command_pool)
+FencedCommandBufferVK::FencedCommandBufferVK(
+    vk::Device device,
+    vk::Queue queue,
+    std::shared_ptr<CommandPoolVK> command_pool,
+    std::weak_ptr<FenceWaiterVK> fence_waiter)
     : device_(device),
       queue_(queue),
-      command_pool_(command_pool),
+      command_pool_(std::move(command_pool)),
+      fence_waiter_(std::move(fence_waiter)),
       deletion_queue_(std::make_unique<DeletionQueueVK>()) {
-  command_buffer_ = CreateCommandBuffer(device_, command_pool_);
+  command_buffer_ = CreateCommandBuffer(device_, command_pool_->Get());
 }
 
 vk::CommandBuffer FencedCommandBufferVK::Get() const {
@@ -43,21 +46,23 @@ vk::CommandBuffer FencedCommandBufferVK::Get() const {
 }
 
 vk::CommandBuffer FencedCommandBufferVK::GetSingleUseChild() {
-  auto child = CreateCommandBuffer(device_, command_pool_);
+  auto child = CreateCommandBuffer(device_, command_pool_->Get());
   children_.push_back(child);
   return child;
 }
 
 FencedCommandBufferVK::~FencedCommandBufferVK() {
-  if (!submitted_) {
-    FML_LOG(WARNING)
-        << "FencedCommandBufferVK is being destroyed without being submitted.";
-    children_.push_back(command_buffer_);
+  if (submitted_) {
+    // Everything was handed off to the completion of the submission.
+    return;
   }
-  device_.freeCommandBuffers(command_pool_, children_);
+  FML_LOG(WARNING)
+      << "FencedCommandBufferVK is being destroyed without being submitted.";
+  children_.push_back(command_buffer_);
+  device_.freeCommandBuffers(command_pool_->Get(), children_);
 }
 
-bool FencedCommandBufferVK::Submit() {
+bool FencedCommandBufferVK::Submit(CompletionCallback callback) {
   if (submitted_) {
     VALIDATION_LOG << "Command buffer already submitted.";
     return false;
@@ -69,6 +74,7 @@ bool FencedCommandBufferVK::Submit() {
   if (fence_res.result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to create fence: "
                    << vk::to_string(fence_res.result);
+    children_.pop_back();
     return false;
   }
   vk::UniqueFence fence = std::move(fence_res.value);
@@ -78,19 +84,44 @@ bool FencedCommandBufferVK::Submit() {
   auto res = queue_.submit(submit_info, *fence);
   if (res != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to submit command buffer: " << vk::to_string(res);
+    children_.pop_back();
     return false;
   }
+  submitted_ = true;
+
+  // Hand everything referenced by the submission off to its completion. The
+  // command pool is released last so that it can be recycled after its
+  // command buffers have been freed.
+  std::shared_ptr<DeletionQueueVK> deletion_queue = std::move(deletion_queue_);
+  deletion_queue_ = std::make_unique<DeletionQueueVK>();
+  auto completion = [device = device_,                          //
+                     command_pool = command_pool_,              //
+                     command_buffers = std::move(children_),    //
+                     deletion_queue,                            //
+                     textures = std::move(tracked_textures_),   //
+                     buffers = std::move(tracked_buffers_),     //
+                     callback                                   //
+  ](bool signaled) mutable {
+    deletion_queue->Flush();
+    textures.clear();
+    buffers.clear();
+    device.freeCommandBuffers(command_pool->Get(), command_buffers);
+    command_pool.reset();
+    if (callback) {
+      callback(signaled);
+    }
+  };
+  children_.clear();
+
+  if (auto fence_waiter = fence_waiter_.lock()) {
+    return fence_waiter->AddFence(std::move(fence), std::move(completion));
+  }
 
   auto wait = device_.waitForFences(fence.get(), true, UINT64_MAX);
   if (wait != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to wait for fence: " << vk::to_string(wait);
-    return false;
   }
-
-  // cleanup all the resources held by the command buffer and its children.
-  deletion_queue_->Flush();
-
-  submitted_ = true;
+  completion(wait == vk::Result::eSuccess);
   return true;
 }
 
@@ -98,4 +129,16 @@ DeletionQueueVK* FencedCommandBufferVK::GetDeletionQueue() const {
   return deletion_queue_.get();
 }
 
+void FencedCommandBufferVK::Track(std::shared_ptr<const Texture> texture) {
+  if (texture) {
+    tracked_textures_.emplace_back(std::move(texture));
+  }
+}
+
+void FencedCommandBufferVK::Track(std::shared_ptr<const Buffer> buffer) {
+  if (buffer) {
+    tracked_buffers_.emplace_back(std::move(buffer));
+  }
+}
+
 }  // namespace impeller
@@ -4,11 +4,17 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/deletion_queue_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/buffer.h"
+#include "impeller/renderer/texture.h"
 
 namespace impeller {
 
@@ -16,7 +22,8 @@ class FencedCommandBufferVK {
  public:
   FencedCommandBufferVK(vk::Device device,
                         vk::Queue queue,
-                        vk::CommandPool command_pool);
+                        std::shared_ptr<CommandPoolVK> command_pool,
+                        std::weak_ptr<FenceWaiterVK> fence_waiter);
 
   ~FencedCommandBufferVK();
 
@@ -24,18 +31,46 @@ class FencedCommandBufferVK {
 
   vk::CommandBuffer GetSingleUseChild();
 
-  // this is a blocking call that waits for the fence to be signaled.
-  bool Submit();
+  using CompletionCallback = std::function<void(bool completed)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submit the command buffer and its children to the queue.
+  ///
+  ///             This does not wait for the GPU. Once the submission fence
+  ///             signals, the deletion queue is flushed, tracked objects are
+  ///             released, the command buffers are returned to the pool and
+  ///             the callback is invoked. This happens on the fence waiter
+  ///             thread. If the fence waiter is unavailable, this call waits
+  ///             for the fence instead.
+  ///
+  /// @param[in]  callback  Invoked once the submission has completed, with
+  ///                       false if the fence could not be waited upon. It
+  ///                       is not invoked if this call returns false.
+  ///
+  /// @return     If the command buffers were submitted.
+  ///
+  bool Submit(CompletionCallback callback = nullptr);
 
   DeletionQueueVK* GetDeletionQueue() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Keep the objects referenced by the commands in this buffer
+  ///             alive till the GPU is done with them.
+  ///
+  void Track(std::shared_ptr<const Texture> texture);
+
+  void Track(std::shared_ptr<const Buffer> buffer);
+
  private:
   vk::Device device_;
   vk::Queue queue_;
-  vk::CommandPool command_pool_;
+  std::shared_ptr<CommandPoolVK> command_pool_;
+  std::weak_ptr<FenceWaiterVK> fence_waiter_;
   std::unique_ptr<DeletionQueueVK> deletion_queue_;
   vk::CommandBuffer command_buffer_;
   std::vector<vk::CommandBuffer> children_;
+  std::vector<std::shared_ptr<const Texture>> tracked_textures_;
+  std::vector<std::shared_ptr<const Buffer>> tracked_buffers_;
   bool submitted_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FencedCommandBufferVK);
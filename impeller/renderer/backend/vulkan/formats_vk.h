@@ -162,6 +162,10 @@ constexpr vk::Format ToVKImageFormat(PixelFormat format) {
       return vk::Format::eR8Unorm;
     case PixelFormat::kR8G8UNormInt:
       return vk::Format::eR8G8Unorm;
+    case PixelFormat::kASTC4x4UNorm:
+      return vk::Format::eAstc4x4UnormBlock;
+    case PixelFormat::kETC2R8G8B8A8UNorm:
+      return vk::Format::eEtc2R8G8B8A8UnormBlock;
   }
 
   FML_UNREACHABLE();
@@ -0,0 +1,24 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
+
+#include "impeller/renderer/backend/vulkan/allocator_vk.h"
+
+namespace impeller {
+
+GPUTracerVK::GPUTracerVK(std::weak_ptr<AllocatorVK> allocator)
+    : allocator_(std::move(allocator)) {}
+
+GPUTracerVK::~GPUTracerVK() = default;
+
+std::optional<GPUMemoryStatistics> GPUTracerVK::GetMemoryStatistics() const {
+  auto allocator = allocator_.lock();
+  if (!allocator) {
+    return std::nullopt;
+  }
+  return allocator->GetMemoryStatistics();
+}
+
+}  // namespace impeller
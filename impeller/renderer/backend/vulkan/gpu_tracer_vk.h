@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+class AllocatorVK;
+
+class GPUTracerVK final : public GPUTracer,
+                          public BackendCast<GPUTracerVK, GPUTracer> {
+ public:
+  // |GPUTracer|
+  ~GPUTracerVK() override;
+
+  // |GPUTracer|
+  std::optional<GPUMemoryStatistics> GetMemoryStatistics() const override;
+
+ private:
+  friend class ContextVK;
+
+  std::weak_ptr<AllocatorVK> allocator_;
+
+  explicit GPUTracerVK(std::weak_ptr<AllocatorVK> allocator);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracerVK);
+};
+
+}  // namespace impeller
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+static constexpr const char* kPipelineCacheFileName =
+    "flutter.impeller.vkcache";
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK(
+    const vk::PhysicalDeviceProperties& props,
+    uint64_t p_data_length)
+    : vendor_id(props.vendorID),
+      device_id(props.deviceID),
+      driver_version(props.driverVersion),
+      data_length(p_data_length) {
+  static_assert(sizeof(uuid) == sizeof(props.pipelineCacheUUID));
+  std::memcpy(uuid, props.pipelineCacheUUID.data(), sizeof(uuid));
+}
+
+bool PipelineCacheHeaderVK::IsCompatibleWith(
+    const PipelineCacheHeaderVK& other) const {
+  return magic == other.magic &&                    //
+         version == other.version &&                //
+         vendor_id == other.vendor_id &&            //
+         device_id == other.device_id &&            //
+         driver_version == other.driver_version &&  //
+         std::memcmp(uuid, other.uuid, sizeof(uuid)) == 0;
+}
+
+std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const vk::PhysicalDeviceProperties& props) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  TRACE_EVENT0("impeller", "PipelineCacheDataRetrieve");
+  std::shared_ptr<fml::FileMapping> mapping =
+      fml::FileMapping::CreateReadOnly(cache_directory, kPipelineCacheFileName);
+  if (!mapping || mapping->GetMapping() == nullptr) {
+    return nullptr;
+  }
+  if (mapping->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    FML_LOG(INFO) << "Pipeline cache data is too small. Ignoring.";
+    return nullptr;
+  }
+  PipelineCacheHeaderVK on_disk_header;
+  std::memcpy(&on_disk_header, mapping->GetMapping(), sizeof(on_disk_header));
+  const auto current_header = PipelineCacheHeaderVK{props, 0u};
+  if (!current_header.IsCompatibleWith(on_disk_header)) {
+    FML_LOG(INFO)
+        << "Pipeline cache was written by a different device or driver. "
+           "Ignoring.";
+    return nullptr;
+  }
+  if (on_disk_header.data_length !=
+      mapping->GetSize() - sizeof(PipelineCacheHeaderVK)) {
+    FML_LOG(INFO) << "Pipeline cache data is truncated. Ignoring.";
+    return nullptr;
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      mapping->GetMapping() + sizeof(PipelineCacheHeaderVK),  //
+      on_disk_header.data_length,                             //
+      [mapping](auto, auto) {}                                //
+  );
+}
+
+bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
+                              const vk::PhysicalDeviceProperties& props,
+                              const std::vector<uint8_t>& data) {
+  if (!cache_directory.is_valid() || data.empty()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "PipelineCacheDataPersist");
+  const auto header = PipelineCacheHeaderVK{props, data.size()};
+  std::vector<uint8_t> contents(sizeof(header) + data.size());
+  std::memcpy(contents.data(), &header, sizeof(header));
+  std::memcpy(contents.data() + sizeof(header), data.data(), data.size());
+
+  if (!fml::WriteAtomically(cache_directory, kPipelineCacheFileName,
+                            fml::DataMapping{std::move(contents)})) {
+    FML_LOG(WARNING) << "Could not write pipeline cache data to disk.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
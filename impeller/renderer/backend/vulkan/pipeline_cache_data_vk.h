@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The header prepended to the pipeline cache data written to disk.
+///
+///             The driver validates the blob it is handed as well. But drivers
+///             have been known to crash on stale or truncated data. So the
+///             data is only handed to the driver if the device and driver that
+///             wrote it are the same as the current ones.
+///
+struct PipelineCacheHeaderVK {
+  static constexpr uint32_t kMagic = 0xC0DEF00D;
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  // Keeps the header free of padding so that it can be written as is.
+  uint32_t reserved = 0u;
+  uint8_t uuid[VK_UUID_SIZE] = {};
+  uint64_t data_length = 0u;
+
+  PipelineCacheHeaderVK();
+
+  PipelineCacheHeaderVK(const vk::PhysicalDeviceProperties& props,
+                        uint64_t data_length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      If the cache data written with the other header can be used
+  ///             with the device and driver described by this one.
+  ///
+  bool IsCompatibleWith(const PipelineCacheHeaderVK& other) const;
+};
+
+static_assert(sizeof(PipelineCacheHeaderVK) ==
+                  6 * sizeof(uint32_t) + VK_UUID_SIZE + sizeof(uint64_t),
+              "The pipeline cache header must not contain padding.");
+
+//------------------------------------------------------------------------------
+/// @brief      Read the pipeline cache data in the cache directory. The data
+///             is only returned if it was written by the same device and
+///             driver.
+///
+/// @param[in]  cache_directory  The directory containing the cache.
+/// @param[in]  props            The properties of the current device.
+///
+/// @return     The driver data without the header. Null if there was no
+///             compatible data on disk.
+///
+std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const vk::PhysicalDeviceProperties& props);
+
+//------------------------------------------------------------------------------
+/// @brief      Write the pipeline cache data along with a header identifying
+///             the device and driver to the cache directory.
+///
+/// @warning    This is a blocking call and must not be made on the raster
+///             thread.
+///
+/// @param[in]  cache_directory  The directory to write the cache to.
+/// @param[in]  props            The properties of the current device.
+/// @param[in]  data             The data fetched from the pipeline cache.
+///
+/// @return     If the cache data was written.
+///
+bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
+                              const vk::PhysicalDeviceProperties& props,
+                              const std::vector<uint8_t>& data);
+
+}  // namespace impeller
@@ -12,6 +12,7 @@
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_function_vk.h"
 #include "impeller/renderer/backend/vulkan/vertex_descriptor_vk.h"
@@ -19,16 +20,21 @@
 namespace impeller {
 
 PipelineLibraryVK::PipelineLibraryVK(
+    const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
-    const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+    fml::UniqueFD cache_directory,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
-    : worker_task_runner_(std::move(worker_task_runner)) {
+    : device_properties_(physical_device.getProperties()),
+      cache_directory_(std::move(cache_directory)),
+      worker_task_runner_(std::move(worker_task_runner)) {
   if (!worker_task_runner_) {
     return;
   }
 
   vk::PipelineCacheCreateInfo cache_info;
 
+  auto pipeline_cache_data =
+      PipelineCacheDataRetrieve(cache_directory_, device_properties_);
   if (pipeline_cache_data) {
     cache_info.pInitialData = pipeline_cache_data->GetMapping();
     cache_info.initialDataSize = pipeline_cache_data->GetSize();
@@ -83,10 +89,14 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
                         "could be created.";
       return;
     }
-    auto pipeline_create_info =
-        PipelineLibraryVK::Cast(thiz.get())->CreatePipeline(descriptor);
+    auto library_vk = PipelineLibraryVK::Cast(thiz.get());
+    auto pipeline_create_info = library_vk->CreatePipeline(descriptor);
+    const bool created = pipeline_create_info != nullptr;
     promise->set_value(std::make_shared<PipelineVK>(
         weak_this, descriptor, std::move(pipeline_create_info)));
+    if (created) {
+      library_vk->SchedulePipelineCacheFlush();
+    }
   });
 
   return pipeline_future;
@@ -247,6 +257,29 @@ std::unique_ptr<PipelineCreateInfoVK> PipelineLibraryVK::CreatePipeline(
   // dynamic as mentioned above in the dynamic state info.
   pipeline_info.setPViewportState(&viewport_state);
 
+  //----------------------------------------------------------------------------
+  /// Specialization Constants
+  ///
+  /// All stages share the constants. Entries for constants a stage doesn't
+  /// declare don't affect it.
+  ///
+  std::vector<vk::SpecializationMapEntry> specialization_entries;
+  std::vector<uint32_t> specialization_data;
+  for (const auto& constant : desc.GetSpecializationConstants()) {
+    vk::SpecializationMapEntry entry;
+    entry.setConstantID(constant.constant_id);
+    entry.setOffset(specialization_data.size() * sizeof(uint32_t));
+    // Booleans are specialized with a VkBool32.
+    entry.setSize(sizeof(uint32_t));
+    specialization_entries.push_back(entry);
+    specialization_data.push_back(constant.value);
+  }
+  vk::SpecializationInfo specialization_info;
+  specialization_info.setMapEntries(specialization_entries);
+  specialization_info.setDataSize(specialization_data.size() *
+                                  sizeof(uint32_t));
+  specialization_info.setPData(specialization_data.data());
+
   //----------------------------------------------------------------------------
   /// Shader Stages
   ///
@@ -263,6 +296,9 @@ std::unique_ptr<PipelineCreateInfoVK> PipelineLibraryVK::CreatePipeline(
     info.setPName("main");
     info.setModule(
         ShaderFunctionVK::Cast(entrypoint.second.get())->GetModule());
+    if (!specialization_entries.empty()) {
+      info.setPSpecializationInfo(&specialization_info);
+    }
     shader_stages.push_back(info);
   }
   pipeline_info.setStages(shader_stages);
@@ -416,4 +452,39 @@ std::unique_ptr<PipelineCreateInfoVK> PipelineLibraryVK::CreatePipeline(
       std::move(pipeline_layout.value), std::move(descriptor_set_layout));
 }
 
+void PipelineLibraryVK::SchedulePipelineCacheFlush() {
+  if (!cache_directory_.is_valid()) {
+    return;
+  }
+  if (cache_flush_pending_.exchange(true)) {
+    return;
+  }
+  auto weak_this = weak_from_this();
+  worker_task_runner_->PostTask([weak_this]() {
+    auto thiz = weak_this.lock();
+    if (!thiz) {
+      return;
+    }
+    PipelineLibraryVK::Cast(thiz.get())->PersistPipelineCacheToDisk();
+  });
+}
+
+void PipelineLibraryVK::PersistPipelineCacheToDisk() {
+  // Pipelines created after this point schedule another flush.
+  cache_flush_pending_ = false;
+  std::vector<uint8_t> data;
+  {
+    // See the note in the header about why this is a writer lock.
+    WriterLock lock(cache_mutex_);
+    auto result = device_.getPipelineCacheData(cache_.get());
+    if (result.result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not fetch pipeline cache data: "
+                     << vk::to_string(result.result);
+      return;
+    }
+    data = std::move(result.value);
+  }
+  PipelineCacheDataPersist(cache_directory_, device_properties_, data);
+}
+
 }  // namespace impeller
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
-#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
@@ -29,6 +31,7 @@ class PipelineLibraryVK final
   friend ContextVK;
 
   vk::Device device_;
+  vk::PhysicalDeviceProperties device_properties_;
   // On locking around the pipeline cache: The cache is internally synchronized.
   // So there is no need to hold a writer lock around its use when pipelines are
   // being created. The time it takes for implementations to spend within the
@@ -37,14 +40,17 @@ class PipelineLibraryVK final
   // necessary when fetching pipeline cache data for persisting to disk.
   mutable RWMutex cache_mutex_;
   vk::UniquePipelineCache cache_ IPLR_GUARDED_BY(cache_mutex_);
+  fml::UniqueFD cache_directory_;
+  std::atomic_bool cache_flush_pending_ = false;
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   Mutex pipelines_mutex_;
   PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   bool is_valid_ = false;
 
   PipelineLibraryVK(
+      const vk::PhysicalDevice& physical_device,
       const vk::Device& device,
-      const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+      fml::UniqueFD cache_directory,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
 
   // |PipelineLibrary|
@@ -68,6 +74,15 @@ class PipelineLibraryVK final
   std::optional<vk::UniqueRenderPass> CreateRenderPass(
       const PipelineDescriptor& desc);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Write the contents of the pipeline cache to the cache
+  ///             directory on a worker. Requests made while a write is
+  ///             pending are coalesced.
+  ///
+  void SchedulePipelineCacheFlush();
+
+  void PersistPipelineCacheToDisk();
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibraryVK);
 };
 
@@ -4,9 +4,14 @@
 
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstring>
 #include <vector>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/commands_vk.h"
@@ -72,6 +77,7 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   auto& texture = TextureVK::Cast(*color0.texture);
   vk::Framebuffer framebuffer = CreateFrameBuffer(texture);
+  command_buffer_->Track(color0.texture);
 
   command_buffer_->GetDeletionQueue()->Push(
       [device = device_, fbo = framebuffer]() {
@@ -99,12 +105,19 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
                            .setRenderArea(render_area)
                            .setClearValues(clear_value);
 
-  command_buffer_->Get().beginRenderPass(rp_begin_info,
-                                         vk::SubpassContents::eInline);
-
   const auto& transients_allocator = context.GetResourceAllocator();
 
-  // encode the commands.
+  // All descriptor sets used by the pass come from the same pool. It is kept
+  // alive until the command buffer has completed and then recycled.
+  std::shared_ptr<DescriptorPoolVK> descriptor_pool =
+      GetContextVK().CreateDescriptorPool();
+  command_buffer_->GetDeletionQueue()->Push(
+      [descriptor_pool]() mutable { descriptor_pool.reset(); });
+
+  // Resolve everything the commands reference up front. This may record
+  // uploads into other command buffers and is not thread safe.
+  std::vector<PreparedCommandVK> prepared_commands;
+  prepared_commands.reserve(commands_.size());
   for (const auto& command : commands_) {
     if (command.index_count == 0u) {
       continue;
@@ -118,9 +131,30 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
       continue;
     }
 
-    if (!EncodeCommand(context, command)) {
+    PreparedCommandVK prepared;
+    if (!PrepareCommand(context, command, *descriptor_pool, prepared)) {
       return false;
     }
+    prepared_commands.push_back(prepared);
+  }
+
+  std::vector<vk::CommandBuffer> secondaries;
+  if (!RecordSecondaryCommandBuffers(prepared_commands, framebuffer,
+                                     secondaries)) {
+    return false;
+  }
+
+  command_buffer_->Get().beginRenderPass(
+      rp_begin_info, secondaries.empty()
+                         ? vk::SubpassContents::eInline
+                         : vk::SubpassContents::eSecondaryCommandBuffers);
+
+  if (secondaries.empty()) {
+    for (const auto& prepared : prepared_commands) {
+      RecordCommand(command_buffer_->Get(), prepared);
+    }
+  } else {
+    command_buffer_->Get().executeCommands(secondaries);
   }
 
   if (!TransitionImageLayout(texture.GetImage(), vk::ImageLayout::eUndefined,
@@ -152,20 +186,19 @@ bool RenderPassVK::EndCommandBuffer() {
   return false;
 }
 
-bool RenderPassVK::EncodeCommand(const Context& context,
-                                 const Command& command) const {
-  SetViewportAndScissor(command);
-
+bool RenderPassVK::PrepareCommand(const Context& context,
+                                  const Command& command,
+                                  DescriptorPoolVK& descriptor_pool,
+                                  PreparedCommandVK& prepared) const {
   auto& pipeline_vk = PipelineVK::Cast(*command.pipeline);
   PipelineCreateInfoVK* pipeline_create_info = pipeline_vk.GetCreateInfo();
 
-  if (!AllocateAndBindDescriptorSets(context, command, pipeline_create_info)) {
+  auto desc_set = AllocateDescriptorSets(context, command, pipeline_create_info,
+                                         descriptor_pool);
+  if (!desc_set.has_value()) {
     return false;
   }
 
-  command_buffer_->Get().bindPipeline(vk::PipelineBindPoint::eGraphics,
-                                      pipeline_create_info->GetVKPipeline());
-
   auto vertex_buffer_view = command.GetVertexBuffer();
   auto index_buffer_view = command.index_buffer;
 
@@ -174,7 +207,6 @@ bool RenderPassVK::EncodeCommand(const Context& context,
   }
 
   auto& allocator = *context.GetResourceAllocator();
-  const auto& pipeline_desc = command.pipeline->GetDescriptor();
 
   auto vertex_buffer = vertex_buffer_view.buffer->GetDeviceBuffer(allocator);
   auto index_buffer = index_buffer_view.buffer->GetDeviceBuffer(allocator);
@@ -184,75 +216,223 @@ bool RenderPassVK::EncodeCommand(const Context& context,
                    << " for vertex and index buffer views";
     return false;
   }
+  command_buffer_->Track(vertex_buffer);
+  command_buffer_->Track(index_buffer);
+
+  prepared.command = &command;
+  prepared.pipeline = pipeline_create_info->GetVKPipeline();
+  prepared.pipeline_layout = pipeline_create_info->GetPipelineLayout();
+  prepared.descriptor_set = desc_set.value();
+  prepared.vertex_buffer =
+      DeviceBufferVK::Cast(*vertex_buffer).GetVKBufferHandle();
+  prepared.vertex_buffer_offset = vertex_buffer_view.range.offset;
+  prepared.index_buffer =
+      DeviceBufferVK::Cast(*index_buffer).GetVKBufferHandle();
+  prepared.index_buffer_offset = index_buffer_view.range.offset;
+  return true;
+}
+
+void RenderPassVK::RecordCommand(vk::CommandBuffer command_buffer,
+                                 const PreparedCommandVK& prepared) const {
+  const Command& command = *prepared.command;
+
+  SetViewportAndScissor(command_buffer, command);
+
+  command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                                    prepared.pipeline_layout, 0,
+                                    prepared.descriptor_set, nullptr);
+
+  command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                              prepared.pipeline);
 
   // bind vertex buffer
-  auto vertex_buffer_handle =
-      DeviceBufferVK::Cast(*vertex_buffer).GetVKBufferHandle();
-  vk::Buffer vertex_buffers[] = {vertex_buffer_handle};
-  vk::DeviceSize vertex_buffer_offsets[] = {vertex_buffer_view.range.offset};
-  command_buffer_->Get().bindVertexBuffers(0, 1, vertex_buffers,
-                                           vertex_buffer_offsets);
+  vk::Buffer vertex_buffers[] = {prepared.vertex_buffer};
+  vk::DeviceSize vertex_buffer_offsets[] = {prepared.vertex_buffer_offset};
+  command_buffer.bindVertexBuffers(0, 1, vertex_buffers,
+                                   vertex_buffer_offsets);
 
   // index buffer
-  auto index_buffer_handle =
-      DeviceBufferVK::Cast(*index_buffer).GetVKBufferHandle();
-  command_buffer_->Get().bindIndexBuffer(index_buffer_handle,
-                                         index_buffer_view.range.offset,
-                                         ToVKIndexType(command.index_type));
+  command_buffer.bindIndexBuffer(prepared.index_buffer,
+                                 prepared.index_buffer_offset,
+                                 ToVKIndexType(command.index_type));
 
   // execute draw
-  command_buffer_->Get().drawIndexed(command.index_count,
-                                     command.instance_count, 0, 0, 0);
-  return true;
+  command_buffer.drawIndexed(command.index_count, command.instance_count, 0,
+                             0, 0);
 }
 
-bool RenderPassVK::AllocateAndBindDescriptorSets(
+// Secondaries are only worth their overhead when each gets at least this many
+// commands. Smaller passes are recorded inline.
+static constexpr size_t kMinCommandsPerSecondary = 256u;
 
-    const Context& context,
-    const Command& command,
-    PipelineCreateInfoVK* pipeline_create_info) const {
-  auto& allocator = *context.GetResourceAllocator();
-  vk::PipelineLayout pipeline_layout =
-      pipeline_create_info->GetPipelineLayout();
+// The most secondaries a pass is split into.
+static constexpr size_t kMaxSecondaries = 8u;
 
+bool RenderPassVK::RecordSecondaryCommandBuffers(
+    const std::vector<PreparedCommandVK>& commands,
+    vk::Framebuffer framebuffer,
+    std::vector<vk::CommandBuffer>& secondaries) const {
   const auto& context_vk = GetContextVK();
-  const auto& pool = context_vk.CreateDescriptorPool();
+  const auto& worker_task_runner = context_vk.GetConcurrentWorkerTaskRunner();
+  const size_t secondary_count =
+      std::min(commands.size() / kMinCommandsPerSecondary, kMaxSecondaries);
+  if (!worker_task_runner || secondary_count < 2u) {
+    return true;
+  }
 
-  command_buffer_->GetDeletionQueue()->Push(
-      [pool = pool->GetPool(), device = device_]() {
-        device.destroyDescriptorPool(pool);
-      });
+  TRACE_EVENT0("impeller", "RenderPassVK::RecordSecondaryCommandBuffers");
 
-  vk::DescriptorSetAllocateInfo alloc_info;
-  std::array<vk::DescriptorSetLayout, 1> dsls = {
-      pipeline_create_info->GetDescriptorSetLayout(),
-  };
+  // Command pools may only be used on one thread at a time. So each secondary
+  // is allocated from a pool of its own. The pool is recycled once the
+  // command buffer has completed.
+  for (size_t i = 0; i < secondary_count; i++) {
+    std::shared_ptr<CommandPoolVK> pool =
+        context_vk.CreateGraphicsCommandPool();
+    if (!pool) {
+      return false;
+    }
+    vk::CommandBufferAllocateInfo allocate_info;
+    allocate_info.setLevel(vk::CommandBufferLevel::eSecondary);
+    allocate_info.setCommandBufferCount(1);
+    allocate_info.setCommandPool(pool->Get());
+    auto res = device_.allocateCommandBuffers(allocate_info);
+    if (res.result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Failed to allocate secondary command buffer: "
+                     << vk::to_string(res.result);
+      return false;
+    }
+    vk::CommandBuffer secondary = res.value[0];
+    command_buffer_->GetDeletionQueue()->Push(
+        [device = device_, pool, secondary]() {
+          device.freeCommandBuffers(pool->Get(), secondary);
+        });
+    secondaries.push_back(secondary);
+  }
 
-  alloc_info.setDescriptorPool(pool->GetPool());
-  alloc_info.setSetLayouts(dsls);
+  vk::CommandBufferInheritanceInfo inheritance_info;
+  inheritance_info.setRenderPass(render_pass_);
+  inheritance_info.setSubpass(0u);
+  inheritance_info.setFramebuffer(framebuffer);
 
-  auto desc_sets_res = device_.allocateDescriptorSets(alloc_info);
-  if (desc_sets_res.result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to allocate descriptor sets: "
-                   << vk::to_string(desc_sets_res.result);
-    return false;
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                      vk::CommandBufferUsageFlagBits::eRenderPassContinue);
+  begin_info.setPInheritanceInfo(&inheritance_info);
+
+  // The secondaries are executed in order. So each records a contiguous
+  // range of the commands.
+  std::atomic_bool failed = false;
+  fml::CountDownLatch latch(secondary_count);
+  for (size_t i = 0; i < secondary_count; i++) {
+    const size_t begin = commands.size() * i / secondary_count;
+    const size_t end = commands.size() * (i + 1) / secondary_count;
+    worker_task_runner->PostTask([&, secondary = secondaries[i], begin, end]() {
+      if (secondary.begin(begin_info) != vk::Result::eSuccess) {
+        failed = true;
+      } else {
+        for (size_t j = begin; j < end; j++) {
+          RecordCommand(secondary, commands[j]);
+        }
+        if (secondary.end() != vk::Result::eSuccess) {
+          failed = true;
+        }
+      }
+      latch.CountDown();
+    });
   }
+  latch.Wait();
 
-  auto desc_sets = desc_sets_res.value;
-  bool update_vertex_descriptors = UpdateDescriptorSets(
-      "vertex_bindings", command.vertex_bindings, allocator, desc_sets[0]);
-  if (!update_vertex_descriptors) {
+  if (failed) {
+    VALIDATION_LOG << "Failed to record secondary command buffers.";
     return false;
   }
-  bool update_frag_descriptors = UpdateDescriptorSets(
-      "fragment_bindings", command.fragment_bindings, allocator, desc_sets[0]);
-  if (!update_frag_descriptors) {
+  return true;
+}
+
+template <class T>
+static uint64_t ToSetKeyEntry(T handle) {
+  // Non-dispatchable handles are pointers or 64-bit integers depending on the
+  // platform.
+  auto c_handle = static_cast<typename T::CType>(handle);
+  static_assert(sizeof(c_handle) <= sizeof(uint64_t));
+  uint64_t entry = 0u;
+  std::memcpy(&entry, &c_handle, sizeof(c_handle));
+  return entry;
+}
+
+/// Append the resources referenced by the bindings to the key identifying a
+/// descriptor set. Returns false if a resource could not be resolved.
+static bool AppendBindingsToSetKey(const Bindings& bindings,
+                                   Allocator& allocator,
+                                   DescriptorPoolVK::SetKey& key) {
+  for (const auto& [buffer_index, view] : bindings.buffers) {
+    if (buffer_index == VertexDescriptor::kReservedVertexBufferIndex) {
+      continue;
+    }
+    auto device_buffer = view.resource.buffer->GetDeviceBuffer(allocator);
+    if (!device_buffer) {
+      return false;
+    }
+    const auto& buffer_vk = DeviceBufferVK::Cast(*device_buffer);
+    key.push_back(bindings.uniforms.at(buffer_index).binding);
+    key.push_back(ToSetKeyEntry(buffer_vk.GetVKBufferHandle()));
+    key.push_back(view.resource.range.offset);
+    key.push_back(view.resource.range.length);
+  }
+  for (const auto& [index, sampler_handle] : bindings.samplers) {
+    auto texture = bindings.textures.find(index);
+    if (texture == bindings.textures.end()) {
+      return false;
+    }
+    const auto& texture_vk = TextureVK::Cast(*texture->second.resource);
+    key.push_back(bindings.sampled_images.at(index).binding);
+    key.push_back(ToSetKeyEntry(texture_vk.GetImageView()));
+    key.push_back(ToSetKeyEntry(
+        SamplerVK::Cast(*sampler_handle.resource).GetSamplerVK()));
+  }
+  return true;
+}
+
+std::optional<vk::DescriptorSet> RenderPassVK::AllocateDescriptorSets(
+    const Context& context,
+    const Command& command,
+    PipelineCreateInfoVK* pipeline_create_info,
+    DescriptorPoolVK& descriptor_pool) const {
+  auto& allocator = *context.GetResourceAllocator();
+  vk::DescriptorSetLayout set_layout =
+      pipeline_create_info->GetDescriptorSetLayout();
+
+  // Commands in the pass that bind the same resources with the same layout
+  // share a descriptor set. Those resources have already been prepared when
+  // the set was first written.
+  DescriptorPoolVK::SetKey key = {ToSetKeyEntry(set_layout)};
+  if (!AppendBindingsToSetKey(command.vertex_bindings, allocator, key) ||
+      !AppendBindingsToSetKey(command.fragment_bindings, allocator, key)) {
+    VALIDATION_LOG << "Failed to resolve the resources bound to a command.";
     return false;
   }
 
-  command_buffer_->Get().bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics, pipeline_layout, 0, desc_sets, nullptr);
-  return true;
+  auto desc_set = descriptor_pool.FindDescriptorSet(key);
+  if (!desc_set.has_value()) {
+    desc_set = descriptor_pool.AllocateDescriptorSet(set_layout, key);
+    if (!desc_set.has_value()) {
+      return false;
+    }
+    bool update_vertex_descriptors =
+        UpdateDescriptorSets("vertex_bindings", command.vertex_bindings,
+                             allocator, desc_set.value());
+    if (!update_vertex_descriptors) {
+      return false;
+    }
+    bool update_frag_descriptors =
+        UpdateDescriptorSets("fragment_bindings", command.fragment_bindings,
+                             allocator, desc_set.value());
+    if (!update_frag_descriptors) {
+      return false;
+    }
+  }
+
+  return desc_set;
 }
 
 bool RenderPassVK::UpdateDescriptorSets(const char* label,
@@ -271,6 +451,7 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
       VALIDATION_LOG << "Failed to get device buffer for vertex binding";
       return false;
     }
+    command_buffer_->Track(device_buffer);
 
     auto buffer = DeviceBufferVK::Cast(*device_buffer).GetVKBufferHandle();
     if (!buffer) {
@@ -308,26 +489,37 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
       return false;
     }
 
-    const auto& texture_vk =
-        TextureVK::Cast(*bindings.textures.at(index).resource);
+    const auto& texture = bindings.textures.at(index).resource;
+    const auto& texture_vk = TextureVK::Cast(*texture);
+    command_buffer_->Track(texture);
 
     const Sampler& sampler = *sampler_handle.resource;
     const SamplerVK& sampler_vk = SamplerVK::Cast(sampler);
 
     const SampledImageSlot& slot = bindings.sampled_images.at(index);
 
-    if (!TransitionImageLayout(texture_vk.GetImage(),
-                               vk::ImageLayout::eUndefined,
-                               vk::ImageLayout::eTransferDstOptimal)) {
-      return false;
-    }
-
-    CopyBufferToImage(texture_vk);
-
-    if (!TransitionImageLayout(texture_vk.GetImage(),
-                               vk::ImageLayout::eTransferDstOptimal,
-                               vk::ImageLayout::eShaderReadOnlyOptimal)) {
-      return false;
+    if (texture_vk.IsExternal()) {
+      // The contents were produced outside of Impeller and are sampled in
+      // place, there is nothing to upload.
+      if (!TransitionImageLayout(texture_vk.GetImage(),
+                                 vk::ImageLayout::eUndefined,
+                                 vk::ImageLayout::eShaderReadOnlyOptimal)) {
+        return false;
+      }
+    } else {
+      if (!TransitionImageLayout(texture_vk.GetImage(),
+                                 vk::ImageLayout::eUndefined,
+                                 vk::ImageLayout::eTransferDstOptimal)) {
+        return false;
+      }
+
+      CopyBufferToImage(texture_vk);
+
+      if (!TransitionImageLayout(texture_vk.GetImage(),
+                                 vk::ImageLayout::eTransferDstOptimal,
+                                 vk::ImageLayout::eShaderReadOnlyOptimal)) {
+        return false;
+      }
     }
 
     vk::DescriptorImageInfo desc_image_info;
@@ -354,7 +546,8 @@ bool RenderPassVK::UpdateDescriptorSets(const char* label,
   return true;
 }
 
-void RenderPassVK::SetViewportAndScissor(const Command& command) const {
+void RenderPassVK::SetViewportAndScissor(vk::CommandBuffer command_buffer,
+                                         const Command& command) const {
   // set viewport.
   const auto& vp = command.viewport.value_or<Viewport>(
       {.rect = Rect::MakeSize(GetRenderTargetSize())});
@@ -364,7 +557,7 @@ void RenderPassVK::SetViewportAndScissor(const Command& command) const {
                               .setY(vp.rect.size.height)
                               .setMinDepth(0.0f)
                               .setMaxDepth(1.0f);
-  command_buffer_->Get().setViewport(0, 1, &viewport);
+  command_buffer.setViewport(0, 1, &viewport);
 
   // scissor
   const auto& sc =
@@ -373,7 +566,7 @@ void RenderPassVK::SetViewportAndScissor(const Command& command) const {
       vk::Rect2D()
           .setOffset(vk::Offset2D(sc.origin.x, sc.origin.y))
           .setExtent(vk::Extent2D(sc.size.width, sc.size.height));
-  command_buffer_->Get().setScissor(0, 1, &scissor);
+  command_buffer.setScissor(0, 1, &scissor);
 }
 
 vk::Framebuffer RenderPassVK::CreateFrameBuffer(
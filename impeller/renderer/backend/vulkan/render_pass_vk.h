@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/fenced_command_buffer_vk.h"
@@ -45,12 +48,47 @@ class RenderPassVK final : public RenderPass {
   // |RenderPass|
   bool OnEncodeCommands(const Context& context) const override;
 
-  bool EncodeCommand(const Context& context, const Command& command) const;
-
-  bool AllocateAndBindDescriptorSets(
+  //----------------------------------------------------------------------------
+  /// @brief      The state a command is recorded with. It is resolved on the
+  ///             encoding thread ahead of recording so that recording only
+  ///             touches the command buffer being recorded into.
+  ///
+  struct PreparedCommandVK {
+    const Command* command = nullptr;
+    vk::Pipeline pipeline;
+    vk::PipelineLayout pipeline_layout;
+    vk::DescriptorSet descriptor_set;
+    vk::Buffer vertex_buffer;
+    vk::DeviceSize vertex_buffer_offset = 0u;
+    vk::Buffer index_buffer;
+    vk::DeviceSize index_buffer_offset = 0u;
+  };
+
+  bool PrepareCommand(const Context& context,
+                      const Command& command,
+                      DescriptorPoolVK& descriptor_pool,
+                      PreparedCommandVK& prepared) const;
+
+  void RecordCommand(vk::CommandBuffer command_buffer,
+                     const PreparedCommandVK& prepared) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the commands into secondary command buffers on the
+  ///             concurrent workers. Each secondary gets a command pool of its
+  ///             own. Leaves the secondaries empty if the pass is too small
+  ///             to benefit, in which case the commands must be recorded
+  ///             inline.
+  ///
+  bool RecordSecondaryCommandBuffers(
+      const std::vector<PreparedCommandVK>& commands,
+      vk::Framebuffer framebuffer,
+      std::vector<vk::CommandBuffer>& secondaries) const;
+
+  std::optional<vk::DescriptorSet> AllocateDescriptorSets(
       const Context& context,
       const Command& command,
-      PipelineCreateInfoVK* pipeline_create_info) const;
+      PipelineCreateInfoVK* pipeline_create_info,
+      DescriptorPoolVK& descriptor_pool) const;
 
   bool EndCommandBuffer();
 
@@ -59,7 +97,8 @@ class RenderPassVK final : public RenderPass {
                             Allocator& allocator,
                             vk::DescriptorSet desc_set) const;
 
-  void SetViewportAndScissor(const Command& command) const;
+  void SetViewportAndScissor(vk::CommandBuffer command_buffer,
+                             const Command& command) const;
 
   vk::Framebuffer CreateFrameBuffer(const TextureVK& texture) const;
 
@@ -0,0 +1,224 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/fixtures/colors.frag.h"
+#include "impeller/fixtures/colors.vert.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/pipeline_builder.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+namespace testing {
+
+using RenderPassVKTest = PlaygroundTest;
+INSTANTIATE_VULKAN_PLAYGROUND_SUITE(RenderPassVKTest);
+
+namespace {
+
+using VS = ColorsVertexShader;
+using FS = ColorsFragmentShader;
+
+bool SubmitAndWait(const std::shared_ptr<CommandBuffer>& command_buffer) {
+  fml::AutoResetWaitableEvent latch;
+  CommandBuffer::Status status = CommandBuffer::Status::kPending;
+  if (!command_buffer->SubmitCommands(
+          [&latch, &status](CommandBuffer::Status submitted_status) {
+            status = submitted_status;
+            latch.Signal();
+          })) {
+    return false;
+  }
+  latch.Wait();
+  return status == CommandBuffer::Status::kCompleted;
+}
+
+// A rectangle of a solid color, in pixels.
+struct Quad {
+  Rect rect;
+  Color color;
+};
+
+// Draws each quad with a command of its own, in order, and reads back the
+// RGBA8 pixels of the render target.
+std::shared_ptr<DeviceBuffer> DrawQuads(const std::shared_ptr<Context>& context,
+                                        ISize size,
+                                        const std::vector<Quad>& quads) {
+  auto desc = PipelineBuilder<VS, FS>::MakeDefaultPipelineDescriptor(*context);
+  if (!desc.has_value()) {
+    return nullptr;
+  }
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(std::move(desc)).Get();
+  if (!pipeline) {
+    return nullptr;
+  }
+
+  std::vector<VS::PerVertexData> vertices;
+  for (const auto& quad : quads) {
+    for (const auto& point : quad.rect.GetPoints()) {
+      vertices.push_back({Vector3(point.x, point.y, 0.0), quad.color});
+    }
+  }
+  const uint16_t indices[6] = {0, 1, 2, 1, 2, 3};
+  auto allocator = context->GetResourceAllocator();
+  auto vertex_buffer = allocator->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(vertices.data()),
+      vertices.size() * sizeof(VS::PerVertexData));
+  auto index_buffer = allocator->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(indices), sizeof(indices));
+  if (!vertex_buffer || !index_buffer) {
+    return nullptr;
+  }
+
+  auto render_target = RenderTarget::CreateOffscreen(
+      *context, size, "Quads", RenderTarget::kDefaultAttachmentConfig,
+      RenderTarget::AttachmentConfig{
+          .storage_mode = StorageMode::kDeviceTransient,
+          .load_action = LoadAction::kClear,
+          .store_action = StoreAction::kDontCare,
+      });
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return nullptr;
+  }
+  auto pass = command_buffer->CreateRenderPass(render_target);
+  if (!pass) {
+    return nullptr;
+  }
+  VS::UniformBuffer uniforms;
+  uniforms.mvp = Matrix::MakeOrthographic(size);
+  auto uniform_view = pass->GetTransientsBuffer().EmplaceUniform(uniforms);
+  for (size_t i = 0u; i < quads.size(); i++) {
+    Command cmd;
+    cmd.label = "Quad";
+    cmd.pipeline = pipeline;
+    VertexBuffer quad_vertices;
+    quad_vertices.vertex_buffer = {
+        .buffer = vertex_buffer,
+        .range = Range(i * 4u * sizeof(VS::PerVertexData),
+                       4u * sizeof(VS::PerVertexData))};
+    quad_vertices.index_buffer = {
+        .buffer = index_buffer,
+        .range = Range(0u, sizeof(indices)),
+    };
+    quad_vertices.index_count = 6u;
+    quad_vertices.index_type = IndexType::k16bit;
+    cmd.BindVertices(quad_vertices);
+    VS::BindUniformBuffer(cmd, uniform_view);
+    if (!pass->AddCommand(std::move(cmd))) {
+      return nullptr;
+    }
+  }
+  if (!pass->EncodeCommands() || !SubmitAndWait(command_buffer)) {
+    return nullptr;
+  }
+
+  DeviceBufferDescriptor readback_desc;
+  readback_desc.storage_mode = StorageMode::kHostVisible;
+  readback_desc.size = size.Area() * 4u;
+  auto readback = allocator->CreateBuffer(readback_desc);
+  auto blit_buffer = context->CreateCommandBuffer();
+  if (!readback || !blit_buffer) {
+    return nullptr;
+  }
+  auto blit_pass = blit_buffer->CreateBlitPass();
+  if (!blit_pass ||
+      !blit_pass->AddCopy(render_target.GetRenderTargetTexture(), readback) ||
+      !blit_pass->EncodeCommands(allocator) ||
+      !SubmitAndWait(blit_buffer)) {
+    return nullptr;
+  }
+  return readback;
+}
+
+// The red and blue channels are the same, so that the colors read back
+// don't depend on the order of the channels of the render target format.
+Color MakeColor(uint8_t red_and_blue, uint8_t green) {
+  return Color::MakeRGBA8(red_and_blue, green, red_and_blue, 255u);
+}
+
+}  // namespace
+
+TEST_P(RenderPassVKTest, LargePassesDrawEveryCommand) {
+  // One command per pixel, which is enough commands for the pass to be split
+  // across four secondaries.
+  constexpr ISize kSize = {32, 32};
+  std::vector<Quad> quads;
+  for (int64_t y = 0; y < kSize.height; y++) {
+    for (int64_t x = 0; x < kSize.width; x++) {
+      const uint16_t index = y * kSize.width + x;
+      quads.push_back({
+          .rect = Rect::MakeXYWH(x, y, 1, 1),
+          .color = MakeColor(index & 0xFF, index >> 8),
+      });
+    }
+  }
+
+  auto readback = DrawQuads(GetContext(), kSize, quads);
+  ASSERT_TRUE(readback);
+  const uint8_t* pixels = readback->AsBufferView().contents;
+  for (int64_t y = 0; y < kSize.height; y++) {
+    for (int64_t x = 0; x < kSize.width; x++) {
+      const uint16_t index = y * kSize.width + x;
+      const uint8_t* pixel = pixels + index * 4u;
+      ASSERT_EQ(pixel[0], index & 0xFF) << "at " << x << ", " << y;
+      ASSERT_EQ(pixel[1], index >> 8) << "at " << x << ", " << y;
+      ASSERT_EQ(pixel[2], index & 0xFF) << "at " << x << ", " << y;
+      ASSERT_EQ(pixel[3], 255) << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST_P(RenderPassVKTest, LargePassesDrawCommandsInOrder) {
+  // Every command covers the whole target, so only the last one is visible
+  // if the secondaries are executed in order.
+  constexpr ISize kSize = {4, 4};
+  constexpr uint16_t kCommandCount = 2048u;
+  std::vector<Quad> quads;
+  for (uint16_t i = 0u; i < kCommandCount; i++) {
+    quads.push_back({
+        .rect = Rect::MakeSize(kSize),
+        .color = MakeColor(i & 0xFF, (i >> 8) & 0xFF),
+    });
+  }
+
+  auto readback = DrawQuads(GetContext(), kSize, quads);
+  ASSERT_TRUE(readback);
+  const uint8_t* pixels = readback->AsBufferView().contents;
+  for (int64_t i = 0; i < kSize.Area(); i++) {
+    ASSERT_EQ(pixels[i * 4u], (kCommandCount - 1) & 0xFF);
+    ASSERT_EQ(pixels[i * 4u + 1u], (kCommandCount - 1) >> 8);
+  }
+}
+
+TEST_P(RenderPassVKTest, SmallPassesDrawEveryCommand) {
+  // Too few commands to be split, so they are recorded inline.
+  constexpr ISize kSize = {4, 4};
+  std::vector<Quad> quads;
+  for (uint8_t i = 0u; i < kSize.Area(); i++) {
+    quads.push_back({
+        .rect = Rect::MakeXYWH(i % kSize.width, i / kSize.width, 1, 1),
+        .color = MakeColor(i * 16u, 0u),
+    });
+  }
+
+  auto readback = DrawQuads(GetContext(), kSize, quads);
+  ASSERT_TRUE(readback);
+  const uint8_t* pixels = readback->AsBufferView().contents;
+  for (int i = 0; i < kSize.Area(); i++) {
+    ASSERT_EQ(pixels[i * 4u], i * 16) << "at pixel " << i;
+  }
+}
+
+}  // namespace testing
+}  // namespace impeller
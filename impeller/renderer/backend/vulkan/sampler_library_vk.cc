@@ -15,6 +15,7 @@ SamplerLibraryVK::~SamplerLibraryVK() = default;
 
 std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
     SamplerDescriptor desc) {
+  Lock lock(samplers_mutex_);
   auto found = samplers_.find(desc);
   if (found != samplers_.end()) {
     return found->second;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/comparable.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -24,7 +25,9 @@ class SamplerLibraryVK final
   friend class ContextVK;
 
   vk::Device device_;
-  SamplerMap samplers_;
+  // Samplers are requested by passes that may be encoded concurrently.
+  Mutex samplers_mutex_;
+  SamplerMap samplers_ IPLR_GUARDED_BY(samplers_mutex_);
 
   explicit SamplerLibraryVK(vk::Device device);
 
@@ -7,6 +7,7 @@
 #include <array>
 #include <utility>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -35,11 +36,16 @@ SurfaceProducerVK::~SurfaceProducerVK() = default;
 
 std::unique_ptr<Surface> SurfaceProducerVK::AcquireSurface(
     size_t current_frame) {
-  current_frame = current_frame % kMaxFramesInFlight;
+  current_frame = current_frame % sync_objects_.size();
   const auto& sync_objects = sync_objects_[current_frame];
 
-  auto fence_wait_res = create_info_.device.waitForFences(
-      {*sync_objects->in_flight_fence}, VK_TRUE, UINT64_MAX);
+  vk::Result fence_wait_res;
+  {
+    // Blocks while all the frames in flight are still being rendered.
+    TRACE_EVENT0("impeller", "SurfaceProducerVK::WaitForFrameInFlight");
+    fence_wait_res = create_info_.device.waitForFences(
+        {*sync_objects->in_flight_fence}, VK_TRUE, UINT64_MAX);
+  }
   if (fence_wait_res != vk::Result::eSuccess) {
     VALIDATION_LOG << "Failed to wait for fence: "
                    << vk::to_string(fence_wait_res);
@@ -55,9 +61,13 @@ std::unique_ptr<Surface> SurfaceProducerVK::AcquireSurface(
   }
 
   uint32_t image_index;
-  auto acuire_image_res = create_info_.device.acquireNextImageKHR(
-      create_info_.swapchain->GetSwapchain(), UINT64_MAX,
-      *sync_objects->image_available_semaphore, {}, &image_index);
+  vk::Result acuire_image_res;
+  {
+    TRACE_EVENT0("impeller", "SurfaceProducerVK::AcquireNextImage");
+    acuire_image_res = create_info_.device.acquireNextImageKHR(
+        create_info_.swapchain->GetSwapchain(), UINT64_MAX,
+        *sync_objects->image_available_semaphore, {}, &image_index);
+  }
 
   if (acuire_image_res != vk::Result::eSuccess &&
       acuire_image_res != vk::Result::eSuboptimalKHR) {
@@ -123,12 +133,14 @@ std::unique_ptr<SurfaceSyncObjectsVK> SurfaceSyncObjectsVK::Create(
 }
 
 bool SurfaceProducerVK::SetupSyncObjects() {
-  for (size_t i = 0; i < kMaxFramesInFlight; i++) {
+  FML_DCHECK(create_info_.frames_in_flight > 0u &&
+             create_info_.frames_in_flight <= kMaxFramesInFlight);
+  for (size_t i = 0; i < create_info_.frames_in_flight; i++) {
     auto sync_objects = SurfaceSyncObjectsVK::Create(create_info_.device);
     if (!sync_objects) {
       return false;
     }
-    sync_objects_[i] = std::move(sync_objects);
+    sync_objects_.push_back(std::move(sync_objects));
   }
   return true;
 }
@@ -156,17 +168,13 @@ bool SurfaceProducerVK::Submit(uint32_t frame_num) {
     return false;
   }
 
-  auto idle_wait_res = create_info_.graphics_queue.waitIdle();
-  if (idle_wait_res != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to wait for graphics queue idle: "
-                   << vk::to_string(idle_wait_res);
-    return false;
-  }
-
+  // The in flight fence is waited for before the sync objects are reused, so
+  // the queue doesn't have to be idle for the next frame to be rendered.
   return true;
 }
 
 bool SurfaceProducerVK::Present(size_t frame_num, uint32_t image_index) {
+  TRACE_EVENT0("impeller", "SurfaceProducerVK::Present");
   Submit(frame_num);
 
   auto& sync_objects = sync_objects_[frame_num];
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/swapchain_vk.h"
@@ -19,6 +20,8 @@ struct SurfaceProducerCreateInfoVK {
   vk::Queue graphics_queue;
   vk::Queue present_queue;
   SwapchainVK* swapchain;
+  // At most kMaxFramesInFlight.
+  size_t frames_in_flight = 2u;
 };
 
 class SurfaceSyncObjectsVK {
@@ -54,8 +57,8 @@ class SurfaceProducerVK {
 
   const SurfaceProducerCreateInfoVK create_info_;
 
-  // sync objects
-  std::unique_ptr<SurfaceSyncObjectsVK> sync_objects_[kMaxFramesInFlight];
+  // sync objects, one set per frame in flight
+  std::vector<std::unique_ptr<SurfaceSyncObjectsVK>> sync_objects_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SurfaceProducerVK);
 };
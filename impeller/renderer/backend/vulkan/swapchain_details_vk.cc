@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_details_vk.h"
 
+#include <algorithm>
+
 #include "impeller/base/validation.h"
 
 namespace impeller {
@@ -67,7 +69,13 @@ vk::SurfaceFormatKHR SwapchainDetailsVK::PickSurfaceFormat() const {
   return surface_formats_[0];
 }
 
-vk::PresentModeKHR SwapchainDetailsVK::PickPresentationMode() const {
+vk::PresentModeKHR SwapchainDetailsVK::PickPresentationMode(
+    PresentLatencyVK latency) const {
+  if (latency == PresentLatencyVK::kThroughput) {
+    // Vulkan spec dictates that FIFO is always available.
+    return vk::PresentModeKHR::eFifo;
+  }
+
   for (const auto& mode : present_modes_) {
     if (mode == vk::PresentModeKHR::eMailbox) {
       return mode;
@@ -75,10 +83,21 @@ vk::PresentModeKHR SwapchainDetailsVK::PickPresentationMode() const {
   }
 
   FML_LOG(ERROR) << "Picking a sub-optimal presentation mode.";
-  // Vulkan spec dictates that FIFO is always available.
   return vk::PresentModeKHR::eFifo;
 }
 
+size_t SwapchainDetailsVK::GetFramesInFlight(
+    const SwapchainSettingsVK& settings,
+    vk::PresentModeKHR present_mode) {
+  if (settings.latency == PresentLatencyVK::kLowLatency &&
+      present_mode != vk::PresentModeKHR::eMailbox) {
+    // Each queued image adds a vsync of latency, so only one frame is queued
+    // at a time.
+    return 1u;
+  }
+  return std::clamp<size_t>(settings.frames_in_flight, 1u, kMaxFramesInFlight);
+}
+
 vk::CompositeAlphaFlagBitsKHR SwapchainDetailsVK::PickCompositeAlpha() const {
   return composite_alpha_;
 }
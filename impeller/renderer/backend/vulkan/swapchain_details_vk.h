@@ -9,6 +9,23 @@
 
 namespace impeller {
 
+/// What the presentation of swapchain images is tuned for.
+enum class PresentLatencyVK {
+  /// Present images as soon as possible. Images that are still queued are
+  /// replaced if the surface supports it, otherwise a single frame is kept in
+  /// flight.
+  kLowLatency,
+  /// Queue every image for a vsync, so that no frame is dropped.
+  kThroughput,
+};
+
+struct SwapchainSettingsVK {
+  PresentLatencyVK latency = PresentLatencyVK::kLowLatency;
+  /// The number of frames that may be submitted to the GPU before the first
+  /// of them completes. Clamped to [1, kMaxFramesInFlight].
+  size_t frames_in_flight = 2u;
+};
+
 class SwapchainDetailsVK {
  public:
   static std::unique_ptr<SwapchainDetailsVK> Create(
@@ -24,7 +41,14 @@ class SwapchainDetailsVK {
 
   vk::SurfaceFormatKHR PickSurfaceFormat() const;
 
-  vk::PresentModeKHR PickPresentationMode() const;
+  vk::PresentModeKHR PickPresentationMode(PresentLatencyVK latency) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames to keep in flight with the |settings|
+  ///             for a swapchain that presents with |present_mode|.
+  ///
+  static size_t GetFramesInFlight(const SwapchainSettingsVK& settings,
+                                  vk::PresentModeKHR present_mode);
 
   vk::CompositeAlphaFlagBitsKHR PickCompositeAlpha() const;
 
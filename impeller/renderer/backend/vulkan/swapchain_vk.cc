@@ -10,11 +10,12 @@
 
 namespace impeller {
 
-std::unique_ptr<SwapchainVK> SwapchainVK::Create(vk::Device device,
-                                                 vk::SurfaceKHR surface,
-                                                 SwapchainDetailsVK& details) {
+std::unique_ptr<SwapchainVK> SwapchainVK::Create(
+    vk::Device device,
+    vk::SurfaceKHR surface,
+    SwapchainDetailsVK& details,
+    vk::PresentModeKHR present_mode) {
   vk::SurfaceFormatKHR surface_format = details.PickSurfaceFormat();
-  vk::PresentModeKHR present_mode = details.PickPresentationMode();
   vk::Extent2D extent = details.PickExtent();
 
   vk::SwapchainCreateInfoKHR create_info;
@@ -43,7 +43,8 @@ class SwapchainVK {
  public:
   static std::unique_ptr<SwapchainVK> Create(vk::Device device,
                                              vk::SurfaceKHR surface,
-                                             SwapchainDetailsVK& details);
+                                             SwapchainDetailsVK& details,
+                                             vk::PresentModeKHR present_mode);
 
   SwapchainVK(vk::Device device,
               vk::UniqueSwapchainKHR swapchain,
@@ -14,6 +14,12 @@ TextureVK::TextureVK(TextureDescriptor desc,
       texture_info_(std::move(texture_info)) {}
 
 TextureVK::~TextureVK() {
+  if (IsExternal()) {
+    if (texture_info_->release_external_texture) {
+      texture_info_->release_external_texture();
+    }
+    return;
+  }
   if (!IsWrapped() && IsValid()) {
     const auto& texture = texture_info_->allocated_texture;
     vmaDestroyImage(*texture.backing_allocation.allocator, texture.image,
@@ -28,7 +34,7 @@ void TextureVK::SetLabel(std::string_view label) {
 bool TextureVK::OnSetContents(const uint8_t* contents,
                               size_t length,
                               size_t slice) {
-  if (IsWrapped()) {
+  if (IsWrapped() || IsExternal()) {
     FML_LOG(ERROR) << "Cannot set contents of a wrapped texture";
     return false;
   }
@@ -71,6 +77,8 @@ bool TextureVK::IsValid() const {
       return texture_info_->allocated_texture.image;
     case TextureBackingTypeVK::kWrappedTexture:
       return texture_info_->wrapped_texture.swapchain_image;
+    case TextureBackingTypeVK::kExternalTexture:
+      return texture_info_->external_texture.image;
   }
 }
 
@@ -86,6 +94,10 @@ bool TextureVK::IsWrapped() const {
   return texture_info_->backing_type == TextureBackingTypeVK::kWrappedTexture;
 }
 
+bool TextureVK::IsExternal() const {
+  return texture_info_->backing_type == TextureBackingTypeVK::kExternalTexture;
+}
+
 vk::ImageView TextureVK::GetImageView() const {
   switch (texture_info_->backing_type) {
     case TextureBackingTypeVK::kUnknownType:
@@ -94,6 +106,8 @@ vk::ImageView TextureVK::GetImageView() const {
       return vk::ImageView{texture_info_->allocated_texture.image_view};
     case TextureBackingTypeVK::kWrappedTexture:
       return texture_info_->wrapped_texture.swapchain_image->GetImageView();
+    case TextureBackingTypeVK::kExternalTexture:
+      return vk::ImageView{texture_info_->external_texture.image_view};
   }
 }
 
@@ -105,6 +119,8 @@ vk::Image TextureVK::GetImage() const {
       return vk::Image{texture_info_->allocated_texture.image};
     case TextureBackingTypeVK::kWrappedTexture:
       return texture_info_->wrapped_texture.swapchain_image->GetImage();
+    case TextureBackingTypeVK::kExternalTexture:
+      return vk::Image{texture_info_->external_texture.image};
   }
 }
 
@@ -118,6 +134,9 @@ vk::Buffer TextureVK::GetStagingBuffer() const {
     case TextureBackingTypeVK::kWrappedTexture:
       FML_CHECK(false) << "Wrapped textures do not have staging buffers";
       return nullptr;
+    case TextureBackingTypeVK::kExternalTexture:
+      FML_CHECK(false) << "External textures do not have staging buffers";
+      return nullptr;
   }
 }
 
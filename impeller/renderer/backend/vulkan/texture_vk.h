@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -18,6 +19,7 @@ enum class TextureBackingTypeVK {
   kUnknownType,
   kAllocatedTexture,
   kWrappedTexture,
+  kExternalTexture,
 };
 
 struct WrappedTextureInfoVK {
@@ -32,12 +34,24 @@ struct AllocatedTextureInfoVK {
   VkImageView image_view = VK_NULL_HANDLE;
 };
 
+/// An image whose memory is owned outside of Impeller, such as an imported
+/// AHardwareBuffer. Its contents are produced elsewhere, so it has no staging
+/// buffer.
+struct ExternalTextureInfoVK {
+  VkImage image = VK_NULL_HANDLE;
+  VkImageView image_view = VK_NULL_HANDLE;
+};
+
 struct TextureInfoVK {
   TextureBackingTypeVK backing_type;
   union {
     WrappedTextureInfoVK wrapped_texture;
     AllocatedTextureInfoVK allocated_texture;
+    ExternalTextureInfoVK external_texture;
   };
+  /// Releases the resources of an external texture, called once it is
+  /// destroyed.
+  fml::closure release_external_texture;
 };
 
 class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
@@ -51,6 +65,8 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
 
   bool IsWrapped() const;
 
+  bool IsExternal() const;
+
   vk::Image GetImage() const;
 
   vk::ImageView GetImageView() const;
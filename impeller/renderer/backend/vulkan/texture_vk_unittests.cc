@@ -0,0 +1,191 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/playground/playground_test.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+
+namespace impeller {
+namespace testing {
+
+class TextureVKTest : public PlaygroundTest {
+ public:
+  ContextVK& GetContextVK() const {
+    return ContextVK::Cast(*GetContext());
+  }
+};
+INSTANTIATE_VULKAN_PLAYGROUND_SUITE(TextureVKTest);
+
+namespace {
+
+// An image with memory of its own, standing in for an imported
+// AHardwareBuffer.
+struct ExternalImage {
+  vk::Device device;
+  vk::Image image;
+  vk::DeviceMemory memory;
+  vk::ImageView image_view;
+
+  void Destroy() {
+    device.destroyImageView(image_view);
+    device.destroyImage(image);
+    device.freeMemory(memory);
+  }
+};
+
+std::optional<ExternalImage> CreateExternalImage(const ContextVK& context,
+                                                 ISize size) {
+  ExternalImage external;
+  external.device = context.GetDevice();
+
+  vk::ImageCreateInfo image_info;
+  image_info.imageType = vk::ImageType::e2D;
+  image_info.format = vk::Format::eR8G8B8A8Unorm;
+  image_info.extent = vk::Extent3D{static_cast<uint32_t>(size.width),
+                                   static_cast<uint32_t>(size.height), 1u};
+  image_info.mipLevels = 1u;
+  image_info.arrayLayers = 1u;
+  image_info.samples = vk::SampleCountFlagBits::e1;
+  image_info.tiling = vk::ImageTiling::eOptimal;
+  image_info.usage = vk::ImageUsageFlagBits::eSampled;
+  image_info.initialLayout = vk::ImageLayout::eUndefined;
+  auto image = external.device.createImage(image_info);
+  if (image.result != vk::Result::eSuccess) {
+    return std::nullopt;
+  }
+  external.image = image.value;
+
+  auto requirements = external.device.getImageMemoryRequirements(image.value);
+  uint32_t memory_type_index = 0u;
+  while (memory_type_index < 32u &&
+         !(requirements.memoryTypeBits & (1u << memory_type_index))) {
+    memory_type_index++;
+  }
+  vk::MemoryAllocateInfo memory_info;
+  memory_info.allocationSize = requirements.size;
+  memory_info.memoryTypeIndex = memory_type_index;
+  auto memory = external.device.allocateMemory(memory_info);
+  if (memory.result != vk::Result::eSuccess) {
+    external.device.destroyImage(external.image);
+    return std::nullopt;
+  }
+  external.memory = memory.value;
+  if (external.device.bindImageMemory(external.image, external.memory, 0u) !=
+      vk::Result::eSuccess) {
+    external.device.freeMemory(external.memory);
+    external.device.destroyImage(external.image);
+    return std::nullopt;
+  }
+
+  vk::ImageViewCreateInfo view_info;
+  view_info.image = external.image;
+  view_info.viewType = vk::ImageViewType::e2D;
+  view_info.format = image_info.format;
+  view_info.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+  view_info.subresourceRange.levelCount = 1u;
+  view_info.subresourceRange.layerCount = 1u;
+  auto image_view = external.device.createImageView(view_info);
+  if (image_view.result != vk::Result::eSuccess) {
+    external.device.freeMemory(external.memory);
+    external.device.destroyImage(external.image);
+    return std::nullopt;
+  }
+  external.image_view = image_view.value;
+  return external;
+}
+
+std::shared_ptr<TextureVK> WrapExternalImage(ContextVK& context,
+                                             const ExternalImage& external,
+                                             ISize size,
+                                             fml::closure release) {
+  auto texture_info = std::make_unique<TextureInfoVK>(TextureInfoVK{
+      .backing_type = TextureBackingTypeVK::kExternalTexture,
+      .external_texture =
+          {
+              .image = static_cast<VkImage>(external.image),
+              .image_view = static_cast<VkImageView>(external.image_view),
+          },
+      .release_external_texture = std::move(release),
+  });
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = size;
+  desc.mip_count = 1u;
+  return std::make_shared<TextureVK>(desc, &context, std::move(texture_info));
+}
+
+}  // namespace
+
+TEST_P(TextureVKTest, ContextReportsVulkanBackend) {
+  ASSERT_EQ(GetContext()->GetBackendType(), Context::BackendType::kVulkan);
+#ifndef FML_OS_ANDROID
+  ASSERT_FALSE(GetContextVK().SupportsAndroidHardwareBuffers());
+#endif  // FML_OS_ANDROID
+}
+
+TEST_P(TextureVKTest, ExternalTexturesAreReleasedOnceWhenDestroyed) {
+  auto& context = GetContextVK();
+  constexpr ISize kSize = {16, 16};
+  auto external = CreateExternalImage(context, kSize);
+  ASSERT_TRUE(external.has_value());
+
+  size_t release_count = 0u;
+  auto texture = WrapExternalImage(context, *external, kSize,
+                                   [&release_count, external]() mutable {
+                                     release_count++;
+                                     external->Destroy();
+                                   });
+  ASSERT_TRUE(texture->IsValid());
+  ASSERT_TRUE(texture->IsExternal());
+  ASSERT_FALSE(texture->IsWrapped());
+  ASSERT_EQ(texture->GetImage(), external->image);
+  ASSERT_EQ(texture->GetImageView(), external->image_view);
+  ASSERT_EQ(release_count, 0u);
+
+  texture.reset();
+  ASSERT_EQ(release_count, 1u);
+}
+
+TEST_P(TextureVKTest, ExternalTexturesCannotBeWrittenTo) {
+  auto& context = GetContextVK();
+  constexpr ISize kSize = {16, 16};
+  auto external = CreateExternalImage(context, kSize);
+  ASSERT_TRUE(external.has_value());
+
+  auto texture =
+      WrapExternalImage(context, *external, kSize,
+                        [external]() mutable { external->Destroy(); });
+  // The contents are produced outside of Impeller. There is no staging
+  // buffer to write to.
+  std::vector<uint8_t> contents(
+      texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel(), 0xFFu);
+  ASSERT_FALSE(texture->SetContents(contents.data(), contents.size()));
+}
+
+TEST_P(TextureVKTest, ExternalTextureWithoutImageIsInvalid) {
+  auto& context = GetContextVK();
+  size_t release_count = 0u;
+  {
+    auto texture_info = std::make_unique<TextureInfoVK>(TextureInfoVK{
+        .backing_type = TextureBackingTypeVK::kExternalTexture,
+        .external_texture = {},
+        .release_external_texture = [&release_count]() { release_count++; },
+    });
+    TextureVK texture({}, &context, std::move(texture_info));
+    ASSERT_FALSE(texture.IsValid());
+    ASSERT_TRUE(texture.IsExternal());
+  }
+  // The release callback owns whatever was imported, even if the import
+  // didn't produce an image.
+  ASSERT_EQ(release_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
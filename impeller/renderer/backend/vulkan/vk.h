@@ -28,7 +28,7 @@ static_assert(VK_HEADER_VERSION >= 215,
 
 namespace impeller {
 
-const uint32_t kMaxFramesInFlight = 2;
+const uint32_t kMaxFramesInFlight = 3;
 
 struct QueueVK {
   size_t family = 0;
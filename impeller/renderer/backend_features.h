@@ -10,12 +10,30 @@ namespace impeller {
 /// selection.
 struct BackendFeatures {
   bool ssbo_support;
+  bool compute_shader_support;
+  /// Whether fragment shaders can read the current value of the color
+  /// attachment they write to, as with programmable blending on Apple GPUs
+  /// and `GL_EXT_shader_framebuffer_fetch`.
+  bool framebuffer_fetch_support;
+  /// Whether samplers can repeat and mirror textures whose sizes are not
+  /// powers of two, which GLES 2 only allows with `GL_OES_texture_npot`.
+  bool npot_address_mode_support;
 };
 
 /// @brief feature sets available on most but not all modern hardware.
-constexpr BackendFeatures kModernBackendFeatures = {.ssbo_support = true};
+constexpr BackendFeatures kModernBackendFeatures = {
+    .ssbo_support = true,
+    .compute_shader_support = true,
+    .framebuffer_fetch_support = false,
+    .npot_address_mode_support = true,
+};
 
 /// @brief Lowest common denominator feature sets.
-constexpr BackendFeatures kLegacyBackendFeatures = {.ssbo_support = false};
+constexpr BackendFeatures kLegacyBackendFeatures = {
+    .ssbo_support = false,
+    .compute_shader_support = false,
+    .framebuffer_fetch_support = false,
+    .npot_address_mode_support = false,
+};
 
 }  // namespace impeller
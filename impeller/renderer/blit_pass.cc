@@ -116,6 +116,46 @@ bool BlitPass::AddCopy(std::shared_ptr<Texture> source,
                                       std::move(label));
 }
 
+bool BlitPass::AddCopy(std::shared_ptr<DeviceBuffer> source,
+                       std::shared_ptr<Texture> destination,
+                       IRect destination_region,
+                       size_t source_offset,
+                       std::string label) {
+  if (!source) {
+    VALIDATION_LOG << "Attempted to add a buffer blit with no source.";
+    return false;
+  }
+  if (!destination) {
+    VALIDATION_LOG << "Attempted to add a buffer blit with no destination.";
+    return false;
+  }
+
+  if (destination_region.size.IsEmpty()) {
+    return true;  // Nothing to blit.
+  }
+
+  if (!IRect::MakeSize(destination->GetSize())
+           .Contains(destination_region)) {
+    VALIDATION_LOG
+        << "Attempted to add a buffer blit outside of the destination texture.";
+    return false;
+  }
+
+  auto bytes_per_pixel =
+      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  auto bytes_per_image = destination_region.size.Area() * bytes_per_pixel;
+  if (source_offset + bytes_per_image >
+      source->GetDeviceBufferDescriptor().size) {
+    VALIDATION_LOG
+        << "Attempted to add a buffer blit with out of bounds access.";
+    return false;
+  }
+
+  return OnCopyBufferToTextureCommand(std::move(source), std::move(destination),
+                                      destination_region, source_offset,
+                                      std::move(label));
+}
+
 bool BlitPass::GenerateMipmap(std::shared_ptr<Texture> texture,
                               std::string label) {
   if (!texture) {
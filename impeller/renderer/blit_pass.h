@@ -84,6 +84,31 @@ class BlitPass {
                size_t destination_offset = 0,
                std::string label = "");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record a command to copy the contents of the buffer to a
+  ///             region of the texture. The rest of the texture is preserved.
+  ///             No work is encoded into the command buffer at this time.
+  ///
+  /// @param[in]  source              The buffer containing tightly packed
+  ///                                 rows of pixels in the format of the
+  ///                                 destination texture.
+  /// @param[in]  destination         The texture to overwrite using the source
+  ///                                 contents.
+  /// @param[in]  destination_region  The region of the destination texture to
+  ///                                 write to.
+  /// @param[in]  source_offset       The offset to start reading from in the
+  ///                                 source buffer.
+  /// @param[in]  label               The optional debug label to give the
+  ///                                 command.
+  ///
+  /// @return     If the command was valid for subsequent commitment.
+  ///
+  bool AddCopy(std::shared_ptr<DeviceBuffer> source,
+               std::shared_ptr<Texture> destination,
+               IRect destination_region,
+               size_t source_offset = 0,
+               std::string label = "");
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command to generate all mip levels for a texture.
   ///             No work is encoded into the command buffer at this time.
@@ -127,6 +152,13 @@ class BlitPass {
       size_t destination_offset,
       std::string label) = 0;
 
+  virtual bool OnCopyBufferToTextureCommand(
+      std::shared_ptr<DeviceBuffer> source,
+      std::shared_ptr<Texture> destination,
+      IRect destination_region,
+      size_t source_offset,
+      std::string label) = 0;
+
   virtual bool OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
                                        std::string label) = 0;
 
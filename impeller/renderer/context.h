@@ -23,8 +23,21 @@ class WorkQueue;
 
 class Context : public std::enable_shared_from_this<Context> {
  public:
+  enum class BackendType {
+    kMetal,
+    kOpenGLES,
+    kVulkan,
+  };
+
   virtual ~Context();
 
+  //----------------------------------------------------------------------------
+  /// @return     The graphics API the context is backed by. Callers can use
+  ///             this to safely downcast the context to the backend specific
+  ///             type.
+  ///
+  virtual BackendType GetBackendType() const = 0;
+
   virtual bool IsValid() const = 0;
 
   //----------------------------------------------------------------------------
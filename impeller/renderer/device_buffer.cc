@@ -8,7 +8,18 @@ namespace impeller {
 
 DeviceBuffer::DeviceBuffer(DeviceBufferDescriptor desc) : desc_(desc) {}
 
-DeviceBuffer::~DeviceBuffer() = default;
+DeviceBuffer::~DeviceBuffer() {
+  if (memory_tracker_) {
+    memory_tracker_->RecordDeallocation(desc_.category, desc_.size);
+  }
+}
+
+void DeviceBuffer::TrackDeviceMemory(
+    std::shared_ptr<DeviceMemoryTracker> tracker) {
+  FML_DCHECK(!memory_tracker_);
+  tracker->RecordAllocation(desc_.category, desc_.size);
+  memory_tracker_ = std::move(tracker);
+}
 
 // |Buffer|
 std::shared_ptr<const DeviceBuffer> DeviceBuffer::GetDeviceBuffer(
@@ -12,6 +12,7 @@
 #include "impeller/renderer/buffer.h"
 #include "impeller/renderer/buffer_view.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
+#include "impeller/renderer/device_memory_tracker.h"
 #include "impeller/renderer/range.h"
 #include "impeller/renderer/texture.h"
 
@@ -55,6 +56,12 @@ class DeviceBuffer : public Buffer,
                                 size_t offset) = 0;
 
  private:
+  friend class Allocator;
+
+  std::shared_ptr<DeviceMemoryTracker> memory_tracker_;
+
+  void TrackDeviceMemory(std::shared_ptr<DeviceMemoryTracker> tracker);
+
   FML_DISALLOW_COPY_AND_ASSIGN(DeviceBuffer);
 };
 
@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/device_memory_tracker.h"
+
+namespace impeller {
+
+size_t DeviceMemoryStatistics::GetTotalBytes() const {
+  size_t bytes = 0u;
+  for (const auto& usage : categories) {
+    bytes += usage.bytes;
+  }
+  return bytes;
+}
+
+DeviceMemoryTracker::DeviceMemoryTracker() = default;
+
+DeviceMemoryTracker::~DeviceMemoryTracker() = default;
+
+void DeviceMemoryTracker::RecordAllocation(AllocationCategory category,
+                                           size_t bytes) {
+  auto& counters = counters_[static_cast<size_t>(category)];
+  counters.count.fetch_add(1u, std::memory_order_relaxed);
+  counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void DeviceMemoryTracker::RecordDeallocation(AllocationCategory category,
+                                             size_t bytes) {
+  auto& counters = counters_[static_cast<size_t>(category)];
+  counters.count.fetch_sub(1u, std::memory_order_relaxed);
+  counters.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+DeviceMemoryStatistics DeviceMemoryTracker::GetStatistics() const {
+  DeviceMemoryStatistics statistics;
+  for (size_t i = 0; i < kAllocationCategoryCount; i++) {
+    statistics.categories[i] = {
+        .count = counters_[i].count.load(std::memory_order_relaxed),
+        .bytes = counters_[i].bytes.load(std::memory_order_relaxed),
+    };
+  }
+  return statistics;
+}
+
+}  // namespace impeller
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/formats.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The buffers and textures of an allocator that are alive, by
+///             category.
+///
+struct DeviceMemoryStatistics {
+  struct Usage {
+    size_t count = 0u;
+    size_t bytes = 0u;
+  };
+
+  std::array<Usage, kAllocationCategoryCount> categories = {};
+
+  const Usage& Get(AllocationCategory category) const {
+    return categories[static_cast<size_t>(category)];
+  }
+
+  size_t GetTotalBytes() const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the live device memory of an allocator. Buffers and
+///             textures hold on to the tracker of the allocator that created
+///             them and remove themselves when they are collected, which may
+///             happen on any thread.
+///
+class DeviceMemoryTracker {
+ public:
+  DeviceMemoryTracker();
+
+  ~DeviceMemoryTracker();
+
+  void RecordAllocation(AllocationCategory category, size_t bytes);
+
+  void RecordDeallocation(AllocationCategory category, size_t bytes);
+
+  DeviceMemoryStatistics GetStatistics() const;
+
+ private:
+  struct Counters {
+    std::atomic_size_t count = 0u;
+    std::atomic_size_t bytes = 0u;
+  };
+
+  std::array<Counters, kAllocationCategoryCount> counters_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DeviceMemoryTracker);
+};
+
+}  // namespace impeller
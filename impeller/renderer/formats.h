@@ -51,6 +51,41 @@ enum class StorageMode {
   kDeviceTransient,
 };
 
+//------------------------------------------------------------------------------
+/// @brief      What the memory of a buffer or texture is used for, to account
+///             for the device memory in use.
+///
+enum class AllocationCategory {
+  kOther,
+  //----------------------------------------------------------------------------
+  /// Textures that are rendered to. Textures with the render target usage are
+  /// accounted as such unless they specify another category.
+  ///
+  kRenderTarget,
+  kImage,
+  kGlyphAtlas,
+  kHostBuffer,
+};
+
+constexpr size_t kAllocationCategoryCount =
+    static_cast<size_t>(AllocationCategory::kHostBuffer) + 1u;
+
+constexpr const char* AllocationCategoryToString(AllocationCategory category) {
+  switch (category) {
+    case AllocationCategory::kOther:
+      return "Other";
+    case AllocationCategory::kRenderTarget:
+      return "RenderTarget";
+    case AllocationCategory::kImage:
+      return "Image";
+    case AllocationCategory::kGlyphAtlas:
+      return "GlyphAtlas";
+    case AllocationCategory::kHostBuffer:
+      return "HostBuffer";
+  }
+  FML_UNREACHABLE();
+}
+
 //------------------------------------------------------------------------------
 /// @brief      The Pixel formats supported by Impeller. The naming convention
 ///             denotes the usage of the component, the bit width of that
@@ -91,6 +126,11 @@ enum class PixelFormat {
   kR16G16B16A16Float,
   kB10G10R10XR,
   kB10G10R10XRSRGB,
+  // Block compressed formats. Pixels are stored in blocks of 4x4 that take 16
+  // bytes each. Devices may not support them.
+  // @see `Allocator::SupportsCompressedPixelFormat`.
+  kASTC4x4UNorm,
+  kETC2R8G8B8A8UNorm,
   // Depth and stencil formats.
   kS8UInt,
   kD32FloatS8UInt,
@@ -276,9 +316,29 @@ enum class ColorWriteMask : uint64_t {
   kAll = kRed | kGreen | kBlue | kAlpha,
 };
 
+/// The width and height in pixels of the blocks of compressed pixel formats.
+constexpr int64_t kCompressedBlockDimension = 4;
+
+constexpr bool IsCompressedPixelFormat(PixelFormat format) {
+  return format == PixelFormat::kASTC4x4UNorm ||
+         format == PixelFormat::kETC2R8G8B8A8UNorm;
+}
+
+/// The size of a block of `kCompressedBlockDimension` by
+/// `kCompressedBlockDimension` pixels of a compressed pixel format, and 0 for
+/// other formats.
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  return IsCompressedPixelFormat(format) ? 16u : 0u;
+}
+
+/// The size of a pixel of the format, and 0 for compressed pixel formats whose
+/// pixels have no size of their own.
+/// @see `BytesPerBlockForPixelFormat`.
 constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
+    case PixelFormat::kASTC4x4UNorm:
+    case PixelFormat::kETC2R8G8B8A8UNorm:
       return 0u;
     case PixelFormat::kA8UNormInt:
     case PixelFormat::kR8UNormInt:
@@ -18,4 +18,8 @@ bool GPUTracer::StopCapturingFrame() {
   return false;
 }
 
+std::optional<GPUMemoryStatistics> GPUTracer::GetMemoryStatistics() const {
+  return std::nullopt;
+}
+
 }  // namespace impeller
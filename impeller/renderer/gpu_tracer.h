@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstddef>
+#include <optional>
+
 #include "flutter/fml/macros.h"
 
 namespace impeller {
@@ -18,6 +21,24 @@ struct GPUTracerConfiguration {
   bool mtl_frame_capture_save_trace_as_document = false;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      A snapshot of the device memory used by a context.
+///
+struct GPUMemoryStatistics {
+  /// The number of live allocations sub-allocated from the pool backing small
+  /// transient buffers.
+  size_t pooled_allocation_count = 0u;
+  /// The bytes of those allocations.
+  size_t pooled_allocation_bytes = 0u;
+  /// The bytes of device memory reserved by the pool.
+  size_t pooled_block_bytes = 0u;
+  /// The bytes of device memory used by the context across all heaps.
+  size_t device_memory_usage_bytes = 0u;
+  /// The bytes of device memory the context can use across all heaps before
+  /// allocations may start failing or affecting system stability.
+  size_t device_memory_budget_bytes = 0u;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A GPU tracer to trace gpu workflow during rendering.
 ///
@@ -43,6 +64,14 @@ class GPUTracer {
   ///
   virtual bool StopCapturingFrame();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a snapshot of the device memory used by the context.
+  ///
+  /// @return     The statistics or std::nullopt if the backend does not
+  ///             track them.
+  ///
+  virtual std::optional<GPUMemoryStatistics> GetMemoryStatistics() const;
+
  protected:
   GPUTracer();
 
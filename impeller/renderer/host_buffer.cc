@@ -16,10 +16,16 @@
 namespace impeller {
 
 std::shared_ptr<HostBuffer> HostBuffer::Create() {
-  return std::shared_ptr<HostBuffer>(new HostBuffer());
+  return std::shared_ptr<HostBuffer>(new HostBuffer(nullptr));
 }
 
-HostBuffer::HostBuffer() = default;
+std::shared_ptr<HostBuffer> HostBuffer::Create(
+    std::shared_ptr<Allocator> allocator) {
+  return std::shared_ptr<HostBuffer>(new HostBuffer(std::move(allocator)));
+}
+
+HostBuffer::HostBuffer(std::shared_ptr<Allocator> allocator)
+    : allocator_(std::move(allocator)), frames_(1u) {}
 
 HostBuffer::~HostBuffer() = default;
 
@@ -27,9 +33,17 @@ void HostBuffer::SetLabel(std::string label) {
   label_ = std::move(label);
 }
 
+bool HostBuffer::IsDeviceBacked() const {
+  return allocator_ != nullptr;
+}
+
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  if (IsDeviceBacked()) {
+    return EmplaceDevice(buffer, length, align);
+  }
+
   if (align == 0 || (GetLength() % align) == 0) {
     return Emplace(buffer, length);
   }
@@ -45,6 +59,7 @@ BufferView HostBuffer::Emplace(const void* buffer,
 }
 
 BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
+  Lock lock(device_blocks_mutex_);
   auto old_length = GetLength();
   if (!Truncate(old_length + length)) {
     return {};
@@ -56,8 +71,130 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
   return BufferView{shared_from_this(), GetBuffer(), Range{old_length, length}};
 }
 
+BufferView HostBuffer::EmplaceDevice(const void* buffer,
+                                     size_t length,
+                                     size_t align) {
+  Lock lock(device_blocks_mutex_);
+  auto& blocks = frames_[frame_index_].blocks;
+
+  // Find the first block of this frame with enough room left.
+  DeviceBlock* block = nullptr;
+  size_t aligned_offset = 0u;
+  for (auto& candidate : blocks) {
+    aligned_offset = candidate.offset;
+    if (align > 0 && (aligned_offset % align) != 0) {
+      aligned_offset += align - (aligned_offset % align);
+    }
+    if (aligned_offset + length <= candidate.size) {
+      block = &candidate;
+      break;
+    }
+  }
+
+  if (block == nullptr) {
+    DeviceBufferDescriptor desc;
+    desc.storage_mode = StorageMode::kHostVisible;
+    desc.size = std::max(length, kDeviceBlockSize);
+    desc.category = AllocationCategory::kHostBuffer;
+    auto device_buffer = allocator_->CreateBuffer(desc);
+    if (!device_buffer) {
+      return {};
+    }
+    if (!label_.empty()) {
+      device_buffer->SetLabel(label_);
+    }
+    blocks.push_back(DeviceBlock{
+        .buffer = std::move(device_buffer),
+        .size = desc.size,
+        .offset = 0u,
+    });
+    block = &blocks.back();
+    aligned_offset = 0u;
+  }
+
+  if (buffer && !block->buffer->CopyHostBuffer(
+                    reinterpret_cast<const uint8_t*>(buffer),
+                    Range{0u, length}, aligned_offset)) {
+    return {};
+  }
+  block->offset = aligned_offset + length;
+
+  auto view = block->buffer->AsBufferView();
+  view.range = Range{aligned_offset, length};
+  return view;
+}
+
+uint64_t HostBuffer::Reset() {
+  Lock lock(device_blocks_mutex_);
+  generation_ = 1u;
+  device_buffer_generation_ = 0u;
+  device_buffer_ = nullptr;
+  if (GetLength() > 0u) {
+    FML_CHECK(Truncate(0u));
+  }
+
+  if (!IsDeviceBacked()) {
+    return 0u;
+  }
+
+  const auto frame_id = ++last_frame_id_;
+  frames_[frame_index_].pending_frame_id = frame_id;
+
+  // Continue in the blocks of a frame that the GPU is done with, or in a new
+  // set of blocks if all of them are still in flight.
+  auto free_frame =
+      std::find_if(frames_.begin(), frames_.end(), [](const auto& frame) {
+        return frame.pending_frame_id == 0u;
+      });
+  if (free_frame == frames_.end()) {
+    frame_index_ = frames_.size();
+    frames_.emplace_back();
+    return frame_id;
+  }
+  frame_index_ = std::distance(frames_.begin(), free_frame);
+  auto& blocks = free_frame->blocks;
+  // Dedicated blocks for oversized emplacements are not worth keeping around.
+  blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                              [](const DeviceBlock& block) {
+                                return block.size > kDeviceBlockSize;
+                              }),
+               blocks.end());
+  for (auto& block : blocks) {
+    block.offset = 0u;
+  }
+  return frame_id;
+}
+
+void HostBuffer::MarkFrameCompleted(uint64_t frame_id) {
+  if (frame_id == 0u) {
+    return;
+  }
+  Lock lock(device_blocks_mutex_);
+  for (auto& frame : frames_) {
+    if (frame.pending_frame_id == frame_id) {
+      frame.pending_frame_id = 0u;
+      return;
+    }
+  }
+}
+
+size_t HostBuffer::GetDeviceBlockCount() const {
+  Lock lock(device_blocks_mutex_);
+  size_t count = 0u;
+  for (const auto& frame : frames_) {
+    count += frame.blocks.size();
+  }
+  return count;
+}
+
+size_t HostBuffer::GetFrameCount() const {
+  Lock lock(device_blocks_mutex_);
+  return frames_.size();
+}
+
 std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
     Allocator& allocator) const {
+  Lock lock(device_blocks_mutex_);
   if (generation_ == device_buffer_generation_) {
     return device_buffer_;
   }
@@ -8,21 +8,47 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/allocation.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/buffer.h"
 #include "impeller/renderer/buffer_view.h"
 #include "impeller/renderer/platform.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      A buffer used to stage transient data (uniforms, vertices,
+///             storage buffers) for a frame.
+///
+///             Host buffers created without an allocator accumulate data in
+///             host memory and copy it into a freshly allocated device buffer
+///             when they are first bound.
+///
+///             Host buffers created with an allocator instead write directly
+///             into a ring of persistently mapped, host visible device buffer
+///             blocks. Each call to `Reset` retires the blocks written since
+///             the previous one. They are only recycled once the caller
+///             reports that the GPU work reading them has completed, so the
+///             ring grows to the number of frames actually in flight.
+///             Emplacing data is then a bump pointer write into GPU visible
+///             memory.
+///
 class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                          public Allocation,
                          public Buffer {
  public:
+  /// The size of each device buffer block. Emplacements larger than this get
+  /// a dedicated block of their own.
+  static constexpr size_t kDeviceBlockSize = 1024u * 1024u;
+
   static std::shared_ptr<HostBuffer> Create();
 
+  static std::shared_ptr<HostBuffer> Create(
+      std::shared_ptr<Allocator> allocator);
+
   // |Buffer|
   virtual ~HostBuffer();
 
@@ -95,11 +121,74 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                                    size_t length,
                                    size_t align);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether emplaced data is written directly into device buffer
+  ///             blocks.
+  ///
+  bool IsDeviceBacked() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discard all emplaced data and prepare the buffer for the next
+  ///             frame.
+  ///
+  ///             Buffer views handed out before the reset must not be used
+  ///             after it. For device backed buffers, the blocks written
+  ///             since the previous reset stay reserved until
+  ///             `MarkFrameCompleted` is called with the returned id. The
+  ///             next frame writes into the blocks of a completed frame, or
+  ///             into new blocks if every frame is still in flight.
+  ///
+  /// @return     The id of the retired frame. Always zero for host-only
+  ///             buffers, which need no completion.
+  ///
+  uint64_t Reset();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allow the blocks of a frame retired by `Reset` to be reused.
+  ///             Call this once the GPU has finished all the work that reads
+  ///             the data of the frame. It may be called on any thread.
+  ///
+  /// @param[in]  frame_id  The id returned by `Reset`.
+  ///
+  void MarkFrameCompleted(uint64_t frame_id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of device buffer blocks allocated across all
+  ///             frames in flight. Always zero for host-only buffers.
+  ///
+  size_t GetDeviceBlockCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of sets of device buffer blocks, one per frame
+  ///             that was in flight at the same time. Always one for
+  ///             host-only buffers.
+  ///
+  size_t GetFrameCount() const;
+
  private:
-  mutable std::shared_ptr<DeviceBuffer> device_buffer_;
-  mutable size_t device_buffer_generation_ = 0u;
-  size_t generation_ = 1u;
+  struct DeviceBlock {
+    std::shared_ptr<DeviceBuffer> buffer;
+    size_t size = 0u;
+    size_t offset = 0u;
+  };
+  struct FrameBlocks {
+    std::vector<DeviceBlock> blocks;
+    // The id that the frame was retired with while its GPU work is pending,
+    // zero once the blocks may be reused.
+    uint64_t pending_frame_id = 0u;
+  };
+
+  const std::shared_ptr<Allocator> allocator_;
   std::string label_;
+  mutable Mutex device_blocks_mutex_;
+  mutable std::shared_ptr<DeviceBuffer> device_buffer_
+      IPLR_GUARDED_BY(device_blocks_mutex_);
+  mutable size_t device_buffer_generation_
+      IPLR_GUARDED_BY(device_blocks_mutex_) = 0u;
+  size_t generation_ IPLR_GUARDED_BY(device_blocks_mutex_) = 1u;
+  std::vector<FrameBlocks> frames_ IPLR_GUARDED_BY(device_blocks_mutex_);
+  size_t frame_index_ IPLR_GUARDED_BY(device_blocks_mutex_) = 0u;
+  uint64_t last_frame_id_ IPLR_GUARDED_BY(device_blocks_mutex_) = 0u;
 
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
@@ -107,7 +196,11 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
-  HostBuffer();
+  [[nodiscard]] BufferView EmplaceDevice(const void* buffer,
+                                         size_t length,
+                                         size_t align);
+
+  explicit HostBuffer(std::shared_ptr<Allocator> allocator);
 
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
 };
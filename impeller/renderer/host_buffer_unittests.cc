@@ -2,12 +2,21 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/allocation_counter.h"
 #include "flutter/testing/testing.h"
+#include "impeller/playground/playground.h"
+#include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/host_buffer.h"
 
 namespace impeller {
 namespace testing {
 
+using HostBufferPlaygroundTest = Playground;
+INSTANTIATE_PLAYGROUND_SUITE(HostBufferPlaygroundTest);
+
 TEST(HostBufferTest, TestInitialization) {
   ASSERT_TRUE(HostBuffer::Create());
   // Newly allocated buffers don't touch the heap till they have to.
@@ -75,5 +84,131 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST_P(HostBufferPlaygroundTest, DeviceBackedBufferWritesIntoDeviceBlocks) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  ASSERT_TRUE(buffer->IsDeviceBacked());
+  ASSERT_EQ(buffer->GetDeviceBlockCount(), 0u);
+
+  struct alignas(16) Align16 {
+    uint8_t pad[2];
+  };
+
+  auto view_a = buffer->Emplace(Align16{});
+  auto view_b = buffer->Emplace(Align16{});
+  ASSERT_TRUE(view_a);
+  ASSERT_TRUE(view_b);
+  // Nothing is staged in host memory.
+  ASSERT_EQ(buffer->GetLength(), 0u);
+  ASSERT_EQ(buffer->GetDeviceBlockCount(), 1u);
+  // Both views share the same device buffer block.
+  ASSERT_EQ(view_a.buffer, view_b.buffer);
+  ASSERT_EQ(view_a.range, Range(0u, 16u));
+  ASSERT_EQ(view_b.range, Range(16u, 16u));
+}
+
+TEST_P(HostBufferPlaygroundTest, DeviceBackedBufferRecyclesCompletedFrames) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  auto first_view = buffer->Emplace(uint32_t{42});
+  ASSERT_TRUE(first_view);
+  auto first_frame_id = buffer->Reset();
+  ASSERT_NE(first_frame_id, 0u);
+
+  // The first frame is still in flight, so its block is not reused.
+  auto second_view = buffer->Emplace(uint32_t{42});
+  ASSERT_TRUE(second_view);
+  ASSERT_NE(second_view.buffer, first_view.buffer);
+  auto second_frame_id = buffer->Reset();
+  ASSERT_NE(second_frame_id, first_frame_id);
+  ASSERT_EQ(buffer->GetFrameCount(), 3u);
+  ASSERT_EQ(buffer->GetDeviceBlockCount(), 2u);
+
+  // Once the GPU is done with the first frame, its block is reused.
+  buffer->MarkFrameCompleted(first_frame_id);
+  ASSERT_EQ(buffer->Reset(), second_frame_id + 1);
+  auto third_view = buffer->Emplace(uint32_t{42});
+  ASSERT_EQ(third_view.buffer, first_view.buffer);
+  ASSERT_EQ(third_view.range.offset, 0u);
+  ASSERT_EQ(buffer->GetFrameCount(), 3u);
+  ASSERT_EQ(buffer->GetDeviceBlockCount(), 2u);
+}
+
+TEST_P(HostBufferPlaygroundTest, ResetsWithinAFrameDoNotRecycleInFlightData) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  // Several renders per frame, none of which has completed yet, never write
+  // over each other's data however many there are.
+  std::vector<std::shared_ptr<const Buffer>> blocks;
+  for (size_t render = 0; render < 8u; render++) {
+    auto view = buffer->Emplace(uint32_t{42});
+    ASSERT_TRUE(view);
+    for (const auto& block : blocks) {
+      ASSERT_NE(view.buffer, block);
+    }
+    blocks.push_back(view.buffer);
+    buffer->Reset();
+  }
+  ASSERT_EQ(buffer->GetDeviceBlockCount(), 8u);
+}
+
+TEST_P(HostBufferPlaygroundTest, FramesCanBeCompletedOnAnotherThread) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  std::vector<uint64_t> frame_ids;
+  for (size_t frame = 0; frame < 4u; frame++) {
+    ASSERT_TRUE(buffer->Emplace(uint32_t{42}));
+    frame_ids.push_back(buffer->Reset());
+  }
+  std::thread completion_thread([&buffer, &frame_ids]() {
+    for (auto frame_id : frame_ids) {
+      buffer->MarkFrameCompleted(frame_id);
+    }
+  });
+  for (size_t i = 0; i < 64u; i++) {
+    ASSERT_TRUE(buffer->Emplace(uint32_t{42}));
+  }
+  completion_thread.join();
+
+  // All the earlier frames are free now, so no new frame is added.
+  auto frame_count = buffer->GetFrameCount();
+  buffer->Reset();
+  ASSERT_EQ(buffer->GetFrameCount(), frame_count);
+}
+
+TEST_P(HostBufferPlaygroundTest, RecycledDeviceBlocksAreFilledWithoutAllocs) {
+  if (!fml::AllocationCounter::IsEnabled()) {
+    GTEST_SKIP_("Allocations are not being counted.");
+  }
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  for (size_t frame = 0; frame < 2u; frame++) {
+    ASSERT_TRUE(buffer->Emplace(uint32_t{42}));
+    buffer->MarkFrameCompleted(buffer->Reset());
+  }
+
+  fml::ScopedAllocationCount allocations;
+  for (size_t frame = 0; frame < 4u; frame++) {
+    for (uint32_t i = 0; i < 64u; i++) {
+      ASSERT_TRUE(buffer->Emplace(i));
+    }
+    buffer->MarkFrameCompleted(buffer->Reset());
+  }
+  ASSERT_EQ(allocations.Get().allocations, 0u);
+}
+
+TEST_P(HostBufferPlaygroundTest, DeviceBackedBufferHandlesLargeEmplacements) {
+  auto buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+
+  std::vector<uint8_t> large(HostBuffer::kDeviceBlockSize * 2, 0xff);
+  auto view = buffer->Emplace(large.data(), large.size(), 16u);
+  ASSERT_TRUE(view);
+  ASSERT_EQ(view.range, Range(0u, large.size()));
+
+  // Dedicated blocks are dropped when their frame is reused.
+  buffer->MarkFrameCompleted(buffer->Reset());
+  buffer->MarkFrameCompleted(buffer->Reset());
+  buffer->Reset();
+  ASSERT_EQ(buffer->GetDeviceBlockCount(), 0u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -114,6 +114,14 @@ class RenderPipelineT {
     return pipeline_;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The future of the pipeline, for callers that need to wait
+  ///             for it without holding the lock guarding this object.
+  ///
+  const PipelineFuture<PipelineDescriptor>& GetPipelineFuture() const {
+    return pipeline_future_;
+  }
+
   std::optional<PipelineDescriptor> GetDescriptor() const {
     return pipeline_future_.descriptor;
   }
@@ -41,6 +41,9 @@ std::size_t PipelineDescriptor::GetHash() const {
   fml::HashCombineSeed(seed, winding_order_);
   fml::HashCombineSeed(seed, cull_mode_);
   fml::HashCombineSeed(seed, primitive_type_);
+  for (const auto& constant : specialization_constants_) {
+    fml::HashCombineSeed(seed, constant.GetHash());
+  }
   return seed;
 }
 
@@ -59,7 +62,8 @@ bool PipelineDescriptor::IsEqual(const PipelineDescriptor& other) const {
              other.back_stencil_attachment_descriptor_ &&
          winding_order_ == other.winding_order_ &&
          cull_mode_ == other.cull_mode_ &&
-         primitive_type_ == other.primitive_type_;
+         primitive_type_ == other.primitive_type_ &&
+         specialization_constants_ == other.specialization_constants_;
 }
 
 PipelineDescriptor& PipelineDescriptor::SetLabel(std::string label) {
@@ -259,4 +263,15 @@ PrimitiveType PipelineDescriptor::GetPrimitiveType() const {
   return primitive_type_;
 }
 
+PipelineDescriptor& PipelineDescriptor::SetSpecializationConstants(
+    std::vector<ShaderSpecializationConstant> constants) {
+  specialization_constants_ = std::move(constants);
+  return *this;
+}
+
+const std::vector<ShaderSpecializationConstant>&
+PipelineDescriptor::GetSpecializationConstants() const {
+  return specialization_constants_;
+}
+
 }  // namespace impeller
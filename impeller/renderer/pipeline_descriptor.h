@@ -12,6 +12,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
@@ -125,6 +126,12 @@ class PipelineDescriptor final : public Comparable<PipelineDescriptor> {
 
   PrimitiveType GetPrimitiveType() const;
 
+  PipelineDescriptor& SetSpecializationConstants(
+      std::vector<ShaderSpecializationConstant> constants);
+
+  const std::vector<ShaderSpecializationConstant>& GetSpecializationConstants()
+      const;
+
  private:
   std::string label_;
   SampleCount sample_count_ = SampleCount::kCount1;
@@ -142,6 +149,7 @@ class PipelineDescriptor final : public Comparable<PipelineDescriptor> {
   std::optional<StencilAttachmentDescriptor>
       back_stencil_attachment_descriptor_;
   PrimitiveType primitive_type_ = PrimitiveType::kTriangle;
+  std::vector<ShaderSpecializationConstant> specialization_constants_;
 };
 
 }  // namespace impeller
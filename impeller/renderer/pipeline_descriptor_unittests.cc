@@ -23,5 +23,23 @@ TEST(PipelineDescriptorTest, PrimitiveTypeHashEquality) {
   ASSERT_NE(descA.GetHash(), descB.GetHash());
 }
 
+TEST(PipelineDescriptorTest, SpecializationConstantsHashEquality) {
+  constexpr auto kSlot =
+      ShaderSpecializationConstantSlot{"decal", 0u, ShaderType::kBoolean};
+  PipelineDescriptor descA;
+  PipelineDescriptor descB;
+  descA.SetSpecializationConstants({ShaderSpecializationConstant(kSlot, true)});
+  descB.SetSpecializationConstants(
+      {ShaderSpecializationConstant(kSlot, false)});
+
+  ASSERT_FALSE(descA.IsEqual(descB));
+  ASSERT_NE(descA.GetHash(), descB.GetHash());
+
+  descB.SetSpecializationConstants({ShaderSpecializationConstant(kSlot, true)});
+
+  ASSERT_TRUE(descA.IsEqual(descB));
+  ASSERT_EQ(descA.GetHash(), descB.GetHash());
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -26,11 +26,22 @@ HostBuffer& RenderPass::GetTransientsBuffer() {
   return *transients_buffer_;
 }
 
+void RenderPass::SetTransientsBuffer(std::shared_ptr<HostBuffer> buffer) {
+  if (!buffer) {
+    return;
+  }
+  transients_buffer_ = std::move(buffer);
+}
+
 void RenderPass::SetLabel(std::string label) {
   if (label.empty()) {
     return;
   }
-  transients_buffer_->SetLabel(SPrintF("%s Transients", label.c_str()));
+  // Shared transients buffers outlive this pass and are labeled by their
+  // owner.
+  if (!transients_buffer_->IsDeviceBacked()) {
+    transients_buffer_->SetLabel(SPrintF("%s Transients", label.c_str()));
+  }
   OnSetLabel(std::move(label));
 }
 
@@ -49,6 +60,17 @@ bool RenderPass::AddCommand(Command command) {
     }
   }
 
+  if (scissor_.has_value()) {
+    auto scissor = command.scissor.has_value()
+                       ? command.scissor->Intersection(scissor_.value())
+                       : scissor_;
+    if (!scissor.has_value() || scissor->IsEmpty()) {
+      // Nothing of the command would be drawn.
+      return true;
+    }
+    command.scissor = scissor;
+  }
+
   if (command.index_count == 0u) {
     // Essentially a no-op. Don't record the command but this is not necessary
     // an error either.
@@ -65,6 +87,18 @@ bool RenderPass::AddCommand(Command command) {
   return true;
 }
 
+void RenderPass::SetScissor(std::optional<IRect> scissor) {
+  if (scissor.has_value()) {
+    auto target_rect = IRect::MakeSize(render_target_.GetRenderTargetSize());
+    scissor = scissor->Intersection(target_rect).value_or(IRect{});
+  }
+  scissor_ = scissor;
+}
+
+const std::optional<IRect>& RenderPass::GetScissor() const {
+  return scissor_;
+}
+
 bool RenderPass::EncodeCommands() const {
   auto context = context_.lock();
   // The context could have been collected in the meantime.
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "impeller/renderer/command.h"
@@ -37,6 +38,15 @@ class RenderPass {
 
   HostBuffer& GetTransientsBuffer();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Replace the per-pass transients buffer with one shared across
+  ///             passes, typically a device backed buffer that is reset once
+  ///             per frame by its owner.
+  ///
+  /// @param[in]  buffer  The transients buffer to use for this pass.
+  ///
+  void SetTransientsBuffer(std::shared_ptr<HostBuffer> buffer);
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command for subsequent encoding to the underlying
   ///             command buffer. No work is encoded into the command buffer at
@@ -48,6 +58,23 @@ class RenderPass {
   ///
   bool AddCommand(Command command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Clip the commands added to this pass from now on to a
+  ///             scissor, in addition to their own. Commands that lie
+  ///             entirely outside of it are dropped.
+  ///
+  /// @param[in]  scissor  The scissor, or std::nullopt to stop clipping the
+  ///                      commands. It is clamped to the render target.
+  ///
+  void SetScissor(std::optional<IRect> scissor);
+
+  const std::optional<IRect>& GetScissor() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The commands recorded so far, in the order they were added.
+  ///
+  const std::vector<Command>& GetCommands() const { return commands_; }
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -61,6 +88,7 @@ class RenderPass {
   const RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
   std::vector<Command> commands_;
+  std::optional<IRect> scissor_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
 
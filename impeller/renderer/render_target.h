@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +18,38 @@ namespace impeller {
 
 class Context;
 
+//------------------------------------------------------------------------------
+/// @brief      Allocates the textures backing render target attachments.
+///
+///             The default implementation forwards every request to the
+///             resource allocator. Subclasses may recycle textures across
+///             frames; `Start` and `End` bracket each frame so that they know
+///             when previously handed out textures can be reused or released.
+///
+class RenderTargetAllocator {
+ public:
+  explicit RenderTargetAllocator(std::shared_ptr<Allocator> allocator);
+
+  virtual ~RenderTargetAllocator();
+
+  virtual std::shared_ptr<Texture> CreateTexture(const TextureDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the beginning of a frame workload.
+  ///
+  virtual void Start();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the end of a frame workload.
+  ///
+  virtual void End();
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetAllocator);
+};
+
 class RenderTarget {
  public:
   struct AttachmentConfig {
@@ -50,8 +83,25 @@ class RenderTarget {
       AttachmentConfig color_attachment_config = kDefaultAttachmentConfig,
       std::optional<AttachmentConfig> stencil_attachment_config = std::nullopt);
 
+  static RenderTarget CreateOffscreen(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen",
+      AttachmentConfig color_attachment_config = kDefaultAttachmentConfig,
+      std::optional<AttachmentConfig> stencil_attachment_config = std::nullopt);
+
+  static RenderTarget CreateOffscreenMSAA(
+      const Context& context,
+      ISize size,
+      const std::string& label = "Offscreen MSAA",
+      AttachmentConfigMSAA color_attachment_config =
+          kDefaultAttachmentConfigMSAA,
+      std::optional<AttachmentConfig> stencil_attachment_config = std::nullopt);
+
   static RenderTarget CreateOffscreenMSAA(
       const Context& context,
+      RenderTargetAllocator& allocator,
       ISize size,
       const std::string& label = "Offscreen MSAA",
       AttachmentConfigMSAA color_attachment_config =
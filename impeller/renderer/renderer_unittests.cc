@@ -2,8 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "impeller/base/strings.h"
+#include "impeller/base/validation.h"
 #include "impeller/fixtures/array.frag.h"
 #include "impeller/fixtures/array.vert.h"
 #include "impeller/fixtures/box_fade.frag.h"
@@ -25,7 +31,9 @@
 #include "impeller/image/decompressed_image.h"
 #include "impeller/playground/playground_test.h"
 #include "impeller/renderer/command.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/pipeline_builder.h"
@@ -681,6 +689,152 @@ TEST_P(RendererTest, CanBlitTextureToBuffer) {
   OpenPlaygroundHere(callback);
 }
 
+// Encodes the blits recorded by |record| and waits for the GPU to complete
+// them.
+static bool SubmitBlitsAndWait(const std::shared_ptr<Context>& context,
+                               const std::function<bool(BlitPass&)>& record) {
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  auto pass = command_buffer->CreateBlitPass();
+  if (!pass || !record(*pass) ||
+      !pass->EncodeCommands(context->GetResourceAllocator())) {
+    return false;
+  }
+  fml::AutoResetWaitableEvent latch;
+  bool completed = false;
+  if (!command_buffer->SubmitCommands(
+          [&latch, &completed](CommandBuffer::Status status) {
+            completed = status == CommandBuffer::Status::kCompleted;
+            latch.Signal();
+          })) {
+    return false;
+  }
+  latch.Wait();
+  return completed;
+}
+
+static std::shared_ptr<Texture> CreateBlitDestination(const Context& context,
+                                                      ISize size) {
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kHostVisible;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = size;
+  texture_desc.mip_count = 1u;
+  return context.GetResourceAllocator()->CreateTexture(texture_desc);
+}
+
+TEST_P(RendererTest, CanBlitBufferToTextureRegion) {
+  if (GetParam() == PlaygroundBackend::kVulkan) {
+    // The blit writes to the staging buffer, which is only uploaded to the
+    // image when the texture is bound.
+    GTEST_SKIP_("Vulkan texture readback doesn't see the staged contents.");
+  }
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  constexpr ISize kSize = {4, 4};
+  auto texture = CreateBlitDestination(*context, kSize);
+  ASSERT_TRUE(texture);
+
+  // Two by two pixels, after a pixel that isn't copied.
+  constexpr size_t kSourceOffset = 4u;
+  std::vector<uint8_t> pixels(kSourceOffset, 0xFFu);
+  for (uint8_t i = 0u; i < 4u; i++) {
+    for (uint8_t channel = 1u; channel <= 3u; channel++) {
+      pixels.push_back(i * 16u + channel);
+    }
+    pixels.push_back(255u);
+  }
+  auto source = context->GetResourceAllocator()->CreateBufferWithCopy(
+      pixels.data(), pixels.size());
+  std::vector<uint8_t> zeros(kSize.Area() * 4u, 0u);
+  auto clear = context->GetResourceAllocator()->CreateBufferWithCopy(
+      zeros.data(), zeros.size());
+  DeviceBufferDescriptor readback_desc;
+  readback_desc.storage_mode = StorageMode::kHostVisible;
+  readback_desc.size = zeros.size();
+  auto readback = context->GetResourceAllocator()->CreateBuffer(readback_desc);
+  ASSERT_TRUE(source && clear && readback);
+
+  ASSERT_TRUE(SubmitBlitsAndWait(context, [&](BlitPass& pass) {
+    return pass.AddCopy(clear, texture, IRect::MakeSize(kSize));
+  }));
+  ASSERT_TRUE(SubmitBlitsAndWait(context, [&](BlitPass& pass) {
+    return pass.AddCopy(source, texture, IRect::MakeXYWH(1, 1, 2, 2),
+                        kSourceOffset);
+  }));
+  ASSERT_TRUE(SubmitBlitsAndWait(context, [&](BlitPass& pass) {
+    return pass.AddCopy(texture, readback);
+  }));
+
+  // Only the region is written to, and the rest of the texture is preserved.
+  const uint8_t* contents = readback->AsBufferView().contents;
+  for (int64_t y = 0; y < kSize.height; y++) {
+    for (int64_t x = 0; x < kSize.width; x++) {
+      const uint8_t* pixel = contents + (y * kSize.width + x) * 4u;
+      std::vector<uint8_t> expected(4u, 0u);
+      if (x >= 1 && x <= 2 && y >= 1 && y <= 2) {
+        const uint8_t* source_pixel =
+            pixels.data() + kSourceOffset + ((y - 1) * 2 + (x - 1)) * 4u;
+        expected.assign(source_pixel, source_pixel + 4u);
+      }
+      ASSERT_EQ(std::vector<uint8_t>(pixel, pixel + 4u), expected)
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+TEST_P(RendererTest, BufferToTextureBlitsOutsideOfTheTextureAreRejected) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto texture = CreateBlitDestination(*context, {4, 4});
+  std::vector<uint8_t> pixels(4u * 4u * 4u, 0u);
+  auto source = context->GetResourceAllocator()->CreateBufferWithCopy(
+      pixels.data(), pixels.size());
+  ASSERT_TRUE(texture && source);
+  auto command_buffer = context->CreateCommandBuffer();
+  ASSERT_TRUE(command_buffer);
+  auto pass = command_buffer->CreateBlitPass();
+  ASSERT_TRUE(pass);
+
+  ScopedValidationDisable disable_validation;
+  ASSERT_TRUE(pass->AddCopy(source, texture, IRect::MakeXYWH(2, 2, 2, 2)));
+  ASSERT_FALSE(pass->AddCopy(source, texture, IRect::MakeXYWH(3, 3, 2, 2)));
+  ASSERT_FALSE(pass->AddCopy(source, texture, IRect::MakeXYWH(-1, 0, 2, 2)));
+  ASSERT_FALSE(pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 5, 4)));
+  ASSERT_FALSE(pass->AddCopy(nullptr, texture, IRect::MakeXYWH(0, 0, 2, 2)));
+  ASSERT_FALSE(pass->AddCopy(source, nullptr, IRect::MakeXYWH(0, 0, 2, 2)));
+  // An empty region has nothing to copy.
+  ASSERT_TRUE(pass->AddCopy(source, texture, IRect::MakeXYWH(8, 8, 0, 0)));
+}
+
+TEST_P(RendererTest, BufferToTextureBlitsOutsideOfTheBufferAreRejected) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  auto texture = CreateBlitDestination(*context, {4, 4});
+  // Enough for two by two pixels and no more.
+  std::vector<uint8_t> pixels(2u * 2u * 4u, 0u);
+  auto source = context->GetResourceAllocator()->CreateBufferWithCopy(
+      pixels.data(), pixels.size());
+  ASSERT_TRUE(texture && source);
+  auto command_buffer = context->CreateCommandBuffer();
+  ASSERT_TRUE(command_buffer);
+  auto pass = command_buffer->CreateBlitPass();
+  ASSERT_TRUE(pass);
+
+  ScopedValidationDisable disable_validation;
+  ASSERT_TRUE(pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 2, 2)));
+  ASSERT_TRUE(pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 2, 1), 8u));
+  // The buffer is too small for the region.
+  ASSERT_FALSE(pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 3, 2)));
+  ASSERT_FALSE(pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 4, 4)));
+  // The offset leaves too few bytes for the region.
+  ASSERT_FALSE(pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 2, 2), 4u));
+  ASSERT_FALSE(
+      pass->AddCopy(source, texture, IRect::MakeXYWH(0, 0, 1, 1), 16u));
+}
+
 TEST_P(RendererTest, CanGenerateMipmaps) {
   auto context = GetContext();
   ASSERT_TRUE(context);
@@ -996,6 +1150,22 @@ TEST_P(RendererTest, CanCreateCPUBackedTexture) {
   } while (dimension <= 8192);
 }
 
+TEST_P(RendererTest, ContextReportsItsBackendType) {
+  Context::BackendType expected;
+  switch (GetParam()) {
+    case PlaygroundBackend::kMetal:
+      expected = Context::BackendType::kMetal;
+      break;
+    case PlaygroundBackend::kOpenGLES:
+      expected = Context::BackendType::kOpenGLES;
+      break;
+    case PlaygroundBackend::kVulkan:
+      expected = Context::BackendType::kVulkan;
+      break;
+  }
+  ASSERT_EQ(GetContext()->GetBackendType(), expected);
+}
+
 TEST_P(RendererTest, DefaultIndexSize) {
   using VS = BoxFadeVertexShader;
 
@@ -1027,5 +1197,66 @@ TEST_P(RendererTest, VertexBufferBuilder) {
   ASSERT_EQ(vertex_builder.GetVertexCount(), 4u);
 }
 
+TEST_P(RendererTest, AllocatorCountsTheBuffersAndTexturesItCreates) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  const auto before = allocator->GetAllocationStatistics();
+
+  DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.storage_mode = StorageMode::kHostVisible;
+  buffer_descriptor.size = 1024u;
+  auto buffer = allocator->CreateBuffer(buffer_descriptor);
+  ASSERT_TRUE(buffer);
+
+  TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = StorageMode::kDevicePrivate;
+  texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_descriptor.size = {16, 16};
+  auto texture = allocator->CreateTexture(texture_descriptor);
+  ASSERT_TRUE(texture);
+
+  const auto after = allocator->GetAllocationStatistics();
+  ASSERT_EQ(after.buffer_count - before.buffer_count, 1u);
+  ASSERT_EQ(after.buffer_bytes - before.buffer_bytes, 1024u);
+  ASSERT_EQ(after.texture_count - before.texture_count, 1u);
+  ASSERT_EQ(after.texture_bytes - before.texture_bytes, 16u * 16u * 4u);
+}
+
+TEST_P(RendererTest, AllocatorAccountsLiveDeviceMemoryByCategory) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  const auto before = allocator->GetDeviceMemoryStatistics();
+
+  DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.storage_mode = StorageMode::kHostVisible;
+  buffer_descriptor.size = 1024u;
+  buffer_descriptor.category = AllocationCategory::kHostBuffer;
+  auto buffer = allocator->CreateBuffer(buffer_descriptor);
+  ASSERT_TRUE(buffer);
+
+  TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = StorageMode::kDevicePrivate;
+  texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_descriptor.size = {16, 16};
+  texture_descriptor.usage =
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  auto texture = allocator->CreateTexture(texture_descriptor);
+  ASSERT_TRUE(texture);
+
+  auto live = allocator->GetDeviceMemoryStatistics();
+  auto host_buffers = live.Get(AllocationCategory::kHostBuffer).bytes -
+                      before.Get(AllocationCategory::kHostBuffer).bytes;
+  auto render_targets = live.Get(AllocationCategory::kRenderTarget).bytes -
+                        before.Get(AllocationCategory::kRenderTarget).bytes;
+  ASSERT_EQ(host_buffers, 1024u);
+  ASSERT_EQ(render_targets, 16u * 16u * 4u);
+  ASSERT_EQ(live.GetTotalBytes() - before.GetTotalBytes(),
+            1024u + 16u * 16u * 4u);
+
+  // Collecting the resources removes them.
+  buffer.reset();
+  texture.reset();
+  ASSERT_EQ(allocator->GetDeviceMemoryStatistics().GetTotalBytes(),
+            before.GetTotalBytes());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstring>
 #include <optional>
 #include <string_view>
 #include <vector>
@@ -111,6 +112,75 @@ struct ShaderStageIOSlot {
   }
 };
 
+struct ShaderSpecializationConstantSlot {
+  const char* name;
+  size_t constant_id;
+  ShaderType type;
+};
+
+/// @brief The value a pipeline specializes a constant of its shaders with.
+///
+///        Specialization constants are 32 bit scalars. The value holds the
+///        bits of the constant, with booleans stored as 0 or 1.
+struct ShaderSpecializationConstant {
+  uint32_t constant_id = 0u;
+  ShaderType type = ShaderType::kUnknown;
+  uint32_t value = 0u;
+
+  ShaderSpecializationConstant(const ShaderSpecializationConstantSlot& slot,
+                               bool p_value)
+      : constant_id(static_cast<uint32_t>(slot.constant_id)),
+        type(ShaderType::kBoolean),
+        value(p_value ? 1u : 0u) {
+    FML_DCHECK(slot.type == type);
+  }
+
+  ShaderSpecializationConstant(const ShaderSpecializationConstantSlot& slot,
+                               int32_t p_value)
+      : constant_id(static_cast<uint32_t>(slot.constant_id)),
+        type(ShaderType::kSignedInt),
+        value(static_cast<uint32_t>(p_value)) {
+    FML_DCHECK(slot.type == type);
+  }
+
+  ShaderSpecializationConstant(const ShaderSpecializationConstantSlot& slot,
+                               uint32_t p_value)
+      : constant_id(static_cast<uint32_t>(slot.constant_id)),
+        type(ShaderType::kUnsignedInt),
+        value(p_value) {
+    FML_DCHECK(slot.type == type);
+  }
+
+  ShaderSpecializationConstant(const ShaderSpecializationConstantSlot& slot,
+                               float p_value)
+      : constant_id(static_cast<uint32_t>(slot.constant_id)),
+        type(ShaderType::kFloat) {
+    static_assert(sizeof(value) == sizeof(p_value));
+    std::memcpy(&value, &p_value, sizeof(value));
+    FML_DCHECK(slot.type == type);
+  }
+
+  constexpr bool GetBool() const { return value != 0u; }
+
+  constexpr int32_t GetSignedInt() const { return static_cast<int32_t>(value); }
+
+  float GetFloat() const {
+    float result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+  }
+
+  constexpr size_t GetHash() const {
+    return fml::HashCombine(constant_id, type, value);
+  }
+
+  constexpr bool operator==(const ShaderSpecializationConstant& other) const {
+    return constant_id == other.constant_id &&  //
+           type == other.type &&                //
+           value == other.value;
+  }
+};
+
 struct SampledImageSlot {
   const char* name;
   size_t texture_index;
@@ -10,7 +10,21 @@ namespace impeller {
 
 Texture::Texture(TextureDescriptor desc) : desc_(desc) {}
 
-Texture::~Texture() = default;
+Texture::~Texture() {
+  if (memory_tracker_) {
+    memory_tracker_->RecordDeallocation(memory_category_, memory_bytes_);
+  }
+}
+
+void Texture::TrackDeviceMemory(std::shared_ptr<DeviceMemoryTracker> tracker,
+                                AllocationCategory category,
+                                size_t bytes) {
+  FML_DCHECK(!memory_tracker_);
+  tracker->RecordAllocation(category, bytes);
+  memory_tracker_ = std::move(tracker);
+  memory_category_ = category;
+  memory_bytes_ = bytes;
+}
 
 bool Texture::SetContents(const uint8_t* contents,
                           size_t length,
@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/geometry/size.h"
+#include "impeller/renderer/device_memory_tracker.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/texture_descriptor.h"
 
@@ -53,11 +54,20 @@ class Texture {
       size_t slice) = 0;
 
  private:
+  friend class Allocator;
+
   TextureIntent intent_ = TextureIntent::kRenderToTexture;
   const TextureDescriptor desc_;
+  std::shared_ptr<DeviceMemoryTracker> memory_tracker_;
+  AllocationCategory memory_category_ = AllocationCategory::kOther;
+  size_t memory_bytes_ = 0u;
 
   bool IsSliceValid(size_t slice) const;
 
+  void TrackDeviceMemory(std::shared_ptr<DeviceMemoryTracker> tracker,
+                         AllocationCategory category,
+                         size_t bytes);
+
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
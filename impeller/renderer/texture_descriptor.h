@@ -25,18 +25,30 @@ struct TextureDescriptor {
   TextureUsageMask usage =
       static_cast<TextureUsageMask>(TextureUsage::kShaderRead);
   SampleCount sample_count = SampleCount::kCount1;
+  AllocationCategory category = AllocationCategory::kOther;
 
   constexpr size_t GetByteSizeOfBaseMipLevel() const {
     if (!IsValid()) {
       return 0u;
     }
+    if (IsCompressedPixelFormat(format)) {
+      return GetBytesPerRow() *
+             ((size.height + kCompressedBlockDimension - 1) /
+              kCompressedBlockDimension);
+    }
     return size.Area() * BytesPerPixelForPixelFormat(format);
   }
 
+  /// The size of a row of pixels, or of a row of blocks for compressed pixel
+  /// formats.
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
+    if (IsCompressedPixelFormat(format)) {
+      return (size.width + kCompressedBlockDimension - 1) /
+             kCompressedBlockDimension * BytesPerBlockForPixelFormat(format);
+    }
     return size.width * BytesPerPixelForPixelFormat(format);
   }
 
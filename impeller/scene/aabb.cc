@@ -0,0 +1,46 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/aabb.h"
+
+namespace impeller {
+namespace scene {
+
+std::array<Vector3, 8> AABB::GetCorners() const {
+  return {
+      Vector3(min.x, min.y, min.z), Vector3(max.x, min.y, min.z),
+      Vector3(min.x, max.y, min.z), Vector3(max.x, max.y, min.z),
+      Vector3(min.x, min.y, max.z), Vector3(max.x, min.y, max.z),
+      Vector3(min.x, max.y, max.z), Vector3(max.x, max.y, max.z),
+  };
+}
+
+bool AABB::IntersectsClipSpace(const Matrix& mvp) const {
+  // Count the corners that are outside of each of the six clip planes. The
+  // clip space depth ranges from 0 to w.
+  int outside[6] = {};
+  for (const auto& corner : GetCorners()) {
+    auto clip = mvp * Vector4(corner.x, corner.y, corner.z, 1.0);
+    outside[0] += clip.x < -clip.w;
+    outside[1] += clip.x > clip.w;
+    outside[2] += clip.y < -clip.w;
+    outside[3] += clip.y > clip.w;
+    outside[4] += clip.z < 0;
+    outside[5] += clip.z > clip.w;
+  }
+  for (auto count : outside) {
+    if (count == 8) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Scalar AABB::GetClipSpaceDepth(const Matrix& mvp) const {
+  auto center = (min + max) * 0.5;
+  return (mvp * Vector4(center.x, center.y, center.z, 1.0)).w;
+}
+
+}  // namespace scene
+}  // namespace impeller
@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/vector.h"
+
+namespace impeller {
+namespace scene {
+
+//------------------------------------------------------------------------------
+/// @brief      An axis aligned bounding box.
+///
+struct AABB {
+  Vector3 min;
+  Vector3 max;
+
+  std::array<Vector3, 8> GetCorners() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      If any part of the box may be visible after it is transformed
+  ///             to clip space by |mvp|.
+  ///
+  ///             Boxes that are entirely on the outer side of one of the
+  ///             planes of the view frustum are culled. Boxes that straddle
+  ///             the corners of the frustum may be kept even if they aren't
+  ///             visible.
+  ///
+  bool IntersectsClipSpace(const Matrix& mvp) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The view space depth of the center of the box, which is the w
+  ///             component of its clip space position, for ordering the draws
+  ///             of boxes transformed by |mvp|.
+  ///
+  Scalar GetClipSpaceDepth(const Matrix& mvp) const;
+};
+
+}  // namespace scene
+}  // namespace impeller
@@ -10,15 +10,19 @@
 
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/vector.h"
+#include "impeller/renderer/compute_command.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/sampler_descriptor.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
+#include "impeller/scene/shaders/skinning.comp.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -116,11 +120,48 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .index_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  auto result = MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  if (mesh.bounds()) {
+    result->SetBounds(AABB{.min = importer::ToVector3(mesh.bounds()->min()),
+                           .max = importer::ToVector3(mesh.bounds()->max())});
+  }
+  return result;
+}
+
+void Geometry::SetBounds(std::optional<AABB> bounds) {
+  bounds_ = bounds;
+}
+
+const std::optional<AABB>& Geometry::GetBounds() const {
+  return bounds_;
+}
+
+void Geometry::BindInstancesToCommand(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const Matrix& transform,
+                                      const BufferView& instance_transforms,
+                                      Command& command) const {
+  FML_DCHECK(GetGeometryType() == GeometryType::kUnskinned);
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+
+  UnskinnedInstancedVertexShader::VertInfo info;
+  info.mvp = transform;
+  UnskinnedInstancedVertexShader::BindVertInfo(command,
+                                               buffer.EmplaceUniform(info));
+  UnskinnedInstancedVertexShader::BindInstanceData(command,
+                                                   instance_transforms);
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
 
+std::optional<VertexBuffer> Geometry::MakeSkinnedVertexBuffer(
+    const SceneContext& scene_context,
+    ComputePass& pass,
+    const std::vector<Matrix>& joint_transforms) const {
+  return std::nullopt;
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
@@ -269,5 +310,62 @@ void SkinnedVertexBufferGeometry::SetJointsTexture(
     const std::shared_ptr<Texture>& texture) {
   joints_texture_ = texture;
 }
+
+// |Geometry|
+std::optional<VertexBuffer>
+SkinnedVertexBufferGeometry::MakeSkinnedVertexBuffer(
+    const SceneContext& scene_context,
+    ComputePass& pass,
+    const std::vector<Matrix>& joint_transforms) const {
+  using CS = SkinningComputeShader;
+
+  auto pipeline = scene_context.GetSkinningPipeline();
+  if (!pipeline || joint_transforms.empty()) {
+    return std::nullopt;
+  }
+  const size_t vertex_count =
+      vertex_buffer_.vertex_buffer.range.length / sizeof(fb::SkinnedVertex);
+  if (vertex_count == 0) {
+    return std::nullopt;
+  }
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+  buffer_desc.size = vertex_count * sizeof(fb::Vertex);
+  auto buffer =
+      scene_context.GetContext()->GetResourceAllocator()->CreateBuffer(
+          buffer_desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("Skinned Vertices");
+
+  ComputeCommand cmd;
+  cmd.label = "Skinning";
+  cmd.pipeline = pipeline;
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  CS::SkinningInfo info;
+  info.vertex_count = vertex_count;
+  CS::BindSkinningInfo(cmd, host_buffer.EmplaceUniform(info));
+  CS::BindSkinnedVertices(cmd, vertex_buffer_.vertex_buffer);
+  CS::BindJoints(
+      cmd, host_buffer.Emplace(
+               joint_transforms.data(),
+               joint_transforms.size() * sizeof(Matrix),
+               std::max(alignof(Matrix), DefaultUniformAlignment())));
+  CS::BindVertices(cmd, buffer->AsBufferView());
+  if (!pass.AddCommand(std::move(cmd))) {
+    return std::nullopt;
+  }
+
+  return VertexBuffer{
+      .vertex_buffer = buffer->AsBufferView(),
+      .index_buffer = vertex_buffer_.index_buffer,
+      .index_count = vertex_buffer_.index_count,
+      .index_type = vertex_buffer_.index_type,
+  };
+}
+
 }  // namespace scene
 }  // namespace impeller
@@ -5,15 +5,19 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/command.h"
+#include "impeller/renderer/compute_pass.h"
 #include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/host_buffer.h"
 #include "impeller/renderer/vertex_buffer.h"
+#include "impeller/scene/aabb.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/pipeline_key.h"
 #include "impeller/scene/scene_context.h"
@@ -39,6 +43,14 @@ class Geometry {
 
   virtual GeometryType GetGeometryType() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the bounds of the vertices in model space. Geometry
+  ///             without bounds is never culled.
+  ///
+  void SetBounds(std::optional<AABB> bounds);
+
+  const std::optional<AABB>& GetBounds() const;
+
   virtual VertexBuffer GetVertexBuffer(Allocator& allocator) const = 0;
 
   virtual void BindToCommand(const SceneContext& scene_context,
@@ -46,7 +58,34 @@ class Geometry {
                              const Matrix& transform,
                              Command& command) const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Bind the vertices of the geometry to draw one instance of it
+  ///             for each of the matrices in |instance_transforms|, relative
+  ///             to |transform|. The geometry must be unskinned.
+  ///
+  void BindInstancesToCommand(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const Matrix& transform,
+                              const BufferView& instance_transforms,
+                              Command& command) const;
+
   virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add a command to |pass| that poses the vertices of this
+  ///             geometry with |joint_transforms|. The posed vertices are in
+  ///             the layout of unskinned geometry.
+  ///
+  /// @return     The posed vertices, or std::nullopt if this geometry isn't
+  ///             skinned or the command couldn't be added.
+  ///
+  virtual std::optional<VertexBuffer> MakeSkinnedVertexBuffer(
+      const SceneContext& scene_context,
+      ComputePass& pass,
+      const std::vector<Matrix>& joint_transforms) const;
+
+ private:
+  std::optional<AABB> bounds_;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -124,6 +163,12 @@ class SkinnedVertexBufferGeometry final : public Geometry {
   // |Geometry|
   void SetJointsTexture(const std::shared_ptr<Texture>& texture) override;
 
+  // |Geometry|
+  std::optional<VertexBuffer> MakeSkinnedVertexBuffer(
+      const SceneContext& scene_context,
+      ComputePass& pass,
+      const std::vector<Matrix>& joint_transforms) const override;
+
  private:
   VertexBuffer vertex_buffer_;
   std::shared_ptr<Texture> joints_texture_;
@@ -56,6 +56,38 @@ TEST(ImporterTest, CanParseUnskinnedGLTF) {
   ASSERT_COLOR_NEAR(color, Color(0.0221714, 0.467781, 0.921584, 1));
 }
 
+TEST(ImporterTest, MeshPrimitivesAreBounded) {
+  auto mapping =
+      flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb");
+
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(*mapping, scene));
+
+  auto& node = scene.nodes[scene.children[0]];
+  ASSERT_EQ(node->mesh_primitives.size(), 1u);
+  auto& mesh = *node->mesh_primitives[0];
+  ASSERT_TRUE(mesh.bounds);
+  Vector3 min = ToVector3(mesh.bounds->min());
+  Vector3 max = ToVector3(mesh.bounds->max());
+
+  bool touches_min[3] = {};
+  bool touches_max[3] = {};
+  for (const auto& vertex : mesh.vertices.AsUnskinnedVertexBuffer()->vertices) {
+    Vector3 position = ToVector3(vertex.position());
+    for (int i = 0; i < 3; i++) {
+      ASSERT_GE(position.e[i], min.e[i]);
+      ASSERT_LE(position.e[i], max.e[i]);
+      touches_min[i] |= position.e[i] == min.e[i];
+      touches_max[i] |= position.e[i] == max.e[i];
+    }
+  }
+  // The bounds are tight.
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(touches_min[i]);
+    ASSERT_TRUE(touches_max[i]);
+  }
+}
+
 TEST(ImporterTest, CanParseSkinnedGLTF) {
   auto mapping = flutter::testing::OpenFixtureAsMapping("two_triangles.glb");
 
@@ -4,6 +4,7 @@
 
 #include "impeller/scene/importer/vertices_builder.h"
 
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <memory>
@@ -156,6 +157,27 @@ void VerticesBuilder::WriteAttribute(void* destination,
   }
 }
 
+// Sets the bounds of |primitive| to the bounds of the positions of
+// |vertices|, which are used to cull the primitive when it's off-screen.
+template <typename VertexType, typename PositionProc>
+static void WriteFBBounds(fb::MeshPrimitiveT& primitive,
+                          const std::vector<VertexType>& vertices,
+                          PositionProc position_proc) {
+  if (vertices.empty()) {
+    return;
+  }
+  Vector3 min = position_proc(vertices.front());
+  Vector3 max = min;
+  for (const auto& vertex : vertices) {
+    const Vector3& position = position_proc(vertex);
+    min = Vector3(std::min(min.x, position.x), std::min(min.y, position.y),
+                  std::min(min.z, position.z));
+    max = Vector3(std::max(max.x, position.x), std::max(max.y, position.y),
+                  std::max(max.z, position.z));
+  }
+  primitive.bounds = std::make_unique<fb::AABB>(ToFBVec3(min), ToFBVec3(max));
+}
+
 //------------------------------------------------------------------------------
 /// UnskinnedVerticesBuilder
 ///
@@ -174,6 +196,8 @@ void UnskinnedVerticesBuilder::WriteFBVertices(
         ToFBVec2(v.texture_coords), ToFBColor(v.color)));
   }
   primitive.vertices.Set(std::move(vertex_buffer));
+  WriteFBBounds(primitive, vertices_,
+                [](const Vertex& v) -> const Vector3& { return v.position; });
 }
 
 void UnskinnedVerticesBuilder::SetAttributeFromBuffer(
@@ -215,6 +239,9 @@ void SkinnedVerticesBuilder::WriteFBVertices(
         unskinned_attributes, ToFBVec4(v.joints), ToFBVec4(v.weights)));
   }
   primitive.vertices.Set(std::move(vertex_buffer));
+  WriteFBBounds(primitive, vertices_, [](const Vertex& v) -> const Vector3& {
+    return v.vertex.position;
+  });
 }
 
 void SkinnedVerticesBuilder::SetAttributeFromBuffer(
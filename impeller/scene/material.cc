@@ -45,6 +45,7 @@ std::unique_ptr<PhysicallyBasedMaterial> Material::MakePhysicallyBased() {
 
 void Material::SetVertexColorWeight(Scalar weight) {
   vertex_color_weight_ = weight;
+  uniform_buffer_ = nullptr;
 }
 
 void Material::SetBlendConfig(BlendConfig blend_config) {
@@ -59,6 +60,10 @@ void Material::SetTranslucent(bool is_translucent) {
   is_translucent_ = is_translucent;
 }
 
+bool Material::IsTranslucent() const {
+  return is_translucent_;
+}
+
 SceneContextOptions Material::GetContextOptions(const RenderPass& pass) const {
   // TODO(bdero): Pipeline blend and stencil config.
   return {.sample_count = pass.GetRenderTarget().GetSampleCount()};
@@ -95,6 +100,7 @@ UnlitMaterial::~UnlitMaterial() = default;
 
 void UnlitMaterial::SetColor(Color color) {
   color_ = color;
+  uniform_buffer_ = nullptr;
 }
 
 void UnlitMaterial::SetColorTexture(std::shared_ptr<Texture> color_texture) {
@@ -114,7 +120,18 @@ void UnlitMaterial::BindToCommand(const SceneContext& scene_context,
   UnlitFragmentShader::FragInfo info;
   info.color = color_;
   info.vertex_color_weight = vertex_color_weight_;
-  UnlitFragmentShader::BindFragInfo(command, buffer.EmplaceUniform(info));
+  if (!uniform_buffer_) {
+    auto allocator = scene_context.GetContext()->GetResourceAllocator();
+    uniform_buffer_ = allocator->CreateBufferWithCopy(
+        reinterpret_cast<const uint8_t*>(&info), sizeof(info));
+    if (uniform_buffer_) {
+      uniform_buffer_->SetLabel("Unlit Material Uniforms");
+    }
+  }
+  UnlitFragmentShader::BindFragInfo(command,
+                                    uniform_buffer_
+                                        ? uniform_buffer_->AsBufferView()
+                                        : buffer.EmplaceUniform(info));
 
   // Textures.
   SamplerDescriptor sampler_descriptor;
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "impeller/geometry/scalar.h"
+#include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/texture.h"
@@ -54,6 +55,8 @@ class Material {
 
   void SetTranslucent(bool is_translucent);
 
+  bool IsTranslucent() const;
+
   SceneContextOptions GetContextOptions(const RenderPass& pass) const;
 
   virtual MaterialType GetMaterialType() const = 0;
@@ -67,6 +70,10 @@ class Material {
   BlendConfig blend_config_;
   StencilConfig stencil_config_;
   bool is_translucent_ = false;
+  // The uniforms of the material on the GPU, reused by every frame until they
+  // change. Subclasses create it when they are bound and clear it when their
+  // uniforms change.
+  mutable std::shared_ptr<DeviceBuffer> uniform_buffer_;
 };
 
 class UnlitMaterial final : public Material {
@@ -33,16 +33,41 @@ std::vector<Mesh::Primitive>& Mesh::GetPrimitives() {
   return primitives_;
 }
 
-bool Mesh::Render(SceneEncoder& encoder,
-                  const Matrix& transform,
-                  const std::shared_ptr<Texture>& joints) const {
+void Mesh::SetInstanceTransforms(std::vector<Matrix> transforms) {
+  instance_transforms_ =
+      transforms.empty()
+          ? nullptr
+          : std::make_shared<std::vector<Matrix>>(std::move(transforms));
+  // Frames that are still in flight keep their reference to the old buffer.
+  instance_buffer_ = nullptr;
+}
+
+bool Mesh::Render(
+    SceneEncoder& encoder,
+    Allocator& allocator,
+    const Matrix& transform,
+    const std::shared_ptr<const std::vector<Matrix>>& joints) const {
+  if (instance_transforms_ && !instance_buffer_) {
+    instance_buffer_ = allocator.CreateBufferWithCopy(
+        reinterpret_cast<const uint8_t*>(instance_transforms_->data()),
+        instance_transforms_->size() * sizeof(Matrix));
+    if (!instance_buffer_) {
+      VALIDATION_LOG << "Could not create mesh instance buffer.";
+      return false;
+    }
+    instance_buffer_->SetLabel("Mesh Instance Transforms");
+  }
+
   for (const auto& mesh : primitives_) {
-    mesh.geometry->SetJointsTexture(joints);
     SceneCommand command = {
         .label = "Mesh Primitive",
         .transform = transform,
         .geometry = mesh.geometry.get(),
         .material = mesh.material.get(),
+        .joints = joints,
+        .instance_transforms = instance_transforms_,
+        .instance_buffer = instance_buffer_ ? instance_buffer_->AsBufferView()
+                                            : BufferView{},
     };
     encoder.Add(command);
   }
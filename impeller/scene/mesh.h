@@ -6,8 +6,11 @@
 
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/device_buffer.h"
 #include "impeller/scene/geometry.h"
 #include "impeller/scene/material.h"
 #include "impeller/scene/scene_encoder.h"
@@ -33,12 +36,26 @@ class Mesh final {
   void AddPrimitive(Primitive mesh_);
   std::vector<Primitive>& GetPrimitives();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draw the primitives of the mesh once for each of
+  ///             |transforms|, relative to the transform of the mesh. When
+  ///             the backend supports it, all the instances of a primitive
+  ///             are drawn with a single command. An empty list draws the
+  ///             primitives once.
+  ///
+  void SetInstanceTransforms(std::vector<Matrix> transforms);
+
   bool Render(SceneEncoder& encoder,
+              Allocator& allocator,
               const Matrix& transform,
-              const std::shared_ptr<Texture>& joints) const;
+              const std::shared_ptr<const std::vector<Matrix>>& joints) const;
 
  private:
   std::vector<Primitive> primitives_;
+  std::shared_ptr<const std::vector<Matrix>> instance_transforms_;
+  // The instance transforms on the GPU. Reused by every frame until the
+  // transforms change.
+  mutable std::shared_ptr<DeviceBuffer> instance_buffer_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Mesh);
 };
@@ -132,6 +132,18 @@ static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
   return texture;
 }
 
+static Mesh::Primitive UnpackMeshPrimitiveFromFlatbuffer(
+    const fb::MeshPrimitive& primitive,
+    const std::vector<std::shared_ptr<Texture>>& textures,
+    Allocator& allocator) {
+  auto geometry = Geometry::MakeFromFlatbuffer(primitive, allocator);
+  auto material =
+      primitive.material()
+          ? Material::MakeFromFlatbuffer(*primitive.material(), textures)
+          : Material::MakeUnlit();
+  return {std::move(geometry), std::move(material)};
+}
+
 std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
                                                Allocator& allocator) {
   // Unpack textures.
@@ -145,6 +157,124 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
     }
   }
 
+  std::vector<std::shared_ptr<Node>> scene_nodes;
+  auto result = UnpackSceneGraphFromFlatbuffer(scene, scene_nodes);
+
+  // Unpack meshes.
+  for (size_t node_i = 0; node_i < scene_nodes.size(); node_i++) {
+    auto primitives = scene.nodes()->Get(node_i)->mesh_primitives();
+    if (!primitives) {
+      continue;
+    }
+    Mesh mesh;
+    for (const auto* primitive : *primitives) {
+      mesh.AddPrimitive(
+          UnpackMeshPrimitiveFromFlatbuffer(*primitive, textures, allocator));
+    }
+    scene_nodes[node_i]->SetMesh(std::move(mesh));
+  }
+
+  return result;
+}
+
+namespace {
+
+/// The state shared by the tasks that upload the meshes of a scene unpacked
+/// by |Node::MakeFromFlatbufferProgressively|. Only ever used on the task
+/// runner of those tasks.
+struct ProgressiveSceneLoad {
+  std::shared_ptr<const fml::Mapping> mapping;
+  const fb::Scene* scene = nullptr;
+  std::shared_ptr<Allocator> allocator;
+  std::vector<std::weak_ptr<Node>> nodes;
+  std::vector<std::shared_ptr<Texture>> textures;
+  std::vector<bool> textures_unpacked;
+
+  void UnpackTexture(int32_t index) {
+    if (index < 0 || static_cast<size_t>(index) >= textures.size() ||
+        textures_unpacked[index]) {
+      return;
+    }
+    textures_unpacked[index] = true;
+    textures[index] =
+        UnpackTextureFromFlatbuffer(scene->textures()->Get(index), *allocator);
+  }
+
+  void UnpackMaterialTextures(const fb::Material& material) {
+    UnpackTexture(material.base_color_texture());
+    UnpackTexture(material.metallic_roughness_texture());
+    UnpackTexture(material.normal_texture());
+    UnpackTexture(material.occlusion_texture());
+  }
+};
+
+}  // namespace
+
+std::shared_ptr<Node> Node::MakeFromFlatbufferProgressively(
+    std::shared_ptr<const fml::Mapping> ipscene_mapping,
+    std::shared_ptr<Allocator> allocator,
+    const fml::RefPtr<fml::TaskRunner>& task_runner) {
+  if (!ipscene_mapping || !allocator || !task_runner) {
+    return nullptr;
+  }
+  // Verification only checks the bounds of the vertex, index and image data,
+  // so it doesn't page those in.
+  flatbuffers::Verifier verifier(ipscene_mapping->GetMapping(),
+                                 ipscene_mapping->GetSize());
+  if (!fb::VerifySceneBuffer(verifier)) {
+    VALIDATION_LOG << "Failed to unpack scene: Scene flatbuffer is invalid.";
+    return nullptr;
+  }
+
+  auto load = std::make_shared<ProgressiveSceneLoad>();
+  load->mapping = std::move(ipscene_mapping);
+  load->scene = fb::GetScene(load->mapping->GetMapping());
+  load->allocator = std::move(allocator);
+  if (load->scene->textures()) {
+    load->textures.resize(load->scene->textures()->size());
+    load->textures_unpacked.resize(load->scene->textures()->size(), false);
+  }
+
+  std::vector<std::shared_ptr<Node>> scene_nodes;
+  auto result = UnpackSceneGraphFromFlatbuffer(*load->scene, scene_nodes);
+  load->nodes.assign(scene_nodes.begin(), scene_nodes.end());
+
+  // Each primitive is uploaded by a task of its own so that other work on the
+  // task runner can be interleaved with loading a large scene.
+  for (size_t node_i = 0; node_i < scene_nodes.size(); node_i++) {
+    auto primitives = load->scene->nodes()->Get(node_i)->mesh_primitives();
+    if (!primitives) {
+      continue;
+    }
+    for (size_t primitive_i = 0; primitive_i < primitives->size();
+         primitive_i++) {
+      task_runner->PostTask([load, node_i, primitive_i]() {
+        auto node = load->nodes[node_i].lock();
+        if (!node) {
+          return;
+        }
+        const auto* primitive = load->scene->nodes()
+                                    ->Get(node_i)
+                                    ->mesh_primitives()
+                                    ->Get(primitive_i);
+        if (primitive->material()) {
+          load->UnpackMaterialTextures(*primitive->material());
+        }
+        // Nodes may be rendering on another thread, so the primitive is
+        // handed over through the mutation log.
+        node->AddMutation(MutationLog::AddMeshPrimitiveEntry{
+            UnpackMeshPrimitiveFromFlatbuffer(*primitive, load->textures,
+                                              *load->allocator)});
+      });
+    }
+  }
+
+  return result;
+}
+
+std::shared_ptr<Node> Node::UnpackSceneGraphFromFlatbuffer(
+    const fb::Scene& scene,
+    std::vector<std::shared_ptr<Node>>& scene_nodes) {
   auto result = std::make_shared<Node>();
   result->SetLocalTransform(importer::ToMatrix(*scene.transform()));
 
@@ -153,7 +283,6 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
   }
 
   // Initialize nodes for unpacking the entire scene.
-  std::vector<std::shared_ptr<Node>> scene_nodes;
   scene_nodes.reserve(scene.nodes()->size());
   for (size_t node_i = 0; node_i < scene.nodes()->size(); node_i++) {
     scene_nodes.push_back(std::make_shared<Node>());
@@ -171,7 +300,7 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
   // Unpack each node.
   for (size_t node_i = 0; node_i < scene.nodes()->size(); node_i++) {
     scene_nodes[node_i]->UnpackFromFlatbuffer(*scene.nodes()->Get(node_i),
-                                              scene_nodes, textures, allocator);
+                                              scene_nodes);
   }
 
   // Unpack animations.
@@ -189,27 +318,10 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
 
 void Node::UnpackFromFlatbuffer(
     const fb::Node& source_node,
-    const std::vector<std::shared_ptr<Node>>& scene_nodes,
-    const std::vector<std::shared_ptr<Texture>>& textures,
-    Allocator& allocator) {
+    const std::vector<std::shared_ptr<Node>>& scene_nodes) {
   name_ = source_node.name()->str();
   SetLocalTransform(importer::ToMatrix(*source_node.transform()));
 
-  /// Meshes.
-
-  if (source_node.mesh_primitives()) {
-    Mesh mesh;
-    for (const auto* primitives : *source_node.mesh_primitives()) {
-      auto geometry = Geometry::MakeFromFlatbuffer(*primitives, allocator);
-      auto material =
-          primitives->material()
-              ? Material::MakeFromFlatbuffer(*primitives->material(), textures)
-              : Material::MakeUnlit();
-      mesh.AddPrimitive({std::move(geometry), std::move(material)});
-    }
-    SetMesh(std::move(mesh));
-  }
-
   /// Child nodes.
 
   if (source_node.children()) {
@@ -398,6 +510,12 @@ bool Node::Render(SceneEncoder& encoder,
         }
 
         clip->Seek(SecondsF(e->time));
+      } else if (auto e = std::get_if<MutationLog::SetInstanceTransformsEntry>(
+                     &entry)) {
+        mesh_.SetInstanceTransforms(e->transforms);
+      } else if (auto e =
+                     std::get_if<MutationLog::AddMeshPrimitiveEntry>(&entry)) {
+        mesh_.AddPrimitive(e->primitive);
       }
     }
   }
@@ -407,8 +525,11 @@ bool Node::Render(SceneEncoder& encoder,
   }
 
   Matrix transform = parent_transform * local_transform_;
-  mesh_.Render(encoder, transform,
-               skin_ ? skin_->GetJointsTexture(allocator) : nullptr);
+  std::shared_ptr<const std::vector<Matrix>> joints;
+  if (skin_) {
+    joints = std::make_shared<std::vector<Matrix>>(skin_->GetJointTransforms());
+  }
+  mesh_.Render(encoder, allocator, transform, joints);
 
   for (auto& child : children_) {
     if (!child->Render(encoder, allocator, transform)) {
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/geometry/matrix.h"
@@ -47,8 +48,19 @@ class Node final {
       float time = 0;
     };
 
-    using Entry = std::
-        variant<SetTransformEntry, SetAnimationStateEntry, SeekAnimationEntry>;
+    struct SetInstanceTransformsEntry {
+      std::vector<Matrix> transforms;
+    };
+
+    struct AddMeshPrimitiveEntry {
+      Mesh::Primitive primitive;
+    };
+
+    using Entry = std::variant<SetTransformEntry,
+                               SetAnimationStateEntry,
+                               SeekAnimationEntry,
+                               SetInstanceTransformsEntry,
+                               AddMeshPrimitiveEntry>;
 
     void Append(const Entry& entry);
 
@@ -68,6 +80,22 @@ class Node final {
   static std::shared_ptr<Node> MakeFromFlatbuffer(const fb::Scene& scene,
                                                   Allocator& allocator);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Unpack the nodes, skins and animations of an ipscene right
+  ///             away, and leave its meshes and textures to tasks posted to
+  ///             |task_runner|. Each mesh primitive is added to its node once
+  ///             it and its textures are resident, so that the scene can be
+  ///             displayed while the rest of it loads.
+  ///
+  ///             Only the parts of the mapping that are being unpacked are
+  ///             read, so file mappings are paged in as the scene loads.
+  ///             Loading stops early if the scene is collected.
+  ///
+  static std::shared_ptr<Node> MakeFromFlatbufferProgressively(
+      std::shared_ptr<const fml::Mapping> ipscene_mapping,
+      std::shared_ptr<Allocator> allocator,
+      const fml::RefPtr<fml::TaskRunner>& task_runner);
+
   Node();
   ~Node();
 
@@ -105,11 +133,13 @@ class Node final {
   void AddMutation(const MutationLog::Entry& entry);
 
  private:
+  static std::shared_ptr<Node> UnpackSceneGraphFromFlatbuffer(
+      const fb::Scene& scene,
+      std::vector<std::shared_ptr<Node>>& scene_nodes);
+
   void UnpackFromFlatbuffer(
       const fb::Node& node,
-      const std::vector<std::shared_ptr<Node>>& scene_nodes,
-      const std::vector<std::shared_ptr<Texture>>& textures,
-      Allocator& allocator);
+      const std::vector<std::shared_ptr<Node>>& scene_nodes);
 
   mutable MutationLog mutation_log_;
 
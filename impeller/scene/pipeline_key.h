@@ -22,10 +22,14 @@ enum class MaterialType {
 struct PipelineKey {
   GeometryType geometry_type = GeometryType::kUnskinned;
   MaterialType material_type = MaterialType::kUnlit;
+  // If the transforms of the instances are read from a storage buffer. Only
+  // unskinned geometry can be instanced.
+  bool is_instanced = false;
 
   struct Hash {
     constexpr std::size_t operator()(const PipelineKey& o) const {
-      return fml::HashCombine(o.geometry_type, o.material_type);
+      return fml::HashCombine(o.geometry_type, o.material_type,
+                              o.is_instanced);
     }
   };
 
@@ -33,7 +37,8 @@ struct PipelineKey {
     constexpr bool operator()(const PipelineKey& lhs,
                               const PipelineKey& rhs) const {
       return lhs.geometry_type == rhs.geometry_type &&
-             lhs.material_type == rhs.material_type;
+             lhs.material_type == rhs.material_type &&
+             lhs.is_instanced == rhs.is_instanced;
     }
   };
 };
@@ -3,11 +3,14 @@
 // found in the LICENSE file.
 
 #include "impeller/scene/scene_context.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/scene/material.h"
 #include "impeller/scene/shaders/skinned.vert.h"
+#include "impeller/scene/shaders/skinning.comp.h"
 #include "impeller/scene/shaders/unlit.frag.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -44,6 +47,22 @@ SceneContext::SceneContext(std::shared_ptr<Context> context)
           *context_);
   pipelines_[{PipelineKey{GeometryType::kSkinned, MaterialType::kUnlit}}] =
       MakePipelineVariants<SkinnedVertexShader, UnlitFragmentShader>(*context_);
+  if (context_->GetBackendFeatures().ssbo_support) {
+    pipelines_[{PipelineKey{GeometryType::kUnskinned, MaterialType::kUnlit,
+                            true}}] =
+        MakePipelineVariants<UnskinnedInstancedVertexShader,
+                             UnlitFragmentShader>(*context_);
+  }
+
+  if (context_->GetBackendFeatures().compute_shader_support) {
+    auto skinning_descriptor =
+        ComputePipelineBuilder<SkinningComputeShader>::
+            MakeDefaultPipelineDescriptor(*context_);
+    if (skinning_descriptor.has_value()) {
+      skinning_pipeline_ = context_->GetPipelineLibrary()->GetPipeline(
+          std::move(skinning_descriptor.value()));
+    }
+  }
 
   {
     impeller::TextureDescriptor texture_descriptor;
@@ -88,6 +107,11 @@ bool SceneContext::IsValid() const {
   return is_valid_;
 }
 
+std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+SceneContext::GetSkinningPipeline() const {
+  return skinning_pipeline_.IsValid() ? skinning_pipeline_.Get() : nullptr;
+}
+
 std::shared_ptr<Context> SceneContext::GetContext() const {
   return context_;
 }
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "impeller/renderer/compute_pipeline_descriptor.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
@@ -47,6 +48,13 @@ class SceneContext {
       PipelineKey key,
       SceneContextOptions opts) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The compute pipeline that poses skinned geometry, or null if
+  ///             the backend doesn't support compute.
+  ///
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>> GetSkinningPipeline()
+      const;
+
   std::shared_ptr<Context> GetContext() const;
 
   std::shared_ptr<Texture> GetPlaceholderTexture() const;
@@ -115,6 +123,8 @@ class SceneContext {
                      PipelineKey::Equal>
       pipelines_;
 
+  PipelineFuture<ComputePipelineDescriptor> skinning_pipeline_;
+
   std::shared_ptr<Context> context_;
 
   bool is_valid_ = false;
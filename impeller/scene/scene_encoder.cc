@@ -2,6 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "flutter/fml/macros.h"
 
 #include "flutter/fml/logging.h"
@@ -9,6 +14,7 @@
 #include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
 #include "impeller/scene/scene_encoder.h"
+#include "impeller/scene/skin.h"
 
 namespace impeller {
 namespace scene {
@@ -20,11 +26,197 @@ void SceneEncoder::Add(const SceneCommand& command) {
   commands_.push_back(command);
 }
 
-static void EncodeCommand(const SceneContext& scene_context,
-                          const Matrix& view_transform,
-                          RenderPass& render_pass,
-                          const SceneCommand& scene_command) {
+// Poses the skinned geometry of |commands| in a compute pass that is
+// submitted ahead of the render pass. The posed geometry of each command is
+// at the same index of the result, or null if it wasn't posed.
+static std::vector<std::shared_ptr<Geometry>> PoseSkinnedGeometry(
+    const SceneContext& scene_context,
+    const std::vector<SceneCommand>& commands) {
+  std::vector<std::shared_ptr<Geometry>> posed_geometry(commands.size());
+  if (!scene_context.GetSkinningPipeline()) {
+    return posed_geometry;
+  }
+
+  auto command_buffer = scene_context.GetContext()->CreateCommandBuffer();
+  if (!command_buffer) {
+    return posed_geometry;
+  }
+  command_buffer->SetLabel("Scene Skinning Command Buffer");
+  auto pass = command_buffer->CreateComputePass();
+  if (!pass || !pass->IsValid()) {
+    return posed_geometry;
+  }
+  pass->SetLabel("Scene Skinning");
+
+  size_t max_vertex_count = 0;
+  for (size_t i = 0; i < commands.size(); i++) {
+    const auto& command = commands[i];
+    if (!command.joints ||
+        command.geometry->GetGeometryType() != GeometryType::kSkinned) {
+      continue;
+    }
+    auto vertex_buffer = command.geometry->MakeSkinnedVertexBuffer(
+        scene_context, *pass, *command.joints);
+    if (!vertex_buffer.has_value()) {
+      continue;
+    }
+    const size_t vertex_count =
+        vertex_buffer->vertex_buffer.range.length / sizeof(fb::Vertex);
+    max_vertex_count = std::max(max_vertex_count, vertex_count);
+    posed_geometry[i] =
+        Geometry::MakeVertexBuffer(std::move(vertex_buffer.value()), false);
+  }
+  if (max_vertex_count == 0) {
+    return posed_geometry;
+  }
+
+  // Every command runs over the largest grid, and invocations past the end of
+  // the vertices of their geometry return early.
+  pass->SetGridSize(ISize(max_vertex_count, 1));
+  pass->SetThreadGroupSize(ISize(128, 1));
+  if (!pass->EncodeCommands() || !command_buffer->SubmitCommands()) {
+    FML_LOG(ERROR) << "Failed to pose skinned geometry. Skinning on the CPU.";
+    return std::vector<std::shared_ptr<Geometry>>(commands.size());
+  }
+  return posed_geometry;
+}
+
+namespace {
+
+struct SceneDraw {
+  const SceneCommand* command;
+  // The skinned geometry of the command posed in compute, if any.
+  Geometry* posed_geometry;
+  GeometryType geometry_type;
+  // The instances of a command that can't be drawn at once are drawn one at a
+  // time, each with a transform of its own.
+  Matrix transform;
+  // If all of the instances of the command are drawn at once.
+  bool is_instanced = false;
+  Scalar depth = 0;
+};
+
+}  // namespace
+
+// The depth that a draw of |command| with |mvp| is sorted by, or std::nullopt
+// if it's outside of the view frustum.
+static std::optional<Scalar> GetDrawDepth(const SceneCommand& command,
+                                          const Matrix& mvp) {
+  const auto& bounds = command.geometry->GetBounds();
+  // The bounds of skinned geometry don't account for the pose of its joints.
+  if (!bounds.has_value() || command.joints) {
+    return (mvp * Vector4(0, 0, 0, 1)).w;
+  }
+  if (!bounds->IntersectsClipSpace(mvp)) {
+    return std::nullopt;
+  }
+  return bounds->GetClipSpaceDepth(mvp);
+}
+
+// Drops the commands whose geometry is outside of the view frustum. The rest
+// is ordered so that opaque geometry is drawn first, front to back and grouped
+// by pipeline and material to minimize state changes. Translucent geometry is
+// drawn after it, back to front.
+static std::vector<SceneDraw> CullAndSortCommands(
+    const Matrix& view_transform,
+    const std::vector<SceneCommand>& commands,
+    const std::vector<std::shared_ptr<Geometry>>& posed_geometry,
+    bool supports_instancing) {
+  std::vector<SceneDraw> draws;
+  draws.reserve(commands.size());
+  for (size_t i = 0; i < commands.size(); i++) {
+    const auto& command = commands[i];
+    Geometry* geometry = posed_geometry[i].get();
+    SceneDraw draw = {
+        .command = &command,
+        .posed_geometry = geometry,
+        .geometry_type =
+            (geometry ? geometry : command.geometry)->GetGeometryType(),
+        .transform = command.transform,
+    };
+
+    if (!command.instance_transforms) {
+      if (auto depth = GetDrawDepth(command, view_transform * draw.transform)) {
+        draw.depth = depth.value();
+        draws.push_back(draw);
+      }
+      continue;
+    }
+
+    if (supports_instancing && command.instance_buffer &&
+        draw.geometry_type == GeometryType::kUnskinned) {
+      // Draw all of the instances if any of them is visible, at the depth of
+      // the nearest one.
+      std::optional<Scalar> depth;
+      for (const auto& instance : *command.instance_transforms) {
+        auto instance_depth =
+            GetDrawDepth(command, view_transform * draw.transform * instance);
+        if (instance_depth.has_value()) {
+          depth = std::min(depth.value_or(instance_depth.value()),
+                           instance_depth.value());
+        }
+      }
+      if (depth.has_value()) {
+        draw.is_instanced = true;
+        draw.depth = depth.value();
+        draws.push_back(draw);
+      }
+      continue;
+    }
+
+    for (const auto& instance : *command.instance_transforms) {
+      draw.transform = command.transform * instance;
+      if (auto depth = GetDrawDepth(command, view_transform * draw.transform)) {
+        draw.depth = depth.value();
+        draws.push_back(draw);
+      }
+    }
+  }
+
+  std::stable_sort(
+      draws.begin(), draws.end(), [](const SceneDraw& a, const SceneDraw& b) {
+        const Material* a_material = a.command->material;
+        const Material* b_material = b.command->material;
+        if (a_material->IsTranslucent() != b_material->IsTranslucent()) {
+          return !a_material->IsTranslucent();
+        }
+        if (a_material->IsTranslucent()) {
+          return a.depth > b.depth;
+        }
+        if (a.geometry_type != b.geometry_type) {
+          return a.geometry_type < b.geometry_type;
+        }
+        if (a.is_instanced != b.is_instanced) {
+          return a.is_instanced < b.is_instanced;
+        }
+        if (a_material->GetMaterialType() != b_material->GetMaterialType()) {
+          return a_material->GetMaterialType() < b_material->GetMaterialType();
+        }
+        if (a_material != b_material) {
+          return a_material < b_material;
+        }
+        return a.depth < b.depth;
+      });
+  return draws;
+}
+
+static void EncodeDraw(const SceneContext& scene_context,
+                       const Matrix& view_transform,
+                       RenderPass& render_pass,
+                       const SceneDraw& draw) {
   auto& host_buffer = render_pass.GetTransientsBuffer();
+  const SceneCommand& scene_command = *draw.command;
+
+  Geometry* geometry =
+      draw.posed_geometry ? draw.posed_geometry : scene_command.geometry;
+  if (!draw.posed_geometry && draw.geometry_type == GeometryType::kSkinned) {
+    geometry->SetJointsTexture(
+        scene_command.joints
+            ? Skin::MakeJointsTexture(
+                  *scene_context.GetContext()->GetResourceAllocator(),
+                  *scene_command.joints)
+            : nullptr);
+  }
 
   Command cmd;
   cmd.label = scene_command.label;
@@ -32,13 +224,19 @@ static void EncodeCommand(const SceneContext& scene_context,
       0;  // TODO(bdero): Configurable stencil ref per-command.
 
   cmd.pipeline = scene_context.GetPipeline(
-      PipelineKey{scene_command.geometry->GetGeometryType(),
-                  scene_command.material->GetMaterialType()},
+      PipelineKey{draw.geometry_type,
+                  scene_command.material->GetMaterialType(),
+                  draw.is_instanced},
       scene_command.material->GetContextOptions(render_pass));
 
-  scene_command.geometry->BindToCommand(
-      scene_context, host_buffer, view_transform * scene_command.transform,
-      cmd);
+  const Matrix mvp = view_transform * draw.transform;
+  if (draw.is_instanced) {
+    geometry->BindInstancesToCommand(scene_context, host_buffer, mvp,
+                                     scene_command.instance_buffer, cmd);
+    cmd.instance_count = scene_command.instance_transforms->size();
+  } else {
+    geometry->BindToCommand(scene_context, host_buffer, mvp, cmd);
+  }
   scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
 
   render_pass.AddCommand(std::move(cmd));
@@ -48,6 +246,8 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     const SceneContext& scene_context,
     const Matrix& camera_transform,
     RenderTarget render_target) const {
+  auto posed_geometry = PoseSkinnedGeometry(scene_context, commands_);
+
   {
     TextureDescriptor ds_texture;
     ds_texture.type = TextureType::kTexture2DMultisample;
@@ -90,8 +290,12 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  const bool supports_instancing =
+      scene_context.GetContext()->GetBackendFeatures().ssbo_support;
+  for (const auto& draw : CullAndSortCommands(camera_transform, commands_,
+                                              posed_geometry,
+                                              supports_instancing)) {
+    EncodeDraw(scene_context, camera_transform, *render_pass, draw);
   }
 
   if (!render_pass->EncodeCommands()) {
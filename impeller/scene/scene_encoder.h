@@ -24,6 +24,13 @@ struct SceneCommand {
   Matrix transform;
   Geometry* geometry;
   Material* material;
+  // The transforms of the joints that pose skinned geometry, if any.
+  std::shared_ptr<const std::vector<Matrix>> joints;
+  // The transforms of the instances of the geometry relative to |transform|,
+  // if it's instanced.
+  std::shared_ptr<const std::vector<Matrix>> instance_transforms;
+  // The instance transforms on the GPU.
+  BufferView instance_buffer;
 };
 
 class SceneEncoder {
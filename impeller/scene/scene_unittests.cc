@@ -2,11 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <vector>
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/testing/testing.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/constants.h"
@@ -16,14 +19,21 @@
 #include "impeller/image/decompressed_image.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_command.h"
 #include "impeller/renderer/formats.h"
+#include "impeller/scene/aabb.h"
 #include "impeller/scene/animation/animation_clip.h"
 #include "impeller/scene/camera.h"
 #include "impeller/scene/geometry.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/material.h"
 #include "impeller/scene/mesh.h"
 #include "impeller/scene/scene.h"
+#include "impeller/scene/scene_context.h"
+#include "impeller/scene/shaders/skinning.comp.h"
+#include "impeller/scene/skin.h"
 #include "third_party/flatbuffers/include/flatbuffers/verifier.h"
 #include "third_party/imgui/imgui.h"
 
@@ -34,6 +44,42 @@ namespace testing {
 using SceneTest = PlaygroundTest;
 INSTANTIATE_PLAYGROUND_SUITE(SceneTest);
 
+namespace {
+
+fb::SkinnedVertex MakeSkinnedVertex(fb::Vec3 position,
+                                    fb::Vec4 joints,
+                                    fb::Vec4 weights) {
+  return fb::SkinnedVertex(
+      fb::Vertex(position, fb::Vec3(0, 1, 0), fb::Vec4(1, 0, 0, -1),
+                 fb::Vec2(0.25, 0.75), fb::Color(1, 0.5, 0.25, 1)),
+      joints, weights);
+}
+
+}  // namespace
+
+TEST(AABBTest, IntersectsClipSpace) {
+  auto mvp = Matrix::MakePerspective(Degrees(60), ISize(100, 100), 0.1, 100) *
+             Matrix::MakeLookAt({0, 0, -5}, {0, 0, 0}, {0, 1, 0});
+  AABB box = {.min = {-1, -1, -1}, .max = {1, 1, 1}};
+
+  ASSERT_TRUE(box.IntersectsClipSpace(mvp));
+  // Behind the camera.
+  ASSERT_FALSE(
+      box.IntersectsClipSpace(mvp * Matrix::MakeTranslation({0, 0, -10})));
+  // Beyond the far plane.
+  ASSERT_FALSE(
+      box.IntersectsClipSpace(mvp * Matrix::MakeTranslation({0, 0, 200})));
+  // Off to the side.
+  ASSERT_FALSE(
+      box.IntersectsClipSpace(mvp * Matrix::MakeTranslation({50, 0, 0})));
+  // Straddling the edge of the view.
+  ASSERT_TRUE(
+      box.IntersectsClipSpace(mvp * Matrix::MakeTranslation({3, 0, 0})));
+
+  ASSERT_LT(box.GetClipSpaceDepth(mvp),
+            box.GetClipSpaceDepth(mvp * Matrix::MakeTranslation({0, 0, 10})));
+}
+
 TEST_P(SceneTest, CuboidUnlit) {
   auto scene_context = std::make_shared<SceneContext>(GetContext());
 
@@ -70,6 +116,49 @@ TEST_P(SceneTest, CuboidUnlit) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(SceneTest, CuboidUnlitInstanced) {
+  auto scene_context = std::make_shared<SceneContext>(GetContext());
+
+  Renderer::RenderCallback callback = [&](RenderTarget& render_target) {
+    auto scene = Scene(scene_context);
+
+    {
+      Mesh mesh;
+
+      auto material = Material::MakeUnlit();
+      material->SetColor(Color::Red());
+
+      Vector3 size(1, 1, 0);
+      mesh.AddPrimitive({Geometry::MakeCuboid(size), std::move(material)});
+
+      std::vector<Matrix> instances;
+      for (int x = -2; x <= 2; x++) {
+        for (int y = -2; y <= 2; y++) {
+          instances.push_back(Matrix::MakeTranslation({x * 1.5f, y * 1.5f, 0}));
+        }
+      }
+      mesh.SetInstanceTransforms(std::move(instances));
+
+      Node& root = scene.GetRoot();
+      root.SetLocalTransform(Matrix::MakeTranslation(-size / 2));
+      root.SetMesh(std::move(mesh));
+    }
+
+    // Face towards the +Z direction (+X right, +Y up).
+    auto camera = Camera::MakePerspective(
+                      /* fov */ Radians(kPiOver4),
+                      /* position */ {2, 2, -12})
+                      .LookAt(
+                          /* target */ Vector3(),
+                          /* up */ {0, 1, 0});
+
+    scene.Render(render_target, camera);
+    return true;
+  };
+
+  OpenPlaygroundHere(callback);
+}
+
 TEST_P(SceneTest, FlutterLogo) {
   auto allocator = GetContext()->GetResourceAllocator();
 
@@ -110,6 +199,42 @@ TEST_P(SceneTest, FlutterLogo) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(SceneTest, FlutterLogoLoadedProgressively) {
+  auto allocator = GetContext()->GetResourceAllocator();
+
+  std::shared_ptr<const fml::Mapping> mapping =
+      flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb.ipscene");
+  ASSERT_NE(mapping, nullptr);
+
+  fml::Thread io_thread("io");
+  std::shared_ptr<Node> gltf_scene = Node::MakeFromFlatbufferProgressively(
+      mapping, allocator, io_thread.GetTaskRunner());
+  ASSERT_NE(gltf_scene, nullptr);
+  ASSERT_EQ(gltf_scene->GetChildren().size(), 1u);
+  // The mesh is added when the scene is next rendered.
+  ASSERT_TRUE(gltf_scene->GetChildren()[0]->GetMesh().GetPrimitives().empty());
+
+  fml::AutoResetWaitableEvent uploaded;
+  io_thread.GetTaskRunner()->PostTask([&uploaded]() { uploaded.Signal(); });
+  uploaded.Wait();
+
+  auto logo = gltf_scene->GetChildren()[0];
+  auto scene_context = std::make_shared<SceneContext>(GetContext());
+  auto scene = Scene(scene_context);
+  scene.GetRoot().AddChild(std::move(gltf_scene));
+  scene.GetRoot().SetLocalTransform(Matrix::MakeScale({3, 3, 3}));
+
+  Renderer::RenderCallback callback = [&](RenderTarget& render_target) {
+    auto camera = Camera::MakePerspective(Degrees(60), {-1, -1.5, -5})
+                      .LookAt(Vector3(), {0, 1, 0});
+    scene.Render(render_target, camera);
+    EXPECT_EQ(logo->GetMesh().GetPrimitives().size(), 1u);
+    return true;
+  };
+
+  OpenPlaygroundHere(callback);
+}
+
 TEST_P(SceneTest, TwoTriangles) {
   auto allocator = GetContext()->GetResourceAllocator();
 
@@ -297,6 +422,163 @@ TEST_P(SceneTest, Dash) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(SceneTest, JointsTextureFitsTheJointTransforms) {
+  auto allocator = GetContext()->GetResourceAllocator();
+
+  // Each joint takes four pixels.
+  auto texture = Skin::MakeJointsTexture(*allocator, {Matrix()});
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(texture->GetSize(), ISize(2, 2));
+  ASSERT_EQ(texture->GetTextureDescriptor().format,
+            PixelFormat::kR32G32B32A32Float);
+
+  texture = Skin::MakeJointsTexture(*allocator, std::vector<Matrix>(5u));
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(texture->GetSize(), ISize(8, 8));
+}
+
+TEST_P(SceneTest, SkinningShaderPosesVerticesWithTheirJoints) {
+  using CS = SkinningComputeShader;
+
+  auto context = GetContext();
+  if (!context->GetBackendFeatures().compute_shader_support) {
+    GTEST_SKIP_("Skinning on the GPU requires compute.");
+  }
+  SceneContext scene_context(context);
+  auto pipeline = scene_context.GetSkinningPipeline();
+  ASSERT_TRUE(pipeline);
+
+  const std::vector<fb::SkinnedVertex> skinned_vertices = {
+      MakeSkinnedVertex({1, 0, 0}, {0, 1, 0, 0}, {1, 0, 0, 0}),
+      MakeSkinnedVertex({1, 0, 0}, {0, 1, 0, 0}, {0.5, 0.5, 0, 0}),
+  };
+  const std::vector<Matrix> joint_transforms = {
+      Matrix::MakeTranslation({0, 2, 0}),
+      Matrix::MakeScale({2, 2, 2}),
+  };
+  auto allocator = context->GetResourceAllocator();
+  auto input = allocator->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(skinned_vertices.data()),
+      skinned_vertices.size() * sizeof(fb::SkinnedVertex));
+  DeviceBufferDescriptor output_desc;
+  output_desc.storage_mode = StorageMode::kHostVisible;
+  output_desc.size = skinned_vertices.size() * sizeof(fb::Vertex);
+  auto output = allocator->CreateBuffer(output_desc);
+  ASSERT_TRUE(input && output);
+
+  auto command_buffer = context->CreateCommandBuffer();
+  auto pass = command_buffer->CreateComputePass();
+  ASSERT_TRUE(pass && pass->IsValid());
+  pass->SetGridSize(ISize(skinned_vertices.size(), 1));
+  pass->SetThreadGroupSize(ISize(skinned_vertices.size(), 1));
+
+  ComputeCommand cmd;
+  cmd.label = "Skinning";
+  cmd.pipeline = pipeline;
+  auto& host_buffer = pass->GetTransientsBuffer();
+  CS::SkinningInfo info;
+  info.vertex_count = skinned_vertices.size();
+  CS::BindSkinningInfo(cmd, host_buffer.EmplaceUniform(info));
+  CS::BindSkinnedVertices(cmd, input->AsBufferView());
+  CS::BindJoints(
+      cmd, host_buffer.Emplace(
+               joint_transforms.data(),
+               joint_transforms.size() * sizeof(Matrix),
+               std::max(alignof(Matrix), DefaultUniformAlignment())));
+  CS::BindVertices(cmd, output->AsBufferView());
+  ASSERT_TRUE(pass->AddCommand(std::move(cmd)));
+  ASSERT_TRUE(pass->EncodeCommands());
+
+  fml::AutoResetWaitableEvent latch;
+  CommandBuffer::Status status = CommandBuffer::Status::kPending;
+  ASSERT_TRUE(command_buffer->SubmitCommands(
+      [&latch, &status](CommandBuffer::Status submitted_status) {
+        status = submitted_status;
+        latch.Signal();
+      }));
+  latch.Wait();
+  ASSERT_EQ(status, CommandBuffer::Status::kCompleted);
+
+  auto vertices =
+      reinterpret_cast<const fb::Vertex*>(output->AsBufferView().contents);
+  auto expect_vector = [](Vector3 actual, Vector3 expected) {
+    EXPECT_NEAR(actual.x, expected.x, 1e-5);
+    EXPECT_NEAR(actual.y, expected.y, 1e-5);
+    EXPECT_NEAR(actual.z, expected.z, 1e-5);
+  };
+  auto tangent = [](const fb::Vertex& vertex) {
+    return Vector3(vertex.tangent().x(), vertex.tangent().y(),
+                   vertex.tangent().z());
+  };
+  // Translations don't move normals and tangents.
+  expect_vector(importer::ToVector3(vertices[0].position()), {1, 2, 0});
+  expect_vector(importer::ToVector3(vertices[0].normal()), {0, 1, 0});
+  expect_vector(tangent(vertices[0]), {1, 0, 0});
+  // The joints are blended by their weights.
+  expect_vector(importer::ToVector3(vertices[1].position()), {1.5, 1, 0});
+  expect_vector(importer::ToVector3(vertices[1].normal()), {0, 1.5, 0});
+  expect_vector(tangent(vertices[1]), {1.5, 0, 0});
+  // The handedness, texture coordinates and color are passed through.
+  for (size_t i = 0u; i < skinned_vertices.size(); i++) {
+    EXPECT_EQ(vertices[i].tangent().w(), -1);
+    EXPECT_EQ(vertices[i].texture_coords().x(), 0.25);
+    EXPECT_EQ(vertices[i].texture_coords().y(), 0.75);
+    EXPECT_EQ(vertices[i].color().r(), 1);
+    EXPECT_EQ(vertices[i].color().g(), 0.5);
+    EXPECT_EQ(vertices[i].color().b(), 0.25);
+    EXPECT_EQ(vertices[i].color().a(), 1);
+  }
+}
+
+TEST_P(SceneTest, OnlySkinnedGeometryIsPosedOnTheGPU) {
+  auto context = GetContext();
+  if (!context->GetBackendFeatures().compute_shader_support) {
+    GTEST_SKIP_("Skinning on the GPU requires compute.");
+  }
+  SceneContext scene_context(context);
+  auto command_buffer = context->CreateCommandBuffer();
+  auto pass = command_buffer->CreateComputePass();
+  ASSERT_TRUE(pass && pass->IsValid());
+
+  const std::vector<fb::SkinnedVertex> skinned_vertices(
+      3u, MakeSkinnedVertex({0, 0, 0}, {0, 0, 0, 0}, {1, 0, 0, 0}));
+  const std::vector<uint16_t> indices = {0, 1, 2};
+  auto allocator = context->GetResourceAllocator();
+  auto vertex_buffer = allocator->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(skinned_vertices.data()),
+      skinned_vertices.size() * sizeof(fb::SkinnedVertex));
+  auto index_buffer = allocator->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(indices.data()),
+      indices.size() * sizeof(uint16_t));
+  ASSERT_TRUE(vertex_buffer && index_buffer);
+  auto geometry = Geometry::MakeVertexBuffer(
+      VertexBuffer{
+          .vertex_buffer = vertex_buffer->AsBufferView(),
+          .index_buffer = index_buffer->AsBufferView(),
+          .index_count = indices.size(),
+          .index_type = IndexType::k16bit,
+      },
+      /*is_skinned=*/true);
+  ASSERT_EQ(geometry->GetGeometryType(), GeometryType::kSkinned);
+
+  // The posed vertices are unskinned and drawn with the same indices.
+  auto posed =
+      geometry->MakeSkinnedVertexBuffer(scene_context, *pass, {Matrix()});
+  ASSERT_TRUE(posed.has_value());
+  EXPECT_EQ(posed->vertex_buffer.range.length,
+            skinned_vertices.size() * sizeof(fb::Vertex));
+  EXPECT_EQ(posed->index_buffer.buffer, index_buffer);
+  EXPECT_EQ(posed->index_count, indices.size());
+  EXPECT_EQ(posed->index_type, IndexType::k16bit);
+
+  // There is nothing to pose without joints.
+  EXPECT_FALSE(
+      geometry->MakeSkinnedVertexBuffer(scene_context, *pass, {}).has_value());
+  EXPECT_FALSE(Geometry::MakeCuboid({1, 1, 1})
+                   ->MakeSkinnedVertexBuffer(scene_context, *pass, {Matrix()})
+                   .has_value());
+}
+
 }  // namespace testing
 }  // namespace scene
 }  // namespace impeller
@@ -62,30 +62,8 @@ Skin::Skin(Skin&&) = default;
 
 Skin& Skin::operator=(Skin&&) = default;
 
-std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
-  // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
-  // Therefore, each joint needs 4 pixels.
-  auto required_pixels = joints_.size() * 4;
-  auto dimension_size = std::max(
-      2u,
-      Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
-
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
-  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
-  texture_descriptor.size = {dimension_size, dimension_size};
-  texture_descriptor.mip_count = 1u;
-
-  auto result = allocator.CreateTexture(texture_descriptor);
-  result->SetLabel("Joints Texture");
-  if (!result) {
-    FML_LOG(ERROR) << "Could not create joint texture.";
-    return nullptr;
-  }
-
-  std::vector<Matrix> joints;
-  joints.resize(result->GetSize().Area() / 4, Matrix());
-  FML_DCHECK(joints.size() >= joints_.size());
+std::vector<Matrix> Skin::GetJointTransforms() const {
+  std::vector<Matrix> joints(joints_.size(), Matrix());
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
     const Node* joint = joints_[joint_i].get();
     if (!joint) {
@@ -109,7 +87,34 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     // the default pose) are all in model space.
     joints[joint_i] = joints[joint_i] * inverse_bind_matrices_[joint_i];
   }
+  return joints;
+}
 
+std::shared_ptr<Texture> Skin::MakeJointsTexture(
+    Allocator& allocator,
+    const std::vector<Matrix>& joint_transforms) {
+  // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
+  // Therefore, each joint needs 4 pixels.
+  auto required_pixels = joint_transforms.size() * 4;
+  auto dimension_size = std::max(
+      2u,
+      Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
+  texture_descriptor.size = {dimension_size, dimension_size};
+  texture_descriptor.mip_count = 1u;
+
+  auto result = allocator.CreateTexture(texture_descriptor);
+  if (!result) {
+    FML_LOG(ERROR) << "Could not create joint texture.";
+    return nullptr;
+  }
+  result->SetLabel("Joints Texture");
+
+  std::vector<Matrix> joints = joint_transforms;
+  joints.resize(result->GetSize().Area() / 4, Matrix());
   if (!result->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
                            joints.size() * sizeof(Matrix))) {
     FML_LOG(ERROR) << "Could not set contents of joint texture.";
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 
@@ -27,7 +28,19 @@ class Skin final {
   Skin(Skin&&);
   Skin& operator=(Skin&&);
 
-  std::shared_ptr<Texture> GetJointsTexture(Allocator& allocator);
+  //----------------------------------------------------------------------------
+  /// @brief      The model space transforms of the joints relative to their
+  ///             bind pose, for the current pose of the joint nodes.
+  ///
+  std::vector<Matrix> GetJointTransforms() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a texture that the skinned vertex shader can read the
+  ///             joint transforms from, for backends without compute.
+  ///
+  static std::shared_ptr<Texture> MakeJointsTexture(
+      Allocator& allocator,
+      const std::vector<Matrix>& joint_transforms);
 
  private:
   Skin();
@@ -64,6 +64,7 @@ Tessellator::Result Tessellator::Tessellate(
     return Result::kInputError;
   }
 
+  std::scoped_lock lock(c_tessellator_mutex_);
   auto tessellator = c_tessellator_.get();
   if (!tessellator) {
     return Result::kTessellationError;
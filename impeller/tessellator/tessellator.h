@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -63,6 +64,9 @@ class Tessellator {
                                  const BuilderCallback& callback) const;
 
  private:
+  // The C tessellator is stateful, guard it so that geometry may be
+  // tessellated from entity passes encoded on worker threads.
+  mutable std::mutex c_tessellator_mutex_;
   CTessellator c_tessellator_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Tessellator);
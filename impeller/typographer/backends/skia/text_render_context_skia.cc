@@ -4,12 +4,20 @@
 
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/allocator.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -32,6 +40,114 @@ TextRenderContextSkia::TextRenderContextSkia(std::shared_ptr<Context> context)
 
 TextRenderContextSkia::~TextRenderContextSkia() = default;
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// @brief      Glyphs rasterized ahead of time, typically on a worker, and the
+///             signed-distance fields of glyphs, keyed by the type of atlas
+///             they were rendered for.
+///
+///             Entries are kept after being copied into an atlas so that
+///             atlases regenerated later can reuse them. The cache is reset
+///             when it grows past its budget.
+///
+class PrerasterizedGlyphCache {
+ public:
+  static PrerasterizedGlyphCache& GetInstance() {
+    static PrerasterizedGlyphCache* cache = new PrerasterizedGlyphCache();
+    return *cache;
+  }
+
+  bool Contains(const FontGlyphPair& pair, GlyphAtlas::Type type) const {
+    Lock lock(mutex_);
+    const auto& glyphs = GetGlyphs(type);
+    return glyphs.find(pair) != glyphs.end();
+  }
+
+  std::shared_ptr<SkBitmap> Find(const FontGlyphPair& pair,
+                                 GlyphAtlas::Type type) const {
+    Lock lock(mutex_);
+    const auto& glyphs = GetGlyphs(type);
+    auto found = glyphs.find(pair);
+    return found == glyphs.end() ? nullptr : found->second;
+  }
+
+  /// The bitmap may be null for glyphs that have nothing to rasterize so
+  /// that they are not attempted again.
+  void Insert(const FontGlyphPair& pair,
+              GlyphAtlas::Type type,
+              std::shared_ptr<SkBitmap> bitmap) {
+    const size_t bytes = bitmap ? bitmap->computeByteSize() : 0u;
+    Lock lock(mutex_);
+    if (byte_size_ + bytes > kMaxByteSize) {
+      ClearLocked();
+    }
+    auto& glyphs = GetGlyphs(type);
+    if (glyphs.emplace(pair, std::move(bitmap)).second) {
+      byte_size_ += bytes;
+    }
+  }
+
+  size_t GetCount() const {
+    Lock lock(mutex_);
+    return alpha_glyphs_.size() + color_glyphs_.size() + sdf_glyphs_.size();
+  }
+
+  size_t GetByteSize() const {
+    Lock lock(mutex_);
+    return byte_size_;
+  }
+
+  void Clear() {
+    Lock lock(mutex_);
+    ClearLocked();
+  }
+
+ private:
+  static constexpr size_t kMaxByteSize = 4u * 1024u * 1024u;
+
+  using GlyphMap = std::unordered_map<FontGlyphPair,
+                                      std::shared_ptr<SkBitmap>,
+                                      FontGlyphPair::Hash,
+                                      FontGlyphPair::Equal>;
+
+  mutable Mutex mutex_;
+  GlyphMap alpha_glyphs_ IPLR_GUARDED_BY(mutex_);
+  GlyphMap color_glyphs_ IPLR_GUARDED_BY(mutex_);
+  GlyphMap sdf_glyphs_ IPLR_GUARDED_BY(mutex_);
+  size_t byte_size_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  PrerasterizedGlyphCache() = default;
+
+  void ClearLocked() IPLR_REQUIRES(mutex_) {
+    alpha_glyphs_.clear();
+    color_glyphs_.clear();
+    sdf_glyphs_.clear();
+    byte_size_ = 0u;
+  }
+
+  GlyphMap& GetGlyphs(GlyphAtlas::Type type) IPLR_REQUIRES(mutex_) {
+    switch (type) {
+      case GlyphAtlas::Type::kSignedDistanceField:
+        return sdf_glyphs_;
+      case GlyphAtlas::Type::kAlphaBitmap:
+        return alpha_glyphs_;
+      case GlyphAtlas::Type::kColorBitmap:
+        return color_glyphs_;
+    }
+    FML_UNREACHABLE();
+  }
+
+  const GlyphMap& GetGlyphs(GlyphAtlas::Type type) const
+      IPLR_REQUIRES(mutex_) {
+    return const_cast<PrerasterizedGlyphCache*>(this)->GetGlyphs(type);
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PrerasterizedGlyphCache);
+};
+
+}  // namespace
+
 static FontGlyphPair::Set CollectUniqueFontGlyphPairsSet(
     GlyphAtlas::Type type,
     const TextRenderContext::FrameIterator& frame_iterator) {
@@ -39,11 +155,9 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairsSet(
   while (auto frame = frame_iterator()) {
     for (const auto& run : frame->GetRuns()) {
       auto font = run.GetFont();
-      // TODO(dnfield): If we're doing SDF here, we should be using a consistent
-      // point size.
-      // https://github.com/flutter/flutter/issues/112016
       for (const auto& glyph_position : run.GetGlyphPositions()) {
-        set.insert({font, glyph_position.glyph});
+        set.insert(
+            GlyphAtlas::GetAtlasPair(type, {font, glyph_position.glyph}));
       }
     }
   }
@@ -63,7 +177,23 @@ static FontGlyphPair::Vector CollectUniqueFontGlyphPairs(
   return vector;
 }
 
+/// The size of the region of an atlas of the given type that holds the glyph
+/// of a pair, without the padding between glyphs. Signed-distance fields
+/// include the margin over which the distance falls off.
+static ISize GetAtlasGlyphSize(GlyphAtlas::Type type,
+                               const FontGlyphPair& pair) {
+  auto size =
+      ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
+  if (type == GlyphAtlas::Type::kSignedDistanceField && !size.IsEmpty()) {
+    constexpr auto kMargin =
+        static_cast<int64_t>(2 * GlyphAtlas::kSignedDistanceFieldSpread);
+    size = ISize::MakeWH(size.width + kMargin, size.height + kMargin);
+  }
+  return size;
+}
+
 static size_t PairsFitInAtlasOfSize(
+    GlyphAtlas::Type type,
     const FontGlyphPair::Vector& pairs,
     const ISize& atlas_size,
     std::vector<Rect>& glyph_positions,
@@ -78,8 +208,7 @@ static size_t PairsFitInAtlasOfSize(
   for (size_t i = 0; i < pairs.size(); i++) {
     const auto& pair = pairs[i];
 
-    const auto glyph_size =
-        ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
+    const auto glyph_size = GetAtlasGlyphSize(type, pair);
     SkIPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -116,8 +245,7 @@ static bool CanAppendToExistingAtlas(
   for (size_t i = 0; i < extra_pairs.size(); i++) {
     const auto& pair = extra_pairs[i];
 
-    const auto glyph_size =
-        ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
+    const auto glyph_size = GetAtlasGlyphSize(atlas->GetType(), pair);
     SkIPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -136,6 +264,7 @@ static bool CanAppendToExistingAtlas(
 }
 
 static ISize OptimumAtlasSizeForFontGlyphPairs(
+    GlyphAtlas::Type type,
     const FontGlyphPair::Vector& pairs,
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<GlyphAtlasContext>& atlas_context) {
@@ -150,8 +279,8 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
     auto rect_packer = std::shared_ptr<GrRectanizer>(
         GrRectanizer::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs = PairsFitInAtlasOfSize(
+        type, pairs, current_size, glyph_positions, rect_packer);
     if (remaining_pairs == 0) {
       atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
@@ -170,119 +299,115 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   return ISize{0, 0};
 }
 
-/// Compute signed-distance field for an 8-bpp grayscale image (values greater
-/// than 127 are considered "on") For details of this algorithm, see "The 'dead
-/// reckoning' signed distance transform" [Grevera 2004]
-static void ConvertBitmapToSignedDistanceField(uint8_t* pixels,
-                                               uint16_t width,
-                                               uint16_t height) {
-  if (!pixels || width == 0 || height == 0) {
-    return;
-  }
-
-  using ShortPoint = TPoint<uint16_t>;
-
-  // distance to nearest boundary point map
-  std::vector<Scalar> distance_map(width * height);
-  // nearest boundary point map
-  std::vector<ShortPoint> boundary_point_map(width * height);
-
-  // Some helpers for manipulating the above arrays
-#define image(_x, _y) (pixels[(_y)*width + (_x)] > 0x7f)
-#define distance(_x, _y) distance_map[(_y)*width + (_x)]
-#define nearestpt(_x, _y) boundary_point_map[(_y)*width + (_x)]
-
-  const Scalar maxDist = hypot(width, height);
-  const Scalar distUnit = 1;
-  const Scalar distDiag = sqrt(2);
-
-  // Initialization phase: set all distances to "infinity"; zero out nearest
-  // boundary point map
-  for (uint16_t y = 0; y < height; ++y) {
-    for (uint16_t x = 0; x < width; ++x) {
-      distance(x, y) = maxDist;
-      nearestpt(x, y) = ShortPoint{0, 0};
-    }
-  }
-
-  // Immediate interior/exterior phase: mark all points along the boundary as
-  // such
-  for (uint16_t y = 1; y < height - 1; ++y) {
-    for (uint16_t x = 1; x < width - 1; ++x) {
-      bool inside = image(x, y);
-      if (image(x - 1, y) != inside || image(x + 1, y) != inside ||
-          image(x, y - 1) != inside || image(x, y + 1) != inside) {
-        distance(x, y) = 0;
-        nearestpt(x, y) = ShortPoint{x, y};
+/// Compute the squared distances of `length` values of `grid`, `stride`
+/// apart, in place. For details of this algorithm, see "Distance Transforms of
+/// Sampled Functions" [Felzenszwalb and Huttenlocher 2012].
+///
+/// The scratch buffers `f` and `v` hold `length` values, and `z` one more.
+static void SquaredDistanceTransform1D(double* grid,
+                                       size_t stride,
+                                       size_t length,
+                                       double* f,
+                                       double* z,
+                                       size_t* v) {
+  constexpr double kInfinity = 1e20;
+  v[0] = 0;
+  z[0] = -kInfinity;
+  z[1] = kInfinity;
+  f[0] = grid[0];
+  for (size_t q = 1, k = 0; q < length; q++) {
+    f[q] = grid[q * stride];
+    double s;
+    while (true) {
+      const size_t r = v[k];
+      s = (f[q] - f[r] + static_cast<double>(q * q) -
+           static_cast<double>(r * r)) /
+          static_cast<double>(q - r) / 2.0;
+      if (s > z[k] || k == 0) {
+        break;
       }
+      k--;
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kInfinity;
+  }
+  for (size_t q = 0, k = 0; q < length; q++) {
+    while (z[k + 1] < static_cast<double>(q)) {
+      k++;
     }
+    const auto qr = static_cast<double>(q) - static_cast<double>(v[k]);
+    grid[q * stride] = f[v[k]] + qr * qr;
   }
+}
 
-  // Forward dead-reckoning pass
-  for (uint16_t y = 1; y < height - 2; ++y) {
-    for (uint16_t x = 1; x < width - 2; ++x) {
-      if (distance_map[(y - 1) * width + (x - 1)] + distDiag < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x - 1, y - 1);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-      if (distance(x, y - 1) + distUnit < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x, y - 1);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-      if (distance(x + 1, y - 1) + distDiag < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x + 1, y - 1);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-      if (distance(x - 1, y) + distUnit < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x - 1, y);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-    }
+static void SquaredDistanceTransform2D(std::vector<double>& grid,
+                                       size_t width,
+                                       size_t height) {
+  const auto length = std::max(width, height);
+  std::vector<double> f(length);
+  std::vector<double> z(length + 1);
+  std::vector<size_t> v(length);
+  for (size_t x = 0; x < width; x++) {
+    SquaredDistanceTransform1D(grid.data() + x, width, height, f.data(),
+                               z.data(), v.data());
+  }
+  for (size_t y = 0; y < height; y++) {
+    SquaredDistanceTransform1D(grid.data() + y * width, 1, width, f.data(),
+                               z.data(), v.data());
   }
+}
 
-  // Backward dead-reckoning pass
-  for (uint16_t y = height - 2; y >= 1; --y) {
-    for (uint16_t x = width - 2; x >= 1; --x) {
-      if (distance(x + 1, y) + distUnit < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x + 1, y);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-      if (distance(x - 1, y + 1) + distDiag < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x - 1, y + 1);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-      if (distance(x, y + 1) + distUnit < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x, y + 1);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
-      }
-      if (distance(x + 1, y + 1) + distDiag < distance(x, y)) {
-        nearestpt(x, y) = nearestpt(x + 1, y + 1);
-        distance(x, y) = hypot(x - nearestpt(x, y).x, y - nearestpt(x, y).y);
+/// Replace the coverage of a glyph in an 8-bpp alpha image by its
+/// signed-distance field. The outline maps to 50%, and the distance falls
+/// off linearly to 0% and 100% over `spread` pixels outside and inside.
+///
+/// Partially covered pixels place the outline within the pixel, so the field
+/// is accurate to a fraction of a pixel, unlike a thresholded image.
+static void ConvertBitmapToSignedDistanceField(uint8_t* pixels,
+                                               size_t width,
+                                               size_t height,
+                                               size_t row_bytes,
+                                               Scalar spread) {
+  if (!pixels || width == 0 || height == 0) {
+    return;
+  }
+  constexpr double kInfinity = 1e20;
+
+  // The squared distances to the outline from outside and inside the glyph.
+  std::vector<double> outer(width * height);
+  std::vector<double> inner(width * height);
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      const auto coverage = pixels[y * row_bytes + x] / 255.0;
+      const auto i = y * width + x;
+      if (coverage >= 1.0) {
+        outer[i] = 0.0;
+        inner[i] = kInfinity;
+      } else if (coverage <= 0.0) {
+        outer[i] = kInfinity;
+        inner[i] = 0.0;
+      } else {
+        const auto offset = 0.5 - coverage;
+        outer[i] = offset > 0.0 ? offset * offset : 0.0;
+        inner[i] = offset < 0.0 ? offset * offset : 0.0;
       }
     }
   }
 
-  // Interior distance negation pass; distances outside the figure are
-  // considered negative
-  // Also does final quantization.
-  for (uint16_t y = 0; y < height; ++y) {
-    for (uint16_t x = 0; x < width; ++x) {
-      if (!image(x, y)) {
-        distance(x, y) = -distance(x, y);
-      }
+  SquaredDistanceTransform2D(outer, width, height);
+  SquaredDistanceTransform2D(inner, width, height);
 
-      float norm_factor = 13.5;
-      float dist = distance(x, y);
-      float clamped_dist = fmax(-norm_factor, fmin(dist, norm_factor));
-      float scaled_dist = clamped_dist / norm_factor;
-      uint8_t quantized_value = ((scaled_dist + 1) / 2) * UINT8_MAX;
-      pixels[y * width + x] = quantized_value;
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      const auto i = y * width + x;
+      const auto distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+      const auto value = std::clamp(0.5 - distance / (2.0 * spread), 0.0, 1.0);
+      pixels[y * row_bytes + x] =
+          static_cast<uint8_t>(std::round(value * UINT8_MAX));
     }
   }
-
-#undef image
-#undef distance
-#undef nearestpt
 }
 
 static void DrawGlyph(SkCanvas* canvas,
@@ -318,6 +443,103 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
+/// Render a glyph into its own bitmap along with the padding around it that
+/// the atlas reserves for it. Glyphs of signed-distance field atlases are
+/// converted to their distance field.
+static std::shared_ptr<SkBitmap> RasterizeGlyph(const FontGlyphPair& pair,
+                                                GlyphAtlas::Type type) {
+  const auto glyph_size = GetAtlasGlyphSize(type, pair);
+  if (glyph_size.IsEmpty()) {
+    return nullptr;
+  }
+  const bool has_color = type == GlyphAtlas::Type::kColorBitmap;
+  const auto width = glyph_size.width + kPadding;
+  const auto height = glyph_size.height + kPadding;
+  auto image_info = has_color ? SkImageInfo::MakeN32Premul(width, height)
+                              : SkImageInfo::MakeA8(width, height);
+  auto bitmap = std::make_shared<SkBitmap>();
+  if (!bitmap->tryAllocPixels(image_info)) {
+    return nullptr;
+  }
+  bitmap->eraseColor(SK_ColorTRANSPARENT);
+  auto surface = SkSurface::MakeRasterDirect(bitmap->pixmap());
+  if (!surface || !surface->getCanvas()) {
+    return nullptr;
+  }
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    constexpr auto kSpread = GlyphAtlas::kSignedDistanceFieldSpread;
+    DrawGlyph(surface->getCanvas(), pair,
+              Rect::MakeXYWH(kSpread, kSpread, glyph_size.width - 2 * kSpread,
+                             glyph_size.height - 2 * kSpread),
+              has_color);
+    ConvertBitmapToSignedDistanceField(
+        reinterpret_cast<uint8_t*>(bitmap->getPixels()), width, height,
+        bitmap->rowBytes(), kSpread);
+  } else {
+    DrawGlyph(surface->getCanvas(), pair, Rect::MakeSize(glyph_size),
+              has_color);
+  }
+  bitmap->setImmutable();
+  return bitmap;
+}
+
+/// Draw a glyph into the atlas at the given location. Glyphs that were
+/// rasterized ahead of time are copied instead of being rendered again.
+///
+/// The distance fields of glyphs can't be drawn in place, so they are always
+/// rasterized on their own and cached for the atlases created later.
+static void DrawOrCopyGlyph(SkCanvas* canvas,
+                            const FontGlyphPair& font_glyph,
+                            const Rect& location,
+                            GlyphAtlas::Type type) {
+  auto& cache = PrerasterizedGlyphCache::GetInstance();
+  auto prerasterized = cache.Find(font_glyph, type);
+  if (!prerasterized && type == GlyphAtlas::Type::kSignedDistanceField) {
+    prerasterized = RasterizeGlyph(font_glyph, type);
+    cache.Insert(font_glyph, type, prerasterized);
+  }
+  if (prerasterized) {
+    canvas->writePixels(*prerasterized, location.origin.x, location.origin.y);
+    return;
+  }
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    return;
+  }
+  DrawGlyph(canvas, font_glyph, location,
+            type == GlyphAtlas::Type::kColorBitmap);
+}
+
+// static
+void TextRenderContextSkia::PrerasterizeGlyphs(const TextFrame& frame) {
+  TRACE_EVENT0("impeller", "TextRenderContextSkia::PrerasterizeGlyphs");
+  auto& cache = PrerasterizedGlyphCache::GetInstance();
+  const auto type = frame.HasColor() ? GlyphAtlas::Type::kColorBitmap
+                                     : GlyphAtlas::Type::kAlphaBitmap;
+  for (const auto& run : frame.GetRuns()) {
+    const auto& font = run.GetFont();
+    for (const auto& glyph_position : run.GetGlyphPositions()) {
+      FontGlyphPair pair{font, glyph_position.glyph};
+      if (cache.Contains(pair, type)) {
+        continue;
+      }
+      cache.Insert(pair, type, RasterizeGlyph(pair, type));
+    }
+  }
+}
+
+// static
+size_t TextRenderContextSkia::GetPrerasterizedGlyphCount() {
+  return PrerasterizedGlyphCache::GetInstance().GetCount();
+}
+
+size_t TextRenderContextSkia::GetPrerasterizedGlyphByteSize() {
+  return PrerasterizedGlyphCache::GetInstance().GetByteSize();
+}
+
+void TextRenderContextSkia::PurgePrerasterizedGlyphs() {
+  PrerasterizedGlyphCache::GetInstance().Clear();
+}
+
 static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                               const std::shared_ptr<SkBitmap>& bitmap,
                               const FontGlyphPair::Vector& new_pairs) {
@@ -333,14 +555,12 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
     return false;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
   for (const auto& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphPosition(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair, pos.value(), has_color);
+    DrawOrCopyGlyph(canvas, pair, pos.value(), atlas.GetType());
   }
   return true;
 }
@@ -375,31 +595,122 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
     return nullptr;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const FontGlyphPair& font_glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, font_glyph, location, has_color);
+  const auto type = atlas.GetType();
+  atlas.IterateGlyphs([canvas, type](const FontGlyphPair& font_glyph,
+                                     const Rect& location) -> bool {
+    DrawOrCopyGlyph(canvas, font_glyph, location, type);
     return true;
   });
 
   return bitmap;
 }
 
-static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
-                                    const std::shared_ptr<Texture>& texture) {
+/// Copy the pixels of the given region of the bitmap into a tightly packed
+/// buffer.
+static void CopyBitmapRegion(const SkBitmap& bitmap,
+                             const IRect& region,
+                             uint8_t* destination) {
+  const auto row_bytes = region.size.width * bitmap.bytesPerPixel();
+  for (auto row = 0; row < region.size.height; row++) {
+    std::memcpy(destination + row * row_bytes,
+                bitmap.getAddr(region.origin.x, region.origin.y + row),
+                row_bytes);
+  }
+}
+
+/// The inverse of CopyBitmapRegion.
+static void WriteBitmapRegion(const SkBitmap& bitmap,
+                              const IRect& region,
+                              const uint8_t* source) {
+  const auto row_bytes = region.size.width * bitmap.bytesPerPixel();
+  for (auto row = 0; row < region.size.height; row++) {
+    std::memcpy(bitmap.getAddr(region.origin.x, region.origin.y + row),
+                source + row * row_bytes, row_bytes);
+  }
+}
+
+/// Upload the regions of the bitmap containing the new font-glyph pairs to
+/// the atlas texture. The rest of the texture is left untouched. So the cost
+/// is proportional to the size of the new glyphs rather than the atlas.
+static bool UpdateGlyphTextureAtlasRegions(
+    const std::shared_ptr<Context>& context,
+    const GlyphAtlas& atlas,
+    const SkBitmap& bitmap,
+    const FontGlyphPair::Vector& new_pairs) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  FML_DCHECK(bitmap != nullptr);
-  auto texture_descriptor = texture->GetTextureDescriptor();
+  const auto& texture = atlas.GetTexture();
+  if (!texture) {
+    return false;
+  }
+  const auto atlas_rect = IRect::MakeSize(texture->GetSize());
 
-  auto mapping = std::make_shared<fml::NonOwnedMapping>(
-      reinterpret_cast<const uint8_t*>(bitmap->getAddr(0, 0)),  // data
-      texture_descriptor.GetByteSizeOfBaseMipLevel(),           // size
-      [bitmap](auto, auto) mutable { bitmap.reset(); }          // proc
-  );
+  // Each glyph was packed with padding to its right and bottom. Include it so
+  // that the texture matches the bitmap around the glyph.
+  std::vector<IRect> regions;
+  regions.reserve(new_pairs.size());
+  size_t staging_size = 0u;
+  for (const auto& pair : new_pairs) {
+    auto pos = atlas.FindFontGlyphPosition(pair);
+    if (!pos.has_value()) {
+      continue;
+    }
+    auto region =
+        IRect::MakeXYWH(static_cast<int64_t>(pos->origin.x),
+                        static_cast<int64_t>(pos->origin.y),
+                        static_cast<int64_t>(std::ceil(pos->size.width)) +
+                            kPadding,
+                        static_cast<int64_t>(std::ceil(pos->size.height)) +
+                            kPadding)
+            .Intersection(atlas_rect);
+    if (!region.has_value() || region->size.IsEmpty()) {
+      continue;
+    }
+    regions.push_back(region.value());
+    staging_size += region->size.Area() * bitmap.bytesPerPixel();
+  }
+  if (regions.empty()) {
+    return true;
+  }
 
-  return texture->SetContents(mapping);
+  std::vector<uint8_t> staging(staging_size);
+  size_t offset = 0u;
+  for (const auto& region : regions) {
+    CopyBitmapRegion(bitmap, region, staging.data() + offset);
+    offset += region.size.Area() * bitmap.bytesPerPixel();
+  }
+
+  auto allocator = context->GetResourceAllocator();
+  auto staging_buffer =
+      allocator->CreateBufferWithCopy(staging.data(), staging.size());
+  if (!staging_buffer) {
+    return false;
+  }
+  staging_buffer->SetLabel("GlyphAtlas Staging");
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("GlyphAtlas Update");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("GlyphAtlas Update");
+
+  offset = 0u;
+  for (const auto& region : regions) {
+    if (!blit_pass->AddCopy(staging_buffer, texture, region, offset)) {
+      return false;
+    }
+    offset += region.size.Area() * bitmap.bytesPerPixel();
+  }
+
+  if (!blit_pass->EncodeCommands(allocator)) {
+    return false;
+  }
+  return command_buffer->SubmitCommands();
 }
 
 static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
@@ -419,6 +730,7 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   texture_descriptor.storage_mode = StorageMode::kHostVisible;
   texture_descriptor.format = format;
   texture_descriptor.size = atlas_size;
+  texture_descriptor.category = AllocationCategory::kGlyphAtlas;
 
   if (pixmap.rowBytes() * pixmap.height() !=
       texture_descriptor.GetByteSizeOfBaseMipLevel()) {
@@ -476,7 +788,8 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   //         existing bitmap without recreating the atlas.
   // ---------------------------------------------------------------------------
   std::vector<Rect> glyph_positions;
-  if (CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
+  if (last_atlas->GetType() == type &&
+      CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
                                atlas_context->GetAtlasSize(),
                                atlas_context->GetRectPacker())) {
     // The old bitmap will be reused and only the additional glyphs will be
@@ -499,9 +812,10 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     }
 
     // ---------------------------------------------------------------------------
-    // Step 6: Update the existing texture with the updated bitmap.
+    // Step 6: Upload the regions of the new glyphs to the existing texture.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    if (!UpdateGlyphTextureAtlasRegions(GetContext(), *last_atlas, *bitmap,
+                                        new_glyphs)) {
       return nullptr;
     }
     return last_atlas;
@@ -513,7 +827,7 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
   auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
-      font_glyph_pairs, glyph_positions, atlas_context);
+      type, font_glyph_pairs, glyph_positions, atlas_context);
 
   atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
   if (atlas_size.IsEmpty()) {
@@ -552,9 +866,6 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   PixelFormat format;
   switch (type) {
     case GlyphAtlas::Type::kSignedDistanceField:
-      ConvertBitmapToSignedDistanceField(
-          reinterpret_cast<uint8_t*>(bitmap->getPixels()), atlas_size.width,
-          atlas_size.height);
     case GlyphAtlas::Type::kAlphaBitmap:
       format = PixelFormat::kA8UNormInt;
       break;
@@ -21,6 +21,39 @@ class TextRenderContextSkia : public TextRenderContext {
       std::shared_ptr<GlyphAtlasContext> atlas_context,
       FrameIterator iterator) const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Rasterize the glyphs in the frame that have not been
+  ///             rasterized already into a process-wide cache. Atlases
+  ///             created later copy the cached pixels instead of rendering
+  ///             the glyphs themselves.
+  ///
+  ///             This is safe to call from any thread and is meant to be
+  ///             called off the raster thread as soon as the frame is
+  ///             recorded.
+  ///
+  /// @param[in]  frame  The text frame whose glyphs to rasterize.
+  ///
+  static void PrerasterizeGlyphs(const TextFrame& frame);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of glyphs currently held in the cache populated
+  ///             by `PrerasterizeGlyphs`.
+  ///
+  static size_t GetPrerasterizedGlyphCount();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of the glyphs currently held in the cache
+  ///             populated by `PrerasterizeGlyphs`.
+  ///
+  static size_t GetPrerasterizedGlyphByteSize();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the glyphs held in the cache populated by
+  ///             `PrerasterizeGlyphs`. Atlases created later rasterize their
+  ///             glyphs again.
+  ///
+  static void PurgePrerasterizedGlyphs();
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(TextRenderContextSkia);
 };
@@ -45,6 +45,20 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
+// static
+FontGlyphPair GlyphAtlas::GetAtlasPair(Type type, const FontGlyphPair& pair) {
+  if (type != Type::kSignedDistanceField) {
+    return pair;
+  }
+  auto metrics = pair.font.GetMetrics();
+  const auto bounds_scale = kSignedDistanceFieldPointSize / metrics.point_size;
+  metrics.scale = 1.0f;
+  metrics.point_size = kSignedDistanceFieldPointSize;
+  return {Font(pair.font.GetTypeface(), metrics),
+          Glyph(pair.glyph.index, pair.glyph.type,
+                pair.glyph.bounds * bounds_scale)};
+}
+
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
@@ -37,6 +37,9 @@ class GlyphAtlas {
     /// where the value of each pixel represents a signed-distance field that
     /// stores the glyph outlines.
     ///
+    /// Text drawn at any size or scale reuses the same glyphs, which suits
+    /// large text and text whose scale is animated.
+    ///
     kSignedDistanceField,
 
     //--------------------------------------------------------------------------
@@ -52,6 +55,33 @@ class GlyphAtlas {
     kColorBitmap,
   };
 
+  //----------------------------------------------------------------------------
+  /// The point size at which the glyphs of signed-distance field atlases are
+  /// rendered, whatever the size and scale of the text.
+  ///
+  static constexpr Scalar kSignedDistanceFieldPointSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// The margin around the glyphs of signed-distance field atlases, in atlas
+  /// pixels, over which the distance to the outline falls off. It is included
+  /// in the locations of the glyphs in the atlas.
+  ///
+  static constexpr Scalar kSignedDistanceFieldSpread = 8.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the font-glyph pair under which an atlas of the given type
+  ///             stores a glyph.
+  ///
+  ///             Signed-distance field atlases store the glyphs of all the
+  ///             point sizes and scales of a typeface at
+  ///             `kSignedDistanceFieldPointSize`. Other atlases store the
+  ///             pair as is.
+  ///
+  /// @param[in]  type  The type of the atlas.
+  /// @param[in]  pair  The font-glyph pair of a run.
+  ///
+  static FontGlyphPair GetAtlasPair(Type type, const FontGlyphPair& pair);
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
@@ -8,18 +8,105 @@
 #include "impeller/typographer/text_render_context.h"
 #include "lazy_glyph_atlas.h"
 
+#include <unordered_map>
 #include <utility>
 
 namespace impeller {
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// @brief      Remembers the last scale that each font was drawn at, across
+///             frames, to find the fonts whose scale is animated.
+///
+class FontScaleHistory {
+ public:
+  static FontScaleHistory& GetInstance() {
+    static FontScaleHistory* history = new FontScaleHistory();
+    return *history;
+  }
+
+  /// Records that the font was drawn at the scale of its metrics, and returns
+  /// whether its scale changed in one of the last draws.
+  bool RecordScale(const Font& font) {
+    auto metrics = font.GetMetrics();
+    const auto scale = metrics.scale;
+    metrics.scale = 1.0f;
+    const auto key = Font(font.GetTypeface(), metrics).GetHash();
+
+    Lock lock(mutex_);
+    if (entries_.size() >= kMaxEntries) {
+      entries_.clear();
+    }
+    auto found = entries_.find(key);
+    if (found == entries_.end()) {
+      entries_[key] = Entry{scale, kSettleDraws};
+      return false;
+    }
+    auto& entry = found->second;
+    if (entry.scale != scale) {
+      entry.scale = scale;
+      entry.draws_since_change = 0u;
+    } else if (entry.draws_since_change < kSettleDraws) {
+      entry.draws_since_change++;
+    }
+    return entry.draws_since_change < kSettleDraws;
+  }
+
+ private:
+  // The number of draws at the same scale after which the scale of a font is
+  // no longer considered animated. Switching atlases back and forth during
+  // short pauses of an animation would add glyphs to both.
+  static constexpr size_t kSettleDraws = 30u;
+  static constexpr size_t kMaxEntries = 1024u;
+
+  struct Entry {
+    Scalar scale = 1.0f;
+    size_t draws_since_change = 0u;
+  };
+
+  Mutex mutex_;
+  std::unordered_map<size_t, Entry> entries_ IPLR_GUARDED_BY(mutex_);
+
+  FontScaleHistory() = default;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FontScaleHistory);
+};
+
+}  // namespace
+
 LazyGlyphAtlas::LazyGlyphAtlas() = default;
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
-void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame) {
+static bool ShouldUseSignedDistanceField(const TextFrame& frame) {
+  if (frame.HasColor()) {
+    return false;
+  }
+  auto& history = FontScaleHistory::GetInstance();
+  bool use_sdf = false;
+  for (const auto& run : frame.GetRuns()) {
+    const auto& metrics = run.GetFont().GetMetrics();
+    // The history of every font is recorded, whatever the outcome.
+    const bool scale_animated = history.RecordScale(run.GetFont());
+    use_sdf |= scale_animated ||
+               metrics.point_size * metrics.scale >=
+                   LazyGlyphAtlas::kSignedDistanceFieldMinimumGlyphSize;
+  }
+  return use_sdf;
+}
+
+bool LazyGlyphAtlas::AddTextFrame(const TextFrame& frame) {
+  const bool use_sdf = ShouldUseSignedDistanceField(frame);
+  Lock lock(atlas_mutex_);
   FML_DCHECK(atlas_map_.empty());
+  if (use_sdf) {
+    sdf_frames_.emplace_back(frame);
+    return true;
+  }
   has_color_ |= frame.HasColor();
   frames_.emplace_back(frame);
+  return false;
 }
 
 bool LazyGlyphAtlas::HasColor() const {
@@ -30,6 +117,7 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     GlyphAtlas::Type type,
     std::shared_ptr<GlyphAtlasContext> atlas_context,
     std::shared_ptr<Context> context) const {
+  Lock lock(atlas_mutex_);
   {
     auto atlas_it = atlas_map_.find(type);
     if (atlas_it != atlas_map_.end()) {
@@ -41,12 +129,14 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
   if (!text_context || !text_context->IsValid()) {
     return nullptr;
   }
+  const auto& frames =
+      type == GlyphAtlas::Type::kSignedDistanceField ? sdf_frames_ : frames_;
   size_t i = 0;
   TextRenderContext::FrameIterator iterator = [&]() -> const TextFrame* {
-    if (i >= frames_.size()) {
+    if (i >= frames.size()) {
       return nullptr;
     }
-    const auto& result = frames_[i];
+    const auto& result = frames[i];
     i++;
     return &result;
   };
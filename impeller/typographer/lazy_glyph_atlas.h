@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/context.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_frame.h"
@@ -19,19 +20,45 @@ class LazyGlyphAtlas {
 
   ~LazyGlyphAtlas();
 
-  void AddTextFrame(const TextFrame& frame);
+  //----------------------------------------------------------------------------
+  /// @brief      Add a frame whose glyphs the atlases must contain.
+  ///
+  ///             Frames without color glyphs are rendered from the
+  ///             signed-distance field atlas if their glyphs are large, or if
+  ///             the scale of their fonts recently changed. Bitmap atlases
+  ///             would need new glyphs for each of these sizes.
+  ///
+  /// @return     Whether the frame is rendered from the signed-distance field
+  ///             atlas.
+  ///
+  bool AddTextFrame(const TextFrame& frame);
 
   std::shared_ptr<GlyphAtlas> CreateOrGetGlyphAtlas(
       GlyphAtlas::Type type,
       std::shared_ptr<GlyphAtlasContext> atlas_context,
       std::shared_ptr<Context> context) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the bitmap atlas needs color, because one of the
+  ///             frames not rendered from the signed-distance field atlas has
+  ///             color glyphs.
+  ///
   bool HasColor() const;
 
+  //----------------------------------------------------------------------------
+  /// The rendered size of glyphs, in pixels, above which their frame is
+  /// rendered from the signed-distance field atlas.
+  ///
+  static constexpr Scalar kSignedDistanceFieldMinimumGlyphSize = 48.0f;
+
  private:
   std::vector<TextFrame> frames_;
+  std::vector<TextFrame> sdf_frames_;
+  // Subpasses may be encoded concurrently and request the atlas from multiple
+  // threads. This also serializes updates to the shared atlas context.
+  mutable Mutex atlas_mutex_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
-      atlas_map_;
+      atlas_map_ IPLR_GUARDED_BY(atlas_mutex_);
   bool has_color_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(LazyGlyphAtlas);
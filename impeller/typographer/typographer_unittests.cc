@@ -2,11 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
 
@@ -168,6 +173,34 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
             atlas->GetTexture()->GetSize().height);
 }
 
+TEST_P(TypographerTest, SignedDistanceFieldAtlasIsSharedAcrossScales) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  sk_font.setSize(64);
+  auto blob = SkTextBlob::MakeFromString("AGH", sk_font);
+  ASSERT_TRUE(blob);
+
+  TextFrame frame;
+  size_t count = 0;
+  TextRenderContext::FrameIterator iterator = [&]() -> const TextFrame* {
+    if (count < 8) {
+      count++;
+      frame = TextFrameFromTextBlob(blob, 0.6 * count);
+      return &frame;
+    }
+    return nullptr;
+  };
+  auto atlas = context->CreateGlyphAtlas(
+      GlyphAtlas::Type::kSignedDistanceField, atlas_context, iterator);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+
+  // Every scale is drawn from the same distance field of each glyph.
+  ASSERT_EQ(atlas->GetGlyphCount(), 3u);
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto context = TextRenderContext::Create(GetContext());
   auto atlas_context = std::make_shared<GlyphAtlasContext>();
@@ -201,5 +234,87 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   ASSERT_EQ(old_packer, new_packer);
 }
 
+// Empties the process-wide cache of prerasterized glyphs for the duration
+// of a test, so that it doesn't depend on the glyphs of other tests.
+class ScopedEmptyPrerasterizedGlyphCache {
+ public:
+  ScopedEmptyPrerasterizedGlyphCache() {
+    TextRenderContextSkia::PurgePrerasterizedGlyphs();
+  }
+
+  ~ScopedEmptyPrerasterizedGlyphCache() {
+    TextRenderContextSkia::PurgePrerasterizedGlyphs();
+  }
+};
+
+// Creates an alpha atlas for the frame in a new atlas context and returns a
+// copy of its pixels.
+static std::vector<uint8_t> CreateAtlasPixels(TextRenderContext& context,
+                                              const TextFrame& frame) {
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  auto atlas = context.CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap,
+                                        atlas_context, frame);
+  auto bitmap = atlas_context->GetBitmap();
+  if (!atlas || !bitmap) {
+    return {};
+  }
+  auto pixels = reinterpret_cast<const uint8_t*>(bitmap->getPixels());
+  return std::vector<uint8_t>(pixels, pixels + bitmap->computeByteSize());
+}
+
+TEST_P(TypographerTest, PrerasterizedGlyphsCanPopulateAtlas) {
+  ScopedEmptyPrerasterizedGlyphCache empty_cache;
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("prerasterized", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = TextFrameFromTextBlob(blob);
+
+  // Each unique glyph of "prerasterized" is cached once.
+  ASSERT_EQ(TextRenderContextSkia::GetPrerasterizedGlyphCount(), 0u);
+  TextRenderContextSkia::PrerasterizeGlyphs(frame);
+  ASSERT_EQ(TextRenderContextSkia::GetPrerasterizedGlyphCount(), 9u);
+  ASSERT_GT(TextRenderContextSkia::GetPrerasterizedGlyphByteSize(), 0u);
+
+  // Glyphs that are already cached are not rasterized again.
+  TextRenderContextSkia::PrerasterizeGlyphs(frame);
+  ASSERT_EQ(TextRenderContextSkia::GetPrerasterizedGlyphCount(), 9u);
+
+  auto atlas = context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap,
+                                         atlas_context, frame);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_NE(atlas->GetTexture(), nullptr);
+
+  TextRenderContextSkia::PurgePrerasterizedGlyphs();
+  ASSERT_EQ(TextRenderContextSkia::GetPrerasterizedGlyphCount(), 0u);
+  ASSERT_EQ(TextRenderContextSkia::GetPrerasterizedGlyphByteSize(), 0u);
+}
+
+TEST_P(TypographerTest, PrerasterizedGlyphsAreCopiedWhereTheyWouldBeDrawn) {
+  ScopedEmptyPrerasterizedGlyphCache empty_cache;
+  auto context = TextRenderContext::Create(GetContext());
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("the quick brown fox", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = TextFrameFromTextBlob(blob);
+
+  // Glyphs that miss the cache are drawn into the atlas.
+  auto drawn = CreateAtlasPixels(*context, frame);
+  ASSERT_FALSE(drawn.empty());
+  ASSERT_TRUE(std::any_of(drawn.begin(), drawn.end(),
+                          [](uint8_t value) { return value != 0u; }));
+  ASSERT_EQ(TextRenderContextSkia::GetPrerasterizedGlyphCount(), 0u);
+
+  // Cached glyphs are copied into the atlas with writePixels instead.
+  TextRenderContextSkia::PrerasterizeGlyphs(frame);
+  ASSERT_GT(TextRenderContextSkia::GetPrerasterizedGlyphCount(), 0u);
+  auto copied = CreateAtlasPixels(*context, frame);
+  ASSERT_EQ(copied.size(), drawn.size());
+  ASSERT_TRUE(copied == drawn);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -318,22 +318,44 @@ class SceneBuilder extends NativeFieldWrapperClass1 {
   /// original object.
   /// {@endtemplate}
   ///
+  /// If `pointerDeltaScale` is not null, the engine may move the layer to
+  /// follow the pointer that drives the current drag when the frame is shown
+  /// later than the pointer moved. The layer is translated by the distance
+  /// the pointer has moved, in logical pixels, since the pointer events that
+  /// the frame was built from, scaled by `pointerDeltaScale`. For example, a
+  /// vertical list that scrolls with the pointer would use `Offset(0, 1)`.
+  /// This only happens when the engine is run with late latching of pointer
+  /// transforms enabled.
+  ///
   /// See [pop] for details about the operation stack.
   TransformEngineLayer pushTransform(
     Float64List matrix4, {
     TransformEngineLayer? oldLayer,
+    Offset? pointerDeltaScale,
   }) {
     assert(_matrix4IsValid(matrix4));
     assert(_debugCheckCanBeUsedAsOldLayer(oldLayer, 'pushTransform'));
     final EngineLayer engineLayer = EngineLayer._();
-    _pushTransform(engineLayer, matrix4, oldLayer?._nativeLayer);
+    _pushTransform(
+      engineLayer,
+      matrix4,
+      oldLayer?._nativeLayer,
+      pointerDeltaScale?.dx ?? 0.0,
+      pointerDeltaScale?.dy ?? 0.0,
+    );
     final TransformEngineLayer layer = TransformEngineLayer._(engineLayer);
     assert(_debugPushLayer(layer));
     return layer;
   }
 
-  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'SceneBuilder::pushTransformHandle')
-  external void _pushTransform(EngineLayer layer, Float64List matrix4, EngineLayer? oldLayer);
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle, Double, Double)>(symbol: 'SceneBuilder::pushTransformHandle')
+  external void _pushTransform(
+    EngineLayer layer,
+    Float64List matrix4,
+    EngineLayer? oldLayer,
+    double pointerDeltaScaleX,
+    double pointerDeltaScaleY,
+  );
 
   /// Pushes an offset operation onto the operation stack.
   ///
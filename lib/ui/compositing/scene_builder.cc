@@ -44,9 +44,13 @@ SceneBuilder::~SceneBuilder() = default;
 
 void SceneBuilder::pushTransform(Dart_Handle layer_handle,
                                  tonic::Float64List& matrix4,
-                                 const fml::RefPtr<EngineLayer>& oldLayer) {
+                                 const fml::RefPtr<EngineLayer>& oldLayer,
+                                 double pointerDeltaScaleX,
+                                 double pointerDeltaScaleY) {
   SkMatrix sk_matrix = ToSkMatrix(matrix4);
   auto layer = std::make_shared<flutter::TransformLayer>(sk_matrix);
+  layer->set_pointer_delta_scale(
+      SkPoint::Make(pointerDeltaScaleX, pointerDeltaScaleY));
   PushLayer(layer);
   // matrix4 has to be released before we can return another Dart object
   matrix4.Release();
@@ -38,13 +38,18 @@ class SceneBuilder : public RefCountedDartWrappable<SceneBuilder> {
 
   void pushTransformHandle(Dart_Handle layer_handle,
                            Dart_Handle matrix4_handle,
-                           fml::RefPtr<EngineLayer> oldLayer) {
+                           fml::RefPtr<EngineLayer> oldLayer,
+                           double pointerDeltaScaleX,
+                           double pointerDeltaScaleY) {
     tonic::Float64List matrix4(matrix4_handle);
-    pushTransform(layer_handle, matrix4, oldLayer);
+    pushTransform(layer_handle, matrix4, oldLayer, pointerDeltaScaleX,
+                  pointerDeltaScaleY);
   }
   void pushTransform(Dart_Handle layer_handle,
                      tonic::Float64List& matrix4,
-                     const fml::RefPtr<EngineLayer>& oldLayer);
+                     const fml::RefPtr<EngineLayer>& oldLayer,
+                     double pointerDeltaScaleX,
+                     double pointerDeltaScaleY);
   void pushOffset(Dart_Handle layer_handle,
                   double dx,
                   double dy,
@@ -29,6 +29,7 @@
 #include "flutter/lib/ui/painting/path_measure.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
+#include "flutter/lib/ui/painting/point_buffer.h"
 #include "flutter/lib/ui/painting/vertices.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
@@ -81,10 +82,11 @@ typedef CanvasPath Path;
   V(PathMeasure::Create, 3)                                           \
   V(Path::Create, 1)                                                  \
   V(PictureRecorder::Create, 1)                                       \
+  V(Picture::CreateFromTransfer, 2)                                   \
   V(SceneBuilder::Create, 1)                                          \
   V(SemanticsUpdateBuilder::Create, 1)                                \
   /* Other */                                                         \
-  V(FontCollection::LoadFontFromList, 3)                              \
+  V(FontCollection::LoadFontFromList, 4)                              \
   V(ImageDescriptor::initEncoded, 3)                                  \
   V(ImmutableBuffer::init, 3)                                         \
   V(ImmutableBuffer::initFromAsset, 3)                                \
@@ -97,7 +99,7 @@ typedef CanvasPath Path;
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
-  V(PlatformConfigurationNativeApi::Render, 1)                        \
+  V(PlatformConfigurationNativeApi::Render, 2)                        \
   V(PlatformConfigurationNativeApi::UpdateSemantics, 1)               \
   V(PlatformConfigurationNativeApi::SetNeedsReportTimings, 1)         \
   V(PlatformConfigurationNativeApi::SetIsolateDebugName, 1)           \
@@ -109,12 +111,16 @@ typedef CanvasPath Path;
   V(PlatformConfigurationNativeApi::GetRootIsolateToken, 0)           \
   V(PlatformConfigurationNativeApi::RegisterBackgroundIsolate, 1)     \
   V(PlatformConfigurationNativeApi::SendPortPlatformMessage, 4)       \
+  V(PlatformConfigurationNativeApi::SetPlatformMessagePort, 3)        \
+  V(PlatformConfigurationNativeApi::RespondToPortPlatformMessage, 3)  \
+  V(PlatformConfigurationNativeApi::OpenSharedRingBuffer, 3)          \
   V(DartRuntimeHooks::Logger_PrintDebugString, 1)                     \
   V(DartRuntimeHooks::Logger_PrintString, 1)                          \
   V(DartRuntimeHooks::ScheduleMicrotask, 1)                           \
   V(DartRuntimeHooks::GetCallbackHandle, 1)                           \
   V(DartRuntimeHooks::GetCallbackFromHandle, 1)                       \
   V(DartPluginRegistrant_EnsureInitialized, 0)                        \
+  V(PointBuffer::Reserve, 1)                                          \
   V(Vertices::init, 6)
 
 // List of native instance methods used as @Native functions.
@@ -138,6 +144,7 @@ typedef CanvasPath Path;
   V(Canvas, clipRRect, 3)                              \
   V(Canvas, drawArc, 10)                               \
   V(Canvas, drawAtlas, 10)                             \
+  V(Canvas, drawBatch, 3)                              \
   V(Canvas, drawCircle, 6)                             \
   V(Canvas, drawColor, 3)                              \
   V(Canvas, drawDRRect, 5)                             \
@@ -150,6 +157,7 @@ typedef CanvasPath Path;
   V(Canvas, drawPath, 4)                               \
   V(Canvas, drawPicture, 2)                            \
   V(Canvas, drawPoints, 5)                             \
+  V(Canvas, drawPointsFromBuffer, 6)                   \
   V(Canvas, drawRRect, 4)                              \
   V(Canvas, drawRect, 7)                               \
   V(Canvas, drawShadow, 5)                             \
@@ -221,6 +229,7 @@ typedef CanvasPath Path;
   V(Paragraph, height, 1)                              \
   V(Paragraph, ideographicBaseline, 1)                 \
   V(Paragraph, layout, 2)                              \
+  V(Paragraph, layoutAsync, 3)                         \
   V(Paragraph, longestLine, 1)                         \
   V(Paragraph, maxIntrinsicWidth, 1)                   \
   V(Paragraph, minIntrinsicWidth, 1)                   \
@@ -230,6 +239,7 @@ typedef CanvasPath Path;
   V(PathMeasure, getLength, 2)                         \
   V(PathMeasure, getPosTan, 3)                         \
   V(PathMeasure, getSegment, 6)                        \
+  V(PathMeasure, getSegments, 5)                       \
   V(PathMeasure, isClosed, 2)                          \
   V(PathMeasure, nextContour, 1)                       \
   V(Path, addArc, 7)                                   \
@@ -237,6 +247,7 @@ typedef CanvasPath Path;
   V(Path, addPath, 4)                                  \
   V(Path, addPathWithMatrix, 5)                        \
   V(Path, addPolygon, 3)                               \
+  V(Path, addPolygonFromBuffer, 4)                     \
   V(Path, addRRect, 2)                                 \
   V(Path, addRect, 5)                                  \
   V(Path, arcTo, 8)                                    \
@@ -253,6 +264,7 @@ typedef CanvasPath Path;
   V(Path, lineTo, 3)                                   \
   V(Path, moveTo, 3)                                   \
   V(Path, op, 4)                                       \
+  V(Path, opAsync, 5)                                  \
   V(Path, quadraticBezierTo, 5)                        \
   V(Path, relativeArcToPoint, 8)                       \
   V(Path, relativeConicTo, 6)                          \
@@ -264,11 +276,14 @@ typedef CanvasPath Path;
   V(Path, setFillType, 2)                              \
   V(Path, shift, 4)                                    \
   V(Path, transform, 3)                                \
+  V(Path, unionAll, 2)                                 \
+  V(Path, unionAllAsync, 3)                            \
   V(PictureRecorder, endRecording, 2)                  \
   V(Picture, GetAllocationSize, 1)                     \
   V(Picture, dispose, 1)                               \
   V(Picture, toImage, 4)                               \
   V(Picture, toImageSync, 4)                           \
+  V(Picture, transfer, 1)                              \
   V(SceneBuilder, addPerformanceOverlay, 6)            \
   V(SceneBuilder, addPicture, 5)                       \
   V(SceneBuilder, addPlatformView, 6)                  \
@@ -297,7 +312,8 @@ typedef CanvasPath Path;
   V(SemanticsUpdateBuilder, updateCustomAction, 5)     \
   V(SemanticsUpdateBuilder, updateNode, 36)            \
   V(SemanticsUpdate, dispose, 1)                       \
-  V(Vertices, dispose, 1)
+  V(Vertices, dispose, 1)                              \
+  V(Vertices, update, 4)
 
 #ifdef IMPELLER_ENABLE_3D
 
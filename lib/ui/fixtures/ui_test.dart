@@ -267,6 +267,28 @@ void platformMessagePortResponseTest() async {
   }
 }
 
+@pragma('vm:entry-point')
+void platformMessagePortRouterTest() {
+  final RootIsolateToken token = RootIsolateToken.instance!;
+  final ReceivePort receivePort = ReceivePort();
+  int count = 0;
+  receivePort.listen((dynamic message) {
+    final List<dynamic> routedMessage = message as List<dynamic>;
+    final int responseId = routedMessage[0] as int;
+    final Uint8List data = routedMessage[1] as Uint8List;
+    final String reply = '$count:${String.fromCharCodes(data)}';
+    count += 1;
+    PlatformDispatcher.instance.respondToPortPlatformMessage(
+        token, responseId, ByteData.sublistView(Uint8List.fromList(reply.codeUnits)));
+  });
+  PlatformDispatcher.instance.setPlatformMessagePort(
+      token, 'test/port_channel', receivePort.sendPort);
+  _notifyPlatformMessagePortSet();
+}
+
+@pragma('vm:external-name', 'NotifyPlatformMessagePortSet')
+external void _notifyPlatformMessagePortSet();
+
 @pragma('vm:entry-point')
 void platformMessageResponseTest() {
   _callPlatformMessageResponseDart((ByteData? result) {
@@ -289,6 +311,52 @@ external void _finishCallResponse(bool didPass);
 @pragma('vm:entry-point')
 void messageCallback(dynamic data) {}
 
+// Records a picture of `count` draws of simple shapes, whose paint changes
+// every few draws, for the canvas recording benchmark.
+@pragma('vm:entry-point')
+void recordShapes(int count) {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint();
+  final RRect rrect = RRect.fromLTRBR(0, 0, 10, 10, const Radius.circular(2));
+  for (int i = 0; i < count; i++) {
+    if (i % 4 == 0) {
+      paint.color = Color(0xFF000000 | i);
+    }
+    switch (i % 3) {
+      case 0:
+        canvas.drawRect(Rect.fromLTWH(i.toDouble(), 0, 10, 10), paint);
+        break;
+      case 1:
+        canvas.drawRRect(rrect.shift(Offset(i.toDouble(), 0)), paint);
+        break;
+      case 2:
+        canvas.drawCircle(Offset(i.toDouble(), 5), 5, paint);
+        break;
+    }
+  }
+  recorder.endRecording().dispose();
+}
+
+@pragma('vm:entry-point')
+void recordPointLists(int count) {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint()..strokeWidth = 2;
+  final List<Offset> points = List<Offset>.generate(
+    16,
+    (int i) => Offset(i.toDouble(), (i % 4).toDouble()),
+  );
+  for (int i = 0; i < count; i++) {
+    if (i.isEven) {
+      canvas.drawPoints(PointMode.polygon, points, paint);
+    } else {
+      canvas.drawPath(Path()..addPolygon(points, true), paint);
+    }
+  }
+  recorder.endRecording().dispose();
+}
+
 @pragma('vm:entry-point')
 @pragma('vm:external-name', 'ValidateConfiguration')
 external void validateConfiguration();
@@ -51,6 +51,11 @@ void _updateWindowMetrics(
   );
 }
 
+@pragma('vm:entry-point')
+void _removeView(Object id) {
+  PlatformDispatcher.instance._removeView(id);
+}
+
 typedef _LocaleClosure = String Function();
 
 @pragma('vm:entry-point')
@@ -86,6 +91,11 @@ void _dispatchPlatformMessage(String name, ByteData? data, int responseId) {
   PlatformDispatcher.instance._dispatchPlatformMessage(name, data, responseId);
 }
 
+@pragma('vm:entry-point')
+void _dispatchPlatformMessages(String name, List<Object?> data, List<int> responseIds) {
+  PlatformDispatcher.instance._dispatchPlatformMessages(name, data, responseIds);
+}
+
 @pragma('vm:entry-point')
 void _dispatchPointerDataPacket(ByteData packet) {
   PlatformDispatcher.instance._dispatchPointerDataPacket(packet);
@@ -4,10 +4,16 @@
 
 #include "flutter/lib/ui/io_manager.h"
 
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
 namespace flutter {
 
 std::shared_ptr<impeller::Context> IOManager::GetImpellerContext() const {
   return nullptr;
 }
 
+std::shared_ptr<DecodedImageCache> IOManager::GetDecodedImageCache() const {
+  return nullptr;
+}
+
 }  // namespace flutter
@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.ui;
+
+/// A pool of background isolates that run short computations, such as those
+/// of `compute`.
+///
+/// Running each computation in an isolate of its own, as [Isolate.run] does,
+/// pays for spawning and setting up an isolate every time, which can take
+/// longer than a computation of a few milliseconds. The isolates of a pool are
+/// spawned ahead of time in the isolate group of the isolate that creates the
+/// pool, and run one computation after another.
+///
+/// The pool keeps up to [size] isolates. They are all spawned when the pool is
+/// created, unless `prewarm` is false. An isolate that has been idle for
+/// [idleTimeout] exits, and is spawned again when there is more work than the
+/// remaining isolates can take.
+///
+/// Computations and their results are copied between isolates like the
+/// messages of [SendPort.send], so they can only capture and return values
+/// that can be sent. An exception thrown by a computation is rethrown by the
+/// future returned by [run] if it can be sent, and as a [RemoteError]
+/// otherwise.
+///
+/// A computation that doesn't complete keeps its isolate busy. Computations
+/// must not exit their isolate, for example with [Isolate.exit].
+class IsolatePool {
+  /// Creates a pool of at most `size` isolates, and spawns them unless
+  /// `prewarm` is false.
+  IsolatePool({
+    this.size = 2,
+    this.idleTimeout = const Duration(seconds: 30),
+    bool prewarm = true,
+  }) : assert(size > 0) {
+    if (prewarm) {
+      while (_workers.length < size) {
+        _spawnWorker();
+      }
+    }
+  }
+
+  /// The largest number of isolates of this pool.
+  final int size;
+
+  /// How long an isolate of this pool stays idle before it exits.
+  final Duration idleTimeout;
+
+  final List<_IsolatePoolWorker> _workers = <_IsolatePoolWorker>[];
+  final collection.Queue<_IsolatePoolTask> _pendingTasks = collection.Queue<_IsolatePoolTask>();
+  bool _closed = false;
+
+  /// The number of isolates this pool has spawned.
+  int get spawnCount => _spawnCount;
+  int _spawnCount = 0;
+
+  /// The total time it took for the isolates this pool has spawned to be
+  /// ready to run computations.
+  ///
+  /// Divided by [spawnCount], this is the average latency of a spawn.
+  Duration get totalSpawnLatency => _totalSpawnLatency;
+  Duration _totalSpawnLatency = Duration.zero;
+
+  /// Runs `computation` in an isolate of this pool, and returns its result.
+  ///
+  /// The computation runs as soon as an isolate of this pool is idle.
+  Future<R> run<R>(FutureOr<R> Function() computation) {
+    if (_closed) {
+      throw StateError('IsolatePool.run called after the pool was closed.');
+    }
+    final _IsolatePoolTask task = _IsolatePoolTask(computation);
+    _pendingTasks.add(task);
+    _schedule();
+    return task.completer.future.then((Object? result) => result as R);
+  }
+
+  /// Shuts down the isolates of this pool.
+  ///
+  /// The computations that are running complete, but the ones that are still
+  /// waiting for an isolate complete with a [StateError].
+  void close() {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    while (_pendingTasks.isNotEmpty) {
+      _pendingTasks.removeFirst().completer.completeError(
+        StateError('The IsolatePool was closed before the computation ran.'),
+      );
+    }
+    for (final _IsolatePoolWorker worker in _workers.toList()) {
+      if (worker.task == null) {
+        _shutDownWorker(worker);
+      }
+    }
+  }
+
+  void _schedule() {
+    while (_pendingTasks.isNotEmpty) {
+      final _IsolatePoolWorker? worker = _idleWorker();
+      if (worker == null) {
+        int spawning = _workers.where((_IsolatePoolWorker worker) => worker.sendPort == null).length;
+        while (_workers.length < size && spawning < _pendingTasks.length) {
+          _spawnWorker();
+          spawning += 1;
+        }
+        return;
+      }
+      final _IsolatePoolTask task = _pendingTasks.removeFirst();
+      worker.idleTimer?.cancel();
+      worker.idleTimer = null;
+      worker.task = task;
+      try {
+        worker.sendPort!.send(task.computation);
+      } catch (error, stackTrace) {
+        // The computation captures values that can't be sent.
+        worker.task = null;
+        task.completer.completeError(error, stackTrace);
+        _didBecomeIdle(worker);
+      }
+    }
+  }
+
+  _IsolatePoolWorker? _idleWorker() {
+    for (final _IsolatePoolWorker worker in _workers) {
+      if (worker.sendPort != null && worker.task == null) {
+        return worker;
+      }
+    }
+    return null;
+  }
+
+  void _spawnWorker() {
+    final _IsolatePoolWorker worker = _IsolatePoolWorker();
+    _workers.add(worker);
+    final Stopwatch stopwatch = Stopwatch()..start();
+    worker.port.handler = (Object? message) {
+      if (message is SendPort) {
+        _spawnCount += 1;
+        _totalSpawnLatency += stopwatch.elapsed;
+        worker.sendPort = message;
+        if (_closed) {
+          _shutDownWorker(worker);
+          return;
+        }
+        _didBecomeIdle(worker);
+        return;
+      }
+      if (message == null) {
+        // The isolate exited.
+        _removeWorker(worker);
+        worker.task?.completer.completeError(
+          RemoteError('The computation ended without a result.', ''),
+        );
+        worker.task = null;
+        _schedule();
+        return;
+      }
+      final List<Object?> reply = message as List<Object?>;
+      final _IsolatePoolTask task = worker.task!;
+      worker.task = null;
+      if (reply.length == 1) {
+        task.completer.complete(reply[0]);
+      } else {
+        task.completer.completeError(reply[0]!, StackTrace.fromString(reply[1]! as String));
+      }
+      _didBecomeIdle(worker);
+    };
+    Isolate.spawn<SendPort>(
+      _isolatePoolWorkerMain,
+      worker.port.sendPort,
+      onExit: worker.port.sendPort,
+      debugName: 'IsolatePool',
+    ).then((Isolate isolate) {}, onError: (Object error, StackTrace stackTrace) {
+      _removeWorker(worker);
+      // Fail the pending work rather than spawning again, since the next
+      // spawn would most likely fail the same way.
+      if (_workers.isEmpty) {
+        while (_pendingTasks.isNotEmpty) {
+          _pendingTasks.removeFirst().completer.completeError(error, stackTrace);
+        }
+      }
+    });
+  }
+
+  void _didBecomeIdle(_IsolatePoolWorker worker) {
+    if (_closed) {
+      _shutDownWorker(worker);
+      return;
+    }
+    _schedule();
+    if (worker.task == null) {
+      worker.idleTimer = Timer(idleTimeout, () => _shutDownWorker(worker));
+    }
+  }
+
+  void _shutDownWorker(_IsolatePoolWorker worker) {
+    worker.idleTimer?.cancel();
+    worker.idleTimer = null;
+    // Asks the isolate to exit, which it reports to its port.
+    worker.sendPort?.send(null);
+    worker.sendPort = null;
+    _workers.remove(worker);
+  }
+
+  void _removeWorker(_IsolatePoolWorker worker) {
+    worker.idleTimer?.cancel();
+    worker.idleTimer = null;
+    worker.port.close();
+    _workers.remove(worker);
+  }
+}
+
+class _IsolatePoolTask {
+  _IsolatePoolTask(this.computation);
+
+  final FutureOr<Object?> Function() computation;
+  final Completer<Object?> completer = Completer<Object?>();
+}
+
+class _IsolatePoolWorker {
+  final RawReceivePort port = RawReceivePort();
+  // Null until the isolate is ready to run computations.
+  SendPort? sendPort;
+  _IsolatePoolTask? task;
+  Timer? idleTimer;
+}
+
+void _isolatePoolWorkerMain(SendPort replyPort) {
+  final RawReceivePort port = RawReceivePort();
+  port.handler = (Object? message) async {
+    if (message == null) {
+      // The pool shut this isolate down.
+      port.close();
+      return;
+    }
+    final FutureOr<Object?> Function() computation = message as FutureOr<Object?> Function();
+    try {
+      final Object? result = await computation();
+      try {
+        replyPort.send(<Object?>[result]);
+      } catch (error, stackTrace) {
+        // The result can't be sent.
+        replyPort.send(<Object?>[error, stackTrace.toString()]);
+      }
+    } catch (error, stackTrace) {
+      try {
+        replyPort.send(<Object?>[error, stackTrace.toString()]);
+      } catch (_) {
+        replyPort.send(<Object?>[RemoteError(error.toString(), stackTrace.toString()), stackTrace.toString()]);
+      }
+    }
+  };
+  replyPort.send(port.sendPort);
+}
@@ -1123,6 +1123,7 @@ class Paint {
   static const int _kMaskFilterSigmaIndex = 11;
   static const int _kInvertColorIndex = 12;
   static const int _kDitherIndex = 13;
+  static const int _kGenerationIndex = 14;
 
   static const int _kIsAntiAliasOffset = _kIsAntiAliasIndex << 2;
   static const int _kColorOffset = _kColorIndex << 2;
@@ -1138,8 +1139,26 @@ class Paint {
   static const int _kMaskFilterSigmaOffset = _kMaskFilterSigmaIndex << 2;
   static const int _kInvertColorOffset = _kInvertColorIndex << 2;
   static const int _kDitherOffset = _kDitherIndex << 2;
+  static const int _kGenerationOffset = _kGenerationIndex << 2;
   // If you add more fields, remember to update _kDataByteCount.
-  static const int _kDataByteCount = 56;
+  static const int _kDataByteCount = 60;
+
+  // The generation field changes whenever the paint does, so that a canvas
+  // that has already synchronized its attributes to a paint of the same
+  // generation can skip decoding it again. Generations are unique across
+  // paints, and zero marks a paint whose attributes must be decoded for
+  // every draw, either because it was never changed or because its shader
+  // can change without the paint being set.
+  static int _nextGeneration = 1;
+
+  void _markChanged() {
+    int generation = 0;
+    if (_objects?[_kShaderIndex] == null) {
+      generation = _nextGeneration;
+      _nextGeneration = generation == 0xFFFFFFFF ? 1 : generation + 1;
+    }
+    _data.setUint32(_kGenerationOffset, generation, _kFakeHostEndian);
+  }
 
   // Binary format must match the deserialization code in paint.cc.
   // C++ unit tests access this.
@@ -1155,6 +1174,16 @@ class Paint {
   static const int _kImageFilterIndex = 2;
   static const int _kObjectCount = 3; // Must be one larger than the largest index.
 
+  // Whether the paint has a shader or a filter object, which the batched
+  // draws of a [Canvas] cannot encode.
+  bool get _hasObjects {
+    final List<Object?>? objects = _objects;
+    return objects != null &&
+        (objects[_kShaderIndex] != null ||
+         objects[_kColorFilterIndex] != null ||
+         objects[_kImageFilterIndex] != null);
+  }
+
   /// Whether to apply anti-aliasing to lines and images drawn on the
   /// canvas.
   ///
@@ -1167,6 +1196,7 @@ class Paint {
     // we always encode as zero, is true.
     final int encoded = value ? 0 : 1;
     _data.setInt32(_kIsAntiAliasOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   // Must be kept in sync with the default in paint.cc.
@@ -1191,6 +1221,7 @@ class Paint {
   set color(Color value) {
     final int encoded = value.value ^ _kColorDefault;
     _data.setInt32(_kColorOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   // Must be kept in sync with the default in paint.cc.
@@ -1221,6 +1252,7 @@ class Paint {
   set blendMode(BlendMode value) {
     final int encoded = value.index ^ _kBlendModeDefault;
     _data.setInt32(_kBlendModeOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// Whether to paint inside shapes, the edges of shapes, or both.
@@ -1232,6 +1264,7 @@ class Paint {
   set style(PaintingStyle value) {
     final int encoded = value.index;
     _data.setInt32(_kStyleOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// How wide to make edges drawn when [style] is set to
@@ -1245,6 +1278,7 @@ class Paint {
   set strokeWidth(double value) {
     final double encoded = value;
     _data.setFloat32(_kStrokeWidthOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// The kind of finish to place on the end of lines drawn when
@@ -1257,6 +1291,7 @@ class Paint {
   set strokeCap(StrokeCap value) {
     final int encoded = value.index;
     _data.setInt32(_kStrokeCapOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// The kind of finish to place on the joins between segments.
@@ -1290,6 +1325,7 @@ class Paint {
   set strokeJoin(StrokeJoin value) {
     final int encoded = value.index;
     _data.setInt32(_kStrokeJoinOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   // Must be kept in sync with the default in paint.cc.
@@ -1327,6 +1363,7 @@ class Paint {
   set strokeMiterLimit(double value) {
     final double encoded = value - _kStrokeMiterLimitDefault;
     _data.setFloat32(_kStrokeMiterLimitOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// A mask filter (for example, a blur) to apply to a shape after it has been
@@ -1357,6 +1394,7 @@ class Paint {
       _data.setInt32(_kMaskFilterBlurStyleOffset, value._style.index, _kFakeHostEndian);
       _data.setFloat32(_kMaskFilterSigmaOffset, value._sigma, _kFakeHostEndian);
     }
+    _markChanged();
   }
 
   /// Controls the performance vs quality trade-off to use when sampling bitmaps,
@@ -1371,6 +1409,7 @@ class Paint {
   set filterQuality(FilterQuality value) {
     final int encoded = value.index;
     _data.setInt32(_kFilterQualityOffset, encoded, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// The shader to use when stroking or filling a shape.
@@ -1403,6 +1442,7 @@ class Paint {
       return true;
     }());
     _ensureObjectsInitialized()[_kShaderIndex] = value;
+    _markChanged();
   }
 
   /// A color filter to apply when a shape is drawn or when a layer is
@@ -1424,6 +1464,7 @@ class Paint {
     } else {
       _ensureObjectsInitialized()[_kColorFilterIndex] = nativeFilter;
     }
+    _markChanged();
   }
 
   /// The [ImageFilter] to use when drawing raster images.
@@ -1460,6 +1501,7 @@ class Paint {
         objects[_kImageFilterIndex] = value._toNativeImageFilter();
       }
     }
+    _markChanged();
   }
 
   /// Whether the colors of the image are inverted when drawn.
@@ -1472,6 +1514,7 @@ class Paint {
   }
   set invertColors(bool value) {
     _data.setInt32(_kInvertColorOffset, value ? 1 : 0, _kFakeHostEndian);
+    _markChanged();
   }
 
   bool get _dither {
@@ -1479,6 +1522,7 @@ class Paint {
   }
   set _dither(bool value) {
     _data.setInt32(_kDitherOffset, value ? 1 : 0, _kFakeHostEndian);
+    _markChanged();
   }
 
   /// Whether to dither the output when drawing images.
@@ -2738,12 +2782,19 @@ class Path extends NativeFieldWrapperClass1 {
   ///
   /// The `points` argument is interpreted as offsets from the origin.
   void addPolygon(List<Offset> points, bool close) {
-    _addPolygon(_encodePointList(points), close);
+    if (points.length <= _kMaxBufferedPointCount) {
+      _addPolygonFromBuffer(_bufferPointList(points), points.length, close);
+    } else {
+      _addPolygon(_encodePointList(points), close);
+    }
   }
 
   @Native<Void Function(Pointer<Void>, Handle, Bool)>(symbol: 'Path::addPolygon')
   external void _addPolygon(Float32List points, bool close);
 
+  @Native<Void Function(Pointer<Void>, Pointer<Float>, Uint32, Bool)>(symbol: 'Path::addPolygonFromBuffer', isLeaf: true)
+  external void _addPolygonFromBuffer(Pointer<Float> points, int pointCount, bool close);
+
   /// Adds a new sub-path that consists of the straight lines and
   /// curves needed to form the rounded rectangle described by the
   /// argument.
@@ -2889,6 +2940,53 @@ class Path extends NativeFieldWrapperClass1 {
   @Native<Bool Function(Pointer<Void>, Pointer<Void>, Pointer<Void>, Int32)>(symbol: 'Path::op')
   external bool _op(Path path1, Path path2, int operation);
 
+  /// Like [combine], but combines the paths on a background thread instead
+  /// of blocking the isolate, which is useful for complex paths.
+  ///
+  /// The paths may be modified or disposed while they are being combined,
+  /// without changing the result.
+  static Future<Path> combineAsync(PathOperation operation, Path path1, Path path2) {
+    final Path path = Path();
+    return _futurize<bool>((_Callback<bool> callback) {
+      return path._opAsync(path1, path2, operation.index, callback);
+    }).then((bool success) => _checkCombined(path, success));
+  }
+
+  @Native<Handle Function(Pointer<Void>, Pointer<Void>, Pointer<Void>, Int32, Handle)>(symbol: 'Path::opAsync')
+  external String? _opAsync(Path path1, Path path2, int operation, _Callback<bool> callback);
+
+  /// Combines all the `paths` with [PathOperation.union].
+  ///
+  /// This is much faster than combining the paths one by one with [combine],
+  /// as the paths are combined at once instead of simplifying every
+  /// intermediate union.
+  static Path unionAll(List<Path> paths) {
+    final Path path = Path();
+    return _checkCombined(path, path._unionAll(paths));
+  }
+
+  @Native<Bool Function(Pointer<Void>, Handle)>(symbol: 'Path::unionAll')
+  external bool _unionAll(List<Path> paths);
+
+  /// Like [unionAll], but combines the paths on a background thread, like
+  /// [combineAsync].
+  static Future<Path> unionAllAsync(List<Path> paths) {
+    final Path path = Path();
+    return _futurize<bool>((_Callback<bool> callback) {
+      return path._unionAllAsync(paths, callback);
+    }).then((bool success) => _checkCombined(path, success));
+  }
+
+  @Native<Handle Function(Pointer<Void>, Handle, Handle)>(symbol: 'Path::unionAllAsync')
+  external String? _unionAllAsync(List<Path> paths, _Callback<bool> callback);
+
+  static Path _checkCombined(Path path, bool success) {
+    if (success) {
+      return path;
+    }
+    throw StateError('Path combination failed.  This may be due an invalid path; in particular, check for NaN values.');
+  }
+
   /// Creates a [PathMetrics] object for this path, which can describe various
   /// properties about the contours of the path.
   ///
@@ -3100,6 +3198,21 @@ class PathMetric {
     return _measure.extractPath(contourIndex, start, end, startWithMoveTo: startWithMoveTo);
   }
 
+  /// Returns a single path with the segments between each pair of start and
+  /// end distances in `intervals`, which holds the distances of the segments
+  /// one after the other, as in `[start0, end0, start1, end1, ...]`.
+  ///
+  /// The distances are clamped like those of [extractPath]. Each segment
+  /// after the first begins with a moveTo, and the first one begins with a
+  /// moveTo if `startWithMoveTo` is true.
+  ///
+  /// This is equivalent to adding the results of [extractPath] for each pair
+  /// to one path, and is cheaper when extracting many segments, such as the
+  /// dashes of a dashed line.
+  Path extractPathSegments(Float32List intervals, {bool startWithMoveTo = true}) {
+    return _measure.extractPathSegments(contourIndex, intervals, startWithMoveTo: startWithMoveTo);
+  }
+
   @override
   String toString() => 'PathMetric(length: $length, isClosed: $isClosed, contourIndex: $contourIndex)';
 }
@@ -3149,6 +3262,20 @@ class _PathMeasure extends NativeFieldWrapperClass1 {
   @Native<Void Function(Pointer<Void>, Handle, Int32, Float, Float, Bool)>(symbol: 'PathMeasure::getSegment')
   external void _extractPath(Path outPath, int contourIndex, double start, double end, bool startWithMoveTo);
 
+  Path extractPathSegments(int contourIndex, Float32List intervals,
+      {bool startWithMoveTo = true}) {
+    assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
+    if (intervals.length.isOdd) {
+      throw ArgumentError('"intervals" must have an even number of entries (each segment is a start, end pair).');
+    }
+    final Path path = Path._();
+    _extractPathSegments(path, contourIndex, intervals, startWithMoveTo);
+    return path;
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Int32, Handle, Bool)>(symbol: 'PathMeasure::getSegments')
+  external void _extractPathSegments(Path outPath, int contourIndex, Float32List intervals, bool startWithMoveTo);
+
   bool isClosed(int contourIndex) {
     assert(contourIndex <= currentContourIndex, 'Iterator must be advanced before index $contourIndex can be used.');
     return _isClosed(contourIndex);
@@ -3953,6 +4080,32 @@ Float32List _encodePointList(List<Offset> points) {
   return result;
 }
 
+// The most points that [_bufferPointList] writes to the engine's point buffer.
+// Must match PointBuffer::kMaxPointCount.
+const int _kMaxBufferedPointCount = 4096;
+
+@Native<Pointer<Float> Function(Uint32)>(symbol: 'PointBuffer::Reserve', isLeaf: true)
+external Pointer<Float> _reservePointBuffer(int pointCount);
+
+// Writes the points to the engine's point buffer, which saves allocating a
+// [Float32List] for them and acquiring it in the engine. The buffer is only
+// valid until the next call, so it must be passed on to the engine right
+// away. There must be at most [_kMaxBufferedPointCount] points.
+Pointer<Float> _bufferPointList(List<Offset> points) {
+  final int pointCount = points.length;
+  assert(pointCount <= _kMaxBufferedPointCount);
+  final Pointer<Float> buffer = _reservePointBuffer(pointCount);
+  for (int i = 0; i < pointCount; ++i) {
+    final int xIndex = i * 2;
+    final int yIndex = xIndex + 1;
+    final Offset point = points[i];
+    assert(_offsetIsValid(point));
+    buffer[xIndex] = point.dx;
+    buffer[yIndex] = point.dy;
+  }
+  return buffer;
+}
+
 Float32List _encodeTwoPoints(Offset pointA, Offset pointB) {
   assert(_offsetIsValid(pointA));
   assert(_offsetIsValid(pointB));
@@ -4650,6 +4803,33 @@ class Vertices extends NativeFieldWrapperClass1 {
                              Int32List? colors,
                              Uint16List? indices);
 
+  /// Overwrites the data of these vertices in place.
+  ///
+  /// The lists that are given must have the same lengths as the lists these
+  /// vertices were created with, and [textureCoordinates] and [colors] may
+  /// only be given if these vertices were created with them. The lists that
+  /// are omitted keep their current values, and the indices and the
+  /// [VertexMode] can't be changed.
+  ///
+  /// Pictures that these vertices were already drawn into are not affected.
+  ///
+  /// Updating the positions or colors of a mesh whose topology stays the same
+  /// from frame to frame is cheaper than creating a new [Vertices] object each
+  /// frame, which allocates the whole mesh again.
+  void updateRaw({
+    Float32List? positions,
+    Int32List? colors,
+    Float32List? textureCoordinates,
+  }) {
+    assert(!_disposed);
+    if (!_update(positions, textureCoordinates, colors)) {
+      throw ArgumentError('"positions", "colors" and "textureCoordinates" must match the lists these vertices were created with.');
+    }
+  }
+
+  @Native<Bool Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'Vertices::update')
+  external bool _update(Float32List? positions, Float32List? textureCoordinates, Int32List? colors);
+
   /// Release the resources used by this object. The object is no longer usable
   /// after this method is called.
   void dispose() {
@@ -4773,6 +4953,90 @@ class Canvas extends NativeFieldWrapperClass1 {
   // garbage collected until PictureRecorder.endRecording is called.
   PictureRecorder? _recorder;
 
+  // Draws of lines, rectangles, rounded rectangles, ovals and circles made
+  // with paints that have no shader or filter objects are written into this
+  // buffer rather than recorded one native call at a time. The batch is
+  // recorded with a single native call when any other method of the canvas
+  // is called, when it is full, and when the recording ends.
+  //
+  // Each command of the batch is an opcode followed by its arguments. Must be
+  // kept in sync with the BatchOp enum in canvas.cc.
+  static const int _kBatchOpSetPaint = 0;
+  static const int _kBatchOpDrawLine = 1;
+  static const int _kBatchOpDrawRect = 2;
+  static const int _kBatchOpDrawRRect = 3;
+  static const int _kBatchOpDrawOval = 4;
+  static const int _kBatchOpDrawCircle = 5;
+
+  static const int _kPaintDataWordCount = Paint._kDataByteCount ~/ 4;
+  static const int _kBatchCapacity = 512; // In 32 bit words.
+
+  Float32List? _batch;
+  Uint32List? _batchWords;
+  int _batchLength = 0;
+
+  // The offset in the batch of the data of the paint of the last batched
+  // draw, or -1 if there is none.
+  int _batchPaintOffset = -1;
+
+  // Returns the offset in [_batch] at which to write the arguments of a
+  // batched draw, or -1 if the draw cannot be batched because of its paint,
+  // in which case the batch has been recorded and the draw should be made
+  // directly.
+  int _addBatchedDraw(int opcode, int argumentCount, Paint paint) {
+    if (paint._hasObjects) {
+      _flushBatch();
+      return -1;
+    }
+    final Float32List batch = _batch ??= Float32List(_kBatchCapacity);
+    final Uint32List words = _batchWords ??= batch.buffer.asUint32List();
+    final ByteData paintData = paint._data;
+    if (_batchLength + 2 + _kPaintDataWordCount + argumentCount > _kBatchCapacity) {
+      _flushBatch();
+    }
+    if (!_batchPaintMatches(words, paintData)) {
+      words[_batchLength] = _kBatchOpSetPaint;
+      _batchPaintOffset = _batchLength + 1;
+      for (int i = 0; i < _kPaintDataWordCount; i++) {
+        words[_batchPaintOffset + i] = paintData.getUint32(i * 4, _kFakeHostEndian);
+      }
+      _batchLength = _batchPaintOffset + _kPaintDataWordCount;
+    }
+    words[_batchLength] = opcode;
+    final int offset = _batchLength + 1;
+    _batchLength = offset + argumentCount;
+    return offset;
+  }
+
+  bool _batchPaintMatches(Uint32List words, ByteData paintData) {
+    if (_batchPaintOffset < 0) {
+      return false;
+    }
+    final int generation = paintData.getUint32(Paint._kGenerationOffset, _kFakeHostEndian);
+    if (generation != 0) {
+      return words[_batchPaintOffset + Paint._kGenerationIndex] == generation;
+    }
+    for (int i = 0; i < _kPaintDataWordCount; i++) {
+      if (words[_batchPaintOffset + i] != paintData.getUint32(i * 4, _kFakeHostEndian)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void _flushBatch() {
+    if (_batchLength == 0) {
+      return;
+    }
+    final int length = _batchLength;
+    _batchLength = 0;
+    _batchPaintOffset = -1;
+    _drawBatch(_batch!, length);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Int32)>(symbol: 'Canvas::drawBatch')
+  external void _drawBatch(Float32List commands, int length);
+
   /// Saves a copy of the current transform and clip on the save stack.
   ///
   /// Call [restore] to pop the save stack.
@@ -4781,8 +5045,13 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   ///  * [saveLayer], which does the same thing but additionally also groups the
   ///    commands done until the matching [restore].
+  void save() {
+    _flushBatch();
+    _save();
+  }
+
   @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::save', isLeaf: true)
-  external void save();
+  external void _save();
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -4894,6 +5163,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///  * [BlendMode], which discusses the use of [Paint.blendMode] with
   ///    [saveLayer].
   void saveLayer(Rect? bounds, Paint paint) {
+    _flushBatch();
     if (bounds == null) {
       _saveLayerWithoutBounds(paint._objects, paint._data);
     } else {
@@ -4915,8 +5185,13 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// If the state was pushed with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
+  void restore() {
+    _flushBatch();
+    _restore();
+  }
+
   @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::restore', isLeaf: true)
-  external void restore();
+  external void _restore();
 
   /// Restores the save stack to a previous level as might be obtained from [getSaveCount].
   /// If [count] is less than 1, the stack is restored to its initial state.
@@ -4927,8 +5202,13 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// If any of the state stack levels restored by this call were pushed with
   /// [saveLayer], then this call will also cause those layers to be composited
   /// into their previous layers.
+  void restoreToCount(int count) {
+    _flushBatch();
+    _restoreToCount(count);
+  }
+
   @Native<Void Function(Pointer<Void>, Int32)>(symbol: 'Canvas::restoreToCount', isLeaf: true)
-  external void restoreToCount(int count);
+  external void _restoreToCount(int count);
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -4936,13 +5216,23 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
+  int getSaveCount() {
+    _flushBatch();
+    return _getSaveCount();
+  }
+
   @Native<Int32 Function(Pointer<Void>)>(symbol: 'Canvas::getSaveCount', isLeaf: true)
-  external int getSaveCount();
+  external int _getSaveCount();
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
+  void translate(double dx, double dy) {
+    _flushBatch();
+    _translate(dx, dy);
+  }
+
   @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::translate', isLeaf: true)
-  external void translate(double dx, double dy);
+  external void _translate(double dx, double dy);
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
@@ -4950,25 +5240,39 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// If [sy] is unspecified, [sx] will be used for the scale in both
   /// directions.
-  void scale(double sx, [double? sy]) => _scale(sx, sy ?? sx);
+  void scale(double sx, [double? sy]) {
+    _flushBatch();
+    _scale(sx, sy ?? sx);
+  }
 
   @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::scale', isLeaf: true)
   external void _scale(double sx, double sy);
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
+  void rotate(double radians) {
+    _flushBatch();
+    _rotate(radians);
+  }
+
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Canvas::rotate', isLeaf: true)
-  external void rotate(double radians);
+  external void _rotate(double radians);
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in rise over run units clockwise around the
   /// origin, and the second argument being the vertical skew in rise over run
   /// units clockwise around the origin.
+  void skew(double sx, double sy) {
+    _flushBatch();
+    _skew(sx, sy);
+  }
+
   @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::skew', isLeaf: true)
-  external void skew(double sx, double sy);
+  external void _skew(double sx, double sy);
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
   void transform(Float64List matrix4) {
+    _flushBatch();
     if (matrix4.length != 16) {
       throw ArgumentError('"matrix4" must have 16 entries.');
     }
@@ -4987,6 +5291,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// the current transform by restoring it to the same value it had before its
   /// associated [save] or [saveLayer] call.
   Float64List getTransform() {
+    _flushBatch();
     final Float64List matrix4 = Float64List(16);
     _getTransform(matrix4);
     return matrix4;
@@ -5009,6 +5314,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// Use [ClipOp.difference] to subtract the provided rectangle from the
   /// current clip.
   void clipRect(Rect rect, { ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true }) {
+    _flushBatch();
     assert(_rectIsValid(rect));
     _clipRect(rect.left, rect.top, rect.right, rect.bottom, clipOp.index, doAntiAlias);
   }
@@ -5027,6 +5333,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// in incorrect blending at the clip boundary. See [saveLayer] for a
   /// discussion of how to address that and some examples of using [clipRRect].
   void clipRRect(RRect rrect, {bool doAntiAlias = true}) {
+    _flushBatch();
     assert(_rrectIsValid(rrect));
     _clipRRect(rrect._getValue32(), doAntiAlias);
   }
@@ -5045,6 +5352,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// in incorrect blending at the clip boundary. See [saveLayer] for a
   /// discussion of how to address that.
   void clipPath(Path path, {bool doAntiAlias = true}) {
+    _flushBatch();
     _clipPath(path, doAntiAlias);
   }
 
@@ -5104,6 +5412,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [saveLayer] call.
   /// {@endtemplate}
   Rect getLocalClipBounds() {
+    _flushBatch();
     final Float64List bounds = Float64List(4);
     _getLocalClipBounds(bounds);
     return Rect.fromLTRB(bounds[0], bounds[1], bounds[2], bounds[3]);
@@ -5127,6 +5436,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// {@macro dart.ui.canvas.conservativeClipBounds}
   Rect getDestinationClipBounds() {
+    _flushBatch();
     final Float64List bounds = Float64List(4);
     _getDestinationClipBounds(bounds);
     return Rect.fromLTRB(bounds[0], bounds[1], bounds[2], bounds[3]);
@@ -5139,6 +5449,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [BlendMode], with the given color being the source and the background
   /// being the destination.
   void drawColor(Color color, BlendMode blendMode) {
+    _flushBatch();
     _drawColor(color.value, blendMode.index);
   }
 
@@ -5155,7 +5466,16 @@ class Canvas extends NativeFieldWrapperClass1 {
   void drawLine(Offset p1, Offset p2, Paint paint) {
     assert(_offsetIsValid(p1));
     assert(_offsetIsValid(p2));
-    _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
+    final int offset = _addBatchedDraw(_kBatchOpDrawLine, 4, paint);
+    if (offset < 0) {
+      _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
+      return;
+    }
+    _batch!
+      ..[offset] = p1.dx
+      ..[offset + 1] = p1.dy
+      ..[offset + 2] = p2.dx
+      ..[offset + 3] = p2.dy;
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Handle, Handle)>(symbol: 'Canvas::drawLine')
@@ -5166,6 +5486,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// To fill the canvas with a solid color and blend mode, consider
   /// [drawColor] instead.
   void drawPaint(Paint paint) {
+    _flushBatch();
     _drawPaint(paint._objects, paint._data);
   }
 
@@ -5179,7 +5500,16 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_rect_dark.png#gh-dark-mode-only)
   void drawRect(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
-    _drawRect(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+    final int offset = _addBatchedDraw(_kBatchOpDrawRect, 4, paint);
+    if (offset < 0) {
+      _drawRect(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+      return;
+    }
+    _batch!
+      ..[offset] = rect.left
+      ..[offset + 1] = rect.top
+      ..[offset + 2] = rect.right
+      ..[offset + 3] = rect.bottom;
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Handle, Handle)>(symbol: 'Canvas::drawRect')
@@ -5192,7 +5522,24 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_rrect_dark.png#gh-dark-mode-only)
   void drawRRect(RRect rrect, Paint paint) {
     assert(_rrectIsValid(rrect));
-    _drawRRect(rrect._getValue32(), paint._objects, paint._data);
+    final int offset = _addBatchedDraw(_kBatchOpDrawRRect, 12, paint);
+    if (offset < 0) {
+      _drawRRect(rrect._getValue32(), paint._objects, paint._data);
+      return;
+    }
+    _batch!
+      ..[offset] = rrect.left
+      ..[offset + 1] = rrect.top
+      ..[offset + 2] = rrect.right
+      ..[offset + 3] = rrect.bottom
+      ..[offset + 4] = rrect.tlRadiusX
+      ..[offset + 5] = rrect.tlRadiusY
+      ..[offset + 6] = rrect.trRadiusX
+      ..[offset + 7] = rrect.trRadiusY
+      ..[offset + 8] = rrect.brRadiusX
+      ..[offset + 9] = rrect.brRadiusY
+      ..[offset + 10] = rrect.blRadiusX
+      ..[offset + 11] = rrect.blRadiusY;
   }
 
   @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'Canvas::drawRRect')
@@ -5204,6 +5551,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// This shape is almost but not quite entirely unlike an annulus.
   void drawDRRect(RRect outer, RRect inner, Paint paint) {
+    _flushBatch();
     assert(_rrectIsValid(outer));
     assert(_rrectIsValid(inner));
     _drawDRRect(outer._getValue32(), inner._getValue32(), paint._objects, paint._data);
@@ -5220,7 +5568,16 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_oval_dark.png#gh-dark-mode-only)
   void drawOval(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
-    _drawOval(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+    final int offset = _addBatchedDraw(_kBatchOpDrawOval, 4, paint);
+    if (offset < 0) {
+      _drawOval(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
+      return;
+    }
+    _batch!
+      ..[offset] = rect.left
+      ..[offset + 1] = rect.top
+      ..[offset + 2] = rect.right
+      ..[offset + 3] = rect.bottom;
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Handle, Handle)>(symbol: 'Canvas::drawOval')
@@ -5235,7 +5592,15 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_circle_dark.png#gh-dark-mode-only)
   void drawCircle(Offset c, double radius, Paint paint) {
     assert(_offsetIsValid(c));
-    _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
+    final int offset = _addBatchedDraw(_kBatchOpDrawCircle, 3, paint);
+    if (offset < 0) {
+      _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
+      return;
+    }
+    _batch!
+      ..[offset] = c.dx
+      ..[offset + 1] = c.dy
+      ..[offset + 2] = radius;
   }
 
   @Native<Void Function(Pointer<Void>, Double, Double, Double, Handle, Handle)>(symbol: 'Canvas::drawCircle')
@@ -5256,6 +5621,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// This method is optimized for drawing arcs and should be faster than [Path.arcTo].
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
+    _flushBatch();
     assert(_rectIsValid(rect));
     _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, useCenter, paint._objects, paint._data);
   }
@@ -5278,6 +5644,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [Paint.style]. If the path is filled, then sub-paths within it are
   /// implicitly closed (see [Path.close]).
   void drawPath(Path path, Paint paint) {
+    _flushBatch();
     _drawPath(path, paint._objects, paint._data);
   }
 
@@ -5287,6 +5654,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// Draws the given [Image] into the canvas with its top-left corner at the
   /// given [Offset]. The image is composited into the canvas using the given [Paint].
   void drawImage(Image image, Offset offset, Paint paint) {
+    _flushBatch();
     assert(!image.debugDisposed);
     assert(_offsetIsValid(offset));
     final String? error = _drawImage(image._image, offset.dx, offset.dy, paint._objects, paint._data, paint.filterQuality.index);
@@ -5308,6 +5676,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// image) can be batched into a single call to [drawAtlas] to improve
   /// performance.
   void drawImageRect(Image image, Rect src, Rect dst, Paint paint) {
+    _flushBatch();
     assert(!image.debugDisposed);
     assert(_rectIsValid(src));
     assert(_rectIsValid(dst));
@@ -5357,6 +5726,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// cover the destination rectangle while maintaining their relative
   /// positions.
   void drawImageNine(Image image, Rect center, Rect dst, Paint paint) {
+    _flushBatch();
     assert(!image.debugDisposed);
     assert(_rectIsValid(center));
     assert(_rectIsValid(dst));
@@ -5395,6 +5765,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// Draw the given picture onto the canvas. To create a picture, see
   /// [PictureRecorder].
   void drawPicture(Picture picture) {
+    _flushBatch();
     assert(!picture.debugDisposed);
     _drawPicture(picture);
   }
@@ -5423,6 +5794,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// described by adding half of the [ParagraphConstraints.width] given to
   /// [Paragraph.layout], to the `offset` argument's [Offset.dx] coordinate.
   void drawParagraph(Paragraph paragraph, Offset offset) {
+    _flushBatch();
     assert(!paragraph.debugDisposed);
     assert(_offsetIsValid(offset));
     assert(!paragraph._needsLayout);
@@ -5441,7 +5813,12 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///  * [drawRawPoints], which takes `points` as a [Float32List] rather than a
   ///    [List<Offset>].
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint) {
-    _drawPoints(paint._objects, paint._data, pointMode.index, _encodePointList(points));
+    _flushBatch();
+    if (points.length <= _kMaxBufferedPointCount) {
+      _drawPointsFromBuffer(paint._objects, paint._data, pointMode.index, _bufferPointList(points), points.length);
+    } else {
+      _drawPoints(paint._objects, paint._data, pointMode.index, _encodePointList(points));
+    }
   }
 
   /// Draws a sequence of points according to the given [PointMode].
@@ -5457,6 +5834,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///  * [drawPoints], which takes `points` as a [List<Offset>] rather than a
   ///    [List<Float32List>].
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint) {
+    _flushBatch();
     if (points.length % 2 != 0) {
       throw ArgumentError('"points" must have an even number of values.');
     }
@@ -5466,6 +5844,9 @@ class Canvas extends NativeFieldWrapperClass1 {
   @Native<Void Function(Pointer<Void>, Handle, Handle, Int32, Handle)>(symbol: 'Canvas::drawPoints')
   external void _drawPoints(List<Object?>? paintObjects, ByteData paintData, int pointMode, Float32List points);
 
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Int32, Pointer<Float>, Uint32)>(symbol: 'Canvas::drawPointsFromBuffer')
+  external void _drawPointsFromBuffer(List<Object?>? paintObjects, ByteData paintData, int pointMode, Pointer<Float> points, int pointCount);
+
   /// Draws a set of [Vertices] onto the canvas as one or more triangles.
   ///
   /// The [Paint.color] property specifies the default color to use for the
@@ -5495,6 +5876,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///     rather than unencoded lists.
   ///   * [paint], Image shaders can be used to draw images on a triangular mesh.
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint) {
+    _flushBatch();
     assert(!vertices.debugDisposed);
     _drawVertices(vertices, blendMode.index, paint._objects, paint._data);
   }
@@ -5640,6 +6022,7 @@ class Canvas extends NativeFieldWrapperClass1 {
                  BlendMode? blendMode,
                  Rect? cullRect,
                  Paint paint) {
+    _flushBatch();
     assert(!atlas.debugDisposed);
     assert(colors == null || colors.isEmpty || blendMode != null);
 
@@ -5840,6 +6223,7 @@ class Canvas extends NativeFieldWrapperClass1 {
                     BlendMode? blendMode,
                     Rect? cullRect,
                     Paint paint) {
+    _flushBatch();
     assert(colors == null || blendMode != null);
 
     final int rectCount = rects.length;
@@ -5883,6 +6267,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// The arguments must not be null.
   void drawShadow(Path path, Color color, double elevation, bool transparentOccluder) {
+    _flushBatch();
     _drawShadow(path, color.value, elevation, transparentOccluder);
   }
 
@@ -6015,6 +6400,44 @@ class Picture extends NativeFieldWrapperClass1 {
   /// references to image or other large objects.
   @Native<Uint64 Function(Pointer<Void>)>(symbol: 'Picture::GetAllocationSize', isLeaf: true)
   external int get approximateBytesUsed;
+
+  @Native<Int64 Function(Pointer<Void>)>(symbol: 'Picture::transfer', isLeaf: true)
+  external int _transfer();
+}
+
+/// A [Picture] on its way to another isolate.
+///
+/// Pictures can't be sent to other isolates themselves. Instead, a picture
+/// recorded on a background isolate, such as one started with `Isolate.spawn`,
+/// can be wrapped in a [TransferablePicture] and sent to the UI isolate, or to
+/// any other isolate of the same isolate group. The isolates share the
+/// recording of the picture, so it is not copied.
+///
+/// The recording is kept until [materialize] is called, which can only happen
+/// once across all the copies of a [TransferablePicture].
+class TransferablePicture {
+  /// Wraps the recording of `picture`, and disposes `picture`.
+  TransferablePicture(Picture picture) : _handle = picture._transfer() {
+    picture.dispose();
+  }
+
+  final int _handle;
+
+  /// Creates a [Picture] of the recording on the current isolate.
+  ///
+  /// Throws a [StateError] if this or another copy of this object was already
+  /// materialized.
+  Picture materialize() {
+    final Picture picture = Picture._();
+    if (!_createPicture(picture, _handle)) {
+      throw StateError('This TransferablePicture was already materialized.');
+    }
+    Picture.onCreate?.call(picture);
+    return picture;
+  }
+
+  @Native<Bool Function(Handle, Int64)>(symbol: 'Picture::CreateFromTransfer')
+  external static bool _createPicture(Picture outPicture, int handle);
 }
 
 /// Records a [Picture] containing a sequence of graphical operations.
@@ -6049,6 +6472,7 @@ class PictureRecorder extends NativeFieldWrapperClass1 {
     if (_canvas == null) {
       throw StateError('PictureRecorder did not start recording.');
     }
+    _canvas!._flushBatch();
     final Picture picture = Picture._();
     _endRecording(picture);
     _canvas!._recorder = null;
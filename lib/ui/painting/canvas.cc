@@ -18,6 +18,46 @@ using tonic::ToDart;
 
 namespace flutter {
 
+namespace {
+
+// The commands of a batch, each followed by its arguments. Must be kept in
+// sync with the batch opcodes in painting.dart.
+enum class BatchOp : uint32_t {
+  // The data of the paint of the draws that follow.
+  kSetPaint,
+  // x1, y1, x2, y2
+  kDrawLine,
+  // left, top, right, bottom
+  kDrawRect,
+  // left, top, right, bottom, followed by the x and y radii of the top left,
+  // top right, bottom right and bottom left corners
+  kDrawRRect,
+  // left, top, right, bottom
+  kDrawOval,
+  // x, y, radius
+  kDrawCircle,
+};
+
+// Returns the number of words of the arguments of |op|, or -1 if |op| is
+// not a batch command.
+int BatchOpArgumentCount(BatchOp op) {
+  switch (op) {
+    case BatchOp::kSetPaint:
+      return static_cast<int>(Paint::kDataWordCount);
+    case BatchOp::kDrawLine:
+    case BatchOp::kDrawRect:
+    case BatchOp::kDrawOval:
+      return 4;
+    case BatchOp::kDrawRRect:
+      return 12;
+    case BatchOp::kDrawCircle:
+      return 3;
+  }
+  return -1;
+}
+
+}  // namespace
+
 IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
 
 void Canvas::Create(Dart_Handle wrapper,
@@ -26,7 +66,6 @@ void Canvas::Create(Dart_Handle wrapper,
                     double top,
                     double right,
                     double bottom) {
-  UIDartState::ThrowIfUIOperationsProhibited();
 
   if (!recorder) {
     Dart_ThrowException(
@@ -58,7 +97,7 @@ void Canvas::saveLayerWithoutBounds(Dart_Handle paint_objects,
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
     bool restore_with_paint =
-        paint.sync_to(builder(), kSaveLayerWithPaintFlags);
+        paint.sync_to(builder(), kSaveLayerWithPaintFlags, &synced_paint_);
     FML_DCHECK(restore_with_paint);
     TRACE_EVENT0("flutter", "ui.Canvas::saveLayer (Recorded)");
     builder()->saveLayer(nullptr, restore_with_paint);
@@ -77,7 +116,7 @@ void Canvas::saveLayer(double left,
   SkRect bounds = SkRect::MakeLTRB(left, top, right, bottom);
   if (display_list_builder_) {
     bool restore_with_paint =
-        paint.sync_to(builder(), kSaveLayerWithPaintFlags);
+        paint.sync_to(builder(), kSaveLayerWithPaintFlags, &synced_paint_);
     FML_DCHECK(restore_with_paint);
     TRACE_EVENT0("flutter", "ui.Canvas::saveLayer (Recorded)");
     builder()->saveLayer(&bounds, restore_with_paint);
@@ -222,7 +261,7 @@ void Canvas::drawLine(double x1,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawLineFlags);
+    paint.sync_to(builder(), kDrawLineFlags, &synced_paint_);
     builder()->drawLine(SkPoint::Make(x1, y1), SkPoint::Make(x2, y2));
   }
 }
@@ -232,7 +271,7 @@ void Canvas::drawPaint(Dart_Handle paint_objects, Dart_Handle paint_data) {
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawPaintFlags);
+    paint.sync_to(builder(), kDrawPaintFlags, &synced_paint_);
     std::shared_ptr<const DlImageFilter> filter = builder()->getImageFilter();
     if (filter && !filter->asColorFilter()) {
       // drawPaint does an implicit saveLayer if an SkImageFilter is
@@ -253,7 +292,7 @@ void Canvas::drawRect(double left,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawRectFlags);
+    paint.sync_to(builder(), kDrawRectFlags, &synced_paint_);
     builder()->drawRect(SkRect::MakeLTRB(left, top, right, bottom));
   }
 }
@@ -265,7 +304,7 @@ void Canvas::drawRRect(const RRect& rrect,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawRRectFlags);
+    paint.sync_to(builder(), kDrawRRectFlags, &synced_paint_);
     builder()->drawRRect(rrect.sk_rrect);
   }
 }
@@ -278,7 +317,7 @@ void Canvas::drawDRRect(const RRect& outer,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawDRRectFlags);
+    paint.sync_to(builder(), kDrawDRRectFlags, &synced_paint_);
     builder()->drawDRRect(outer.sk_rrect, inner.sk_rrect);
   }
 }
@@ -293,7 +332,7 @@ void Canvas::drawOval(double left,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawOvalFlags);
+    paint.sync_to(builder(), kDrawOvalFlags, &synced_paint_);
     builder()->drawOval(SkRect::MakeLTRB(left, top, right, bottom));
   }
 }
@@ -307,7 +346,7 @@ void Canvas::drawCircle(double x,
 
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawCircleFlags);
+    paint.sync_to(builder(), kDrawCircleFlags, &synced_paint_);
     builder()->drawCircle(SkPoint::Make(x, y), radius);
   }
 }
@@ -328,7 +367,8 @@ void Canvas::drawArc(double left,
     paint.sync_to(builder(),
                   useCenter  //
                       ? kDrawArcWithCenterFlags
-                      : kDrawArcNoCenterFlags);
+                      : kDrawArcNoCenterFlags,
+                  &synced_paint_);
     builder()->drawArc(SkRect::MakeLTRB(left, top, right, bottom),
                        startAngle * 180.0 / M_PI, sweepAngle * 180.0 / M_PI,
                        useCenter);
@@ -347,7 +387,7 @@ void Canvas::drawPath(const CanvasPath* path,
     return;
   }
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawPathFlags);
+    paint.sync_to(builder(), kDrawPathFlags, &synced_paint_);
     builder()->drawPath(path->path());
   }
 }
@@ -376,7 +416,8 @@ Dart_Handle Canvas::drawImage(const CanvasImage* image,
 
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
   if (display_list_builder_) {
-    bool with_attributes = paint.sync_to(builder(), kDrawImageWithPaintFlags);
+    bool with_attributes =
+        paint.sync_to(builder(), kDrawImageWithPaintFlags, &synced_paint_);
     builder()->drawImage(dl_image, SkPoint::Make(x, y), sampling,
                          with_attributes);
   }
@@ -416,7 +457,7 @@ Dart_Handle Canvas::drawImageRect(const CanvasImage* image,
   auto sampling = ImageFilter::SamplingFromIndex(filterQualityIndex);
   if (display_list_builder_) {
     bool with_attributes =
-        paint.sync_to(builder(), kDrawImageRectWithPaintFlags);
+        paint.sync_to(builder(), kDrawImageRectWithPaintFlags, &synced_paint_);
     builder()->drawImageRect(dl_image, src, dst, sampling, with_attributes,
                              SkCanvas::kFast_SrcRectConstraint);
   }
@@ -458,7 +499,7 @@ Dart_Handle Canvas::drawImageNine(const CanvasImage* image,
   auto filter = ImageFilter::FilterModeFromIndex(bitmapSamplingIndex);
   if (display_list_builder_) {
     bool with_attributes =
-        paint.sync_to(builder(), kDrawImageNineWithPaintFlags);
+        paint.sync_to(builder(), kDrawImageNineWithPaintFlags, &synced_paint_);
     builder()->drawImageNine(dl_image, icenter, dst, filter, with_attributes);
   }
   return Dart_Null();
@@ -483,6 +524,15 @@ void Canvas::drawPoints(Dart_Handle paint_objects,
                         Dart_Handle paint_data,
                         SkCanvas::PointMode point_mode,
                         const tonic::Float32List& points) {
+  drawPointsFromBuffer(paint_objects, paint_data, point_mode, points.data(),
+                       points.num_elements() / 2);  // SkPoints have 2 floats
+}
+
+void Canvas::drawPointsFromBuffer(Dart_Handle paint_objects,
+                                  Dart_Handle paint_data,
+                                  SkCanvas::PointMode point_mode,
+                                  const float* points,
+                                  uint32_t point_count) {
   Paint paint(paint_objects, paint_data);
 
   static_assert(sizeof(SkPoint) == sizeof(float) * 2,
@@ -492,18 +542,17 @@ void Canvas::drawPoints(Dart_Handle paint_objects,
   if (display_list_builder_) {
     switch (point_mode) {
       case SkCanvas::kPoints_PointMode:
-        paint.sync_to(builder(), kDrawPointsAsPointsFlags);
+        paint.sync_to(builder(), kDrawPointsAsPointsFlags, &synced_paint_);
         break;
       case SkCanvas::kLines_PointMode:
-        paint.sync_to(builder(), kDrawPointsAsLinesFlags);
+        paint.sync_to(builder(), kDrawPointsAsLinesFlags, &synced_paint_);
         break;
       case SkCanvas::kPolygon_PointMode:
-        paint.sync_to(builder(), kDrawPointsAsPolygonFlags);
+        paint.sync_to(builder(), kDrawPointsAsPolygonFlags, &synced_paint_);
         break;
     }
-    builder()->drawPoints(point_mode,
-                          points.num_elements() / 2,  // SkPoints have 2 floats
-                          reinterpret_cast<const SkPoint*>(points.data()));
+    builder()->drawPoints(point_mode, point_count,
+                          reinterpret_cast<const SkPoint*>(points));
   }
 }
 
@@ -520,7 +569,7 @@ void Canvas::drawVertices(const Vertices* vertices,
   }
   FML_DCHECK(paint.isNotNull());
   if (display_list_builder_) {
-    paint.sync_to(builder(), kDrawVerticesFlags);
+    paint.sync_to(builder(), kDrawVerticesFlags, &synced_paint_);
     builder()->drawVertices(vertices->vertices(), blend_mode);
   }
 }
@@ -562,7 +611,8 @@ Dart_Handle Canvas::drawAtlas(Dart_Handle paint_objects,
     tonic::Int32List colors(colors_handle);
     tonic::Float32List cull_rect(cull_rect_handle);
 
-    bool with_attributes = paint.sync_to(builder(), kDrawAtlasWithPaintFlags);
+    bool with_attributes =
+        paint.sync_to(builder(), kDrawAtlasWithPaintFlags, &synced_paint_);
     builder()->drawAtlas(
         dl_image, reinterpret_cast<const SkRSXform*>(transforms.data()),
         reinterpret_cast<const SkRect*>(rects.data()),
@@ -583,9 +633,14 @@ void Canvas::drawShadow(const CanvasPath* path,
         ToDart("Canvas.drawShader called with non-genuine Path."));
     return;
   }
-  SkScalar dpr = UIDartState::Current()
-                     ->platform_configuration()
-                     ->get_window(0)
+  auto* platform_configuration =
+      UIDartState::Current()->platform_configuration();
+  if (!platform_configuration) {
+    Dart_ThrowException(
+        ToDart("Canvas.drawShadow is only available on the root isolate."));
+    return;
+  }
+  SkScalar dpr = platform_configuration->get_window(0)
                      ->viewport_metrics()
                      .device_pixel_ratio;
   if (display_list_builder_) {
@@ -601,6 +656,74 @@ void Canvas::drawShadow(const CanvasPath* path,
   }
 }
 
+void Canvas::drawBatch(const tonic::Float32List& commands, int length) {
+  if (length < 0 || static_cast<size_t>(length) > commands.num_elements()) {
+    Dart_ThrowException(ToDart("Canvas batch length is out of range."));
+    return;
+  }
+  if (!display_list_builder_) {
+    return;
+  }
+
+  const void* data = commands.data();
+  const uint32_t* words = static_cast<const uint32_t*>(data);
+  const float* floats = static_cast<const float*>(data);
+  const uint32_t* paint_data = nullptr;
+  int index = 0;
+  while (index < length) {
+    BatchOp op = static_cast<BatchOp>(words[index++]);
+    int argument_count = BatchOpArgumentCount(op);
+    if (argument_count < 0 || length - index < argument_count ||
+        (op != BatchOp::kSetPaint && !paint_data)) {
+      Dart_ThrowException(ToDart("Canvas batch is malformed."));
+      return;
+    }
+    const float* args = floats + index;
+    switch (op) {
+      case BatchOp::kSetPaint:
+        paint_data = words + index;
+        break;
+      case BatchOp::kDrawLine:
+        Paint::sync_data_to(paint_data, builder(), kDrawLineFlags,
+                            &synced_paint_);
+        builder()->drawLine(SkPoint::Make(args[0], args[1]),
+                            SkPoint::Make(args[2], args[3]));
+        break;
+      case BatchOp::kDrawRect:
+        Paint::sync_data_to(paint_data, builder(), kDrawRectFlags,
+                            &synced_paint_);
+        builder()->drawRect(
+            SkRect::MakeLTRB(args[0], args[1], args[2], args[3]));
+        break;
+      case BatchOp::kDrawRRect: {
+        Paint::sync_data_to(paint_data, builder(), kDrawRRectFlags,
+                            &synced_paint_);
+        SkVector radii[4] = {{args[4], args[5]},
+                             {args[6], args[7]},
+                             {args[8], args[9]},
+                             {args[10], args[11]}};
+        SkRRect rrect;
+        rrect.setRectRadii(
+            SkRect::MakeLTRB(args[0], args[1], args[2], args[3]), radii);
+        builder()->drawRRect(rrect);
+        break;
+      }
+      case BatchOp::kDrawOval:
+        Paint::sync_data_to(paint_data, builder(), kDrawOvalFlags,
+                            &synced_paint_);
+        builder()->drawOval(
+            SkRect::MakeLTRB(args[0], args[1], args[2], args[3]));
+        break;
+      case BatchOp::kDrawCircle:
+        Paint::sync_data_to(paint_data, builder(), kDrawCircleFlags,
+                            &synced_paint_);
+        builder()->drawCircle(SkPoint::Make(args[0], args[1]), args[2]);
+        break;
+    }
+    index += argument_count;
+  }
+}
+
 void Canvas::Invalidate() {
   display_list_builder_ = nullptr;
   if (dart_wrapper()) {
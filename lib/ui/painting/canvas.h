@@ -8,6 +8,7 @@
 #include "flutter/display_list/display_list_blend_mode.h"
 #include "flutter/display_list/display_list_flags.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/painting/path.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
@@ -164,6 +165,13 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   SkCanvas::PointMode point_mode,
                   const tonic::Float32List& points);
 
+  // Like |drawPoints|, with the points in the |PointBuffer|.
+  void drawPointsFromBuffer(Dart_Handle paint_objects,
+                            Dart_Handle paint_data,
+                            SkCanvas::PointMode point_mode,
+                            const float* points,
+                            uint32_t point_count);
+
   void drawVertices(const Vertices* vertices,
                     DlBlendMode blend_mode,
                     Dart_Handle paint_objects,
@@ -184,10 +192,20 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double elevation,
                   bool transparentOccluder);
 
+  // Records the first |length| words of a batch of draw commands written by
+  // the Dart Canvas, which batches simple draws made with paints that have
+  // no shader or filter objects so that they cost one native call between
+  // them. See the batch opcodes in canvas.cc.
+  void drawBatch(const tonic::Float32List& commands, int length);
+
   void Invalidate();
 
   DisplayListBuilder* builder() { return display_list_builder_.get(); }
 
+  // Must be called after setting attributes of |builder()| other than from a
+  // Paint, such as when painting a paragraph.
+  void ResetSyncedPaint() { synced_paint_.Reset(); }
+
  private:
   explicit Canvas(sk_sp<DisplayListBuilder> builder);
 
@@ -198,6 +216,9 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
   // paint attributes from an SkPaint and an operation type as well as access
   // to the raw DisplayListBuilder for emitting custom rendering operations.
   sk_sp<DisplayListBuilder> display_list_builder_;
+
+  // The paint the attributes of the builder were last synchronized from.
+  SyncedPaint synced_paint_;
 };
 
 }  // namespace flutter
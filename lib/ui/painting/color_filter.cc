@@ -17,7 +17,6 @@ namespace flutter {
 IMPLEMENT_WRAPPERTYPEINFO(ui, ColorFilter);
 
 void ColorFilter::Create(Dart_Handle wrapper) {
-  UIDartState::ThrowIfUIOperationsProhibited();
   auto res = fml::MakeRefCounted<ColorFilter>();
   res->AssociateWithDartWrapper(wrapper);
 }
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <functional>
+#include <iterator>
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_descriptor.h"
+
+namespace flutter {
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  return hash == other.hash &&                    //
+         target_width == other.target_width &&    //
+         target_height == other.target_height &&  //
+         frame_index == other.frame_index &&      //
+         row_bytes == other.row_bytes &&          //
+         image_info == other.image_info &&        //
+         data->equals(other.data.get());
+}
+
+// static
+size_t DecodedImageCache::HashData(const SkData& data) {
+  return std::hash<std::string_view>{}(std::string_view(
+      reinterpret_cast<const char*>(data.data()), data.size()));
+}
+
+// static
+std::optional<DecodedImageCache::Key> DecodedImageCache::MakeKey(
+    const ImageDescriptor& descriptor,
+    uint32_t target_width,
+    uint32_t target_height) {
+  auto data = descriptor.data();
+  if (!data || data->size() == 0) {
+    return std::nullopt;
+  }
+
+  TRACE_EVENT0("flutter", "DecodedImageCache::MakeKey");
+  const auto& image_info = descriptor.image_info();
+  const size_t content_hash = HashData(*data);
+  return Key{
+      .hash = fml::HashCombine(content_hash, image_info.width(),
+                               image_info.height(), image_info.colorType(),
+                               image_info.alphaType(), descriptor.row_bytes(),
+                               target_width, target_height),
+      .data = std::move(data),
+      .image_info = image_info,
+      .row_bytes = static_cast<size_t>(descriptor.row_bytes()),
+      .target_width = target_width,
+      .target_height = target_height,
+  };
+}
+
+// static
+DecodedImageCache::Key DecodedImageCache::MakeFrameKey(
+    sk_sp<SkData> data,
+    size_t data_hash,
+    const SkImageInfo& image_info,
+    int frame_index) {
+  FML_DCHECK(frame_index >= 0);
+  return Key{
+      .hash = fml::HashCombine(data_hash, image_info.width(),
+                               image_info.height(), image_info.colorType(),
+                               image_info.alphaType(), frame_index),
+      .data = std::move(data),
+      .image_info = image_info,
+      .frame_index = frame_index,
+  };
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+sk_sp<DlImage> DecodedImageCache::Get(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = entries_by_hash_.find(key.hash);
+  if (found == entries_by_hash_.end() || !(found->second->key == key)) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->image;
+}
+
+void DecodedImageCache::Put(const Key& key, sk_sp<DlImage> image) {
+  if (!image) {
+    return;
+  }
+  const size_t bytes = image->GetApproximateByteSize();
+  if (bytes > max_bytes_) {
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (auto found = entries_by_hash_.find(key.hash);
+      found != entries_by_hash_.end()) {
+    // Either another decode of the same image finished first, or a different
+    // image has the same hash. Keep the entry that is already cached.
+    return;
+  }
+
+  entries_.push_front(
+      Entry{.key = key, .image = std::move(image), .bytes = bytes});
+  entries_by_hash_[key.hash] = entries_.begin();
+  retained_bytes_ += bytes;
+  while (retained_bytes_ > max_bytes_) {
+    EvictLocked(std::prev(entries_.end()));
+  }
+}
+
+void DecodedImageCache::EvictLocked(EntryList::iterator entry) {
+  retained_bytes_ -= entry->bytes;
+  entries_by_hash_.erase(entry->key.hash);
+  entries_.erase(entry);
+}
+
+void DecodedImageCache::Purge() {
+  // The images are released outside of the lock, since releasing a texture
+  // may take a while.
+  EntryList entries;
+  {
+    std::scoped_lock lock(mutex_);
+    entries.swap(entries_);
+    entries_by_hash_.clear();
+    retained_bytes_ = 0u;
+  }
+}
+
+size_t DecodedImageCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t DecodedImageCache::GetRetainedBytes() const {
+  std::scoped_lock lock(mutex_);
+  return retained_bytes_;
+}
+
+}  // namespace flutter
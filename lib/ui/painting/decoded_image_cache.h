@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace flutter {
+
+class ImageDescriptor;
+
+//------------------------------------------------------------------------------
+/// A cache of the images that the image decoders decoded and uploaded, so
+/// that the same image requested by several isolates or by the engines
+/// spawned from one shell, which share their IO manager, is only decoded
+/// once.
+///
+/// Images are keyed by the hash of the bytes of their descriptor, by the
+/// information of the image and by the size they were decoded at. The frames
+/// of animated images are cached too, keyed by their index. The cache
+/// keeps the most recently used images within a budget of bytes. Purging it
+/// drops every image that is not referenced anywhere else, which frees its
+/// memory.
+///
+/// The cache may be used from any thread.
+///
+class DecodedImageCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 64u * 1024u * 1024u;
+
+  struct Key {
+    size_t hash = 0u;
+    sk_sp<SkData> data;
+    SkImageInfo image_info;
+    size_t row_bytes = 0u;
+    uint32_t target_width = 0u;
+    uint32_t target_height = 0u;
+    // The index of the frame of an animated image, or -1 for a still image.
+    int frame_index = -1;
+
+    bool operator==(const Key& other) const;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hashes the bytes of encoded image data, for |MakeFrameKey|.
+  ///
+  static size_t HashData(const SkData& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key of an image decoded from a descriptor at a
+  ///             target size, or `std::nullopt` if the descriptor has no
+  ///             data.
+  ///
+  static std::optional<Key> MakeKey(const ImageDescriptor& descriptor,
+                                    uint32_t target_width,
+                                    uint32_t target_height);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key of a frame of an animated image decoded at
+  ///             its full size.
+  ///
+  /// @param[in]  data          The encoded image.
+  /// @param[in]  data_hash     The |HashData| of |data|, which the codec of
+  ///                           the image computes once for all its frames.
+  /// @param[in]  image_info    The information of the decoded frames.
+  /// @param[in]  frame_index   The index of the frame.
+  ///
+  static Key MakeFrameKey(sk_sp<SkData> data,
+                          size_t data_hash,
+                          const SkImageInfo& image_info,
+                          int frame_index);
+
+  explicit DecodedImageCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~DecodedImageCache();
+
+  //----------------------------------------------------------------------------
+  /// @return     The image cached for the key, or nullptr if there is none.
+  ///
+  sk_sp<DlImage> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Caches a decoded image, evicting the least recently used
+  ///             images until the cache is within its budget again. Images
+  ///             larger than the budget are not cached.
+  ///
+  void Put(const Key& key, sk_sp<DlImage> image);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops every cached image. Images that are still in use stay
+  ///             alive through the references of their users.
+  ///
+  void Purge();
+
+  size_t GetEntryCount() const;
+
+  size_t GetRetainedBytes() const;
+
+ private:
+  struct Entry {
+    Key key;
+    sk_sp<DlImage> image;
+    size_t bytes = 0u;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void EvictLocked(EntryList::iterator entry);
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // The most recently used entries are at the front.
+  EntryList entries_;
+  std::unordered_map<size_t, EntryList::iterator> entries_by_hash_;
+  size_t retained_bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeImage final : public DlImage {
+ public:
+  explicit FakeImage(size_t bytes) : bytes_(bytes) {}
+
+  // |DlImage|
+  sk_sp<SkImage> skia_image() const override { return nullptr; }
+
+  // |DlImage|
+  std::shared_ptr<impeller::Texture> impeller_texture() const override {
+    return nullptr;
+  }
+
+  // |DlImage|
+  bool isOpaque() const override { return true; }
+
+  // |DlImage|
+  bool isTextureBacked() const override { return true; }
+
+  // |DlImage|
+  SkISize dimensions() const override { return SkISize::Make(1, 1); }
+
+  // |DlImage|
+  size_t GetApproximateByteSize() const override { return bytes_; }
+
+ private:
+  const size_t bytes_;
+};
+
+DecodedImageCache::Key CreateKey(const char* encoded,
+                                 size_t hash,
+                                 uint32_t target_width = 100) {
+  return DecodedImageCache::Key{
+      .hash = hash,
+      .data = SkData::MakeWithCopy(encoded, std::strlen(encoded)),
+      .image_info = SkImageInfo::MakeN32Premul(100, 100),
+      .row_bytes = 400,
+      .target_width = target_width,
+      .target_height = 100,
+  };
+}
+
+}  // namespace
+
+TEST(DecodedImageCacheTest, ReturnsTheImageCachedForTheSameContent) {
+  DecodedImageCache cache;
+  auto image = sk_make_sp<FakeImage>(1000);
+  cache.Put(CreateKey("png", 1), image);
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_EQ(cache.GetRetainedBytes(), 1000u);
+
+  // The key holds its own copy of the bytes, like the descriptors of two
+  // isolates would.
+  EXPECT_EQ(cache.Get(CreateKey("png", 1)), image);
+  EXPECT_EQ(cache.Get(CreateKey("png", 1, 50)), nullptr);
+  EXPECT_EQ(cache.Get(CreateKey("jpg", 2)), nullptr);
+}
+
+TEST(DecodedImageCacheTest, FramesAreCachedByIndex) {
+  DecodedImageCache cache;
+  auto data = SkData::MakeWithCopy("gif", 3);
+  const size_t hash = DecodedImageCache::HashData(*data);
+  const auto info = SkImageInfo::MakeN32Premul(100, 100);
+  auto frame = sk_make_sp<FakeImage>(1000);
+  cache.Put(DecodedImageCache::MakeFrameKey(data, hash, info, 1), frame);
+
+  EXPECT_EQ(cache.Get(DecodedImageCache::MakeFrameKey(
+                SkData::MakeWithCopy("gif", 3), hash, info, 1)),
+            frame);
+  EXPECT_EQ(cache.Get(DecodedImageCache::MakeFrameKey(data, hash, info, 0)),
+            nullptr);
+}
+
+TEST(DecodedImageCacheTest, DifferentContentWithTheSameHashIsNotReturned) {
+  DecodedImageCache cache;
+  cache.Put(CreateKey("png", 1), sk_make_sp<FakeImage>(1000));
+  EXPECT_EQ(cache.Get(CreateKey("gif", 1)), nullptr);
+
+  // The entry that is already cached is kept.
+  cache.Put(CreateKey("gif", 1), sk_make_sp<FakeImage>(1000));
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_NE(cache.Get(CreateKey("png", 1)), nullptr);
+}
+
+TEST(DecodedImageCacheTest, EvictsTheLeastRecentlyUsedImagesOverBudget) {
+  DecodedImageCache cache(3000);
+  cache.Put(CreateKey("a", 1), sk_make_sp<FakeImage>(1000));
+  cache.Put(CreateKey("b", 2), sk_make_sp<FakeImage>(1000));
+  cache.Put(CreateKey("c", 3), sk_make_sp<FakeImage>(1000));
+  // Using "a" makes "b" the least recently used image.
+  ASSERT_NE(cache.Get(CreateKey("a", 1)), nullptr);
+
+  cache.Put(CreateKey("d", 4), sk_make_sp<FakeImage>(1500));
+  EXPECT_EQ(cache.GetRetainedBytes(), 2500u);
+  EXPECT_NE(cache.Get(CreateKey("a", 1)), nullptr);
+  EXPECT_EQ(cache.Get(CreateKey("b", 2)), nullptr);
+  EXPECT_EQ(cache.Get(CreateKey("c", 3)), nullptr);
+  EXPECT_NE(cache.Get(CreateKey("d", 4)), nullptr);
+
+  // Images larger than the budget are not cached at all.
+  cache.Put(CreateKey("e", 5), sk_make_sp<FakeImage>(4000));
+  EXPECT_EQ(cache.Get(CreateKey("e", 5)), nullptr);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST(DecodedImageCacheTest, PurgeReleasesTheImagesNotInUse) {
+  DecodedImageCache cache;
+  auto in_use = sk_make_sp<FakeImage>(1000);
+  cache.Put(CreateKey("a", 1), in_use);
+  cache.Put(CreateKey("b", 2), sk_make_sp<FakeImage>(1000));
+  ASSERT_FALSE(in_use->unique());
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.GetRetainedBytes(), 0u);
+  EXPECT_TRUE(in_use->unique());
+}
+
+}  // namespace testing
+}  // namespace flutter
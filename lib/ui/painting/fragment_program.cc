@@ -14,6 +14,9 @@
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/entity/contents/runtime_effect_contents.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -26,6 +29,30 @@ namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, FragmentProgram);
 
+#if IMPELLER_SUPPORTS_RENDERING
+// Compiles the shader of |runtime_stage| and creates the pipelines most draws
+// with it use on the IO thread, so that the first frame that draws with it
+// doesn't wait for the compilation.
+static void CreatePipelines(
+    std::shared_ptr<impeller::RuntimeStage> runtime_stage) {
+  auto* dart_state = UIDartState::Current();
+  dart_state->GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [io_manager = dart_state->GetIOManager(),
+       runtime_stage = std::move(runtime_stage)]() {
+        if (!io_manager) {
+          return;
+        }
+        auto context = io_manager->GetImpellerContext();
+        if (!context || context->HasThreadingRestrictions()) {
+          return;
+        }
+        TRACE_EVENT0("flutter", "FragmentProgram::CreatePipelines");
+        impeller::RuntimeEffectContents::CreatePipelines(*context,
+                                                         *runtime_stage);
+      });
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   FML_TRACE_EVENT("flutter", "FragmentProgram::initFromAsset", "asset",
                   asset_name);
@@ -58,6 +85,9 @@ std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   if (UIDartState::Current()->IsImpellerEnabled()) {
     runtime_effect_ = DlRuntimeEffect::MakeImpeller(
         std::make_unique<impeller::RuntimeStage>(std::move(runtime_stage)));
+#if IMPELLER_SUPPORTS_RENDERING
+    CreatePipelines(runtime_effect_->runtime_stage());
+#endif  // IMPELLER_SUPPORTS_RENDERING
   } else {
     auto code_mapping = runtime_stage.GetSkSLMapping();
     auto code_size = code_mapping->GetSize();
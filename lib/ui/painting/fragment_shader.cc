@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -82,12 +83,23 @@ void ReusableFragmentShader::SetImageSampler(Dart_Handle index_handle,
       reinterpret_cast<float*>(uniform_data_->writable_data());
   uniform_floats[float_count_ + 2 * index] = image->width();
   uniform_floats[float_count_ + 2 * index + 1] = image->height();
+  color_source_ = nullptr;
 }
 
 std::shared_ptr<DlColorSource> ReusableFragmentShader::shader(
     DlImageSampling sampling) {
   FML_CHECK(program_);
 
+  // The uniforms of animated shaders often only change every few frames, or
+  // not at all between the paints of a frame. The color source made for the
+  // same uniforms and samplers is reused, so that they are neither copied
+  // again nor recorded as a new attribute of the display list.
+  if (color_source_ &&
+      memcmp(color_source_uniform_data_->data(), uniform_data_->bytes(),
+             color_source_uniform_data_->size()) == 0) {
+    return color_source_;
+  }
+
   // The lifetime of this object is longer than a frame, and the uniforms can be
   // continually changed on the UI thread. So we take a copy of the uniforms
   // before handing it to the DisplayList for consumption on the render thread.
@@ -95,13 +107,18 @@ std::shared_ptr<DlColorSource> ReusableFragmentShader::shader(
   uniform_data->resize(uniform_data_->size());
   memcpy(uniform_data->data(), uniform_data_->bytes(), uniform_data->size());
 
-  return program_->MakeDlColorSource(std::move(uniform_data), samplers_);
+  color_source_uniform_data_ = uniform_data;
+  color_source_ =
+      program_->MakeDlColorSource(std::move(uniform_data), samplers_);
+  return color_source_;
 }
 
 void ReusableFragmentShader::Dispose() {
   uniform_data_.reset();
   program_ = nullptr;
   samplers_.clear();
+  color_source_ = nullptr;
+  color_source_uniform_data_ = nullptr;
   ClearDartWrapper();
 }
 
@@ -52,6 +52,11 @@ class ReusableFragmentShader : public Shader {
   sk_sp<SkData> uniform_data_;
   std::vector<std::shared_ptr<DlColorSource>> samplers_;
   size_t float_count_;
+
+  // The color source returned for the uniforms it was made with, until the
+  // uniforms or the samplers change.
+  std::shared_ptr<DlColorSource> color_source_;
+  std::shared_ptr<const std::vector<uint8_t>> color_source_uniform_data_;
 };
 
 }  // namespace flutter
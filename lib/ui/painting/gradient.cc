@@ -17,7 +17,6 @@ typedef CanvasGradient
 IMPLEMENT_WRAPPERTYPEINFO(ui, Gradient);
 
 void CanvasGradient::Create(Dart_Handle wrapper) {
-  UIDartState::ThrowIfUIOperationsProhibited();
   auto res = fml::MakeRefCounted<CanvasGradient>();
   res->AssociateWithDartWrapper(wrapper);
 }
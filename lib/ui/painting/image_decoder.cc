@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_decoder.h"
 
+#include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
@@ -44,6 +45,13 @@ ImageDecoder::ImageDecoder(
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
       << "The image decoder must be created & collected on the UI thread.";
+  std::promise<std::shared_ptr<DecodedImageCache>> cache_promise;
+  decoded_image_cache_ = cache_promise.get_future().share();
+  runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [promise = std::move(cache_promise), io_manager = io_manager_]() mutable {
+        promise.set_value(io_manager ? io_manager->GetDecodedImageCache()
+                                     : nullptr);
+      }));
 }
 
 ImageDecoder::~ImageDecoder() = default;
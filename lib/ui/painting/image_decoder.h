@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
+#include <future>
 #include <memory>
 
 #include "flutter/common/settings.h"
@@ -12,6 +13,7 @@
 #include "flutter/display_list/display_list_image.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
 namespace flutter {
@@ -49,6 +51,9 @@ class ImageDecoder {
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  // The cache of the IO manager, which is only known once the IO thread has
+  // handed it over. Decoders wait for it on the concurrent runner.
+  std::shared_future<std::shared_ptr<DecodedImageCache>> decoded_image_cache_;
 
   ImageDecoder(
       const TaskRunners& runners,
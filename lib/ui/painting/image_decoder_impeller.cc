@@ -4,6 +4,8 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 #include "flutter/fml/closure.h"
@@ -12,13 +14,19 @@
 #include "flutter/impeller/display_list/display_list_image_impeller.h"
 #include "flutter/impeller/renderer/allocator.h"
 #include "flutter/impeller/renderer/command_buffer.h"
+#include "flutter/impeller/renderer/compute_command.h"
+#include "flutter/impeller/renderer/compute_pass.h"
+#include "flutter/impeller/renderer/compute_pipeline_builder.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/renderer/device_buffer.h"
 #include "flutter/impeller/renderer/texture.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "impeller/base/strings.h"
+#include "impeller/entity/texture_resize.comp.h"
 #include "impeller/geometry/size.h"
 #include "include/core/SkSize.h"
 #include "third_party/skia/include/core/SkMallocPixelRef.h"
+#include "third_party/skia/include/core/SkPixelRef.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 
 namespace flutter {
@@ -60,6 +68,25 @@ bool IsWideGamut(const SkColorSpace& color_space) {
   LoadGamut(rgb, xyzd50);
   return CalculateArea(rgb) > kSrgbD50GamutArea;
 }
+
+// A pixel ref whose pixels are the contents of a device buffer, which it keeps
+// alive.
+class DeviceBufferPixelRef final : public SkPixelRef {
+ public:
+  DeviceBufferPixelRef(const SkImageInfo& info,
+                       size_t row_bytes,
+                       std::shared_ptr<impeller::DeviceBuffer> buffer)
+      : SkPixelRef(info.width(),
+                   info.height(),
+                   buffer->AsBufferView().contents,
+                   row_bytes),
+        buffer_(std::move(buffer)) {}
+
+  ~DeviceBufferPixelRef() override = default;
+
+ private:
+  std::shared_ptr<impeller::DeviceBuffer> buffer_;
+};
 }  // namespace
 
 ImageDecoderImpeller::ImageDecoderImpeller(
@@ -100,29 +127,89 @@ static std::optional<impeller::PixelFormat> ToPixelFormat(SkColorType type) {
   return std::nullopt;
 }
 
+static impeller::PixelFormat ToPixelFormat(
+    ImageGenerator::CompressedPixels::Format format) {
+  switch (format) {
+    case ImageGenerator::CompressedPixels::Format::kASTC4x4:
+      return impeller::PixelFormat::kASTC4x4UNorm;
+    case ImageGenerator::CompressedPixels::Format::kETC2RGBA8:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNorm;
+  }
+  FML_UNREACHABLE();
+}
+
+// The row bytes with which a buffer can be used as the storage of a texture of
+// the given image info, if the allocator supports that.
+static std::optional<size_t> GetSharedRowBytes(
+    const impeller::Allocator& allocator,
+    const SkImageInfo& image_info) {
+  const auto pixel_format = ToPixelFormat(image_info.colorType());
+  if (!allocator.HasUnifiedMemory() || !pixel_format.has_value()) {
+    return std::nullopt;
+  }
+  const size_t alignment = allocator.MinimumBytesPerRow(pixel_format.value());
+  const size_t row_bytes =
+      (image_info.minRowBytes() + alignment - 1) / alignment * alignment;
+  // The row bytes of textures that alias buffers are 16 bit.
+  if (row_bytes > std::numeric_limits<uint16_t>::max()) {
+    return std::nullopt;
+  }
+  return row_bytes;
+}
+
+static SkISize ClampToMaxTextureSize(SkISize size,
+                                     impeller::ISize max_texture_size) {
+  return SkISize::Make(
+      std::min(static_cast<int32_t>(max_texture_size.width), size.width()),
+      std::min(static_cast<int32_t>(max_texture_size.height), size.height()));
+}
+
+// The size closest to the target size that the image can be decoded at.
+static SkISize GetDecodeSize(ImageDescriptor* descriptor, SkISize target_size) {
+  const SkISize source_size = descriptor->image_info().dimensions();
+  if (!descriptor->is_compressed()) {
+    return source_size;
+  }
+  return descriptor->get_scaled_dimensions(std::max(
+      static_cast<double>(target_size.width()) / source_size.width(),
+      static_cast<double>(target_size.height()) / source_size.height()));
+}
+
+// Whether an image decoded at `decode_size` should be downscaled to
+// `target_size` by a compute pass rather than by the CPU. The compute pass
+// writes 8 bit pixels and averages the channels, which is only correct for
+// premultiplied or opaque colors.
+static bool ShouldResizeOnGpu(const impeller::Context& context,
+                              ImageDescriptor* descriptor,
+                              SkISize decode_size,
+                              SkISize target_size,
+                              impeller::ISize max_texture_size,
+                              bool supports_wide_gamut) {
+  const auto& image_info = descriptor->image_info();
+  return context.GetBackendFeatures().compute_shader_support &&
+         descriptor->is_compressed() && decode_size != target_size &&
+         ClampToMaxTextureSize(decode_size, max_texture_size) == decode_size &&
+         !target_size.isEmpty() &&
+         decode_size.width() >= target_size.width() &&
+         decode_size.height() >= target_size.height() &&
+         image_info.alphaType() != kUnpremul_SkAlphaType &&
+         !(supports_wide_gamut && IsWideGamut(*image_info.colorSpace()));
+}
+
 std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
     ImageDescriptor* descriptor,
     SkISize target_size,
     impeller::ISize max_texture_size,
-    bool supports_wide_gamut) {
+    bool supports_wide_gamut,
+    SkBitmap::Allocator* allocator) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     FML_DLOG(ERROR) << "Invalid descriptor.";
     return nullptr;
   }
 
-  target_size.set(std::min(static_cast<int32_t>(max_texture_size.width),
-                           target_size.width()),
-                  std::min(static_cast<int32_t>(max_texture_size.height),
-                           target_size.height()));
-
-  const SkISize source_size = descriptor->image_info().dimensions();
-  auto decode_size = source_size;
-  if (descriptor->is_compressed()) {
-    decode_size = descriptor->get_scaled_dimensions(std::max(
-        static_cast<double>(target_size.width()) / source_size.width(),
-        static_cast<double>(target_size.height()) / source_size.height()));
-  }
+  target_size = ClampToMaxTextureSize(target_size, max_texture_size);
+  const SkISize decode_size = GetDecodeSize(descriptor, target_size);
 
   //----------------------------------------------------------------------------
   /// 1. Decode the image.
@@ -161,7 +248,24 @@ std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
 
   auto bitmap = std::make_shared<SkBitmap>();
   if (descriptor->is_compressed()) {
-    if (!bitmap->tryAllocPixels(image_info)) {
+    if (decode_size != target_size) {
+      // Huge images displayed at a small size are averaged down as their rows
+      // are decoded if the generator supports it, which avoids holding the
+      // image at the closest size supported by the decoder in memory.
+      TRACE_EVENT0("impeller", "DecodeDownscaled");
+      auto scaled_bitmap = std::make_shared<SkBitmap>();
+      scaled_bitmap->setInfo(image_info.makeDimensions(target_size));
+      if (scaled_bitmap->tryAllocPixels(allocator) &&
+          descriptor->get_pixels_downscaled(scaled_bitmap->pixmap())) {
+        scaled_bitmap->setImmutable();
+        return scaled_bitmap;
+      }
+    }
+
+    bitmap->setInfo(image_info);
+    // The decoded pixels are only uploaded if they don't need to be resized.
+    auto* bitmap_allocator = decode_size == target_size ? allocator : nullptr;
+    if (!bitmap->tryAllocPixels(bitmap_allocator)) {
       FML_DLOG(ERROR)
           << "Could not allocate intermediate for image decompression.";
       return nullptr;
@@ -191,7 +295,8 @@ std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
   const auto scaled_image_info = image_info.makeDimensions(target_size);
 
   auto scaled_bitmap = std::make_shared<SkBitmap>();
-  if (!scaled_bitmap->tryAllocPixels(scaled_image_info)) {
+  scaled_bitmap->setInfo(scaled_image_info);
+  if (!scaled_bitmap->tryAllocPixels(allocator)) {
     FML_LOG(ERROR)
         << "Could not allocate scaled bitmap for image decompression.";
     return nullptr;
@@ -226,6 +331,7 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTexture(
   texture_descriptor.size = {image_info.width(), image_info.height()};
   texture_descriptor.mip_count = texture_descriptor.size.MipCount();
 
+  texture_descriptor.category = impeller::AllocationCategory::kImage;
   auto texture =
       context->GetResourceAllocator()->CreateTexture(texture_descriptor);
   if (!texture) {
@@ -273,6 +379,286 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTexture(
   return impeller::DlImageImpeller::Make(std::move(texture));
 }
 
+sk_sp<DlImage> ImageDecoderImpeller::UploadTextureToPrivate(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+    const SkImageInfo& image_info) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context || !buffer) {
+    return nullptr;
+  }
+  const auto pixel_format = ToPixelFormat(image_info.colorType());
+  if (!pixel_format) {
+    FML_DLOG(ERROR) << "Pixel format unsupported by Impeller.";
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_descriptor.format = pixel_format.value();
+  texture_descriptor.size = {image_info.width(), image_info.height()};
+  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
+
+  texture_descriptor.category = impeller::AllocationCategory::kImage;
+  auto texture =
+      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!texture) {
+    FML_DLOG(ERROR) << "Could not create Impeller texture.";
+    return nullptr;
+  }
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    FML_DLOG(ERROR) << "Could not create command buffer for texture upload.";
+    return nullptr;
+  }
+  command_buffer->SetLabel("Image Upload Command Buffer");
+
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    FML_DLOG(ERROR) << "Could not create blit pass for texture upload.";
+    return nullptr;
+  }
+  blit_pass->SetLabel("Image Upload Blit Pass");
+  if (!blit_pass->AddCopy(buffer, texture,
+                          impeller::IRect::MakeSize(texture_descriptor.size))) {
+    FML_DLOG(ERROR) << "Could not copy decoded image into Impeller texture.";
+    return nullptr;
+  }
+  if (texture_descriptor.mip_count > 1u) {
+    blit_pass->GenerateMipmap(texture);
+  }
+
+  blit_pass->EncodeCommands(context->GetResourceAllocator());
+  if (!command_buffer->SubmitCommands()) {
+    FML_DLOG(ERROR) << "Failed to submit blit pass command buffer.";
+    return nullptr;
+  }
+
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
+
+sk_sp<DlImage> ImageDecoderImpeller::ResizeTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::Texture>& texture,
+    SkISize target_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  using CS = impeller::TextureResizeComputeShader;
+
+  if (!context || !texture || target_size.isEmpty()) {
+    return nullptr;
+  }
+  if (texture->GetTextureDescriptor().format !=
+      impeller::PixelFormat::kR8G8B8A8UNormInt) {
+    FML_DLOG(ERROR) << "Only RGBA8 textures can be resized.";
+    return nullptr;
+  }
+
+  // Pipelines are cached by the library, so this only builds it once.
+  auto pipeline_future = context->GetPipelineLibrary()->GetPipeline(
+      impeller::ComputePipelineBuilder<CS>::MakeDefaultPipelineDescriptor(
+          *context));
+  auto pipeline = pipeline_future.IsValid() ? pipeline_future.Get() : nullptr;
+  if (!pipeline) {
+    FML_DLOG(ERROR) << "Could not create the texture resize pipeline.";
+    return nullptr;
+  }
+
+  const impeller::ISize output_size(target_size.width(), target_size.height());
+  const auto allocator = context->GetResourceAllocator();
+
+  impeller::DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  buffer_descriptor.size = output_size.Area() * 4u;
+  auto output_buffer = allocator->CreateBuffer(buffer_descriptor);
+  if (!output_buffer) {
+    FML_DLOG(ERROR) << "Could not create the texture resize buffer.";
+    return nullptr;
+  }
+  output_buffer->SetLabel("Texture Resize Buffer");
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_descriptor.format = impeller::PixelFormat::kR8G8B8A8UNormInt;
+  texture_descriptor.size = output_size;
+  texture_descriptor.mip_count = output_size.MipCount();
+  texture_descriptor.category = impeller::AllocationCategory::kImage;
+  auto resized = allocator->CreateTexture(texture_descriptor);
+  if (!resized) {
+    FML_DLOG(ERROR) << "Could not create Impeller texture.";
+    return nullptr;
+  }
+  resized->SetLabel(impeller::SPrintF("ui.Image(%p)", resized.get()).c_str());
+
+  // Each sample of the shader covers about two texels along each axis.
+  const auto source_size = texture->GetSize();
+  static constexpr uint32_t kMaxSamples = 8u;
+  auto sample_count = [](int64_t source, int64_t output) {
+    return std::clamp<uint32_t>((source + 2 * output - 1) / (2 * output), 1u,
+                                kMaxSamples);
+  };
+  CS::ResizeInfo resize_info;
+  resize_info.output_width = output_size.width;
+  resize_info.output_height = output_size.height;
+  resize_info.samples_x = sample_count(source_size.width, output_size.width);
+  resize_info.samples_y =
+      sample_count(source_size.height, output_size.height);
+  resize_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+
+  impeller::SamplerDescriptor sampler_descriptor;
+  sampler_descriptor.min_filter = impeller::MinMagFilter::kLinear;
+  sampler_descriptor.mag_filter = impeller::MinMagFilter::kLinear;
+
+  {
+    auto command_buffer = context->CreateCommandBuffer();
+    if (!command_buffer) {
+      FML_DLOG(ERROR) << "Could not create command buffer for resizing.";
+      return nullptr;
+    }
+    command_buffer->SetLabel("Texture Resize Command Buffer");
+
+    auto compute_pass = command_buffer->CreateComputePass();
+    if (!compute_pass || !compute_pass->IsValid()) {
+      FML_DLOG(ERROR) << "Could not create compute pass for resizing.";
+      return nullptr;
+    }
+    compute_pass->SetLabel("Texture Resize Compute Pass");
+    compute_pass->SetGridSize(output_size);
+    compute_pass->SetThreadGroupSize(impeller::ISize(16, 16));
+
+    impeller::ComputeCommand command;
+    command.label = "Texture Resize";
+    command.pipeline = pipeline;
+    CS::BindResizeInfo(command,
+                       compute_pass->GetTransientsBuffer().EmplaceUniform(
+                           resize_info));
+    CS::BindTextureSampler(
+        command, texture,
+        context->GetSamplerLibrary()->GetSampler(sampler_descriptor));
+    CS::BindOutput(command, output_buffer->AsBufferView());
+    if (!compute_pass->AddCommand(std::move(command)) ||
+        !compute_pass->EncodeCommands() || !command_buffer->SubmitCommands()) {
+      FML_DLOG(ERROR) << "Failed to submit the texture resize compute pass.";
+      return nullptr;
+    }
+  }
+
+  // Compute passes can't write textures yet. So the pixels are copied from
+  // the buffer, and the mipmaps are generated for images drawn minified.
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    FML_DLOG(ERROR) << "Could not create command buffer for resizing.";
+    return nullptr;
+  }
+  command_buffer->SetLabel("Texture Resize Blit Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    FML_DLOG(ERROR) << "Could not create blit pass for resizing.";
+    return nullptr;
+  }
+  blit_pass->SetLabel("Texture Resize Blit Pass");
+  if (!blit_pass->AddCopy(output_buffer, resized,
+                          impeller::IRect::MakeSize(output_size))) {
+    FML_DLOG(ERROR) << "Could not copy the resized image into the texture.";
+    return nullptr;
+  }
+  if (texture_descriptor.mip_count > 1u) {
+    blit_pass->GenerateMipmap(resized);
+  }
+  blit_pass->EncodeCommands(allocator);
+  if (!command_buffer->SubmitCommands()) {
+    FML_DLOG(ERROR) << "Failed to submit blit pass command buffer.";
+    return nullptr;
+  }
+
+  return impeller::DlImageImpeller::Make(std::move(resized));
+}
+
+sk_sp<DlImage> ImageDecoderImpeller::UploadTextureToShared(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+    const SkImageInfo& image_info,
+    size_t row_bytes) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context || !buffer) {
+    return nullptr;
+  }
+  const auto pixel_format = ToPixelFormat(image_info.colorType());
+  if (!pixel_format) {
+    FML_DLOG(ERROR) << "Pixel format unsupported by Impeller.";
+    return nullptr;
+  }
+
+  // Textures that alias a buffer are linear, which rules out mipmaps.
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = pixel_format.value();
+  texture_descriptor.size = {image_info.width(), image_info.height()};
+  texture_descriptor.mip_count = 1u;
+
+  auto texture = buffer->AsTexture(*context->GetResourceAllocator(),
+                                   texture_descriptor, row_bytes);
+  if (!texture) {
+    FML_DLOG(ERROR) << "Could not create Impeller texture from buffer.";
+    return nullptr;
+  }
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
+
+sk_sp<DlImage> ImageDecoderImpeller::UploadCompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const ImageGenerator::CompressedPixels& pixels) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context || !pixels.data) {
+    return nullptr;
+  }
+  const auto& allocator = context->GetResourceAllocator();
+  const auto pixel_format = ToPixelFormat(pixels.format);
+  if (!allocator->SupportsCompressedPixelFormat(pixel_format)) {
+    FML_DLOG(ERROR) << "Compressed pixel format unsupported by the device.";
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = pixel_format;
+  texture_descriptor.size = {pixels.size.width(), pixels.size.height()};
+  // Compressed textures can't be rendered to, so mipmaps can't be generated.
+  texture_descriptor.mip_count = 1u;
+
+  const auto max_size = allocator->GetMaxTextureSizeSupported();
+  if (texture_descriptor.size.width > max_size.width ||
+      texture_descriptor.size.height > max_size.height ||
+      pixels.data->size() != texture_descriptor.GetByteSizeOfBaseMipLevel()) {
+    FML_DLOG(ERROR) << "Invalid compressed texture.";
+    return nullptr;
+  }
+
+  texture_descriptor.category = impeller::AllocationCategory::kImage;
+  auto texture = allocator->CreateTexture(texture_descriptor);
+  if (!texture) {
+    FML_DLOG(ERROR) << "Could not create Impeller texture.";
+    return nullptr;
+  }
+
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      pixels.data->bytes(),                                       // data
+      pixels.data->size(),                                        // size
+      [data = pixels.data](auto, auto) mutable { data.reset(); }  // proc
+  );
+
+  if (!texture->SetContents(mapping)) {
+    FML_DLOG(ERROR) << "Could not copy contents into Impeller texture.";
+    return nullptr;
+  }
+
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
+
 // |ImageDecoder|
 void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                                   uint32_t target_width,
@@ -300,22 +686,95 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        target_size = SkISize::Make(target_width, target_height),  //
        io_runner = runners_.GetIOTaskRunner(),                    //
        result,
-       supports_wide_gamut = supports_wide_gamut_  //
+       supports_wide_gamut = supports_wide_gamut_,  //
+       decoded_image_cache = decoded_image_cache_   //
   ]() {
         FML_CHECK(context) << "No valid impeller context";
+
+        // Images that another decoder sharing the IO manager already decoded
+        // at this size are reused.
+        auto cache = decoded_image_cache.get();
+        std::optional<DecodedImageCache::Key> cache_key;
+        if (cache) {
+          cache_key = DecodedImageCache::MakeKey(
+              *raw_descriptor, target_size.width(), target_size.height());
+          if (cache_key.has_value()) {
+            if (auto image = cache->Get(cache_key.value())) {
+              result(std::move(image));
+              return;
+            }
+          }
+        }
+
+        // Images that are already compressed for the GPU are uploaded as they
+        // are, at their own size.
+        if (auto compressed = raw_descriptor->get_compressed_pixels()) {
+          auto upload_compressed_and_invoke_result =
+              [result, context, compressed = compressed.value(), cache,
+               cache_key]() {
+                auto image = UploadCompressedTexture(context, compressed);
+                if (image && cache_key.has_value()) {
+                  cache->Put(cache_key.value(), image);
+                }
+                result(std::move(image));
+              };
+          if (context->HasThreadingRestrictions()) {
+            io_runner->PostTask(upload_compressed_and_invoke_result);
+          } else {
+            upload_compressed_and_invoke_result();
+          }
+          return;
+        }
+
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
-        // Always decompress on the concurrent runner.
-        auto bitmap =
-            DecompressTexture(raw_descriptor, target_size, max_size_supported,
+        // Images decoded larger than the target size are decoded at that size
+        // and downscaled on the GPU if it supports compute.
+        const auto clamped_size =
+            ClampToMaxTextureSize(target_size, max_size_supported);
+        const auto decode_size = GetDecodeSize(raw_descriptor, clamped_size);
+        const bool resize_on_gpu =
+            ShouldResizeOnGpu(*context, raw_descriptor, decode_size,
+                              clamped_size, max_size_supported,
                               supports_wide_gamut);
+
+        // Always decompress on the concurrent runner. Images are decoded into
+        // host visible device buffers when possible, which are then copied
+        // into device private textures on the GPU.
+        ImpellerAllocator allocator(context->GetResourceAllocator());
+        auto bitmap = DecompressTexture(
+            raw_descriptor, resize_on_gpu ? decode_size : clamped_size,
+            max_size_supported, supports_wide_gamut, &allocator);
         if (!bitmap) {
           result(nullptr);
           return;
         }
-        auto upload_texture_and_invoke_result = [result, context, bitmap]() {
-          result(UploadTexture(context, bitmap));
+        auto device_buffer = allocator.GetDeviceBuffer();
+        auto upload_texture_and_invoke_result = [result, context, bitmap,
+                                                 device_buffer, cache,
+                                                 cache_key, resize_on_gpu,
+                                                 clamped_size]() {
+          sk_sp<DlImage> image;
+          if (device_buffer.has_value() &&
+              GetSharedRowBytes(*context->GetResourceAllocator(),
+                                bitmap->info()) == bitmap->rowBytes()) {
+            image = UploadTextureToShared(context, device_buffer.value(),
+                                          bitmap->info(), bitmap->rowBytes());
+          } else if (device_buffer.has_value()) {
+            image = UploadTextureToPrivate(context, device_buffer.value(),
+                                           bitmap->info());
+          } else {
+            image = UploadTexture(context, bitmap);
+          }
+          if (image && resize_on_gpu) {
+            image = ResizeTexture(context, image->impeller_texture(),
+                                  clamped_size);
+          }
+          if (image && cache_key.has_value()) {
+            cache->Put(cache_key.value(), image);
+          }
+          result(std::move(image));
         };
         // Depending on whether the context has threading restrictions, stay on
         // the concurrent runner to perform texture upload or move to an IO
@@ -328,4 +787,43 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
       });
 }
 
+ImpellerAllocator::ImpellerAllocator(
+    std::shared_ptr<impeller::Allocator> allocator)
+    : allocator_(std::move(allocator)) {}
+
+std::optional<std::shared_ptr<impeller::DeviceBuffer>>
+ImpellerAllocator::GetDeviceBuffer() const {
+  return buffer_;
+}
+
+bool ImpellerAllocator::allocPixelRef(SkBitmap* bitmap) {
+  if (!bitmap || !allocator_) {
+    return false;
+  }
+  const SkImageInfo& info = bitmap->info();
+  if (info.colorType() == kUnknown_SkColorType || info.isEmpty() ||
+      !info.validRowBytes(bitmap->rowBytes())) {
+    return false;
+  }
+
+  // The rows of buffers that are copied into textures are tightly packed.
+  const size_t row_bytes =
+      GetSharedRowBytes(*allocator_, info).value_or(bitmap->rowBytes());
+
+  impeller::DeviceBufferDescriptor descriptor;
+  descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  descriptor.size = info.computeByteSize(row_bytes);
+
+  auto device_buffer = allocator_->CreateBuffer(descriptor);
+  if (!device_buffer || !device_buffer->AsBufferView().contents) {
+    return false;
+  }
+  device_buffer->SetLabel("ImpellerAllocator");
+
+  bitmap->setPixelRef(
+      sk_make_sp<DeviceBufferPixelRef>(info, row_bytes, device_buffer), 0, 0);
+  buffer_ = std::move(device_buffer);
+  return true;
+}
+
 }  // namespace flutter
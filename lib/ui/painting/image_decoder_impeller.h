@@ -6,17 +6,47 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 
 #include <future>
+#include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "impeller/geometry/size.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
 namespace impeller {
 class Context;
+class Allocator;
+class DeviceBuffer;
+class Texture;
 }  // namespace impeller
 
 namespace flutter {
 
+/// @brief  Allocates the pixels of bitmaps in host visible device buffers, so
+///         that images are decoded straight into memory that the GPU can copy
+///         into textures, rather than into memory that is then copied into
+///         the textures by the CPU. On devices with unified memory, the rows
+///         are aligned so that the buffers can be used as the storage of
+///         textures as they are.
+class ImpellerAllocator : public SkBitmap::Allocator {
+ public:
+  explicit ImpellerAllocator(std::shared_ptr<impeller::Allocator> allocator);
+
+  ~ImpellerAllocator() = default;
+
+  /// @brief  The device buffer of the last bitmap allocated, if any.
+  std::optional<std::shared_ptr<impeller::DeviceBuffer>> GetDeviceBuffer()
+      const;
+
+  // |SkBitmap::Allocator|
+  bool allocPixelRef(SkBitmap* bitmap) override;
+
+ private:
+  std::shared_ptr<impeller::Allocator> allocator_;
+  std::optional<std::shared_ptr<impeller::DeviceBuffer>> buffer_;
+};
+
 class ImageDecoderImpeller final : public ImageDecoder {
  public:
   ImageDecoderImpeller(
@@ -33,16 +63,55 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  /// @brief  Decodes the image at the target size, clamped to the maximum
+  ///         texture size. If an allocator is given, it allocates the pixels
+  ///         of the returned bitmap, unless the image is not compressed and
+  ///         its pixels are used as they are.
   static std::shared_ptr<SkBitmap> DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
-      bool supports_wide_gamut);
+      bool supports_wide_gamut,
+      SkBitmap::Allocator* allocator = nullptr);
 
+  /// @brief  Creates a host visible texture with the pixels of the bitmap.
   static sk_sp<DlImage> UploadTexture(
       const std::shared_ptr<impeller::Context>& context,
       std::shared_ptr<SkBitmap> bitmap);
 
+  /// @brief  Creates a device private texture and copies the decoded pixels
+  ///         in the device buffer into it on the GPU.
+  static sk_sp<DlImage> UploadTextureToPrivate(
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+      const SkImageInfo& image_info);
+
+  /// @brief  Downscales the texture to the target size with a compute pass,
+  ///         and generates the mipmaps of the result. Only valid for RGBA8
+  ///         textures of images with premultiplied or opaque colors, on
+  ///         backends that support compute.
+  static sk_sp<DlImage> ResizeTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<impeller::Texture>& texture,
+      SkISize target_size);
+
+  /// @brief  Creates a texture that uses the device buffer of the decoded
+  ///         pixels as its storage, without copying them. Only valid if the
+  ///         allocator of the context has unified memory. The texture is
+  ///         linear and has no mipmaps.
+  static sk_sp<DlImage> UploadTextureToShared(
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<impeller::DeviceBuffer>& buffer,
+      const SkImageInfo& image_info,
+      size_t row_bytes);
+
+  /// @brief  Creates a host visible texture with pixels that are already
+  ///         compressed for the GPU, if the device supports their format.
+  ///         Only the base mip level is uploaded.
+  static sk_sp<DlImage> UploadCompressedTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const ImageGenerator::CompressedPixels& pixels);
+
  private:
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
   FutureContext context_;
@@ -5,9 +5,11 @@
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 
 #include <algorithm>
+#include <optional>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/post_task_and_reply.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 
 namespace flutter {
@@ -242,7 +244,7 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
   // Always service the callback (and cleanup the descriptor) on the UI thread.
   auto result =
       [callback, raw_descriptor, ui_runner = runners_.GetUITaskRunner()](
-          SkiaGPUObject<SkImage> image, fml::tracing::TraceFlow flow) {
+          sk_sp<DlImage> image, fml::tracing::TraceFlow flow) {
         ui_runner->PostTask(fml::MakeCopyable(
             [callback, raw_descriptor, image = std::move(image),
              flow = std::move(flow)]() mutable {
@@ -250,78 +252,105 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
               // terminate without a base trace. Add one explicitly.
               TRACE_EVENT0("flutter", "ImageDecodeCallback");
               flow.End();
-              callback(DlImageGPU::Make(std::move(image)));
+              callback(std::move(image));
               raw_descriptor->Release();
             }));
       };
 
   if (!raw_descriptor->data() || raw_descriptor->data()->size() == 0) {
-    result({}, std::move(flow));
+    result(nullptr, std::move(flow));
     return;
   }
 
-  concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([raw_descriptor,                          //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
-  ]() mutable {
-        // Step 1: Decompress the image.
-        // On Worker.
-
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
-
-        if (!decompressed) {
-          FML_DLOG(ERROR) << "Could not decompress image.";
-          result({}, std::move(flow));
-          return;
+  // The image is decompressed on a worker and then uploaded on the IO
+  // thread. The worker services the callback itself for cache hits and
+  // failures, in which case it leaves nothing to upload.
+  struct Decompressed {
+    sk_sp<SkImage> image;
+    std::optional<DecodedImageCache::Key> cache_key;
+    std::optional<fml::tracing::TraceFlow> flow;
+  };
+
+  // Step 0: Reuse the image if another decoder sharing the IO manager
+  // already decoded it at this size.
+  // Step 1: Decompress the image.
+  // On Worker.
+  auto decompress = [raw_descriptor, result, target_width, target_height,
+                     decoded_image_cache = decoded_image_cache_,
+                     flow = std::move(flow)]() mutable -> Decompressed {
+    std::optional<DecodedImageCache::Key> cache_key;
+    if (decoded_image_cache) {
+      cache_key = DecodedImageCache::MakeKey(*raw_descriptor, target_width,
+                                             target_height);
+      if (cache_key.has_value()) {
+        if (auto image = decoded_image_cache->Get(cache_key.value())) {
+          result(std::move(image), std::move(flow));
+          return {};
         }
+      }
+    }
+
+    auto decompressed = raw_descriptor->is_compressed()
+                            ? ImageFromCompressedData(raw_descriptor,  //
+                                                      target_width,    //
+                                                      target_height,   //
+                                                      flow)
+                            : ImageFromDecompressedData(raw_descriptor,  //
+                                                        target_width,    //
+                                                        target_height,   //
+                                                        flow);
+
+    if (!decompressed) {
+      FML_DLOG(ERROR) << "Could not decompress image.";
+      result(nullptr, std::move(flow));
+      return {};
+    }
+    return {std::move(decompressed), std::move(cache_key), std::move(flow)};
+  };
+
+  // Step 2: Update the image to the GPU.
+  // On IO Thread.
+  auto upload = [io_manager = io_manager_, result,
+                 decoded_image_cache = decoded_image_cache_](
+                    Decompressed decompressed) mutable {
+    if (!decompressed.flow.has_value()) {
+      return;
+    }
+    auto flow = std::move(decompressed.flow.value());
+    if (!io_manager) {
+      FML_DLOG(ERROR) << "Could not acquire IO manager.";
+      result(nullptr, std::move(flow));
+      return;
+    }
+
+    // If the IO manager does not have a resource context, the caller
+    // might not have set one or a software backend could be in use.
+    // Either way, just return the image as-is.
+    SkiaGPUObject<SkImage> image;
+    if (!io_manager->GetResourceContext()) {
+      image = {std::move(decompressed.image), io_manager->GetSkiaUnrefQueue()};
+    } else {
+      image = UploadRasterImage(std::move(decompressed.image), io_manager,
+                                flow);
+      if (!image.skia_object()) {
+        FML_DLOG(ERROR) << "Could not upload image to the GPU.";
+        result(nullptr, std::move(flow));
+        return;
+      }
+    }
+
+    // Finally, all done.
+    auto dl_image = DlImageGPU::Make(std::move(image));
+    if (decoded_image_cache && decompressed.cache_key.has_value()) {
+      decoded_image_cache->Put(decompressed.cache_key.value(), dl_image);
+    }
+    result(std::move(dl_image), std::move(flow));
+  };
 
-        // Step 2: Update the image to the GPU.
-        // On IO Thread.
-
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_DLOG(ERROR) << "Could not acquire IO manager.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.skia_object()) {
-            FML_DLOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
-          result(std::move(uploaded), std::move(flow));
-        }));
-      }));
+  fml::PostTaskAndReplyWithResult(concurrent_task_runner_.get(),
+                                  std::move(decompress),
+                                  runners_.GetIOTaskRunner(),
+                                  std::move(upload));
 }
 
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
+#include "flutter/lib/ui/painting/image_generator.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
@@ -19,6 +20,7 @@
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -614,6 +616,55 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100));
 }
 
+TEST(ImageDecoderTest, DownscaledDecodingAveragesTheDecodedRows) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  auto generator = BuiltinSkiaCodecImageGenerator::MakeFromData(data);
+  ASSERT_TRUE(generator);
+  auto full_image = SkImage::MakeFromEncoded(data);
+  ASSERT_TRUE(full_image);
+
+  const auto full_info = generator->GetInfo();
+  const auto info =
+      full_info.makeWH(full_info.width() / 7, full_info.height() / 7)
+          .makeColorType(kRGBA_8888_SkColorType);
+  SkBitmap downscaled;
+  ASSERT_TRUE(downscaled.tryAllocPixels(info));
+  ASSERT_TRUE(generator->GetPixelsDownscaled(
+      info, downscaled.getPixels(), downscaled.rowBytes()));
+
+  // The average color of the image is preserved.
+  SkBitmap full;
+  ASSERT_TRUE(full.tryAllocPixels(full_info.makeColorType(
+      kRGBA_8888_SkColorType)));
+  ASSERT_TRUE(full_image->readPixels(full.pixmap(), 0, 0));
+  auto average = [](const SkBitmap& bitmap, int channel) {
+    uint64_t sum = 0;
+    for (int y = 0; y < bitmap.height(); y++) {
+      const auto* row = static_cast<const uint8_t*>(bitmap.getAddr(0, y));
+      for (int x = 0; x < bitmap.width(); x++) {
+        sum += row[x * 4 + channel];
+      }
+    }
+    return static_cast<double>(sum) / (bitmap.width() * bitmap.height());
+  };
+  for (int channel = 0; channel < 4; channel++) {
+    EXPECT_NEAR(average(downscaled, channel), average(full, channel), 2.0);
+  }
+}
+
+TEST(ImageDecoderTest, DownscaledDecodingIsNotUsedForOrientedImages) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  auto generator = BuiltinSkiaCodecImageGenerator::MakeFromData(data);
+  ASSERT_TRUE(generator);
+
+  const auto info = generator->GetInfo().makeWH(60, 20).makeColorType(
+      kRGBA_8888_SkColorType);
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(info));
+  ASSERT_FALSE(generator->GetPixelsDownscaled(info, bitmap.getPixels(),
+                                              bitmap.rowBytes()));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
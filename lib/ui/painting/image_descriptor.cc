@@ -111,7 +111,7 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_, buffer_);
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
@@ -126,4 +126,10 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_pixels_downscaled(const SkPixmap& pixmap) const {
+  FML_DCHECK(generator_);
+  return generator_->GetPixelsDownscaled(
+      pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+}
+
 }  // namespace flutter
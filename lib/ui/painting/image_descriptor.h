@@ -109,6 +109,20 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets pixels for this image at a size smaller than any of its
+  ///         scaled dimensions without decoding it at a larger size first,
+  ///         if the backing `ImageGenerator` supports it.
+  /// @see    `ImageGenerator::GetPixelsDownscaled`
+  bool get_pixels_downscaled(const SkPixmap& pixmap) const;
+
+  /// @brief  Gets the pixels of this image if it is stored in a GPU
+  ///         compressed format.
+  /// @see    `ImageGenerator::GetCompressedPixels`
+  std::optional<ImageGenerator::CompressedPixels> get_compressed_pixels()
+      const {
+    return generator_ ? generator_->GetCompressedPixels() : std::nullopt;
+  }
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
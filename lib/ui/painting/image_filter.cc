@@ -16,7 +16,6 @@ namespace flutter {
 IMPLEMENT_WRAPPERTYPEINFO(ui, ImageFilter);
 
 void ImageFilter::Create(Dart_Handle wrapper) {
-  UIDartState::ThrowIfUIOperationsProhibited();
   auto res = fml::MakeRefCounted<ImageFilter>();
   res->AssociateWithDartWrapper(wrapper);
 }
@@ -4,7 +4,9 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -32,6 +34,17 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImage::MakeFromBitmap(bitmap);
 }
 
+bool ImageGenerator::GetPixelsDownscaled(const SkImageInfo& info,
+                                         void* pixels,
+                                         size_t row_bytes) {
+  return false;
+}
+
+std::optional<ImageGenerator::CompressedPixels>
+ImageGenerator::GetCompressedPixels() {
+  return std::nullopt;
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -82,7 +95,8 @@ BuiltinSkiaCodecImageGenerator::~BuiltinSkiaCodecImageGenerator() = default;
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
     std::unique_ptr<SkCodec> codec)
-    : codec_generator_(static_cast<SkCodecImageGenerator*>(
+    : codec_(codec.get()),
+      codec_generator_(static_cast<SkCodecImageGenerator*>(
           SkCodecImageGenerator::MakeFromCodec(std::move(codec)).release())) {}
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
@@ -135,6 +149,83 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return codec_generator_->getPixels(info, pixels, row_bytes, &options);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetPixelsDownscaled(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes) {
+  // Rows are averaged per channel, which is only correct for premultiplied
+  // or opaque colors of 8 bits per channel. Rows of oriented images don't
+  // map to the rows of the image info.
+  if (!codec_ || info.isEmpty() ||
+      info.colorType() != kRGBA_8888_SkColorType ||
+      info.alphaType() == kUnpremul_SkAlphaType ||
+      codec_->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec_->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+
+  // Decode at the smallest size the codec supports that is still at least as
+  // large as the destination.
+  const SkISize full_size = codec_->dimensions();
+  const SkISize source_size = codec_->getScaledDimensions(std::max(
+      static_cast<float>(info.width()) / full_size.width(),
+      static_cast<float>(info.height()) / full_size.height()));
+  if (source_size.width() < info.width() ||
+      source_size.height() < info.height()) {
+    return false;
+  }
+  const auto source_info = info.makeDimensions(source_size);
+  if (codec_->startScanlineDecode(source_info) != SkCodec::kSuccess) {
+    return false;
+  }
+
+  const int64_t source_width = source_size.width();
+  const int64_t source_height = source_size.height();
+  const int64_t width = info.width();
+  const int64_t height = info.height();
+
+  // The destination column of each source column, and the number of source
+  // columns averaged into each destination column.
+  std::vector<int32_t> columns(source_width);
+  std::vector<uint32_t> column_counts(width, 0);
+  for (int64_t x = 0; x < source_width; x++) {
+    columns[x] = static_cast<int32_t>(x * width / source_width);
+    column_counts[columns[x]]++;
+  }
+
+  std::vector<uint8_t> row(source_info.minRowBytes());
+  std::vector<uint64_t> sums(width * 4);
+  int64_t source_y = 0;
+  for (int64_t y = 0; y < height; y++) {
+    const int64_t end_y = (y + 1) * source_height / height;
+    const uint64_t row_count = end_y - source_y;
+    std::fill(sums.begin(), sums.end(), 0u);
+    for (; source_y < end_y; source_y++) {
+      if (codec_->getScanlines(row.data(), 1, row.size()) != 1) {
+        return false;
+      }
+      for (int64_t x = 0; x < source_width; x++) {
+        uint64_t* sum = &sums[columns[x] * 4];
+        const uint8_t* pixel = &row[x * 4];
+        sum[0] += pixel[0];
+        sum[1] += pixel[1];
+        sum[2] += pixel[2];
+        sum[3] += pixel[3];
+      }
+    }
+
+    auto* destination = static_cast<uint8_t*>(pixels) + y * row_bytes;
+    for (int64_t x = 0; x < width; x++) {
+      const uint64_t count = column_counts[x] * row_count;
+      for (int channel = 0; channel < 4; channel++) {
+        destination[x * 4 + channel] =
+            static_cast<uint8_t>((sums[x * 4 + channel] + count / 2) / count);
+      }
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -48,6 +48,27 @@ class ImageGenerator {
     SkCodecAnimation::Blend blend_mode;
   };
 
+  /// @brief  The pixels of an image that is stored in a format that GPUs
+  ///         sample from directly, which are uploaded to textures as they
+  ///         are rather than decoded.
+  struct CompressedPixels {
+    enum class Format {
+      /// ASTC with blocks of 4x4 pixels.
+      kASTC4x4,
+      /// ETC2 with 8 bit RGBA channels.
+      kETC2RGBA8,
+    };
+
+    Format format;
+
+    /// The size of the image in pixels.
+    SkISize size;
+
+    /// The blocks of the largest mip level of the image, in row-major order.
+    /// Each block of 4x4 pixels takes 16 bytes.
+    sk_sp<SkData> data;
+  };
+
   virtual ~ImageGenerator();
 
   /// @brief   Returns basic information about the contents of the encoded
@@ -132,6 +153,38 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Decode the first frame of the image into a given buffer that
+  ///             is smaller than any size returned by `GetScaledDimensions`,
+  ///             by averaging the rows of the encoded image down as they are
+  ///             decoded. Unlike decoding at a supported size and resizing the
+  ///             result, this never holds the larger image in memory, which
+  ///             matters for very large images that are displayed small.
+  /// @param[in]  info       The desired size and color info of the decoded
+  ///                        image to be returned.
+  /// @param[in]  pixels     The location where the raw decoded image data
+  ///                        should be written.
+  /// @param[in]  row_bytes  The total number of bytes that should make up a
+  ///                        single row of decoded image data.
+  /// @return     True if the image was decoded. False if the decoder can't
+  ///             decode rows incrementally for this image or the decode
+  ///             failed, in which case `GetPixels` should be used instead.
+  ///             The default implementation always returns false.
+  /// @note       This method performs potentially long synchronous work, and so
+  ///             it should never be executed on the UI thread.
+  /// @see        `GetPixels`
+  virtual bool GetPixelsDownscaled(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes);
+
+  /// @brief      Get the pixels of an image that is stored in a GPU compressed
+  ///             format. Renderers that support the format upload them
+  ///             instead of calling `GetPixels`. Decoders that produce such
+  ///             images may be unable to decode them into a buffer at all.
+  /// @return     The compressed pixels, or `std::nullopt` if the image is not
+  ///             GPU compressed. The default implementation always returns
+  ///             `std::nullopt`.
+  virtual std::optional<CompressedPixels> GetCompressedPixels();
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -209,10 +262,18 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetPixelsDownscaled(const SkImageInfo& info,
+                           void* pixels,
+                           size_t row_bytes) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BuiltinSkiaCodecImageGenerator);
+  // The codec of the generator, with which rows are decoded incrementally.
+  // Null if the generator was created from encoded data.
+  SkCodec* codec_ = nullptr;
   std::unique_ptr<SkCodecImageGenerator> codec_generator_;
 };
 
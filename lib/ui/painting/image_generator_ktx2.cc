@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include <cstring>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint8_t kKTX2Identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                         0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// The fixed size header that follows the identifier, and the first entry of
+// the level index that follows the header.
+constexpr size_t kHeaderOffset = sizeof(kKTX2Identifier);
+constexpr size_t kLevelIndexOffset = 80u;
+constexpr size_t kLevelIndexEntrySize = 24u;
+
+// The Vulkan formats of the supported textures.
+constexpr uint32_t kVkFormatETC2R8G8B8A8Unorm = 151u;
+constexpr uint32_t kVkFormatETC2R8G8B8A8Srgb = 152u;
+constexpr uint32_t kVkFormatASTC4x4Unorm = 157u;
+constexpr uint32_t kVkFormatASTC4x4Srgb = 158u;
+
+// The flags of the basic data format descriptor block, which start 15 bytes
+// into the descriptor.
+constexpr size_t kDataFormatFlagsOffset = 15u;
+constexpr uint8_t kDataFormatFlagAlphaPremultiplied = 1u;
+
+constexpr size_t kBlockDimension = 4u;
+constexpr size_t kBytesPerBlock = 16u;
+
+template <typename T>
+T ReadLittleEndian(const uint8_t* bytes) {
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return fml::LittleEndianToArch(value);
+}
+
+}  // namespace
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+KTX2ImageGenerator::KTX2ImageGenerator(SkImageInfo image_info,
+                                       CompressedPixels pixels)
+    : image_info_(std::move(image_info)), pixels_(std::move(pixels)) {}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  FML_LOG(ERROR) << "GPU compressed images can only be drawn by renderers that "
+                    "support their format.";
+  return false;
+}
+
+std::optional<ImageGenerator::CompressedPixels>
+KTX2ImageGenerator::GetCompressedPixels() {
+  return pixels_;
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || data->size() < kLevelIndexOffset + kLevelIndexEntrySize) {
+    return nullptr;
+  }
+  const auto* bytes = data->bytes();
+  if (std::memcmp(bytes, kKTX2Identifier, sizeof(kKTX2Identifier)) != 0) {
+    return nullptr;
+  }
+
+  const auto* header = bytes + kHeaderOffset;
+  const auto vk_format = ReadLittleEndian<uint32_t>(header);
+  const auto width = ReadLittleEndian<uint32_t>(header + 8);
+  const auto height = ReadLittleEndian<uint32_t>(header + 12);
+  const auto depth = ReadLittleEndian<uint32_t>(header + 16);
+  const auto layer_count = ReadLittleEndian<uint32_t>(header + 20);
+  const auto face_count = ReadLittleEndian<uint32_t>(header + 24);
+  const auto supercompression_scheme = ReadLittleEndian<uint32_t>(header + 32);
+  const auto dfd_offset = ReadLittleEndian<uint32_t>(header + 36);
+  const auto dfd_length = ReadLittleEndian<uint32_t>(header + 40);
+
+  CompressedPixels::Format format;
+  switch (vk_format) {
+    case kVkFormatASTC4x4Unorm:
+    case kVkFormatASTC4x4Srgb:
+      format = CompressedPixels::Format::kASTC4x4;
+      break;
+    case kVkFormatETC2R8G8B8A8Unorm:
+    case kVkFormatETC2R8G8B8A8Srgb:
+      format = CompressedPixels::Format::kETC2RGBA8;
+      break;
+    default:
+      FML_DLOG(ERROR) << "Unsupported KTX2 texture format " << vk_format;
+      return nullptr;
+  }
+  if (width == 0 || height == 0 || width > INT32_MAX || height > INT32_MAX ||
+      depth != 0 || layer_count > 1 || face_count != 1 ||
+      supercompression_scheme != 0) {
+    FML_DLOG(ERROR) << "Only single 2D KTX2 textures are supported.";
+    return nullptr;
+  }
+
+  // The first level is the largest.
+  const auto* level = bytes + kLevelIndexOffset;
+  const auto level_offset = ReadLittleEndian<uint64_t>(level);
+  const auto level_length = ReadLittleEndian<uint64_t>(level + 8);
+  const uint64_t expected_length =
+      static_cast<uint64_t>((width + kBlockDimension - 1) / kBlockDimension) *
+      ((height + kBlockDimension - 1) / kBlockDimension) * kBytesPerBlock;
+  if (level_length != expected_length || level_offset > data->size() ||
+      level_length > data->size() - level_offset) {
+    FML_DLOG(ERROR) << "Invalid KTX2 level index.";
+    return nullptr;
+  }
+
+  // Colors are straight unless the data format descriptor says otherwise.
+  auto alpha_type = kUnpremul_SkAlphaType;
+  if (dfd_length > kDataFormatFlagsOffset &&
+      dfd_offset <= data->size() - dfd_length) {
+    const uint8_t flags = bytes[dfd_offset + kDataFormatFlagsOffset];
+    if (flags & kDataFormatFlagAlphaPremultiplied) {
+      alpha_type = kPremul_SkAlphaType;
+    }
+  }
+
+  const auto size = SkISize::Make(width, height);
+  // The image info describes the size for layout. The pixels are never
+  // decoded into this color type.
+  auto image_info = SkImageInfo::Make(size, kRGBA_8888_SkColorType, alpha_type);
+  return std::unique_ptr<ImageGenerator>(new KTX2ImageGenerator(
+      std::move(image_info),
+      {.format = format,
+       .size = size,
+       .data = SkData::MakeSubset(data.get(), level_offset, level_length)}));
+}
+
+}  // namespace flutter
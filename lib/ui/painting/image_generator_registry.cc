@@ -15,10 +15,17 @@
 #endif
 
 #include "image_generator_apng.h"
+#include "image_generator_ktx2.h"
 
 namespace flutter {
 
 ImageGeneratorRegistry::ImageGeneratorRegistry() : weak_factory_(this) {
+  AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return KTX2ImageGenerator::MakeFromData(std::move(buffer));
+      },
+      0);
+
   AddFactory(
       [](sk_sp<SkData> buffer) {
         return APNGImageGenerator::MakeFromData(std::move(buffer));
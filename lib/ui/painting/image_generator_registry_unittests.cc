@@ -4,6 +4,10 @@
 
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/endianness.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
@@ -42,6 +46,70 @@ TEST_F(ShellTest, CreateCompatibleReturnsBuiltinImageGeneratorForValidImage) {
   ASSERT_EQ(info.height(), 4032);
 }
 
+// Creates a KTX2 container of an 8x8 ASTC 4x4 texture with a single level.
+static std::vector<uint8_t> CreateKTX2Container(bool premultiplied) {
+  constexpr uint32_t kLevelIndexOffset = 80u;
+  constexpr uint32_t kDataFormatDescriptorOffset = kLevelIndexOffset + 24u;
+  constexpr uint32_t kDataFormatDescriptorLength = 44u;
+  constexpr uint64_t kLevelOffset =
+      kDataFormatDescriptorOffset + kDataFormatDescriptorLength;
+  constexpr uint64_t kLevelLength = 4u * 16u;
+
+  std::vector<uint8_t> container(kLevelOffset + kLevelLength, 0u);
+  const uint8_t identifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                  0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  std::memcpy(container.data(), identifier, sizeof(identifier));
+  auto write = [&container](size_t offset, auto value) {
+    value = fml::LittleEndianToArch(value);
+    std::memcpy(container.data() + offset, &value, sizeof(value));
+  };
+  write(12u, uint32_t{157u});  // vkFormat, VK_FORMAT_ASTC_4x4_UNORM_BLOCK.
+  write(16u, uint32_t{1u});    // typeSize.
+  write(20u, uint32_t{8u});    // pixelWidth.
+  write(24u, uint32_t{8u});    // pixelHeight.
+  write(36u, uint32_t{1u});    // faceCount.
+  write(40u, uint32_t{1u});    // levelCount.
+  write(48u, kDataFormatDescriptorOffset);
+  write(52u, kDataFormatDescriptorLength);
+  write(kLevelIndexOffset, kLevelOffset);
+  write(kLevelIndexOffset + 8u, kLevelLength);
+  write(kLevelIndexOffset + 16u, kLevelLength);
+  container[kDataFormatDescriptorOffset + 15u] = premultiplied ? 1u : 0u;
+  container[kLevelOffset] = 0x42;
+  return container;
+}
+
+TEST_F(ShellTest, CreateCompatibleReturnsKTX2ImageGeneratorForKTX2Container) {
+  auto container = CreateKTX2Container(/*premultiplied=*/true);
+
+  ImageGeneratorRegistry registry;
+  auto result = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(container.data(), container.size()));
+  ASSERT_NE(result, nullptr);
+  ASSERT_EQ(result->GetInfo().width(), 8);
+  ASSERT_EQ(result->GetInfo().height(), 8);
+  ASSERT_EQ(result->GetInfo().alphaType(), kPremul_SkAlphaType);
+  ASSERT_EQ(result->GetFrameCount(), 1u);
+
+  auto pixels = result->GetCompressedPixels();
+  ASSERT_TRUE(pixels.has_value());
+  ASSERT_EQ(pixels->format, ImageGenerator::CompressedPixels::Format::kASTC4x4);
+  ASSERT_EQ(pixels->size, SkISize::Make(8, 8));
+  ASSERT_EQ(pixels->data->size(), 64u);
+  ASSERT_EQ(pixels->data->bytes()[0], 0x42);
+}
+
+TEST_F(ShellTest, CreateCompatibleRejectsKTX2ContainerWithInvalidLevel) {
+  auto container = CreateKTX2Container(/*premultiplied=*/false);
+  // Claim a level that is larger than the texture.
+  container[80u + 8u] = 128u;
+
+  ImageGeneratorRegistry registry;
+  auto result = registry.CreateCompatibleGenerator(
+      SkData::MakeWithCopy(container.data(), container.size()));
+  ASSERT_EQ(result, nullptr);
+}
+
 TEST_F(ShellTest, CreateCompatibleReturnsNullptrForInvalidImage) {
   ImageGeneratorRegistry registry;
   auto result = registry.CreateCompatibleGenerator(SkData::MakeEmpty());
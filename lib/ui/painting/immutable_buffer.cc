@@ -72,8 +72,14 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle buffer_handle,
   }
 
   auto size = data->GetSize();
+#if FML_OS_ANDROID
+  // Assets that are compressed in the APK are decompressed into the native
+  // heap by the asset manager, see |MakeSkDataWithCopy|.
   const void* bytes = static_cast<const void*>(data->GetMapping());
   auto sk_data = MakeSkDataWithCopy(bytes, size);
+#else
+  auto sk_data = MakeSkDataFromMapping(std::move(data));
+#endif  // FML_OS_ANDROID
   auto buffer = fml::MakeRefCounted<ImmutableBuffer>(sk_data);
   buffer->AssociateWithDartWrapper(buffer_handle);
   tonic::DartInvoke(callback_handle, {tonic::ToDart(size)});
@@ -135,8 +141,7 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
         size_t buffer_size = 0;
         if (mapping->IsValid()) {
           buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -146,6 +151,19 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  const size_t size = mapping->GetSize();
+  if (size == 0) {
+    return SkData::MakeEmpty();
+  }
+  const void* bytes = static_cast<const void*>(mapping->GetMapping());
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(bytes, size, proc, mapping.release());
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
@@ -18,13 +19,23 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 sk_sp<SkData> data)
+    : state_(new State(std::move(generator), std::move(data))) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+MultiFrameCodec::IOContext::IOContext(IOManager& io_manager)
+    : resource_context(io_manager.GetResourceContext()),
+      unref_queue(io_manager.GetSkiaUnrefQueue()),
+      gpu_disable_sync_switch(io_manager.GetIsGpuDisabledSyncSwitch()),
+      impeller_context(io_manager.GetImpellerContext()),
+      image_cache(io_manager.GetDecodedImageCache()) {}
+
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              sk_sp<SkData> data)
     : generator_(std::move(generator)),
+      data_(std::move(data)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
@@ -82,75 +93,92 @@ static bool CopyToBitmap(SkBitmap* dst,
   return true;
 }
 
-sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    std::shared_ptr<impeller::Context> impeller_context_,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
+static SkImageInfo GetFrameImageInfo(ImageGenerator& generator) {
+  SkImageInfo info = generator.GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
-  }
-  if (!bitmap.tryAllocPixels(info)) {
-    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
-                   << info.computeMinByteSize() << "B";
-    return nullptr;
+    info = info.makeAlphaType(kPremul_SkAlphaType);
   }
+  return info;
+}
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+bool MultiFrameCodec::State::DecodeFrame(int frame_index, SkBitmap& bitmap) {
+  const SkImageInfo info = GetFrameImageInfo(*generator_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame_index);
+  const bool keep =
+      frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
-  std::optional<unsigned int> prior_frame_index = std::nullopt;
 
   if (requiredFrameIndex != SkCodec::kNoFrame) {
+    if (lastRequiredFrameIndex_ != requiredFrameIndex &&
+        requiredFrameIndex < frame_index) {
+      // The frames since the required one came from the cache, so decode it
+      // first. Its pixels are only kept as the required frame.
+      SkBitmap requiredFrame;
+      DecodeFrame(requiredFrameIndex, requiredFrame);
+    }
     // We currently assume that frames can only ever depend on the immediately
     // previous frame, if any. This means that
     // `DisposalMethod::kRestorePrevious` is not supported.
     if (lastRequiredFrame_ == nullptr) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frame_index << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else if (lastRequiredFrameIndex_ != requiredFrameIndex) {
       FML_DLOG(INFO) << "Required frame " << requiredFrameIndex
                      << " is not cached. Using blank slate instead.";
-    } else {
-      // Copy the previous frame's output buffer into the current frame as the
-      // starting point.
-      if (lastRequiredFrame_->getPixels() &&
-          CopyToBitmap(&bitmap, lastRequiredFrame_->colorType(),
-                       *lastRequiredFrame_)) {
-        prior_frame_index = requiredFrameIndex;
+    } else if (lastRequiredFrame_->getPixels()) {
+      if (keep && lastRequiredFrame_->pixelRef()->unique()) {
+        // This frame replaces the required frame, and no image uses its
+        // pixels, so this frame is decoded over them instead of a copy.
+        bitmap.swap(*lastRequiredFrame_);
+        lastRequiredFrame_.reset();
+        lastRequiredFrameIndex_ = -1;
+      } else {
+        // Copy the previous frame's output buffer into the current frame as
+        // the starting point.
+        CopyToBitmap(&bitmap, lastRequiredFrame_->colorType(),
+                     *lastRequiredFrame_);
       }
     }
   }
 
+  if (!bitmap.getPixels() && !bitmap.tryAllocPixels(info)) {
+    FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                   << info.computeMinByteSize() << "B";
+    return false;
+  }
+
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
-    return nullptr;
+                             frame_index, requiredFrameIndex)) {
+    FML_LOG(ERROR) << "Could not getPixels for frame " << frame_index;
+    return false;
   }
 
   // Hold onto this if we need it to decode future frames.
-  if (frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep) {
+  if (keep) {
     lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frame_index;
   }
+  return true;
+}
 
+sk_sp<DlImage> MultiFrameCodec::State::UploadFrame(
+    const SkBitmap& bitmap,
+    const IOContext& io_context) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     sk_sp<DlImage> result;
     // impeller, transfer to DlImageImpeller
-    gpu_disable_sync_switch->Execute(fml::SyncSwitch::Handlers().SetIfFalse(
-        [&result, &bitmap, &impeller_context_] {
+    io_context.gpu_disable_sync_switch->Execute(
+        fml::SyncSwitch::Handlers().SetIfFalse([&result, &bitmap,
+                                                &io_context] {
           result = ImageDecoderImpeller::UploadTexture(
-              impeller_context_, std::make_shared<SkBitmap>(bitmap));
+              io_context.impeller_context, std::make_shared<SkBitmap>(bitmap));
         }));
 
     return result;
@@ -158,7 +186,7 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
   sk_sp<SkImage> skImage;
-  gpu_disable_sync_switch->Execute(
+  io_context.gpu_disable_sync_switch->Execute(
       fml::SyncSwitch::Handlers()
           .SetIfTrue([&skImage, &bitmap] {
             // Defer decoding until time of draw later on the raster thread. Can
@@ -166,12 +194,12 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
             // background on iOS.
             skImage = SkImage::MakeFromBitmap(bitmap);
           })
-          .SetIfFalse([&skImage, &resourceContext, &bitmap] {
-            if (resourceContext) {
+          .SetIfFalse([&skImage, &io_context, &bitmap] {
+            if (io_context.resource_context) {
               SkPixmap pixmap(bitmap.info(), bitmap.pixelRef()->pixels(),
                               bitmap.pixelRef()->rowBytes());
               skImage = SkImage::MakeCrossContextFromPixmap(
-                  resourceContext.get(), pixmap, true);
+                  io_context.resource_context.get(), pixmap, true);
             } else {
               // Defer decoding until time of draw later on the raster thread.
               // Can happen when GL operations are currently forbidden such as
@@ -180,22 +208,54 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
             }
           }));
 
-  return DlImageGPU::Make({skImage, std::move(unref_queue)});
+  return DlImageGPU::Make({skImage, io_context.unref_queue});
+}
+
+sk_sp<DlImage> MultiFrameCodec::State::GetFrameImage(
+    int frame_index,
+    const IOContext& io_context) {
+  std::optional<DecodedImageCache::Key> cache_key;
+  if (data_ && io_context.image_cache) {
+    if (!dataHash_.has_value()) {
+      dataHash_ = DecodedImageCache::HashData(*data_);
+    }
+    cache_key = DecodedImageCache::MakeFrameKey(
+        data_, dataHash_.value(), GetFrameImageInfo(*generator_),
+        frame_index);
+    if (auto image = io_context.image_cache->Get(cache_key.value())) {
+      return image;
+    }
+  }
+
+  sk_sp<DlImage> image;
+  {
+    SkBitmap bitmap;
+    if (!DecodeFrame(frame_index, bitmap)) {
+      return nullptr;
+    }
+    image = UploadFrame(bitmap, io_context);
+  }
+  if (image && cache_key.has_value()) {
+    io_context.image_cache->Put(cache_key.value(), image);
+  }
+  return image;
 }
 
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<DartPersistentValue> callback,
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    size_t trace_id,
-    std::shared_ptr<impeller::Context> impeller_context) {
+    const IOContext& io_context,
+    size_t trace_id) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
-  sk_sp<DlImage> dlImage =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        std::move(impeller_context), std::move(unref_queue));
+  sk_sp<DlImage> dlImage;
+  if (prefetchedFrameIndex_ == nextFrameIndex_) {
+    dlImage = std::move(prefetchedFrame_);
+  } else {
+    dlImage = GetFrameImage(nextFrameIndex_, io_context);
+  }
+  prefetchedFrame_ = nullptr;
+  prefetchedFrameIndex_ = -1;
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
@@ -214,6 +274,15 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
   }));
 }
 
+void MultiFrameCodec::State::PrefetchNextFrame(const IOContext& io_context) {
+  if (prefetchedFrameIndex_ == nextFrameIndex_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "MultiFrameCodec::PrefetchNextFrame");
+  prefetchedFrame_ = GetFrameImage(nextFrameIndex_, io_context);
+  prefetchedFrameIndex_ = prefetchedFrame_ ? nextFrameIndex_ : -1;
+}
+
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   static size_t trace_counter = 1;
   const size_t trace_id = trace_counter++;
@@ -242,6 +311,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -249,11 +319,20 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
               [callback = std::move(callback)]() { callback->Clear(); }));
           return;
         }
-        state->GetNextFrameAndInvokeCallback(
-            std::move(callback), ui_task_runner,
-            io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
-            io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
-            io_manager->GetImpellerContext());
+        const IOContext io_context(*io_manager);
+        state->GetNextFrameAndInvokeCallback(std::move(callback),
+                                             ui_task_runner, io_context,
+                                             trace_id);
+        // Decode the frame after this one while this one is shown. Requests
+        // are posted behind this task, so the next one finds it ready.
+        io_task_runner->PostTask(
+            [weak_state = std::move(weak_state), io_manager]() {
+              auto state = weak_state.lock();
+              if (!state || !io_manager) {
+                return;
+              }
+              state->PrefetchNextFrame(IOContext(*io_manager));
+            });
       }));
 
   return Dart_Null();
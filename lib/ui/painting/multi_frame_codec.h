@@ -5,17 +5,29 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
+#include "flutter/lib/ui/io_manager.h"
 #include "flutter/lib/ui/painting/codec.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
 using tonic::DartPersistentValue;
 
 namespace flutter {
 
+// Decodes the frames of an animated image one after the other.
+//
+// While a frame is shown, the codec decodes the one after it, so that it is
+// ready when it is requested. When the codec is given the encoded data of
+// its generator, the uploaded frames are also kept in the decoded image
+// cache of the IO manager, so that codecs of the same data, and later loops
+// of the animation, skip decoding them again.
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                           sk_sp<SkData> data = nullptr);
 
   ~MultiFrameCodec() override;
 
@@ -29,6 +41,17 @@ class MultiFrameCodec : public Codec {
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
  private:
+  // What decoding and uploading frames needs from the IO manager.
+  struct IOContext {
+    explicit IOContext(IOManager& io_manager);
+
+    fml::WeakPtr<GrDirectContext> resource_context;
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue;
+    std::shared_ptr<const fml::SyncSwitch> gpu_disable_sync_switch;
+    std::shared_ptr<impeller::Context> impeller_context;
+    std::shared_ptr<DecodedImageCache> image_cache;
+  };
+
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
@@ -39,9 +62,12 @@ class MultiFrameCodec : public Codec {
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
   struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+    State(std::shared_ptr<ImageGenerator> generator, sk_sp<SkData> data);
 
     const std::shared_ptr<ImageGenerator> generator_;
+    // The encoded data of the generator, or null if the frames are not
+    // cached.
+    const sk_sp<SkData> data_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
@@ -56,20 +82,30 @@ class MultiFrameCodec : public Codec {
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
-    sk_sp<DlImage> GetNextFrameImage(
-        fml::WeakPtr<GrDirectContext> resourceContext,
-        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-        std::shared_ptr<impeller::Context> impeller_context_,
-        fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue);
+    // The frame decoded ahead of its request, and its index.
+    sk_sp<DlImage> prefetchedFrame_;
+    int prefetchedFrameIndex_ = -1;
+
+    // The hash of |data_|, computed with the first frame.
+    std::optional<size_t> dataHash_;
+
+    // Decodes the pixels of a frame, after the frame it requires if that
+    // was not the last one decoded.
+    bool DecodeFrame(int frame_index, SkBitmap& bitmap);
+
+    sk_sp<DlImage> UploadFrame(const SkBitmap& bitmap,
+                               const IOContext& io_context);
+
+    // Returns the uploaded frame from the cache, or decodes and uploads it.
+    sk_sp<DlImage> GetFrameImage(int frame_index, const IOContext& io_context);
 
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
         const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
-        fml::WeakPtr<GrDirectContext> resourceContext,
-        fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
-        const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-        size_t trace_id,
-        std::shared_ptr<impeller::Context> impeller_context_);
+        const IOContext& io_context,
+        size_t trace_id);
+
+    void PrefetchNextFrame(const IOContext& io_context);
   };
 
   // Shared across the UI and IO task runners.
@@ -34,7 +34,9 @@ constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
 constexpr int kDitherIndex = 13;
-constexpr size_t kDataByteCount = 56;  // 4 * (last index + 1)
+constexpr int kGenerationIndex = 14;
+constexpr size_t kDataByteCount = 60;  // 4 * (last index + 1)
+static_assert(kDataByteCount == Paint::kDataWordCount * 4);
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
@@ -66,6 +68,37 @@ constexpr float kInvertColors[20] = {
 // Must be kept in sync with the MaskFilter private constants in painting.dart.
 enum MaskFilterType { kNull, kBlur };
 
+bool SyncedPaint::Contains(uint32_t generation,
+                           const DisplayListAttributeFlags& flags) const {
+  if (generation == 0 || generation != generation_) {
+    return false;
+  }
+  for (size_t i = 0; i < flag_count_; i++) {
+    if (flags_[i] == &flags) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SyncedPaint::Add(uint32_t generation,
+                      const DisplayListAttributeFlags& flags) {
+  if (generation == 0) {
+    Reset();
+    return;
+  }
+  if (generation != generation_ || flag_count_ == kMaxFlags) {
+    generation_ = generation;
+    flag_count_ = 0;
+  }
+  flags_[flag_count_++] = &flags;
+}
+
+void SyncedPaint::Reset() {
+  generation_ = 0;
+  flag_count_ = 0;
+}
+
 Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data)
     : paint_objects_(paint_objects), paint_data_(paint_data) {}
 
@@ -191,7 +224,8 @@ const SkPaint* Paint::paint(SkPaint& paint) const {
 }
 
 bool Paint::sync_to(DisplayListBuilder* builder,
-                    const DisplayListAttributeFlags& flags) const {
+                    const DisplayListAttributeFlags& flags,
+                    SyncedPaint* synced) const {
   if (isNull()) {
     return false;
   }
@@ -201,6 +235,15 @@ bool Paint::sync_to(DisplayListBuilder* builder,
   const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
   const float* float_data = static_cast<const float*>(byte_data.data());
 
+  const uint32_t generation = uint_data[kGenerationIndex];
+  if (synced) {
+    if (synced->Contains(generation, flags)) {
+      return true;
+    }
+    // Cleared until the attributes are completely synchronized.
+    synced->Reset();
+  }
+
   Dart_Handle values[kObjectCount];
   if (Dart_IsNull(paint_objects_)) {
     if (flags.applies_shader()) {
@@ -261,6 +304,42 @@ bool Paint::sync_to(DisplayListBuilder* builder,
     }
   }
 
+  SyncDataTo(uint_data, float_data, builder, flags);
+
+  if (synced) {
+    synced->Add(generation, flags);
+  }
+  return true;
+}
+
+void Paint::sync_data_to(const void* paint_data,
+                         DisplayListBuilder* builder,
+                         const DisplayListAttributeFlags& flags,
+                         SyncedPaint* synced) {
+  const uint32_t* uint_data = static_cast<const uint32_t*>(paint_data);
+  const uint32_t generation = uint_data[kGenerationIndex];
+  if (synced && synced->Contains(generation, flags)) {
+    return;
+  }
+  if (flags.applies_shader()) {
+    builder->setColorSource(nullptr);
+  }
+  if (flags.applies_color_filter()) {
+    builder->setColorFilter(nullptr);
+  }
+  if (flags.applies_image_filter()) {
+    builder->setImageFilter(nullptr);
+  }
+  SyncDataTo(uint_data, static_cast<const float*>(paint_data), builder, flags);
+  if (synced) {
+    synced->Add(generation, flags);
+  }
+}
+
+void Paint::SyncDataTo(const uint32_t* uint_data,
+                       const float* float_data,
+                       DisplayListBuilder* builder,
+                       const DisplayListAttributeFlags& flags) {
   if (flags.applies_anti_alias()) {
     builder->setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
   }
@@ -327,8 +406,6 @@ bool Paint::sync_to(DisplayListBuilder* builder,
         break;
     }
   }
-
-  return true;
 }
 
 void Paint::toDlPaint(DlPaint& paint) const {
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PAINT_H_
 #define FLUTTER_LIB_UI_PAINTING_PAINT_H_
 
+#include <array>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_flags.h"
 #include "third_party/skia/include/core/SkPaint.h"
@@ -12,8 +14,42 @@
 
 namespace flutter {
 
+/// Remembers which paint a display list builder last had its attributes
+/// synchronized from, so that draws with an unchanged paint can skip
+/// decoding it again.
+///
+/// Paints are identified by the generation that the Dart Paint stores in
+/// its data and changes whenever the paint does.
+class SyncedPaint {
+ public:
+  /// Whether the builder already has the attributes of |flags| from the
+  /// paint of |generation|.
+  bool Contains(uint32_t generation,
+                const DisplayListAttributeFlags& flags) const;
+
+  /// Records that the attributes of |flags| were synchronized from the paint
+  /// of |generation|, which is zero if the paint can't be remembered.
+  void Add(uint32_t generation, const DisplayListAttributeFlags& flags);
+
+  /// Forgets the paint, for when the attributes of the builder are set
+  /// other than from a Paint.
+  void Reset();
+
+ private:
+  // The flags are the shared constants of |DisplayListOpFlags|, so they are
+  // compared by address. A few are kept for draws that alternate shapes.
+  static constexpr size_t kMaxFlags = 4;
+
+  uint32_t generation_ = 0;
+  std::array<const DisplayListAttributeFlags*, kMaxFlags> flags_ = {};
+  size_t flag_count_ = 0;
+};
+
 class Paint {
  public:
+  /// The number of 32 bit words in the data of a Paint.
+  static constexpr size_t kDataWordCount = 15;
+
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
@@ -27,8 +63,22 @@ class Paint {
   /// either be DCHECKed or used to indicate to the DisplayList
   /// draw operation whether or not to use the synchronized attributes
   /// (mainly the drawImage and saveLayer methods).
+  ///
+  /// If |synced| is not null, the attributes are not synchronized again
+  /// when it shows the builder already has them from this paint, and it is
+  /// updated otherwise.
   bool sync_to(DisplayListBuilder* builder,
-               const DisplayListAttributeFlags& flags) const;
+               const DisplayListAttributeFlags& flags,
+               SyncedPaint* synced = nullptr) const;
+
+  /// Synchronize the data of a paint that has no shader or filter objects,
+  /// such as a paint copied into a batch of canvas commands, to the display
+  /// list. |paint_data| holds |kDataWordCount| words. |synced| is used as in
+  /// |sync_to|.
+  static void sync_data_to(const void* paint_data,
+                           DisplayListBuilder* builder,
+                           const DisplayListAttributeFlags& flags,
+                           SyncedPaint* synced = nullptr);
 
   bool isNull() const { return Dart_IsNull(paint_data_); }
   bool isNotNull() const { return !Dart_IsNull(paint_data_); }
@@ -36,6 +86,11 @@ class Paint {
  private:
   friend struct tonic::DartConverter<Paint>;
 
+  static void SyncDataTo(const uint32_t* uint_data,
+                         const float* float_data,
+                         DisplayListBuilder* builder,
+                         const DisplayListAttributeFlags& flags);
+
   Dart_Handle paint_objects_;
   Dart_Handle paint_data_;
 };
@@ -58,5 +58,41 @@ TEST_F(ShellTest, ConvertPaintToDlPaint) {
   ASSERT_EQ(dl_paint.getDrawStyle(), DlDrawStyle::kStroke);
 }
 
+TEST(SyncedPaintTest, RemembersTheFlagsSynchronizedFromAGeneration) {
+  const DisplayListAttributeFlags& rect_flags =
+      DisplayListOpFlags::kDrawRectFlags;
+  const DisplayListAttributeFlags& oval_flags =
+      DisplayListOpFlags::kDrawOvalFlags;
+  SyncedPaint synced;
+  EXPECT_FALSE(synced.Contains(1, rect_flags));
+
+  synced.Add(1, rect_flags);
+  EXPECT_TRUE(synced.Contains(1, rect_flags));
+  EXPECT_FALSE(synced.Contains(1, oval_flags));
+  EXPECT_FALSE(synced.Contains(2, rect_flags));
+
+  synced.Add(1, oval_flags);
+  EXPECT_TRUE(synced.Contains(1, rect_flags));
+  EXPECT_TRUE(synced.Contains(1, oval_flags));
+
+  synced.Add(2, rect_flags);
+  EXPECT_TRUE(synced.Contains(2, rect_flags));
+  EXPECT_FALSE(synced.Contains(1, oval_flags));
+  EXPECT_FALSE(synced.Contains(2, oval_flags));
+
+  synced.Reset();
+  EXPECT_FALSE(synced.Contains(2, rect_flags));
+}
+
+TEST(SyncedPaintTest, DoesNotRememberGenerationZero) {
+  const DisplayListAttributeFlags& rect_flags =
+      DisplayListOpFlags::kDrawRectFlags;
+  SyncedPaint synced;
+  synced.Add(1, rect_flags);
+  synced.Add(0, rect_flags);
+  EXPECT_FALSE(synced.Contains(0, rect_flags));
+  EXPECT_FALSE(synced.Contains(1, rect_flags));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,12 +6,16 @@
 
 #include <cmath>
 
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/matrix.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 
 using tonic::ToDart;
 
@@ -24,14 +28,15 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Path);
 CanvasPath::CanvasPath()
     : path_tracker_(UIDartState::Current()->GetVolatilePathTracker()),
       tracked_path_(std::make_shared<VolatilePathTracker::TrackedPath>()) {
-  FML_DCHECK(path_tracker_);
   resetVolatility();
 }
 
 CanvasPath::~CanvasPath() = default;
 
 void CanvasPath::resetVolatility() {
-  if (!tracked_path_->tracking_volatility) {
+  // Background isolates have no tracker, since it counts the frames of the
+  // UI isolate. Their paths are never marked volatile.
+  if (path_tracker_ && !tracked_path_->tracking_volatility) {
     mutable_path().setIsVolatile(true);
     tracked_path_->frame_count = 0;
     tracked_path_->tracking_volatility = true;
@@ -39,6 +44,16 @@ void CanvasPath::resetVolatility() {
   }
 }
 
+std::shared_ptr<CanvasPath::ContourMeasures> CanvasPath::GetContourMeasures(
+    bool force_closed) const {
+  if (!contour_measures_ ||
+      contour_measures_->generation_id != path().getGenerationID() ||
+      contour_measures_->force_closed != force_closed) {
+    contour_measures_ = std::make_shared<ContourMeasures>(path(), force_closed);
+  }
+  return contour_measures_;
+}
+
 int CanvasPath::getFillType() {
   return static_cast<int>(path().getFillType());
 }
@@ -188,6 +203,14 @@ void CanvasPath::addPolygon(const tonic::Float32List& points, bool close) {
   resetVolatility();
 }
 
+void CanvasPath::addPolygonFromBuffer(const float* points,
+                                      uint32_t point_count,
+                                      bool close) {
+  mutable_path().addPoly(reinterpret_cast<const SkPoint*>(points),
+                         point_count, close);
+  resetVolatility();
+}
+
 void CanvasPath::addRRect(const RRect& rrect) {
   mutable_path().addRRect(rrect.sk_rrect);
   resetVolatility();
@@ -301,6 +324,95 @@ bool CanvasPath::op(CanvasPath* path1, CanvasPath* path2, int operation) {
   resetVolatility();
 }
 
+Dart_Handle CanvasPath::opAsync(CanvasPath* path1,
+                                CanvasPath* path2,
+                                int operation,
+                                Dart_Handle callback) {
+  if (!path1 || !path2) {
+    return ToDart("Paths must not be null");
+  }
+  // The copies share the points of the paths until these are mutated, so
+  // the isolate can keep using them.
+  return RunAsync(callback, [path1 = path1->path(), path2 = path2->path(),
+                             operation](SkPath* result) {
+    TRACE_EVENT0("flutter", "CanvasPath::opAsync");
+    return Op(path1, path2, static_cast<SkPathOp>(operation), result);
+  });
+}
+
+static bool UnionPaths(const std::vector<SkPath>& paths, SkPath* result) {
+  SkOpBuilder builder;
+  for (const SkPath& path : paths) {
+    builder.add(path, kUnion_SkPathOp);
+  }
+  return builder.resolve(result);
+}
+
+static std::vector<SkPath> CopyPaths(const std::vector<CanvasPath*>& paths) {
+  std::vector<SkPath> copies;
+  copies.reserve(paths.size());
+  for (CanvasPath* path : paths) {
+    if (path) {
+      copies.push_back(path->path());
+    }
+  }
+  return copies;
+}
+
+bool CanvasPath::unionAll(const std::vector<CanvasPath*>& paths) {
+  bool result = UnionPaths(CopyPaths(paths), &tracked_path_->path);
+  resetVolatility();
+  return result;
+}
+
+Dart_Handle CanvasPath::unionAllAsync(const std::vector<CanvasPath*>& paths,
+                                      Dart_Handle callback) {
+  return RunAsync(callback, [paths = CopyPaths(paths)](SkPath* result) {
+    TRACE_EVENT0("flutter", "CanvasPath::unionAllAsync");
+    return UnionPaths(paths, result);
+  });
+}
+
+Dart_Handle CanvasPath::RunAsync(Dart_Handle callback,
+                                 std::function<bool(SkPath*)> path_op) {
+  if (!Dart_IsClosure(callback)) {
+    return ToDart("Callback must be a function");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  auto persistent_callback =
+      std::make_unique<tonic::DartPersistentValue>(dart_state, callback);
+
+  auto ui_task = fml::MakeCopyable(
+      [path = fml::Ref(this), callback = std::move(persistent_callback)](
+          bool success, const SkPath& result) mutable {
+        auto dart_state = callback->dart_state().lock();
+        if (!dart_state) {
+          return;
+        }
+        if (success) {
+          path->mutable_path() = result;
+          path->resetVolatility();
+        }
+        tonic::DartState::Scope scope(dart_state);
+        tonic::DartInvoke(callback->Get(), {ToDart(success)});
+      });
+
+  dart_state->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [path_op = std::move(path_op), ui_task_runner = std::move(ui_task_runner),
+       ui_task = std::move(ui_task)]() mutable {
+        SkPath result;
+        bool success = path_op(&result);
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [success, result = std::move(result),
+             ui_task = std::move(ui_task)]() mutable {
+              ui_task(success, result);
+            }));
+      }));
+  return Dart_Null();
+}
+
 void CanvasPath::clone(Dart_Handle path_handle) {
   fml::RefPtr<CanvasPath> path = Create(path_handle);
   // per Skia docs, this will create a fast copy
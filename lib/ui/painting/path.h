@@ -5,10 +5,15 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PATH_H_
 #define FLUTTER_LIB_UI_PAINTING_PATH_H_
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/rrect.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
+#include "third_party/skia/include/core/SkContourMeasure.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/pathops/SkPathOps.h"
 #include "third_party/tonic/typed_data/typed_list.h"
@@ -83,6 +88,10 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
               float startAngle,
               float sweepAngle);
   void addPolygon(const tonic::Float32List& points, bool close);
+  // Like |addPolygon|, with the points in the |PointBuffer|.
+  void addPolygonFromBuffer(const float* points,
+                            uint32_t point_count,
+                            bool close);
   void addRRect(const RRect& rrect);
   void addPath(CanvasPath* path, double dx, double dy);
 
@@ -107,19 +116,60 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   tonic::Float32List getBounds();
   bool op(CanvasPath* path1, CanvasPath* path2, int operation);
+  // Like |op|, but runs the operation on the concurrent task runner. The
+  // |callback| is invoked on the UI thread with whether it succeeded, once
+  // this path is the result.
+  Dart_Handle opAsync(CanvasPath* path1,
+                      CanvasPath* path2,
+                      int operation,
+                      Dart_Handle callback);
+  // Sets this path to the union of |paths|.
+  //
+  // All the paths are combined at once, which is much faster than combining
+  // them one by one, as the intermediate unions are not simplified.
+  bool unionAll(const std::vector<CanvasPath*>& paths);
+  // Like |unionAll|, but runs on the concurrent task runner like |opAsync|.
+  Dart_Handle unionAllAsync(const std::vector<CanvasPath*>& paths,
+                            Dart_Handle callback);
   void clone(Dart_Handle path_handle);
 
   const SkPath& path() const { return tracked_path_->path; }
 
+  // The contour measures of one generation of a path. They are computed as
+  // the path measures of the path iterate over its contours, and are shared
+  // by the path measures that are created until the path is mutated.
+  struct ContourMeasures {
+    ContourMeasures(const SkPath& path, bool force_closed)
+        : generation_id(path.getGenerationID()),
+          force_closed(force_closed),
+          iter(path, force_closed) {}
+
+    const uint32_t generation_id;
+    const bool force_closed;
+    SkContourMeasureIter iter;
+    std::vector<sk_sp<SkContourMeasure>> measures;
+    // Whether |iter| has run out of contours.
+    bool complete = false;
+  };
+
+  std::shared_ptr<ContourMeasures> GetContourMeasures(bool force_closed) const;
+
  private:
   CanvasPath();
 
   std::shared_ptr<VolatilePathTracker> path_tracker_;
   std::shared_ptr<VolatilePathTracker::TrackedPath> tracked_path_;
+  mutable std::shared_ptr<ContourMeasures> contour_measures_;
 
   // Must be called whenever the path is created or mutated.
   void resetVolatility();
 
+  // Runs |path_op| on the concurrent task runner, with the path that it
+  // writes its result to. Then sets this path to the result if |path_op|
+  // succeeded and invokes |callback| with whether it did.
+  Dart_Handle RunAsync(Dart_Handle callback,
+                       std::function<bool(SkPath*)> path_op);
+
   SkPath& mutable_path() { return tracked_path_->path; }
 };
 
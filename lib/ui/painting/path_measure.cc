@@ -22,16 +22,13 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, PathMeasure);
 void CanvasPathMeasure::Create(Dart_Handle wrapper,
                                const CanvasPath* path,
                                bool forceClosed) {
-  UIDartState::ThrowIfUIOperationsProhibited();
   fml::RefPtr<CanvasPathMeasure> pathMeasure =
       fml::MakeRefCounted<CanvasPathMeasure>();
   if (path) {
-    const SkPath skPath = path->path();
-    SkScalar resScale = 1;
-    pathMeasure->path_measure_ =
-        std::make_unique<SkContourMeasureIter>(skPath, forceClosed, resScale);
+    pathMeasure->contour_measures_ = path->GetContourMeasures(forceClosed);
   } else {
-    pathMeasure->path_measure_ = std::make_unique<SkContourMeasureIter>();
+    pathMeasure->contour_measures_ =
+        std::make_shared<CanvasPath::ContourMeasures>(SkPath(), forceClosed);
   }
   pathMeasure->AssociateWithDartWrapper(wrapper);
 }
@@ -41,14 +38,21 @@ CanvasPathMeasure::CanvasPathMeasure() {}
 CanvasPathMeasure::~CanvasPathMeasure() {}
 
 void CanvasPathMeasure::setPath(const CanvasPath* path, bool isClosed) {
-  const SkPath& skPath = path->path();
-  path_measure_->reset(skPath, isClosed);
+  contour_measures_ = path->GetContourMeasures(isClosed);
+  contour_count_ = 0;
+}
+
+SkContourMeasure* CanvasPathMeasure::GetMeasure(int contour_index) const {
+  if (contour_index < 0 ||
+      static_cast<size_t>(contour_index) >= contour_count_) {
+    return nullptr;
+  }
+  return contour_measures_->measures[contour_index].get();
 }
 
 float CanvasPathMeasure::getLength(int contour_index) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) < measures_.size()) {
-    return measures_[contour_index]->length();
+  if (SkContourMeasure* measure = GetMeasure(contour_index)) {
+    return measure->length();
   }
   return -1;
 }
@@ -57,14 +61,14 @@ tonic::Float32List CanvasPathMeasure::getPosTan(int contour_index,
                                                 float distance) {
   tonic::Float32List posTan(Dart_NewTypedData(Dart_TypedData_kFloat32, 5));
   posTan[0] = 0;  // dart code will check for this for failure
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) >= measures_.size()) {
+  SkContourMeasure* measure = GetMeasure(contour_index);
+  if (!measure) {
     return posTan;
   }
 
   SkPoint pos;
   SkVector tan;
-  bool success = measures_[contour_index]->getPosTan(distance, &pos, &tan);
+  bool success = measure->getPosTan(distance, &pos, &tan);
 
   if (success) {
     posTan[0] = 1;  // dart code will check for this for success
@@ -82,14 +86,32 @@ void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
                                    float start_d,
                                    float stop_d,
                                    bool start_with_move_to) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) >= measures_.size()) {
+  SkContourMeasure* measure = GetMeasure(contour_index);
+  SkPath dst;
+  if (!measure ||
+      !measure->getSegment(start_d, stop_d, &dst, start_with_move_to)) {
     CanvasPath::Create(path_handle);
+  } else {
+    CanvasPath::CreateFrom(path_handle, dst);
   }
+}
+
+void CanvasPathMeasure::getSegments(Dart_Handle path_handle,
+                                    int contour_index,
+                                    Dart_Handle intervals_handle,
+                                    bool start_with_move_to) {
+  SkContourMeasure* measure = GetMeasure(contour_index);
   SkPath dst;
-  bool success = measures_[contour_index]->getSegment(start_d, stop_d, &dst,
-                                                      start_with_move_to);
-  if (!success) {
+  if (measure) {
+    tonic::Float32List intervals(intervals_handle);
+    // Each segment is appended to the same path, so its first one starts a
+    // new contour only if asked to, like a single segment would.
+    for (intptr_t i = 0; i + 1 < intervals.num_elements(); i += 2) {
+      measure->getSegment(intervals[i], intervals[i + 1], &dst,
+                          i == 0 ? start_with_move_to : true);
+    }
+  }
+  if (dst.isEmpty()) {
     CanvasPath::Create(path_handle);
   } else {
     CanvasPath::CreateFrom(path_handle, dst);
@@ -97,17 +119,24 @@ void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
 }
 
 bool CanvasPathMeasure::isClosed(int contour_index) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) < measures_.size()) {
-    return measures_[contour_index]->isClosed();
+  if (SkContourMeasure* measure = GetMeasure(contour_index)) {
+    return measure->isClosed();
   }
   return false;
 }
 
 bool CanvasPathMeasure::nextContour() {
-  auto measure = path_measure_->next();
-  if (measure) {
-    measures_.push_back(std::move(measure));
+  std::vector<sk_sp<SkContourMeasure>>& measures = contour_measures_->measures;
+  if (contour_count_ == measures.size() && !contour_measures_->complete) {
+    auto measure = contour_measures_->iter.next();
+    if (measure) {
+      measures.push_back(std::move(measure));
+    } else {
+      contour_measures_->complete = true;
+    }
+  }
+  if (contour_count_ < measures.size()) {
+    contour_count_++;
     return true;
   }
   return false;
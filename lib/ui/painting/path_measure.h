@@ -5,7 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PATH_MEASURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PATH_MEASURE_H_
 
-#include <vector>
+#include <memory>
 
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/path.h"
@@ -36,16 +36,23 @@ class CanvasPathMeasure : public RefCountedDartWrappable<CanvasPathMeasure> {
                   float start_d,
                   float stop_d,
                   bool start_with_move_to);
+  void getSegments(Dart_Handle path_handle,
+                   int contour_index,
+                   Dart_Handle intervals_handle,
+                   bool start_with_move_to);
   bool isClosed(int contour_index);
   bool nextContour();
 
-  const SkContourMeasureIter& pathMeasure() const { return *path_measure_; }
-
  private:
   CanvasPathMeasure();
 
-  std::unique_ptr<SkContourMeasureIter> path_measure_;
-  std::vector<sk_sp<SkContourMeasure>> measures_;
+  // Shared with the path and the other measures of the same path.
+  std::shared_ptr<CanvasPath::ContourMeasures> contour_measures_;
+  // The number of contours this measure has iterated over.
+  size_t contour_count_ = 0;
+
+  // Returns null if this measure has not iterated over the contour.
+  SkContourMeasure* GetMeasure(int contour_index) const;
 };
 
 }  // namespace flutter
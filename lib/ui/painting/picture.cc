@@ -5,9 +5,12 @@
 #include "flutter/lib/ui/painting/picture.h"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/display_list_deferred_image_gpu_skia.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -42,6 +45,7 @@ Picture::~Picture() = default;
 Dart_Handle Picture::toImage(uint32_t width,
                              uint32_t height,
                              Dart_Handle raw_image_callback) {
+  UIDartState::ThrowIfUIOperationsProhibited();
   if (!display_list_.skia_object()) {
     return tonic::ToDart("Picture is null");
   }
@@ -52,6 +56,7 @@ Dart_Handle Picture::toImage(uint32_t width,
 void Picture::toImageSync(uint32_t width,
                           uint32_t height,
                           Dart_Handle raw_image_handle) {
+  UIDartState::ThrowIfUIOperationsProhibited();
   FML_DCHECK(display_list_.skia_object());
   RasterizeToImageSync(display_list_.skia_object(), width, height,
                        raw_image_handle);
@@ -80,6 +85,50 @@ static sk_sp<DlImage> CreateDeferredImage(
       raster_task_runner, std::move(unref_queue));
 }
 
+// Renders the picture into a texture owned by the returned image, so that
+// its pixels are not read back from the GPU. Called on the raster thread.
+static sk_sp<DlImage> RasterizeToTexture(
+    bool impeller,
+    const sk_sp<DisplayList>& display_list,
+    const std::shared_ptr<LayerTree>& layer_tree,
+    SkISize size,
+    const fml::TaskRunnerAffineWeakPtr<SnapshotDelegate>& snapshot_delegate,
+    const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
+    const fml::RefPtr<SkiaUnrefQueue>& unref_queue) {
+  FML_DCHECK(raster_task_runner->RunsTasksOnCurrentThread());
+  if (impeller) {
+    sk_sp<DisplayList> snapshot_display_list = display_list;
+    if (layer_tree) {
+      snapshot_display_list = layer_tree->Flatten(
+          SkRect::MakeWH(size.width(), size.height()),
+          snapshot_delegate->GetTextureRegistry(),
+          snapshot_delegate->GetGrContext());
+    }
+    return snapshot_delegate->MakeRasterSnapshot(snapshot_display_list, size);
+  }
+
+  // On the raster thread, the deferred image is rendered before it is
+  // returned.
+  const SkImageInfo image_info = SkImageInfo::Make(
+      size.width(), size.height(), kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+  sk_sp<DlDeferredImageGPUSkia> image;
+  if (layer_tree) {
+    image = DlDeferredImageGPUSkia::MakeFromLayerTree(
+        image_info, layer_tree, snapshot_delegate, raster_task_runner,
+        unref_queue);
+  } else {
+    image = DlDeferredImageGPUSkia::Make(image_info, display_list,
+                                         snapshot_delegate, raster_task_runner,
+                                         unref_queue);
+  }
+  if (image->get_error().has_value()) {
+    FML_LOG(ERROR) << "Could not rasterize the picture: "
+                   << image->get_error().value();
+    return nullptr;
+  }
+  return image;
+}
+
 // static
 void Picture::RasterizeToImageSync(sk_sp<DisplayList> display_list,
                                    uint32_t width,
@@ -102,6 +151,48 @@ void Picture::RasterizeToImageSync(sk_sp<DisplayList> display_list,
   image->AssociateWithDartWrapper(raw_image_handle);
 }
 
+namespace {
+
+// The display lists of the pictures on their way to another isolate.
+struct PictureTransfers {
+  std::mutex mutex;
+  int64_t next_handle = 1;
+  std::unordered_map<int64_t, sk_sp<DisplayList>> display_lists;
+};
+
+PictureTransfers& GetPictureTransfers() {
+  static PictureTransfers* transfers = new PictureTransfers();
+  return *transfers;
+}
+
+}  // namespace
+
+int64_t Picture::transfer() {
+  FML_DCHECK(display_list_.skia_object());
+  // Display lists are immutable, so the isolates can share this one.
+  auto& transfers = GetPictureTransfers();
+  std::scoped_lock lock(transfers.mutex);
+  const int64_t handle = transfers.next_handle++;
+  transfers.display_lists[handle] = display_list_.skia_object();
+  return handle;
+}
+
+bool Picture::CreateFromTransfer(Dart_Handle dart_handle, int64_t handle) {
+  sk_sp<DisplayList> display_list;
+  {
+    auto& transfers = GetPictureTransfers();
+    std::scoped_lock lock(transfers.mutex);
+    auto found = transfers.display_lists.find(handle);
+    if (found == transfers.display_lists.end()) {
+      return false;
+    }
+    display_list = std::move(found->second);
+    transfers.display_lists.erase(found);
+  }
+  Create(dart_handle, UIDartState::CreateGPUObject(std::move(display_list)));
+  return true;
+}
+
 void Picture::dispose() {
   display_list_.reset();
   ClearDartWrapper();
@@ -152,6 +243,7 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
   auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
   auto raster_task_runner = dart_state->GetTaskRunners().GetRasterTaskRunner();
   auto snapshot_delegate = dart_state->GetSnapshotDelegate();
+  const bool impeller = dart_state->IsImpellerEnabled();
 
   // We can't create an image on this task runner because we don't have a
   // graphics context. Even if we did, it would be slow anyway. Also, this
@@ -163,8 +255,8 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
   auto ui_task =
       // The static leak checker gets confused by the use of fml::MakeCopyable.
       // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-      fml::MakeCopyable([image_callback = std::move(image_callback),
-                         unref_queue](sk_sp<DlImage> image) mutable {
+      fml::MakeCopyable([image_callback = std::move(image_callback)](
+                            sk_sp<DlImage> image) mutable {
         auto dart_state = image_callback->dart_state().lock();
         if (!dart_state) {
           // The root isolate could have died in the meantime.
@@ -177,11 +269,6 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
           return;
         }
 
-        if (image->skia_image()) {
-          image =
-              DlImageGPU::Make({image->skia_image(), std::move(unref_queue)});
-        }
-
         auto dart_image = CanvasImage::Create();
         dart_image->set_image(image);
         auto* raw_dart_image = tonic::ToDart(dart_image);
@@ -194,27 +281,32 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
         image_callback.reset();
       });
 
-  // Kick things off on the raster rask runner.
+  // Kick things off on the raster rask runner. The image is not needed by
+  // the next frame, so it is rasterized once the engine is idle instead of
+  // competing with the frames.
   fml::TaskRunner::RunNowOrPostTask(
       raster_task_runner,
-      [ui_task_runner, snapshot_delegate, display_list, picture_bounds, ui_task,
+      [ui_task_runner, raster_task_runner, snapshot_delegate, unref_queue,
+       impeller, display_list, picture_bounds, ui_task,
        layer_tree = std::move(layer_tree)] {
-        sk_sp<DlImage> image;
-        if (layer_tree) {
-          auto display_list = layer_tree->Flatten(
-              SkRect::MakeWH(picture_bounds.width(), picture_bounds.height()),
-              snapshot_delegate->GetTextureRegistry(),
-              snapshot_delegate->GetGrContext());
-
-          image = snapshot_delegate->MakeRasterSnapshot(display_list,
-                                                        picture_bounds);
-        } else {
-          image = snapshot_delegate->MakeRasterSnapshot(display_list,
-                                                        picture_bounds);
+        if (!snapshot_delegate) {
+          ui_task_runner->PostTask([ui_task]() { ui_task(nullptr); });
+          return;
         }
-
-        fml::TaskRunner::RunNowOrPostTask(
-            ui_task_runner, [ui_task, image]() { ui_task(image); });
+        snapshot_delegate->PostIdleTask([ui_task_runner, raster_task_runner,
+                                         snapshot_delegate, unref_queue,
+                                         impeller, display_list,
+                                         picture_bounds, ui_task, layer_tree] {
+          TRACE_EVENT0("flutter", "Picture::RasterizeToImage");
+          sk_sp<DlImage> image;
+          if (snapshot_delegate) {
+            image = RasterizeToTexture(impeller, display_list, layer_tree,
+                                       picture_bounds, snapshot_delegate,
+                                       raster_task_runner, unref_queue);
+          }
+          fml::TaskRunner::RunNowOrPostTask(
+              ui_task_runner, [ui_task, image]() { ui_task(image); });
+        });
       });
 
   return Dart_Null();
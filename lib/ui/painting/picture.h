@@ -42,6 +42,14 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
   size_t GetAllocationSize() const;
 
+  // Keeps the display list of this picture until |CreateFromTransfer| is
+  // called with the returned handle, which may be on another isolate.
+  int64_t transfer();
+
+  // Creates a picture from the display list kept by |transfer| for |handle|.
+  // Returns false if there is none, because the handle was already used.
+  static bool CreateFromTransfer(Dart_Handle dart_handle, int64_t handle);
+
   static void RasterizeToImageSync(sk_sp<DisplayList> display_list,
                                    uint32_t width,
                                    uint32_t height,
@@ -6,6 +6,12 @@
 
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/picture.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
+#include "flutter/lib/ui/window/window.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/display_list/display_list_glyph_prerasterizer.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -16,7 +22,6 @@ namespace flutter {
 IMPLEMENT_WRAPPERTYPEINFO(ui, PictureRecorder);
 
 void PictureRecorder::Create(Dart_Handle wrapper) {
-  UIDartState::ThrowIfUIOperationsProhibited();
   auto res = fml::MakeRefCounted<PictureRecorder>();
   res->AssociateWithDartWrapper(wrapper);
 }
@@ -25,6 +30,30 @@ PictureRecorder::PictureRecorder() {}
 
 PictureRecorder::~PictureRecorder() {}
 
+#if IMPELLER_SUPPORTS_RENDERING
+// Rasterize the glyphs of the picture on a worker while the frame is still
+// being built so that the raster thread only has to copy them into the glyph
+// atlas.
+static void PrerasterizeGlyphs(const sk_sp<DisplayList>& display_list) {
+  auto* dart_state = UIDartState::Current();
+  if (!dart_state || !dart_state->IsImpellerEnabled() || !display_list) {
+    return;
+  }
+  auto task_runner = dart_state->GetConcurrentTaskRunner();
+  auto* platform_configuration = dart_state->platform_configuration();
+  if (!task_runner || !platform_configuration ||
+      !platform_configuration->get_window(0)) {
+    return;
+  }
+  auto scale = platform_configuration->get_window(0)
+                   ->viewport_metrics()
+                   .device_pixel_ratio;
+  task_runner->PostTask([display_list, scale]() {
+    impeller::PrerasterizeDisplayListGlyphs(*display_list, scale);
+  });
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 sk_sp<DisplayListBuilder> PictureRecorder::BeginRecording(SkRect bounds) {
   display_list_builder_ =
       sk_make_sp<DisplayListBuilder>(bounds, /*prepare_rtree=*/true);
@@ -38,8 +67,12 @@ fml::RefPtr<Picture> PictureRecorder::endRecording(Dart_Handle dart_picture) {
 
   fml::RefPtr<Picture> picture;
 
-  picture = Picture::Create(dart_picture, UIDartState::CreateGPUObject(
-                                              display_list_builder_->Build()));
+  auto display_list = display_list_builder_->Build();
+#if IMPELLER_SUPPORTS_RENDERING
+  PrerasterizeGlyphs(display_list);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  picture = Picture::Create(dart_picture,
+                            UIDartState::CreateGPUObject(display_list));
   display_list_builder_ = nullptr;
 
   canvas_->Invalidate();
@@ -0,0 +1,22 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/point_buffer.h"
+
+#include <vector>
+
+namespace flutter {
+
+float* PointBuffer::Reserve(uint32_t point_count) {
+  if (point_count > kMaxPointCount) {
+    return nullptr;
+  }
+  thread_local std::vector<float> buffer;
+  if (buffer.size() < point_count * 2) {
+    buffer.resize(point_count * 2);
+  }
+  return buffer.data();
+}
+
+}  // namespace flutter
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_POINT_BUFFER_H_
+#define FLUTTER_LIB_UI_PAINTING_POINT_BUFFER_H_
+
+#include <cstdint>
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A buffer in native memory that dart:ui writes lists of points to, so that
+/// natives such as |CanvasPath::addPolygonFromBuffer| can read them without
+/// a typed list being allocated, passed as a handle, and acquired.
+///
+/// There is one buffer per thread. Dart reserves it right before each call
+/// that reads it, so isolates that share a thread can't see each other's
+/// points.
+///
+class PointBuffer {
+ public:
+  /// The most points that the buffer holds. Longer lists are passed in typed
+  /// lists, so that the buffer stays small.
+  static constexpr uint32_t kMaxPointCount = 4096u;
+
+  /// Returns the buffer with room for |point_count| points, as pairs of x and
+  /// y coordinates, or nullptr if |point_count| is more than
+  /// |kMaxPointCount|. The buffer may move on each call.
+  static float* Reserve(uint32_t point_count);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_POINT_BUFFER_H_
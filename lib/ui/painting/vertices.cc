@@ -24,7 +24,6 @@ bool Vertices::init(Dart_Handle vertices_handle,
                     Dart_Handle texture_coordinates_handle,
                     Dart_Handle colors_handle,
                     Dart_Handle indices_handle) {
-  UIDartState::ThrowIfUIOperationsProhibited();
 
   tonic::Float32List positions(positions_handle);
   tonic::Float32List texture_coordinates(texture_coordinates_handle);
@@ -80,6 +79,41 @@ bool Vertices::init(Dart_Handle vertices_handle,
   return true;
 }
 
+bool Vertices::update(Dart_Handle positions_handle,
+                      Dart_Handle texture_coordinates_handle,
+                      Dart_Handle colors_handle) {
+  if (!vertices_) {
+    return false;
+  }
+
+  tonic::Float32List positions(positions_handle);
+  tonic::Float32List texture_coordinates(texture_coordinates_handle);
+  tonic::Int32List colors(colors_handle);
+
+  // The lists must match the ones these vertices were created with. Canvases
+  // copy the vertices they draw, so they can be updated in place.
+  const intptr_t vertex_count = vertices_->vertex_count();
+  if ((positions.data() && positions.num_elements() != vertex_count * 2) ||
+      (texture_coordinates.data() &&
+       (!vertices_->texture_coordinates() ||
+        texture_coordinates.num_elements() != vertex_count * 2)) ||
+      (colors.data() &&
+       (!vertices_->colors() || colors.num_elements() != vertex_count))) {
+    return false;
+  }
+
+  if (positions.data()) {
+    vertices_->update_vertices(positions.data());
+  }
+  if (texture_coordinates.data()) {
+    vertices_->update_texture_coordinates(texture_coordinates.data());
+  }
+  if (colors.data()) {
+    vertices_->update_colors(reinterpret_cast<const uint32_t*>(colors.data()));
+  }
+  return true;
+}
+
 void Vertices::dispose() {
   vertices_.reset();
   ClearDartWrapper();
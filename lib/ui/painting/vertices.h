@@ -26,6 +26,10 @@ class Vertices : public RefCountedDartWrappable<Vertices> {
                    Dart_Handle colors_handle,
                    Dart_Handle indices_handle);
 
+  bool update(Dart_Handle positions_handle,
+              Dart_Handle texture_coordinates_handle,
+              Dart_Handle colors_handle);
+
   const DlVertices* vertices() const { return vertices_.get(); }
 
   void dispose();
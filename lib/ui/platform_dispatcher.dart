@@ -91,6 +91,42 @@ class RootIsolateToken {
   external static int __getRootIsolateToken();
 }
 
+/// A ring buffer in memory that the embedder shares with Dart, opened with
+/// [PlatformDispatcher.openSharedRingBuffer].
+///
+/// The bytes of the ring are not copied: the bytes that the embedder writes
+/// are visible in [bytes], and the bytes written to [bytes] are visible to the
+/// embedder. The byte at index `i` of the stream is stored at `i % capacity`.
+///
+/// The [producerIndex] counts the bytes written to the ring and the
+/// [consumerIndex] the bytes read from it. Both only grow. Which of the
+/// embedder and Dart produces and which consumes is up to them. The embedder
+/// usually posts the new producer index to the notification port of the ring
+/// buffer when it writes to it.
+class SharedRingBuffer {
+  SharedRingBuffer._(this._memory)
+    : bytes = ByteData.sublistView(_memory, _headerSize);
+
+  // The producer and consumer indices that precede the bytes of the ring.
+  static const int _headerSize = 16;
+
+  final ByteData _memory;
+
+  /// The bytes of the ring.
+  final ByteData bytes;
+
+  /// The number of bytes in the ring.
+  int get capacity => bytes.lengthInBytes;
+
+  /// The number of bytes written to the ring.
+  int get producerIndex => _memory.getUint64(0, Endian.host);
+  set producerIndex(int value) => _memory.setUint64(0, value, Endian.host);
+
+  /// The number of bytes read from the ring.
+  int get consumerIndex => _memory.getUint64(8, Endian.host);
+  set consumerIndex(int value) => _memory.setUint64(8, value, Endian.host);
+}
+
 /// Platform event dispatcher singleton.
 ///
 /// The most basic interface to the host operating system's interface.
@@ -266,6 +302,13 @@ class PlatformDispatcher {
     _invoke(onMetricsChanged, _onMetricsChangedZone);
   }
 
+  // Removes the view with the given id after the embedder removed it.
+  void _removeView(Object id) {
+    _views.remove(id);
+    _viewConfigurations.remove(id);
+    _invoke(onMetricsChanged, _onMetricsChangedZone);
+  }
+
   List<DisplayFeature> _decodeDisplayFeatures({
     required List<double> bounds,
     required List<int> type,
@@ -592,6 +635,53 @@ class PlatformDispatcher {
   @Native<Void Function(Int64)>(symbol: 'PlatformConfigurationNativeApi::RegisterBackgroundIsolate')
   external static void __registerBackgroundIsolate(int rootIsolateId);
 
+  /// Routes the messages that the platform sends on the channel [name] to
+  /// [port] instead of [onPlatformMessage] of the isolate identified by the
+  /// [token], or stops routing them if [port] is null.
+  ///
+  /// Routed messages don't go through the thread of the root isolate, so a
+  /// background isolate can handle a busy channel without taking time from
+  /// the frames of the root isolate. Each message is received by [port] as a
+  /// list of a response identifier and the data of the message, which is null
+  /// if the message has none. Messages on a channel are received in the order
+  /// the platform sent them.
+  ///
+  /// A response identifier of zero means that the platform expects no
+  /// response. Otherwise, the message must be responded to with
+  /// [respondToPortPlatformMessage].
+  void setPlatformMessagePort(RootIsolateToken token, String name, SendPort? port) {
+    __setPlatformMessagePort(token._token, name, port?.nativePort ?? 0);
+  }
+  @Native<Void Function(Int64, Handle, Int64)>(symbol: 'PlatformConfigurationNativeApi::SetPlatformMessagePort')
+  external static void __setPlatformMessagePort(int rootIsolateId, String name, int port);
+
+  /// Responds to a message received on a port set with
+  /// [setPlatformMessagePort]. The [responseId] is the identifier received
+  /// with the message.
+  void respondToPortPlatformMessage(RootIsolateToken token, int responseId, ByteData? data) {
+    __respondToPortPlatformMessage(token._token, responseId, data);
+  }
+  @Native<Void Function(Int64, Int64, Handle)>(symbol: 'PlatformConfigurationNativeApi::RespondToPortPlatformMessage')
+  external static void __respondToPortPlatformMessage(int rootIsolateId, int responseId, ByteData? data);
+
+  /// Opens the ring buffer that the embedder registered with the [name] for
+  /// the root isolate identified by the [token], or returns null if there is
+  /// none.
+  ///
+  /// The integers that the embedder posts to notify the ring buffer, usually
+  /// its new producer index, are received by [notificationPort]. There is only
+  /// one notification port per ring buffer, so opening it again replaces the
+  /// port, and a null port stops the notifications.
+  ///
+  /// The memory of the ring buffer stays valid as long as the returned
+  /// [SharedRingBuffer] is reachable, even if the embedder unregisters it.
+  SharedRingBuffer? openSharedRingBuffer(RootIsolateToken token, String name, SendPort? notificationPort) {
+    final ByteData? memory = __openSharedRingBuffer(token._token, name, notificationPort?.nativePort ?? 0);
+    return memory == null ? null : SharedRingBuffer._(memory);
+  }
+  @Native<Handle Function(Int64, Handle, Int64)>(symbol: 'PlatformConfigurationNativeApi::OpenSharedRingBuffer')
+  external static ByteData? __openSharedRingBuffer(int rootIsolateId, String name, int port);
+
   /// Called whenever this platform dispatcher receives a message from a
   /// platform-specific plugin.
   ///
@@ -667,6 +757,18 @@ class PlatformDispatcher {
     }
   }
 
+  /// Send a batch of messages that the platform sent on one channel to the
+  /// framework, in the order they were sent.
+  ///
+  /// The engine coalesces the messages on the channels it was configured to
+  /// batch, and hands them over with a single call.
+  void _dispatchPlatformMessages(String name, List<Object?> data, List<int> responseIds) {
+    assert(data.length == responseIds.length);
+    for (int i = 0; i < data.length; i++) {
+      _dispatchPlatformMessage(name, data[i] as ByteData?, responseIds[i]);
+    }
+  }
+
   /// Set the debug name associated with this platform dispatcher's root
   /// isolate.
   ///
@@ -18,6 +18,7 @@ namespace flutter {
 void pushStringAttributes(
     StringAttributes& destination,
     const std::vector<NativeStringAttribute*>& native_attributes) {
+  destination.reserve(destination.size() + native_attributes.size());
   for (const auto& native_attribute : native_attributes) {
     destination.push_back(native_attribute->GetAttribute());
   }
@@ -115,7 +116,7 @@ void SemanticsUpdateBuilder::updateNode(
   node.customAccessibilityActions = std::vector<int32_t>(
       localContextActions.data(),
       localContextActions.data() + localContextActions.num_elements());
-  nodes_[id] = node;
+  nodes_[id] = std::move(node);
 }
 
 void SemanticsUpdateBuilder::updateCustomAction(int id,
@@ -127,7 +128,7 @@ void SemanticsUpdateBuilder::updateCustomAction(int id,
   action.overrideId = overrideId;
   action.label = std::move(label);
   action.hint = std::move(hint);
-  actions_[id] = action;
+  actions_[id] = std::move(action);
 }
 
 void SemanticsUpdateBuilder::build(Dart_Handle semantics_update_handle) {
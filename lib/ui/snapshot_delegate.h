@@ -10,6 +10,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/closure.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPromiseImageTexture.h"
@@ -73,6 +74,14 @@ class SnapshotDelegate {
                                             SkISize picture_size) = 0;
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs |task| on the raster task runner once the engine is idle
+  ///             between frames, so that snapshots that are not needed for the
+  ///             next frame don't delay it. The task still runs shortly after
+  ///             it was posted if the engine does not go idle by then.
+  ///
+  virtual void PostIdleTask(fml::closure task) = 0;
 };
 
 }  // namespace flutter
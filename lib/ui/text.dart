@@ -2745,6 +2745,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   ///
   /// The [ParagraphConstraints] control how wide the text is allowed to be.
   void layout(ParagraphConstraints constraints) {
+    assert(!_layoutPending);
     _layout(constraints.width);
     assert(() {
       _needsLayout = false;
@@ -2754,6 +2755,38 @@ class Paragraph extends NativeFieldWrapperClass1 {
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Paragraph::layout', isLeaf: true)
   external void _layout(double width);
 
+  /// Computes the size and position of each glyph in the paragraph on a
+  /// background thread, without blocking the current isolate.
+  ///
+  /// This lets many paragraphs be laid out ahead of the time they are
+  /// displayed, for example the rows of a list that is about to scroll into
+  /// view. Layouts of paragraphs that use the same fonts do not run
+  /// concurrently with each other, but they do run concurrently with the
+  /// isolate.
+  ///
+  /// The paragraph must not be used, laid out again or disposed until the
+  /// returned future completes.
+  Future<void> layoutAsync(ParagraphConstraints constraints) {
+    assert(!_layoutPending);
+    assert(() {
+      _layoutPending = true;
+      return true;
+    }());
+    return _futurize<bool>((_Callback<bool?> callback) {
+      return _layoutAsync(constraints.width, callback);
+    }).then((_) {
+      assert(() {
+        _layoutPending = false;
+        _needsLayout = false;
+        return true;
+      }());
+    });
+  }
+  @Native<Handle Function(Pointer<Void>, Double, Handle)>(symbol: 'Paragraph::layoutAsync')
+  external String? _layoutAsync(double width, _Callback<bool?> callback);
+
+  bool _layoutPending = false;
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -2916,6 +2949,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   /// after this method is called.
   void dispose() {
     assert(!_disposed);
+    assert(!_layoutPending);
     assert(() {
       _disposed = true;
       return true;
@@ -3223,10 +3257,15 @@ class ParagraphBuilder extends NativeFieldWrapperClass1 {
 /// * `list`: A list of bytes containing the font file.
 /// * `fontFamily`: The family name used to identify the font in text styles.
 ///  If this is not provided, then the family name will be extracted from the font file.
-Future<void> loadFontFromList(Uint8List list, {String? fontFamily}) {
+/// * `subset`: Whether to only load the glyphs of the characters that are used
+///  by paragraphs with this font. The glyphs of new characters are added as the
+///  paragraphs that use them are built. This reduces the memory that large
+///  fonts, such as CJK fonts, use when only a few of their characters are
+///  drawn. Fonts that cannot be subset are loaded in full.
+Future<void> loadFontFromList(Uint8List list, {String? fontFamily, bool subset = false}) {
   return _futurize(
     (_Callback<void> callback) {
-      _loadFontFromList(list, callback, fontFamily ?? '');
+      _loadFontFromList(list, callback, fontFamily ?? '', subset);
       return null;
     }
   ).then((_) => _sendFontChangeMessage());
@@ -3251,5 +3290,5 @@ FutureOr<void> _sendFontChangeMessage() async {
   }
 }
 
-@Native<Void Function(Handle, Handle, Handle)>(symbol: 'FontCollection::LoadFontFromList')
-external void _loadFontFromList(Uint8List list, _Callback<void> callback, String fontFamily);
+@Native<Void Function(Handle, Handle, Handle, Bool)>(symbol: 'FontCollection::LoadFontFromList')
+external void _loadFontFromList(Uint8List list, _Callback<void> callback, String fontFamily, bool subset);
@@ -50,8 +50,10 @@ SkFontStyleSet* AssetManagerFontProvider::MatchFamily(
   return font_style_set.release();
 }
 
-void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
-                                             const std::string& asset) {
+void AssetManagerFontProvider::RegisterAsset(
+    const std::string& family_name,
+    const std::string& asset,
+    std::optional<SkFontStyle> style) {
   std::string canonical_name = CanonicalFamilyName(family_name);
   auto family_it = registered_families_.find(canonical_name);
 
@@ -63,7 +65,7 @@ void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
     family_it = registered_families_.emplace(value).first;
   }
 
-  family_it->second->registerAsset(asset);
+  family_it->second->registerAsset(asset, style);
 }
 
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
@@ -74,8 +76,10 @@ AssetManagerFontStyleSet::AssetManagerFontStyleSet(
 
 AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
 
-void AssetManagerFontStyleSet::registerAsset(const std::string& asset) {
-  assets_.emplace_back(asset);
+void AssetManagerFontStyleSet::registerAsset(
+    const std::string& asset,
+    std::optional<SkFontStyle> style) {
+  assets_.emplace_back(asset, style);
 }
 
 int AssetManagerFontStyleSet::count() {
@@ -86,7 +90,9 @@ void AssetManagerFontStyleSet::getStyle(int index,
                                         SkFontStyle* style,
                                         SkString* name) {
   FML_DCHECK(index < static_cast<int>(assets_.size()));
-  if (style) {
+  if (style && assets_[index].style) {
+    *style = assets_[index].style.value();
+  } else if (style) {
     sk_sp<SkTypeface> typeface(createTypeface(index));
     if (typeface) {
       *style = typeface->fontStyle();
@@ -130,11 +136,18 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
 }
 
 SkTypeface* AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern) {
+  // Matching styles loads the fonts whose style isn't declared, which is
+  // pointless if there is only one.
+  if (assets_.size() == 1) {
+    return createTypeface(0);
+  }
   return matchStyleCSS3(pattern);
 }
 
-AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(std::string a)
-    : asset(std::move(a)) {}
+AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
+    std::string a,
+    std::optional<SkFontStyle> s)
+    : asset(std::move(a)), style(s) {}
 
 AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
     const AssetManagerFontStyleSet::TypefaceAsset& other) = default;
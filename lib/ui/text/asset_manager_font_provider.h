@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,7 +26,11 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
   ~AssetManagerFontStyleSet() override;
 
-  void registerAsset(const std::string& asset);
+  // Registers a font file of the family. Its typeface is only created once it
+  // is used. If the font manifest declares the |style| of the font, the font
+  // file isn't loaded to match styles either.
+  void registerAsset(const std::string& asset,
+                     std::optional<SkFontStyle> style = std::nullopt);
 
   // |SkFontStyleSet|
   int count() override;
@@ -44,13 +49,14 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
   std::string family_name_;
 
   struct TypefaceAsset {
-    explicit TypefaceAsset(std::string a);
+    TypefaceAsset(std::string a, std::optional<SkFontStyle> s);
 
     TypefaceAsset(const TypefaceAsset& other);
 
     ~TypefaceAsset();
 
     std::string asset;
+    std::optional<SkFontStyle> style;
     sk_sp<SkTypeface> typeface;
   };
   std::vector<TypefaceAsset> assets_;
@@ -65,7 +71,9 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
   ~AssetManagerFontProvider() override;
 
-  void RegisterAsset(const std::string& family_name, const std::string& asset);
+  void RegisterAsset(const std::string& family_name,
+                     const std::string& asset,
+                     std::optional<SkFontStyle> style = std::nullopt);
 
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/text/asset_manager_font_provider.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(AssetManagerFontProviderTest, DeclaredStylesDoNotLoadFonts) {
+  // The asset manager has no resolvers, so loading any of the fonts fails.
+  AssetManagerFontProvider provider(std::make_shared<AssetManager>());
+  provider.RegisterAsset("Roboto", "fonts/Roboto-Bold.ttf",
+                         SkFontStyle::Bold());
+  provider.RegisterAsset("Roboto", "fonts/Roboto-Italic.ttf",
+                         SkFontStyle::Italic());
+
+  sk_sp<SkFontStyleSet> style_set(provider.MatchFamily("roboto"));
+  ASSERT_TRUE(style_set);
+  ASSERT_EQ(style_set->count(), 2);
+
+  SkFontStyle style;
+  SkString name;
+  style_set->getStyle(0, &style, &name);
+  EXPECT_EQ(style, SkFontStyle::Bold());
+  EXPECT_STREQ(name.c_str(), "Roboto");
+  style_set->getStyle(1, &style, nullptr);
+  EXPECT_EQ(style, SkFontStyle::Italic());
+}
+
+TEST(AssetManagerFontProviderTest, UndeclaredStylesAreReadFromFonts) {
+  AssetManagerFontProvider provider(std::make_shared<AssetManager>());
+  provider.RegisterAsset("Roboto", "fonts/Roboto-Regular.ttf");
+  provider.RegisterAsset("Roboto", "fonts/Roboto-Bold.ttf");
+
+  sk_sp<SkFontStyleSet> style_set(provider.MatchFamily("Roboto"));
+  ASSERT_TRUE(style_set);
+
+  // The style of a font that can't be loaded is left as is.
+  SkFontStyle style = SkFontStyle::BoldItalic();
+  style_set->getStyle(0, &style, nullptr);
+  EXPECT_EQ(style, SkFontStyle::BoldItalic());
+  EXPECT_EQ(style_set->matchStyle(SkFontStyle::Normal()), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
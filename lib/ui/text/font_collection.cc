@@ -4,8 +4,14 @@
 
 #include "flutter/lib/ui/text/font_collection.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <mutex>
+#include <optional>
 
+#include "flutter/fml/file.h"
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
@@ -15,6 +21,7 @@
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
 #include "third_party/skia/include/core/SkTypeface.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -34,6 +41,10 @@ FontCollection::FontCollection()
 FontCollection::~FontCollection() {
   collection_.reset();
   SkGraphics::PurgeFontCache();
+  subsetted_fonts_.clear();
+  for (const std::string& file_name : subsetted_font_file_names_) {
+    fml::UnlinkFile(subsetted_font_directory_, file_name.c_str());
+  }
 }
 
 std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
@@ -45,6 +56,27 @@ void FontCollection::SetupDefaultFontManager(
   collection_->SetupDefaultFontManager(font_initialization_data);
 }
 
+// The style of a font of the manifest, if it declares its weight or style.
+// Fonts with a declared style are only loaded once they are used.
+static std::optional<SkFontStyle> GetDeclaredFontStyle(
+    const rapidjson::Value& family_font) {
+  auto weight = family_font.FindMember("weight");
+  auto style = family_font.FindMember("style");
+  const bool has_weight =
+      weight != family_font.MemberEnd() && weight->value.IsInt();
+  const bool has_style =
+      style != family_font.MemberEnd() && style->value.IsString();
+  if (!has_weight && !has_style) {
+    return std::nullopt;
+  }
+  return SkFontStyle(
+      has_weight ? weight->value.GetInt() : SkFontStyle::kNormal_Weight,
+      SkFontStyle::kNormal_Width,
+      has_style && strcmp(style->value.GetString(), "italic") == 0
+          ? SkFontStyle::kItalic_Slant
+          : SkFontStyle::kUpright_Slant);
+}
+
 // Font manifest yaml format:
 //
 // flutter:
@@ -110,9 +142,9 @@ void FontCollection::RegisterFonts(
         continue;
       }
 
-      // TODO(chinmaygarde): Handle weights and styles.
       font_provider->RegisterAsset(family_name->value.GetString(),
-                                   font_asset->value.GetString());
+                                   font_asset->value.GetString(),
+                                   GetDeclaredFontStyle(family_font));
     }
   }
 
@@ -143,9 +175,101 @@ void FontCollection::RegisterTestFonts() {
   collection_->DisableFontFallback();
 }
 
+void FontCollection::SetSubsettedFontDirectory(fml::UniqueFD directory) {
+  subsetted_font_directory_ = std::move(directory);
+}
+
+static bool EqualsIgnoringCase(const std::string& a, const std::string& b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                    [](unsigned char a_char, unsigned char b_char) {
+                      return std::tolower(a_char) == std::tolower(b_char);
+                    });
+}
+
+void FontCollection::AddTextToSubsettedFonts(
+    const std::vector<std::string>& font_families,
+    const std::u16string& text) {
+  if (subsetted_fonts_.empty()) {
+    return;
+  }
+  bool replaced_typeface = false;
+  for (SubsettedFont& font : subsetted_fonts_) {
+    bool is_used = std::any_of(font_families.begin(), font_families.end(),
+                               [&font](const std::string& family) {
+                                 return EqualsIgnoringCase(family,
+                                                           font.family_name);
+                               });
+    if (!is_used || !font.subsetter->AddCodepoints(text)) {
+      continue;
+    }
+    sk_sp<SkTypeface> typeface = font.subsetter->MakeTypeface();
+    if (typeface && dynamic_font_manager_->font_provider().ReplaceTypeface(
+                        font.family_name, font.typeface.get(), typeface)) {
+      font.typeface = std::move(typeface);
+      replaced_typeface = true;
+    }
+  }
+  if (replaced_typeface) {
+    collection_->ClearFontFamilyCache();
+  }
+}
+
+std::unique_ptr<fml::Mapping> FontCollection::MapSubsettedFontData(
+    const uint8_t* data,
+    size_t size) {
+  if (subsetted_font_directory_.is_valid()) {
+    std::string file_name =
+        "flutter_subsetted_font_" +
+        std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+        std::to_string(subsetted_font_file_names_.size());
+    if (fml::WriteAtomically(subsetted_font_directory_, file_name.c_str(),
+                             fml::NonOwnedMapping(data, size))) {
+      subsetted_font_file_names_.push_back(file_name);
+      auto mapping = fml::FileMapping::CreateReadOnly(subsetted_font_directory_,
+                                                      file_name);
+      if (mapping) {
+        return mapping;
+      }
+    }
+  }
+  return std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>(data, data + size));
+}
+
+bool FontCollection::RegisterSubsettedFont(const uint8_t* font_data,
+                                           size_t size,
+                                           const std::string& family_name) {
+  auto subsetter =
+      txt::FontSubsetter::Create(MapSubsettedFontData(font_data, size));
+  if (!subsetter) {
+    return false;
+  }
+  sk_sp<SkTypeface> typeface = subsetter->MakeTypeface();
+  if (!typeface) {
+    return false;
+  }
+  std::string family = family_name;
+  if (family.empty()) {
+    SkString sk_family_name;
+    typeface->getFamilyName(&sk_family_name);
+    family.assign(sk_family_name.c_str(), sk_family_name.size());
+  }
+  if (family.empty()) {
+    return false;
+  }
+  dynamic_font_manager_->font_provider().RegisterTypeface(typeface, family);
+  subsetted_fonts_.push_back({
+      .family_name = std::move(family),
+      .subsetter = std::move(subsetter),
+      .typeface = std::move(typeface),
+  });
+  return true;
+}
+
 void FontCollection::LoadFontFromList(Dart_Handle font_data_handle,
                                       Dart_Handle callback,
-                                      const std::string& family_name) {
+                                      const std::string& family_name,
+                                      bool subset) {
   tonic::Uint8List font_data(font_data_handle);
   UIDartState::ThrowIfUIOperationsProhibited();
   FontCollection& font_collection = UIDartState::Current()
@@ -153,6 +277,17 @@ void FontCollection::LoadFontFromList(Dart_Handle font_data_handle,
                                         ->client()
                                         ->GetFontCollection();
 
+  // The glyphs of a subsetted font are added as the paragraphs that use it
+  // are built. Fonts that cannot be subset are loaded in full.
+  if (subset &&
+      font_collection.RegisterSubsettedFont(
+          font_data.data(), font_data.num_elements(), family_name)) {
+    font_collection.collection_->ClearFontFamilyCache();
+    font_data.Release();
+    tonic::DartInvoke(callback, {tonic::ToDart(0)});
+    return;
+  }
+
   std::unique_ptr<SkStreamAsset> font_stream = std::make_unique<SkMemoryStream>(
       font_data.data(), font_data.num_elements(), true);
   sk_sp<SkTypeface> typeface =
@@ -6,13 +6,17 @@
 #define FLUTTER_LIB_UI_TEXT_FONT_COLLECTION_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/unique_fd.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 #include "txt/font_collection.h"
+#include "txt/font_subsetter.h"
 
 namespace flutter {
 
@@ -30,13 +34,43 @@ class FontCollection {
 
   void RegisterTestFonts();
 
+  // Sets the directory that the fonts loaded with subsetting are written to,
+  // so that their data is mapped instead of resident. Without a directory,
+  // the data of these fonts is kept in memory.
+  void SetSubsettedFontDirectory(fml::UniqueFD directory);
+
+  // Grows the subsets of the fonts that were loaded with subsetting and that
+  // are one of |font_families| with the code points of |text|.
+  void AddTextToSubsettedFonts(const std::vector<std::string>& font_families,
+                               const std::u16string& text);
+
   static void LoadFontFromList(Dart_Handle font_data_handle,
                                Dart_Handle callback,
-                               const std::string& family_name);
+                               const std::string& family_name,
+                               bool subset);
 
  private:
+  // A font that is registered as the subset of its glyphs used so far.
+  struct SubsettedFont {
+    std::string family_name;
+    std::unique_ptr<txt::FontSubsetter> subsetter;
+    sk_sp<SkTypeface> typeface;
+  };
+
+  std::unique_ptr<fml::Mapping> MapSubsettedFontData(const uint8_t* data,
+                                                     size_t size);
+
+  // Registers the empty subset of the font in |font_data|. Returns false if
+  // the font cannot be subset.
+  bool RegisterSubsettedFont(const uint8_t* font_data,
+                             size_t size,
+                             const std::string& family_name);
+
   std::shared_ptr<txt::FontCollection> collection_;
   sk_sp<txt::DynamicFontManager> dynamic_font_manager_;
+  std::vector<SubsettedFont> subsetted_fonts_;
+  fml::UniqueFD subsetted_font_directory_;
+  std::vector<std::string> subsetted_font_file_names_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
@@ -7,7 +7,12 @@
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -58,6 +63,51 @@ void Paragraph::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+Dart_Handle Paragraph::layoutAsync(double width, Dart_Handle callback) {
+  if (!Dart_IsClosure(callback)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+  if (!m_paragraph) {
+    return tonic::ToDart("Paragraph is disposed or being laid out");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  auto persistent_callback =
+      std::make_unique<tonic::DartPersistentValue>(dart_state, callback);
+
+  // The txt paragraph is owned by the layout task until it completes, so
+  // that it is never used by two threads at once.
+  auto ui_task = fml::MakeCopyable(
+      [paragraph = fml::Ref(this),
+       callback = std::move(persistent_callback)](
+          std::unique_ptr<txt::Paragraph> txt_paragraph) mutable {
+        paragraph->m_paragraph = std::move(txt_paragraph);
+        auto dart_state = callback->dart_state().lock();
+        if (!dart_state) {
+          return;
+        }
+        tonic::DartState::Scope scope(dart_state);
+        tonic::DartInvoke(callback->Get(), {tonic::ToDart(true)});
+      });
+
+  dart_state->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [txt_paragraph = std::move(m_paragraph), width,
+       ui_task_runner = std::move(ui_task_runner),
+       ui_task = std::move(ui_task)]() mutable {
+        {
+          TRACE_EVENT0("flutter", "Paragraph::layoutAsync");
+          txt_paragraph->Layout(width);
+        }
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [txt_paragraph = std::move(txt_paragraph),
+             ui_task = std::move(ui_task)]() mutable {
+              ui_task(std::move(txt_paragraph));
+            }));
+      }));
+  return Dart_Null();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   if (!m_paragraph || !canvas) {
     // disposed.
@@ -67,6 +117,7 @@ void Paragraph::paint(Canvas* canvas, double x, double y) {
   DisplayListBuilder* builder = canvas->builder();
   if (builder) {
     m_paragraph->Paint(builder, x, y);
+    canvas->ResetSyncedPaint();
   }
 }
 
@@ -37,6 +37,10 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   bool didExceedMaxLines();
 
   void layout(double width);
+
+  // Lays out the paragraph on a worker thread, and then invokes |callback|
+  // on the UI thread. The paragraph can't be used until then.
+  Dart_Handle layoutAsync(double width, Dart_Handle callback);
   void paint(Canvas* canvas, double x, double y);
 
   tonic::Float32List getRectsForRange(unsigned start,
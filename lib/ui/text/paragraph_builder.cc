@@ -516,6 +516,12 @@ Dart_Handle ParagraphBuilder::addText(const std::u16string& text) {
     return tonic::ToDart("string is not well-formed UTF-16");
   }
 
+  UIDartState::Current()
+      ->platform_configuration()
+      ->client()
+      ->GetFontCollection()
+      .AddTextToSubsettedFonts(m_paragraphBuilder->PeekStyle().font_families,
+                               text);
   m_paragraphBuilder->AddText(text);
 
   return Dart_Null();
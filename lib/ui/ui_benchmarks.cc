@@ -10,6 +10,8 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/logging/dart_error.h"
 
 #include <future>
 
@@ -112,9 +114,81 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+static void BM_CanvasRecordShapes(benchmark::State& state) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                  ThreadHost::Type::IO | ThreadHost::Type::UI));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  const int64_t count = state.range(0);
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      // Records a picture of |count| rectangles, rounded rectangles and
+      // circles, whose draws are batched into a few native calls.
+      Dart_Handle args[] = {tonic::ToDart(count)};
+      Dart_Handle result = Dart_Invoke(
+          Dart_RootLibrary(), tonic::ToDart("recordShapes"), 1, args);
+      return !tonic::CheckAndHandleError(result);
+    });
+    FML_CHECK(successful);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_CanvasRecordPointLists(benchmark::State& state) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                  ThreadHost::Type::IO | ThreadHost::Type::UI));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+
+  const int64_t count = state.range(0);
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      // Records a picture of |count| point lists, drawn either with
+      // drawPoints or as a polygon path, which pass their points to the
+      // engine through the point buffer.
+      Dart_Handle args[] = {tonic::ToDart(count)};
+      Dart_Handle result = Dart_Invoke(
+          Dart_RootLibrary(), tonic::ToDart("recordPointLists"), 1, args);
+      return !tonic::CheckAndHandleError(result);
+    });
+    FML_CHECK(successful);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK(BM_CanvasRecordShapes)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_CanvasRecordPointLists)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -265,10 +265,10 @@ class FlutterView {
   ///   scheduling of frames.
   /// * [RendererBinding], the Flutter framework class which manages layout and
   ///   painting.
-  void render(Scene scene) => _render(scene);
+  void render(Scene scene) => _render(scene, viewId as int);
 
-  @Native<Void Function(Pointer<Void>)>(symbol: 'PlatformConfigurationNativeApi::Render')
-  external static void _render(Scene scene);
+  @Native<Void Function(Pointer<Void>, Int64)>(symbol: 'PlatformConfigurationNativeApi::Render')
+  external static void _render(Scene scene, int viewId);
 
   /// Change the retained semantics data about this [FlutterView].
   ///
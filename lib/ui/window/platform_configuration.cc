@@ -6,10 +6,13 @@
 
 #include <cstring>
 
+#include "flutter/common/constants.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_message_port_router.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/lib/ui/window/platform_message_response_dart_port.h"
+#include "flutter/lib/ui/window/shared_ring_buffer_registry.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
 #include "flutter/lib/ui/window/window.h"
 #include "third_party/tonic/converter/dart_converter.h"
@@ -26,6 +29,39 @@ Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
 
+void MappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::Mapping*>(peer);
+}
+
+// Hands the data of the message to Dart without copying it when it is large
+// enough to be external typed data anyway. External data is owned by the
+// sender, so Dart gets an unmodifiable view of it.
+Dart_Handle ToByteData(PlatformMessage& message) {
+  if (message.data().GetSize() < tonic::DartByteData::kExternalSizeThreshold) {
+    return ToByteData(message.data());
+  }
+  const bool is_external = message.hasExternalData();
+  std::unique_ptr<fml::Mapping> data = message.releaseMapping();
+  void* mapping = const_cast<uint8_t*>(data->GetMapping());
+  intptr_t size = data->GetSize();
+  if (is_external) {
+    return Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
+        /*type=*/Dart_TypedData_kByteData,
+        /*data=*/mapping,
+        /*length=*/size,
+        /*peer=*/data.release(),
+        /*external_allocation_size=*/size,
+        /*callback=*/MappingFinalizer);
+  }
+  return Dart_NewExternalTypedDataWithFinalizer(
+      /*type=*/Dart_TypedData_kByteData,
+      /*data=*/mapping,
+      /*length=*/size,
+      /*peer=*/data.release(),
+      /*external_allocation_size=*/size,
+      /*callback=*/MappingFinalizer);
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -58,6 +94,9 @@ void PlatformConfiguration::DidCreateIsolate() {
   dispatch_platform_message_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessage")));
+  dispatch_platform_messages_.Set(
+      tonic::DartState::Current(),
+      Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessages")));
   dispatch_semantics_action_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchSemanticsAction")));
@@ -67,8 +106,47 @@ void PlatformConfiguration::DidCreateIsolate() {
                   Dart_GetField(library, tonic::ToDart("_drawFrame")));
   report_timings_.Set(tonic::DartState::Current(),
                       Dart_GetField(library, tonic::ToDart("_reportTimings")));
+  remove_view_.Set(tonic::DartState::Current(),
+                   Dart_GetField(library, tonic::ToDart("_removeView")));
   windows_.insert(std::make_pair(
-      0, std::make_unique<Window>(0, ViewportMetrics{1.0, 0.0, 0.0, -1})));
+      kFlutterImplicitViewId,
+      std::make_unique<Window>(kFlutterImplicitViewId,
+                               ViewportMetrics{1.0, 0.0, 0.0, -1})));
+}
+
+bool PlatformConfiguration::AddWindow(int64_t window_id,
+                                      const ViewportMetrics& metrics) {
+  if (windows_.find(window_id) != windows_.end()) {
+    return false;
+  }
+  std::shared_ptr<tonic::DartState> dart_state =
+      remove_view_.dart_state().lock();
+  if (!dart_state) {
+    return false;
+  }
+  // The window looks up the library of the isolate.
+  tonic::DartState::Scope scope(dart_state);
+  auto window = std::make_unique<Window>(window_id, metrics);
+  // The framework creates the view when it first hears of its metrics.
+  window->UpdateWindowMetrics(metrics);
+  windows_.emplace(window_id, std::move(window));
+  return true;
+}
+
+bool PlatformConfiguration::RemoveWindow(int64_t window_id) {
+  if (window_id == kFlutterImplicitViewId ||
+      windows_.erase(window_id) == 0u) {
+    return false;
+  }
+  std::shared_ptr<tonic::DartState> dart_state =
+      remove_view_.dart_state().lock();
+  if (!dart_state) {
+    return true;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  tonic::CheckAndHandleError(
+      tonic::DartInvoke(remove_view_.Get(), {tonic::ToDart(window_id)}));
+  return true;
 }
 
 void PlatformConfiguration::UpdateLocales(
@@ -151,7 +229,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? ToByteData(*message) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -171,6 +249,57 @@ void PlatformConfiguration::DispatchPlatformMessage(
                          tonic::ToDart(response_id)}));
 }
 
+void PlatformConfiguration::DispatchPlatformMessages(
+    const std::string& channel,
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  std::shared_ptr<tonic::DartState> dart_state =
+      dispatch_platform_messages_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING)
+        << "Dropping platform messages for lack of DartState on channel: "
+        << channel;
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  Dart_Handle data_handles = Dart_NewList(messages.size());
+  if (Dart_IsError(data_handles)) {
+    FML_DLOG(WARNING)
+        << "Dropping platform messages because of a Dart error on channel: "
+        << channel;
+    return;
+  }
+
+  for (size_t i = 0; i < messages.size(); i++) {
+    Dart_Handle data_handle =
+        (messages[i]->hasData()) ? ToByteData(*messages[i]) : Dart_Null();
+    if (Dart_IsError(data_handle) ||
+        Dart_IsError(Dart_ListSetAt(data_handles, i, data_handle))) {
+      FML_DLOG(WARNING)
+          << "Dropping platform messages because of a Dart error on channel: "
+          << channel;
+      return;
+    }
+  }
+
+  // Responses are only registered once all of the messages are sure to be
+  // dispatched, so that none of them is left pending forever.
+  std::vector<int> response_ids;
+  response_ids.reserve(messages.size());
+  for (const auto& message : messages) {
+    int response_id = 0;
+    if (auto response = message->response()) {
+      response_id = next_response_id_++;
+      pending_responses_[response_id] = response;
+    }
+    response_ids.push_back(response_id);
+  }
+
+  tonic::CheckAndHandleError(
+      tonic::DartInvoke(dispatch_platform_messages_.Get(),
+                        {tonic::ToDart(channel), data_handles,
+                         tonic::ToDart(response_ids)}));
+}
+
 void PlatformConfiguration::DispatchSemanticsAction(int32_t node_id,
                                                     SemanticsAction action,
                                                     fml::MallocMapping args) {
@@ -272,9 +401,10 @@ void PlatformConfiguration::CompletePlatformMessageResponse(
   response->Complete(std::make_unique<fml::DataMapping>(std::move(data)));
 }
 
-void PlatformConfigurationNativeApi::Render(Scene* scene) {
+void PlatformConfigurationNativeApi::Render(Scene* scene, int64_t view_id) {
   UIDartState::ThrowIfUIOperationsProhibited();
-  UIDartState::Current()->platform_configuration()->client()->Render(scene);
+  UIDartState::Current()->platform_configuration()->client()->Render(view_id,
+                                                                     scene);
 }
 
 void PlatformConfigurationNativeApi::SetNeedsReportTimings(bool value) {
@@ -454,4 +584,78 @@ void PlatformConfigurationNativeApi::RegisterBackgroundIsolate(
   dart_state->SetPlatformMessageHandler(weak_platform_message_handler);
 }
 
+namespace {
+std::shared_ptr<PlatformMessagePortRouter> GetPlatformMessagePortRouter(
+    int64_t root_isolate_token) {
+  auto storage = (*static_cast<std::shared_ptr<PlatformMessageHandlerStorage>*>(
+      Dart_CurrentIsolateGroupData()));
+  FML_DCHECK(storage);
+  return storage->GetPlatformMessagePortRouter(root_isolate_token).lock();
+}
+
+std::shared_ptr<SharedRingBufferRegistry> GetSharedRingBufferRegistry(
+    int64_t root_isolate_token) {
+  auto storage = (*static_cast<std::shared_ptr<PlatformMessageHandlerStorage>*>(
+      Dart_CurrentIsolateGroupData()));
+  FML_DCHECK(storage);
+  return storage->GetSharedRingBufferRegistry(root_isolate_token).lock();
+}
+
+// Releases the reference of a view of a shared ring buffer to its memory once
+// Dart collects the view.
+void SharedRingBufferFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<std::shared_ptr<SharedRingBufferRegistry::Buffer>*>(peer);
+}
+}  // namespace
+
+void PlatformConfigurationNativeApi::SetPlatformMessagePort(
+    int64_t root_isolate_token,
+    const std::string& name,
+    int64_t port) {
+  if (auto router = GetPlatformMessagePortRouter(root_isolate_token)) {
+    router->SetChannelPort(name, port);
+  }
+}
+
+void PlatformConfigurationNativeApi::RespondToPortPlatformMessage(
+    int64_t root_isolate_token,
+    int64_t response_id,
+    const tonic::DartByteData& data) {
+  auto router = GetPlatformMessagePortRouter(root_isolate_token);
+  if (!router) {
+    return;
+  }
+  if (Dart_IsNull(data.dart_handle())) {
+    router->CompleteResponse(response_id, nullptr);
+  } else {
+    router->CompleteResponse(
+        response_id, std::make_unique<fml::MallocMapping>(
+                         fml::MallocMapping::Copy(data.data(),
+                                                  data.length_in_bytes())));
+  }
+}
+
+Dart_Handle PlatformConfigurationNativeApi::OpenSharedRingBuffer(
+    int64_t root_isolate_token,
+    const std::string& name,
+    int64_t port) {
+  auto registry = GetSharedRingBufferRegistry(root_isolate_token);
+  if (!registry) {
+    return Dart_Null();
+  }
+  auto buffer = registry->Open(name, port);
+  if (!buffer) {
+    return Dart_Null();
+  }
+  // The view is not accounted as external allocation since the memory is
+  // owned by the embedder.
+  return Dart_NewExternalTypedDataWithFinalizer(
+      /*type=*/Dart_TypedData_kByteData,
+      /*data=*/buffer->GetData(),
+      /*length=*/buffer->GetSize(),
+      /*peer=*/new std::shared_ptr<SharedRingBufferRegistry::Buffer>(buffer),
+      /*external_allocation_size=*/0,
+      /*callback=*/SharedRingBufferFinalizer);
+}
+
 }  // namespace flutter
@@ -24,6 +24,8 @@ namespace flutter {
 class FontCollection;
 class PlatformMessage;
 class PlatformMessageHandler;
+class PlatformMessagePortRouter;
+class SharedRingBufferRegistry;
 class Scene;
 
 //--------------------------------------------------------------------------
@@ -65,10 +67,13 @@ class PlatformConfigurationClient {
   virtual void ScheduleFrame() = 0;
 
   //--------------------------------------------------------------------------
-  /// @brief      Updates the client's rendering on the GPU with the newly
-  ///             provided Scene.
+  /// @brief      Updates the client's rendering of a view on the GPU with the
+  ///             newly provided Scene.
   ///
-  virtual void Render(Scene* scene) = 0;
+  /// @param[in]  view_id  The view the scene was built for.
+  /// @param[in]  scene    The scene to render.
+  ///
+  virtual void Render(int64_t view_id, Scene* scene) = 0;
 
   //--------------------------------------------------------------------------
   /// @brief      Receives a updated semantics tree from the Framework.
@@ -319,6 +324,20 @@ class PlatformConfiguration final {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the PlatformConfiguration that the client has sent
+  ///             it a batch of messages on one channel. The messages are
+  ///             handed to the framework in order with a single call into
+  ///             Dart.
+  ///
+  /// @param[in]  channel   The channel all of the messages were sent on.
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application.
+  ///
+  void DispatchPlatformMessages(
+      const std::string& channel,
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the framework that the embedder encountered an
   ///             accessibility related action on the specified node. This call
@@ -395,9 +414,35 @@ class PlatformConfiguration final {
   ///
   /// @param[in] window_id The id of the window to find and return.
   ///
-  /// @return     a pointer to the Window.
+  /// @return     a pointer to the Window, or nullptr if there is no window
+  ///             with the ID.
+  ///
+  Window* get_window(int64_t window_id) {
+    auto found = windows_.find(window_id);
+    return found == windows_.end() ? nullptr : found->second.get();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a window for a view besides the implicit one and
+  ///             notifies the framework of its metrics, which creates the
+  ///             `FlutterView` for it.
+  ///
+  /// @param[in]  window_id  The ID of the view. It must not be in use.
+  /// @param[in]  metrics    The metrics of the view.
+  ///
+  /// @return     Whether the window was added.
   ///
-  Window* get_window(int window_id) { return windows_[window_id].get(); }
+  bool AddWindow(int64_t window_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a window added by |AddWindow| and notifies the
+  ///             framework that its `FlutterView` is gone.
+  ///
+  /// @param[in]  window_id  The ID of the view.
+  ///
+  /// @return     Whether there was a window to remove.
+  ///
+  bool RemoveWindow(int64_t window_id);
 
   //----------------------------------------------------------------------------
   /// @brief      Responds to a previous platform message to the engine from the
@@ -430,10 +475,12 @@ class PlatformConfiguration final {
   tonic::DartPersistentValue update_semantics_enabled_;
   tonic::DartPersistentValue update_accessibility_features_;
   tonic::DartPersistentValue dispatch_platform_message_;
+  tonic::DartPersistentValue dispatch_platform_messages_;
   tonic::DartPersistentValue dispatch_semantics_action_;
   tonic::DartPersistentValue begin_frame_;
   tonic::DartPersistentValue draw_frame_;
   tonic::DartPersistentValue report_timings_;
+  tonic::DartPersistentValue remove_view_;
 
   std::unordered_map<int64_t, std::unique_ptr<Window>> windows_;
 
@@ -455,6 +502,20 @@ class PlatformMessageHandlerStorage {
 
   virtual std::weak_ptr<PlatformMessageHandler> GetPlatformMessageHandler(
       int64_t root_isolate_token) const = 0;
+
+  virtual void SetPlatformMessagePortRouter(
+      int64_t root_isolate_token,
+      std::weak_ptr<PlatformMessagePortRouter> router) = 0;
+
+  virtual std::weak_ptr<PlatformMessagePortRouter> GetPlatformMessagePortRouter(
+      int64_t root_isolate_token) const = 0;
+
+  virtual void SetSharedRingBufferRegistry(
+      int64_t root_isolate_token,
+      std::weak_ptr<SharedRingBufferRegistry> registry) = 0;
+
+  virtual std::weak_ptr<SharedRingBufferRegistry> GetSharedRingBufferRegistry(
+      int64_t root_isolate_token) const = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -473,7 +534,7 @@ class PlatformConfigurationNativeApi {
 
   static void ScheduleFrame();
 
-  static void Render(Scene* scene);
+  static void Render(Scene* scene, int64_t view_id);
 
   static void UpdateSemantics(SemanticsUpdate* update);
 
@@ -525,6 +586,18 @@ class PlatformConfigurationNativeApi {
 
   static void RegisterBackgroundIsolate(int64_t root_isolate_token);
 
+  static void SetPlatformMessagePort(int64_t root_isolate_token,
+                                     const std::string& name,
+                                     int64_t port);
+
+  static void RespondToPortPlatformMessage(int64_t root_isolate_token,
+                                           int64_t response_id,
+                                           const tonic::DartByteData& data);
+
+  static Dart_Handle OpenSharedRingBuffer(int64_t root_isolate_token,
+                                          const std::string& name,
+                                          int64_t port);
+
  private:
   static Dart_PerformanceMode current_performace_mode_;
 };
@@ -22,6 +22,39 @@ PlatformMessage::PlatformMessage(std::string channel,
       hasData_(false),
       response_(std::move(response)) {}
 
+PlatformMessage::PlatformMessage(std::string channel,
+                                 std::unique_ptr<fml::Mapping> external_data,
+                                 fml::RefPtr<PlatformMessageResponse> response)
+    : channel_(std::move(channel)),
+      data_(),
+      external_data_(std::move(external_data)),
+      hasData_(external_data_ != nullptr),
+      response_(std::move(response)) {}
+
 PlatformMessage::~PlatformMessage() = default;
 
+const fml::Mapping& PlatformMessage::data() const {
+  if (external_data_) {
+    return *external_data_;
+  }
+  return data_;
+}
+
+fml::MallocMapping PlatformMessage::releaseData() {
+  if (external_data_) {
+    auto data = fml::MallocMapping::Copy(external_data_->GetMapping(),
+                                         external_data_->GetSize());
+    external_data_.reset();
+    return data;
+  }
+  return std::move(data_);
+}
+
+std::unique_ptr<fml::Mapping> PlatformMessage::releaseMapping() {
+  if (external_data_) {
+    return std::move(external_data_);
+  }
+  return std::make_unique<fml::MallocMapping>(std::move(data_));
+}
+
 }  // namespace flutter
@@ -5,9 +5,11 @@
 #ifndef FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_H_
 #define FLUTTER_LIB_UI_PLATFORM_PLATFORM_MESSAGE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
@@ -21,21 +23,37 @@ class PlatformMessage {
                   fml::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string channel,
                   fml::RefPtr<PlatformMessageResponse> response);
+  // Creates a message whose data is owned by the sender and is handed to the
+  // receiver without being copied. The mapping is released once the message
+  // and everything that refers to its data is collected, see
+  // |hasExternalData|.
+  PlatformMessage(std::string channel,
+                  std::unique_ptr<fml::Mapping> external_data,
+                  fml::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
   const std::string& channel() const { return channel_; }
-  const fml::MallocMapping& data() const { return data_; }
+  const fml::Mapping& data() const;
   bool hasData() { return hasData_; }
 
+  // Whether the data of the message was not copied from the sender. The data
+  // of such a message must not be written to.
+  bool hasExternalData() const { return external_data_ != nullptr; }
+
   const fml::RefPtr<PlatformMessageResponse>& response() const {
     return response_;
   }
 
-  fml::MallocMapping releaseData() { return std::move(data_); }
+  // Copies the data if it is external.
+  fml::MallocMapping releaseData();
+
+  // Returns the data without copying it, whether or not it is external.
+  std::unique_ptr<fml::Mapping> releaseMapping();
 
  private:
   std::string channel_;
   fml::MallocMapping data_;
+  std::unique_ptr<fml::Mapping> external_data_;
   bool hasData_;
   fml::RefPtr<PlatformMessageResponse> response_;
 };
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_port_router.h"
+
+#include <array>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+#include "third_party/dart/runtime/include/dart_native_api.h"
+
+namespace flutter {
+
+namespace {
+
+// Collects the message once Dart collects the external typed data that wraps
+// its data.
+void MessageFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<PlatformMessage*>(peer);
+}
+
+}  // namespace
+
+PlatformMessagePortRouter::PlatformMessagePortRouter() = default;
+
+PlatformMessagePortRouter::~PlatformMessagePortRouter() = default;
+
+void PlatformMessagePortRouter::SetChannelPort(const std::string& channel,
+                                               Dart_Port port) {
+  std::scoped_lock lock(mutex_);
+  if (port == ILLEGAL_PORT) {
+    channel_ports_.erase(channel);
+  } else {
+    channel_ports_[channel] = port;
+  }
+}
+
+std::unique_ptr<PlatformMessage> PlatformMessagePortRouter::RouteMessage(
+    std::unique_ptr<PlatformMessage> message) {
+  // Holding the lock while posting keeps the messages on a channel in order
+  // when they are routed from several threads.
+  std::scoped_lock lock(mutex_);
+  auto found = channel_ports_.find(message->channel());
+  if (found == channel_ports_.end()) {
+    return message;
+  }
+  TRACE_EVENT1("flutter", "PlatformMessagePortRouter::RouteMessage", "channel",
+               message->channel().c_str());
+
+  int64_t response_id = 0;
+  if (auto response = message->response()) {
+    response_id = next_response_id_++;
+    pending_responses_[response_id] = response;
+  }
+
+  Dart_CObject message_response_id = {
+      .type = Dart_CObject_kInt64,
+  };
+  message_response_id.value.as_int64 = response_id;
+  Dart_CObject message_data = {
+      .type = Dart_CObject_kNull,
+  };
+  const bool has_data = message->hasData() && message->data().GetSize() > 0;
+  if (has_data) {
+    // Data that the message doesn't own must not be written to.
+    message_data.type = message->hasExternalData()
+                            ? Dart_CObject_kUnmodifiableExternalTypedData
+                            : Dart_CObject_kExternalTypedData;
+    message_data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    message_data.value.as_external_typed_data.length =
+        message->data().GetSize();
+    message_data.value.as_external_typed_data.data =
+        const_cast<uint8_t*>(message->data().GetMapping());
+    message_data.value.as_external_typed_data.peer = message.get();
+    message_data.value.as_external_typed_data.callback = MessageFinalizer;
+  }
+
+  std::array<Dart_CObject*, 2> message_values = {&message_response_id,
+                                                 &message_data};
+  Dart_CObject routed_message = {
+      .type = Dart_CObject_kArray,
+  };
+  routed_message.value.as_array.length = message_values.size();
+  routed_message.value.as_array.values = message_values.data();
+
+  if (!Dart_PostCObject(found->second, &routed_message)) {
+    // The isolate that set the port is gone.
+    channel_ports_.erase(found);
+    pending_responses_.erase(response_id);
+    return message;
+  }
+
+  // The message is now collected by the finalizer of its data.
+  if (has_data) {
+    [[maybe_unused]] auto released_message = message.release();
+  }
+  return nullptr;
+}
+
+void PlatformMessagePortRouter::CompleteResponse(
+    int64_t response_id,
+    std::unique_ptr<fml::Mapping> data) {
+  fml::RefPtr<PlatformMessageResponse> response;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = pending_responses_.find(response_id);
+    if (found == pending_responses_.end()) {
+      return;
+    }
+    response = std::move(found->second);
+    pending_responses_.erase(found);
+  }
+  if (data) {
+    response->Complete(std::move(data));
+  } else {
+    response->CompleteEmpty();
+  }
+}
+
+}  // namespace flutter
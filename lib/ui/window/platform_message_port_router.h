@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_PORT_ROUTER_H_
+#define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_PORT_ROUTER_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/lib/ui/window/platform_message.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Routes the platform messages sent by the host platform on some channels to
+/// the Dart ports that background isolates set for them, instead of
+/// dispatching them to the root isolate on the UI thread.
+///
+/// A routed message is posted to its port as a list of its response ID and its
+/// data. The data is posted as external typed data, so it is not copied, and
+/// is null if the message has none. A response ID of zero means that the
+/// sender expects no response. The isolate that receives the message responds
+/// to it with `CompleteResponse`.
+///
+/// Messages on a channel are posted to its port in the order they are routed.
+/// Messages that were dispatched to the root isolate before the port was set
+/// may still be delivered there.
+///
+/// All methods are callable on any thread.
+///
+class PlatformMessagePortRouter {
+ public:
+  PlatformMessagePortRouter();
+
+  ~PlatformMessagePortRouter();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Routes the messages on the channel to the port, or stops
+  ///             routing them if the port is `ILLEGAL_PORT`.
+  ///
+  void SetChannelPort(const std::string& channel, Dart_Port port);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts the message to the port set for its channel.
+  ///
+  /// @return     The message if no port is set for its channel, or if the port
+  ///             was closed, in which case it is not used for the channel
+  ///             anymore. Otherwise, nullptr.
+  ///
+  std::unique_ptr<PlatformMessage> RouteMessage(
+      std::unique_ptr<PlatformMessage> message);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Completes the response of a routed message. Does nothing if
+  ///             there is no pending response with the ID.
+  ///
+  /// @param[in]  response_id  The response ID posted with the message.
+  /// @param[in]  data         The data of the response, or nullptr for an
+  ///                          empty response.
+  ///
+  void CompleteResponse(int64_t response_id,
+                        std::unique_ptr<fml::Mapping> data);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, Dart_Port> channel_ports_;
+  // ID starts at 1 because an ID of 0 indicates that no response is expected.
+  int64_t next_response_id_ = 1;
+  std::unordered_map<int64_t, fml::RefPtr<PlatformMessageResponse>>
+      pending_responses_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformMessagePortRouter);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_PORT_ROUTER_H_
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/platform_message_port_router.h"
+
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+class TestResponse : public PlatformMessageResponse {
+ public:
+  explicit TestResponse(fml::CountDownLatch& latch) : latch_(latch) {}
+
+  void Complete(std::unique_ptr<fml::Mapping> data) override {
+    data_ = std::string(reinterpret_cast<const char*>(data->GetMapping()),
+                        data->GetSize());
+    latch_.CountDown();
+  }
+
+  void CompleteEmpty() override { latch_.CountDown(); }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  fml::CountDownLatch& latch_;
+  std::string data_;
+};
+}  // namespace
+
+TEST_F(ShellTest, PlatformMessagePortRouterRoutesMessagesToPorts) {
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  fml::AutoResetWaitableEvent port_set_latch;
+  auto native_notify_port_set = [&port_set_latch](Dart_NativeArguments args) {
+    port_set_latch.Signal();
+  };
+  AddNativeCallback("NotifyPlatformMessagePortSet",
+                    CREATE_NATIVE_ENTRY(native_notify_port_set));
+
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("platformMessagePortRouterTest");
+  shell->RunEngine(std::move(configuration), [](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+  port_set_latch.Wait();
+
+  // The fixture replies with the data of each message, prefixed with the
+  // number of messages it received on the port before it.
+  fml::CountDownLatch response_latch(2);
+  auto first_response = fml::MakeRefCounted<TestResponse>(response_latch);
+  auto second_response = fml::MakeRefCounted<TestResponse>(response_latch);
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners.GetPlatformTaskRunner(), [&]() {
+        const std::string first = "first";
+        const std::string second = "second";
+        shell->GetPlatformView()->DispatchPlatformMessage(
+            std::make_unique<PlatformMessage>(
+                "test/port_channel",
+                fml::MallocMapping::Copy(first.data(), first.size()),
+                first_response));
+        shell->GetPlatformView()->DispatchPlatformMessage(
+            std::make_unique<PlatformMessage>(
+                "test/port_channel",
+                fml::MallocMapping::Copy(second.data(), second.size()),
+                second_response));
+      });
+  response_latch.Wait();
+
+  EXPECT_EQ(first_response->data(), "0:first");
+  EXPECT_EQ(second_response->data(), "1:second");
+  DestroyShell(std::move(shell), task_runners);
+}
+
+}  // namespace testing
+}  // namespace flutter
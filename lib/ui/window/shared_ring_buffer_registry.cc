@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/shared_ring_buffer_registry.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "third_party/dart/runtime/include/dart_native_api.h"
+
+namespace flutter {
+
+SharedRingBufferRegistry::Buffer::Buffer(uint8_t* data,
+                                         size_t size,
+                                         fml::closure release_callback)
+    : data_(data),
+      size_(size),
+      release_callback_(std::move(release_callback)) {}
+
+SharedRingBufferRegistry::Buffer::~Buffer() {
+  if (release_callback_) {
+    release_callback_();
+  }
+}
+
+SharedRingBufferRegistry::SharedRingBufferRegistry() = default;
+
+SharedRingBufferRegistry::~SharedRingBufferRegistry() = default;
+
+bool SharedRingBufferRegistry::Register(const std::string& name,
+                                        uint8_t* data,
+                                        size_t size,
+                                        fml::closure release_callback) {
+  if (data == nullptr || reinterpret_cast<uintptr_t>(data) % 8 != 0 ||
+      size <= kHeaderSize) {
+    FML_LOG(ERROR) << "Invalid memory for the shared ring buffer: " << name;
+    return false;
+  }
+  std::scoped_lock lock(mutex_);
+  if (registrations_.count(name) != 0) {
+    FML_LOG(ERROR) << "A shared ring buffer is already registered as: "
+                   << name;
+    return false;
+  }
+  registrations_[name].buffer =
+      std::make_shared<Buffer>(data, size, std::move(release_callback));
+  return true;
+}
+
+bool SharedRingBufferRegistry::Unregister(const std::string& name) {
+  // The buffer may be released here, so it is dropped outside of the lock.
+  std::shared_ptr<Buffer> buffer;
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = registrations_.find(name);
+    if (found == registrations_.end()) {
+      return false;
+    }
+    buffer = std::move(found->second.buffer);
+    registrations_.erase(found);
+  }
+  return true;
+}
+
+std::shared_ptr<SharedRingBufferRegistry::Buffer>
+SharedRingBufferRegistry::Open(const std::string& name, Dart_Port port) {
+  std::scoped_lock lock(mutex_);
+  auto found = registrations_.find(name);
+  if (found == registrations_.end()) {
+    return nullptr;
+  }
+  found->second.port = port;
+  return found->second.buffer;
+}
+
+bool SharedRingBufferRegistry::Notify(const std::string& name,
+                                      int64_t value) {
+  std::scoped_lock lock(mutex_);
+  auto found = registrations_.find(name);
+  if (found == registrations_.end() || found->second.port == ILLEGAL_PORT) {
+    return false;
+  }
+  if (!Dart_PostInteger(found->second.port, value)) {
+    // The port was closed.
+    found->second.port = ILLEGAL_PORT;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_SHARED_RING_BUFFER_REGISTRY_H_
+#define FLUTTER_LIB_UI_WINDOW_SHARED_RING_BUFFER_REGISTRY_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The ring buffers in memory that the embedder shares with Dart, by name.
+///
+/// A ring buffer is a region of memory owned by the embedder. It starts with a
+/// header of two 64-bit indices in the native byte order, followed by the
+/// bytes of the ring:
+///
+///   - The producer index, at offset 0, counts the bytes written to the ring.
+///   - The consumer index, at offset 8, counts the bytes read from the ring.
+///
+/// Both indices only grow, and the byte at index `i` is stored at offset
+/// `kHeaderSize + i % capacity`. Which of the embedder and Dart produces and
+/// which consumes is up to them; the engine never reads or writes the region.
+///
+/// Dart sees the region as external typed data, so no byte is copied. The
+/// producer signals new bytes with `Notify`, which posts an integer to the
+/// notification port of the ring buffer instead of sending a platform message.
+///
+/// All methods are callable on any thread.
+///
+class SharedRingBufferRegistry {
+ public:
+  /// The size of the header of the producer and consumer indices.
+  static constexpr size_t kHeaderSize = 16;
+
+  //----------------------------------------------------------------------------
+  /// The memory of a registered ring buffer. The release callback is invoked
+  /// once the buffer is unregistered and Dart collected all of its views.
+  ///
+  class Buffer {
+   public:
+    Buffer(uint8_t* data, size_t size, fml::closure release_callback);
+
+    ~Buffer();
+
+    uint8_t* GetData() const { return data_; }
+
+    size_t GetSize() const { return size_; }
+
+   private:
+    uint8_t* const data_;
+    const size_t size_;
+    const fml::closure release_callback_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  SharedRingBufferRegistry();
+
+  ~SharedRingBufferRegistry();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the region of memory as the ring buffer with the
+  ///             name.
+  ///
+  /// @param[in]  name              The name Dart opens the ring buffer with.
+  /// @param[in]  data              The region, aligned to 8 bytes.
+  /// @param[in]  size              The size of the region, header included.
+  /// @param[in]  release_callback  Invoked once the engine and Dart don't use
+  ///                               the region anymore.
+  ///
+  /// @return     Whether the ring buffer was registered. It is not if the name
+  ///             is already used, or if the region is misaligned or too small
+  ///             for the header and one byte. The release callback is not
+  ///             invoked then.
+  ///
+  bool Register(const std::string& name,
+                uint8_t* data,
+                size_t size,
+                fml::closure release_callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unregisters the ring buffer with the name. The views that
+  ///             Dart already opened stay valid until they are collected.
+  ///
+  /// @return     Whether a ring buffer with the name was registered.
+  ///
+  bool Unregister(const std::string& name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the ring buffer with the name and sets the port that is
+  ///             notified of it, or stops notifying it if the port is
+  ///             `ILLEGAL_PORT`.
+  ///
+  /// @return     The ring buffer, or nullptr if none is registered with the
+  ///             name.
+  ///
+  std::shared_ptr<Buffer> Open(const std::string& name, Dart_Port port);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Posts the value, usually the new producer or consumer index,
+  ///             to the notification port of the ring buffer with the name.
+  ///
+  /// @return     Whether the value was posted.
+  ///
+  bool Notify(const std::string& name, int64_t value);
+
+ private:
+  struct Registration {
+    std::shared_ptr<Buffer> buffer;
+    Dart_Port port = ILLEGAL_PORT;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Registration> registrations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedRingBufferRegistry);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_SHARED_RING_BUFFER_REGISTRY_H_
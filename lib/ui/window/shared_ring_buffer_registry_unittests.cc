@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/shared_ring_buffer_registry.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(SharedRingBufferRegistryTest, RejectsInvalidMemory) {
+  SharedRingBufferRegistry registry;
+  alignas(8) uint8_t memory[32] = {};
+  int releases = 0;
+  auto release = [&releases]() { releases++; };
+
+  EXPECT_FALSE(registry.Register("ring", nullptr, sizeof(memory), release));
+  EXPECT_FALSE(registry.Register("ring", memory + 1, 24, release));
+  EXPECT_FALSE(registry.Register("ring", memory,
+                                 SharedRingBufferRegistry::kHeaderSize,
+                                 release));
+  EXPECT_EQ(releases, 0);
+
+  EXPECT_TRUE(registry.Register("ring", memory, sizeof(memory), release));
+  EXPECT_FALSE(registry.Register("ring", memory, sizeof(memory), release));
+  EXPECT_TRUE(registry.Unregister("ring"));
+  EXPECT_FALSE(registry.Unregister("ring"));
+  EXPECT_EQ(releases, 1);
+}
+
+TEST(SharedRingBufferRegistryTest, ReleasesMemoryOnceNotOpenedAnymore) {
+  SharedRingBufferRegistry registry;
+  alignas(8) uint8_t memory[32] = {};
+  int releases = 0;
+  ASSERT_TRUE(registry.Register("ring", memory, sizeof(memory),
+                                [&releases]() { releases++; }));
+
+  auto buffer = registry.Open("ring", ILLEGAL_PORT);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(buffer->GetData(), memory);
+  EXPECT_EQ(buffer->GetSize(), sizeof(memory));
+  EXPECT_EQ(registry.Open("other", ILLEGAL_PORT), nullptr);
+
+  // There is no port to notify.
+  EXPECT_FALSE(registry.Notify("ring", 1));
+
+  EXPECT_TRUE(registry.Unregister("ring"));
+  EXPECT_EQ(releases, 0);
+  EXPECT_EQ(registry.Open("ring", ILLEGAL_PORT), nullptr);
+  buffer.reset();
+  EXPECT_EQ(releases, 1);
+}
+
+TEST(SharedRingBufferRegistryTest, ReleasesMemoryOnDestruction) {
+  alignas(8) uint8_t memory[32] = {};
+  int releases = 0;
+  {
+    SharedRingBufferRegistry registry;
+    ASSERT_TRUE(registry.Register("ring", memory, sizeof(memory),
+                                  [&releases]() { releases++; }));
+  }
+  EXPECT_EQ(releases, 1);
+}
+
+}  // namespace testing
+}  // namespace flutter
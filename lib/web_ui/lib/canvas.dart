@@ -49,6 +49,11 @@ abstract class Vertices {
       indices: indices);
   }
 
+  void updateRaw({
+    Float32List? positions,
+    Int32List? colors,
+    Float32List? textureCoordinates,
+  });
   void dispose();
   bool get debugDisposed;
 }
@@ -137,6 +142,23 @@ abstract class Picture {
   int get approximateBytesUsed;
 }
 
+class TransferablePicture {
+  // The web has no isolates that could share pictures, so the picture itself
+  // is kept until it is materialized.
+  TransferablePicture(Picture picture) : _picture = picture;
+
+  Picture? _picture;
+
+  Picture materialize() {
+    final Picture? picture = _picture;
+    if (picture == null) {
+      throw StateError('This TransferablePicture was already materialized.');
+    }
+    _picture = null;
+    return picture;
+  }
+}
+
 enum PathFillType {
   nonZero,
   evenOdd,
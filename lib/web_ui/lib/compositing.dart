@@ -44,6 +44,7 @@ abstract class SceneBuilder {
   TransformEngineLayer pushTransform(
     Float64List matrix4, {
     TransformEngineLayer? oldLayer,
+    Offset? pointerDeltaScale,
   });
   ClipRectEngineLayer pushClipRect(
     Rect rect, {
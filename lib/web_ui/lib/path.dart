@@ -52,6 +52,13 @@ abstract class Path {
   Rect getBounds();
   static Path combine(PathOperation operation, Path path1, Path path2) =>
     engine.renderer.combinePaths(operation, path1, path2);
+  // The web has no background threads to combine paths on.
+  static Future<Path> combineAsync(PathOperation operation, Path path1, Path path2) =>
+    Future<Path>.value(combine(operation, path1, path2));
+  static Path unionAll(List<Path> paths) => paths.fold(
+    Path(), (Path union, Path path) => combine(PathOperation.union, union, path));
+  static Future<Path> unionAllAsync(List<Path> paths) =>
+    Future<Path>.value(unionAll(paths));
 
   PathMetrics computeMetrics({bool forceClosed = false});
 }
@@ -22,6 +22,7 @@ abstract class PathMetric {
   int get contourIndex;
   Tangent? getTangentForOffset(double distance);
   Path extractPath(double start, double end, {bool startWithMoveTo = true});
+  Path extractPathSegments(Float32List intervals, {bool startWithMoveTo = true});
   bool get isClosed;
 }
 
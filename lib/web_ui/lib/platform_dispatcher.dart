@@ -24,6 +24,15 @@ class RootIsolateToken {
   }
 }
 
+abstract class SharedRingBuffer {
+  ByteData get bytes;
+  int get capacity;
+  int get producerIndex;
+  set producerIndex(int value);
+  int get consumerIndex;
+  set consumerIndex(int value);
+}
+
 abstract class PlatformDispatcher {
   static PlatformDispatcher get instance => engine.EnginePlatformDispatcher.instance;
 
@@ -65,6 +74,12 @@ abstract class PlatformDispatcher {
 
   void registerBackgroundIsolate(RootIsolateToken token);
 
+  void setPlatformMessagePort(RootIsolateToken token, String name, Object? port);
+
+  void respondToPortPlatformMessage(RootIsolateToken token, int responseId, ByteData? data);
+
+  SharedRingBuffer? openSharedRingBuffer(RootIsolateToken token, String name, Object? notificationPort);
+
   PlatformMessageCallback? get onPlatformMessage;
   set onPlatformMessage(PlatformMessageCallback? callback);
 
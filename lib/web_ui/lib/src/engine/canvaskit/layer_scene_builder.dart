@@ -211,6 +211,7 @@ class LayerSceneBuilder implements ui.SceneBuilder {
   TransformEngineLayer pushTransform(
     Float64List matrix4, {
     ui.EngineLayer? oldLayer,
+    ui.Offset? pointerDeltaScale,
   }) {
     final Matrix4 matrix = Matrix4.fromFloat32List(toMatrix32(matrix4));
     return pushLayer<TransformEngineLayer>(TransformEngineLayer(matrix));
@@ -116,6 +116,27 @@ class CkContourMeasure extends ManagedSkiaObject<SkContourMeasure>
     return CkPath.fromSkPath(skPath, _metrics._path.fillType);
   }
 
+  @override
+  ui.Path extractPathSegments(Float32List intervals,
+      {bool startWithMoveTo = true}) {
+    if (intervals.length.isOdd) {
+      throw ArgumentError(
+          '"intervals" must have an even number of entries (each segment is a '
+          'start, end pair).');
+    }
+    final ui.Path path = ui.Path();
+    for (int i = 0; i < intervals.length; i += 2) {
+      final ui.Path segment = extractPath(intervals[i], intervals[i + 1],
+          startWithMoveTo: i > 0 || startWithMoveTo);
+      if (i == 0 && !startWithMoveTo) {
+        path.extendWithPath(segment, ui.Offset.zero);
+      } else {
+        path.addPath(segment, ui.Offset.zero);
+      }
+    }
+    return path;
+  }
+
   @override
   ui.Tangent getTangentForOffset(double distance) {
     final Float32List posTan = skiaObject.getPosTan(distance);
@@ -799,6 +799,13 @@ class CkParagraph extends SkiaObject<SkParagraph> implements ui.Paragraph {
     markUsed();
   }
 
+  @override
+  Future<void> layoutAsync(ui.ParagraphConstraints constraints) {
+    // There are no background threads to lay out the paragraph on.
+    layout(constraints);
+    return Future<void>.value();
+  }
+
   @override
   ui.TextRange getLineBoundary(ui.TextPosition position) {
     final SkParagraph paragraph = _ensureInitialized(_lastLayoutConstraints!);
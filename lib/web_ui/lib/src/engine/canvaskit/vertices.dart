@@ -80,11 +80,34 @@ class CkVertices extends ManagedSkiaObject<SkVertices> implements ui.Vertices {
   );
 
   final SkVertexMode _mode;
-  final Float32List _positions;
-  final Float32List? _textureCoordinates;
-  final Uint32List? _colors;
+  Float32List _positions;
+  Float32List? _textureCoordinates;
+  Uint32List? _colors;
   final Uint16List? _indices;
 
+  @override
+  void updateRaw({
+    Float32List? positions,
+    Int32List? colors,
+    Float32List? textureCoordinates,
+  }) {
+    if ((positions != null && positions.length != _positions.length) ||
+        (colors != null && colors.length != _colors?.length) ||
+        (textureCoordinates != null &&
+            textureCoordinates.length != _textureCoordinates?.length)) {
+      throw ArgumentError(
+          '"positions", "colors" and "textureCoordinates" must match the '
+          'lists these vertices were created with.');
+    }
+    _positions = positions ?? _positions;
+    _colors = colors?.buffer.asUint32List() ?? _colors;
+    _textureCoordinates = textureCoordinates ?? _textureCoordinates;
+    // SkVertices are immutable, and pictures that already hold the current
+    // one keep a reference to it.
+    delete();
+    rawSkiaObject = createDefault();
+  }
+
   @override
   SkVertices createDefault() {
     return canvasKit.MakeVertices(
@@ -601,6 +601,27 @@ class SurfacePathMetric implements ui.PathMetric {
         startWithMoveTo: startWithMoveTo);
   }
 
+  @override
+  ui.Path extractPathSegments(Float32List intervals,
+      {bool startWithMoveTo = true}) {
+    if (intervals.length.isOdd) {
+      throw ArgumentError(
+          '"intervals" must have an even number of entries (each segment is a '
+          'start, end pair).');
+    }
+    final ui.Path path = ui.Path();
+    for (int i = 0; i < intervals.length; i += 2) {
+      final ui.Path segment = extractPath(intervals[i], intervals[i + 1],
+          startWithMoveTo: i > 0 || startWithMoveTo);
+      if (i == 0 && !startWithMoveTo) {
+        path.extendWithPath(segment, ui.Offset.zero);
+      } else {
+        path.addPath(segment, ui.Offset.zero);
+      }
+    }
+    return path;
+  }
+
   @override
   String toString() => 'PathMetric';
 }
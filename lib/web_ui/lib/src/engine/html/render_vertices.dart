@@ -42,10 +42,32 @@ class SurfaceVertices implements ui.Vertices {
   }
 
   final ui.VertexMode mode;
-  final Float32List positions;
-  final Int32List? colors;
+  Float32List positions;
+  Int32List? colors;
   final Uint16List? indices;
 
+  @override
+  void updateRaw({
+    Float32List? positions,
+    Int32List? colors,
+    Float32List? textureCoordinates,
+  }) {
+    if ((positions != null && positions.length != this.positions.length) ||
+        (colors != null && colors.length != this.colors?.length)) {
+      throw ArgumentError(
+          '"positions" and "colors" must match the lists these vertices were '
+          'created with.');
+    }
+    // The lists are replaced rather than written to, so that the pictures
+    // that already hold a snapshot of these vertices are not affected.
+    this.positions = positions ?? this.positions;
+    this.colors = colors ?? this.colors;
+  }
+
+  /// A copy of these vertices that is not affected by [updateRaw].
+  SurfaceVertices snapshot() =>
+      SurfaceVertices.raw(mode, positions, colors: colors, indices: indices);
+
   static Int32List _int32ListFromColors(List<ui.Color> colors) {
     final Int32List list = Int32List(colors.length);
     final int len = colors.length;
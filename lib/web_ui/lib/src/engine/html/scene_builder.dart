@@ -101,6 +101,7 @@ class SurfaceSceneBuilder implements ui.SceneBuilder {
   ui.TransformEngineLayer pushTransform(
     Float64List matrix4, {
     ui.TransformEngineLayer? oldLayer,
+    ui.Offset? pointerDeltaScale,
   }) {
     if (matrix4.length != 16) {
       throw ArgumentError('"matrix4" must have 16 entries.');
@@ -358,6 +358,33 @@ class EnginePlatformDispatcher extends ui.PlatformDispatcher {
     throw Exception("Isolates aren't supported in web.");
   }
 
+  @override
+  void setPlatformMessagePort(
+    ui.RootIsolateToken token,
+    String name,
+    Object? port,
+  ) {
+    throw Exception("Isolates aren't supported in web.");
+  }
+
+  @override
+  void respondToPortPlatformMessage(
+    ui.RootIsolateToken token,
+    int responseId,
+    ByteData? data,
+  ) {
+    throw Exception("Isolates aren't supported in web.");
+  }
+
+  @override
+  ui.SharedRingBuffer? openSharedRingBuffer(
+    ui.RootIsolateToken token,
+    String name,
+    Object? notificationPort,
+  ) {
+    throw Exception("Isolates aren't supported in web.");
+  }
+
   // TODO(ianh): Deprecate onPlatformMessage once the framework is moved over
   // to using channel buffers exclusively.
   @override
@@ -656,6 +656,7 @@ abstract class Paragraph {
   double get ideographicBaseline;
   bool get didExceedMaxLines;
   void layout(ParagraphConstraints constraints);
+  Future<void> layoutAsync(ParagraphConstraints constraints);
   List<TextBox> getBoxesForRange(int start, int end,
       {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
       BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
@@ -687,7 +688,8 @@ abstract class ParagraphBuilder {
   });
 }
 
-Future<void> loadFontFromList(Uint8List list, {String? fontFamily}) async {
+// Fonts are loaded by the browser, so `subset` has no effect on the web.
+Future<void> loadFontFromList(Uint8List list, {String? fontFamily, bool subset = false}) async {
   await engine.renderer.fontCollection.loadFontFromList(list, fontFamily: fontFamily);
   engine.sendFontChangeMessage();
 }
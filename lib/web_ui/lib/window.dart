@@ -205,6 +205,34 @@ class IsolateNameServer {
   }
 }
 
+// There are no isolates on the web, so the computations run on the main
+// thread like those of `compute`.
+class IsolatePool {
+  IsolatePool({
+    this.size = 2,
+    this.idleTimeout = const Duration(seconds: 30),
+    bool prewarm = true,
+  }) : assert(size > 0);
+
+  final int size;
+  final Duration idleTimeout;
+  bool _closed = false;
+
+  int get spawnCount => 0;
+  Duration get totalSpawnLatency => Duration.zero;
+
+  Future<R> run<R>(FutureOr<R> Function() computation) {
+    if (_closed) {
+      throw StateError('IsolatePool.run called after the pool was closed.');
+    }
+    return Future<R>(computation);
+  }
+
+  void close() {
+    _closed = true;
+  }
+}
+
 SingletonFlutterWindow get window => engine.window;
 
 class FrameData {
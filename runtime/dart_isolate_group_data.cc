@@ -83,4 +83,38 @@ DartIsolateGroupData::GetPlatformMessageHandler(
              : it->second;
 }
 
+void DartIsolateGroupData::SetPlatformMessagePortRouter(
+    int64_t root_isolate_token,
+    std::weak_ptr<PlatformMessagePortRouter> router) {
+  std::scoped_lock lock(platform_message_port_routers_mutex_);
+  platform_message_port_routers_[root_isolate_token] = router;
+}
+
+std::weak_ptr<PlatformMessagePortRouter>
+DartIsolateGroupData::GetPlatformMessagePortRouter(
+    int64_t root_isolate_token) const {
+  std::scoped_lock lock(platform_message_port_routers_mutex_);
+  auto it = platform_message_port_routers_.find(root_isolate_token);
+  return it == platform_message_port_routers_.end()
+             ? std::weak_ptr<PlatformMessagePortRouter>()
+             : it->second;
+}
+
+void DartIsolateGroupData::SetSharedRingBufferRegistry(
+    int64_t root_isolate_token,
+    std::weak_ptr<SharedRingBufferRegistry> registry) {
+  std::scoped_lock lock(shared_ring_buffer_registries_mutex_);
+  shared_ring_buffer_registries_[root_isolate_token] = registry;
+}
+
+std::weak_ptr<SharedRingBufferRegistry>
+DartIsolateGroupData::GetSharedRingBufferRegistry(
+    int64_t root_isolate_token) const {
+  std::scoped_lock lock(shared_ring_buffer_registries_mutex_);
+  auto it = shared_ring_buffer_registries_.find(root_isolate_token);
+  return it == shared_ring_buffer_registries_.end()
+             ? std::weak_ptr<SharedRingBufferRegistry>()
+             : it->second;
+}
+
 }  // namespace flutter
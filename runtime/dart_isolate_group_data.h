@@ -19,6 +19,8 @@ namespace flutter {
 class DartIsolate;
 class DartSnapshot;
 class PlatformMessageHandler;
+class PlatformMessagePortRouter;
+class SharedRingBufferRegistry;
 
 using ChildIsolatePreparer = std::function<bool(DartIsolate*)>;
 
@@ -65,6 +67,24 @@ class DartIsolateGroupData : public PlatformMessageHandlerStorage {
   std::weak_ptr<PlatformMessageHandler> GetPlatformMessageHandler(
       int64_t root_isolate_token) const override;
 
+  // |PlatformMessageHandlerStorage|
+  void SetPlatformMessagePortRouter(
+      int64_t root_isolate_token,
+      std::weak_ptr<PlatformMessagePortRouter> router) override;
+
+  // |PlatformMessageHandlerStorage|
+  std::weak_ptr<PlatformMessagePortRouter> GetPlatformMessagePortRouter(
+      int64_t root_isolate_token) const override;
+
+  // |PlatformMessageHandlerStorage|
+  void SetSharedRingBufferRegistry(
+      int64_t root_isolate_token,
+      std::weak_ptr<SharedRingBufferRegistry> registry) override;
+
+  // |PlatformMessageHandlerStorage|
+  std::weak_ptr<SharedRingBufferRegistry> GetSharedRingBufferRegistry(
+      int64_t root_isolate_token) const override;
+
  private:
   const Settings settings_;
   const fml::RefPtr<const DartSnapshot> isolate_snapshot_;
@@ -77,6 +97,12 @@ class DartIsolateGroupData : public PlatformMessageHandlerStorage {
   std::map<int64_t, std::weak_ptr<PlatformMessageHandler>>
       platform_message_handlers_;
   mutable std::mutex platform_message_handlers_mutex_;
+  std::map<int64_t, std::weak_ptr<PlatformMessagePortRouter>>
+      platform_message_port_routers_;
+  mutable std::mutex platform_message_port_routers_mutex_;
+  std::map<int64_t, std::weak_ptr<SharedRingBufferRegistry>>
+      shared_ring_buffer_registries_;
+  mutable std::mutex shared_ring_buffer_registries_mutex_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DartIsolateGroupData);
 };
@@ -264,6 +264,18 @@ bool DartSnapshot::IsDontNeedSafe() const {
   return true;
 }
 
+std::vector<std::shared_ptr<const fml::Mapping>> DartSnapshot::GetMappings()
+    const {
+  std::vector<std::shared_ptr<const fml::Mapping>> mappings;
+  if (data_) {
+    mappings.push_back(data_);
+  }
+  if (instructions_) {
+    mappings.push_back(instructions_);
+  }
+  return mappings;
+}
+
 bool DartSnapshot::IsNullSafetyEnabled(const fml::Mapping* kernel) const {
   return ::Dart_DetectNullSafety(
       nullptr,           // script_uri (unsupported by Flutter)
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/fml/macros.h"
@@ -165,6 +166,15 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///             safe to use with madvise(DONTNEED).
   bool IsDontNeedSafe() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the mappings of the heap and, if present, the
+  ///             instructions snapshot. This is used to prefetch the pages of
+  ///             the snapshot that are touched during startup.
+  ///
+  /// @return     The data mapping followed by the instructions mapping.
+  ///
+  std::vector<std::shared_ptr<const fml::Mapping>> GetMappings() const;
+
   bool IsNullSafetyEnabled(
       const fml::Mapping* application_kernel_mapping) const;
 
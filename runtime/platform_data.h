@@ -6,6 +6,7 @@
 #define FLUTTER_RUNTIME_PLATFORM_DATA_H_
 
 #include <memory>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,8 @@ struct PlatformData {
   ~PlatformData();
 
   ViewportMetrics viewport_metrics;
+  // The metrics of the views other than the implicit one, by view ID.
+  std::map<int64_t, ViewportMetrics> added_view_metrics;
   std::string language_code;
   std::string country_code;
   std::string script_code;
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/compositing/scene.h"
@@ -113,6 +114,13 @@ std::unique_ptr<RuntimeController> RuntimeController::Clone() const {
 }
 
 bool RuntimeController::FlushRuntimeStateToIsolate() {
+  // Copied, as adding a view updates the metrics of the added views.
+  const auto added_view_metrics = platform_data_.added_view_metrics;
+  for (const auto& [view_id, metrics] : added_view_metrics) {
+    if (!AddView(view_id, metrics)) {
+      return false;
+    }
+  }
   return SetViewportMetrics(platform_data_.viewport_metrics) &&
          SetLocales(platform_data_.locale_data) &&
          SetSemanticsEnabled(platform_data_.semantics_enabled) &&
@@ -126,13 +134,40 @@ bool RuntimeController::SetViewportMetrics(const ViewportMetrics& metrics) {
   platform_data_.viewport_metrics = metrics;
 
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
-    platform_configuration->get_window(0)->UpdateWindowMetrics(metrics);
+    platform_configuration->get_window(kFlutterImplicitViewId)
+        ->UpdateWindowMetrics(metrics);
     return true;
   }
 
   return false;
 }
 
+bool RuntimeController::AddView(int64_t view_id,
+                                const ViewportMetrics& metrics) {
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+  platform_data_.added_view_metrics[view_id] = metrics;
+
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    if (Window* window = platform_configuration->get_window(view_id)) {
+      window->UpdateWindowMetrics(metrics);
+      return true;
+    }
+    return platform_configuration->AddWindow(view_id, metrics);
+  }
+
+  return false;
+}
+
+bool RuntimeController::RemoveView(int64_t view_id) {
+  platform_data_.added_view_metrics.erase(view_id);
+
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    return platform_configuration->RemoveWindow(view_id);
+  }
+
+  return false;
+}
+
 bool RuntimeController::SetLocales(
     const std::vector<std::string>& locale_data) {
   platform_data_.locale_data = locale_data;
@@ -267,11 +302,25 @@ bool RuntimeController::DispatchPlatformMessage(
   return false;
 }
 
+bool RuntimeController::DispatchPlatformMessages(
+    const std::string& channel,
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT0("flutter", "RuntimeController::DispatchPlatformMessages");
+    platform_configuration->DispatchPlatformMessages(channel,
+                                                     std::move(messages));
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
     TRACE_EVENT0("flutter", "RuntimeController::DispatchPointerDataPacket");
-    platform_configuration->get_window(0)->DispatchPointerDataPacket(packet);
+    platform_configuration->get_window(kFlutterImplicitViewId)
+        ->DispatchPointerDataPacket(packet);
     return true;
   }
 
@@ -309,8 +358,8 @@ void RuntimeController::ScheduleFrame() {
 }
 
 // |PlatformConfigurationClient|
-void RuntimeController::Render(Scene* scene) {
-  client_.Render(scene->takeLayerTree());
+void RuntimeController::Render(int64_t view_id, Scene* scene) {
+  client_.Render(view_id, scene->takeLayerTree());
 }
 
 // |PlatformConfigurationClient|
@@ -422,6 +471,12 @@ bool RuntimeController::LaunchRootIsolate(
   strong_root_isolate->GetIsolateGroupData().SetPlatformMessageHandler(
       strong_root_isolate->GetRootIsolateToken(),
       client_.GetPlatformMessageHandler());
+  strong_root_isolate->GetIsolateGroupData().SetPlatformMessagePortRouter(
+      strong_root_isolate->GetRootIsolateToken(),
+      client_.GetPlatformMessagePortRouter());
+  strong_root_isolate->GetIsolateGroupData().SetSharedRingBufferRegistry(
+      strong_root_isolate->GetRootIsolateToken(),
+      client_.GetSharedRingBufferRegistry());
 
   // The root isolate ivar is weak.
   root_isolate_ = strong_root_isolate;
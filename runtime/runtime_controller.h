@@ -174,6 +174,28 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   bool SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a view besides the implicit one, or updates the metrics
+  ///             of a view that was added. If the isolate is not running, the
+  ///             view is added when it starts.
+  ///
+  /// @param[in]  view_id  The ID of the view. It must not be the ID of the
+  ///                      implicit view.
+  /// @param[in]  metrics  The viewport metrics of the view.
+  ///
+  /// @return     If the view was forwarded to the running isolate.
+  ///
+  bool AddView(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a view added by |AddView|.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  ///
+  /// @return     If the view was removed from the running isolate.
+  ///
+  bool RemoveView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Forward the specified locale data to the running isolate. If
   ///             the isolate is not running, this data will be saved and
@@ -392,6 +414,20 @@ class RuntimeController : public PlatformConfigurationClient {
   virtual bool DispatchPlatformMessage(
       std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatch a batch of platform messages on one channel to the
+  ///             running root isolate with a single call into Dart.
+  ///
+  /// @param[in]  channel   The channel all of the messages were sent on.
+  /// @param[in]  messages  The messages to dispatch to the isolate, in order.
+  ///
+  /// @return     If the messages were dispatched to the running root isolate.
+  ///             This may fail is an isolate is not running.
+  ///
+  virtual bool DispatchPlatformMessages(
+      const std::string& channel,
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
@@ -617,7 +653,7 @@ class RuntimeController : public PlatformConfigurationClient {
   void ScheduleFrame() override;
 
   // |PlatformConfigurationClient|
-  void Render(Scene* scene) override;
+  void Render(int64_t view_id, Scene* scene) override;
 
   // |PlatformConfigurationClient|
   void UpdateSemantics(SemanticsUpdate* update) override;
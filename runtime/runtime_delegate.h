@@ -14,6 +14,8 @@
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/text/font_collection.h"
 #include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/lib/ui/window/platform_message_port_router.h"
+#include "flutter/lib/ui/window/shared_ring_buffer_registry.h"
 #include "flutter/shell/common/platform_message_handler.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
@@ -25,7 +27,8 @@ class RuntimeDelegate {
 
   virtual void ScheduleFrame(bool regenerate_layer_tree = true) = 0;
 
-  virtual void Render(std::shared_ptr<flutter::LayerTree> layer_tree) = 0;
+  virtual void Render(int64_t view_id,
+                      std::shared_ptr<flutter::LayerTree> layer_tree) = 0;
 
   virtual void UpdateSemantics(SemanticsNodeUpdates update,
                                CustomAccessibilityActionUpdates actions) = 0;
@@ -53,6 +56,12 @@ class RuntimeDelegate {
   virtual std::weak_ptr<PlatformMessageHandler> GetPlatformMessageHandler()
       const = 0;
 
+  virtual std::weak_ptr<PlatformMessagePortRouter>
+  GetPlatformMessagePortRouter() const = 0;
+
+  virtual std::weak_ptr<SharedRingBufferRegistry>
+  GetSharedRingBufferRegistry() const = 0;
+
  protected:
   virtual ~RuntimeDelegate();
 };
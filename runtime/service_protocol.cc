@@ -40,8 +40,21 @@ const std::string_view
 const std::string_view
     ServiceProtocol::kRenderFrameWithRasterStatsExtensionName =
         "_flutter.renderFrameWithRasterStats";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingPercentilesExtensionName =
+        "_flutter.getFrameTimingPercentiles";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kGetTraceRecordingExtensionName =
+    "_flutter.getTraceRecording";
+const std::string_view ServiceProtocol::kGetMemoryUsageExtensionName =
+    "_flutter.getMemoryUsage";
+const std::string_view ServiceProtocol::kNotifyMemoryPressureExtensionName =
+    "_flutter.notifyMemoryPressure";
+const std::string_view ServiceProtocol::kCaptureFramesExtensionName =
+    "_flutter.captureFrames";
+const std::string_view ServiceProtocol::kGetFrameCaptureExtensionName =
+    "_flutter.getFrameCapture";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -62,7 +75,13 @@ ServiceProtocol::ServiceProtocol()
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
+          kGetFrameTimingPercentilesExtensionName,
           kReloadAssetFonts,
+          kGetTraceRecordingExtensionName,
+          kGetMemoryUsageExtensionName,
+          kNotifyMemoryPressureExtensionName,
+          kCaptureFramesExtensionName,
+          kGetFrameCaptureExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -30,7 +30,13 @@ class ServiceProtocol {
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
+  static const std::string_view kGetFrameTimingPercentilesExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kGetTraceRecordingExtensionName;
+  static const std::string_view kGetMemoryUsageExtensionName;
+  static const std::string_view kNotifyMemoryPressureExtensionName;
+  static const std::string_view kCaptureFramesExtensionName;
+  static const std::string_view kGetFrameCaptureExtensionName;
 
   class Handler {
    public:
@@ -0,0 +1,223 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_warmup_profile.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#define SNAPSHOT_WARMUP_PROFILE_SUPPORTED 1
+#else
+#define SNAPSHOT_WARMUP_PROFILE_SUPPORTED 0
+#endif
+
+namespace flutter {
+
+namespace {
+
+// The profile is only read back on the device that wrote it, so it is stored
+// in the native byte order.
+//
+// Header:  magic u32, version u32, page size u32, mapping count u32.
+// Mapping: mapping size u64, range count u32, then the ranges as pairs of
+//          first page u32 and page count u32.
+constexpr uint32_t kMagic = 0x50574c46;  // "FLWP"
+constexpr uint32_t kVersion = 1;
+
+size_t GetPageSize() {
+#if SNAPSHOT_WARMUP_PROFILE_SUPPORTED
+  return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& data, T value) {
+  const auto offset = data.size();
+  data.resize(offset + sizeof(T));
+  std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+class Reader {
+ public:
+  explicit Reader(const fml::Mapping& data)
+      : data_(data.GetMapping()), size_(data.GetSize()) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (data_ == nullptr || size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool IsAtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0;
+};
+
+// The page aligned start of the mapping and the number of pages it spans.
+std::pair<uint8_t*, size_t> GetPages(const fml::Mapping& mapping,
+                                     size_t page_size) {
+  const auto begin = reinterpret_cast<uintptr_t>(mapping.GetMapping());
+  const auto aligned_begin = begin & ~(page_size - 1);
+  const auto end = begin + mapping.GetSize();
+  return {reinterpret_cast<uint8_t*>(aligned_begin),
+          (end - aligned_begin + page_size - 1) / page_size};
+}
+
+}  // namespace
+
+SnapshotWarmupProfile::SnapshotWarmupProfile() = default;
+
+std::optional<std::vector<SnapshotWarmupProfile::PageRange>>
+SnapshotWarmupProfile::GetResidentPages(const fml::Mapping& mapping) {
+#if SNAPSHOT_WARMUP_PROFILE_SUPPORTED
+  if (mapping.GetMapping() == nullptr || mapping.GetSize() == 0) {
+    return std::nullopt;
+  }
+  const auto page_size = GetPageSize();
+  const auto [pages, page_count] = GetPages(mapping, page_size);
+  std::vector<unsigned char> residency(page_count);
+  if (::mincore(pages, page_count * page_size, residency.data()) != 0) {
+    return std::nullopt;
+  }
+
+  std::vector<PageRange> ranges;
+  for (size_t page = 0; page < page_count; page++) {
+    if ((residency[page] & 1u) == 0) {
+      continue;
+    }
+    if (!ranges.empty() &&
+        ranges.back().first_page + ranges.back().page_count == page) {
+      ranges.back().page_count++;
+    } else {
+      ranges.push_back({page, 1});
+    }
+  }
+  return ranges;
+#else
+  return std::nullopt;
+#endif
+}
+
+std::optional<SnapshotWarmupProfile> SnapshotWarmupProfile::Record(
+    const Mappings& mappings) {
+  TRACE_EVENT0("flutter", "SnapshotWarmupProfile::Record");
+  SnapshotWarmupProfile profile;
+  profile.page_size_ = GetPageSize();
+  for (const auto& mapping : mappings) {
+    if (!mapping) {
+      return std::nullopt;
+    }
+    auto ranges = GetResidentPages(*mapping);
+    if (!ranges.has_value()) {
+      return std::nullopt;
+    }
+    profile.mapping_sizes_.push_back(mapping->GetSize());
+    profile.ranges_.push_back(std::move(ranges.value()));
+  }
+  return profile;
+}
+
+std::unique_ptr<fml::Mapping> SnapshotWarmupProfile::Serialize() const {
+  std::vector<uint8_t> data;
+  Append<uint32_t>(data, kMagic);
+  Append<uint32_t>(data, kVersion);
+  Append<uint32_t>(data, page_size_);
+  Append<uint32_t>(data, mapping_sizes_.size());
+  for (size_t i = 0; i < mapping_sizes_.size(); i++) {
+    Append<uint64_t>(data, mapping_sizes_[i]);
+    Append<uint32_t>(data, ranges_[i].size());
+    for (const auto& range : ranges_[i]) {
+      Append<uint32_t>(data, range.first_page);
+      Append<uint32_t>(data, range.page_count);
+    }
+  }
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+std::optional<SnapshotWarmupProfile> SnapshotWarmupProfile::Deserialize(
+    const fml::Mapping& data,
+    const Mappings& mappings) {
+  Reader reader(data);
+  uint32_t magic = 0, version = 0, page_size = 0, mapping_count = 0;
+  if (GetPageSize() == 0 || !reader.Read(magic) || magic != kMagic ||
+      !reader.Read(version) || version != kVersion ||
+      !reader.Read(page_size) || page_size != GetPageSize() ||
+      !reader.Read(mapping_count) || mapping_count != mappings.size()) {
+    return std::nullopt;
+  }
+
+  SnapshotWarmupProfile profile;
+  profile.page_size_ = page_size;
+  for (const auto& mapping : mappings) {
+    uint64_t mapping_size = 0;
+    uint32_t range_count = 0;
+    if (!mapping || !reader.Read(mapping_size) ||
+        mapping_size != mapping->GetSize() || !reader.Read(range_count)) {
+      return std::nullopt;
+    }
+    const auto page_count = GetPages(*mapping, page_size).second;
+    std::vector<PageRange> ranges;
+    for (uint32_t i = 0; i < range_count; i++) {
+      uint32_t first_page = 0, range_page_count = 0;
+      if (!reader.Read(first_page) || !reader.Read(range_page_count) ||
+          first_page >= page_count ||
+          range_page_count > page_count - first_page) {
+        return std::nullopt;
+      }
+      ranges.push_back({first_page, range_page_count});
+    }
+    profile.mapping_sizes_.push_back(mapping_size);
+    profile.ranges_.push_back(std::move(ranges));
+  }
+  if (!reader.IsAtEnd()) {
+    return std::nullopt;
+  }
+  return profile;
+}
+
+size_t SnapshotWarmupProfile::Prefetch(const Mappings& mappings) const {
+  TRACE_EVENT0("flutter", "SnapshotWarmupProfile::Prefetch");
+  size_t advised_bytes = 0;
+#if SNAPSHOT_WARMUP_PROFILE_SUPPORTED
+  if (mappings.size() != ranges_.size() || page_size_ != GetPageSize()) {
+    return 0;
+  }
+  for (size_t i = 0; i < mappings.size(); i++) {
+    const auto& mapping = mappings[i];
+    if (!mapping || mapping->GetSize() != mapping_sizes_[i]) {
+      continue;
+    }
+    auto pages = GetPages(*mapping, page_size_).first;
+    for (const auto& range : ranges_[i]) {
+      const auto length = range.page_count * page_size_;
+      if (::madvise(pages + range.first_page * page_size_, length,
+                    MADV_WILLNEED) != 0) {
+        FML_DLOG(WARNING) << "Could not prefetch snapshot pages: "
+                          << strerror(errno);
+        break;
+      }
+      advised_bytes += length;
+    }
+  }
+#endif
+  return advised_bytes;
+}
+
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_RUNTIME_SNAPSHOT_WARMUP_PROFILE_H_
+#define FLUTTER_RUNTIME_SNAPSHOT_WARMUP_PROFILE_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The pages of the snapshot mappings that were resident in memory once the
+/// first frame was rasterized.
+///
+/// On a cold start, the pages of the AOT snapshots are faulted in one at a
+/// time as the VM and the root isolate touch them, which is slow on devices
+/// with slow storage. A profile recorded on one launch lets the next launches
+/// ask the kernel to read those pages ahead, with `madvise(MADV_WILLNEED)`,
+/// before they are touched.
+///
+/// Residency is an approximation of the pages that were touched. It includes
+/// pages that the kernel read ahead on its own and pages that other processes
+/// mapped. A profile only applies to the mappings it was recorded from. It is
+/// discarded if the sizes of the mappings or the page size change, as happens
+/// when the application is updated.
+///
+/// Recording and prefetching is only supported on Linux and Android. On other
+/// platforms nothing is recorded and prefetching does nothing.
+///
+class SnapshotWarmupProfile {
+ public:
+  using Mappings = std::vector<std::shared_ptr<const fml::Mapping>>;
+
+  /// The name of the profile in the cache directory.
+  static constexpr const char* kFileName = "flutter_snapshot_warmup_profile";
+
+  struct PageRange {
+    size_t first_page = 0;
+    size_t page_count = 0;
+
+    bool operator==(const PageRange& other) const {
+      return first_page == other.first_page && page_count == other.page_count;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the resident pages of each of the mappings.
+  ///
+  /// @return     The profile, or nothing if residency can't be queried on this
+  ///             platform or for one of the mappings.
+  ///
+  static std::optional<SnapshotWarmupProfile> Record(const Mappings& mappings);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads a profile written by `Serialize`.
+  ///
+  /// @return     The profile, or nothing if the data is malformed or the
+  ///             profile was recorded for other mappings.
+  ///
+  static std::optional<SnapshotWarmupProfile> Deserialize(
+      const fml::Mapping& data,
+      const Mappings& mappings);
+
+  std::unique_ptr<fml::Mapping> Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the kernel to read the recorded pages of the mappings
+  ///             ahead. This doesn't wait for the reads to complete.
+  ///
+  /// @return     The number of bytes that were advised.
+  ///
+  size_t Prefetch(const Mappings& mappings) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The ranges of pages of the mapping whose bytes are resident.
+  ///             Pages are numbered from the page that contains the first
+  ///             byte of the mapping.
+  ///
+  static std::optional<std::vector<PageRange>> GetResidentPages(
+      const fml::Mapping& mapping);
+
+  const std::vector<std::vector<PageRange>>& GetRanges() const {
+    return ranges_;
+  }
+
+ private:
+  size_t page_size_ = 0;
+  std::vector<size_t> mapping_sizes_;
+  std::vector<std::vector<PageRange>> ranges_;
+
+  SnapshotWarmupProfile();
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_RUNTIME_SNAPSHOT_WARMUP_PROFILE_H_
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/runtime/snapshot_warmup_profile.h"
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace flutter {
+namespace testing {
+
+#if FML_OS_ANDROID || FML_OS_LINUX
+
+namespace {
+
+using PageRange = SnapshotWarmupProfile::PageRange;
+
+// Maps a file of the given number of pages.
+std::shared_ptr<const fml::Mapping> CreateFileMapping(
+    fml::ScopedTemporaryDirectory& directory,
+    size_t page_count) {
+  const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  fml::DataMapping contents(std::vector<uint8_t>(page_count * page_size, 1u));
+  if (!fml::WriteAtomically(directory.fd(), "snapshot", contents)) {
+    return nullptr;
+  }
+  return fml::FileMapping::CreateReadOnly(directory.fd(), "snapshot");
+}
+
+}  // namespace
+
+TEST(SnapshotWarmupProfileTest, RecordsResidentPagesOfFileMappings) {
+  fml::ScopedTemporaryDirectory directory;
+  auto mapping = CreateFileMapping(directory, 4);
+  ASSERT_NE(mapping, nullptr);
+
+  // The file was just written, so all of its pages are in the page cache.
+  auto profile = SnapshotWarmupProfile::Record({mapping});
+  ASSERT_TRUE(profile.has_value());
+  ASSERT_EQ(profile->GetRanges().size(), 1u);
+  ASSERT_EQ(profile->GetRanges()[0], (std::vector<PageRange>{{0, 4}}));
+  ASSERT_GT(profile->Prefetch({mapping}), 0u);
+}
+
+TEST(SnapshotWarmupProfileTest, SerializesAndDeserializes) {
+  fml::ScopedTemporaryDirectory directory;
+  auto mapping = CreateFileMapping(directory, 2);
+  ASSERT_NE(mapping, nullptr);
+  auto profile = SnapshotWarmupProfile::Record({mapping});
+  ASSERT_TRUE(profile.has_value());
+
+  auto data = profile->Serialize();
+  auto deserialized = SnapshotWarmupProfile::Deserialize(*data, {mapping});
+  ASSERT_TRUE(deserialized.has_value());
+  ASSERT_EQ(deserialized->GetRanges(), profile->GetRanges());
+}
+
+TEST(SnapshotWarmupProfileTest, RejectsProfilesOfOtherMappings) {
+  fml::ScopedTemporaryDirectory directory;
+  auto mapping = CreateFileMapping(directory, 2);
+  ASSERT_NE(mapping, nullptr);
+  auto data = SnapshotWarmupProfile::Record({mapping})->Serialize();
+
+  // A mapping of another size, as after an update of the application.
+  fml::ScopedTemporaryDirectory other_directory;
+  auto other_mapping = CreateFileMapping(other_directory, 3);
+  ASSERT_NE(other_mapping, nullptr);
+  ASSERT_FALSE(
+      SnapshotWarmupProfile::Deserialize(*data, {other_mapping}).has_value());
+  ASSERT_FALSE(SnapshotWarmupProfile::Deserialize(*data, {mapping, mapping})
+                   .has_value());
+
+  // Truncated data.
+  fml::NonOwnedMapping truncated(data->GetMapping(), data->GetSize() - 1);
+  ASSERT_FALSE(
+      SnapshotWarmupProfile::Deserialize(truncated, {mapping}).has_value());
+}
+
+#endif  // FML_OS_ANDROID || FML_OS_LINUX
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,7 +4,11 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+#include <string>
+
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -23,10 +27,18 @@ constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   std::shared_ptr<const FrameDurationPredictor>
+                       frame_duration_predictor,
+                   std::shared_ptr<const PipelineDepthAdvisor>
+                       pipeline_depth_advisor,
+                   std::unique_ptr<FrameRateAdvisor> frame_rate_advisor)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
+      frame_duration_predictor_(std::move(frame_duration_predictor)),
+      pipeline_depth_advisor_(std::move(pipeline_depth_advisor)),
+      frame_rate_advisor_(std::move(frame_rate_advisor)),
 #if SHELL_ENABLE_METAL
       layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
 #else   // SHELL_ENABLE_METAL
@@ -41,6 +53,9 @@ Animator::Animator(Delegate& delegate,
 #endif  // SHELL_ENABLE_METAL
       pending_frame_semaphore_(1),
       weak_factory_(this) {
+  if (frame_duration_predictor_) {
+    waiter_->SetFrameDurationPredictor(frame_duration_predictor_);
+  }
 }
 
 Animator::~Animator() = default;
@@ -59,11 +74,26 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
 
 void Animator::BeginFrame(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  begin_frame_deferred_ = false;
+  // Input that was held for this frame is handled before the frame begins,
+  // and any frame it requests is the one that is beginning.
+  RunBeginFrameCallbacks();
+
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending",
                          frame_request_number_);
   frame_request_number_++;
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
+  if (frame_rate_advisor_) {
+    frame_rate_advisor_->AddFrame(frame_timings_recorder_->GetVsyncStartTime(),
+                                  frame_timings_recorder_->GetVsyncTargetTime(),
+                                  pending_input_time_.has_value());
+    UpdatePreferredFrameRate();
+  }
+  if (pending_input_time_.has_value()) {
+    frame_timings_recorder_->RecordInput(pending_input_time_.value());
+    pending_input_time_.reset();
+  }
   frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
 
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder_, "flutter",
@@ -78,6 +108,14 @@ void Animator::BeginFrame(
   regenerate_layer_tree_ = false;
   pending_frame_semaphore_.Signal();
 
+  if (pipeline_depth_advisor_) {
+    const uint32_t depth = pipeline_depth_advisor_->GetDepth();
+    if (depth != layer_tree_pipeline_->GetDepth()) {
+      TRACE_EVENT0("flutter", "Animator::SetPipelineDepth");
+      layer_tree_pipeline_->SetDepth(depth);
+    }
+  }
+
   if (!producer_continuation_) {
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animator::Render. Simply reuse that
@@ -101,7 +139,12 @@ void Animator::BeginFrame(
       frame_timings_recorder_->GetVsyncTargetTime();
   dart_frame_deadline_ = frame_target_time.ToEpochDelta();
   uint64_t frame_number = frame_timings_recorder_->GetFrameNumber();
+  in_begin_frame_ = true;
   delegate_.OnAnimatorBeginFrame(frame_target_time, frame_number);
+  in_begin_frame_ = false;
+  if (!layer_tree_tasks_.empty()) {
+    EndFrame();
+  }
 
   if (!frame_scheduled_ && has_rendered_) {
     // Wait a tad more than 3 60hz frames before reporting a big idle period.
@@ -120,6 +163,10 @@ void Animator::BeginFrame(
           // vsync deadline, bail.
           if (!self->frame_scheduled_ && now > self->dart_frame_deadline_) {
             TRACE_EVENT0("flutter", "BeginFrame idle callback");
+            if (self->frame_rate_advisor_) {
+              self->frame_rate_advisor_->OnIdle();
+              self->UpdatePreferredFrameRate();
+            }
             self->delegate_.OnAnimatorNotifyIdle(
                 now + fml::TimeDelta::FromMilliseconds(100));
           }
@@ -128,12 +175,61 @@ void Animator::BeginFrame(
   }
 }
 
-void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
+void Animator::ScheduleBeginFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (frame_duration_predictor_) {
+    const auto frame_duration =
+        frame_duration_predictor_->PredictFrameDuration();
+    if (frame_duration.has_value()) {
+      const fml::TimePoint begin_frame_time =
+          frame_timings_recorder->GetVsyncTargetTime() - frame_duration.value();
+      if (begin_frame_time > fml::TimePoint::Now()) {
+        // Input that arrives before the frame begins still makes it into the
+        // frame. The frame itself must not wait behind a backlog of other
+        // tasks once it is due.
+        TRACE_EVENT0("flutter", "Animator::DeferBeginFrame");
+        begin_frame_deferred_ = true;
+        task_runners_.GetUITaskRunner()->PostTaskForTimeWithGrade(
+            fml::MakeCopyable(
+                [self = weak_factory_.GetWeakPtr(),
+                 recorder = std::move(frame_timings_recorder)]() mutable {
+                  if (self) {
+                    self->BeginFrame(std::move(recorder));
+                  }
+                }),
+            begin_frame_time, fml::TaskSourceGrade::kUserInteraction);
+        return;
+      }
+    }
+  }
+  BeginFrame(std::move(frame_timings_recorder));
+}
+
+void Animator::Render(int64_t view_id,
+                      std::shared_ptr<flutter::LayerTree> layer_tree) {
   has_rendered_ = true;
-  last_layer_tree_size_ = layer_tree->frame_size();
+  if (view_id == kFlutterImplicitViewId) {
+    last_layer_tree_size_ = layer_tree->frame_size();
+  }
 
-  if (!frame_timings_recorder_) {
+  auto found = std::find_if(
+      layer_tree_tasks_.begin(), layer_tree_tasks_.end(),
+      [view_id](const LayerTreeTask& task) { return task.view_id == view_id; });
+  if (found != layer_tree_tasks_.end()) {
+    found->layer_tree = std::move(layer_tree);
+  } else {
+    layer_tree_tasks_.emplace_back(view_id, std::move(layer_tree));
+  }
+
+  if (!in_begin_frame_) {
     // Framework can directly call render with a built scene.
+    EndFrame();
+  }
+}
+
+void Animator::EndFrame() {
+  FML_DCHECK(!layer_tree_tasks_.empty());
+  if (!frame_timings_recorder_) {
     frame_timings_recorder_ = std::make_unique<FrameTimingsRecorder>();
     const fml::TimePoint placeholder_time = fml::TimePoint::Now();
     frame_timings_recorder_->RecordVsync(placeholder_time, placeholder_time);
@@ -148,7 +244,8 @@ void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
       frame_timings_recorder_->GetVsyncTargetTime());
 
   auto layer_tree_item = std::make_unique<LayerTreeItem>(
-      std::move(layer_tree), std::move(frame_timings_recorder_));
+      std::move(layer_tree_tasks_), std::move(frame_timings_recorder_));
+  layer_tree_tasks_.clear();
   // Commit the pending continuation.
   PipelineProduceResult result =
       producer_continuation_.Complete(std::move(layer_tree_item));
@@ -191,9 +288,26 @@ void Animator::DrawLastLayerTree(
   const auto now = fml::TimePoint::Now();
   frame_timings_recorder->RecordBuildStart(now);
   frame_timings_recorder->RecordBuildEnd(now);
+  if (frame_rate_advisor_) {
+    frame_rate_advisor_->AddFrame(frame_timings_recorder->GetVsyncStartTime(),
+                                  frame_timings_recorder->GetVsyncTargetTime(),
+                                  /*has_input=*/false);
+    UpdatePreferredFrameRate();
+  }
   delegate_.OnAnimatorDrawLastLayerTree(std::move(frame_timings_recorder));
 }
 
+void Animator::UpdatePreferredFrameRate() {
+  const double rate = frame_rate_advisor_->GetPreferredFrameRate();
+  if (rate == preferred_frame_rate_) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "Animator::SetPreferredFrameRate", "rate",
+               std::to_string(rate).c_str());
+  preferred_frame_rate_ = rate;
+  waiter_->SetPreferredFrameRate(rate);
+}
+
 void Animator::RequestFrame(bool regenerate_layer_tree) {
   if (regenerate_layer_tree) {
     // This event will be closed by BeginFrame. BeginFrame will only be called
@@ -236,7 +350,7 @@ void Animator::AwaitVSync() {
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
+            self->ScheduleBeginFrame(std::move(frame_timings_recorder));
           }
         }
       });
@@ -250,12 +364,54 @@ void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+bool Animator::ScheduleBeginFrameCallback(uintptr_t id,
+                                          const fml::closure& callback) {
+  if (!frame_scheduled_) {
+    return false;
+  }
+  begin_frame_callbacks_.emplace(id, callback);
+  // The secondary callbacks run after the vsync callback has begun the frame
+  // or deferred its begin. The callbacks are left to the deferred begin.
+  waiter_->ScheduleSecondaryCallback(
+      reinterpret_cast<uintptr_t>(&begin_frame_callbacks_),
+      [self = weak_factory_.GetWeakPtr()] {
+        if (self && !self->begin_frame_deferred_) {
+          self->RunBeginFrameCallbacks();
+        }
+      });
+  return true;
+}
+
+void Animator::RunBeginFrameCallbacks() {
+  if (begin_frame_callbacks_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Animator::RunBeginFrameCallbacks");
+  // The callbacks may schedule callbacks for the next frame.
+  auto callbacks = std::move(begin_frame_callbacks_);
+  begin_frame_callbacks_.clear();
+  for (auto& [id, callback] : callbacks) {
+    callback();
+  }
+}
+
+void Animator::RecordInput(fml::TimePoint input_time) {
+  if (!pending_input_time_.has_value() ||
+      input_time < pending_input_time_.value()) {
+    pending_input_time_ = input_time;
+  }
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
       reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
         if (!self) {
           return;
         }
+        if (!self->frame_scheduled_) {
+          // The input was not handled in a frame.
+          self->pending_input_time_.reset();
+        }
         if (!self->frame_scheduled_ && !self->trace_flow_ids_.empty()) {
           TRACE_EVENT0("flutter",
                        "Animator::ScheduleMaybeClearTraceFlowIds - callback");
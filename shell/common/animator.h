@@ -6,6 +6,9 @@
 #define FLUTTER_SHELL_COMMON_ANIMATOR_H_
 
 #include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
@@ -13,7 +16,10 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_duration_predictor.h"
+#include "flutter/shell/common/frame_rate_advisor.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/pipeline_depth_advisor.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
 
@@ -46,15 +52,45 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an animator.
+  ///
+  /// @param[in]  delegate                  The delegate.
+  /// @param[in]  task_runners              The task runners.
+  /// @param[in]  waiter                    The vsync waiter.
+  /// @param[in]  frame_duration_predictor  If not null, frames start as late
+  ///                                       after their vsync as the predicted
+  ///                                       frame duration allows. It is also
+  ///                                       given to the vsync waiter.
+  /// @param[in]  pipeline_depth_advisor    If not null, the depth of the layer
+  ///                                       tree pipeline follows its advice.
+  /// @param[in]  frame_rate_advisor        If not null, it is told about every
+  ///                                       frame and the rate it prefers is
+  ///                                       given to the vsync waiter.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           std::shared_ptr<const FrameDurationPredictor>
+               frame_duration_predictor = nullptr,
+           std::shared_ptr<const PipelineDepthAdvisor> pipeline_depth_advisor =
+               nullptr,
+           std::unique_ptr<FrameRateAdvisor> frame_rate_advisor = nullptr);
 
   ~Animator();
 
   void RequestFrame(bool regenerate_layer_tree = true);
 
-  void Render(std::shared_ptr<flutter::LayerTree> layer_tree);
+  //--------------------------------------------------------------------------
+  /// @brief    Submits the layer tree of a view to the rasterizer.
+  ///
+  ///           The views rendered while a frame begins are collected and
+  ///           submitted together as a single pipeline item once the frame
+  ///           has been built, so that they are rasterized together.
+  ///           Rendering the same view twice in a frame replaces its layer
+  ///           tree.
+  ///
+  void Render(int64_t view_id, std::shared_ptr<flutter::LayerTree> layer_tree);
 
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
@@ -76,6 +112,32 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Schedule a callback to be executed right before the frame that
+  ///           is scheduled begins, after any deferral of its begin to the
+  ///           vsync target time minus the predicted frame duration. If that
+  ///           frame reuses the last layer tree, or doesn't begin by the next
+  ///           vsync, the callback is executed at that vsync instead.
+  ///
+  ///           This callback is only scheduled to be called once per |id|,
+  ///           and it will be called in the UI thread.
+  ///
+  ///           This callback is used by `FrameAlignedPointerDataDispatcher`
+  ///           to dispatch input with the latest events before the build of
+  ///           the frame starts.
+  ///
+  /// @return   Whether the callback was scheduled. It is not if no frame is
+  ///           scheduled, in which case work that may request a frame should
+  ///           be done right away so that the frame starts at the next vsync.
+  ///
+  /// @see      `PointerDataDispatcher::ScheduleBeginFrameCallback`.
+  bool ScheduleBeginFrameCallback(uintptr_t id, const fml::closure& callback);
+
+  // Record that input was received at |input_time|. The input latency of the
+  // next frame that begins is measured from the earliest such time, unless
+  // no frame was scheduled by the next vsync interval.
+  void RecordInput(fml::TimePoint input_time);
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // rendering.
@@ -84,19 +146,37 @@ class Animator final {
  private:
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  // Begins the frame right away or, if the frame duration can be predicted,
+  // at the latest time that still meets its target time.
+  void ScheduleBeginFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   bool CanReuseLastLayerTree();
 
+  void RunBeginFrameCallbacks();
+
   void DrawLastLayerTree(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
   void AwaitVSync();
 
+  // Submits |layer_tree_tasks_| to the pipeline.
+  void EndFrame();
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
+  // Gives the rate preferred by |frame_rate_advisor_| to the vsync waiter if
+  // it changed.
+  void UpdatePreferredFrameRate();
+
   Delegate& delegate_;
   TaskRunners task_runners_;
   std::shared_ptr<VsyncWaiter> waiter_;
+  std::shared_ptr<const FrameDurationPredictor> frame_duration_predictor_;
+  std::shared_ptr<const PipelineDepthAdvisor> pipeline_depth_advisor_;
+  std::unique_ptr<FrameRateAdvisor> frame_rate_advisor_;
+  double preferred_frame_rate_ = 0.0;
 
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder_;
   uint64_t frame_request_number_ = 1;
@@ -108,7 +188,16 @@ class Animator final {
   bool frame_scheduled_ = false;
   SkISize last_layer_tree_size_ = {0, 0};
   std::deque<uint64_t> trace_flow_ids_;
+  std::unordered_map<uintptr_t, fml::closure> begin_frame_callbacks_;
+  // Whether the begin of the current frame is deferred by
+  // |ScheduleBeginFrame|.
+  bool begin_frame_deferred_ = false;
+  std::optional<fml::TimePoint> pending_input_time_;
   bool has_rendered_ = false;
+  // Whether |Delegate::OnAnimatorBeginFrame| is being called.
+  bool in_begin_frame_ = false;
+  // The views rendered in the current frame.
+  std::vector<LayerTreeTask> layer_tree_tasks_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
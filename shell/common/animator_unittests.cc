@@ -9,7 +9,9 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
+#include "flutter/common/constants.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
 #include "flutter/testing/post_task_sync.h"
@@ -157,7 +159,7 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyIdleBeforeRender) {
         ASSERT_FALSE(delegate.notify_idle_called_);
         auto layer_tree =
             std::make_shared<LayerTree>(SkISize::Make(600, 800), 1.0);
-        animator->Render(std::move(layer_tree));
+        animator->Render(kFlutterImplicitViewId, std::move(layer_tree));
         task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
       },
       // See kNotifyIdleTaskWaitTime in animator.cc.
@@ -240,13 +242,83 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
     PostTaskSync(task_runners.GetUITaskRunner(), [&] {
       auto layer_tree =
           std::make_shared<LayerTree>(SkISize::Make(600, 800), 1.0);
-      animator->Render(std::move(layer_tree));
+      animator->Render(kFlutterImplicitViewId, std::move(layer_tree));
     });
   }
 
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+TEST_F(ShellTest, AnimatorSubmitsTheViewsRenderedInAFrameTogether) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+  std::shared_ptr<Animator> animator;
+
+  auto flush_vsync_task = [&] {
+    fml::AutoResetWaitableEvent ui_latch;
+    task_runners.GetUITaskRunner()->PostTask([&] { ui_latch.Signal(); });
+    do {
+      clock->SimulateVSync();
+    } while (ui_latch.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(1)));
+  };
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter));
+  });
+
+  constexpr int64_t kSecondViewId = 1;
+  auto second_layer_tree =
+      std::make_shared<LayerTree>(SkISize::Make(300, 400), 1.0);
+  EXPECT_CALL(delegate, OnAnimatorBeginFrame)
+      .WillOnce([&](fml::TimePoint frame_target_time, uint64_t frame_number) {
+        animator->Render(kFlutterImplicitViewId,
+                         std::make_shared<LayerTree>(SkISize::Make(600, 800),
+                                                     1.0));
+        animator->Render(kSecondViewId, std::make_shared<LayerTree>(
+                                            SkISize::Make(100, 200), 1.0));
+        // Rendering a view again in the same frame replaces its layer tree.
+        animator->Render(kSecondViewId, second_layer_tree);
+      });
+  EXPECT_CALL(delegate, OnAnimatorUpdateLatestFrameTargetTime).Times(1);
+
+  fml::AutoResetWaitableEvent draw_latch;
+  std::vector<LayerTreeTask> tasks;
+  EXPECT_CALL(delegate, OnAnimatorDraw)
+      .WillOnce([&](std::shared_ptr<LayerTreePipeline> pipeline) {
+        auto result =
+            pipeline->Consume([&](std::unique_ptr<LayerTreeItem> item) {
+              tasks = std::move(item->layer_tree_tasks);
+            });
+        EXPECT_EQ(result, PipelineConsumeResult::Done);
+        draw_latch.Signal();
+      });
+
+  task_runners.GetUITaskRunner()->PostTask([&] {
+    animator->RequestFrame();
+    task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
+  });
+  draw_latch.Wait();
+
+  ASSERT_EQ(tasks.size(), 2u);
+  EXPECT_EQ(tasks[0].view_id, kFlutterImplicitViewId);
+  EXPECT_EQ(tasks[0].layer_tree->frame_size(), SkISize::Make(600, 800));
+  EXPECT_EQ(tasks[1].view_id, kSecondViewId);
+  EXPECT_EQ(tasks[1].layer_tree, second_layer_tree);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -10,7 +10,9 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/snapshot/snapshot.h"
@@ -103,6 +105,13 @@ Engine::Engine(Delegate& delegate,
           vm.GetConcurrentWorkerTaskRunner(),      // concurrent task runner
           settings_.enable_impeller,               // enable impeller
       });
+  font_collection_->GetFontCollection()->SetFontFallbackCacheDirectory(
+      PersistentCache::GetCacheForProcess()->DuplicateCacheDirectory());
+  if (!settings_.temp_directory_path.empty()) {
+    font_collection_->SetSubsettedFontDirectory(
+        fml::OpenDirectory(settings_.temp_directory_path.c_str(), false,
+                           fml::FilePermission::kReadWrite));
+  }
 }
 
 std::unique_ptr<Engine> Engine::Spawn(
@@ -148,9 +157,15 @@ fml::WeakPtr<Engine> Engine::GetWeakPtr() const {
 
 void Engine::SetupDefaultFontManager() {
   TRACE_EVENT0("flutter", "Engine::SetupDefaultFontManager");
+  pending_default_font_manager_ = {};
   font_collection_->SetupDefaultFontManager(settings_.font_initialization_data);
 }
 
+void Engine::SetupDefaultFontManager(
+    std::shared_future<sk_sp<SkFontMgr>> font_manager) {
+  pending_default_font_manager_ = std::move(font_manager);
+}
+
 std::shared_ptr<AssetManager> Engine::GetAssetManager() {
   return asset_manager_;
 }
@@ -221,9 +236,15 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
   // If the embedding prefetched the default font manager, then set up the
   // font manager later in the engine launch process.  This makes it less
   // likely that the setup will need to wait for the prefetch to complete.
+  // The same goes for a font manager that the shell is creating.
   auto root_isolate_create_callback = [&]() {
     if (settings_.prefetched_default_font_manager) {
       SetupDefaultFontManager();
+    } else if (pending_default_font_manager_.valid()) {
+      TRACE_EVENT0("flutter", "Engine::WaitForDefaultFontManager");
+      font_collection_->GetFontCollection()->SetDefaultFontManager(
+          pending_default_font_manager_.get());
+      pending_default_font_manager_ = {};
     }
   };
 
@@ -291,6 +312,15 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
   ScheduleFrame();
 }
 
+void Engine::AddView(int64_t view_id, const ViewportMetrics& metrics) {
+  runtime_controller_->AddView(view_id, metrics);
+  ScheduleFrame();
+}
+
+void Engine::RemoveView(int64_t view_id) {
+  runtime_controller_->RemoveView(view_id);
+}
+
 void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
   std::string channel = message->channel();
   if (channel == kLifecycleChannel) {
@@ -319,6 +349,26 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
   FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
 }
 
+void Engine::DispatchPlatformMessages(
+    const std::string& channel,
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (channel == kLifecycleChannel || channel == kLocalizationChannel ||
+      channel == kSettingsChannel || channel == kNavigationChannel ||
+      !runtime_controller_->IsRootIsolateRunning()) {
+    for (auto& message : messages) {
+      DispatchPlatformMessage(std::move(message));
+    }
+    return;
+  }
+
+  if (runtime_controller_->DispatchPlatformMessages(channel,
+                                                    std::move(messages))) {
+    return;
+  }
+
+  FML_DLOG(WARNING) << "Dropping platform messages on channel: " << channel;
+}
+
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
   std::string state(reinterpret_cast<const char*>(data.GetMapping()),
@@ -413,9 +463,18 @@ void Engine::DispatchPointerDataPacket(
     uint64_t trace_flow_id) {
   TRACE_EVENT0("flutter", "Engine::DispatchPointerDataPacket");
   TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+  animator_->RecordInput(fml::TimePoint::Now());
+  if (pointer_late_latch_) {
+    pointer_late_latch_->OnPointersDispatched(*packet);
+  }
   pointer_data_dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
 }
 
+void Engine::SetPointerLateLatch(
+    std::shared_ptr<PointerLateLatch> pointer_late_latch) {
+  pointer_late_latch_ = std::move(pointer_late_latch);
+}
+
 void Engine::DispatchSemanticsAction(int node_id,
                                      SemanticsAction action,
                                      fml::MallocMapping args) {
@@ -442,7 +501,8 @@ void Engine::ScheduleFrame(bool regenerate_layer_tree) {
   animator_->RequestFrame(regenerate_layer_tree);
 }
 
-void Engine::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
+void Engine::Render(int64_t view_id,
+                    std::shared_ptr<flutter::LayerTree> layer_tree) {
   if (!layer_tree) {
     return;
   }
@@ -453,7 +513,12 @@ void Engine::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
     return;
   }
 
-  animator_->Render(std::move(layer_tree));
+  if (pointer_late_latch_) {
+    layer_tree->set_built_pointer_position(
+        pointer_late_latch_->GetDispatchedPosition());
+  }
+
+  animator_->Render(view_id, std::move(layer_tree));
 }
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
@@ -504,6 +569,11 @@ void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
 }
 
+bool Engine::ScheduleBeginFrameCallback(uintptr_t id,
+                                        const fml::closure& callback) {
+  return animator_->ScheduleBeginFrameCallback(id, callback);
+}
+
 void Engine::HandleAssetPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   fml::RefPtr<PlatformMessageResponse> response = message->response();
@@ -548,6 +618,16 @@ std::weak_ptr<PlatformMessageHandler> Engine::GetPlatformMessageHandler()
   return delegate_.GetPlatformMessageHandler();
 }
 
+std::weak_ptr<PlatformMessagePortRouter> Engine::GetPlatformMessagePortRouter()
+    const {
+  return delegate_.GetPlatformMessagePortRouter();
+}
+
+std::weak_ptr<SharedRingBufferRegistry> Engine::GetSharedRingBufferRegistry()
+    const {
+  return delegate_.GetSharedRingBufferRegistry();
+}
+
 void Engine::LoadDartDeferredLibrary(
     intptr_t loading_unit_id,
     std::unique_ptr<const fml::Mapping> snapshot_data,
@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_ENGINE_H_
 #define SHELL_COMMON_ENGINE_H_
 
+#include <future>
 #include <memory>
 #include <string>
 
@@ -29,9 +30,11 @@
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
+#include "flutter/shell/common/pointer_late_latch.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
 namespace flutter {
@@ -294,6 +297,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
     ///        Flutter to the host platform (and its responses).
     virtual const std::shared_ptr<PlatformMessageHandler>&
     GetPlatformMessageHandler() const = 0;
+
+    //----------------------------------------------------------------------------
+    /// @brief Returns the router of the PlatformMessage's from the host
+    ///        platform to the ports of background isolates.
+    virtual const std::shared_ptr<PlatformMessagePortRouter>&
+    GetPlatformMessagePortRouter() const = 0;
+
+    //----------------------------------------------------------------------------
+    /// @brief Returns the ring buffers in memory that the embedder shares
+    ///        with Dart.
+    virtual const std::shared_ptr<SharedRingBufferRegistry>&
+    GetSharedRingBufferRegistry() const = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -445,6 +460,17 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetupDefaultFontManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Setup the default font manager with one that is created on
+  ///             another thread, so that loading the system fonts overlaps
+  ///             with the rest of the startup. The engine waits for it right
+  ///             after the root isolate is created, before any Dart code runs.
+  ///
+  /// @param[in]  font_manager  The font manager, once it is created.
+  ///
+  void SetupDefaultFontManager(
+      std::shared_future<sk_sp<SkFontMgr>> font_manager);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the asset manager referenced by the root isolate of a
   ///             Flutter application. This happens implicitly in the call to
@@ -685,6 +711,24 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a view besides the implicit one to the running Flutter
+  ///             application, or updates the metrics of a view that was
+  ///             added. The frames of all the views are scheduled together.
+  ///
+  /// @param[in]  view_id  The ID of the view. It must not be the ID of the
+  ///                      implicit view.
+  /// @param[in]  metrics  The viewport metrics of the view.
+  ///
+  void AddView(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a view added by |AddView|.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  ///
+  void RemoveView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a message.
   ///             This call originates in the platform view and has been
@@ -695,6 +739,23 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it a batch of
+  ///             messages on one channel. The shell coalesces the messages on
+  ///             the channels in `Settings::batched_platform_message_channels`
+  ///             and forwards them here on the UI task runner, so that they
+  ///             are handed to the framework with a single call into Dart.
+  ///             The messages on the channels that the engine handles itself
+  ///             are dispatched one at a time.
+  ///
+  /// @param[in]  channel   The channel all of the messages were sent on.
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application, in order.
+  ///
+  void DispatchPlatformMessages(
+      const std::string& channel,
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -716,6 +777,17 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet,
                                  uint64_t trace_flow_id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the pointer tracking that is told about the pointer
+  ///             events dispatched to the framework, and that the layer trees
+  ///             rendered by the framework record the pointer position of,
+  ///             see |Settings::late_latch_pointer_transforms|.
+  ///
+  /// @param[in]  pointer_late_latch  The pointer tracking of the shell.
+  ///
+  void SetPointerLateLatch(
+      std::shared_ptr<PointerLateLatch> pointer_late_latch);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder encountered an
   ///             accessibility related action on the specified node. This call
@@ -791,6 +863,10 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback) override;
 
+  // |PointerDataDispatcher::Delegate|
+  bool ScheduleBeginFrameCallback(uintptr_t id,
+                                  const fml::closure& callback) override;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
   ///             when |Engine::Run| was called.
@@ -892,7 +968,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string DefaultRouteName() override;
 
   // |RuntimeDelegate|
-  void Render(std::shared_ptr<flutter::LayerTree> layer_tree) override;
+  void Render(int64_t view_id,
+              std::shared_ptr<flutter::LayerTree> layer_tree) override;
 
   // |RuntimeDelegate|
   void UpdateSemantics(SemanticsNodeUpdates update,
@@ -919,6 +996,14 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::weak_ptr<PlatformMessageHandler> GetPlatformMessageHandler()
       const override;
 
+  // |RuntimeDelegate|
+  std::weak_ptr<PlatformMessagePortRouter> GetPlatformMessagePortRouter()
+      const override;
+
+  // |RuntimeDelegate|
+  std::weak_ptr<SharedRingBufferRegistry> GetSharedRingBufferRegistry()
+      const override;
+
   void SetNeedsReportTimings(bool value) override;
 
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
@@ -945,6 +1030,7 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   // So it should be defined after them to ensure that pointer_data_dispatcher_
   // is destructed first.
   std::unique_ptr<PointerDataDispatcher> pointer_data_dispatcher_;
+  std::shared_ptr<PointerLateLatch> pointer_late_latch_;
 
   std::string last_entry_point_;
   std::string last_entry_point_library_;
@@ -952,6 +1038,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string initial_route_;
   std::shared_ptr<AssetManager> asset_manager_;
   std::shared_ptr<FontCollection> font_collection_;
+  // The default font manager that is being created on another thread, if
+  // any.
+  std::shared_future<sk_sp<SkFontMgr>> pending_default_font_manager_;
   const std::unique_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
   TaskRunners task_runners_;
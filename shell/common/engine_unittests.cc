@@ -38,6 +38,10 @@ class MockDelegate : public Engine::Delegate {
   MOCK_METHOD0(GetCurrentTimePoint, fml::TimePoint());
   MOCK_CONST_METHOD0(GetPlatformMessageHandler,
                      const std::shared_ptr<PlatformMessageHandler>&());
+  MOCK_CONST_METHOD0(GetPlatformMessagePortRouter,
+                     const std::shared_ptr<PlatformMessagePortRouter>&());
+  MOCK_CONST_METHOD0(GetSharedRingBufferRegistry,
+                     const std::shared_ptr<SharedRingBufferRegistry>&());
 };
 
 class MockResponse : public PlatformMessageResponse {
@@ -50,7 +54,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
  public:
   MOCK_METHOD0(DefaultRouteName, std::string());
   MOCK_METHOD1(ScheduleFrame, void(bool));
-  MOCK_METHOD1(Render, void(std::shared_ptr<flutter::LayerTree>));
+  MOCK_METHOD2(Render, void(int64_t, std::shared_ptr<flutter::LayerTree>));
   MOCK_METHOD2(UpdateSemantics,
                void(SemanticsNodeUpdates, CustomAccessibilityActionUpdates));
   MOCK_METHOD1(HandlePlatformMessage, void(std::unique_ptr<PlatformMessage>));
@@ -65,6 +69,10 @@ class MockRuntimeDelegate : public RuntimeDelegate {
   MOCK_METHOD1(RequestDartDeferredLibrary, void(intptr_t));
   MOCK_CONST_METHOD0(GetPlatformMessageHandler,
                      std::weak_ptr<PlatformMessageHandler>());
+  MOCK_CONST_METHOD0(GetPlatformMessagePortRouter,
+                     std::weak_ptr<PlatformMessagePortRouter>());
+  MOCK_CONST_METHOD0(GetSharedRingBufferRegistry,
+                     std::weak_ptr<SharedRingBufferRegistry>());
 };
 
 class MockRuntimeController : public RuntimeController {
@@ -74,6 +82,9 @@ class MockRuntimeController : public RuntimeController {
       : RuntimeController(client, p_task_runners) {}
   MOCK_METHOD0(IsRootIsolateRunning, bool());
   MOCK_METHOD1(DispatchPlatformMessage, bool(std::unique_ptr<PlatformMessage>));
+  MOCK_METHOD2(DispatchPlatformMessages,
+               bool(const std::string&,
+                    std::vector<std::unique_ptr<PlatformMessage>>));
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t, const std::string, bool));
   MOCK_CONST_METHOD0(GetDartVM, DartVM*());
@@ -256,6 +267,73 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
   });
 }
 
+TEST_F(EngineTest, DispatchPlatformMessagesDispatchesBatch) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*mock_runtime_controller, DispatchPlatformMessage(::testing::_))
+        .Times(0);
+    EXPECT_CALL(*mock_runtime_controller,
+                DispatchPlatformMessages("foo", ::testing::SizeIs(3)))
+        .WillOnce(::testing::Return(true));
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+    for (int i = 0; i < 3; i++) {
+      messages.push_back(std::make_unique<PlatformMessage>(
+          "foo", fml::MakeRefCounted<MockResponse>()));
+    }
+    engine->DispatchPlatformMessages("foo", std::move(messages));
+  });
+}
+
+TEST_F(EngineTest, DispatchPlatformMessagesHandlesEngineChannelsInOrder) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(false));
+    EXPECT_CALL(*mock_runtime_controller,
+                DispatchPlatformMessages(::testing::_, ::testing::_))
+        .Times(0);
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+    for (const auto* route : {"first_route", "second_route"}) {
+      std::map<std::string, std::string> values{
+          {"method", "setInitialRoute"},
+          {"args", route},
+      };
+      messages.push_back(MakePlatformMessage(
+          "flutter/navigation", values, fml::MakeRefCounted<MockResponse>()));
+    }
+    engine->DispatchPlatformMessages("flutter/navigation", std::move(messages));
+    EXPECT_EQ(engine->InitialRoute(), "second_route");
+  });
+}
+
 TEST_F(EngineTest, SpawnSharesFontLibrary) {
   PostUITaskSync([this] {
     MockRuntimeDelegate client;
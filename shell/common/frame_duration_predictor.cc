@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_duration_predictor.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+FrameDurationPredictor::FrameDurationPredictor() = default;
+
+FrameDurationPredictor::~FrameDurationPredictor() = default;
+
+void FrameDurationPredictor::AddFrameTiming(const FrameTiming& timing) {
+  const auto duration = timing.Get(FrameTiming::kRasterFinish) -
+                        timing.Get(FrameTiming::kBuildStart);
+  if (duration < fml::TimeDelta::Zero()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  durations_.push_back(duration);
+  if (durations_.size() > kSampleCount) {
+    durations_.pop_front();
+  }
+}
+
+std::optional<fml::TimeDelta> FrameDurationPredictor::PredictFrameDuration()
+    const {
+  std::scoped_lock lock(mutex_);
+  if (durations_.size() < kMinSampleCount) {
+    return std::nullopt;
+  }
+  return *std::max_element(durations_.begin(), durations_.end()) +
+         kSafetyMargin;
+}
+
+}  // namespace flutter
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_DURATION_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_DURATION_PREDICTOR_H_
+
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Predicts how long the next frame takes from the start of its build to the
+/// end of its rasterization, using the timings of the recent frames.
+///
+/// Timings are added on the raster thread and predictions are made on the UI
+/// thread. This class is thread safe.
+///
+class FrameDurationPredictor {
+ public:
+  /// The number of recent frames predictions are based on.
+  static constexpr size_t kSampleCount = 30u;
+
+  /// The number of frames that must have been rasterized before predictions
+  /// are made.
+  static constexpr size_t kMinSampleCount = 8u;
+
+  /// Added to every prediction to absorb the jitter of scheduling the start
+  /// of the frame.
+  static constexpr fml::TimeDelta kSafetyMargin =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  FrameDurationPredictor();
+
+  ~FrameDurationPredictor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timing of a frame that was just rasterized.
+  ///
+  void AddFrameTiming(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Predicts the duration from the start of the build to the end
+  ///             of the rasterization of the next frame.
+  ///
+  ///             This is the longest duration among the recent frames plus a
+  ///             safety margin. Starting the frame this long before its
+  ///             deadline delays it as much as possible without dropping it
+  ///             if the workload stays similar.
+  ///
+  /// @return     The predicted duration or `std::nullopt` if not enough
+  ///             frames have been rasterized yet.
+  ///
+  std::optional<fml::TimeDelta> PredictFrameDuration() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<fml::TimeDelta> durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameDurationPredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_DURATION_PREDICTOR_H_
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_duration_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+FrameTiming CreateFrameTiming(fml::TimeDelta duration) {
+  FrameTiming timing;
+  const auto build_start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kRasterFinish, build_start + duration);
+  return timing;
+}
+
+}  // namespace
+
+TEST(FrameDurationPredictorTest, NoPredictionWithoutEnoughFrames) {
+  FrameDurationPredictor predictor;
+  for (size_t i = 0; i < FrameDurationPredictor::kMinSampleCount - 1; i++) {
+    predictor.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(4)));
+    ASSERT_FALSE(predictor.PredictFrameDuration().has_value());
+  }
+  predictor.AddFrameTiming(
+      CreateFrameTiming(fml::TimeDelta::FromMilliseconds(4)));
+  ASSERT_TRUE(predictor.PredictFrameDuration().has_value());
+}
+
+TEST(FrameDurationPredictorTest, PredictsLongestRecentFrame) {
+  FrameDurationPredictor predictor;
+  for (size_t i = 0; i < FrameDurationPredictor::kMinSampleCount; i++) {
+    predictor.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(i == 3 ? 9 : 4)));
+  }
+  ASSERT_EQ(predictor.PredictFrameDuration().value(),
+            fml::TimeDelta::FromMilliseconds(9) +
+                FrameDurationPredictor::kSafetyMargin);
+}
+
+TEST(FrameDurationPredictorTest, ForgetsOldFrames) {
+  FrameDurationPredictor predictor;
+  predictor.AddFrameTiming(
+      CreateFrameTiming(fml::TimeDelta::FromMilliseconds(20)));
+  for (size_t i = 0; i < FrameDurationPredictor::kSampleCount; i++) {
+    predictor.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(4)));
+  }
+  ASSERT_EQ(predictor.PredictFrameDuration().value(),
+            fml::TimeDelta::FromMilliseconds(4) +
+                FrameDurationPredictor::kSafetyMargin);
+}
+
+}  // namespace testing
+}  // namespace flutter
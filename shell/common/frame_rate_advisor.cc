@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_rate_advisor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace flutter {
+
+FrameRateAdvisor::FrameRateAdvisor() = default;
+
+FrameRateAdvisor::~FrameRateAdvisor() = default;
+
+void FrameRateAdvisor::AddFrame(fml::TimePoint vsync_start_time,
+                                fml::TimePoint vsync_target_time,
+                                bool has_input) {
+  // The vsyncs only come at the full refresh rate while no rate is preferred.
+  if (vsyncs_per_frame_ == 1u) {
+    const auto period = vsync_target_time - vsync_start_time;
+    if (period > fml::TimeDelta::Zero()) {
+      display_period_ = period;
+    }
+  }
+
+  if (has_input || !last_frame_start_time_.has_value() ||
+      vsync_start_time - *last_frame_start_time_ > kIdleTimeout) {
+    Reset();
+    last_frame_start_time_ = vsync_start_time;
+    return;
+  }
+  intervals_.push_back(vsync_start_time - *last_frame_start_time_);
+  if (intervals_.size() > kSampleCount) {
+    intervals_.pop_front();
+  }
+  last_frame_start_time_ = vsync_start_time;
+  if (intervals_.size() < kSampleCount || !display_period_.has_value()) {
+    return;
+  }
+
+  // The second shortest interval, so that a single frame that begins early
+  // doesn't ask for the full rate.
+  std::vector<fml::TimeDelta> sorted(intervals_.begin(), intervals_.end());
+  std::nth_element(sorted.begin(), sorted.begin() + 1, sorted.end());
+  const double periods = sorted[1].ToSecondsF() / display_period_->ToSecondsF();
+  const double display_rate = 1.0 / display_period_->ToSecondsF();
+  const size_t max_vsyncs_per_frame = std::max<size_t>(
+      1u, static_cast<size_t>(std::floor(display_rate / kMinFrameRate)));
+  const size_t vsyncs_per_frame = std::clamp<size_t>(
+      static_cast<size_t>(std::floor(periods + 0.25)), 1u,
+      max_vsyncs_per_frame);
+
+  if (vsyncs_per_frame > 1u && vsyncs_per_frame == vsyncs_per_frame_ &&
+      ++saturated_frame_count_ >= kSaturatedFrameCount) {
+    Reset();
+    return;
+  }
+  SetVsyncsPerFrame(vsyncs_per_frame);
+}
+
+void FrameRateAdvisor::OnIdle() {
+  if (!display_period_.has_value()) {
+    return;
+  }
+  intervals_.clear();
+  last_frame_start_time_.reset();
+  const double display_rate = 1.0 / display_period_->ToSecondsF();
+  SetVsyncsPerFrame(std::max<size_t>(
+      1u, static_cast<size_t>(std::floor(display_rate / kMinFrameRate))));
+}
+
+void FrameRateAdvisor::Reset() {
+  intervals_.clear();
+  SetVsyncsPerFrame(1u);
+}
+
+void FrameRateAdvisor::SetVsyncsPerFrame(size_t vsyncs_per_frame) {
+  if (vsyncs_per_frame == vsyncs_per_frame_) {
+    return;
+  }
+  vsyncs_per_frame_ = vsyncs_per_frame;
+  saturated_frame_count_ = 0u;
+  if (vsyncs_per_frame == 1u || !display_period_.has_value()) {
+    preferred_frame_rate_ = 0.0;
+  } else {
+    preferred_frame_rate_ =
+        1.0 / (display_period_->ToSecondsF() * vsyncs_per_frame);
+  }
+}
+
+}  // namespace flutter
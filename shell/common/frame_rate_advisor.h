@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_RATE_ADVISOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_RATE_ADVISOR_H_
+
+#include <deque>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Chooses the frame rate to ask the display for from the frames the animator
+/// actually produces.
+///
+/// * Content that is updated at a fraction of the refresh rate of the display,
+///   such as a 30Hz video on a 120Hz panel, gets that fraction.
+/// * Input asks for the full refresh rate right away, so that scrolls and
+///   drags are as smooth as the display allows.
+/// * While nothing is animating, the lowest rate is asked for.
+///
+/// A display that runs at the preferred rate can't show whether the content
+/// would be updated more often, so the full rate is asked for again after
+/// `kSaturatedFrameCount` frames that were produced for every vsync, and the
+/// rate is measured anew.
+///
+/// The full refresh rate of the display is taken from the vsyncs that are
+/// received while no rate is preferred.
+///
+/// This class is used on the UI thread and is not thread safe.
+///
+class FrameRateAdvisor {
+ public:
+  /// The number of intervals between frames the rate is chosen from.
+  static constexpr size_t kSampleCount = 8u;
+
+  /// The number of frames produced for every vsync at a preferred rate that
+  /// are waited for before the full rate is measured again.
+  static constexpr size_t kSaturatedFrameCount = 120u;
+
+  /// No rate lower than this is asked for.
+  static constexpr double kMinFrameRate = 30.0;
+
+  /// Frames that begin this long after the previous one start a new series.
+  static constexpr fml::TimeDelta kIdleTimeout =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  FrameRateAdvisor();
+
+  ~FrameRateAdvisor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a frame that begins for a vsync.
+  ///
+  /// @param[in]  vsync_start_time   The start time of the vsync.
+  /// @param[in]  vsync_target_time  The target time of the vsync.
+  /// @param[in]  has_input          Whether input was received for the frame.
+  ///
+  void AddFrame(fml::TimePoint vsync_start_time,
+                fml::TimePoint vsync_target_time,
+                bool has_input);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records that no frame has been produced for a while.
+  ///
+  void OnIdle();
+
+  //----------------------------------------------------------------------------
+  /// @return     The frame rate the display should run at in frames per
+  ///             second, or 0 for its full refresh rate.
+  ///
+  double GetPreferredFrameRate() const { return preferred_frame_rate_; }
+
+ private:
+  // The interval between the vsyncs of the display at its full refresh rate.
+  std::optional<fml::TimeDelta> display_period_;
+  std::optional<fml::TimePoint> last_frame_start_time_;
+  std::deque<fml::TimeDelta> intervals_;
+  // The number of vsyncs of the display at its full rate per frame at the
+  // preferred rate, which is 1 while no rate is preferred.
+  size_t vsyncs_per_frame_ = 1u;
+  size_t saturated_frame_count_ = 0u;
+  double preferred_frame_rate_ = 0.0;
+
+  // Asks for the full refresh rate and forgets the intervals.
+  void Reset();
+
+  void SetVsyncsPerFrame(size_t vsyncs_per_frame);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameRateAdvisor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_RATE_ADVISOR_H_
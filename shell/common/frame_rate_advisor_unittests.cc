@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_rate_advisor.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// A 120Hz display.
+constexpr fml::TimeDelta kDisplayPeriod =
+    fml::TimeDelta::FromMicroseconds(8333);
+
+// Produces frames for the vsyncs of a display that runs at the rate preferred
+// by the advisor.
+class FakeDisplay {
+ public:
+  explicit FakeDisplay(FrameRateAdvisor& advisor) : advisor_(advisor) {}
+
+  void AddFrames(size_t count, int64_t vsyncs_per_frame, bool input = false) {
+    for (size_t i = 0; i < count; i++) {
+      const double rate = advisor_.GetPreferredFrameRate();
+      // The vsyncs of the display at its full rate between those it sends.
+      const int64_t display_vsyncs =
+          rate == 0.0 ? 1 : std::llround(1.0 / (kDisplayPeriod.ToSecondsF() *
+                                                rate));
+      now_ = now_ + kDisplayPeriod * vsyncs_per_frame;
+      advisor_.AddFrame(now_, now_ + kDisplayPeriod * display_vsyncs, input);
+    }
+  }
+
+ private:
+  FrameRateAdvisor& advisor_;
+  fml::TimePoint now_ =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(1));
+};
+
+}  // namespace
+
+TEST(FrameRateAdvisorTest, HasNoPreferenceForContentUpdatedEveryVsync) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(FrameRateAdvisor::kSampleCount * 3, 1);
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+}
+
+TEST(FrameRateAdvisorTest, PrefersTheRateTheContentIsUpdatedAt) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(1, 1);
+  display.AddFrames(FrameRateAdvisor::kSampleCount - 1, 2);
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+  display.AddFrames(1, 2);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 60.0, 0.1);
+}
+
+TEST(FrameRateAdvisorTest, IgnoresASingleFrameThatBeginsEarly) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(FrameRateAdvisor::kSampleCount + 1, 4);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 30.0, 0.1);
+  display.AddFrames(1, 1);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 30.0, 0.1);
+}
+
+TEST(FrameRateAdvisorTest, DoesNotPreferARateBelowTheMinimum) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(1, 1);
+  display.AddFrames(FrameRateAdvisor::kSampleCount, 8);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(),
+              FrameRateAdvisor::kMinFrameRate, 0.1);
+}
+
+TEST(FrameRateAdvisorTest, InputAsksForTheFullRate) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(FrameRateAdvisor::kSampleCount + 1, 2);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 60.0, 0.1);
+  display.AddFrames(1, 2, /*input=*/true);
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+}
+
+TEST(FrameRateAdvisorTest, IdlingAsksForTheMinimumRateUntilTheNextFrame) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(2, 1);
+  advisor.OnIdle();
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(),
+              FrameRateAdvisor::kMinFrameRate, 0.1);
+  display.AddFrames(1, 4);
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+}
+
+TEST(FrameRateAdvisorTest, DoesNotIdleBeforeTheDisplayRateIsKnown) {
+  FrameRateAdvisor advisor;
+  advisor.OnIdle();
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+}
+
+TEST(FrameRateAdvisorTest, AFrameAfterAGapAsksForTheFullRate) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(FrameRateAdvisor::kSampleCount + 1, 2);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 60.0, 0.1);
+  display.AddFrames(1, 20);
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+}
+
+TEST(FrameRateAdvisorTest, MeasuresTheFullRateAgainWhenSaturated) {
+  FrameRateAdvisor advisor;
+  FakeDisplay display(advisor);
+  display.AddFrames(FrameRateAdvisor::kSampleCount + 1, 2);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 60.0, 0.1);
+  display.AddFrames(FrameRateAdvisor::kSaturatedFrameCount - 1, 2);
+  EXPECT_NEAR(advisor.GetPreferredFrameRate(), 60.0, 0.1);
+  display.AddFrames(1, 2);
+  EXPECT_EQ(advisor.GetPreferredFrameRate(), 0.0);
+}
+
+}  // namespace testing
+}  // namespace flutter
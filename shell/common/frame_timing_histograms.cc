@@ -0,0 +1,190 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_histograms.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kLinearBucketCount = 8u;
+constexpr size_t kSubBucketBits = 3u;
+constexpr size_t kSubBucketCount = 1u << kSubBucketBits;
+constexpr size_t kMaxExponent = 39u;
+
+// The number of attempts to read a window while the raster thread is
+// starting a new one before giving up.
+constexpr int kMaxReadAttempts = 3;
+
+uint64_t ToNonNegativeMicroseconds(fml::TimeDelta delta) {
+  return static_cast<uint64_t>(std::max<int64_t>(delta.ToMicroseconds(), 0));
+}
+
+}  // namespace
+
+FrameTimingHistograms::FrameTimingHistograms() = default;
+
+FrameTimingHistograms::~FrameTimingHistograms() = default;
+
+size_t FrameTimingHistograms::BucketForValue(uint64_t value) {
+  if (value < kLinearBucketCount) {
+    return value;
+  }
+  size_t exponent = kSubBucketBits;
+  while (exponent < kMaxExponent && (value >> (exponent + 1)) != 0) {
+    exponent++;
+  }
+  if ((value >> (exponent + 1)) != 0) {
+    return kBucketCount - 1;
+  }
+  size_t sub_bucket =
+      (value >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+  return kLinearBucketCount + (exponent - kSubBucketBits) * kSubBucketCount +
+         sub_bucket;
+}
+
+uint64_t FrameTimingHistograms::ValueForBucket(size_t bucket) {
+  if (bucket < kLinearBucketCount) {
+    return bucket;
+  }
+  size_t exponent = (bucket - kLinearBucketCount) / kSubBucketCount +
+                    kSubBucketBits;
+  size_t sub_bucket = (bucket - kLinearBucketCount) % kSubBucketCount;
+  uint64_t width = uint64_t{1} << (exponent - kSubBucketBits);
+  return (kSubBucketCount + sub_bucket) * width + width / 2;
+}
+
+void FrameTimingHistograms::AddFrameTiming(const FrameTiming& timing,
+                                           fml::Milliseconds frame_budget) {
+  const fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+  const int64_t window = raster_finish.ToEpochDelta().ToMicroseconds() /
+                         kWindowDuration.ToMicroseconds();
+  const int64_t current_window =
+      current_window_.load(std::memory_order_relaxed);
+  if (window < current_window) {
+    return;
+  }
+
+  Slot& slot = slots_[window % 2];
+  if (window != current_window) {
+    // Readers that see the window index change while they copy the counts
+    // discard their copy.
+    slot.window.store(-1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (auto& counts : slot.counts) {
+      for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+      }
+    }
+    slot.window.store(window, std::memory_order_release);
+    current_window_.store(window, std::memory_order_release);
+  }
+
+  const fml::TimeDelta budget =
+      fml::TimeDelta::FromMillisecondsF(frame_budget.count());
+  const uint64_t values[kMetricCount] = {
+      ToNonNegativeMicroseconds(timing.Get(FrameTiming::kBuildFinish) -
+                                timing.Get(FrameTiming::kBuildStart)),
+      ToNonNegativeMicroseconds(raster_finish -
+                                timing.Get(FrameTiming::kRasterStart)),
+      ToNonNegativeMicroseconds(
+          raster_finish - (timing.Get(FrameTiming::kVsyncStart) + budget)),
+      timing.GetLayerCacheBytes() + timing.GetPictureCacheBytes(),
+      ToNonNegativeMicroseconds(timing.GetInputLatency()),
+  };
+  for (size_t metric = 0; metric < kMetricCount; metric++) {
+    if (metric == static_cast<size_t>(Metric::kInputLatency) &&
+        timing.GetInputLatency() == fml::TimeDelta::Zero()) {
+      continue;
+    }
+    slot.counts[metric][BucketForValue(values[metric])].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+std::optional<FrameTimingHistograms::Window>
+FrameTimingHistograms::GetLastCompletedWindow() const {
+  const int64_t current_window =
+      current_window_.load(std::memory_order_acquire);
+  if (current_window < 1) {
+    return std::nullopt;
+  }
+  return ReadWindow(current_window - 1);
+}
+
+std::optional<FrameTimingHistograms::Window>
+FrameTimingHistograms::GetCurrentWindow() const {
+  const int64_t current_window =
+      current_window_.load(std::memory_order_acquire);
+  if (current_window < 0) {
+    return std::nullopt;
+  }
+  return ReadWindow(current_window);
+}
+
+std::optional<FrameTimingHistograms::Window> FrameTimingHistograms::ReadWindow(
+    int64_t window) const {
+  const Slot& slot = slots_[window % 2];
+  std::array<std::array<uint64_t, kBucketCount>, kMetricCount> counts;
+  for (int attempt = 0; attempt < kMaxReadAttempts; attempt++) {
+    if (slot.window.load(std::memory_order_acquire) != window) {
+      return std::nullopt;
+    }
+    for (size_t metric = 0; metric < kMetricCount; metric++) {
+      for (size_t bucket = 0; bucket < kBucketCount; bucket++) {
+        counts[metric][bucket] =
+            slot.counts[metric][bucket].load(std::memory_order_relaxed);
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.window.load(std::memory_order_relaxed) != window) {
+      continue;
+    }
+
+    Window result;
+    result.start = fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromMicroseconds(window *
+                                         kWindowDuration.ToMicroseconds()));
+    for (size_t metric = 0; metric < kMetricCount; metric++) {
+      uint64_t total = 0;
+      for (uint64_t count : counts[metric]) {
+        total += count;
+      }
+      if (metric == 0) {
+        result.frame_count = total;
+      }
+      if (total == 0) {
+        continue;
+      }
+      // The rank of each percentile among the counted values, starting at 1.
+      const uint64_t ranks[3] = {
+          (total * 50 + 99) / 100,
+          (total * 90 + 99) / 100,
+          (total * 99 + 99) / 100,
+      };
+      uint64_t* results[3] = {
+          &result.percentiles[metric].p50,
+          &result.percentiles[metric].p90,
+          &result.percentiles[metric].p99,
+      };
+      size_t next = 0;
+      uint64_t cumulative = 0;
+      for (size_t bucket = 0; bucket < kBucketCount && next < 3; bucket++) {
+        cumulative += counts[metric][bucket];
+        while (next < 3 && cumulative >= ranks[next]) {
+          *results[next++] = ValueForBucket(bucket);
+        }
+      }
+    }
+    if (result.frame_count == 0) {
+      return std::nullopt;
+    }
+    return result;
+  }
+  return std::nullopt;
+}
+
+}  // namespace flutter
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_TIMING_HISTOGRAMS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_TIMING_HISTOGRAMS_H_
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Aggregates the timings of the rasterized frames into histograms over
+/// fixed windows of time, so that the percentiles of a window can be
+/// reported without keeping or sending the timings of every frame.
+///
+/// The values of a metric are counted in buckets whose width grows with the
+/// value, so that a percentile is within 1/16th of the value it reports.
+///
+/// Timings are added on the raster thread only. The percentiles may be read
+/// from any thread. Neither adding nor reading takes a lock. A read that
+/// overlaps with the start of a new window is retried.
+///
+class FrameTimingHistograms {
+ public:
+  enum class Metric {
+    /// The duration of the build of the frame, in microseconds.
+    kBuildDuration,
+    /// The duration of the rasterization of the frame, in microseconds.
+    kRasterDuration,
+    /// How long after the end of its frame interval the rasterization of the
+    /// frame finished, in microseconds. Zero for frames that were on time.
+    kVsyncOverrun,
+    /// The bytes held by the layer and picture raster caches.
+    kRasterCacheBytes,
+    /// The time from the earliest input handled in the frame until the end
+    /// of its rasterization, in microseconds. Only frames that handled input
+    /// are counted.
+    kInputLatency,
+  };
+  static constexpr size_t kMetricCount = 5u;
+
+  /// The duration of the windows that the percentiles are reported for.
+  static constexpr fml::TimeDelta kWindowDuration =
+      fml::TimeDelta::FromSeconds(10);
+
+  struct Percentiles {
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+  };
+
+  struct Window {
+    /// The time at which the window started.
+    fml::TimePoint start;
+    /// The number of frames that finished rasterizing in the window.
+    uint64_t frame_count = 0;
+    std::array<Percentiles, kMetricCount> percentiles;
+
+    const Percentiles& Get(Metric metric) const {
+      return percentiles[static_cast<size_t>(metric)];
+    }
+  };
+
+  FrameTimingHistograms();
+
+  ~FrameTimingHistograms();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Counts the timing of a frame that was just rasterized in the
+  ///             window that its rasterization finished in.
+  ///
+  /// @param[in]  timing        The timing of the frame.
+  /// @param[in]  frame_budget  The current frame interval of the display.
+  ///
+  void AddFrameTiming(const FrameTiming& timing,
+                      fml::Milliseconds frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @return     The percentiles of the last window that has ended before
+  ///             the window of the most recently added frame, or
+  ///             `std::nullopt` if no frame was rasterized in that window.
+  ///
+  std::optional<Window> GetLastCompletedWindow() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The percentiles of the window of the most recently added
+  ///             frame so far, or `std::nullopt` if no frame was added yet.
+  ///
+  std::optional<Window> GetCurrentWindow() const;
+
+  /// The number of buckets of each histogram. Values below 8 have a bucket
+  /// each, larger values share a bucket with the values that have the same
+  /// four most significant bits. Values of 2^40 or more are counted in the
+  /// last bucket.
+  static constexpr size_t kBucketCount = 8u + 37u * 8u;
+
+  static size_t BucketForValue(uint64_t value);
+
+  /// The value a bucket reports for a percentile, which is the middle of the
+  /// range of values it counts.
+  static uint64_t ValueForBucket(size_t bucket);
+
+ private:
+  // The histograms of one window. The window index is -1 while the slot is
+  // being reset for a new window.
+  struct Slot {
+    std::atomic<int64_t> window{-1};
+    std::array<std::array<std::atomic<uint64_t>, kBucketCount>, kMetricCount>
+        counts = {};
+  };
+
+  std::optional<Window> ReadWindow(int64_t window) const;
+
+  // Two slots, for the current window and the one before it.
+  std::array<Slot, 2> slots_;
+  std::atomic<int64_t> current_window_ = -1;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingHistograms);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_TIMING_HISTOGRAMS_H_
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_timing_histograms.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::Milliseconds kFrameBudget = fml::Milliseconds(16);
+
+using Metric = FrameTimingHistograms::Metric;
+
+// Creates the timing of a frame that finishes rasterizing |window_offset|
+// after the start of window |window| of |FrameTimingHistograms|.
+FrameTiming CreateFrameTiming(int64_t window,
+                              fml::TimeDelta window_offset,
+                              int64_t build_micros,
+                              int64_t raster_micros,
+                              size_t cache_bytes = 0) {
+  FrameTiming timing;
+  const auto raster_finish = fml::TimePoint::FromEpochDelta(
+      FrameTimingHistograms::kWindowDuration * window + window_offset);
+  const auto raster_start =
+      raster_finish - fml::TimeDelta::FromMicroseconds(raster_micros);
+  const auto build_start =
+      raster_start - fml::TimeDelta::FromMicroseconds(build_micros);
+  timing.Set(FrameTiming::kVsyncStart, build_start);
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kBuildFinish, raster_start);
+  timing.Set(FrameTiming::kRasterStart, raster_start);
+  timing.Set(FrameTiming::kRasterFinish, raster_finish);
+  timing.SetRasterCacheStatistics(0, cache_bytes, 0, 0);
+  return timing;
+}
+
+}  // namespace
+
+TEST(FrameTimingHistogramsTest, BucketsAreWithinASixteenthOfTheirValues) {
+  for (uint64_t value = 0; value < 100000; value++) {
+    size_t bucket = FrameTimingHistograms::BucketForValue(value);
+    ASSERT_LT(bucket, FrameTimingHistograms::kBucketCount);
+    uint64_t reported = FrameTimingHistograms::ValueForBucket(bucket);
+    uint64_t error = reported > value ? reported - value : value - reported;
+    ASSERT_LE(error * 16, value) << value;
+  }
+  ASSERT_EQ(FrameTimingHistograms::BucketForValue(uint64_t{1} << 50),
+            FrameTimingHistograms::kBucketCount - 1);
+}
+
+TEST(FrameTimingHistogramsTest, NoWindowsWithoutFrames) {
+  FrameTimingHistograms histograms;
+  ASSERT_FALSE(histograms.GetCurrentWindow().has_value());
+  ASSERT_FALSE(histograms.GetLastCompletedWindow().has_value());
+}
+
+TEST(FrameTimingHistogramsTest, PercentilesOfTheCurrentWindow) {
+  FrameTimingHistograms histograms;
+  for (int64_t i = 1; i <= 100; i++) {
+    histograms.AddFrameTiming(
+        CreateFrameTiming(5, fml::TimeDelta::FromMilliseconds(i), i * 200,
+                          i * 10, 4096),
+        kFrameBudget);
+  }
+
+  auto window = histograms.GetCurrentWindow();
+  ASSERT_TRUE(window.has_value());
+  EXPECT_EQ(window->frame_count, 100u);
+  EXPECT_EQ(window->start.ToEpochDelta(),
+            FrameTimingHistograms::kWindowDuration * 5);
+  const auto& build = window->Get(Metric::kBuildDuration);
+  EXPECT_NEAR(build.p50, 10000, 10000 / 16);
+  EXPECT_NEAR(build.p90, 18000, 18000 / 16);
+  EXPECT_NEAR(build.p99, 19800, 19800 / 16);
+  const auto& raster = window->Get(Metric::kRasterDuration);
+  EXPECT_NEAR(raster.p50, 500, 500 / 16);
+  EXPECT_NEAR(raster.p99, 990, 990 / 16);
+  // Frames that take more than 16ms from their vsync overrun.
+  const auto& overrun = window->Get(Metric::kVsyncOverrun);
+  EXPECT_EQ(overrun.p50, 0u);
+  EXPECT_NEAR(overrun.p90, 18900 - 16000, 2900 / 16);
+  EXPECT_NEAR(overrun.p99, 20790 - 16000, 4790 / 16);
+  EXPECT_NEAR(window->Get(Metric::kRasterCacheBytes).p50, 4096, 4096 / 16);
+
+  ASSERT_FALSE(histograms.GetLastCompletedWindow().has_value());
+}
+
+TEST(FrameTimingHistogramsTest, WindowCompletesWhenTheNextOneStarts) {
+  FrameTimingHistograms histograms;
+  histograms.AddFrameTiming(
+      CreateFrameTiming(3, fml::TimeDelta::FromMilliseconds(1), 1000, 1000),
+      kFrameBudget);
+  histograms.AddFrameTiming(
+      CreateFrameTiming(4, fml::TimeDelta::FromMilliseconds(1), 2000, 2000),
+      kFrameBudget);
+
+  auto completed = histograms.GetLastCompletedWindow();
+  ASSERT_TRUE(completed.has_value());
+  EXPECT_EQ(completed->frame_count, 1u);
+  EXPECT_NEAR(completed->Get(Metric::kBuildDuration).p50, 1000, 1000 / 16);
+  auto current = histograms.GetCurrentWindow();
+  ASSERT_TRUE(current.has_value());
+  EXPECT_EQ(current->frame_count, 1u);
+  EXPECT_NEAR(current->Get(Metric::kBuildDuration).p50, 2000, 2000 / 16);
+
+  // The window after that starts with empty histograms, and the window
+  // before it had no frames.
+  histograms.AddFrameTiming(
+      CreateFrameTiming(6, fml::TimeDelta::FromMilliseconds(1), 3000, 3000),
+      kFrameBudget);
+  EXPECT_FALSE(histograms.GetLastCompletedWindow().has_value());
+  current = histograms.GetCurrentWindow();
+  ASSERT_TRUE(current.has_value());
+  EXPECT_EQ(current->frame_count, 1u);
+  EXPECT_NEAR(current->Get(Metric::kBuildDuration).p50, 3000, 3000 / 16);
+}
+
+TEST(FrameTimingHistogramsTest, IgnoresFramesOfEndedWindows) {
+  FrameTimingHistograms histograms;
+  histograms.AddFrameTiming(
+      CreateFrameTiming(4, fml::TimeDelta::FromMilliseconds(1), 1000, 1000),
+      kFrameBudget);
+  histograms.AddFrameTiming(
+      CreateFrameTiming(3, fml::TimeDelta::FromMilliseconds(1), 1000, 1000),
+      kFrameBudget);
+  EXPECT_FALSE(histograms.GetLastCompletedWindow().has_value());
+  EXPECT_EQ(histograms.GetCurrentWindow()->frame_count, 1u);
+}
+
+TEST(FrameTimingHistogramsTest, InputLatencyOfFramesThatHandledInput) {
+  FrameTimingHistograms histograms;
+  for (int64_t i = 1; i <= 10; i++) {
+    auto timing =
+        CreateFrameTiming(2, fml::TimeDelta::FromMilliseconds(i), 1000, 1000);
+    if (i % 2 == 0) {
+      timing.SetInputLatency(fml::TimeDelta::FromMilliseconds(20));
+    }
+    histograms.AddFrameTiming(timing, kFrameBudget);
+  }
+
+  auto window = histograms.GetCurrentWindow();
+  ASSERT_TRUE(window.has_value());
+  EXPECT_EQ(window->frame_count, 10u);
+  // The frames without input don't count as zero latency.
+  const auto& input_latency = window->Get(Metric::kInputLatency);
+  EXPECT_NEAR(input_latency.p50, 20000, 20000 / 16);
+  EXPECT_NEAR(input_latency.p99, 20000, 20000 / 16);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+IdleTaskQueue::IdleTaskQueue() = default;
+
+IdleTaskQueue::~IdleTaskQueue() = default;
+
+void IdleTaskQueue::Task::Run() {
+  if (!started.exchange(true)) {
+    closure();
+    closure = nullptr;
+  }
+}
+
+void IdleTaskQueue::PostTask(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                             fml::closure task,
+                             fml::TimeDelta max_delay) {
+  auto idle_task = std::make_shared<Task>();
+  idle_task->task_runner = task_runner;
+  idle_task->closure = std::move(task);
+  {
+    std::scoped_lock lock(mutex_);
+    tasks_.push_back(idle_task);
+  }
+  task_runner->PostDelayedTask(
+      [idle_task]() {
+        if (!idle_task->started) {
+          TRACE_EVENT0("flutter", "IdleTaskQueue::RunOverdueTask");
+          idle_task->Run();
+        }
+      },
+      max_delay);
+}
+
+void IdleTaskQueue::RunUntil(fml::TimePoint deadline) {
+  while (fml::TimePoint::Now() + kMinIdleTime < deadline) {
+    std::shared_ptr<Task> task = PopTask();
+    if (!task) {
+      return;
+    }
+    if (task->task_runner->RunsTasksOnCurrentThread()) {
+      TRACE_EVENT0("flutter", "IdleTaskQueue::RunTask");
+      task->Run();
+      continue;
+    }
+    // The next task is started once this one is done on its own thread.
+    task->task_runner->PostTask(
+        [weak_queue = weak_from_this(), task, deadline]() {
+          {
+            TRACE_EVENT0("flutter", "IdleTaskQueue::RunTask");
+            task->Run();
+          }
+          if (auto queue = weak_queue.lock()) {
+            queue->RunUntil(deadline);
+          }
+        });
+    return;
+  }
+}
+
+size_t IdleTaskQueue::GetPendingTaskCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto& task : tasks_) {
+    if (!task->started) {
+      count++;
+    }
+  }
+  return count;
+}
+
+std::shared_ptr<IdleTaskQueue::Task> IdleTaskQueue::PopTask() {
+  std::scoped_lock lock(mutex_);
+  while (!tasks_.empty()) {
+    std::shared_ptr<Task> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    if (!task->started) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace flutter
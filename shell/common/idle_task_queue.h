@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+#define FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A queue of deferrable engine work, such as cache writes, that is run in
+/// the idle windows between frames instead of competing with them.
+///
+/// The shell runs the queue when the animator notifies it of an idle period,
+/// after the Dart VM has been told about it. Tasks start in the order they
+/// were posted, one at a time, and none starts after the deadline of the
+/// idle period. The tasks that run on another thread than the caller of
+/// |RunUntil| are posted to their task runner one after the other.
+///
+/// A task that is still pending after its maximum delay runs anyway, so
+/// that the work is not put off forever by a continuous animation.
+///
+/// Tasks may be posted from any thread.
+///
+class IdleTaskQueue : public std::enable_shared_from_this<IdleTaskQueue> {
+ public:
+  /// The default time after which a task runs even if the engine never went
+  /// idle.
+  static constexpr fml::TimeDelta kDefaultMaxDelay =
+      fml::TimeDelta::FromSeconds(2);
+
+  /// Tasks don't start when less than this is left before the deadline.
+  static constexpr fml::TimeDelta kMinIdleTime =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  IdleTaskQueue();
+
+  ~IdleTaskQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs |task| on |task_runner| in an idle window, or after
+  ///             |max_delay| if there was none by then.
+  ///
+  void PostTask(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                fml::closure task,
+                fml::TimeDelta max_delay = kDefaultMaxDelay);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts the pending tasks until |deadline|.
+  ///
+  void RunUntil(fml::TimePoint deadline);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of tasks that have not started yet.
+  ///
+  size_t GetPendingTaskCount() const;
+
+ private:
+  struct Task {
+    fml::RefPtr<fml::TaskRunner> task_runner;
+    fml::closure closure;
+    std::atomic_bool started = false;
+
+    // Runs the task unless it already started.
+    void Run();
+  };
+
+  mutable std::mutex mutex_;
+  std::deque<std::shared_ptr<Task>> tasks_;
+
+  // Removes the first task that has not started yet.
+  std::shared_ptr<Task> PopTask();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleTaskQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_TASK_QUEUE_H_
@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_task_queue.h"
+
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kLongMaxDelay = fml::TimeDelta::FromSeconds(60);
+
+// Runs |closure| on |thread| and waits for it to finish.
+void RunOnThread(const fml::Thread& thread, const fml::closure& closure) {
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&closure, &latch]() {
+    closure();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+}  // namespace
+
+TEST(IdleTaskQueueTest, RunsTheTasksOfTheCurrentThreadInOrder) {
+  fml::Thread thread("idle");
+  auto queue = std::make_shared<IdleTaskQueue>();
+  std::vector<int> order;
+  RunOnThread(thread, [&]() {
+    for (int i = 0; i < 3; i++) {
+      queue->PostTask(
+          thread.GetTaskRunner(), [&order, i]() { order.push_back(i); },
+          kLongMaxDelay);
+    }
+    EXPECT_EQ(queue->GetPendingTaskCount(), 3u);
+    queue->RunUntil(fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10));
+  });
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+  EXPECT_EQ(queue->GetPendingTaskCount(), 0u);
+}
+
+TEST(IdleTaskQueueTest, DoesNotStartTasksAfterTheDeadline) {
+  fml::Thread thread("idle");
+  auto queue = std::make_shared<IdleTaskQueue>();
+  bool ran = false;
+  RunOnThread(thread, [&]() {
+    queue->PostTask(
+        thread.GetTaskRunner(), [&ran]() { ran = true; }, kLongMaxDelay);
+    queue->RunUntil(fml::TimePoint::Now() + IdleTaskQueue::kMinIdleTime / 2);
+  });
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(queue->GetPendingTaskCount(), 1u);
+}
+
+TEST(IdleTaskQueueTest, RunsTheTasksOfOtherThreadsOnTheirThread) {
+  fml::Thread thread("idle");
+  auto queue = std::make_shared<IdleTaskQueue>();
+  fml::AutoResetWaitableEvent latch;
+  int ran_count = 0;
+  for (int i = 0; i < 2; i++) {
+    queue->PostTask(
+        thread.GetTaskRunner(),
+        [&]() {
+          EXPECT_TRUE(thread.GetTaskRunner()->RunsTasksOnCurrentThread());
+          if (++ran_count == 2) {
+            latch.Signal();
+          }
+        },
+        kLongMaxDelay);
+  }
+  queue->RunUntil(fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10));
+  latch.Wait();
+  EXPECT_EQ(ran_count, 2);
+}
+
+TEST(IdleTaskQueueTest, RunsOverdueTasksWithoutIdleWindows) {
+  fml::Thread thread("idle");
+  auto queue = std::make_shared<IdleTaskQueue>();
+  fml::AutoResetWaitableEvent latch;
+  queue->PostTask(
+      thread.GetTaskRunner(), [&latch]() { latch.Signal(); },
+      fml::TimeDelta::FromMilliseconds(1));
+  latch.Wait();
+  EXPECT_EQ(queue->GetPendingTaskCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/jank_snapshot_recorder.h"
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace flutter {
+
+namespace {
+
+int64_t ToMicroseconds(fml::TimePoint time_point) {
+  return time_point.ToEpochDelta().ToMicroseconds();
+}
+
+const char* GetPhase(fml::tracing::RecordedTraceEvent::Type type) {
+  switch (type) {
+    case fml::tracing::RecordedTraceEvent::Type::kBegin:
+      return "B";
+    case fml::tracing::RecordedTraceEvent::Type::kEnd:
+      return "E";
+    case fml::tracing::RecordedTraceEvent::Type::kInstant:
+      return "i";
+  }
+  return "i";
+}
+
+}  // namespace
+
+JankSnapshotRecorder::JankSnapshotRecorder(fml::TimeDelta frame_budget,
+                                           fml::TimeDelta trace_duration)
+    : frame_budget_(frame_budget), trace_duration_(trace_duration) {}
+
+JankSnapshotRecorder::~JankSnapshotRecorder() = default;
+
+bool JankSnapshotRecorder::ShouldCapture(const FrameTiming& timing) {
+  const fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+  if (raster_finish - timing.Get(FrameTiming::kBuildStart) <= frame_budget_) {
+    return false;
+  }
+  if (has_captured_ && raster_finish - last_capture_ < trace_duration_) {
+    return false;
+  }
+  has_captured_ = true;
+  last_capture_ = raster_finish;
+  return true;
+}
+
+rapidjson::Value JankSnapshotRecorder::SerializeTraceEvents(
+    const std::vector<fml::tracing::TraceRecorder::ThreadRecording>&
+        recordings,
+    fml::TimePoint trace_start,
+    rapidjson::Document::AllocatorType& allocator) {
+  const int64_t start_nanos = trace_start.ToEpochDelta().ToNanoseconds();
+  rapidjson::Value events(rapidjson::kArrayType);
+  for (const auto& recording : recordings) {
+    for (const auto& recorded : recording.events) {
+      if (recorded.timestamp_nanos < start_nanos) {
+        continue;
+      }
+      rapidjson::Value event(rapidjson::kObjectType);
+      // The names are string literals, which outlive the document.
+      event.AddMember(
+          "name",
+          rapidjson::StringRef(recorded.name != nullptr ? recorded.name : ""),
+          allocator);
+      event.AddMember("ph", rapidjson::StringRef(GetPhase(recorded.type)),
+                      allocator);
+      event.AddMember<int64_t>("ts", recorded.timestamp_nanos / 1000,
+                               allocator);
+      event.AddMember<int64_t>("pid", 0, allocator);
+      event.AddMember<int64_t>("tid", recording.thread_index, allocator);
+      events.PushBack(event, allocator);
+    }
+  }
+  return events;
+}
+
+std::string JankSnapshotRecorder::Serialize(
+    const FrameTiming& timing,
+    const std::vector<fml::tracing::TraceRecorder::ThreadRecording>&
+        recordings,
+    fml::TimePoint trace_start,
+    LayerSnapshotStore* layers) {
+  rapidjson::Document document;
+  document.SetObject();
+  auto& allocator = document.GetAllocator();
+
+  document.AddMember("traceEvents",
+                     SerializeTraceEvents(recordings, trace_start, allocator),
+                     allocator);
+
+  rapidjson::Value frame(rapidjson::kObjectType);
+  frame.AddMember<uint64_t>("number", timing.GetFrameNumber(), allocator);
+  frame.AddMember<int64_t>(
+      "vsyncStart", ToMicroseconds(timing.Get(FrameTiming::kVsyncStart)),
+      allocator);
+  frame.AddMember<int64_t>(
+      "buildStart", ToMicroseconds(timing.Get(FrameTiming::kBuildStart)),
+      allocator);
+  frame.AddMember<int64_t>(
+      "buildFinish", ToMicroseconds(timing.Get(FrameTiming::kBuildFinish)),
+      allocator);
+  frame.AddMember<int64_t>(
+      "rasterStart", ToMicroseconds(timing.Get(FrameTiming::kRasterStart)),
+      allocator);
+  frame.AddMember<int64_t>(
+      "rasterFinish", ToMicroseconds(timing.Get(FrameTiming::kRasterFinish)),
+      allocator);
+  frame.AddMember<uint64_t>("layerCacheCount", timing.GetLayerCacheCount(),
+                            allocator);
+  frame.AddMember<uint64_t>("layerCacheBytes", timing.GetLayerCacheBytes(),
+                            allocator);
+  frame.AddMember<uint64_t>("pictureCacheCount",
+                            timing.GetPictureCacheCount(), allocator);
+  frame.AddMember<uint64_t>("pictureCacheBytes",
+                            timing.GetPictureCacheBytes(), allocator);
+  frame.AddMember<uint64_t>("deviceMemoryBytes",
+                            timing.GetDeviceMemoryBytes(), allocator);
+  frame.AddMember<uint64_t>("discardedFrameCount",
+                            timing.GetDiscardedFrameCount(), allocator);
+  document.AddMember("frame", frame, allocator);
+
+  rapidjson::Value layers_json(rapidjson::kArrayType);
+  if (layers != nullptr) {
+    for (const LayerSnapshotData& data : *layers) {
+      const SkRect bounds = data.GetBounds();
+      rapidjson::Value layer(rapidjson::kObjectType);
+      layer.AddMember<int64_t>("layer_unique_id", data.GetLayerUniqueId(),
+                               allocator);
+      layer.AddMember<int64_t>("cpu_duration_micros",
+                               data.GetCpuDuration().ToMicroseconds(),
+                               allocator);
+      layer.AddMember<int64_t>("gpu_duration_micros",
+                               data.GetGpuDuration().ToMicroseconds(),
+                               allocator);
+      layer.AddMember("left", bounds.fLeft, allocator);
+      layer.AddMember("top", bounds.fTop, allocator);
+      layer.AddMember("width", bounds.width(), allocator);
+      layer.AddMember("height", bounds.height(), allocator);
+      layers_json.PushBack(layer, allocator);
+    }
+  }
+  document.AddMember("layers", layers_json, allocator);
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  return buffer.GetString();
+}
+
+}  // namespace flutter
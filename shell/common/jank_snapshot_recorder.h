@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_JANK_SNAPSHOT_RECORDER_H_
+#define FLUTTER_SHELL_COMMON_JANK_SNAPSHOT_RECORDER_H_
+
+#include <string>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/flow/layer_snapshot_store.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_recorder.h"
+#include "rapidjson/document.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Decides which rasterized frames are janky enough to be snapshotted, and
+/// serializes their snapshots.
+///
+/// A snapshot is a JSON object in the Chrome trace event format, so that it
+/// can be opened as is by trace viewers. Besides the `traceEvents` kept by
+/// the |fml::tracing::TraceRecorder| during the last seconds before the
+/// frame, it holds the `frame` timing and raster cache statistics, and the
+/// rasterization times of the leaf `layers` of the frame.
+///
+/// The recorder is used on the raster thread only.
+///
+class JankSnapshotRecorder {
+ public:
+  //----------------------------------------------------------------------------
+  /// @param[in]  frame_budget    The time from the start of the build of a
+  ///                             frame to the end of its rasterization above
+  ///                             which the frame is janky.
+  /// @param[in]  trace_duration  How far back the trace events of a snapshot
+  ///                             go. At most one snapshot is captured in that
+  ///                             time, so that their traces don't overlap and
+  ///                             a run of janky frames isn't made worse by
+  ///                             snapshotting each of them.
+  ///
+  JankSnapshotRecorder(fml::TimeDelta frame_budget,
+                       fml::TimeDelta trace_duration);
+
+  ~JankSnapshotRecorder();
+
+  fml::TimeDelta GetTraceDuration() const { return trace_duration_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a snapshot should be captured for a frame that was
+  ///             just rasterized. Once this returns true, it returns false
+  ///             for the frames that finish within the trace duration.
+  ///
+  bool ShouldCapture(const FrameTiming& timing);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes the snapshot of a janky frame.
+  ///
+  /// @param[in]  timing       The timing of the frame.
+  /// @param[in]  recordings   The trace events recorded around the frame.
+  ///                          Only the ones after |trace_start| are kept.
+  /// @param[in]  trace_start  The time from which trace events are kept.
+  /// @param[in]  layers       The rasterization times of the leaf layers of
+  ///                          the frame, or nullptr if they were not measured.
+  ///
+  static std::string Serialize(
+      const FrameTiming& timing,
+      const std::vector<fml::tracing::TraceRecorder::ThreadRecording>&
+          recordings,
+      fml::TimePoint trace_start,
+      LayerSnapshotStore* layers);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Converts the recorded trace events after |trace_start| to an
+  ///             array of events in the Chrome trace event format.
+  ///
+  static rapidjson::Value SerializeTraceEvents(
+      const std::vector<fml::tracing::TraceRecorder::ThreadRecording>&
+          recordings,
+      fml::TimePoint trace_start,
+      rapidjson::Document::AllocatorType& allocator);
+
+ private:
+  const fml::TimeDelta frame_budget_;
+  const fml::TimeDelta trace_duration_;
+  fml::TimePoint last_capture_;
+  bool has_captured_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(JankSnapshotRecorder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_JANK_SNAPSHOT_RECORDER_H_
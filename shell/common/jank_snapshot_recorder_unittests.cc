@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/jank_snapshot_recorder.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameBudget = fml::TimeDelta::FromMilliseconds(100);
+constexpr fml::TimeDelta kTraceDuration = fml::TimeDelta::FromSeconds(5);
+
+// Creates the timing of a frame that finishes rasterizing at
+// |raster_finish_millis| and took |duration_millis| to build and rasterize.
+FrameTiming CreateFrameTiming(int64_t raster_finish_millis,
+                              int64_t duration_millis) {
+  FrameTiming timing;
+  const auto raster_finish = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(raster_finish_millis));
+  const auto build_start =
+      raster_finish - fml::TimeDelta::FromMilliseconds(duration_millis);
+  timing.Set(FrameTiming::kVsyncStart, build_start);
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kBuildFinish, build_start);
+  timing.Set(FrameTiming::kRasterStart, build_start);
+  timing.Set(FrameTiming::kRasterFinish, raster_finish);
+  timing.SetRasterCacheStatistics(1, 2, 3, 4);
+  timing.SetFrameNumber(7);
+  timing.SetDiscardedFrameCount(5);
+  return timing;
+}
+
+fml::tracing::RecordedTraceEvent CreateEvent(
+    const char* name,
+    int64_t millis,
+    fml::tracing::RecordedTraceEvent::Type type) {
+  fml::tracing::RecordedTraceEvent event;
+  event.name = name;
+  event.timestamp_nanos =
+      fml::TimeDelta::FromMilliseconds(millis).ToNanoseconds();
+  event.type = type;
+  return event;
+}
+
+}  // namespace
+
+TEST(JankSnapshotRecorderTest, CapturesFramesOverTheBudget) {
+  JankSnapshotRecorder recorder(kFrameBudget, kTraceDuration);
+  EXPECT_FALSE(recorder.ShouldCapture(CreateFrameTiming(1000, 16)));
+  EXPECT_FALSE(recorder.ShouldCapture(CreateFrameTiming(2000, 100)));
+  EXPECT_TRUE(recorder.ShouldCapture(CreateFrameTiming(3000, 101)));
+}
+
+TEST(JankSnapshotRecorderTest, CapturesOneFramePerTraceDuration) {
+  JankSnapshotRecorder recorder(kFrameBudget, kTraceDuration);
+  EXPECT_TRUE(recorder.ShouldCapture(CreateFrameTiming(10000, 200)));
+  EXPECT_FALSE(recorder.ShouldCapture(CreateFrameTiming(10200, 200)));
+  EXPECT_FALSE(recorder.ShouldCapture(CreateFrameTiming(14999, 200)));
+  EXPECT_TRUE(recorder.ShouldCapture(CreateFrameTiming(15000, 200)));
+}
+
+TEST(JankSnapshotRecorderTest, SerializesTheTraceEventsAfterTheStart) {
+  using Type = fml::tracing::RecordedTraceEvent::Type;
+  fml::tracing::TraceRecorder::ThreadRecording recording;
+  recording.thread_index = 3;
+  recording.events = {
+      CreateEvent("Old", 1000, Type::kBegin),
+      CreateEvent("Frame", 2000, Type::kBegin),
+      CreateEvent("Frame", 2100, Type::kEnd),
+      CreateEvent("Vsync", 2200, Type::kInstant),
+  };
+
+  rapidjson::Document document;
+  document.SetObject();
+  rapidjson::Value events = JankSnapshotRecorder::SerializeTraceEvents(
+      {recording},
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(1500)),
+      document.GetAllocator());
+
+  ASSERT_TRUE(events.IsArray());
+  ASSERT_EQ(events.Size(), 3u);
+  EXPECT_STREQ(events[0]["name"].GetString(), "Frame");
+  EXPECT_STREQ(events[0]["ph"].GetString(), "B");
+  EXPECT_EQ(events[0]["ts"].GetInt64(), 2000000);
+  EXPECT_EQ(events[0]["tid"].GetInt64(), 3);
+  EXPECT_STREQ(events[1]["ph"].GetString(), "E");
+  EXPECT_STREQ(events[2]["name"].GetString(), "Vsync");
+  EXPECT_STREQ(events[2]["ph"].GetString(), "i");
+}
+
+TEST(JankSnapshotRecorderTest, SerializesTheFrame) {
+  const FrameTiming timing = CreateFrameTiming(3000, 250);
+  const std::string snapshot = JankSnapshotRecorder::Serialize(
+      timing, {}, timing.Get(FrameTiming::kRasterFinish) - kTraceDuration,
+      nullptr);
+
+  rapidjson::Document document;
+  document.Parse(snapshot.c_str());
+  ASSERT_FALSE(document.HasParseError());
+  ASSERT_TRUE(document["traceEvents"].IsArray());
+  EXPECT_EQ(document["traceEvents"].Size(), 0u);
+  ASSERT_TRUE(document["layers"].IsArray());
+  EXPECT_EQ(document["layers"].Size(), 0u);
+
+  const auto& frame = document["frame"];
+  EXPECT_EQ(frame["number"].GetUint64(), 7u);
+  EXPECT_EQ(frame["buildStart"].GetInt64(), 2750000);
+  EXPECT_EQ(frame["rasterFinish"].GetInt64(), 3000000);
+  EXPECT_EQ(frame["layerCacheCount"].GetUint64(), 1u);
+  EXPECT_EQ(frame["layerCacheBytes"].GetUint64(), 2u);
+  EXPECT_EQ(frame["pictureCacheCount"].GetUint64(), 3u);
+  EXPECT_EQ(frame["pictureCacheBytes"].GetUint64(), 4u);
+  EXPECT_EQ(frame["discardedFrameCount"].GetUint64(), 5u);
+}
+
+}  // namespace testing
+}  // namespace flutter
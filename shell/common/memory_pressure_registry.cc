@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_pressure_registry.h"
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+MemoryPressureRegistry::MemoryPressureRegistry() = default;
+
+MemoryPressureRegistry::~MemoryPressureRegistry() = default;
+
+void MemoryPressureRegistry::Register(std::string name,
+                                      fml::RefPtr<fml::TaskRunner> task_runner,
+                                      TrimCallback trim,
+                                      ByteCountCallback get_bytes) {
+  FML_DCHECK(task_runner);
+  FML_DCHECK(trim);
+  std::scoped_lock lock(mutex_);
+  subsystems_.push_back({
+      .name = std::move(name),
+      .task_runner = std::move(task_runner),
+      .trim = std::move(trim),
+      .get_bytes = std::move(get_bytes),
+  });
+}
+
+std::vector<MemoryPressureRegistry::Subsystem>
+MemoryPressureRegistry::GetSubsystems() const {
+  std::scoped_lock lock(mutex_);
+  return subsystems_;
+}
+
+void MemoryPressureRegistry::Notify(MemoryPressureLevel level) const {
+  for (const Subsystem& subsystem : GetSubsystems()) {
+    subsystem.task_runner->PostTask([trim = subsystem.trim, level]() {
+      TRACE_EVENT0("flutter", "MemoryPressureRegistry::Trim");
+      trim(level);
+    });
+  }
+}
+
+std::vector<MemoryPressureRegistry::Usage> MemoryPressureRegistry::GetUsage()
+    const {
+  std::vector<Subsystem> subsystems = GetSubsystems();
+  std::vector<Usage> usage;
+  for (const Subsystem& subsystem : subsystems) {
+    if (subsystem.get_bytes) {
+      usage.push_back({.name = subsystem.name});
+    }
+  }
+
+  fml::CountDownLatch latch(usage.size());
+  size_t index = 0;
+  for (const Subsystem& subsystem : subsystems) {
+    if (!subsystem.get_bytes) {
+      continue;
+    }
+    Usage* subsystem_usage = &usage[index++];
+    fml::TaskRunner::RunNowOrPostTask(
+        subsystem.task_runner,
+        [subsystem_usage, get_bytes = subsystem.get_bytes, &latch]() {
+          subsystem_usage->bytes = get_bytes();
+          latch.CountDown();
+        });
+  }
+  latch.Wait();
+  return usage;
+}
+
+}  // namespace flutter
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_REGISTRY_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_REGISTRY_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+/// How much memory the engine should give back.
+enum class MemoryPressureLevel {
+  /// Memory is getting low. Caches that are cheap to rebuild are trimmed,
+  /// without slowing down the next frames.
+  kModerate,
+  /// Memory is about to run out. Everything that can be rebuilt is dropped,
+  /// even if the next frames are slower.
+  kCritical,
+  /// The application is in the background and its UI not visible. Memory
+  /// is released as for |kCritical|, as well as the memory kept only to
+  /// render quickly.
+  kBackground,
+};
+
+//------------------------------------------------------------------------------
+/// The caches of the engine that respond to memory pressure.
+///
+/// Each subsystem registers how it trims its memory for a pressure level
+/// and, optionally, how many bytes it holds. Both callbacks run on the task
+/// runner of the subsystem, so that the subsystem needs no locks of its own.
+///
+/// Subsystems may be registered and notified from any thread.
+///
+class MemoryPressureRegistry {
+ public:
+  using TrimCallback = std::function<void(MemoryPressureLevel)>;
+  using ByteCountCallback = std::function<size_t()>;
+
+  /// The bytes held by a subsystem.
+  struct Usage {
+    std::string name;
+    size_t bytes = 0u;
+  };
+
+  MemoryPressureRegistry();
+
+  ~MemoryPressureRegistry();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a subsystem for memory pressure notifications.
+  ///
+  /// @param[in]  name         The name of the subsystem in the reported
+  ///                          usage.
+  /// @param[in]  task_runner  The task runner the callbacks run on.
+  /// @param[in]  trim         Called with the level of each notification.
+  /// @param[in]  get_bytes    Returns the bytes held by the subsystem, or
+  ///                          nullptr if they are not known.
+  ///
+  void Register(std::string name,
+                fml::RefPtr<fml::TaskRunner> task_runner,
+                TrimCallback trim,
+                ByteCountCallback get_bytes = nullptr);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks every subsystem to trim its memory for |level|.
+  ///
+  void Notify(MemoryPressureLevel level) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the bytes held by the subsystems that count them.
+  ///
+  ///             This waits for the subsystems to count their bytes on their
+  ///             task runners, so it must not be called on a task runner
+  ///             that one of them waits for.
+  ///
+  std::vector<Usage> GetUsage() const;
+
+ private:
+  struct Subsystem {
+    std::string name;
+    fml::RefPtr<fml::TaskRunner> task_runner;
+    TrimCallback trim;
+    ByteCountCallback get_bytes;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Subsystem> subsystems_;
+
+  std::vector<Subsystem> GetSubsystems() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryPressureRegistry);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_REGISTRY_H_
@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_pressure_registry.h"
+
+#include <atomic>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(MemoryPressureRegistryTest, TrimsSubsystemsOnTheirTaskRunners) {
+  fml::Thread raster_thread("raster");
+  fml::Thread io_thread("io");
+  MemoryPressureRegistry registry;
+  fml::AutoResetWaitableEvent raster_latch;
+  fml::AutoResetWaitableEvent io_latch;
+  MemoryPressureLevel raster_level = MemoryPressureLevel::kModerate;
+  MemoryPressureLevel io_level = MemoryPressureLevel::kModerate;
+
+  auto raster_runner = raster_thread.GetTaskRunner();
+  auto io_runner = io_thread.GetTaskRunner();
+  registry.Register("raster", raster_runner, [&](MemoryPressureLevel level) {
+    EXPECT_TRUE(raster_runner->RunsTasksOnCurrentThread());
+    raster_level = level;
+    raster_latch.Signal();
+  });
+  registry.Register("io", io_runner, [&](MemoryPressureLevel level) {
+    EXPECT_TRUE(io_runner->RunsTasksOnCurrentThread());
+    io_level = level;
+    io_latch.Signal();
+  });
+
+  registry.Notify(MemoryPressureLevel::kBackground);
+  raster_latch.Wait();
+  io_latch.Wait();
+  EXPECT_EQ(raster_level, MemoryPressureLevel::kBackground);
+  EXPECT_EQ(io_level, MemoryPressureLevel::kBackground);
+}
+
+TEST(MemoryPressureRegistryTest, ReportsTheUsageOfSubsystemsThatCountBytes) {
+  fml::Thread thread("subsystem");
+  MemoryPressureRegistry registry;
+  std::atomic<size_t> bytes = 1024u;
+
+  registry.Register(
+      "counted", thread.GetTaskRunner(), [&](MemoryPressureLevel level) {
+        bytes = 0u;
+      },
+      [&]() -> size_t {
+        EXPECT_TRUE(thread.GetTaskRunner()->RunsTasksOnCurrentThread());
+        return bytes;
+      });
+  registry.Register("uncounted", thread.GetTaskRunner(),
+                    [](MemoryPressureLevel level) {});
+
+  std::vector<MemoryPressureRegistry::Usage> usage = registry.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_EQ(usage[0].name, "counted");
+  EXPECT_EQ(usage[0].bytes, 1024u);
+
+  registry.Notify(MemoryPressureLevel::kCritical);
+  // The usage is counted after the trim, which was posted first.
+  usage = registry.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_EQ(usage[0].bytes, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/graphics/persistent_cache_file.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/physical_shape_layer.h"
@@ -25,13 +26,6 @@ namespace testing {
 
 using PersistentCacheTest = ShellTest;
 
-static void WaitForIO(Shell* shell) {
-  std::promise<bool> io_task_finished;
-  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
-      [&io_task_finished]() { io_task_finished.set_value(true); });
-  io_task_finished.get_future().wait();
-}
-
 static void WaitForRaster(Shell* shell) {
   std::promise<bool> raster_task_finished;
   shell->GetTaskRunners().GetRasterTaskRunner()->PostTask(
@@ -75,7 +69,7 @@ TEST_F(PersistentCacheTest, CacheSkSLWorks) {
   };
   PumpOneFrame(shell.get(), 100, 100, builder);
   first_frame_latch.Wait();
-  WaitForIO(shell.get());
+  FlushPersistentCacheWrites(shell.get());
 
   // Some skp should be dumped due to shader compilations.
   int skp_count = 0;
@@ -108,7 +102,7 @@ TEST_F(PersistentCacheTest, CacheSkSLWorks) {
   first_frame_latch.Reset();
   PumpOneFrame(shell.get(), 100, 100, builder);
   first_frame_latch.Wait();
-  WaitForIO(shell.get());
+  FlushPersistentCacheWrites(shell.get());
 
 // Shader precompilation from SkSL is not implemented on the Skia Vulkan
 // backend so don't run the second half of this test on Vulkan. This can get
@@ -175,7 +169,7 @@ TEST_F(PersistentCacheTest, CanPrecompileMetalShaders) {
   PumpOneFrame(shell.get(), 100, 100, builder);
   first_frame_latch.Wait();
   WaitForRaster(shell.get());
-  WaitForIO(shell.get());
+  FlushPersistentCacheWrites(shell.get());
 
   // Assert that SkSLs have been generated.
   auto filled_cache = PersistentCache::GetCacheForProcess()->LoadSkSLs();
@@ -297,6 +291,38 @@ TEST_F(PersistentCacheTest, CanRemoveOldPersistentCache) {
   fml::RemoveFilesInDirectory(base_dir.fd());
 }
 
+TEST_F(PersistentCacheTest, CanDuplicateCacheDirectory) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto duplicate =
+      PersistentCache::GetCacheForProcess()->DuplicateCacheDirectory();
+  ASSERT_TRUE(duplicate.is_valid());
+
+  // Files written through the duplicate land in the versioned cache directory.
+  fml::DataMapping test_data(std::string("test"));
+  ASSERT_TRUE(fml::WriteAtomically(duplicate, "test", test_data));
+  auto cache_dir = fml::CreateDirectory(
+      base_dir.fd(),
+      {"flutter_engine", GetFlutterEngineVersion(), "skia", GetSkiaVersion()},
+      fml::FilePermission::kRead);
+  ASSERT_TRUE(cache_dir.is_valid());
+  ASSERT_TRUE(fml::OpenFileReadOnly(cache_dir, "test").is_valid());
+
+  // Read-only caches don't hand out their directory.
+  PersistentCache::gIsReadOnly = true;
+  PersistentCache::ResetCacheForProcess();
+  ASSERT_FALSE(PersistentCache::GetCacheForProcess()
+                   ->DuplicateCacheDirectory()
+                   .is_valid());
+  PersistentCache::gIsReadOnly = false;
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 TEST_F(PersistentCacheTest, CanPurgePersistentCache) {
   fml::ScopedTemporaryDirectory base_dir;
   ASSERT_TRUE(base_dir.fd().is_valid());
@@ -351,10 +377,7 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
 
   // Store the cache and verify it's valid.
   StorePersistentCache(persistent_cache, *shader_key, *shader_value);
-  std::promise<bool> io_flushed;
-  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
-      [&io_flushed]() { io_flushed.set_value(true); });
-  io_flushed.get_future().get();  // Wait for the IO thread to flush the file.
+  FlushPersistentCacheWrites(shell.get());
   ASSERT_GT(persistent_cache->LoadSkSLs().size(), 0u);
 
   // Cleanup
@@ -362,5 +385,135 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+static std::string ToString(const sk_sp<SkData>& data) {
+  return std::string(static_cast<const char*>(data->data()), data->size());
+}
+
+static std::shared_ptr<const fml::UniqueFD> OpenTestDirectory(
+    const fml::ScopedTemporaryDirectory& dir) {
+  return std::make_shared<const fml::UniqueFD>(fml::OpenDirectory(
+      dir.path().c_str(), false, fml::FilePermission::kReadWrite));
+}
+
+TEST(PersistentCacheFileTest, StoresEntriesInASingleFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenTestDirectory(dir);
+  {
+    PersistentCacheFile file(directory, false);
+    ASSERT_EQ(file.Find(*SkData::MakeWithCString("a")), nullptr);
+    ASSERT_TRUE(file.Store(*SkData::MakeWithCString("a"),
+                           *SkData::MakeWithCString("x")));
+    ASSERT_TRUE(file.Store(*SkData::MakeWithCString("b"),
+                           *SkData::MakeWithCString("y")));
+    ASSERT_TRUE(file.Store(*SkData::MakeWithCString("a"),
+                           *SkData::MakeWithCString("z")));
+    EXPECT_EQ(ToString(file.Find(*SkData::MakeWithCString("a"))),
+              std::string("z", 2));
+    EXPECT_EQ(file.GetEntryCount(), 2u);
+    EXPECT_GT(file.GetDeadBytes(), 0u);
+  }
+
+  int file_count = 0;
+  fml::VisitFiles(*directory, [&file_count](const fml::UniqueFD& directory,
+                                            const std::string& filename) {
+    EXPECT_EQ(filename, PersistentCacheFile::kFileName);
+    file_count++;
+    return true;
+  });
+  EXPECT_EQ(file_count, 1);
+
+  // The entries are read back by another instance, and the latest value of a
+  // key wins.
+  PersistentCacheFile file(directory, true);
+  EXPECT_EQ(ToString(file.Find(*SkData::MakeWithCString("a"))),
+            std::string("z", 2));
+  EXPECT_EQ(ToString(file.Find(*SkData::MakeWithCString("b"))),
+            std::string("y", 2));
+  EXPECT_EQ(file.GetEntries().size(), 2u);
+
+  // Read-only files are never written to.
+  EXPECT_FALSE(file.Store(*SkData::MakeWithCString("c"),
+                          *SkData::MakeWithCString("w")));
+}
+
+TEST(PersistentCacheFileTest, DropsATornRecordAndOverwritesIt) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenTestDirectory(dir);
+  {
+    PersistentCacheFile file(directory, false);
+    ASSERT_TRUE(file.Store(*SkData::MakeWithCString("a"),
+                           *SkData::MakeWithCString("x")));
+    ASSERT_TRUE(file.Store(*SkData::MakeWithCString("b"),
+                           *SkData::MakeWithCString("y")));
+  }
+
+  // Cut the last record short as if the process died while writing it.
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      *directory, PersistentCacheFile::kFileName);
+  ASSERT_NE(mapping, nullptr);
+  const size_t size = mapping->GetSize();
+  mapping.reset();
+  auto handle = fml::OpenFile(*directory, PersistentCacheFile::kFileName,
+                              false, fml::FilePermission::kReadWrite);
+  ASSERT_TRUE(fml::TruncateFile(handle, size - 1));
+  handle.reset();
+
+  PersistentCacheFile file(directory, false);
+  EXPECT_EQ(file.GetEntryCount(), 1u);
+  EXPECT_NE(file.Find(*SkData::MakeWithCString("a")), nullptr);
+  EXPECT_EQ(file.Find(*SkData::MakeWithCString("b")), nullptr);
+
+  ASSERT_TRUE(file.Store(*SkData::MakeWithCString("c"),
+                         *SkData::MakeWithCString("w")));
+  PersistentCacheFile reloaded(directory, true);
+  EXPECT_EQ(reloaded.GetEntryCount(), 2u);
+  EXPECT_EQ(ToString(reloaded.Find(*SkData::MakeWithCString("c"))),
+            std::string("w", 2));
+}
+
+TEST(PersistentCacheFileTest, CompactsReplacedRecords) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenTestDirectory(dir);
+  PersistentCacheFile file(directory, false);
+  auto key = SkData::MakeWithCString("key");
+  auto value = SkData::MakeUninitialized(64u * 1024u);
+  memset(value->writable_data(), 1, value->size());
+  auto other_value = SkData::MakeWithCString("other");
+  for (int i = 0; i < 8; i++) {
+    ASSERT_TRUE(file.Store(*key, *value));
+  }
+  ASSERT_TRUE(file.Store(*key, *other_value));
+
+  // Compacting once more than 256KB of replaced records pile up keeps the
+  // file from growing without bounds.
+  EXPECT_LT(file.GetDeadBytes(), PersistentCacheFile::kMinimumCompactionBytes);
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      *directory, PersistentCacheFile::kFileName);
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_LT(mapping->GetSize(), 5u * value->size());
+
+  ASSERT_TRUE(file.Compact());
+  EXPECT_EQ(file.GetDeadBytes(), 0u);
+  EXPECT_EQ(ToString(file.Find(*key)), ToString(other_value));
+  EXPECT_EQ(file.GetEntries().size(), 1u);
+}
+
+TEST(PersistentCacheFileTest, ResetForgetsAPurgedFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = OpenTestDirectory(dir);
+  PersistentCacheFile file(directory, false);
+  ASSERT_TRUE(file.Store(*SkData::MakeWithCString("a"),
+                         *SkData::MakeWithCString("x")));
+  ASSERT_TRUE(fml::UnlinkFile(*directory, PersistentCacheFile::kFileName));
+  file.Reset();
+  EXPECT_EQ(file.GetEntryCount(), 0u);
+
+  ASSERT_TRUE(file.Store(*SkData::MakeWithCString("b"),
+                         *SkData::MakeWithCString("y")));
+  PersistentCacheFile reloaded(directory, true);
+  EXPECT_EQ(reloaded.GetEntryCount(), 1u);
+  EXPECT_NE(reloaded.Find(*SkData::MakeWithCString("b")), nullptr);
+}
+
 }  // namespace testing
 }  // namespace flutter
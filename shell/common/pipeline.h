@@ -8,9 +8,12 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <vector>
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/semaphore.h"
@@ -102,12 +105,41 @@ class Pipeline {
   };
 
   explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+      : depth_(depth), empty_(depth), available_(0), inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  uint32_t GetDepth() const {
+    std::scoped_lock lock(depth_mutex_);
+    return depth_;
+  }
+
+  /// Changes the number of resources that may be in flight at once. When the
+  /// depth is reduced while more resources are in flight, the extra spots are
+  /// retired as those resources are consumed.
+  void SetDepth(uint32_t depth) {
+    FML_DCHECK(depth > 0u);
+    std::scoped_lock lock(depth_mutex_);
+    for (; depth_ < depth; depth_++) {
+      if (retiring_spots_ > 0u) {
+        retiring_spots_--;
+      } else {
+        empty_.Signal();
+      }
+    }
+    for (; depth_ > depth; depth_--) {
+      if (!empty_.TryWait()) {
+        retiring_spots_++;
+      }
+    }
+    FML_TRACE_COUNTER("flutter", "Pipeline Max Depth",
+                      reinterpret_cast<int64_t>(this),  //
+                      "depth", depth_                   //
+    );
+  }
+
   ProducerContinuation Produce() {
     if (!empty_.TryWait()) {
       return {};
@@ -144,6 +176,12 @@ class Pipeline {
         GetNextPipelineTraceID()};         // trace id
   }
 
+  /// The number of resources that are produced and waiting to be consumed.
+  size_t GetPendingCount() {
+    std::scoped_lock lock(queue_mutex_);
+    return queue_.size();
+  }
+
   using Consumer = std::function<void(ResourcePtr)>;
 
   /// @note Procedure doesn't copy all closures.
@@ -169,7 +207,7 @@ class Pipeline {
 
     consumer(std::move(resource));
 
-    empty_.Signal();
+    ReleaseSpot();
     --inflight_;
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
@@ -180,12 +218,26 @@ class Pipeline {
   }
 
  private:
+  mutable std::mutex depth_mutex_;
+  uint32_t depth_;
+  // Spots that are taken by resources in flight but are given up once those
+  // resources are consumed because the depth was reduced.
+  uint32_t retiring_spots_ = 0u;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
 
+  void ReleaseSpot() {
+    std::scoped_lock lock(depth_mutex_);
+    if (retiring_spots_ > 0u) {
+      retiring_spots_--;
+      return;
+    }
+    empty_.Signal();
+  }
+
   PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
     bool is_first_item = false;
     {
@@ -206,7 +258,7 @@ class Pipeline {
       if (!queue_.empty()) {
         // Bail if the queue is not empty, opens up spaces to produce other
         // frames.
-        empty_.Signal();
+        ReleaseSpot();
         return {.success = false, .is_first_item = false};
       }
       queue_.emplace_back(std::move(resource), trace_id);
@@ -220,12 +272,29 @@ class Pipeline {
   FML_DISALLOW_COPY_AND_ASSIGN(Pipeline);
 };
 
+/// A layer tree and the view to render it to.
+struct LayerTreeTask {
+  LayerTreeTask(int64_t view_id, std::shared_ptr<LayerTree> layer_tree)
+      : view_id(view_id), layer_tree(std::move(layer_tree)) {}
+  int64_t view_id;
+  std::shared_ptr<LayerTree> layer_tree;
+};
+
+/// The layer trees of the views that were rendered for the same vsync. They
+/// are rasterized together.
 struct LayerTreeItem {
+  /// A frame of the implicit view.
   LayerTreeItem(std::shared_ptr<LayerTree> layer_tree,
                 std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder)
-      : layer_tree(std::move(layer_tree)),
+      : frame_timings_recorder(std::move(frame_timings_recorder)) {
+    layer_tree_tasks.emplace_back(kFlutterImplicitViewId,
+                                  std::move(layer_tree));
+  }
+  LayerTreeItem(std::vector<LayerTreeTask> layer_tree_tasks,
+                std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder)
+      : layer_tree_tasks(std::move(layer_tree_tasks)),
         frame_timings_recorder(std::move(frame_timings_recorder)) {}
-  std::shared_ptr<LayerTree> layer_tree;
+  std::vector<LayerTreeTask> layer_tree_tasks;
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder;
 };
 
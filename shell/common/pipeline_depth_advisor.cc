@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_advisor.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+PipelineDepthAdvisor::PipelineDepthAdvisor() = default;
+
+PipelineDepthAdvisor::~PipelineDepthAdvisor() = default;
+
+void PipelineDepthAdvisor::AddFrameTiming(const FrameTiming& timing,
+                                          fml::Milliseconds frame_budget) {
+  const Sample sample = {
+      .build_duration = timing.Get(FrameTiming::kBuildFinish) -
+                        timing.Get(FrameTiming::kBuildStart),
+      .raster_duration = timing.Get(FrameTiming::kRasterFinish) -
+                         timing.Get(FrameTiming::kRasterStart),
+  };
+
+  std::scoped_lock lock(mutex_);
+  samples_.push_back(sample);
+  if (samples_.size() > kSampleCount) {
+    samples_.pop_front();
+  }
+  if (samples_.size() < kSampleCount) {
+    return;
+  }
+
+  const auto budget = fml::TimeDelta::FromMillisecondsF(frame_budget.count());
+  const auto fast_budget = fml::TimeDelta::FromMillisecondsF(
+      frame_budget.count() * kFastFrameBudgetFraction);
+  const auto raster_bound_count =
+      std::count_if(samples_.begin(), samples_.end(), [&](const auto& sample) {
+        return sample.raster_duration > budget;
+      });
+  const bool all_fast =
+      std::all_of(samples_.begin(), samples_.end(), [&](const auto& sample) {
+        return sample.build_duration + sample.raster_duration < fast_budget;
+      });
+
+  if (static_cast<size_t>(raster_bound_count) >= kRasterBoundSampleCount) {
+    depth_ = kMaxDepth;
+  } else if (all_fast) {
+    depth_ = kMinDepth;
+  } else {
+    depth_ = kDefaultDepth;
+  }
+}
+
+uint32_t PipelineDepthAdvisor::GetDepth() const {
+  return depth_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_ADVISOR_H_
+#define FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_ADVISOR_H_
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Chooses the depth of the layer tree pipeline from the timings of the recent
+/// frames.
+///
+/// * If the rasterization of frames often takes longer than a frame interval,
+///   the raster thread is the bottleneck. A third frame in flight keeps the UI
+///   thread from stalling on it.
+/// * If every frame is built and rasterized well within a frame interval, one
+///   frame in flight gives the lowest latency.
+/// * Otherwise two frames in flight let building and rasterizing overlap.
+///
+/// Timings are added on the raster thread and the depth is read on the UI
+/// thread. This class is thread safe.
+///
+class PipelineDepthAdvisor {
+ public:
+  static constexpr uint32_t kMinDepth = 1u;
+  static constexpr uint32_t kDefaultDepth = 2u;
+  static constexpr uint32_t kMaxDepth = 3u;
+
+  /// The number of recent frames the depth is chosen from.
+  static constexpr size_t kSampleCount = 30u;
+
+  /// The number of frames whose rasterization is too long for the raster
+  /// thread to be considered the bottleneck.
+  static constexpr size_t kRasterBoundSampleCount = kSampleCount / 4u;
+
+  /// The fraction of the frame interval a frame must fit in to be considered
+  /// fast.
+  static constexpr double kFastFrameBudgetFraction = 0.75;
+
+  PipelineDepthAdvisor();
+
+  ~PipelineDepthAdvisor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the timing of a frame that was just rasterized and
+  ///             updates the advised depth.
+  ///
+  /// @param[in]  timing        The timing of the frame.
+  /// @param[in]  frame_budget  The current frame interval of the display.
+  ///
+  void AddFrameTiming(const FrameTiming& timing,
+                      fml::Milliseconds frame_budget);
+
+  //----------------------------------------------------------------------------
+  /// @return     The depth the pipeline should have. This is `kDefaultDepth`
+  ///             until `kSampleCount` frames have been rasterized.
+  ///
+  uint32_t GetDepth() const;
+
+ private:
+  struct Sample {
+    fml::TimeDelta build_duration;
+    fml::TimeDelta raster_duration;
+  };
+
+  std::mutex mutex_;
+  std::deque<Sample> samples_;
+  std::atomic<uint32_t> depth_ = kDefaultDepth;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthAdvisor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_ADVISOR_H_
@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_advisor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::Milliseconds kFrameBudget = fml::Milliseconds(16);
+
+FrameTiming CreateFrameTiming(int64_t build_millis, int64_t raster_millis) {
+  FrameTiming timing;
+  const auto build_start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  const auto raster_start =
+      build_start + fml::TimeDelta::FromMilliseconds(build_millis);
+  timing.Set(FrameTiming::kBuildStart, build_start);
+  timing.Set(FrameTiming::kBuildFinish, raster_start);
+  timing.Set(FrameTiming::kRasterStart, raster_start);
+  timing.Set(FrameTiming::kRasterFinish,
+             raster_start + fml::TimeDelta::FromMilliseconds(raster_millis));
+  return timing;
+}
+
+void AddFrameTimings(PipelineDepthAdvisor& advisor,
+                     size_t count,
+                     int64_t build_millis,
+                     int64_t raster_millis) {
+  for (size_t i = 0; i < count; i++) {
+    advisor.AddFrameTiming(CreateFrameTiming(build_millis, raster_millis),
+                           kFrameBudget);
+  }
+}
+
+}  // namespace
+
+TEST(PipelineDepthAdvisorTest, DefaultDepthWithoutEnoughFrames) {
+  PipelineDepthAdvisor advisor;
+  AddFrameTimings(advisor, PipelineDepthAdvisor::kSampleCount - 1, 1, 1);
+  ASSERT_EQ(advisor.GetDepth(), PipelineDepthAdvisor::kDefaultDepth);
+}
+
+TEST(PipelineDepthAdvisorTest, SingleFrameInFlightWhenFast) {
+  PipelineDepthAdvisor advisor;
+  AddFrameTimings(advisor, PipelineDepthAdvisor::kSampleCount, 3, 4);
+  ASSERT_EQ(advisor.GetDepth(), PipelineDepthAdvisor::kMinDepth);
+}
+
+TEST(PipelineDepthAdvisorTest, TwoFramesInFlightWhenFramesOverlap) {
+  PipelineDepthAdvisor advisor;
+  AddFrameTimings(advisor, PipelineDepthAdvisor::kSampleCount, 8, 8);
+  ASSERT_EQ(advisor.GetDepth(), PipelineDepthAdvisor::kDefaultDepth);
+}
+
+TEST(PipelineDepthAdvisorTest, ThreeFramesInFlightWhenRasterBound) {
+  PipelineDepthAdvisor advisor;
+  AddFrameTimings(advisor, PipelineDepthAdvisor::kSampleCount, 3, 4);
+  AddFrameTimings(advisor, PipelineDepthAdvisor::kRasterBoundSampleCount, 3,
+                  20);
+  ASSERT_EQ(advisor.GetDepth(), PipelineDepthAdvisor::kMaxDepth);
+
+  AddFrameTimings(advisor, PipelineDepthAdvisor::kSampleCount, 3, 4);
+  ASSERT_EQ(advisor.GetDepth(), PipelineDepthAdvisor::kMinDepth);
+}
+
+}  // namespace testing
+}  // namespace flutter
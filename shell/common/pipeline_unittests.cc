@@ -35,6 +35,27 @@ TEST(PipelineTest, ConsumeOneVal) {
   ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, PendingCountExcludesTheConsumedResource) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(3);
+  ASSERT_EQ(pipeline->GetPendingCount(), 0u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  // Reserved spots are not pending until they are completed.
+  ASSERT_EQ(pipeline->GetPendingCount(), 0u);
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)).success);
+  ASSERT_EQ(pipeline->GetPendingCount(), 2u);
+
+  size_t pending_while_consuming = 0;
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([&](std::unique_ptr<int> v) {
+        pending_while_consuming = pipeline->GetPendingCount();
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pending_while_consuming, 1u);
+}
+
 TEST(PipelineTest, ContinuationCanOnlyBeUsedOnce) {
   std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
 
@@ -144,5 +165,42 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, IncreasingDepthAllowsMoreInFlight) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(1);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(2);
+  ASSERT_EQ(pipeline->GetDepth(), 2u);
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_FALSE(pipeline->Produce());
+}
+
+TEST(PipelineTest, ReducingDepthRetiresSpotsWhenConsumed) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)).success);
+
+  pipeline->SetDepth(1);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+
+  // One frame is still in flight. So there is no spot for another one.
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::MoreAvailable);
+  ASSERT_FALSE(pipeline->Produce());
+
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) {}),
+            PipelineConsumeResult::Done);
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(pipeline->Produce());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_coalescer.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+PointerDataCoalescer::PointerDataCoalescer(fml::TimeDelta resampling_offset)
+    : resampling_offset_(resampling_offset) {}
+
+PointerDataCoalescer::~PointerDataCoalescer() = default;
+
+bool PointerDataCoalescer::CanCoalesce(const PointerData& previous,
+                                       const PointerData& next) {
+  return (next.change == PointerData::Change::kMove ||
+          next.change == PointerData::Change::kHover) &&
+         next.signal_kind == PointerData::SignalKind::kNone &&
+         previous.change == next.change &&
+         previous.signal_kind == next.signal_kind &&
+         previous.kind == next.kind && previous.buttons == next.buttons &&
+         previous.synthesized == next.synthesized;
+}
+
+void PointerDataCoalescer::Add(const PointerDataPacket& packet) {
+  const bool resampling = resampling_offset_ > fml::TimeDelta::Zero();
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    Event event;
+    event.data = packet.GetPointerData(i);
+    auto found = last_events_.find(event.data.device);
+    if (found != last_events_.end() &&
+        CanCoalesce(events_[found->second].data, event.data)) {
+      Event& previous = events_[found->second];
+      event.data.physical_delta_x += previous.data.physical_delta_x;
+      event.data.physical_delta_y += previous.data.physical_delta_y;
+      event.samples = std::move(previous.samples);
+      previous.coalesced = true;
+    }
+    if (resampling) {
+      event.samples.push_back(packet.GetPointerData(i));
+    }
+    last_events_[event.data.device] = events_.size();
+    events_.push_back(std::move(event));
+  }
+}
+
+void PointerDataCoalescer::Resample(Event& event, int64_t sample_time) const {
+  const auto& samples = event.samples;
+  if (samples.size() < 2 || sample_time >= samples.back().time_stamp) {
+    return;
+  }
+  if (sample_time <= samples.front().time_stamp) {
+    event.data.physical_x = samples.front().physical_x;
+    event.data.physical_y = samples.front().physical_y;
+    event.data.time_stamp = samples.front().time_stamp;
+    return;
+  }
+  // The first sample that is newer than the sample time.
+  auto next = std::upper_bound(samples.begin(), samples.end(), sample_time,
+                               [](int64_t time, const PointerData& sample) {
+                                 return time < sample.time_stamp;
+                               });
+  auto previous = next - 1;
+  const double t =
+      static_cast<double>(sample_time - previous->time_stamp) /
+      static_cast<double>(next->time_stamp - previous->time_stamp);
+  event.data.physical_x =
+      previous->physical_x + (next->physical_x - previous->physical_x) * t;
+  event.data.physical_y =
+      previous->physical_y + (next->physical_y - previous->physical_y) * t;
+  event.data.time_stamp = sample_time;
+}
+
+std::unique_ptr<PointerDataPacket> PointerDataCoalescer::Flush() {
+  if (events_.empty()) {
+    return nullptr;
+  }
+
+  const bool resampling = resampling_offset_ > fml::TimeDelta::Zero();
+  int64_t sample_time = 0;
+  size_t count = 0;
+  for (const auto& event : events_) {
+    sample_time = std::max(sample_time, event.data.time_stamp);
+    count += event.coalesced ? 0 : 1;
+  }
+  sample_time -= resampling_offset_.ToMicroseconds();
+
+  auto packet = std::make_unique<PointerDataPacket>(count);
+  size_t index = 0;
+  for (auto& event : events_) {
+    if (event.coalesced) {
+      continue;
+    }
+    auto& data = event.data;
+    if (resampling && data.signal_kind == PointerData::SignalKind::kNone &&
+        data.kind != PointerData::DeviceKind::kTrackpad) {
+      Resample(event, sample_time);
+      // Resampled positions are not the positions that the deltas of the
+      // converter are relative to, so the deltas are made relative to the
+      // positions that were dispatched instead.
+      auto last_position = last_positions_.find(data.device);
+      if (last_position != last_positions_.end()) {
+        data.physical_delta_x = data.physical_x - last_position->second.first;
+        data.physical_delta_y = data.physical_y - last_position->second.second;
+      }
+      if (data.change == PointerData::Change::kRemove ||
+          data.change == PointerData::Change::kCancel) {
+        last_positions_.erase(data.device);
+      } else {
+        last_positions_[data.device] = {data.physical_x, data.physical_y};
+      }
+    }
+    packet->SetPointerData(index++, data);
+  }
+
+  events_.clear();
+  last_events_.clear();
+  return packet;
+}
+
+}  // namespace flutter
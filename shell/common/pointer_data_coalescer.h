@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_COALESCER_H_
+#define FLUTTER_SHELL_COMMON_POINTER_DATA_COALESCER_H_
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Merges the pointer events received during a frame into the packet that is
+/// dispatched to the framework at the next vsync.
+///
+/// Consecutive move events of a pointer with the same buttons, and consecutive
+/// hover events of a pointer, are coalesced into the last of them. Events of
+/// other pointers in between don't interrupt a run, but any other event of the
+/// same pointer does, so downs, ups, signals and pan/zoom events are always
+/// delivered. The deltas of a coalesced event span all of the events it
+/// replaces, so no motion is lost.
+///
+/// With a resampling offset, the coalesced event is resampled at the offset
+/// before the newest event of the frame instead of being the last sample. Its
+/// position is interpolated between the samples around that time, which gives
+/// evenly spaced positions when the panel samples at a rate unrelated to the
+/// display. The samples newer than that time only show in the next frame.
+///
+class PointerDataCoalescer {
+ public:
+  explicit PointerDataCoalescer(
+      fml::TimeDelta resampling_offset = fml::TimeDelta::Zero());
+
+  ~PointerDataCoalescer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the events of the packet after the events added before.
+  ///
+  void Add(const PointerDataPacket& packet);
+
+  bool IsEmpty() const { return events_.empty(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the coalesced events added since the last call, or
+  ///             nullptr if none was added.
+  ///
+  std::unique_ptr<PointerDataPacket> Flush();
+
+ private:
+  struct Event {
+    PointerData data;
+    // Whether the event was coalesced into a later one.
+    bool coalesced = false;
+    // The samples the event replaces, oldest first, itself included. Only
+    // recorded for resampling.
+    std::vector<PointerData> samples;
+  };
+
+  static bool CanCoalesce(const PointerData& previous,
+                          const PointerData& next);
+
+  void Resample(Event& event, int64_t sample_time) const;
+
+  const fml::TimeDelta resampling_offset_;
+  std::vector<Event> events_;
+  // The index in `events_` of the last event of each pointer device.
+  std::unordered_map<int64_t, size_t> last_events_;
+  // The position of the last event of each pointer device that was flushed.
+  std::unordered_map<int64_t, std::pair<double, double>> last_positions_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerDataCoalescer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_POINTER_DATA_COALESCER_H_
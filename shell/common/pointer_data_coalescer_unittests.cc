@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_coalescer.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t device,
+                              int64_t time_stamp,
+                              double x,
+                              double y,
+                              double delta_x,
+                              double delta_y,
+                              int64_t buttons) {
+  PointerData data;
+  data.Clear();
+  data.time_stamp = time_stamp;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_y = y;
+  data.physical_delta_x = delta_x;
+  data.physical_delta_y = delta_y;
+  data.buttons = buttons;
+  return data;
+}
+
+PointerData CreateMove(int64_t device,
+                       int64_t time_stamp,
+                       double x,
+                       double y,
+                       double delta_x,
+                       double delta_y) {
+  return CreatePointerData(PointerData::Change::kMove, device, time_stamp, x,
+                           y, delta_x, delta_y, 1);
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(PointerDataCoalescerTest, CoalescesMovesWithTheirDeltas) {
+  PointerDataCoalescer coalescer;
+  EXPECT_TRUE(coalescer.IsEmpty());
+  EXPECT_EQ(coalescer.Flush(), nullptr);
+
+  coalescer.Add(*CreatePacket({
+      CreatePointerData(PointerData::Change::kDown, 0, 0, 0, 0, 0, 0, 1),
+      CreateMove(0, 1000, 1, 2, 1, 2),
+  }));
+  coalescer.Add(*CreatePacket({CreateMove(0, 2000, 4, 6, 3, 4)}));
+  EXPECT_FALSE(coalescer.IsEmpty());
+
+  auto packet = coalescer.Flush();
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 2u);
+  EXPECT_EQ(packet->GetPointerData(0).change, PointerData::Change::kDown);
+  PointerData move = packet->GetPointerData(1);
+  EXPECT_EQ(move.change, PointerData::Change::kMove);
+  EXPECT_EQ(move.time_stamp, 2000);
+  EXPECT_EQ(move.physical_x, 4);
+  EXPECT_EQ(move.physical_y, 6);
+  EXPECT_EQ(move.physical_delta_x, 4);
+  EXPECT_EQ(move.physical_delta_y, 6);
+
+  EXPECT_TRUE(coalescer.IsEmpty());
+  EXPECT_EQ(coalescer.Flush(), nullptr);
+}
+
+TEST(PointerDataCoalescerTest, KeepsEventsThatChangeThePointerState) {
+  PointerDataCoalescer coalescer;
+  coalescer.Add(*CreatePacket({
+      CreateMove(0, 1000, 1, 0, 1, 0),
+      CreatePointerData(PointerData::Change::kUp, 0, 2000, 1, 0, 0, 0, 0),
+      CreatePointerData(PointerData::Change::kDown, 0, 3000, 1, 0, 0, 0, 1),
+      CreateMove(0, 4000, 2, 0, 1, 0),
+      CreatePointerData(PointerData::Change::kMove, 0, 5000, 3, 0, 1, 0, 3),
+  }));
+
+  auto packet = coalescer.Flush();
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 5u);
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    EXPECT_EQ(packet->GetPointerData(i).time_stamp,
+              static_cast<int64_t>(i + 1) * 1000);
+  }
+}
+
+TEST(PointerDataCoalescerTest, CoalescesEachPointerSeparately) {
+  PointerDataCoalescer coalescer;
+  coalescer.Add(*CreatePacket({
+      CreateMove(0, 1000, 1, 0, 1, 0),
+      CreateMove(1, 1000, 0, 1, 0, 1),
+      CreateMove(0, 2000, 2, 0, 1, 0),
+      CreateMove(1, 2000, 0, 2, 0, 1),
+      CreateMove(0, 3000, 3, 0, 1, 0),
+  }));
+
+  auto packet = coalescer.Flush();
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 2u);
+  // The coalesced events are where the last event of each pointer was.
+  EXPECT_EQ(packet->GetPointerData(0).device, 1);
+  EXPECT_EQ(packet->GetPointerData(0).physical_y, 2);
+  EXPECT_EQ(packet->GetPointerData(0).physical_delta_y, 2);
+  EXPECT_EQ(packet->GetPointerData(1).device, 0);
+  EXPECT_EQ(packet->GetPointerData(1).physical_x, 3);
+  EXPECT_EQ(packet->GetPointerData(1).physical_delta_x, 3);
+}
+
+TEST(PointerDataCoalescerTest, ResamplesCoalescedMoves) {
+  PointerDataCoalescer coalescer(fml::TimeDelta::FromMicroseconds(5000));
+  coalescer.Add(*CreatePacket({
+      CreatePointerData(PointerData::Change::kDown, 0, 0, 0, 0, 0, 0, 1),
+      CreateMove(0, 4000, 8, 0, 8, 0),
+      CreateMove(0, 8000, 16, 4, 8, 4),
+      CreateMove(0, 12000, 24, 8, 8, 4),
+  }));
+
+  // The moves are resampled at 7000 microseconds, between the moves at 4000
+  // and 8000 microseconds.
+  auto packet = coalescer.Flush();
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 2u);
+  PointerData move = packet->GetPointerData(1);
+  EXPECT_EQ(move.time_stamp, 7000);
+  EXPECT_DOUBLE_EQ(move.physical_x, 14);
+  EXPECT_DOUBLE_EQ(move.physical_y, 3);
+  EXPECT_DOUBLE_EQ(move.physical_delta_x, 14);
+  EXPECT_DOUBLE_EQ(move.physical_delta_y, 3);
+
+  // The deltas of the next frame are relative to the resampled position.
+  coalescer.Add(*CreatePacket({CreateMove(0, 16000, 32, 8, 8, 0)}));
+  packet = coalescer.Flush();
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 1u);
+  move = packet->GetPointerData(0);
+  EXPECT_EQ(move.time_stamp, 16000);
+  EXPECT_DOUBLE_EQ(move.physical_x, 32);
+  EXPECT_DOUBLE_EQ(move.physical_delta_x, 18);
+  EXPECT_DOUBLE_EQ(move.physical_delta_y, 5);
+}
+
+}  // namespace testing
+}  // namespace flutter
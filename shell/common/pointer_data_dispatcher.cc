@@ -15,6 +15,20 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate,
+    fml::TimeDelta resampling_offset)
+    : DefaultPointerDataDispatcher(delegate),
+      coalescer_(resampling_offset),
+      weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
+FrameAlignedPointerDataDispatcher::FrameAlignedPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+FrameAlignedPointerDataDispatcher::~FrameAlignedPointerDataDispatcher() =
+    default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +82,96 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "CoalescingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  const bool was_empty = coalescer_.IsEmpty();
+  coalescer_.Add(*packet);
+  if (!was_empty) {
+    TRACE_FLOW_END("flutter", "PointerEvent", pending_trace_flow_id_);
+  }
+  pending_trace_flow_id_ = trace_flow_id;
+  if (was_empty) {
+    delegate_.ScheduleSecondaryVsyncCallback(
+        reinterpret_cast<uintptr_t>(this),
+        [dispatcher = weak_factory_.GetWeakPtr()]() {
+          if (dispatcher) {
+            dispatcher->DispatchCoalescedPackets();
+          }
+        });
+  }
+}
+
+void CoalescingPointerDataDispatcher::DispatchCoalescedPackets() {
+  TRACE_EVENT0("flutter",
+               "CoalescingPointerDataDispatcher::DispatchCoalescedPackets");
+  auto packet = coalescer_.Flush();
+  if (packet == nullptr) {
+    return;
+  }
+  const uint64_t trace_flow_id = pending_trace_flow_id_;
+  pending_trace_flow_id_ = 0;
+  delegate_.DoDispatchPacket(std::move(packet), trace_flow_id);
+}
+
+void FrameAlignedPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "FrameAlignedPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (pending_packets_.empty() &&
+      !delegate_.ScheduleBeginFrameCallback(
+          reinterpret_cast<uintptr_t>(this),
+          [dispatcher = weak_factory_.GetWeakPtr()]() {
+            if (dispatcher) {
+              dispatcher->DispatchPendingPackets();
+            }
+          })) {
+    // No frame is scheduled, so any frame that the framework requests for
+    // this packet starts at the next vsync.
+    delegate_.DoDispatchPacket(std::move(packet), trace_flow_id);
+    return;
+  }
+  pending_packets_.push_back(std::move(packet));
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+}
+
+void FrameAlignedPointerDataDispatcher::DispatchPendingPackets() {
+  if (pending_packets_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter",
+               "FrameAlignedPointerDataDispatcher::DispatchPendingPackets");
+  auto packets = std::move(pending_packets_);
+  auto trace_flow_ids = std::move(pending_trace_flow_ids_);
+  pending_packets_.clear();
+  pending_trace_flow_ids_.clear();
+
+  std::unique_ptr<PointerDataPacket> packet;
+  if (packets.size() == 1) {
+    packet = std::move(packets.front());
+  } else {
+    // The packets are dispatched in one call into the framework.
+    size_t count = 0;
+    for (const auto& pending : packets) {
+      count += pending->GetLength();
+    }
+    packet = std::make_unique<PointerDataPacket>(count);
+    size_t index = 0;
+    for (const auto& pending : packets) {
+      for (size_t i = 0; i < pending->GetLength(); i++) {
+        packet->SetPointerData(index++, pending->GetPointerData(i));
+      }
+    }
+    for (size_t i = 0; i + 1 < trace_flow_ids.size(); i++) {
+      TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_ids[i]);
+    }
+  }
+  delegate_.DoDispatchPacket(std::move(packet), trace_flow_ids.back());
+}
+
 }  // namespace flutter
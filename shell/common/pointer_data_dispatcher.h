@@ -7,6 +7,7 @@
 
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/pointer_data_coalescer.h"
 
 namespace flutter {
 
@@ -64,6 +65,22 @@ class PointerDataDispatcher {
     virtual void ScheduleSecondaryVsyncCallback(
         uintptr_t id,
         const fml::closure& callback) = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief    Schedule a callback to be executed right before the frame
+    ///           that is scheduled begins, or at the next vsync if that frame
+    ///           doesn't begin by then.
+    ///
+    ///           This callback is only scheduled to be called once per |id|,
+    ///           and it will be called in the UI thread. It is used by
+    ///           `FrameAlignedPointerDataDispatcher`.
+    ///
+    /// @return   Whether the callback was scheduled. It is not if no frame is
+    ///           scheduled.
+    ///
+    /// @see      `Animator::ScheduleBeginFrameCallback`.
+    virtual bool ScheduleBeginFrameCallback(uintptr_t id,
+                                            const fml::closure& callback) = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -163,6 +180,77 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds the packets received during a frame and dispatches
+/// them as one packet at the next vsync, after coalescing the move and hover
+/// events of each pointer with a `PointerDataCoalescer`.
+///
+/// Input devices that sample faster than the display deliver several moves per
+/// frame, and each of them is otherwise converted and hit tested by the
+/// framework even though only the last one is visible. Coalescing dispatches
+/// at most one move per pointer and frame, and resampling it at a fixed offset
+/// before the newest event smooths out sampling rates that beat with the
+/// display refresh rate.
+///
+/// Packets received while no frame is scheduled still wait for the next vsync,
+/// which it schedules, so this adds up to a frame of latency.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  CoalescingPointerDataDispatcher(Delegate& delegate,
+                                  fml::TimeDelta resampling_offset);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  void DispatchCoalescedPackets();
+
+  PointerDataCoalescer coalescer_;
+  // The trace flow id of the newest packet in `coalescer_`, or 0 if it is
+  // empty. The flows of the packets it replaces end when they are coalesced.
+  uint64_t pending_trace_flow_id_ = 0;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<CoalescingPointerDataDispatcher> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
+//------------------------------------------------------------------------------
+/// A dispatcher that dispatches packets right away while no frame is
+/// scheduled, and otherwise holds them until right before that frame begins.
+///
+/// The first packet of a gesture reaches the framework as soon as possible, so
+/// the frame it requests starts at the next vsync. Packets received while a
+/// frame is pending, including while its begin is deferred until the vsync
+/// target time minus the predicted frame duration, are dispatched together as
+/// the frame begins, so the frame handles the latest events and the framework
+/// handles them at most once per frame.
+class FrameAlignedPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit FrameAlignedPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~FrameAlignedPointerDataDispatcher();
+
+ private:
+  void DispatchPendingPackets();
+
+  std::vector<std::unique_ptr<PointerDataPacket>> pending_packets_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<FrameAlignedPointerDataDispatcher> weak_factory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameAlignedPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    dispatched_lengths.push_back(packet->GetLength());
+    dispatched_trace_flow_ids.push_back(trace_flow_id);
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callbacks.push_back(callback);
+  }
+
+  bool ScheduleBeginFrameCallback(uintptr_t id,
+                                  const fml::closure& callback) override {
+    if (!frame_scheduled) {
+      return false;
+    }
+    begin_frame_callbacks.push_back(callback);
+    return true;
+  }
+
+  void BeginFrame() {
+    auto callbacks = std::move(begin_frame_callbacks);
+    begin_frame_callbacks.clear();
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+  }
+
+  bool frame_scheduled = false;
+  std::vector<size_t> dispatched_lengths;
+  std::vector<uint64_t> dispatched_trace_flow_ids;
+  std::vector<fml::closure> vsync_callbacks;
+  std::vector<fml::closure> begin_frame_callbacks;
+};
+
+std::unique_ptr<PointerDataPacket> CreatePacket(size_t length) {
+  auto packet = std::make_unique<PointerDataPacket>(length);
+  PointerData data;
+  data.Clear();
+  data.change = PointerData::Change::kDown;
+  for (size_t i = 0; i < length; i++) {
+    data.device = i;
+    packet->SetPointerData(i, data);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(PointerDataDispatcherTest, FrameAlignedDispatchesRightAwayWhenIdle) {
+  FakeDispatcherDelegate delegate;
+  FrameAlignedPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(CreatePacket(1), 1);
+  ASSERT_EQ(delegate.dispatched_lengths.size(), 1u);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[0], 1u);
+  EXPECT_TRUE(delegate.begin_frame_callbacks.empty());
+}
+
+TEST(PointerDataDispatcherTest, FrameAlignedHoldsPacketsUntilFrameBegins) {
+  FakeDispatcherDelegate delegate;
+  FrameAlignedPointerDataDispatcher dispatcher(delegate);
+  delegate.frame_scheduled = true;
+
+  dispatcher.DispatchPacket(CreatePacket(1), 1);
+  dispatcher.DispatchPacket(CreatePacket(2), 2);
+  EXPECT_TRUE(delegate.dispatched_lengths.empty());
+  // The callback is scheduled once for the frame.
+  EXPECT_EQ(delegate.begin_frame_callbacks.size(), 1u);
+
+  delegate.BeginFrame();
+  ASSERT_EQ(delegate.dispatched_lengths.size(), 1u);
+  EXPECT_EQ(delegate.dispatched_lengths[0], 3u);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[0], 2u);
+
+  // The next packet is held for the next frame.
+  dispatcher.DispatchPacket(CreatePacket(1), 3);
+  EXPECT_EQ(delegate.begin_frame_callbacks.size(), 1u);
+  delegate.BeginFrame();
+  ASSERT_EQ(delegate.dispatched_lengths.size(), 2u);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[1], 3u);
+}
+
+TEST(PointerDataDispatcherTest, CoalescingDispatchesAtVsync) {
+  FakeDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate,
+                                             fml::TimeDelta::Zero());
+
+  dispatcher.DispatchPacket(CreatePacket(1), 1);
+  dispatcher.DispatchPacket(CreatePacket(1), 2);
+  EXPECT_TRUE(delegate.dispatched_lengths.empty());
+  ASSERT_EQ(delegate.vsync_callbacks.size(), 1u);
+
+  delegate.vsync_callbacks[0]();
+  ASSERT_EQ(delegate.dispatched_lengths.size(), 1u);
+  EXPECT_EQ(delegate.dispatched_lengths[0], 2u);
+  EXPECT_EQ(delegate.dispatched_trace_flow_ids[0], 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
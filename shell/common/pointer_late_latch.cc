@@ -0,0 +1,73 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_late_latch.h"
+
+namespace flutter {
+
+PointerLateLatch::PointerLateLatch() = default;
+
+PointerLateLatch::~PointerLateLatch() = default;
+
+void PointerLateLatch::Tracker::Update(const PointerDataPacket& packet) {
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    PointerData data = packet.GetPointerData(i);
+    if (data.signal_kind != PointerData::SignalKind::kNone) {
+      continue;
+    }
+    if (device.has_value() && device.value() != data.device) {
+      continue;
+    }
+    SkPoint physical = SkPoint::Make(data.physical_x, data.physical_y);
+    switch (data.change) {
+      case PointerData::Change::kDown:
+      case PointerData::Change::kMove:
+        device = data.device;
+        position = physical;
+        break;
+      case PointerData::Change::kPanZoomStart:
+      case PointerData::Change::kPanZoomUpdate:
+        // The pan of a gesture is relative to where it started.
+        device = data.device;
+        position = physical + SkPoint::Make(data.pan_x, data.pan_y);
+        break;
+      case PointerData::Change::kUp:
+      case PointerData::Change::kCancel:
+      case PointerData::Change::kRemove:
+      case PointerData::Change::kPanZoomEnd:
+        device = std::nullopt;
+        position = std::nullopt;
+        break;
+      case PointerData::Change::kAdd:
+      case PointerData::Change::kHover:
+        break;
+    }
+  }
+}
+
+void PointerLateLatch::OnPointersReceived(const PointerDataPacket& packet) {
+  std::scoped_lock lock(mutex_);
+  received_.Update(packet);
+}
+
+void PointerLateLatch::OnPointersDispatched(const PointerDataPacket& packet) {
+  std::scoped_lock lock(mutex_);
+  dispatched_.Update(packet);
+}
+
+std::optional<SkPoint> PointerLateLatch::GetDispatchedPosition() const {
+  std::scoped_lock lock(mutex_);
+  return dispatched_.position;
+}
+
+SkPoint PointerLateLatch::GetDeltaSince(
+    std::optional<SkPoint> dispatched_position) const {
+  std::scoped_lock lock(mutex_);
+  if (!dispatched_position.has_value() || !received_.position.has_value()) {
+    return SkPoint::Make(0, 0);
+  }
+  return received_.position.value() - dispatched_position.value();
+}
+
+}  // namespace flutter
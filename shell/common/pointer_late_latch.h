@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_POINTER_LATE_LATCH_H_
+#define FLUTTER_SHELL_COMMON_POINTER_LATE_LATCH_H_
+
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+#include "third_party/skia/include/core/SkPoint.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Tracks how far the pointer that drives a drag or a trackpad pan has moved
+/// since the framework last saw it, so that the rasterizer can move the layers
+/// that follow it by the distance the frame is behind.
+///
+/// The first pointer that goes down, or the first pan/zoom gesture, is tracked
+/// until it goes up or ends. Its position is recorded both when its events
+/// are received from the platform and when they are dispatched to the
+/// framework. All positions are in physical pixels.
+///
+/// This class is thread safe.
+///
+class PointerLateLatch {
+ public:
+  PointerLateLatch();
+
+  ~PointerLateLatch();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the events of a packet received from the platform.
+  ///
+  void OnPointersReceived(const PointerDataPacket& packet);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the events of a packet dispatched to the framework.
+  ///
+  void OnPointersDispatched(const PointerDataPacket& packet);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The position of the tracked pointer as of the last event
+  ///             dispatched to the framework, if a pointer is tracked.
+  ///
+  std::optional<SkPoint> GetDispatchedPosition() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The distance the tracked pointer has moved since its
+  ///             position was |dispatched_position|, or zero if no pointer
+  ///             was tracked then or is tracked now.
+  ///
+  SkPoint GetDeltaSince(std::optional<SkPoint> dispatched_position) const;
+
+ private:
+  struct Tracker {
+    std::optional<int64_t> device;
+    std::optional<SkPoint> position;
+
+    void Update(const PointerDataPacket& packet);
+  };
+
+  mutable std::mutex mutex_;
+  Tracker received_;
+  Tracker dispatched_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PointerLateLatch);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_POINTER_LATE_LATCH_H_
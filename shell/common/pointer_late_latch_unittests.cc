@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_late_latch.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData CreatePointerData(PointerData::Change change,
+                              int64_t device,
+                              double x,
+                              double y) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_y = y;
+  return data;
+}
+
+std::unique_ptr<PointerDataPacket> CreatePacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+}  // namespace
+
+TEST(PointerLateLatchTest, TracksTheDistanceSinceTheDispatchedPosition) {
+  PointerLateLatch latch;
+  EXPECT_FALSE(latch.GetDispatchedPosition().has_value());
+
+  auto down = CreatePacket({
+      CreatePointerData(PointerData::Change::kDown, 0, 10, 20),
+  });
+  latch.OnPointersReceived(*down);
+  latch.OnPointersDispatched(*down);
+  auto dispatched = latch.GetDispatchedPosition();
+  ASSERT_TRUE(dispatched.has_value());
+  EXPECT_EQ(dispatched.value(), SkPoint::Make(10, 20));
+  EXPECT_EQ(latch.GetDeltaSince(dispatched), SkPoint::Make(0, 0));
+
+  // The events of other pointers are ignored.
+  latch.OnPointersReceived(*CreatePacket({
+      CreatePointerData(PointerData::Change::kMove, 0, 10, 50),
+      CreatePointerData(PointerData::Change::kDown, 1, 100, 100),
+      CreatePointerData(PointerData::Change::kMove, 1, 200, 200),
+  }));
+  EXPECT_EQ(latch.GetDeltaSince(dispatched), SkPoint::Make(0, 30));
+
+  latch.OnPointersReceived(*CreatePacket({
+      CreatePointerData(PointerData::Change::kUp, 0, 10, 50),
+  }));
+  EXPECT_EQ(latch.GetDeltaSince(dispatched), SkPoint::Make(0, 0));
+  EXPECT_EQ(latch.GetDeltaSince(std::nullopt), SkPoint::Make(0, 0));
+}
+
+TEST(PointerLateLatchTest, TracksThePanOfPanZoomGestures) {
+  PointerLateLatch latch;
+  auto start = CreatePacket({
+      CreatePointerData(PointerData::Change::kPanZoomStart, 0, 10, 10),
+  });
+  latch.OnPointersReceived(*start);
+  latch.OnPointersDispatched(*start);
+  auto dispatched = latch.GetDispatchedPosition();
+
+  PointerData update =
+      CreatePointerData(PointerData::Change::kPanZoomUpdate, 0, 10, 10);
+  update.pan_x = -5;
+  update.pan_y = 40;
+  latch.OnPointersReceived(*CreatePacket({update}));
+  EXPECT_EQ(latch.GetDeltaSince(dispatched), SkPoint::Make(-5, 40));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/raster_cache_io_rasterizer.h"
+
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/synchronization/sync_switch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+RasterCacheIORasterizer::RasterCacheIORasterizer(
+    fml::RefPtr<fml::TaskRunner> io_task_runner,
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    fml::WeakPtr<IOManager> io_manager)
+    : io_task_runner_(std::move(io_task_runner)),
+      raster_task_runner_(std::move(raster_task_runner)),
+      io_manager_(std::move(io_manager)) {}
+
+RasterCacheIORasterizer::~RasterCacheIORasterizer() = default;
+
+void RasterCacheIORasterizer::Rasterize(const SkImageInfo& image_info,
+                                        DrawFunction draw_function,
+                                        Callback callback) {
+  io_task_runner_->PostTask(fml::MakeCopyable(
+      [io_manager = io_manager_, raster_task_runner = raster_task_runner_,
+       image_info, draw_function = std::move(draw_function),
+       callback = std::move(callback)]() mutable {
+        TRACE_EVENT0("flutter", "RasterCacheIORasterizer::Rasterize");
+        SkiaGPUObject<SkImage> image;
+        if (io_manager) {
+          io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+              fml::SyncSwitch::Handlers().SetIfFalse([&] {
+                fml::WeakPtr<GrDirectContext> context =
+                    io_manager->GetResourceContext();
+                sk_sp<SkSurface> surface =
+                    context ? SkSurface::MakeRenderTarget(
+                                  context.get(), skgpu::Budgeted::kYes,
+                                  image_info)
+                            : SkSurface::MakeRaster(image_info);
+                if (!surface) {
+                  return;
+                }
+                draw_function(surface->getCanvas());
+                sk_sp<SkImage> snapshot = surface->makeImageSnapshot();
+                // The onscreen context may sample the texture as soon as it
+                // is handed over, so the work must be complete first.
+                surface->flushAndSubmit(true);
+                image = SkiaGPUObject<SkImage>(std::move(snapshot),
+                                               io_manager->GetSkiaUnrefQueue());
+              }));
+        }
+        raster_task_runner->PostTask(fml::MakeCopyable(
+            [image = std::move(image),
+             callback = std::move(callback)]() mutable {
+              callback(std::move(image));
+            }));
+      }));
+}
+
+}  // namespace flutter
@@ -0,0 +1,47 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_RASTER_CACHE_IO_RASTERIZER_H_
+#define FLUTTER_SHELL_COMMON_RASTER_CACHE_IO_RASTERIZER_H_
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/io_manager.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Renders raster cache entries on the IO thread with the resource
+///             context of the IO manager, whose textures the onscreen context
+///             can draw as it does for decoded images.
+///
+///             If the IO manager has no resource context, e.g. for software
+///             rendering, the entries are rendered into raster surfaces.
+///
+class RasterCacheIORasterizer final : public RasterCacheAsyncRasterizer {
+ public:
+  RasterCacheIORasterizer(fml::RefPtr<fml::TaskRunner> io_task_runner,
+                          fml::RefPtr<fml::TaskRunner> raster_task_runner,
+                          fml::WeakPtr<IOManager> io_manager);
+
+  ~RasterCacheIORasterizer() override;
+
+  // |RasterCacheAsyncRasterizer|
+  void Rasterize(const SkImageInfo& image_info,
+                 DrawFunction draw_function,
+                 Callback callback) override;
+
+ private:
+  fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  fml::RefPtr<fml::TaskRunner> raster_task_runner_;
+  fml::WeakPtr<IOManager> io_manager_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheIORasterizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_RASTER_CACHE_IO_RASTERIZER_H_
@@ -6,15 +6,22 @@
 
 #include <algorithm>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 #include "flow/frame_timings.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "fml/make_copyable.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/aiks/aiks_context.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
 #include "third_party/skia/include/core/SkImageEncoder.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkSerialProcs.h"
@@ -28,6 +35,13 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+#if IMPELLER_SUPPORTS_RENDERING
+// The Impeller pipeline variants are stored next to the Skia cache so that they
+// are purged and versioned along with it.
+static constexpr char kImpellerPipelineVariantsFileName[] =
+    "io.flutter.impeller_pipeline_variants";
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -63,6 +77,13 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   if (context_switch->GetResult()) {
     compositor_context_->OnGrContextCreated();
   }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->SetParallelSubpassEncodingEnabled(
+        delegate_.GetSettings().impeller_parallel_subpass_encoding);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  PrewarmImpellerPipelineVariants();
 
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
@@ -75,6 +96,7 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
         delegate_.GetParentRasterThreadMerger(), platform_id, gpu_id);
   }
   if (raster_thread_merger_) {
+    raster_thread_merger_->SetLeaseHysteresisEnabled(true);
     raster_thread_merger_->SetMergeUnmergeCallback([=]() {
       // Clear the GL context after the thread configuration has changed.
       if (surface_) {
@@ -92,6 +114,7 @@ void Rasterizer::TeardownExternalViewEmbedder() {
 
 void Rasterizer::Teardown() {
   if (surface_) {
+    SaveImpellerPipelineVariants();
     auto context_switch = surface_->MakeRenderContextCurrent();
     if (context_switch->GetResult()) {
       compositor_context_->OnGrContextDestroyed();
@@ -102,7 +125,12 @@ void Rasterizer::Teardown() {
     surface_.reset();
   }
 
+  view_records_.clear();
   last_layer_tree_.reset();
+  last_frame_image_.reset();
+  prewarmed_layer_tree_.reset();
+  prewarmed_recorder_.reset();
+  has_prewarmed_offscreen_ = false;
 
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
@@ -112,6 +140,124 @@ void Rasterizer::Teardown() {
   }
 }
 
+void Rasterizer::PrewarmImpellerPipelineVariants() {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (!surface_ || !surface_->GetAiksContext()) {
+    return;
+  }
+  auto cache_directory = std::make_shared<fml::UniqueFD>(
+      PersistentCache::GetCacheForProcess()->DuplicateCacheDirectory());
+  if (!cache_directory->is_valid()) {
+    return;
+  }
+  pipeline_variants_file_io_.ReadFile(
+      std::move(cache_directory), kImpellerPipelineVariantsFileName,
+      /*completion_runner=*/nullptr,
+      [weak_this = GetWeakPtr(),
+       raster_task_runner = delegate_.GetTaskRunners().GetRasterTaskRunner()](
+          std::unique_ptr<fml::FileMapping> mapping) {
+        if (!mapping || mapping->GetSize() == 0u) {
+          return;
+        }
+        auto variants =
+            std::make_shared<const std::vector<impeller::PipelineVariantKey>>(
+                impeller::PipelineVariantKey::Deserialize(std::string_view(
+                    reinterpret_cast<const char*>(mapping->GetMapping()),
+                    mapping->GetSize())));
+        raster_task_runner->PostTask([weak_this, variants]() {
+          if (weak_this) {
+            weak_this->OnImpellerPipelineVariantsLoaded(variants);
+          }
+        });
+      });
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void Rasterizer::OnImpellerPipelineVariantsLoaded(
+    std::shared_ptr<const std::vector<impeller::PipelineVariantKey>>
+        variants) {
+#if IMPELLER_SUPPORTS_RENDERING
+  prewarmed_pipeline_variants_ = std::move(variants);
+  // The surface may have been torn down while the file was read.
+  auto aiks_context = surface_ ? surface_->GetAiksContext() : nullptr;
+  if (!aiks_context) {
+    return;
+  }
+  aiks_context->GetContentContext().PrewarmPipelineVariants(
+      *prewarmed_pipeline_variants_);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void Rasterizer::SaveImpellerPipelineVariants() {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto aiks_context = surface_ ? surface_->GetAiksContext() : nullptr;
+  if (!aiks_context) {
+    return;
+  }
+  // The variants of the previous runs come first, as they are the ones that
+  // were needed the earliest.
+  std::vector<impeller::PipelineVariantKey> variants;
+  if (prewarmed_pipeline_variants_) {
+    variants = *prewarmed_pipeline_variants_;
+  }
+  const size_t prewarmed_count = variants.size();
+  auto used_variants =
+      aiks_context->GetContentContext().GetUsedPipelineVariants();
+  for (auto& used : used_variants) {
+    auto found = std::find_if(
+        variants.begin(), variants.begin() + prewarmed_count,
+        [&used](const impeller::PipelineVariantKey& variant) {
+          return variant.pipeline == used.pipeline &&
+                 impeller::ContentContextOptions::Equal{}(variant.options,
+                                                          used.options);
+        });
+    if (found == variants.begin() + prewarmed_count) {
+      variants.push_back(std::move(used));
+    }
+  }
+  if (variants.size() == prewarmed_count) {
+    return;
+  }
+
+  auto cache_directory = std::make_shared<fml::UniqueFD>(
+      PersistentCache::GetCacheForProcess()->DuplicateCacheDirectory());
+  if (!cache_directory->is_valid()) {
+    return;
+  }
+  auto saved_variants =
+      std::make_shared<const std::vector<impeller::PipelineVariantKey>>(
+          std::move(variants));
+  prewarmed_pipeline_variants_ = saved_variants;
+  pipeline_variants_file_io_.RunOperation(
+      [cache_directory = std::move(cache_directory),
+       saved_variants = std::move(saved_variants)]() {
+        fml::DataMapping mapping(
+            impeller::PipelineVariantKey::Serialize(*saved_variants));
+        if (!fml::WriteAtomically(*cache_directory,
+                                  kImpellerPipelineVariantsFileName, mapping)) {
+          FML_LOG(WARNING) << "Could not save the Impeller pipeline variants.";
+        }
+      });
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void Rasterizer::AddSurface(int64_t view_id, std::unique_ptr<Surface> surface) {
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+  view_records_[view_id] = {.surface = std::move(surface)};
+}
+
+void Rasterizer::RemoveSurface(int64_t view_id) {
+  view_records_.erase(view_id);
+}
+
+Surface* Rasterizer::GetViewSurface(int64_t view_id) const {
+  if (view_id == kFlutterImplicitViewId) {
+    return surface_.get();
+  }
+  auto found = view_records_.find(view_id);
+  return found == view_records_.end() ? nullptr : found->second.surface.get();
+}
+
 void Rasterizer::EnableThreadMergerIfNeeded() {
   if (raster_thread_merger_) {
     raster_thread_merger_->Enable();
@@ -124,23 +270,56 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
   }
 }
 
-void Rasterizer::NotifyLowMemoryWarning() const {
+void Rasterizer::NotifyMemoryPressure(MemoryPressureLevel level) const {
   if (!surface_) {
     FML_DLOG(INFO)
-        << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
+        << "Rasterizer::NotifyMemoryPressure called with no surface.";
     return;
   }
   auto context = surface_->GetContext();
   if (!context) {
     FML_DLOG(INFO)
-        << "Rasterizer::NotifyLowMemoryWarning called with no GrContext.";
+        << "Rasterizer::NotifyMemoryPressure called with no GrContext.";
     return;
   }
   auto context_switch = surface_->MakeRenderContextCurrent();
   if (!context_switch->GetResult()) {
     return;
   }
-  context->performDeferredCleanup(std::chrono::milliseconds(0));
+  switch (level) {
+    case MemoryPressureLevel::kModerate:
+      context->purgeUnlockedResources(/*scratchResourcesOnly=*/true);
+      break;
+    case MemoryPressureLevel::kCritical:
+      context->performDeferredCleanup(std::chrono::milliseconds(0));
+      break;
+    case MemoryPressureLevel::kBackground:
+      context->freeGpuResources();
+      break;
+  }
+}
+
+size_t Rasterizer::GetGpuResourceCacheBytes() const {
+  auto context = surface_ ? surface_->GetContext() : nullptr;
+  if (!context) {
+    return 0u;
+  }
+  size_t bytes = 0u;
+  context->getResourceCacheUsage(nullptr, &bytes);
+  return bytes;
+}
+
+size_t Rasterizer::GetImpellerDeviceMemoryBytes() const {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto aiks_context = surface_ ? surface_->GetAiksContext() : nullptr;
+  if (aiks_context) {
+    return aiks_context->GetContext()
+        ->GetResourceAllocator()
+        ->GetDeviceMemoryStatistics()
+        .GetTotalBytes();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return 0u;
 }
 
 std::shared_ptr<flutter::TextureRegistry> Rasterizer::GetTextureRegistry() {
@@ -160,8 +339,42 @@ void Rasterizer::DrawLastLayerTree(
   if (!last_layer_tree_ || !surface_) {
     return;
   }
+  std::vector<LayerTreeTask> tasks;
+  tasks.emplace_back(kFlutterImplicitViewId, last_layer_tree_);
+  for (const auto& [view_id, record] : view_records_) {
+    if (record.last_layer_tree) {
+      tasks.emplace_back(view_id, record.last_layer_tree);
+    }
+  }
+  RasterStatus raster_status = DrawToSurface(*frame_timings_recorder, tasks);
+
+  // EndFrame should perform cleanups for the external_view_embedder.
+  if (external_view_embedder_ && external_view_embedder_->GetUsedThisFrame()) {
+    bool should_resubmit_frame = ShouldResubmitFrame(raster_status);
+    external_view_embedder_->SetUsedThisFrame(false);
+    external_view_embedder_->EndFrame(should_resubmit_frame,
+                                      raster_thread_merger_);
+  }
+}
+
+RasterStatus Rasterizer::DrawPrewarmedFrame(
+    const LayerTreeDiscardCallback& discard_callback) {
+  TRACE_EVENT0("flutter", "Rasterizer::DrawPrewarmedFrame");
+  if (!prewarmed_layer_tree_ || !surface_) {
+    return RasterStatus::kFailed;
+  }
+  std::shared_ptr<flutter::LayerTree> layer_tree =
+      std::move(prewarmed_layer_tree_);
+  std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
+      std::move(prewarmed_recorder_);
+  if (discard_callback(*layer_tree)) {
+    return RasterStatus::kDiscarded;
+  }
+
+  std::vector<LayerTreeTask> tasks;
+  tasks.emplace_back(kFlutterImplicitViewId, std::move(layer_tree));
   RasterStatus raster_status =
-      DrawToSurface(*frame_timings_recorder, *last_layer_tree_);
+      DoDraw(std::move(frame_timings_recorder), std::move(tasks));
 
   // EndFrame should perform cleanups for the external_view_embedder.
   if (external_view_embedder_ && external_view_embedder_->GetUsedThisFrame()) {
@@ -170,6 +383,7 @@ void Rasterizer::DrawLastLayerTree(
     external_view_embedder_->EndFrame(should_resubmit_frame,
                                       raster_thread_merger_);
   }
+  return raster_status;
 }
 
 RasterStatus Rasterizer::Draw(
@@ -188,14 +402,30 @@ RasterStatus Rasterizer::Draw(
   RasterStatus raster_status = RasterStatus::kFailed;
   LayerTreePipeline::Consumer consumer =
       [&](std::unique_ptr<LayerTreeItem> item) {
-        std::shared_ptr<LayerTree> layer_tree = std::move(item->layer_tree);
+        std::vector<LayerTreeTask> tasks =
+            std::move(item->layer_tree_tasks);
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
             std::move(item->frame_timings_recorder);
-        if (discard_callback(*layer_tree.get())) {
+        // Only the implicit view is resized by the platform view, so the
+        // other views are drawn even if its layer tree is discarded. Those
+        // of the other views are discarded once the views are removed.
+        auto should_discard = [&](const LayerTreeTask& task) {
+          if (task.view_id == kFlutterImplicitViewId) {
+            return discard_callback(*task.layer_tree);
+          }
+          return GetViewSurface(task.view_id) == nullptr;
+        };
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), should_discard),
+                    tasks.end());
+        if (tasks.empty()) {
+          raster_status = RasterStatus::kDiscarded;
+        } else if (IsSuperseded(*pipeline, *frame_timings_recorder)) {
+          TRACE_EVENT0("flutter", "Rasterizer::DiscardSupersededFrame");
+          discarded_frame_count_++;
           raster_status = RasterStatus::kDiscarded;
         } else {
           raster_status =
-              DoDraw(std::move(frame_timings_recorder), std::move(layer_tree));
+              DoDraw(std::move(frame_timings_recorder), std::move(tasks));
         }
       };
 
@@ -209,7 +439,9 @@ RasterStatus Rasterizer::Draw(
   bool should_resubmit_frame = ShouldResubmitFrame(raster_status);
   if (should_resubmit_frame) {
     auto resubmitted_layer_tree_item = std::make_unique<LayerTreeItem>(
-        std::move(resubmitted_layer_tree_), std::move(resubmitted_recorder_));
+        std::move(resubmitted_layer_tree_tasks_),
+        std::move(resubmitted_recorder_));
+    resubmitted_layer_tree_tasks_.clear();
     auto front_continuation = pipeline->ProduceIfEmpty();
     PipelineProduceResult result =
         front_continuation.Complete(std::move(resubmitted_layer_tree_item));
@@ -254,6 +486,16 @@ bool Rasterizer::ShouldResubmitFrame(const RasterStatus& raster_status) {
          raster_status == RasterStatus::kSkipAndRetry;
 }
 
+bool Rasterizer::IsSuperseded(
+    LayerTreePipeline& pipeline,
+    const FrameTimingsRecorder& frame_timings_recorder) const {
+  // A tree that is still on time is drawn even when another one is waiting,
+  // so that the frames of a pipeline that is deeper than one are not dropped.
+  return delegate_.GetSettings().discard_superseded_frames &&
+         pipeline.GetPendingCount() > 0 &&
+         frame_timings_recorder.GetVsyncTargetTime() < fml::TimePoint::Now();
+}
+
 namespace {
 std::unique_ptr<SnapshotDelegate::GpuImageResult> MakeBitmapImage(
     const sk_sp<DisplayList>& display_list,
@@ -356,32 +598,55 @@ sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
   return snapshot_controller_->ConvertToRasterImage(image);
 }
 
+void Rasterizer::PostIdleTask(fml::closure task) {
+  const auto& raster_task_runner =
+      delegate_.GetTaskRunners().GetRasterTaskRunner();
+  if (auto idle_task_queue = idle_task_queue_.lock()) {
+    // The tasks produce images that the app is waiting for, so they wait for
+    // less than the other idle work.
+    idle_task_queue->PostTask(raster_task_runner, std::move(task),
+                              fml::TimeDelta::FromMilliseconds(100));
+  } else {
+    raster_task_runner->PostTask(std::move(task));
+  }
+}
+
 fml::Milliseconds Rasterizer::GetFrameBudget() const {
   return delegate_.GetFrameBudget();
 };
 
 RasterStatus Rasterizer::DoDraw(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
-    std::shared_ptr<flutter::LayerTree> layer_tree) {
+    std::vector<LayerTreeTask> tasks) {
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder, "flutter",
                                 "Rasterizer::DoDraw");
   FML_DCHECK(delegate_.GetTaskRunners()
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
-  if (!layer_tree || !surface_) {
+  if (tasks.empty()) {
+    return RasterStatus::kFailed;
+  }
+
+  if (!surface_) {
+    auto implicit_view_task = std::find_if(
+        tasks.begin(), tasks.end(), [](const LayerTreeTask& task) {
+          return task.view_id == kFlutterImplicitViewId;
+        });
+    if (delegate_.GetSettings().prewarm_first_frame &&
+        implicit_view_task != tasks.end()) {
+      PrewarmFrame(std::move(frame_timings_recorder),
+                   std::move(implicit_view_task->layer_tree));
+    }
     return RasterStatus::kFailed;
   }
 
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
-  RasterStatus raster_status =
-      DrawToSurface(*frame_timings_recorder, *layer_tree);
-  if (raster_status == RasterStatus::kSuccess) {
-    last_layer_tree_ = std::move(layer_tree);
-  } else if (ShouldResubmitFrame(raster_status)) {
-    resubmitted_layer_tree_ = std::move(layer_tree);
+  RasterStatus raster_status = DrawToSurface(*frame_timings_recorder, tasks);
+  if (ShouldResubmitFrame(raster_status)) {
+    resubmitted_layer_tree_tasks_ = std::move(tasks);
     resubmitted_recorder_ = frame_timings_recorder->CloneUntil(
         FrameTimingsRecorder::State::kBuildEnd);
     return raster_status;
@@ -399,7 +664,11 @@ RasterStatus Rasterizer::DoDraw(
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
-  delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
+  FrameTiming timing = frame_timings_recorder->GetRecordedTime();
+  timing.SetDiscardedFrameCount(discarded_frame_count_);
+  discarded_frame_count_ = 0;
+  CaptureFrame(tasks, timing);
+  delegate_.OnFrameRasterized(timing);
 
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
@@ -461,22 +730,79 @@ RasterStatus Rasterizer::DoDraw(
   return raster_status;
 }
 
+void Rasterizer::PrewarmFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
+    std::shared_ptr<flutter::LayerTree> layer_tree) {
+  TRACE_EVENT0("flutter", "Rasterizer::PrewarmFrame");
+  // Impeller builds its pipelines when its context is created, so there is
+  // nothing to warm up by rasterizing the frame ahead.
+  const bool should_rasterize_offscreen =
+      !has_prewarmed_offscreen_ && snapshot_surface_producer_ &&
+      !delegate_.GetSettings().enable_impeller;
+  prewarmed_layer_tree_ = std::move(layer_tree);
+  prewarmed_recorder_ = std::move(frame_timings_recorder);
+  if (!should_rasterize_offscreen) {
+    return;
+  }
+  has_prewarmed_offscreen_ = true;
+
+  // The snapshot surface renders with the context that the on-screen surface
+  // is going to use, so the shaders compiled here are not compiled again
+  // when the frame is drawn on screen.
+  std::unique_ptr<Surface> snapshot_surface =
+      snapshot_surface_producer_->CreateSnapshotSurface();
+  if (!snapshot_surface || !snapshot_surface->GetContext()) {
+    return;
+  }
+  auto context_switch = snapshot_surface->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  GrDirectContext* surface_context = snapshot_surface->GetContext();
+  OffscreenSurface offscreen_surface(surface_context,
+                                     prewarmed_layer_tree_->frame_size());
+  if (!offscreen_surface.IsValid()) {
+    return;
+  }
+  auto* canvas = offscreen_surface.GetCanvas();
+
+  SkMatrix root_surface_transformation;
+  root_surface_transformation.reset();
+  delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        auto frame = compositor_context_->AcquireFrame(
+            surface_context,              // skia context
+            canvas,                       // canvas
+            nullptr,                      // view embedder
+            root_surface_transformation,  // root surface transformation
+            false,                        // instrumentation enabled
+            true,                         // render buffer readback supported
+            nullptr,                      // thread merger
+            nullptr,                      // display list builder
+            nullptr                       // aiks context
+        );
+        canvas->clear(SK_ColorTRANSPARENT);
+        frame->Raster(*prewarmed_layer_tree_, true, nullptr);
+        canvas->flush();
+      }));
+}
+
 RasterStatus Rasterizer::DrawToSurface(
     FrameTimingsRecorder& frame_timings_recorder,
-    flutter::LayerTree& layer_tree) {
+    const std::vector<LayerTreeTask>& tasks) {
   TRACE_EVENT0("flutter", "Rasterizer::DrawToSurface");
   FML_DCHECK(surface_);
 
   RasterStatus raster_status;
   if (surface_->AllowsDrawingWhenGpuDisabled()) {
-    raster_status = DrawToSurfaceUnsafe(frame_timings_recorder, layer_tree);
+    raster_status = DrawToSurfaceUnsafe(frame_timings_recorder, tasks);
   } else {
     delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
         fml::SyncSwitch::Handlers()
             .SetIfTrue([&] { raster_status = RasterStatus::kDiscarded; })
             .SetIfFalse([&] {
               raster_status =
-                  DrawToSurfaceUnsafe(frame_timings_recorder, layer_tree);
+                  DrawToSurfaceUnsafe(frame_timings_recorder, tasks);
             }));
   }
 
@@ -488,32 +814,188 @@ RasterStatus Rasterizer::DrawToSurface(
 /// \see Rasterizer::DrawToSurface
 RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     FrameTimingsRecorder& frame_timings_recorder,
-    flutter::LayerTree& layer_tree) {
+    const std::vector<LayerTreeTask>& tasks) {
   FML_DCHECK(surface_);
 
   compositor_context_->ui_time().SetLapTime(
       frame_timings_recorder.GetBuildDuration());
 
-  SkCanvas* embedder_root_canvas = nullptr;
-  if (external_view_embedder_) {
-    FML_DCHECK(!external_view_embedder_->GetUsedThisFrame());
-    external_view_embedder_->SetUsedThisFrame(true);
-    external_view_embedder_->BeginFrame(
-        layer_tree.frame_size(), surface_->GetContext(),
-        layer_tree.device_pixel_ratio(), raster_thread_merger_);
-    embedder_root_canvas = external_view_embedder_->GetRootCanvas();
+  const Settings& settings = delegate_.GetSettings();
+  if (settings.render_on_demand && IsFrameUndamaged(tasks)) {
+    // What the surfaces show is still up to date, so they aren't touched.
+    TRACE_EVENT0("flutter", "Rasterizer::SkipUndamagedFrame");
+    frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
+    for (const LayerTreeTask& task : tasks) {
+      if (task.view_id == kFlutterImplicitViewId) {
+        last_layer_tree_ = task.layer_tree;
+      } else {
+        view_records_[task.view_id].last_layer_tree = task.layer_tree;
+      }
+    }
+    frame_timings_recorder.RecordRasterEnd(
+        &compositor_context_->raster_cache());
+    return RasterStatus::kSuccess;
   }
 
+  // The views share the raster cache, which only evicts the entries that not
+  // one of them encountered once the last of them that uses it is painted.
+  const size_t view_count = std::count_if(
+      tasks.begin(), tasks.end(), [this](const LayerTreeTask& task) {
+        Surface* surface = GetViewSurface(task.view_id);
+        return surface && surface->EnableRasterCache() &&
+               !task.layer_tree->is_leaf_layer_tracing_enabled();
+      });
+  compositor_context_->raster_cache().BeginFrame(view_count);
+
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
 
+  RasterStatus raster_status = RasterStatus::kFailed;
+  bool submitted_view = false;
+  for (const LayerTreeTask& task : tasks) {
+    Surface* surface = GetViewSurface(task.view_id);
+    if (!surface) {
+      // The view was removed after its layer tree was built.
+      continue;
+    }
+    const bool is_implicit_view = task.view_id == kFlutterImplicitViewId;
+    std::shared_ptr<flutter::LayerTree>& last_layer_tree =
+        is_implicit_view ? last_layer_tree_
+                         : view_records_[task.view_id].last_layer_tree;
+    RasterStatus view_status = DrawLayerTreeUnsafe(
+        frame_timings_recorder, task.view_id, *surface, *task.layer_tree,
+        last_layer_tree.get());
+    if (view_status == RasterStatus::kSuccess) {
+      last_layer_tree = task.layer_tree;
+    }
+    if (view_status == RasterStatus::kSuccess ||
+        view_status == RasterStatus::kResubmit) {
+      submitted_view = true;
+    }
+    if (ShouldResubmitFrame(view_status)) {
+      raster_status = view_status;
+      break;
+    }
+    // The status of the implicit view is that of the frame.
+    if (is_implicit_view || raster_status == RasterStatus::kFailed) {
+      raster_status = view_status;
+    }
+  }
+
+  if (submitted_view) {
+    compositor_context_->raster_cache().EndFrame();
+    frame_timings_recorder.RecordDeviceMemoryUsage(
+        GetImpellerDeviceMemoryBytes());
+  }
+  frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
+  if (submitted_view) {
+    FireNextFrameCallbackIfPresent();
+
+    // The views share the context, which is cleaned up once per frame.
+    if (surface_->GetContext()) {
+      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+    }
+
+    if (settings.render_on_demand) {
+      last_draw_time_ = fml::TimePoint::Now();
+      if (!resource_trim_scheduled_) {
+        resource_trim_scheduled_ = true;
+        ScheduleResourceTrim(settings.render_on_demand_resource_trim_delay);
+      }
+    }
+  }
+
+  return raster_status;
+}
+
+bool Rasterizer::IsFrameUndamaged(
+    const std::vector<LayerTreeTask>& tasks) const {
+  // The platform views composited by the embedder and the layers that follow
+  // the pointer may change without the layer tree changing.
+  if (external_view_embedder_ || pointer_late_latch_) {
+    return false;
+  }
+  // Every layer tree is diffed, even once the frame is known to be damaged,
+  // so that the paint regions the next frame is compared with are recorded.
+  bool undamaged = true;
+  for (const LayerTreeTask& task : tasks) {
+    Surface* surface = GetViewSurface(task.view_id);
+    if (!surface) {
+      // The view was removed after its layer tree was built.
+      continue;
+    }
+    const LayerTree* last_layer_tree = nullptr;
+    if (task.view_id == kFlutterImplicitViewId) {
+      last_layer_tree = last_layer_tree_.get();
+    } else {
+      auto found = view_records_.find(task.view_id);
+      last_layer_tree = found->second.last_layer_tree.get();
+    }
+    // Texture layers are always damaged, so the frames that only update
+    // textures are drawn.
+    FrameDamage damage;
+    damage.SetPreviousLayerTree(last_layer_tree);
+    if (!damage.ComputeClipRect(*task.layer_tree,
+                                surface->EnableRasterCache()) ||
+        !last_layer_tree || task.layer_tree->is_leaf_layer_tracing_enabled() ||
+        !damage.GetFrameDamage()->isEmpty()) {
+      undamaged = false;
+    }
+  }
+  return undamaged;
+}
+
+void Rasterizer::ScheduleResourceTrim(fml::TimeDelta delay) {
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (!weak_this) {
+          return;
+        }
+        const auto idle_duration =
+            fml::TimePoint::Now() - weak_this->last_draw_time_;
+        const auto trim_delay =
+            weak_this->delegate_.GetSettings()
+                .render_on_demand_resource_trim_delay;
+        if (idle_duration < trim_delay) {
+          // A frame was drawn since the trim was scheduled.
+          weak_this->ScheduleResourceTrim(trim_delay - idle_duration);
+          return;
+        }
+        TRACE_EVENT0("flutter", "Rasterizer::TrimIdleResources");
+        weak_this->resource_trim_scheduled_ = false;
+        weak_this->NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+      },
+      delay);
+}
+
+RasterStatus Rasterizer::DrawLayerTreeUnsafe(
+    FrameTimingsRecorder& frame_timings_recorder,
+    int64_t view_id,
+    Surface& surface,
+    flutter::LayerTree& layer_tree,
+    flutter::LayerTree* last_layer_tree) {
+  // Platform views are only embedded in the implicit view.
+  ExternalViewEmbedder* external_view_embedder =
+      view_id == kFlutterImplicitViewId ? external_view_embedder_.get()
+                                        : nullptr;
+
+  SkCanvas* embedder_root_canvas = nullptr;
+  DisplayListBuilder* embedder_root_builder = nullptr;
+  if (external_view_embedder) {
+    FML_DCHECK(!external_view_embedder->GetUsedThisFrame());
+    external_view_embedder->SetUsedThisFrame(true);
+    external_view_embedder->BeginFrame(
+        layer_tree.frame_size(), surface.GetContext(),
+        layer_tree.device_pixel_ratio(), raster_thread_merger_);
+    embedder_root_canvas = external_view_embedder->GetRootCanvas();
+    embedder_root_builder = external_view_embedder->GetRootBuilder();
+  }
+
   // On Android, the external view embedder deletes surfaces in `BeginFrame`.
   //
   // Deleting a surface also clears the GL context. Therefore, acquire the
   // frame after calling `BeginFrame` as this operation resets the GL context.
-  auto frame = surface_->AcquireFrame(layer_tree.frame_size());
+  auto frame = surface.AcquireFrame(layer_tree.frame_size());
   if (frame == nullptr) {
-    frame_timings_recorder.RecordRasterEnd(
-        &compositor_context_->raster_cache());
     return RasterStatus::kFailed;
   }
 
@@ -521,42 +1003,60 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   // root surface transformation is set by the embedder instead of
   // having to apply it here.
   SkMatrix root_surface_transformation =
-      embedder_root_canvas ? SkMatrix{} : surface_->GetRootTransformation();
+      embedder_root_canvas ? SkMatrix{} : surface.GetRootTransformation();
 
   auto root_surface_canvas =
       embedder_root_canvas ? embedder_root_canvas : frame->SkiaCanvas();
 
+  // Only frames that are recorded into display lists render the builder.
+  DisplayListBuilder* root_surface_builder =
+      frame->GetDisplayListBuilder().get();
+  if (root_surface_builder && embedder_root_builder) {
+    root_surface_builder = embedder_root_builder;
+  }
+
   auto compositor_frame = compositor_context_->AcquireFrame(
-      surface_->GetContext(),         // skia GrContext
-      root_surface_canvas,            // root surface canvas
-      external_view_embedder_.get(),  // external view embedder
-      root_surface_transformation,    // root surface transformation
-      true,                           // instrumentation enabled
+      surface.GetContext(),         // skia GrContext
+      root_surface_canvas,          // root surface canvas
+      external_view_embedder,       // external view embedder
+      root_surface_transformation,  // root surface transformation
+      true,                         // instrumentation enabled
       frame->framebuffer_info()
           .supports_readback,                // surface supports pixel reads
       raster_thread_merger_,                 // thread merger
-      frame->GetDisplayListBuilder().get(),  // display list builder
-      surface_->GetAiksContext()             // aiks context
+      root_surface_builder,                  // display list builder
+      surface.GetAiksContext()               // aiks context
   );
   if (compositor_frame) {
-    compositor_context_->raster_cache().BeginFrame();
+    // Catch the layers that follow the pointer up with the events received
+    // since the tree was built.
+    SkPoint pointer_delta = SkPoint::Make(0, 0);
+    if (pointer_late_latch_) {
+      pointer_delta = pointer_late_latch_->GetDeltaSince(
+          layer_tree.built_pointer_position());
+      pointer_delta.scale(1.0f / layer_tree.device_pixel_ratio());
+    }
+    layer_tree.set_late_latched_pointer_delta(pointer_delta);
 
     std::unique_ptr<FrameDamage> damage;
     // when leaf layer tracing is enabled we wish to repaint the whole frame
-    // for accurate performance metrics.
+    // for accurate performance metrics. Retained layers that were moved by
+    // the late latched pointer delta are not diffed, so their frames are
+    // repainted whole too.
     if (frame->framebuffer_info().supports_partial_repaint &&
-        !layer_tree.is_leaf_layer_tracing_enabled()) {
+        !layer_tree.is_leaf_layer_tracing_enabled() &&
+        pointer_delta.isZero()) {
       // Disable partial repaint if external_view_embedder_ SubmitFrame is
       // involved - ExternalViewEmbedder unconditionally clears the entire
       // surface and also partial repaint with platform view present is
       // something that still need to be figured out.
       bool force_full_repaint =
-          external_view_embedder_ &&
+          external_view_embedder &&
           (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
 
       damage = std::make_unique<FrameDamage>();
       if (frame->framebuffer_info().existing_damage && !force_full_repaint) {
-        damage->SetPreviousLayerTree(last_layer_tree_.get());
+        damage->SetPreviousLayerTree(last_layer_tree);
         damage->AddAdditionalDamage(*frame->framebuffer_info().existing_damage);
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
@@ -565,11 +1065,24 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     }
 
     bool ignore_raster_cache = true;
-    if (surface_->EnableRasterCache() &&
+    if (surface.EnableRasterCache() &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
       ignore_raster_cache = false;
     }
 
+    layer_tree.enable_paint_list(delegate_.GetSettings().enable_paint_list);
+
+    size_t parallel_paint_tasks = delegate_.GetSettings().parallel_paint_tasks;
+    if (parallel_paint_tasks > 1 && !parallel_painter_) {
+      // The raster thread paints one of the runs of children itself.
+      paint_loop_ =
+          fml::ConcurrentMessageLoop::Create(parallel_paint_tasks - 1);
+      parallel_painter_ = std::make_shared<LayerParallelPainter>(
+          paint_loop_->GetTaskRunner(), parallel_paint_tasks,
+          delegate_.GetSettings().parallel_paint_deferred_display_lists);
+    }
+    layer_tree.set_parallel_painter(parallel_painter_);
+
     RasterStatus raster_status =
         compositor_frame->Raster(layer_tree,           // layer tree
                                  ignore_raster_cache,  // ignore raster cache
@@ -596,24 +1109,23 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
 
     frame->set_submit_info(submit_info);
 
-    if (external_view_embedder_ &&
+    if (external_view_embedder &&
         (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
       FML_DCHECK(!frame->IsSubmitted());
-      external_view_embedder_->SubmitFrame(surface_->GetContext(),
-                                           std::move(frame));
+      // The surface only has part of the frame when the platform views are
+      // composited by the embedder, so the frame can't be retained.
+      last_frame_image_.reset();
+      external_view_embedder->SubmitFrame(surface.GetContext(),
+                                          std::move(frame));
     } else {
+      if (view_id == kFlutterImplicitViewId &&
+          delegate_.GetSettings().retain_last_frame_for_screenshots &&
+          frame->SkiaSurface()) {
+        last_frame_image_ = frame->SkiaSurface()->makeImageSnapshot();
+      }
       frame->Submit();
     }
 
-    compositor_context_->raster_cache().EndFrame();
-    frame_timings_recorder.RecordRasterEnd(
-        &compositor_context_->raster_cache());
-    FireNextFrameCallbackIfPresent();
-
-    if (surface_->GetContext()) {
-      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
-    }
-
     return raster_status;
   }
 
@@ -650,11 +1162,31 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   return recorder.finishRecordingAsPicture()->serialize(&procs);
 }
 
-sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
+sk_sp<SkImage> Rasterizer::ScreenshotLayerTreeAsRasterImage(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context,
-    GrDirectContext* surface_context,
-    bool compressed) {
+    GrDirectContext* surface_context) {
+  // snapshot_surface->makeImageSnapshot needs the GL context to be set if the
+  // render context is GL. frame->Raster() pops the gl context in platforms
+  // that gl context switching are used. (For example, older iOS that uses GL)
+  // We reset the GL context using the context switch.
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    FML_LOG(ERROR) << "Screenshot: unable to make image screenshot";
+    return nullptr;
+  }
+
+  // The frame that was drawn last is read back as is instead of drawing the
+  // layer tree again.
+  if (last_frame_image_ &&
+      last_frame_image_->dimensions() == tree->frame_size()) {
+    auto cpu_snapshot = last_frame_image_->makeRasterImage();
+    if (cpu_snapshot) {
+      return cpu_snapshot;
+    }
+    FML_LOG(ERROR) << "Screenshot: unable to read back the last frame";
+  }
+
   // Attempt to create a snapshot surface depending on whether we have access
   // to a valid GPU rendering context.
   std::unique_ptr<OffscreenSurface> snapshot_surface =
@@ -673,16 +1205,6 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
   SkMatrix root_surface_transformation;
   root_surface_transformation.reset();
 
-  // snapshot_surface->makeImageSnapshot needs the GL context to be set if the
-  // render context is GL. frame->Raster() pops the gl context in platforms
-  // that gl context switching are used. (For example, older iOS that uses GL)
-  // We reset the GL context using the context switch.
-  auto context_switch = surface_->MakeRenderContextCurrent();
-  if (!context_switch->GetResult()) {
-    FML_LOG(ERROR) << "Screenshot: unable to make image screenshot";
-    return nullptr;
-  }
-
   auto frame = compositor_context.AcquireFrame(
       surface_context,              // skia context
       canvas,                       // canvas
@@ -698,7 +1220,67 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
   frame->Raster(*tree, true, nullptr);
   canvas->flush();
 
-  return snapshot_surface->GetRasterData(compressed);
+  return snapshot_surface->MakeRasterImage();
+}
+
+sk_sp<SkData> Rasterizer::EncodeScreenshotImage(const sk_sp<SkImage>& image,
+                                                ScreenshotType type) {
+  if (!image) {
+    return nullptr;
+  }
+  switch (type) {
+    case ScreenshotType::CompressedImage:
+      return image->encodeToData();
+    case ScreenshotType::CompressedJpegImage:
+      return image->encodeToData(SkEncodedImageFormat::kJPEG, 90);
+    case ScreenshotType::UncompressedImage: {
+      SkPixmap pixmap;
+      if (!image->peekPixels(&pixmap)) {
+        FML_LOG(ERROR) << "Screenshot: unable to obtain bitmap pixels";
+        return nullptr;
+      }
+      return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
+    }
+    case ScreenshotType::SkiaPicture:
+    case ScreenshotType::SurfaceData:
+      break;
+  }
+  return nullptr;
+}
+
+Rasterizer::Screenshot Rasterizer::MakeScreenshot(sk_sp<SkData> data,
+                                                  SkISize frame_size,
+                                                  std::string format,
+                                                  bool base64_encode) {
+  if (data == nullptr) {
+    FML_LOG(ERROR) << "Screenshot data was null.";
+    return {};
+  }
+
+  if (base64_encode) {
+    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
+    auto b64_data = SkData::MakeUninitialized(b64_size);
+    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
+    return Rasterizer::Screenshot{b64_data, frame_size, format};
+  }
+
+  return Rasterizer::Screenshot{data, frame_size, format};
+}
+
+std::string Rasterizer::GetScreenshotFormat(ScreenshotType type) {
+  switch (type) {
+    case ScreenshotType::SkiaPicture:
+      return "ScreenshotType::SkiaPicture";
+    case ScreenshotType::UncompressedImage:
+      return "ScreenshotType::UncompressedImage";
+    case ScreenshotType::CompressedImage:
+      return "ScreenshotType::CompressedImage";
+    case ScreenshotType::CompressedJpegImage:
+      return "ScreenshotType::CompressedJpegImage";
+    case ScreenshotType::SurfaceData:
+      break;
+  }
+  return "";
 }
 
 Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
@@ -711,25 +1293,22 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   }
 
   sk_sp<SkData> data = nullptr;
-  std::string format;
+  std::string format = GetScreenshotFormat(type);
 
   GrDirectContext* surface_context =
       surface_ ? surface_->GetContext() : nullptr;
 
   switch (type) {
     case ScreenshotType::SkiaPicture:
-      format = "ScreenshotType::SkiaPicture";
       data = ScreenshotLayerTreeAsPicture(layer_tree, *compositor_context_);
       break;
     case ScreenshotType::UncompressedImage:
-      format = "ScreenshotType::UncompressedImage";
-      data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
-                                        surface_context, false);
-      break;
     case ScreenshotType::CompressedImage:
-      format = "ScreenshotType::CompressedImage";
-      data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
-                                        surface_context, true);
+    case ScreenshotType::CompressedJpegImage:
+      data = EncodeScreenshotImage(
+          ScreenshotLayerTreeAsRasterImage(layer_tree, *compositor_context_,
+                                           surface_context),
+          type);
       break;
     case ScreenshotType::SurfaceData: {
       Surface::SurfaceData surface_data = surface_->GetSurfaceData();
@@ -739,19 +1318,110 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
     }
   }
 
-  if (data == nullptr) {
-    FML_LOG(ERROR) << "Screenshot data was null.";
-    return {};
+  return MakeScreenshot(std::move(data), layer_tree->frame_size(),
+                        std::move(format), base64_encode);
+}
+
+void Rasterizer::ScreenshotLastLayerTreeAsync(
+    ScreenshotType type,
+    bool base64_encode,
+    const std::shared_ptr<fml::BasicTaskRunner>& encode_task_runner,
+    ScreenshotCallback callback) {
+  FML_DCHECK(encode_task_runner);
+  auto* layer_tree = GetLastLayerTree();
+  if (layer_tree == nullptr ||
+      (type != ScreenshotType::UncompressedImage &&
+       type != ScreenshotType::CompressedImage &&
+       type != ScreenshotType::CompressedJpegImage)) {
+    // There is nothing to encode off the raster thread.
+    encode_task_runner->PostTask(
+        [callback = std::move(callback),
+         screenshot = ScreenshotLastLayerTree(type, base64_encode)]() {
+          callback(screenshot);
+        });
+    return;
   }
 
-  if (base64_encode) {
-    size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
-    auto b64_data = SkData::MakeUninitialized(b64_size);
-    SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
-    return Rasterizer::Screenshot{b64_data, layer_tree->frame_size(), format};
+  TRACE_EVENT0("flutter", "Rasterizer::ScreenshotLastLayerTreeAsync");
+  sk_sp<SkImage> image = ScreenshotLayerTreeAsRasterImage(
+      layer_tree, *compositor_context_,
+      surface_ ? surface_->GetContext() : nullptr);
+  encode_task_runner->PostTask([callback = std::move(callback),
+                                image = std::move(image), type, base64_encode,
+                                frame_size = layer_tree->frame_size()]() {
+    TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+    callback(MakeScreenshot(EncodeScreenshotImage(image, type), frame_size,
+                            GetScreenshotFormat(type), base64_encode));
+  });
+}
+
+void Rasterizer::StartFrameCapture(size_t frame_count) {
+  frame_capture_ = std::make_unique<DisplayListFrameCapture>();
+  frame_capture_frame_count_ = frame_count;
+}
+
+std::pair<size_t, size_t> Rasterizer::GetFrameCaptureProgress() const {
+  if (!frame_capture_) {
+    return {0, 0};
   }
+  return {frame_capture_->frame_count(), frame_capture_frame_count_};
+}
 
-  return Rasterizer::Screenshot{data, layer_tree->frame_size(), format};
+sk_sp<SkData> Rasterizer::TakeFrameCapture() {
+  if (!frame_capture_ ||
+      frame_capture_->frame_count() < frame_capture_frame_count_) {
+    return nullptr;
+  }
+  sk_sp<SkData> data = frame_capture_->Serialize();
+  frame_capture_.reset();
+  frame_capture_frame_count_ = 0;
+  return data;
+}
+
+void Rasterizer::CaptureFrame(const std::vector<LayerTreeTask>& tasks,
+                              const FrameTiming& timing) {
+  if (!frame_capture_ ||
+      frame_capture_->frame_count() >= frame_capture_frame_count_ ||
+      !surface_) {
+    return;
+  }
+  auto implicit_view_task = std::find_if(
+      tasks.begin(), tasks.end(), [](const LayerTreeTask& task) {
+        return task.view_id == kFlutterImplicitViewId;
+      });
+  if (implicit_view_task == tasks.end() || !implicit_view_task->layer_tree) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::CaptureFrame");
+
+  // The textures are drawn and the texture images are read back with the
+  // context of the surface.
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    FML_LOG(ERROR) << "Frame capture: unable to make the context current.";
+    return;
+  }
+  LayerTree& layer_tree = *implicit_view_task->layer_tree;
+  sk_sp<DisplayList> display_list =
+      layer_tree.Flatten(SkRect::Make(layer_tree.frame_size()),
+                         compositor_context_->texture_registry(),
+                         surface_->GetContext());
+  bool added = frame_capture_->AddFrame(
+      {
+          .frame_size = layer_tree.frame_size(),
+          .device_pixel_ratio = layer_tree.device_pixel_ratio(),
+          .build_time = timing.Get(FrameTiming::kBuildFinish) -
+                        timing.Get(FrameTiming::kBuildStart),
+          .raster_time = timing.Get(FrameTiming::kRasterFinish) -
+                         timing.Get(FrameTiming::kRasterStart),
+          .display_list = std::move(display_list),
+      },
+      /*read_back_texture_images=*/true);
+  // The capture waits for the next frame instead.
+  if (!added) {
+    FML_LOG(ERROR) << "Frame capture: the frame draws images or Skia objects "
+                      "that can't be serialized.";
+  }
 }
 
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
@@ -768,6 +1438,16 @@ void Rasterizer::SetSnapshotSurfaceProducer(
   snapshot_surface_producer_ = std::move(producer);
 }
 
+void Rasterizer::SetIdleTaskQueue(
+    std::weak_ptr<IdleTaskQueue> idle_task_queue) {
+  idle_task_queue_ = std::move(idle_task_queue);
+}
+
+void Rasterizer::SetPointerLateLatch(
+    std::shared_ptr<const PointerLateLatch> pointer_late_latch) {
+  pointer_late_latch_ = std::move(pointer_late_latch);
+}
+
 fml::RefPtr<fml::RasterThreadMerger> Rasterizer::GetRasterThreadMerger() {
   return raster_thread_merger_;
 }
@@ -792,6 +1472,8 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 
   max_cache_bytes_ = max_bytes;
+  compositor_context_->raster_cache().SetMaxBytes(static_cast<size_t>(
+      max_bytes * RasterCacheUtil::kResourceCacheFractionForRasterCache));
   if (!surface_) {
     return;
   }
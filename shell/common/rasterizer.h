@@ -5,31 +5,46 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/display_list/display_list_frame_capture.h"
 #include "flutter/display_list/display_list_image.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
+#include "flutter/fml/async_file_io.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/idle_task_queue.h"
+#include "flutter/shell/common/memory_pressure_registry.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/pointer_late_latch.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
+namespace impeller {
+struct PipelineVariantKey;
+}  // namespace impeller
+
 namespace flutter {
 
 //------------------------------------------------------------------------------
@@ -162,6 +177,28 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void Teardown();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the on-screen render surface of a view other than the
+  ///             implicit view. The layer trees rendered to the view are
+  ///             drawn to it along with those of the implicit view, sharing
+  ///             its contexts and raster cache. The external view embedder is
+  ///             only used for the implicit view.
+  ///
+  ///             The surface must use the same context as the one given to
+  ///             `Rasterizer::Setup`.
+  ///
+  /// @param[in]  view_id  The ID of the view, which must not be the implicit
+  ///                      view.
+  /// @param[in]  surface  The on-screen render surface of the view.
+  ///
+  void AddSurface(int64_t view_id, std::unique_ptr<Surface> surface);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the render surface of a view that was added with
+  ///             `Rasterizer::AddSurface`.
+  ///
+  void RemoveSurface(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Releases any resource used by the external view embedder.
   ///             For example, overlay surfaces or Android views.
@@ -170,12 +207,30 @@ class Rasterizer final : public SnapshotDelegate,
   void TeardownExternalViewEmbedder();
 
   //----------------------------------------------------------------------------
-  /// @brief      Notifies the rasterizer that there is a low memory situation
-  ///             and it must purge as many unnecessary resources as possible.
-  ///             Currently, the Skia context associated with onscreen rendering
-  ///             is told to free GPU resources.
+  /// @brief      Notifies the rasterizer that memory is running low, so that
+  ///             it purges the resources of the Skia context associated with
+  ///             onscreen rendering.
   ///
-  void NotifyLowMemoryWarning() const;
+  ///             Moderate pressure only purges the scratch resources, which
+  ///             are recreated at little cost. Critical pressure purges all
+  ///             the resources that are not in use, and background pressure
+  ///             frees all the GPU resources of the context.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes held by the resource cache of the Skia context
+  ///             associated with onscreen rendering, or zero if there is
+  ///             none.
+  ///
+  size_t GetGpuResourceCacheBytes() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of the buffers and textures the Impeller allocator
+  ///             of the onscreen surface holds, or zero when rendering with
+  ///             Skia.
+  ///
+  size_t GetImpellerDeviceMemoryBytes() const;
 
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
@@ -259,6 +314,20 @@ class Rasterizer final : public SnapshotDelegate,
   RasterStatus Draw(const std::shared_ptr<LayerTreePipeline>& pipeline,
                     LayerTreeDiscardCallback discard_callback = NoDiscard);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draws the last layer tree that was rasterized offscreen
+  ///             because there was no on-screen surface yet to the surface
+  ///             that was just set up. This saves waiting for the framework to
+  ///             produce a new frame after the surface is created.
+  ///
+  /// @see        `Settings::prewarm_first_frame`
+  ///
+  /// @param[in]  discard_callback if specified and returns true, the layer tree
+  ///                             is discarded instead of being rendered
+  ///
+  RasterStatus DrawPrewarmedFrame(
+      const LayerTreeDiscardCallback& discard_callback = NoDiscard);
+
   //----------------------------------------------------------------------------
   /// @brief      The type of the screenshot to obtain of the previously
   ///             rendered layer tree.
@@ -288,6 +357,13 @@ class Rasterizer final : public SnapshotDelegate,
     ///
     CompressedImage,
 
+    //--------------------------------------------------------------------------
+    /// A format used to denote compressed image data. The JPEG compressed
+    /// container is used. Capturing fails if Skia was built without a JPEG
+    /// encoder.
+    ///
+    CompressedJpegImage,
+
     //--------------------------------------------------------------------------
     /// Reads the data directly from the Rasterizer's surface. The pixel format
     /// is determined from the surface. This is the only way to read wide gamut
@@ -364,6 +440,54 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  using ScreenshotCallback = std::function<void(Screenshot)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Screenshots the last layer tree like
+  ///             |ScreenshotLastLayerTree|, but only reads the pixels back
+  ///             on the raster thread. Compressing and Base 64 encoding them
+  ///             happens on `encode_task_runner`.
+  ///
+  /// @param[in]  type                The type of the screenshot to gather.
+  /// @param[in]  base64_encode       Whether Base 64 encoding must be applied
+  ///                                 to the data after a screenshot has been
+  ///                                 captured.
+  /// @param[in]  encode_task_runner  The task runner that the screenshot is
+  ///                                 encoded on, usually a worker.
+  /// @param[in]  callback            Called on `encode_task_runner` with the
+  ///                                 screenshot, which is empty if none could
+  ///                                 be captured.
+  ///
+  void ScreenshotLastLayerTreeAsync(
+      ScreenshotType type,
+      bool base64_encode,
+      const std::shared_ptr<fml::BasicTaskRunner>& encode_task_runner,
+      ScreenshotCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts capturing the layer trees of the implicit view for the
+  ///             next `frame_count` frames that are drawn, to replay them
+  ///             offline. See |DisplayListFrameCapture| for what a capture
+  ///             holds. A capture that has not finished yet is discarded.
+  ///
+  /// @param[in]  frame_count  The number of frames to capture.
+  ///
+  void StartFrameCapture(size_t frame_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames captured so far, and the number that
+  ///             the capture started with |StartFrameCapture| waits for.
+  ///
+  std::pair<size_t, size_t> GetFrameCaptureProgress() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the frame capture once all its frames were captured.
+  ///
+  /// @return     The serialized |DisplayListFrameCapture|, or nullptr if no
+  ///             capture was started or it has not finished yet.
+  ///
+  sk_sp<SkData> TakeFrameCapture();
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -401,6 +525,25 @@ class Rasterizer final : public SnapshotDelegate,
   void SetSnapshotSurfaceProducer(
       std::unique_ptr<SnapshotSurfaceProducer> producer);
 
+  //----------------------------------------------------------------------------
+  /// @brief Set the queue that the tasks posted with |PostIdleTask| wait in
+  ///        for the engine to go idle. Without one, they are posted to the
+  ///        raster task runner right away.
+  ///
+  /// @param[in]  idle_task_queue  The queue run by the shell between frames.
+  ///
+  void SetIdleTaskQueue(std::weak_ptr<IdleTaskQueue> idle_task_queue);
+
+  //----------------------------------------------------------------------------
+  /// @brief Set the pointer tracking that layer trees are late latched with,
+  ///        see |Settings::late_latch_pointer_transforms|. Without one, the
+  ///        transform layers that follow the pointer are drawn as built.
+  ///
+  /// @param[in]  pointer_late_latch  The pointer tracking of the shell.
+  ///
+  void SetPointerLateLatch(
+      std::shared_ptr<const PointerLateLatch> pointer_late_latch);
+
   //----------------------------------------------------------------------------
   /// @brief      Returns a pointer to the compositor context used by this
   ///             rasterizer. This pointer will never be `nullptr`.
@@ -432,7 +575,8 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   /// @attention  This cache does not describe the entirety of GPU resources
   ///             that may be cached. The `RasterCache` also holds very large
-  ///             GPU resources.
+  ///             GPU resources, and is given a share of the same limit as
+  ///             its byte budget.
   ///
   /// @see        `RasterCache`
   ///
@@ -495,6 +639,9 @@ class Rasterizer final : public SnapshotDelegate,
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  // |SnapshotDelegate|
+  void PostIdleTask(fml::closure task) override;
+
   // |Stopwatch::Delegate|
   /// Time limit for a smooth frame.
   ///
@@ -518,45 +665,146 @@ class Rasterizer final : public SnapshotDelegate,
     return delegate_.GetIsGpuDisabledSyncSwitch();
   }
 
-  sk_sp<SkData> ScreenshotLayerTreeAsImage(
+  sk_sp<SkImage> ScreenshotLayerTreeAsRasterImage(
       flutter::LayerTree* tree,
       flutter::CompositorContext& compositor_context,
-      GrDirectContext* surface_context,
-      bool compressed);
+      GrDirectContext* surface_context);
+
+  static sk_sp<SkData> EncodeScreenshotImage(const sk_sp<SkImage>& image,
+                                             ScreenshotType type);
+
+  static Screenshot MakeScreenshot(sk_sp<SkData> data,
+                                   SkISize frame_size,
+                                   std::string format,
+                                   bool base64_encode);
+
+  static std::string GetScreenshotFormat(ScreenshotType type);
+
+  // The surface and the last layer tree of a view that is not the implicit
+  // view.
+  struct ViewRecord {
+    std::unique_ptr<Surface> surface;
+    std::shared_ptr<flutter::LayerTree> last_layer_tree;
+  };
 
   RasterStatus DoDraw(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
+      std::vector<LayerTreeTask> tasks);
+
+  // Keeps the layer tree to draw it once the surface is created. The first of
+  // these layer trees is rasterized to a snapshot surface so that the shaders
+  // it needs are compiled before the surface is created.
+  void PrewarmFrame(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
       std::shared_ptr<flutter::LayerTree> layer_tree);
 
+  // Starts creating the Impeller pipeline variants that the previous runs of
+  // the application used, as stored in the persistent cache directory. The
+  // file is read and decoded off the raster thread.
+  void PrewarmImpellerPipelineVariants();
+
+  // Creates the variants read by |PrewarmImpellerPipelineVariants|.
+  void OnImpellerPipelineVariantsLoaded(
+      std::shared_ptr<const std::vector<impeller::PipelineVariantKey>>
+          variants);
+
+  // Adds the Impeller pipeline variants used by this run to the ones stored
+  // in the persistent cache directory, for the next run to prewarm. The file
+  // is written off the raster thread.
+  void SaveImpellerPipelineVariants();
+
+  // Draws the layer trees of all the views of a frame. The frame is
+  // resubmitted as a whole if any of the views asks for it.
   RasterStatus DrawToSurface(FrameTimingsRecorder& frame_timings_recorder,
-                             flutter::LayerTree& layer_tree);
+                             const std::vector<LayerTreeTask>& tasks);
 
   RasterStatus DrawToSurfaceUnsafe(FrameTimingsRecorder& frame_timings_recorder,
-                                   flutter::LayerTree& layer_tree);
+                                   const std::vector<LayerTreeTask>& tasks);
+
+  // Draws the layer tree of a single view between the |RecordRasterStart| and
+  // the |RecordRasterEnd| of the frame.
+  RasterStatus DrawLayerTreeUnsafe(FrameTimingsRecorder& frame_timings_recorder,
+                                   int64_t view_id,
+                                   Surface& surface,
+                                   flutter::LayerTree& layer_tree,
+                                   flutter::LayerTree* last_layer_tree);
+
+  // The render surface of a view, or nullptr if it has none.
+  Surface* GetViewSurface(int64_t view_id) const;
+
+  // Whether none of the layer trees of |tasks| would damage their view when
+  // compared with the last layer tree drawn to it, see
+  // |Settings::render_on_demand|.
+  bool IsFrameUndamaged(const std::vector<LayerTreeTask>& tasks) const;
+
+  // Purges the unused GPU resources once no frame has been drawn for
+  // |Settings::render_on_demand_resource_trim_delay|.
+  void ScheduleResourceTrim(fml::TimeDelta delay);
 
   void FireNextFrameCallbackIfPresent();
 
+  // Adds the layer tree of the implicit view in |tasks| to the frame capture
+  // started with |StartFrameCapture|, if one is in progress.
+  void CaptureFrame(const std::vector<LayerTreeTask>& tasks,
+                    const FrameTiming& timing);
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
+  bool IsSuperseded(LayerTreePipeline& pipeline,
+                    const FrameTimingsRecorder& frame_timings_recorder) const;
+
   Delegate& delegate_;
   MakeGpuImageBehavior gpu_image_behavior_;
   std::unique_ptr<Surface> surface_;
+  // The views added with |AddSurface|.
+  std::unordered_map<int64_t, ViewRecord> view_records_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
+  std::weak_ptr<IdleTaskQueue> idle_task_queue_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   // This is the last successfully rasterized layer tree.
   std::shared_ptr<flutter::LayerTree> last_layer_tree_;
   // Set when we need attempt to rasterize the layer tree again. This layer_tree
   // has not successfully rasterized. This can happen due to the change in the
   // thread configuration. This will be inserted to the front of the pipeline.
-  std::shared_ptr<flutter::LayerTree> resubmitted_layer_tree_;
+  std::vector<LayerTreeTask> resubmitted_layer_tree_tasks_;
   std::unique_ptr<FrameTimingsRecorder> resubmitted_recorder_;
+  // The last layer tree that was drawn before there was a surface, see
+  // |Settings::prewarm_first_frame|.
+  std::shared_ptr<flutter::LayerTree> prewarmed_layer_tree_;
+  std::unique_ptr<FrameTimingsRecorder> prewarmed_recorder_;
+  bool has_prewarmed_offscreen_ = false;
+  // The pipeline variants that were loaded from the persistent cache
+  // directory.
+  std::shared_ptr<const std::vector<impeller::PipelineVariantKey>>
+      prewarmed_pipeline_variants_;
+  // Reads and writes the pipeline variants file.
+  fml::AsyncFileIO pipeline_variants_file_io_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  // The workers that the layer trees paint on when parallel painting is
+  // enabled, see |Settings::parallel_paint_tasks|.
+  std::shared_ptr<fml::ConcurrentMessageLoop> paint_loop_;
+  std::shared_ptr<LayerParallelPainter> parallel_painter_;
+  std::shared_ptr<const PointerLateLatch> pointer_late_latch_;
+  // A copy of the last frame drawn to the surface, see
+  // |Settings::retain_last_frame_for_screenshots|.
+  sk_sp<SkImage> last_frame_image_;
+  // The layer trees discarded since the last frame was rasterized, see
+  // |Settings::discard_superseded_frames|.
+  size_t discarded_frame_count_ = 0;
+  // When the last frame was drawn, and whether the resources are going to be
+  // purged once the engine has been idle for long enough.
+  fml::TimePoint last_draw_time_;
+  bool resource_trim_scheduled_ = false;
+  // The frame capture started with |StartFrameCapture| and the number of
+  // frames it waits for.
+  std::unique_ptr<DisplayListFrameCapture> frame_capture_;
+  size_t frame_capture_frame_count_ = 0;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
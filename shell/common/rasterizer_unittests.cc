@@ -8,8 +8,11 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -928,6 +931,314 @@ TEST(RasterizerTest,
   latch.Wait();
 }
 
+TEST(RasterizerTest, drawPrewarmedFrameDrawsFrameProducedWithoutSurface) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.prewarm_first_frame = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; },
+      /*frame_size=*/SkISize::Make(800, 600));
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillByDefault(Return(is_gpu_disabled_sync_switch));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    // There is no surface yet, so the frame is kept for later.
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    auto layer_tree = std::make_shared<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    auto layer_tree_item = std::make_unique<LayerTreeItem>(
+        std::move(layer_tree), CreateFinishedBuildRecorder());
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::move(layer_tree_item));
+    EXPECT_TRUE(result.success);
+    auto no_discard = [](LayerTree&) { return false; };
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kFailed);
+
+    rasterizer->Setup(std::move(surface));
+    EXPECT_EQ(rasterizer->DrawPrewarmedFrame(no_discard),
+              RasterStatus::kSuccess);
+    // The frame is only drawn once.
+    EXPECT_EQ(rasterizer->DrawPrewarmedFrame(no_discard),
+              RasterStatus::kFailed);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawDiscardsLateFramesSupersededByNewerFrames) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.discard_superseded_frames = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  // Only the newest frame is rasterized, and it accounts for the other one.
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .WillOnce([](const FrameTiming& timing) {
+        EXPECT_EQ(timing.GetDiscardedFrameCount(), 1u);
+      });
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+      /*submit_callback=*/[](const SurfaceFrame&, SkCanvas*) { return true; },
+      /*frame_size=*/SkISize::Make(800, 600));
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillByDefault(Return(is_gpu_disabled_sync_switch));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer->Setup(std::move(surface));
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    const auto late = fml::TimePoint::Now() - fml::TimeDelta::FromSeconds(1);
+    for (int i = 0; i < 2; i++) {
+      auto layer_tree = std::make_shared<LayerTree>(
+          /*frame_size=*/SkISize(), /*device_pixel_ratio=*/2.0f);
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree), CreateFinishedBuildRecorder(late));
+      EXPECT_TRUE(
+          pipeline->Produce().Complete(std::move(layer_tree_item)).success);
+    }
+    auto no_discard = [](LayerTree&) { return false; };
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kDiscarded);
+    // The newest frame is drawn even though it is late too.
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kSuccess);
+    latch.Signal();
+  });
+  latch.Wait();
+  // The first draw posted another one, which finds the pipeline empty.
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawRasterizesTheViewsOfAFrameTogether) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  // The views are timed as a single frame.
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(2);
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+  ON_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillByDefault(Return(is_gpu_disabled_sync_switch));
+
+  constexpr int64_t kSecondViewId = 1;
+  auto make_surface = [](const SkISize& frame_size, int frames) {
+    auto surface = std::make_unique<NiceMock<MockSurface>>();
+    ON_CALL(*surface, AllowsDrawingWhenGpuDisabled())
+        .WillByDefault(Return(true));
+    ON_CALL(*surface, MakeRenderContextCurrent())
+        .WillByDefault(::testing::Invoke(
+            [] { return std::make_unique<GLContextDefaultResult>(true); }));
+    EXPECT_CALL(*surface, AcquireFrame(frame_size))
+        .Times(frames)
+        .WillRepeatedly([](const SkISize& size) {
+          SurfaceFrame::FramebufferInfo framebuffer_info;
+          framebuffer_info.supports_readback = true;
+          return std::make_unique<SurfaceFrame>(
+              /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+              /*submit_callback=*/
+              [](const SurfaceFrame&, SkCanvas*) { return true; },
+              /*frame_size=*/size);
+        });
+    return surface;
+  };
+  // The implicit view is discarded in the second frame.
+  auto implicit_view_surface = make_surface(SkISize::Make(800, 600), 1);
+  auto second_view_surface = make_surface(SkISize::Make(400, 300), 2);
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer->Setup(std::move(implicit_view_surface));
+    rasterizer->AddSurface(kSecondViewId, std::move(second_view_surface));
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    auto produce_frame = [&] {
+      std::vector<LayerTreeTask> tasks;
+      tasks.emplace_back(kFlutterImplicitViewId,
+                         std::make_shared<LayerTree>(
+                             /*frame_size=*/SkISize::Make(800, 600),
+                             /*device_pixel_ratio=*/2.0f));
+      tasks.emplace_back(kSecondViewId,
+                         std::make_shared<LayerTree>(
+                             /*frame_size=*/SkISize::Make(400, 300),
+                             /*device_pixel_ratio=*/2.0f));
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(tasks), CreateFinishedBuildRecorder());
+      EXPECT_TRUE(
+          pipeline->Produce().Complete(std::move(layer_tree_item)).success);
+    };
+
+    produce_frame();
+    auto no_discard = [](LayerTree&) { return false; };
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kSuccess);
+    ASSERT_TRUE(rasterizer->GetLastLayerTree());
+    EXPECT_EQ(rasterizer->GetLastLayerTree()->frame_size(),
+              SkISize::Make(800, 600));
+
+    produce_frame();
+    auto discard_implicit_view = [](LayerTree& layer_tree) {
+      return layer_tree.frame_size() == SkISize::Make(800, 600);
+    };
+    EXPECT_EQ(rasterizer->Draw(pipeline, discard_implicit_view),
+              RasterStatus::kSuccess);
+
+    // A view that was removed is not drawn anymore.
+    rasterizer->RemoveSurface(kSecondViewId);
+    produce_frame();
+    EXPECT_EQ(rasterizer->Draw(pipeline, discard_implicit_view),
+              RasterStatus::kDiscarded);
+    latch.Signal();
+  });
+  latch.Wait();
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawSkipsUndamagedFramesWhenRenderingOnDemand) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.render_on_demand = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  // The skipped frame is still timed.
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(2);
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto is_gpu_disabled_sync_switch =
+      std::make_shared<const fml::SyncSwitch>(false);
+  ON_CALL(delegate, GetIsGpuDisabledSyncSwitch())
+      .WillByDefault(Return(is_gpu_disabled_sync_switch));
+
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+  // Only the first frame is drawn to the surface.
+  EXPECT_CALL(*surface, AcquireFrame(SkISize::Make(800, 600)))
+      .WillOnce([](const SkISize& size) {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/nullptr, /*framebuffer_info=*/framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame&, SkCanvas*) { return true; },
+            /*frame_size=*/size);
+      });
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer->Setup(std::move(surface));
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    auto produce_frame = [&] {
+      auto layer_tree =
+          std::make_shared<LayerTree>(/*frame_size=*/SkISize::Make(800, 600),
+                                      /*device_pixel_ratio=*/2.0f);
+      layer_tree->set_root_layer(std::make_shared<ContainerLayer>());
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree), CreateFinishedBuildRecorder());
+      EXPECT_TRUE(
+          pipeline->Produce().Complete(std::move(layer_tree_item)).success);
+    };
+    auto no_discard = [](LayerTree&) { return false; };
+
+    produce_frame();
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kSuccess);
+    const LayerTree* first_layer_tree = rasterizer->GetLastLayerTree();
+
+    produce_frame();
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kSuccess);
+    // The skipped frame is what the next frame is compared with.
+    EXPECT_NE(rasterizer->GetLastLayerTree(), first_layer_tree);
+    latch.Signal();
+  });
+  latch.Wait();
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(RasterizerTest, TeardownFreesResourceCache) {
   std::string test_name =
       ::testing::UnitTest::GetInstance()->current_test_info()->name();
@@ -1176,4 +1487,49 @@ TEST(RasterizerTest, presentationTimeNotSetWhenVsyncTargetInPast) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, idleTasksRunOnTheRasterThreadWhenTheQueueRuns) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+
+  auto idle_task_queue = std::make_shared<IdleTaskQueue>();
+  std::unique_ptr<Rasterizer> rasterizer;
+  fml::AutoResetWaitableEvent latch;
+  fml::AutoResetWaitableEvent task_latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer = std::make_unique<Rasterizer>(delegate);
+    rasterizer->SetIdleTaskQueue(idle_task_queue);
+    rasterizer->GetSnapshotDelegate()->PostIdleTask([&] {
+      EXPECT_TRUE(
+          task_runners.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+      task_latch.Signal();
+    });
+    latch.Signal();
+  });
+  latch.Wait();
+
+  idle_task_queue->RunUntil(fml::TimePoint::Now() +
+                            fml::TimeDelta::FromSeconds(1));
+  task_latch.Wait();
+  EXPECT_EQ(idle_task_queue->GetPendingTaskCount(), 0u);
+
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace flutter
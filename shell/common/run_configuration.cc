@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/assets/packed_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/unique_fd.h"
@@ -25,10 +26,17 @@ RunConfiguration RunConfiguration::InferFromSettings(
         fml::Duplicate(settings.assets_dir), true));
   }
 
+  auto assets_directory = fml::OpenDirectory(
+      settings.assets_path.c_str(), false, fml::FilePermission::kRead);
+  // Assets in a packed archive are resolved before the loose files of the
+  // directory, without opening a file per asset.
+  if (std::shared_ptr<fml::Mapping> archive = fml::FileMapping::CreateReadOnly(
+          assets_directory, PackedAssetBundle::kArchiveName)) {
+    asset_manager->PushBack(
+        std::make_unique<PackedAssetBundle>(std::move(archive), true));
+  }
   asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
-      fml::OpenDirectory(settings.assets_path.c_str(), false,
-                         fml::FilePermission::kRead),
-      true));
+      std::move(assets_directory), true));
 
   return {IsolateConfiguration::InferFromSettings(settings, asset_manager,
                                                   io_worker),
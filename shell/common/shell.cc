@@ -5,12 +5,15 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
@@ -22,16 +25,25 @@
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/runtime/snapshot_warmup_profile.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/raster_cache_io_rasterizer.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/common/vsync_waiter_on_demand.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/typographer/backends/skia/text_render_context_skia.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 namespace flutter {
 
@@ -40,6 +52,13 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+struct Shell::PlatformMessageBatches {
+  std::mutex mutex;
+  std::unordered_map<std::string,
+                     std::vector<std::unique_ptr<PlatformMessage>>>
+      messages;
+};
+
 namespace {
 
 std::unique_ptr<Engine> CreateEngine(
@@ -96,6 +115,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.enable_trace_recorder) {
+      fml::tracing::TraceRecorder::SetEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -116,6 +139,78 @@ void PerformInitializationTasks(Settings& settings) {
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
 }
 
+// The mappings of the snapshots, in the order of the snapshot warmup profile.
+SnapshotWarmupProfile::Mappings GetSnapshotMappings(
+    const DartSnapshot* vm_snapshot,
+    const DartSnapshot* isolate_snapshot) {
+  SnapshotWarmupProfile::Mappings mappings;
+  for (const auto& snapshot : {vm_snapshot, isolate_snapshot}) {
+    if (snapshot) {
+      auto snapshot_mappings = snapshot->GetMappings();
+      mappings.insert(mappings.end(), snapshot_mappings.begin(),
+                      snapshot_mappings.end());
+    }
+  }
+  return mappings;
+}
+
+// Asks the kernel to read the pages of the snapshots that the last recorded
+// launch touched ahead. This runs on the snapshot warmup thread of the shell,
+// as the VM, whose launch it overlaps, is not created yet. The mappings are
+// kept alive by the task.
+void PrefetchSnapshotPages(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                           const std::string& cache_directory,
+                           SnapshotWarmupProfile::Mappings mappings) {
+  task_runner->PostTask([cache_directory, mappings = std::move(mappings)]() {
+    TRACE_EVENT0("flutter", "Shell::PrefetchSnapshotPages");
+    auto directory = fml::OpenDirectory(cache_directory.c_str(), false,
+                                        fml::FilePermission::kReadWrite);
+    if (!directory.is_valid() ||
+        !fml::FileExists(directory, SnapshotWarmupProfile::kFileName)) {
+      return;
+    }
+    auto data = fml::FileMapping::CreateReadOnly(
+        directory, SnapshotWarmupProfile::kFileName);
+    auto profile = data ? SnapshotWarmupProfile::Deserialize(*data, mappings)
+                        : std::nullopt;
+    if (!profile.has_value()) {
+      // The profile was recorded for other snapshots, such as those of a
+      // previous version of the application. Record it again.
+      fml::UnlinkFile(directory, SnapshotWarmupProfile::kFileName);
+      return;
+    }
+    profile->Prefetch(mappings);
+  });
+}
+
+// Records the pages of the snapshots that are resident once the first frame is
+// rasterized, unless a profile was already recorded. Profiles are not updated
+// on later launches as those prefetch the recorded pages, which would then
+// always appear as touched.
+//
+// This runs on the same thread as the prefetch, after it. A stale profile that
+// the prefetch removes is then never removed while the new one is written.
+void RecordSnapshotPages(const fml::RefPtr<fml::TaskRunner>& task_runner,
+                         const std::string& cache_directory,
+                         SnapshotWarmupProfile::Mappings mappings) {
+  task_runner->PostTask([cache_directory, mappings = std::move(mappings)]() {
+    auto directory = fml::OpenDirectory(cache_directory.c_str(), false,
+                                        fml::FilePermission::kReadWrite);
+    if (!directory.is_valid() ||
+        fml::FileExists(directory, SnapshotWarmupProfile::kFileName)) {
+      return;
+    }
+    auto profile = SnapshotWarmupProfile::Record(mappings);
+    if (!profile.has_value()) {
+      return;
+    }
+    if (!fml::WriteAtomically(directory, SnapshotWarmupProfile::kFileName,
+                              *profile->Serialize())) {
+      FML_LOG(ERROR) << "Could not write the snapshot warmup profile.";
+    }
+  });
+}
+
 }  // namespace
 
 std::unique_ptr<Shell> Shell::Create(
@@ -133,10 +228,23 @@ std::unique_ptr<Shell> Shell::Create(
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
+  const auto vm_setup_begin = fml::TimePoint::Now();
   auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
   auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  // Only the shell that launches the VM warms up the snapshots.
+  std::unique_ptr<fml::Thread> snapshot_warmup_thread;
+  if (settings.enable_snapshot_warmup_profile &&
+      !DartVMRef::IsInstanceRunning()) {
+    snapshot_warmup_thread =
+        std::make_unique<fml::Thread>("io.flutter.snapshot_warmup");
+    PrefetchSnapshotPages(snapshot_warmup_thread->GetTaskRunner(),
+                          settings.temp_directory_path,
+                          GetSnapshotMappings(vm_snapshot.get(),
+                                              isolate_snapshot.get()));
+  }
   auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
   FML_CHECK(vm) << "Must be able to initialize the VM.";
+  const auto vm_setup_end = fml::TimePoint::Now();
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
@@ -146,17 +254,23 @@ std::unique_ptr<Shell> Shell::Create(
   auto resource_cache_limit_calculator =
       std::make_shared<ResourceCacheLimitCalculator>(
           settings.resource_cache_max_bytes_threshold);
-  return CreateWithSnapshot(platform_data,                    //
-                            task_runners,                     //
-                            /*parent_merger=*/nullptr,        //
-                            /*parent_io_manager=*/nullptr,    //
-                            resource_cache_limit_calculator,  //
-                            settings,                         //
-                            std::move(vm),                    //
-                            std::move(isolate_snapshot),      //
-                            on_create_platform_view,          //
-                            on_create_rasterizer,             //
-                            CreateEngine, is_gpu_disabled);
+  auto shell = CreateWithSnapshot(platform_data,                    //
+                                  task_runners,                     //
+                                  /*parent_merger=*/nullptr,        //
+                                  /*parent_io_manager=*/nullptr,    //
+                                  resource_cache_limit_calculator,  //
+                                  settings,                         //
+                                  std::move(vm),                    //
+                                  std::move(isolate_snapshot),      //
+                                  on_create_platform_view,          //
+                                  on_create_rasterizer,             //
+                                  CreateEngine, is_gpu_disabled);
+  if (shell) {
+    shell->startup_timeline_->Record(StartupTimeline::Phase::kVMSetup,
+                                     vm_setup_begin, vm_setup_end);
+    shell->snapshot_warmup_thread_ = std::move(snapshot_warmup_thread);
+  }
+  return shell;
 }
 
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
@@ -199,20 +313,31 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                                            shell = shell.get()    //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        StartupTimeline::ScopedPhase phase(*shell->startup_timeline_,
+                                           StartupTimeline::Phase::kGPUSetup);
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
+        rasterizer->SetIdleTaskQueue(shell->idle_task_queue_);
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
+  const auto platform_view_setup_begin = fml::TimePoint::Now();
   auto platform_view = on_create_platform_view(*shell.get());
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
+  shell->startup_timeline_->Record(StartupTimeline::Phase::kPlatformViewSetup,
+                                   platform_view_setup_begin,
+                                   fml::TimePoint::Now());
 
   // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
+  // to create the animator. Frames that are rendered on demand don't wait for
+  // the vsync of the display.
+  std::unique_ptr<VsyncWaiter> vsync_waiter =
+      shell->GetSettings().render_on_demand
+          ? std::make_unique<VsyncWaiterOnDemand>(shell->GetTaskRunners())
+          : platform_view->CreateVSyncWaiter();
   if (!vsync_waiter) {
     return nullptr;
   }
@@ -240,9 +365,12 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &unref_queue_promise,                                              //
        platform_view_ptr,                                                 //
        io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(),  //
+       &startup_timeline = *shell->startup_timeline_                      //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        StartupTimeline::ScopedPhase phase(startup_timeline,
+                                           StartupTimeline::Phase::kIOSetup);
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -262,6 +390,19 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (settings.coalesce_pointer_events) {
+    dispatcher_maker =
+        [resampling_offset = fml::TimeDelta::FromMicroseconds(
+             settings.pointer_resampling_offset_micros)](
+            PointerDataDispatcher::Delegate& delegate) {
+          return std::make_unique<CoalescingPointerDataDispatcher>(
+              delegate, resampling_offset);
+        };
+  } else if (settings.frame_aligned_pointer_events) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<FrameAlignedPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -279,12 +420,18 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &unref_queue_future,                             //
                          &on_create_engine]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        StartupTimeline::ScopedPhase phase(*shell->startup_timeline_,
+                                           StartupTimeline::Phase::kUISetup);
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->frame_duration_predictor_, shell->pipeline_depth_advisor_,
+            shell->GetSettings().enable_frame_rate_hints
+                ? std::make_unique<FrameRateAdvisor>()
+                : nullptr);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -388,6 +535,11 @@ Shell::Shell(DartVMRef vm,
       vm_(std::move(vm)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
+      platform_message_port_router_(
+          std::make_shared<PlatformMessagePortRouter>()),
+      shared_ring_buffer_registry_(
+          std::make_shared<SharedRingBufferRegistry>()),
+      platform_message_batches_(std::make_shared<PlatformMessageBatches>()),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
   FML_CHECK(vm_) << "Must have access to VM to create a shell.";
@@ -395,6 +547,18 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   display_manager_ = std::make_unique<DisplayManager>();
+  if (settings_.enable_predictive_frame_scheduling) {
+    frame_duration_predictor_ = std::make_shared<FrameDurationPredictor>();
+  }
+  if (settings_.enable_adaptive_pipeline_depth) {
+    pipeline_depth_advisor_ = std::make_shared<PipelineDepthAdvisor>();
+  }
+  if (settings_.jank_snapshot_callback) {
+    jank_snapshot_recorder_ = std::make_unique<JankSnapshotRecorder>(
+        settings_.jank_snapshot_frame_budget,
+        settings_.jank_snapshot_trace_duration);
+    fml::tracing::TraceRecorder::SetEnabled(true);
+  }
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
 
@@ -450,10 +614,37 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolRenderFrameWithRasterStats, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingPercentilesExtensionName] = {
+          task_runners_.GetUITaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingPercentiles, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kReloadAssetFonts] = {
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTraceRecordingExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTraceRecording, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetMemoryUsageExtensionName] =
+      {task_runners_.GetIOTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetMemoryUsage, this,
+                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kNotifyMemoryPressureExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolNotifyMemoryPressure, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kCaptureFramesExtensionName] = {
+      task_runners_.GetRasterTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolCaptureFrames, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetFrameCaptureExtensionName] =
+      {task_runners_.GetRasterTaskRunner(),
+       std::bind(&Shell::OnServiceProtocolGetFrameCapture, this,
+                 std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -550,26 +741,158 @@ std::unique_ptr<Shell> Shell::Spawn(
   return result;
 }
 
+void Shell::AddView(int64_t view_id,
+                    const ViewportMetrics& metrics,
+                    std::unique_ptr<Surface> surface) {
+  TRACE_EVENT0("flutter", "Shell::AddView");
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+
+  // The surface is added before the engine can render to the view.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      fml::MakeCopyable([rasterizer = rasterizer_->GetWeakPtr(), view_id,
+                         surface = std::move(surface)]() mutable {
+        if (rasterizer) {
+          rasterizer->AddSurface(view_id, std::move(surface));
+        }
+      }));
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id, metrics]() {
+        if (engine) {
+          engine->AddView(view_id, metrics);
+        }
+      });
+}
+
+void Shell::RemoveView(int64_t view_id) {
+  TRACE_EVENT0("flutter", "Shell::RemoveView");
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id]() {
+        if (engine) {
+          engine->RemoveView(view_id);
+        }
+      });
+
+  // The frames that were already built for the view are dropped by the
+  // rasterizer once the surface is gone.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = rasterizer_->GetWeakPtr(), view_id, &latch]() {
+        if (rasterizer) {
+          rasterizer->RemoveSurface(view_id);
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+}
+
 void Shell::NotifyLowMemoryWarning() const {
-  auto trace_id = fml::tracing::TraceNonce();
-  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
-                           trace_id);
-  // This does not require a current isolate but does require a running VM.
-  // Since a valid shell will not be returned to the embedder without a valid
-  // DartVMRef, we can be certain that this is a safe spot to assume a VM is
-  // running.
-  ::Dart_NotifyLowMemory();
+  NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+}
 
-  task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
+void Shell::NotifyMemoryPressure(MemoryPressureLevel level) const {
+  TRACE_EVENT0("flutter", "Shell::NotifyMemoryPressure");
+  if (level != MemoryPressureLevel::kModerate) {
+    // This does not require a current isolate but does require a running VM.
+    // Since a valid shell will not be returned to the embedder without a
+    // valid DartVMRef, we can be certain that this is a safe spot to assume a
+    // VM is running.
+    ::Dart_NotifyLowMemory();
+  }
+  memory_pressure_registry_.Notify(level);
+}
+
+void Shell::RegisterMemoryPressureSubsystems() {
+  const auto& raster_task_runner = task_runners_.GetRasterTaskRunner();
+  memory_pressure_registry_.Register(
+      "gpuResources", raster_task_runner,
+      [rasterizer = weak_rasterizer_](MemoryPressureLevel level) {
         if (rasterizer) {
-          rasterizer->NotifyLowMemoryWarning();
+          rasterizer->NotifyMemoryPressure(level);
+        }
+      },
+      [rasterizer = weak_rasterizer_]() -> size_t {
+        return rasterizer ? rasterizer->GetGpuResourceCacheBytes() : 0u;
+      });
+
+  // The raster cache is rebuilt over the next frames, which makes them
+  // slower, so it is only dropped once memory is critical.
+  memory_pressure_registry_.Register(
+      "rasterCache", raster_task_runner,
+      [rasterizer = weak_rasterizer_](MemoryPressureLevel level) {
+        if (rasterizer && level != MemoryPressureLevel::kModerate) {
+          rasterizer->compositor_context()->raster_cache().Clear();
         }
-        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
-                               trace_id);
+      },
+      [rasterizer = weak_rasterizer_]() -> size_t {
+        if (!rasterizer) {
+          return 0u;
+        }
+        const auto& raster_cache =
+            rasterizer->compositor_context()->raster_cache();
+        return raster_cache.EstimateLayerCacheByteSize() +
+               raster_cache.EstimatePictureCacheByteSize();
       });
+
   // The IO Manager uses resource cache limits of 0, so it is not necessary
-  // to purge them.
+  // to purge them. The decoded images that are not in use are released on
+  // the IO thread, which their textures belong to.
+  if (auto decoded_image_cache = io_manager_->GetDecodedImageCache()) {
+    memory_pressure_registry_.Register(
+        "decodedImages", task_runners_.GetIOTaskRunner(),
+        [decoded_image_cache](MemoryPressureLevel level) {
+          if (level != MemoryPressureLevel::kModerate) {
+            decoded_image_cache->Purge();
+          }
+        },
+        [decoded_image_cache]() {
+          return decoded_image_cache->GetRetainedBytes();
+        });
+  }
+
+#if IMPELLER_SUPPORTS_RENDERING
+  // The prerasterized glyphs only save work when atlases are regenerated.
+  if (settings_.enable_impeller) {
+    memory_pressure_registry_.Register(
+        "prerasterizedGlyphs", task_runners_.GetIOTaskRunner(),
+        [](MemoryPressureLevel level) {
+          impeller::TextRenderContextSkia::PurgePrerasterizedGlyphs();
+        },
+        []() {
+          return impeller::TextRenderContextSkia::
+              GetPrerasterizedGlyphByteSize();
+        });
+
+    // Device memory is only released by the caches that hold on to it, so
+    // it is reported by category without trimming anything itself.
+    if (auto impeller_context = io_manager_->GetImpellerContext()) {
+      std::weak_ptr<impeller::Allocator> weak_allocator =
+          impeller_context->GetResourceAllocator();
+      for (size_t i = 0; i < impeller::kAllocationCategoryCount; i++) {
+        const auto category = static_cast<impeller::AllocationCategory>(i);
+        memory_pressure_registry_.Register(
+            std::string("impellerDeviceMemory") +
+                impeller::AllocationCategoryToString(category),
+            task_runners_.GetIOTaskRunner(), [](MemoryPressureLevel level) {},
+            [weak_allocator, category]() -> size_t {
+              auto allocator = weak_allocator.lock();
+              return allocator ? allocator->GetDeviceMemoryStatistics()
+                                     .Get(category)
+                                     .bytes
+                               : 0u;
+            });
+      }
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
 void Shell::RunEngine(RunConfiguration run_configuration) {
@@ -594,14 +917,18 @@ void Shell::RunEngine(
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable(
           [run_configuration = std::move(run_configuration),
-           weak_engine = weak_engine_, result]() mutable {
+           weak_engine = weak_engine_, result,
+           startup_timeline = startup_timeline_]() mutable {
             if (!weak_engine) {
               FML_LOG(ERROR)
                   << "Could not launch engine with configuration - no engine.";
               result(Engine::RunStatus::Failure);
               return;
             }
+            const auto launch_begin = fml::TimePoint::Now();
             auto run_result = weak_engine->Run(std::move(run_configuration));
+            startup_timeline->Record(StartupTimeline::Phase::kRootIsolateLaunch,
+                                     launch_begin, fml::TimePoint::Now());
             if (run_result == flutter::Engine::RunStatus::Failure) {
               FML_LOG(ERROR) << "Could not launch engine with configuration.";
             }
@@ -676,26 +1003,73 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   rasterizer_->SetSnapshotSurfaceProducer(
       platform_view_->CreateSnapshotSurfaceProducer());
 
+  if (settings_.late_latch_pointer_transforms) {
+    pointer_late_latch_ = std::make_shared<PointerLateLatch>();
+    engine_->SetPointerLateLatch(pointer_late_latch_);
+    rasterizer_->SetPointerLateLatch(pointer_late_latch_);
+  }
+
+  if (settings_.enable_async_raster_cache) {
+    auto async_rasterizer = std::make_shared<RasterCacheIORasterizer>(
+        task_runners_.GetIOTaskRunner(), task_runners_.GetRasterTaskRunner(),
+        io_manager_->GetWeakIOManager());
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = rasterizer_->GetWeakPtr(), async_rasterizer] {
+          if (rasterizer) {
+            rasterizer->compositor_context()->raster_cache().SetAsyncRasterizer(
+                async_rasterizer);
+          }
+        });
+  }
+
   // The weak ptr must be generated in the platform thread which owns the unique
   // ptr.
   weak_engine_ = engine_->GetWeakPtr();
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
-  // Setup the time-consuming default font manager right after engine created.
+  RegisterMemoryPressureSubsystems();
+
+  // Create the time-consuming default font manager on a worker right after
+  // the engine is created, rather than on the UI thread. The engine only waits
+  // for it once the root isolate is created.
   if (!settings_.prefetched_default_font_manager) {
-    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                      [engine = weak_engine_] {
-                                        if (engine) {
-                                          engine->SetupDefaultFontManager();
-                                        }
-                                      });
+    auto font_manager_promise =
+        std::make_shared<std::promise<sk_sp<SkFontMgr>>>();
+    std::shared_future<sk_sp<SkFontMgr>> font_manager =
+        font_manager_promise->get_future();
+    vm_->GetConcurrentWorkerTaskRunner()->PostTask(
+        [font_manager_promise, startup_timeline = startup_timeline_,
+         font_initialization_data = settings_.font_initialization_data]() {
+          TRACE_EVENT0("flutter", "Shell::CreateDefaultFontManager");
+          StartupTimeline::ScopedPhase phase(
+              *startup_timeline, StartupTimeline::Phase::kFontManagerSetup);
+          font_manager_promise->set_value(
+              txt::GetDefaultFontManager(font_initialization_data));
+        });
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, font_manager = std::move(font_manager)] {
+          if (engine) {
+            engine->SetupDefaultFontManager(font_manager);
+          }
+        });
   }
 
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
+  PersistentCache::GetCacheForProcess()->SetIdleTaskPoster(
+      [weak_queue = std::weak_ptr<IdleTaskQueue>(idle_task_queue_)](
+          const fml::RefPtr<fml::TaskRunner>& worker, fml::closure task) {
+        if (auto queue = weak_queue.lock()) {
+          queue->PostTask(worker, std::move(task));
+        } else {
+          worker->PostTask(std::move(task));
+        }
+      });
 
   PersistentCache::GetCacheForProcess()->SetIsDumpingSkp(
       settings_.dump_skp_on_shader_compilation);
@@ -740,6 +1114,14 @@ fml::WeakPtr<ShellIOManager> Shell::GetIOManager() {
   return io_manager_->GetWeakPtr();
 }
 
+const FrameTimingHistograms& Shell::GetFrameTimingHistograms() const {
+  return frame_timing_histograms_;
+}
+
+const StartupTimeline& Shell::GetStartupTimeline() const {
+  return *startup_timeline_;
+}
+
 DartVM* Shell::GetDartVM() {
   return &vm_;
 }
@@ -775,15 +1157,24 @@ void Shell::OnPlatformViewCreated(std::unique_ptr<Surface> surface) {
       !task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread();
 
   fml::AutoResetWaitableEvent latch;
-  auto raster_task =
-      fml::MakeCopyable([&waiting_for_first_frame = waiting_for_first_frame_,
-                         rasterizer = rasterizer_->GetWeakPtr(),  //
-                         surface = std::move(surface)]() mutable {
+  auto raster_task = fml::MakeCopyable(
+      [&waiting_for_first_frame = waiting_for_first_frame_,
+       rasterizer = rasterizer_->GetWeakPtr(),  //
+       surface = std::move(surface),
+       prewarm_first_frame = settings_.prewarm_first_frame,
+       discard_callback = [this](flutter::LayerTree& tree) {
+         return ShouldDiscardLayerTree(tree);
+       }]() mutable {
         if (rasterizer) {
           // Enables the thread merger which may be used by the external view
           // embedder.
           rasterizer->EnableThreadMergerIfNeeded();
           rasterizer->Setup(std::move(surface));
+          // Present the frame that was produced before the surface existed
+          // instead of waiting for the one scheduled below.
+          if (prewarm_first_frame) {
+            rasterizer->DrawPrewarmedFrame(discard_callback);
+          }
         }
 
         waiting_for_first_frame.store(true);
@@ -967,6 +1358,19 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  // Messages on the channels of background isolates skip the UI thread.
+  message = platform_message_port_router_->RouteMessage(std::move(message));
+  if (!message) {
+    return;
+  }
+
+  const auto& batched_channels = settings_.batched_platform_message_channels;
+  if (std::find(batched_channels.begin(), batched_channels.end(),
+                message->channel()) != batched_channels.end()) {
+    BatchPlatformMessage(std::move(message));
+    return;
+  }
+
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
@@ -977,6 +1381,36 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
       }));
 }
 
+void Shell::BatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
+  const std::string channel = message->channel();
+  {
+    std::scoped_lock lock(platform_message_batches_->mutex);
+    auto& batch = platform_message_batches_->messages[channel];
+    batch.push_back(std::move(message));
+    if (batch.size() > 1) {
+      // The dispatch of the batch is already scheduled.
+      return;
+    }
+  }
+
+  task_runners_.GetUITaskRunner()->PostDelayedTask(
+      [engine = engine_->GetWeakPtr(), batches = platform_message_batches_,
+       channel]() {
+        std::vector<std::unique_ptr<PlatformMessage>> messages;
+        {
+          std::scoped_lock lock(batches->mutex);
+          auto found = batches->messages.find(channel);
+          messages = std::move(found->second);
+          batches->messages.erase(found);
+        }
+        if (engine) {
+          TRACE_EVENT0("flutter", "Shell::DispatchPlatformMessageBatch");
+          engine->DispatchPlatformMessages(channel, std::move(messages));
+        }
+      },
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count()));
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewDispatchPointerDataPacket(
     std::unique_ptr<PointerDataPacket> packet) {
@@ -984,13 +1418,17 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
-  task_runners_.GetUITaskRunner()->PostTask(
+  if (pointer_late_latch_) {
+    pointer_late_latch_->OnPointersReceived(*packet);
+  }
+  task_runners_.GetUITaskRunner()->PostTaskWithGrade(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
         if (engine) {
           engine->DispatchPointerDataPacket(std::move(packet), flow_id);
         }
-      }));
+      }),
+      fml::TaskSourceGrade::kUserInteraction);
   next_pointer_flow_id_++;
 }
 
@@ -1140,6 +1578,25 @@ void Shell::OnAnimatorNotifyIdle(fml::TimeDelta deadline) {
   if (engine_) {
     engine_->NotifyIdle(deadline);
     volatile_path_tracker_->OnFrame();
+
+    if (!is_font_fallback_cache_save_pending_) {
+      is_font_fallback_cache_save_pending_ = true;
+      // The engine is destroyed on the UI thread before the shell.
+      idle_task_queue_->PostTask(
+          task_runners_.GetUITaskRunner(),
+          [this, engine = engine_->GetWeakPtr()]() {
+            if (engine) {
+              is_font_fallback_cache_save_pending_ = false;
+              engine->GetFontCollection()
+                  .GetFontCollection()
+                  ->SaveFontFallbackCache();
+            }
+          });
+    }
+
+    // The deadline is on the clock of the Dart timeline.
+    const auto now = fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
+    idle_task_queue_->RunUntil(fml::TimePoint::Now() + (deadline - now));
   }
 }
 
@@ -1163,9 +1620,7 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
   FML_DCHECK(is_setup_);
 
   auto discard_callback = [this](flutter::LayerTree& tree) {
-    std::scoped_lock<std::mutex> lock(resize_mutex_);
-    return !expected_frame_size_.isEmpty() &&
-           tree.frame_size() != expected_frame_size_;
+    return ShouldDiscardLayerTree(tree);
   };
 
   task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
@@ -1188,6 +1643,12 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
       }));
 }
 
+bool Shell::ShouldDiscardLayerTree(flutter::LayerTree& tree) {
+  std::scoped_lock<std::mutex> lock(resize_mutex_);
+  return !expected_frame_size_.isEmpty() &&
+         tree.frame_size() != expected_frame_size_;
+}
+
 // |Animator::Delegate|
 void Shell::OnAnimatorDrawLastLayerTree(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
@@ -1212,9 +1673,11 @@ void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
 
   task_runners_.GetPlatformTaskRunner()->PostTask(
       [view = platform_view_->GetWeakPtr(), update = std::move(update),
-       actions = std::move(actions)] {
+       actions = std::move(actions)]() mutable {
         if (view) {
-          view->UpdateSemantics(update, actions);
+          // The updates are only needed by the view, so hand them over rather
+          // than copying every node on the platform thread.
+          view->UpdateSemantics(std::move(update), std::move(actions));
         }
       });
 }
@@ -1421,6 +1884,34 @@ void Shell::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
       });
 }
 
+void Shell::SummarizeStartup(const FrameTiming& first_frame_timing) {
+  startup_timeline_->Record(StartupTimeline::Phase::kFirstFrame,
+                            first_frame_timing.Get(FrameTiming::kBuildStart),
+                            first_frame_timing.Get(FrameTiming::kRasterFinish));
+  auto summary = startup_timeline_->Summarize();
+  if (!summary.has_value()) {
+    return;
+  }
+  const auto time_to_first_frame =
+      std::to_string(summary->time_to_first_frame.ToMillisecondsF());
+  const auto critical_path = startup_timeline_->FormatCriticalPath(*summary);
+  TRACE_EVENT_INSTANT2("flutter", "StartupSummary",         //
+                       "TimeToFirstFrameMs",                //
+                       time_to_first_frame.c_str(),         //
+                       "CriticalPath", critical_path.c_str());
+  FML_DLOG(INFO) << "First frame rasterized "
+                 << summary->time_to_first_frame.ToMillisecondsF()
+                 << "ms after startup. Critical path: " << critical_path;
+
+  if (snapshot_warmup_thread_) {
+    auto vm_data = vm_->GetVMData();
+    RecordSnapshotPages(
+        snapshot_warmup_thread_->GetTaskRunner(), settings_.temp_directory_path,
+        GetSnapshotMappings(&vm_data->GetVMSnapshot(),
+                            vm_data->GetIsolateSnapshot().get()));
+  }
+}
+
 void Shell::ReportTimings() {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
@@ -1451,6 +1942,26 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (frame_duration_predictor_) {
+    frame_duration_predictor_->AddFrameTiming(timing);
+  }
+
+  if (pipeline_depth_advisor_) {
+    pipeline_depth_advisor_->AddFrameTiming(timing, GetFrameBudget());
+  }
+
+  frame_timing_histograms_.AddFrameTiming(timing, GetFrameBudget());
+
+  if (jank_snapshot_recorder_ && !is_capturing_jank_snapshot_ &&
+      jank_snapshot_recorder_->ShouldCapture(timing)) {
+    CaptureJankSnapshot(timing);
+  }
+
+  if (!startup_summarized_) {
+    startup_summarized_ = true;
+    SummarizeStartup(timing);
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1859,6 +2370,10 @@ static rapidjson::Value SerializeLayerSnapshot(
   result.AddMember("layer_unique_id", snapshot.GetLayerUniqueId(), allocator);
   result.AddMember("duration_micros", snapshot.GetDuration().ToMicroseconds(),
                    allocator);
+  result.AddMember("cpu_duration_micros",
+                   snapshot.GetCpuDuration().ToMicroseconds(), allocator);
+  result.AddMember("gpu_duration_micros",
+                   snapshot.GetGpuDuration().ToMicroseconds(), allocator);
 
   const SkRect bounds = snapshot.GetBounds();
   result.AddMember("top", bounds.top(), allocator);
@@ -1880,6 +2395,79 @@ static rapidjson::Value SerializeLayerSnapshot(
   return result;
 }
 
+static rapidjson::Value SerializeFrameTimingPercentiles(
+    const FrameTimingHistograms::Percentiles& percentiles,
+    rapidjson::Document* response) {
+  auto& allocator = response->GetAllocator();
+  rapidjson::Value result;
+  result.SetObject();
+  result.AddMember<uint64_t>("p50", percentiles.p50, allocator);
+  result.AddMember<uint64_t>("p90", percentiles.p90, allocator);
+  result.AddMember<uint64_t>("p99", percentiles.p99, allocator);
+  return result;
+}
+
+static rapidjson::Value SerializeFrameTimingWindow(
+    const std::optional<FrameTimingHistograms::Window>& window,
+    rapidjson::Document* response) {
+  rapidjson::Value result;
+  if (!window) {
+    result.SetNull();
+    return result;
+  }
+  using Metric = FrameTimingHistograms::Metric;
+  auto& allocator = response->GetAllocator();
+  result.SetObject();
+  result.AddMember<int64_t>("startMicros",
+                            window->start.ToEpochDelta().ToMicroseconds(),
+                            allocator);
+  result.AddMember<uint64_t>("frameCount", window->frame_count, allocator);
+  result.AddMember("buildMicros",
+                   SerializeFrameTimingPercentiles(
+                       window->Get(Metric::kBuildDuration), response),
+                   allocator);
+  result.AddMember("rasterMicros",
+                   SerializeFrameTimingPercentiles(
+                       window->Get(Metric::kRasterDuration), response),
+                   allocator);
+  result.AddMember("vsyncOverrunMicros",
+                   SerializeFrameTimingPercentiles(
+                       window->Get(Metric::kVsyncOverrun), response),
+                   allocator);
+  result.AddMember("rasterCacheBytes",
+                   SerializeFrameTimingPercentiles(
+                       window->Get(Metric::kRasterCacheBytes), response),
+                   allocator);
+  result.AddMember("inputLatencyMicros",
+                   SerializeFrameTimingPercentiles(
+                       window->Get(Metric::kInputLatency), response),
+                   allocator);
+  return result;
+}
+
+bool Shell::OnServiceProtocolGetFrameTimingPercentiles(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameTimingPercentiles", allocator);
+  response->AddMember<int64_t>(
+      "windowDurationMicros",
+      FrameTimingHistograms::kWindowDuration.ToMicroseconds(), allocator);
+  response->AddMember(
+      "lastCompletedWindow",
+      SerializeFrameTimingWindow(
+          frame_timing_histograms_.GetLastCompletedWindow(), response),
+      allocator);
+  response->AddMember(
+      "currentWindow",
+      SerializeFrameTimingWindow(frame_timing_histograms_.GetCurrentWindow(),
+                                 response),
+      allocator);
+  return true;
+}
+
 bool Shell::OnServiceProtocolRenderFrameWithRasterStats(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
     rapidjson::Document* response) {
@@ -1972,6 +2560,171 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolGetTraceRecording(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRecording", allocator);
+  response->AddMember("enabled", fml::tracing::TraceRecorder::IsEnabled(),
+                      allocator);
+
+  response->AddMember(
+      "traceEvents",
+      JankSnapshotRecorder::SerializeTraceEvents(
+          fml::tracing::TraceRecorder::GetRecording(), fml::TimePoint(),
+          allocator),
+      allocator);
+  return true;
+}
+
+void Shell::CaptureJankSnapshot(const FrameTiming& timing) {
+  TRACE_EVENT0("flutter", "Shell::CaptureJankSnapshot");
+  // Read the trace events before the rasterization below adds its own.
+  auto recordings = fml::tracing::TraceRecorder::GetRecording();
+  const fml::TimePoint trace_start =
+      timing.Get(FrameTiming::kRasterFinish) -
+      jank_snapshot_recorder_->GetTraceDuration();
+
+  // The frame is still being finished, so the leaf layers are measured by
+  // drawing it again once it has been presented. This is the same
+  // measurement as the one of the "renderFrameWithRasterStats" service
+  // extension.
+  task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
+      [self = weak_factory_gpu_->GetWeakPtr(), timing,
+       recordings = std::move(recordings), trace_start]() mutable {
+        if (!self || !self->rasterizer_) {
+          return;
+        }
+        LayerSnapshotStore* layers = nullptr;
+        if (auto last_layer_tree = self->rasterizer_->GetLastLayerTree()) {
+          auto frame_timings_recorder =
+              std::make_unique<FrameTimingsRecorder>();
+          const auto now = fml::TimePoint::Now();
+          frame_timings_recorder->RecordVsync(now, now);
+          frame_timings_recorder->RecordBuildStart(now);
+          frame_timings_recorder->RecordBuildEnd(now);
+
+          self->is_capturing_jank_snapshot_ = true;
+          last_layer_tree->enable_leaf_layer_tracing(true);
+          self->rasterizer_->DrawLastLayerTree(
+              std::move(frame_timings_recorder));
+          last_layer_tree->enable_leaf_layer_tracing(false);
+          self->is_capturing_jank_snapshot_ = false;
+          layers = &self->rasterizer_->compositor_context()->snapshot_store();
+        }
+        self->settings_.jank_snapshot_callback(
+            timing, JankSnapshotRecorder::Serialize(timing, recordings,
+                                                    trace_start, layers));
+      }));
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "MemoryUsage", allocator);
+
+  rapidjson::Value subsystems(rapidjson::kObjectType);
+  uint64_t total_bytes = 0u;
+  for (const auto& usage : memory_pressure_registry_.GetUsage()) {
+    subsystems.AddMember(rapidjson::Value(usage.name.c_str(), allocator),
+                         static_cast<uint64_t>(usage.bytes), allocator);
+    total_bytes += usage.bytes;
+  }
+  response->AddMember("subsystems", subsystems, allocator);
+  response->AddMember("totalBytes", total_bytes, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolNotifyMemoryPressure(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  if (params.count("level") == 0) {
+    ServiceProtocolParameterError(response, "'level' parameter is missing.");
+    return false;
+  }
+  const std::string_view level = params.at("level");
+  if (level == "moderate") {
+    NotifyMemoryPressure(MemoryPressureLevel::kModerate);
+  } else if (level == "critical") {
+    NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+  } else if (level == "background") {
+    NotifyMemoryPressure(MemoryPressureLevel::kBackground);
+  } else {
+    ServiceProtocolParameterError(
+        response,
+        "'level' must be one of 'moderate', 'critical' or 'background'.");
+    return false;
+  }
+  response->SetObject();
+  response->AddMember("type", "Success", response->GetAllocator());
+  return true;
+}
+
+// The most frames that a capture holds, as their images are kept in memory
+// until the capture is sent.
+static constexpr size_t kMaxCapturedFrames = 600;
+
+// Service protocol handler
+bool Shell::OnServiceProtocolCaptureFrames(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  size_t frame_count = 1;
+  if (params.count("frameCount") > 0) {
+    std::stringstream stream(std::string(params.at("frameCount")));
+    if (!(stream >> frame_count) || frame_count == 0 ||
+        frame_count > kMaxCapturedFrames) {
+      ServiceProtocolParameterError(
+          response, "'frameCount' must be a number between 1 and " +
+                        std::to_string(kMaxCapturedFrames) + ".");
+      return false;
+    }
+  }
+  rasterizer_->StartFrameCapture(frame_count);
+  response->SetObject();
+  response->AddMember("type", "Success", response->GetAllocator());
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameCapture(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto [captured_frames, frame_count] = rasterizer_->GetFrameCaptureProgress();
+  if (frame_count == 0) {
+    ServiceProtocolFailureError(response,
+                                "No frame capture was started with "
+                                "'_flutter.captureFrames'.");
+    return false;
+  }
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameCapture", allocator);
+  response->AddMember<uint64_t>("capturedFrames", captured_frames, allocator);
+  response->AddMember<uint64_t>("frameCount", frame_count, allocator);
+  sk_sp<SkData> capture = rasterizer_->TakeFrameCapture();
+  response->AddMember("complete", capture != nullptr, allocator);
+  if (capture) {
+    std::string b64_capture(
+        SkBase64::Encode(capture->data(), capture->size(), nullptr), '\0');
+    SkBase64::Encode(capture->data(), capture->size(), b64_capture.data());
+    rapidjson::Value capture_value;
+    capture_value.SetString(b64_capture.data(), b64_capture.size(), allocator);
+    response->AddMember("capture", capture_value, allocator);
+  }
+  return true;
+}
+
 Rasterizer::Screenshot Shell::Screenshot(
     Rasterizer::ScreenshotType screenshot_type,
     bool base64_encode) {
@@ -1995,6 +2748,29 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+void Shell::Screenshot(Rasterizer::ScreenshotType screenshot_type,
+                       bool base64_encode,
+                       Rasterizer::ScreenshotCallback callback) {
+  TRACE_EVENT0("flutter", "Shell::ScreenshotAsync");
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      fml::MakeCopyable([rasterizer = GetRasterizer(),
+                         worker_task_runner =
+                             vm_->GetConcurrentWorkerTaskRunner(),
+                         screenshot_type, base64_encode,
+                         callback = std::move(callback)]() mutable {
+        if (!rasterizer) {
+          worker_task_runner->PostTask(
+              [callback = std::move(callback)]() { callback({}); });
+          return;
+        }
+        rasterizer->ScreenshotLastLayerTreeAsync(screenshot_type,
+                                                 base64_encode,
+                                                 worker_task_runner,
+                                                 std::move(callback));
+      }));
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -2082,6 +2858,16 @@ Shell::GetPlatformMessageHandler() const {
   return platform_message_handler_;
 }
 
+const std::shared_ptr<PlatformMessagePortRouter>&
+Shell::GetPlatformMessagePortRouter() const {
+  return platform_message_port_router_;
+}
+
+const std::shared_ptr<SharedRingBufferRegistry>&
+Shell::GetSharedRingBufferRegistry() const {
+  return shared_ring_buffer_registry_;
+}
+
 const std::weak_ptr<VsyncWaiter> Shell::GetVsyncWaiter() const {
   return engine_->GetVsyncWaiter();
 }
@@ -30,16 +30,26 @@
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/volatile_path_tracker.h"
 #include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/lib/ui/window/platform_message_port_router.h"
+#include "flutter/lib/ui/window/shared_ring_buffer_registry.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/runtime/platform_data.h"
 #include "flutter/runtime/service_protocol.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_duration_predictor.h"
+#include "flutter/shell/common/frame_timing_histograms.h"
+#include "flutter/shell/common/idle_task_queue.h"
+#include "flutter/shell/common/jank_snapshot_recorder.h"
+#include "flutter/shell/common/memory_pressure_registry.h"
+#include "flutter/shell/common/pipeline_depth_advisor.h"
 #include "flutter/shell/common/platform_view.h"
+#include "flutter/shell/common/pointer_late_latch.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/common/startup_timeline.h"
 
 namespace flutter {
 
@@ -273,6 +283,34 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::WeakPtr<ShellIOManager> GetIOManager();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a view other than the implicit view, which the framework
+  ///             can then render to. The views are rendered for the same vsync
+  ///             and rasterized together, so they share the raster cache and
+  ///             the rendering context of the implicit view.
+  ///
+  ///             This method must be called on the platform task runner.
+  ///
+  /// @param[in]  view_id   The ID of the view, which must not be in use.
+  /// @param[in]  metrics   The initial viewport metrics of the view.
+  /// @param[in]  surface   The on-screen render surface of the view. It must
+  ///                       use the same context as the surface of the
+  ///                       platform view.
+  ///
+  void AddView(int64_t view_id,
+               const ViewportMetrics& metrics,
+               std::unique_ptr<Surface> surface);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a view that was added with `Shell::AddView`. Its
+  ///             surface has been released by the time this method returns.
+  ///
+  ///             This method must be called on the platform task runner.
+  ///
+  /// @param[in]  view_id   The ID of the view.
+  ///
+  void RemoveView(int64_t view_id);
+
   // Embedders should call this under low memory conditions to free up
   // internal caches used.
   //
@@ -281,10 +319,18 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. This is the same as a critical memory pressure
+  ///             notification.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify that memory is running low, or
+  ///             that the application went to the background. Each engine
+  ///             subsystem registered with the memory pressure registry
+  ///             trims its memory for the level on its own thread, and the
+  ///             Dart VM is notified of critical and background pressure.
+  void NotifyMemoryPressure(MemoryPressureLevel level) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -311,6 +357,21 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a screenshot of the last layer tree rendered by the
+  ///             rasterizer in this shell without blocking the calling
+  ///             thread. The screenshot is encoded on a worker thread of the
+  ///             VM, which the callback is also invoked on.
+  ///
+  /// @param[in]  type           The type of screenshot to capture.
+  /// @param[in]  base64_encode  If the screenshot data should be base64
+  ///                            encoded.
+  /// @param[in]  callback       Invoked with the screenshot result.
+  ///
+  void Screenshot(Rasterizer::ScreenshotType type,
+                  bool base64_encode,
+                  Rasterizer::ScreenshotCallback callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Pauses the calling thread until the first frame is presented.
   ///
@@ -363,6 +424,18 @@ class Shell final : public PlatformView::Delegate,
   /// @brief     Marks the GPU as available or unavailable.
   void SetGpuAvailability(GpuAvailability availability);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the histograms of the timings of the rasterized
+  ///             frames. The histograms may be read from any thread.
+  ///
+  const FrameTimingHistograms& GetFrameTimingHistograms() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the timeline of the startup of this shell. The
+  ///             timeline may be read from any thread.
+  ///
+  const StartupTimeline& GetStartupTimeline() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get a pointer to the Dart VM used by this running shell
   ///             instance.
@@ -401,6 +474,14 @@ class Shell final : public PlatformView::Delegate,
   const std::shared_ptr<PlatformMessageHandler>& GetPlatformMessageHandler()
       const override;
 
+  // |Engine::Delegate|
+  const std::shared_ptr<PlatformMessagePortRouter>&
+  GetPlatformMessagePortRouter() const override;
+
+  // |Engine::Delegate|
+  const std::shared_ptr<SharedRingBufferRegistry>& GetSharedRingBufferRegistry()
+      const override;
+
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
  private:
@@ -424,6 +505,17 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
+  // Routes the messages from the host platform on the channels that
+  // background isolates handle, without going through the UI thread.
+  const std::shared_ptr<PlatformMessagePortRouter>
+      platform_message_port_router_;
+  // The ring buffers in memory that the embedder shares with Dart.
+  const std::shared_ptr<SharedRingBufferRegistry> shared_ring_buffer_registry_;
+  // The messages on the channels in
+  // `Settings::batched_platform_message_channels` that wait for the end of
+  // the frame interval to be dispatched to the UI thread together.
+  struct PlatformMessageBatches;
+  const std::shared_ptr<PlatformMessageBatches> platform_message_batches_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
@@ -464,6 +556,49 @@ class Shell final : public PlatformView::Delegate,
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
 
+  // Fed the frame timings on the raster thread and used by the animator on the
+  // UI thread. Only set if predictive frame scheduling is enabled.
+  std::shared_ptr<FrameDurationPredictor> frame_duration_predictor_;
+
+  // Fed the frame timings on the raster thread and used by the animator on the
+  // UI thread. Only set if the pipeline depth is adaptive.
+  std::shared_ptr<PipelineDepthAdvisor> pipeline_depth_advisor_;
+
+  // Fed the frame timings on the raster thread and read by the service
+  // protocol and the embedder on any thread.
+  FrameTimingHistograms frame_timing_histograms_;
+
+  // The subsystems that trim their memory under memory pressure.
+  MemoryPressureRegistry memory_pressure_registry_;
+
+  // Deferrable work that runs in the idle windows of the UI thread.
+  const std::shared_ptr<IdleTaskQueue> idle_task_queue_ =
+      std::make_shared<IdleTaskQueue>();
+  // Whether the font fallback cache is waiting for an idle window to be
+  // saved. Only used on the UI thread.
+  bool is_font_fallback_cache_save_pending_ = false;
+
+  // Tracks the pointer that the transform layers following it are late
+  // latched with. Null unless |Settings::late_latch_pointer_transforms|.
+  std::shared_ptr<PointerLateLatch> pointer_late_latch_;
+
+  // Decides which frames are snapshotted on the raster thread. Only set if
+  // there is a jank snapshot callback.
+  std::unique_ptr<JankSnapshotRecorder> jank_snapshot_recorder_;
+  // Whether a janky frame is being drawn again to measure its layers.
+  bool is_capturing_jank_snapshot_ = false;
+
+  // Records the phases of the startup on the threads they run on. It is
+  // summarized on the raster thread once the first frame is rasterized.
+  const std::shared_ptr<StartupTimeline> startup_timeline_ =
+      std::make_shared<StartupTimeline>();
+  bool startup_summarized_ = false;
+
+  // Prefetches and then records the pages of the snapshots, for the shell
+  // that launched the VM with the snapshot warmup profile enabled. Null for
+  // other shells. Set on the platform thread before the first frame.
+  std::unique_ptr<fml::Thread> snapshot_warmup_thread_;
+
   // protects expected_frame_size_ which is set on platform thread and read on
   // raster thread
   std::mutex resize_mutex_;
@@ -523,6 +658,27 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Adds the message to the batch of its channel. The first message of a
+  // batch schedules the dispatch of the whole batch on the UI thread a frame
+  // interval later.
+  void BatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
+
+  // Records the first frame in the startup timeline and summarizes the
+  // startup in the trace.
+  void SummarizeStartup(const FrameTiming& first_frame_timing);
+
+  // Measures the layers of a janky frame and hands its snapshot to the jank
+  // snapshot callback on the raster thread.
+  void CaptureJankSnapshot(const FrameTiming& timing);
+
+  // Registers the caches of the rasterizer and the IO manager for memory
+  // pressure notifications.
+  void RegisterMemoryPressureSubsystems();
+
+  // Whether the layer tree was built for another size than the one the
+  // platform view was last resized to, in which case it must not be drawn.
+  bool ShouldDiscardLayerTree(flutter::LayerTree& tree);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -703,6 +859,14 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the percentiles of the frame timings of the last completed
+  // window of |FrameTimingHistograms| and of the current window.
+  bool OnServiceProtocolGetFrameTimingPercentiles(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Renders a frame and responds with various statistics pertaining to the
@@ -720,6 +884,46 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Returns the events kept by the |fml::tracing::TraceRecorder|, in the
+  // Chrome trace event format.
+  bool OnServiceProtocolGetTraceRecording(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the bytes held by each subsystem registered for memory pressure
+  // notifications.
+  bool OnServiceProtocolGetMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Simulates a memory pressure notification of the given "level", which is
+  // "moderate", "critical" or "background".
+  bool OnServiceProtocolNotifyMemoryPressure(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Starts capturing the layer trees of the next "frameCount" frames, 1 by
+  // default, for "getFrameCapture" to return.
+  bool OnServiceProtocolCaptureFrames(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Reports the progress of the capture started by "captureFrames", and the
+  // Base64 encoded |DisplayListFrameCapture| once it has finished.
+  bool OnServiceProtocolGetFrameCapture(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
@@ -4,9 +4,18 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <mutex>
+#include <vector>
+
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
@@ -120,4 +129,142 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+namespace testing {
+
+class ShellFrameBenchmarks : public ShellTest, public benchmark::Fixture {
+ public:
+  ShellFrameBenchmarks() = default;
+
+  void SetUp(const ::benchmark::State& state) {}
+
+  void TearDown(const ::benchmark::State& state) {}
+
+  // The fixture is only used for its helpers, it never runs as a test.
+  void TestBody() override {}
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(ShellFrameBenchmarks);
+};
+
+// Nests |depth| containers under the root, alternating between transforms and
+// opacity, with |width| display list layers drawing a rect in each of them.
+static void BuildSyntheticLayerTree(const std::shared_ptr<ContainerLayer>& root,
+                                    int depth,
+                                    int width,
+                                    const fml::RefPtr<SkiaUnrefQueue>& queue) {
+  std::shared_ptr<ContainerLayer> parent = root;
+  for (int level = 0; level < depth; level++) {
+    std::shared_ptr<ContainerLayer> container;
+    if (level % 2 == 0) {
+      container = std::make_shared<TransformLayer>(SkMatrix::Translate(1, 1));
+    } else {
+      container = std::make_shared<OpacityLayer>(0xF0, SkPoint::Make(1, 1));
+    }
+    parent->Add(container);
+    for (int i = 0; i < width; i++) {
+      DisplayListBuilder builder;
+      builder.setColor(i % 2 == 0 ? DlColor::kRed() : DlColor::kBlue());
+      builder.drawRect(SkRect::MakeXYWH((i * 24) % 776, (level * 24) % 576,
+                                        24, 24));
+      container->Add(std::make_shared<DisplayListLayer>(
+          SkPoint::Make(0, 0),
+          SkiaGPUObject<DisplayList>({builder.Build(), queue}), false, false));
+    }
+    parent = container;
+  }
+}
+
+/// Runs steady state frames through the |Animator|, the layer tree pipeline
+/// and |Rasterizer::Draw|. The layer trees are made of `range(0)` nested
+/// containers that hold `range(1)` display list layers each.
+///
+/// The time of an iteration is the time from beginning a frame to it being
+/// rasterized. The frame timings of the rasterizer are reported too, averaged
+/// over the frames: "UIMs" from the start of the build, which includes making
+/// the layer tree, to handing it to the pipeline, "RasterMs" for drawing it,
+/// and "LatencyMs" from the vsync to the end of the raster.
+BENCHMARK_DEFINE_F(ShellFrameBenchmarks, SteadyStateFrames)
+(benchmark::State& state) {
+  constexpr int kWarmUpFrameCount = 3;
+  constexpr double kFrameWidth = 800;
+  constexpr double kFrameHeight = 600;
+  const int depth = state.range(0);
+  const int width = state.range(1);
+
+  std::mutex timings_mutex;
+  std::vector<FrameTiming> timings;
+  fml::AutoResetWaitableEvent rasterized;
+  auto settings = CreateSettingsForFixture();
+  settings.frame_rasterized_callback = [&](const FrameTiming& timing) {
+    {
+      std::scoped_lock lock(timings_mutex);
+      timings.push_back(timing);
+    }
+    rasterized.Signal();
+  };
+
+  auto shell = CreateShell(settings);
+  FML_CHECK(shell);
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+      shell->GetTaskRunners().GetIOTaskRunner(), fml::TimeDelta::Zero());
+  LayerTreeBuilder builder =
+      [depth, width, &queue](const std::shared_ptr<ContainerLayer>& root) {
+        BuildSyntheticLayerTree(root, depth, width, queue);
+      };
+
+  // The first frames set up the surface and warm up the caches.
+  for (int i = 0; i < kWarmUpFrameCount; i++) {
+    PumpOneFrame(shell.get(), kFrameWidth, kFrameHeight, builder);
+    rasterized.Wait();
+  }
+  {
+    std::scoped_lock lock(timings_mutex);
+    timings.clear();
+  }
+
+  for ([[maybe_unused]] auto _ : state) {
+    PumpOneFrame(shell.get(), kFrameWidth, kFrameHeight, builder);
+    rasterized.Wait();
+  }
+
+  DestroyShell(std::move(shell));
+
+  if (timings.empty()) {
+    return;
+  }
+  auto average_ms = [&timings](FrameTiming::Phase start,
+                               FrameTiming::Phase finish) {
+    double total = 0;
+    for (const auto& timing : timings) {
+      total += (timing.Get(finish) - timing.Get(start)).ToMillisecondsF();
+    }
+    return total / timings.size();
+  };
+  state.counters["UIMs"] =
+      average_ms(FrameTiming::kBuildStart, FrameTiming::kBuildFinish);
+  state.counters["RasterMs"] =
+      average_ms(FrameTiming::kRasterStart, FrameTiming::kRasterFinish);
+  state.counters["LatencyMs"] =
+      average_ms(FrameTiming::kVsyncStart, FrameTiming::kRasterFinish);
+  state.counters["LayerCount"] = depth * (width + 1);
+}
+
+BENCHMARK_REGISTER_F(ShellFrameBenchmarks, SteadyStateFrames)
+    ->ArgNames({"depth", "width"})
+    ->Args({1, 1})
+    ->Args({1, 16})
+    ->Args({1, 256})
+    ->Args({4, 16})
+    ->Args({16, 16})
+    ->Args({64, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace testing
+
 }  // namespace flutter
@@ -51,6 +51,7 @@ ShellIOManager::ShellIOManager(
           resource_context_)),
       is_gpu_disabled_sync_switch_(std::move(is_gpu_disabled_sync_switch)),
       impeller_context_(std::move(impeller_context)),
+      decoded_image_cache_(std::make_shared<DecodedImageCache>()),
       weak_factory_(this) {
   if (!resource_context_) {
 #ifndef OS_FUCHSIA
@@ -121,4 +122,9 @@ std::shared_ptr<impeller::Context> ShellIOManager::GetImpellerContext() const {
   return impeller_context_;
 }
 
+std::shared_ptr<DecodedImageCache> ShellIOManager::GetDecodedImageCache()
+    const {
+  return decoded_image_cache_;
+}
+
 }  // namespace flutter
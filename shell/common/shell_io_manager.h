@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -62,6 +63,9 @@ class ShellIOManager final : public IOManager {
   // |IOManager|
   std::shared_ptr<impeller::Context> GetImpellerContext() const override;
 
+  // |IOManager|
+  std::shared_ptr<DecodedImageCache> GetDecodedImageCache() const override;
+
  private:
   // Resource context management.
   sk_sp<GrDirectContext> resource_context_;
@@ -71,6 +75,8 @@ class ShellIOManager final : public IOManager {
   fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue_;
   std::shared_ptr<const fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<impeller::Context> impeller_context_;
+  // Shared by the engines spawned from the shell that created this manager.
+  const std::shared_ptr<DecodedImageCache> decoded_image_cache_;
   fml::WeakPtrFactory<ShellIOManager> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ShellIOManager);
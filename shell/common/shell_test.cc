@@ -6,6 +6,7 @@
 
 #include "flutter/shell/common/shell_test.h"
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -208,7 +209,8 @@ void ShellTest::PumpOneFrame(Shell* shell,
         if (builder) {
           builder(root_layer);
         }
-        runtime_delegate->Render(std::move(layer_tree));
+        runtime_delegate->Render(kFlutterImplicitViewId,
+                                 std::move(layer_tree));
         latch.Signal();
       });
   latch.Wait();
@@ -249,6 +251,17 @@ void ShellTest::StorePersistentCache(PersistentCache* cache,
   cache->store(key, value);
 }
 
+void ShellTest::FlushPersistentCacheWrites(Shell* shell) {
+  // The deferred writes are handed to the file IO thread from the IO thread,
+  // so they have all been handed over once the IO thread is flushed.
+  shell->idle_task_queue_->RunUntil(fml::TimePoint::Max());
+  std::promise<bool> io_task_finished;
+  shell->GetTaskRunners().GetIOTaskRunner()->PostTask(
+      [&io_task_finished]() { io_task_finished.set_value(true); });
+  io_task_finished.get_future().wait();
+  PersistentCache::GetCacheForProcess()->WaitForPendingWrites();
+}
+
 void ShellTest::OnServiceProtocol(
     Shell* shell,
     ServiceProtocolEnum some_protocol,
@@ -274,6 +287,12 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kCaptureFrames:
+        shell->OnServiceProtocolCaptureFrames(params, response);
+        break;
+      case ServiceProtocolEnum::kGetFrameCapture:
+        shell->OnServiceProtocolGetFrameCapture(params, response);
+        break;
     }
     finished.set_value(true);
   });
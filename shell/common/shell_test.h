@@ -100,6 +100,10 @@ class ShellTest : public FixtureTest {
                                    const SkData& key,
                                    const SkData& value);
 
+  // Runs the persistent cache writes deferred to idle periods and waits for
+  // all the pending ones to be written.
+  static void FlushPersistentCacheWrites(Shell* shell);
+
   static bool IsAnimatorRunning(Shell* shell);
 
   enum ServiceProtocolEnum {
@@ -108,6 +112,8 @@ class ShellTest : public FixtureTest {
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
+    kCaptureFrames,
+    kGetFrameCapture,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
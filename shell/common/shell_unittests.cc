@@ -2084,6 +2084,71 @@ TEST_F(ShellTest, Screenshot) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ScreenshotOfRetainedFrameIsEncodedAsynchronously) {
+  auto settings = CreateSettingsForFixture();
+  settings.retain_last_frame_for_screenshots = true;
+  fml::AutoResetWaitableEvent firstFrameLatch;
+  settings.frame_rasterized_callback =
+      [&firstFrameLatch](const FrameTiming& t) { firstFrameLatch.Signal(); };
+
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](const std::shared_ptr<ContainerLayer>& root) {
+    fml::RefPtr<SkiaUnrefQueue> queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        this->GetCurrentTaskRunner(), fml::TimeDelta::Zero());
+    auto display_list_layer = std::make_shared<DisplayListLayer>(
+        SkPoint::Make(10, 10),
+        flutter::SkiaGPUObject<DisplayList>(
+            {MakeSizedDisplayList(80, 80), queue}),
+        false, false);
+    root->Add(display_list_layer);
+  };
+
+  PumpOneFrame(shell.get(), 100, 100, builder);
+  firstFrameLatch.Wait();
+
+  std::promise<Rasterizer::Screenshot> screenshot_promise;
+  auto screenshot_future = screenshot_promise.get_future();
+  auto raster_task_runner = shell->GetTaskRunners().GetRasterTaskRunner();
+  shell->Screenshot(
+      Rasterizer::ScreenshotType::CompressedImage, false,
+      [&screenshot_promise,
+       raster_task_runner](Rasterizer::Screenshot screenshot) {
+        // The screenshot is encoded off the raster thread.
+        EXPECT_FALSE(raster_task_runner->RunsTasksOnCurrentThread());
+        screenshot_promise.set_value(std::move(screenshot));
+      });
+
+  auto fixtures_dir =
+      fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead);
+
+  auto reference_png = fml::FileMapping::CreateReadOnly(
+      fixtures_dir, "shelltest_screenshot.png");
+
+  // Use MakeWithoutCopy instead of MakeWithCString because we don't want to
+  // encode the null sentinel
+  sk_sp<SkData> reference_data = SkData::MakeWithoutCopy(
+      reference_png->GetMapping(), reference_png->GetSize());
+
+  Rasterizer::Screenshot screenshot = screenshot_future.get();
+  EXPECT_EQ(screenshot.format, "ScreenshotType::CompressedImage");
+  if (!reference_data->equals(screenshot.data.get())) {
+    LogSkData(reference_data, "reference");
+    LogSkData(screenshot.data, "screenshot");
+    ASSERT_TRUE(false);
+  }
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, CanConvertToAndFromMappings) {
   const size_t buffer_size = 2 << 20;
 
@@ -2547,6 +2612,61 @@ TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolCaptureFramesWorks) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("scene_with_red_box");
+  RunEngine(shell.get(), std::move(configuration));
+
+  auto raster_task_runner = shell->GetTaskRunners().GetRasterTaskRunner();
+  auto to_string = [](const rapidjson::Document& document) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    document.Accept(writer);
+    return std::string(buffer.GetString());
+  };
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameCapture,
+                    raster_task_runner, empty_params, &document);
+  EXPECT_THAT(to_string(document),
+              ::testing::HasSubstr("No frame capture was started"));
+
+  ServiceProtocol::Handler::ServiceProtocolMap invalid_params;
+  invalid_params["frameCount"] = "0";
+  document.SetNull();
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kCaptureFrames,
+                    raster_task_runner, invalid_params, &document);
+  EXPECT_THAT(to_string(document),
+              ::testing::HasSubstr("'frameCount' must be a number"));
+
+  document.SetNull();
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kCaptureFrames,
+                    raster_task_runner, empty_params, &document);
+  EXPECT_EQ(to_string(document), "{\"type\":\"Success\"}");
+
+  PumpOneFrame(shell.get());
+
+  document.SetNull();
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameCapture,
+                    raster_task_runner, empty_params, &document);
+  std::string actual_json = to_string(document);
+  EXPECT_THAT(actual_json,
+              ::testing::HasSubstr("{\"type\":\"FrameCapture\""));
+  EXPECT_THAT(actual_json, ::testing::HasSubstr("\"capturedFrames\":1"));
+  EXPECT_THAT(actual_json, ::testing::HasSubstr("\"complete\":true"));
+  EXPECT_THAT(actual_json, ::testing::HasSubstr("\"capture\":\""));
+
+  PlatformViewNotifyDestroyed(shell.get());
+  DestroyShell(std::move(shell));
+}
+
 // TODO(https://github.com/flutter/flutter/issues/100273): Disabled due to
 // flakiness.
 // TODO(https://github.com/flutter/flutter/issues/100299): Fix it when
@@ -3632,6 +3752,39 @@ TEST_F(ShellTest, PrefetchDefaultFontManager) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, DefaultFontManagerIsSetUpWhenTheEngineRuns) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell;
+
+  auto get_font_manager_count = [&] {
+    fml::AutoResetWaitableEvent latch;
+    size_t font_manager_count;
+    fml::TaskRunner::RunNowOrPostTask(
+        shell->GetTaskRunners().GetUITaskRunner(),
+        [this, &shell, &latch, &font_manager_count]() {
+          font_manager_count =
+              GetFontCollection(shell.get())->GetFontManagersCount();
+          latch.Signal();
+        });
+    latch.Wait();
+    return font_manager_count;
+  };
+
+  shell = CreateShell(settings);
+
+  // The default font manager is created on a worker, and is only waited for
+  // once the root isolate is created.
+  size_t initial_font_manager_count = get_font_manager_count();
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+
+  ASSERT_EQ(get_font_manager_count(), initial_font_manager_count + 1);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, OnPlatformViewCreatedWhenUIThreadIsBusy) {
   // This test will deadlock if the threading logic in
   // Shell::OnCreatePlatformView is wrong.
@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_timeline.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+using Phase = StartupTimeline::Phase;
+
+// The phases that each phase waits for before it begins.
+std::vector<Phase> GetDependencies(Phase phase) {
+  switch (phase) {
+    case Phase::kVMSetup:
+      return {};
+    case Phase::kPlatformViewSetup:
+    case Phase::kGPUSetup:
+      return {Phase::kVMSetup};
+    case Phase::kIOSetup:
+      return {Phase::kPlatformViewSetup};
+    case Phase::kUISetup:
+      return {Phase::kIOSetup, Phase::kGPUSetup};
+    case Phase::kFontManagerSetup:
+    case Phase::kRootIsolateLaunch:
+      return {Phase::kUISetup};
+    case Phase::kFirstFrame:
+      return {Phase::kRootIsolateLaunch};
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace
+
+StartupTimeline::StartupTimeline() = default;
+
+StartupTimeline::~StartupTimeline() = default;
+
+void StartupTimeline::Record(Phase phase,
+                             fml::TimePoint begin,
+                             fml::TimePoint end) {
+  std::scoped_lock lock(mutex_);
+  auto& interval = intervals_[static_cast<size_t>(phase)];
+  if (!interval.has_value()) {
+    interval = Interval{begin, end};
+  }
+}
+
+std::optional<StartupTimeline::Interval> StartupTimeline::GetInterval(
+    Phase phase) const {
+  std::scoped_lock lock(mutex_);
+  return intervals_[static_cast<size_t>(phase)];
+}
+
+std::optional<StartupTimeline::Summary> StartupTimeline::Summarize() const {
+  const auto first_frame = GetInterval(Phase::kFirstFrame);
+  if (!first_frame.has_value()) {
+    return std::nullopt;
+  }
+
+  Summary summary;
+  auto start = first_frame->begin;
+  for (size_t i = 0; i < kPhaseCount; i++) {
+    if (auto interval = GetInterval(static_cast<Phase>(i))) {
+      start = std::min(start, interval->begin);
+    }
+  }
+  summary.time_to_first_frame = first_frame->end - start;
+
+  // Walk back from the first frame through the dependencies that ended last.
+  std::optional<Phase> phase = Phase::kFirstFrame;
+  while (phase.has_value()) {
+    const auto interval = GetInterval(phase.value());
+    summary.critical_path.push_back(phase.value());
+    summary.critical_path_duration =
+        summary.critical_path_duration + (interval->end - interval->begin);
+
+    std::optional<Phase> last_dependency;
+    fml::TimePoint last_end;
+    for (const auto dependency : GetDependencies(phase.value())) {
+      const auto dependency_interval = GetInterval(dependency);
+      if (!dependency_interval.has_value()) {
+        continue;
+      }
+      if (!last_dependency.has_value() || dependency_interval->end > last_end) {
+        last_dependency = dependency;
+        last_end = dependency_interval->end;
+      }
+    }
+    phase = last_dependency;
+  }
+  std::reverse(summary.critical_path.begin(), summary.critical_path.end());
+  return summary;
+}
+
+std::string StartupTimeline::FormatCriticalPath(const Summary& summary) const {
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(1);
+  for (size_t i = 0; i < summary.critical_path.size(); i++) {
+    const auto phase = summary.critical_path[i];
+    const auto interval = GetInterval(phase);
+    if (i > 0) {
+      stream << " > ";
+    }
+    stream << GetPhaseName(phase) << " "
+           << (interval->end - interval->begin).ToMillisecondsF() << "ms";
+  }
+  return stream.str();
+}
+
+const char* StartupTimeline::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kVMSetup:
+      return "VMSetup";
+    case Phase::kPlatformViewSetup:
+      return "PlatformViewSetup";
+    case Phase::kGPUSetup:
+      return "GPUSetup";
+    case Phase::kIOSetup:
+      return "IOSetup";
+    case Phase::kUISetup:
+      return "UISetup";
+    case Phase::kFontManagerSetup:
+      return "FontManagerSetup";
+    case Phase::kRootIsolateLaunch:
+      return "RootIsolateLaunch";
+    case Phase::kFirstFrame:
+      return "FirstFrame";
+  }
+  FML_UNREACHABLE();
+}
+
+StartupTimeline::ScopedPhase::ScopedPhase(StartupTimeline& timeline,
+                                          Phase phase)
+    : timeline_(timeline), phase_(phase), begin_(fml::TimePoint::Now()) {}
+
+StartupTimeline::ScopedPhase::~ScopedPhase() {
+  timeline_.Record(phase_, begin_, fml::TimePoint::Now());
+}
+
+}  // namespace flutter
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Records when the phases of the startup of a shell begin and end, and finds
+/// the critical path to the first frame from them.
+///
+/// The phases run on different threads and some of them run concurrently.
+/// Each phase waits for the phases it depends on. So the critical path is
+/// found by walking back from the first frame to the dependency that ended
+/// last, until a phase without recorded dependencies is reached. Shortening
+/// the phases that are not on the path doesn't bring the first frame sooner.
+///
+/// Phases may be recorded from any thread. This class is thread safe.
+///
+class StartupTimeline {
+ public:
+  enum class Phase {
+    // Creating the Dart VM and loading its snapshots.
+    kVMSetup,
+    // Creating the platform view on the platform thread, which creates the
+    // GPU context on most platforms.
+    kPlatformViewSetup,
+    // Creating the rasterizer on the raster thread.
+    kGPUSetup,
+    // Creating the IO manager, which needs the resource context of the
+    // platform view.
+    kIOSetup,
+    // Creating the engine, which needs the IO manager and the rasterizer.
+    kUISetup,
+    // Creating the default font manager, which loads the system fonts. It
+    // runs concurrently with the engine setup and the root isolate launch.
+    kFontManagerSetup,
+    // Launching the root isolate. This includes waiting for the default font
+    // manager, if it is not created by then.
+    kRootIsolateLaunch,
+    // Building and rasterizing the first frame.
+    kFirstFrame,
+  };
+
+  static constexpr size_t kPhaseCount =
+      static_cast<size_t>(Phase::kFirstFrame) + 1u;
+
+  struct Summary {
+    /// The time from the start of the first phase to the end of the first
+    /// frame.
+    fml::TimeDelta time_to_first_frame;
+    /// The phases that the first frame waited for, from the first to the
+    /// first frame itself.
+    std::vector<Phase> critical_path;
+    /// The time spent in the phases of the critical path. The rest of the
+    /// time to the first frame is spent between phases, such as waiting for
+    /// the platform to run the engine or for the first vsync.
+    fml::TimeDelta critical_path_duration;
+  };
+
+  StartupTimeline();
+
+  ~StartupTimeline();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a phase. Only the first record of each phase is kept,
+  ///             so that later runs of the same steps, such as relaunching
+  ///             the root isolate on hot restart, don't overwrite the startup.
+  ///
+  void Record(Phase phase, fml::TimePoint begin, fml::TimePoint end);
+
+  //----------------------------------------------------------------------------
+  /// @return     The summary of the startup, or nothing if the first frame
+  ///             has not been recorded yet.
+  ///
+  std::optional<Summary> Summarize() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The critical path of the summary as a single line, such as
+  ///             "VMSetup 10.0ms > UISetup 2.0ms > FirstFrame 8.0ms".
+  ///
+  std::string FormatCriticalPath(const Summary& summary) const;
+
+  static const char* GetPhaseName(Phase phase);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the time from its creation to its destruction as a
+  ///             phase.
+  ///
+  class ScopedPhase {
+   public:
+    ScopedPhase(StartupTimeline& timeline, Phase phase);
+
+    ~ScopedPhase();
+
+   private:
+    StartupTimeline& timeline_;
+    const Phase phase_;
+    const fml::TimePoint begin_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedPhase);
+  };
+
+ private:
+  struct Interval {
+    fml::TimePoint begin;
+    fml::TimePoint end;
+  };
+
+  mutable std::mutex mutex_;
+  std::array<std::optional<Interval>, kPhaseCount> intervals_;
+
+  std::optional<Interval> GetInterval(Phase phase) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_timeline.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using Phase = StartupTimeline::Phase;
+
+fml::TimePoint AtMillis(int64_t millis) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(millis));
+}
+
+void Record(StartupTimeline& timeline,
+            Phase phase,
+            int64_t begin_millis,
+            int64_t end_millis) {
+  timeline.Record(phase, AtMillis(begin_millis), AtMillis(end_millis));
+}
+
+}  // namespace
+
+TEST(StartupTimelineTest, IsNotSummarizedBeforeTheFirstFrame) {
+  StartupTimeline timeline;
+  Record(timeline, Phase::kVMSetup, 0, 10);
+  ASSERT_FALSE(timeline.Summarize().has_value());
+}
+
+TEST(StartupTimelineTest, FollowsTheDependenciesThatEndedLast) {
+  StartupTimeline timeline;
+  Record(timeline, Phase::kVMSetup, 0, 10);
+  Record(timeline, Phase::kPlatformViewSetup, 10, 15);
+  Record(timeline, Phase::kGPUSetup, 10, 30);
+  Record(timeline, Phase::kIOSetup, 15, 20);
+  Record(timeline, Phase::kUISetup, 30, 35);
+  Record(timeline, Phase::kFontManagerSetup, 35, 60);
+  Record(timeline, Phase::kRootIsolateLaunch, 40, 70);
+  Record(timeline, Phase::kFirstFrame, 80, 90);
+
+  auto summary = timeline.Summarize();
+  ASSERT_TRUE(summary.has_value());
+  ASSERT_EQ(summary->time_to_first_frame.ToMilliseconds(), 90);
+  // The UI setup waited for the rasterizer rather than the IO manager.
+  ASSERT_EQ(summary->critical_path,
+            (std::vector<Phase>{Phase::kVMSetup, Phase::kGPUSetup,
+                                Phase::kUISetup, Phase::kRootIsolateLaunch,
+                                Phase::kFirstFrame}));
+  ASSERT_EQ(summary->critical_path_duration.ToMilliseconds(),
+            10 + 20 + 5 + 30 + 10);
+  ASSERT_EQ(timeline.FormatCriticalPath(*summary),
+            "VMSetup 10.0ms > GPUSetup 20.0ms > UISetup 5.0ms > "
+            "RootIsolateLaunch 30.0ms > FirstFrame 10.0ms");
+}
+
+TEST(StartupTimelineTest, SkipsPhasesThatWereNotRecorded) {
+  StartupTimeline timeline;
+  Record(timeline, Phase::kUISetup, 5, 10);
+  Record(timeline, Phase::kRootIsolateLaunch, 10, 20);
+  Record(timeline, Phase::kFirstFrame, 25, 30);
+
+  auto summary = timeline.Summarize();
+  ASSERT_TRUE(summary.has_value());
+  ASSERT_EQ(summary->time_to_first_frame.ToMilliseconds(), 25);
+  ASSERT_EQ(summary->critical_path,
+            (std::vector<Phase>{Phase::kUISetup, Phase::kRootIsolateLaunch,
+                                Phase::kFirstFrame}));
+}
+
+TEST(StartupTimelineTest, KeepsTheFirstRecordOfAPhase) {
+  StartupTimeline timeline;
+  Record(timeline, Phase::kRootIsolateLaunch, 0, 10);
+  // A hot restart launches the root isolate again.
+  Record(timeline, Phase::kRootIsolateLaunch, 100, 200);
+  Record(timeline, Phase::kFirstFrame, 10, 20);
+
+  auto summary = timeline.Summarize();
+  ASSERT_TRUE(summary.has_value());
+  ASSERT_EQ(summary->time_to_first_frame.ToMilliseconds(), 20);
+  ASSERT_EQ(summary->critical_path_duration.ToMilliseconds(), 20);
+}
+
+}  // namespace testing
+}  // namespace flutter
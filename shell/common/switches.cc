@@ -354,6 +354,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.enable_trace_recorder =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTraceRecorder));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -413,6 +416,8 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
 
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
+  settings.enable_snapshot_warmup_profile = command_line.HasOption(
+      FlagForSwitch(Switch::EnableSnapshotWarmupProfile));
 
   bool leak_vm = "true" == command_line.GetOptionValueWithDefault(
                                FlagForSwitch(Switch::LeakVM), "true");
@@ -446,6 +451,102 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_impeller =
       command_line.HasOption(FlagForSwitch(Switch::EnableImpeller));
 
+  settings.impeller_vulkan_low_latency =
+      !command_line.HasOption(FlagForSwitch(Switch::ImpellerVulkanThroughput));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerVulkanFramesInFlight))) {
+    std::string frames_in_flight;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImpellerVulkanFramesInFlight), &frames_in_flight);
+    settings.impeller_vulkan_frames_in_flight =
+        std::max(std::stoi(frames_in_flight), 1);
+  }
+
+  settings.impeller_parallel_subpass_encoding = command_line.HasOption(
+      FlagForSwitch(Switch::ImpellerParallelSubpassEncoding));
+
+  settings.enable_surface_control =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSurfaceControl));
+
+  settings.enable_predictive_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameScheduling));
+
+  settings.enable_adaptive_pipeline_depth = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptivePipelineDepth));
+
+  settings.enable_frame_rate_hints =
+      command_line.HasOption(FlagForSwitch(Switch::EnableFrameRateHints));
+
+  settings.render_on_demand =
+      command_line.HasOption(FlagForSwitch(Switch::RenderOnDemand));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RenderOnDemandResourceTrimDelay))) {
+    std::string trim_delay;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RenderOnDemandResourceTrimDelay), &trim_delay);
+    settings.render_on_demand_resource_trim_delay =
+        fml::TimeDelta::FromMilliseconds(std::max(std::stoll(trim_delay), 0ll));
+  }
+
+  settings.enable_thread_placement =
+      command_line.HasOption(FlagForSwitch(Switch::EnableThreadPlacement));
+
+  settings.enable_performance_hints =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePerformanceHints));
+
+  settings.enable_async_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAsyncRasterCache));
+
+  settings.enable_paint_list =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePaintList));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ParallelPaintTasks))) {
+    std::string parallel_paint_tasks;
+    command_line.GetOptionValue(FlagForSwitch(Switch::ParallelPaintTasks),
+                                &parallel_paint_tasks);
+    settings.parallel_paint_tasks =
+        std::clamp(std::stoi(parallel_paint_tasks), 0, 8);
+  }
+  settings.parallel_paint_deferred_display_lists = command_line.HasOption(
+      FlagForSwitch(Switch::ParallelPaintDeferredDisplayLists));
+
+  settings.prewarm_first_frame =
+      command_line.HasOption(FlagForSwitch(Switch::PrewarmFirstFrame));
+
+  std::string batched_platform_message_channels;
+  command_line.GetOptionValue(
+      FlagForSwitch(Switch::BatchedPlatformMessageChannels),
+      &batched_platform_message_channels);
+  settings.batched_platform_message_channels =
+      ParseCommaDelimited(batched_platform_message_channels);
+
+  settings.coalesce_pointer_events =
+      command_line.HasOption(FlagForSwitch(Switch::CoalescePointerEvents));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::PointerResamplingOffsetUs))) {
+    std::string pointer_resampling_offset;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::PointerResamplingOffsetUs),
+        &pointer_resampling_offset);
+    settings.pointer_resampling_offset_micros =
+        std::stoll(pointer_resampling_offset);
+  }
+
+  settings.frame_aligned_pointer_events =
+      command_line.HasOption(FlagForSwitch(Switch::FrameAlignedPointerEvents));
+
+  settings.late_latch_pointer_transforms = command_line.HasOption(
+      FlagForSwitch(Switch::LateLatchPointerTransforms));
+
+  settings.discard_superseded_frames =
+      command_line.HasOption(FlagForSwitch(Switch::DiscardSupersededFrames));
+
+  settings.retain_last_frame_for_screenshots = command_line.HasOption(
+      FlagForSwitch(Switch::RetainLastFrameForScreenshots));
+
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
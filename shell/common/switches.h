@@ -58,6 +58,11 @@ DEF_SWITCH(CacheDirPath,
            "Path to the cache directory. "
            "This is different from the persistent_cache_path in embedder.h, "
            "which is used for Skia shader cache.")
+DEF_SWITCH(EnableSnapshotWarmupProfile,
+           "enable-snapshot-warmup-profile",
+           "Record the pages of the Dart snapshots that are touched until the "
+           "first frame in the cache directory, and read them ahead on the "
+           "next launches. CacheDirPath must be present.")
 DEF_SWITCH(ICUDataFilePath, "icu-data-file-path", "Path to the ICU data file.")
 DEF_SWITCH(ICUSymbolPrefix,
            "icu-symbol-prefix",
@@ -197,6 +202,11 @@ DEF_SWITCH(
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(EnableTraceRecorder,
+           "enable-trace-recorder",
+           "Keep the last trace events of each thread in memory so that they "
+           "can be dumped after the fact, for instance after a janky frame. "
+           "Unlike the timeline, this is also available in release builds.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -261,6 +271,123 @@ DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
            "Impeller is not supported on the platform.")
+DEF_SWITCH(ImpellerVulkanThroughput,
+           "impeller-vulkan-throughput",
+           "Queue every frame Impeller renders with Vulkan for a vsync, so "
+           "that no frame is dropped, instead of presenting frames as soon as "
+           "possible.")
+DEF_SWITCH(ImpellerVulkanFramesInFlight,
+           "impeller-vulkan-frames-in-flight",
+           "The number of frames Impeller may submit to the GPU with Vulkan "
+           "before the first of them completes. Defaults to 2, at most 3.")
+DEF_SWITCH(ImpellerParallelSubpassEncoding,
+           "impeller-parallel-subpass-encoding",
+           "Encode the independent save layers of each frame Impeller renders "
+           "concurrently on the worker threads of its context. Ignored by "
+           "OpenGL ES.")
+DEF_SWITCH(EnableSurfaceControl,
+           "enable-surface-control",
+           "Compose the overlays of Android platform views through "
+           "SurfaceControl transactions instead of merging the raster thread "
+           "into the platform thread. Ignored below API 29.")
+DEF_SWITCH(EnablePredictiveFrameScheduling,
+           "enable-predictive-frame-scheduling",
+           "Start building each frame as late as the timings of the recent "
+           "frames allow for it to still be rasterized before its deadline. "
+           "This reduces the latency from input to display.")
+DEF_SWITCH(EnableAdaptivePipelineDepth,
+           "enable-adaptive-pipeline-depth",
+           "Choose the number of frames in flight between the UI and raster "
+           "threads from the timings of the recent frames. A third frame is "
+           "allowed when rasterization is the bottleneck and a single frame "
+           "when both threads are fast.")
+DEF_SWITCH(EnableFrameRateHints,
+           "enable-frame-rate-hints",
+           "Ask displays with a variable refresh rate to run at the rate the "
+           "content is updated at, at their full rate while there is input, "
+           "and at their lowest rate while nothing is animating.")
+DEF_SWITCH(RenderOnDemand,
+           "render-on-demand",
+           "Begin frames as soon as they are requested instead of at the next "
+           "vsync, skip drawing frames that don't differ from the last ones "
+           "drawn, and purge the unused GPU resources once no frame has been "
+           "drawn for a while. Meant for displays that mostly show static "
+           "content.")
+DEF_SWITCH(RenderOnDemandResourceTrimDelay,
+           "render-on-demand-resource-trim-delay",
+           "The milliseconds without a frame being drawn after which the "
+           "unused GPU resources are purged when rendering on demand. "
+           "Defaults to 5000.")
+DEF_SWITCH(EnableThreadPlacement,
+           "enable-thread-placement",
+           "Keep the UI and raster threads on the fastest cores of devices "
+           "with cores of different speeds. Only supported on Android.")
+DEF_SWITCH(EnablePerformanceHints,
+           "enable-performance-hints",
+           "Report the work the UI and raster threads do on every frame to "
+           "the system, so that it can boost them before frames miss their "
+           "targets. Only supported on Android.")
+DEF_SWITCH(EnableAsyncRasterCache,
+           "enable-async-raster-cache",
+           "Render the display lists that the raster cache decides to cache on "
+           "the IO thread, and draw them uncached until their images are "
+           "ready, so that the frame that decides to cache them does not also "
+           "render them offscreen.")
+DEF_SWITCH(EnablePaintList,
+           "enable-paint-list",
+           "Compile each layer tree into a flat list of paint commands after "
+           "its preroll and paint the frame by looping over the list instead "
+           "of recursing into the layers.")
+DEF_SWITCH(ParallelPaintTasks,
+           "parallel-paint-tasks",
+           "Paint the children of a container in each layer tree on up to this "
+           "many threads, including the raster thread, when the frame is "
+           "painted into a display list. The value is capped at 8. Values "
+           "below 2 paint every layer on the raster thread.")
+DEF_SWITCH(ParallelPaintDeferredDisplayLists,
+           "parallel-paint-deferred-display-lists",
+           "When the frame is painted into the canvas of a Skia GPU surface, "
+           "record the children that are painted in parallel into deferred "
+           "display lists. Only applies with --parallel-paint-tasks.")
+DEF_SWITCH(PrewarmFirstFrame,
+           "prewarm-first-frame",
+           "Rasterize the frames produced before the platform surface is "
+           "created offscreen, and present the last of them as soon as the "
+           "surface is created.")
+DEF_SWITCH(BatchedPlatformMessageChannels,
+           "batched-platform-message-channels",
+           "A comma separated list of platform channels whose messages are "
+           "coalesced for up to a frame interval and dispatched to Dart "
+           "together.")
+DEF_SWITCH(CoalescePointerEvents,
+           "coalesce-pointer-events",
+           "Dispatch the pointer events received during a frame at the next "
+           "vsync, with the consecutive move and hover events of each pointer "
+           "coalesced into one.")
+DEF_SWITCH(PointerResamplingOffsetUs,
+           "pointer-resampling-offset-us",
+           "When pointer events are coalesced, resample the coalesced move "
+           "events at this many microseconds before the newest pointer event "
+           "of the frame.")
+DEF_SWITCH(FrameAlignedPointerEvents,
+           "frame-aligned-pointer-events",
+           "Dispatch the pointer events received while a frame is scheduled "
+           "right before that frame begins, so that it handles the latest "
+           "events.")
+DEF_SWITCH(LateLatchPointerTransforms,
+           "late-latch-pointer-transforms",
+           "Move the layers that follow a dragging pointer by the distance "
+           "the pointer has moved since their frame was built, right before "
+           "the frame is rasterized.")
+DEF_SWITCH(DiscardSupersededFrames,
+           "discard-superseded-frames",
+           "Discard the frames that missed their vsync target when a newer "
+           "frame is already waiting to be rasterized.")
+DEF_SWITCH(RetainLastFrameForScreenshots,
+           "retain-last-frame-for-screenshots",
+           "Keep a copy of the last frame that was presented, so that "
+           "screenshots read it back instead of rendering the last layer tree "
+           "again.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
@@ -76,5 +76,17 @@ TEST(SwitchesTest, MsaaSamples) {
   EXPECT_EQ(settings.msaa_samples, 0);
 }
 
+TEST(SwitchesTest, ImpellerParallelSubpassEncoding) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.impeller_parallel_subpass_encoding);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-parallel-subpass-encoding"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.impeller_parallel_subpass_encoding);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -7,6 +7,7 @@
 #include "flow/frame_timings.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/frame_duration_predictor.h"
 #include "fml/logging.h"
 #include "fml/message_loop_task_queues.h"
 #include "fml/task_queue_id.h"
@@ -23,6 +24,20 @@ VsyncWaiter::VsyncWaiter(const TaskRunners& task_runners)
 
 VsyncWaiter::~VsyncWaiter() = default;
 
+void VsyncWaiter::SetFrameDurationPredictor(
+    std::shared_ptr<const FrameDurationPredictor> frame_duration_predictor) {
+  frame_duration_predictor_ = std::move(frame_duration_predictor);
+}
+
+void VsyncWaiter::SetPreferredFrameRate(double frame_rate) {}
+
+std::optional<fml::TimeDelta> VsyncWaiter::PredictFrameDuration() const {
+  if (!frame_duration_predictor_) {
+    return std::nullopt;
+  }
+  return frame_duration_predictor_->PredictFrameDuration();
+}
+
 // Public method invoked by the animator.
 void VsyncWaiter::AsyncWaitForVsync(const Callback& callback) {
   if (!callback) {
@@ -126,7 +141,8 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
     fml::TaskQueueId ui_task_queue_id =
         task_runners_.GetUITaskRunner()->GetTaskQueueId();
 
-    task_runners_.GetUITaskRunner()->PostTask(
+    // The frame must not wait behind a backlog of platform messages.
+    task_runners_.GetUITaskRunner()->PostTaskWithGrade(
         [ui_task_queue_id, callback, flow_identifier, frame_start_time,
          frame_target_time, pause_secondary_tasks]() {
           FML_TRACE_EVENT("flutter", kVsyncTraceName, "StartTime",
@@ -140,7 +156,8 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
           if (pause_secondary_tasks) {
             ResumeDartMicroTasks(ui_task_queue_id);
           }
-        });
+        },
+        fml::TaskSourceGrade::kUserInteraction);
   }
 
   for (auto& secondary_callback : secondary_callbacks) {
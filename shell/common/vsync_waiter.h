@@ -8,6 +8,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/common/task_runners.h"
@@ -16,6 +17,8 @@
 
 namespace flutter {
 
+class FrameDurationPredictor;
+
 /// Abstract Base Class that represents a platform specific mechanism for
 /// getting callbacks when a vsync event happens.
 class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
@@ -32,6 +35,21 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// Sets the predictor of the durations of frames. Backends that are given
+  /// several possible deadlines per vsync use it to pick the earliest deadline
+  /// that the next frame is predicted to meet.
+  ///
+  /// Must be called on the UI thread before the first vsync is awaited.
+  void SetFrameDurationPredictor(
+      std::shared_ptr<const FrameDurationPredictor> frame_duration_predictor);
+
+  /// Asks the display to run at |frame_rate| frames per second, or at its full
+  /// refresh rate if |frame_rate| is 0. The display may not honor it. Backends
+  /// that can't change the rate of the display ignore it.
+  ///
+  /// Called on the UI thread.
+  virtual void SetPreferredFrameRate(double frame_rate);
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -71,7 +89,12 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
                     fml::TimePoint frame_target_time,
                     bool pause_secondary_tasks = true);
 
+  // The predicted duration of the next frame from the start of its build to
+  // the end of its rasterization, if any.
+  std::optional<fml::TimeDelta> PredictFrameDuration() const;
+
  private:
+  std::shared_ptr<const FrameDurationPredictor> frame_duration_predictor_;
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
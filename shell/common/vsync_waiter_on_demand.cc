@@ -0,0 +1,44 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/vsync_waiter_on_demand.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+VsyncWaiterOnDemand::VsyncWaiterOnDemand(const TaskRunners& task_runners,
+                                         fml::TimeDelta frame_interval)
+    : VsyncWaiter(task_runners), frame_interval_(frame_interval) {}
+
+VsyncWaiterOnDemand::~VsyncWaiterOnDemand() = default;
+
+// |VsyncWaiter|
+void VsyncWaiterOnDemand::AwaitVSync() {
+  const auto frame_start_time = std::max(
+      fml::TimePoint::Now(), last_frame_start_time_ + frame_interval_);
+  const auto frame_target_time = frame_start_time + frame_interval_;
+  last_frame_start_time_ = frame_start_time;
+
+  TRACE_EVENT2_INT("flutter", "OnDemandVsync", "frame_start_time",
+                   frame_start_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   frame_target_time.ToEpochDelta().ToMicroseconds());
+
+  std::weak_ptr<VsyncWaiterOnDemand> weak_this =
+      std::static_pointer_cast<VsyncWaiterOnDemand>(shared_from_this());
+
+  task_runners_.GetUITaskRunner()->PostTaskForTime(
+      [frame_start_time, frame_target_time, weak_this]() {
+        if (auto vsync_waiter = weak_this.lock()) {
+          vsync_waiter->FireCallback(frame_start_time, frame_target_time);
+        }
+      },
+      frame_start_time);
+}
+
+}  // namespace flutter
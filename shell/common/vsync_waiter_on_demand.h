@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_VSYNC_WAITER_ON_DEMAND_H_
+#define FLUTTER_SHELL_COMMON_VSYNC_WAITER_ON_DEMAND_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/vsync_waiter.h"
+
+namespace flutter {
+
+/// A |VsyncWaiter| that doesn't wait for the vsync of the display. A frame
+/// that is requested begins right away, unless it would begin less than one
+/// frame interval after the previous one, in which case it begins one interval
+/// after it. Used by |Settings::render_on_demand|.
+class VsyncWaiterOnDemand final : public VsyncWaiter {
+ public:
+  static constexpr fml::TimeDelta kDefaultFrameInterval =
+      fml::TimeDelta::FromMicroseconds(16667);
+
+  explicit VsyncWaiterOnDemand(
+      const TaskRunners& task_runners,
+      fml::TimeDelta frame_interval = kDefaultFrameInterval);
+
+  ~VsyncWaiterOnDemand() override;
+
+ private:
+  const fml::TimeDelta frame_interval_;
+  // Only accessed on the UI thread.
+  fml::TimePoint last_frame_start_time_;
+
+  // |VsyncWaiter|
+  void AwaitVSync() override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterOnDemand);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_VSYNC_WAITER_ON_DEMAND_H_
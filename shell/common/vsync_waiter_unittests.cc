@@ -4,7 +4,10 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/shell/common/switches.h"
+#include "flutter/shell/common/vsync_waiter_on_demand.h"
 
 #include "gtest/gtest.h"
 #include "thread_host.h"
@@ -43,5 +46,39 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+TEST(VsyncWaiterTest, OnDemandFramesAreAtLeastAFrameIntervalApart) {
+  fml::Thread thread("vsync_waiter_test");
+  auto task_runner = thread.GetTaskRunner();
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+  constexpr fml::TimeDelta kFrameInterval =
+      fml::TimeDelta::FromMilliseconds(50);
+  auto vsync_waiter =
+      std::make_shared<VsyncWaiterOnDemand>(task_runners, kFrameInterval);
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TimePoint request_time;
+  fml::TimePoint first_frame_start_time;
+  fml::TimePoint second_frame_start_time;
+  task_runner->PostTask([&] {
+    request_time = fml::TimePoint::Now();
+    vsync_waiter->AsyncWaitForVsync(
+        [&](std::unique_ptr<FrameTimingsRecorder> recorder) {
+          first_frame_start_time = recorder->GetVsyncStartTime();
+          vsync_waiter->AsyncWaitForVsync(
+              [&](std::unique_ptr<FrameTimingsRecorder> recorder) {
+                second_frame_start_time = recorder->GetVsyncStartTime();
+                latch.Signal();
+              });
+        });
+  });
+  latch.Wait();
+
+  // The first frame doesn't wait for an interval to pass.
+  EXPECT_LT(first_frame_start_time - request_time, kFrameInterval);
+  EXPECT_GE(second_frame_start_time - first_frame_start_time, kFrameInterval);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -11,10 +11,21 @@
 
 namespace flutter {
 
+static std::optional<impeller::IRect> ToIRect(
+    const std::optional<SkIRect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(rect->left(), rect->top(), rect->right(),
+                                   rect->bottom());
+}
+
 GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     GPUSurfaceGLDelegate* delegate,
-    std::shared_ptr<impeller::Context> context)
-    : weak_factory_(this) {
+    std::shared_ptr<impeller::Context> context,
+    std::shared_ptr<impeller::AiksContext> aiks_context,
+    bool render_to_surface)
+    : render_to_surface_(render_to_surface), weak_factory_(this) {
   if (delegate == nullptr) {
     return;
   }
@@ -28,7 +39,9 @@ GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(context);
+  if (!aiks_context || aiks_context->GetContext() != context) {
+    aiks_context = std::make_shared<impeller::AiksContext>(context);
+  }
 
   if (!aiks_context->IsValid()) {
     return;
@@ -57,16 +70,34 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
+  if (!render_to_surface_) {
+    SurfaceFrame::FramebufferInfo framebuffer_info;
+    framebuffer_info.supports_readback = true;
+    return std::make_unique<SurfaceFrame>(
+        nullptr,           // surface
+        framebuffer_info,  // framebuffer info
+        [](const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+          return true;
+        },                 // submit callback
+        size,              // frame size
+        nullptr,           // context result
+        true               // display list fallback
+    );
+  }
+
+  // Filled in when the frame is submitted. The swap happens after that.
+  auto submit_info = std::make_shared<SurfaceFrame::SubmitInfo>();
+
   auto swap_callback = [weak = weak_factory_.GetWeakPtr(),
-                        delegate = delegate_]() -> bool {
+                        delegate = delegate_, submit_info]() -> bool {
     if (weak) {
       GLPresentInfo present_info = {
           .fbo_id = 0,
-          .frame_damage = std::nullopt,
+          .frame_damage = submit_info->frame_damage,
           // TODO (https://github.com/flutter/flutter/issues/105597): wire-up
           // presentation time to impeller backend.
           .presentation_time = std::nullopt,
-          .buffer_damage = std::nullopt,
+          .buffer_damage = submit_info->buffer_damage,
       };
       delegate->GLContextPresent(present_info);
     }
@@ -80,49 +111,69 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
+  // The existing damage is what changed since the FBO was last drawn to.
+  // The flow layer uses it to work out which part of the frame to repaint.
+  GLFrameInfo frame_info = {static_cast<uint32_t>(size.width()),
+                            static_cast<uint32_t>(size.height())};
+  const GLFBOInfo fbo_info = delegate_->GLContextFBO(frame_info);
+
   auto surface = impeller::SurfaceGLES::WrapFBO(
       impeller_context_,                            // context
       swap_callback,                                // swap_callback
-      0u,                                           // fbo
+      fbo_info.fbo_id,                              // fbo
       impeller::PixelFormat::kR8G8B8A8UNormInt,     // color_format
       impeller::ISize{size.width(), size.height()}  // fbo_size
   );
+  auto framebuffer_info = delegate_->GLContextFramebufferInfo();
+  if (!framebuffer_info.existing_damage.has_value()) {
+    framebuffer_info.existing_damage = fbo_info.existing_damage;
+  }
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([renderer = impeller_renderer_,         //
+                         aiks_context = aiks_context_,          //
+                         conversion_cache = conversion_cache_,  //
+                         surface = std::move(surface),          //
+                         delegate = delegate_,                  //
+                         submit_info                            //
   ](SurfaceFrame& surface_frame, SkCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
         }
 
+        *submit_info = surface_frame.submit_info();
+        // Must be called before anything is drawn to the FBO.
+        delegate->GLContextSetDamageRegion(submit_info->buffer_damage);
+
         auto display_list = surface_frame.BuildDisplayList();
         if (!display_list) {
           FML_LOG(ERROR) << "Could not build display list for surface frame.";
           return false;
         }
 
-        impeller::DisplayListDispatcher impeller_dispatcher;
+        impeller::DisplayListDispatcher impeller_dispatcher(
+            aiks_context->GetContext()->GetWorkQueue(), conversion_cache);
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        conversion_cache->EndFrame();
 
         return renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
+                [aiks_context, picture = std::move(picture),
+                 damage = ToIRect(submit_info->buffer_damage)](
                     impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target);
+                  return aiks_context->Render(picture, render_target, damage);
                 }));
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      std::move(context_switch),        // context result
-      true                              // display list fallback
+      nullptr,                    // surface
+      framebuffer_info,           // framebuffer info
+      submit_callback,            // submit callback
+      size,                       // frame size
+      std::move(context_switch),  // context result
+      true                        // display list fallback
   );
 }
 
@@ -156,7 +207,7 @@ bool GPUSurfaceGLImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceGLImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
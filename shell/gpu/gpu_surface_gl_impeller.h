@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_conversion_cache.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 
@@ -17,8 +18,21 @@ namespace flutter {
 
 class GPUSurfaceGLImpeller final : public Surface {
  public:
-  explicit GPUSurfaceGLImpeller(GPUSurfaceGLDelegate* delegate,
-                                std::shared_ptr<impeller::Context> context);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that renders with the given Impeller
+  ///             context. If an Aiks context of the same Impeller context is
+  ///             given, it is used rather than a new one, so that surfaces
+  ///             share the pipeline variants, glyph atlas and caches it holds.
+  ///
+  ///             If the surface doesn't render to the surface, the frames only
+  ///             record display lists, and the contents are rendered by an
+  ///             external view embedder instead.
+  ///
+  explicit GPUSurfaceGLImpeller(
+      GPUSurfaceGLDelegate* delegate,
+      std::shared_ptr<impeller::Context> context,
+      std::shared_ptr<impeller::AiksContext> aiks_context = nullptr,
+      bool render_to_surface = true);
 
   // |Surface|
   ~GPUSurfaceGLImpeller() override;
@@ -31,6 +45,9 @@ class GPUSurfaceGLImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<impeller::DisplayListConversionCache> conversion_cache_ =
+      std::make_shared<impeller::DisplayListConversionCache>();
+  bool render_to_surface_ = true;
   bool is_valid_ = false;
   fml::WeakPtrFactory<GPUSurfaceGLImpeller> weak_factory_;
 
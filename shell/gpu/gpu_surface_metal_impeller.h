@@ -7,19 +7,32 @@
 
 #include <QuartzCore/CAMetalLayer.h>
 
+#include <map>
+
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_conversion_cache.h"
+#include "flutter/impeller/renderer/backend/metal/frame_pacer_mtl.h"
 #include "flutter/impeller/renderer/renderer.h"
+#include "flutter/impeller/renderer/texture.h"
 #include "flutter/shell/gpu/gpu_surface_metal_delegate.h"
 
 namespace flutter {
 
 class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetalImpeller : public Surface {
  public:
-  GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
-                          const std::shared_ptr<impeller::Context>& context);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that renders with the given Impeller
+  ///             context. If an Aiks context of the same Impeller context is
+  ///             given, it is used rather than a new one, so that surfaces
+  ///             share the pipeline variants, glyph atlas and caches it holds.
+  ///
+  GPUSurfaceMetalImpeller(
+      GPUSurfaceMetalDelegate* delegate,
+      const std::shared_ptr<impeller::Context>& context,
+      std::shared_ptr<impeller::AiksContext> aiks_context = nullptr);
 
   // |Surface|
   ~GPUSurfaceMetalImpeller();
@@ -33,11 +46,26 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetalImpeller : public Surface {
   const GPUSurfaceMetalDelegate* delegate_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<impeller::DisplayListConversionCache> conversion_cache_ =
+      std::make_shared<impeller::DisplayListConversionCache>();
   fml::scoped_nsprotocol<id<MTLDrawable>> last_drawable_;
+  bool disable_partial_repaint_ = false;
+  // Whether frames are rendered into |offscreen_texture_|, which is copied into
+  // a drawable once the frame was encoded.
+  bool defer_drawable_acquisition_ = true;
+  std::shared_ptr<impeller::Texture> offscreen_texture_;
+  std::shared_ptr<impeller::FramePacerMTL> frame_pacer_;
+  // Accumulated damage for each framebuffer; Key is address of underlying
+  // MTLTexture for each drawable
+  std::map<uintptr_t, SkIRect> damage_;
 
   // |Surface|
   std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override;
 
+  // Gets the offscreen texture that matches the drawables of |layer|, which is
+  // recreated when they change.
+  std::shared_ptr<impeller::Texture> GetOffscreenTexture(CAMetalLayer* layer);
+
   // |Surface|
   SkMatrix GetRootTransformation() const override;
 
@@ -12,6 +12,7 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/display_list/display_list_dispatcher.h"
+#include "flutter/impeller/renderer/backend/metal/formats_mtl.h"
 #include "flutter/impeller/renderer/backend/metal/surface_mtl.h"
 
 static_assert(!__has_feature(objc_arc), "ARC must be disabled.");
@@ -28,12 +29,40 @@ static std::shared_ptr<impeller::Renderer> CreateImpellerRenderer(
   return renderer;
 }
 
-GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
-                                                 const std::shared_ptr<impeller::Context>& context)
+static std::shared_ptr<impeller::AiksContext> GetOrCreateAiksContext(
+    const std::shared_ptr<impeller::Context>& context,
+    std::shared_ptr<impeller::AiksContext> aiks_context) {
+  if (aiks_context && aiks_context->GetContext() == context) {
+    return aiks_context;
+  }
+  return std::make_shared<impeller::AiksContext>(context);
+}
+
+GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(
+    GPUSurfaceMetalDelegate* delegate,
+    const std::shared_ptr<impeller::Context>& context,
+    std::shared_ptr<impeller::AiksContext> aiks_context)
     : delegate_(delegate),
       impeller_renderer_(CreateImpellerRenderer(context)),
-      aiks_context_(
-          std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr)) {}
+      aiks_context_(GetOrCreateAiksContext(impeller_renderer_ ? context : nullptr,
+                                           std::move(aiks_context))) {
+  // If this preference is explicitly set, we allow for disabling partial repaint.
+  NSNumber* disablePartialRepaint =
+      [[NSBundle mainBundle] objectForInfoDictionaryKey:@"FLTDisablePartialRepaint"];
+  if (disablePartialRepaint != nil) {
+    disable_partial_repaint_ = disablePartialRepaint.boolValue;
+  }
+  // Rendering into an offscreen texture costs a copy per frame, and so it can be disabled too.
+  NSNumber* disableDeferredDrawableAcquisition =
+      [[NSBundle mainBundle] objectForInfoDictionaryKey:@"FLTDisableDeferredDrawableAcquisition"];
+  if (disableDeferredDrawableAcquisition != nil) {
+    defer_drawable_acquisition_ = !disableDeferredDrawableAcquisition.boolValue;
+  }
+  // The surface data is read from the last drawable.
+  if (Settings::kSurfaceDataAccessible) {
+    defer_drawable_acquisition_ = false;
+  }
+}
 
 GPUSurfaceMetalImpeller::~GPUSurfaceMetalImpeller() = default;
 
@@ -59,48 +88,155 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrame(const SkISiz
 
   auto* mtl_layer = (CAMetalLayer*)layer;
 
-  auto surface = impeller::SurfaceMTL::WrapCurrentMetalLayerDrawable(
-      impeller_renderer_->GetContext(), mtl_layer);
-  if (Settings::kSurfaceDataAccessible) {
-    last_drawable_.reset([surface->drawable() retain]);
+  std::unique_ptr<impeller::SurfaceMTL> surface;
+  uintptr_t texture = 0;
+  if (defer_drawable_acquisition_) {
+    // Drawables are copied into, which framebuffer only drawables can't be.
+    if (mtl_layer.framebufferOnly) {
+      mtl_layer.framebufferOnly = NO;
+    }
+    if (!frame_pacer_) {
+      frame_pacer_ = impeller::FramePacerMTL::Create(
+          mtl_layer.device, impeller::Renderer::kDefaultMaxFramesInFlight);
+    }
+    // Bound the frames the GPU is behind by, rather than blocking on the next drawable.
+    if (frame_pacer_ && !frame_pacer_->WaitForFrameSlot()) {
+      FML_LOG(ERROR) << "Timed out waiting for the GPU to complete a frame.";
+    }
+    auto offscreen_texture = GetOffscreenTexture(mtl_layer);
+    if (!offscreen_texture) {
+      FML_LOG(ERROR) << "Could not create the offscreen texture for the CAMetalLayer.";
+      return nullptr;
+    }
+    surface = impeller::SurfaceMTL::WrapTextureForMetalLayer(
+        impeller_renderer_->GetContext(), offscreen_texture, mtl_layer, frame_pacer_);
+    if (!surface) {
+      FML_LOG(ERROR) << "Could not wrap the offscreen texture for the CAMetalLayer.";
+      return nullptr;
+    }
+    // The offscreen texture always holds the previous frame.
+    texture = reinterpret_cast<uintptr_t>(offscreen_texture.get());
+  } else {
+    surface = impeller::SurfaceMTL::WrapCurrentMetalLayerDrawable(impeller_renderer_->GetContext(),
+                                                                  mtl_layer);
+    if (!surface) {
+      FML_LOG(ERROR) << "Could not wrap the drawable of the CAMetalLayer.";
+      return nullptr;
+    }
+    if (Settings::kSurfaceDataAccessible) {
+      last_drawable_.reset([surface->drawable() retain]);
+    }
+
+    // The drawable textures are recycled by the layer. Their identity tells
+    // which previous frame the texture still holds.
+    id<CAMetalDrawable> metal_drawable =
+        reinterpret_cast<id<CAMetalDrawable>>(surface->drawable());
+    texture = reinterpret_cast<uintptr_t>(metal_drawable.texture);
   }
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([this,                                  //
+                         renderer = impeller_renderer_,         //
+                         aiks_context = aiks_context_,          //
+                         conversion_cache = conversion_cache_,  //
+                         surface = std::move(surface),          //
+                         texture                                //
   ](SurfaceFrame& surface_frame, SkCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
         }
 
+        std::optional<impeller::IRect> damage;
+        if (!disable_partial_repaint_) {
+          for (auto& entry : damage_) {
+            if (entry.first != texture) {
+              // Accumulate damage for other framebuffers
+              if (surface_frame.submit_info().frame_damage) {
+                entry.second.join(*surface_frame.submit_info().frame_damage);
+              }
+            }
+          }
+          // Reset accumulated damage for current framebuffer
+          damage_[texture] = SkIRect::MakeEmpty();
+
+          const auto& buffer_damage = surface_frame.submit_info().buffer_damage;
+          if (buffer_damage.has_value()) {
+            damage = impeller::IRect::MakeLTRB(buffer_damage->left(), buffer_damage->top(),
+                                               buffer_damage->right(), buffer_damage->bottom());
+          }
+        }
+
         auto display_list = surface_frame.BuildDisplayList();
         if (!display_list) {
           FML_LOG(ERROR) << "Could not build display list for surface frame.";
           return false;
         }
 
-        impeller::DisplayListDispatcher impeller_dispatcher;
+        impeller::DisplayListDispatcher impeller_dispatcher(
+            aiks_context->GetContext()->GetWorkQueue(), conversion_cache);
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        conversion_cache->EndFrame();
 
         return renderer->Render(
             std::move(surface),
-            fml::MakeCopyable([aiks_context, picture = std::move(picture)](
+            fml::MakeCopyable([aiks_context, picture = std::move(picture), damage](
                                   impeller::RenderTarget& render_target) -> bool {
-              return aiks_context->Render(picture, render_target);
+              return aiks_context->Render(picture, render_target, damage);
             }));
       });
 
-  return std::make_unique<SurfaceFrame>(nullptr,                          // surface
-                                        SurfaceFrame::FramebufferInfo{},  // framebuffer info
-                                        submit_callback,                  // submit callback
-                                        frame_info,                       // frame size
-                                        nullptr,                          // context result
-                                        true                              // display list fallback
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  if (!disable_partial_repaint_) {
+    // Provide accumulated damage to rasterizer (area in current framebuffer that lags behind
+    // front buffer)
+    auto i = damage_.find(texture);
+    if (i != damage_.end()) {
+      framebuffer_info.existing_damage = i->second;
+    }
+    framebuffer_info.supports_partial_repaint = true;
+  }
+
+  return std::make_unique<SurfaceFrame>(nullptr,           // surface
+                                        framebuffer_info,  // framebuffer info
+                                        submit_callback,   // submit callback
+                                        frame_info,        // frame size
+                                        nullptr,           // context result
+                                        true               // display list fallback
   );
 }
 
+std::shared_ptr<impeller::Texture> GPUSurfaceMetalImpeller::GetOffscreenTexture(
+    CAMetalLayer* layer) {
+  const auto format = impeller::FromMTLPixelFormat(layer.pixelFormat);
+  const impeller::ISize size(layer.drawableSize.width, layer.drawableSize.height);
+  if (offscreen_texture_) {
+    const auto& desc = offscreen_texture_->GetTextureDescriptor();
+    if (desc.format == format && desc.size == size) {
+      return offscreen_texture_;
+    }
+  }
+
+  // The previous texture may still be read by frames in flight, which keep it alive.
+  offscreen_texture_ = nullptr;
+  damage_.clear();
+  if (format == impeller::PixelFormat::kUnknown || size.IsEmpty()) {
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor desc;
+  desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  desc.format = format;
+  desc.size = size;
+  desc.usage = static_cast<impeller::TextureUsageMask>(impeller::TextureUsage::kRenderTarget);
+  offscreen_texture_ =
+      impeller_renderer_->GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  if (offscreen_texture_) {
+    offscreen_texture_->SetLabel("ImpellerOffscreenFrame");
+  }
+  return offscreen_texture_;
+}
+
 // |Surface|
 SkMatrix GPUSurfaceMetalImpeller::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -125,7 +261,7 @@ bool GPUSurfaceMetalImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceMetalImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
@@ -12,7 +12,8 @@
 namespace flutter {
 
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
-    std::shared_ptr<impeller::Context> context)
+    std::shared_ptr<impeller::Context> context,
+    std::shared_ptr<impeller::AiksContext> aiks_context)
     : weak_factory_(this) {
   if (!context || !context->IsValid()) {
     return;
@@ -23,7 +24,9 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
-  auto aiks_context = std::make_shared<impeller::AiksContext>(context);
+  if (!aiks_context || aiks_context->GetContext() != context) {
+    aiks_context = std::make_shared<impeller::AiksContext>(context);
+  }
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -68,9 +71,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
   };
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([renderer = impeller_renderer_,         //
+                         aiks_context = aiks_context_,          //
+                         conversion_cache = conversion_cache_,  //
+                         surface = std::move(surface)           //
   ](SurfaceFrame& surface_frame, SkCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -82,9 +86,11 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
           return false;
         }
 
-        impeller::DisplayListDispatcher impeller_dispatcher;
+        impeller::DisplayListDispatcher impeller_dispatcher(
+            aiks_context->GetContext()->GetWorkQueue(), conversion_cache);
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        conversion_cache->EndFrame();
 
         return renderer->Render(
             std::move(surface),
@@ -127,7 +133,7 @@ GPUSurfaceVulkanImpeller::MakeRenderContextCurrent() {
 
 // |Surface|
 bool GPUSurfaceVulkanImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
@@ -9,6 +9,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_conversion_cache.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
 
@@ -16,7 +17,14 @@ namespace flutter {
 
 class GPUSurfaceVulkanImpeller final : public Surface {
  public:
-  explicit GPUSurfaceVulkanImpeller(std::shared_ptr<impeller::Context> context);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that renders with the given Impeller
+  ///             context. If an Aiks context of the same Impeller context is
+  ///             given, it is used rather than a new one.
+  ///
+  explicit GPUSurfaceVulkanImpeller(
+      std::shared_ptr<impeller::Context> context,
+      std::shared_ptr<impeller::AiksContext> aiks_context = nullptr);
 
   // |Surface|
   ~GPUSurfaceVulkanImpeller() override;
@@ -28,6 +36,8 @@ class GPUSurfaceVulkanImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<impeller::DisplayListConversionCache> conversion_cache_ =
+      std::make_shared<impeller::DisplayListConversionCache>();
   bool is_valid_ = false;
   uint64_t frame_num_ = 0;
   fml::WeakPtrFactory<GPUSurfaceVulkanImpeller> weak_factory_;
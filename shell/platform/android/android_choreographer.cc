@@ -17,11 +17,94 @@ typedef void (*AChoreographer_postFrameCallback_FPN)(
     AChoreographer* choreographer,
     AChoreographer_frameCallback callback,
     void* data);
+// Only available on API 33+
+typedef void AChoreographerFrameCallbackData;
+typedef void (*AChoreographer_vsyncCallback)(
+    const AChoreographerFrameCallbackData* callback_data,
+    void* data);
+typedef int (*AChoreographer_postVsyncCallback_FPN)(
+    AChoreographer* choreographer,
+    AChoreographer_vsyncCallback callback,
+    void* data);
+typedef int64_t (*AChoreographerFrameCallbackData_getFrameTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef size_t (*AChoreographerFrameCallbackData_getFrameTimelinesLength_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef size_t (
+    *AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef int64_t (
+    *AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
+typedef int64_t (
+    *AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
 static AChoreographer_getInstance_FPN AChoreographer_getInstance;
 static AChoreographer_postFrameCallback_FPN AChoreographer_postFrameCallback;
+static AChoreographer_postVsyncCallback_FPN AChoreographer_postVsyncCallback;
+static AChoreographerFrameCallbackData_getFrameTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimeNanos;
+static AChoreographerFrameCallbackData_getFrameTimelinesLength_FPN
+    AChoreographerFrameCallbackData_getFrameTimelinesLength;
+static AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex;
+static AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos;
+static AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos;
 
 namespace flutter {
 
+namespace {
+
+// The callback of a |PostVsyncCallback| call.
+struct PendingVsyncCallback {
+  AndroidChoreographer::OnVsyncCallback callback;
+  void* data;
+};
+
+template <typename T>
+bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+             const char* name,
+             T* function) {
+  auto resolved = library->ResolveFunction<T>(name);
+  if (!resolved) {
+    return false;
+  }
+  *function = resolved.value();
+  return true;
+}
+
+void OnVsync(const AChoreographerFrameCallbackData* callback_data,
+             void* data) {
+  auto* pending = reinterpret_cast<PendingVsyncCallback*>(data);
+  AndroidChoreographer::VsyncData vsync_data;
+  vsync_data.frame_time_nanos =
+      AChoreographerFrameCallbackData_getFrameTimeNanos(callback_data);
+  const size_t length =
+      AChoreographerFrameCallbackData_getFrameTimelinesLength(callback_data);
+  vsync_data.frame_timelines.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    vsync_data.frame_timelines.push_back({
+        .expected_presentation_time_nanos =
+            AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos(
+                callback_data, i),
+        .deadline_nanos =
+            AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(
+                callback_data, i),
+    });
+  }
+  vsync_data.preferred_frame_timeline_index =
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(
+          callback_data);
+  pending->callback(vsync_data, pending->data);
+  delete pending;
+}
+
+}  // namespace
+
 bool AndroidChoreographer::ShouldUseNDKChoreographer() {
   static std::optional<bool> use_ndk_choreographer;
   if (use_ndk_choreographer) {
@@ -58,4 +141,46 @@ void AndroidChoreographer::PostFrameCallback(OnFrameCallback callback,
   AChoreographer_postFrameCallback(choreographer, callback, data);
 }
 
+bool AndroidChoreographer::SupportsFrameTimelines() {
+  static std::optional<bool> supports_frame_timelines;
+  if (supports_frame_timelines) {
+    return supports_frame_timelines.value();
+  }
+  if (!ShouldUseNDKChoreographer()) {
+    supports_frame_timelines = false;
+    return false;
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  supports_frame_timelines =
+      Resolve(libandroid, "AChoreographer_postVsyncCallback",
+              &AChoreographer_postVsyncCallback) &&
+      Resolve(libandroid, "AChoreographerFrameCallbackData_getFrameTimeNanos",
+              &AChoreographerFrameCallbackData_getFrameTimeNanos) &&
+      Resolve(libandroid,
+              "AChoreographerFrameCallbackData_getFrameTimelinesLength",
+              &AChoreographerFrameCallbackData_getFrameTimelinesLength) &&
+      Resolve(
+          libandroid,
+          "AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex",
+          &AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex) &&
+      Resolve(
+          libandroid,
+          "AChoreographerFrameCallbackData_"
+          "getFrameTimelineExpectedPresentationTimeNanos",
+          &AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos) &&
+      Resolve(libandroid,
+              "AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos",
+              &AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos);
+  return supports_frame_timelines.value();
+}
+
+void AndroidChoreographer::PostVsyncCallback(OnVsyncCallback callback,
+                                             void* data) {
+  FML_DCHECK(SupportsFrameTimelines());
+  AChoreographer* choreographer = AChoreographer_getInstance();
+  AChoreographer_postVsyncCallback(
+      choreographer, &OnVsync, new PendingVsyncCallback{callback, data});
+}
+
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include "flutter/fml/macros.h"
 
 #include <cstdint>
+#include <vector>
 
 namespace flutter {
 
@@ -18,10 +19,34 @@ namespace flutter {
 ///
 class AndroidChoreographer {
  public:
+  // A possible presentation of the frame that starts at a vsync.
+  struct FrameTimeline {
+    // When the frame is expected to be presented.
+    int64_t expected_presentation_time_nanos;
+    // When the frame has to be submitted to be presented at
+    // |expected_presentation_time_nanos|.
+    int64_t deadline_nanos;
+  };
+
+  struct VsyncData {
+    int64_t frame_time_nanos;
+    // Sorted by their presentation time.
+    std::vector<FrameTimeline> frame_timelines;
+    // The index of the timeline the system would pick for the frame.
+    size_t preferred_frame_timeline_index;
+  };
+
   typedef void (*OnFrameCallback)(int64_t frame_time_nanos, void* data);
+  typedef void (*OnVsyncCallback)(const VsyncData& vsync_data, void* data);
   static bool ShouldUseNDKChoreographer();
   static void PostFrameCallback(OnFrameCallback callback, void* data);
 
+  // Whether |PostVsyncCallback| can be used. Only available on API 33+.
+  static bool SupportsFrameTimelines();
+  // Like |PostFrameCallback|, but also reports the frame timelines of the
+  // vsync.
+  static void PostVsyncCallback(OnVsyncCallback callback, void* data);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidChoreographer);
 };
 
@@ -5,11 +5,26 @@
 #ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_IMPELLER_H_
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_IMPELLER_H_
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/renderer/context.h"
+#include "flutter/impeller/toolkit/egl/context.h"
+#include "flutter/impeller/toolkit/egl/display.h"
+#include "flutter/impeller/toolkit/egl/surface.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Holds the EGL contexts and the Impeller context that are shared
+///             by the surfaces of a platform view, and by the platform views
+///             of the shells spawned from it. Spawned shells use the same
+///             raster and IO threads, so the onscreen context is only made
+///             current on the raster thread and the resource context on the
+///             IO thread.
+///
 class AndroidContextGLImpeller : public AndroidContext {
  public:
   AndroidContextGLImpeller();
@@ -19,7 +34,46 @@ class AndroidContextGLImpeller : public AndroidContext {
   // |AndroidContext|
   bool IsValid() const override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface for the window that the onscreen context
+  ///             can be made current with.
+  ///
+  std::unique_ptr<impeller::egl::Surface> CreateOnscreenSurface(
+      EGLNativeWindowType window);
+
+  bool OnscreenContextMakeCurrent(impeller::egl::Surface* onscreen_surface);
+
+  bool OnscreenContextClearCurrent();
+
+  bool ResourceContextMakeCurrent();
+
+  bool ResourceContextClearCurrent();
+
+  std::shared_ptr<impeller::Context> GetImpellerContext() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the Aiks context of the Impeller context, which holds
+  ///             the pipeline variants, the glyph atlas and the render target
+  ///             caches. It is created by the first surface that asks for it
+  ///             and then shared by all of them. Must be called on the raster
+  ///             thread.
+  ///
+  std::shared_ptr<impeller::AiksContext> GetAiksContext();
+
  private:
+  class ReactorWorker;
+
+  std::shared_ptr<ReactorWorker> reactor_worker_;
+  std::unique_ptr<impeller::egl::Display> display_;
+  std::unique_ptr<impeller::egl::Config> onscreen_config_;
+  std::unique_ptr<impeller::egl::Config> offscreen_config_;
+  std::unique_ptr<impeller::egl::Surface> offscreen_surface_;
+  std::unique_ptr<impeller::egl::Context> onscreen_context_;
+  std::unique_ptr<impeller::egl::Context> offscreen_context_;
+  std::shared_ptr<impeller::Context> impeller_context_;
+  std::shared_ptr<impeller::AiksContext> aiks_context_;
+  bool is_valid_ = false;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextGLImpeller);
 };
 
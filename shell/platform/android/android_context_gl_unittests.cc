@@ -2,9 +2,11 @@
 
 #include <memory>
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/platform/android/android_context_gl_impeller.h"
 #include "flutter/shell/platform/android/android_context_gl_skia.h"
 #include "flutter/shell/platform/android/android_egl_surface.h"
 #include "flutter/shell/platform/android/android_environment_gl.h"
+#include "flutter/shell/platform/android/android_surface_gl_impeller.h"
 #include "flutter/shell/platform/android/android_surface_gl_skia.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "gmock/gmock.h"
@@ -38,6 +40,11 @@ class MockPlatformViewAndroidJNI : public PlatformViewAndroidJNI {
                void(JavaLocalRef surface_texture, SkMatrix& transform));
   MOCK_METHOD1(SurfaceTextureDetachFromGLContext,
                void(JavaLocalRef surface_texture));
+  MOCK_METHOD1(ImageTextureEntryAcquireLatestImage,
+               JavaLocalRef(JavaLocalRef image_texture_entry));
+  MOCK_METHOD1(ImageGetHardwareBuffer, JavaLocalRef(JavaLocalRef image));
+  MOCK_METHOD1(ImageClose, void(JavaLocalRef image));
+  MOCK_METHOD1(HardwareBufferClose, void(JavaLocalRef hardware_buffer));
   MOCK_METHOD8(FlutterViewOnDisplayPlatformView,
                void(int view_id,
                     int x,
@@ -210,6 +217,47 @@ TEST(AndroidContextGl, EnsureMakeCurrentChecksCurrentContextStatus) {
   status = pbuffer_surface->MakeCurrent();
   EXPECT_EQ(AndroidEGLSurfaceMakeCurrentStatus::kSuccessAlreadyCurrent, status);
 }
+
+TEST(AndroidContextGLImpeller, SharesOneAiksContext) {
+  auto context = std::make_unique<AndroidContextGLImpeller>();
+  if (!context->IsValid()) {
+    GTEST_SKIP() << "Impeller requires OpenGL ES 3.0 or above.";
+  }
+  ASSERT_NE(context->GetImpellerContext(), nullptr);
+  auto aiks_context = context->GetAiksContext();
+  ASSERT_NE(aiks_context, nullptr);
+  EXPECT_EQ(aiks_context->GetContext(), context->GetImpellerContext());
+  EXPECT_EQ(context->GetAiksContext(), aiks_context);
+}
+
+TEST(AndroidContextGLImpeller, SurfacesShareTheContextsOfTheirAndroidContext) {
+  auto android_context = std::make_shared<AndroidContextGLImpeller>();
+  if (!android_context->IsValid()) {
+    GTEST_SKIP() << "Impeller requires OpenGL ES 3.0 or above.";
+  }
+  auto jni = std::make_shared<MockPlatformViewAndroidJNI>();
+  // A spawned platform view creates its surface with the Android context of
+  // the platform view it was spawned from.
+  auto surface =
+      std::make_unique<AndroidSurfaceGLImpeller>(android_context, jni);
+  auto spawned_surface =
+      std::make_unique<AndroidSurfaceGLImpeller>(android_context, jni);
+  ASSERT_TRUE(surface->IsValid());
+  ASSERT_TRUE(spawned_surface->IsValid());
+  EXPECT_EQ(surface->GetImpellerContext(),
+            android_context->GetImpellerContext());
+  EXPECT_EQ(spawned_surface->GetImpellerContext(),
+            android_context->GetImpellerContext());
+
+  auto gpu_surface = surface->CreateGPUSurface(nullptr);
+  auto spawned_gpu_surface = spawned_surface->CreateGPUSurface(nullptr);
+  ASSERT_NE(gpu_surface, nullptr);
+  ASSERT_NE(spawned_gpu_surface, nullptr);
+  EXPECT_EQ(gpu_surface->GetAiksContext(),
+            android_context->GetAiksContext().get());
+  EXPECT_EQ(spawned_gpu_surface->GetAiksContext(),
+            gpu_surface->GetAiksContext());
+}
 }  // namespace android
 }  // namespace testing
 }  // namespace flutter
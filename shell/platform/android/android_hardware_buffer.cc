@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_hardware_buffer.h"
+
+#include <optional>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+
+// Only available on API 26+
+typedef AHardwareBuffer* (*AHardwareBuffer_fromHardwareBuffer_FPN)(
+    JNIEnv* env,
+    jobject hardware_buffer);
+typedef int (*AHardwareBuffer_allocate_FPN)(const AHardwareBuffer_Desc* desc,
+                                            AHardwareBuffer** out_buffer);
+typedef void (*AHardwareBuffer_acquire_FPN)(AHardwareBuffer* buffer);
+typedef void (*AHardwareBuffer_release_FPN)(AHardwareBuffer* buffer);
+typedef void (*AHardwareBuffer_describe_FPN)(const AHardwareBuffer* buffer,
+                                             AHardwareBuffer_Desc* desc);
+static AHardwareBuffer_fromHardwareBuffer_FPN
+    AHardwareBuffer_fromHardwareBuffer_fn;
+static AHardwareBuffer_allocate_FPN AHardwareBuffer_allocate_fn;
+static AHardwareBuffer_acquire_FPN AHardwareBuffer_acquire_fn;
+static AHardwareBuffer_release_FPN AHardwareBuffer_release_fn;
+static AHardwareBuffer_describe_FPN AHardwareBuffer_describe_fn;
+
+namespace flutter {
+
+bool AndroidHardwareBuffer::IsAvailable() {
+  static std::optional<bool> is_available;
+  if (is_available) {
+    return is_available.value();
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  auto from_hardware_buffer_fn =
+      libandroid->ResolveFunction<AHardwareBuffer_fromHardwareBuffer_FPN>(
+          "AHardwareBuffer_fromHardwareBuffer");
+  auto allocate_fn = libandroid->ResolveFunction<AHardwareBuffer_allocate_FPN>(
+      "AHardwareBuffer_allocate");
+  auto acquire_fn = libandroid->ResolveFunction<AHardwareBuffer_acquire_FPN>(
+      "AHardwareBuffer_acquire");
+  auto release_fn = libandroid->ResolveFunction<AHardwareBuffer_release_FPN>(
+      "AHardwareBuffer_release");
+  auto describe_fn = libandroid->ResolveFunction<AHardwareBuffer_describe_FPN>(
+      "AHardwareBuffer_describe");
+  if (from_hardware_buffer_fn && allocate_fn && acquire_fn && release_fn &&
+      describe_fn) {
+    AHardwareBuffer_fromHardwareBuffer_fn = from_hardware_buffer_fn.value();
+    AHardwareBuffer_allocate_fn = allocate_fn.value();
+    AHardwareBuffer_acquire_fn = acquire_fn.value();
+    AHardwareBuffer_release_fn = release_fn.value();
+    AHardwareBuffer_describe_fn = describe_fn.value();
+    is_available = true;
+  } else {
+    is_available = false;
+  }
+  return is_available.value();
+}
+
+AHardwareBuffer* AndroidHardwareBuffer::FromHardwareBuffer(
+    JNIEnv* env,
+    jobject hardware_buffer) {
+  FML_DCHECK(IsAvailable());
+  return AHardwareBuffer_fromHardwareBuffer_fn(env, hardware_buffer);
+}
+
+AHardwareBuffer* AndroidHardwareBuffer::Allocate(
+    const AHardwareBuffer_Desc& desc) {
+  FML_DCHECK(IsAvailable());
+  AHardwareBuffer* buffer = nullptr;
+  if (AHardwareBuffer_allocate_fn(&desc, &buffer) != 0) {
+    return nullptr;
+  }
+  return buffer;
+}
+
+void AndroidHardwareBuffer::Acquire(AHardwareBuffer* buffer) {
+  FML_DCHECK(IsAvailable());
+  AHardwareBuffer_acquire_fn(buffer);
+}
+
+void AndroidHardwareBuffer::Release(AHardwareBuffer* buffer) {
+  FML_DCHECK(IsAvailable());
+  AHardwareBuffer_release_fn(buffer);
+}
+
+void AndroidHardwareBuffer::Describe(const AHardwareBuffer* buffer,
+                                     AHardwareBuffer_Desc* desc) {
+  FML_DCHECK(IsAvailable());
+  AHardwareBuffer_describe_fn(buffer, desc);
+}
+
+}  // namespace flutter
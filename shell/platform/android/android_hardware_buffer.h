@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_BUFFER_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_BUFFER_H_
+
+#include <android/hardware_buffer.h>
+#include <jni.h>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The NDK's AHardwareBuffer functions, used by image textures to import the
+/// buffers of `android.media.Image`s without copies, and by the SurfaceControl
+/// overlays of platform views. They are only available on API 26+ and are
+/// looked up at runtime.
+///
+class AndroidHardwareBuffer {
+ public:
+  static bool IsAvailable();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the AHardwareBuffer of an
+  ///             `android.hardware.HardwareBuffer`. The buffer is only valid
+  ///             as long as the Java object is, unless it is acquired.
+  ///
+  static AHardwareBuffer* FromHardwareBuffer(JNIEnv* env,
+                                             jobject hardware_buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates a buffer matching |desc|, with a reference owned by
+  ///             the caller. Returns nullptr on failure.
+  ///
+  static AHardwareBuffer* Allocate(const AHardwareBuffer_Desc& desc);
+
+  static void Acquire(AHardwareBuffer* buffer);
+
+  static void Release(AHardwareBuffer* buffer);
+
+  static void Describe(const AHardwareBuffer* buffer,
+                       AHardwareBuffer_Desc* desc);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidHardwareBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_BUFFER_H_
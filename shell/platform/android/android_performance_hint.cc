@@ -0,0 +1,205 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_performance_hint.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/trace_event.h"
+
+struct APerformanceHintManager;
+
+namespace flutter {
+
+namespace {
+
+// The performance hint API is only in the NDK headers from API 33 on.
+using APerformanceHint_getManager_FPN = APerformanceHintManager* (*)();
+using APerformanceHint_createSession_FPN =
+    APerformanceHintSession* (*)(APerformanceHintManager* manager,
+                                 const int32_t* thread_ids,
+                                 size_t size,
+                                 int64_t initial_target_work_duration_nanos);
+using APerformanceHint_updateTargetWorkDuration_FPN =
+    int (*)(APerformanceHintSession* session,
+            int64_t target_duration_nanos);
+using APerformanceHint_reportActualWorkDuration_FPN =
+    int (*)(APerformanceHintSession* session, int64_t actual_duration_nanos);
+using APerformanceHint_closeSession_FPN =
+    void (*)(APerformanceHintSession* session);
+
+struct PerformanceHintFunctions {
+  APerformanceHint_getManager_FPN get_manager = nullptr;
+  APerformanceHint_createSession_FPN create_session = nullptr;
+  APerformanceHint_updateTargetWorkDuration_FPN update_target = nullptr;
+  APerformanceHint_reportActualWorkDuration_FPN report_actual = nullptr;
+  APerformanceHint_closeSession_FPN close_session = nullptr;
+
+  bool IsValid() const {
+    return get_manager && create_session && update_target && report_actual &&
+           close_session;
+  }
+};
+
+const PerformanceHintFunctions& GetPerformanceHintFunctions() {
+  static PerformanceHintFunctions functions = []() {
+    PerformanceHintFunctions functions;
+    auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+    FML_DCHECK(libandroid);
+    functions.get_manager =
+        libandroid
+            ->ResolveFunction<APerformanceHint_getManager_FPN>(
+                "APerformanceHint_getManager")
+            .value_or(nullptr);
+    functions.create_session =
+        libandroid
+            ->ResolveFunction<APerformanceHint_createSession_FPN>(
+                "APerformanceHint_createSession")
+            .value_or(nullptr);
+    functions.update_target =
+        libandroid
+            ->ResolveFunction<APerformanceHint_updateTargetWorkDuration_FPN>(
+                "APerformanceHint_updateTargetWorkDuration")
+            .value_or(nullptr);
+    functions.report_actual =
+        libandroid
+            ->ResolveFunction<APerformanceHint_reportActualWorkDuration_FPN>(
+                "APerformanceHint_reportActualWorkDuration")
+            .value_or(nullptr);
+    functions.close_session =
+        libandroid
+            ->ResolveFunction<APerformanceHint_closeSession_FPN>(
+                "APerformanceHint_closeSession")
+            .value_or(nullptr);
+    return functions;
+  }();
+  return functions;
+}
+
+// From include/uapi/linux/sched/types.h, which bionic doesn't export.
+struct SchedAttr {
+  uint32_t size;
+  uint32_t sched_policy;
+  uint64_t sched_flags;
+  int32_t sched_nice;
+  uint32_t sched_priority;
+  uint64_t sched_runtime;
+  uint64_t sched_deadline;
+  uint64_t sched_period;
+  uint32_t sched_util_min;
+  uint32_t sched_util_max;
+};
+
+constexpr uint64_t kSchedFlagKeepPolicy = 0x08;
+constexpr uint64_t kSchedFlagKeepParams = 0x10;
+constexpr uint64_t kSchedFlagUtilClampMin = 0x20;
+
+bool SetMinimumUtilization(int32_t thread_id, uint32_t utilization) {
+  SchedAttr attr = {};
+  attr.size = sizeof(SchedAttr);
+  attr.sched_flags =
+      kSchedFlagKeepPolicy | kSchedFlagKeepParams | kSchedFlagUtilClampMin;
+  attr.sched_util_min = utilization;
+  return ::syscall(__NR_sched_setattr, thread_id, &attr, 0) == 0;
+}
+
+}  // namespace
+
+AndroidPerformanceHint::AndroidPerformanceHint(std::vector<int32_t> thread_ids,
+                                               fml::TimeDelta target)
+    : thread_ids_(std::move(thread_ids)), target_(target) {
+  const PerformanceHintFunctions& functions = GetPerformanceHintFunctions();
+  if (!functions.IsValid()) {
+    return;
+  }
+  APerformanceHintManager* manager = functions.get_manager();
+  if (manager == nullptr) {
+    return;
+  }
+  session_ = functions.create_session(manager, thread_ids_.data(),
+                                      thread_ids_.size(),
+                                      target_.ToNanoseconds());
+  if (session_ == nullptr) {
+    FML_DLOG(INFO) << "Could not create a performance hint session.";
+  }
+}
+
+AndroidPerformanceHint::~AndroidPerformanceHint() {
+  if (session_ != nullptr) {
+    GetPerformanceHintFunctions().close_session(session_);
+  }
+  SetBoosted(false);
+}
+
+void AndroidPerformanceHint::ReportFrame(const FrameTiming& timing) {
+  const fml::TimeDelta target = timing.GetVsyncInterval() > fml::TimeDelta()
+                                    ? timing.GetVsyncInterval()
+                                    : target_;
+  const fml::TimeDelta build_duration =
+      timing.Get(FrameTiming::kBuildFinish) -
+      timing.Get(FrameTiming::kBuildStart);
+  const fml::TimeDelta raster_duration =
+      timing.Get(FrameTiming::kRasterFinish) -
+      timing.Get(FrameTiming::kRasterStart);
+  const fml::TimeDelta work_duration =
+      std::max(build_duration, raster_duration);
+  TraceFrame(work_duration, target);
+
+  if (session_ != nullptr) {
+    const PerformanceHintFunctions& functions = GetPerformanceHintFunctions();
+    if (target != target_) {
+      target_ = target;
+      functions.update_target(session_, target_.ToNanoseconds());
+    }
+    functions.report_actual(session_, work_duration.ToNanoseconds());
+    return;
+  }
+
+  target_ = target;
+  if (work_duration > target_) {
+    relaxed_frame_count_ = 0u;
+    SetBoosted(true);
+  } else if (boosted_ && work_duration * 4 < target_ * 3 &&
+             ++relaxed_frame_count_ >= kRelaxFrameCount) {
+    SetBoosted(false);
+  }
+}
+
+void AndroidPerformanceHint::TraceFrame(fml::TimeDelta work_duration,
+                                        fml::TimeDelta target) const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "AndroidPerformanceHint",
+                    reinterpret_cast<int64_t>(this),  //
+                    "ActualMicros", work_duration.ToMicroseconds(),
+                    "TargetMicros", target.ToMicroseconds());
+#endif  // !FLUTTER_RELEASE
+}
+
+void AndroidPerformanceHint::SetBoosted(bool boosted) {
+  if (boosted == boosted_) {
+    return;
+  }
+  TRACE_EVENT1("flutter", "AndroidPerformanceHint::SetBoosted", "boosted",
+               boosted ? "true" : "false");
+  boosted_ = boosted;
+  relaxed_frame_count_ = 0u;
+  for (int32_t thread_id : thread_ids_) {
+    if (!SetMinimumUtilization(thread_id,
+                               boosted ? kBoostedUtilization : 0u)) {
+      // Kernels without utilization clamping, and apps that aren't allowed to
+      // clamp, refuse every thread.
+      FML_DLOG(INFO) << "Could not clamp the utilization of thread "
+                     << thread_id;
+      break;
+    }
+  }
+}
+
+}  // namespace flutter
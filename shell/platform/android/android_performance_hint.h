@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+struct APerformanceHintSession;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Gives the UI and raster threads more CPU time while their frames miss
+/// their targets.
+///
+/// On API 33 and above, the duration of every frame is reported to a
+/// performance hint session, which lets the system pick the cores and their
+/// clocks for the threads. On older versions, the minimum utilization of the
+/// threads is clamped up while frames miss their targets, which places them
+/// on faster cores on kernels that support utilization clamping.
+///
+class AndroidPerformanceHint {
+ public:
+  /// The minimum utilization, out of 1024, of the threads while they are
+  /// boosted.
+  static constexpr uint32_t kBoostedUtilization = 768u;
+
+  /// The number of frames that must meet their target in a row before the
+  /// threads stop being boosted.
+  static constexpr size_t kRelaxFrameCount = 30u;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  thread_ids  The ids of the threads that work on frames.
+  /// @param[in]  target      The target duration of their work on a frame
+  ///                         until a frame with a vsync interval is reported.
+  ///
+  AndroidPerformanceHint(std::vector<int32_t> thread_ids,
+                         fml::TimeDelta target);
+
+  ~AndroidPerformanceHint();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the work done on a frame. Must be called on the
+  ///             raster thread.
+  ///
+  ///             The work on the frame must fit in its vsync interval on each
+  ///             thread, as the threads work on different frames at the same
+  ///             time.
+  ///
+  /// @param[in]  timing  The timing of the frame.
+  ///
+  void ReportFrame(const FrameTiming& timing);
+
+ private:
+  std::vector<int32_t> thread_ids_;
+  APerformanceHintSession* session_ = nullptr;
+  fml::TimeDelta target_;
+  bool boosted_ = false;
+  size_t relaxed_frame_count_ = 0u;
+
+  // Traces the reported durations, so that they can be checked against the
+  // work seen in the timeline.
+  void TraceFrame(fml::TimeDelta work_duration, fml::TimeDelta target) const;
+
+  void SetBoosted(bool boosted);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidPerformanceHint);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
@@ -16,17 +16,21 @@
 #include <string>
 #include <utility>
 
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/android/android_display.h"
 #include "flutter/shell/platform/android/android_image_generator.h"
+#include "flutter/shell/platform/android/android_performance_hint.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
 
@@ -71,6 +75,47 @@ static void AndroidPlatformThreadConfigSetter(
       }
   }
 }
+
+/// Also keeps the threads that work on frames on the fastest cores, and the
+/// other threads off them.
+static void AndroidPlacedThreadConfigSetter(
+    const fml::Thread::ThreadConfig& config) {
+  AndroidPlatformThreadConfigSetter(config);
+  switch (config.priority) {
+    case fml::Thread::ThreadPriority::DISPLAY:
+    case fml::Thread::ThreadPriority::RASTER:
+      fml::RequestAffinity(fml::CpuAffinity::kPerformance);
+      break;
+    default:
+      fml::RequestAffinity(fml::CpuAffinity::kNotPerformance);
+      break;
+  }
+}
+
+static std::vector<int32_t> GetThreadIds(
+    const std::vector<fml::RefPtr<fml::TaskRunner>>& task_runners) {
+  std::vector<int32_t> thread_ids(task_runners.size());
+  fml::CountDownLatch latch(task_runners.size());
+  for (size_t i = 0; i < task_runners.size(); i++) {
+    task_runners[i]->PostTask([&thread_ids, &latch, i]() {
+      thread_ids[i] = gettid();
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  return thread_ids;
+}
+
+// The duration the work on a frame must fit in on each thread to keep up with
+// the display, until the frames tell their vsync interval.
+static fml::TimeDelta GetFrameTarget(const AndroidDisplay& display) {
+  const double refresh_rate = display.GetRefreshRate();
+  return fml::TimeDelta::FromMillisecondsF(
+      (refresh_rate > 0.0 ? fml::RefreshRateToFrameBudget(refresh_rate)
+                          : fml::kDefaultFrameBudget)
+          .count());
+}
+
 static PlatformData GetDefaultPlatformData() {
   PlatformData platform_data;
   platform_data.lifecycle_state = "AppLifecycleState.detached";
@@ -88,7 +133,9 @@ AndroidShellHolder::AndroidShellHolder(
       ThreadHost::Type::UI | ThreadHost::Type::RASTER | ThreadHost::Type::IO;
 
   flutter::ThreadHost::ThreadHostConfig host_config(
-      thread_label, mask, AndroidPlatformThreadConfigSetter);
+      thread_label, mask,
+      settings_.enable_thread_placement ? AndroidPlacedThreadConfigSetter
+                                        : AndroidPlatformThreadConfigSetter);
   host_config.ui_config = fml::Thread::ThreadConfig(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
           flutter::ThreadHost::Type::UI, thread_label),
@@ -147,10 +194,25 @@ AndroidShellHolder::AndroidShellHolder(
                                     io_runner         // io
   );
 
+  Settings shell_settings = settings_;
+  if (settings_.enable_performance_hints) {
+    auto performance_hint = std::make_shared<AndroidPerformanceHint>(
+        GetThreadIds({ui_runner, raster_runner}),
+        GetFrameTarget(AndroidDisplay(jni_facade)));
+    shell_settings.frame_rasterized_callback =
+        [callback = settings_.frame_rasterized_callback,
+         performance_hint](const FrameTiming& timing) {
+          if (callback) {
+            callback(timing);
+          }
+          performance_hint->ReportFrame(timing);
+        };
+  }
+
   shell_ =
       Shell::Create(GetDefaultPlatformData(),  // window data
                     task_runners,              // task runners
-                    settings_,                 // settings
+                    shell_settings,            // settings
                     on_create_platform_view,   // platform view create callback
                     on_create_rasterizer       // rasterizer create callback
       );
@@ -311,6 +373,11 @@ void AndroidShellHolder::NotifyLowMemoryWarning() {
   shell_->NotifyLowMemoryWarning();
 }
 
+void AndroidShellHolder::NotifyMemoryPressure(MemoryPressureLevel level) {
+  FML_DCHECK(shell_);
+  shell_->NotifyMemoryPressure(level);
+}
+
 std::optional<RunConfiguration> AndroidShellHolder::BuildRunConfiguration(
     const std::string& entrypoint,
     const std::string& libraryUrl,
@@ -331,6 +398,13 @@ std::optional<RunConfiguration> AndroidShellHolder::BuildRunConfiguration(
   }
 
   RunConfiguration config(std::move(isolate_configuration));
+  // Assets in a packed archive are resolved before the loose assets of the
+  // APK. Archives stored uncompressed are mapped without a copy.
+  if (std::shared_ptr<fml::Mapping> archive =
+          apk_asset_provider_->GetAsMapping(PackedAssetBundle::kArchiveName)) {
+    config.AddAssetResolver(
+        std::make_unique<PackedAssetBundle>(std::move(archive), true));
+  }
   config.AddAssetResolver(apk_asset_provider_->Clone());
 
   {
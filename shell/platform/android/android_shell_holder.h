@@ -98,6 +98,8 @@ class AndroidShellHolder {
 
   void NotifyLowMemoryWarning();
 
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
   const std::shared_ptr<PlatformMessageHandler>& GetPlatformMessageHandler()
       const {
     return shell_->GetPlatformMessageHandler();
@@ -30,6 +30,11 @@ class MockPlatformViewAndroidJNI : public PlatformViewAndroidJNI {
                void(JavaLocalRef surface_texture, SkMatrix& transform));
   MOCK_METHOD1(SurfaceTextureDetachFromGLContext,
                void(JavaLocalRef surface_texture));
+  MOCK_METHOD1(ImageTextureEntryAcquireLatestImage,
+               JavaLocalRef(JavaLocalRef image_texture_entry));
+  MOCK_METHOD1(ImageGetHardwareBuffer, JavaLocalRef(JavaLocalRef image));
+  MOCK_METHOD1(ImageClose, void(JavaLocalRef image));
+  MOCK_METHOD1(HardwareBufferClose, void(JavaLocalRef hardware_buffer));
   MOCK_METHOD8(FlutterViewOnDisplayPlatformView,
                void(int view_id,
                     int x,
@@ -0,0 +1,192 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_surface_control.h"
+
+#include <optional>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+
+// Only available on API 29+
+typedef ASurfaceControl* (*ASurfaceControl_createFromWindow_FPN)(
+    ANativeWindow* parent,
+    const char* debug_name);
+typedef void (*ASurfaceControl_release_FPN)(ASurfaceControl* surface_control);
+typedef ASurfaceTransaction* (*ASurfaceTransaction_create_FPN)();
+typedef void (*ASurfaceTransaction_delete_FPN)(
+    ASurfaceTransaction* transaction);
+typedef void (*ASurfaceTransaction_apply_FPN)(ASurfaceTransaction* transaction);
+typedef void (*ASurfaceTransaction_setBuffer_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    AHardwareBuffer* buffer,
+    int acquire_fence_fd);
+typedef void (*ASurfaceTransaction_setVisibility_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    int8_t visibility);
+typedef void (*ASurfaceTransaction_setZOrder_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    int32_t z_order);
+typedef void (*ASurfaceTransaction_setGeometry_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* surface_control,
+    const ARect& source,
+    const ARect& destination,
+    int32_t transform);
+typedef void (*ASurfaceTransaction_setOnComplete_FPN)(
+    ASurfaceTransaction* transaction,
+    void* context,
+    void (*func)(void* context, ASurfaceTransactionStats* stats));
+typedef int (*ASurfaceTransactionStats_getPreviousReleaseFenceFd_FPN)(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control);
+static ASurfaceControl_createFromWindow_FPN ASurfaceControl_createFromWindow_fn;
+static ASurfaceControl_release_FPN ASurfaceControl_release_fn;
+static ASurfaceTransaction_create_FPN ASurfaceTransaction_create_fn;
+static ASurfaceTransaction_delete_FPN ASurfaceTransaction_delete_fn;
+static ASurfaceTransaction_apply_FPN ASurfaceTransaction_apply_fn;
+static ASurfaceTransaction_setBuffer_FPN ASurfaceTransaction_setBuffer_fn;
+static ASurfaceTransaction_setVisibility_FPN
+    ASurfaceTransaction_setVisibility_fn;
+static ASurfaceTransaction_setZOrder_FPN ASurfaceTransaction_setZOrder_fn;
+static ASurfaceTransaction_setGeometry_FPN ASurfaceTransaction_setGeometry_fn;
+static ASurfaceTransaction_setOnComplete_FPN
+    ASurfaceTransaction_setOnComplete_fn;
+static ASurfaceTransactionStats_getPreviousReleaseFenceFd_FPN
+    ASurfaceTransactionStats_getPreviousReleaseFenceFd_fn;
+
+// ASURFACE_TRANSACTION_VISIBILITY_HIDE and
+// ASURFACE_TRANSACTION_VISIBILITY_SHOW.
+static constexpr int8_t kVisibilityHide = 0;
+static constexpr int8_t kVisibilityShow = 1;
+
+namespace flutter {
+
+template <typename T>
+static bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+                    const char* name,
+                    T* function) {
+  auto resolved = library->ResolveFunction<T>(name);
+  if (!resolved) {
+    return false;
+  }
+  *function = resolved.value();
+  return true;
+}
+
+bool AndroidSurfaceControl::IsAvailable() {
+  static std::optional<bool> is_available;
+  if (is_available) {
+    return is_available.value();
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  is_available =
+      Resolve(libandroid, "ASurfaceControl_createFromWindow",
+              &ASurfaceControl_createFromWindow_fn) &&
+      Resolve(libandroid, "ASurfaceControl_release",
+              &ASurfaceControl_release_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_create",
+              &ASurfaceTransaction_create_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_delete",
+              &ASurfaceTransaction_delete_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_apply",
+              &ASurfaceTransaction_apply_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_setBuffer",
+              &ASurfaceTransaction_setBuffer_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_setVisibility",
+              &ASurfaceTransaction_setVisibility_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_setZOrder",
+              &ASurfaceTransaction_setZOrder_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_setGeometry",
+              &ASurfaceTransaction_setGeometry_fn) &&
+      Resolve(libandroid, "ASurfaceTransaction_setOnComplete",
+              &ASurfaceTransaction_setOnComplete_fn) &&
+      Resolve(libandroid, "ASurfaceTransactionStats_getPreviousReleaseFenceFd",
+              &ASurfaceTransactionStats_getPreviousReleaseFenceFd_fn);
+  return is_available.value();
+}
+
+ASurfaceControl* AndroidSurfaceControl::CreateFromWindow(
+    ANativeWindow* parent,
+    const char* debug_name) {
+  FML_DCHECK(IsAvailable());
+  return ASurfaceControl_createFromWindow_fn(parent, debug_name);
+}
+
+void AndroidSurfaceControl::Release(ASurfaceControl* surface_control) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceControl_release_fn(surface_control);
+}
+
+ASurfaceTransaction* AndroidSurfaceControl::CreateTransaction() {
+  FML_DCHECK(IsAvailable());
+  return ASurfaceTransaction_create_fn();
+}
+
+void AndroidSurfaceControl::DeleteTransaction(
+    ASurfaceTransaction* transaction) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceTransaction_delete_fn(transaction);
+}
+
+void AndroidSurfaceControl::ApplyTransaction(ASurfaceTransaction* transaction) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceTransaction_apply_fn(transaction);
+}
+
+void AndroidSurfaceControl::SetBuffer(ASurfaceTransaction* transaction,
+                                      ASurfaceControl* surface_control,
+                                      AHardwareBuffer* buffer,
+                                      int acquire_fence) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceTransaction_setBuffer_fn(transaction, surface_control, buffer,
+                                   acquire_fence);
+}
+
+void AndroidSurfaceControl::SetVisibility(ASurfaceTransaction* transaction,
+                                          ASurfaceControl* surface_control,
+                                          bool visible) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceTransaction_setVisibility_fn(
+      transaction, surface_control,
+      visible ? kVisibilityShow : kVisibilityHide);
+}
+
+void AndroidSurfaceControl::SetZOrder(ASurfaceTransaction* transaction,
+                                      ASurfaceControl* surface_control,
+                                      int32_t z_order) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceTransaction_setZOrder_fn(transaction, surface_control, z_order);
+}
+
+void AndroidSurfaceControl::SetGeometry(ASurfaceTransaction* transaction,
+                                        ASurfaceControl* surface_control,
+                                        const ARect& source,
+                                        const ARect& destination) {
+  FML_DCHECK(IsAvailable());
+  // ANATIVEWINDOW_TRANSFORM_IDENTITY
+  ASurfaceTransaction_setGeometry_fn(transaction, surface_control, source,
+                                     destination, /*transform=*/0);
+}
+
+void AndroidSurfaceControl::SetOnComplete(ASurfaceTransaction* transaction,
+                                          void* context,
+                                          OnComplete callback) {
+  FML_DCHECK(IsAvailable());
+  ASurfaceTransaction_setOnComplete_fn(transaction, context, callback);
+}
+
+int AndroidSurfaceControl::GetPreviousReleaseFence(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* surface_control) {
+  FML_DCHECK(IsAvailable());
+  return ASurfaceTransactionStats_getPreviousReleaseFenceFd_fn(stats,
+                                                               surface_control);
+}
+
+}  // namespace flutter
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_H_
+
+#include <android/hardware_buffer.h>
+#include <android/native_window.h>
+#include <android/rect.h>
+
+#include "flutter/fml/macros.h"
+
+// Only available on API 29+
+struct ASurfaceControl;
+struct ASurfaceTransaction;
+struct ASurfaceTransactionStats;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The NDK's SurfaceControl functions, used to present the overlays of
+/// platform views from the raster thread. They are only available on API 29+
+/// and are looked up at runtime.
+///
+class AndroidSurfaceControl {
+ public:
+  // Called on a binder thread once a transaction was presented. |stats| is
+  // only valid during the call.
+  using OnComplete = void (*)(void* context, ASurfaceTransactionStats* stats);
+
+  static bool IsAvailable();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface control that is a child of the surface of
+  ///             |parent|. Returns nullptr on failure.
+  ///
+  static ASurfaceControl* CreateFromWindow(ANativeWindow* parent,
+                                           const char* debug_name);
+
+  static void Release(ASurfaceControl* surface_control);
+
+  static ASurfaceTransaction* CreateTransaction();
+
+  static void DeleteTransaction(ASurfaceTransaction* transaction);
+
+  static void ApplyTransaction(ASurfaceTransaction* transaction);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents |buffer| on |surface_control| once |acquire_fence|
+  ///             signals. The transaction takes ownership of the fence, which
+  ///             may be -1 if the buffer can be read right away.
+  ///
+  static void SetBuffer(ASurfaceTransaction* transaction,
+                        ASurfaceControl* surface_control,
+                        AHardwareBuffer* buffer,
+                        int acquire_fence);
+
+  static void SetVisibility(ASurfaceTransaction* transaction,
+                            ASurfaceControl* surface_control,
+                            bool visible);
+
+  static void SetZOrder(ASurfaceTransaction* transaction,
+                        ASurfaceControl* surface_control,
+                        int32_t z_order);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Shows |source| of the buffer at |destination| of the parent
+  ///             surface.
+  ///
+  static void SetGeometry(ASurfaceTransaction* transaction,
+                          ASurfaceControl* surface_control,
+                          const ARect& source,
+                          const ARect& destination);
+
+  static void SetOnComplete(ASurfaceTransaction* transaction,
+                            void* context,
+                            OnComplete callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the fence that signals once the buffer replaced on
+  ///             |surface_control| by the transaction of |stats| can be
+  ///             written again. The caller owns the fence, which is -1 if the
+  ///             buffer can be written right away.
+  ///
+  static int GetPreviousReleaseFence(ASurfaceTransactionStats* stats,
+                                     ASurfaceControl* surface_control);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceControl);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_H_
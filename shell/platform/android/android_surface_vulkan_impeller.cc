@@ -7,6 +7,7 @@
 #include <memory>
 #include <utility>
 
+#include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/memory/ref_ptr.h"
@@ -34,10 +35,15 @@ std::shared_ptr<impeller::Context> CreateImpellerContext(
   PFN_vkGetInstanceProcAddr instance_proc_addr =
       proc_table->NativeGetInstanceProcAddr();
 
+  // The pipeline cache is stored next to the Skia cache so that it is purged
+  // and versioned along with it.
+  auto cache_directory =
+      PersistentCache::GetCacheForProcess()->DuplicateCacheDirectory();
+
   auto context =
       impeller::ContextVK::Create(instance_proc_addr,                //
                                   shader_mappings,                   //
-                                  nullptr,                           //
+                                  std::move(cache_directory),        //
                                   concurrent_loop->GetTaskRunner(),  //
                                   "Android Impeller Vulkan Lib"      //
       );
@@ -47,10 +53,14 @@ std::shared_ptr<impeller::Context> CreateImpellerContext(
 
 AndroidSurfaceVulkanImpeller::AndroidSurfaceVulkanImpeller(
     const std::shared_ptr<AndroidContext>& android_context,
-    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade)
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
+    bool low_latency,
+    size_t frames_in_flight)
     : AndroidSurface(android_context),
       proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()),
-      workers_(fml::ConcurrentMessageLoop::Create()) {
+      workers_(fml::ConcurrentMessageLoop::Create()),
+      low_latency_(low_latency),
+      frames_in_flight_(frames_in_flight) {
   impeller_context_ = CreateImpellerContext(proc_table_, workers_);
   is_valid_ =
       proc_table_->HasAcquiredMandatoryProcAddresses() && impeller_context_;
@@ -114,7 +124,13 @@ bool AndroidSurfaceVulkanImpeller::SetNativeWindow(
       return false;
     }
 
-    context_vk.SetupSwapchain(std::move(surface));
+    context_vk.SetupSwapchain(
+        std::move(surface),
+        {
+            .latency = low_latency_ ? impeller::PresentLatencyVK::kLowLatency
+                                    : impeller::PresentLatencyVK::kThroughput,
+            .frames_in_flight = frames_in_flight_,
+        });
     return true;
   }
 
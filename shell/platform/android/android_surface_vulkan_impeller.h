@@ -15,9 +15,18 @@ namespace flutter {
 
 class AndroidSurfaceVulkanImpeller : public AndroidSurface {
  public:
+  //----------------------------------------------------------------------------
+  /// @param[in]  low_latency       Whether frames are presented as soon as
+  ///                               possible instead of being queued for a
+  ///                               vsync.
+  /// @param[in]  frames_in_flight  The number of frames that may be rendered
+  ///                               by the GPU at the same time.
+  ///
   AndroidSurfaceVulkanImpeller(
       const std::shared_ptr<AndroidContext>& android_context,
-      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
+      bool low_latency = true,
+      size_t frames_in_flight = 2u);
 
   ~AndroidSurfaceVulkanImpeller() override;
 
@@ -51,6 +60,8 @@ class AndroidSurfaceVulkanImpeller : public AndroidSurface {
   fml::RefPtr<AndroidNativeWindow> native_window_;
   std::shared_ptr<fml::ConcurrentMessageLoop> workers_;
   std::shared_ptr<impeller::Context> impeller_context_;
+  const bool low_latency_;
+  const size_t frames_in_flight_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceVulkanImpeller);
@@ -8,17 +8,32 @@
 
 namespace flutter {
 
+namespace {
+
+// The geometry of a platform view in a frame, captured on the raster thread
+// to display the view on the platform thread.
+struct PlatformViewPlacement {
+  int64_t view_id;
+  SkRect rect;
+  SkSize size;
+  MutatorsStack mutators_stack;
+};
+
+}  // namespace
+
 AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    const TaskRunners& task_runners)
+    const TaskRunners& task_runners,
+    std::shared_ptr<OverlayCompositor> overlay_compositor)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(std::move(jni_facade)),
       surface_factory_(std::move(surface_factory)),
       surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      task_runners_(task_runners),
+      overlay_compositor_(std::move(overlay_compositor)) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -99,6 +114,10 @@ void AndroidExternalViewEmbedder::SubmitFrame(
 
   if (!FrameHasPlatformLayers()) {
     frame->Submit();
+    if (overlay_compositor_ && previous_frame_view_count_ > 0) {
+      // Hide the overlays and the Android views of the previous frame.
+      SubmitOverlaysToCompositor(context, {});
+    }
     return;
   }
 
@@ -173,6 +192,14 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   // Manually trigger the SkAutoCanvasRestore before we submit the frame
   save.restore();
 
+  if (overlay_compositor_) {
+    // The background surface doesn't change when platform views are added,
+    // so the frame never needs to be resubmitted.
+    frame->Submit();
+    SubmitOverlaysToCompositor(context, overlay_layers);
+    return;
+  }
+
   // Submit the background canvas frame before switching the GL context to
   // the overlay surfaces.
   //
@@ -247,10 +274,75 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
   return frame;
 }
 
+void AndroidExternalViewEmbedder::SubmitOverlaysToCompositor(
+    GrDirectContext* context,
+    const std::unordered_map<int64_t, SkRect>& overlay_layers) {
+  if (overlay_compositor_->IsAvailable()) {
+    size_t index = 0;
+    for (int64_t view_id : composition_order_) {
+      std::unordered_map<int64_t, SkRect>::const_iterator overlay =
+          overlay_layers.find(view_id);
+      if (overlay == overlay_layers.end()) {
+        continue;
+      }
+      const SkRect& rect = overlay->second;
+      std::unique_ptr<SurfaceFrame> frame = overlay_compositor_->AcquireFrame(
+          context, index++, rect, frame_size_);
+      if (!frame) {
+        continue;
+      }
+      SkCanvas* overlay_canvas = frame->SkiaCanvas();
+      overlay_canvas->clear(SK_ColorTRANSPARENT);
+      // Offset the picture since the frame only covers the overlay's rect.
+      overlay_canvas->translate(-rect.x(), -rect.y());
+      if (frame->GetDisplayListBuilder()) {
+        slices_.at(view_id)->render_into(frame->GetDisplayListBuilder().get());
+      } else {
+        slices_.at(view_id)->render_into(overlay_canvas);
+      }
+      frame->Submit();
+    }
+    overlay_compositor_->Present();
+  }
+
+  // The Android views can only be updated on the platform thread. Their
+  // geometry is captured now, since later frames change the embedder's state
+  // before the task runs.
+  std::vector<PlatformViewPlacement> placements;
+  placements.reserve(composition_order_.size());
+  for (int64_t view_id : composition_order_) {
+    const EmbeddedViewParams& params = view_params_.at(view_id);
+    placements.push_back({
+        view_id,
+        GetViewRect(view_id),
+        SkSize::Make(params.sizePoints().width() * device_pixel_ratio_,
+                     params.sizePoints().height() * device_pixel_ratio_),
+        params.mutatorsStack(),
+    });
+  }
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [jni_facade = jni_facade_, placements = std::move(placements)]() {
+        jni_facade->FlutterViewBeginFrame();
+        for (const PlatformViewPlacement& placement : placements) {
+          jni_facade->FlutterViewOnDisplayPlatformView(
+              placement.view_id,        //
+              placement.rect.x(),       //
+              placement.rect.y(),       //
+              placement.rect.width(),   //
+              placement.rect.height(),  //
+              placement.size.width(),   //
+              placement.size.height(),  //
+              placement.mutators_stack  //
+          );
+        }
+        jni_facade->FlutterViewEndFrame();
+      });
+}
+
 // |ExternalViewEmbedder|
 PostPrerollResult AndroidExternalViewEmbedder::PostPrerollAction(
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
-  if (!FrameHasPlatformLayers()) {
+  if (!FrameHasPlatformLayers() || overlay_compositor_) {
     return PostPrerollResult::kSuccess;
   }
   if (!raster_thread_merger->IsMerged()) {
@@ -306,8 +398,10 @@ void AndroidExternalViewEmbedder::BeginFrame(
     DestroySurfaces();
   }
   surface_pool_->SetFrameSize(frame_size);
-  // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  // JNI method must be called on the platform thread. There is no merger when
+  // the overlays are presented by |overlay_compositor_|, in which case the
+  // Android views are updated by a task posted in |SubmitFrame|.
+  if (raster_thread_merger && raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewBeginFrame();
   }
 
@@ -326,19 +420,22 @@ void AndroidExternalViewEmbedder::EndFrame(
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   surface_pool_->RecycleLayers();
   // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  if (raster_thread_merger && raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewEndFrame();
   }
 }
 
 // |ExternalViewEmbedder|
 bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return !overlay_compositor_;
 }
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::Teardown() {
   DestroySurfaces();
+  if (overlay_compositor_) {
+    overlay_compositor_->Teardown();
+  }
 }
 
 // |ExternalViewEmbedder|
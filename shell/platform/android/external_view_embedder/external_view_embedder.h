@@ -11,6 +11,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
 #include "flutter/shell/platform/android/context/android_context.h"
+#include "flutter/shell/platform/android/external_view_embedder/overlay_compositor.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
@@ -28,13 +29,19 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// If an |OverlayCompositor| is provided, the overlays are presented through
+/// it from the raster thread instead, and the raster thread is never merged
+/// into the platform thread. The Android views are then updated by tasks
+/// posted to the platform thread.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      const TaskRunners& task_runners);
+      const TaskRunners& task_runners,
+      std::shared_ptr<OverlayCompositor> overlay_compositor = nullptr);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -110,6 +117,9 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // The task runners.
   const TaskRunners task_runners_;
 
+  // Presents the overlay layers without thread merging, if set.
+  const std::shared_ptr<OverlayCompositor> overlay_compositor_;
+
   // The size of the root canvas.
   SkISize frame_size_;
 
@@ -150,6 +160,13 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
                                                       int64_t view_id,
                                                       EmbedderViewSlice* slice,
                                                       const SkRect& rect);
+
+  // Renders the overlay layers through |overlay_compositor_|, and posts a task
+  // that updates the Android views of the current frame on the platform
+  // thread.
+  void SubmitOverlaysToCompositor(
+      GrDirectContext* context,
+      const std::unordered_map<int64_t, SkRect>& overlay_layers);
 };
 
 }  // namespace flutter
@@ -24,6 +24,7 @@
 namespace flutter {
 namespace testing {
 
+using ::testing::_;
 using ::testing::ByMove;
 using ::testing::Return;
 
@@ -64,6 +65,23 @@ class SurfaceMock : public Surface {
               (override));
 };
 
+class OverlayCompositorMock : public OverlayCompositor {
+ public:
+  MOCK_METHOD(bool, IsAvailable, (), (override));
+
+  MOCK_METHOD(std::unique_ptr<SurfaceFrame>,
+              AcquireFrame,
+              (GrDirectContext * context,
+               size_t index,
+               const SkRect& rect,
+               const SkISize& frame_size),
+              (override));
+
+  MOCK_METHOD(void, Present, (), (override));
+
+  MOCK_METHOD(void, Teardown, (), (override));
+};
+
 fml::RefPtr<fml::RasterThreadMerger> GetThreadMergerFromPlatformThread(
     fml::Thread* rasterizer_thread = nullptr) {
   // Assume the current thread is the platform thread.
@@ -1110,5 +1128,135 @@ TEST(AndroidExternalViewEmbedder, TeardownDoesNotCallJNIMethod) {
   embedder->Teardown();
 }
 
+TEST(AndroidExternalViewEmbedder,
+     DoesNotSupportDynamicThreadMergingWithOverlayCompositor) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      std::make_shared<OverlayCompositorMock>());
+  ASSERT_FALSE(embedder->SupportsDynamicThreadMerging());
+}
+
+TEST(AndroidExternalViewEmbedder, SubmitFrameWithOverlayCompositor) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto overlay_compositor = std::make_shared<OverlayCompositorMock>();
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      overlay_compositor);
+
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+
+  // There is no thread merger without dynamic thread merging, and JNI methods
+  // are only called from tasks posted to the platform thread.
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+  embedder->BeginFrame(frame_size, nullptr, 1.5, nullptr);
+
+  // Add an Android view.
+  MutatorsStack stack;
+  auto view_params = std::make_unique<EmbeddedViewParams>(
+      SkMatrix(), SkSize::Make(200, 200), stack);
+  embedder->PrerollCompositeEmbeddedView(0, std::move(view_params));
+  ASSERT_EQ(PostPrerollResult::kSuccess, embedder->PostPrerollAction(nullptr));
+
+  // This simulates Flutter UI that intersects with the Android view.
+  embedder->CompositeEmbeddedView(0).canvas->drawRect(
+      SkRect::MakeXYWH(50, 50, 200, 200), SkPaint());
+
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface()).Times(0);
+  EXPECT_CALL(*overlay_compositor, IsAvailable()).WillOnce(Return(true));
+  auto overlay_submitted = std::make_shared<bool>(false);
+  EXPECT_CALL(*overlay_compositor,
+              AcquireFrame(gr_context.get(), 0,
+                           SkRect::MakeXYWH(50, 50, 150, 150), frame_size))
+      .WillOnce(Return(ByMove(std::make_unique<SurfaceFrame>(
+          SkSurface::MakeNull(150, 150), framebuffer_info,
+          [overlay_submitted](const SurfaceFrame& surface_frame,
+                              SkCanvas* canvas) {
+            *overlay_submitted = true;
+            return true;
+          },
+          /*frame_size=*/SkISize::Make(150, 150)))));
+  EXPECT_CALL(*overlay_compositor, Present());
+
+  // The background is submitted in the first frame with platform views, since
+  // it doesn't switch to a different surface.
+  bool background_submitted = false;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurface::MakeNull(1000, 1000), framebuffer_info,
+      [&background_submitted](const SurfaceFrame& surface_frame,
+                              SkCanvas* canvas) {
+        background_submitted = true;
+        return true;
+      },
+      /*frame_size=*/SkISize::Make(800, 600));
+  embedder->SubmitFrame(gr_context.get(), std::move(surface_frame));
+  EXPECT_TRUE(background_submitted);
+  EXPECT_TRUE(*overlay_submitted);
+
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame()).Times(0);
+  embedder->EndFrame(/*should_resubmit_frame=*/false, nullptr);
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 200, 200,
+                                                          300, 300, stack));
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+}
+
+TEST(AndroidExternalViewEmbedder,
+     UpdatesViewsWhenOverlayCompositorIsUnavailable) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto overlay_compositor = std::make_shared<OverlayCompositorMock>();
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      overlay_compositor);
+
+  auto frame_size = SkISize::Make(1000, 1000);
+  embedder->BeginFrame(frame_size, nullptr, 1.5, nullptr);
+
+  MutatorsStack stack;
+  auto view_params = std::make_unique<EmbeddedViewParams>(
+      SkMatrix(), SkSize::Make(200, 200), stack);
+  embedder->PrerollCompositeEmbeddedView(0, std::move(view_params));
+  embedder->CompositeEmbeddedView(0).canvas->drawRect(
+      SkRect::MakeXYWH(50, 50, 200, 200), SkPaint());
+
+  EXPECT_CALL(*overlay_compositor, IsAvailable()).WillOnce(Return(false));
+  EXPECT_CALL(*overlay_compositor, AcquireFrame(_, _, _, _)).Times(0);
+  EXPECT_CALL(*overlay_compositor, Present()).Times(0);
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurface::MakeNull(1000, 1000), framebuffer_info,
+      [](const SurfaceFrame& surface_frame, SkCanvas* canvas) { return true; },
+      /*frame_size=*/SkISize::Make(800, 600));
+  embedder->SubmitFrame(nullptr, std::move(surface_frame));
+  embedder->EndFrame(/*should_resubmit_frame=*/false, nullptr);
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 200, 200,
+                                                          300, 300, stack));
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+}
+
+TEST(AndroidExternalViewEmbedder, TeardownTearsDownOverlayCompositor) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto overlay_compositor = std::make_shared<OverlayCompositorMock>();
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      overlay_compositor);
+
+  EXPECT_CALL(*jni_mock, FlutterViewDestroyOverlaySurfaces()).Times(0);
+  EXPECT_CALL(*overlay_compositor, Teardown());
+  embedder->Teardown();
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_OVERLAY_COMPOSITOR_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_OVERLAY_COMPOSITOR_H_
+
+#include <memory>
+
+#include "flutter/flow/surface_frame.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+class GrDirectContext;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Presents the overlay layers of platform views from the raster thread.
+///
+/// Unlike the overlay surfaces of |SurfacePool|, which are Android views and
+/// can only be managed on the platform thread, the layers of a compositor are
+/// updated without involving the platform thread. This allows the embedder to
+/// render frames with platform views without merging the raster thread into
+/// the platform thread.
+///
+/// All the methods are called on the raster thread.
+///
+class OverlayCompositor {
+ public:
+  virtual ~OverlayCompositor() = default;
+
+  // Whether overlay layers can currently be presented. This is false whenever
+  // the platform surface that hosts the layers doesn't exist.
+  virtual bool IsAvailable() = 0;
+
+  // Acquires a frame for the overlay layer at |index|, placed at |rect| in a
+  // frame of |frame_size|. The frame covers |rect| only.
+  //
+  // Layers are stacked in the order of their indices.
+  virtual std::unique_ptr<SurfaceFrame> AcquireFrame(
+      GrDirectContext* context,
+      size_t index,
+      const SkRect& rect,
+      const SkISize& frame_size) = 0;
+
+  // Presents the frames submitted since the last call at once, and hides the
+  // layers that weren't acquired since then.
+  virtual void Present() = 0;
+
+  // Releases the layers and their buffers.
+  virtual void Teardown() = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_OVERLAY_COMPOSITOR_H_
@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/image_external_texture.h"
+
+#include <utility>
+
+#include "flutter/display_list/display_list_sampling_options.h"
+
+namespace flutter {
+
+// The frame being drawn and the frame before it, which the GPU may still be
+// sampling.
+static constexpr size_t kMaxFrames = 2u;
+
+ImageExternalTexture::ImageExternalTexture(
+    int64_t id,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry,
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade)
+    : Texture(id),
+      jni_facade_(jni_facade),
+      image_texture_entry_(image_texture_entry) {}
+
+ImageExternalTexture::~ImageExternalTexture() {
+  CloseFrames(0u);
+}
+
+void ImageExternalTexture::Paint(PaintContext& context,
+                                 const SkRect& bounds,
+                                 bool freeze,
+                                 const SkSamplingOptions& sampling) {
+  if (!freeze && new_frame_ready_) {
+    UpdateImage(context);
+    new_frame_ready_ = false;
+  }
+  if (frames_.empty()) {
+    return;
+  }
+  const sk_sp<DlImage>& dl_image = frames_.back().dl_image;
+
+  if (dl_image->impeller_texture()) {
+    context.builder->drawImageRect(
+        dl_image,                                             // image
+        SkRect::Make(dl_image->bounds()),                     // source rect
+        bounds,                                               // dest rect
+        ToDl(sampling),                                       // sampling
+        context.dl_paint,                                     // paint
+        SkCanvas::SrcRectConstraint::kFast_SrcRectConstraint  // constraint
+    );
+    return;
+  }
+
+  context.canvas->drawImageRect(
+      dl_image->skia_image(),                               // image
+      SkRect::Make(dl_image->bounds()),                     // source rect
+      bounds,                                               // destination rect
+      sampling,                                             // sampling
+      context.sk_paint,                                     // paint
+      SkCanvas::SrcRectConstraint::kFast_SrcRectConstraint  // constraint
+  );
+}
+
+void ImageExternalTexture::MarkNewFrameAvailable() {
+  new_frame_ready_ = true;
+}
+
+void ImageExternalTexture::OnTextureUnregistered() {}
+
+void ImageExternalTexture::OnGrContextCreated() {}
+
+void ImageExternalTexture::OnGrContextDestroyed() {
+  // The images can't outlive the context they were imported into. Drawing
+  // resumes with the next frame the producer pushes.
+  CloseFrames(0u);
+  Detach();
+}
+
+void ImageExternalTexture::UpdateImage(PaintContext& context) {
+  JavaLocalRef image = jni_facade_->ImageTextureEntryAcquireLatestImage(
+      JavaLocalRef(image_texture_entry_));
+  if (image.is_null()) {
+    // Keep drawing the last frame.
+    return;
+  }
+
+  JavaLocalRef hardware_buffer = jni_facade_->ImageGetHardwareBuffer(image);
+  if (hardware_buffer.is_null()) {
+    FML_LOG(ERROR) << "Image texture frame has no hardware buffer.";
+    jni_facade_->ImageClose(image);
+    return;
+  }
+
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+  AHardwareBuffer* buffer =
+      AndroidHardwareBuffer::FromHardwareBuffer(env, hardware_buffer.obj());
+  AHardwareBuffer_Desc desc = {};
+  AndroidHardwareBuffer::Describe(buffer, &desc);
+  sk_sp<DlImage> dl_image = CreateDlImage(context, buffer, desc);
+  // The image holds the buffer for as long as it is open, the Java wrapper
+  // returned by `getHardwareBuffer` isn't needed anymore.
+  jni_facade_->HardwareBufferClose(hardware_buffer);
+  if (!dl_image) {
+    jni_facade_->ImageClose(image);
+    return;
+  }
+
+  frames_.push_back({fml::jni::ScopedJavaGlobalRef<jobject>(env, image.obj()),
+                     std::move(dl_image)});
+  CloseFrames(kMaxFrames);
+}
+
+void ImageExternalTexture::CloseFrames(size_t keep) {
+  while (frames_.size() > keep) {
+    // The image is released before the buffer is handed back.
+    frames_.front().dl_image.reset();
+    jni_facade_->ImageClose(JavaLocalRef(frames_.front().image));
+    frames_.pop_front();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_H_
+
+#include <deque>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/fml/logging.h"
+#include "flutter/shell/platform/android/android_hardware_buffer.h"
+#include "flutter/shell/platform/android/platform_view_android_jni_impl.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// An external texture fed by the `android.media.Image`s an
+/// `ImageTextureEntry` is handed, typically from an `ImageReader`.
+///
+/// The AHardwareBuffer backing each image is imported by the rendering
+/// backend as is, so frames are sampled without being copied. Subclasses
+/// implement the import for a given backend.
+///
+class ImageExternalTexture : public flutter::Texture {
+ public:
+  ImageExternalTexture(
+      int64_t id,
+      const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry,
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+
+  ~ImageExternalTexture() override;
+
+  // |Texture|
+  void Paint(PaintContext& context,
+             const SkRect& bounds,
+             bool freeze,
+             const SkSamplingOptions& sampling) override;
+
+  // |Texture|
+  void MarkNewFrameAvailable() override;
+
+  // |Texture|
+  void OnTextureUnregistered() override;
+
+  // |ContextListener|
+  void OnGrContextCreated() override;
+
+  // |ContextListener|
+  void OnGrContextDestroyed() override;
+
+ protected:
+  //----------------------------------------------------------------------------
+  /// @brief      Imports a hardware buffer into an image that can be drawn
+  ///             with |context|.
+  ///
+  ///             The buffer stays valid as long as the returned image is
+  ///             referenced by the texture. Implementations that use the
+  ///             buffer for longer must acquire it.
+  ///
+  /// @return     The image, or nullptr if the buffer can't be imported.
+  ///
+  virtual sk_sp<DlImage> CreateDlImage(PaintContext& context,
+                                       AHardwareBuffer* hardware_buffer,
+                                       const AHardwareBuffer_Desc& desc) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the backend resources of the images created so
+  ///             far. Called on the raster thread when the rendering context
+  ///             goes away.
+  ///
+  virtual void Detach() = 0;
+
+ private:
+  void UpdateImage(PaintContext& context);
+
+  void CloseFrames(size_t keep);
+
+  struct Frame {
+    fml::jni::ScopedJavaGlobalRef<jobject> image;
+    sk_sp<DlImage> dl_image;
+  };
+
+  std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
+
+  fml::jni::ScopedJavaGlobalRef<jobject> image_texture_entry_;
+
+  // The frames whose buffers are in use, the latest one last. Closing an
+  // image hands its buffer back to the producer, so the last few frames are
+  // kept alive while the GPU may still be sampling them.
+  std::deque<Frame> frames_;
+
+  bool new_frame_ready_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageExternalTexture);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_H_
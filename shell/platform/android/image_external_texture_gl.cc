@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/image_external_texture_gl.h"
+
+#include "third_party/skia/include/core/SkAlphaType.h"
+#include "third_party/skia/include/core/SkColorType.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLTypes.h"
+
+namespace flutter {
+
+ImageExternalTextureGL::ImageExternalTextureGL(
+    int64_t id,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry,
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade)
+    : ImageExternalTexture(id, image_texture_entry, jni_facade) {}
+
+ImageExternalTextureGL::~ImageExternalTextureGL() {
+  Detach();
+}
+
+bool ImageExternalTextureGL::LoadProcs() {
+  if (procs_loaded_) {
+    return image_target_texture_ != nullptr;
+  }
+  procs_loaded_ = true;
+  get_native_client_buffer_ =
+      reinterpret_cast<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
+          eglGetProcAddress("eglGetNativeClientBufferANDROID"));
+  create_image_ = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(
+      eglGetProcAddress("eglCreateImageKHR"));
+  destroy_image_ = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(
+      eglGetProcAddress("eglDestroyImageKHR"));
+  image_target_texture_ =
+      reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+          eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+  if (!get_native_client_buffer_ || !create_image_ || !destroy_image_ ||
+      !image_target_texture_) {
+    FML_LOG(ERROR) << "EGL can't import hardware buffers.";
+    image_target_texture_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+sk_sp<DlImage> ImageExternalTextureGL::CreateDlImage(
+    PaintContext& context,
+    AHardwareBuffer* hardware_buffer,
+    const AHardwareBuffer_Desc& desc) {
+  if (!context.gr_context || !LoadProcs()) {
+    return nullptr;
+  }
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  EGLClientBuffer client_buffer = get_native_client_buffer_(hardware_buffer);
+  const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  EGLImageKHR egl_image = create_image_(display, EGL_NO_CONTEXT,
+                                        EGL_NATIVE_BUFFER_ANDROID,
+                                        client_buffer, attributes);
+  if (egl_image == EGL_NO_IMAGE_KHR) {
+    FML_LOG(ERROR) << "Failed to import hardware buffer: EGL error "
+                   << eglGetError();
+    return nullptr;
+  }
+
+  if (texture_name_ == 0) {
+    glGenTextures(1, &texture_name_);
+  }
+  glBindTexture(GL_TEXTURE_EXTERNAL_OES, texture_name_);
+  // The texture aliases the memory of the buffer, nothing is copied.
+  image_target_texture_(GL_TEXTURE_EXTERNAL_OES, egl_image);
+  // Skia needs to know that the texture binding changed behind its back.
+  context.gr_context->resetContext(kTextureBinding_GrGLBackendState);
+
+  if (egl_image_ != EGL_NO_IMAGE_KHR) {
+    destroy_image_(display_, egl_image_);
+  }
+  display_ = display;
+  egl_image_ = egl_image;
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_EXTERNAL_OES, texture_name_,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(desc.width, desc.height, GrMipMapped::kNo,
+                                   texture_info);
+  sk_sp<SkImage> image = SkImage::MakeFromTexture(
+      context.gr_context, backend_texture, kTopLeft_GrSurfaceOrigin,
+      kRGBA_8888_SkColorType, kPremul_SkAlphaType, nullptr);
+  if (!image) {
+    return nullptr;
+  }
+  return DlImage::Make(std::move(image));
+}
+
+void ImageExternalTextureGL::Detach() {
+  if (egl_image_ != EGL_NO_IMAGE_KHR) {
+    destroy_image_(display_, egl_image_);
+    egl_image_ = EGL_NO_IMAGE_KHR;
+  }
+  if (texture_name_ != 0) {
+    glDeleteTextures(1, &texture_name_);
+    texture_name_ = 0;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_GL_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_GL_H_
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include "flutter/shell/platform/android/image_external_texture.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// An image texture drawn by Skia's OpenGL ES backend. Each frame's buffer is
+/// bound to an external texture through an EGLImage.
+///
+class ImageExternalTextureGL : public ImageExternalTexture {
+ public:
+  ImageExternalTextureGL(
+      int64_t id,
+      const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry,
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+
+  ~ImageExternalTextureGL() override;
+
+ protected:
+  // |ImageExternalTexture|
+  sk_sp<DlImage> CreateDlImage(PaintContext& context,
+                               AHardwareBuffer* hardware_buffer,
+                               const AHardwareBuffer_Desc& desc) override;
+
+  // |ImageExternalTexture|
+  void Detach() override;
+
+ private:
+  bool LoadProcs();
+
+  bool procs_loaded_ = false;
+  PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC get_native_client_buffer_ = nullptr;
+  PFNEGLCREATEIMAGEKHRPROC create_image_ = nullptr;
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image_ = nullptr;
+  PFNGLEGLIMAGETARGETTEXTURE2DOESPROC image_target_texture_ = nullptr;
+
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  // The image of the latest frame. It keeps the buffer of the frame alive
+  // while it is bound to |texture_name_|.
+  EGLImageKHR egl_image_ = EGL_NO_IMAGE_KHR;
+  GLuint texture_name_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageExternalTextureGL);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_GL_H_
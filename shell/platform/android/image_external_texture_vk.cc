@@ -0,0 +1,181 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/image_external_texture_vk.h"
+
+#include <utility>
+
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_image_impeller.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/formats_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/texture_vk.h"
+
+namespace flutter {
+
+ImageExternalTextureVK::ImageExternalTextureVK(
+    int64_t id,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry,
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade)
+    : ImageExternalTexture(id, image_texture_entry, jni_facade) {}
+
+ImageExternalTextureVK::~ImageExternalTextureVK() = default;
+
+sk_sp<DlImage> ImageExternalTextureVK::CreateDlImage(
+    PaintContext& context,
+    AHardwareBuffer* hardware_buffer,
+    const AHardwareBuffer_Desc& desc) {
+  if (!context.aiks_context) {
+    return nullptr;
+  }
+  auto impeller_context = context.aiks_context->GetContext();
+  if (!impeller_context || impeller_context->GetBackendType() !=
+                               impeller::Context::BackendType::kVulkan) {
+    return nullptr;
+  }
+  auto context_vk =
+      std::static_pointer_cast<impeller::ContextVK>(impeller_context);
+  if (!context_vk->SupportsAndroidHardwareBuffers()) {
+    return nullptr;
+  }
+  vk::Device device = context_vk->GetDevice();
+
+  auto properties_chain = device.getAndroidHardwareBufferPropertiesANDROID<
+      vk::AndroidHardwareBufferPropertiesANDROID,
+      vk::AndroidHardwareBufferFormatPropertiesANDROID>(*hardware_buffer);
+  if (properties_chain.result != vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Failed to get the properties of a hardware buffer: "
+                   << vk::to_string(properties_chain.result);
+    return nullptr;
+  }
+  const auto& properties =
+      properties_chain.value.get<vk::AndroidHardwareBufferPropertiesANDROID>();
+  const auto& format_properties = properties_chain.value.get<
+      vk::AndroidHardwareBufferFormatPropertiesANDROID>();
+
+  // Buffers without a Vulkan format, such as the YUV buffers of cameras and
+  // video decoders, can only be sampled through a YCbCr conversion.
+  const auto pixel_format = impeller::ToPixelFormat(format_properties.format);
+  if (pixel_format == impeller::PixelFormat::kUnknown) {
+    FML_LOG(ERROR) << "Unsupported hardware buffer format: "
+                   << vk::to_string(format_properties.format);
+    return nullptr;
+  }
+
+  vk::StructureChain<vk::ImageCreateInfo, vk::ExternalMemoryImageCreateInfo>
+      image_chain;
+  auto& image_info = image_chain.get<vk::ImageCreateInfo>();
+  image_info.imageType = vk::ImageType::e2D;
+  image_info.format = format_properties.format;
+  image_info.extent = vk::Extent3D{desc.width, desc.height, 1u};
+  image_info.mipLevels = 1u;
+  image_info.arrayLayers = 1u;
+  image_info.samples = vk::SampleCountFlagBits::e1;
+  image_info.tiling = vk::ImageTiling::eOptimal;
+  image_info.usage = vk::ImageUsageFlagBits::eSampled;
+  image_info.sharingMode = vk::SharingMode::eExclusive;
+  image_info.initialLayout = vk::ImageLayout::eUndefined;
+  image_chain.get<vk::ExternalMemoryImageCreateInfo>().handleTypes =
+      vk::ExternalMemoryHandleTypeFlagBits::eAndroidHardwareBufferANDROID;
+
+  auto image = device.createImage(image_chain.get<vk::ImageCreateInfo>());
+  if (image.result != vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Failed to create an image for a hardware buffer: "
+                   << vk::to_string(image.result);
+    return nullptr;
+  }
+
+  // The buffer's memory is imported as is, any of the memory types the
+  // driver reports can hold it.
+  uint32_t memory_type_index = 0u;
+  while (memory_type_index < 32u &&
+         !(properties.memoryTypeBits & (1u << memory_type_index))) {
+    memory_type_index++;
+  }
+
+  vk::StructureChain<vk::MemoryAllocateInfo,
+                     vk::ImportAndroidHardwareBufferInfoANDROID,
+                     vk::MemoryDedicatedAllocateInfo>
+      memory_chain;
+  auto& memory_info = memory_chain.get<vk::MemoryAllocateInfo>();
+  memory_info.allocationSize = properties.allocationSize;
+  memory_info.memoryTypeIndex = memory_type_index;
+  memory_chain.get<vk::ImportAndroidHardwareBufferInfoANDROID>().buffer =
+      hardware_buffer;
+  memory_chain.get<vk::MemoryDedicatedAllocateInfo>().image = image.value;
+
+  auto memory =
+      device.allocateMemory(memory_chain.get<vk::MemoryAllocateInfo>());
+  if (memory.result != vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Failed to import a hardware buffer: "
+                   << vk::to_string(memory.result);
+    device.destroyImage(image.value);
+    return nullptr;
+  }
+
+  if (device.bindImageMemory(image.value, memory.value, 0u) !=
+      vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Failed to bind the memory of a hardware buffer.";
+    device.freeMemory(memory.value);
+    device.destroyImage(image.value);
+    return nullptr;
+  }
+
+  vk::ImageViewCreateInfo view_info;
+  view_info.image = image.value;
+  view_info.viewType = vk::ImageViewType::e2D;
+  view_info.format = image_info.format;
+  view_info.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+  view_info.subresourceRange.levelCount = 1u;
+  view_info.subresourceRange.layerCount = 1u;
+  auto image_view = device.createImageView(view_info);
+  if (image_view.result != vk::Result::eSuccess) {
+    FML_LOG(ERROR) << "Failed to create an image view for a hardware buffer: "
+                   << vk::to_string(image_view.result);
+    device.freeMemory(memory.value);
+    device.destroyImage(image.value);
+    return nullptr;
+  }
+
+  // The texture may outlive the frame it was created for, so it holds its own
+  // reference to the buffer.
+  AndroidHardwareBuffer::Acquire(hardware_buffer);
+
+  auto texture_info =
+      std::make_unique<impeller::TextureInfoVK>(impeller::TextureInfoVK{
+          .backing_type = impeller::TextureBackingTypeVK::kExternalTexture,
+          .external_texture =
+              {
+                  .image = static_cast<VkImage>(image.value),
+                  .image_view = static_cast<VkImageView>(image_view.value),
+              },
+          .release_external_texture =
+              [context_vk, device, image = image.value,
+               image_view = image_view.value, memory = memory.value,
+               hardware_buffer]() {
+                device.destroyImageView(image_view);
+                device.destroyImage(image);
+                device.freeMemory(memory);
+                AndroidHardwareBuffer::Release(hardware_buffer);
+              },
+      });
+
+  impeller::TextureDescriptor texture_desc;
+  texture_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+  texture_desc.format = pixel_format;
+  texture_desc.size = impeller::ISize(desc.width, desc.height);
+  texture_desc.mip_count = 1u;
+
+  auto texture = std::make_shared<impeller::TextureVK>(
+      texture_desc, context_vk.get(), std::move(texture_info));
+  return impeller::DlImageImpeller::Make(std::move(texture),
+                                         DlImage::OwningContext::kRaster);
+}
+
+void ImageExternalTextureVK::Detach() {
+  // The Vulkan resources are owned by the textures, which are released along
+  // with the frames.
+}
+
+}  // namespace flutter
@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_VK_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_VK_H_
+
+#include "flutter/shell/platform/android/image_external_texture.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// An image texture drawn by Impeller's Vulkan backend. Each frame's buffer is
+/// imported as the memory of a `VkImage`.
+///
+class ImageExternalTextureVK : public ImageExternalTexture {
+ public:
+  ImageExternalTextureVK(
+      int64_t id,
+      const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry,
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+
+  ~ImageExternalTextureVK() override;
+
+ protected:
+  // |ImageExternalTexture|
+  sk_sp<DlImage> CreateDlImage(PaintContext& context,
+                               AHardwareBuffer* hardware_buffer,
+                               const AHardwareBuffer_Desc& desc) override;
+
+  // |ImageExternalTexture|
+  void Detach() override;
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageExternalTextureVK);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_IMAGE_EXTERNAL_TEXTURE_VK_H_
@@ -5,6 +5,7 @@
 package io.flutter.embedding.android;
 
 import static android.content.ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW;
+import static android.content.ComponentCallbacks2.TRIM_MEMORY_RUNNING_MODERATE;
 import static io.flutter.embedding.android.FlutterActivityLaunchConfigs.DEFAULT_INITIAL_ROUTE;
 
 import android.app.Activity;
@@ -904,8 +905,11 @@ import java.util.List;
       // an overly aggressive GC.
       boolean trim = isFirstFrameRendered && level >= TRIM_MEMORY_RUNNING_LOW;
       if (trim) {
-        flutterEngine.getDartExecutor().notifyLowMemoryWarning();
+        flutterEngine.getDartExecutor().notifyMemoryPressure(level);
         flutterEngine.getSystemChannel().sendMemoryPressureWarning();
+      } else if (isFirstFrameRendered && level == TRIM_MEMORY_RUNNING_MODERATE) {
+        // Only the engine caches that are cheap to rebuild are trimmed.
+        flutterEngine.getDartExecutor().notifyMemoryPressure(level);
       }
       flutterEngine.getRenderer().onTrimMemory(level);
     }
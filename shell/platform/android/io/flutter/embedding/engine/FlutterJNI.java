@@ -33,6 +33,7 @@ import io.flutter.plugin.platform.PlatformViewsController;
 import io.flutter.util.Preconditions;
 import io.flutter.view.AccessibilityBridge;
 import io.flutter.view.FlutterCallbackInformation;
+import io.flutter.view.TextureRegistry;
 import java.io.IOException;
 import java.lang.ref.WeakReference;
 import java.nio.ByteBuffer;
@@ -646,6 +647,53 @@ public class FlutterJNI {
 
   private native void nativeSurfaceDestroyed(long nativeShellHolderId);
 
+  /**
+   * Whether the overlays of hybrid composition platform views are presented through {@code
+   * SurfaceControl} from the raster thread, instead of merging the raster thread into the platform
+   * thread.
+   *
+   * <p>In that mode, the overlays are presented in the surface that is registered with {@link
+   * #onOverlayHostSurfaceCreated(Surface)}, and the render surface isn't converted to an image
+   * view. This is always false while {@code FlutterJNI} isn't attached to native.
+   */
+  @UiThread
+  public boolean usesSurfaceControlComposition() {
+    ensureRunningOnMainThread();
+    if (!isAttached()) {
+      return false;
+    }
+    return nativeUsesSurfaceControlComposition(nativeShellHolderId);
+  }
+
+  private native boolean nativeUsesSurfaceControlComposition(long nativeShellHolderId);
+
+  /**
+   * Call this method when the {@link Surface} that hosts the overlays of platform views has been
+   * created. Only used if {@link #usesSurfaceControlComposition()} is true.
+   */
+  @UiThread
+  public void onOverlayHostSurfaceCreated(@NonNull Surface surface) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeOverlayHostSurfaceCreated(nativeShellHolderId, surface);
+  }
+
+  private native void nativeOverlayHostSurfaceCreated(
+      long nativeShellHolderId, @NonNull Surface surface);
+
+  /**
+   * Call this method when the {@link Surface} that was previously registered with {@link
+   * #onOverlayHostSurfaceCreated(Surface)} is destroyed.
+   */
+  @UiThread
+  public void onOverlayHostSurfaceDestroyed() {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeOverlayHostSurfaceDestroyed(nativeShellHolderId);
+  }
+
+  private native void nativeOverlayHostSurfaceDestroyed(long nativeShellHolderId);
+
   /**
    * Call this method to notify Flutter of the current device viewport metrics that are applies to
    * the Flutter UI that is being rendered.
@@ -885,6 +933,26 @@ public class FlutterJNI {
       long textureId,
       @NonNull WeakReference<SurfaceTextureWrapper> textureWrapper);
 
+  /**
+   * Gives control of an {@link TextureRegistry.ImageTextureEntry} to Flutter so that Flutter can
+   * display the images it is handed within Flutter's UI.
+   */
+  @UiThread
+  public void registerImageTexture(
+      long textureId, @NonNull TextureRegistry.ImageTextureEntry imageTextureEntry) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeRegisterImageTexture(
+        nativeShellHolderId,
+        textureId,
+        new WeakReference<TextureRegistry.ImageTextureEntry>(imageTextureEntry));
+  }
+
+  private native void nativeRegisterImageTexture(
+      long nativeShellHolderId,
+      long textureId,
+      @NonNull WeakReference<TextureRegistry.ImageTextureEntry> imageTextureEntry);
+
   /**
    * Call this method to inform Flutter that a texture previously registered with {@link
    * #registerTexture(long, SurfaceTextureWrapper)} has a new frame available.
@@ -1426,6 +1494,20 @@ public class FlutterJNI {
 
   private native void nativeNotifyLowMemoryWarning(long nativeShellHolderId);
 
+  /**
+   * Notifies the engine of memory pressure, so that it trims its caches according to the given
+   * level of {@link android.content.ComponentCallbacks2#onTrimMemory(int)}, and notifies the Dart
+   * VM when memory is running low or the application is in the background.
+   */
+  @UiThread
+  public void notifyMemoryPressure(int trimLevel) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeNotifyMemoryPressure(nativeShellHolderId, trimLevel);
+  }
+
+  private native void nativeNotifyMemoryPressure(long nativeShellHolderId, int trimLevel);
+
   private void ensureRunningOnMainThread() {
     if (Looper.myLooper() != mainLooper) {
       throw new RuntimeException(
@@ -318,6 +318,24 @@ public class DartExecutor implements BinaryMessenger {
     }
   }
 
+  /**
+   * Notify the engine of memory pressure at the given level of {@link
+   * android.content.ComponentCallbacks2#onTrimMemory(int)}.
+   *
+   * <p>The engine trims its caches according to the level. Moderate pressure only drops what is
+   * cheap to rebuild. From {@code TRIM_MEMORY_RUNNING_LOW} on, the Dart VM is notified of low
+   * memory as by {@link #notifyLowMemoryWarning()}, and from {@code TRIM_MEMORY_UI_HIDDEN} on, the
+   * resources kept only to render quickly are released too.
+   *
+   * <p>This does not notify a Flutter application about memory pressure. For that, use the {@link
+   * io.flutter.embedding.engine.systemchannels.SystemChannel#sendMemoryPressureWarning}.
+   */
+  public void notifyMemoryPressure(int trimLevel) {
+    if (flutterJNI.isAttached()) {
+      flutterJNI.notifyMemoryPressure(trimLevel);
+    }
+  }
+
   /**
    * Configuration options that specify which Dart entrypoint function is executed and where to find
    * that entrypoint and other assets required for Dart execution.
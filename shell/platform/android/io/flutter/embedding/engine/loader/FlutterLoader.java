@@ -41,6 +41,8 @@ public class FlutterLoader {
       "io.flutter.embedding.android.OldGenHeapSize";
   private static final String ENABLE_IMPELLER_META_DATA_KEY =
       "io.flutter.embedding.android.EnableImpeller";
+  private static final String ENABLE_SURFACE_CONTROL_META_DATA_KEY =
+      "io.flutter.embedding.android.EnableSurfaceControl";
 
   /**
    * Set whether leave or clean up the VM after the last shell shuts down. It can be set from app's
@@ -319,6 +321,9 @@ public class FlutterLoader {
       if (metaData != null && metaData.getBoolean(ENABLE_IMPELLER_META_DATA_KEY, false)) {
         shellArgs.add("--enable-impeller");
       }
+      if (metaData != null && metaData.getBoolean(ENABLE_SURFACE_CONTROL_META_DATA_KEY, false)) {
+        shellArgs.add("--enable-surface-control");
+      }
 
       final String leakVM = isLeakVM(metaData) ? "true" : "false";
       shellArgs.add("--leak-vm=" + leakVM);
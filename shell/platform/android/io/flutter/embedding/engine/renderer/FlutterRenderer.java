@@ -7,9 +7,11 @@ package io.flutter.embedding.engine.renderer;
 import android.graphics.Bitmap;
 import android.graphics.Rect;
 import android.graphics.SurfaceTexture;
+import android.media.Image;
 import android.os.Build;
 import android.os.Handler;
 import android.view.Surface;
+import androidx.annotation.Keep;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 import androidx.annotation.VisibleForTesting;
@@ -158,6 +160,20 @@ public class FlutterRenderer implements TextureRegistry {
     return entry;
   }
 
+  /**
+   * Creates and returns a texture drawing the {@link Image}s handed to it, which is made available
+   * to Flutter code.
+   */
+  @Override
+  @NonNull
+  public ImageTextureEntry createImageTexture() {
+    final ImageTextureRegistryEntry entry =
+        new ImageTextureRegistryEntry(nextTextureId.getAndIncrement());
+    Log.v(TAG, "New ImageTexture ID: " + entry.id());
+    flutterJNI.registerImageTexture(entry.id(), entry);
+    return entry;
+  }
+
   @Override
   public void onTrimMemory(int level) {
     final Iterator<WeakReference<OnTrimMemoryListener>> iterator = onTrimMemoryListeners.iterator();
@@ -287,6 +303,91 @@ public class FlutterRenderer implements TextureRegistry {
     }
   }
 
+  @Keep
+  final class ImageTextureRegistryEntry implements TextureRegistry.ImageTextureEntry {
+    private final long id;
+    private boolean released;
+    // The image pushed last that the engine hasn't acquired yet. Read by the engine on the raster
+    // thread.
+    @Nullable private Image pendingImage;
+
+    ImageTextureRegistryEntry(long id) {
+      this.id = id;
+    }
+
+    @Override
+    public long id() {
+      return id;
+    }
+
+    @Override
+    public void release() {
+      if (released) {
+        return;
+      }
+      released = true;
+      Log.v(TAG, "Releasing an ImageTexture (" + id + ").");
+      synchronized (this) {
+        if (pendingImage != null) {
+          pendingImage.close();
+          pendingImage = null;
+        }
+      }
+      unregisterTexture(id);
+    }
+
+    @Override
+    public void pushImage(@NonNull Image image) {
+      if (released) {
+        image.close();
+        return;
+      }
+      Image droppedImage;
+      synchronized (this) {
+        droppedImage = pendingImage;
+        pendingImage = image;
+      }
+      if (droppedImage != null) {
+        // The engine never drew it, a newer frame replaces it.
+        droppedImage.close();
+      }
+      markTextureFrameAvailable(id);
+    }
+
+    /**
+     * Called by the engine to take ownership of the image pushed last.
+     *
+     * @return The image, or null if none was pushed since the last call.
+     */
+    @Nullable
+    @SuppressWarnings("unused")
+    public Image acquireLatestImage() {
+      synchronized (this) {
+        Image image = pendingImage;
+        pendingImage = null;
+        return image;
+      }
+    }
+
+    @Override
+    protected void finalize() throws Throwable {
+      try {
+        if (released) {
+          return;
+        }
+        synchronized (this) {
+          if (pendingImage != null) {
+            pendingImage.close();
+            pendingImage = null;
+          }
+        }
+        handler.post(new SurfaceTextureFinalizerRunnable(id, flutterJNI));
+      } finally {
+        super.finalize();
+      }
+    }
+  }
+
   static final class SurfaceTextureFinalizerRunnable implements Runnable {
     private final long id;
     private final FlutterJNI flutterJNI;
@@ -385,6 +486,30 @@ public class FlutterRenderer implements TextureRegistry {
     isDisplayingFlutterUi = false;
   }
 
+  /**
+   * Whether the overlays of hybrid composition platform views are presented in a separate surface
+   * registered with {@link #startRenderingOverlaysToSurface(Surface)}, instead of Android views.
+   */
+  public boolean usesSurfaceControlComposition() {
+    return flutterJNI.usesSurfaceControlComposition();
+  }
+
+  /**
+   * Notifies Flutter that the given {@code surface} was created and is ready to host the overlays
+   * of platform views.
+   */
+  public void startRenderingOverlaysToSurface(@NonNull Surface surface) {
+    flutterJNI.onOverlayHostSurfaceCreated(surface);
+  }
+
+  /**
+   * Notifies Flutter that the {@code surface} previously registered with {@link
+   * #startRenderingOverlaysToSurface(Surface)} has been destroyed.
+   */
+  public void stopRenderingOverlaysToSurface() {
+    flutterJNI.onOverlayHostSurfaceDestroyed();
+  }
+
   /**
    * Notifies Flutter that the viewport metrics, e.g. window height and width, have changed.
    *
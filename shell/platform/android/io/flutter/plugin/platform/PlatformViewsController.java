@@ -10,9 +10,11 @@ import static android.view.MotionEvent.PointerProperties;
 import android.annotation.TargetApi;
 import android.content.Context;
 import android.content.MutableContextWrapper;
+import android.graphics.PixelFormat;
 import android.os.Build;
 import android.util.SparseArray;
 import android.view.MotionEvent;
+import android.view.SurfaceHolder;
 import android.view.SurfaceView;
 import android.view.View;
 import android.view.ViewGroup;
@@ -66,6 +68,12 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
 
   private AndroidTouchProcessor androidTouchProcessor;
 
+  @Nullable private FlutterRenderer flutterRenderer;
+
+  // The view whose surface hosts the overlays of hybrid composition platform views when the engine
+  // presents them through SurfaceControl. Null otherwise.
+  @Nullable private SurfaceView overlayHostView;
+
   // The context of the Activity or Fragment hosting the render target for the Flutter engine.
   private Context context;
 
@@ -792,6 +800,11 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
    */
   public void attachToView(@NonNull FlutterView newFlutterView) {
     flutterView = newFlutterView;
+    if (Build.VERSION.SDK_INT >= 29
+        && flutterRenderer != null
+        && flutterRenderer.usesSurfaceControlComposition()) {
+      addOverlayHostView();
+    }
     // Add wrapper for platform views that use GL texture.
     for (int index = 0; index < viewWrappers.size(); index++) {
       final PlatformViewWrapper view = viewWrappers.valueAt(index);
@@ -830,6 +843,10 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
 
     destroyOverlaySurfaces();
     removeOverlaySurfaces();
+    if (overlayHostView != null) {
+      flutterView.removeView(overlayHostView);
+      overlayHostView = null;
+    }
     flutterView = null;
     flutterViewConvertedToImageView = false;
 
@@ -1024,7 +1041,50 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
     }
   }
 
+  /**
+   * Adds the view that hosts the overlays presented by the engine through SurfaceControl.
+   *
+   * <p>The overlays are drawn by the raster thread, so the render surface doesn't need to be
+   * converted to an image view to synchronize with the platform views. The host is placed above
+   * the whole window, including the platform views.
+   */
+  @TargetApi(29)
+  private void addOverlayHostView() {
+    overlayHostView = new SurfaceView(context);
+    overlayHostView.setZOrderOnTop(true);
+    overlayHostView.getHolder().setFormat(PixelFormat.TRANSPARENT);
+    overlayHostView
+        .getHolder()
+        .addCallback(
+            new SurfaceHolder.Callback() {
+              @Override
+              public void surfaceCreated(@NonNull SurfaceHolder holder) {
+                if (flutterRenderer != null) {
+                  flutterRenderer.startRenderingOverlaysToSurface(holder.getSurface());
+                }
+              }
+
+              @Override
+              public void surfaceChanged(
+                  @NonNull SurfaceHolder holder, int format, int width, int height) {}
+
+              @Override
+              public void surfaceDestroyed(@NonNull SurfaceHolder holder) {
+                if (flutterRenderer != null) {
+                  flutterRenderer.stopRenderingOverlaysToSurface();
+                }
+              }
+            });
+    flutterView.addView(
+        overlayHostView,
+        new FrameLayout.LayoutParams(
+            ViewGroup.LayoutParams.MATCH_PARENT, ViewGroup.LayoutParams.MATCH_PARENT));
+  }
+
   private void initializeRootImageViewIfNeeded() {
+    if (overlayHostView != null) {
+      return;
+    }
     if (synchronizeToNativeViewHierarchy && !flutterViewConvertedToImageView) {
       flutterView.convertToImageView();
       flutterViewConvertedToImageView = true;
@@ -1086,6 +1146,7 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
   }
 
   public void attachToFlutterRenderer(@NonNull FlutterRenderer flutterRenderer) {
+    this.flutterRenderer = flutterRenderer;
     androidTouchProcessor = new AndroidTouchProcessor(flutterRenderer, /*trackMotionEvents=*/ true);
   }
 
@@ -1226,14 +1287,16 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
       // This should only show platform views that are rendered in this frame and either:
       //  1. Surface has images available in this frame or,
       //  2. Surface does not have images available in this frame because the render surface should
-      // not be an ImageView.
+      // not be an ImageView, or the overlays are presented in the overlay host view.
       //
       // The platform view is appended to a mutator view.
       //
       // Otherwise, hide the platform view, but don't remove it from the view hierarchy yet as
       // they are removed when the framework disposes the platform view widget.
       if (currentFrameUsedPlatformViewIds.contains(viewId)
-          && (isFrameRenderedUsingImageReaders || !synchronizeToNativeViewHierarchy)) {
+          && (isFrameRenderedUsingImageReaders
+              || !synchronizeToNativeViewHierarchy
+              || overlayHostView != null)) {
         parentView.setVisibility(View.VISIBLE);
       } else {
         parentView.setVisibility(View.GONE);
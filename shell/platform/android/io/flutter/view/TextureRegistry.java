@@ -5,6 +5,7 @@
 package io.flutter.view;
 
 import android.graphics.SurfaceTexture;
+import android.media.Image;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 
@@ -31,6 +32,24 @@ public interface TextureRegistry {
   @NonNull
   SurfaceTextureEntry registerSurfaceTexture(@NonNull SurfaceTexture surfaceTexture);
 
+  /**
+   * Creates and registers a texture that draws the {@link Image}s it is handed.
+   *
+   * <p>The hardware buffers of the images are sampled by the GPU as is, without being copied. This
+   * makes image textures the cheapest way to show frames produced by an {@link
+   * android.media.ImageReader}, such as camera previews or decoded video. The reader must be
+   * created with the {@link android.hardware.HardwareBuffer#USAGE_GPU_SAMPLED_IMAGE} usage.
+   *
+   * <p>Image textures require API 28 and are only supported by some renderers, they are not drawn
+   * otherwise.
+   *
+   * @return An ImageTextureEntry.
+   */
+  @NonNull
+  default ImageTextureEntry createImageTexture() {
+    throw new UnsupportedOperationException("Image textures are not supported by this registry.");
+  }
+
   /**
    * Callback invoked when memory is low.
    *
@@ -57,6 +76,27 @@ public interface TextureRegistry {
     default void setOnTrimMemoryListener(@Nullable OnTrimMemoryListener listener) {}
   }
 
+  /** A registry entry for a texture drawing {@link Image}s. */
+  interface ImageTextureEntry {
+    /** @return The identity of this texture. */
+    long id();
+
+    /** Deregisters this texture and closes the image it holds. */
+    void release();
+
+    /**
+     * Hands the next frame of the texture over. The texture owns the image from then on, and
+     * closes it once it is no longer drawn. An image pushed before that wasn't drawn yet is closed
+     * right away.
+     *
+     * <p>The texture keeps the images of the last couple of frames open while the GPU may still
+     * sample them, so readers feeding it need a {@code maxImages} of at least 4.
+     *
+     * <p>Must be called on the platform thread.
+     */
+    void pushImage(@NonNull Image image);
+  }
+
   /** Listener invoked when the most recent image has been consumed. */
   interface OnFrameConsumedListener {
     /**
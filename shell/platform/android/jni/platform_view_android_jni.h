@@ -109,6 +109,32 @@ class PlatformViewAndroidJNI {
   virtual void SurfaceTextureDetachFromGLContext(
       JavaLocalRef surface_texture) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Acquires the most recent image pushed to an image texture
+  ///             entry, transferring its ownership to the caller.
+  ///
+  /// @return     The `android.media.Image`, or a null reference if no new
+  ///             image was pushed since the last call.
+  ///
+  virtual JavaLocalRef ImageTextureEntryAcquireLatestImage(
+      JavaLocalRef image_texture_entry) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the `android.hardware.HardwareBuffer` backing an image.
+  ///
+  virtual JavaLocalRef ImageGetHardwareBuffer(JavaLocalRef image) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Closes an `android.media.Image`, handing its buffer back to
+  ///             the producer.
+  ///
+  virtual void ImageClose(JavaLocalRef image) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Closes an `android.hardware.HardwareBuffer`.
+  ///
+  virtual void HardwareBufferClose(JavaLocalRef hardware_buffer) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief      Positions and sizes a platform view if using hybrid
   ///             composition.
@@ -8,23 +8,28 @@
 #include <utility>
 
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/common/shell_io_manager.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
 #include "flutter/shell/platform/android/android_context_gl_skia.h"
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
+#include "flutter/shell/platform/android/android_hardware_buffer.h"
 #include "flutter/shell/platform/android/android_surface_gl_impeller.h"
 #include "flutter/shell/platform/android/android_surface_gl_skia.h"
 #include "flutter/shell/platform/android/android_surface_software.h"
 #if IMPELLER_ENABLE_VULKAN  // b/258506856 for why this is behind an if
 #include "flutter/shell/platform/android/android_surface_vulkan_impeller.h"
+#include "flutter/shell/platform/android/image_external_texture_vk.h"
 #endif
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
+#include "flutter/shell/platform/android/image_external_texture_gl.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "flutter/shell/platform/android/platform_message_response_android.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 #include "flutter/shell/platform/android/surface/snapshot_surface_producer.h"
+#include "flutter/shell/platform/android/surface_control_overlay_compositor.h"
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
 namespace flutter {
@@ -32,10 +37,14 @@ namespace flutter {
 AndroidSurfaceFactoryImpl::AndroidSurfaceFactoryImpl(
     const std::shared_ptr<AndroidContext>& context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-    bool enable_impeller)
+    bool enable_impeller,
+    bool impeller_vulkan_low_latency,
+    size_t impeller_vulkan_frames_in_flight)
     : android_context_(context),
       jni_facade_(std::move(jni_facade)),
-      enable_impeller_(enable_impeller) {}
+      enable_impeller_(enable_impeller),
+      impeller_vulkan_low_latency_(impeller_vulkan_low_latency),
+      impeller_vulkan_frames_in_flight_(impeller_vulkan_frames_in_flight) {}
 
 AndroidSurfaceFactoryImpl::~AndroidSurfaceFactoryImpl() = default;
 
@@ -48,8 +57,9 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
       if (enable_impeller_) {
 // TODO(kaushikiska@): Enable this after wiring a preference for Vulkan backend.
 #if false
-        return std::make_unique<AndroidSurfaceVulkanImpeller>(android_context_,
-                                                              jni_facade_);
+        return std::make_unique<AndroidSurfaceVulkanImpeller>(
+            android_context_, jni_facade_, impeller_vulkan_low_latency_,
+            impeller_vulkan_frames_in_flight_);
 
 #else
         return std::make_unique<AndroidSurfaceGLImpeller>(android_context_,
@@ -113,14 +123,29 @@ PlatformViewAndroid::PlatformViewAndroid(
   if (android_context_) {
     FML_CHECK(android_context_->IsValid())
         << "Could not create surface from invalid Android context.";
+    const Settings& settings = delegate.OnPlatformViewGetSettings();
     surface_factory_ = std::make_shared<AndroidSurfaceFactoryImpl>(
-        android_context_, jni_facade_,
-        delegate.OnPlatformViewGetSettings().enable_impeller);
+        android_context_, jni_facade_, settings.enable_impeller,
+        settings.impeller_vulkan_low_latency,
+        settings.impeller_vulkan_frames_in_flight);
     android_surface_ = surface_factory_->CreateSurface();
 
     FML_CHECK(android_surface_ && android_surface_->IsValid())
         << "Could not create an OpenGL, Vulkan or Software surface to set up "
            "rendering.";
+
+    if (settings.enable_surface_control) {
+      // The overlays are rendered by Skia's OpenGL ES backend.
+      if (!settings.enable_impeller &&
+          android_context_->RenderingApi() == AndroidRenderingAPI::kOpenGLES &&
+          SurfaceControlOverlayCompositor::IsSupported()) {
+        overlay_compositor_ =
+            std::make_shared<SurfaceControlOverlayCompositor>();
+      } else {
+        FML_LOG(INFO) << "SurfaceControl composition is only supported by "
+                         "Skia's OpenGL ES backend on API 29+.";
+      }
+    }
   }
 }
 
@@ -128,6 +153,10 @@ PlatformViewAndroid::~PlatformViewAndroid() = default;
 
 void PlatformViewAndroid::NotifyCreated(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  native_window_ = native_window;
+  if (native_window_ && preferred_frame_rate_ > 0.0) {
+    native_window_->SetFrameRate(preferred_frame_rate_);
+  }
   if (android_surface_) {
     InstallFirstFrameCallback();
 
@@ -147,6 +176,10 @@ void PlatformViewAndroid::NotifyCreated(
 
 void PlatformViewAndroid::NotifySurfaceWindowChanged(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  native_window_ = native_window;
+  if (native_window_ && preferred_frame_rate_ > 0.0) {
+    native_window_->SetFrameRate(preferred_frame_rate_);
+  }
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
     fml::TaskRunner::RunNowOrPostTask(
@@ -163,6 +196,7 @@ void PlatformViewAndroid::NotifySurfaceWindowChanged(
 
 void PlatformViewAndroid::NotifyDestroyed() {
   PlatformView::NotifyDestroyed();
+  native_window_ = nullptr;
 
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
@@ -176,6 +210,46 @@ void PlatformViewAndroid::NotifyDestroyed() {
   }
 }
 
+void PlatformViewAndroid::SetPreferredFrameRate(double frame_rate) {
+  preferred_frame_rate_ = frame_rate;
+  if (native_window_) {
+    native_window_->SetFrameRate(frame_rate);
+  }
+}
+
+bool PlatformViewAndroid::UsesSurfaceControlComposition() const {
+  return overlay_compositor_ != nullptr;
+}
+
+void PlatformViewAndroid::NotifyOverlayHostCreated(
+    fml::RefPtr<AndroidNativeWindow> native_window) {
+  if (!overlay_compositor_) {
+    return;
+  }
+  // The compositor is only used on the raster thread.
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [compositor = overlay_compositor_,
+       native_window = std::move(native_window)]() {
+        compositor->SetHostWindow(native_window);
+      });
+}
+
+void PlatformViewAndroid::NotifyOverlayHostDestroyed() {
+  if (!overlay_compositor_) {
+    return;
+  }
+  // The layers must be released before the window goes away.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [&latch, compositor = overlay_compositor_.get()]() {
+        compositor->SetHostWindow(nullptr);
+        latch.Signal();
+      });
+  latch.Wait();
+}
+
 void PlatformViewAndroid::NotifyChanged(const SkISize& size) {
   if (!android_surface_) {
     return;
@@ -275,9 +349,54 @@ void PlatformViewAndroid::RegisterExternalTexture(
   }
 }
 
+void PlatformViewAndroid::RegisterImageTexture(
+    int64_t texture_id,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry) {
+  if (!AndroidHardwareBuffer::IsAvailable()) {
+    FML_LOG(INFO) << "Image textures require AHardwareBuffer support.";
+    return;
+  }
+  if (!delegate_.OnPlatformViewGetSettings().enable_impeller) {
+    if (android_context_->RenderingApi() == AndroidRenderingAPI::kOpenGLES) {
+      RegisterTexture(std::make_shared<ImageExternalTextureGL>(
+          texture_id, image_texture_entry, jni_facade_));
+      return;
+    }
+    FML_LOG(INFO) << "Attempted to use an image texture in a non GL context.";
+    return;
+  }
+#if IMPELLER_ENABLE_VULKAN
+  auto impeller_context = GetImpellerContext();
+  if (impeller_context && impeller_context->GetBackendType() ==
+                              impeller::Context::BackendType::kVulkan) {
+    RegisterTexture(std::make_shared<ImageExternalTextureVK>(
+        texture_id, image_texture_entry, jni_facade_));
+    return;
+  }
+#endif
+  FML_LOG(INFO) << "Image textures are only supported by Impeller's Vulkan "
+                   "backend.";
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewAndroid::CreateVSyncWaiter() {
-  return std::make_unique<VsyncWaiterAndroid>(task_runners_);
+  if (!GetSettings().enable_frame_rate_hints) {
+    return std::make_unique<VsyncWaiterAndroid>(task_runners_);
+  }
+  // The window is only used on the platform thread.
+  auto on_preferred_frame_rate =
+      [weak_platform_view = GetWeakPtr(),
+       platform_task_runner = task_runners_.GetPlatformTaskRunner()](
+          double frame_rate) {
+        platform_task_runner->PostTask([weak_platform_view, frame_rate]() {
+          if (weak_platform_view) {
+            static_cast<PlatformViewAndroid*>(weak_platform_view.get())
+                ->SetPreferredFrameRate(frame_rate);
+          }
+        });
+      };
+  return std::make_unique<VsyncWaiterAndroid>(
+      task_runners_, std::move(on_preferred_frame_rate));
 }
 
 // |PlatformView|
@@ -293,7 +412,8 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_, task_runners_);
+      *android_context_, jni_facade_, surface_factory_, task_runners_,
+      overlay_compositor_);
 }
 
 // |PlatformView|
@@ -24,11 +24,15 @@
 
 namespace flutter {
 
+class SurfaceControlOverlayCompositor;
+
 class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  public:
   AndroidSurfaceFactoryImpl(const std::shared_ptr<AndroidContext>& context,
                             std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-                            bool enable_impeller);
+                            bool enable_impeller,
+                            bool impeller_vulkan_low_latency = true,
+                            size_t impeller_vulkan_frames_in_flight = 2u);
 
   ~AndroidSurfaceFactoryImpl() override;
 
@@ -38,6 +42,8 @@ class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
   const std::shared_ptr<AndroidContext>& android_context_;
   std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
   const bool enable_impeller_;
+  const bool impeller_vulkan_low_latency_;
+  const size_t impeller_vulkan_frames_in_flight_;
 };
 
 class PlatformViewAndroid final : public PlatformView {
@@ -73,6 +79,24 @@ class PlatformViewAndroid final : public PlatformView {
   // |PlatformView|
   void NotifyDestroyed() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the overlays of platform views are presented through
+  ///             SurfaceControl in the window registered with
+  ///             |NotifyOverlayHostCreated|, without thread merging.
+  ///
+  bool UsesSurfaceControlComposition() const;
+
+  void NotifyOverlayHostCreated(fml::RefPtr<AndroidNativeWindow> native_window);
+
+  void NotifyOverlayHostDestroyed();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the display to run at |frame_rate| while the window of
+  ///             the Flutter view is shown, or at its full refresh rate if
+  ///             |frame_rate| is 0. Ignored below API 30.
+  ///
+  void SetPreferredFrameRate(double frame_rate);
+
   void DispatchPlatformMessage(JNIEnv* env,
                                std::string name,
                                jobject message_data,
@@ -93,6 +117,10 @@ class PlatformViewAndroid final : public PlatformView {
       int64_t texture_id,
       const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture);
 
+  void RegisterImageTexture(
+      int64_t texture_id,
+      const fml::jni::ScopedJavaGlobalRef<jobject>& image_texture_entry);
+
   // |PlatformView|
   void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
@@ -127,6 +155,15 @@ class PlatformViewAndroid final : public PlatformView {
   std::unique_ptr<AndroidSurface> android_surface_;
   std::shared_ptr<PlatformMessageHandlerAndroid> platform_message_handler_;
 
+  // Presents the overlays of platform views if SurfaceControl composition is
+  // enabled and supported, or nullptr.
+  std::shared_ptr<SurfaceControlOverlayCompositor> overlay_compositor_;
+
+  // The window of the Flutter view while it has one, which the preferred frame
+  // rate is applied to.
+  fml::RefPtr<AndroidNativeWindow> native_window_;
+  double preferred_frame_rate_ = 0.0;
+
   // |PlatformView|
   void UpdateSemantics(
       flutter::SemanticsNodeUpdates update,
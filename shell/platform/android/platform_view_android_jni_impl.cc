@@ -47,6 +47,14 @@ static fml::jni::ScopedJavaGlobalRef<jclass>* g_java_weak_reference_class =
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_texture_wrapper_class = nullptr;
 
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_image_texture_entry_class =
+    nullptr;
+
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_image_class = nullptr;
+
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_hardware_buffer_class =
+    nullptr;
+
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_java_long_class = nullptr;
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_bitmap_class = nullptr;
@@ -104,6 +112,14 @@ static jmethodID g_get_transform_matrix_method = nullptr;
 
 static jmethodID g_detach_from_gl_context_method = nullptr;
 
+static jmethodID g_acquire_latest_image_method = nullptr;
+
+static jmethodID g_image_get_hardware_buffer_method = nullptr;
+
+static jmethodID g_image_close_method = nullptr;
+
+static jmethodID g_hardware_buffer_close_method = nullptr;
+
 static jmethodID g_compute_platform_resolved_locale_method = nullptr;
 
 static jmethodID g_request_dart_deferred_library_method = nullptr;
@@ -243,6 +259,33 @@ static void SurfaceDestroyed(JNIEnv* env, jobject jcaller, jlong shell_holder) {
   ANDROID_SHELL_HOLDER->GetPlatformView()->NotifyDestroyed();
 }
 
+static jboolean UsesSurfaceControlComposition(JNIEnv* env,
+                                              jobject jcaller,
+                                              jlong shell_holder) {
+  return ANDROID_SHELL_HOLDER->GetPlatformView()
+      ->UsesSurfaceControlComposition();
+}
+
+static void OverlayHostSurfaceCreated(JNIEnv* env,
+                                      jobject jcaller,
+                                      jlong shell_holder,
+                                      jobject jsurface) {
+  // Note: This frame ensures that any local references used by
+  // ANativeWindow_fromSurface are released immediately. This is needed as a
+  // workaround for https://code.google.com/p/android/issues/detail?id=68174
+  fml::jni::ScopedJavaLocalFrame scoped_local_reference_frame(env);
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(
+      ANativeWindow_fromSurface(env, jsurface));
+  ANDROID_SHELL_HOLDER->GetPlatformView()->NotifyOverlayHostCreated(
+      std::move(window));
+}
+
+static void OverlayHostSurfaceDestroyed(JNIEnv* env,
+                                        jobject jcaller,
+                                        jlong shell_holder) {
+  ANDROID_SHELL_HOLDER->GetPlatformView()->NotifyOverlayHostDestroyed();
+}
+
 static void RunBundleAndSnapshotFromLibrary(JNIEnv* env,
                                             jobject jcaller,
                                             jlong shell_holder,
@@ -465,6 +508,17 @@ static void RegisterTexture(JNIEnv* env,
   );
 }
 
+static void RegisterImageTexture(JNIEnv* env,
+                                 jobject jcaller,
+                                 jlong shell_holder,
+                                 jlong texture_id,
+                                 jobject image_texture_entry) {
+  ANDROID_SHELL_HOLDER->GetPlatformView()->RegisterImageTexture(
+      static_cast<int64_t>(texture_id),                                 //
+      fml::jni::ScopedJavaGlobalRef<jobject>(env, image_texture_entry)  //
+  );
+}
+
 static void MarkTextureFrameAvailable(JNIEnv* env,
                                       jobject jcaller,
                                       jlong shell_holder,
@@ -510,6 +564,25 @@ static void NotifyLowMemoryWarning(JNIEnv* env,
   ANDROID_SHELL_HOLDER->NotifyLowMemoryWarning();
 }
 
+// Maps the level of android.content.ComponentCallbacks2#onTrimMemory.
+static void NotifyMemoryPressure(JNIEnv* env,
+                                 jobject obj,
+                                 jlong shell_holder,
+                                 jint trim_level) {
+  // ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW
+  constexpr jint kTrimMemoryRunningLow = 10;
+  // ComponentCallbacks2.TRIM_MEMORY_UI_HIDDEN
+  constexpr jint kTrimMemoryUiHidden = 20;
+
+  MemoryPressureLevel level = MemoryPressureLevel::kModerate;
+  if (trim_level >= kTrimMemoryUiHidden) {
+    level = MemoryPressureLevel::kBackground;
+  } else if (trim_level >= kTrimMemoryRunningLow) {
+    level = MemoryPressureLevel::kCritical;
+  }
+  ANDROID_SHELL_HOLDER->NotifyMemoryPressure(level);
+}
+
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
@@ -669,6 +742,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(J)V",
           .fnPtr = reinterpret_cast<void*>(&NotifyLowMemoryWarning),
       },
+      {
+          .name = "nativeNotifyMemoryPressure",
+          .signature = "(JI)V",
+          .fnPtr = reinterpret_cast<void*>(&NotifyMemoryPressure),
+      },
 
       // Start of methods from FlutterView
       {
@@ -696,6 +774,21 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(J)V",
           .fnPtr = reinterpret_cast<void*>(&SurfaceDestroyed),
       },
+      {
+          .name = "nativeUsesSurfaceControlComposition",
+          .signature = "(J)Z",
+          .fnPtr = reinterpret_cast<void*>(&UsesSurfaceControlComposition),
+      },
+      {
+          .name = "nativeOverlayHostSurfaceCreated",
+          .signature = "(JLandroid/view/Surface;)V",
+          .fnPtr = reinterpret_cast<void*>(&OverlayHostSurfaceCreated),
+      },
+      {
+          .name = "nativeOverlayHostSurfaceDestroyed",
+          .signature = "(J)V",
+          .fnPtr = reinterpret_cast<void*>(&OverlayHostSurfaceDestroyed),
+      },
       {
           .name = "nativeSetViewportMetrics",
           .signature = "(JFIIIIIIIIIIIIIII[I[I[I)V",
@@ -732,6 +825,12 @@ bool RegisterApi(JNIEnv* env) {
                        "WeakReference;)V",
           .fnPtr = reinterpret_cast<void*>(&RegisterTexture),
       },
+      {
+          .name = "nativeRegisterImageTexture",
+          .signature = "(JJLjava/lang/ref/"
+                       "WeakReference;)V",
+          .fnPtr = reinterpret_cast<void*>(&RegisterImageTexture),
+      },
       {
           .name = "nativeMarkTextureFrameAvailable",
           .signature = "(JJ)V",
@@ -1112,6 +1211,51 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
+  g_image_texture_entry_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("io/flutter/embedding/engine/renderer/"
+                          "FlutterRenderer$ImageTextureRegistryEntry"));
+  if (g_image_texture_entry_class->is_null()) {
+    FML_LOG(ERROR) << "Could not locate ImageTextureRegistryEntry class";
+    return false;
+  }
+
+  g_acquire_latest_image_method =
+      env->GetMethodID(g_image_texture_entry_class->obj(), "acquireLatestImage",
+                       "()Landroid/media/Image;");
+  if (g_acquire_latest_image_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate acquireLatestImage method";
+    return false;
+  }
+
+  g_image_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("android/media/Image"));
+  if (g_image_class->is_null()) {
+    FML_LOG(ERROR) << "Could not locate Image class";
+    return false;
+  }
+
+  g_image_close_method = env->GetMethodID(g_image_class->obj(), "close", "()V");
+  if (g_image_close_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate Image.close method";
+    return false;
+  }
+
+  // HardwareBuffers are only available from API 28. Image textures are not
+  // registered on older devices, so the lookups are allowed to fail.
+  g_image_get_hardware_buffer_method =
+      env->GetMethodID(g_image_class->obj(), "getHardwareBuffer",
+                       "()Landroid/hardware/HardwareBuffer;");
+  fml::jni::ClearException(env);
+
+  g_hardware_buffer_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("android/hardware/HardwareBuffer"));
+  fml::jni::ClearException(env);
+  if (!g_hardware_buffer_class->is_null()) {
+    g_hardware_buffer_close_method =
+        env->GetMethodID(g_hardware_buffer_class->obj(), "close", "()V");
+    fml::jni::ClearException(env);
+  }
+
   g_compute_platform_resolved_locale_method = env->GetMethodID(
       g_flutter_jni_class->obj(), "computePlatformResolvedLocale",
       "([Ljava/lang/String;)[Ljava/lang/String;");
@@ -1405,6 +1549,66 @@ void PlatformViewAndroidJNIImpl::SurfaceTextureDetachFromGLContext(
   FML_CHECK(fml::jni::CheckException(env));
 }
 
+JavaLocalRef PlatformViewAndroidJNIImpl::ImageTextureEntryAcquireLatestImage(
+    JavaLocalRef image_texture_entry) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (image_texture_entry.is_null()) {
+    return JavaLocalRef();
+  }
+
+  fml::jni::ScopedJavaLocalRef<jobject> image_texture_entry_local_ref(
+      env, env->CallObjectMethod(image_texture_entry.obj(),
+                                 g_java_weak_reference_get_method));
+  if (image_texture_entry_local_ref.is_null()) {
+    return JavaLocalRef();
+  }
+
+  JavaLocalRef image(
+      env, env->CallObjectMethod(image_texture_entry_local_ref.obj(),
+                                 g_acquire_latest_image_method));
+  FML_CHECK(fml::jni::CheckException(env));
+  return image;
+}
+
+JavaLocalRef PlatformViewAndroidJNIImpl::ImageGetHardwareBuffer(
+    JavaLocalRef image) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (image.is_null() || g_image_get_hardware_buffer_method == nullptr) {
+    return JavaLocalRef();
+  }
+
+  JavaLocalRef hardware_buffer(
+      env,
+      env->CallObjectMethod(image.obj(), g_image_get_hardware_buffer_method));
+  FML_CHECK(fml::jni::CheckException(env));
+  return hardware_buffer;
+}
+
+void PlatformViewAndroidJNIImpl::ImageClose(JavaLocalRef image) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (image.is_null()) {
+    return;
+  }
+
+  env->CallVoidMethod(image.obj(), g_image_close_method);
+  FML_CHECK(fml::jni::CheckException(env));
+}
+
+void PlatformViewAndroidJNIImpl::HardwareBufferClose(
+    JavaLocalRef hardware_buffer) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (hardware_buffer.is_null() || g_hardware_buffer_close_method == nullptr) {
+    return;
+  }
+
+  env->CallVoidMethod(hardware_buffer.obj(), g_hardware_buffer_close_method);
+  FML_CHECK(fml::jni::CheckException(env));
+}
+
 void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int view_id,
     int x,
@@ -4,8 +4,39 @@
 
 #include "flutter/shell/platform/android/surface/android_native_window.h"
 
+#if FML_OS_ANDROID
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#endif  // FML_OS_ANDROID
+
 namespace flutter {
 
+#if FML_OS_ANDROID
+namespace {
+
+// Only available on API 30+
+typedef int32_t (*ANativeWindow_setFrameRate_FPN)(ANativeWindow* window,
+                                                 float frame_rate,
+                                                 int8_t compatibility);
+
+// ANATIVEWINDOW_FRAME_RATE_COMPATIBILITY_DEFAULT.
+constexpr int8_t kFrameRateCompatibilityDefault = 0;
+
+ANativeWindow_setFrameRate_FPN GetSetFrameRateFunction() {
+  static ANativeWindow_setFrameRate_FPN set_frame_rate = []() {
+    auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+    FML_DCHECK(libandroid);
+    return libandroid
+        ->ResolveFunction<ANativeWindow_setFrameRate_FPN>(
+            "ANativeWindow_setFrameRate")
+        .value_or(nullptr);
+  }();
+  return set_frame_rate;
+}
+
+}  // namespace
+#endif  // FML_OS_ANDROID
+
 AndroidNativeWindow::AndroidNativeWindow(Handle window, bool is_fake_window)
     : window_(window), is_fake_window_(is_fake_window) {}
 
@@ -39,4 +70,17 @@ SkISize AndroidNativeWindow::GetSize() const {
 #endif  // FML_OS_ANDROID
 }
 
+bool AndroidNativeWindow::SetFrameRate(float frame_rate) const {
+#if FML_OS_ANDROID
+  auto set_frame_rate = GetSetFrameRateFunction();
+  if (window_ == nullptr || set_frame_rate == nullptr) {
+    return false;
+  }
+  return set_frame_rate(window_, frame_rate, kFrameRateCompatibilityDefault) ==
+         0;
+#else   // FML_OS_ANDROID
+  return false;
+#endif  // FML_OS_ANDROID
+}
+
 }  // namespace flutter
@@ -32,6 +32,15 @@ class AndroidNativeWindow
 
   SkISize GetSize() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the display to run at |frame_rate| frames per second
+  ///             while the window is shown, or removes the request if
+  ///             |frame_rate| is 0.
+  ///
+  /// @return     Whether it was asked. Always false below API 30.
+  ///
+  bool SetFrameRate(float frame_rate) const;
+
   /// Returns true when this AndroidNativeWindow is not backed by a real window
   /// (used for testing).
   bool IsFakeWindow() const { return is_fake_window_; }
@@ -0,0 +1,387 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/surface_control_overlay_compositor.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/shell/platform/android/android_hardware_buffer.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLTypes.h"
+
+namespace flutter {
+
+bool SurfaceControlOverlayCompositor::IsSupported() {
+  return AndroidSurfaceControl::IsAvailable() &&
+         AndroidHardwareBuffer::IsAvailable() &&
+         eglGetProcAddress("eglGetNativeClientBufferANDROID") != nullptr &&
+         eglGetProcAddress("eglDupNativeFenceFDANDROID") != nullptr;
+}
+
+SurfaceControlOverlayCompositor::SurfaceControlOverlayCompositor()
+    : release_fences_(std::make_shared<ReleaseFences>()) {}
+
+SurfaceControlOverlayCompositor::~SurfaceControlOverlayCompositor() {
+  ReleaseLayers();
+}
+
+bool SurfaceControlOverlayCompositor::LoadProcs() {
+  if (procs_loaded_) {
+    return image_target_texture_ != nullptr;
+  }
+  procs_loaded_ = true;
+  get_native_client_buffer_ =
+      reinterpret_cast<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
+          eglGetProcAddress("eglGetNativeClientBufferANDROID"));
+  create_image_ = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(
+      eglGetProcAddress("eglCreateImageKHR"));
+  destroy_image_ = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(
+      eglGetProcAddress("eglDestroyImageKHR"));
+  create_sync_ = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(
+      eglGetProcAddress("eglCreateSyncKHR"));
+  destroy_sync_ = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(
+      eglGetProcAddress("eglDestroySyncKHR"));
+  wait_sync_ = reinterpret_cast<PFNEGLWAITSYNCKHRPROC>(
+      eglGetProcAddress("eglWaitSyncKHR"));
+  dup_native_fence_fd_ = reinterpret_cast<PFNEGLDUPNATIVEFENCEFDANDROIDPROC>(
+      eglGetProcAddress("eglDupNativeFenceFDANDROID"));
+  image_target_texture_ =
+      reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+          eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+  if (!get_native_client_buffer_ || !create_image_ || !destroy_image_ ||
+      !create_sync_ || !destroy_sync_ || !wait_sync_ ||
+      !dup_native_fence_fd_ || !image_target_texture_) {
+    FML_LOG(ERROR) << "EGL can't render into hardware buffers.";
+    image_target_texture_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void SurfaceControlOverlayCompositor::SetHostWindow(
+    fml::RefPtr<AndroidNativeWindow> window) {
+  if (window == host_window_) {
+    return;
+  }
+  ReleaseLayers();
+  host_window_ = std::move(window);
+}
+
+// |OverlayCompositor|
+bool SurfaceControlOverlayCompositor::IsAvailable() {
+  return host_window_ && host_window_->IsValid() && LoadProcs();
+}
+
+// |OverlayCompositor|
+std::unique_ptr<SurfaceFrame> SurfaceControlOverlayCompositor::AcquireFrame(
+    GrDirectContext* context,
+    size_t index,
+    const SkRect& rect,
+    const SkISize& frame_size) {
+  TRACE_EVENT0("flutter", "SurfaceControlOverlayCompositor::AcquireFrame");
+  if (!context || !IsAvailable()) {
+    return nullptr;
+  }
+  display_ = eglGetCurrentDisplay();
+
+  while (layers_.size() <= index) {
+    ASurfaceControl* surface_control = AndroidSurfaceControl::CreateFromWindow(
+        host_window_->handle(), "FlutterOverlay");
+    if (!surface_control) {
+      FML_LOG(ERROR) << "Failed to create a surface control for an overlay.";
+      return nullptr;
+    }
+    layers_.emplace_back();
+    layers_.back().surface_control = surface_control;
+  }
+
+  Layer& layer = layers_[index];
+  // Buffers cover the whole frame so that they can be reused while the
+  // overlay moves and resizes within the frame.
+  if (layer.size != frame_size) {
+    DestroyBuffers(layer);
+    layer.size = frame_size;
+  }
+  Buffer* buffer = GetNextBuffer(context, layer);
+  if (!buffer) {
+    return nullptr;
+  }
+  WaitForRelease(buffer->hardware_buffer);
+
+  SkIRect overlay_rect = rect.roundOut();
+  // The overlay is rendered at the origin of the buffer.
+  SkCanvas* canvas = buffer->surface->getCanvas();
+  canvas->restoreToCount(1);
+  canvas->resetMatrix();
+  canvas->save();
+  canvas->clipRect(SkRect::Make(SkIRect::MakeSize(overlay_rect.size())));
+
+  SurfaceFrame::SubmitCallback submit_callback =
+      [this, index, overlay_rect, hardware_buffer = buffer->hardware_buffer](
+          const SurfaceFrame& surface_frame, SkCanvas* canvas) {
+        canvas->flush();
+        pending_buffers_.push_back({
+            index,
+            overlay_rect,
+            hardware_buffer,
+            CreateAcquireFence(),
+        });
+        return true;
+      };
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  return std::make_unique<SurfaceFrame>(buffer->surface, framebuffer_info,
+                                        submit_callback, frame_size);
+}
+
+SurfaceControlOverlayCompositor::Buffer*
+SurfaceControlOverlayCompositor::GetNextBuffer(GrDirectContext* context,
+                                               Layer& layer) {
+  if (layer.buffers.empty()) {
+    layer.buffers.resize(kBufferCount);
+  }
+  // Never render into the buffer on screen.
+  if (layer.buffers[layer.next_buffer].hardware_buffer != nullptr &&
+      layer.buffers[layer.next_buffer].hardware_buffer ==
+          layer.presented_buffer) {
+    layer.next_buffer = (layer.next_buffer + 1) % kBufferCount;
+  }
+  Buffer& buffer = layer.buffers[layer.next_buffer];
+  layer.next_buffer = (layer.next_buffer + 1) % kBufferCount;
+  if (!buffer.surface && !CreateBuffer(context, layer.size, buffer)) {
+    return nullptr;
+  }
+  return &buffer;
+}
+
+bool SurfaceControlOverlayCompositor::CreateBuffer(GrDirectContext* context,
+                                                   const SkISize& size,
+                                                   Buffer& buffer) {
+  AHardwareBuffer_Desc desc = {};
+  desc.width = size.width();
+  desc.height = size.height();
+  desc.layers = 1;
+  desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+  desc.usage = AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+               AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT |
+               AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY;
+  buffer.hardware_buffer = AndroidHardwareBuffer::Allocate(desc);
+  if (!buffer.hardware_buffer) {
+    FML_LOG(ERROR) << "Failed to allocate a hardware buffer for an overlay.";
+    return false;
+  }
+
+  EGLClientBuffer client_buffer =
+      get_native_client_buffer_(buffer.hardware_buffer);
+  const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  buffer.egl_image = create_image_(display_, EGL_NO_CONTEXT,
+                                   EGL_NATIVE_BUFFER_ANDROID, client_buffer,
+                                   attributes);
+  if (buffer.egl_image == EGL_NO_IMAGE_KHR) {
+    FML_LOG(ERROR) << "Failed to import hardware buffer: EGL error "
+                   << eglGetError();
+    return false;
+  }
+
+  glGenTextures(1, &buffer.texture_name);
+  glBindTexture(GL_TEXTURE_2D, buffer.texture_name);
+  image_target_texture_(GL_TEXTURE_2D, buffer.egl_image);
+  // Skia needs to know that the texture binding changed behind its back.
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_2D, buffer.texture_name,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(size.width(), size.height(),
+                                   GrMipMapped::kNo, texture_info);
+  SkSurfaceProps surface_properties(0, kUnknown_SkPixelGeometry);
+  buffer.surface = SkSurface::MakeFromBackendTexture(
+      context,                   // context
+      backend_texture,           // back-end texture
+      kTopLeft_GrSurfaceOrigin,  // surface origin
+      1,                         // sample count
+      kRGBA_8888_SkColorType,    // color type
+      SkColorSpace::MakeSRGB(),  // color space
+      &surface_properties        // surface properties
+  );
+  if (!buffer.surface) {
+    FML_LOG(ERROR) << "Failed to wrap a hardware buffer in a Skia surface.";
+    return false;
+  }
+  return true;
+}
+
+void SurfaceControlOverlayCompositor::DestroyBuffers(Layer& layer) {
+  // Textures can only be deleted while the context that created them is
+  // current. Otherwise they are released along with the context.
+  bool has_context = eglGetCurrentContext() != EGL_NO_CONTEXT;
+  for (Buffer& buffer : layer.buffers) {
+    buffer.surface.reset();
+    if (buffer.texture_name != 0 && has_context) {
+      glDeleteTextures(1, &buffer.texture_name);
+    }
+    if (buffer.egl_image != EGL_NO_IMAGE_KHR) {
+      destroy_image_(display_, buffer.egl_image);
+    }
+    if (buffer.hardware_buffer) {
+      {
+        std::scoped_lock lock(release_fences_->mutex);
+        release_fences_->fences.erase(buffer.hardware_buffer);
+      }
+      // The system compositor keeps its own reference while the buffer is
+      // on screen.
+      AndroidHardwareBuffer::Release(buffer.hardware_buffer);
+    }
+  }
+  layer.buffers.clear();
+  layer.next_buffer = 0;
+}
+
+void SurfaceControlOverlayCompositor::WaitForRelease(AHardwareBuffer* buffer) {
+  fml::UniqueFD release_fence;
+  {
+    std::scoped_lock lock(release_fences_->mutex);
+    auto found = release_fences_->fences.find(buffer);
+    if (found == release_fences_->fences.end()) {
+      return;
+    }
+    release_fence = std::move(found->second);
+    release_fences_->fences.erase(found);
+  }
+  const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID,
+                               release_fence.get(), EGL_NONE};
+  EGLSyncKHR sync =
+      create_sync_(display_, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+  if (sync == EGL_NO_SYNC_KHR) {
+    FML_LOG(ERROR) << "Failed to import a release fence: EGL error "
+                   << eglGetError();
+    return;
+  }
+  // The sync owns the fence from here on.
+  static_cast<void>(release_fence.release());
+  wait_sync_(display_, sync, 0);
+  destroy_sync_(display_, sync);
+}
+
+fml::UniqueFD SurfaceControlOverlayCompositor::CreateAcquireFence() {
+  const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID,
+                               EGL_NO_NATIVE_FENCE_FD_ANDROID, EGL_NONE};
+  EGLSyncKHR sync =
+      create_sync_(display_, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+  if (sync == EGL_NO_SYNC_KHR) {
+    // Without a fence, the buffer mustn't be presented before it is fully
+    // rendered.
+    glFinish();
+    return fml::UniqueFD();
+  }
+  // The fence is only created once the commands before it are flushed.
+  glFlush();
+  fml::UniqueFD fence(dup_native_fence_fd_(display_, sync));
+  destroy_sync_(display_, sync);
+  if (!fence.is_valid()) {
+    glFinish();
+  }
+  return fence;
+}
+
+// |OverlayCompositor|
+void SurfaceControlOverlayCompositor::Present() {
+  TRACE_EVENT0("flutter", "SurfaceControlOverlayCompositor::Present");
+  if (!IsAvailable()) {
+    pending_buffers_.clear();
+    return;
+  }
+
+  ASurfaceTransaction* transaction = AndroidSurfaceControl::CreateTransaction();
+  auto transaction_context = std::make_unique<TransactionContext>();
+  transaction_context->release_fences = release_fences_;
+
+  std::vector<bool> used_layers(layers_.size(), false);
+  for (PendingBuffer& pending : pending_buffers_) {
+    Layer& layer = layers_[pending.index];
+    AndroidSurfaceControl::SetBuffer(transaction, layer.surface_control,
+                                     pending.hardware_buffer,
+                                     pending.acquire_fence.release());
+    ARect source = {0, 0, pending.rect.width(), pending.rect.height()};
+    ARect destination = {pending.rect.left(), pending.rect.top(),
+                         pending.rect.right(), pending.rect.bottom()};
+    AndroidSurfaceControl::SetGeometry(transaction, layer.surface_control,
+                                       source, destination);
+    if (!layer.visible) {
+      AndroidSurfaceControl::SetZOrder(transaction, layer.surface_control,
+                                       static_cast<int32_t>(pending.index));
+      AndroidSurfaceControl::SetVisibility(transaction, layer.surface_control,
+                                           true);
+      layer.visible = true;
+    }
+    if (layer.presented_buffer) {
+      transaction_context->replaced_buffers.emplace_back(
+          layer.surface_control, layer.presented_buffer);
+    }
+    layer.presented_buffer = pending.hardware_buffer;
+    used_layers[pending.index] = true;
+  }
+  pending_buffers_.clear();
+
+  for (size_t i = 0; i < layers_.size(); i++) {
+    if (!used_layers[i] && layers_[i].visible) {
+      AndroidSurfaceControl::SetVisibility(transaction,
+                                           layers_[i].surface_control, false);
+      layers_[i].visible = false;
+    }
+  }
+
+  AndroidSurfaceControl::SetOnComplete(transaction,
+                                       transaction_context.release(),
+                                       &OnTransactionComplete);
+  AndroidSurfaceControl::ApplyTransaction(transaction);
+  AndroidSurfaceControl::DeleteTransaction(transaction);
+}
+
+void SurfaceControlOverlayCompositor::OnTransactionComplete(
+    void* context,
+    ASurfaceTransactionStats* stats) {
+  std::unique_ptr<TransactionContext> transaction_context(
+      static_cast<TransactionContext*>(context));
+  std::scoped_lock lock(transaction_context->release_fences->mutex);
+  for (const auto& [surface_control, buffer] :
+       transaction_context->replaced_buffers) {
+    fml::UniqueFD fence(
+        AndroidSurfaceControl::GetPreviousReleaseFence(stats, surface_control));
+    if (fence.is_valid()) {
+      transaction_context->release_fences->fences[buffer] = std::move(fence);
+    }
+  }
+}
+
+// |OverlayCompositor|
+void SurfaceControlOverlayCompositor::Teardown() {
+  ReleaseLayers();
+}
+
+void SurfaceControlOverlayCompositor::ReleaseLayers() {
+  pending_buffers_.clear();
+  if (layers_.empty()) {
+    return;
+  }
+  // Released surface controls stay on screen as long as their parent does.
+  if (host_window_ && host_window_->IsValid()) {
+    ASurfaceTransaction* transaction =
+        AndroidSurfaceControl::CreateTransaction();
+    for (const Layer& layer : layers_) {
+      AndroidSurfaceControl::SetVisibility(transaction, layer.surface_control,
+                                           false);
+    }
+    AndroidSurfaceControl::ApplyTransaction(transaction);
+    AndroidSurfaceControl::DeleteTransaction(transaction);
+  }
+  for (Layer& layer : layers_) {
+    DestroyBuffers(layer);
+    AndroidSurfaceControl::Release(layer.surface_control);
+  }
+  layers_.clear();
+}
+
+}  // namespace flutter
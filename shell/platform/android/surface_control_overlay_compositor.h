@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_OVERLAY_COMPOSITOR_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_OVERLAY_COMPOSITOR_H_
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "flutter/shell/platform/android/android_surface_control.h"
+#include "flutter/shell/platform/android/external_view_embedder/overlay_compositor.h"
+#include "flutter/shell/platform/android/surface/android_native_window.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Presents the overlays of platform views as child surfaces of a host window
+/// through SurfaceControl transactions.
+///
+/// Each overlay layer is a surface control with its own hardware buffers,
+/// rendered by Skia's OpenGL ES backend. The buffers of all the layers are
+/// presented by a single transaction per frame, so the layers never show
+/// content of different frames.
+///
+class SurfaceControlOverlayCompositor final : public OverlayCompositor {
+ public:
+  // Whether SurfaceControl and the EGL functions needed to render into
+  // hardware buffers are available.
+  static bool IsSupported();
+
+  SurfaceControlOverlayCompositor();
+
+  ~SurfaceControlOverlayCompositor() override;
+
+  // Sets the window of the surface that hosts the overlay layers, or nullptr
+  // once that surface is destroyed. The layers in the previous window are
+  // released.
+  //
+  // Called on the raster thread.
+  void SetHostWindow(fml::RefPtr<AndroidNativeWindow> window);
+
+  // |OverlayCompositor|
+  bool IsAvailable() override;
+
+  // |OverlayCompositor|
+  std::unique_ptr<SurfaceFrame> AcquireFrame(
+      GrDirectContext* context,
+      size_t index,
+      const SkRect& rect,
+      const SkISize& frame_size) override;
+
+  // |OverlayCompositor|
+  void Present() override;
+
+  // |OverlayCompositor|
+  void Teardown() override;
+
+ private:
+  // The number of buffers of a layer. One is on screen, one may wait to be
+  // released by the system compositor, and one is rendered into.
+  static constexpr size_t kBufferCount = 3;
+
+  struct Buffer {
+    AHardwareBuffer* hardware_buffer = nullptr;
+    EGLImageKHR egl_image = EGL_NO_IMAGE_KHR;
+    GLuint texture_name = 0;
+    sk_sp<SkSurface> surface;
+  };
+
+  struct Layer {
+    ASurfaceControl* surface_control = nullptr;
+    // The size of |buffers|.
+    SkISize size = SkISize::MakeEmpty();
+    std::vector<Buffer> buffers;
+    size_t next_buffer = 0;
+    // The buffer shown by the layer, or nullptr.
+    AHardwareBuffer* presented_buffer = nullptr;
+    bool visible = false;
+  };
+
+  // A buffer to present in the next transaction.
+  struct PendingBuffer {
+    size_t index;
+    SkIRect rect;
+    AHardwareBuffer* hardware_buffer;
+    // Signals once the GPU finished rendering into the buffer.
+    fml::UniqueFD acquire_fence;
+  };
+
+  // The fences that signal once the buffers given back by the system
+  // compositor can be rendered into again. They are shared with the callbacks
+  // of transactions, which run on binder threads.
+  struct ReleaseFences {
+    std::mutex mutex;
+    std::unordered_map<AHardwareBuffer*, fml::UniqueFD> fences;
+  };
+
+  // The buffers that are replaced by a transaction on each layer.
+  struct TransactionContext {
+    std::shared_ptr<ReleaseFences> release_fences;
+    std::vector<std::pair<ASurfaceControl*, AHardwareBuffer*>>
+        replaced_buffers;
+  };
+
+  static void OnTransactionComplete(void* context,
+                                    ASurfaceTransactionStats* stats);
+
+  bool LoadProcs();
+
+  Buffer* GetNextBuffer(GrDirectContext* context, Layer& layer);
+
+  bool CreateBuffer(GrDirectContext* context,
+                    const SkISize& size,
+                    Buffer& buffer);
+
+  void DestroyBuffers(Layer& layer);
+
+  // Makes the GPU wait until the system compositor released |buffer|.
+  void WaitForRelease(AHardwareBuffer* buffer);
+
+  // Creates a fence that signals once the commands issued so far completed.
+  fml::UniqueFD CreateAcquireFence();
+
+  void ReleaseLayers();
+
+  bool procs_loaded_ = false;
+  PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC get_native_client_buffer_ = nullptr;
+  PFNEGLCREATEIMAGEKHRPROC create_image_ = nullptr;
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image_ = nullptr;
+  PFNGLEGLIMAGETARGETTEXTURE2DOESPROC image_target_texture_ = nullptr;
+  PFNEGLCREATESYNCKHRPROC create_sync_ = nullptr;
+  PFNEGLDESTROYSYNCKHRPROC destroy_sync_ = nullptr;
+  PFNEGLWAITSYNCKHRPROC wait_sync_ = nullptr;
+  PFNEGLDUPNATIVEFENCEFDANDROIDPROC dup_native_fence_fd_ = nullptr;
+
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  fml::RefPtr<AndroidNativeWindow> host_window_;
+  std::vector<Layer> layers_;
+  std::vector<PendingBuffer> pending_buffers_;
+  const std::shared_ptr<ReleaseFences> release_fences_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SurfaceControlOverlayCompositor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_OVERLAY_COMPOSITOR_H_
@@ -6,6 +6,7 @@ import static org.junit.Assert.assertNotNull;
 import static org.junit.Assert.assertNull;
 import static org.junit.Assert.assertThrows;
 import static org.mockito.ArgumentMatchers.any;
+import static org.mockito.ArgumentMatchers.anyInt;
 import static org.mockito.ArgumentMatchers.eq;
 import static org.mockito.ArgumentMatchers.isNotNull;
 import static org.mockito.ArgumentMatchers.isNull;
@@ -893,7 +894,7 @@ public class FlutterActivityAndFragmentDelegateTest {
     // Emulate the host and call the method that we expect to be forwarded.
     delegate.onTrimMemory(TRIM_MEMORY_RUNNING_MODERATE);
     delegate.onTrimMemory(TRIM_MEMORY_RUNNING_LOW);
-    verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyMemoryPressure(anyInt());
     verify(mockFlutterEngine.getSystemChannel(), times(0)).sendMemoryPressureWarning();
 
     delegate.onTrimMemory(TRIM_MEMORY_RUNNING_CRITICAL);
@@ -901,7 +902,7 @@ public class FlutterActivityAndFragmentDelegateTest {
     delegate.onTrimMemory(TRIM_MEMORY_COMPLETE);
     delegate.onTrimMemory(TRIM_MEMORY_MODERATE);
     delegate.onTrimMemory(TRIM_MEMORY_UI_HIDDEN);
-    verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyMemoryPressure(anyInt());
     verify(mockFlutterEngine.getSystemChannel(), times(0)).sendMemoryPressureWarning();
 
     verify(mockHost, times(0)).onFlutterUiDisplayed();
@@ -917,7 +918,8 @@ public class FlutterActivityAndFragmentDelegateTest {
     verify(mockHost, times(1)).onFlutterUiDisplayed();
 
     delegate.onTrimMemory(TRIM_MEMORY_RUNNING_MODERATE);
-    verify(mockFlutterEngine.getDartExecutor(), times(0)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(1))
+        .notifyMemoryPressure(TRIM_MEMORY_RUNNING_MODERATE);
     verify(mockFlutterEngine.getSystemChannel(), times(0)).sendMemoryPressureWarning();
 
     delegate.onTrimMemory(TRIM_MEMORY_RUNNING_LOW);
@@ -926,7 +928,7 @@ public class FlutterActivityAndFragmentDelegateTest {
     delegate.onTrimMemory(TRIM_MEMORY_COMPLETE);
     delegate.onTrimMemory(TRIM_MEMORY_MODERATE);
     delegate.onTrimMemory(TRIM_MEMORY_UI_HIDDEN);
-    verify(mockFlutterEngine.getDartExecutor(), times(6)).notifyLowMemoryWarning();
+    verify(mockFlutterEngine.getDartExecutor(), times(7)).notifyMemoryPressure(anyInt());
     verify(mockFlutterEngine.getSystemChannel(), times(6)).sendMemoryPressureWarning();
   }
 
@@ -1,5 +1,6 @@
 package io.flutter.embedding.engine.dart;
 
+import static android.content.ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW;
 import static junit.framework.TestCase.assertNotNull;
 import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertThrows;
@@ -65,6 +66,16 @@ public class DartExecutorTest {
     verify(mockFlutterJNI, times(1)).notifyLowMemoryWarning();
   }
 
+  @Test
+  public void itNotifiesMemoryPressure() {
+    FlutterJNI mockFlutterJNI = mock(FlutterJNI.class);
+    when(mockFlutterJNI.isAttached()).thenReturn(true);
+
+    DartExecutor dartExecutor = new DartExecutor(mockFlutterJNI, mock(AssetManager.class));
+    dartExecutor.notifyMemoryPressure(TRIM_MEMORY_RUNNING_LOW);
+    verify(mockFlutterJNI, times(1)).notifyMemoryPressure(TRIM_MEMORY_RUNNING_LOW);
+  }
+
   @Test
   public void itThrowsWhenCreatingADefaultDartEntrypointWithAnUninitializedFlutterLoader() {
     assertThrows(
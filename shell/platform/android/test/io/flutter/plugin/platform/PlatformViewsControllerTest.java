@@ -25,6 +25,7 @@ import android.widget.FrameLayout.LayoutParams;
 import androidx.test.core.app.ApplicationProvider;
 import androidx.test.ext.junit.runners.AndroidJUnit4;
 import io.flutter.embedding.android.FlutterImageView;
+import io.flutter.embedding.android.FlutterSurfaceView;
 import io.flutter.embedding.android.FlutterView;
 import io.flutter.embedding.android.MotionEventTracker;
 import io.flutter.embedding.android.RenderMode;
@@ -1210,6 +1211,65 @@ public class PlatformViewsControllerTest {
     disposePlatformView(jni, platformViewsController, platformViewId);
   }
 
+  @Test
+  @Config(shadows = {ShadowFlutterJNI.class, ShadowPlatformTaskQueue.class})
+  public void dontConvertRenderSurfaceWithSurfaceControlComposition() {
+    final PlatformViewsController platformViewsController = new PlatformViewsController();
+
+    final int platformViewId = 0;
+    assertNull(platformViewsController.getPlatformViewById(platformViewId));
+
+    final PlatformViewFactory viewFactory = mock(PlatformViewFactory.class);
+    final PlatformView platformView = mock(PlatformView.class);
+    final View androidView = mock(View.class);
+    when(platformView.getView()).thenReturn(androidView);
+    when(viewFactory.create(any(), eq(platformViewId), any())).thenReturn(platformView);
+
+    platformViewsController.getRegistry().registerViewFactory("testType", viewFactory);
+
+    final FlutterJNI jni = new FlutterJNI();
+    jni.attachToNative();
+    ShadowFlutterJNI.setUsesSurfaceControlComposition(true);
+    try {
+      final FlutterView flutterView = attach(jni, platformViewsController);
+
+      jni.onFirstFrame();
+
+      // Simulate create call from the framework.
+      createPlatformView(
+          jni, platformViewsController, platformViewId, "testType", /* hybrid=*/ true);
+
+      // Produce a frame that displays a platform view.
+      platformViewsController.onBeginFrame();
+      platformViewsController.onDisplayPlatformView(
+          platformViewId,
+          /* x=*/ 0,
+          /* y=*/ 0,
+          /* width=*/ 10,
+          /* height=*/ 10,
+          /* viewWidth=*/ 10,
+          /* viewHeight=*/ 10,
+          /* mutatorsStack=*/ new FlutterMutatorsStack());
+      platformViewsController.onEndFrame();
+
+      // The render surface, the overlay host and the platform view.
+      assertEquals(flutterView.getChildCount(), 3);
+      assertTrue(flutterView.getChildAt(0) instanceof FlutterSurfaceView);
+      assertTrue(flutterView.getChildAt(1) instanceof SurfaceView);
+      assertTrue(flutterView.getChildAt(2) instanceof FlutterMutatorView);
+      assertEquals(flutterView.getChildAt(2).getVisibility(), View.VISIBLE);
+
+      // Simulate dispose call from the framework.
+      disposePlatformView(jni, platformViewsController, platformViewId);
+
+      final View overlayHostView = flutterView.getChildAt(1);
+      platformViewsController.detachFromView();
+      assertEquals(flutterView.indexOfChild(overlayHostView), -1);
+    } finally {
+      ShadowFlutterJNI.setUsesSurfaceControlComposition(false);
+    }
+  }
+
   @Test
   @Config(shadows = {ShadowFlutterJNI.class, ShadowPlatformTaskQueue.class})
   public void reattachToFlutterView() {
@@ -1487,6 +1547,7 @@ public class PlatformViewsControllerTest {
   @Implements(FlutterJNI.class)
   public static class ShadowFlutterJNI {
     private static SparseArray<ByteBuffer> replies = new SparseArray<>();
+    private static boolean usesSurfaceControlComposition = false;
 
     public ShadowFlutterJNI() {}
 
@@ -1495,6 +1556,15 @@ public class PlatformViewsControllerTest {
       return false;
     }
 
+    @Implementation
+    public boolean usesSurfaceControlComposition() {
+      return usesSurfaceControlComposition;
+    }
+
+    public static void setUsesSurfaceControlComposition(boolean value) {
+      usesSurfaceControlComposition = value;
+    }
+
     @Implementation
     public long performNativeAttach(FlutterJNI flutterJNI) {
       return 1;
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -21,16 +22,34 @@ static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
 static std::atomic_uint g_refresh_rate_ = 60;
 
-VsyncWaiterAndroid::VsyncWaiterAndroid(const flutter::TaskRunners& task_runners)
+VsyncWaiterAndroid::VsyncWaiterAndroid(
+    const flutter::TaskRunners& task_runners,
+    PreferredFrameRateCallback on_preferred_frame_rate)
     : VsyncWaiter(task_runners),
       use_ndk_choreographer_(
-          AndroidChoreographer::ShouldUseNDKChoreographer()) {}
+          AndroidChoreographer::ShouldUseNDKChoreographer()),
+      use_frame_timelines_(AndroidChoreographer::SupportsFrameTimelines()),
+      on_preferred_frame_rate_(std::move(on_preferred_frame_rate)) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
+// |VsyncWaiter|
+void VsyncWaiterAndroid::SetPreferredFrameRate(double frame_rate) {
+  if (on_preferred_frame_rate_) {
+    on_preferred_frame_rate_(frame_rate);
+  }
+}
+
 // |VsyncWaiter|
 void VsyncWaiterAndroid::AwaitVSync() {
-  if (use_ndk_choreographer_) {
+  if (use_frame_timelines_) {
+    auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [weak_this]() {
+          AndroidChoreographer::PostVsyncCallback(&OnVsyncWithFrameTimelines,
+                                                  weak_this);
+        });
+  } else if (use_ndk_choreographer_) {
     auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
     fml::TaskRunner::RunNowOrPostTask(
         task_runners_.GetUITaskRunner(), [weak_this]() {
@@ -70,6 +89,64 @@ void VsyncWaiterAndroid::OnVsyncFromNDK(int64_t frame_nanos, void* data) {
   ConsumePendingCallback(weak_this, frame_time, target_time);
 }
 
+// static
+void VsyncWaiterAndroid::OnVsyncWithFrameTimelines(
+    const AndroidChoreographer::VsyncData& vsync_data,
+    void* data) {
+  auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(data);
+  auto shared_this = weak_this->lock();
+  if (!shared_this || vsync_data.frame_timelines.empty()) {
+    OnVsyncFromNDK(vsync_data.frame_time_nanos, data);
+    return;
+  }
+
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(vsync_data.frame_time_nanos));
+  auto now = fml::TimePoint::Now();
+  if (frame_time > now) {
+    frame_time = now;
+  }
+  const size_t index = SelectFrameTimeline(
+      vsync_data, shared_this->PredictFrameDuration(), now);
+  // The deadline of the selected timeline is the time by which the frame has
+  // to be rasterized, which is what the animator expects as the target time.
+  auto target_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(
+          vsync_data.frame_timelines[index].deadline_nanos));
+  if (target_time <= frame_time) {
+    target_time = frame_time + fml::TimeDelta::FromNanoseconds(
+                                   1000000000.0 / g_refresh_rate_);
+  }
+
+  TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
+                   frame_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   target_time.ToEpochDelta().ToMicroseconds());
+
+  ConsumePendingCallback(weak_this, frame_time, target_time);
+}
+
+// static
+size_t VsyncWaiterAndroid::SelectFrameTimeline(
+    const AndroidChoreographer::VsyncData& vsync_data,
+    std::optional<fml::TimeDelta> frame_duration,
+    fml::TimePoint now) {
+  const auto& timelines = vsync_data.frame_timelines;
+  FML_DCHECK(!timelines.empty());
+  if (!frame_duration.has_value()) {
+    return std::min(vsync_data.preferred_frame_timeline_index,
+                    timelines.size() - 1);
+  }
+  const int64_t earliest_deadline_nanos =
+      (now + frame_duration.value()).ToEpochDelta().ToNanoseconds();
+  for (size_t i = 0; i < timelines.size(); i++) {
+    if (timelines[i].deadline_nanos >= earliest_deadline_nanos) {
+      return i;
+    }
+  }
+  return timelines.size() - 1;
+}
+
 // static
 void VsyncWaiterAndroid::OnVsyncFromJava(JNIEnv* env,
                                          jclass jcaller,
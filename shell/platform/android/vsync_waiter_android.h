@@ -7,29 +7,57 @@
 
 #include <jni.h>
 
+#include <functional>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/platform/android/android_choreographer.h"
 
 namespace flutter {
 
-class AndroidChoreographer;
-
 class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
   static bool Register(JNIEnv* env);
 
-  explicit VsyncWaiterAndroid(const flutter::TaskRunners& task_runners);
+  /// Called on the UI thread with the frame rate preferred by the animator.
+  using PreferredFrameRateCallback = std::function<void(double frame_rate)>;
+
+  explicit VsyncWaiterAndroid(
+      const flutter::TaskRunners& task_runners,
+      PreferredFrameRateCallback on_preferred_frame_rate = nullptr);
 
   ~VsyncWaiterAndroid() override;
 
+  // |VsyncWaiter|
+  void SetPreferredFrameRate(double frame_rate) override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Picks the frame timeline of |vsync_data| with the earliest
+  ///             deadline that a frame starting at |now| and lasting
+  ///             |frame_duration| meets, or the last timeline if none does.
+  ///             Without a predicted duration, the timeline preferred by the
+  ///             system is picked.
+  ///
+  /// @return     The index of the timeline in |vsync_data.frame_timelines|.
+  ///
+  static size_t SelectFrameTimeline(
+      const AndroidChoreographer::VsyncData& vsync_data,
+      std::optional<fml::TimeDelta> frame_duration,
+      fml::TimePoint now);
+
  private:
   // |VsyncWaiter|
   void AwaitVSync() override;
 
   static void OnVsyncFromNDK(int64_t frame_nanos, void* data);
 
+  static void OnVsyncWithFrameTimelines(
+      const AndroidChoreographer::VsyncData& vsync_data,
+      void* data);
+
   static void OnVsyncFromJava(JNIEnv* env,
                               jclass jcaller,
                               jlong frameDelayNanos,
@@ -45,6 +73,10 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
                                   jfloat refresh_rate);
 
   const bool use_ndk_choreographer_;
+  const bool use_frame_timelines_;
+  // The frame rate can only be set on a window, which the vsync waiter doesn't
+  // know about.
+  const PreferredFrameRateCallback on_preferred_frame_rate_;
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterAndroid);
 };
 
@@ -0,0 +1,63 @@
+#include "flutter/shell/platform/android/vsync_waiter_android.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr int64_t kMillisecond = 1000000;
+
+// Three timelines 16ms apart, with deadlines at 10ms, 26ms and 42ms.
+AndroidChoreographer::VsyncData CreateVsyncData(
+    size_t preferred_frame_timeline_index) {
+  AndroidChoreographer::VsyncData vsync_data;
+  vsync_data.frame_time_nanos = 0;
+  for (int64_t i = 0; i < 3; i++) {
+    vsync_data.frame_timelines.push_back({
+        .expected_presentation_time_nanos = (16 + 16 * i) * kMillisecond,
+        .deadline_nanos = (10 + 16 * i) * kMillisecond,
+    });
+  }
+  vsync_data.preferred_frame_timeline_index = preferred_frame_timeline_index;
+  return vsync_data;
+}
+
+fml::TimePoint FromMilliseconds(int64_t milliseconds) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(milliseconds));
+}
+
+}  // namespace
+
+TEST(VsyncWaiterAndroid, SelectsPreferredFrameTimelineWithoutPrediction) {
+  ASSERT_EQ(VsyncWaiterAndroid::SelectFrameTimeline(
+                CreateVsyncData(1), std::nullopt, FromMilliseconds(0)),
+            1u);
+}
+
+TEST(VsyncWaiterAndroid, SelectsEarliestFrameTimelineThatFitsPrediction) {
+  auto vsync_data = CreateVsyncData(1);
+  ASSERT_EQ(VsyncWaiterAndroid::SelectFrameTimeline(
+                vsync_data, fml::TimeDelta::FromMilliseconds(8),
+                FromMilliseconds(1)),
+            0u);
+  ASSERT_EQ(VsyncWaiterAndroid::SelectFrameTimeline(
+                vsync_data, fml::TimeDelta::FromMilliseconds(20),
+                FromMilliseconds(1)),
+            1u);
+  ASSERT_EQ(VsyncWaiterAndroid::SelectFrameTimeline(
+                vsync_data, fml::TimeDelta::FromMilliseconds(20),
+                FromMilliseconds(8)),
+            2u);
+}
+
+TEST(VsyncWaiterAndroid, SelectsLastFrameTimelineIfNoneFitsPrediction) {
+  ASSERT_EQ(VsyncWaiterAndroid::SelectFrameTimeline(
+                CreateVsyncData(0), fml::TimeDelta::FromMilliseconds(100),
+                FromMilliseconds(0)),
+            2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -71,6 +71,7 @@ void AccessibilityBridge::CommitUpdates() {
   // Second, apply the pending node updates. This also moves reparented nodes to
   // their new parents if needed.
   ui::AXTreeUpdate update{.tree_data = tree_->data()};
+  update.nodes.reserve(pending_semantics_node_updates_.size());
 
   // Figure out update order, ui::AXTree only accepts update in tree order,
   // where parent node must come before the child node in
@@ -80,18 +81,21 @@ void AccessibilityBridge::CommitUpdates() {
   // lists in the reversed order, this guarantees parent updates always come
   // before child updates. If the root is in the update, it is guaranteed to
   // be the first node of the last list.
+  //
+  // Only the nodes of the update are visited, and they are moved rather than
+  // copied, so the cost of a commit is proportional to the number of nodes
+  // that changed rather than to the size of the tree.
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode>& sub_tree_list = results.emplace_back();
+    GetSubTreeList(std::move(target), sub_tree_list);
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFlutterUpdate(node, update);
     }
   }
@@ -215,7 +219,7 @@ std::optional<ui::AXTreeUpdate>
 AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
 
-  for (auto node_update : pending_semantics_node_updates_) {
+  for (const auto& node_update : pending_semantics_node_updates_) {
     for (int32_t child_id : node_update.second.children_in_traversal_order) {
       // Skip nodes that don't exist or have a parent in the current tree.
       ui::AXNode* child = tree_->GetFromId(child_id);
@@ -260,7 +264,8 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
       .nodes = std::vector<ui::AXNodeData>(),
   };
 
-  for (std::pair<int32_t, ui::AXNodeData> data : updates) {
+  update.nodes.reserve(updates.size());
+  for (auto& data : updates) {
     update.nodes.push_back(std::move(data.second));
   }
 
@@ -268,22 +273,35 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  // Walk the subtree in pre-order with an explicit stack of the indices of
+  // the nodes in |result| and of their next child, since semantics trees can
+  // be deeper than the native stack allows to recurse.
+  result.push_back(std::move(target));
+  std::vector<std::pair<size_t, size_t>> stack = {{result.size() - 1, 0}};
+  while (!stack.empty()) {
+    auto& [index, next_child] = stack.back();
+    const auto& children = result[index].children_in_traversal_order;
+    if (next_child == children.size()) {
+      stack.pop_back();
+      continue;
+    }
+    int32_t child = children[next_child++];
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      result.push_back(std::move(iter->second));
       pending_semantics_node_updates_.erase(iter);
+      stack.emplace_back(result.size() - 1, 0);
     }
   }
 }
 
 void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
                                                ui::AXTreeUpdate& tree_update) {
-  ui::AXNodeData node_data;
+  // Build the node data in place in the update, which ui::AXTree copies into
+  // the node.
+  ui::AXNodeData& node_data = tree_update.nodes.emplace_back();
   node_data.id = node.id;
   SetRoleFromFlutterUpdate(node_data, node);
   SetStateFromFlutterUpdate(node_data, node);
@@ -303,11 +321,9 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
       node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
       node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
       0, 0);
-  for (auto child : node.children_in_traversal_order) {
-    node_data.child_ids.push_back(child);
-  }
+  node_data.child_ids.assign(node.children_in_traversal_order.begin(),
+                             node.children_in_traversal_order.end());
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "accessibility_bridge.h"
+#include "test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+// Each node that is not a leaf has this many children, like the rows of the
+// sections of a long form.
+constexpr int32_t kFanout = 8;
+
+// A complete tree of semantics nodes in which the children of node |i| are
+// the nodes |i * kFanout + 1| to |i * kFanout + kFanout|.
+class SemanticsTree {
+ public:
+  explicit SemanticsTree(int32_t node_count)
+      : children_(node_count), labels_(node_count) {
+    for (int32_t id = 0; id < node_count; id++) {
+      for (int32_t i = 1; i <= kFanout; i++) {
+        const int64_t child = static_cast<int64_t>(id) * kFanout + i;
+        if (child < node_count) {
+          children_[id].push_back(static_cast<int32_t>(child));
+        }
+      }
+      labels_[id] = "node " + std::to_string(id);
+    }
+  }
+
+  int32_t GetNodeCount() const {
+    return static_cast<int32_t>(children_.size());
+  }
+
+  void SetLabel(int32_t id, std::string label) {
+    labels_[id] = std::move(label);
+  }
+
+  FlutterSemanticsNode GetNode(int32_t id) const {
+    return {
+        .struct_size = sizeof(FlutterSemanticsNode),
+        .id = id,
+        .flags = static_cast<FlutterSemanticsFlag>(0),
+        .actions = static_cast<FlutterSemanticsAction>(0),
+        .text_selection_base = -1,
+        .text_selection_extent = -1,
+        .label = labels_[id].c_str(),
+        .hint = "",
+        .value = "",
+        .increased_value = "",
+        .decreased_value = "",
+        .rect = {0, 0, 100, 20},
+        .transform = {1, 0, 0, 0, 1, 20, 0, 0, 1},
+        .child_count = children_[id].size(),
+        .children_in_traversal_order = children_[id].data(),
+        .children_in_hit_test_order = children_[id].data(),
+        .custom_accessibility_actions_count = 0,
+        .tooltip = "",
+    };
+  }
+
+  void AddAllNodes(AccessibilityBridge& bridge) const {
+    for (int32_t id = 0; id < GetNodeCount(); id++) {
+      FlutterSemanticsNode node = GetNode(id);
+      bridge.AddFlutterSemanticsNodeUpdate(&node);
+    }
+  }
+
+ private:
+  std::vector<std::vector<int32_t>> children_;
+  std::vector<std::string> labels_;
+};
+
+}  // namespace
+
+// Commits a whole semantics tree to a new bridge, as happens when a screen
+// reader is turned on. The argument is the number of nodes.
+static void BM_AccessibilityBridgeCommitTree(benchmark::State& state) {
+  const SemanticsTree tree(state.range(0));
+  while (state.KeepRunning()) {
+    auto bridge = std::make_shared<TestAccessibilityBridge>();
+    tree.AddAllNodes(*bridge);
+    bridge->CommitUpdates();
+  }
+  state.SetItemsProcessed(state.iterations() * tree.GetNodeCount());
+}
+
+// Commits the labels of a few leaves of a large semantics tree, as happens
+// when a field of a form is edited. The first argument is the number of nodes
+// and the second the number of leaves that change per commit.
+static void BM_AccessibilityBridgeCommitLeaves(benchmark::State& state) {
+  SemanticsTree tree(state.range(0));
+  const int32_t changed_count = state.range(1);
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  tree.AddAllNodes(*bridge);
+  bridge->CommitUpdates();
+
+  int32_t generation = 0;
+  while (state.KeepRunning()) {
+    generation++;
+    for (int32_t i = 0; i < changed_count; i++) {
+      const int32_t id = tree.GetNodeCount() - 1 - i;
+      tree.SetLabel(id, "edit " + std::to_string(generation));
+      FlutterSemanticsNode node = tree.GetNode(id);
+      bridge->AddFlutterSemanticsNodeUpdate(&node);
+    }
+    bridge->CommitUpdates();
+    bridge->accessibility_events.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * changed_count);
+}
+
+BENCHMARK(BM_AccessibilityBridgeCommitTree)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(50000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_AccessibilityBridgeCommitLeaves)
+    ->Args({10000, 1})
+    ->Args({50000, 1})
+    ->Args({50000, 64})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -86,9 +86,7 @@ class ByteBufferStreamWriter : public ByteStreamWriter {
   void WriteAlignment(uint8_t alignment) {
     uint8_t mod = bytes_->size() % alignment;
     if (mod) {
-      for (int i = 0; i < alignment - mod; ++i) {
-        WriteByte(0);
-      }
+      bytes_->resize(bytes_->size() + alignment - mod, 0);
     }
   }
 
@@ -97,6 +95,38 @@ class ByteBufferStreamWriter : public ByteStreamWriter {
   std::vector<uint8_t>* bytes_;
 };
 
+// Implementation of ByteStreamWriter that only counts the bytes written.
+//
+// Writing a value with it first gives the exact size of the encoding, padding
+// included, so that the buffer for the encoding can be allocated once instead
+// of growing as the value is written.
+class ByteCountingStreamWriter : public ByteStreamWriter {
+ public:
+  ByteCountingStreamWriter() = default;
+
+  virtual ~ByteCountingStreamWriter() = default;
+
+  // |ByteStreamWriter|
+  void WriteByte(uint8_t byte) { ++size_; }
+
+  // |ByteStreamWriter|
+  void WriteBytes(const uint8_t* bytes, size_t length) { size_ += length; }
+
+  // |ByteStreamWriter|
+  void WriteAlignment(uint8_t alignment) {
+    uint8_t mod = size_ % alignment;
+    if (mod) {
+      size_ += alignment - mod;
+    }
+  }
+
+  // The number of bytes written so far.
+  size_t size() const { return size_; }
+
+ private:
+  size_t size_ = 0;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_BYTE_BUFFER_STREAMS_H_
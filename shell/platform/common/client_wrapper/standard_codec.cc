@@ -11,7 +11,9 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -188,7 +190,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +207,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +217,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -268,11 +270,11 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
   size_t count = vector.size();
   WriteSize(count, stream);
@@ -287,6 +289,28 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
                      count * type_size);
 }
 
+namespace {
+
+// Returns the bytes that |write| writes, in a buffer that is allocated once.
+//
+// |write| is called twice: first with a stream that only counts the bytes it
+// is given, then with a stream that writes into a buffer of exactly that
+// size. Both passes go through the serializer, so the values written by codec
+// extensions are counted like the standard ones.
+template <typename WriteFunction>
+std::unique_ptr<std::vector<uint8_t>> EncodeToBuffer(
+    const WriteFunction& write) {
+  ByteCountingStreamWriter counter;
+  write(&counter);
+  auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(counter.size());
+  ByteBufferStreamWriter stream(encoded.get());
+  write(&stream);
+  return encoded;
+}
+
+}  // namespace
+
 // ===== standard_message_codec.h =====
 
 // static
@@ -328,10 +352,9 @@ std::unique_ptr<EncodableValue> StandardMessageCodec::DecodeMessageInternal(
 std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(message, &stream);
-  return encoded;
+  return EncodeToBuffer([this, &message](ByteStreamWriter* stream) {
+    serializer_->WriteValue(message, stream);
+  });
 }
 
 // ===== standard_method_codec.h =====
@@ -382,29 +405,29 @@ StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
-  if (method_call.arguments()) {
-    serializer_->WriteValue(*method_call.arguments(), &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  }
-  return encoded;
+  const EncodableValue method_name(method_call.method_name());
+  return EncodeToBuffer(
+      [this, &method_name, &method_call](ByteStreamWriter* stream) {
+        serializer_->WriteValue(method_name, stream);
+        if (method_call.arguments()) {
+          serializer_->WriteValue(*method_call.arguments(), stream);
+        } else {
+          serializer_->WriteValue(EncodableValue(), stream);
+        }
+      });
 }
 
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  stream.WriteByte(0);
-  if (result) {
-    serializer_->WriteValue(*result, &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  }
-  return encoded;
+  return EncodeToBuffer([this, result](ByteStreamWriter* stream) {
+    stream->WriteByte(0);
+    if (result) {
+      serializer_->WriteValue(*result, stream);
+    } else {
+      serializer_->WriteValue(EncodableValue(), stream);
+    }
+  });
 }
 
 std::unique_ptr<std::vector<uint8_t>>
@@ -412,21 +435,20 @@ StandardMethodCodec::EncodeErrorEnvelopeInternal(
     const std::string& error_code,
     const std::string& error_message,
     const EncodableValue* error_details) const {
-  auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  stream.WriteByte(1);
-  serializer_->WriteValue(EncodableValue(error_code), &stream);
-  if (error_message.empty()) {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(error_message), &stream);
-  }
-  if (error_details) {
-    serializer_->WriteValue(*error_details, &stream);
-  } else {
-    serializer_->WriteValue(EncodableValue(), &stream);
-  }
-  return encoded;
+  const EncodableValue code(error_code);
+  const EncodableValue message =
+      error_message.empty() ? EncodableValue() : EncodableValue(error_message);
+  return EncodeToBuffer(
+      [this, &code, &message, error_details](ByteStreamWriter* stream) {
+        stream->WriteByte(1);
+        serializer_->WriteValue(code, stream);
+        serializer_->WriteValue(message, stream);
+        if (error_details) {
+          serializer_->WriteValue(*error_details, stream);
+        } else {
+          serializer_->WriteValue(EncodableValue(), stream);
+        }
+      });
 }
 
 bool StandardMethodCodec::DecodeAndProcessResponseEnvelopeInternal(
@@ -259,4 +259,23 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeVariableLengthCustomType) {
                     some_data_comparator);
 }
 
+TEST(StandardMessageCodec, AllocatesEncodingOnce) {
+  EncodableValue value(EncodableList{
+      EncodableValue("label"),
+      EncodableValue(std::vector<double>(1000, 3.14)),
+      EncodableValue(EncodableMap{
+          {EncodableValue("points"),
+           EncodableValue(std::vector<int32_t>(300, 47))},
+      }),
+      CustomEncodableValue(SomeData("test", std::vector<uint8_t>(500, 0x2a))),
+  });
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance(
+      &SomeDataExtensionSerializer::GetInstance());
+  auto encoded = codec.EncodeMessage(value);
+  ASSERT_TRUE(encoded);
+  // The size of the encoding is measured before the buffer is allocated, so
+  // the buffer never grows.
+  EXPECT_EQ(encoded->capacity(), encoded->size());
+}
+
 }  // namespace flutter
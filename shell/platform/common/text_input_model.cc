@@ -292,10 +292,26 @@ std::string TextInputModel::GetText() const {
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  return fml::Utf16ToUtf8(leading_text).size();
+  // Measure the UTF-8 length of the current text up to the selection extent
+  // without converting it.
+  size_t extent = std::min(selection_.extent(), text_.length());
+  int offset = 0;
+  for (size_t i = 0; i < extent; i++) {
+    char16_t code_unit = text_[i];
+    if (code_unit < 0x80) {
+      offset += 1;
+    } else if (code_unit < 0x800) {
+      offset += 2;
+    } else if (IsLeadingSurrogate(code_unit) && i + 1 < extent &&
+               IsTrailingSurrogate(text_[i + 1])) {
+      // A surrogate pair encodes a code point that takes four bytes.
+      offset += 4;
+      i++;
+    } else {
+      offset += 3;
+    }
+  }
+  return offset;
 }
 
 }  // namespace flutter
@@ -86,7 +86,17 @@ BOOL canApplyBlurBackdrop = YES;
 
 std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewLayerPool::GetLayer(
     GrDirectContext* gr_context,
-    const std::shared_ptr<IOSContext>& ios_context) {
+    const std::shared_ptr<IOSContext>& ios_context,
+    int64_t view_id,
+    int64_t overlay_id) {
+  // Move the layer that was used for this overlay in the last frame to the front of the
+  // available layers, so it keeps its place in the view hierarchy.
+  for (size_t i = available_layer_index_; i < layers_.size(); i++) {
+    if (layers_[i]->view_id == view_id && layers_[i]->overlay_id == overlay_id) {
+      std::swap(layers_[i], layers_[available_layer_index_]);
+      break;
+    }
+  }
   if (available_layer_index_ >= layers_.size()) {
     std::shared_ptr<FlutterPlatformViewLayer> layer;
     fml::scoped_nsobject<FlutterOverlayView> overlay_view;
@@ -688,6 +698,9 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
     EmbedderViewSlice* slice = slices_[platform_view_id].get();
     slice->end_recording();
 
+    // The rects of the overlays of the current picture, and the platform view each of them
+    // is over. The top most platform view comes first.
+    std::vector<std::pair<int64_t, SkRect>> overlay_rects;
     // Check if the current picture contains overlays that intersect with the
     // current platform view or any of the previous platform views.
     for (size_t j = i + 1; j > 0; j--) {
@@ -697,10 +710,6 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
           slice->searchNonOverlappingDrawnRects(platform_view_rect);
       auto allocation_size = intersection_rects.size();
 
-      // For testing purposes, the overlay id is used to find the overlay view.
-      // This is the index of the layer for the current platform view.
-      auto overlay_id = platform_view_layers[current_platform_view_id].size();
-
       // If the max number of allocations per platform view is exceeded,
       // then join all the rects into a single one.
       //
@@ -728,19 +737,45 @@ bool FlutterPlatformViewsController::SubmitFrame(GrDirectContext* gr_context,
         // Clip the background canvas, so it doesn't contain any of the pixels drawn
         // on the overlay layer.
         background_canvas->clipRect(joined_rect, SkClipOp::kDifference);
-        // Get a new host layer.
-        std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,                //
-                                                                   ios_context,               //
-                                                                   slice,                     //
-                                                                   joined_rect,               //
-                                                                   current_platform_view_id,  //
-                                                                   overlay_id                 //
-        );
-        did_submit &= layer->did_submit_last_frame;
-        platform_view_layers[current_platform_view_id].push_back(layer);
-        overlay_id++;
+        overlay_rects.emplace_back(current_platform_view_id, joined_rect);
       }
     }
+
+    // The picture is drawn above all the platform views it intersects, so if it needs more
+    // overlays than a single platform view is allowed, the overlays are merged into one that
+    // is above the top most of these platform views. Only the pixels of the original overlay
+    // rects are drawn on it.
+    //
+    // Unlike joining the rects, this doesn't cover the pixels between the platform views, which
+    // later pictures may draw on the background.
+    std::vector<std::pair<int64_t, SkRegion>> overlay_regions;
+    if (overlay_rects.size() > kMaxLayerAllocations &&
+        overlay_rects.front().first != overlay_rects.back().first) {
+      SkRegion region;
+      for (const auto& [view_id, rect] : overlay_rects) {
+        region.op(rect.roundOut(), SkRegion::kUnion_Op);
+      }
+      overlay_regions.emplace_back(overlay_rects.front().first, region);
+    } else {
+      for (const auto& [view_id, rect] : overlay_rects) {
+        overlay_regions.emplace_back(view_id, SkRegion(rect.roundOut()));
+      }
+    }
+    for (const auto& [current_platform_view_id, region] : overlay_regions) {
+      // For testing purposes, the overlay id is used to find the overlay view.
+      // This is the index of the layer for the current platform view.
+      auto overlay_id = platform_view_layers[current_platform_view_id].size();
+      // Get a new host layer.
+      std::shared_ptr<FlutterPlatformViewLayer> layer = GetLayer(gr_context,                //
+                                                                 ios_context,               //
+                                                                 slice,                     //
+                                                                 region,                    //
+                                                                 current_platform_view_id,  //
+                                                                 overlay_id                 //
+      );
+      did_submit &= layer->did_submit_last_frame;
+      platform_view_layers[current_platform_view_id].push_back(layer);
+    }
     if (background_builder) {
       slice->render_into(background_builder);
     } else {
@@ -784,14 +819,24 @@ void FlutterPlatformViewsController::BringLayersIntoView(LayersMap layer_map) {
     }
     // Make sure the platform_view_root is higher than the last platform_view_root in
     // composition_order_.
-    platform_view_root.layer.zPosition = zIndex++;
+    //
+    // The z positions are only set when they changed, as every change is sent to the render
+    // server, even if the value is the same.
+    if (platform_view_root.layer.zPosition != zIndex) {
+      platform_view_root.layer.zPosition = zIndex;
+    }
+    zIndex++;
 
     for (const std::shared_ptr<FlutterPlatformViewLayer>& layer : layers) {
       if ([layer->overlay_view_wrapper.get() superview] != flutter_view) {
         [flutter_view addSubview:layer->overlay_view_wrapper];
       }
       // Make sure all the overlays are higher than the platform view.
-      layer->overlay_view_wrapper.get().layer.zPosition = zIndex++;
+      CALayer* overlay_layer = layer->overlay_view_wrapper.get().layer;
+      if (overlay_layer.zPosition != zIndex) {
+        overlay_layer.zPosition = zIndex;
+      }
+      zIndex++;
       FML_DCHECK(layer->overlay_view_wrapper.get().layer.zPosition >
                  platform_view_root.layer.zPosition);
     }
@@ -803,30 +848,48 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
     GrDirectContext* gr_context,
     const std::shared_ptr<IOSContext>& ios_context,
     EmbedderViewSlice* slice,
-    SkRect rect,
+    const SkRegion& region,
     int64_t view_id,
     int64_t overlay_id) {
   FML_DCHECK(flutter_view_);
-  std::shared_ptr<FlutterPlatformViewLayer> layer = layer_pool_->GetLayer(gr_context, ios_context);
-
+  std::shared_ptr<FlutterPlatformViewLayer> layer =
+      layer_pool_->GetLayer(gr_context, ios_context, view_id, overlay_id);
+  // The layer is the same as in the last frame if the overlay still exists, in which case its
+  // views are only changed when the overlay moved, to keep the Core Animation transaction small.
+  bool is_same_overlay = layer->view_id == view_id && layer->overlay_id == overlay_id;
+  layer->view_id = view_id;
+  layer->overlay_id = overlay_id;
+
+  SkRect rect = SkRect::Make(region.getBounds());
   UIView* overlay_view_wrapper = layer->overlay_view_wrapper.get();
   auto screenScale = [UIScreen mainScreen].scale;
   // Set the size of the overlay view wrapper.
   // This wrapper view masks the overlay view.
-  overlay_view_wrapper.frame = CGRectMake(rect.x() / screenScale, rect.y() / screenScale,
-                                          rect.width() / screenScale, rect.height() / screenScale);
-  // Set a unique view identifier, so the overlay_view_wrapper can be identified in XCUITests.
-  overlay_view_wrapper.accessibilityIdentifier =
-      [NSString stringWithFormat:@"platform_view[%lld].overlay[%lld]", view_id, overlay_id];
+  CGRect overlay_view_wrapper_frame =
+      CGRectMake(rect.x() / screenScale, rect.y() / screenScale, rect.width() / screenScale,
+                 rect.height() / screenScale);
+  if (!is_same_overlay ||
+      !CGRectEqualToRect(overlay_view_wrapper.frame, overlay_view_wrapper_frame)) {
+    overlay_view_wrapper.frame = overlay_view_wrapper_frame;
+  }
 
   UIView* overlay_view = layer->overlay_view.get();
   // Set the size of the overlay view.
   // This size is equal to the device screen size.
-  overlay_view.frame = [flutter_view_.get() convertRect:flutter_view_.get().bounds
-                                                 toView:overlay_view_wrapper];
-  // Set a unique view identifier, so the overlay_view can be identified in XCUITests.
-  overlay_view.accessibilityIdentifier =
-      [NSString stringWithFormat:@"platform_view[%lld].overlay_view[%lld]", view_id, overlay_id];
+  CGRect overlay_view_frame = [flutter_view_.get() convertRect:flutter_view_.get().bounds
+                                                        toView:overlay_view_wrapper];
+  if (!is_same_overlay || !CGRectEqualToRect(overlay_view.frame, overlay_view_frame)) {
+    overlay_view.frame = overlay_view_frame;
+  }
+
+  if (!is_same_overlay) {
+    // Set a unique view identifier, so the overlay_view_wrapper can be identified in XCUITests.
+    overlay_view_wrapper.accessibilityIdentifier =
+        [NSString stringWithFormat:@"platform_view[%lld].overlay[%lld]", view_id, overlay_id];
+    // Set a unique view identifier, so the overlay_view can be identified in XCUITests.
+    overlay_view.accessibilityIdentifier =
+        [NSString stringWithFormat:@"platform_view[%lld].overlay_view[%lld]", view_id, overlay_id];
+  }
 
   std::unique_ptr<SurfaceFrame> frame = layer->surface->AcquireFrame(frame_size_);
   // If frame is null, AcquireFrame already printed out an error message.
@@ -836,8 +899,18 @@ std::shared_ptr<FlutterPlatformViewLayer> FlutterPlatformViewsController::GetLay
   SkCanvas* overlay_canvas = frame->SkiaCanvas();
   overlay_canvas->clipRect(rect);
   overlay_canvas->clear(SK_ColorTRANSPARENT);
+  if (region.isComplex()) {
+    // The overlay was merged from several overlays, leave the pixels between them transparent.
+    overlay_canvas->clipRegion(region);
+  }
   if (frame->GetDisplayListBuilder()) {
-    slice->render_into(frame->GetDisplayListBuilder().get());
+    DisplayListBuilder* builder = frame->GetDisplayListBuilder().get();
+    if (region.isComplex()) {
+      SkPath region_path;
+      region.getBoundaryPath(&region_path);
+      builder->clipPath(region_path, SkClipOp::kIntersect, false);
+    }
+    slice->render_into(builder);
   } else {
     slice->render_into(overlay_canvas);
   }
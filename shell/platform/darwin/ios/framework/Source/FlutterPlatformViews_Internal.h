@@ -15,6 +15,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Headers/FlutterPlugin.h"
 #import "flutter/shell/platform/darwin/ios/ios_context.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRegion.h"
 
 @class FlutterTouchInterceptingView;
 
@@ -129,6 +130,12 @@ struct FlutterPlatformViewLayer {
   // Whether a frame for this layer was submitted.
   bool did_submit_last_frame;
 
+  // The platform view and the index of the overlay this layer was last used for.
+  // The pool hands the layer out for the same overlay in the next frame, so the views
+  // don't have to move in the view hierarchy.
+  int64_t view_id = -1;
+  int64_t overlay_id = -1;
+
   // The GrContext that is currently used by the overlay surfaces.
   // We track this to know when the GrContext for the Flutter app has changed
   // so we can update the overlay with the new context.
@@ -143,10 +150,13 @@ class FlutterPlatformViewLayerPool {
   ~FlutterPlatformViewLayerPool() = default;
 
   // Gets a layer from the pool if available, or allocates a new one.
+  // An available layer that was last used for the same `view_id` and `overlay_id` is preferred.
+  // The caller is responsible for updating the ids of the layer.
   // Finally, it marks the layer as used. That is, it increments `available_layer_index_`.
-  std::shared_ptr<FlutterPlatformViewLayer> GetLayer(
-      GrDirectContext* gr_context,
-      const std::shared_ptr<IOSContext>& ios_context);
+  std::shared_ptr<FlutterPlatformViewLayer> GetLayer(GrDirectContext* gr_context,
+                                                     const std::shared_ptr<IOSContext>& ios_context,
+                                                     int64_t view_id,
+                                                     int64_t overlay_id);
 
   // Gets the layers in the pool that aren't currently used.
   // This method doesn't mark the layers as unused.
@@ -291,12 +301,15 @@ class FlutterPlatformViewsController {
                      const SkRect& bounding_rect);
   void CompositeWithParams(int view_id, const EmbeddedViewParams& params);
 
-  // Allocates a new FlutterPlatformViewLayer if needed, draws the pixels within the rect from
+  // Allocates a new FlutterPlatformViewLayer if needed, draws the pixels within the region from
   // the picture on the layer's canvas.
+  //
+  // The overlay covers the bounds of the region. Pixels in the bounds but outside of the region
+  // are left transparent.
   std::shared_ptr<FlutterPlatformViewLayer> GetLayer(GrDirectContext* gr_context,
                                                      const std::shared_ptr<IOSContext>& ios_context,
                                                      EmbedderViewSlice* slice,
-                                                     SkRect rect,
+                                                     const SkRegion& region,
                                                      int64_t view_id,
                                                      int64_t overlay_id);
   // Removes overlay views and platform views that aren't needed in the current frame.
@@ -60,6 +60,10 @@
 
 - (void)setMaxRefreshRate:(double)refreshRate;
 
+// Asks the display to run at |frameRate|, but not above the max refresh rate, or at the max refresh
+// rate if |frameRate| is 0.
+- (void)setPreferredFrameRate:(double)frameRate;
+
 @end
 
 namespace flutter {
@@ -73,6 +77,9 @@ class VsyncWaiterIOS final : public VsyncWaiter, public VariableRefreshRateRepor
   // |VariableRefreshRateReporter|
   double GetRefreshRate() const override;
 
+  // |VsyncWaiter|
+  void SetPreferredFrameRate(double frame_rate) override;
+
   // Made public for testing.
   fml::scoped_nsobject<VSyncClient> GetVsyncClient() const;
 
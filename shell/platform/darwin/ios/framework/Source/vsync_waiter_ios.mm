@@ -56,6 +56,11 @@ void VsyncWaiterIOS::AwaitVSync() {
   [client_.get() await];
 }
 
+// |VsyncWaiter|
+void VsyncWaiterIOS::SetPreferredFrameRate(double frame_rate) {
+  [client_.get() setPreferredFrameRate:frame_rate];
+}
+
 // |VariableRefreshRateReporter|
 double VsyncWaiterIOS::GetRefreshRate() const {
   return [client_.get() getRefreshRate];
@@ -71,6 +76,10 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
   flutter::VsyncWaiter::Callback callback_;
   fml::scoped_nsobject<CADisplayLink> display_link_;
   double current_refresh_rate_;
+  // 0 until the max refresh rate is set.
+  double max_frame_rate_;
+  // 0 if no rate is preferred.
+  double preferred_frame_rate_;
 }
 
 - (instancetype)initWithTaskRunner:(fml::RefPtr<fml::TaskRunner>)task_runner
@@ -102,13 +111,42 @@ fml::scoped_nsobject<VSyncClient> VsyncWaiterIOS::GetVsyncClient() const {
   if (!DisplayLinkManager.maxRefreshRateEnabledOnIPhone) {
     return;
   }
-  double maxFrameRate = fmax(refreshRate, 60);
-  double minFrameRate = fmax(maxFrameRate / 2, 60);
+  max_frame_rate_ = fmax(refreshRate, 60);
+  [self updateFrameRate];
+}
+
+- (void)setPreferredFrameRate:(double)frameRate {
+  preferred_frame_rate_ = frameRate;
+  [self updateFrameRate];
+}
+
+- (void)updateFrameRate {
+  if (preferred_frame_rate_ > 0) {
+    // A display that isn't allowed to go above 60Hz can still go below it.
+    double frameRate =
+        max_frame_rate_ > 0 ? fmin(preferred_frame_rate_, max_frame_rate_) : preferred_frame_rate_;
+    if (@available(iOS 15.0, *)) {
+      display_link_.get().preferredFrameRateRange =
+          CAFrameRateRangeMake(frameRate, frameRate, frameRate);
+    } else {
+      display_link_.get().preferredFramesPerSecond = frameRate;
+    }
+    return;
+  }
+  if (max_frame_rate_ > 0) {
+    double minFrameRate = fmax(max_frame_rate_ / 2, 60);
+    if (@available(iOS 15.0, *)) {
+      display_link_.get().preferredFrameRateRange =
+          CAFrameRateRangeMake(minFrameRate, max_frame_rate_, max_frame_rate_);
+    } else {
+      display_link_.get().preferredFramesPerSecond = max_frame_rate_;
+    }
+    return;
+  }
   if (@available(iOS 15.0, *)) {
-    display_link_.get().preferredFrameRateRange =
-        CAFrameRateRangeMake(minFrameRate, maxFrameRate, maxFrameRate);
+    display_link_.get().preferredFrameRateRange = CAFrameRateRangeDefault;
   } else {
-    display_link_.get().preferredFramesPerSecond = maxFrameRate;
+    display_link_.get().preferredFramesPerSecond = 0;
   }
 }
 
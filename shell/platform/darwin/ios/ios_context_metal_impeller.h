@@ -5,7 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_CONTEXT_METAL_IMPELER_H_
 #define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_IOS_CONTEXT_METAL_IMPELER_H_
 
+#include <map>
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/renderer/formats.h"
 #include "flutter/shell/platform/darwin/graphics/FlutterDarwinContextMetalImpeller.h"
 #include "flutter/shell/platform/darwin/graphics/FlutterDarwinContextMetalSkia.h"
 #include "flutter/shell/platform/darwin/ios/ios_context.h"
@@ -33,8 +38,24 @@ class IOSContextMetalImpeller final : public IOSContext {
 
   sk_sp<GrDirectContext> GetResourceContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the Aiks context shared by the surfaces of this
+  ///             context that render to layers of the given color format.
+  ///             Engines spawned from another share its context, so they
+  ///             share the pipeline variants, glyph atlas and caches of the
+  ///             Aiks contexts too. Must be used on the raster thread.
+  /// @returns    `nullptr` when no surface has set an Aiks context for the
+  ///             color format yet via SetAiksContext.
+  ///
+  std::shared_ptr<impeller::AiksContext> GetAiksContext(
+      impeller::PixelFormat color_format) const;
+
+  void SetAiksContext(impeller::PixelFormat color_format,
+                      std::shared_ptr<impeller::AiksContext> aiks_context);
+
  private:
   fml::scoped_nsobject<FlutterDarwinContextMetalImpeller> darwin_context_metal_impeller_;
+  std::map<impeller::PixelFormat, std::shared_ptr<impeller::AiksContext>> aiks_contexts_;
 
   // |IOSContext|
   sk_sp<GrDirectContext> CreateResourceContext() override;
@@ -42,6 +42,17 @@ std::shared_ptr<impeller::Context> IOSContextMetalImpeller::GetImpellerContext()
   return darwin_context_metal_impeller_.get().context;
 }
 
+std::shared_ptr<impeller::AiksContext> IOSContextMetalImpeller::GetAiksContext(
+    impeller::PixelFormat color_format) const {
+  auto found = aiks_contexts_.find(color_format);
+  return found == aiks_contexts_.end() ? nullptr : found->second;
+}
+
+void IOSContextMetalImpeller::SetAiksContext(impeller::PixelFormat color_format,
+                                             std::shared_ptr<impeller::AiksContext> aiks_context) {
+  aiks_contexts_[color_format] = std::move(aiks_context);
+}
+
 // |IOSContext|
 std::unique_ptr<GLContextResult> IOSContextMetalImpeller::MakeCurrent() {
   // This only makes sense for contexts that need to be bound to a specific thread.
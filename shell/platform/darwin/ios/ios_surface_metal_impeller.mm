@@ -7,6 +7,7 @@
 #include "flutter/impeller/renderer/backend/metal/formats_mtl.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_metal_impeller.h"
+#import "flutter/shell/platform/darwin/ios/ios_context_metal_impeller.h"
 
 namespace impeller {
 namespace {
@@ -22,6 +23,8 @@ class CustomColorAttachmentPixelFormatContext final : public Context {
                                           PixelFormat color_attachment_pixel_format)
       : context_(context), color_attachment_pixel_format_(color_attachment_pixel_format) {}
 
+  BackendType GetBackendType() const override { return context_->GetBackendType(); }
+
   bool IsValid() const override { return context_->IsValid(); }
 
   std::shared_ptr<Allocator> GetResourceAllocator() const override {
@@ -99,10 +102,22 @@ void IOSSurfaceMetalImpeller::UpdateStorageSizeIfNecessary() {
 
 // |IOSSurface|
 std::unique_ptr<Surface> IOSSurfaceMetalImpeller::CreateGPUSurface(GrDirectContext*) {
-  auto context = std::make_shared<CustomColorAttachmentPixelFormatContext>(
-      impeller_context_, FromMTLPixelFormat(layer_.get().pixelFormat));
-  return std::make_unique<GPUSurfaceMetalImpeller>(this,    //
-                                                   context  //
+  // The surfaces of the context share the Aiks context of their color format, and so do the
+  // surfaces of the engines spawned from the one that created the context.
+  auto ios_context = static_cast<IOSContextMetalImpeller*>(GetContext().get());
+  const auto color_format = FromMTLPixelFormat(layer_.get().pixelFormat);
+  auto aiks_context = ios_context->GetAiksContext(color_format);
+  if (!aiks_context) {
+    auto context =
+        std::make_shared<CustomColorAttachmentPixelFormatContext>(impeller_context_, color_format);
+    aiks_context = std::make_shared<impeller::AiksContext>(context);
+    if (aiks_context->IsValid()) {
+      ios_context->SetAiksContext(color_format, aiks_context);
+    }
+  }
+  return std::make_unique<GPUSurfaceMetalImpeller>(this,                        //
+                                                   aiks_context->GetContext(),  //
+                                                   aiks_context                 //
   );
 }
 
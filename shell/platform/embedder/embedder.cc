@@ -50,6 +50,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
+#include "flutter/shell/platform/embedder/embedder_external_texture_frame.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
@@ -63,7 +64,12 @@ extern const intptr_t kPlatformStrongDillSize;
 
 #ifdef SHELL_ENABLE_GL
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
-#endif
+#ifdef IMPELLER_ENABLE_OPENGLES
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/renderer/backend/gles/surface_gles.h"
+#include "flutter/impeller/renderer/render_target.h"
+#endif  // IMPELLER_ENABLE_OPENGLES
+#endif  // SHELL_ENABLE_GL
 
 #ifdef SHELL_ENABLE_METAL
 #include "flutter/shell/platform/embedder/embedder_surface_metal.h"
@@ -949,10 +955,48 @@ static sk_sp<SkSurface> MakeSkSurfaceFromBackingStore(
 #endif
 }
 
+static std::shared_ptr<impeller::RenderTarget>
+MakeImpellerRenderTargetFromBackingStore(
+    const std::shared_ptr<impeller::AiksContext>& aiks_context,
+    const FlutterBackingStoreConfig& config,
+    const FlutterBackingStore& backing_store) {
+#if defined(SHELL_ENABLE_GL) && defined(IMPELLER_ENABLE_OPENGLES)
+  if (backing_store.type != kFlutterBackingStoreTypeOpenGL ||
+      backing_store.open_gl.type != kFlutterOpenGLTargetTypeFramebuffer) {
+    FML_LOG(ERROR) << "Impeller can only render into OpenGL framebuffer "
+                      "backing stores.";
+    return nullptr;
+  }
+
+  const auto& framebuffer = backing_store.open_gl.framebuffer;
+  // Presentation is up to the embedder, the wrapped surface is never swapped.
+  auto surface = impeller::SurfaceGLES::WrapFBO(
+      aiks_context->GetContext(),                // context
+      []() { return true; },                     // swap callback
+      framebuffer.name,                          // fbo
+      impeller::PixelFormat::kR8G8B8A8UNormInt,  // color format
+      impeller::ISize(config.size.width, config.size.height)  // fbo size
+  );
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not wrap embedder supplied framebuffer.";
+    return nullptr;
+  }
+
+  return std::make_shared<impeller::RenderTarget>(
+      surface->GetTargetRenderPassDescriptor());
+#else
+  FML_LOG(ERROR) << "The engine was built without the Impeller OpenGL "
+                    "backend.";
+  return nullptr;
+#endif
+}
+
 static std::unique_ptr<flutter::EmbedderRenderTarget>
-CreateEmbedderRenderTarget(const FlutterCompositor* compositor,
-                           const FlutterBackingStoreConfig& config,
-                           GrDirectContext* context) {
+CreateEmbedderRenderTarget(
+    const FlutterCompositor* compositor,
+    const FlutterBackingStoreConfig& config,
+    GrDirectContext* context,
+    const std::shared_ptr<impeller::AiksContext>& aiks_context) {
   FlutterBackingStore backing_store = {};
   backing_store.struct_size = sizeof(backing_store);
 
@@ -987,6 +1031,40 @@ CreateEmbedderRenderTarget(const FlutterCompositor* compositor,
   // No safe access checks on the renderer are necessary since we allocated
   // the struct.
 
+  if (aiks_context) {
+    auto render_target = MakeImpellerRenderTargetFromBackingStore(
+        aiks_context, config, backing_store);
+    if (!render_target) {
+      FML_LOG(ERROR) << "Could not create an Impeller render target from an "
+                        "embedder provided backing store.";
+      // Nothing took ownership of the OpenGL resource of the backing store.
+      if (backing_store.type == kFlutterBackingStoreTypeOpenGL) {
+        const auto& open_gl = backing_store.open_gl;
+        if (open_gl.type == kFlutterOpenGLTargetTypeTexture &&
+            open_gl.texture.destruction_callback) {
+          open_gl.texture.destruction_callback(open_gl.texture.user_data);
+        } else if (open_gl.type == kFlutterOpenGLTargetTypeFramebuffer &&
+                   open_gl.framebuffer.destruction_callback) {
+          open_gl.framebuffer.destruction_callback(
+              open_gl.framebuffer.user_data);
+        }
+      }
+      return nullptr;
+    }
+    // Unlike Skia, Impeller doesn't take ownership of the wrapped framebuffer,
+    // so it is released along with the backing store.
+    auto on_release = [collect = collect_callback.Release(),
+                       framebuffer = backing_store.open_gl.framebuffer]() {
+      if (framebuffer.destruction_callback) {
+        framebuffer.destruction_callback(framebuffer.user_data);
+      }
+      collect();
+    };
+    return std::make_unique<flutter::EmbedderRenderTarget>(
+        backing_store, aiks_context, std::move(render_target),
+        SkISize::Make(config.size.width, config.size.height), on_release);
+  }
+
   sk_sp<SkSurface> render_surface;
 
   switch (backing_store.type) {
@@ -1046,6 +1124,9 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  size_t backing_store_buffer_count =
+      SAFE_ACCESS(compositor, backing_store_buffer_count, 0);
+  size_t render_thread_count = SAFE_ACCESS(compositor, render_thread_count, 0);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -1057,9 +1138,10 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
 
   flutter::EmbedderExternalViewEmbedder::CreateRenderTargetCallback
       create_render_target_callback =
-          [captured_compositor](GrDirectContext* context, const auto& config) {
+          [captured_compositor](GrDirectContext* context,
+                                const auto& aiks_context, const auto& config) {
             return CreateEmbedderRenderTarget(&captured_compositor, config,
-                                              context);
+                                              context, aiks_context);
           };
 
   flutter::EmbedderExternalViewEmbedder::PresentCallback present_callback =
@@ -1073,7 +1155,8 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
 
   return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
               avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
+              present_callback, backing_store_buffer_count,
+              render_thread_count),
           false};
 }
 
@@ -1324,11 +1407,13 @@ CreateNewEmbedderSemanticsUpdateCallback(
              const flutter::SemanticsNodeUpdates& nodes,
              const flutter::CustomAccessibilityActionUpdates& actions) {
     std::vector<FlutterSemanticsNode> embedder_nodes;
+    embedder_nodes.reserve(nodes.size());
     for (const auto& value : nodes) {
       embedder_nodes.push_back(CreateEmbedderSemanticsNode(value.second));
     }
 
     std::vector<FlutterSemanticsCustomAction> embedder_custom_actions;
+    embedder_custom_actions.reserve(actions.size());
     for (const auto& value : actions) {
       embedder_custom_actions.push_back(
           CreateEmbedderSemanticsCustomAction(value.second));
@@ -1581,6 +1666,21 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
+  if (SAFE_ACCESS(args, jank_snapshot_callback, nullptr) != nullptr) {
+    FlutterJankSnapshotCallback callback =
+        SAFE_ACCESS(args, jank_snapshot_callback, nullptr);
+    settings.jank_snapshot_callback = [callback, user_data](
+                                          const flutter::FrameTiming& timing,
+                                          const std::string& snapshot) {
+      callback(snapshot.c_str(), user_data);
+    };
+    const uint64_t frame_budget_ms =
+        SAFE_ACCESS(args, jank_snapshot_frame_budget_ms, 0);
+    if (frame_budget_ms > 0) {
+      settings.jank_snapshot_frame_budget =
+          fml::TimeDelta::FromMilliseconds(frame_budget_ms);
+    }
+  }
 
   if (args->update_semantics_callback != nullptr &&
       (args->update_semantics_node_callback != nullptr ||
@@ -2231,9 +2331,13 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
       message_data);
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
+// Copies the message data unless a release callback is specified, in which
+// case the data is referenced until the release callback is invoked.
+static FlutterEngineResult SendEmbedderPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* release_user_data) {
   if (engine == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
   }
@@ -2268,18 +2372,127 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   if (message_size == 0) {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel, response);
-  } else {
+  } else if (release_callback == nullptr) {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
         fml::MallocMapping::Copy(message_data, message_size), response);
+  } else {
+    message = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel,
+        std::make_unique<fml::NonOwnedMapping>(
+            message_data, message_size,
+            [release_callback, release_user_data](const uint8_t* data,
+                                                  size_t size) {
+              release_callback(release_user_data);
+            }),
+        response);
   }
 
-  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
-                 ->SendPlatformMessage(std::move(message))
-             ? kSuccess
-             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
-                                  "Could not send a message to the running "
-                                  "Flutter application.");
+  const bool sent =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)->SendPlatformMessage(
+          std::move(message));
+
+  // Without data, the message did not reference the buffer to release.
+  if (release_callback != nullptr && message_size == 0) {
+    release_callback(release_user_data);
+  }
+
+  return sent ? kSuccess
+              : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                   "Could not send a message to the running "
+                                   "Flutter application.");
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return SendEmbedderPlatformMessage(engine, flutter_message, nullptr, nullptr);
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* user_data) {
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The release callback was invalid.");
+  }
+  return SendEmbedderPlatformMessage(engine, flutter_message, release_callback,
+                                     user_data);
+}
+
+FlutterEngineResult FlutterEngineRegisterSharedRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterSharedRingBuffer* ring_buffer) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (ring_buffer == nullptr ||
+      ring_buffer->struct_size < sizeof(FlutterSharedRingBuffer) ||
+      ring_buffer->name == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid shared ring buffer.");
+  }
+
+  fml::closure release_callback;
+  if (ring_buffer->release_callback != nullptr) {
+    release_callback = [callback = ring_buffer->release_callback,
+                        user_data = ring_buffer->user_data]() {
+      callback(user_data);
+    };
+  }
+
+  auto registry = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                      ->GetShell()
+                      .GetSharedRingBufferRegistry();
+  if (!registry->Register(ring_buffer->name, ring_buffer->data,
+                          ring_buffer->size, std::move(release_callback))) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The shared ring buffer name was already registered or its memory "
+        "was invalid.");
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineUnregisterSharedRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* name) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (name == nullptr ||
+      !reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->GetShell()
+           .GetSharedRingBufferRegistry()
+           ->Unregister(name)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "No shared ring buffer was registered with the "
+                              "name.");
+  }
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineNotifySharedRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* name,
+    int64_t value) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (name == nullptr ||
+      !reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->GetShell()
+           .GetSharedRingBufferRegistry()
+           ->Notify(name, value)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The shared ring buffer was not registered or "
+                              "has no notification port.");
+  }
+  return kSuccess;
 }
 
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
@@ -2422,6 +2635,40 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineSubmitExternalTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterExternalTextureFrame* frame) {
+  if (frame == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid frame.");
+  }
+  // The engine owns the texture from here on, it is collected if the frame
+  // can't be submitted.
+  flutter::EmbedderExternalTextureFrame texture_frame(frame->open_gl);
+  if (frame->struct_size < sizeof(FlutterExternalTextureFrame)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid frame struct size.");
+  }
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+  if (texture_identifier == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid texture identifier.");
+  }
+  std::shared_ptr<const flutter::TextureFence> ready_fence;
+  if (frame->is_ready != nullptr) {
+    ready_fence = std::make_shared<flutter::EmbedderExternalTextureFence>(
+        frame->is_ready, frame->fence_user_data);
+  }
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->SubmitTextureFrame(
+          texture_identifier, std::move(texture_frame),
+          std::move(ready_fence))) {
+    return LOG_EMBEDDER_ERROR(
+        kInternalInconsistency,
+        "Could not submit the frame of the specified texture.");
+  }
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineUpdateSemanticsEnabled(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     bool enabled) {
@@ -2565,6 +2812,38 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "Could not run the specified task.");
 }
 
+FlutterEngineResult FlutterEngineRunTasks(FLUTTER_API_SYMBOL(FlutterEngine)
+                                              engine,
+                                          FlutterTaskRunner task_runner,
+                                          uint64_t deadline_nanos,
+                                          uint64_t* next_target_time_nanos) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  const auto deadline =
+      deadline_nanos == 0
+          ? fml::TimePoint::Max()
+          : fml::TimePoint::FromEpochDelta(
+                fml::TimeDelta::FromNanoseconds(deadline_nanos));
+
+  std::optional<fml::TimePoint> next_target_time;
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->RunExpiredTasks(
+          task_runner, deadline,
+          next_target_time_nanos ? &next_target_time : nullptr)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Could not run the tasks of the task runner.");
+  }
+
+  if (next_target_time_nanos) {
+    *next_target_time_nanos =
+        next_target_time.has_value()
+            ? next_target_time->ToEpochDelta().ToNanoseconds()
+            : 0;
+  }
+  return kSuccess;
+}
+
 static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
                                             engine,
                                         const rapidjson::Document& document,
@@ -2928,6 +3207,57 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+static void SetFrameTimingPercentiles(
+    FlutterFrameTimingPercentiles* result,
+    const flutter::FrameTimingHistograms::Percentiles& percentiles) {
+  result->p50 = percentiles.p50;
+  result->p90 = percentiles.p90;
+  result->p99 = percentiles.p99;
+}
+
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (statistics == nullptr ||
+      statistics->struct_size < sizeof(FlutterFrameTimingStatistics)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame timing statistics.");
+  }
+
+  using Histograms = flutter::FrameTimingHistograms;
+  const size_t struct_size = statistics->struct_size;
+  *statistics = {};
+  statistics->struct_size = struct_size;
+  statistics->window_duration_nanos =
+      Histograms::kWindowDuration.ToNanoseconds();
+
+  std::optional<Histograms::Window> window =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)
+          ->GetShell()
+          .GetFrameTimingHistograms()
+          .GetLastCompletedWindow();
+  if (!window) {
+    return kSuccess;
+  }
+
+  statistics->has_frames = true;
+  statistics->window_start_nanos = window->start.ToEpochDelta().ToNanoseconds();
+  statistics->frame_count = window->frame_count;
+  SetFrameTimingPercentiles(&statistics->build_micros,
+                            window->Get(Histograms::Metric::kBuildDuration));
+  SetFrameTimingPercentiles(&statistics->raster_micros,
+                            window->Get(Histograms::Metric::kRasterDuration));
+  SetFrameTimingPercentiles(&statistics->vsync_overrun_micros,
+                            window->Get(Histograms::Metric::kVsyncOverrun));
+  SetFrameTimingPercentiles(&statistics->raster_cache_bytes,
+                            window->Get(Histograms::Metric::kRasterCacheBytes));
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -2980,6 +3310,14 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(GetFrameTimingStatistics, FlutterEngineGetFrameTimingStatistics);
+  SET_PROC(SendPlatformMessageNoCopy, FlutterEngineSendPlatformMessageNoCopy);
+  SET_PROC(RegisterSharedRingBuffer, FlutterEngineRegisterSharedRingBuffer);
+  SET_PROC(UnregisterSharedRingBuffer, FlutterEngineUnregisterSharedRingBuffer);
+  SET_PROC(NotifySharedRingBuffer, FlutterEngineNotifySharedRingBuffer);
+  SET_PROC(RunTasks, FlutterEngineRunTasks);
+  SET_PROC(SubmitExternalTextureFrame,
+           FlutterEngineSubmitExternalTextureFrame);
 #undef SET_PROC
 
   return kSuccess;
@@ -366,6 +366,26 @@ typedef struct {
   size_t height;
 } FlutterOpenGLTexture;
 
+/// Returns whether the GPU commands that wrote an external texture frame have
+/// completed. Must not block.
+typedef bool (*FlutterExternalTextureFrameFenceCallback)(void* /* user data */);
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterExternalTextureFrame).
+  size_t struct_size;
+  /// The texture holding the frame. The engine takes ownership of it and
+  /// invokes its destruction callback once the frame has been superseded and
+  /// isn't sampled anymore.
+  FlutterOpenGLTexture open_gl;
+  /// User data to be returned on the invocations of `is_ready`.
+  void* fence_user_data;
+  /// Optional. Polled on the raster thread to know if the frame can be drawn.
+  /// Until it returns true, the engine keeps drawing the previous frame. When
+  /// not specified, the frame can be drawn as soon as it is submitted. The
+  /// fence is never invoked after the destruction callback of the texture.
+  FlutterExternalTextureFrameFenceCallback is_ready;
+} FlutterExternalTextureFrame;
+
 typedef struct {
   /// The target of the color attachment of the frame-buffer. For example,
   /// GL_TEXTURE_2D or GL_RENDERBUFFER. In case of ambiguity when dealing with
@@ -373,6 +393,11 @@ typedef struct {
   uint32_t target;
 
   /// The name of the framebuffer.
+  ///
+  /// When the engine renders with Impeller (`--enable-impeller`), the
+  /// backing stores of the compositor must be framebuffers with an RGBA8
+  /// color attachment and a stencil attachment. Texture backing stores are
+  /// not supported with Impeller.
   uint32_t name;
 
   /// User data to be returned on the invocation of the destruction callback.
@@ -1181,6 +1206,11 @@ typedef void (*FlutterTaskRunnerPostTaskCallback)(
     uint64_t /* target time nanos */,
     void* /* user data */);
 
+typedef void (*FlutterTaskRunnerTasksPendingCallback)(
+    FlutterTaskRunner /* task runner */,
+    uint64_t /* target time nanos */,
+    void* /* user data */);
+
 /// An interface used by the Flutter engine to execute tasks at the target time
 /// on a specified thread. There should be a 1-1 relationship between a thread
 /// and a task runner. It is undefined behavior to run a task on a thread that
@@ -1203,11 +1233,22 @@ typedef struct {
   /// delta, `FlutterEngineGetCurrentTime` may be called and the difference used
   /// as the delta.
   ///
-  /// @attention     This field is required.
+  /// @attention     This field is required unless the
+  ///                `tasks_pending_callback` is specified.
   FlutterTaskRunnerPostTaskCallback post_task_callback;
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// May be called from any thread. If specified, the engine queues the tasks
+  /// itself instead of handing each of them to the `post_task_callback`, and
+  /// calls this callback only when the earliest target time of the queued
+  /// tasks becomes earlier than the time the embedder was last told of. Tasks
+  /// posted for a later time don't call it again. At the given target time,
+  /// the embedder must call `FlutterEngineRunTasks` on the thread associated
+  /// with the task runner, which runs all the tasks whose target time has
+  /// expired in a single call. The target time uses the same clock as for the
+  /// `post_task_callback`.
+  FlutterTaskRunnerTasksPendingCallback tasks_pending_callback;
 } FlutterTaskRunnerDescription;
 
 typedef struct {
@@ -1435,6 +1476,12 @@ typedef struct {
   FlutterPoint offset;
   /// The size of the layer (in physical pixels).
   FlutterSize size;
+  /// The region of a backing store layer (in physical pixels relative to the
+  /// offset of the layer) whose contents may differ from its contents in the
+  /// previous frame. The embedder only needs to composite this region again.
+  /// Only set when `FlutterCompositor.backing_store_buffer_count` is not zero,
+  /// and null for platform view layers.
+  const FlutterDamage* damage;
 } FlutterLayer;
 
 typedef bool (*FlutterBackingStoreCreateCallback)(
@@ -1474,6 +1521,24 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// The number of backing stores the engine cycles through for each layer.
+  /// A cached backing store is reused at the earliest this many frames after
+  /// it was presented, so the embedder may still be reading the backing
+  /// stores of the frames in between. Only the region of a reused backing
+  /// store whose contents change is rendered again, and the region that
+  /// changed since the previous frame is given in `FlutterLayer.damage`. The
+  /// embedder must not modify the contents of the backing stores then.
+  ///
+  /// Zero reuses the backing store presented in the previous frame and
+  /// renders all of it again every frame. Ignored when
+  /// `avoid_backing_store_cache` is set.
+  size_t backing_store_buffer_count;
+  /// The number of threads, including the raster thread, that render the
+  /// backing stores of the layers of a frame concurrently. Only used with the
+  /// software renderer, because the backing stores of the other renderers
+  /// belong to the context of the raster thread. The value is capped at 8,
+  /// and values below 2 render every backing store on the raster thread.
+  size_t render_thread_count;
 } FlutterCompositor;
 
 typedef struct {
@@ -1670,6 +1735,17 @@ typedef void (*FlutterLogMessageCallback)(const char* /* tag */,
                                           const char* /* message */,
                                           void* /* user_data */);
 
+/// The callback that receives the snapshot of a janky frame.
+///
+/// The `snapshot` parameter contains a null-terminated JSON object in the
+/// Chrome trace event format, with the trace events recorded in the seconds
+/// before the frame, the timing and raster cache statistics of the frame, and
+/// the rasterization times of its leaf layers. It is only valid for the
+/// duration of the call. `user_data` is a user data baton passed in
+/// `FlutterEngineRun`.
+typedef void (*FlutterJankSnapshotCallback)(const char* /* snapshot */,
+                                            void* /* user_data */);
+
 /// An opaque object that describes the AOT data that can be used to launch a
 /// FlutterEngine instance in AOT mode.
 typedef struct _FlutterEngineAOTData* FlutterEngineAOTData;
@@ -1937,8 +2013,56 @@ typedef struct {
   /// If this callback is provided, update_semantics_node_callback and
   /// update_semantics_custom_action_callback must not be provided.
   FlutterUpdateSemanticsCallback update_semantics_callback;
+
+  /// A callback that receives a snapshot of the engine after a frame took
+  /// longer than `jank_snapshot_frame_budget_ms` from the start of its build
+  /// to the end of its rasterization. Setting it makes the engine keep the
+  /// last trace events of each thread in memory, even in release builds. At
+  /// most one snapshot is taken every few seconds.
+  ///
+  /// The callback is made on an internal engine managed thread and embedders
+  /// must re-thread if necessary.
+  FlutterJankSnapshotCallback jank_snapshot_callback;
+
+  /// The frame budget above which a frame is snapshotted, in milliseconds.
+  /// Defaults to 100 milliseconds if zero.
+  uint64_t jank_snapshot_frame_budget_ms;
 } FlutterProjectArgs;
 
+/// The 50th, 90th and 99th percentiles of a frame statistic over a window of
+/// time.
+typedef struct {
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+} FlutterFrameTimingPercentiles;
+
+/// The percentiles of the timings of the frames that finished rasterizing in
+/// a window of time. Populated by `FlutterEngineGetFrameTimingStatistics`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingStatistics).
+  size_t struct_size;
+  /// Whether any frame finished rasterizing in the window. The other fields
+  /// are zero if this is false.
+  bool has_frames;
+  /// The time at which the window started, in nanoseconds. The clock is the
+  /// same as that used by `FlutterEngineGetCurrentTime`.
+  uint64_t window_start_nanos;
+  /// The duration of the window in nanoseconds.
+  uint64_t window_duration_nanos;
+  /// The number of frames that finished rasterizing in the window.
+  uint64_t frame_count;
+  /// The time it took to build the frames, in microseconds.
+  FlutterFrameTimingPercentiles build_micros;
+  /// The time it took to rasterize the frames, in microseconds.
+  FlutterFrameTimingPercentiles raster_micros;
+  /// How long after the end of its frame interval the rasterization of each
+  /// frame finished, in microseconds. Zero for frames that were on time.
+  FlutterFrameTimingPercentiles vsync_overrun_micros;
+  /// The bytes held by the raster caches when the frames were rasterized.
+  FlutterFrameTimingPercentiles raster_cache_bytes;
+} FlutterFrameTimingStatistics;
+
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
 
 //------------------------------------------------------------------------------
@@ -2124,6 +2248,119 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the Flutter application without
+///             copying its data. Unlike `FlutterEngineSendPlatformMessage`,
+///             the message data must remain valid and unchanged until the
+///             engine invokes the release callback.
+///
+///             Messages larger than a few kilobytes are handed to the Dart
+///             handler of the channel as unmodifiable external `ByteData`, so
+///             the data may be referenced for as long as the Dart application
+///             keeps that `ByteData` alive. Smaller messages are copied.
+///
+/// @param[in]  engine            A running engine instance.
+/// @param[in]  message           The message to send. The data, channel and
+///                               response handle are read as in
+///                               `FlutterEngineSendPlatformMessage`.
+/// @param[in]  release_callback  The callback invoked with the user data once
+///                               the engine no longer references the message
+///                               data. It may be invoked on any thread,
+///                               including before this call returns. It is
+///                               invoked exactly once unless the call returns
+///                               `kInvalidArguments`.
+/// @param[in]  user_data         A baton passed by the engine to the release
+///                               callback. This baton is not interpreted by
+///                               the engine in any way.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* user_data);
+
+/// A ring buffer in memory that the embedder shares with the Dart
+/// application. Dart opens it with `PlatformDispatcher.openSharedRingBuffer`
+/// and sees the memory as `ByteData` without copying it.
+///
+/// The memory starts with two 64-bit unsigned integers in the native byte
+/// order: the producer index, which counts the bytes written to the ring, and
+/// the consumer index, which counts the bytes read from it. The bytes of the
+/// ring follow, and the byte at index `i` is stored at `16 + i % capacity`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterSharedRingBuffer).
+  size_t struct_size;
+  /// The name that the Dart application opens the ring buffer with.
+  const char* name;
+  /// The memory of the ring buffer, aligned to 8 bytes.
+  uint8_t* data;
+  /// The size of the memory, including the 16 bytes of the indices.
+  size_t size;
+  /// Invoked once the engine and the Dart application no longer reference the
+  /// memory, after the ring buffer is unregistered or the engine is shut
+  /// down. It may be invoked on any thread.
+  VoidCallback release_callback;
+  /// A baton passed to the release callback. It is not interpreted by the
+  /// engine in any way.
+  void* user_data;
+} FlutterSharedRingBuffer;
+
+//------------------------------------------------------------------------------
+/// @brief      Registers a ring buffer in memory shared with the Dart
+///             application. Streams of data such as video frames or audio
+///             buffers can be exchanged through it without copies and without
+///             platform messages.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  ring_buffer  The ring buffer to register. The name is copied.
+///
+/// @return     The result of the call. The release callback is only invoked
+///             if the call is successful.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRegisterSharedRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterSharedRingBuffer* ring_buffer);
+
+//------------------------------------------------------------------------------
+/// @brief      Unregisters a shared ring buffer. The Dart application may
+///             still reference the memory afterwards, until it collects the
+///             ring buffer objects it opened. The release callback of the ring
+///             buffer tells when the memory is no longer referenced.
+///
+/// @param[in]  engine  A running engine instance.
+/// @param[in]  name    The name of the ring buffer.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineUnregisterSharedRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* name);
+
+//------------------------------------------------------------------------------
+/// @brief      Posts a value, usually the new producer or consumer index, to
+///             the notification port that the Dart application opened the
+///             ring buffer with. This is a lightweight message that doesn't
+///             go through the platform channels. It can be called on any
+///             thread.
+///
+/// @param[in]  engine  A running engine instance.
+/// @param[in]  name    The name of the ring buffer.
+/// @param[in]  value   The value to post.
+///
+/// @return     The result of the call. It is `kInvalidArguments` if the ring
+///             buffer isn't registered or has no open notification port.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineNotifySharedRingBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* name,
+    int64_t value);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -2272,6 +2509,38 @@ FlutterEngineResult FlutterEngineMarkExternalTextureFrameAvailable(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
 
+//------------------------------------------------------------------------------
+/// @brief      Submit a new frame of an OpenGL external texture, from any
+///             thread.
+///
+///             Unlike the frames returned by the
+///             `gl_external_texture_frame_callback` of the OpenGL renderer
+///             config, which the raster thread asks for while it draws,
+///             submitted frames are queued so that the raster thread never
+///             waits on the producer. The engine keeps at most three frames of
+///             the texture: the one being drawn, the latest one that is ready,
+///             and the latest one that isn't. Frames that are superseded before
+///             being drawn are released right away.
+///
+///             Submitting a frame marks the texture as having a new frame
+///             available, a separate call to
+///             `FlutterEngineMarkExternalTextureFrameAvailable` isn't needed.
+///
+/// @see        FlutterEngineRegisterExternalTexture()
+///
+/// @param[in]  engine              A running engine instance.
+/// @param[in]  texture_identifier  The identifier of the texture.
+/// @param[in]  frame               The frame. The engine takes ownership of its
+///                                 texture, even if the call fails.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSubmitExternalTextureFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterExternalTextureFrame* frame);
+
 //------------------------------------------------------------------------------
 /// @brief      Enable or disable accessibility semantics.
 ///
@@ -2453,6 +2722,39 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task);
 
+//------------------------------------------------------------------------------
+/// @brief      Inform the engine to run the expired tasks queued on a task
+///             runner whose description specifies the
+///             `FlutterTaskRunnerDescription.tasks_pending_callback`. The
+///             tasks are run in the order of their target times, until none
+///             of them is expired or the deadline passes. At least one
+///             expired task is run per call. This call must be made on the
+///             thread associated with the task runner.
+///
+/// @param[in]  engine            A running engine instance.
+/// @param[in]  task_runner       The task runner given to the tasks pending
+///                               callback.
+/// @param[in]  deadline_nanos    The time after which no more tasks are run,
+///                               from the clock of
+///                               `FlutterEngineGetCurrentTime`. Zero for no
+///                               deadline.
+/// @param[out] next_target_time_nanos
+///                               If not null, receives the target time of the
+///                               earliest task still queued, or zero if there
+///                               is none. The embedder must then call this
+///                               function again at that time, as the tasks
+///                               pending callback is not invoked for it. If
+///                               null, the callback is invoked instead.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunTasks(FLUTTER_API_SYMBOL(FlutterEngine)
+                                              engine,
+                                          FlutterTaskRunner task_runner,
+                                          uint64_t deadline_nanos,
+                                          uint64_t* next_target_time_nanos);
+
 //------------------------------------------------------------------------------
 /// @brief      Notify a running engine instance that the locale has been
 ///             updated. The preferred locale must be the first item in the list
@@ -2630,6 +2932,24 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the percentiles of the frame timings of the last window
+///             of time that has ended. The engine aggregates the timings of
+///             the rasterized frames over fixed windows of time, which lets
+///             embedders report frame statistics without receiving the
+///             timings of every frame. This may be called from any thread.
+///
+/// @param[in]  engine      A running engine instance.
+/// @param[out] statistics  The statistics of the window. The `struct_size`
+///                         must be set by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2696,6 +3016,10 @@ typedef FlutterEngineResult (
     *FlutterEngineMarkExternalTextureFrameAvailableFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
+typedef FlutterEngineResult (*FlutterEngineSubmitExternalTextureFrameFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    int64_t texture_identifier,
+    const FlutterExternalTextureFrame* frame);
 typedef FlutterEngineResult (*FlutterEngineUpdateSemanticsEnabledFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     bool enabled);
@@ -2752,6 +3076,29 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingStatistics* statistics);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineRegisterSharedRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterSharedRingBuffer* ring_buffer);
+typedef FlutterEngineResult (*FlutterEngineUnregisterSharedRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* name);
+typedef FlutterEngineResult (*FlutterEngineNotifySharedRingBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* name,
+    int64_t value);
+typedef FlutterEngineResult (*FlutterEngineRunTasksFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    uint64_t deadline_nanos,
+    uint64_t* next_target_time_nanos);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2798,6 +3145,13 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineGetFrameTimingStatisticsFnPtr GetFrameTimingStatistics;
+  FlutterEngineSendPlatformMessageNoCopyFnPtr SendPlatformMessageNoCopy;
+  FlutterEngineRegisterSharedRingBufferFnPtr RegisterSharedRingBuffer;
+  FlutterEngineUnregisterSharedRingBufferFnPtr UnregisterSharedRingBuffer;
+  FlutterEngineNotifySharedRingBufferFnPtr NotifySharedRingBuffer;
+  FlutterEngineRunTasksFnPtr RunTasks;
+  FlutterEngineSubmitExternalTextureFrameFnPtr SubmitExternalTextureFrame;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
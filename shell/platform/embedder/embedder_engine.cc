@@ -147,8 +147,14 @@ bool EmbedderEngine::RegisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
   }
+  auto frame_queue = std::make_shared<EmbedderExternalTextureFrameQueue>();
+  {
+    std::scoped_lock lock(texture_frame_queues_mutex_);
+    texture_frame_queues_[texture] = frame_queue;
+  }
   shell_->GetPlatformView()->RegisterTexture(
-      external_texture_resolver_->ResolveExternalTexture(texture));
+      external_texture_resolver_->ResolveExternalTexture(texture,
+                                                         frame_queue));
   return true;
 }
 
@@ -156,6 +162,10 @@ bool EmbedderEngine::UnregisterTexture(int64_t texture) {
   if (!IsValid()) {
     return false;
   }
+  {
+    std::scoped_lock lock(texture_frame_queues_mutex_);
+    texture_frame_queues_.erase(texture);
+  }
   shell_->GetPlatformView()->UnregisterTexture(texture);
   return true;
 }
@@ -168,6 +178,35 @@ bool EmbedderEngine::MarkTextureFrameAvailable(int64_t texture) {
   return true;
 }
 
+bool EmbedderEngine::SubmitTextureFrame(
+    int64_t texture,
+    EmbedderExternalTextureFrame frame,
+    std::shared_ptr<const TextureFence> ready_fence) {
+  if (!IsValid()) {
+    return false;
+  }
+  std::shared_ptr<EmbedderExternalTextureFrameQueue> frame_queue;
+  {
+    std::scoped_lock lock(texture_frame_queues_mutex_);
+    auto found = texture_frame_queues_.find(texture);
+    if (found == texture_frame_queues_.end()) {
+      return false;
+    }
+    frame_queue = found->second;
+  }
+  frame_queue->Submit(std::move(frame), std::move(ready_fence));
+  // Frames may be submitted on the thread that produces them, the platform
+  // view is only accessed on the platform thread.
+  fml::TaskRunner::RunNowOrPostTask(
+      shell_->GetTaskRunners().GetPlatformTaskRunner(),
+      [platform_view = shell_->GetPlatformView(), texture]() {
+        if (platform_view) {
+          platform_view->MarkTextureFrameAvailable(texture);
+        }
+      });
+  return true;
+}
+
 bool EmbedderEngine::SetSemanticsEnabled(bool enabled) {
   if (!IsValid()) {
     return false;
@@ -246,6 +285,18 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+bool EmbedderEngine::RunExpiredTasks(
+    FlutterTaskRunner task_runner,
+    fml::TimePoint deadline,
+    std::optional<fml::TimePoint>* next_target_time) {
+  // Like `RunTask`, this doesn't need the shell.
+  if (task_runner == nullptr) {
+    return false;
+  }
+  return thread_host_->RunExpiredTasks(reinterpret_cast<int64_t>(task_runner),
+                                       deadline, next_target_time);
+}
+
 bool EmbedderEngine::PostTaskOnEngineManagedNativeThreads(
     const std::function<void(FlutterNativeThreadType)>& closure) const {
   if (!IsValid() || closure == nullptr) {
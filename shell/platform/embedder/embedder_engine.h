@@ -6,6 +6,8 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -61,6 +63,10 @@ class EmbedderEngine {
 
   bool MarkTextureFrameAvailable(int64_t texture);
 
+  bool SubmitTextureFrame(int64_t texture,
+                          EmbedderExternalTextureFrame frame,
+                          std::shared_ptr<const TextureFence> ready_fence);
+
   bool SetSemanticsEnabled(bool enabled);
 
   bool SetAccessibilityFeatures(int32_t flags);
@@ -79,6 +85,10 @@ class EmbedderEngine {
 
   bool RunTask(const FlutterTask* task);
 
+  bool RunExpiredTasks(FlutterTaskRunner task_runner,
+                       fml::TimePoint deadline,
+                       std::optional<fml::TimePoint>* next_target_time);
+
   bool PostTaskOnEngineManagedNativeThreads(
       const std::function<void(FlutterNativeThreadType)>& closure) const;
 
@@ -93,6 +103,11 @@ class EmbedderEngine {
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  // The frames of the registered textures are submitted on any thread.
+  std::mutex texture_frame_queues_mutex_;
+  std::unordered_map<int64_t,
+                     std::shared_ptr<EmbedderExternalTextureFrameQueue>>
+      texture_frame_queues_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_external_texture_frame.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+EmbedderExternalTextureFrame::EmbedderExternalTextureFrame(
+    const FlutterOpenGLTexture& texture)
+    : texture_(texture) {}
+
+EmbedderExternalTextureFrame::EmbedderExternalTextureFrame(
+    EmbedderExternalTextureFrame&& other)
+    : texture_(other.texture_) {
+  other.texture_.reset();
+}
+
+EmbedderExternalTextureFrame& EmbedderExternalTextureFrame::operator=(
+    EmbedderExternalTextureFrame&& other) {
+  if (this != &other) {
+    Collect();
+    texture_ = other.texture_;
+    other.texture_.reset();
+  }
+  return *this;
+}
+
+EmbedderExternalTextureFrame::~EmbedderExternalTextureFrame() {
+  Collect();
+}
+
+const FlutterOpenGLTexture& EmbedderExternalTextureFrame::GetTexture() const {
+  FML_DCHECK(texture_.has_value());
+  return texture_.value();
+}
+
+FlutterOpenGLTexture EmbedderExternalTextureFrame::ReleaseTexture() {
+  FML_DCHECK(texture_.has_value());
+  FlutterOpenGLTexture texture = texture_.value();
+  texture_.reset();
+  return texture;
+}
+
+void EmbedderExternalTextureFrame::Collect() {
+  if (texture_.has_value() && texture_->destruction_callback) {
+    texture_->destruction_callback(texture_->user_data);
+  }
+  texture_.reset();
+}
+
+EmbedderExternalTextureFence::EmbedderExternalTextureFence(
+    FlutterExternalTextureFrameFenceCallback is_ready,
+    void* user_data)
+    : is_ready_(is_ready), user_data_(user_data) {
+  FML_DCHECK(is_ready_);
+}
+
+EmbedderExternalTextureFence::~EmbedderExternalTextureFence() = default;
+
+// |TextureFence|
+bool EmbedderExternalTextureFence::IsSignaled() const {
+  return is_ready_(user_data_);
+}
+
+}  // namespace flutter
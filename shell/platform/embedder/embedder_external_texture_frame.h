@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_FRAME_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_FRAME_H_
+
+#include <memory>
+#include <optional>
+
+#include "flutter/common/graphics/texture_frame_queue.h"
+#include "flutter/fml/macros.h"
+#include "flutter/shell/platform/embedder/embedder.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A frame submitted with
+///             `FlutterEngineSubmitExternalTextureFrame`. Invokes the
+///             destruction callback of its texture when it is collected,
+///             unless the texture was released to its user first.
+///
+class EmbedderExternalTextureFrame {
+ public:
+  explicit EmbedderExternalTextureFrame(const FlutterOpenGLTexture& texture);
+
+  EmbedderExternalTextureFrame(EmbedderExternalTextureFrame&& other);
+
+  EmbedderExternalTextureFrame& operator=(EmbedderExternalTextureFrame&& other);
+
+  ~EmbedderExternalTextureFrame();
+
+  const FlutterOpenGLTexture& GetTexture() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands the texture to the caller, which becomes responsible
+  ///             for invoking its destruction callback.
+  ///
+  FlutterOpenGLTexture ReleaseTexture();
+
+ private:
+  std::optional<FlutterOpenGLTexture> texture_;
+
+  void Collect();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureFrame);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The fence of a submitted frame, which polls the callback the
+///             embedder specified.
+///
+class EmbedderExternalTextureFence : public TextureFence {
+ public:
+  EmbedderExternalTextureFence(
+      FlutterExternalTextureFrameFenceCallback is_ready,
+      void* user_data);
+
+  ~EmbedderExternalTextureFence() override;
+
+  // |TextureFence|
+  bool IsSignaled() const override;
+
+ private:
+  const FlutterExternalTextureFrameFenceCallback is_ready_;
+  void* const user_data_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalTextureFence);
+};
+
+using EmbedderExternalTextureFrameQueue =
+    TextureFrameQueue<EmbedderExternalTextureFrame>;
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_EXTERNAL_TEXTURE_FRAME_H_
@@ -19,9 +19,13 @@ namespace flutter {
 
 EmbedderExternalTextureGL::EmbedderExternalTextureGL(
     int64_t texture_identifier,
-    const ExternalTextureCallback& callback)
-    : Texture(texture_identifier), external_texture_callback_(callback) {
+    const ExternalTextureCallback& callback,
+    std::shared_ptr<EmbedderExternalTextureFrameQueue> frame_queue)
+    : Texture(texture_identifier),
+      external_texture_callback_(callback),
+      frame_queue_(std::move(frame_queue)) {
   FML_DCHECK(external_texture_callback_);
+  FML_DCHECK(frame_queue_);
 }
 
 EmbedderExternalTextureGL::~EmbedderExternalTextureGL() = default;
@@ -31,7 +35,19 @@ void EmbedderExternalTextureGL::Paint(PaintContext& context,
                                       const SkRect& bounds,
                                       bool freeze,
                                       const SkSamplingOptions& sampling) {
-  if (last_image_ == nullptr) {
+  if (frame_queue_->GetSubmittedFrameCount() > 0) {
+    // The previous frame keeps being drawn until a newer one is ready.
+    std::optional<EmbedderExternalTextureFrame> frame =
+        freeze ? std::nullopt : frame_queue_->AcquireLatest();
+    if (frame.has_value()) {
+      sk_sp<SkImage> image = ResolveSubmittedFrame(
+          std::move(frame.value()), context.gr_context,
+          SkISize::Make(bounds.width(), bounds.height()));
+      if (image) {
+        last_image_ = std::move(image);
+      }
+    }
+  } else if (last_image_ == nullptr) {
     last_image_ =
         ResolveTexture(Id(),                                           //
                        context.gr_context,                             //
@@ -64,6 +80,26 @@ sk_sp<SkImage> EmbedderExternalTextureGL::ResolveTexture(
     return nullptr;
   }
 
+  return MakeImage(std::move(texture), context, size);
+}
+
+sk_sp<SkImage> EmbedderExternalTextureGL::ResolveSubmittedFrame(
+    EmbedderExternalTextureFrame frame,
+    GrDirectContext* context,
+    const SkISize& size) {
+  context->flushAndSubmit();
+  context->resetContext(kAll_GrBackendState);
+  // The image collects the texture once it stops sampling it.
+  return MakeImage(
+      std::make_unique<FlutterOpenGLTexture>(frame.ReleaseTexture()), context,
+      size);
+}
+
+sk_sp<SkImage> EmbedderExternalTextureGL::MakeImage(
+    std::unique_ptr<FlutterOpenGLTexture> texture,
+    GrDirectContext* context,
+    const SkISize& size) {
+
   GrGLTextureInfo gr_texture_info = {texture->target, texture->name,
                                      texture->format};
 
@@ -110,10 +146,15 @@ void EmbedderExternalTextureGL::OnGrContextDestroyed() {}
 
 // |flutter::Texture|
 void EmbedderExternalTextureGL::MarkNewFrameAvailable() {
-  last_image_ = nullptr;
+  // Submitted frames replace the last image once they are ready.
+  if (frame_queue_->GetSubmittedFrameCount() == 0) {
+    last_image_ = nullptr;
+  }
 }
 
 // |flutter::Texture|
-void EmbedderExternalTextureGL::OnTextureUnregistered() {}
+void EmbedderExternalTextureGL::OnTextureUnregistered() {
+  frame_queue_->Clear();
+}
 
 }  // namespace flutter
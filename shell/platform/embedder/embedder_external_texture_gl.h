@@ -8,6 +8,7 @@
 #include "flutter/common/graphics/texture.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_external_texture_frame.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
 
@@ -18,19 +19,32 @@ class EmbedderExternalTextureGL : public flutter::Texture {
   using ExternalTextureCallback = std::function<
       std::unique_ptr<FlutterOpenGLTexture>(int64_t, size_t, size_t)>;
 
-  EmbedderExternalTextureGL(int64_t texture_identifier,
-                            const ExternalTextureCallback& callback);
+  EmbedderExternalTextureGL(
+      int64_t texture_identifier,
+      const ExternalTextureCallback& callback,
+      std::shared_ptr<EmbedderExternalTextureFrameQueue> frame_queue);
 
   ~EmbedderExternalTextureGL();
 
  private:
   const ExternalTextureCallback& external_texture_callback_;
+  // The frames submitted by the embedder. Once a frame has been submitted,
+  // the callback isn't used anymore.
+  const std::shared_ptr<EmbedderExternalTextureFrameQueue> frame_queue_;
   sk_sp<SkImage> last_image_;
 
   sk_sp<SkImage> ResolveTexture(int64_t texture_id,
                                 GrDirectContext* context,
                                 const SkISize& size);
 
+  sk_sp<SkImage> ResolveSubmittedFrame(EmbedderExternalTextureFrame frame,
+                                       GrDirectContext* context,
+                                       const SkISize& size);
+
+  sk_sp<SkImage> MakeImage(std::unique_ptr<FlutterOpenGLTexture> texture,
+                           GrDirectContext* context,
+                           const SkISize& size);
+
   // |flutter::Texture|
   void Paint(PaintContext& context,
              const SkRect& bounds,
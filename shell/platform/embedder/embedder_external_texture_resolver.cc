@@ -22,11 +22,13 @@ EmbedderExternalTextureResolver::EmbedderExternalTextureResolver(
 #endif
 
 std::unique_ptr<Texture>
-EmbedderExternalTextureResolver::ResolveExternalTexture(int64_t texture_id) {
+EmbedderExternalTextureResolver::ResolveExternalTexture(
+    int64_t texture_id,
+    std::shared_ptr<EmbedderExternalTextureFrameQueue> frame_queue) {
 #ifdef SHELL_ENABLE_GL
   if (gl_callback_) {
-    return std::make_unique<EmbedderExternalTextureGL>(texture_id,
-                                                       gl_callback_);
+    return std::make_unique<EmbedderExternalTextureGL>(
+        texture_id, gl_callback_, std::move(frame_queue));
   }
 #endif
 
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/shell/platform/embedder/embedder_external_texture_frame.h"
 
 #ifdef SHELL_ENABLE_GL
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
@@ -34,7 +35,13 @@ class EmbedderExternalTextureResolver {
       EmbedderExternalTextureMetal::ExternalTextureCallback metal_callback);
 #endif
 
-  std::unique_ptr<Texture> ResolveExternalTexture(int64_t texture_id);
+  //----------------------------------------------------------------------------
+  /// @brief      Create the texture with the given identifier. OpenGL textures
+  ///             draw the frames submitted to `frame_queue`.
+  ///
+  std::unique_ptr<Texture> ResolveExternalTexture(
+      int64_t texture_id,
+      std::shared_ptr<EmbedderExternalTextureFrameQueue> frame_queue);
 
   bool SupportsExternalTextures();
 
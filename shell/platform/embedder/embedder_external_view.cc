@@ -5,6 +5,13 @@
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/canvas_spy.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_dispatcher.h"
+#include "flutter/impeller/renderer/render_target.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 namespace flutter {
 
@@ -20,19 +27,41 @@ EmbedderExternalView::EmbedderExternalView(
     const SkMatrix& surface_transformation)
     : EmbedderExternalView(frame_size, surface_transformation, {}, nullptr) {}
 
+static SkCanvas* BeginRecording(SkPictureRecorder& recorder,
+                                const SkISize& frame_size,
+                                bool compute_content_bounds) {
+  const auto bounds = SkRect::Make(frame_size);
+  if (!compute_content_bounds) {
+    return recorder.beginRecording(bounds);
+  }
+  // With a bounding box hierarchy, the cull rect of the recorded picture is
+  // trimmed to the bounds of its contents.
+  SkRTreeFactory rtree_factory;
+  return recorder.beginRecording(bounds, &rtree_factory);
+}
+
 EmbedderExternalView::EmbedderExternalView(
     const SkISize& frame_size,
     const SkMatrix& surface_transformation,
     ViewIdentifier view_identifier,
-    std::unique_ptr<EmbeddedViewParams> params)
+    std::unique_ptr<EmbeddedViewParams> params,
+    bool compute_content_bounds,
+    bool record_display_list)
     : render_surface_size_(
           TransformedSurfaceSize(frame_size, surface_transformation)),
       surface_transformation_(surface_transformation),
       view_identifier_(view_identifier),
       embedded_view_params_(std::move(params)),
-      recorder_(std::make_unique<SkPictureRecorder>()),
-      canvas_spy_(std::make_unique<CanvasSpy>(
-          recorder_->beginRecording(frame_size.width(), frame_size.height()))) {
+      compute_content_bounds_(compute_content_bounds) {
+  if (record_display_list) {
+    dl_recorder_ = sk_make_sp<DisplayListCanvasRecorder>(
+        SkRect::Make(frame_size));
+    canvas_spy_ = std::make_unique<CanvasSpy>(dl_recorder_.get());
+  } else {
+    recorder_ = std::make_unique<SkPictureRecorder>();
+    canvas_spy_ = std::make_unique<CanvasSpy>(
+        BeginRecording(*recorder_, frame_size, compute_content_bounds));
+  }
 }
 
 EmbedderExternalView::~EmbedderExternalView() = default;
@@ -46,6 +75,10 @@ SkCanvas* EmbedderExternalView::GetCanvas() const {
   return canvas_spy_->GetSpyingCanvas();
 }
 
+DisplayListBuilder* EmbedderExternalView::GetBuilder() const {
+  return dl_recorder_ ? dl_recorder_->builder().get() : nullptr;
+}
+
 SkISize EmbedderExternalView::GetRenderSurfaceSize() const {
   return render_surface_size_;
 }
@@ -58,7 +91,12 @@ bool EmbedderExternalView::HasPlatformView() const {
   return view_identifier_.platform_view_id.has_value();
 }
 
-bool EmbedderExternalView::HasEngineRenderedContents() const {
+bool EmbedderExternalView::HasEngineRenderedContents() {
+  if (dl_recorder_) {
+    // The layers draw into the builder directly, not through the spy.
+    auto display_list = GetDisplayList();
+    return display_list && !display_list->bounds().isEmpty();
+  }
   return canvas_spy_->DidDrawIntoCanvas();
 }
 
@@ -71,15 +109,66 @@ const EmbeddedViewParams* EmbedderExternalView::GetEmbeddedViewParams() const {
   return embedded_view_params_.get();
 }
 
-bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
+sk_sp<SkPicture> EmbedderExternalView::GetPicture() {
+  if (!picture_ && recorder_) {
+    picture_ = recorder_->finishRecordingAsPicture();
+  }
+  return picture_;
+}
+
+sk_sp<DisplayList> EmbedderExternalView::GetDisplayList() {
+  if (!display_list_ && dl_recorder_) {
+    display_list_ = dl_recorder_->Build();
+  }
+  return display_list_;
+}
+
+SkRect EmbedderExternalView::GetContentBounds() {
+  if (dl_recorder_) {
+    auto display_list = GetDisplayList();
+    if (!display_list) {
+      return SkRect::MakeEmpty();
+    }
+    return compute_content_bounds_ ? display_list->bounds()
+                                   : SkRect::Make(render_surface_size_);
+  }
+  auto picture = GetPicture();
+  return picture ? picture->cullRect() : SkRect::MakeEmpty();
+}
+
+std::optional<SkIRect> EmbedderExternalView::GetRenderDamage(
+    const EmbedderRenderTarget& render_target,
+    const SkRect& content_bounds) const {
+  const auto& rendered_bounds = render_target.GetRenderedBounds();
+  if (!rendered_bounds.has_value()) {
+    return std::nullopt;
+  }
+  // Outside of the bounds of the contents rendered before and the contents
+  // rendered now, the surface is transparent before and after.
+  SkRect damage = content_bounds;
+  damage.join(rendered_bounds.value());
+  SkIRect device_damage = surface_transformation_.mapRect(damage).roundOut();
+  // Antialiasing may touch the pixels around the bounds.
+  device_damage.outset(1, 1);
+  return device_damage;
+}
+
+bool EmbedderExternalView::Render(EmbedderRenderTarget& render_target) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
 
   FML_DCHECK(HasEngineRenderedContents())
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
-  auto picture = recorder_->finishRecordingAsPicture();
-  if (!picture) {
+  FML_DCHECK(render_target.GetRenderTargetSize() == render_surface_size_);
+
+  if (render_target.GetImpellerRenderTarget()) {
+    return RenderWithImpeller(render_target);
+  }
+
+  auto picture = GetPicture();
+  auto display_list = GetDisplayList();
+  if (!picture && !display_list) {
     return false;
   }
 
@@ -88,20 +177,74 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
     return false;
   }
 
-  FML_DCHECK(SkISize::Make(surface->width(), surface->height()) ==
-             render_surface_size_);
-
   auto canvas = surface->getCanvas();
   if (!canvas) {
     return false;
   }
 
+  const SkRect content_bounds = GetContentBounds();
+
+  canvas->save();
+  canvas->resetMatrix();
+  if (auto damage = GetRenderDamage(render_target, content_bounds)) {
+    canvas->clipIRect(damage.value());
+  }
   canvas->setMatrix(surface_transformation_);
   canvas->clear(SK_ColorTRANSPARENT);
-  canvas->drawPicture(picture);
+  if (picture) {
+    canvas->drawPicture(picture);
+  } else {
+    display_list->RenderTo(canvas);
+  }
+  canvas->restore();
   canvas->flush();
 
+  render_target.SetRenderedBounds(content_bounds);
+  return true;
+}
+
+bool EmbedderExternalView::RenderWithImpeller(
+    EmbedderRenderTarget& render_target) {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto display_list = GetDisplayList();
+  if (!display_list) {
+    FML_LOG(ERROR) << "Impeller can only render views recorded into display "
+                      "lists.";
+    return false;
+  }
+
+  const auto& aiks_context = render_target.GetAiksContext();
+  if (!aiks_context) {
+    return false;
+  }
+
+  const SkRect content_bounds = GetContentBounds();
+
+  DisplayListBuilder builder;
+  builder.transform(surface_transformation_);
+  builder.drawDisplayList(display_list);
+
+  impeller::DisplayListDispatcher dispatcher;
+  builder.Build()->Dispatch(dispatcher);
+  auto picture = dispatcher.EndRecordingAsPicture();
+
+  std::optional<impeller::IRect> impeller_damage;
+  if (auto damage = GetRenderDamage(render_target, content_bounds)) {
+    impeller_damage = impeller::IRect::MakeLTRB(
+        damage->left(), damage->top(), damage->right(), damage->bottom());
+  }
+
+  if (!aiks_context->Render(picture, *render_target.GetImpellerRenderTarget(),
+                            impeller_damage)) {
+    return false;
+  }
+
+  render_target.SetRenderedBounds(content_bounds);
   return true;
+#else
+  FML_LOG(ERROR) << "The engine was built without Impeller.";
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
 }  // namespace flutter
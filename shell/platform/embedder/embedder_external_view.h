@@ -9,6 +9,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "flutter/display_list/display_list_canvas_recorder.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
@@ -86,10 +87,23 @@ class EmbedderExternalView {
   EmbedderExternalView(const SkISize& frame_size,
                        const SkMatrix& surface_transformation);
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  compute_content_bounds  Whether the bounds of the contents
+  ///                                     drawn into the view are computed,
+  ///                                     which lets `Render` only render the
+  ///                                     region of a reused render target
+  ///                                     that changed. Otherwise the contents
+  ///                                     cover the whole frame.
+  /// @param[in]  record_display_list     Whether the view is recorded into a
+  ///                                     display list rather than a picture,
+  ///                                     as needed to render it with Impeller.
+  ///
   EmbedderExternalView(const SkISize& frame_size,
                        const SkMatrix& surface_transformation,
                        ViewIdentifier view_identifier,
-                       std::unique_ptr<EmbeddedViewParams> params);
+                       std::unique_ptr<EmbeddedViewParams> params,
+                       bool compute_content_bounds = false,
+                       bool record_display_list = false);
 
   ~EmbedderExternalView();
 
@@ -97,7 +111,7 @@ class EmbedderExternalView {
 
   bool HasPlatformView() const;
 
-  bool HasEngineRenderedContents() const;
+  bool HasEngineRenderedContents();
 
   ViewIdentifier GetViewIdentifier() const;
 
@@ -107,17 +121,56 @@ class EmbedderExternalView {
 
   SkCanvas* GetCanvas() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The builder the view is recorded into, or nullptr if the view
+  ///             isn't recorded into a display list.
+  ///
+  DisplayListBuilder* GetBuilder() const;
+
   SkISize GetRenderSurfaceSize() const;
 
-  bool Render(const EmbedderRenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the contents drawn into the view, in the
+  ///             coordinates of the frame. Nothing can be drawn into the view
+  ///             after this is called.
+  ///
+  SkRect GetContentBounds();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the contents of the view into the render target. If
+  ///             the bounds of the contents last rendered into the target are
+  ///             known, only the region that changed is rendered again.
+  ///             Render targets with an Impeller render target are rendered
+  ///             with Impeller.
+  ///
+  ///             Views may be rendered on different threads at the same time.
+  ///
+  bool Render(EmbedderRenderTarget& render_target);
 
  private:
   const SkISize render_surface_size_;
   const SkMatrix surface_transformation_;
   ViewIdentifier view_identifier_;
   std::unique_ptr<EmbeddedViewParams> embedded_view_params_;
+  const bool compute_content_bounds_;
+  // Only one of the recorders is used.
   std::unique_ptr<SkPictureRecorder> recorder_;
+  sk_sp<DisplayListCanvasRecorder> dl_recorder_;
   std::unique_ptr<CanvasSpy> canvas_spy_;
+  sk_sp<SkPicture> picture_;
+  sk_sp<DisplayList> display_list_;
+
+  sk_sp<SkPicture> GetPicture();
+
+  sk_sp<DisplayList> GetDisplayList();
+
+  // The region of the render target that has to be rendered again, in the
+  // coordinates of the render target. Absent if all of it does.
+  std::optional<SkIRect> GetRenderDamage(
+      const EmbedderRenderTarget& render_target,
+      const SkRect& content_bounds) const;
+
+  bool RenderWithImpeller(EmbedderRenderTarget& render_target);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalView);
 };
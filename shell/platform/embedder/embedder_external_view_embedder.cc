@@ -5,8 +5,10 @@
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/shell/platform/embedder/embedder_layers.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
@@ -16,12 +18,23 @@ namespace flutter {
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
     const CreateRenderTargetCallback& create_render_target_callback,
-    const PresentCallback& present_callback)
+    const PresentCallback& present_callback,
+    size_t backing_store_buffer_count,
+    size_t render_thread_count)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      backing_store_buffer_count_(
+          avoid_backing_store_cache ? 0 : backing_store_buffer_count),
+      render_target_cache_(backing_store_buffer_count_) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
+  static constexpr size_t kMaxRenderThreadCount = 8;
+  render_thread_count = std::min(render_thread_count, kMaxRenderThreadCount);
+  if (render_thread_count > 1) {
+    // The raster thread renders one of the layers itself.
+    render_loop_ = fml::ConcurrentMessageLoop::Create(render_thread_count - 1);
+  }
 }
 
 EmbedderExternalViewEmbedder::~EmbedderExternalViewEmbedder() = default;
@@ -31,6 +44,11 @@ void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
   surface_transformation_callback_ = std::move(surface_transformation_callback);
 }
 
+void EmbedderExternalViewEmbedder::SetAiksContext(
+    std::shared_ptr<impeller::AiksContext> aiks_context) {
+  aiks_context_ = std::move(aiks_context);
+}
+
 SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
   if (!surface_transformation_callback_) {
     return SkMatrix{};
@@ -65,7 +83,13 @@ void EmbedderExternalViewEmbedder::BeginFrame(
       EmbedderExternalView::ViewIdentifier{};
 
   pending_views_[kRootViewIdentifier] = std::make_unique<EmbedderExternalView>(
-      pending_frame_size_, pending_surface_transformation_);
+      pending_frame_size_,              // frame size
+      pending_surface_transformation_,  // surface xformation
+      kRootViewIdentifier,              // view identifier
+      nullptr,                          // embedded view params
+      backing_store_buffer_count_ > 0,  // compute content bounds
+      aiks_context_ != nullptr          // record display list
+  );
   composition_order_.push_back(kRootViewIdentifier);
 }
 
@@ -80,22 +104,35 @@ void EmbedderExternalViewEmbedder::PrerollCompositeEmbeddedView(
       pending_frame_size_,              // frame size
       pending_surface_transformation_,  // surface xformation
       vid,                              // view identifier
-      std::move(params)                 // embedded view params
+      std::move(params),                // embedded view params
+      backing_store_buffer_count_ > 0,  // compute content bounds
+      aiks_context_ != nullptr          // record display list
   );
   composition_order_.push_back(vid);
 }
 
-// |ExternalViewEmbedder|
-SkCanvas* EmbedderExternalViewEmbedder::GetRootCanvas() {
+EmbedderExternalView* EmbedderExternalViewEmbedder::GetRootView() const {
   auto found = pending_views_.find(EmbedderExternalView::ViewIdentifier{});
   if (found == pending_views_.end()) {
     FML_DLOG(WARNING)
-        << "No root canvas could be found. This is extremely unlikely and "
+        << "No root view could be found. This is extremely unlikely and "
            "indicates that the external view embedder did not receive the "
            "notification to begin the frame.";
     return nullptr;
   }
-  return found->second->GetCanvas();
+  return found->second.get();
+}
+
+// |ExternalViewEmbedder|
+SkCanvas* EmbedderExternalViewEmbedder::GetRootCanvas() {
+  auto root_view = GetRootView();
+  return root_view ? root_view->GetCanvas() : nullptr;
+}
+
+// |ExternalViewEmbedder|
+DisplayListBuilder* EmbedderExternalViewEmbedder::GetRootBuilder() {
+  auto root_view = GetRootView();
+  return root_view ? root_view->GetBuilder() : nullptr;
 }
 
 // |ExternalViewEmbedder|
@@ -114,7 +151,15 @@ std::vector<SkCanvas*> EmbedderExternalViewEmbedder::GetCurrentCanvases() {
 // |ExternalViewEmbedder|
 std::vector<DisplayListBuilder*>
 EmbedderExternalViewEmbedder::GetCurrentBuilders() {
-  return std::vector<DisplayListBuilder*>({});
+  std::vector<DisplayListBuilder*> builders;
+  for (const auto& view : pending_views_) {
+    const auto& external_view = view.second;
+    // Like the canvases, only the builders of the non-root views.
+    if (!external_view->IsRootView() && external_view->GetBuilder()) {
+      builders.push_back(external_view->GetBuilder());
+    }
+  }
+  return builders;
 }
 
 // |ExternalViewEmbedder|
@@ -127,7 +172,7 @@ EmbedderPaintContext EmbedderExternalViewEmbedder::CompositeEmbeddedView(
                          "pre-rolled.";
     return {nullptr, nullptr};
   }
-  return {found->second->GetCanvas(), nullptr};
+  return {found->second->GetCanvas(), found->second->GetBuilder()};
 }
 
 static FlutterBackingStoreConfig MakeBackingStoreConfig(
@@ -142,6 +187,75 @@ static FlutterBackingStoreConfig MakeBackingStoreConfig(
   return config;
 }
 
+bool EmbedderExternalViewEmbedder::RenderTargets(
+    GrDirectContext* context,
+    const EmbedderRenderTargetCache::RenderTargets& targets) {
+  // Render targets backed by a GPU context can only be rendered into on the
+  // thread of the context.
+  if (context != nullptr || aiks_context_ || !render_loop_ ||
+      targets.size() < 2) {
+    for (const auto& render_target : targets) {
+      if (!pending_views_.at(render_target.first)
+               ->Render(*render_target.second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::atomic<bool> rendered(true);
+  fml::CountDownLatch latch(targets.size() - 1);
+  auto task_runner = render_loop_->GetTaskRunner();
+  auto render_target = targets.begin();
+  for (++render_target; render_target != targets.end(); ++render_target) {
+    auto* view = pending_views_.at(render_target->first).get();
+    auto* target = render_target->second.get();
+    task_runner->PostTask([view, target, &rendered, &latch]() {
+      if (!view->Render(*target)) {
+        rendered = false;
+      }
+      latch.CountDown();
+    });
+  }
+  const auto& first_target = *targets.begin();
+  if (!pending_views_.at(first_target.first)->Render(*first_target.second)) {
+    rendered = false;
+  }
+  latch.Wait();
+  return rendered;
+}
+
+SkIRect EmbedderExternalViewEmbedder::ComputeLayerDamage(
+    EmbedderExternalView::ViewIdentifier view_id,
+    const ContentBounds& previous_content_bounds) {
+  const auto& external_view = pending_views_.at(view_id);
+  const auto layer_bounds = SkRect::Make(pending_frame_size_);
+  const SkRect content_bounds = external_view->GetContentBounds();
+  presented_content_bounds_[view_id] = content_bounds;
+
+  SkRect damage = layer_bounds;
+  auto previous = previous_content_bounds.find(view_id);
+  // Without a layer for the view in the last frame, all of it is damaged.
+  if (previous != previous_content_bounds.end()) {
+    damage = content_bounds;
+    damage.join(previous->second);
+  }
+
+  const SkIRect transformed_layer_bounds =
+      pending_surface_transformation_.mapRect(layer_bounds).roundOut();
+  SkIRect device_damage =
+      pending_surface_transformation_.mapRect(damage).roundOut();
+  // Antialiasing may touch the pixels around the bounds.
+  device_damage.outset(1, 1);
+  if (!device_damage.intersect(transformed_layer_bounds)) {
+    return SkIRect::MakeEmpty();
+  }
+  // The damage is relative to the offset of the layer.
+  device_damage.offset(-transformed_layer_bounds.x(),
+                       -transformed_layer_bounds.y());
+  return device_damage;
+}
+
 // |ExternalViewEmbedder|
 void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
@@ -193,7 +307,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     //
     // @warning: Embedder may trample on our OpenGL context here.
     auto render_target =
-        create_render_target_callback_(context, backing_store_config);
+        create_render_target_callback_(context, aiks_context_,
+                                       backing_store_config);
 
     if (!render_target) {
       FML_LOG(ERROR) << "Embedder did not return a valid render target.";
@@ -210,14 +325,12 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   }
 
   // Scribble embedder provide render targets. The order in which we scribble
-  // into the buffers is irrelevant to the presentation order.
-  for (const auto& render_target : matched_render_targets) {
-    if (!pending_views_.at(render_target.first)
-             ->Render(*render_target.second)) {
-      FML_LOG(ERROR)
-          << "Could not render into the embedder supplied render target.";
-      return;
-    }
+  // into the buffers is irrelevant to the presentation order, so they may be
+  // scribbled into concurrently.
+  if (!RenderTargets(context, matched_render_targets)) {
+    FML_LOG(ERROR)
+        << "Could not render into the embedder supplied render target.";
+    return;
   }
 
   // We are going to be transferring control back over to the embedder there the
@@ -233,6 +346,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   {
+    auto previous_content_bounds = std::move(presented_content_bounds_);
+    presented_content_bounds_.clear();
     EmbedderLayers presented_layers(pending_frame_size_,
                                     pending_device_pixel_ratio_,
                                     pending_surface_transformation_);
@@ -255,8 +370,12 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       // platform view.
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
+        std::optional<SkIRect> damage;
+        if (backing_store_buffer_count_ > 0) {
+          damage = ComputeLayerDamage(view_id, previous_content_bounds);
+        }
         presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore());
+            exteral_render_target->GetBackingStore(), damage);
       }
     }
 
@@ -9,11 +9,16 @@
 #include <unordered_map>
 
 #include "flutter/flow/embedded_views.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+namespace impeller {
+class AiksContext;
+}  // namespace impeller
+
 namespace flutter {
 
 //------------------------------------------------------------------------------
@@ -31,6 +36,7 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   using CreateRenderTargetCallback =
       std::function<std::unique_ptr<EmbedderRenderTarget>(
           GrDirectContext* context,
+          const std::shared_ptr<impeller::AiksContext>& aiks_context,
           const FlutterBackingStoreConfig& config)>;
   using PresentCallback =
       std::function<bool(const std::vector<const FlutterLayer*>& layers)>;
@@ -52,11 +58,22 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                     collection of layers (backed by
   ///                                     fulfilled render targets) to the
   ///                                     embedder for presentation.
+  /// @param[in]  backing_store_buffer_count
+  ///                                     The number of render targets cycled
+  ///                                     through for each layer. If not zero,
+  ///                                     only the changed regions of reused
+  ///                                     render targets are rendered, and the
+  ///                                     damage of each layer is presented.
+  /// @param[in]  render_thread_count     The number of threads that render the
+  ///                                     layers of a frame when there is no
+  ///                                     GPU context.
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
       const CreateRenderTargetCallback& create_render_target_callback,
-      const PresentCallback& present_callback);
+      const PresentCallback& present_callback,
+      size_t backing_store_buffer_count = 0,
+      size_t render_thread_count = 1);
 
   //----------------------------------------------------------------------------
   /// @brief      Collects the external view embedder.
@@ -74,6 +91,16 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   void SetSurfaceTransformationCallback(
       SurfaceTransformationCallback surface_transformation_callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the Impeller context the layers are rendered with. If
+  ///             set, the layers are recorded into display lists and rendered
+  ///             into render targets created for that context instead of
+  ///             being rendered with Skia.
+  ///
+  /// @param[in]  aiks_context  The Impeller context.
+  ///
+  void SetAiksContext(std::shared_ptr<impeller::AiksContext> aiks_context);
+
  private:
   // |ExternalViewEmbedder|
   void CancelFrame() override;
@@ -106,20 +133,44 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   SkCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  DisplayListBuilder* GetRootBuilder() override;
+
  private:
   const bool avoid_backing_store_cache_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
+  const size_t backing_store_buffer_count_;
   SurfaceTransformationCallback surface_transformation_callback_;
+  std::shared_ptr<impeller::AiksContext> aiks_context_;
   SkISize pending_frame_size_ = SkISize::Make(0, 0);
   double pending_device_pixel_ratio_ = 1.0;
   SkMatrix pending_surface_transformation_;
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  // Renders the layers of a frame along with the raster thread. Only created
+  // for more than one render thread.
+  std::shared_ptr<fml::ConcurrentMessageLoop> render_loop_;
+  using ContentBounds =
+      std::unordered_map<EmbedderExternalView::ViewIdentifier,
+                         SkRect,
+                         EmbedderExternalView::ViewIdentifier::Hash,
+                         EmbedderExternalView::ViewIdentifier::Equal>;
+  // The bounds of the contents of the backing store layers presented in the
+  // last frame, used to compute the damage of the layers.
+  ContentBounds presented_content_bounds_;
 
   void Reset();
 
+  EmbedderExternalView* GetRootView() const;
+
+  bool RenderTargets(GrDirectContext* context,
+                     const EmbedderRenderTargetCache::RenderTargets& targets);
+
+  SkIRect ComputeLayerDamage(EmbedderExternalView::ViewIdentifier view_id,
+                             const ContentBounds& previous_content_bounds);
+
   SkMatrix GetSurfaceTransformation() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
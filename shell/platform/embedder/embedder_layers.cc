@@ -17,13 +17,34 @@ EmbedderLayers::EmbedderLayers(SkISize frame_size,
 
 EmbedderLayers::~EmbedderLayers() = default;
 
-void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
+void EmbedderLayers::PushBackingStoreLayer(
+    const FlutterBackingStore* store,
+    const std::optional<SkIRect>& damage) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
   layer.type = kFlutterLayerContentTypeBackingStore;
   layer.backing_store = store;
 
+  if (damage.has_value()) {
+    FlutterRect rect = {};
+    rect.left = damage->left();
+    rect.top = damage->top();
+    rect.right = damage->right();
+    rect.bottom = damage->bottom();
+    auto& referenced_rect = damage_rects_referenced_.emplace_back(
+        std::make_unique<FlutterRect>(rect));
+
+    FlutterDamage layer_damage = {};
+    layer_damage.struct_size = sizeof(FlutterDamage);
+    layer_damage.num_rects = damage->isEmpty() ? 0 : 1;
+    layer_damage.damage = referenced_rect.get();
+    layer.damage = damages_referenced_
+                       .emplace_back(std::make_unique<FlutterDamage>(
+                           layer_damage))
+                       .get();
+  }
+
   const auto layer_bounds =
       SkRect::MakeWH(frame_size_.width(), frame_size_.height());
 
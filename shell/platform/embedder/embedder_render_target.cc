@@ -17,6 +17,9 @@ EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
                                            fml::closure on_release)
     : backing_store_(backing_store),
       render_surface_(std::move(render_surface)),
+      size_(render_surface_ ? SkISize::Make(render_surface_->width(),
+                                            render_surface_->height())
+                            : SkISize::MakeEmpty()),
       on_release_(std::move(on_release)) {
   // TODO(38468): The optimization to elide backing store updates between frames
   // has not been implemented yet.
@@ -24,6 +27,22 @@ EmbedderRenderTarget::EmbedderRenderTarget(FlutterBackingStore backing_store,
   FML_DCHECK(render_surface_);
 }
 
+EmbedderRenderTarget::EmbedderRenderTarget(
+    FlutterBackingStore backing_store,
+    std::shared_ptr<impeller::AiksContext> aiks_context,
+    std::shared_ptr<impeller::RenderTarget> impeller_target,
+    SkISize size,
+    fml::closure on_release)
+    : backing_store_(backing_store),
+      aiks_context_(std::move(aiks_context)),
+      impeller_target_(std::move(impeller_target)),
+      size_(size),
+      on_release_(std::move(on_release)) {
+  backing_store_.did_update = true;
+  FML_DCHECK(aiks_context_);
+  FML_DCHECK(impeller_target_);
+}
+
 EmbedderRenderTarget::~EmbedderRenderTarget() {
   if (on_release_) {
     on_release_();
@@ -38,4 +57,25 @@ sk_sp<SkSurface> EmbedderRenderTarget::GetRenderSurface() const {
   return render_surface_;
 }
 
+impeller::RenderTarget* EmbedderRenderTarget::GetImpellerRenderTarget() const {
+  return impeller_target_.get();
+}
+
+const std::shared_ptr<impeller::AiksContext>&
+EmbedderRenderTarget::GetAiksContext() const {
+  return aiks_context_;
+}
+
+SkISize EmbedderRenderTarget::GetRenderTargetSize() const {
+  return size_;
+}
+
+const std::optional<SkRect>& EmbedderRenderTarget::GetRenderedBounds() const {
+  return rendered_bounds_;
+}
+
+void EmbedderRenderTarget::SetRenderedBounds(const SkRect& bounds) {
+  rendered_bounds_ = bounds;
+}
+
 }  // namespace flutter
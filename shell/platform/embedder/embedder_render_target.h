@@ -5,12 +5,20 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_H_
 
+#include <memory>
+#include <optional>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
+namespace impeller {
+class AiksContext;
+class RenderTarget;
+}  // namespace impeller
+
 namespace flutter {
 
 //------------------------------------------------------------------------------
@@ -38,6 +46,27 @@ class EmbedderRenderTarget {
                        sk_sp<SkSurface> render_surface,
                        fml::closure on_release);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a render target whose backing store is managed by the
+  ///             embedder and rendered into by Impeller.
+  ///
+  /// @param[in]  backing_store   The backing store describing this render
+  ///                             target.
+  /// @param[in]  aiks_context    The Aiks context that renders into the
+  ///                             render target.
+  /// @param[in]  impeller_target The Impeller render target wrapping the
+  ///                             backing store.
+  /// @param[in]  size            The size of the render target.
+  /// @param[in]  on_release      The callback to invoke (eventually forwarded
+  ///                             to the embedder) when the backing store is no
+  ///                             longer required by the engine.
+  ///
+  EmbedderRenderTarget(FlutterBackingStore backing_store,
+                       std::shared_ptr<impeller::AiksContext> aiks_context,
+                       std::shared_ptr<impeller::RenderTarget> impeller_target,
+                       SkISize size,
+                       fml::closure on_release);
+
   //----------------------------------------------------------------------------
   /// @brief      Destroys this instance of the render target and invokes the
   ///             callback for the embedder to release its resource associated
@@ -49,10 +78,27 @@ class EmbedderRenderTarget {
   /// @brief      A render surface the rasterizer can use to draw into the
   ///             backing store of this render target.
   ///
-  /// @return     The render surface.
+  /// @return     The render surface, or nullptr if Impeller renders into the
+  ///             backing store.
   ///
   sk_sp<SkSurface> GetRenderSurface() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The Impeller render target for the backing store, and the
+  ///             Aiks context that renders into it.
+  ///
+  /// @return     The render target, or nullptr if Skia renders into the
+  ///             backing store.
+  ///
+  impeller::RenderTarget* GetImpellerRenderTarget() const;
+
+  const std::shared_ptr<impeller::AiksContext>& GetAiksContext() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the render surface or render target.
+  ///
+  SkISize GetRenderTargetSize() const;
+
   //----------------------------------------------------------------------------
   /// @brief      The embedder backing store descriptor. This is the descriptor
   ///             that was given to the engine by the embedder. This descriptor
@@ -65,10 +111,26 @@ class EmbedderRenderTarget {
   ///
   const FlutterBackingStore* GetBackingStore() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the contents that were last rendered into the
+  ///             render surface, in the coordinates of the frame. Outside of
+  ///             these bounds, the surface is transparent.
+  ///
+  /// @return     The bounds, or `std::nullopt` if the contents of the surface
+  ///             are unknown.
+  ///
+  const std::optional<SkRect>& GetRenderedBounds() const;
+
+  void SetRenderedBounds(const SkRect& bounds);
+
  private:
   FlutterBackingStore backing_store_;
   sk_sp<SkSurface> render_surface_;
+  std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::shared_ptr<impeller::RenderTarget> impeller_target_;
+  SkISize size_;
   fml::closure on_release_;
+  std::optional<SkRect> rendered_bounds_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTarget);
 };
@@ -4,16 +4,26 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t buffer_count)
+    : buffer_count_(std::max<size_t>(buffer_count, 1)) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
+bool EmbedderRenderTargetCache::IsReusable(
+    const CachedRenderTarget& cached) const {
+  return cached.frame + buffer_count_ <= frame_;
+}
+
 std::pair<EmbedderRenderTargetCache::RenderTargets,
           EmbedderExternalView::ViewIdentifierSet>
 EmbedderRenderTargetCache::GetExistingTargetsInCache(
     const EmbedderExternalView::PendingViews& pending_views) {
+  frame_++;
+
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
 
@@ -24,12 +34,13 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
     }
     auto& compatible_targets =
         cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.empty()) {
+    if (compatible_targets.empty() ||
+        !IsReusable(compatible_targets.front())) {
       unmatched_identifiers.insert(view.first);
     } else {
       std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
+          std::move(compatible_targets.front().target);
+      compatible_targets.pop_front();
       resolved_render_targets[view.first] = std::move(target);
     }
   }
@@ -39,14 +50,19 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    auto& targets = it->second;
+    while (!targets.empty() && IsReusable(targets.front())) {
+      cleared_targets.emplace(std::move(targets.front().target));
+      targets.pop_front();
+    }
+    if (targets.empty()) {
+      it = cached_render_targets_.erase(it);
+    } else {
+      ++it;
     }
   }
-  cached_render_targets_.clear();
   return cleared_targets;
 }
 
@@ -56,10 +72,9 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   if (target == nullptr) {
     return;
   }
-  auto surface = target->GetRenderSurface();
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, SkISize::Make(surface->width(), surface->height())};
-  cached_render_targets_[desc].push(std::move(target));
+      view_identifier, target->GetRenderTargetSize()};
+  cached_render_targets_[desc].push_back({std::move(target), frame_});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
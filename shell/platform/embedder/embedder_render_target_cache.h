@@ -5,8 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <deque>
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
 
@@ -21,7 +21,16 @@ namespace flutter {
 ///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  //----------------------------------------------------------------------------
+  /// @param[in]  buffer_count  The number of frames after its presentation at
+  ///                           which a cached render target may be reused.
+  ///                           With more than one, the render targets of a
+  ///                           view are cycled through, and the ones that
+  ///                           were presented in the last frames are not
+  ///                           rendered into while the embedder may still
+  ///                           read them. Values below 1 are treated as 1.
+  ///
+  explicit EmbedderRenderTargetCache(size_t buffer_count = 1);
 
   ~EmbedderRenderTargetCache();
 
@@ -31,10 +40,22 @@ class EmbedderRenderTargetCache {
                          EmbedderExternalView::ViewIdentifier::Hash,
                          EmbedderExternalView::ViewIdentifier::Equal>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Starts a frame, and takes the cached render targets that may
+  ///             be reused for the pending views out of the cache.
+  ///
+  /// @return     The reused render targets, and the views with engine rendered
+  ///             contents that need a new render target.
+  ///
   std::pair<RenderTargets, EmbedderExternalView::ViewIdentifierSet>
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the render targets that could have been reused in this
+  ///             frame but weren't out of the cache. The render targets that
+  ///             may still be reused in the next frames are kept.
+  ///
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
@@ -44,14 +65,26 @@ class EmbedderRenderTargetCache {
   size_t GetCachedTargetsCount() const;
 
  private:
+  struct CachedRenderTarget {
+    std::unique_ptr<EmbedderRenderTarget> target;
+    // The frame in which the render target was last presented.
+    uint64_t frame;
+  };
+
+  // The render targets compatible with each descriptor, the least recently
+  // presented first.
   using CachedRenderTargets =
       std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
+                         std::deque<CachedRenderTarget>,
                          EmbedderExternalView::RenderTargetDescriptor::Hash,
                          EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
+  const uint64_t buffer_count_;
+  uint64_t frame_ = 0;
   CachedRenderTargets cached_render_targets_;
 
+  bool IsReusable(const CachedRenderTarget& cached) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
 
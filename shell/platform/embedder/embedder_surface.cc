@@ -10,4 +10,9 @@ EmbedderSurface::EmbedderSurface() = default;
 
 EmbedderSurface::~EmbedderSurface() = default;
 
+std::shared_ptr<impeller::Context> EmbedderSurface::CreateImpellerContext()
+    const {
+  return nullptr;
+}
+
 }  // namespace flutter
@@ -9,6 +9,10 @@
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 
+namespace impeller {
+class Context;
+}  // namespace impeller
+
 namespace flutter {
 
 class EmbedderSurface {
@@ -23,6 +27,8 @@ class EmbedderSurface {
 
   virtual sk_sp<GrDirectContext> CreateResourceContext() const = 0;
 
+  virtual std::shared_ptr<impeller::Context> CreateImpellerContext() const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurface);
 };
@@ -0,0 +1,223 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_surface_gl_impeller.h"
+
+#include <map>
+#include <thread>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/renderer/backend/gles/context_gles.h"
+#include "flutter/impeller/renderer/backend/gles/proc_table_gles.h"
+#include "flutter/shell/gpu/gpu_surface_gl_impeller.h"
+#include "impeller/entity/gles/entity_shaders_gles.h"
+#include "impeller/scene/shaders/gles/scene_shaders_gles.h"
+
+namespace flutter {
+
+// Reactions to the Impeller context are only allowed on the threads the
+// embedder made the GL context current on.
+class EmbedderSurfaceGLImpeller::ReactorWorker final
+    : public impeller::ReactorGLES::Worker {
+ public:
+  ReactorWorker() = default;
+
+  // |impeller::ReactorGLES::Worker|
+  ~ReactorWorker() override = default;
+
+  // |impeller::ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const impeller::ReactorGLES& reactor) const override {
+    impeller::ReaderLock lock(mutex_);
+    auto found = reactions_allowed_.find(std::this_thread::get_id());
+    if (found == reactions_allowed_.end()) {
+      return false;
+    }
+    return found->second;
+  }
+
+  void SetReactionsAllowedOnCurrentThread(bool allowed) {
+    impeller::WriterLock lock(mutex_);
+    reactions_allowed_[std::this_thread::get_id()] = allowed;
+  }
+
+ private:
+  mutable impeller::RWMutex mutex_;
+  std::map<std::thread::id, bool> reactions_allowed_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ReactorWorker);
+};
+
+EmbedderSurfaceGLImpeller::EmbedderSurfaceGLImpeller(
+    EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table,
+    bool fbo_reset_after_present,
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    : gl_dispatch_table_(std::move(gl_dispatch_table)),
+      fbo_reset_after_present_(fbo_reset_after_present),
+      external_view_embedder_(std::move(external_view_embedder)),
+      worker_(std::make_shared<ReactorWorker>()) {
+  // Make sure all required members of the dispatch table are checked.
+  if (!gl_dispatch_table_.gl_make_current_callback ||
+      !gl_dispatch_table_.gl_clear_current_callback ||
+      !gl_dispatch_table_.gl_present_callback ||
+      !gl_dispatch_table_.gl_fbo_callback ||
+      !gl_dispatch_table_.gl_populate_existing_damage) {
+    return;
+  }
+
+  // Impeller resolves all of the GL procs it uses itself.
+  if (!gl_dispatch_table_.gl_proc_resolver) {
+    FML_LOG(ERROR) << "Impeller requires a GL proc resolver.";
+    return;
+  }
+
+  // The proc table queries the capabilities of the context.
+  if (!GLContextMakeCurrent()->GetResult()) {
+    FML_LOG(ERROR) << "Could not make the context current to set up the "
+                      "Impeller context.";
+    return;
+  }
+
+  auto proc_table = std::make_unique<impeller::ProcTableGLES>(
+      gl_dispatch_table_.gl_proc_resolver);
+  if (!proc_table->IsValid()) {
+    FML_LOG(ERROR) << "Could not create OpenGL proc table.";
+    GLContextClearCurrent();
+    return;
+  }
+
+  std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_entity_shaders_gles_data,
+          impeller_entity_shaders_gles_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_scene_shaders_gles_data, impeller_scene_shaders_gles_length),
+  };
+
+  impeller_context_ =
+      impeller::ContextGLES::Create(std::move(proc_table), shader_mappings);
+  GLContextClearCurrent();
+
+  if (!impeller_context_) {
+    FML_LOG(ERROR) << "Could not create the OpenGL ES Impeller context.";
+    return;
+  }
+
+  if (!impeller_context_->AddReactorWorker(worker_).has_value()) {
+    FML_LOG(ERROR) << "Could not add reactor worker.";
+    return;
+  }
+
+  aiks_context_ = std::make_shared<impeller::AiksContext>(impeller_context_);
+  if (!aiks_context_->IsValid()) {
+    FML_LOG(ERROR) << "Could not create the Aiks context.";
+    return;
+  }
+
+  FML_LOG(INFO) << "Using the Impeller rendering backend (OpenGL).";
+  valid_ = true;
+}
+
+EmbedderSurfaceGLImpeller::~EmbedderSurfaceGLImpeller() = default;
+
+// |EmbedderSurface|
+bool EmbedderSurfaceGLImpeller::IsValid() const {
+  return valid_;
+}
+
+// |GPUSurfaceGLDelegate|
+std::unique_ptr<GLContextResult>
+EmbedderSurfaceGLImpeller::GLContextMakeCurrent() {
+  const bool result = gl_dispatch_table_.gl_make_current_callback();
+  worker_->SetReactionsAllowedOnCurrentThread(result);
+  return std::make_unique<GLContextDefaultResult>(result);
+}
+
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGLImpeller::GLContextClearCurrent() {
+  worker_->SetReactionsAllowedOnCurrentThread(false);
+  return gl_dispatch_table_.gl_clear_current_callback();
+}
+
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGLImpeller::GLContextPresent(
+    const GLPresentInfo& present_info) {
+  // Pass the present information to the embedder present callback.
+  return gl_dispatch_table_.gl_present_callback(present_info);
+}
+
+// |GPUSurfaceGLDelegate|
+GLFBOInfo EmbedderSurfaceGLImpeller::GLContextFBO(
+    GLFrameInfo frame_info) const {
+  // Get the FBO ID using the gl_fbo_callback and then get exiting damage by
+  // passing that ID to the gl_populate_existing_damage.
+  return gl_dispatch_table_.gl_populate_existing_damage(
+      gl_dispatch_table_.gl_fbo_callback(frame_info));
+}
+
+// |GPUSurfaceGLDelegate|
+bool EmbedderSurfaceGLImpeller::GLContextFBOResetAfterPresent() const {
+  return fbo_reset_after_present_;
+}
+
+// |GPUSurfaceGLDelegate|
+SkMatrix EmbedderSurfaceGLImpeller::GLContextSurfaceTransformation() const {
+  auto callback = gl_dispatch_table_.gl_surface_transformation_callback;
+  if (!callback) {
+    SkMatrix matrix;
+    matrix.setIdentity();
+    return matrix;
+  }
+  return callback();
+}
+
+// |GPUSurfaceGLDelegate|
+EmbedderSurfaceGLImpeller::GLProcResolver
+EmbedderSurfaceGLImpeller::GetGLProcResolver() const {
+  return gl_dispatch_table_.gl_proc_resolver;
+}
+
+// |GPUSurfaceGLDelegate|
+SurfaceFrame::FramebufferInfo
+EmbedderSurfaceGLImpeller::GLContextFramebufferInfo() const {
+  // Enable partial repaint by default on the embedders.
+  auto info = SurfaceFrame::FramebufferInfo{};
+  info.supports_readback = true;
+  info.supports_partial_repaint =
+      gl_dispatch_table_.gl_populate_existing_damage != nullptr;
+  return info;
+}
+
+// |EmbedderSurface|
+std::unique_ptr<Surface> EmbedderSurfaceGLImpeller::CreateGPUSurface() {
+  const bool render_to_surface = !external_view_embedder_;
+  if (external_view_embedder_) {
+    // The layers are rendered into the backing stores with the same Aiks
+    // context, so they share its pipelines and glyph atlas.
+    external_view_embedder_->SetAiksContext(aiks_context_);
+  }
+  return std::make_unique<GPUSurfaceGLImpeller>(
+      this,               // GPU surface GL delegate
+      impeller_context_,  // Impeller context
+      aiks_context_,      // Aiks context
+      render_to_surface   // render to surface
+  );
+}
+
+// |EmbedderSurface|
+sk_sp<GrDirectContext> EmbedderSurfaceGLImpeller::CreateResourceContext()
+    const {
+  // Impeller uploads textures with its own context.
+  return nullptr;
+}
+
+// |EmbedderSurface|
+std::shared_ptr<impeller::Context>
+EmbedderSurfaceGLImpeller::CreateImpellerContext() const {
+  return impeller_context_;
+}
+
+}  // namespace flutter
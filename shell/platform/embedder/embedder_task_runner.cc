@@ -16,7 +16,8 @@ EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable table,
       dispatch_table_(std::move(table)),
       placeholder_id_(
           fml::MessageLoopTaskQueues::GetInstance()->CreateTaskQueue()) {
-  FML_DCHECK(dispatch_table_.post_task_callback);
+  FML_DCHECK(dispatch_table_.post_task_callback ||
+             dispatch_table_.tasks_pending_callback);
   FML_DCHECK(dispatch_table_.runs_task_on_current_thread_callback);
 }
 
@@ -26,11 +27,11 @@ size_t EmbedderTaskRunner::GetEmbedderIdentifier() const {
   return embedder_identifier_;
 }
 
-void EmbedderTaskRunner::PostTask(const fml::closure& task) {
-  PostTaskForTime(task, fml::TimePoint::Now());
+void EmbedderTaskRunner::PostTask(fml::UniqueClosure task) {
+  PostTaskForTime(std::move(task), fml::TimePoint::Now());
 }
 
-void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
+void EmbedderTaskRunner::PostTaskForTime(fml::UniqueClosure task,
                                          fml::TimePoint target_time) {
   if (!task) {
     return;
@@ -38,19 +39,44 @@ void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
 
   uint64_t baton = 0;
 
+  if (dispatch_table_.tasks_pending_callback) {
+    {
+      // Release the lock before the jump via the dispatch table.
+      std::scoped_lock lock(tasks_mutex_);
+      baton = ++last_baton_;
+      queued_tasks_[{target_time, baton}] = std::move(task);
+      // The embedder already calls back early enough for the task.
+      if (notified_target_time_.has_value() &&
+          notified_target_time_.value() <= target_time) {
+        return;
+      }
+      notified_target_time_ = target_time;
+    }
+    dispatch_table_.tasks_pending_callback(this, target_time);
+    return;
+  }
+
   {
     // Release the lock before the jump via the dispatch table.
     std::scoped_lock lock(tasks_mutex_);
     baton = ++last_baton_;
-    pending_tasks_[baton] = task;
+    pending_tasks_[baton] = std::move(task);
   }
 
   dispatch_table_.post_task_callback(this, baton, target_time);
 }
 
-void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
+void EmbedderTaskRunner::PostDelayedTask(fml::UniqueClosure task,
                                          fml::TimeDelta delay) {
-  PostTaskForTime(task, fml::TimePoint::Now() + delay);
+  PostTaskForTime(std::move(task), fml::TimePoint::Now() + delay);
+}
+
+void EmbedderTaskRunner::PostTaskForTimeWithGrade(
+    fml::UniqueClosure task,
+    fml::TimePoint target_time,
+    fml::TaskSourceGrade task_source_grade) {
+  // The embedder decides the order in which its tasks run.
+  PostTaskForTime(std::move(task), target_time);
 }
 
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
@@ -58,7 +84,7 @@ bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
 }
 
 bool EmbedderTaskRunner::PostTask(uint64_t baton) {
-  fml::closure task;
+  fml::UniqueClosure task;
 
   {
     std::scoped_lock lock(tasks_mutex_);
@@ -67,7 +93,7 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
       FML_LOG(ERROR) << "Embedder attempted to post an unknown task.";
       return false;
     }
-    task = found->second;
+    task = std::move(found->second);
     pending_tasks_.erase(found);
 
     // Let go of the tasks mutex befor executing the task.
@@ -78,6 +104,52 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
   return true;
 }
 
+bool EmbedderTaskRunner::RunExpiredTasks(
+    fml::TimePoint deadline,
+    std::optional<fml::TimePoint>* next_target_time) {
+  if (!dispatch_table_.tasks_pending_callback) {
+    FML_LOG(ERROR) << "Embedder attempted to run the queued tasks of a task "
+                      "runner that doesn't queue them.";
+    return false;
+  }
+
+  std::optional<fml::TimePoint> notify_target_time;
+  for (bool ran_task = false;; ran_task = true) {
+    fml::UniqueClosure task;
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      const auto now = fml::TimePoint::Now();
+      auto next = queued_tasks_.begin();
+      if (next == queued_tasks_.end() || next->first.first > now ||
+          (ran_task && now >= deadline)) {
+        // Tasks posted from now on can rely on the embedder calling back at
+        // the time given here.
+        notified_target_time_.reset();
+        if (next != queued_tasks_.end()) {
+          notified_target_time_ = next->first.first;
+          if (!next_target_time) {
+            notify_target_time = next->first.first;
+          }
+        }
+        if (next_target_time) {
+          *next_target_time = notified_target_time_;
+        }
+        break;
+      }
+      task = std::move(next->second);
+      queued_tasks_.erase(next);
+      // Let go of the tasks mutex before executing the task.
+    }
+    FML_DCHECK(task);
+    task();
+  }
+
+  if (notify_target_time.has_value()) {
+    dispatch_table_.tasks_pending_callback(this, notify_target_time.value());
+  }
+  return true;
+}
+
 // |fml::TaskRunner|
 fml::TaskQueueId EmbedderTaskRunner::GetTaskQueueId() {
   return placeholder_id_;
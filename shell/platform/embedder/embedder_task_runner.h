@@ -5,8 +5,11 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 
+#include <map>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -39,6 +42,17 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
     /// thread.
     ///
     std::function<bool(void)> runs_task_on_current_thread_callback;
+    //--------------------------------------------------------------------------
+    /// If set, the tasks are queued by the task runner instead of being handed
+    /// to the `post_task_callback` one by one. This tells the embedder that
+    /// `EmbedderTaskRunner::RunExpiredTasks` must be called on the correct
+    /// thread at the `target_time`. It is only invoked when the earliest
+    /// target time of the queued tasks becomes earlier than the one the
+    /// embedder was last told of.
+    ///
+    std::function<void(EmbedderTaskRunner* task_runner,
+                       fml::TimePoint target_time)>
+        tasks_pending_callback;
   };
 
   //----------------------------------------------------------------------------
@@ -71,23 +85,55 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
 
   bool PostTask(uint64_t baton);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the queued tasks whose target time has expired, in the
+  ///             order of their target times, until none is left or the
+  ///             deadline passes. At least one expired task is run. Only valid
+  ///             for task runners with a `tasks_pending_callback`.
+  ///
+  /// @param[in]  deadline          The time after which no more tasks are run.
+  /// @param[out] next_target_time  If not null, receives the target time of
+  ///                               the earliest task left in the queue, and
+  ///                               the embedder takes the responsibility of
+  ///                               calling back at that time. If null, the
+  ///                               `tasks_pending_callback` is invoked for
+  ///                               the tasks left instead.
+  ///
+  /// @return     If the task runner queues its tasks.
+  ///
+  bool RunExpiredTasks(fml::TimePoint deadline,
+                       std::optional<fml::TimePoint>* next_target_time);
+
  private:
   const size_t embedder_identifier_;
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_ = 0;
-  std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  std::unordered_map<uint64_t, fml::UniqueClosure> pending_tasks_;
+  // The tasks queued for a `tasks_pending_callback`, in the order of their
+  // target times and then of posting.
+  std::map<std::pair<fml::TimePoint, uint64_t>, fml::UniqueClosure>
+      queued_tasks_;
+  // The target time the embedder was last told of. It calls back no later
+  // than that.
+  std::optional<fml::TimePoint> notified_target_time_;
   fml::TaskQueueId placeholder_id_;
 
   // |fml::TaskRunner|
-  void PostTask(const fml::closure& task) override;
+  void PostTask(fml::UniqueClosure task) override;
 
   // |fml::TaskRunner|
-  void PostTaskForTime(const fml::closure& task,
+  void PostTaskForTime(fml::UniqueClosure task,
                        fml::TimePoint target_time) override;
 
   // |fml::TaskRunner|
-  void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
+  void PostDelayedTask(fml::UniqueClosure task, fml::TimeDelta delay) override;
+
+  // |fml::TaskRunner|
+  void PostTaskForTimeWithGrade(
+      fml::UniqueClosure task,
+      fml::TimePoint target_time,
+      fml::TaskSourceGrade task_source_grade) override;
 
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
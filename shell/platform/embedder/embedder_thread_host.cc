@@ -42,7 +42,11 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
     return {false, {}};
   }
 
-  if (SAFE_ACCESS(description, post_task_callback, nullptr) == nullptr) {
+  auto tasks_pending_callback_c =
+      SAFE_ACCESS(description, tasks_pending_callback, nullptr);
+
+  if (SAFE_ACCESS(description, post_task_callback, nullptr) == nullptr &&
+      tasks_pending_callback_c == nullptr) {
     FML_LOG(ERROR)
         << "FlutterTaskRunnerDescription.post_task_callback was nullptr.";
     return {false, {}};
@@ -74,6 +78,19 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
         return runs_task_on_current_thread_callback_c(user_data);
       }};
 
+  if (tasks_pending_callback_c) {
+    task_runner_dispatch_table.post_task_callback = nullptr;
+    // .tasks_pending_callback
+    task_runner_dispatch_table.tasks_pending_callback =
+        [tasks_pending_callback_c, user_data](
+            EmbedderTaskRunner* task_runner,
+            fml::TimePoint target_time) -> void {
+      tasks_pending_callback_c(
+          reinterpret_cast<FlutterTaskRunner>(task_runner),
+          target_time.ToEpochDelta().ToNanoseconds(), user_data);
+    };
+  }
+
   return {true, fml::MakeRefCounted<EmbedderTaskRunner>(
                     task_runner_dispatch_table,
                     SAFE_ACCESS(description, identifier, 0u))};
@@ -295,4 +312,15 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+bool EmbedderThreadHost::RunExpiredTasks(
+    int64_t runner,
+    fml::TimePoint deadline,
+    std::optional<fml::TimePoint>* next_target_time) const {
+  auto found = runners_map_.find(runner);
+  if (found == runners_map_.end()) {
+    return false;
+  }
+  return found->second->RunExpiredTasks(deadline, next_target_time);
+}
+
 }  // namespace flutter
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 #include "flutter/common/task_runners.h"
@@ -38,6 +39,10 @@ class EmbedderThreadHost {
 
   bool PostTask(int64_t runner, uint64_t task) const;
 
+  bool RunExpiredTasks(int64_t runner,
+                       fml::TimePoint deadline,
+                       std::optional<fml::TimePoint>* next_target_time) const;
+
  private:
   ThreadHost host_;
   flutter::TaskRunners runners_;
@@ -312,6 +312,27 @@ void platform_messages_no_response() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+void shared_ring_buffer() {
+  final ReceivePort notifications = ReceivePort();
+  late SharedRingBuffer ring;
+  notifications.listen((dynamic producerIndex) {
+    final StringBuffer received = StringBuffer();
+    for (int i = ring.consumerIndex; i < producerIndex; i++) {
+      received.writeCharCode(ring.bytes.getUint8(i % ring.capacity));
+    }
+    ring.consumerIndex = producerIndex as int;
+    signalNativeMessage(received.toString());
+  });
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    ring = PlatformDispatcher.instance.openSharedRingBuffer(
+        RootIsolateToken.instance!, 'test_ring', notifications.sendPort)!;
+    callback!(null);
+  };
+  signalNativeTest();
+}
+
 @pragma('vm:entry-point')
 void null_platform_messages() {
   PlatformDispatcher.instance.onPlatformMessage =
@@ -63,6 +63,25 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       platform_dispatch_table_(std::move(platform_dispatch_table)) {}
 
 #ifdef SHELL_ENABLE_GL
+static std::unique_ptr<EmbedderSurface> CreateEmbedderSurfaceGL(
+    bool enable_impeller,
+    const EmbedderSurfaceGL::GLDispatchTable& gl_dispatch_table,
+    bool fbo_reset_after_present,
+    const std::shared_ptr<EmbedderExternalViewEmbedder>&
+        external_view_embedder) {
+  if (enable_impeller) {
+#ifdef IMPELLER_ENABLE_OPENGLES
+    return std::make_unique<EmbedderSurfaceGLImpeller>(
+        gl_dispatch_table, fbo_reset_after_present, external_view_embedder);
+#else
+    FML_LOG(ERROR) << "Impeller was requested but the engine was built "
+                      "without its OpenGL ES backend. Using Skia instead.";
+#endif  // IMPELLER_ENABLE_OPENGLES
+  }
+  return std::make_unique<EmbedderSurfaceGL>(
+      gl_dispatch_table, fbo_reset_after_present, external_view_embedder);
+}
+
 PlatformViewEmbedder::PlatformViewEmbedder(
     PlatformView::Delegate& delegate,
     const flutter::TaskRunners& task_runners,
@@ -72,10 +91,11 @@ PlatformViewEmbedder::PlatformViewEmbedder(
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : PlatformView(delegate, task_runners),
       external_view_embedder_(std::move(external_view_embedder)),
-      embedder_surface_(
-          std::make_unique<EmbedderSurfaceGL>(gl_dispatch_table,
-                                              fbo_reset_after_present,
-                                              external_view_embedder_)),
+      embedder_surface_(CreateEmbedderSurfaceGL(
+          delegate.OnPlatformViewGetSettings().enable_impeller,
+          gl_dispatch_table,
+          fbo_reset_after_present,
+          external_view_embedder_)),
       platform_message_handler_(new EmbedderPlatformMessageHandler(
           GetWeakPtr(),
           task_runners.GetPlatformTaskRunner())),
@@ -166,6 +186,15 @@ sk_sp<GrDirectContext> PlatformViewEmbedder::CreateResourceContext() const {
   return embedder_surface_->CreateResourceContext();
 }
 
+// |PlatformView|
+std::shared_ptr<impeller::Context> PlatformViewEmbedder::GetImpellerContext()
+    const {
+  if (embedder_surface_ == nullptr) {
+    return nullptr;
+  }
+  return embedder_surface_->CreateImpellerContext();
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
   if (!platform_dispatch_table_.vsync_callback) {
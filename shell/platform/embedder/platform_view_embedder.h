@@ -17,6 +17,9 @@
 
 #ifdef SHELL_ENABLE_GL
 #include "flutter/shell/platform/embedder/embedder_surface_gl.h"
+#ifdef IMPELLER_ENABLE_OPENGLES
+#include "flutter/shell/platform/embedder/embedder_surface_gl_impeller.h"
+#endif  // IMPELLER_ENABLE_OPENGLES
 #endif
 
 #ifdef SHELL_ENABLE_METAL
@@ -121,6 +124,9 @@ class PlatformViewEmbedder final : public PlatformView {
   // |PlatformView|
   sk_sp<GrDirectContext> CreateResourceContext() const override;
 
+  // |PlatformView|
+  std::shared_ptr<impeller::Context> GetImpellerContext() const override;
+
   // |PlatformView|
   std::unique_ptr<VsyncWaiter> CreateVSyncWaiter() override;
 
@@ -34,6 +34,7 @@
 #include "flutter/testing/assertions_skia.h"
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
@@ -4041,7 +4042,8 @@ TEST_F(EmbedderTest, ExternalTextureGLRefreshedTooOften) {
         res->width = res->height = 100;
         return res;
       });
-  EmbedderExternalTextureGL texture(1, callback);
+  EmbedderExternalTextureGL texture(
+      1, callback, std::make_shared<EmbedderExternalTextureFrameQueue>());
 
   auto skia_surface = surface.GetOnscreenSurface();
   auto canvas = skia_surface->getCanvas();
@@ -4069,6 +4071,78 @@ TEST_F(EmbedderTest, ExternalTextureGLRefreshedTooOften) {
   EXPECT_TRUE(resolve_called);
 }
 
+TEST_F(EmbedderTest, ExternalTextureGLDrawsSubmittedFramesOnceReady) {
+  TestGLSurface surface(SkISize::Make(100, 100));
+  auto context = surface.GetGrContext();
+
+  typedef void (*glGenTexturesProc)(uint32_t n, uint32_t * textures);
+  glGenTexturesProc glGenTextures;
+
+  glGenTextures = reinterpret_cast<glGenTexturesProc>(
+      surface.GetProcAddress("glGenTextures"));
+
+  uint32_t names[2];
+  glGenTextures(2, names);
+
+  bool resolve_called = false;
+  EmbedderExternalTextureGL::ExternalTextureCallback callback(
+      [&](int64_t, size_t, size_t) {
+        resolve_called = true;
+        return nullptr;
+      });
+  auto frame_queue = std::make_shared<EmbedderExternalTextureFrameQueue>();
+  EmbedderExternalTextureGL texture(1, callback, frame_queue);
+
+  int collected_count = 0;
+  auto make_frame = [&](uint32_t name) {
+    FlutterOpenGLTexture gl_texture = {};
+    gl_texture.target = GL_TEXTURE_2D;
+    gl_texture.name = name;
+    gl_texture.format = GL_RGBA8;
+    gl_texture.user_data = &collected_count;
+    gl_texture.destruction_callback = [](void* user_data) {
+      (*reinterpret_cast<int*>(user_data))++;
+    };
+    gl_texture.width = gl_texture.height = 100;
+    return EmbedderExternalTextureFrame(gl_texture);
+  };
+
+  bool second_frame_ready = false;
+  frame_queue->Submit(make_frame(names[0]), nullptr);
+  frame_queue->Submit(
+      make_frame(names[1]),
+      std::make_shared<EmbedderExternalTextureFence>(
+          [](void* user_data) { return *reinterpret_cast<bool*>(user_data); },
+          &second_frame_ready));
+
+  auto skia_surface = surface.GetOnscreenSurface();
+  auto canvas = skia_surface->getCanvas();
+
+  Texture* texture_ = &texture;
+  Texture::PaintContext ctx{
+      .canvas = canvas,
+      .gr_context = context.get(),
+  };
+
+  // The first frame is drawn while the second one isn't ready.
+  texture_->Paint(ctx, SkRect::MakeXYWH(0, 0, 100, 100), false,
+                  SkSamplingOptions(SkFilterMode::kLinear));
+  texture_->MarkNewFrameAvailable();
+  texture_->Paint(ctx, SkRect::MakeXYWH(0, 0, 100, 100), false,
+                  SkSamplingOptions(SkFilterMode::kLinear));
+  EXPECT_FALSE(resolve_called);
+  EXPECT_EQ(frame_queue->GetDroppedFrameCount(), 0u);
+  EXPECT_EQ(collected_count, 0);
+
+  second_frame_ready = true;
+  texture_->Paint(ctx, SkRect::MakeXYWH(0, 0, 100, 100), false,
+                  SkSamplingOptions(SkFilterMode::kLinear));
+  context->flushAndSubmit(true);
+  EXPECT_FALSE(resolve_called);
+  // Skia collects the first frame once it isn't sampled anymore.
+  EXPECT_EQ(collected_count, 1);
+}
+
 TEST_F(EmbedderTest,
        PresentInfoReceivesNoDamageWhenPopulateExistingDamageIsUndefined) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
@@ -4089,6 +4163,202 @@ TEST_F(EmbedderTest,
       });
 }
 
+#ifdef IMPELLER_ENABLE_OPENGLES
+
+//------------------------------------------------------------------------------
+/// With Impeller, the layers of a custom compositor must be presented in the
+/// same structure as with Skia, in framebuffer backing stores.
+///
+TEST_F(EmbedderTest, CompositorMustBeAbleToRenderToOpenGLFramebufferImpeller) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.AddCommandLineArgument("--enable-impeller");
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("can_composite_platform_views");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLFramebuffer);
+
+  fml::CountDownLatch latch(3);
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 3u);
+
+        for (size_t i : {0u, 2u}) {
+          ASSERT_EQ(layers[i]->type, kFlutterLayerContentTypeBackingStore);
+          const FlutterBackingStore& backing_store = *layers[i]->backing_store;
+          ASSERT_EQ(backing_store.type, kFlutterBackingStoreTypeOpenGL);
+          ASSERT_EQ(backing_store.open_gl.type,
+                    kFlutterOpenGLTargetTypeFramebuffer);
+          ASSERT_TRUE(backing_store.did_update);
+          ASSERT_EQ(layers[i]->size.width, 800.0);
+          ASSERT_EQ(layers[i]->size.height, 600.0);
+        }
+
+        ASSERT_EQ(layers[1]->type, kFlutterLayerContentTypePlatformView);
+        ASSERT_EQ(layers[1]->platform_view->identifier, 42);
+        ASSERT_EQ(layers[1]->size.width, 123.0);
+        ASSERT_EQ(layers[1]->size.height, 456.0);
+        ASSERT_EQ(layers[1]->offset.x, 1.0);
+        ASSERT_EQ(layers[1]->offset.y, 2.0);
+
+        latch.CountDown();
+      });
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&latch](Dart_NativeArguments args) { latch.CountDown(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+}
+
+//------------------------------------------------------------------------------
+/// Impeller must render the layers into the framebuffers supplied by the
+/// embedder.
+///
+TEST_F(EmbedderTest, CompositorRendersIntoOpenGLFramebufferWithImpeller) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.AddCommandLineArgument("--enable-impeller");
+  builder.SetOpenGLRendererConfig(SkISize::Make(80, 60));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLFramebuffer);
+
+  auto scene_image = context.GetNextSceneImage();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 80;
+  event.height = 60;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  auto image = scene_image.get();
+  ASSERT_TRUE(image);
+  SkPixmap pixmap;
+  ASSERT_TRUE(image->peekPixels(&pixmap));
+  for (const SkIPoint& point : {SkIPoint::Make(0, 0), SkIPoint::Make(40, 30),
+                                SkIPoint::Make(79, 59)}) {
+    ASSERT_EQ(pixmap.getColor(point.x(), point.y()), SK_ColorRED)
+        << "at " << point.x() << ", " << point.y();
+  }
+}
+
+//------------------------------------------------------------------------------
+/// The framebuffers wrapped by Impeller must be returned to the embedder when
+/// the render targets are collected.
+///
+TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycledWithImpeller) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.AddCommandLineArgument("--enable-impeller");
+  builder.SetOpenGLRendererConfig(SkISize::Make(300, 200));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("render_targets_are_recycled");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLFramebuffer);
+
+  fml::CountDownLatch latch(2);
+
+  context.AddNativeCallback("SignalNativeTest",
+                            CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                              latch.CountDown();
+                            }));
+
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 20u);
+        latch.CountDown();
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+  ASSERT_EQ(context.GetCompositor().GetPendingBackingStoresCount(), 10u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCreatedCount(), 10u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 0u);
+  // Killing the engine should immediately collect all pending render targets.
+  engine.reset();
+  ASSERT_EQ(context.GetCompositor().GetPendingBackingStoresCount(), 0u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCreatedCount(), 10u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
+}
+
+//------------------------------------------------------------------------------
+/// Impeller can't render into texture backing stores. They must be collected
+/// right away instead of being presented.
+///
+TEST_F(EmbedderTest, ImpellerCollectsOpenGLTextureBackingStores) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.AddCommandLineArgument("--enable-impeller");
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("can_composite_platform_views");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  fml::AutoResetWaitableEvent collected;
+  context.GetCompositor().AddOnCollectRenderTargetCallback(
+      [&collected]() { collected.Signal(); });
+  std::atomic<size_t> present_count = 0u;
+  context.GetCompositor().AddOnPresentCallback(
+      [&present_count]() { present_count++; });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  collected.Wait();
+  engine.reset();
+  ASSERT_GT(context.GetCompositor().GetBackingStoresCreatedCount(), 0u);
+  ASSERT_EQ(context.GetCompositor().GetPendingBackingStoresCount(), 0u);
+  ASSERT_EQ(present_count.load(), 0u);
+}
+
+#endif  // IMPELLER_ENABLE_OPENGLES
+
 INSTANTIATE_TEST_SUITE_P(
     EmbedderTestGlVk,
     EmbedderTestMultiBackend,
@@ -25,6 +25,10 @@ bool EmbedderTestCompositorGL::UpdateOffscrenComposition(
     size_t layers_count) {
   last_composition_ = nullptr;
 
+  // The backing stores may have been rendered by Impeller, which doesn't tell
+  // Skia about the GL state it changed.
+  context_->resetContext();
+
   const auto image_info = SkImageInfo::MakeN32Premul(surface_size_);
 
   auto surface =
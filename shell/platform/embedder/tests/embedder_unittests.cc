@@ -240,6 +240,91 @@ TEST_F(EmbedderTest, CanSpecifyCustomPlatformTaskRunner) {
   signaled_once = false;
 }
 
+TEST_F(EmbedderTest, CanSpecifyCustomPlatformTaskRunnerThatQueuesTasks) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  fml::AutoResetWaitableEvent latch;
+
+  auto platform_task_runner = CreateNewThread("test_platform_thread");
+  static std::mutex engine_mutex;
+  static size_t tasks_pending_count = 0;
+  static size_t run_tasks_count = 0;
+  UniqueEngine engine;
+
+  struct TaskRunnerState {
+    fml::RefPtr<fml::TaskRunner> real_task_runner;
+    std::function<void(FlutterTaskRunner, uint64_t)> run_tasks_at;
+  } state;
+  state.real_task_runner = platform_task_runner;
+  // Runs the queued tasks at the target time, and again at the target time
+  // of the tasks left, without waiting for the tasks pending callback.
+  state.run_tasks_at =
+      [&](FlutterTaskRunner task_runner, uint64_t target_time_nanos) {
+        platform_task_runner->PostTaskForTime(
+            [&, task_runner]() {
+              std::scoped_lock lock(engine_mutex);
+              if (!engine.is_valid()) {
+                return;
+              }
+              uint64_t next_target_time_nanos = 0;
+              ASSERT_EQ(FlutterEngineRunTasks(engine.get(), task_runner, 0,
+                                              &next_target_time_nanos),
+                        kSuccess);
+              if (++run_tasks_count == 1) {
+                latch.Signal();
+              }
+              if (next_target_time_nanos != 0) {
+                state.run_tasks_at(task_runner, next_target_time_nanos);
+              }
+            },
+            fml::TimePoint::FromEpochDelta(
+                fml::TimeDelta::FromNanoseconds(target_time_nanos)));
+      };
+
+  FlutterTaskRunnerDescription task_runner_description = {};
+  task_runner_description.struct_size = sizeof(FlutterTaskRunnerDescription);
+  task_runner_description.user_data = &state;
+  task_runner_description.runs_task_on_current_thread_callback =
+      [](void* user_data) -> bool {
+    return reinterpret_cast<TaskRunnerState*>(user_data)
+        ->real_task_runner->RunsTasksOnCurrentThread();
+  };
+  task_runner_description.tasks_pending_callback =
+      [](FlutterTaskRunner task_runner, uint64_t target_time_nanos,
+         void* user_data) -> void {
+    tasks_pending_count++;
+    reinterpret_cast<TaskRunnerState*>(user_data)->run_tasks_at(
+        task_runner, target_time_nanos);
+  };
+  task_runner_description.identifier = 1000;
+
+  platform_task_runner->PostTask([&]() {
+    EmbedderConfigBuilder builder(context);
+    builder.SetSoftwareRendererConfig();
+    builder.SetPlatformTaskRunner(&task_runner_description);
+    builder.SetDartEntrypoint("invokePlatformTaskRunner");
+    std::scoped_lock lock(engine_mutex);
+    engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+  });
+
+  // Signaled once queued tasks were run.
+  latch.Wait();
+
+  fml::AutoResetWaitableEvent kill_latch;
+  platform_task_runner->PostTask(fml::MakeCopyable([&]() mutable {
+    std::scoped_lock lock(engine_mutex);
+    ASSERT_TRUE(engine.is_valid());
+    ASSERT_GE(tasks_pending_count, 1u);
+    engine.reset();
+    platform_task_runner->PostTask([&kill_latch] { kill_latch.Signal(); });
+  }));
+  kill_latch.Wait();
+
+  ASSERT_GE(run_tasks_count, 1u);
+  tasks_pending_count = 0;
+  run_tasks_count = 0;
+}
+
 TEST(EmbedderTestNoFixture, CanGetCurrentTimeInNanoseconds) {
   auto point1 = fml::TimePoint::FromEpochDelta(
       fml::TimeDelta::FromNanoseconds(FlutterEngineGetCurrentTime()));
@@ -439,6 +524,156 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the data of a platform message sent without copies is released
+/// once the Dart application is done with it.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopies) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  // Large enough to be handed to Dart as external typed data.
+  const std::string message_data(4096, 'x');
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message =
+      reinterpret_cast<const uint8_t*>(message_data.data());
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  fml::AutoResetWaitableEvent released;
+  auto result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &platform_message,
+      [](void* user_data) {
+        reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+      },
+      &released);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+
+  // The external typed data is finalized at the latest when the isolate shuts
+  // down.
+  engine.reset();
+  released.Wait();
+}
+
+TEST_F(EmbedderTest, SharedRingBuffersAreReadWithoutPlatformMessages) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("shared_ring_buffer");
+
+  fml::AutoResetWaitableEvent ready, message;
+  std::string received_message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &received_message](Dart_NativeArguments args) {
+            received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  // The indices, then a ring of 8 bytes.
+  alignas(8) uint8_t memory[24] = {};
+  uint64_t* indices = reinterpret_cast<uint64_t*>(memory);
+  fml::AutoResetWaitableEvent released;
+  FlutterSharedRingBuffer ring_buffer = {};
+  ring_buffer.struct_size = sizeof(FlutterSharedRingBuffer);
+  ring_buffer.name = "test_ring";
+  ring_buffer.data = memory;
+  ring_buffer.size = sizeof(memory);
+  ring_buffer.release_callback = [](void* user_data) {
+    reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+  };
+  ring_buffer.user_data = &released;
+  ASSERT_EQ(FlutterEngineRegisterSharedRingBuffer(engine.get(), &ring_buffer),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineRegisterSharedRingBuffer(engine.get(), &ring_buffer),
+            kInvalidArguments);
+
+  // Nothing opened the ring buffer yet.
+  ASSERT_EQ(FlutterEngineNotifySharedRingBuffer(engine.get(), "test_ring", 0),
+            kInvalidArguments);
+
+  // Have the application open the ring buffer.
+  fml::AutoResetWaitableEvent opened;
+  FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+  ASSERT_EQ(FlutterPlatformMessageCreateResponseHandle(
+                engine.get(),
+                [](const uint8_t* data, size_t size, void* user_data) {
+                  reinterpret_cast<fml::AutoResetWaitableEvent*>(user_data)
+                      ->Signal();
+                },
+                &opened, &response_handle),
+            kSuccess);
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.response_handle = response_handle;
+  ASSERT_EQ(FlutterEngineSendPlatformMessage(engine.get(), &platform_message),
+            kSuccess);
+  FlutterPlatformMessageReleaseResponseHandle(engine.get(), response_handle);
+  opened.Wait();
+
+  // Write across the end of the ring.
+  indices[0] = 6;
+  indices[1] = 6;
+  const std::string data = "flutter";
+  for (size_t i = 0; i < data.size(); i++) {
+    memory[16 + (indices[0] + i) % 8] = data[i];
+  }
+  indices[0] += data.size();
+  ASSERT_EQ(FlutterEngineNotifySharedRingBuffer(engine.get(), "test_ring",
+                                                indices[0]),
+            kSuccess);
+  message.Wait();
+  ASSERT_EQ(received_message, data);
+  ASSERT_EQ(indices[1], indices[0]);
+
+  ASSERT_EQ(FlutterEngineUnregisterSharedRingBuffer(engine.get(), "test_ring"),
+            kSuccess);
+  ASSERT_EQ(FlutterEngineUnregisterSharedRingBuffer(engine.get(), "test_ring"),
+            kInvalidArguments);
+
+  // The view of the application is finalized at the latest when the isolate
+  // shuts down.
+  engine.reset();
+  released.Wait();
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message can be sent.
 ///
@@ -793,6 +1028,92 @@ TEST_F(EmbedderTest,
   ASSERT_EQ(context.GetSurfacePresentCount(), 0u);
 }
 
+//------------------------------------------------------------------------------
+/// Test that the layers rendered concurrently into cycled backing stores by a
+/// software compositor are the same, and that their damage is reported.
+///
+TEST_F(EmbedderTest,
+       CompositorMustBeAbleToRenderKnownSceneConcurrentlyWithDamage) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.GetCompositor().backing_store_buffer_count = 2;
+  builder.GetCompositor().render_thread_count = 4;
+  builder.SetDartEntrypoint("can_composite_platform_views_with_known_scene");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kSoftwareBuffer);
+
+  fml::CountDownLatch latch(5);
+
+  auto scene_image = context.GetNextSceneImage();
+
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 5u);
+
+        for (size_t i = 0; i < layers_count; i++) {
+          if (layers[i]->type == kFlutterLayerContentTypePlatformView) {
+            ASSERT_EQ(layers[i]->damage, nullptr);
+            continue;
+          }
+          // The layers of the first frame are damaged entirely.
+          ASSERT_NE(layers[i]->damage, nullptr);
+          ASSERT_EQ(layers[i]->damage->num_rects, 1u);
+          const FlutterRect& rect = layers[i]->damage->damage[0];
+          ASSERT_EQ(rect.left, 0.0);
+          ASSERT_EQ(rect.top, 0.0);
+          ASSERT_EQ(rect.right, 800.0);
+          ASSERT_EQ(rect.bottom, 600.0);
+        }
+
+        latch.CountDown();
+      });
+
+  context.GetCompositor().SetPlatformViewRendererCallback(
+      [&](const FlutterLayer& layer, GrDirectContext*
+          /* don't use because software compositor */) -> sk_sp<SkImage> {
+        auto surface = CreateRenderSurface(
+            layer, nullptr /* null because software compositor */);
+        auto canvas = surface->getCanvas();
+        FML_CHECK(canvas != nullptr);
+
+        SkPaint paint;
+        // See dart test for total order.
+        paint.setColor(layer.platform_view->identifier == 1 ? SK_ColorGREEN
+                                                            : SK_ColorMAGENTA);
+        paint.setAlpha(127);
+        canvas->drawRect(SkRect::MakeWH(layer.size.width, layer.size.height),
+                         paint);
+        latch.CountDown();
+
+        return surface->makeImageSnapshot();
+      });
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&latch](Dart_NativeArguments args) { latch.CountDown(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+
+  ASSERT_TRUE(ImageMatchesFixture("compositor_software.png", scene_image));
+}
+
 //------------------------------------------------------------------------------
 /// Test that an engine can be initialized but not run.
 ///
@@ -2202,6 +2523,29 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetFrameTimingStatistics) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameTimingStatistics statistics = {};
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), &statistics),
+            kInvalidArguments);
+
+  statistics.struct_size = sizeof(statistics);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStatistics(engine.get(), &statistics),
+            kSuccess);
+  ASSERT_EQ(statistics.struct_size, sizeof(statistics));
+  // No window of frames has ended yet.
+  ASSERT_FALSE(statistics.has_frames);
+  ASSERT_EQ(statistics.frame_count, 0u);
+  ASSERT_EQ(statistics.window_duration_nanos,
+            static_cast<uint64_t>(flutter::FrameTimingHistograms::
+                                      kWindowDuration.ToNanoseconds()));
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
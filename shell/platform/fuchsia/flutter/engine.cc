@@ -255,9 +255,12 @@ void Engine::Initialize(
   fml::AutoResetWaitableEvent view_embedder_latch;
   auto session_inspect_node =
       dart_utils::RootInspectNode::CreateRootChild("vsync_stats");
+  auto surface_pool_inspect_node =
+      dart_utils::RootInspectNode::CreateRootChild("vulkan_surface_pool");
   task_runners.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
       [this, &view_embedder_latch,
        session_inspect_node = std::move(session_inspect_node),
+       surface_pool_inspect_node = std::move(surface_pool_inspect_node),
        session = std::move(session), flatland = std::move(flatland),
        session_error_callback = std::move(session_error_callback), use_flatland,
        view_token = std::move(view_token_),
@@ -274,7 +277,8 @@ void Engine::Initialize(
                 /*scenic_session=*/nullptr);
           } else {
             surface_producer_ = std::make_shared<VulkanSurfaceProducer>(
-                /*scenic_session=*/nullptr);
+                /*scenic_session=*/nullptr,
+                std::move(surface_pool_inspect_node));
           }
 
           flatland_connection_ = std::make_shared<FlatlandConnection>(
@@ -432,9 +436,12 @@ void Engine::Initialize(
                std::move(on_request_announce_callback),
            external_view_embedder = GetExternalViewEmbedder(),
            await_vsync_callback =
-               [this, use_flatland](FireCallbackCallback cb) {
+               [this, use_flatland](
+                   FireCallbackCallback cb,
+                   std::optional<fml::TimeDelta> predicted_frame_duration) {
                  if (use_flatland) {
-                   flatland_connection_->AwaitVsync(cb);
+                   flatland_connection_->AwaitVsync(cb,
+                                                    predicted_frame_duration);
                  } else {
                    session_connection_->AwaitVsync(cb);
                  }
@@ -1021,6 +1028,13 @@ void Engine::OnLevelChanged(
     FML_LOG(WARNING)
         << "memorypressure watcher: notifying Flutter that memory is low";
     shell_->NotifyLowMemoryWarning();
+
+    // Release the memory held by the surfaces that aren't used anymore.
+    shell_->GetTaskRunners().GetRasterTaskRunner()->PostTask([this]() {
+      if (surface_producer_) {
+        surface_producer_->OnMemoryPressure();
+      }
+    });
   }
   latest_memory_pressure_level_ = level;
 }
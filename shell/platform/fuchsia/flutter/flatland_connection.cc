@@ -85,8 +85,11 @@ void FlatlandConnection::DoPresent() {
 }
 
 // This method is called from the UI thread.
-void FlatlandConnection::AwaitVsync(FireCallbackCallback callback) {
+void FlatlandConnection::AwaitVsync(
+    FireCallbackCallback callback,
+    std::optional<fml::TimeDelta> predicted_frame_duration) {
   std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+  threadsafe_state_.predicted_frame_duration_ = predicted_frame_duration;
 
   // Immediately fire callbacks until the first Present. We might receive
   // multiple requests for AwaitVsync() until the first Present, which relies on
@@ -101,9 +104,10 @@ void FlatlandConnection::AwaitVsync(FireCallbackCallback callback) {
 
   if (threadsafe_state_.fire_callback_pending_) {
     const fml::TimePoint now = fml::TimePoint::Now();
-    threadsafe_state_.fire_callback_(
+    const auto [frame_start, frame_target] = GetNextFrameTimes(
         now, GetNextPresentationTime(
                  now, threadsafe_state_.next_presentation_time_));
+    threadsafe_state_.fire_callback_(frame_start, frame_target);
     threadsafe_state_.fire_callback_ = nullptr;
     threadsafe_state_.fire_callback_pending_ = false;
   }
@@ -118,6 +122,36 @@ void FlatlandConnection::AwaitVsyncForSecondaryCallback(
                     now, threadsafe_state_.next_presentation_time_));
 }
 
+std::optional<std::pair<fml::TimePoint, fml::TimePoint>>
+FlatlandConnection::SelectFrameTimes(
+    fml::TimePoint now,
+    fml::TimeDelta predicted_frame_duration,
+    const FuturePresentationInfos& future_presentation_infos) {
+  for (const auto& [latch_point, presentation_time] :
+       future_presentation_infos) {
+    if (now + predicted_frame_duration <= latch_point) {
+      return std::make_pair(latch_point - predicted_frame_duration,
+                            presentation_time);
+    }
+  }
+  return std::nullopt;
+}
+
+std::pair<fml::TimePoint, fml::TimePoint> FlatlandConnection::GetNextFrameTimes(
+    fml::TimePoint now,
+    fml::TimePoint default_frame_target) {
+  if (threadsafe_state_.predicted_frame_duration_) {
+    auto frame_times = SelectFrameTimes(
+        now, threadsafe_state_.predicted_frame_duration_.value(),
+        threadsafe_state_.future_presentation_infos_);
+    if (frame_times) {
+      TRACE_EVENT_INSTANT0("flutter", "FlatlandConnection::LatchPointTargeted");
+      return frame_times.value();
+    }
+  }
+  return std::make_pair(now, default_frame_target);
+}
+
 void FlatlandConnection::OnError(
     fuchsia::ui::composition::FlatlandError error) {
   FML_LOG(ERROR) << "Flatland error: " << static_cast<int>(error);
@@ -140,16 +174,30 @@ void FlatlandConnection::OnNextFrameBegin(
     const auto next_presentation_time =
         fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(
             values.future_presentation_infos().front().presentation_time()));
+    FuturePresentationInfos future_presentation_infos;
+    for (const auto& info : values.future_presentation_infos()) {
+      if (!info.has_latch_point() || !info.has_presentation_time()) {
+        continue;
+      }
+      future_presentation_infos.emplace_back(
+          fml::TimePoint::FromEpochDelta(
+              fml::TimeDelta::FromNanoseconds(info.latch_point())),
+          fml::TimePoint::FromEpochDelta(
+              fml::TimeDelta::FromNanoseconds(info.presentation_time())));
+    }
 
     std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+    threadsafe_state_.next_presentation_time_ = next_presentation_time;
+    threadsafe_state_.future_presentation_infos_ =
+        std::move(future_presentation_infos);
     if (threadsafe_state_.fire_callback_) {
-      threadsafe_state_.fire_callback_(
-          /*frame_start=*/fml::TimePoint::Now(),
-          /*frame_target=*/next_presentation_time);
+      const auto [frame_start, frame_target] =
+          GetNextFrameTimes(/*now=*/fml::TimePoint::Now(),
+                            /*default_frame_target=*/next_presentation_time);
+      threadsafe_state_.fire_callback_(frame_start, frame_target);
       threadsafe_state_.fire_callback_ = nullptr;
     } else {
       threadsafe_state_.fire_callback_pending_ = true;
-      threadsafe_state_.next_presentation_time_ = next_presentation_time;
     }
   }
 }
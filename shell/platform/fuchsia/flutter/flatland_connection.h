@@ -16,7 +16,10 @@
 
 #include <cstdint>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace flutter_runner {
 
@@ -41,14 +44,33 @@ class FlatlandConnection final {
 
   ~FlatlandConnection();
 
+  // Pairs of latch points and presentation times of future frames.
+  using FuturePresentationInfos =
+      std::vector<std::pair<fml::TimePoint, fml::TimePoint>>;
+
   void Present();
 
   // Used to implement VsyncWaiter functionality.
   // Note that these two methods are called from the UI thread while the
   // rest of the methods on this class are called from the raster thread.
-  void AwaitVsync(FireCallbackCallback callback);
+  //
+  // When |predicted_frame_duration| is known, the frame targets the first
+  // presentation whose latch point it can hit.
+  void AwaitVsync(
+      FireCallbackCallback callback,
+      std::optional<fml::TimeDelta> predicted_frame_duration = std::nullopt);
   void AwaitVsyncForSecondaryCallback(FireCallbackCallback callback);
 
+  // Selects the start and target times of a frame that takes
+  // |predicted_frame_duration| to build and rasterize. The frame targets the
+  // first of |future_presentation_infos| whose latch point it can hit if
+  // started at |now|, and starts as late as possible to still hit it. Returns
+  // std::nullopt if none of the latch points can be hit.
+  static std::optional<std::pair<fml::TimePoint, fml::TimePoint>>
+  SelectFrameTimes(fml::TimePoint now,
+                   fml::TimeDelta predicted_frame_duration,
+                   const FuturePresentationInfos& future_presentation_infos);
+
   fuchsia::ui::composition::Flatland* flatland() { return flatland_.get(); }
 
   fuchsia::ui::composition::TransformId NextTransformId() {
@@ -70,6 +92,13 @@ class FlatlandConnection final {
   void OnFramePresented(fuchsia::scenic::scheduling::FramePresentedInfo info);
   void DoPresent();
 
+  // Returns the start and target times of the next frame, which targets
+  // |default_frame_target| if no latch point can be selected.
+  // |threadsafe_state_| must be locked.
+  std::pair<fml::TimePoint, fml::TimePoint> GetNextFrameTimes(
+      fml::TimePoint now,
+      fml::TimePoint default_frame_target);
+
   fuchsia::ui::composition::FlatlandPtr flatland_;
 
   fml::closure error_callback_;
@@ -93,6 +122,8 @@ class FlatlandConnection final {
     bool fire_callback_pending_ = false;
     bool first_present_called_ = false;
     fml::TimePoint next_presentation_time_;
+    FuturePresentationInfos future_presentation_infos_;
+    std::optional<fml::TimeDelta> predicted_frame_duration_;
   } threadsafe_state_;
 
   std::vector<zx::event> acquire_fences_;
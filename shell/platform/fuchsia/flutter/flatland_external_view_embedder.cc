@@ -224,6 +224,11 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
     const float inv_dpr = 1.0f / frame_dpr_;
     flatland_->flatland()->SetScale(root_transform_id_, {inv_dpr, inv_dpr});
 
+    // The children of the root transform in this frame, and whether each
+    // FlatlandLayer shows an image in this frame.
+    std::vector<fuchsia::ui::composition::TransformId> frame_child_transforms;
+    std::vector<bool> flatland_layers_used(flatland_layers_.size(), false);
+
     size_t flatland_layer_index = 0;
     for (const auto& layer_id : frame_composition_order_) {
       const auto& layer = frame_layers_.find(layer_id);
@@ -279,6 +284,12 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
 
         // Set clip regions.
         if (view_mutators.clips != viewport.mutators.clips) {
+          // The viewport's transform is about to become the child of a clip
+          // transform, so it must not stay attached to the root.
+          if (!view_mutators.clips.empty()) {
+            DetachChildTransform(viewport.transform_id);
+          }
+
           // Expand the clip_transforms array to fit any new transforms.
           while (viewport.clip_transforms.size() < view_mutators.clips.size()) {
             ClipTransform clip_transform;
@@ -355,9 +366,7 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
             viewport.mutators.clips.empty()
                 ? viewport.transform_id
                 : viewport.clip_transforms[0].transform_id;
-        flatland_->flatland()->AddChild(root_transform_id_,
-                                        main_child_transform);
-        child_transforms_.emplace_back(main_child_transform);
+        frame_child_transforms.emplace_back(main_child_transform);
       }
 
       // Acquire the surface associated with the layer.
@@ -386,16 +395,37 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
           FlatlandLayer new_layer{.transform_id = flatland_->NextTransformId()};
           flatland_->flatland()->CreateTransform(new_layer.transform_id);
           flatland_layers_.emplace_back(std::move(new_layer));
+          flatland_layers_used.push_back(false);
         }
+        flatland_layers_used[flatland_layer_index] = true;
 
         // Update the image content and set size.
-        flatland_->flatland()->SetContent(
-            flatland_layers_[flatland_layer_index].transform_id,
-            {surface_for_layer->GetImageId()});
+        const uint32_t image_id = surface_for_layer->GetImageId();
+        auto& flatland_layer = flatland_layers_[flatland_layer_index];
+        if (flatland_layer.image_id.value != image_id) {
+          flatland_->flatland()->SetContent(flatland_layer.transform_id,
+                                            {image_id});
+          flatland_layer.image_id = {image_id};
+        }
+        const SkISize viewport_size = surface_for_layer->GetViewportSize();
         flatland_->flatland()->SetImageDestinationSize(
-            {surface_for_layer->GetImageId()},
-            {static_cast<uint32_t>(surface_for_layer->GetSize().width()),
-             static_cast<uint32_t>(surface_for_layer->GetSize().height())});
+            {image_id}, {static_cast<uint32_t>(viewport_size.width()),
+                         static_cast<uint32_t>(viewport_size.height())});
+
+        // Surfaces may be larger than the frame, in which case only their
+        // top-left corner is shown.
+        if (viewport_size != surface_for_layer->GetSize()) {
+          flatland_->flatland()->SetImageSampleRegion(
+              {image_id},
+              {0.f, 0.f, static_cast<float>(viewport_size.width()),
+               static_cast<float>(viewport_size.height())});
+          cropped_images_.insert(image_id);
+        } else if (cropped_images_.erase(image_id) > 0) {
+          const SkISize& size = surface_for_layer->GetSize();
+          flatland_->flatland()->SetImageSampleRegion(
+              {image_id}, {0.f, 0.f, static_cast<float>(size.width()),
+                           static_cast<float>(size.height())});
+        }
 
         // Flutter Embedder lacks an API to detect if a layer has alpha or not.
         // For now, we assume any layer beyond the first has alpha.
@@ -431,10 +461,7 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
         }
 
         // Attach the FlatlandLayer to the main scene graph.
-        flatland_->flatland()->AddChild(
-            root_transform_id_,
-            flatland_layers_[flatland_layer_index].transform_id);
-        child_transforms_.emplace_back(
+        frame_child_transforms.emplace_back(
             flatland_layers_[flatland_layer_index].transform_id);
       }
 
@@ -446,9 +473,18 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
     // will capture all input, and any unwanted input will be reinjected into
     // embedded views.
     if (input_interceptor_transform_.has_value()) {
-      flatland_->flatland()->AddChild(root_transform_id_,
-                                      *input_interceptor_transform_);
-      child_transforms_.emplace_back(*input_interceptor_transform_);
+      frame_child_transforms.emplace_back(*input_interceptor_transform_);
+    }
+
+    SetChildTransforms(std::move(frame_child_transforms));
+
+    // Clear images on unused layers so they aren't cached unnecessarily.
+    for (size_t i = 0; i < flatland_layers_.size(); i++) {
+      if (!flatland_layers_used[i] && flatland_layers_[i].image_id.value != 0) {
+        flatland_->flatland()->SetContent(flatland_layers_[i].transform_id,
+                                          {0});
+        flatland_layers_[i].image_id = {0};
+      }
     }
   }
 
@@ -473,8 +509,9 @@ void FlatlandExternalViewEmbedder::SubmitFrame(
 
       sk_sp<SkSurface> sk_surface = surface->GetSkiaSurface();
       FML_CHECK(sk_surface != nullptr);
-      FML_CHECK(SkISize::Make(sk_surface->width(), sk_surface->height()) ==
-                frame_size_);
+      FML_CHECK(surface->GetViewportSize() == frame_size_);
+      FML_CHECK(sk_surface->width() >= frame_size_.width() &&
+                sk_surface->height() >= frame_size_.height());
       SkCanvas* canvas = sk_surface->getCanvas();
       FML_CHECK(canvas != nullptr);
 
@@ -588,16 +625,45 @@ void FlatlandExternalViewEmbedder::Reset() {
   frame_composition_order_.clear();
   frame_size_ = SkISize::Make(0, 0);
   frame_dpr_ = 1.f;
+}
+
+void FlatlandExternalViewEmbedder::SetChildTransforms(
+    std::vector<fuchsia::ui::composition::TransformId> child_transforms) {
+  // Children are drawn in the order they were added, so the children after
+  // the first difference are all re-attached.
+  size_t common_children = 0;
+  while (common_children < child_transforms.size() &&
+         common_children < child_transforms_.size() &&
+         child_transforms[common_children].value ==
+             child_transforms_[common_children].value) {
+    common_children++;
+  }
+  if (common_children == child_transforms.size() &&
+      common_children == child_transforms_.size()) {
+    return;
+  }
 
-  // Clear all children from root.
-  for (const auto& transform : child_transforms_) {
-    flatland_->flatland()->RemoveChild(root_transform_id_, transform);
+  TRACE_EVENT1("flutter", "FlatlandExternalViewEmbedder::SetChildTransforms",
+               "reattached", child_transforms.size() - common_children);
+  for (size_t i = common_children; i < child_transforms_.size(); i++) {
+    flatland_->flatland()->RemoveChild(root_transform_id_,
+                                       child_transforms_[i]);
   }
-  child_transforms_.clear();
+  for (size_t i = common_children; i < child_transforms.size(); i++) {
+    flatland_->flatland()->AddChild(root_transform_id_, child_transforms[i]);
+  }
+  child_transforms_ = std::move(child_transforms);
+}
 
-  // Clear images on all layers so they aren't cached unnecessarily.
-  for (const auto& layer : flatland_layers_) {
-    flatland_->flatland()->SetContent(layer.transform_id, {0});
+void FlatlandExternalViewEmbedder::DetachChildTransform(
+    fuchsia::ui::composition::TransformId transform_id) {
+  auto itr = std::find_if(child_transforms_.begin(), child_transforms_.end(),
+                          [transform_id](const auto& id) {
+                            return id.value == transform_id.value;
+                          });
+  if (itr != child_transforms_.end()) {
+    flatland_->flatland()->RemoveChild(root_transform_id_, *itr);
+    child_transforms_.erase(itr);
   }
 }
 
@@ -14,6 +14,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "flutter/flow/embedded_views.h"
@@ -123,6 +124,16 @@ class FlatlandExternalViewEmbedder final
  private:
   void Reset();  // Reset state for a new frame.
 
+  // Makes |child_transforms| the children of the root transform, in order.
+  // Only the children that differ from the previous frame are updated, so
+  // that a frame that doesn't change the structure of the scene doesn't
+  // re-attach every layer and child view.
+  void SetChildTransforms(
+      std::vector<fuchsia::ui::composition::TransformId> child_transforms);
+
+  // Detaches |transform_id| from the root transform if it is a child of it.
+  void DetachChildTransform(fuchsia::ui::composition::TransformId transform_id);
+
   // This struct represents a transformed clip rect.
   struct TransformedClip {
     SkMatrix transform = SkMatrix::I();
@@ -193,6 +204,8 @@ class FlatlandExternalViewEmbedder final
   struct FlatlandLayer {
     // Transform on which Images are set.
     fuchsia::ui::composition::TransformId transform_id;
+    // The Image currently set on |transform_id|, if not 0.
+    fuchsia::ui::composition::ContentId image_id = {0};
   };
 
   std::shared_ptr<FlatlandConnection> flatland_;
@@ -204,6 +217,9 @@ class FlatlandExternalViewEmbedder final
 
   std::unordered_map<int64_t, FlatlandView> flatland_views_;
   std::vector<FlatlandLayer> flatland_layers_;
+  // The images that only show the viewport of a larger surface, and thus have
+  // a sample region that must be reset once the whole surface is shown again.
+  std::unordered_set<uint64_t> cropped_images_;
 
   std::unordered_map<EmbedderLayerId, EmbedderLayer> frame_layers_;
   std::vector<EmbedderLayerId> frame_composition_order_;
@@ -47,6 +47,9 @@ class SoftwareSurface final : public SurfaceProducerSurface {
   // |SurfaceProducerSurface|
   SkISize GetSize() const override;
 
+  // |SurfaceProducerSurface|
+  SkISize GetViewportSize() const override;
+
   // |SurfaceProducerSurface|
   void SignalWritesFinished(
       const std::function<void(void)>& on_surface_read_finished) override;
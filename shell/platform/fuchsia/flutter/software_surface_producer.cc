@@ -122,6 +122,15 @@ void SoftwareSurfaceProducer::SubmitSurfaces(
   AgeAndCollectOldBuffers();
 }
 
+void SoftwareSurfaceProducer::OnMemoryPressure() {
+  TRACE_EVENT0("flutter", "SoftwareSurfaceProducer::OnMemoryPressure");
+
+  // The surfaces that are still in use are recycled once they are released,
+  // and age out as usual.
+  available_surfaces_.clear();
+  TraceStats();
+}
+
 void SoftwareSurfaceProducer::SubmitSurface(
     std::unique_ptr<SurfaceProducerSurface> surface) {
   TRACE_EVENT0("flutter", "SoftwareSurfacePool::SubmitSurface");
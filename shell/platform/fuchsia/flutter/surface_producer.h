@@ -35,6 +35,10 @@ class SurfaceProducerSurface {
 
   virtual SkISize GetSize() const = 0;
 
+  // The size of the rendered part of the surface, at its origin. It is smaller
+  // than |GetSize| if the surface was allocated larger than requested.
+  virtual SkISize GetViewportSize() const = 0;
+
   virtual void SetImageId(uint32_t image_id) = 0;
 
   virtual uint32_t GetImageId() = 0;
@@ -76,6 +80,10 @@ class SurfaceProducer {
 
   virtual void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) = 0;
+
+  // Releases as much of the memory held by unused surfaces as possible.
+  // Called when the system is low on memory.
+  virtual void OnMemoryPressure() = 0;
 };
 
 }  // namespace flutter_runner
@@ -489,4 +489,97 @@ TEST_F(FlatlandConnectionTest, PresentCreditExhaustion) {
   EXPECT_EQ(num_release_fences, num_onfb);
 }
 
+TEST(FlatlandConnectionSelectFrameTimesTest, TargetsFirstReachableLatchPoint) {
+  const fml::TimePoint now =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromMilliseconds(100));
+  const FlatlandConnection::FuturePresentationInfos infos = {
+      {now + fml::TimeDelta::FromMilliseconds(4),
+       now + fml::TimeDelta::FromMilliseconds(8)},
+      {now + fml::TimeDelta::FromMilliseconds(20),
+       now + fml::TimeDelta::FromMilliseconds(24)},
+      {now + fml::TimeDelta::FromMilliseconds(36),
+       now + fml::TimeDelta::FromMilliseconds(40)},
+  };
+
+  // A short frame hits the first latch point, and starts as late as possible.
+  auto frame_times = FlatlandConnection::SelectFrameTimes(
+      now, fml::TimeDelta::FromMilliseconds(3), infos);
+  ASSERT_TRUE(frame_times.has_value());
+  EXPECT_EQ(frame_times->first, now + fml::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(frame_times->second, now + fml::TimeDelta::FromMilliseconds(8));
+
+  // A longer frame skips the latch points it can't hit.
+  frame_times = FlatlandConnection::SelectFrameTimes(
+      now, fml::TimeDelta::FromMilliseconds(10), infos);
+  ASSERT_TRUE(frame_times.has_value());
+  EXPECT_EQ(frame_times->first, now + fml::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(frame_times->second, now + fml::TimeDelta::FromMilliseconds(24));
+
+  // No latch point can be hit.
+  EXPECT_FALSE(FlatlandConnection::SelectFrameTimes(
+                   now, fml::TimeDelta::FromMilliseconds(40), infos)
+                   .has_value());
+  EXPECT_FALSE(FlatlandConnection::SelectFrameTimes(
+                   now, fml::TimeDelta::FromMilliseconds(3), {})
+                   .has_value());
+}
+
+TEST_F(FlatlandConnectionTest, AwaitVsyncTargetsLatchPoint) {
+  // Set up callbacks which allow sensing of how many presents were handled.
+  size_t presents_called = 0u;
+  fake_flatland().SetPresentHandler(
+      [&presents_called](auto present_args) { presents_called++; });
+
+  // Create the FlatlandConnection and pump the loop to process the initial
+  // FIDL calls.
+  flutter_runner::FlatlandConnection flatland_connection(
+      GetCurrentTestName(), TakeFlatlandHandle(), []() { FAIL(); },
+      [](auto...) {}, 1, fml::TimeDelta::Zero());
+  loop().RunUntilIdle();
+
+  flatland_connection.Present();
+  loop().RunUntilIdle();
+  EXPECT_EQ(presents_called, 1u);
+
+  // The first latch point is too close for the predicted frame duration, so
+  // the frame targets the second one.
+  const fml::TimePoint now = fml::TimePoint::Now();
+  const fml::TimeDelta frame_duration = fml::TimeDelta::FromMilliseconds(50);
+  std::vector<fuchsia::scenic::scheduling::PresentationInfo> infos;
+  auto to_nanoseconds = [now](int64_t milliseconds) {
+    return (now + fml::TimeDelta::FromMilliseconds(milliseconds))
+        .ToEpochDelta()
+        .ToNanoseconds();
+  };
+  for (int64_t latch_ms : {10, 100, 200}) {
+    fuchsia::scenic::scheduling::PresentationInfo info;
+    info.set_latch_point(to_nanoseconds(latch_ms));
+    info.set_presentation_time(to_nanoseconds(latch_ms + 5));
+    infos.push_back(std::move(info));
+  }
+
+  bool fired = false;
+  fml::TimePoint frame_start;
+  fml::TimePoint frame_target;
+  flatland_connection.AwaitVsync(
+      [&](fml::TimePoint start, fml::TimePoint target) {
+        fired = true;
+        frame_start = start;
+        frame_target = target;
+      },
+      frame_duration);
+
+  fuchsia::ui::composition::OnNextFrameBeginValues on_next_frame_begin_values;
+  on_next_frame_begin_values.set_additional_present_credits(1);
+  on_next_frame_begin_values.set_future_presentation_infos(std::move(infos));
+  fake_flatland().FireOnNextFrameBeginEvent(
+      std::move(on_next_frame_begin_values));
+  loop().RunUntilIdle();
+
+  ASSERT_TRUE(fired);
+  EXPECT_EQ(frame_target, now + fml::TimeDelta::FromMilliseconds(105));
+  EXPECT_EQ(frame_start,
+            now + fml::TimeDelta::FromMilliseconds(100) - frame_duration);
+}
+
 }  // namespace flutter_runner::testing
@@ -87,6 +87,8 @@ class FakeSurfaceProducerSurface : public SurfaceProducerSurface {
     return SkISize::Make(surface_->width(), surface_->height());
   }
 
+  SkISize GetViewportSize() const override { return GetSize(); }
+
   void SetImageId(uint32_t image_id) override { image_id_ = image_id; }
   uint32_t GetImageId() override { return image_id_; }
 
@@ -177,6 +179,9 @@ class FakeSurfaceProducer : public SurfaceProducer {
   void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) override {}
 
+  // |SurfaceProducer|
+  void OnMemoryPressure() override {}
+
   fuchsia::ui::composition::AllocatorPtr flatland_allocator_;
 };
 
@@ -85,6 +85,8 @@ class FakeSurfaceProducerSurface : public SurfaceProducerSurface {
     return SkISize::Make(surface_->width(), surface_->height());
   }
 
+  SkISize GetViewportSize() const override { return GetSize(); }
+
   void SetImageId(uint32_t image_id) override { FAIL(); }
   uint32_t GetImageId() override { return image_id_; }
 
@@ -143,6 +145,9 @@ class FakeSurfaceProducer : public SurfaceProducer {
   void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) override {}
 
+  // |SurfaceProducer|
+  void OnMemoryPressure() override {}
+
  private:
   scenic::Session* session_;
 
@@ -67,7 +67,7 @@ VsyncWaiter::~VsyncWaiter() {
 }
 
 void VsyncWaiter::AwaitVSync() {
-  await_vsync_callback_(fire_callback_callback_);
+  await_vsync_callback_(fire_callback_callback_, PredictFrameDuration());
 }
 
 void VsyncWaiter::AwaitVSyncForSecondaryCallback() {
@@ -7,6 +7,8 @@
 
 #include <lib/async/cpp/wait.h>
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/time/time_delta.h"
@@ -19,7 +21,10 @@ namespace flutter_runner {
 using FireCallbackCallback =
     std::function<void(fml::TimePoint, fml::TimePoint)>;
 
-using AwaitVsyncCallback = std::function<void(FireCallbackCallback)>;
+// Called with the predicted duration of the next frame, if any.
+using AwaitVsyncCallback =
+    std::function<void(FireCallbackCallback,
+                       std::optional<fml::TimeDelta> predicted_frame_duration)>;
 
 using AwaitVsyncForSecondaryCallbackCallback =
     std::function<void(FireCallbackCallback)>;
@@ -150,7 +150,10 @@ VulkanSurface::VulkanSurface(
     scenic::Session* session,
     const SkISize& size,
     uint32_t buffer_id)
-    : vulkan_provider_(vulkan_provider), session_(session), wait_(this) {
+    : vulkan_provider_(vulkan_provider),
+      session_(session),
+      wait_(this),
+      viewport_size_(size) {
   FML_CHECK(session_ || flatland_allocator.is_bound());
   FML_CHECK(context != nullptr);
 
@@ -203,6 +206,20 @@ SkISize VulkanSurface::GetSize() const {
   return SkISize::Make(sk_surface_->width(), sk_surface_->height());
 }
 
+SkISize VulkanSurface::GetViewportSize() const {
+  if (!valid_) {
+    return SkISize::Make(0, 0);
+  }
+
+  return viewport_size_;
+}
+
+void VulkanSurface::SetViewportSize(const SkISize& viewport_size) {
+  FML_DCHECK(viewport_size.width() <= GetSize().width() &&
+             viewport_size.height() <= GetSize().height());
+  viewport_size_ = viewport_size;
+}
+
 vulkan::VulkanHandle<VkSemaphore> VulkanSurface::SemaphoreFromEvent(
     const zx::event& event) const {
   VkResult result;
@@ -65,6 +65,13 @@ class VulkanSurface final : public SurfaceProducerSurface {
   // |SurfaceProducerSurface|
   SkISize GetSize() const override;
 
+  // |SurfaceProducerSurface|
+  SkISize GetViewportSize() const override;
+
+  // Sets the size of the part of the surface that the next frame renders into.
+  // It must not be larger than |GetSize|.
+  void SetViewportSize(const SkISize& viewport_size);
+
   // Note: It is safe for the caller to collect the surface in the
   // |on_writes_committed| callback.
   void SignalWritesFinished(
@@ -179,6 +186,7 @@ class VulkanSurface final : public SurfaceProducerSurface {
   zx::event release_event_;
   async::WaitMethod<VulkanSurface, &VulkanSurface::OnHandleReady> wait_;
   std::function<void()> pending_on_writes_committed_;
+  SkISize viewport_size_;
   std::array<SkISize, kSizeHistorySize> size_history_;
   int size_history_index_ = 0;
   size_t age_ = 0;
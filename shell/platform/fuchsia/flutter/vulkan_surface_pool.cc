@@ -31,10 +31,21 @@ static zx_koid_t GetCurrentProcessId() {
 
 VulkanSurfacePool::VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                                      sk_sp<GrDirectContext> context,
-                                     scenic::Session* scenic_session)
+                                     scenic::Session* scenic_session,
+                                     inspect::Node inspect_node)
     : vulkan_provider_(vulkan_provider),
       context_(std::move(context)),
-      scenic_session_(scenic_session) {
+      scenic_session_(scenic_session),
+      inspect_node_(std::move(inspect_node)),
+      surfaces_created_(inspect_node_.CreateUint("SurfacesCreated", 0u)),
+      surfaces_reused_(inspect_node_.CreateUint("SurfacesReused", 0u)),
+      surfaces_shrunk_(inspect_node_.CreateUint("SurfacesShrunk", 0u)),
+      memory_pressure_events_(
+          inspect_node_.CreateUint("MemoryPressureEvents", 0u)),
+      cached_surfaces_(inspect_node_.CreateUint("CachedSurfaces", 0u)),
+      cached_surfaces_bytes_(inspect_node_.CreateUint("CachedBytes", 0u)),
+      pending_surfaces_count_(
+          inspect_node_.CreateUint("PendingInCompositor", 0u)) {
   FML_CHECK(context_ != nullptr);
 
   zx_status_t status = fdio_service_connect(
@@ -76,22 +87,33 @@ std::unique_ptr<VulkanSurface> VulkanSurfacePool::GetCachedOrCreateSurface(
     const SkISize& size) {
   TRACE_EVENT2("flutter", "VulkanSurfacePool::GetCachedOrCreateSurface",
                "width", size.width(), "height", size.height());
-  // First try to find a surface that exactly matches |size|.
-  {
-    auto exact_match_it =
+  // First try to find a surface that exactly matches |size|, then one of the
+  // size that would be allocated for |size|.
+  const SkISize allocation_size =
+      scenic_session_ ? size : GetBucketedSize(size);
+  for (const SkISize& match_size : {size, allocation_size}) {
+    auto match_it =
         std::find_if(available_surfaces_.begin(), available_surfaces_.end(),
-                     [&size](const auto& surface) {
-                       return surface->IsValid() && surface->GetSize() == size;
+                     [&match_size](const auto& surface) {
+                       return surface->IsValid() &&
+                              surface->GetSize() == match_size;
                      });
-    if (exact_match_it != available_surfaces_.end()) {
-      auto acquired_surface = std::move(*exact_match_it);
-      available_surfaces_.erase(exact_match_it);
-      TRACE_EVENT_INSTANT0("flutter", "Exact match found");
+    if (match_it != available_surfaces_.end()) {
+      auto acquired_surface = std::move(*match_it);
+      available_surfaces_.erase(match_it);
+      acquired_surface->SetViewportSize(size);
+      if (match_size == size) {
+        TRACE_EVENT_INSTANT0("flutter", "Exact match found");
+      } else {
+        TRACE_EVENT_INSTANT0("flutter", "Bucket match found");
+      }
+      trace_surfaces_reused_++;
+      surfaces_reused_.Add(1);
       return acquired_surface;
     }
   }
 
-  return CreateSurface(size);
+  return CreateSurface(allocation_size, size);
 }
 
 void VulkanSurfacePool::SubmitSurface(
@@ -119,18 +141,34 @@ void VulkanSurfacePool::SubmitSurface(
   }
 }
 
+SkISize VulkanSurfacePool::GetBucketedSize(const SkISize& size) {
+  auto round_up = [](int32_t value) {
+    return (value + kSizeBucketGranularity - 1) / kSizeBucketGranularity *
+           kSizeBucketGranularity;
+  };
+  return SkISize::Make(round_up(size.width()), round_up(size.height()));
+}
+
 std::unique_ptr<VulkanSurface> VulkanSurfacePool::CreateSurface(
     const SkISize& size) {
+  return CreateSurface(size, size);
+}
+
+std::unique_ptr<VulkanSurface> VulkanSurfacePool::CreateSurface(
+    const SkISize& allocation_size,
+    const SkISize& viewport_size) {
   TRACE_EVENT2("flutter", "VulkanSurfacePool::CreateSurface", "width",
-               size.width(), "height", size.height());
+               allocation_size.width(), "height", allocation_size.height());
   auto surface = std::make_unique<VulkanSurface>(
       vulkan_provider_, sysmem_allocator_, flatland_allocator_, context_,
-      scenic_session_, size, buffer_id_++);
+      scenic_session_, allocation_size, buffer_id_++);
   if (!surface->IsValid()) {
     FML_LOG(ERROR) << "VulkanSurfaceProducer: Created surface is invalid";
     return nullptr;
   }
+  surface->SetViewportSize(viewport_size);
   trace_surfaces_created_++;
+  surfaces_created_.Add(1);
   return surface;
 }
 
@@ -195,8 +233,9 @@ void VulkanSurfacePool::AgeAndCollectOldBuffers() {
   if (surface_to_remove_it != available_surfaces_.end()) {
     TRACE_EVENT_INSTANT0("flutter", "replacing surface with smaller one");
     auto size = (*surface_to_remove_it)->GetSize();
+    auto viewport_size = (*surface_to_remove_it)->GetViewportSize();
     available_surfaces_.erase(surface_to_remove_it);
-    auto new_surface = CreateSurface(size);
+    auto new_surface = CreateSurface(size, viewport_size);
     if (new_surface != nullptr) {
       available_surfaces_.push_back(std::move(new_surface));
     } else {
@@ -215,11 +254,13 @@ void VulkanSurfacePool::ShrinkToFit() {
   // reducing our peak memory footprint.
   std::vector<SkISize> sizes_to_recreate;
   for (auto& surface : available_surfaces_) {
-    if (surface->IsOversized()) {
-      sizes_to_recreate.push_back(surface->GetSize());
+    if (surface->IsOversized() ||
+        surface->GetSize() != surface->GetViewportSize()) {
+      sizes_to_recreate.push_back(surface->GetViewportSize());
       surface.reset();
     }
   }
+  surfaces_shrunk_.Add(sizes_to_recreate.size());
   available_surfaces_.erase(std::remove(available_surfaces_.begin(),
                                         available_surfaces_.end(), nullptr),
                             available_surfaces_.end());
@@ -236,6 +277,12 @@ void VulkanSurfacePool::ShrinkToFit() {
   TraceStats();
 }
 
+void VulkanSurfacePool::OnMemoryPressure() {
+  TRACE_EVENT0("flutter", "VulkanSurfacePool::OnMemoryPressure");
+  memory_pressure_events_.Add(1);
+  ShrinkToFit();
+}
+
 void VulkanSurfacePool::TraceStats() {
   // Resources held in cached buffers.
   size_t cached_surfaces_bytes = 0;
@@ -266,6 +313,10 @@ void VulkanSurfacePool::TraceStats() {
                 "SkiaCachePurgeable", skia_cache_purgeable  //
   );
 
+  cached_surfaces_.Set(available_surfaces_.size());
+  cached_surfaces_bytes_.Set(cached_surfaces_bytes);
+  pending_surfaces_count_.Set(pending_surfaces_.size());
+
   // Reset per present/frame stats.
   trace_surfaces_created_ = 0;
   trace_surfaces_reused_ = 0;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <fuchsia/ui/composition/cpp/fidl.h>
+#include <lib/inspect/cpp/inspect.h>
 
 #include <unordered_map>
 #include <vector>
@@ -21,10 +22,14 @@ class VulkanSurfacePool final {
   static constexpr int kMaxSurfaces = 12;
   // If a surface doesn't get used for 3 or more generations, we discard it.
   static constexpr int kMaxSurfaceAge = 3;
+  // Surfaces for Flatland are allocated with their width and height rounded up
+  // to a multiple of this, so that slightly different sizes share surfaces.
+  static constexpr int kSizeBucketGranularity = 64;
 
   VulkanSurfacePool(vulkan::VulkanProvider& vulkan_provider,
                     sk_sp<GrDirectContext> context,
-                    scenic::Session* scenic_session);
+                    scenic::Session* scenic_session,
+                    inspect::Node inspect_node = inspect::Node());
 
   ~VulkanSurfacePool();
 
@@ -36,9 +41,16 @@ class VulkanSurfacePool final {
   void AgeAndCollectOldBuffers();
 
   // Shrink all oversized |VulkanSurfaces| in |available_surfaces_| to as
-  // small as they can be.
+  // small as they can be, which is the size of their viewport.
   void ShrinkToFit();
 
+  // Releases the memory that unused surfaces don't need, because the system is
+  // low on memory.
+  void OnMemoryPressure();
+
+  // Gets the size of the surface to allocate for |size|.
+  static SkISize GetBucketedSize(const SkISize& size);
+
  private:
   vulkan::VulkanProvider& vulkan_provider_;
   sk_sp<GrDirectContext> context_;
@@ -53,8 +65,21 @@ class VulkanSurfacePool final {
   size_t trace_surfaces_created_ = 0;
   size_t trace_surfaces_reused_ = 0;
 
+  inspect::Node inspect_node_;
+  inspect::UintProperty surfaces_created_;
+  inspect::UintProperty surfaces_reused_;
+  inspect::UintProperty surfaces_shrunk_;
+  inspect::UintProperty memory_pressure_events_;
+  inspect::UintProperty cached_surfaces_;
+  inspect::UintProperty cached_surfaces_bytes_;
+  inspect::UintProperty pending_surfaces_count_;
+
   std::unique_ptr<VulkanSurface> GetCachedOrCreateSurface(const SkISize& size);
 
+  // Creates a surface of |allocation_size| to render |viewport_size| into.
+  std::unique_ptr<VulkanSurface> CreateSurface(const SkISize& allocation_size,
+                                               const SkISize& viewport_size);
+
   void RecycleSurface(std::unique_ptr<VulkanSurface> surface);
 
   void RecyclePendingSurface(uintptr_t surface_key);
@@ -39,8 +39,9 @@ constexpr size_t kGrCacheMaxByteSize = 1024 * 600 * 12 * 4;
 
 }  // namespace
 
-VulkanSurfaceProducer::VulkanSurfaceProducer(scenic::Session* scenic_session) {
-  valid_ = Initialize(scenic_session);
+VulkanSurfaceProducer::VulkanSurfaceProducer(scenic::Session* scenic_session,
+                                             inspect::Node inspect_node) {
+  valid_ = Initialize(scenic_session, std::move(inspect_node));
 
   if (!valid_) {
     FML_LOG(FATAL) << "VulkanSurfaceProducer: Initialization failed";
@@ -56,7 +57,8 @@ VulkanSurfaceProducer::~VulkanSurfaceProducer() {
   }
 };
 
-bool VulkanSurfaceProducer::Initialize(scenic::Session* scenic_session) {
+bool VulkanSurfaceProducer::Initialize(scenic::Session* scenic_session,
+                                       inspect::Node inspect_node) {
   vk_ = fml::MakeRefCounted<vulkan::VulkanProcTable>();
 
   std::vector<std::string> extensions = {
@@ -162,8 +164,8 @@ bool VulkanSurfaceProducer::Initialize(scenic::Session* scenic_session) {
   // Use local limits specified in this file above instead of flutter defaults.
   context_->setResourceCacheLimit(kGrCacheMaxByteSize);
 
-  surface_pool_ =
-      std::make_unique<VulkanSurfacePool>(*this, context_, scenic_session);
+  surface_pool_ = std::make_unique<VulkanSurfacePool>(
+      *this, context_, scenic_session, std::move(inspect_node));
 
   return true;
 }
@@ -285,6 +287,11 @@ void VulkanSurfaceProducer::SubmitSurface(
   surface_pool_->SubmitSurface(std::move(surface));
 }
 
+void VulkanSurfaceProducer::OnMemoryPressure() {
+  FML_CHECK(valid_);
+  surface_pool_->OnMemoryPressure();
+}
+
 std::unique_ptr<SurfaceProducerSurface>
 VulkanSurfaceProducer::ProduceOffscreenSurface(const SkISize& size) {
   return surface_pool_->CreateSurface(size);
@@ -6,6 +6,7 @@
 
 #include <lib/async/cpp/time.h>
 #include <lib/async/default.h>
+#include <lib/inspect/cpp/inspect.h>
 #include <lib/syslog/global.h>
 #include <lib/ui/scenic/cpp/resources.h>
 #include <lib/ui/scenic/cpp/session.h>
@@ -28,7 +29,9 @@ namespace flutter_runner {
 class VulkanSurfaceProducer final : public SurfaceProducer,
                                     public vulkan::VulkanProvider {
  public:
-  explicit VulkanSurfaceProducer(scenic::Session* scenic_session);
+  // The statistics of the surface pool are published to |inspect_node|.
+  explicit VulkanSurfaceProducer(scenic::Session* scenic_session,
+                                 inspect::Node inspect_node = inspect::Node());
   ~VulkanSurfaceProducer() override;
 
   bool IsValid() const { return valid_; }
@@ -48,6 +51,9 @@ class VulkanSurfaceProducer final : public SurfaceProducer,
   void SubmitSurfaces(
       std::vector<std::unique_ptr<SurfaceProducerSurface>> surfaces) override;
 
+  // |SurfaceProducer|
+  void OnMemoryPressure() override;
+
  private:
   // VulkanProvider
   const vulkan::VulkanProcTable& vk() override { return *vk_.get(); }
@@ -55,7 +61,7 @@ class VulkanSurfaceProducer final : public SurfaceProducer,
     return logical_device_->GetHandle();
   }
 
-  bool Initialize(scenic::Session* scenic_session);
+  bool Initialize(scenic::Session* scenic_session, inspect::Node inspect_node);
 
   void SubmitSurface(std::unique_ptr<SurfaceProducerSurface> surface);
   bool TransitionSurfacesToExternal(
@@ -7,11 +7,14 @@
 #include <GLFW/glfw3.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/plugin_registrar.h"
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
@@ -42,6 +45,9 @@ const int kFlutterDesktopDontCare = GLFW_DONT_CARE;
 
 static constexpr double kDpPerInch = 160.0;
 
+// The refresh period to assume if the refresh rate of the monitor is unknown.
+static constexpr uint64_t kDefaultVsyncPeriodNanos = 1000000000 / 60;
+
 // Struct for storing state within an instance of the GLFW Window.
 struct FlutterDesktopWindowControllerState {
   // The GLFW window that is bound to this state object.
@@ -74,6 +80,28 @@ struct FlutterDesktopWindowControllerState {
   // The screen coordinates per inch on the primary monitor. Defaults to a sane
   // value based on pixel_ratio 1.0.
   double monitor_screen_coordinates_per_inch = kDpPerInch;
+
+  // Pointer events received from GLFW that haven't been sent to the engine
+  // yet. They are sent together once GLFW has processed its pending events.
+  std::vector<FlutterPointerEvent> pending_pointer_events;
+
+  // The refresh period of the monitor that the window is on.
+  uint64_t vsync_period_nanos = kDefaultVsyncPeriodNanos;
+
+  // The engine time of the last buffer swap, or 0 before the first one. With
+  // a swap interval of 1 the swap returns at a vsync, so this gives the phase
+  // of the vsync signal.
+  std::atomic<uint64_t> last_swap_time_nanos{0};
+
+  // Whether the swap interval of the window's context has been set. Only used
+  // on the raster thread.
+  bool swap_interval_set = false;
+
+  // The batons of the engine's vsync requests that haven't been returned
+  // yet. Requests are made on an engine thread, but the batons must be
+  // returned on the platform thread.
+  std::mutex vsync_mutex;
+  std::vector<intptr_t> pending_vsync_batons;
 };
 
 // Opaque reference for the GLFW window itself. This is separate from the
@@ -389,7 +417,7 @@ static void SendPointerEventWithData(GLFWwindow* window,
   event.scroll_delta_x *= pixels_per_coordinate;
   event.scroll_delta_y *= pixels_per_coordinate;
 
-  FlutterEngineSendPointerEvent(controller->engine->flutter_engine, &event, 1);
+  controller->pending_pointer_events.push_back(event);
 
   if (event_data.phase == FlutterPointerPhase::kAdd) {
     controller->pointer_currently_added = true;
@@ -402,6 +430,99 @@ static void SendPointerEventWithData(GLFWwindow* window,
   }
 }
 
+// Sends the pointer events that GLFW delivered since the last call to the
+// engine, in a single call.
+static void SendPendingPointerEvents(
+    FlutterDesktopWindowControllerState* controller) {
+  if (controller->pending_pointer_events.empty()) {
+    return;
+  }
+  FlutterEngineSendPointerEvent(controller->engine->flutter_engine,
+                                controller->pending_pointer_events.data(),
+                                controller->pending_pointer_events.size());
+  controller->pending_pointer_events.clear();
+}
+
+// Updates the vsync period of |controller| from the refresh rate of the
+// monitor that contains the center of its window.
+static void UpdateVsyncPeriod(FlutterDesktopWindowControllerState* controller) {
+  GLFWwindow* window = controller->window.get();
+  GLFWmonitor* window_monitor = glfwGetWindowMonitor(window);
+  if (!window_monitor) {
+    int x, y, width, height;
+    glfwGetWindowPos(window, &x, &y);
+    glfwGetWindowSize(window, &width, &height);
+    int center_x = x + width / 2;
+    int center_y = y + height / 2;
+    int monitor_count = 0;
+    GLFWmonitor** monitors = glfwGetMonitors(&monitor_count);
+    for (int i = 0; i < monitor_count && !window_monitor; i++) {
+      const GLFWvidmode* mode = glfwGetVideoMode(monitors[i]);
+      int monitor_x, monitor_y;
+      glfwGetMonitorPos(monitors[i], &monitor_x, &monitor_y);
+      if (mode && center_x >= monitor_x && center_x < monitor_x + mode->width &&
+          center_y >= monitor_y && center_y < monitor_y + mode->height) {
+        window_monitor = monitors[i];
+      }
+    }
+  }
+  if (!window_monitor) {
+    window_monitor = glfwGetPrimaryMonitor();
+  }
+  const GLFWvidmode* mode =
+      window_monitor ? glfwGetVideoMode(window_monitor) : nullptr;
+  controller->vsync_period_nanos = (mode && mode->refreshRate > 0)
+                                       ? 1000000000 / mode->refreshRate
+                                       : kDefaultVsyncPeriodNanos;
+}
+
+// Returns the batons of the engine's pending vsync requests, with the time
+// of the next vsync after now as the frame start.
+//
+// The vsync times are extrapolated from the time of the last buffer swap and
+// the refresh period of the monitor.
+static void ReturnPendingVsyncBatons(
+    FlutterDesktopWindowControllerState* controller) {
+  std::vector<intptr_t> batons;
+  {
+    std::lock_guard<std::mutex> lock(controller->vsync_mutex);
+    batons.swap(controller->pending_vsync_batons);
+  }
+  if (batons.empty()) {
+    return;
+  }
+  const uint64_t period = controller->vsync_period_nanos;
+  const uint64_t last_swap = controller->last_swap_time_nanos;
+  const uint64_t now = FlutterEngineGetCurrentTime();
+  uint64_t frame_start = now;
+  if (last_swap != 0 && last_swap <= now) {
+    frame_start = last_swap + ((now - last_swap) / period + 1) * period;
+  }
+  for (intptr_t baton : batons) {
+    FlutterEngineOnVsync(controller->engine->flutter_engine, baton,
+                         frame_start, frame_start + period);
+  }
+}
+
+// Called by the engine, on an engine thread, when it waits for a vsync.
+static void EngineOnVsync(void* user_data, intptr_t baton) {
+  FlutterDesktopEngineState* engine_state =
+      static_cast<FlutterDesktopEngineState*>(user_data);
+  FlutterDesktopWindowControllerState* window_controller =
+      engine_state->window_controller;
+  {
+    std::lock_guard<std::mutex> lock(window_controller->vsync_mutex);
+    window_controller->pending_vsync_batons.push_back(baton);
+  }
+  // Wake the event loop so that it returns the baton.
+  glfwPostEmptyEvent();
+}
+
+// Called when the window is moved, possibly onto a different monitor.
+static void GLFWWindowPosCallback(GLFWwindow* window, int x, int y) {
+  UpdateVsyncPeriod(GetWindowController(window));
+}
+
 // Updates |event_data| with the current location of the mouse cursor.
 static void SetEventLocationFromCursorPosition(
     GLFWwindow* window,
@@ -593,6 +714,11 @@ static bool EngineMakeContextCurrent(void* user_data) {
     return false;
   }
   glfwMakeContextCurrent(window_controller->window.get());
+  if (!window_controller->swap_interval_set) {
+    // Sync buffer swaps to the vsync, which |EngineOnVsync| relies on.
+    glfwSwapInterval(1);
+    window_controller->swap_interval_set = true;
+  }
   return true;
 }
 
@@ -629,6 +755,7 @@ static bool EnginePresent(void* user_data) {
     return false;
   }
   glfwSwapBuffers(window_controller->window.get());
+  window_controller->last_swap_time_nanos = FlutterEngineGetCurrentTime();
   return true;
 }
 
@@ -763,6 +890,10 @@ static bool RunFlutterEngine(
   args.command_line_argv = &argv[0];
   args.platform_message_callback = EngineOnFlutterPlatformMessage;
   args.custom_task_runners = &task_runners;
+  // Headless engines have no display to sync frames to.
+  if (engine_state->window_controller != nullptr) {
+    args.vsync_callback = EngineOnVsync;
+  }
 
   if (FlutterEngineRunsAOTCompiledDartCode()) {
     engine_state->aot_data = LoadAotData(aot_library_path);
@@ -773,15 +904,25 @@ static bool RunFlutterEngine(
     args.aot_data = engine_state->aot_data.get();
   }
 
+  // Initialize the engine before running it, so that the engine handle is
+  // set by the time the engine makes its first vsync request.
   FLUTTER_API_SYMBOL(FlutterEngine) engine = nullptr;
-  auto result = FlutterEngineRun(FLUTTER_ENGINE_VERSION, &config, &args,
-                                 engine_state, &engine);
+  auto result = FlutterEngineInitialize(FLUTTER_ENGINE_VERSION, &config, &args,
+                                        engine_state, &engine);
   if (result != kSuccess || engine == nullptr) {
     std::cerr << "Failed to start Flutter engine: error " << result
               << std::endl;
     return false;
   }
   engine_state->flutter_engine = engine;
+  result = FlutterEngineRunInitialized(engine);
+  if (result != kSuccess) {
+    std::cerr << "Failed to start Flutter engine: error " << result
+              << std::endl;
+    FlutterEngineDeinitialize(engine);
+    engine_state->flutter_engine = nullptr;
+    return false;
+  }
   return true;
 }
 
@@ -874,6 +1015,7 @@ FlutterDesktopWindowControllerRef FlutterDesktopCreateWindow(
 
   state->engine = std::make_unique<FlutterDesktopEngineState>();
   state->engine->window_controller = state.get();
+  UpdateVsyncPeriod(state.get());
 
   // Create an event loop for the window. It is not running yet.
   auto event_loop = std::make_unique<flutter::GLFWEventLoop>(
@@ -912,12 +1054,15 @@ FlutterDesktopWindowControllerRef FlutterDesktopCreateWindow(
   // Set up GLFW callbacks for the window.
   glfwSetFramebufferSizeCallback(window, GLFWFramebufferSizeCallback);
   glfwSetWindowRefreshCallback(window, GLFWWindowRefreshCallback);
+  glfwSetWindowPosCallback(window, GLFWWindowPosCallback);
   GLFWAssignEventCallbacks(window);
 
   return state.release();
 }
 
 void FlutterDesktopDestroyWindow(FlutterDesktopWindowControllerRef controller) {
+  // All vsync batons must be returned before the engine is shut down.
+  ReturnPendingVsyncBatons(controller);
   controller->engine->messenger->SetEngine(nullptr);
   FlutterDesktopPluginRegistrarRef registrar =
       controller->engine->plugin_registrar.get();
@@ -1074,6 +1219,12 @@ void FlutterDesktopRunEngineEventLoopWithTimeout(
           ? std::chrono::nanoseconds::max()
           : std::chrono::milliseconds(timeout_milliseconds);
   engine->event_loop->WaitForEvents(wait_duration);
+  FlutterDesktopWindowControllerState* window_controller =
+      engine->window_controller;
+  if (window_controller) {
+    SendPendingPointerEvents(window_controller);
+    ReturnPendingVsyncBatons(window_controller);
+  }
 }
 
 bool FlutterDesktopShutDownEngine(FlutterDesktopEngineRef engine) {
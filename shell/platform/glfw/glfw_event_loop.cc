@@ -24,7 +24,11 @@ void GLFWEventLoop::WaitUntil(const TaskTimePoint& time) {
   using Seconds = std::chrono::duration<double, std::ratio<1>>;
   const auto duration_to_wait = std::chrono::duration_cast<Seconds>(time - now);
 
-  if (duration_to_wait.count() > 0.0) {
+  if (time == TaskTimePoint::max()) {
+    // There are no pending engine tasks, so only wake for GLFW events or a
+    // Wake() call.
+    ::glfwWaitEvents();
+  } else if (duration_to_wait.count() > 0.0) {
     ::glfwWaitEventsTimeout(duration_to_wait.count());
   } else {
     // Avoid engine task priority inversion by making sure GLFW events are
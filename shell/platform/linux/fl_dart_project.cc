@@ -16,6 +16,7 @@ struct _FlDartProject {
   GObject parent_instance;
 
   gboolean enable_mirrors;
+  gboolean raw_key_events_enabled;
   gchar* aot_library_path;
   gchar* assets_path;
   gchar* icu_data_path;
@@ -52,7 +53,9 @@ static void fl_dart_project_class_init(FlDartProjectClass* klass) {
   G_OBJECT_CLASS(klass)->dispose = fl_dart_project_dispose;
 }
 
-static void fl_dart_project_init(FlDartProject* self) {}
+static void fl_dart_project_init(FlDartProject* self) {
+  self->raw_key_events_enabled = TRUE;
+}
 
 G_MODULE_EXPORT FlDartProject* fl_dart_project_new() {
   FlDartProject* self =
@@ -128,6 +131,19 @@ G_MODULE_EXPORT void fl_dart_project_set_dart_entrypoint_arguments(
   self->dart_entrypoint_args = g_strdupv(argv);
 }
 
+G_MODULE_EXPORT void fl_dart_project_set_raw_key_events_enabled(
+    FlDartProject* self,
+    gboolean enabled) {
+  g_return_if_fail(FL_IS_DART_PROJECT(self));
+  self->raw_key_events_enabled = enabled;
+}
+
+G_MODULE_EXPORT gboolean
+fl_dart_project_get_raw_key_events_enabled(FlDartProject* self) {
+  g_return_val_if_fail(FL_IS_DART_PROJECT(self), TRUE);
+  return self->raw_key_events_enabled;
+}
+
 GPtrArray* fl_dart_project_get_switches(FlDartProject* self) {
   GPtrArray* switches = g_ptr_array_new_with_free_func(g_free);
   std::vector<std::string> env_switches = flutter::GetSwitchesFromEnvironment();
@@ -38,6 +38,13 @@ TEST(FlDartProjectTest, EnableMirrors) {
   G_GNUC_END_IGNORE_DEPRECATIONS
 }
 
+TEST(FlDartProjectTest, RawKeyEventsEnabled) {
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  EXPECT_TRUE(fl_dart_project_get_raw_key_events_enabled(project));
+  fl_dart_project_set_raw_key_events_enabled(project, FALSE);
+  EXPECT_FALSE(fl_dart_project_get_raw_key_events_enabled(project));
+}
+
 TEST(FlDartProjectTest, OverrideAssetsPath) {
   g_autoptr(FlDartProject) project = fl_dart_project_new();
 
@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gmodule.h>
+
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_renderer.h"
+
+// DRM_FORMAT_MOD_INVALID, defined here to not depend on the DRM headers.
+static constexpr uint64_t kDrmFormatModInvalid = 0x00ffffffffffffffull;
+
+typedef struct {
+  GLuint texture_id;
+} FlDmabufTexturePrivate;
+
+// Added here to stop the compiler from optimising this function away.
+G_MODULE_EXPORT GType fl_dmabuf_texture_get_type();
+
+static void fl_dmabuf_texture_iface_init(FlTextureInterface* iface) {}
+
+G_DEFINE_TYPE_WITH_CODE(FlDmabufTexture,
+                        fl_dmabuf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dmabuf_texture_iface_init);
+                        G_ADD_PRIVATE(FlDmabufTexture))
+
+static void fl_dmabuf_texture_dispose(GObject* object) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(object);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  if (priv->texture_id) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+
+  G_OBJECT_CLASS(fl_dmabuf_texture_parent_class)->dispose(object);
+}
+
+// Imports the planes of a dmabuf as an EGLImage.
+static EGLImageKHR create_image(EGLDisplay display,
+                                uint32_t fourcc,
+                                uint64_t modifier,
+                                const FlDmabufPlane* planes,
+                                uint32_t n_planes,
+                                uint32_t width,
+                                uint32_t height,
+                                GError** error) {
+  static const EGLint kPlaneAttributes[FL_DMABUF_TEXTURE_MAX_PLANES][5] = {
+      {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+  };
+
+  if (n_planes == 0 || n_planes > FL_DMABUF_TEXTURE_MAX_PLANES) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Invalid number of dmabuf planes: %u", n_planes);
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  if (!epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "EGL can't import dmabufs");
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  const bool has_modifier = modifier != kDrmFormatModInvalid;
+  if (has_modifier &&
+      !epoxy_has_egl_extension(display,
+                               "EGL_EXT_image_dma_buf_import_modifiers")) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "EGL can't import dmabufs with format modifiers");
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  // 7 attributes for the image and at most 10 for each plane, plus EGL_NONE.
+  EGLint attributes[7 + FL_DMABUF_TEXTURE_MAX_PLANES * 10 + 1];
+  size_t n = 0;
+  attributes[n++] = EGL_WIDTH;
+  attributes[n++] = static_cast<EGLint>(width);
+  attributes[n++] = EGL_HEIGHT;
+  attributes[n++] = static_cast<EGLint>(height);
+  attributes[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attributes[n++] = static_cast<EGLint>(fourcc);
+  for (uint32_t i = 0; i < n_planes; i++) {
+    attributes[n++] = kPlaneAttributes[i][0];
+    attributes[n++] = planes[i].fd;
+    attributes[n++] = kPlaneAttributes[i][1];
+    attributes[n++] = static_cast<EGLint>(planes[i].offset);
+    attributes[n++] = kPlaneAttributes[i][2];
+    attributes[n++] = static_cast<EGLint>(planes[i].stride);
+    if (has_modifier) {
+      attributes[n++] = kPlaneAttributes[i][3];
+      attributes[n++] = static_cast<EGLint>(modifier & 0xffffffff);
+      attributes[n++] = kPlaneAttributes[i][4];
+      attributes[n++] = static_cast<EGLint>(modifier >> 32);
+    }
+  }
+  attributes[n++] = EGL_NONE;
+
+  EGLImageKHR image =
+      eglCreateImageKHR(display, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT,
+                        nullptr, attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to import dmabuf: EGL error %x", eglGetError());
+  }
+  return image;
+}
+
+gboolean fl_dmabuf_texture_populate(FlDmabufTexture* texture,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    FlutterOpenGLTexture* opengl_texture,
+                                    GError** error) {
+  FlDmabufTexture* self = FL_DMABUF_TEXTURE(texture);
+  FlDmabufTexturePrivate* priv = reinterpret_cast<FlDmabufTexturePrivate*>(
+      fl_dmabuf_texture_get_instance_private(self));
+
+  uint32_t fourcc = 0;
+  uint64_t modifier = kDrmFormatModInvalid;
+  FlDmabufPlane planes[FL_DMABUF_TEXTURE_MAX_PLANES] = {};
+  uint32_t n_planes = 0;
+  if (!FL_DMABUF_TEXTURE_GET_CLASS(self)->get_dmabuf(
+          self, &fourcc, &modifier, planes, &n_planes, &width, &height,
+          error)) {
+    return FALSE;
+  }
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  EGLImageKHR image = create_image(display, fourcc, modifier, planes,
+                                   n_planes, width, height, error);
+  if (image == EGL_NO_IMAGE_KHR) {
+    return FALSE;
+  }
+
+  if (priv->texture_id == 0) {
+    glGenTextures(1, &priv->texture_id);
+    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  } else {
+    glBindTexture(GL_TEXTURE_2D, priv->texture_id);
+  }
+  // The texture aliases the memory of the dmabuf, nothing is copied. It keeps
+  // that memory alive on its own, so the image isn't needed afterwards.
+  glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
+  GLenum gl_error = glGetError();
+  eglDestroyImageKHR(display, image);
+  if (gl_error != GL_NO_ERROR) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to bind dmabuf to texture: GL error %x", gl_error);
+    return FALSE;
+  }
+
+  opengl_texture->target = GL_TEXTURE_2D;
+  opengl_texture->name = priv->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = width;
+  opengl_texture->height = height;
+
+  return TRUE;
+}
+
+static void fl_dmabuf_texture_class_init(FlDmabufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_dmabuf_texture_dispose;
+}
+
+static void fl_dmabuf_texture_init(FlDmabufTexture* self) {}
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dmabuf_texture.h"
+#include "flutter/shell/platform/linux/fl_dmabuf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+
+static constexpr uint32_t kBufferWidth = 4u;
+static constexpr uint32_t kBufferHeight = 4u;
+static constexpr uint32_t kRealBufferWidth = 2u;
+static constexpr uint32_t kRealBufferHeight = 2u;
+// DRM_FORMAT_ABGR8888
+static constexpr uint32_t kFourcc = 0x34324241;
+
+G_DECLARE_FINAL_TYPE(FlTestDmabufTexture,
+                     fl_test_dmabuf_texture,
+                     FL,
+                     TEST_DMABUF_TEXTURE,
+                     FlDmabufTexture)
+
+/// A simple texture with a fixed dmabuf.
+struct _FlTestDmabufTexture {
+  FlDmabufTexture parent_instance;
+
+  uint32_t n_planes;
+};
+
+G_DEFINE_TYPE(FlTestDmabufTexture,
+              fl_test_dmabuf_texture,
+              fl_dmabuf_texture_get_type())
+
+static gboolean fl_test_dmabuf_texture_get_dmabuf(FlDmabufTexture* texture,
+                                                  uint32_t* fourcc,
+                                                  uint64_t* modifier,
+                                                  FlDmabufPlane* planes,
+                                                  uint32_t* n_planes,
+                                                  uint32_t* width,
+                                                  uint32_t* height,
+                                                  GError** error) {
+  EXPECT_TRUE(FL_IS_TEST_DMABUF_TEXTURE(texture));
+  FlTestDmabufTexture* self = FL_TEST_DMABUF_TEXTURE(texture);
+
+  EXPECT_EQ(*width, kBufferWidth);
+  EXPECT_EQ(*height, kBufferHeight);
+  *fourcc = kFourcc;
+  planes[0].fd = 1;
+  planes[0].offset = 0;
+  planes[0].stride = kRealBufferWidth * 4;
+  *n_planes = self->n_planes;
+  *width = kRealBufferWidth;
+  *height = kRealBufferHeight;
+
+  return TRUE;
+}
+
+static void fl_test_dmabuf_texture_class_init(
+    FlTestDmabufTextureClass* klass) {
+  FL_DMABUF_TEXTURE_CLASS(klass)->get_dmabuf =
+      fl_test_dmabuf_texture_get_dmabuf;
+}
+
+static void fl_test_dmabuf_texture_init(FlTestDmabufTexture* self) {
+  self->n_planes = 1;
+}
+
+static FlTestDmabufTexture* fl_test_dmabuf_texture_new() {
+  return FL_TEST_DMABUF_TEXTURE(
+      g_object_new(fl_test_dmabuf_texture_get_type(), nullptr));
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmabufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_dmabuf_texture_new());
+  EXPECT_EQ(fl_texture_get_texture_id(texture),
+            reinterpret_cast<int64_t>(texture));
+}
+
+// Test that importing a dmabuf into an OpenGL texture works.
+TEST(FlDmabufTextureTest, PopulateTexture) {
+  eglInitialize(eglGetDisplay(EGL_DEFAULT_DISPLAY), nullptr, nullptr);
+
+  g_autoptr(FlDmabufTexture) texture =
+      FL_DMABUF_TEXTURE(fl_test_dmabuf_texture_new());
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dmabuf_texture_populate(
+      texture, kBufferWidth, kBufferHeight, &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.target, static_cast<uint32_t>(GL_TEXTURE_2D));
+  EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+}
+
+// Test that dmabufs with an invalid number of planes are rejected.
+TEST(FlDmabufTextureTest, PopulateTextureWithoutPlanes) {
+  eglInitialize(eglGetDisplay(EGL_DEFAULT_DISPLAY), nullptr, nullptr);
+
+  g_autoptr(FlTestDmabufTexture) test_texture = fl_test_dmabuf_texture_new();
+  test_texture->n_planes = 0;
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dmabuf_texture_populate(FL_DMABUF_TEXTURE(test_texture),
+                                          kBufferWidth, kBufferHeight,
+                                          &opengl_texture, &error));
+  EXPECT_NE(error, nullptr);
+}
@@ -533,7 +533,8 @@ static void guarantee_layout(FlKeyboardManager* self, FlKeyEvent* event) {
 }
 
 FlKeyboardManager* fl_keyboard_manager_new(
-    FlKeyboardViewDelegate* view_delegate) {
+    FlKeyboardViewDelegate* view_delegate,
+    gboolean raw_key_events_enabled) {
   g_return_val_if_fail(FL_IS_KEYBOARD_VIEW_DELEGATE(view_delegate), nullptr);
 
   FlKeyboardManager* self = FL_KEYBOARD_MANAGER(
@@ -554,9 +555,12 @@ FlKeyboardManager* fl_keyboard_manager_new(
             fl_keyboard_view_delegate_send_key_event(self->view_delegate, event,
                                                      callback, user_data);
           })));
-  g_ptr_array_add(self->responder_list,
-                  FL_KEY_RESPONDER(fl_key_channel_responder_new(
-                      fl_keyboard_view_delegate_get_messenger(view_delegate))));
+  if (raw_key_events_enabled) {
+    FlBinaryMessenger* messenger =
+        fl_keyboard_view_delegate_get_messenger(view_delegate);
+    g_ptr_array_add(self->responder_list,
+                    FL_KEY_RESPONDER(fl_key_channel_responder_new(messenger)));
+  }
 
   fl_keyboard_view_delegate_subscribe_to_layout_change(
       self->view_delegate, [self]() { self->derived_layout->clear(); });
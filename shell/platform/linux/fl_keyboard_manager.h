@@ -28,7 +28,8 @@ G_DECLARE_FINAL_TYPE(FlKeyboardManager,
  *
  * - Keyboard: Dispatch to the embedder responder and the channel responder
  *   simultaneously. After both responders have responded (asynchronously), the
- *   event is considered handled if either responder handles it.
+ *   event is considered handled if either responder handles it. The channel
+ *   responder is left out if RawKeyEvents are disabled.
  * - Text input: Events are sent to IM filter (usually owned by
  *   `TextInputPlugin`) and are handled synchronously.
  * - Redispatching: Events are inserted back to the system for redispatching.
@@ -38,13 +39,16 @@ G_DECLARE_FINAL_TYPE(FlKeyboardManager,
  * fl_keyboard_manager_new:
  * @view_delegate: An interface that the manager requires to communicate with
  * the platform. Usually implemented by FlView.
+ * @raw_key_events_enabled: %TRUE if events are also sent as RawKeyEvents on
+ * the "flutter/keyevent" channel.
  *
  * Create a new #FlKeyboardManager.
  *
  * Returns: a new #FlKeyboardManager.
  */
 FlKeyboardManager* fl_keyboard_manager_new(
-    FlKeyboardViewDelegate* view_delegate);
+    FlKeyboardViewDelegate* view_delegate,
+    gboolean raw_key_events_enabled);
 
 /**
  * fl_keyboard_manager_handle_event:
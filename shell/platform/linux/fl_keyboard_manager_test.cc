@@ -405,14 +405,15 @@ static FlKeyEvent* fl_key_event_new_by_mock(bool is_press,
 
 class KeyboardTester {
  public:
-  KeyboardTester() {
+  explicit KeyboardTester(bool raw_key_events_enabled = true) {
     view_ = fl_mock_view_delegate_new();
     respondToEmbedderCallsWith(false);
     respondToChannelCallsWith(false);
     respondToTextInputWith(false);
     setLayout(kLayoutUs);
 
-    manager_ = fl_keyboard_manager_new(FL_KEYBOARD_VIEW_DELEGATE(view_));
+    manager_ = fl_keyboard_manager_new(FL_KEYBOARD_VIEW_DELEGATE(view_),
+                                       raw_key_events_enabled);
   }
 
   ~KeyboardTester() {
@@ -754,6 +755,36 @@ TEST(FlKeyboardManagerTest, WithTwoAsyncDelegates) {
   EXPECT_TRUE(fl_keyboard_manager_is_state_clear(tester.manager()));
 }
 
+TEST(FlKeyboardManagerTest, WithoutRawKeyEvents) {
+  KeyboardTester tester(false);
+  std::vector<CallRecord> call_records;
+  std::vector<std::unique_ptr<FlKeyEvent>> redispatched;
+
+  tester.recordEmbedderCallsTo(call_records);
+  tester.recordChannelCallsTo(call_records);
+  tester.recordRedispatchedEventsTo(redispatched);
+
+  gboolean manager_handled = fl_keyboard_manager_handle_event(
+      tester.manager(),
+      fl_key_event_new_by_mock(true, GDK_KEY_a, kKeyCodeKeyA, 0x0, false));
+  tester.flushChannelMessages();
+
+  // The event is only sent to the embedder responder, and is redispatched as
+  // soon as that responds.
+  EXPECT_EQ(manager_handled, true);
+  EXPECT_EQ(call_records.size(), 1u);
+  EXPECT_EQ(call_records[0].type, CallRecord::kKeyCallEmbedder);
+
+  call_records[0].callback(false);
+  tester.flushChannelMessages();
+  EXPECT_EQ(redispatched.size(), 1u);
+  call_records.clear();
+
+  EXPECT_EQ(tester.redispatchEventsAndClear(redispatched), 1);
+  EXPECT_EQ(call_records.size(), 0u);
+  EXPECT_TRUE(fl_keyboard_manager_is_state_clear(tester.manager()));
+}
+
 TEST(FlKeyboardManagerTest, TextInputPluginReturnsFalse) {
   KeyboardTester tester;
   std::vector<std::unique_ptr<FlKeyEvent>> redispatched;
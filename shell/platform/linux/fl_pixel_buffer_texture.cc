@@ -7,10 +7,27 @@
 #include <epoxy/gl.h>
 #include <gmodule.h>
 
+#include <algorithm>
+
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 
 typedef struct {
   GLuint texture_id;
+
+  // Size of the storage of the texture. It is only allocated again when the
+  // size of the pixel buffer changes.
+  uint32_t width;
+  uint32_t height;
+
+  // Buffer the pixels are streamed through, if supported.
+  GLuint pixel_buffer_id;
+
+  // Region to upload on the next populate, if any was marked.
+  gboolean has_dirty_rect;
+  uint32_t dirty_left;
+  uint32_t dirty_top;
+  uint32_t dirty_right;
+  uint32_t dirty_bottom;
 } FlPixelBufferTexturePrivate;
 
 // Added here to stop the compiler from optimising this function away.
@@ -36,10 +53,40 @@ static void fl_pixel_buffer_texture_dispose(GObject* object) {
     glDeleteTextures(1, &priv->texture_id);
     priv->texture_id = 0;
   }
+  if (priv->pixel_buffer_id) {
+    glDeleteBuffers(1, &priv->pixel_buffer_id);
+    priv->pixel_buffer_id = 0;
+  }
 
   G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->dispose(object);
 }
 
+// Returns true if textures can have immutable storage.
+static bool has_texture_storage() {
+  if (epoxy_is_desktop_gl()) {
+    return epoxy_gl_version() >= 42 ||
+           epoxy_has_gl_extension("GL_ARB_texture_storage");
+  }
+  return epoxy_gl_version() >= 30;
+}
+
+// Returns true if pixels can be uploaded through pixel buffer objects.
+static bool has_pixel_buffers() {
+  if (epoxy_is_desktop_gl()) {
+    return epoxy_gl_version() >= 21;
+  }
+  return epoxy_gl_version() >= 30;
+}
+
+// Returns true if columns of the pixels can be uploaded.
+static bool has_unpack_row_length() {
+  if (epoxy_is_desktop_gl()) {
+    return true;
+  }
+  return epoxy_gl_version() >= 30 ||
+         epoxy_has_gl_extension("GL_EXT_unpack_subimage");
+}
+
 static void check_gl_error(int line) {
   GLenum err = glGetError();
   if (err) {
@@ -63,7 +110,14 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     return FALSE;
   }
 
-  if (priv->texture_id == 0) {
+  // Immutable storage can't be resized, so the texture is created again.
+  const bool allocate = priv->texture_id == 0 || priv->width != width ||
+                        priv->height != height;
+  if (allocate) {
+    if (priv->texture_id != 0) {
+      glDeleteTextures(1, &priv->texture_id);
+      check_gl_error(__LINE__);
+    }
     glGenTextures(1, &priv->texture_id);
     check_gl_error(__LINE__);
     glBindTexture(GL_TEXTURE_2D, priv->texture_id);
@@ -76,13 +130,77 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     check_gl_error(__LINE__);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     check_gl_error(__LINE__);
+    if (has_texture_storage()) {
+      glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    } else {
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                   GL_UNSIGNED_BYTE, nullptr);
+    }
+    check_gl_error(__LINE__);
+    priv->width = width;
+    priv->height = height;
   } else {
     glBindTexture(GL_TEXTURE_2D, priv->texture_id);
     check_gl_error(__LINE__);
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, buffer);
-  check_gl_error(__LINE__);
+
+  // The region of the buffer to upload.
+  uint32_t left = 0, top = 0, right = width, bottom = height;
+  if (!allocate && priv->has_dirty_rect) {
+    left = std::min(priv->dirty_left, width);
+    top = std::min(priv->dirty_top, height);
+    right = std::min(priv->dirty_right, width);
+    bottom = std::min(priv->dirty_bottom, height);
+  }
+  priv->has_dirty_rect = FALSE;
+
+  const bool unpack_row_length = has_unpack_row_length();
+  if (!unpack_row_length) {
+    // Only whole rows can be uploaded.
+    left = 0;
+    right = width;
+  }
+
+  if (right > left && bottom > top) {
+    const uint32_t region_width = right - left;
+    const uint32_t region_height = bottom - top;
+    const uint8_t* region = buffer + (top * width + left) * 4;
+    const size_t region_size =
+        ((region_height - 1) * width + region_width) * 4;
+
+    if (unpack_row_length) {
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+      check_gl_error(__LINE__);
+    }
+    if (has_pixel_buffers()) {
+      if (priv->pixel_buffer_id == 0) {
+        glGenBuffers(1, &priv->pixel_buffer_id);
+        check_gl_error(__LINE__);
+      }
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, priv->pixel_buffer_id);
+      check_gl_error(__LINE__);
+      // Orphan the storage of the previous frame, so the copy doesn't wait
+      // for the GPU to finish reading it.
+      glBufferData(GL_PIXEL_UNPACK_BUFFER, region_size, nullptr,
+                   GL_STREAM_DRAW);
+      check_gl_error(__LINE__);
+      glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, region_size, region);
+      check_gl_error(__LINE__);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, left, top, region_width,
+                      region_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+      check_gl_error(__LINE__);
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+      check_gl_error(__LINE__);
+    } else {
+      glTexSubImage2D(GL_TEXTURE_2D, 0, left, top, region_width,
+                      region_height, GL_RGBA, GL_UNSIGNED_BYTE, region);
+      check_gl_error(__LINE__);
+    }
+    if (unpack_row_length) {
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+      check_gl_error(__LINE__);
+    }
+  }
 
   opengl_texture->target = GL_TEXTURE_2D;
   opengl_texture->name = priv->texture_id;
@@ -95,6 +213,34 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
   return TRUE;
 }
 
+void fl_pixel_buffer_texture_set_dirty_rect(FlPixelBufferTexture* texture,
+                                            uint32_t x,
+                                            uint32_t y,
+                                            uint32_t width,
+                                            uint32_t height) {
+  g_return_if_fail(FL_IS_PIXEL_BUFFER_TEXTURE(texture));
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(texture));
+
+  if (width == 0 || height == 0) {
+    return;
+  }
+
+  if (!priv->has_dirty_rect) {
+    priv->has_dirty_rect = TRUE;
+    priv->dirty_left = x;
+    priv->dirty_top = y;
+    priv->dirty_right = x + width;
+    priv->dirty_bottom = y + height;
+    return;
+  }
+  priv->dirty_left = std::min(priv->dirty_left, x);
+  priv->dirty_top = std::min(priv->dirty_top, y);
+  priv->dirty_right = std::max(priv->dirty_right, x + width);
+  priv->dirty_bottom = std::max(priv->dirty_bottom, y + height);
+}
+
 static void fl_pixel_buffer_texture_class_init(
     FlPixelBufferTextureClass* klass) {
   G_OBJECT_CLASS(klass)->dispose = fl_pixel_buffer_texture_dispose;
@@ -86,3 +86,24 @@ TEST(FlPixelBufferTextureTest, PopulateTexture) {
   EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
   EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
 }
+
+// Test that populating an OpenGL texture again with a dirty region works.
+TEST(FlPixelBufferTextureTest, PopulateTextureWithDirtyRect) {
+  g_autoptr(FlPixelBufferTexture) texture =
+      FL_PIXEL_BUFFER_TEXTURE(fl_test_pixel_buffer_texture_new());
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      texture, kBufferWidth, kBufferHeight, &opengl_texture, &error));
+  uint32_t texture_name = opengl_texture.name;
+
+  // The storage of the texture is kept for a frame of the same size.
+  fl_pixel_buffer_texture_set_dirty_rect(texture, 1, 0, 1, 1);
+  fl_pixel_buffer_texture_set_dirty_rect(texture, 0, 1, 1, 1);
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(
+      texture, kBufferWidth, kBufferHeight, &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.name, texture_name);
+  EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+}
@@ -260,7 +260,10 @@ static void im_preedit_start_cb(FlTextInputPlugin* self) {
 static void im_preedit_changed_cb(FlTextInputPlugin* self) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  std::string text_before_change = priv->text_model->GetText();
+  std::string text_before_change;
+  if (priv->enable_delta_model) {
+    text_before_change = priv->text_model->GetText();
+  }
   g_autofree gchar* buf = nullptr;
   gint cursor_offset = 0;
   gtk_im_context_get_preedit_string(priv->im_context, &buf, nullptr,
@@ -287,7 +290,10 @@ static void im_preedit_changed_cb(FlTextInputPlugin* self) {
 static void im_commit_cb(FlTextInputPlugin* self, const gchar* text) {
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
-  std::string text_before_change = priv->text_model->GetText();
+  std::string text_before_change;
+  if (priv->enable_delta_model) {
+    text_before_change = priv->text_model->GetText();
+  }
   flutter::TextRange selection_before_change = priv->text_model->selection();
 
   priv->text_model->AddText(text);
@@ -336,7 +342,10 @@ static gboolean im_delete_surrounding_cb(FlTextInputPlugin* self,
   FlTextInputPluginPrivate* priv = static_cast<FlTextInputPluginPrivate*>(
       fl_text_input_plugin_get_instance_private(self));
 
-  std::string text_before_change = priv->text_model->GetText();
+  std::string text_before_change;
+  if (priv->enable_delta_model) {
+    text_before_change = priv->text_model->GetText();
+  }
   if (priv->text_model->DeleteSurrounding(offset, n_chars)) {
     if (priv->enable_delta_model) {
       flutter::TextEditingDelta delta = flutter::TextEditingDelta(
@@ -621,9 +630,15 @@ static gboolean fl_text_input_plugin_filter_keypress_default(
     return TRUE;
   }
 
-  std::string text_before_change = priv->text_model->GetText();
+  // The text is only copied for deltas, which carry the text before the
+  // change.
+  std::string text_before_change;
+  std::string text;
+  if (priv->enable_delta_model) {
+    text_before_change = priv->text_model->GetText();
+    text = text_before_change;
+  }
   flutter::TextRange selection_before_change = priv->text_model->selection();
-  std::string text = priv->text_model->GetText();
 
   // Handle the enter/return key.
   gboolean do_action = FALSE;
@@ -111,8 +111,9 @@ static void init_keyboard(FlView* self) {
 
   self->text_input_plugin = fl_text_input_plugin_new(
       messenger, im_context, FL_TEXT_INPUT_VIEW_DELEGATE(self));
-  self->keyboard_manager =
-      fl_keyboard_manager_new(FL_KEYBOARD_VIEW_DELEGATE(self));
+  self->keyboard_manager = fl_keyboard_manager_new(
+      FL_KEYBOARD_VIEW_DELEGATE(self),
+      fl_dart_project_get_raw_key_events_enabled(self->project));
 }
 
 static void init_scrolling(FlView* self) {
@@ -141,6 +141,35 @@ void fl_dart_project_set_dart_entrypoint_arguments(FlDartProject* project,
  */
 gchar** fl_dart_project_get_dart_entrypoint_arguments(FlDartProject* project);
 
+/**
+ * fl_dart_project_set_raw_key_events_enabled:
+ * @project: an #FlDartProject.
+ * @enabled: %TRUE if key events should also be sent as RawKeyEvents.
+ *
+ * Sets if key events are also sent to the framework as RawKeyEvents, encoded
+ * as JSON on the "flutter/keyevent" channel. They are sent by default.
+ *
+ * Key events are always sent to the framework as KeyEvents. Without the
+ * channel, the engine waits for one response per key event instead of two
+ * before it redispatches an unhandled event, but RawKeyboard listeners no
+ * longer receive events. Only disable the channel for frameworks that dispatch
+ * KeyEvents without waiting for the matching RawKeyEvent.
+ *
+ * This must be set before an #FlView is created for @project.
+ */
+void fl_dart_project_set_raw_key_events_enabled(FlDartProject* project,
+                                                gboolean enabled);
+
+/**
+ * fl_dart_project_get_raw_key_events_enabled:
+ * @project: an #FlDartProject.
+ *
+ * Gets if key events are also sent to the framework as RawKeyEvents.
+ *
+ * Returns: %TRUE if key events are also sent as RawKeyEvents.
+ */
+gboolean fl_dart_project_get_raw_key_events_enabled(FlDartProject* project);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DART_PROJECT_H_
@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <stdint.h>
+
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FL_DMABUF_TEXTURE_MAX_PLANES:
+ *
+ * The maximum number of planes of a dmabuf.
+ */
+#define FL_DMABUF_TEXTURE_MAX_PLANES 4
+
+/**
+ * FlDmabufPlane:
+ * @fd: file descriptor of the dmabuf containing the plane.
+ * @offset: offset of the plane in the dmabuf in bytes.
+ * @stride: number of bytes between two rows of the plane.
+ *
+ * A plane of a dmabuf.
+ */
+typedef struct {
+  int fd;
+  uint32_t offset;
+  uint32_t stride;
+} FlDmabufPlane;
+
+G_DECLARE_DERIVABLE_TYPE(FlDmabufTexture,
+                         fl_dmabuf_texture,
+                         FL,
+                         DMABUF_TEXTURE,
+                         GObject)
+
+/**
+ * FlDmabufTexture:
+ *
+ * #FlDmabufTexture represents an OpenGL texture imported from a dmabuf, such
+ * as the frames decoded by GStreamer or captured through PipeWire. The dmabuf
+ * is imported as an EGLImage, so the pixels are never copied by the CPU.
+ *
+ * The dmabuf must be in an RGB format the EGL implementation can import as a
+ * GL_TEXTURE_2D, for example DRM_FORMAT_ABGR8888. YUV frames have to be
+ * converted by the producer first.
+ *
+ * The following example shows how to implement an #FlDmabufTexture.
+ * ![<!-- language="C" -->
+ *   #include <drm_fourcc.h>
+ *
+ *   // Type definition, constructor, init, destructor and class_init are
+ *   // omitted.
+ *   struct _VideoDmabufTexture {  // extends FlDmabufTexture
+ *     FlDmabufTexture parent_instance;
+ *
+ *     VideoFrame *frame;  // your latest frame.
+ *   }
+ *
+ *   G_DEFINE_TYPE(VideoDmabufTexture,
+ *                 video_dmabuf_texture,
+ *                 fl_dmabuf_texture_get_type ())
+ *
+ *   static gboolean
+ *   video_dmabuf_texture_get_dmabuf (FlDmabufTexture* texture,
+ *                                    uint32_t* fourcc,
+ *                                    uint64_t* modifier,
+ *                                    FlDmabufPlane* planes,
+ *                                    uint32_t* n_planes,
+ *                                    uint32_t* width,
+ *                                    uint32_t* height,
+ *                                    GError** error) {
+ *     // This method is called on Render Thread. Be careful with your
+ *     // cross-thread operation.
+ *     VideoDmabufTexture* self = VIDEO_DMABUF_TEXTURE (texture);
+ *
+ *     *fourcc = DRM_FORMAT_ABGR8888;
+ *     *modifier = self->frame->modifier;
+ *     planes[0].fd = self->frame->fd;
+ *     planes[0].offset = 0;
+ *     planes[0].stride = self->frame->stride;
+ *     *n_planes = 1;
+ *     *width = self->frame->width;
+ *     *height = self->frame->height;
+ *
+ *     return TRUE;
+ *   }
+ * ]|
+ */
+
+struct _FlDmabufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * FlDmabufTexture::get_dmabuf:
+   * @texture: an #FlDmabufTexture.
+   * @fourcc: (out): DRM format of the dmabuf.
+   * @modifier: (out): DRM format modifier of the dmabuf, or
+   * DRM_FORMAT_MOD_INVALID if it has none.
+   * @planes: (out): an array of #FL_DMABUF_TEXTURE_MAX_PLANES planes to
+   * store the planes of the dmabuf in.
+   * @n_planes: (out): number of planes of the dmabuf.
+   * @width: (inout): width of the texture in pixels.
+   * @height: (inout): height of the texture in pixels.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Retrieve the dmabuf to show. The file descriptors remain owned by the
+   * texture, and must stay valid until this method is called again or the
+   * texture is unregistered.
+   *
+   * As this method is usually invoked from the render thread, you must
+   * take care of proper synchronization.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*get_dmabuf)(FlDmabufTexture* texture,
+                         uint32_t* fourcc,
+                         uint64_t* modifier,
+                         FlDmabufPlane* planes,
+                         uint32_t* n_planes,
+                         uint32_t* width,
+                         uint32_t* height,
+                         GError** error);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMABUF_TEXTURE_H_
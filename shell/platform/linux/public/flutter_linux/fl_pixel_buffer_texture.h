@@ -102,6 +102,28 @@ struct _FlPixelBufferTextureClass {
                           GError** error);
 };
 
+/**
+ * fl_pixel_buffer_texture_set_dirty_rect:
+ * @texture: an #FlPixelBufferTexture.
+ * @x: left edge of the region in pixels.
+ * @y: top edge of the region in pixels.
+ * @width: width of the region in pixels.
+ * @height: height of the region in pixels.
+ *
+ * Marks the region of the pixel buffer that changed since the last frame, so
+ * that only that region is uploaded to the texture. The region is combined
+ * with the regions marked before, and reset once uploaded. If no region is
+ * marked, or the size of the buffer changed, the whole buffer is uploaded.
+ *
+ * The pixel buffer returned by the copy_pixels method must still hold all of
+ * the pixels. This function should be called from that method.
+ */
+void fl_pixel_buffer_texture_set_dirty_rect(FlPixelBufferTexture* texture,
+                                            uint32_t x,
+                                            uint32_t y,
+                                            uint32_t width,
+                                            uint32_t height);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_PIXEL_BUFFER_TEXTURE_H_
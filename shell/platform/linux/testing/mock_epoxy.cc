@@ -45,11 +45,15 @@ typedef struct {
 typedef struct {
 } MockSurface;
 
+typedef struct {
+} MockImage;
+
 static bool display_initialized = false;
 static MockDisplay mock_display;
 static MockConfig mock_config;
 static MockContext mock_context;
 static MockSurface mock_surface;
+static MockImage mock_image;
 
 static EGLint mock_error = EGL_SUCCESS;
 
@@ -254,6 +258,31 @@ EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
   }
 }
 
+EGLImageKHR _eglCreateImageKHR(EGLDisplay dpy,
+                               EGLContext ctx,
+                               EGLenum target,
+                               EGLClientBuffer buffer,
+                               const EGLint* attrib_list) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  mock_error = EGL_SUCCESS;
+  return &mock_image;
+}
+
+EGLBoolean _eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
+EGLDisplay _eglGetCurrentDisplay() {
+  return &mock_display;
+}
+
 EGLDisplay _eglGetDisplay(EGLNativeDisplayType display_id) {
   return &mock_display;
 }
@@ -334,20 +363,42 @@ EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   return bool_success();
 }
 
+static void _glBindBuffer(GLenum target, GLuint buffer) {}
+
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {}
 
+static void _glBufferData(GLenum target,
+                          GLsizeiptr size,
+                          const void* data,
+                          GLenum usage) {}
+
+static void _glBufferSubData(GLenum target,
+                             GLintptr offset,
+                             GLsizeiptr size,
+                             const void* data) {}
+
+void _glDeleteBuffers(GLsizei n, const GLuint* buffers) {}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
 
+static void _glEGLImageTargetTexture2DOES(GLenum target, GLeglImageOES image) {}
+
 static void _glFramebufferTexture2D(GLenum target,
                                     GLenum attachment,
                                     GLenum textarget,
                                     GLuint texture,
                                     GLint level) {}
 
+static void _glGenBuffers(GLsizei n, GLuint* buffers) {
+  for (GLsizei i = 0; i < n; i++) {
+    buffers[i] = 0;
+  }
+}
+
 static void _glGenTextures(GLsizei n, GLuint* textures) {
   for (GLsizei i = 0; i < n; i++) {
     textures[i] = 0;
@@ -360,6 +411,8 @@ static void _glGenFramebuffers(GLsizei n, GLuint* framebuffers) {
   }
 }
 
+static void _glPixelStorei(GLenum pname, GLint param) {}
+
 static void _glTexParameterf(GLenum target, GLenum pname, GLfloat param) {}
 
 static void _glTexParameteri(GLenum target, GLenum pname, GLint param) {}
@@ -374,6 +427,22 @@ static void _glTexImage2D(GLenum target,
                           GLenum type,
                           const void* pixels) {}
 
+static void _glTexStorage2D(GLenum target,
+                            GLsizei levels,
+                            GLenum internalformat,
+                            GLsizei width,
+                            GLsizei height) {}
+
+static void _glTexSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* pixels) {}
+
 static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
@@ -382,6 +451,10 @@ bool epoxy_has_gl_extension(const char* extension) {
   return false;
 }
 
+bool epoxy_has_egl_extension(EGLDisplay dpy, const char* extension) {
+  return true;
+}
+
 bool epoxy_is_desktop_gl(void) {
   return false;
 }
@@ -430,6 +503,13 @@ EGLBoolean (*epoxy_eglGetConfigAttrib)(EGLDisplay dpy,
                                        EGLConfig config,
                                        EGLint attribute,
                                        EGLint* value);
+EGLImageKHR (*epoxy_eglCreateImageKHR)(EGLDisplay dpy,
+                                       EGLContext ctx,
+                                       EGLenum target,
+                                       EGLClientBuffer buffer,
+                                       const EGLint* attrib_list);
+EGLBoolean (*epoxy_eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
+EGLDisplay (*epoxy_eglGetCurrentDisplay)();
 EGLDisplay (*epoxy_eglGetDisplay)(EGLNativeDisplayType display_id);
 EGLint (*epoxy_eglGetError)();
 void (*(*epoxy_eglGetProcAddress)(const char* procname))(void);
@@ -440,17 +520,30 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLContext ctx);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
 
+void (*epoxy_glBindBuffer)(GLenum target, GLuint buffer);
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
+void (*epoxy_glBufferData)(GLenum target,
+                           GLsizeiptr size,
+                           const void* data,
+                           GLenum usage);
+void (*epoxy_glBufferSubData)(GLenum target,
+                              GLintptr offset,
+                              GLsizeiptr size,
+                              const void* data);
+void (*epoxy_glDeleteBuffers)(GLsizei n, const GLuint* buffers);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
+void (*epoxy_glEGLImageTargetTexture2DOES)(GLenum target, GLeglImageOES image);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum attachment,
                                      GLenum textarget,
                                      GLuint texture,
                                      GLint level);
 void (*epoxy_glGenFramebuffers)(GLsizei n, GLuint* framebuffers);
+void (*epoxy_glGenBuffers)(GLsizei n, GLuint* buffers);
 void (*epoxy_glGenTextures)(GLsizei n, GLuint* textures);
+void (*epoxy_glPixelStorei)(GLenum pname, GLint param);
 void (*epoxy_glTexParameterf)(GLenum target, GLenum pname, GLfloat param);
 void (*epoxy_glTexParameteri)(GLenum target, GLenum pname, GLint param);
 void (*epoxy_glTexImage2D)(GLenum target,
@@ -462,6 +555,20 @@ void (*epoxy_glTexImage2D)(GLenum target,
                            GLenum format,
                            GLenum type,
                            const void* pixels);
+void (*epoxy_glTexStorage2D)(GLenum target,
+                             GLsizei levels,
+                             GLenum internalformat,
+                             GLsizei width,
+                             GLsizei height);
+void (*epoxy_glTexSubImage2D)(GLenum target,
+                              GLint level,
+                              GLint xoffset,
+                              GLint yoffset,
+                              GLsizei width,
+                              GLsizei height,
+                              GLenum format,
+                              GLenum type,
+                              const void* pixels);
 GLenum (*epoxy_glGetError)();
 
 static void library_init() {
@@ -471,6 +578,9 @@ static void library_init() {
   epoxy_eglCreatePbufferSurface = _eglCreatePbufferSurface;
   epoxy_eglCreateWindowSurface = _eglCreateWindowSurface;
   epoxy_eglGetConfigAttrib = _eglGetConfigAttrib;
+  epoxy_eglCreateImageKHR = _eglCreateImageKHR;
+  epoxy_eglDestroyImageKHR = _eglDestroyImageKHR;
+  epoxy_eglGetCurrentDisplay = _eglGetCurrentDisplay;
   epoxy_eglGetDisplay = _eglGetDisplay;
   epoxy_eglGetError = _eglGetError;
   epoxy_eglGetProcAddress = _eglGetProcAddress;
@@ -478,15 +588,24 @@ static void library_init() {
   epoxy_eglMakeCurrent = _eglMakeCurrent;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
 
+  epoxy_glBindBuffer = _glBindBuffer;
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
+  epoxy_glBufferData = _glBufferData;
+  epoxy_glBufferSubData = _glBufferSubData;
+  epoxy_glDeleteBuffers = _glDeleteBuffers;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
+  epoxy_glEGLImageTargetTexture2DOES = _glEGLImageTargetTexture2DOES;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
+  epoxy_glGenBuffers = _glGenBuffers;
   epoxy_glGenTextures = _glGenTextures;
+  epoxy_glPixelStorei = _glPixelStorei;
   epoxy_glTexParameterf = _glTexParameterf;
   epoxy_glTexParameteri = _glTexParameteri;
   epoxy_glTexImage2D = _glTexImage2D;
+  epoxy_glTexStorage2D = _glTexStorage2D;
+  epoxy_glTexSubImage2D = _glTexSubImage2D;
   epoxy_glGetError = _glGetError;
 }
@@ -4,10 +4,17 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <cstring>
 #include <vector>
 
 #include "flutter/fml/logging.h"
 
+// Defined by EGL_ANGLE_direct_composition, which isn't part of every version
+// of the ANGLE headers.
+#ifndef EGL_DIRECT_COMPOSITION_ANGLE
+#define EGL_DIRECT_COMPOSITION_ANGLE 0x33A5
+#endif
+
 // Logs an EGL error to stderr. This automatically calls eglGetError()
 // and logs the error code.
 static void LogEglError(std::string message) {
@@ -146,6 +153,13 @@ bool AngleSurfaceManager::Initialize() {
     }
   }
 
+  // DirectComposition presents flip model swap chains without copying them
+  // into the window's redirection surface first.
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  supports_direct_composition_ =
+      extensions &&
+      strstr(extensions, "EGL_ANGLE_direct_composition") != nullptr;
+
   EGLint numConfigs = 0;
   if ((eglChooseConfig(egl_display_, config_attributes, &egl_config_, 1,
                        &numConfigs) == EGL_FALSE) ||
@@ -214,18 +228,25 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
     return false;
   }
 
+  HWND window = std::get<HWND>(*render_target);
   EGLSurface surface = EGL_NO_SURFACE;
-
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
-
-  surface = eglCreateWindowSurface(
-      egl_display_, egl_config_,
-      static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+  if (supports_direct_composition_) {
+    surface = CreateWindowSurface(window, width, height, true);
+    if (surface == EGL_NO_SURFACE) {
+      // Fall back to presenting through the redirection surface, for example
+      // when the window is already composed by someone else.
+      FML_LOG(WARNING) << "Failed to create a DirectComposition surface, "
+                       << "falling back to a regular window surface.";
+      supports_direct_composition_ = false;
+    }
+  }
+  if (surface == EGL_NO_SURFACE) {
+    surface = CreateWindowSurface(window, width, height, false);
+  }
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
+  } else {
+    LimitFrameLatency();
   }
 
   surface_width_ = width;
@@ -234,6 +255,40 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   return true;
 }
 
+EGLSurface AngleSurfaceManager::CreateWindowSurface(HWND window,
+                                                    EGLint width,
+                                                    EGLint height,
+                                                    bool direct_composition) {
+  std::vector<EGLint> surface_attributes = {
+      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width, EGL_HEIGHT, height,
+  };
+  if (direct_composition) {
+    surface_attributes.push_back(EGL_DIRECT_COMPOSITION_ANGLE);
+    surface_attributes.push_back(EGL_TRUE);
+  }
+  surface_attributes.push_back(EGL_NONE);
+
+  return eglCreateWindowSurface(egl_display_, egl_config_,
+                                static_cast<EGLNativeWindowType>(window),
+                                surface_attributes.data());
+}
+
+void AngleSurfaceManager::LimitFrameLatency() {
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  if (!GetDevice(device.GetAddressOf())) {
+    return;
+  }
+  Microsoft::WRL::ComPtr<IDXGIDevice1> dxgi_device;
+  if (FAILED(device.As(&dxgi_device))) {
+    return;
+  }
+  // The raster thread blocks in eglSwapBuffers instead of running ahead, so
+  // a frame reaches the screen at most one vsync after it was rendered.
+  if (FAILED(dxgi_device->SetMaximumFrameLatency(1))) {
+    FML_LOG(WARNING) << "Failed to limit the frame latency of the device.";
+  }
+}
+
 void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
                                         EGLint width,
                                         EGLint height) {
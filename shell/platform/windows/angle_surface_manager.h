@@ -14,6 +14,7 @@
 
 // Windows platform specific includes
 #include <d3d11.h>
+#include <dxgi.h>
 #include <windows.h>
 #include <wrl/client.h>
 #include <memory>
@@ -37,6 +38,10 @@ class AngleSurfaceManager {
   // associated with window, in the appropriate format for display.
   // Target represents the visual entity to bind to.  Width and
   // height represent dimensions surface is created at.
+  //
+  // When ANGLE supports it, the swap chain is a flip model swap chain that
+  // is presented through a DirectComposition visual of the window instead of
+  // the window's redirection surface.
   bool CreateSurface(WindowsRenderTarget* render_target,
                      EGLint width,
                      EGLint height);
@@ -96,6 +101,17 @@ class AngleSurfaceManager {
       const EGLint* config,
       bool should_log);
 
+  // Creates the window surface, presenting through DirectComposition if
+  // |direct_composition| is true.
+  EGLSurface CreateWindowSurface(HWND window,
+                                 EGLint width,
+                                 EGLint height,
+                                 bool direct_composition);
+
+  // Limits the number of frames queued for presentation by the D3D device to
+  // one, trading throughput for input latency.
+  void LimitFrameLatency();
+
   // EGL representation of native display.
   EGLDisplay egl_display_;
 
@@ -113,6 +129,9 @@ class AngleSurfaceManager {
   // creating surfaces.
   bool initialize_succeeded_;
 
+  // Whether window surfaces can be presented through DirectComposition.
+  bool supports_direct_composition_ = false;
+
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
@@ -32,6 +32,9 @@ FlutterEngine::FlutterEngine(const DartProject& project) {
       entrypoint_argv.empty() ? nullptr : entrypoint_argv.data();
 
   engine_ = FlutterDesktopEngineCreate(&c_engine_properties);
+  if (!project.raw_key_events_enabled()) {
+    FlutterDesktopEngineSetRawKeyEventsEnabled(engine_, false);
+  }
 
   auto core_messenger = FlutterDesktopEngineGetMessenger(engine_);
   messenger_ = std::make_unique<BinaryMessengerImpl>(core_messenger);
@@ -56,6 +56,11 @@ class TestFlutterWindowsApi : public testing::StubFlutterWindowsApi {
   // |flutter::testing::StubFlutterWindowsApi|
   void EngineReloadSystemFonts() override { reload_fonts_called_ = true; }
 
+  // |flutter::testing::StubFlutterWindowsApi|
+  void EngineSetRawKeyEventsEnabled(bool enabled) override {
+    raw_key_events_enabled_ = enabled;
+  }
+
   bool create_called() { return create_called_; }
 
   bool run_called() { return run_called_; }
@@ -64,6 +69,8 @@ class TestFlutterWindowsApi : public testing::StubFlutterWindowsApi {
 
   bool reload_fonts_called() { return reload_fonts_called_; }
 
+  bool raw_key_events_enabled() { return raw_key_events_enabled_; }
+
   const std::vector<std::string>& dart_entrypoint_arguments() {
     return dart_entrypoint_arguments_;
   }
@@ -79,6 +86,7 @@ class TestFlutterWindowsApi : public testing::StubFlutterWindowsApi {
   bool run_called_ = false;
   bool destroy_called_ = false;
   bool reload_fonts_called_ = false;
+  bool raw_key_events_enabled_ = true;
   std::vector<std::string> dart_entrypoint_arguments_;
   VoidCallback next_frame_callback_ = nullptr;
   void* next_frame_user_data_ = nullptr;
@@ -183,6 +191,27 @@ TEST(FlutterEngineTest, DartEntrypointArgs) {
   EXPECT_TRUE(arguments[1] == arguments_ref[1]);
 }
 
+TEST(FlutterEngineTest, RawKeyEventsAreEnabledByDefault) {
+  testing::ScopedStubFlutterWindowsApi scoped_api_stub(
+      std::make_unique<TestFlutterWindowsApi>());
+  auto test_api = static_cast<TestFlutterWindowsApi*>(scoped_api_stub.stub());
+
+  FlutterEngine engine(DartProject(L"fake/project/path"));
+  EXPECT_TRUE(test_api->raw_key_events_enabled());
+}
+
+TEST(FlutterEngineTest, DisableRawKeyEvents) {
+  testing::ScopedStubFlutterWindowsApi scoped_api_stub(
+      std::make_unique<TestFlutterWindowsApi>());
+  auto test_api = static_cast<TestFlutterWindowsApi*>(scoped_api_stub.stub());
+
+  DartProject project(L"data");
+  project.set_raw_key_events_enabled(false);
+
+  FlutterEngine engine(project);
+  EXPECT_FALSE(test_api->raw_key_events_enabled());
+}
+
 TEST(FlutterEngineTest, SetNextFrameCallback) {
   DartProject project(L"data");
   testing::ScopedStubFlutterWindowsApi scoped_api_stub(
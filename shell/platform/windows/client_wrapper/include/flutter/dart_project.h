@@ -71,6 +71,18 @@ class DartProject {
     return dart_entrypoint_arguments_;
   }
 
+  // Sets whether key events are also sent to the framework as RawKeyEvents
+  // on the "flutter/keyevent" channel. See
+  // FlutterDesktopEngineSetRawKeyEventsEnabled in flutter_windows.h.
+  //
+  // If not set, RawKeyEvents are sent.
+  void set_raw_key_events_enabled(bool enabled) {
+    raw_key_events_enabled_ = enabled;
+  }
+
+  // Returns whether key events are also sent as RawKeyEvents.
+  bool raw_key_events_enabled() const { return raw_key_events_enabled_; }
+
  private:
   // Accessors for internals are private, so that they can be changed if more
   // flexible options for project structures are needed later without it
@@ -95,6 +107,8 @@ class DartProject {
   std::string dart_entrypoint_;
   // The list of arguments to pass through to the Dart entrypoint.
   std::vector<std::string> dart_entrypoint_arguments_;
+  // Whether key events are also sent as RawKeyEvents.
+  bool raw_key_events_enabled_ = true;
 };
 
 }  // namespace flutter
@@ -125,6 +125,13 @@ void FlutterDesktopEngineReloadSystemFonts(FlutterDesktopEngineRef engine) {
   }
 }
 
+void FlutterDesktopEngineSetRawKeyEventsEnabled(FlutterDesktopEngineRef engine,
+                                                bool enabled) {
+  if (s_stub_implementation) {
+    s_stub_implementation->EngineSetRawKeyEventsEnabled(enabled);
+  }
+}
+
 FlutterDesktopPluginRegistrarRef FlutterDesktopEngineGetPluginRegistrar(
     FlutterDesktopEngineRef engine,
     const char* plugin_name) {
@@ -69,6 +69,9 @@ class StubFlutterWindowsApi {
   // Called for FlutterDesktopEngineReloadSystemFonts.
   virtual void EngineReloadSystemFonts() {}
 
+  // Called for FlutterDesktopEngineSetRawKeyEventsEnabled.
+  virtual void EngineSetRawKeyEventsEnabled(bool enabled) {}
+
   // Called for FlutterDesktopViewGetHWND.
   virtual HWND ViewGetHWND() { return reinterpret_cast<HWND>(1); }
 
@@ -159,6 +159,11 @@ void FlutterDesktopEngineReloadSystemFonts(FlutterDesktopEngineRef engine) {
   EngineFromHandle(engine)->ReloadSystemFonts();
 }
 
+void FlutterDesktopEngineSetRawKeyEventsEnabled(FlutterDesktopEngineRef engine,
+                                                bool enabled) {
+  EngineFromHandle(engine)->SetRawKeyEventsEnabled(enabled);
+}
+
 FlutterDesktopPluginRegistrarRef FlutterDesktopEngineGetPluginRegistrar(
     FlutterDesktopEngineRef engine,
     const char* plugin_name) {
@@ -178,6 +178,21 @@ FlutterWindowsEngine::FlutterWindowsEngine(
             }
           });
 
+  vsync_waiter_ = std::make_unique<VsyncWaiter>(
+      [this](intptr_t baton, bool vblank_reached,
+             std::chrono::nanoseconds refresh_interval) {
+        // Called on the vsync waiter's thread.
+        if (!vblank_reached) {
+          OnPredictedVsync(baton);
+          return;
+        }
+        std::chrono::nanoseconds frame_interval =
+            refresh_interval.count() > 0 ? refresh_interval : FrameInterval();
+        uint64_t current_time = embedder_api_.GetCurrentTime();
+        embedder_api_.OnVsync(engine_, baton, current_time,
+                              current_time + frame_interval.count());
+      });
+
   // Set up the legacy structs backing the API handles.
   messenger_ =
       fml::RefPtr<FlutterDesktopMessenger>(new FlutterDesktopMessenger());
@@ -390,6 +405,8 @@ bool FlutterWindowsEngine::Run(std::string_view entrypoint) {
 }
 
 bool FlutterWindowsEngine::Stop() {
+  // Vsyncs may be reported until the thread is stopped.
+  vsync_waiter_->Stop();
   if (engine_) {
     for (const auto& [callback, registrar] :
          plugin_registrar_destruction_callbacks_) {
@@ -404,10 +421,26 @@ bool FlutterWindowsEngine::Stop() {
 
 void FlutterWindowsEngine::SetView(FlutterWindowsView* view) {
   view_ = view;
+  vsync_waiter_->SetWindow(view ? view->GetPlatformWindow() : nullptr);
   InitializeKeyboard();
 }
 
 void FlutterWindowsEngine::OnVsync(intptr_t baton) {
+  // The platform thread is blocked until a frame of the new size has been
+  // presented, so start that frame right away instead of at the next vblank.
+  if (view_ && view_->IsResizing()) {
+    uint64_t current_time = embedder_api_.GetCurrentTime();
+    embedder_api_.OnVsync(engine_, baton, current_time,
+                          current_time + FrameInterval().count());
+    return;
+  }
+  if (vsync_waiter_->AwaitVsync(baton)) {
+    return;
+  }
+  OnPredictedVsync(baton);
+}
+
+void FlutterWindowsEngine::OnPredictedVsync(intptr_t baton) {
   std::chrono::nanoseconds current_time =
       std::chrono::nanoseconds(embedder_api_.GetCurrentTime());
   std::chrono::nanoseconds frame_interval = FrameInterval();
@@ -596,8 +629,10 @@ FlutterWindowsEngine::CreateKeyboardKeyHandler(
             return SendKeyEvent(event, callback, user_data);
           },
           get_key_state, map_vk_to_scan));
-  keyboard_key_handler->AddDelegate(
-      std::make_unique<KeyboardKeyChannelHandler>(messenger));
+  if (raw_key_events_enabled_) {
+    keyboard_key_handler->AddDelegate(
+        std::make_unique<KeyboardKeyChannelHandler>(messenger));
+  }
   return keyboard_key_handler;
 }
 
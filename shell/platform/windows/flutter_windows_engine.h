@@ -32,6 +32,7 @@
 #include "flutter/shell/platform/windows/settings_plugin.h"
 #include "flutter/shell/platform/windows/task_runner.h"
 #include "flutter/shell/platform/windows/text_input_plugin.h"
+#include "flutter/shell/platform/windows/vsync_waiter.h"
 #include "flutter/shell/platform/windows/window_proc_delegate_manager.h"
 #include "flutter/shell/platform/windows/window_state.h"
 #include "flutter/shell/platform/windows/windows_registry.h"
@@ -192,6 +193,17 @@ class FlutterWindowsEngine {
   // Informs the engine that the system font list has changed.
   void ReloadSystemFonts();
 
+  // Sets whether key events are also sent as RawKeyEvents on the
+  // "flutter/keyevent" channel. See
+  // |FlutterDesktopEngineSetRawKeyEventsEnabled|.
+  //
+  // Takes effect the next time the keyboard is initialized.
+  void SetRawKeyEventsEnabled(bool enabled) {
+    raw_key_events_enabled_ = enabled;
+  }
+
+  bool raw_key_events_enabled() const { return raw_key_events_enabled_; }
+
   // Informs the engine that a new frame is needed to redraw the content.
   void ScheduleFrame();
 
@@ -357,6 +369,10 @@ class FlutterWindowsEngine {
   // Handlers for keyboard events from Windows.
   std::unique_ptr<KeyboardHandlerBase> keyboard_key_handler_;
 
+  // Whether the keyboard key handler also sends key events on the
+  // "flutter/keyevent" channel.
+  bool raw_key_events_enabled_ = true;
+
   // Handlers for text events from Windows.
   std::unique_ptr<TextInputPlugin> text_input_plugin_;
 
@@ -372,6 +388,13 @@ class FlutterWindowsEngine {
   // The approximate time between vblank events.
   std::chrono::nanoseconds FrameInterval();
 
+  // Reports a frame starting at the next vblank predicted from the frame
+  // interval to the engine, without waiting for it.
+  void OnPredictedVsync(intptr_t baton);
+
+  // Waits for the vblanks of the monitor showing the view.
+  std::unique_ptr<VsyncWaiter> vsync_waiter_;
+
   // The start time used to align frames.
   std::chrono::nanoseconds start_time_ = std::chrono::nanoseconds::zero();
 
@@ -98,6 +98,11 @@ void FlutterWindowsView::ForceRedraw() {
   }
 }
 
+bool FlutterWindowsView::IsResizing() {
+  std::unique_lock<std::mutex> lock(resize_mutex_);
+  return resize_status_ != ResizeState::kDone;
+}
+
 void FlutterWindowsView::OnWindowSizeChanged(size_t width, size_t height) {
   // Called on the platform thread.
   std::unique_lock<std::mutex> lock(resize_mutex_);
@@ -65,6 +65,12 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   // Tells the engine to generate a new frame
   void ForceRedraw();
 
+  // Returns true while the platform thread is blocked waiting for a frame of
+  // the new window size.
+  //
+  // Can be called from any thread.
+  bool IsResizing();
+
   // Callbacks for clearing context, settings context and swapping buffers,
   // these are typically called on an engine-controlled (non-platform) thread.
   bool ClearContext();
@@ -116,6 +116,26 @@ TEST(FlutterWindowsViewTest, KeySequence) {
   key_event_logs.clear();
 }
 
+TEST(FlutterWindowsViewTest, KeySequenceWithoutRawKeyEvents) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  engine->SetRawKeyEventsEnabled(false);
+
+  test_response = false;
+
+  auto window_binding_handler =
+      std::make_unique<::testing::NiceMock<MockWindowBindingHandler>>();
+  FlutterWindowsView view(std::move(window_binding_handler));
+  view.SetEngine(std::move(engine));
+
+  view.OnKey(kVirtualKeyA, kScanCodeKeyA, WM_KEYDOWN, 'a', false, false,
+             [](bool handled) {});
+
+  EXPECT_EQ(key_event_logs.size(), 1);
+  EXPECT_EQ(key_event_logs[0], kKeyEventFromEmbedder);
+
+  key_event_logs.clear();
+}
+
 TEST(FlutterWindowsViewTest, EnableSemantics) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   EngineModifier modifier(engine.get());
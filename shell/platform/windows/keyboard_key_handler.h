@@ -28,7 +28,8 @@ namespace flutter {
 // reality, this design is only to support sending events through
 // "channel" (RawKeyEvent) and "embedder" (KeyEvent) simultaneously,
 // the former of which shall be removed after the deprecation window
-// of the RawKeyEvent system.
+// of the RawKeyEvent system. The embedder delegate must be added first.
+// The channel delegate is left out when RawKeyEvents are disabled.
 class KeyboardKeyHandler : public KeyboardHandlerBase {
  public:
   // An interface for concrete definition of how to asynchronously handle key
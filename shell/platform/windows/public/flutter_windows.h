@@ -173,6 +173,20 @@ FlutterDesktopEngineProcessMessages(FlutterDesktopEngineRef engine);
 FLUTTER_EXPORT void FlutterDesktopEngineReloadSystemFonts(
     FlutterDesktopEngineRef engine);
 
+// Sets whether key events are also sent to the framework as RawKeyEvents,
+// encoded as JSON on the "flutter/keyevent" channel. They are sent by default.
+//
+// Key events are always sent to the framework as KeyEvents. Without the
+// channel, the engine waits for one response per key event instead of two
+// before it redispatches an unhandled event, but RawKeyboard listeners no
+// longer receive events. Only disable the channel for frameworks that dispatch
+// KeyEvents without waiting for the matching RawKeyEvent.
+//
+// This must be called before a view controller is created for |engine|.
+FLUTTER_EXPORT void FlutterDesktopEngineSetRawKeyEventsEnabled(
+    FlutterDesktopEngineRef engine,
+    bool enabled);
+
 // Returns the plugin registrar handle for the plugin with the given name.
 //
 // The name must be unique across the application.
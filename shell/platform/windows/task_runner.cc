@@ -50,6 +50,7 @@ std::chrono::nanoseconds TaskRunner::ProcessTasks() {
   }
 
   // Fire expired tasks.
+  size_t fired_tasks = 0;
   {
     // Flushing tasks here without holing onto the task queue mutex.
     for (const auto& task : expired_tasks) {
@@ -57,12 +58,27 @@ std::chrono::nanoseconds TaskRunner::ProcessTasks() {
         on_task_expired_(flutter_task);
       } else if (auto closure = std::get_if<TaskClosure>(&task.variant))
         (*closure)();
+      ++fired_tasks;
+
+      // Don't keep window messages waiting behind unrelated tasks.
+      if (fired_tasks < expired_tasks.size() && HasPendingMessages()) {
+        break;
+      }
     }
   }
 
   // Calculate duration to sleep for on next iteration.
   {
     std::lock_guard<std::mutex> lock(task_queue_mutex_);
+    // Tasks that didn't run keep their order, and run as soon as the message
+    // loop is idle again.
+    for (size_t i = fired_tasks; i < expired_tasks.size(); ++i) {
+      task_queue_.push(std::move(expired_tasks[i]));
+    }
+    if (fired_tasks < expired_tasks.size()) {
+      return std::chrono::nanoseconds::zero();
+    }
+
     const auto next_wake = task_queue_.empty() ? TaskTimePoint::max()
                                                : task_queue_.top().fire_time;
 
@@ -117,4 +133,8 @@ void TaskRunner::WakeUp() {
   task_runner_window_->WakeUp();
 }
 
+bool TaskRunner::HasPendingMessages() const {
+  return HIWORD(GetQueueStatus(QS_INPUT | QS_SENDMESSAGE)) != 0;
+}
+
 }  // namespace flutter
@@ -83,6 +83,13 @@ class TaskRunner : public TaskRunnerWindow::Delegate {
   // Schedules timers to call `ProcessTasks()` at the runner's thread.
   virtual void WakeUp();
 
+  // Returns true if the thread has input or sent messages waiting, such as
+  // the ones driving an interactive window resize. `ProcessTasks()` then
+  // returns to the message loop before running the remaining expired tasks.
+  //
+  // Tests can override this to simulate pending messages.
+  virtual bool HasPendingMessages() const;
+
   // Returns the current TaskTimePoint that can be used to determine whether a
   // task is expired.
   //
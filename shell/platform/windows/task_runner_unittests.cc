@@ -18,7 +18,9 @@ class MockTaskRunner : public TaskRunner {
 
   virtual bool RunsTasksOnCurrentThread() const override { return true; }
 
-  void SimulateTimerAwake() { ProcessTasks(); }
+  std::chrono::nanoseconds SimulateTimerAwake() { return ProcessTasks(); }
+
+  bool has_pending_messages = false;
 
  protected:
   virtual void WakeUp() override {
@@ -26,6 +28,10 @@ class MockTaskRunner : public TaskRunner {
     // posted.
   }
 
+  virtual bool HasPendingMessages() const override {
+    return has_pending_messages;
+  }
+
   virtual TaskTimePoint GetCurrentTimeForTask() const override {
     return TaskTimePoint(
         std::chrono::duration_cast<std::chrono::steady_clock::duration>(
@@ -84,5 +90,30 @@ TEST(TaskRunnerTest, MaybeExecuteTaskOnlyExpired) {
   EXPECT_EQ(executed_task, only_task_expired_before_now);
 }
 
+TEST(TaskRunnerTest, YieldsToPendingMessages) {
+  std::vector<uint64_t> executed_task_order;
+  auto runner =
+      MockTaskRunner(MockGetCurrentTime,
+                     [&executed_task_order](const FlutterTask* expired_task) {
+                       executed_task_order.push_back(expired_task->task);
+                     });
+
+  uint64_t time_now = MockGetCurrentTime();
+  runner.PostFlutterTask(FlutterTask{nullptr, 1}, time_now);
+  runner.PostFlutterTask(FlutterTask{nullptr, 2}, time_now);
+  runner.PostFlutterTask(FlutterTask{nullptr, 3}, time_now);
+
+  // Only the first task runs while messages are waiting, the others are
+  // picked up right away by the next iteration.
+  runner.has_pending_messages = true;
+  EXPECT_EQ(runner.SimulateTimerAwake(), std::chrono::nanoseconds::zero());
+  EXPECT_EQ(executed_task_order, std::vector<uint64_t>{1});
+
+  runner.has_pending_messages = false;
+  runner.SimulateTimerAwake();
+  std::vector<uint64_t> posted_task_order{1, 2, 3};
+  EXPECT_EQ(executed_task_order, posted_task_order);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -8,6 +8,11 @@
 
 #include "flutter/fml/logging.h"
 
+// Only defined by the Windows 10 1803 SDK and later.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace flutter {
 
 TaskRunnerWindow::TaskRunnerWindow() {
@@ -30,9 +35,33 @@ TaskRunnerWindow::TaskRunnerWindow() {
     OutputDebugString(message);
     LocalFree(message);
   }
+
+  // Window timers have the granularity of the system timer, usually around
+  // 15ms, which is too coarse to pace frames on high refresh rate displays.
+  // High resolution timers are only available on Windows 10 1803 and later.
+  timer_ = CreateWaitableTimerExW(nullptr, nullptr,
+                                  CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                  TIMER_ALL_ACCESS);
+  if (timer_) {
+    timer_wait_ = CreateThreadpoolWait(OnTimerSignaled, this, nullptr);
+    if (!timer_wait_) {
+      CloseHandle(timer_);
+      timer_ = nullptr;
+    }
+  }
 }
 
 TaskRunnerWindow::~TaskRunnerWindow() {
+  if (timer_wait_) {
+    SetThreadpoolWait(timer_wait_, nullptr, nullptr);
+    WaitForThreadpoolWaitCallbacks(timer_wait_, TRUE);
+    CloseThreadpoolWait(timer_wait_);
+    timer_wait_ = nullptr;
+  }
+  if (timer_) {
+    CloseHandle(timer_);
+    timer_ = nullptr;
+  }
   if (window_handle_) {
     DestroyWindow(window_handle_);
     window_handle_ = nullptr;
@@ -83,12 +112,46 @@ void TaskRunnerWindow::ProcessTasks() {
 }
 
 void TaskRunnerWindow::SetTimer(std::chrono::nanoseconds when) {
+  if (!timer_) {
+    if (when == std::chrono::nanoseconds::max()) {
+      KillTimer(window_handle_, 0);
+    } else {
+      auto millis =
+          std::chrono::duration_cast<std::chrono::milliseconds>(when);
+      ::SetTimer(window_handle_, 0, millis.count() + 1, nullptr);
+    }
+    return;
+  }
+
   if (when == std::chrono::nanoseconds::max()) {
-    KillTimer(window_handle_, 0);
-  } else {
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(when);
-    ::SetTimer(window_handle_, 0, millis.count() + 1, nullptr);
+    CancelWaitableTimer(timer_);
+    return;
   }
+  if (when <= std::chrono::nanoseconds::zero()) {
+    CancelWaitableTimer(timer_);
+    WakeUp();
+    return;
+  }
+
+  // Negative due times are relative, in 100ns intervals.
+  LARGE_INTEGER due_time;
+  due_time.QuadPart = -std::max<LONGLONG>(when.count() / 100, 1);
+  if (!SetWaitableTimer(timer_, &due_time, 0, nullptr, nullptr, FALSE)) {
+    FML_LOG(ERROR) << "Failed to set waitable timer.";
+    return;
+  }
+  // Thread pool waits fire once, so the wait is armed again for every new
+  // deadline.
+  SetThreadpoolWait(timer_wait_, timer_, nullptr);
+}
+
+void CALLBACK TaskRunnerWindow::OnTimerSignaled(PTP_CALLBACK_INSTANCE instance,
+                                                PVOID context,
+                                                PTP_WAIT wait,
+                                                TP_WAIT_RESULT wait_result) {
+  // Tasks still run on the main thread. The message wakes it up even while
+  // the host application's message loop is blocked in GetMessage.
+  static_cast<TaskRunnerWindow*>(context)->WakeUp();
 }
 
 WNDCLASS TaskRunnerWindow::RegisterWindowClass() {
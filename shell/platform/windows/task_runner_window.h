@@ -41,8 +41,16 @@ class TaskRunnerWindow {
 
   void ProcessTasks();
 
+  // Schedules a call to `ProcessTasks()` after |when|, replacing the previous
+  // schedule.
   void SetTimer(std::chrono::nanoseconds when);
 
+  // Called on a thread pool thread when |timer_| is signaled.
+  static void CALLBACK OnTimerSignaled(PTP_CALLBACK_INSTANCE instance,
+                                       PVOID context,
+                                       PTP_WAIT wait,
+                                       TP_WAIT_RESULT wait_result);
+
   WNDCLASS RegisterWindowClass();
 
   LRESULT
@@ -58,6 +66,13 @@ class TaskRunnerWindow {
   HWND window_handle_;
   std::wstring window_class_name_;
   std::vector<Delegate*> delegates_;
+
+  // High resolution waitable timer for the next task deadline, or nullptr if
+  // unavailable, in which case a window timer is used instead.
+  HANDLE timer_ = nullptr;
+
+  // Thread pool wait that wakes up the window when |timer_| is signaled.
+  PTP_WAIT timer_wait_ = nullptr;
 };
 }  // namespace flutter
 
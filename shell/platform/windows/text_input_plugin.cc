@@ -65,18 +65,19 @@ void TextInputPlugin::TextHook(const std::u16string& text) {
   if (active_model_ == nullptr) {
     return;
   }
+  if (!enable_delta_model) {
+    active_model_->AddText(text);
+    SendStateUpdate(*active_model_);
+    return;
+  }
+  // Only deltas carry the text before the change, so only copy it for them.
   std::u16string text_before_change =
       fml::Utf8ToUtf16(active_model_->GetText());
   TextRange selection_before_change = active_model_->selection();
   active_model_->AddText(text);
-
-  if (enable_delta_model) {
-    TextEditingDelta delta =
-        TextEditingDelta(text_before_change, selection_before_change, text);
-    SendStateUpdateWithDelta(*active_model_, &delta);
-  } else {
-    SendStateUpdate(*active_model_);
-  }
+  TextEditingDelta delta =
+      TextEditingDelta(text_before_change, selection_before_change, text);
+  SendStateUpdateWithDelta(*active_model_, &delta);
 }
 
 void TextInputPlugin::KeyboardHook(int key,
@@ -126,7 +127,6 @@ void TextInputPlugin::ComposeBeginHook() {
   active_model_->BeginComposing();
   if (enable_delta_model) {
     std::string text = active_model_->GetText();
-    TextRange selection = active_model_->selection();
     TextEditingDelta delta = TextEditingDelta(text);
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
@@ -138,11 +138,6 @@ void TextInputPlugin::ComposeCommitHook() {
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange selection_before_change = active_model_->selection();
-  TextRange composing_before_change = active_model_->composing_range();
-  std::string composing_text_before_change = text_before_change.substr(
-      composing_before_change.start(), composing_before_change.length());
   active_model_->CommitComposing();
 
   // We do not trigger SendStateUpdate here.
@@ -173,8 +168,6 @@ void TextInputPlugin::ComposeEndHook() {
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
-  TextRange selection_before_change = active_model_->selection();
   active_model_->CommitComposing();
   active_model_->EndComposing();
   if (enable_delta_model) {
@@ -191,16 +184,18 @@ void TextInputPlugin::ComposeChangeHook(const std::u16string& text,
   if (active_model_ == nullptr) {
     return;
   }
-  std::string text_before_change = active_model_->GetText();
+  std::u16string text_before_change;
+  if (enable_delta_model) {
+    text_before_change = fml::Utf8ToUtf16(active_model_->GetText());
+  }
   TextRange composing_before_change = active_model_->composing_range();
   active_model_->AddText(text);
   cursor_pos += active_model_->composing_range().extent();
   active_model_->UpdateComposingText(text);
   active_model_->SetSelection(TextRange(cursor_pos, cursor_pos));
-  std::string text_after_change = active_model_->GetText();
   if (enable_delta_model) {
-    TextEditingDelta delta = TextEditingDelta(
-        fml::Utf8ToUtf16(text_before_change), composing_before_change, text);
+    TextEditingDelta delta =
+        TextEditingDelta(text_before_change, composing_before_change, text);
     SendStateUpdateWithDelta(*active_model_, &delta);
   } else {
     SendStateUpdate(*active_model_);
@@ -447,7 +442,10 @@ void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
 
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
-    std::u16string text_before_change = fml::Utf8ToUtf16(model->GetText());
+    std::u16string text_before_change;
+    if (enable_delta_model) {
+      text_before_change = fml::Utf8ToUtf16(model->GetText());
+    }
     TextRange selection_before_change = model->selection();
     model->AddText(u"\n");
     if (enable_delta_model) {
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vsync_waiter.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+VsyncWaiter::VsyncWaiter(VsyncCallback callback)
+    : callback_(std::move(callback)) {}
+
+VsyncWaiter::~VsyncWaiter() {
+  Stop();
+}
+
+void VsyncWaiter::SetWindow(HWND window) {
+  window_ = window;
+}
+
+bool VsyncWaiter::AwaitVsync(intptr_t baton) {
+  if (!window_) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return false;
+    }
+    // The thread is only started once vsyncs are needed, so that engines
+    // that never draw don't own an idle thread.
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this]() { ThreadMain(); });
+    }
+    FML_DCHECK(!pending_baton_.has_value());
+    pending_baton_ = baton;
+  }
+  cv_.notify_one();
+  return true;
+}
+
+void VsyncWaiter::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    pending_baton_.reset();
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void VsyncWaiter::ThreadMain() {
+  while (true) {
+    intptr_t baton;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock,
+               [this]() { return stopped_ || pending_baton_.has_value(); });
+      if (stopped_) {
+        return;
+      }
+      baton = pending_baton_.value();
+      pending_baton_.reset();
+    }
+
+    HMONITOR monitor = MonitorFromWindow(window_, MONITOR_DEFAULTTONEAREST);
+    if (monitor != monitor_) {
+      UpdateOutput(monitor);
+    }
+
+    if (!output_ || FAILED(output_->WaitForVBlank())) {
+      // The output stays unusable until the window moves to another monitor,
+      // for example while it is shown through a remote desktop session.
+      output_.Reset();
+      callback_(baton, false, refresh_interval_);
+      continue;
+    }
+    callback_(baton, true, refresh_interval_);
+  }
+}
+
+void VsyncWaiter::UpdateOutput(HMONITOR monitor) {
+  monitor_ = monitor;
+  output_.Reset();
+  refresh_interval_ = std::chrono::nanoseconds::zero();
+
+  // Outputs are enumerated from a new factory, as adapters and outputs of an
+  // existing factory don't reflect display changes.
+  Microsoft::WRL::ComPtr<IDXGIFactory1> factory;
+  if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) {
+    FML_LOG(ERROR) << "Failed to create a DXGI factory.";
+    return;
+  }
+
+  Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+  for (UINT i = 0; !output_ && factory->EnumAdapters1(i, &adapter) == S_OK;
+       ++i) {
+    Microsoft::WRL::ComPtr<IDXGIOutput> output;
+    for (UINT j = 0; adapter->EnumOutputs(j, &output) == S_OK; ++j) {
+      DXGI_OUTPUT_DESC desc;
+      if (SUCCEEDED(output->GetDesc(&desc)) && desc.Monitor == monitor) {
+        output_ = output;
+        break;
+      }
+    }
+  }
+  if (!output_) {
+    return;
+  }
+
+  MONITORINFOEXW monitor_info = {};
+  monitor_info.cbSize = sizeof(monitor_info);
+  DEVMODEW mode = {};
+  mode.dmSize = sizeof(mode);
+  // Frequencies of 0 and 1 stand for the hardware's default rate.
+  if (GetMonitorInfoW(monitor, &monitor_info) &&
+      EnumDisplaySettingsW(monitor_info.szDevice, ENUM_CURRENT_SETTINGS,
+                           &mode) &&
+      mode.dmDisplayFrequency > 1) {
+    refresh_interval_ =
+        std::chrono::nanoseconds(1000000000 / mode.dmDisplayFrequency);
+  }
+}
+
+}  // namespace flutter
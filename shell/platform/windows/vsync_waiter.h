@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_H_
+
+#include <dxgi.h>
+#include <windows.h>
+#include <wrl/client.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace flutter {
+
+// Waits for the vertical blanks of the monitor showing a window.
+//
+// DXGI only offers a blocking wait for the vblank of an output, so requests
+// are served by a dedicated thread. The output is looked up again whenever
+// the window moves to another monitor, so frames follow the refresh rate of
+// the monitor the window is on.
+class VsyncWaiter {
+ public:
+  // Called on the waiter's thread with the baton of a request.
+  // |vblank_reached| is false if no vblank could be waited for, in which case
+  // the frame has to be timed by other means. |refresh_interval| is the
+  // refresh interval of the monitor, or zero if it is unknown.
+  using VsyncCallback =
+      std::function<void(intptr_t baton,
+                         bool vblank_reached,
+                         std::chrono::nanoseconds refresh_interval)>;
+
+  explicit VsyncWaiter(VsyncCallback callback);
+
+  // Stops the thread, dropping any pending request.
+  ~VsyncWaiter();
+
+  // Sets the window whose monitor's vblanks are waited for.
+  //
+  // Can be called from any thread.
+  void SetWindow(HWND window);
+
+  // Requests |callback| to be called with |baton| at the next vblank.
+  //
+  // Returns false if there is no window or the waiter was stopped, in which
+  // case the callback won't be called.
+  //
+  // Can be called from any thread.
+  bool AwaitVsync(intptr_t baton);
+
+  // Stops the thread, dropping any pending request. Later calls to
+  // `AwaitVsync` fail.
+  void Stop();
+
+ private:
+  // The body of |thread_|.
+  void ThreadMain();
+
+  // Finds the DXGI output of |monitor| and its refresh interval.
+  void UpdateOutput(HMONITOR monitor);
+
+  VsyncCallback callback_;
+
+  std::atomic<HWND> window_ = nullptr;
+
+  // Guards the members below.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::optional<intptr_t> pending_baton_;
+  bool stopped_ = false;
+  std::thread thread_;
+
+  // Only used on |thread_|.
+  HMONITOR monitor_ = nullptr;
+  Microsoft::WRL::ComPtr<IDXGIOutput> output_;
+  std::chrono::nanoseconds refresh_interval_ =
+      std::chrono::nanoseconds::zero();
+
+  VsyncWaiter(const VsyncWaiter&) = delete;
+  VsyncWaiter& operator=(const VsyncWaiter&) = delete;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_VSYNC_WAITER_H_
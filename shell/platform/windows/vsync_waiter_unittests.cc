@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vsync_waiter.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(VsyncWaiterTest, FailsWithoutWindow) {
+  bool called = false;
+  VsyncWaiter waiter(
+      [&called](intptr_t baton, bool vblank_reached,
+                std::chrono::nanoseconds refresh_interval) { called = true; });
+
+  EXPECT_FALSE(waiter.AwaitVsync(1));
+  waiter.Stop();
+  EXPECT_FALSE(called);
+}
+
+TEST(VsyncWaiterTest, FailsAfterStop) {
+  bool called = false;
+  VsyncWaiter waiter(
+      [&called](intptr_t baton, bool vblank_reached,
+                std::chrono::nanoseconds refresh_interval) { called = true; });
+  waiter.SetWindow(GetDesktopWindow());
+
+  waiter.Stop();
+  EXPECT_FALSE(waiter.AwaitVsync(1));
+  EXPECT_FALSE(called);
+}
+
+TEST(VsyncWaiterTest, ReportsVsyncForWindow) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::optional<intptr_t> reported_baton;
+  VsyncWaiter waiter([&](intptr_t baton, bool vblank_reached,
+                         std::chrono::nanoseconds refresh_interval) {
+    // Whether a vblank is reached depends on the machine running the test,
+    // but every request must be answered.
+    std::lock_guard<std::mutex> lock(mutex);
+    reported_baton = baton;
+    cv.notify_one();
+  });
+  waiter.SetWindow(GetDesktopWindow());
+
+  ASSERT_TRUE(waiter.AwaitVsync(42));
+  std::unique_lock<std::mutex> lock(mutex);
+  cv.wait(lock, [&]() { return reported_baton.has_value(); });
+  EXPECT_EQ(reported_baton.value(), 42);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -1096,6 +1096,49 @@ void main() {
     canvas.restoreToCount(canvas.getSaveCount() + 1);
     expect(canvas.getSaveCount(), equals(6));
   });
+
+  test('Batched draws use the paint and transform current at each draw', () async {
+    final Image image = await toImage((Canvas canvas) {
+      final Paint paint = Paint()..color = const Color(0xFFFF0000);
+      // More draws than fit in one batch.
+      for (int i = 0; i < 200; i++) {
+        canvas.drawRect(const Rect.fromLTWH(0, 0, 1, 1), paint);
+      }
+      paint.color = const Color(0xFF00FF00);
+      canvas.drawRect(const Rect.fromLTWH(1, 0, 1, 1), paint);
+      canvas.translate(2, 0);
+      paint.color = const Color(0xFF0000FF);
+      canvas.drawRect(const Rect.fromLTWH(0, 0, 1, 1), paint);
+      paint.colorFilter = const ColorFilter.mode(Color(0xFFFFFF00), BlendMode.src);
+      canvas.drawRect(const Rect.fromLTWH(1, 0, 1, 1), paint);
+    }, 4, 1);
+
+    final ByteData? data = await image.toByteData();
+    expect(data, isNotNull);
+    expect(data!.getUint32(0), 0xFF0000FF);
+    expect(data.getUint32(4), 0x00FF00FF);
+    expect(data.getUint32(8), 0x0000FFFF);
+    expect(data.getUint32(12), 0xFFFF00FF);
+  });
+
+  test('Draws with an unchanged paint apply the attributes each draw uses', () async {
+    final Image dot = await createImage(1, 1);
+    final Image image = await toImage((Canvas canvas) {
+      final Paint paint = Paint()
+        ..color = const Color(0xFFFF0000)
+        ..style = PaintingStyle.stroke
+        ..strokeWidth = 2;
+      // Drawing an image synchronizes the paint without its style.
+      canvas.drawImage(dot, Offset.zero, paint);
+      canvas.drawRect(const Rect.fromLTRB(5, 5, 15, 15), paint);
+    }, 20, 20);
+
+    final ByteData? data = await image.toByteData();
+    expect(data, isNotNull);
+    int getPixel(int x, int y) => data!.getUint32((x + y * 20) * 4);
+    expect(getPixel(5, 10), 0xFF0000FF);
+    expect(getPixel(10, 10), 0x00000000);
+  });
 }
 
 Matcher listEquals(ByteData expected) => (dynamic v) {
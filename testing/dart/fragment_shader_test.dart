@@ -195,6 +195,24 @@ void main() async {
     shader.dispose();
   });
 
+  test('Reused FragmentShader renders uniforms that were set back', () async {
+    final FragmentProgram program = await FragmentProgram.fromAsset(
+      'functions.frag.iplr',
+    );
+    final FragmentShader shader = program.fragmentShader()
+      ..setFloat(0, 1.0);
+    await _expectShaderRendersGreen(shader);
+    await _expectShaderRendersGreen(shader);
+
+    shader.setFloat(0, 0.0);
+    await _expectShaderRendersBlack(shader);
+
+    shader.setFloat(0, 1.0);
+    await _expectShaderRendersGreen(shader);
+
+    shader.dispose();
+  });
+
   test('FragmentShader blue-green image renders green', () async {
     final FragmentProgram program = await FragmentProgram.fromAsset(
       'blue_green_sampler.frag.iplr',
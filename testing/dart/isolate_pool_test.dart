@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:isolate';
+import 'dart:ui';
+
+import 'package:litetest/litetest.dart';
+
+void main() {
+  test('IsolatePool runs computations in background isolates', () async {
+    final IsolatePool pool = IsolatePool();
+    final int mainIsolate = Isolate.current.hashCode;
+    final List<int> results = await Future.wait(<Future<int>>[
+      for (int i = 0; i < 10; i += 1)
+        pool.run(() => i * i),
+    ]);
+    expect(results, <int>[0, 1, 4, 9, 16, 25, 36, 49, 64, 81]);
+    expect(await pool.run(() => Isolate.current.hashCode), notEquals(mainIsolate));
+    expect(await pool.run(() async {
+      await Future<void>.delayed(const Duration(milliseconds: 1));
+      return 'done';
+    }), 'done');
+
+    // The isolates are reused.
+    expect(pool.spawnCount, 2);
+    expect(pool.totalSpawnLatency, notEquals(Duration.zero));
+    pool.close();
+  });
+
+  test('IsolatePool rethrows the errors of computations', () async {
+    final IsolatePool pool = IsolatePool(size: 1);
+    try {
+      await pool.run<void>(() => throw StateError('failed'));
+      throw 'IsolatePool.run did not throw the expected error.';
+    } on StateError catch (e) {
+      expect(e.message, 'failed');
+    }
+
+    // A computation that captures values that can't be sent fails, but the
+    // isolate can still be used.
+    final RawReceivePort port = RawReceivePort();
+    try {
+      await pool.run(() => port.hashCode);
+      throw 'IsolatePool.run did not throw the expected error.';
+    } on ArgumentError {
+      // Expected.
+    }
+    port.close();
+    expect(await pool.run(() => 42), 42);
+    expect(pool.spawnCount, 1);
+    pool.close();
+  });
+
+  test('IsolatePool shuts down idle isolates', () async {
+    final IsolatePool pool = IsolatePool(
+      size: 1,
+      idleTimeout: const Duration(milliseconds: 10),
+      prewarm: false,
+    );
+    expect(pool.spawnCount, 0);
+    expect(await pool.run(() => 1), 1);
+    expect(pool.spawnCount, 1);
+
+    await Future<void>.delayed(const Duration(milliseconds: 100));
+    expect(await pool.run(() => 2), 2);
+    expect(pool.spawnCount, 2);
+    pool.close();
+  });
+
+  test('IsolatePool fails pending computations when it is closed', () async {
+    final IsolatePool pool = IsolatePool(size: 1);
+    // Waits for the isolate to be ready.
+    expect(await pool.run(() => 0), 0);
+    final Future<int> running = pool.run(() async {
+      await Future<void>.delayed(const Duration(milliseconds: 10));
+      return 1;
+    });
+    final Future<int> pending = pool.run(() => 2);
+    pool.close();
+
+    expect(await running, 1);
+    try {
+      await pending;
+      throw 'The pending computation did not fail.';
+    } on StateError {
+      // Expected.
+    }
+    try {
+      pool.run(() => 3);
+      throw 'IsolatePool.run did not throw the expected error.';
+    } on StateError {
+      // Expected.
+    }
+  });
+}
@@ -31,4 +31,36 @@ void main() {
     final List<dynamic> isolateError = await errorPort.first as List<dynamic>;
     expect(isolateError[0], 'UI actions are only available on root isolate.');
   });
+
+  test('Pictures recorded in a background isolate can be transferred', () async {
+    void recordPicture(SendPort sendPort) {
+      final PictureRecorder recorder = PictureRecorder();
+      final Canvas canvas = Canvas(recorder);
+      final Path path = Path()
+        ..moveTo(0, 0)
+        ..lineTo(10, 10)
+        ..close();
+      canvas.drawPath(path, Paint()..color = const Color(0xFF00FF00));
+      canvas.drawRect(const Rect.fromLTWH(0, 0, 10, 10), Paint());
+      sendPort.send(TransferablePicture(recorder.endRecording()));
+    }
+    final ReceivePort receivePort = ReceivePort();
+    await Isolate.spawn<SendPort>(recordPicture, receivePort.sendPort);
+    final TransferablePicture transferable = await receivePort.first as TransferablePicture;
+
+    final Picture picture = transferable.materialize();
+    expect(picture.approximateBytesUsed, isNonZero);
+    final Image image = await picture.toImage(10, 10);
+    expect(image.width, 10);
+    image.dispose();
+    picture.dispose();
+
+    bool threw = false;
+    try {
+      transferable.materialize();
+    } on StateError {
+      threw = true;
+    }
+    expect(threw, true);
+  });
 }
@@ -60,4 +60,58 @@ void main() {
       indices: Uint16List.fromList(const <int>[0, 2, 1, 2, 0, 1, 2, 0]),
     ).dispose();
   });
+
+  test('Vertices.updateRaw checks', () {
+    final Vertices vertices = Vertices.raw(
+      VertexMode.triangles,
+      Float32List.fromList(const <double>[0.0, 0.0, 0.0, 0.0, 0.0, 0.0]),
+    );
+    try {
+      vertices.updateRaw(positions: Float32List.fromList(const <double>[0.0, 0.0]));
+      throw 'Vertices.updateRaw did not throw the expected error.';
+    } on ArgumentError catch (e) {
+      expect('$e', 'Invalid argument(s): "positions", "colors" and "textureCoordinates" must match the lists these vertices were created with.');
+    }
+    try {
+      vertices.updateRaw(colors: Int32List(3));
+      throw 'Vertices.updateRaw did not throw the expected error.';
+    } on ArgumentError catch (e) {
+      expect('$e', 'Invalid argument(s): "positions", "colors" and "textureCoordinates" must match the lists these vertices were created with.');
+    }
+    vertices.updateRaw( // This one does not throw.
+      positions: Float32List.fromList(const <double>[1.0, 1.0, 2.0, 2.0, 3.0, 1.0]),
+    );
+    vertices.dispose();
+  });
+
+  test('Vertices.updateRaw does not affect recorded pictures', () async {
+    final Vertices vertices = Vertices.raw(
+      VertexMode.triangles,
+      Float32List.fromList(const <double>[0.0, 0.0, 10.0, 0.0, 0.0, 10.0]),
+      colors: Int32List.fromList(const <int>[0xFFFF0000, 0xFFFF0000, 0xFFFF0000]),
+    );
+    final PictureRecorder recorder = PictureRecorder();
+    Canvas(recorder).drawVertices(vertices, BlendMode.srcOver, Paint());
+    final Picture picture = recorder.endRecording();
+
+    vertices.updateRaw(
+      positions: Float32List.fromList(const <double>[10.0, 10.0, 20.0, 10.0, 10.0, 20.0]),
+      colors: Int32List.fromList(const <int>[0xFF0000FF, 0xFF0000FF, 0xFF0000FF]),
+    );
+    final PictureRecorder updatedRecorder = PictureRecorder();
+    Canvas(updatedRecorder).drawVertices(vertices, BlendMode.srcOver, Paint());
+    final Picture updatedPicture = updatedRecorder.endRecording();
+    vertices.dispose();
+
+    Future<int> pixelAt(Picture picture, int x, int y) async {
+      final Image image = await picture.toImage(20, 20);
+      final ByteData data = (await image.toByteData())!;
+      image.dispose();
+      picture.dispose();
+      return data.getUint32((x + y * 20) * 4);
+    }
+
+    expect(await pixelAt(picture, 2, 2), isNonZero);
+    expect(await pixelAt(updatedPicture, 2, 2), 0);
+  });
 }
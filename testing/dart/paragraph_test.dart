@@ -198,6 +198,28 @@ void main() {
     expect(line.end, 10);
   });
 
+  test('layoutAsync lays out the paragraph like layout', () async {
+    Paragraph buildParagraph() {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'Ahem',
+        fontSize: 10.0,
+      ));
+      builder.addText('Test Ahem');
+      return builder.build();
+    }
+
+    const ParagraphConstraints constraints = ParagraphConstraints(width: 50.0);
+    final Paragraph expected = buildParagraph()..layout(constraints);
+    final Paragraph paragraph = buildParagraph();
+    await paragraph.layoutAsync(constraints);
+
+    expect(paragraph.height, closeTo(expected.height, 0.001));
+    expect(paragraph.width, closeTo(expected.width, 0.001));
+    expect(paragraph.longestLine, closeTo(expected.longestLine, 0.001));
+    expect(paragraph.computeLineMetrics().length, 2);
+    expect(paragraph.didExceedMaxLines, expected.didExceedMaxLines);
+  });
+
   test('painting a disposed paragraph does not crash', () {
     final Paragraph paragraph = ParagraphBuilder(ParagraphStyle()).build();
     paragraph.dispose();
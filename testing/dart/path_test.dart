@@ -2,7 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-import 'dart:typed_data' show Float64List;
+import 'dart:typed_data' show Float32List, Float64List;
 import 'dart:ui';
 
 import 'package:litetest/litetest.dart';
@@ -41,6 +41,39 @@ void main() {
     expect(xor.getBounds(), equals(c1UnionC2));
   });
 
+  test('path combineAsync rect', () async {
+    final Rect c1 = Rect.fromCircle(center: const Offset(10.0, 10.0), radius: 10.0);
+    final Rect c2 = Rect.fromCircle(center: const Offset(5.0, 5.0), radius: 10.0);
+    final Path pathCircle1 = Path()..addRect(c1);
+    final Path pathCircle2 = Path()..addRect(c2);
+
+    final Future<Path> intersect = Path.combineAsync(PathOperation.intersect, pathCircle1, pathCircle2);
+    // The paths that are being combined can be modified.
+    pathCircle1.reset();
+    expect((await intersect).getBounds(), equals(c1.intersect(c2)));
+
+    final Path union = await Path.combineAsync(PathOperation.union, pathCircle2, Path()..addRect(c1));
+    expect(union.getBounds(), equals(c1.expandToInclude(c2)));
+  });
+
+  test('path unionAll', () async {
+    final List<Rect> rects = <Rect>[
+      for (int i = 0; i < 10; i++) Rect.fromLTWH(i * 5.0, i * 3.0, 10.0, 10.0),
+    ];
+    final List<Path> paths = <Path>[for (final Rect rect in rects) Path()..addRect(rect)];
+    final Rect bounds = rects.reduce((Rect a, Rect b) => a.expandToInclude(b));
+
+    final Path union = Path.unionAll(paths);
+    expect(union.getBounds(), equals(bounds));
+    expect(union.contains(const Offset(1.0, 1.0)), isTrue);
+    expect(union.contains(const Offset(1.0, 30.0)), isFalse);
+
+    final Path asyncUnion = await Path.unionAllAsync(paths);
+    expect(asyncUnion.getBounds(), equals(bounds));
+
+    expect(Path.unionAll(<Path>[]).getBounds(), equals(Rect.zero));
+  });
+
   test('path combine oval', () {
     final Rect c1 = Rect.fromCircle(center: const Offset(10.0, 10.0), radius: 10.0);
     final Rect c2 = Rect.fromCircle(center: const Offset(5.0, 5.0), radius: 10.0);
@@ -240,4 +273,47 @@ void main() {
        'PathMetric(length: 120.0, isClosed: true, contourIndex: 1))',
     );
   });
+
+  test('PathMetrics of the same path can be iterated over together', () {
+    final Path path = Path()
+      ..lineTo(0, 10)
+      ..moveTo(0, 20)
+      ..lineTo(20, 20)
+      ..moveTo(0, 30)
+      ..lineTo(30, 30);
+    final Iterator<PathMetric> first = path.computeMetrics().iterator;
+    expect(first.moveNext(), true);
+    expect(first.current.length, 10);
+
+    final List<PathMetric> second = path.computeMetrics().toList();
+    expect(second.map((PathMetric metric) => metric.length).toList(), <double>[10, 20, 30]);
+
+    expect(first.moveNext(), true);
+    expect(first.current.length, 20);
+    expect(first.current.contourIndex, 1);
+    expect(first.moveNext(), true);
+    expect(first.current.length, 30);
+    expect(first.moveNext(), false);
+
+    path.lineTo(30, 70);
+    expect(path.computeMetrics().last.length, 70);
+    expect(second.last.length, 30);
+  });
+
+  test('PathMetric.extractPathSegments', () {
+    final Path path = Path()..lineTo(100, 0);
+    final PathMetric metric = path.computeMetrics().first;
+    final Path dashes = metric.extractPathSegments(Float32List.fromList(<double>[0, 10, 20, 30, 40, 55]));
+    final List<PathMetric> dashMetrics = dashes.computeMetrics().toList();
+    expect(dashMetrics.map((PathMetric metric) => metric.length).toList(), <double>[10, 10, 15]);
+    expect(dashMetrics[1].getTangentForOffset(0)!.position, const Offset(20, 0));
+
+    expect(metric.extractPathSegments(Float32List(0)).computeMetrics(), isEmpty);
+    try {
+      metric.extractPathSegments(Float32List.fromList(<double>[0, 10, 20]));
+      throw 'PathMetric.extractPathSegments did not throw the expected error.';
+    } on ArgumentError catch (e) {
+      expect('$e', 'Invalid argument(s): "intervals" must have an even number of entries (each segment is a start, end pair).');
+    }
+  });
 }
@@ -210,6 +210,25 @@ void testLoadFontFromList() {
     expect(actualName, 'flutter/system');
     expect(message, '{"type":"fontsChange"}');
   });
+
+  test('loadFontFromList with subset lays out text like the full font', () async {
+    final Uint8List fontData = await readFile('RobotoSlab-VariableFont_wght.ttf');
+    await loadFontFromList(fontData, fontFamily: 'RobotoSlabFull');
+    await loadFontFromList(fontData, fontFamily: 'RobotoSlabSubset', subset: true);
+
+    double layoutWidth(String fontFamily, String text) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle());
+      builder.pushStyle(TextStyle(fontFamily: fontFamily, fontSize: 20));
+      builder.addText(text);
+      final Paragraph paragraph = builder.build();
+      paragraph.layout(const ParagraphConstraints(width: double.infinity));
+      return paragraph.maxIntrinsicWidth;
+    }
+
+    expect(layoutWidth('RobotoSlabSubset', 'Hello'), layoutWidth('RobotoSlabFull', 'Hello'));
+    // The subset grows with the characters of later paragraphs.
+    expect(layoutWidth('RobotoSlabSubset', 'world!'), layoutWidth('RobotoSlabFull', 'world!'));
+  });
 }
 
 void testFontFeatureClass() {
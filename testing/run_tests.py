@@ -351,6 +351,7 @@ def run_cc_tests(build_dir, executable_filter, coverage, capture_core_dump):
     return (name, flags, extra_env)
 
   unittests = [
+      make_test('assets_unittests'),
       make_test('client_wrapper_glfw_unittests'),
       make_test('client_wrapper_unittests'),
       make_test('common_cpp_core_unittests'),
@@ -511,6 +512,12 @@ def run_engine_benchmarks(build_dir, executable_filter):
         build_dir, 'txt_benchmarks', executable_filter, icu_flags
     )
 
+  if is_mac():
+    run_engine_executable(
+        build_dir, 'accessibility_bridge_benchmarks', executable_filter,
+        icu_flags
+    )
+
 
 def gather_dart_test(
     build_dir,
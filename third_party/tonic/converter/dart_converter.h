@@ -248,6 +248,31 @@ struct DartConverter<double> : public DartConverterFloatingPoint<double> {
   static const char* GetDartRepresentation() { return kDartRepresentation; }
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Float pointers
+
+// Pointers to floats in native memory, which Dart reads and writes through a
+// `Pointer<Float>`. They are only passed in FFI calls, which can be leaf calls
+// as no handle is involved.
+template <typename T>
+using EnableIfFloat = typename std::enable_if<
+    std::is_same<typename std::remove_const<T>::type, float>::value>::type;
+
+template <typename T>
+struct DartConverter<T*, EnableIfFloat<T>> {
+  using NativeType = T*;
+  using FfiType = T*;
+  static constexpr const char* kFfiRepresentation = "Pointer<Float>";
+  static constexpr const char* kDartRepresentation = "Pointer<Float>";
+  static constexpr bool kAllowedInLeafCall = true;
+
+  static NativeType FromFfi(FfiType val) { return val; }
+  static FfiType ToFfi(NativeType val) { return val; }
+  static const char* GetFfiRepresentation() { return kFfiRepresentation; }
+  static const char* GetDartRepresentation() { return kDartRepresentation; }
+  static bool AllowedInLeafCall() { return kAllowedInLeafCall; }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Enum Classes
 
@@ -47,9 +47,10 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
 ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection)
-    : base_style_(style.GetTextStyle()) {
+    : font_collection_(std::move(font_collection)),
+      base_style_(style.GetTextStyle()) {
   builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection());
+      TxtToSkia(style), font_collection_->CreateSktFontCollection());
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
@@ -70,6 +71,7 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  text_length_ += text.length();
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -82,11 +84,13 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  // Placeholders are represented by an object replacement character.
+  text_length_++;
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
-  return std::make_unique<ParagraphSkia>(builder_->Build(),
-                                         std::move(dl_paints_));
+  return std::make_unique<ParagraphSkia>(
+      builder_->Build(), std::move(dl_paints_), font_collection_, text_length_);
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
@@ -45,7 +45,10 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   skia::textlayout::ParagraphStyle TxtToSkia(const ParagraphStyle& txt);
   skia::textlayout::TextStyle TxtToSkia(const TextStyle& txt);
 
+  std::shared_ptr<FontCollection> font_collection_;
   std::shared_ptr<skia::textlayout::ParagraphBuilder> builder_;
+  // The number of UTF-16 code units added to the paragraph.
+  size_t text_length_ = 0;
   TextStyle base_style_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
@@ -143,8 +143,13 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
 }  // anonymous namespace
 
 ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
-                             std::vector<flutter::DlPaint>&& dl_paints)
-    : paragraph_(std::move(paragraph)), dl_paints_(dl_paints) {}
+                             std::vector<flutter::DlPaint>&& dl_paints,
+                             std::shared_ptr<FontCollection> font_collection,
+                             size_t text_length)
+    : paragraph_(std::move(paragraph)),
+      dl_paints_(dl_paints),
+      font_collection_(std::move(font_collection)),
+      text_length_(text_length) {}
 
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
@@ -220,7 +225,11 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
-  paragraph_->layout(width);
+  if (font_collection_) {
+    font_collection_->LayoutParagraph(*paragraph_, width, text_length_);
+  } else {
+    paragraph_->layout(width);
+  }
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
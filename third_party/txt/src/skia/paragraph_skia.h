@@ -17,8 +17,10 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <memory>
 #include <optional>
 
+#include "txt/font_collection.h"
 #include "txt/paragraph.h"
 
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
@@ -28,8 +30,12 @@ namespace txt {
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // The paragraph, which has |text_length| UTF-16 code units, is laid out
+  // with |font_collection| if set.
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
-                std::vector<flutter::DlPaint>&& dl_paints);
+                std::vector<flutter::DlPaint>&& dl_paints,
+                std::shared_ptr<FontCollection> font_collection = nullptr,
+                size_t text_length = 0);
 
   virtual ~ParagraphSkia() = default;
 
@@ -73,6 +79,8 @@ class ParagraphSkia : public Paragraph {
 
   std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
+  std::shared_ptr<FontCollection> font_collection_;
+  size_t text_length_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
 };
@@ -17,6 +17,7 @@
 #include "font_collection.h"
 
 #include <algorithm>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -24,16 +25,25 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+static constexpr char kFontFallbackCacheFileName[] =
+    "io.flutter.font_fallback_cache";
+
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      font_fallback_cache_(std::make_shared<FontFallbackCache>()),
+      paragraph_cache_counters_(std::make_shared<ParagraphCacheCounters>()) {}
 
 FontCollection::~FontCollection() {
+  std::scoped_lock lock(layout_mutex_);
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
@@ -45,27 +55,38 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
+  std::scoped_lock lock(layout_mutex_);
   default_font_manager_ = GetDefaultFontManager(font_initialization_data);
+  font_fallback_cache_->ClearTypefaces();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   default_font_manager_ = font_manager;
+  font_fallback_cache_->ClearTypefaces();
   skt_collection_.reset();
+  ResetParagraphCacheBytes();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   asset_font_manager_ = font_manager;
   skt_collection_.reset();
+  ResetParagraphCacheBytes();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   dynamic_font_manager_ = font_manager;
   skt_collection_.reset();
+  ResetParagraphCacheBytes();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   test_font_manager_ = font_manager;
   skt_collection_.reset();
+  ResetParagraphCacheBytes();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -83,6 +104,7 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
 }
 
 void FontCollection::DisableFontFallback() {
+  std::scoped_lock lock(layout_mutex_);
   enable_font_fallback_ = false;
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
@@ -90,13 +112,44 @@ void FontCollection::DisableFontFallback() {
 }
 
 void FontCollection::ClearFontFamilyCache() {
+  std::scoped_lock lock(layout_mutex_);
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  font_fallback_cache_->ClearTypefaces();
+  ResetParagraphCacheBytes();
+}
+
+void FontCollection::SetFontFallbackCacheDirectory(fml::UniqueFD directory) {
+  font_fallback_cache_directory_ = std::move(directory);
+  if (!font_fallback_cache_directory_.is_valid()) {
+    return;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      font_fallback_cache_directory_, kFontFallbackCacheFileName);
+  if (mapping && mapping->GetSize() > 0) {
+    font_fallback_cache_->Load(
+        {reinterpret_cast<const char*>(mapping->GetMapping()),
+         mapping->GetSize()});
+  }
+}
+
+void FontCollection::SaveFontFallbackCache() {
+  if (!font_fallback_cache_directory_.is_valid() ||
+      !font_fallback_cache_->HasUnsavedFamilies()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "FontCollection::SaveFontFallbackCache");
+  fml::DataMapping mapping(font_fallback_cache_->Serialize());
+  if (!fml::WriteAtomically(font_fallback_cache_directory_,
+                            kFontFallbackCacheFileName, mapping)) {
+    FML_LOG(WARNING) << "Could not save the font fallback cache.";
+  }
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
+  std::scoped_lock lock(layout_mutex_);
   if (!skt_collection_) {
     skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
 
@@ -104,7 +157,12 @@ FontCollection::CreateSktFontCollection() {
     for (const std::string& family : GetDefaultFontFamilies()) {
       default_font_families.emplace_back(family);
     }
-    skt_collection_->setDefaultFontManager(default_font_manager_,
+    sk_sp<SkFontMgr> default_font_manager;
+    if (default_font_manager_) {
+      default_font_manager = sk_make_sp<FontFallbackCacheManager>(
+          default_font_manager_, font_fallback_cache_);
+    }
+    skt_collection_->setDefaultFontManager(default_font_manager,
                                            default_font_families);
     skt_collection_->setAssetFontManager(asset_font_manager_);
     skt_collection_->setDynamicFontManager(dynamic_font_manager_);
@@ -112,9 +170,81 @@ FontCollection::CreateSktFontCollection() {
     if (!enable_font_fallback_) {
       skt_collection_->disableFontFallback();
     }
+    skt_collection_->getParagraphCache()->setChecker(
+        [counters = paragraph_cache_counters_](auto*, const char* event,
+                                               bool) {
+          if (strcmp(event, "foundParagraph") == 0) {
+            counters->hit_count++;
+          } else if (strcmp(event, "missingParagraph") == 0) {
+            counters->miss_count++;
+          } else if (strcmp(event, "addedParagraph") == 0) {
+            counters->added_count++;
+          }
+        });
   }
 
   return skt_collection_;
 }
 
+void FontCollection::SetParagraphCacheBudget(size_t bytes) {
+  std::scoped_lock lock(paragraph_cache_mutex_);
+  paragraph_cache_budget_ = bytes;
+}
+
+FontCollection::ParagraphCacheStats FontCollection::GetParagraphCacheStats()
+    const {
+  std::scoped_lock lock(paragraph_cache_mutex_);
+  return {
+      .hit_count = paragraph_cache_counters_->hit_count,
+      .miss_count = paragraph_cache_counters_->miss_count,
+      .estimated_bytes = paragraph_cache_bytes_,
+  };
+}
+
+void FontCollection::LayoutParagraph(skia::textlayout::Paragraph& paragraph,
+                                     double width,
+                                     size_t text_length) {
+  std::scoped_lock lock(layout_mutex_);
+  paragraph.layout(width);
+  OnParagraphLaidOut(text_length);
+}
+
+void FontCollection::OnParagraphLaidOut(size_t text_length) {
+  bool purge = false;
+  {
+    std::scoped_lock lock(paragraph_cache_mutex_);
+    const size_t added_count = paragraph_cache_counters_->added_count;
+    if (added_count == paragraph_cache_accounted_count_) {
+      return;
+    }
+    paragraph_cache_bytes_ += (added_count - paragraph_cache_accounted_count_) *
+                              text_length *
+                              kEstimatedParagraphCacheBytesPerCodeUnit;
+    paragraph_cache_accounted_count_ = added_count;
+    purge = paragraph_cache_bytes_ > paragraph_cache_budget_;
+
+#if !FLUTTER_RELEASE
+    FML_TRACE_COUNTER("flutter", "ParagraphCache",
+                      reinterpret_cast<int64_t>(this),  //
+                      "Hits", paragraph_cache_counters_->hit_count.load(),
+                      "Misses", paragraph_cache_counters_->miss_count.load(),
+                      "KBytes", paragraph_cache_bytes_ / 1024);
+#endif  // !FLUTTER_RELEASE
+  }
+
+  // The cache locks itself, so it is purged without holding the lock of the
+  // statistics.
+  if (purge && skt_collection_) {
+    TRACE_EVENT0("flutter", "FontCollection::PurgeParagraphCache");
+    skt_collection_->getParagraphCache()->reset();
+    ResetParagraphCacheBytes();
+  }
+}
+
+void FontCollection::ResetParagraphCacheBytes() {
+  std::scoped_lock lock(paragraph_cache_mutex_);
+  paragraph_cache_accounted_count_ = paragraph_cache_counters_->added_count;
+  paragraph_cache_bytes_ = 0;
+}
+
 }  // namespace txt
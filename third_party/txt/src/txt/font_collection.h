@@ -17,21 +17,30 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"  // nogncheck
 #include "txt/asset_font_manager.h"
+#include "txt/font_fallback_cache.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
+// The fonts that paragraphs are laid out with.
+//
+// Paragraphs may be laid out on any thread with |LayoutParagraph|. The other
+// methods are called on the UI thread.
 class FontCollection : public std::enable_shared_from_this<FontCollection> {
  public:
   FontCollection();
@@ -53,21 +62,92 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Remove all entries in the font family cache.
   void ClearFontFamilyCache();
 
+  // Loads the fallback fonts found by previous runs from |directory|, in which
+  // |SaveFontFallbackCache| saves the fallback fonts found since then.
+  void SetFontFallbackCacheDirectory(fml::UniqueFD directory);
+
+  // Saves the fallback fonts found since the last call, if any.
+  void SaveFontFallbackCache();
+
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // The statistics of the cache in which the Skia text layout FontCollection
+  // keeps the shaping results of paragraphs. Paragraphs with the same text,
+  // text styles (which include the fonts, font features and locales) and
+  // paragraph style reuse these results, across frames.
+  struct ParagraphCacheStats {
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+    // An estimate of the memory held by the cached paragraphs.
+    size_t estimated_bytes = 0;
+  };
+
+  // The default of |SetParagraphCacheBudget|.
+  static constexpr size_t kDefaultParagraphCacheBudget = 4 * 1024 * 1024;
+
+  // Sets the estimated memory the paragraph cache may hold. The cache is
+  // purged once it holds more than |bytes|.
+  void SetParagraphCacheBudget(size_t bytes);
+
+  ParagraphCacheStats GetParagraphCacheStats() const;
+
+  // Lays out |paragraph|, which was built with this collection and has
+  // |text_length| UTF-16 code units, to fit in |width|.
+  //
+  // The Skia text layout FontCollection caches the fonts it matches and isn't
+  // thread safe, so layouts are serialized.
+  void LayoutParagraph(skia::textlayout::Paragraph& paragraph,
+                       double width,
+                       size_t text_length);
+
  private:
+  // An estimate of the memory held by the shaping results of a UTF-16 code
+  // unit, including its glyph, position, cluster and line breaking data.
+  static constexpr size_t kEstimatedParagraphCacheBytesPerCodeUnit = 64;
+
+  // Updated by the paragraph cache, which may outlive this collection.
+  struct ParagraphCacheCounters {
+    std::atomic<size_t> hit_count = 0;
+    std::atomic<size_t> miss_count = 0;
+    std::atomic<size_t> added_count = 0;
+  };
+
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
   bool enable_font_fallback_;
 
+  // Consulted by the default font manager before it searches the platform
+  // fonts for a fallback.
+  const std::shared_ptr<FontFallbackCache> font_fallback_cache_;
+  fml::UniqueFD font_fallback_cache_directory_;
+
+  // Held while |skt_collection_| is used or replaced.
+  std::mutex layout_mutex_;
+
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
 
+  const std::shared_ptr<ParagraphCacheCounters> paragraph_cache_counters_;
+  mutable std::mutex paragraph_cache_mutex_;
+  size_t paragraph_cache_budget_ = kDefaultParagraphCacheBudget;
+  // The number of paragraphs added to the cache that are accounted for in
+  // |paragraph_cache_bytes_|.
+  size_t paragraph_cache_accounted_count_ = 0;
+  size_t paragraph_cache_bytes_ = 0;
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
+  // Accounts for the memory of the shaping results of a paragraph of
+  // |text_length| UTF-16 code units that was just laid out, if they were added
+  // to the paragraph cache. |layout_mutex_| must be held.
+  void OnParagraphLaidOut(size_t text_length);
+
+  // Forgets the memory accounted to the paragraph cache once it was cleared.
+  void ResetParagraphCacheBytes();
+
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
 
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_fallback_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+namespace {
+
+// The first line of the serialized families. Each following line holds the
+// key of an entry, a range and a family, separated by tabs.
+constexpr std::string_view kSerializationHeader = "txt-font-fallback-cache-1";
+
+bool IsSerializable(std::string_view string) {
+  return string.find_first_of("\t\n") == std::string_view::npos;
+}
+
+bool Covers(const SkTypeface& typeface, SkUnichar character) {
+  return typeface.unicharToGlyph(character) != 0;
+}
+
+}  // namespace
+
+FontFallbackCache::FontFallbackCache() = default;
+
+FontFallbackCache::~FontFallbackCache() = default;
+
+std::string FontFallbackCache::GetKey(const char family_name[],
+                                      const SkFontStyle& style,
+                                      const char* bcp47[],
+                                      int bcp47_count) {
+  std::string key = family_name ? family_name : "";
+  key += "|" + std::to_string(style.weight()) + "|" +
+         std::to_string(style.width()) + "|" +
+         std::to_string(static_cast<int>(style.slant()));
+  for (int i = 0; i < bcp47_count; i++) {
+    key += "|";
+    key += bcp47[i];
+  }
+  return key;
+}
+
+sk_sp<SkTypeface> FontFallbackCache::MatchCharacter(
+    const SkFontMgr& font_manager,
+    const char family_name[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47_count,
+    SkUnichar character) {
+  std::scoped_lock lock(mutex_);
+  Entry& entry = entries_[GetKey(family_name, style, bcp47, bcp47_count)];
+  if (entry.missing_characters.count(character) != 0) {
+    return nullptr;
+  }
+
+  const SkUnichar range = character >> kRangeBits;
+  std::vector<sk_sp<SkTypeface>>& typefaces = entry.typefaces[range];
+  for (const sk_sp<SkTypeface>& typeface : typefaces) {
+    if (Covers(*typeface, character)) {
+      return typeface;
+    }
+  }
+
+  std::vector<std::string>& families = entry.families[range];
+  for (const std::string& family : families) {
+    sk_sp<SkTypeface> typeface(
+        font_manager.matchFamilyStyle(family.c_str(), style));
+    if (typeface && Covers(*typeface, character)) {
+      typefaces.push_back(typeface);
+      return typeface;
+    }
+  }
+
+  TRACE_EVENT0("flutter", "FontFallbackCache::MatchPlatformCharacter");
+  sk_sp<SkTypeface> typeface(font_manager.matchFamilyStyleCharacter(
+      family_name, style, bcp47, bcp47_count, character));
+  if (!typeface) {
+    if (entry.missing_characters.size() >= kMaxMissingCharacters) {
+      entry.missing_characters.clear();
+    }
+    entry.missing_characters.insert(character);
+    return nullptr;
+  }
+
+  typefaces.push_back(typeface);
+  SkString typeface_family;
+  typeface->getFamilyName(&typeface_family);
+  std::string family(typeface_family.c_str());
+  if (std::find(families.begin(), families.end(), family) == families.end()) {
+    families.push_back(std::move(family));
+    has_unsaved_families_ = true;
+  }
+  return typeface;
+}
+
+void FontFallbackCache::ClearTypefaces() {
+  std::scoped_lock lock(mutex_);
+  for (auto& [key, entry] : entries_) {
+    entry.typefaces.clear();
+    entry.missing_characters.clear();
+  }
+}
+
+bool FontFallbackCache::HasUnsavedFamilies() const {
+  std::scoped_lock lock(mutex_);
+  return has_unsaved_families_;
+}
+
+std::string FontFallbackCache::Serialize() {
+  std::scoped_lock lock(mutex_);
+  std::string data(kSerializationHeader);
+  data += "\n";
+  for (const auto& [key, entry] : entries_) {
+    if (!IsSerializable(key)) {
+      continue;
+    }
+    for (const auto& [range, families] : entry.families) {
+      for (const std::string& family : families) {
+        if (family.empty() || !IsSerializable(family)) {
+          continue;
+        }
+        data += key + "\t" + std::to_string(range) + "\t" + family + "\n";
+      }
+    }
+  }
+  has_unsaved_families_ = false;
+  return data;
+}
+
+void FontFallbackCache::Load(std::string_view data) {
+  std::scoped_lock lock(mutex_);
+  size_t line_end = data.find('\n');
+  if (line_end == std::string_view::npos ||
+      data.substr(0, line_end) != kSerializationHeader) {
+    return;
+  }
+
+  while (line_end + 1 < data.size()) {
+    const size_t line_start = line_end + 1;
+    line_end = data.find('\n', line_start);
+    if (line_end == std::string_view::npos) {
+      return;
+    }
+    std::string_view line = data.substr(line_start, line_end - line_start);
+    const size_t key_end = line.find('\t');
+    const size_t range_end = line.find('\t', key_end + 1);
+    if (key_end == std::string_view::npos ||
+        range_end == std::string_view::npos || range_end + 1 == line.size()) {
+      continue;
+    }
+
+    const std::string range_string(
+        line.substr(key_end + 1, range_end - key_end - 1));
+    char* range_string_end = nullptr;
+    const long range = std::strtol(range_string.c_str(), &range_string_end, 10);
+    if (range_string.empty() || *range_string_end != '\0' || range < 0) {
+      continue;
+    }
+
+    std::vector<std::string>& families =
+        entries_[std::string(line.substr(0, key_end))]
+            .families[static_cast<SkUnichar>(range)];
+    std::string family(line.substr(range_end + 1));
+    if (std::find(families.begin(), families.end(), family) ==
+        families.end()) {
+      families.push_back(std::move(family));
+    }
+  }
+}
+
+FontFallbackCacheManager::FontFallbackCacheManager(
+    sk_sp<SkFontMgr> font_manager,
+    std::shared_ptr<FontFallbackCache> cache)
+    : font_manager_(std::move(font_manager)), cache_(std::move(cache)) {
+  FML_DCHECK(font_manager_);
+  FML_DCHECK(cache_);
+}
+
+FontFallbackCacheManager::~FontFallbackCacheManager() = default;
+
+int FontFallbackCacheManager::onCountFamilies() const {
+  return font_manager_->countFamilies();
+}
+
+void FontFallbackCacheManager::onGetFamilyName(int index,
+                                               SkString* familyName) const {
+  font_manager_->getFamilyName(index, familyName);
+}
+
+SkFontStyleSet* FontFallbackCacheManager::onCreateStyleSet(int index) const {
+  return font_manager_->createStyleSet(index);
+}
+
+SkFontStyleSet* FontFallbackCacheManager::onMatchFamily(
+    const char familyName[]) const {
+  return font_manager_->matchFamily(familyName);
+}
+
+SkTypeface* FontFallbackCacheManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return font_manager_->matchFamilyStyle(familyName, style);
+}
+
+SkTypeface* FontFallbackCacheManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  return cache_
+      ->MatchCharacter(*font_manager_, familyName, style, bcp47, bcp47Count,
+                       character)
+      .release();
+}
+
+sk_sp<SkTypeface> FontFallbackCacheManager::onMakeFromData(sk_sp<SkData> data,
+                                                           int ttcIndex) const {
+  return font_manager_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FontFallbackCacheManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return font_manager_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FontFallbackCacheManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return font_manager_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FontFallbackCacheManager::onMakeFromFile(
+    const char path[],
+    int ttcIndex) const {
+  return font_manager_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FontFallbackCacheManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return font_manager_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
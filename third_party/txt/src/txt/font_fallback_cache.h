@@ -0,0 +1,166 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TXT_FONT_FALLBACK_CACHE_H_
+#define TXT_FONT_FALLBACK_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+// Remembers the typefaces that a platform font manager falls back to for the
+// characters that are missing from the requested fonts.
+//
+// Matching a fallback font is slow with some platform font managers, such as
+// the fontconfig and Android ones. Fallback fonts usually cover whole scripts,
+// so the typeface found for a character is reused for the other characters of
+// the same range of code points that it covers.
+//
+// The families of these typefaces can be serialized and loaded by later runs,
+// which then only match the family instead of searching all the fonts.
+class FontFallbackCache {
+ public:
+  FontFallbackCache();
+
+  ~FontFallbackCache();
+
+  // Returns the typeface that |font_manager| falls back to for |character|,
+  // or nullptr if no font covers it.
+  //
+  // The typefaces and families remembered for the range of |character| are
+  // only returned if they cover |character|. Otherwise |font_manager| is
+  // searched again, and the typeface it finds is added to the range.
+  sk_sp<SkTypeface> MatchCharacter(const SkFontMgr& font_manager,
+                                   const char family_name[],
+                                   const SkFontStyle& style,
+                                   const char* bcp47[],
+                                   int bcp47_count,
+                                   SkUnichar character);
+
+  // Forgets the typefaces, which belong to a font manager that is replaced,
+  // but keeps their families.
+  void ClearTypefaces();
+
+  // Whether fallback families were found since the last |Serialize|.
+  bool HasUnsavedFamilies() const;
+
+  std::string Serialize();
+
+  // Adds the families serialized by |Serialize|. Malformed data is ignored.
+  void Load(std::string_view data);
+
+ private:
+  // The number of low bits of the code points that aren't part of the range
+  // they belong to.
+  static constexpr int kRangeBits = 7;
+
+  // Bounds the memory used by characters without fallback.
+  static constexpr size_t kMaxMissingCharacters = 1024;
+
+  // The fallbacks of a font style and list of locales.
+  struct Entry {
+    // The typefaces found for the characters of each range.
+    std::unordered_map<SkUnichar, std::vector<sk_sp<SkTypeface>>> typefaces;
+    // The families of |typefaces|, including the ones loaded from a previous
+    // run.
+    std::unordered_map<SkUnichar, std::vector<std::string>> families;
+    std::unordered_set<SkUnichar> missing_characters;
+  };
+
+  static std::string GetKey(const char family_name[],
+                            const SkFontStyle& style,
+                            const char* bcp47[],
+                            int bcp47_count);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  bool has_unsaved_families_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FontFallbackCache);
+};
+
+// A font manager that matches fallback characters through a
+// |FontFallbackCache| and forwards everything else to |font_manager|.
+class FontFallbackCacheManager : public SkFontMgr {
+ public:
+  FontFallbackCacheManager(sk_sp<SkFontMgr> font_manager,
+                           std::shared_ptr<FontFallbackCache> cache);
+
+  ~FontFallbackCacheManager() override;
+
+ private:
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  SkFontStyleSet* onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  SkFontStyleSet* onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyle(const char familyName[],
+                                 const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                          const SkFontStyle&,
+                                          const char* bcp47[],
+                                          int bcp47Count,
+                                          SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  const sk_sp<SkFontMgr> font_manager_;
+  const std::shared_ptr<FontFallbackCache> cache_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FontFallbackCacheManager);
+};
+
+}  // namespace txt
+
+#endif  // TXT_FONT_FALLBACK_CACHE_H_
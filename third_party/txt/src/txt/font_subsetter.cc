@@ -0,0 +1,138 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_subsetter.h"
+
+#include <hb-subset.h>
+
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace txt {
+
+namespace {
+
+struct HbBlobDeleter {
+  void operator()(hb_blob_t* blob) { hb_blob_destroy(blob); }
+};
+
+struct HbFaceDeleter {
+  void operator()(hb_face_t* face) { hb_face_destroy(face); }
+};
+
+struct HbSubsetInputDeleter {
+  void operator()(hb_subset_input_t* input) { hb_subset_input_destroy(input); }
+};
+
+using HbBlobPtr = std::unique_ptr<hb_blob_t, HbBlobDeleter>;
+using HbFacePtr = std::unique_ptr<hb_face_t, HbFaceDeleter>;
+using HbSubsetInputPtr =
+    std::unique_ptr<hb_subset_input_t, HbSubsetInputDeleter>;
+
+bool IsLeadSurrogate(char16_t c) {
+  return (c & 0xFC00) == 0xD800;
+}
+
+bool IsTrailSurrogate(char16_t c) {
+  return (c & 0xFC00) == 0xDC00;
+}
+
+}  // namespace
+
+std::unique_ptr<FontSubsetter> FontSubsetter::Create(
+    std::unique_ptr<fml::Mapping> font_data) {
+  if (!font_data || font_data->GetSize() == 0) {
+    return nullptr;
+  }
+  // The blob does not copy the data, which is owned by the subsetter and
+  // outlives the face.
+  HbBlobPtr blob(hb_blob_create(
+      reinterpret_cast<const char*>(font_data->GetMapping()),
+      font_data->GetSize(), HB_MEMORY_MODE_READONLY, nullptr, nullptr));
+  HbFacePtr face(hb_face_create(blob.get(), 0));
+  if (!face || face.get() == hb_face_get_empty() ||
+      hb_face_get_glyph_count(face.get()) == 0) {
+    return nullptr;
+  }
+  return std::unique_ptr<FontSubsetter>(
+      new FontSubsetter(std::move(font_data), face.release()));
+}
+
+FontSubsetter::FontSubsetter(std::unique_ptr<fml::Mapping> font_data,
+                             hb_face_t* face)
+    : font_data_(std::move(font_data)),
+      face_(face),
+      font_codepoints_(hb_set_create()),
+      subset_codepoints_(hb_set_create()) {
+  hb_face_collect_unicodes(face_, font_codepoints_);
+}
+
+FontSubsetter::~FontSubsetter() {
+  hb_set_destroy(subset_codepoints_);
+  hb_set_destroy(font_codepoints_);
+  hb_face_destroy(face_);
+}
+
+bool FontSubsetter::AddCodepoints(const std::u16string& text) {
+  const size_t old_count = hb_set_get_population(subset_codepoints_);
+  for (size_t i = 0; i < text.size(); i++) {
+    hb_codepoint_t codepoint = text[i];
+    if (IsLeadSurrogate(text[i]) && i + 1 < text.size() &&
+        IsTrailSurrogate(text[i + 1])) {
+      codepoint = 0x10000 + ((text[i] - 0xD800) << 10) + (text[i + 1] - 0xDC00);
+      i++;
+    }
+    if (hb_set_has(font_codepoints_, codepoint)) {
+      hb_set_add(subset_codepoints_, codepoint);
+    }
+  }
+  return hb_set_get_population(subset_codepoints_) != old_count;
+}
+
+size_t FontSubsetter::GetCodepointCount() const {
+  return hb_set_get_population(subset_codepoints_);
+}
+
+sk_sp<SkTypeface> FontSubsetter::MakeTypeface() const {
+  HbSubsetInputPtr input(hb_subset_input_create_or_fail());
+  if (!input) {
+    return nullptr;
+  }
+  hb_set_union(hb_subset_input_unicode_set(input.get()), subset_codepoints_);
+  // Unlike the build time subsetting of icon fonts, the layout tables are
+  // kept, as the text may need shaping.
+  HbFacePtr subset_face(hb_subset_or_fail(face_, input.get()));
+  if (!subset_face || subset_face.get() == hb_face_get_empty()) {
+    FML_LOG(ERROR) << "Could not subset the font.";
+    return nullptr;
+  }
+  hb_blob_t* blob = hb_face_reference_blob(subset_face.get());
+  unsigned int length = 0;
+  const char* data = hb_blob_get_data(blob, &length);
+  if (length == 0) {
+    hb_blob_destroy(blob);
+    return nullptr;
+  }
+  sk_sp<SkData> sk_data = SkData::MakeWithProc(
+      data, length,
+      [](const void* ptr, void* context) {
+        hb_blob_destroy(static_cast<hb_blob_t*>(context));
+      },
+      blob);
+  return SkTypeface::MakeFromData(std::move(sk_data));
+}
+
+}  // namespace txt
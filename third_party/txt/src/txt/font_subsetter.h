@@ -0,0 +1,76 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TXT_FONT_SUBSETTER_H_
+#define TXT_FONT_SUBSETTER_H_
+
+#include <hb.h>
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/core/SkRefCnt.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+// Makes typefaces that only contain the glyphs of the code points used so far
+// from a font that is loaded at runtime.
+//
+// Fonts with many glyphs, such as CJK fonts, use megabytes of memory once they
+// are loaded as a typeface, although most apps only draw a small part of their
+// characters. The subset grows with the code points that are added, and a new
+// typeface has to be made each time it grows.
+//
+// The data of the source font is only read while a subset is made, so it can
+// be a mapped file that is mostly not resident.
+class FontSubsetter {
+ public:
+  // Returns nullptr if |font_data| does not contain a font.
+  static std::unique_ptr<FontSubsetter> Create(
+      std::unique_ptr<fml::Mapping> font_data);
+
+  ~FontSubsetter();
+
+  // Adds the code points of the UTF-16 |text| that the font has glyphs for to
+  // the subset. Returns whether any code points were added.
+  bool AddCodepoints(const std::u16string& text);
+
+  // The number of code points of the subset.
+  size_t GetCodepointCount() const;
+
+  // Makes a typeface with the glyphs of the current subset, or returns nullptr
+  // if the font could not be subset.
+  sk_sp<SkTypeface> MakeTypeface() const;
+
+ private:
+  FontSubsetter(std::unique_ptr<fml::Mapping> font_data, hb_face_t* face);
+
+  const std::unique_ptr<fml::Mapping> font_data_;
+  hb_face_t* const face_;
+  // The code points that the font has glyphs for.
+  hb_set_t* const font_codepoints_;
+  // The code points of the subset.
+  hb_set_t* const subset_codepoints_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FontSubsetter);
+};
+
+}  // namespace txt
+
+#endif  // TXT_FONT_SUBSETTER_H_
@@ -77,6 +77,18 @@ void TypefaceFontAssetProvider::RegisterTypeface(
   family_it->second->registerTypeface(std::move(typeface));
 }
 
+bool TypefaceFontAssetProvider::ReplaceTypeface(
+    const std::string& family_name,
+    const SkTypeface* old_typeface,
+    sk_sp<SkTypeface> new_typeface) {
+  auto family_it = registered_families_.find(CanonicalFamilyName(family_name));
+  if (family_it == registered_families_.end()) {
+    return false;
+  }
+  return family_it->second->replaceTypeface(old_typeface,
+                                            std::move(new_typeface));
+}
+
 TypefaceFontStyleSet::TypefaceFontStyleSet() = default;
 
 TypefaceFontStyleSet::~TypefaceFontStyleSet() = default;
@@ -88,6 +100,20 @@ void TypefaceFontStyleSet::registerTypeface(sk_sp<SkTypeface> typeface) {
   typefaces_.emplace_back(std::move(typeface));
 }
 
+bool TypefaceFontStyleSet::replaceTypeface(const SkTypeface* old_typeface,
+                                           sk_sp<SkTypeface> new_typeface) {
+  if (new_typeface == nullptr) {
+    return false;
+  }
+  for (sk_sp<SkTypeface>& typeface : typefaces_) {
+    if (typeface.get() == old_typeface) {
+      typeface = std::move(new_typeface);
+      return true;
+    }
+  }
+  return false;
+}
+
 int TypefaceFontStyleSet::count() {
   return typefaces_.size();
 }
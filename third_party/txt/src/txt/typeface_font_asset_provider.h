@@ -35,6 +35,11 @@ class TypefaceFontStyleSet : public SkFontStyleSet {
 
   void registerTypeface(sk_sp<SkTypeface> typeface);
 
+  // Replaces |old_typeface| with |new_typeface|. Returns false if
+  // |old_typeface| is not in the set.
+  bool replaceTypeface(const SkTypeface* old_typeface,
+                       sk_sp<SkTypeface> new_typeface);
+
   // |SkFontStyleSet|
   int count() override;
 
@@ -63,6 +68,13 @@ class TypefaceFontAssetProvider : public FontAssetProvider {
   void RegisterTypeface(sk_sp<SkTypeface> typeface,
                         std::string family_name_alias);
 
+  // Replaces |old_typeface| of the family |family_name| with |new_typeface|,
+  // for example with a larger subset of the same font. Returns false if the
+  // family does not have |old_typeface|.
+  bool ReplaceTypeface(const std::string& family_name,
+                       const SkTypeface* old_typeface,
+                       sk_sp<SkTypeface> new_typeface);
+
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_collection.h"
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "txt/asset_font_manager.h"
+#include "txt/paragraph_builder.h"
+#include "txt/typeface_font_asset_provider.h"
+
+namespace txt {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<FontCollection> CreateFontCollection() {
+  auto mapping = flutter::testing::OpenFixtureAsMapping("Roboto-Regular.ttf");
+  if (!mapping) {
+    return nullptr;
+  }
+  auto typeface = SkTypeface::MakeFromData(
+      SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize()));
+  if (!typeface) {
+    return nullptr;
+  }
+  auto provider = std::make_unique<TypefaceFontAssetProvider>();
+  provider->RegisterTypeface(std::move(typeface), "Roboto");
+  auto font_collection = std::make_shared<FontCollection>();
+  font_collection->SetAssetFontManager(
+      sk_make_sp<AssetFontManager>(std::move(provider)));
+  font_collection->DisableFontFallback();
+  return font_collection;
+}
+
+// Builds a paragraph the way |flutter::Paragraph| does and lays it out.
+void LayoutParagraph(const std::shared_ptr<FontCollection>& font_collection,
+                     const std::u16string& text,
+                     double font_size = 14.0) {
+  ParagraphStyle paragraph_style;
+  TextStyle text_style;
+  text_style.font_families = {"Roboto"};
+  text_style.font_size = font_size;
+  auto builder =
+      ParagraphBuilder::CreateSkiaBuilder(paragraph_style, font_collection);
+  builder->PushStyle(text_style);
+  builder->AddText(text);
+  builder->Pop();
+  auto paragraph = builder->Build();
+  paragraph->Layout(1000.0);
+}
+
+}  // namespace
+
+TEST(FontCollectionTest, IdenticalParagraphsReuseTheirShapingResults) {
+  auto font_collection = CreateFontCollection();
+  ASSERT_TRUE(font_collection);
+
+  LayoutParagraph(font_collection, u"Total revenue");
+  auto stats = font_collection->GetParagraphCacheStats();
+  ASSERT_EQ(stats.hit_count, 0u);
+  ASSERT_EQ(stats.miss_count, 1u);
+  const size_t estimated_bytes = stats.estimated_bytes;
+  ASSERT_GT(estimated_bytes, 0u);
+
+  // A paragraph rebuilt with the same text and styles, as lists do every
+  // frame, is not shaped again.
+  LayoutParagraph(font_collection, u"Total revenue");
+  stats = font_collection->GetParagraphCacheStats();
+  ASSERT_EQ(stats.hit_count, 1u);
+  ASSERT_EQ(stats.miss_count, 1u);
+  ASSERT_EQ(stats.estimated_bytes, estimated_bytes);
+}
+
+TEST(FontCollectionTest, ParagraphsWithOtherTextOrStylesAreShaped) {
+  auto font_collection = CreateFontCollection();
+  ASSERT_TRUE(font_collection);
+
+  LayoutParagraph(font_collection, u"Total revenue");
+  const size_t estimated_bytes =
+      font_collection->GetParagraphCacheStats().estimated_bytes;
+  LayoutParagraph(font_collection, u"Total revenue", 20.0);
+  LayoutParagraph(font_collection, u"Total revenue (USD)");
+
+  auto stats = font_collection->GetParagraphCacheStats();
+  ASSERT_EQ(stats.hit_count, 0u);
+  ASSERT_EQ(stats.miss_count, 3u);
+  // The estimate grows with the length of the text.
+  ASSERT_GT(stats.estimated_bytes, 3u * estimated_bytes);
+}
+
+TEST(FontCollectionTest, ParagraphCacheIsPurgedPastItsBudget) {
+  auto font_collection = CreateFontCollection();
+  ASSERT_TRUE(font_collection);
+
+  LayoutParagraph(font_collection, u"Total revenue");
+  const size_t estimated_bytes =
+      font_collection->GetParagraphCacheStats().estimated_bytes;
+  font_collection->SetParagraphCacheBudget(estimated_bytes);
+
+  // Still within the budget.
+  LayoutParagraph(font_collection, u"Total revenue");
+  ASSERT_EQ(font_collection->GetParagraphCacheStats().hit_count, 1u);
+
+  LayoutParagraph(font_collection, u"Net income");
+  auto stats = font_collection->GetParagraphCacheStats();
+  ASSERT_EQ(stats.miss_count, 2u);
+  ASSERT_EQ(stats.estimated_bytes, 0u);
+
+  // The purged paragraphs are shaped again.
+  LayoutParagraph(font_collection, u"Total revenue");
+  stats = font_collection->GetParagraphCacheStats();
+  ASSERT_EQ(stats.hit_count, 1u);
+  ASSERT_EQ(stats.miss_count, 3u);
+  ASSERT_EQ(stats.estimated_bytes, estimated_bytes);
+}
+
+TEST(FontCollectionTest, ClearingTheCachesResetsTheParagraphCacheEstimate) {
+  auto font_collection = CreateFontCollection();
+  ASSERT_TRUE(font_collection);
+
+  LayoutParagraph(font_collection, u"Total revenue");
+  ASSERT_GT(font_collection->GetParagraphCacheStats().estimated_bytes, 0u);
+  font_collection->ClearFontFamilyCache();
+  auto stats = font_collection->GetParagraphCacheStats();
+  ASSERT_EQ(stats.estimated_bytes, 0u);
+  // The counts are kept.
+  ASSERT_EQ(stats.miss_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace txt
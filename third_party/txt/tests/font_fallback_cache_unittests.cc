@@ -0,0 +1,310 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_fallback_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkString.h"
+#include "txt/font_subsetter.h"
+
+namespace txt {
+namespace testing {
+
+namespace {
+
+constexpr SkUnichar kArabicBeh = 0x0628;
+
+sk_sp<SkTypeface> LoadFixtureTypeface(const char* fixture_name) {
+  auto mapping = flutter::testing::OpenFixtureAsMapping(fixture_name);
+  if (!mapping) {
+    return nullptr;
+  }
+  return SkTypeface::MakeFromData(
+      SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize()));
+}
+
+std::string GetFamilyName(const SkTypeface& typeface) {
+  SkString family_name;
+  typeface.getFamilyName(&family_name);
+  return family_name.c_str();
+}
+
+// A platform font manager over a list of typefaces that counts the slow
+// fallback searches.
+class FakeFontManager : public SkFontMgr {
+ public:
+  explicit FakeFontManager(std::vector<sk_sp<SkTypeface>> typefaces)
+      : typefaces_(std::move(typefaces)) {}
+
+  ~FakeFontManager() override = default;
+
+  int character_match_count() const { return character_match_count_; }
+
+  int family_match_count() const { return family_match_count_; }
+
+ private:
+  std::vector<sk_sp<SkTypeface>> typefaces_;
+  mutable int character_match_count_ = 0;
+  mutable int family_match_count_ = 0;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override { return 0; }
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override {}
+
+  // |SkFontMgr|
+  SkFontStyleSet* onCreateStyleSet(int index) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  SkFontStyleSet* onMatchFamily(const char familyName[]) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyle(const char familyName[],
+                                 const SkFontStyle&) const override {
+    family_match_count_++;
+    for (const sk_sp<SkTypeface>& typeface : typefaces_) {
+      if (GetFamilyName(*typeface) == familyName) {
+        return SkRef(typeface.get());
+      }
+    }
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                          const SkFontStyle&,
+                                          const char* bcp47[],
+                                          int bcp47Count,
+                                          SkUnichar character) const override {
+    character_match_count_++;
+    for (const sk_sp<SkTypeface>& typeface : typefaces_) {
+      if (typeface->unicharToGlyph(character) != 0) {
+        return SkRef(typeface.get());
+      }
+    }
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(
+      std::unique_ptr<SkStreamAsset>,
+      const SkFontArguments&) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override {
+    return nullptr;
+  }
+};
+
+sk_sp<SkTypeface> MatchCharacter(FontFallbackCache& cache,
+                                 const SkFontMgr& font_manager,
+                                 SkUnichar character) {
+  return cache.MatchCharacter(font_manager, "sans-serif", SkFontStyle(),
+                              nullptr, 0, character);
+}
+
+}  // namespace
+
+TEST(FontFallbackCacheTest, ReusesTheTypefaceOfARange) {
+  auto roboto = LoadFixtureTypeface("Roboto-Regular.ttf");
+  ASSERT_NE(roboto, nullptr);
+  FakeFontManager font_manager({roboto});
+  FontFallbackCache cache;
+
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), roboto);
+  EXPECT_EQ(font_manager.character_match_count(), 1);
+
+  // 'a' and 'b' are in the same range, which Roboto covers.
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), roboto);
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'b'), roboto);
+  EXPECT_EQ(font_manager.character_match_count(), 1);
+  EXPECT_EQ(font_manager.family_match_count(), 0);
+}
+
+TEST(FontFallbackCacheTest, ChecksThatTheTypefaceOfARangeCoversTheCharacter) {
+  auto roboto = LoadFixtureTypeface("Roboto-Regular.ttf");
+  ASSERT_NE(roboto, nullptr);
+  auto subsetter = FontSubsetter::Create(
+      flutter::testing::OpenFixtureAsMapping("Roboto-Regular.ttf"));
+  ASSERT_NE(subsetter, nullptr);
+  ASSERT_TRUE(subsetter->AddCodepoints(u"a"));
+  auto subset = subsetter->MakeTypeface();
+  ASSERT_NE(subset, nullptr);
+  ASSERT_EQ(subset->unicharToGlyph('b'), 0);
+
+  // The subset is found first for the characters that it covers.
+  FakeFontManager font_manager({subset, roboto});
+  FontFallbackCache cache;
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), subset);
+  EXPECT_EQ(font_manager.character_match_count(), 1);
+
+  // 'b' is in the range of 'a' but not in the subset.
+  auto typeface = MatchCharacter(cache, font_manager, 'b');
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_NE(typeface->unicharToGlyph('b'), 0);
+  EXPECT_EQ(typeface, roboto);
+  EXPECT_EQ(font_manager.character_match_count(), 2);
+
+  // Both typefaces are now remembered for the range.
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), subset);
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'c'), roboto);
+  EXPECT_EQ(font_manager.character_match_count(), 2);
+}
+
+TEST(FontFallbackCacheTest, RemembersCharactersWithoutFallback) {
+  auto roboto = LoadFixtureTypeface("Roboto-Regular.ttf");
+  ASSERT_NE(roboto, nullptr);
+  ASSERT_EQ(roboto->unicharToGlyph(kArabicBeh), 0);
+  FakeFontManager font_manager({roboto});
+  FontFallbackCache cache;
+
+  EXPECT_EQ(MatchCharacter(cache, font_manager, kArabicBeh), nullptr);
+  EXPECT_EQ(MatchCharacter(cache, font_manager, kArabicBeh), nullptr);
+  EXPECT_EQ(font_manager.character_match_count(), 1);
+  EXPECT_FALSE(cache.HasUnsavedFamilies());
+
+  // The missing characters belong to the replaced font manager.
+  cache.ClearTypefaces();
+  EXPECT_EQ(MatchCharacter(cache, font_manager, kArabicBeh), nullptr);
+  EXPECT_EQ(font_manager.character_match_count(), 2);
+}
+
+TEST(FontFallbackCacheTest, ClearTypefacesKeepsTheFamilies) {
+  auto roboto = LoadFixtureTypeface("Roboto-Regular.ttf");
+  ASSERT_NE(roboto, nullptr);
+  FakeFontManager font_manager({roboto});
+  FontFallbackCache cache;
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), roboto);
+
+  cache.ClearTypefaces();
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), roboto);
+  EXPECT_EQ(font_manager.character_match_count(), 1);
+  EXPECT_EQ(font_manager.family_match_count(), 1);
+}
+
+TEST(FontFallbackCacheTest, LoadsTheSerializedFamilies) {
+  auto roboto = LoadFixtureTypeface("Roboto-Regular.ttf");
+  auto arabic = LoadFixtureTypeface("NotoNaskhArabic-Regular.ttf");
+  ASSERT_NE(roboto, nullptr);
+  ASSERT_NE(arabic, nullptr);
+  ASSERT_NE(arabic->unicharToGlyph(kArabicBeh), 0);
+
+  std::string data;
+  {
+    FakeFontManager font_manager({roboto, arabic});
+    FontFallbackCache cache;
+    EXPECT_FALSE(cache.HasUnsavedFamilies());
+    EXPECT_EQ(MatchCharacter(cache, font_manager, 'a'), roboto);
+    EXPECT_EQ(MatchCharacter(cache, font_manager, kArabicBeh), arabic);
+    EXPECT_TRUE(cache.HasUnsavedFamilies());
+    data = cache.Serialize();
+    EXPECT_FALSE(cache.HasUnsavedFamilies());
+  }
+  EXPECT_NE(data.find(GetFamilyName(*roboto)), std::string::npos);
+  EXPECT_NE(data.find(GetFamilyName(*arabic)), std::string::npos);
+
+  // A later run matches the families instead of searching the fonts.
+  FakeFontManager font_manager({roboto, arabic});
+  FontFallbackCache cache;
+  cache.Load(data);
+  EXPECT_FALSE(cache.HasUnsavedFamilies());
+  EXPECT_EQ(MatchCharacter(cache, font_manager, 'b'), roboto);
+  EXPECT_EQ(MatchCharacter(cache, font_manager, kArabicBeh + 1), arabic);
+  EXPECT_EQ(font_manager.character_match_count(), 0);
+  EXPECT_EQ(font_manager.family_match_count(), 2);
+}
+
+TEST(FontFallbackCacheTest, LoadIgnoresMalformedData) {
+  const std::string header = "txt-font-fallback-cache-1\n";
+  const std::string line = "sans-serif|400|5|0\t0\tRoboto\n";
+
+  for (const std::string& data : {
+           std::string(),
+           std::string("not a cache\n"),
+           "txt-font-fallback-cache-0\n" + line,
+           line,
+           header.substr(0, header.size() - 1),
+       }) {
+    FontFallbackCache cache;
+    cache.Load(data);
+    EXPECT_EQ(cache.Serialize(), header) << data;
+  }
+
+  FontFallbackCache cache;
+  cache.Load(header +                            //
+             "no tabs\n" +                       //
+             "sans-serif|400|5|0\t0\n" +         // No family.
+             "sans-serif|400|5|0\t0\t\n" +       // Empty family.
+             "sans-serif|400|5|0\t\tRoboto\n" +  // No range.
+             "sans-serif|400|5|0\tx\tRoboto\n" +
+             "sans-serif|400|5|0\t-1\tRoboto\n" + line + line +
+             "sans-serif|400|5|0\t1\tRoboto");  // Truncated.
+  EXPECT_FALSE(cache.HasUnsavedFamilies());
+  EXPECT_EQ(cache.Serialize(), header + line);
+}
+
+TEST(FontFallbackCacheTest, ManagerMatchesFallbacksThroughTheCache) {
+  auto roboto = LoadFixtureTypeface("Roboto-Regular.ttf");
+  ASSERT_NE(roboto, nullptr);
+  auto font_manager = sk_make_sp<FakeFontManager>(
+      std::vector<sk_sp<SkTypeface>>{roboto});
+  auto cache = std::make_shared<FontFallbackCache>();
+  auto cache_manager =
+      sk_make_sp<FontFallbackCacheManager>(font_manager, cache);
+
+  for (SkUnichar character : {'a', 'b', 'c'}) {
+    sk_sp<SkTypeface> typeface(cache_manager->matchFamilyStyleCharacter(
+        "sans-serif", SkFontStyle(), nullptr, 0, character));
+    EXPECT_EQ(typeface, roboto);
+  }
+  EXPECT_EQ(font_manager->character_match_count(), 1);
+  EXPECT_TRUE(cache->HasUnsavedFamilies());
+}
+
+}  // namespace testing
+}  // namespace txt
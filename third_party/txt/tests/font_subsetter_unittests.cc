@@ -0,0 +1,81 @@
+/*
+ * Copyright 2017 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "txt/font_subsetter.h"
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+namespace testing {
+
+static std::unique_ptr<FontSubsetter> CreateRobotoSubsetter() {
+  return FontSubsetter::Create(
+      flutter::testing::OpenFixtureAsMapping("Roboto-Regular.ttf"));
+}
+
+TEST(FontSubsetterTest, CreateFailsForDataThatIsNotAFont) {
+  EXPECT_EQ(FontSubsetter::Create(nullptr), nullptr);
+  EXPECT_EQ(FontSubsetter::Create(
+                std::make_unique<fml::DataMapping>("not a font")),
+            nullptr);
+}
+
+TEST(FontSubsetterTest, OnlyAddsCodepointsOfTheFont) {
+  auto subsetter = CreateRobotoSubsetter();
+  ASSERT_NE(subsetter, nullptr);
+  EXPECT_EQ(subsetter->GetCodepointCount(), 0u);
+
+  EXPECT_TRUE(subsetter->AddCodepoints(u"Hello"));
+  EXPECT_EQ(subsetter->GetCodepointCount(), 4u);
+
+  // Code points that are in the subset already do not grow it.
+  EXPECT_FALSE(subsetter->AddCodepoints(u"olleH"));
+  // Roboto does not have CJK characters or emoji.
+  EXPECT_FALSE(subsetter->AddCodepoints(u"中\U0001F600"));
+  EXPECT_EQ(subsetter->GetCodepointCount(), 4u);
+}
+
+TEST(FontSubsetterTest, TypefaceOnlyHasGlyphsOfTheSubset) {
+  auto subsetter = CreateRobotoSubsetter();
+  ASSERT_NE(subsetter, nullptr);
+  subsetter->AddCodepoints(u"Hello");
+
+  sk_sp<SkTypeface> typeface = subsetter->MakeTypeface();
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_NE(typeface->unicharToGlyph('H'), 0);
+  EXPECT_NE(typeface->unicharToGlyph('o'), 0);
+  EXPECT_EQ(typeface->unicharToGlyph('x'), 0);
+
+  auto font_data = flutter::testing::OpenFixtureAsMapping("Roboto-Regular.ttf");
+  ASSERT_NE(font_data, nullptr);
+  sk_sp<SkTypeface> font = SkTypeface::MakeFromData(
+      SkData::MakeWithoutCopy(font_data->GetMapping(), font_data->GetSize()));
+  ASSERT_NE(font, nullptr);
+  EXPECT_LT(typeface->countGlyphs(), font->countGlyphs());
+
+  // A larger subset is a new typeface.
+  EXPECT_TRUE(subsetter->AddCodepoints(u"x"));
+  sk_sp<SkTypeface> grown_typeface = subsetter->MakeTypeface();
+  ASSERT_NE(grown_typeface, nullptr);
+  EXPECT_NE(grown_typeface->unicharToGlyph('x'), 0);
+  EXPECT_GT(grown_typeface->countGlyphs(), typeface->countGlyphs());
+}
+
+}  // namespace testing
+}  // namespace txt